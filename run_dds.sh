@@ -0,0 +1,45 @@
+#!/bin/bash
+
+################################################################################
+# Converts textures into compressed DDS files with mipmaps, which are read
+# instead of the source images when they exist next to them.
+# Requires ImageMagick and NVIDIA Texture Tools (nvcompress).
+#
+# usage: ./run_dds.sh [data directory] [bc7]
+#   opaque images are compressed as BC1, images with alpha channel as BC3,
+#   or BC7 when bc7 is given (BC7 requires OpenGL 4.2 capable hardware)
+################################################################################
+
+DATA_DIR=${1:-/usr/share/mscsim/data}
+ALPHA_FORMAT=-bc3
+
+if [ "$2" == "bc7" ]; then
+    ALPHA_FORMAT=-bc7
+fi
+
+TEMP_FILE=$(mktemp --suffix=.png)
+
+################################################################################
+
+find "$DATA_DIR" -type f \( -iname "*.png" -o -iname "*.jpg" -o -iname "*.bmp" -o -iname "*.rgb" -o -iname "*.tga" \) | while read -r FILE
+do
+    DDS_FILE="${FILE%.*}.dds"
+
+    # skip up to date files
+    if [ "$DDS_FILE" -nt "$FILE" ]; then
+        continue
+    fi
+
+    if [ "$(identify -format '%[opaque]' "$FILE[0]")" == "True" ]; then
+        FORMAT=-bc1
+    else
+        FORMAT=$ALPHA_FORMAT
+    fi
+
+    # images are flipped, so DDS files have the same origin as OSG images
+    convert "$FILE" -flip "$TEMP_FILE" && nvcompress -silent $FORMAT "$TEMP_FILE" "$DDS_FILE"
+done
+
+rm -f "$TEMP_FILE"
+
+################################################################################
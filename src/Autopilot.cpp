@@ -20,6 +20,8 @@
  * IN THE SOFTWARE.
  ******************************************************************************/
 
+#include <cstring>
+
 #include <Autopilot.h>
 
 #include <Data.h>
@@ -27,13 +29,14 @@
 #include <fdm/fdm_Exception.h>
 #include <fdm/utils/fdm_Units.h>
 
-#include <hid/hid_Manager.h>
-
 #include <sim/Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Autopilot::Autopilot() :
+    _btn_dn ( false ),
+    _btn_up ( false ),
+
     _autopilot ( NULLPTR ),
 
     _c172_gfc700_ap ( NULLPTR ),
@@ -42,7 +45,10 @@ Autopilot::Autopilot() :
 
     _altitude  ( 100.0 ),
     _climbRate (   0.0 )
-{}
+{
+    publishState();
+    update();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -55,846 +61,584 @@ Autopilot::~Autopilot()
 
 void Autopilot::init()
 {
-    try
-    {
-        if ( !_autopilot )
-        {
-            switch ( Data::get()->aircraftType )
-            {
-            case fdm::DataInp::C172:
-                //_autopilot = _c172_gfc700_ap = new fdm::C172_GFC700_AP();
-                //_autopilot = _c172_kap140_ap = new fdm::C172_KAP140_AP();
-                _autopilot = _c172_kfc325_ap = new fdm::C172_KFC325_AP();
-                break;
-
-            default:
-                _autopilot = NULLPTR;
-                break;
-            }
-
-            if ( _autopilot ) _autopilot->initialize();
-        }
-    }
-    catch ( fdm::Exception &e )
-    {
-        Log::e() << e.getInfo() << std::endl;
-
-        while ( e.hasCause() )
-        {
-            e = e.getCause();
-            Log::e() << e.getInfo() << std::endl;
-        }
-    }
+    push( Command::Init, Data::get()->aircraftType );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Autopilot::stop()
 {
-    DELPTR( _autopilot );
-
-    _c172_gfc700_ap = NULLPTR;
-    _c172_kap140_ap = NULLPTR;
-    _c172_kfc325_ap = NULLPTR;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::update( double timeStep )
-{
-    if ( _autopilot )
-    {
-        if ( _c172_kfc325_ap )
-        {
-            _c172_kfc325_ap->setHeadingILS( Data::get()->navigation.ils_heading );
-        }
-
-        _autopilot->update( timeStep,
-                            Data::get()->ownship.roll,
-                            Data::get()->ownship.pitch,
-                            Data::get()->ownship.heading,
-                            Data::get()->ownship.altitude_asl,
-                            Data::get()->ownship.ias,
-                            Data::get()->ownship.turnRate,
-                            Data::get()->ownship.yawRate,
-                            Data::get()->ownship.climbRate,
-                            Data::get()->navigation.dme_distance,
-                            Data::get()->navigation.nav_deviation,
-                            Data::get()->navigation.nav_cdi != Data::Navigation::NONE,
-                            Data::get()->navigation.ils_lc_deviation,
-                            Data::get()->navigation.ils_lc_visible,
-                            Data::get()->navigation.ils_gs_deviation,
-                            Data::get()->navigation.ils_gs_visible );
-
-        if ( hid::Manager::instance()->getAP_Disc() )
-        {
-            _autopilot->disengage();
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::update( double timeStep, bool btn_dn, bool btn_up )
-{
-    if ( _c172_kfc325_ap ) _c172_kfc325_ap->update( timeStep, btn_dn, btn_up );
+    push( Command::Stop );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::onPressedAP()
+void Autopilot::update()
 {
-    if ( isWorking() )
+    if ( _stateBuffer.fetch() )
     {
-        if ( _c172_gfc700_ap ) _c172_gfc700_ap->onPressedAP();
-        if ( _c172_kap140_ap ) _c172_kap140_ap->onPressedAP();
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedAP();
+        _state = _stateBuffer.getFrontBuffer();
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::onPressedFD()
+void Autopilot::step( double timeStep, const fdm::DataOut &dataOut,
+                      const Navigation &navigation, bool disc,
+                      Controls *controls )
 {
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            if ( !_c172_gfc700_ap->isActiveFD() )
-            {
-                _c172_gfc700_ap->setPitch( Data::get()->ownship.pitch );
-                _c172_gfc700_ap->setRoll( Data::get()->ownship.roll );
-            }
-
-            _c172_gfc700_ap->onPressedFD();
-        }
-
-        // KAP 140
-        if ( _c172_kap140_ap )
-        {
-            if ( !_c172_kap140_ap->isActiveFD() )
-            {
-                _c172_kap140_ap->setPitch( Data::get()->ownship.pitch );
-            }
-
-            _c172_kap140_ap->onPressedFD();
-        }
+    bool btn_dn = false;
+    bool btn_up = false;
 
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-            {
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-            }
-
-            _c172_kfc325_ap->onPressedFD();
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::onPressedALT()
-{
-    if ( isWorking() )
+    // queue is swapped, so GUI thread is never blocked by commands execution
     {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveALT() )
-                _altitude = Data::get()->ownship.altitude_asl;
-
-            _c172_kfc325_ap->setAltitude( _altitude );
-            _c172_kfc325_ap->onPressedALT();
-        }
-    }
-}
+        std::lock_guard< std::mutex > lock( _mutex );
 
-////////////////////////////////////////////////////////////////////////////////
+        _pending.swap( _commands );
 
-void Autopilot::onPressedIAS()
-{
-    if ( isWorking() )
-    {
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveIAS() )
-                _c172_kfc325_ap->setAirspeed( Data::get()->ownship.ias );
-
-            _c172_kfc325_ap->onPressedIAS();
-        }
+        btn_dn = _btn_dn;
+        btn_up = _btn_up;
     }
-}
-
-////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::onPressedENG()
-{
-    if ( isWorking() )
+    for ( Commands::iterator it = _pending.begin(); it != _pending.end(); ++it )
     {
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveVS() )
-            {
-                _climbRate = Data::get()->ownship.climbRate;
-            }
-
-            _c172_kfc325_ap->setClimbRate( _climbRate );
-            _c172_kfc325_ap->onPressedENG();
-        }
+        execute( *it, dataOut );
     }
-}
 
-////////////////////////////////////////////////////////////////////////////////
+    _pending.clear();
 
-void Autopilot::onPressedARM()
-{
-    if ( isWorking() )
-    {
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveARM() )
-            {
-                _altitude = Data::get()->ownship.altitude_asl;
-            }
-
-            _c172_kfc325_ap->setAltitude( _altitude );
-            _c172_kfc325_ap->onPressedARM();
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::onPressedVNV()
-{
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::onPressedFLC()
-{
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::onPressedVS()
-{
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::onPressedHDG( double hdg )
-{
-    if ( isWorking() )
+    if ( _autopilot )
     {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
         if ( _c172_kfc325_ap )
         {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-
-            _c172_kfc325_ap->setHeading( hdg );
-            _c172_kfc325_ap->onPressedHDG();
+            _c172_kfc325_ap->setHeadingILS( navigation.ils_heading );
         }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::onPressedNAV( double crs )
-{
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
+        _autopilot->update( timeStep,
+                            dataOut.flight.roll,
+                            dataOut.flight.pitch,
+                            dataOut.flight.heading,
+                            dataOut.flight.altitude_asl,
+                            dataOut.flight.ias,
+                            dataOut.flight.turnRate,
+                            dataOut.flight.yawRate,
+                            dataOut.flight.climbRate,
+                            navigation.dme_distance,
+                            navigation.nav_deviation,
+                            navigation.nav_active,
+                            navigation.ils_lc_deviation,
+                            navigation.ils_lc_visible,
+                            navigation.ils_gs_deviation,
+                            navigation.ils_gs_visible );
+
+        if ( disc )
         {
-            // TODO
+            _autopilot->disengage();
         }
 
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->update( timeStep, btn_dn, btn_up );
 
-            _c172_kfc325_ap->setCourse( crs );
-            _c172_kfc325_ap->onPressedNAV();
-        }
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
+        controls->ctrlRoll  = _autopilot->getCtrlRoll();
+        controls->ctrlPitch = _autopilot->getCtrlPitch();
+        controls->ctrlYaw   = _autopilot->getCtrlYaw();
 
-void Autopilot::onPressedAPR()
-{
-    if ( isWorking() )
-    {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
-
-            _c172_kfc325_ap->onPressedAPR();
-        }
+        controls->ap_active = _autopilot->isActiveAP() && _autopilot->isActiveFD();
+        controls->yd_active = _autopilot->isActiveYD();
     }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::onPressedBC()
-{
-    if ( isWorking() )
+    else
     {
-        // GFC 700
-        if ( _c172_gfc700_ap )
-        {
-            // TODO
-        }
-
-        // KFC 325
-        if ( _c172_kfc325_ap )
-        {
-            if ( !_c172_kfc325_ap->isActiveFD() )
-                _c172_kfc325_ap->setPitch( Data::get()->ownship.pitch );
+        controls->ctrlRoll  = 0.0;
+        controls->ctrlPitch = 0.0;
+        controls->ctrlYaw   = 0.0;
 
-            _c172_kfc325_ap->onPressedBC();
-        }
+        controls->ap_active = false;
+        controls->yd_active = false;
     }
-}
-
-////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::onPressedREV()
-{
-    if ( isWorking() )
-    {
-        // KAP 140
-        if ( _c172_kap140_ap )
-        {
-
-        }
-    }
+    publishState();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::onPressedYD()
+void Autopilot::setButtons( bool btn_dn, bool btn_up )
 {
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedYD();
-    }
-}
+    std::lock_guard< std::mutex > lock( _mutex );
 
-////////////////////////////////////////////////////////////////////////////////
-
-void Autopilot::onPressedSoftRide()
-{
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedSoftRide();
-    }
+    _btn_dn = btn_dn;
+    _btn_up = btn_up;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Autopilot::onPressedHalfBank()
-{
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedHalfBank();
-    }
-}
+void Autopilot::onPressedAP()  { push( Command::PressedAP  ); }
+void Autopilot::onPressedFD()  { push( Command::PressedFD  ); }
 
-////////////////////////////////////////////////////////////////////////////////
+void Autopilot::onPressedALT() { push( Command::PressedALT ); }
+void Autopilot::onPressedIAS() { push( Command::PressedIAS ); }
+void Autopilot::onPressedENG() { push( Command::PressedENG ); }
+void Autopilot::onPressedARM() { push( Command::PressedARM ); }
+void Autopilot::onPressedVNV() { push( Command::PressedVNV ); }
+void Autopilot::onPressedFLC() { push( Command::PressedFLC ); }
+void Autopilot::onPressedVS()  { push( Command::PressedVS  ); }
 
-void Autopilot::onPressedTest()
-{
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedTest();
-    }
-}
-
-////////////////////////////////////////////////////////////////////////////////
+void Autopilot::onPressedHDG( double hdg ) { push( Command::PressedHDG, hdg ); }
+void Autopilot::onPressedNAV( double crs ) { push( Command::PressedNAV, crs ); }
 
-void Autopilot::onReleasedTest()
-{
-    if ( isWorking() )
-    {
-        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onReleasedTest();
-    }
-}
+void Autopilot::onPressedAPR() { push( Command::PressedAPR ); }
+void Autopilot::onPressedBC()  { push( Command::PressedBC  ); }
+void Autopilot::onPressedREV() { push( Command::PressedREV ); }
 
-////////////////////////////////////////////////////////////////////////////////
+void Autopilot::onPressedYD()  { push( Command::PressedYD  ); }
 
-double Autopilot::getAirspeed() const
-{
-    if ( _autopilot ) return _autopilot->getAirspeed();
+void Autopilot::onPressedSoftRide() { push( Command::PressedSoftRide ); }
+void Autopilot::onPressedHalfBank() { push( Command::PressedHalfBank ); }
 
-    return 0.0;
-}
+void Autopilot::onPressedTest()  { push( Command::PressedTest  ); }
+void Autopilot::onReleasedTest() { push( Command::ReleasedTest ); }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-double Autopilot::getAltitude() const
-{
-    if ( _autopilot ) return _autopilot->getAltitude();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getClimbRate() const
-{
-    if ( _autopilot ) return _autopilot->getClimbRate();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getHeading() const
-{
-    if ( _autopilot ) return _autopilot->getHeading();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCmdRoll() const
-{
-    if ( _autopilot ) return _autopilot->getCmdRoll();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCmdPitch() const
-{
-    if ( _autopilot ) return _autopilot->getCmdPitch();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCtrlRoll() const
-{
-    if ( _autopilot ) return _autopilot->getCtrlRoll();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCtrlPitch() const
-{
-    if ( _autopilot ) return _autopilot->getCtrlPitch();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Autopilot::getCtrlYaw() const
-{
-    if ( _autopilot ) return _autopilot->getCtrlYaw();
-
-    return 0.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-bool Autopilot::getLampAP() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampAP();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-bool Autopilot::getLampFD() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampFD();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-bool Autopilot::getLampYD() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampYD();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-bool Autopilot::getLampALT() const
+bool Autopilot::isWorking() const
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampALT();
-
-    return false;
+    return ( Data::get()->stateOut == fdm::DataOut::Working );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampIAS() const
+void Autopilot::setAltitude( double altitude )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampIAS();
-
-    return false;
+    push( Command::SetAltitude, altitude );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampGS()  const
+void Autopilot::setClimbRate( double climbRate )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampGS();
-
-    return false;
+    push( Command::SetClimbRate, climbRate );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampHDG() const
+void Autopilot::setCourse( double course )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampHDG();
-
-    return false;
+    push( Command::SetCourse, course );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampNAV() const
+void Autopilot::setHeading( double heading )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampNAV();
-
-    return false;
+    push( Command::SetHeading, heading );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampAPR() const
+void Autopilot::push( Command::Type type, double value )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampAPR();
+    Command command;
 
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    command.type  = type;
+    command.value = value;
 
-bool Autopilot::getLampBC() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampBC();
+    std::lock_guard< std::mutex > lock( _mutex );
 
-    return false;
+    _commands.push_back( command );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampNAV_ARM() const
+void Autopilot::execute( const Command &command, const fdm::DataOut &dataOut )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampNAV_ARM();
+    const fdm::DataOut::Flight &flight = dataOut.flight;
 
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    switch ( command.type )
+    {
+    case Command::Init:
+        create( static_cast< int >( command.value ) );
+        return;
+
+    case Command::Stop:
+        destroy();
+        return;
+
+    case Command::SetAltitude:
+        _altitude = command.value;
+        if ( _autopilot ) _autopilot->setAltitude( _altitude );
+        return;
+
+    case Command::SetClimbRate:
+        _climbRate = command.value;
+        if ( _autopilot ) _autopilot->setClimbRate( _climbRate );
+        return;
+
+    case Command::SetCourse:
+        if ( _autopilot ) _autopilot->setCourse( command.value );
+        return;
+
+    case Command::SetHeading:
+        if ( _autopilot ) _autopilot->setHeading( command.value );
+        return;
+
+    default:
+        break;
+    }
 
-bool Autopilot::getLampAPR_ARM() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampAPR_ARM();
+    // buttons work only when flight dynamics model is working
+    if ( dataOut.stateOut != fdm::DataOut::Working )
+    {
+        return;
+    }
 
-    return false;
-}
+    switch ( command.type )
+    {
+    case Command::PressedAP:
+        if ( _c172_gfc700_ap ) _c172_gfc700_ap->onPressedAP();
+        if ( _c172_kap140_ap ) _c172_kap140_ap->onPressedAP();
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedAP();
+        break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::PressedFD:  pressedFD  ( flight ); break;
+    case Command::PressedALT: pressedALT ( flight ); break;
+    case Command::PressedIAS: pressedIAS ( flight ); break;
+    case Command::PressedENG: pressedENG ( flight ); break;
+    case Command::PressedARM: pressedARM ( flight ); break;
 
-bool Autopilot::getLampSR() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampSR();
+    case Command::PressedHDG: pressedHDG ( flight, command.value ); break;
+    case Command::PressedNAV: pressedNAV ( flight, command.value ); break;
 
-    return false;
-}
+    case Command::PressedAPR: pressedAPR ( flight ); break;
+    case Command::PressedBC:  pressedBC  ( flight ); break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::PressedYD:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedYD();
+        break;
 
-bool Autopilot::getLampHB() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampHB();
+    case Command::PressedSoftRide:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedSoftRide();
+        break;
 
-    return false;
-}
+    case Command::PressedHalfBank:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedHalfBank();
+        break;
 
-////////////////////////////////////////////////////////////////////////////////
+    case Command::PressedTest:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onPressedTest();
+        break;
 
-bool Autopilot::getLampTRIM() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampTRIM();
+    case Command::ReleasedTest:
+        if ( _c172_kfc325_ap ) _c172_kfc325_ap->onReleasedTest();
+        break;
 
-    return false;
+    // TODO GFC 700 VNV, FLC and VS, KAP 140 REV
+    default:
+        break;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::getLampVS() const
+void Autopilot::create( int aircraftType )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampVS();
-
-    return false;
-}
+    try
+    {
+        if ( !_autopilot )
+        {
+            switch ( aircraftType )
+            {
+            case fdm::DataInp::C172:
+                //_autopilot = _c172_gfc700_ap = new fdm::C172_GFC700_AP();
+                //_autopilot = _c172_kap140_ap = new fdm::C172_KAP140_AP();
+                _autopilot = _c172_kfc325_ap = new fdm::C172_KFC325_AP();
+                break;
 
-////////////////////////////////////////////////////////////////////////////////
+            default:
+                _autopilot = NULLPTR;
+                break;
+            }
 
-bool Autopilot::getLampARM() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->getLampARM();
+            if ( _autopilot ) _autopilot->initialize();
+        }
+    }
+    catch ( fdm::Exception &e )
+    {
+        Log::e() << e.getInfo() << std::endl;
 
-    return false;
+        while ( e.hasCause() )
+        {
+            e = e.getCause();
+            Log::e() << e.getInfo() << std::endl;
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-double Autopilot::getMinAltitude() const
+void Autopilot::destroy()
 {
-    if ( _autopilot ) return _autopilot->getMinAltitude();
+    DELPTR( _autopilot );
 
-    return 100.0;
+    _c172_gfc700_ap = NULLPTR;
+    _c172_kap140_ap = NULLPTR;
+    _c172_kfc325_ap = NULLPTR;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-double Autopilot::getMaxAltitude() const
+void Autopilot::pressedFD( const fdm::DataOut::Flight &flight )
 {
-    if ( _autopilot ) return _autopilot->getMaxAltitude();
-
-    return 50000.0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        if ( !_c172_gfc700_ap->isActiveFD() )
+        {
+            _c172_gfc700_ap->setPitch( flight.pitch );
+            _c172_gfc700_ap->setRoll( flight.roll );
+        }
 
-double Autopilot::getMinClimbRate() const
-{
-    if ( _autopilot ) return _autopilot->getMinClimbRate();
+        _c172_gfc700_ap->onPressedFD();
+    }
 
-    return -5000.0;
-}
+    // KAP 140
+    if ( _c172_kap140_ap )
+    {
+        if ( !_c172_kap140_ap->isActiveFD() )
+        {
+            _c172_kap140_ap->setPitch( flight.pitch );
+        }
 
-////////////////////////////////////////////////////////////////////////////////
+        _c172_kap140_ap->onPressedFD();
+    }
 
-double Autopilot::getMaxClimbRate() const
-{
-    if ( _autopilot ) return _autopilot->getMaxClimbRate();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+        {
+            _c172_kfc325_ap->setPitch( flight.pitch );
+        }
 
-    return  5000.0;
+        _c172_kfc325_ap->onPressedFD();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveAP() const
+void Autopilot::pressedALT( const fdm::DataOut::Flight &flight )
 {
-    if ( _autopilot ) return _autopilot->isActiveAP();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveFD() const
-{
-    if ( _autopilot ) return _autopilot->isActiveFD();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveALT() )
+            _altitude = flight.altitude_asl;
 
-    return false;
+        _c172_kfc325_ap->setAltitude( _altitude );
+        _c172_kfc325_ap->onPressedALT();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveYD() const
+void Autopilot::pressedIAS( const fdm::DataOut::Flight &flight )
 {
-    if ( _autopilot ) return _autopilot->isActiveYD();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveIAS() )
+            _c172_kfc325_ap->setAirspeed( flight.ias );
 
-    return false;
+        _c172_kfc325_ap->onPressedIAS();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveALT() const
+void Autopilot::pressedENG( const fdm::DataOut::Flight &flight )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveALT();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveVS() )
+        {
+            _climbRate = flight.climbRate;
+        }
 
-    return false;
+        _c172_kfc325_ap->setClimbRate( _climbRate );
+        _c172_kfc325_ap->onPressedENG();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveIAS() const
+void Autopilot::pressedARM( const fdm::DataOut::Flight &flight )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveIAS();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveARM() )
+        {
+            _altitude = flight.altitude_asl;
+        }
 
-    return false;
+        _c172_kfc325_ap->setAltitude( _altitude );
+        _c172_kfc325_ap->onPressedARM();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveVS() const
+void Autopilot::pressedHDG( const fdm::DataOut::Flight &flight, double hdg )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveVS();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveARM() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveARM();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( flight.pitch );
 
-    return false;
+        _c172_kfc325_ap->setHeading( hdg );
+        _c172_kfc325_ap->onPressedHDG();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveGS() const
+void Autopilot::pressedNAV( const fdm::DataOut::Flight &flight, double crs )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveGS();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveHDG() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveHDG();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( flight.pitch );
 
-    return false;
+        _c172_kfc325_ap->setCourse( crs );
+        _c172_kfc325_ap->onPressedNAV();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveNAV() const
+void Autopilot::pressedAPR( const fdm::DataOut::Flight &flight )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveNAV();
-
-    return false;
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-bool Autopilot::isActiveAPR() const
-{
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveAPR();
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( flight.pitch );
 
-    return false;
+        _c172_kfc325_ap->onPressedAPR();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isActiveBC() const
+void Autopilot::pressedBC( const fdm::DataOut::Flight &flight )
 {
-    if ( _c172_kfc325_ap ) return _c172_kfc325_ap->isActiveBC();
-
-    return false;
-}
+    // GFC 700
+    if ( _c172_gfc700_ap )
+    {
+        // TODO
+    }
 
-////////////////////////////////////////////////////////////////////////////////
+    // KFC 325
+    if ( _c172_kfc325_ap )
+    {
+        if ( !_c172_kfc325_ap->isActiveFD() )
+            _c172_kfc325_ap->setPitch( flight.pitch );
 
-bool Autopilot::isInited() const
-{
-    return ( _autopilot != NULLPTR );
+        _c172_kfc325_ap->onPressedBC();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool Autopilot::isWorking() const
+void Autopilot::publishState()
 {
-    return ( Data::get()->stateOut == fdm::DataOut::Working );
-}
+    State &state = _stateBuffer.getBackBuffer();
 
-////////////////////////////////////////////////////////////////////////////////
+    memset( &state, 0, sizeof(State) );
 
-void Autopilot::setAltitude( double altitude )
-{
-    _altitude = altitude;
+    state.minAltitude  =   100.0;
+    state.maxAltitude  = 50000.0;
+    state.minClimbRate = -5000.0;
+    state.maxClimbRate =  5000.0;
 
-    if ( _autopilot ) _autopilot->setAltitude( _altitude );
-}
-
-////////////////////////////////////////////////////////////////////////////////
+    if ( _autopilot )
+    {
+        state.airspeed  = _autopilot->getAirspeed();
+        state.altitude  = _autopilot->getAltitude();
+        state.climbRate = _autopilot->getClimbRate();
+        state.heading   = _autopilot->getHeading();
 
-void Autopilot::setClimbRate( double climbRate )
-{
-    _climbRate = climbRate;
+        state.cmdRoll  = _autopilot->getCmdRoll();
+        state.cmdPitch = _autopilot->getCmdPitch();
 
-    if ( _autopilot ) _autopilot->setClimbRate( _climbRate );
-}
+        state.minAltitude  = _autopilot->getMinAltitude();
+        state.maxAltitude  = _autopilot->getMaxAltitude();
+        state.minClimbRate = _autopilot->getMinClimbRate();
+        state.maxClimbRate = _autopilot->getMaxClimbRate();
 
-////////////////////////////////////////////////////////////////////////////////
+        state.activeAP = _autopilot->isActiveAP();
+        state.activeFD = _autopilot->isActiveFD();
+        state.activeYD = _autopilot->isActiveYD();
 
-void Autopilot::setCourse( double course )
-{
-    if ( _autopilot ) _autopilot->setCourse( course );
-}
+        state.inited = true;
+    }
 
-////////////////////////////////////////////////////////////////////////////////
+    if ( _c172_kfc325_ap )
+    {
+        state.lampAP      = _c172_kfc325_ap->getLampAP();
+        state.lampFD      = _c172_kfc325_ap->getLampFD();
+        state.lampYD      = _c172_kfc325_ap->getLampYD();
+        state.lampALT     = _c172_kfc325_ap->getLampALT();
+        state.lampIAS     = _c172_kfc325_ap->getLampIAS();
+        state.lampGS      = _c172_kfc325_ap->getLampGS();
+        state.lampHDG     = _c172_kfc325_ap->getLampHDG();
+        state.lampNAV     = _c172_kfc325_ap->getLampNAV();
+        state.lampAPR     = _c172_kfc325_ap->getLampAPR();
+        state.lampBC      = _c172_kfc325_ap->getLampBC();
+        state.lampNAV_ARM = _c172_kfc325_ap->getLampNAV_ARM();
+        state.lampAPR_ARM = _c172_kfc325_ap->getLampAPR_ARM();
+        state.lampSR      = _c172_kfc325_ap->getLampSR();
+        state.lampHB      = _c172_kfc325_ap->getLampHB();
+        state.lampTRIM    = _c172_kfc325_ap->getLampTRIM();
+        state.lampVS      = _c172_kfc325_ap->getLampVS();
+        state.lampARM     = _c172_kfc325_ap->getLampARM();
+
+        state.activeALT = _c172_kfc325_ap->isActiveALT();
+        state.activeIAS = _c172_kfc325_ap->isActiveIAS();
+        state.activeVS  = _c172_kfc325_ap->isActiveVS();
+        state.activeARM = _c172_kfc325_ap->isActiveARM();
+        state.activeGS  = _c172_kfc325_ap->isActiveGS();
+        state.activeHDG = _c172_kfc325_ap->isActiveHDG();
+        state.activeNAV = _c172_kfc325_ap->isActiveNAV();
+        state.activeAPR = _c172_kfc325_ap->isActiveAPR();
+        state.activeBC  = _c172_kfc325_ap->isActiveBC();
+    }
 
-void Autopilot::setHeading( double heading )
-{
-    if ( _autopilot ) _autopilot->setHeading( heading );
+    ///////////////////////
+    _stateBuffer.publish();
+    ///////////////////////
 }
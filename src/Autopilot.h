@@ -24,21 +24,62 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <mutex>
+#include <vector>
+
+#include <fdm/fdm_DataOut.h>
+
 #include <fdm/auto/fdm_Autopilot.h>
 
 #include <fdm_c172/c172_GFC700_AP.h>
 #include <fdm_c172/c172_KAP140_AP.h>
 #include <fdm_c172/c172_KFC325_AP.h>
 
+#include <sim/TripleBuffer.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
  * @brief Autopilot class.
+ *
+ * Autopilot is stepped by the simulation thread at the FDM rate, so its
+ * control loops do not depend on GUI event loop load. GUI thread functions
+ * (init, stop, buttons and settings) only queue commands which are executed
+ * by the simulation thread right before the next step, while state getters
+ * return the snapshot published after the most recent step and fetched by
+ * update().
+ *
+ * @see Simulation
  */
 class Autopilot
 {
 public:
 
+    /** Navigation data used by autopilot. */
+    struct Navigation
+    {
+        double dme_distance;        ///< [m] DME distance
+        double nav_deviation;       ///< [rad] VOR deviation
+        double ils_heading;         ///< [rad] ILS heading
+        double ils_lc_deviation;    ///< [rad] ILS localizer deviation
+        double ils_gs_deviation;    ///< [rad] ILS glide slope deviation
+
+        bool nav_active;            ///< specifies if VOR is active
+        bool ils_lc_visible;        ///< specifies if ILS localizer is visible
+        bool ils_gs_visible;        ///< specifies if ILS glide slope is visible
+    };
+
+    /** Autopilot flight controls commands. */
+    struct Controls
+    {
+        double ctrlRoll;            ///< [-1.0,1.0] roll command
+        double ctrlPitch;           ///< [-1.0,1.0] pitch command
+        double ctrlYaw;             ///< [-1.0,1.0] yaw damper command
+
+        bool ap_active;             ///< specifies if autopilot and flight director are active
+        bool yd_active;             ///< specifies if yaw damper is active
+    };
+
     Autopilot();
 
     /** @brief Autopilot class destructor. */
@@ -47,8 +88,31 @@ public:
     void init();
     void stop();
 
-    void update( double timeStep );
-    void update( double timeStep, bool btn_dn, bool btn_up );
+    /**
+     * @brief Fetches most recent autopilot state snapshot.
+     * Might be called only from the GUI thread.
+     */
+    void update();
+
+    /**
+     * @brief Steps autopilot.
+     * Might be called only from the simulation thread.
+     * @param timeStep [s] time step
+     * @param dataOut flight dynamics model output data of the previous step
+     * @param navigation navigation data
+     * @param disc specifies if autopilot disconnect is pressed
+     * @param controls autopilot flight controls commands
+     */
+    void step( double timeStep, const fdm::DataOut &dataOut,
+               const Navigation &navigation, bool disc,
+               Controls *controls );
+
+    /**
+     * @brief Sets up and down buttons state.
+     * @param btn_dn specifies if down button is pressed
+     * @param btn_up specifies if up button is pressed
+     */
+    void setButtons( bool btn_dn, bool btn_up );
 
     void onPressedAP();
     void onPressedFD();
@@ -75,56 +139,53 @@ public:
     void onPressedTest();
     void onReleasedTest();
 
-    double getAirspeed() const;
-    double getAltitude() const;
-    double getClimbRate() const;
-    double getHeading() const;
-
-    double getCmdRoll() const;
-    double getCmdPitch() const;
-
-    double getCtrlRoll() const;
-    double getCtrlPitch() const;
-    double getCtrlYaw() const;
-
-    bool getLampAP() const;
-    bool getLampFD() const;
-    bool getLampYD() const;
-    bool getLampALT() const;
-    bool getLampIAS() const;
-    bool getLampGS()  const;
-    bool getLampHDG() const;
-    bool getLampNAV() const;
-    bool getLampAPR() const;
-    bool getLampBC()  const;
-    bool getLampNAV_ARM() const;
-    bool getLampAPR_ARM() const;
-    bool getLampSR() const;
-    bool getLampHB() const;
-    bool getLampTRIM() const;
-    bool getLampVS()  const;
-    bool getLampARM() const;
-
-    double getMinAltitude()  const;
-    double getMaxAltitude()  const;
-    double getMinClimbRate() const;
-    double getMaxClimbRate() const;
-
-    bool isActiveAP() const;
-    bool isActiveFD() const;
-    bool isActiveYD() const;
-
-    bool isActiveALT() const;
-    bool isActiveIAS() const;
-    bool isActiveVS()  const;
-    bool isActiveARM() const;
-    bool isActiveGS()  const;
-    bool isActiveHDG() const;
-    bool isActiveNAV() const;
-    bool isActiveAPR() const;
-    bool isActiveBC()  const;
-
-    bool isInited() const;
+    inline double getAirspeed()  const { return _state.airspeed;  }
+    inline double getAltitude()  const { return _state.altitude;  }
+    inline double getClimbRate() const { return _state.climbRate; }
+    inline double getHeading()   const { return _state.heading;   }
+
+    inline double getCmdRoll()  const { return _state.cmdRoll;  }
+    inline double getCmdPitch() const { return _state.cmdPitch; }
+
+    inline bool getLampAP()  const { return _state.lampAP;  }
+    inline bool getLampFD()  const { return _state.lampFD;  }
+    inline bool getLampYD()  const { return _state.lampYD;  }
+    inline bool getLampALT() const { return _state.lampALT; }
+    inline bool getLampIAS() const { return _state.lampIAS; }
+    inline bool getLampGS()  const { return _state.lampGS;  }
+    inline bool getLampHDG() const { return _state.lampHDG; }
+    inline bool getLampNAV() const { return _state.lampNAV; }
+    inline bool getLampAPR() const { return _state.lampAPR; }
+    inline bool getLampBC()  const { return _state.lampBC;  }
+    inline bool getLampNAV_ARM() const { return _state.lampNAV_ARM; }
+    inline bool getLampAPR_ARM() const { return _state.lampAPR_ARM; }
+    inline bool getLampSR()   const { return _state.lampSR;   }
+    inline bool getLampHB()   const { return _state.lampHB;   }
+    inline bool getLampTRIM() const { return _state.lampTRIM; }
+    inline bool getLampVS()  const { return _state.lampVS;  }
+    inline bool getLampARM() const { return _state.lampARM; }
+
+    inline double getMinAltitude()  const { return _state.minAltitude;  }
+    inline double getMaxAltitude()  const { return _state.maxAltitude;  }
+    inline double getMinClimbRate() const { return _state.minClimbRate; }
+    inline double getMaxClimbRate() const { return _state.maxClimbRate; }
+
+    inline bool isActiveAP() const { return _state.activeAP; }
+    inline bool isActiveFD() const { return _state.activeFD; }
+    inline bool isActiveYD() const { return _state.activeYD; }
+
+    inline bool isActiveALT() const { return _state.activeALT; }
+    inline bool isActiveIAS() const { return _state.activeIAS; }
+    inline bool isActiveVS()  const { return _state.activeVS;  }
+    inline bool isActiveARM() const { return _state.activeARM; }
+    inline bool isActiveGS()  const { return _state.activeGS;  }
+    inline bool isActiveHDG() const { return _state.activeHDG; }
+    inline bool isActiveNAV() const { return _state.activeNAV; }
+    inline bool isActiveAPR() const { return _state.activeAPR; }
+    inline bool isActiveBC()  const { return _state.activeBC;  }
+
+    inline bool isInited() const { return _state.inited; }
+
     bool isWorking() const;
 
     void setAltitude( double altitude );
@@ -134,6 +195,109 @@ public:
 
 private:
 
+    /** GUI thread command. */
+    struct Command
+    {
+        /** Command type. */
+        enum Type
+        {
+            Init = 0,               ///< create autopilot, value is aircraft type
+            Stop,                   ///< destroy autopilot
+
+            PressedAP,              ///< AP button pressed
+            PressedFD,              ///< FD button pressed
+            PressedALT,             ///< ALT button pressed
+            PressedIAS,             ///< IAS button pressed
+            PressedENG,             ///< ENG button pressed
+            PressedARM,             ///< ARM button pressed
+            PressedVNV,             ///< VNV button pressed
+            PressedFLC,             ///< FLC button pressed
+            PressedVS,              ///< VS button pressed
+            PressedHDG,             ///< HDG button pressed, value is heading
+            PressedNAV,             ///< NAV button pressed, value is course
+            PressedAPR,             ///< APR button pressed
+            PressedBC,              ///< BC button pressed
+            PressedREV,             ///< REV button pressed
+            PressedYD,              ///< YD button pressed
+            PressedSoftRide,        ///< soft ride button pressed
+            PressedHalfBank,        ///< half bank button pressed
+            PressedTest,            ///< test button pressed
+            ReleasedTest,           ///< test button released
+
+            SetAltitude,            ///< set altitude, value is altitude
+            SetClimbRate,           ///< set climb rate, value is climb rate
+            SetCourse,              ///< set course, value is course
+            SetHeading              ///< set heading, value is heading
+        };
+
+        Type type;                  ///< command type
+        double value;               ///< command value
+    };
+
+    /** Autopilot state snapshot for GUI thread. */
+    struct State
+    {
+        double airspeed;            ///< [m/s] selected airspeed
+        double altitude;            ///< [m] selected altitude
+        double climbRate;           ///< [m/s] selected climb rate
+        double heading;             ///< [rad] selected heading
+
+        double cmdRoll;             ///< [rad] commanded roll
+        double cmdPitch;            ///< [rad] commanded pitch
+
+        double minAltitude;         ///< [m] minimum altitude
+        double maxAltitude;         ///< [m] maximum altitude
+        double minClimbRate;        ///< [m/s] minimum climb rate
+        double maxClimbRate;        ///< [m/s] maximum climb rate
+
+        bool lampAP;                ///<
+        bool lampFD;                ///<
+        bool lampYD;                ///<
+        bool lampALT;               ///<
+        bool lampIAS;               ///<
+        bool lampGS;                ///<
+        bool lampHDG;               ///<
+        bool lampNAV;               ///<
+        bool lampAPR;               ///<
+        bool lampBC;                ///<
+        bool lampNAV_ARM;           ///<
+        bool lampAPR_ARM;           ///<
+        bool lampSR;                ///<
+        bool lampHB;                ///<
+        bool lampTRIM;              ///<
+        bool lampVS;                ///<
+        bool lampARM;               ///<
+
+        bool activeAP;              ///<
+        bool activeFD;              ///<
+        bool activeYD;              ///<
+        bool activeALT;             ///<
+        bool activeIAS;             ///<
+        bool activeVS;              ///<
+        bool activeARM;             ///<
+        bool activeGS;              ///<
+        bool activeHDG;             ///<
+        bool activeNAV;             ///<
+        bool activeAPR;             ///<
+        bool activeBC;              ///<
+
+        bool inited;                ///< specifies if autopilot is created
+    };
+
+    typedef std::vector< Command > Commands;
+
+    std::mutex _mutex;                      ///< mutex guarding commands queue and buttons state
+
+    Commands _commands;                     ///< commands queued by GUI thread
+    Commands _pending;                      ///< commands being executed by simulation thread
+
+    bool _btn_dn;                           ///< down button state
+    bool _btn_up;                           ///< up button state
+
+    TripleBuffer< State > _stateBuffer;     ///< state snapshot channel
+
+    State _state;                           ///< most recent state snapshot (owned by GUI thread)
+
     fdm::Autopilot *_autopilot;             ///< autopilot
 
     fdm::C172_GFC700_AP *_c172_gfc700_ap;   ///< Cessna 172 Garmin GFC 700 autopilot
@@ -142,6 +306,28 @@ private:
 
     double _altitude;                       ///< [m]   desired altitude
     double _climbRate;                      ///< [m/s] desired climb rate
+
+    /** Using this constructor is forbidden. */
+    Autopilot( const Autopilot & ) {}
+
+    void push( Command::Type type, double value = 0.0 );
+
+    void execute( const Command &command, const fdm::DataOut &dataOut );
+
+    void create( int aircraftType );
+    void destroy();
+
+    void pressedFD( const fdm::DataOut::Flight &flight );
+    void pressedALT( const fdm::DataOut::Flight &flight );
+    void pressedIAS( const fdm::DataOut::Flight &flight );
+    void pressedENG( const fdm::DataOut::Flight &flight );
+    void pressedARM( const fdm::DataOut::Flight &flight );
+    void pressedHDG( const fdm::DataOut::Flight &flight, double hdg );
+    void pressedNAV( const fdm::DataOut::Flight &flight, double crs );
+    void pressedAPR( const fdm::DataOut::Flight &flight );
+    void pressedBC( const fdm::DataOut::Flight &flight );
+
+    void publishState();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
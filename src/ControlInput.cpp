@@ -0,0 +1,117 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <ControlInput.h>
+
+#include <algorithm>
+
+#include <hid/hid_Manager.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+hid::AxisTune ControlInput::_tuneRoll;
+hid::AxisTune ControlInput::_tunePitch;
+hid::AxisTune ControlInput::_tuneYaw;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ControlInput::update( double timeStep, const Commands &commands,
+                           fdm::DataInp *dataInp, Data::HID *hid )
+{
+    hid::Manager *manager = hid::Manager::instance();
+
+    if ( dataInp->stateInp == fdm::DataInp::Idle )
+    {
+        manager->reset( dataInp->initial.altitude_agl < FDM_MIN_INIT_ALTITUDE );
+    }
+
+    manager->update( timeStep );
+
+    // controls
+    double r_rv = manager->getCtrlRoll();
+    double p_rv = manager->getCtrlPitch();
+    double y_rv = manager->getCtrlYaw();
+
+    const Aircrafts::Axes &axes = commands.axes;
+
+    // response curves are rebuilt only when tuning changes
+    _tuneRoll  .setTuning( axes.roll.deadzone  , axes.roll.curvature  , axes.roll.scale  );
+    _tunePitch .setTuning( axes.pitch.deadzone , axes.pitch.curvature , axes.pitch.scale );
+    _tuneYaw   .setTuning( axes.yaw.deadzone   , axes.yaw.curvature   , axes.yaw.scale   );
+
+    fdm::DataInp::Controls &controls = dataInp->controls;
+
+    controls.roll         = -_tuneRoll  .getValue( r_rv );
+    controls.pitch        = -_tunePitch .getValue( p_rv );
+    controls.yaw          = -_tuneYaw   .getValue( y_rv );
+    controls.trim_roll    = -manager->getTrimRoll();
+    controls.trim_pitch   = -manager->getTrimPitch();
+    controls.trim_yaw     = -manager->getTrimYaw();
+    controls.brake_l      =  manager->getBrakeLeft();
+    controls.brake_r      =  manager->getBrakeRight();
+    controls.wheel_brake  =  std::max( manager->getBrakeLeft(), manager->getBrakeRight() );
+    controls.landing_gear =  manager->getLandingGear();
+    controls.wheel_nose   =  manager->getCtrlYaw();
+    controls.flaps        =  manager->getFlaps();
+    controls.airbrake     =  manager->getAirbrake();
+    controls.spoilers     =  manager->getSpoilers();
+    controls.collective   =  manager->getCollective();
+
+    controls.lgh = manager->isLgHandleDown();
+    controls.nws = commands.nws;
+    controls.abs = commands.abs;
+
+    if ( commands.ap_active && !manager->getCWS() )
+    {
+        controls.roll  -= commands.ap_ctrlRoll;
+        controls.pitch -= commands.ap_ctrlPitch;
+
+        controls.roll  = std::max( -1.0, std::min( 1.0, controls.roll  ) );
+        controls.pitch = std::max( -1.0, std::min( 1.0, controls.pitch ) );
+    }
+
+    if ( commands.yd_active )
+    {
+        controls.yaw -= commands.ap_ctrlYaw;
+        controls.yaw = std::max( -1.0, std::min( 1.0, controls.yaw ) );
+    }
+
+    // engines
+    for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        dataInp->engine[ i ].throttle  = manager->getThrottle  ( i );
+        dataInp->engine[ i ].mixture   = manager->getMixture   ( i );
+        dataInp->engine[ i ].propeller = manager->getPropeller ( i );
+    }
+
+    // raw values for GUI
+    hid->ctrl_roll  = manager->getCtrlRoll();
+    hid->ctrl_pitch = manager->getCtrlPitch();
+    hid->ctrl_yaw   = manager->getCtrlYaw();
+    hid->trim_roll  = manager->getTrimRoll();
+    hid->trim_pitch = manager->getTrimPitch();
+    hid->trim_yaw   = manager->getTrimYaw();
+    hid->collective = manager->getCollective();
+
+    hid->ap_disc = manager->getAP_Disc();
+    hid->cws     = manager->getCWS();
+}
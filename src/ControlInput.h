@@ -0,0 +1,87 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CONTROLINPUT_H
+#define CONTROLINPUT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_DataInp.h>
+
+#include <gui/Aircrafts.h>
+
+#include <hid/hid_AxisTune.h>
+
+#include <Data.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Control input pipeline class.
+ *
+ * Polls human interface devices, shapes axes and mixes autopilot commands
+ * into flight dynamics model input data. It is run by the simulation thread
+ * right before each step, so control input latency does not depend on GUI
+ * event loop load. Settings and autopilot commands are provided by the GUI
+ * thread as a snapshot.
+ *
+ * @see Simulation
+ */
+class ControlInput
+{
+public:
+
+    /** GUI thread commands snapshot. */
+    struct Commands
+    {
+        Aircrafts::Axes axes;       ///< current aircraft axes tuning data
+
+        double ap_ctrlRoll;         ///< [-1.0,1.0] autopilot roll command
+        double ap_ctrlPitch;        ///< [-1.0,1.0] autopilot pitch command
+        double ap_ctrlYaw;          ///< [-1.0,1.0] yaw damper command
+
+        bool ap_active;             ///< specifies if autopilot and flight director are active
+        bool yd_active;             ///< specifies if yaw damper is active
+
+        bool nws;                   ///< nose wheel steering
+        bool abs;                   ///< anti-skid braking system
+    };
+
+    /**
+     * @brief Updates flight dynamics model controls input data.
+     * @param timeStep [s] time step
+     * @param commands GUI thread commands
+     * @param dataInp flight dynamics model input data
+     * @param hid human interface devices raw data
+     */
+    static void update( double timeStep, const Commands &commands,
+                        fdm::DataInp *dataInp, Data::HID *hid );
+
+private:
+
+    static hid::AxisTune _tuneRoll;     ///< roll axis response curve
+    static hid::AxisTune _tunePitch;    ///< pitch axis response curve
+    static hid::AxisTune _tuneYaw;      ///< yaw axis response curve
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CONTROLINPUT_H
@@ -26,6 +26,9 @@
 
 #include <fdm/fdm_DataInp.h>
 #include <fdm/fdm_DataOut.h>
+#include <fdm/fdm_Types.h>
+
+#include <Defines.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -156,6 +159,19 @@ public:
             bool stall;                     ///< stall flag
         };
 
+        /** Ownship pose at render time. */
+        struct Ownship
+        {
+            double pos_x_wgs;               ///< [m] postion x coordinate expressed in WGS
+            double pos_y_wgs;               ///< [m] postion y coordinate expressed in WGS
+            double pos_z_wgs;               ///< [m] postion z coordinate expressed in WGS
+
+            double att_e0_wgs;              ///< [-] attitude quaternion e0 component expressed as rotation from WGS to BAS
+            double att_ex_wgs;              ///< [-] attitude quaternion ex component expressed as rotation from WGS to BAS
+            double att_ey_wgs;              ///< [-] attitude quaternion ey component expressed as rotation from WGS to BAS
+            double att_ez_wgs;              ///< [-] attitude quaternion ez component expressed as rotation from WGS to BAS
+        };
+
         /** Sky dome data. */
         struct SkyDome
         {
@@ -199,6 +215,7 @@ public:
         Camera      camera;                 ///< camera data
         Environment environment;            ///< environment data
         HUD         hud;                    ///< HUD data
+        Ownship     ownship;                ///< ownship pose at render time (dead reckoned)
         SkyDome     skyDome;                ///< sky dome data
         Vector      vector;                 ///< vector data
         Rotor       rotor;                  /// rotor data
@@ -223,6 +240,28 @@ public:
         unsigned short second;              ///< [0..59] second
     };
 
+    /** Other simulated aircraft data. */
+    struct Entities
+    {
+        /** Entity data. */
+        struct Entity
+        {
+            fdm::UInt32 id;                 ///< entity ID
+
+            double pos_x_wgs;               ///< [m] postion x coordinate expressed in WGS
+            double pos_y_wgs;               ///< [m] postion y coordinate expressed in WGS
+            double pos_z_wgs;               ///< [m] postion z coordinate expressed in WGS
+
+            double att_e0_wgs;              ///< [-] attitude quaternion e0 component expressed as rotation from WGS to BAS
+            double att_ex_wgs;              ///< [-] attitude quaternion ex component expressed as rotation from WGS to BAS
+            double att_ey_wgs;              ///< [-] attitude quaternion ey component expressed as rotation from WGS to BAS
+            double att_ez_wgs;              ///< [-] attitude quaternion ez component expressed as rotation from WGS to BAS
+        };
+
+        unsigned int count;                 ///< number of entities
+        Entity entity[ SIM_MAX_ENTITIES ];  ///< entities data
+    };
+
     /** Environment data. */
     struct Environment
     {
@@ -239,6 +278,21 @@ public:
         WindShear  windShear;               ///< wind shear model type
     };
 
+    /** Human interface devices raw data. */
+    struct HID
+    {
+        double ctrl_roll;                   ///< [-1.0,1.0] roll control
+        double ctrl_pitch;                  ///< [-1.0,1.0] pitch control
+        double ctrl_yaw;                    ///< [-1.0,1.0] yaw control
+        double trim_roll;                   ///< [-1.0,1.0] roll trim
+        double trim_pitch;                  ///< [-1.0,1.0] pitch trim
+        double trim_yaw;                    ///< [-1.0,1.0] yaw trim
+        double collective;                  ///< [0.0,1.0] collective
+
+        bool ap_disc;                       ///< autopilot disconnect
+        bool cws;                           ///< control wheel steering
+    };
+
     /** Navigation data. */
     struct Navigation
     {
@@ -305,6 +359,8 @@ public:
 
         char aircraftFile[ 1024 ];          ///< ownship model file path
 
+        double time;                        ///< [s] monotonic clock time of the FDM frame
+
         double latitude;                    ///< [rad] geodetic latitude
         double longitude;                   ///< [rad] geodetic longitude
 
@@ -351,6 +407,10 @@ public:
         double vel_north;                   ///< [m/s] north velocity
         double vel_east;                    ///< [m/s] east velocity
 
+        double vel_u_bas;                   ///< [m/s] velcoity u component expressed in BAS
+        double vel_v_bas;                   ///< [m/s] velcoity v component expressed in BAS
+        double vel_w_bas;                   ///< [m/s] velcoity w component expressed in BAS
+
         double ailerons;                    ///< [rad] ailerons deflection (positive left aileron in the upward direction)
         double elevator;                    ///< [rad] elevator deflection (positive in the downward direction)
         double elevons;                     ///< [rad] elevons differential deflection
@@ -413,6 +473,13 @@ public:
         double volume;                      ///< sound volume
     };
 
+    /** Render benchmark data (used only if SIM_RENDER_BENCHMARK is defined). */
+    struct Benchmark
+    {
+        unsigned int frameInp;              ///< number of rendered frames simulation is requested to step
+        unsigned int frameOut;              ///< number of rendered frames simulation has stepped
+    };
+
     /** Simulation data struct. */
     struct DataBuf
     {
@@ -429,8 +496,10 @@ public:
         CGI         cgi;                    ///< CGI data
         Controls    controls;               ///< controls data
         DateTime    dateTime;               ///< date time data
+        Entities    entities;               ///< other simulated aircraft data
         Environment environment;            ///< environment data
         Ground      ground;                 ///< ground data
+        HID         hid;                    ///< HID raw data
         Initial     initial;                ///< initial conditions
         Masses      masses;                 ///< masses data
         Navigation  navigation;             ///< navigation data
@@ -439,6 +508,8 @@ public:
         Recording   recording;              ///< recording data
         SFX         sfx;                    ///< SFX data
 
+        Benchmark benchmark;                ///< render benchmark data
+
         AircraftType aircraftType;          ///< input aircraft type
 
         StateInp stateInp;                  ///< simulation input state
@@ -446,6 +517,7 @@ public:
 
         double timeCoef;                    ///< [-] time coefficient
         double timeStep;                    ///< [s] simulation time step
+        double timeCoefMax;                 ///< [-] achievable time coefficient
 
         bool freezePosition;                ///< specifies if aircraft position is to be frozen
         bool freezeAttitude;                ///< specifies if aircraft attitude is to be frozen
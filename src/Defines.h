@@ -61,4 +61,215 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifndef SIM_MAX_ENTITIES
+#   define SIM_MAX_ENTITIES 16                  ///< maximum number of simulated aircraft other than ownship
+#endif
+
+#ifndef SIM_FLEET_THREADS
+#   define SIM_FLEET_THREADS 0                  ///< number of threads stepping aircraft, 0 means number of hardware threads
+#endif
+
+#ifndef SIM_WINGMEN
+#   define SIM_WINGMEN 0                        ///< number of wingmen flying ownship inputs in echelon formation
+#endif
+
+#ifndef SIM_WINGMEN_SPACING
+#   define SIM_WINGMEN_SPACING 30.0             ///< [m] wingmen longitudinal and lateral spacing
+#endif
+
+#ifdef SIM_OSG_SHARED_CONTEXT
+#   undef SIM_OSG_THREADING_MODEL /* shared context is drawn by GUI thread only */
+#endif
+
+#ifndef SIM_OSG_THREADING_MODEL
+#   define SIM_OSG_THREADING_MODEL SingleThreaded   ///< OTW and CGI viewers threading model (osgViewer::ViewerBase::ThreadingModel)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_REALTIME_SCHEDULER
+#   ifndef SIM_REALTIME_STEP
+#       define SIM_REALTIME_STEP FDM_TIME_STEP   ///< [s] real-time scheduler period
+#   endif
+#   ifndef SIM_REALTIME_PRIORITY
+#       define SIM_REALTIME_PRIORITY 0          ///< SCHED_FIFO priority, 0 means unchanged
+#   endif
+#   ifndef SIM_REALTIME_CPU
+#       define SIM_REALTIME_CPU -1              ///< CPU index, negative means no pinning
+#   endif
+#endif
+
+#ifdef SIM_THREAD_PLACEMENT
+#   ifndef SIM_PLACEMENT_SIM_CORES
+#       define SIM_PLACEMENT_SIM_CORES 1        ///< simulation thread dedicated physical cores, 0 means shared, negative means not pinned
+#   endif
+#   ifndef SIM_PLACEMENT_RENDER_CORES
+#       define SIM_PLACEMENT_RENDER_CORES 1     ///< render (GUI) thread dedicated physical cores
+#   endif
+#   ifndef SIM_PLACEMENT_SFX_CORES
+#       define SIM_PLACEMENT_SFX_CORES 0        ///< sound thread dedicated physical cores
+#   endif
+#   ifndef SIM_PLACEMENT_WORKER_CORES
+#       define SIM_PLACEMENT_WORKER_CORES 0     ///< worker pools dedicated physical cores
+#   endif
+#   ifndef SIM_PLACEMENT_NUMA_NODE
+#       define SIM_PLACEMENT_NUMA_NODE -1       ///< NUMA node all threads are placed on, negative means any node
+#   endif
+#   ifndef SIM_PLACEMENT_AVOID_SIBLINGS
+#       define SIM_PLACEMENT_AVOID_SIBLINGS 1   ///< specifies if hyperthread siblings of dedicated cores are left idle
+#   endif
+#   ifndef SIM_PLACEMENT_ISOLATE_RENDER
+#       define SIM_PLACEMENT_ISOLATE_RENDER 1   ///< specifies if render dedicated cores are not shared with other threads
+#   endif
+#endif
+
+#ifndef SIM_FDM_POOL_SIZE
+#   define SIM_FDM_POOL_SIZE 2                  ///< number of recently used aircraft types kept pre-built for ownship
+#endif
+
+#ifndef SIM_TIME_ACCEL_MAX_STEPS
+#   define SIM_TIME_ACCEL_MAX_STEPS 200         ///< maximum number of fixed steps made per simulation tick when time is accelerated
+#endif
+#ifndef SIM_TIME_ACCEL_BUDGET
+#   define SIM_TIME_ACCEL_BUDGET 0.5            ///< [-] fraction of simulation tick period fixed steps might take when time is accelerated
+#endif
+
+#ifdef FDM_LOCKSTEP
+#   ifndef SIM_LOCKSTEP_MAX_STEPS
+#       define SIM_LOCKSTEP_MAX_STEPS 10        ///< maximum number of fixed steps made to catch up with wall-clock time
+#   endif
+#endif
+
+#ifdef SIM_REMOTE_FDM
+#   ifndef SIM_REMOTE_FDM_ADDRESS
+#       define SIM_REMOTE_FDM_ADDRESS "127.0.0.1"      ///< FDM server address
+#   endif
+#   ifndef SIM_REMOTE_FDM_PORT
+#       define SIM_REMOTE_FDM_PORT 47702                ///< FDM server port
+#   endif
+#   ifndef SIM_REMOTE_FDM_REDUNDANCY
+#       define SIM_REMOTE_FDM_REDUNDANCY 2              ///< number of copies of every input datagram sent
+#   endif
+#   ifndef SIM_REMOTE_FDM_TIMEOUT
+#       define SIM_REMOTE_FDM_TIMEOUT 1.0               ///< [s] time without output data after which server is considered disconnected
+#   endif
+#endif
+
+#ifdef SIM_SHARED_DATAOUT
+#   ifndef SIM_SHARED_DATAOUT_NAME
+#       define SIM_SHARED_DATAOUT_NAME "mscsim_dataout"    ///< FDM output data shared memory segment name
+#   endif
+#endif
+
+#ifdef SIM_DATAOUT_STREAM
+#   ifndef SIM_DATAOUT_STREAM_ADDRESS
+#       define SIM_DATAOUT_STREAM_ADDRESS "239.255.77.1"  ///< FDM output data stream destination (multicast group) address
+#   endif
+#   ifndef SIM_DATAOUT_STREAM_PORT
+#       define SIM_DATAOUT_STREAM_PORT 47701               ///< FDM output data stream destination port
+#   endif
+#   ifndef SIM_DATAOUT_STREAM_TTL
+#       define SIM_DATAOUT_STREAM_TTL 1                    ///< FDM output data stream multicast time-to-live
+#   endif
+#   ifndef SIM_DATAOUT_STREAM_FRAME_RATE
+#       define SIM_DATAOUT_STREAM_FRAME_RATE 60.0          ///< [Hz] FDM output data stream frame rate
+#   endif
+#   ifndef SIM_DATAOUT_STREAM_SEND_RATE
+#       define SIM_DATAOUT_STREAM_SEND_RATE 20.0           ///< [Hz] FDM output data stream datagram rate
+#   endif
+#endif
+
+#ifdef FDM_METRICS
+#   ifndef SIM_METRICS_ADDRESS
+#       define SIM_METRICS_ADDRESS "127.0.0.1"     ///< StatsD server address
+#   endif
+#   ifndef SIM_METRICS_PORT
+#       define SIM_METRICS_PORT 8125                ///< StatsD server port
+#   endif
+#   ifndef SIM_METRICS_INTERVAL
+#       define SIM_METRICS_INTERVAL 10.0            ///< [s] metrics export interval
+#   endif
+#   ifndef SIM_METRICS_PREFIX
+#       define SIM_METRICS_PREFIX "mscsim"          ///< metrics names prefix (followed by host name)
+#   endif
+#endif
+
+#ifdef SIM_LOW_POWER_IDLE
+#   ifndef SIM_IDLE_TIME_STEP
+#       define SIM_IDLE_TIME_STEP 0.1           ///< [s] GUI, CGI and sound timers period while idle or paused
+#   endif
+#   ifndef SIM_IDLE_WAIT
+#       define SIM_IDLE_WAIT 0.1                ///< [s] maximum time simulation thread is blocked while idle or paused
+#   endif
+#   ifndef SIM_IDLE_REDRAW
+#       define SIM_IDLE_REDRAW 1.0              ///< [s] frozen OTW view redraw period without user input
+#   endif
+#endif
+
+#ifdef SIM_HEAD_TRACKING
+#   ifndef SIM_HEAD_TRACKING_PORT
+#       define SIM_HEAD_TRACKING_PORT 4242      ///< OpenTrack UDP output port
+#   endif
+#   ifndef SIM_HEAD_TRACKING_LEAD
+#       define SIM_HEAD_TRACKING_LEAD 0.011     ///< [s] latched pose to photon latency compensated by prediction
+#   endif
+#   ifndef SIM_HEAD_TRACKING_HORIZON
+#       define SIM_HEAD_TRACKING_HORIZON 0.05   ///< [s] maximum head pose prediction horizon
+#   endif
+#   ifndef SIM_HEAD_TRACKING_TIMEOUT
+#       define SIM_HEAD_TRACKING_TIMEOUT 0.5    ///< [s] time without head poses after which pilot view is restored
+#   endif
+#endif
+
+#ifdef SIM_CLUSTER_SYNC
+#   ifndef SIM_CLUSTER_MASTER
+#       define SIM_CLUSTER_MASTER 1             ///< specifies if node is cluster master (1) or slave (0)
+#   endif
+#   ifndef SIM_CLUSTER_ADDRESS
+#       define SIM_CLUSTER_ADDRESS "239.255.77.2"   ///< cluster multicast group address
+#   endif
+#   ifndef SIM_CLUSTER_PORT
+#       define SIM_CLUSTER_PORT 47703           ///< cluster multicast group port
+#   endif
+#   ifndef SIM_CLUSTER_SLAVES
+#       define SIM_CLUSTER_SLAVES 2             ///< number of slaves master waits for at swap barrier
+#   endif
+#   ifndef SIM_CLUSTER_FRAME_TIMEOUT
+#       define SIM_CLUSTER_FRAME_TIMEOUT 0.05   ///< [s] maximum time slave waits for master frame before dead reckoning
+#   endif
+#   ifndef SIM_CLUSTER_SWAP_TIMEOUT
+#       define SIM_CLUSTER_SWAP_TIMEOUT 0.005   ///< [s] maximum swap barrier waiting time
+#   endif
+#endif
+
+#ifdef SIM_EVENT_SCRIPT
+#   ifndef SIM_EVENT_SCRIPT_FILE
+#       define SIM_EVENT_SCRIPT_FILE "event_script.xml"        ///< scenario events script file path
+#   endif
+#endif
+
+#ifdef SIM_REPLAY_DIRECT
+#   ifndef SIM_REPLAY_RATE
+#       define SIM_REPLAY_RATE 1.0              ///< [-] direct replay rate, negative replays backwards (binary recordings only)
+#   endif
+#endif
+
+#if defined(SIM_RENDER_BENCHMARK) && defined(SIM_REMOTE_FDM)
+#   undef SIM_RENDER_BENCHMARK /* remote FDM is not stepped by rendered frames */
+#endif
+
+#ifdef SIM_RENDER_BENCHMARK
+#   ifndef SIM_RENDER_BENCHMARK_FILE
+#       define SIM_RENDER_BENCHMARK_FILE "render_benchmark.xml"     ///< render benchmark scenes file path
+#   endif
+#   ifndef SIM_RENDER_BENCHMARK_RESULTS
+#       define SIM_RENDER_BENCHMARK_RESULTS "render_benchmark.csv"  ///< render benchmark results file path
+#   endif
+#   ifndef SIM_RENDER_BENCHMARK_FRAME_STEPS
+#       define SIM_RENDER_BENCHMARK_FRAME_STEPS 2   ///< number of fixed FDM steps simulated per rendered frame
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 #endif // DEFINES_H
@@ -27,14 +27,17 @@
 
 #include <Data.h>
 
+#include <fdm/utils/fdm_ThreadPlacement.h>
+#include <fdm/utils/fdm_Time.h>
 #include <fdm/utils/fdm_Units.h>
 
 #include <gui/Aircrafts.h>
 
-#include <hid/hid_AxisTune.h>
 #include <hid/hid_Manager.h>
 
+#include <sim/IdleMode.h>
 #include <sim/Log.h>
+#include <sim/TaskGraph.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -53,11 +56,21 @@ Manager::Manager() :
 
     _g1000_ifd ( NULLPTR ),
 
+    _dataOutTime ( 0.0 ),
+
     _timerSim ( NULLPTR ),
     _timerOut ( NULLPTR ),
 
     _timeStep ( 0.0 ),
 
+    _startTime ( fdm::Time::get() ),
+
+    _firstFrame ( false ),
+
+#   ifdef SIM_LOW_POWER_IDLE
+    _idle ( false ),
+#   endif
+
     _timerId ( 0 )
 {
     _ap  = new Autopilot();
@@ -66,9 +79,13 @@ Manager::Manager() :
     _sim = new Simulation();
     _win = new MainWindow();
 
+    _sim->setAutopilot( _ap );
+
     _g1000_ifd = new g1000::IFD();
     memset( &_g1000_input, 0, sizeof( g1000::Input ) );
 
+    memset( &_dataOut, 0, sizeof( fdm::DataOut ) );
+
     _timerSim = new QElapsedTimer();
     _timerOut = new QElapsedTimer();
 }
@@ -89,6 +106,8 @@ Manager::~Manager()
 
     if ( _sim )
     {
+        _sim->requestInterruption();
+
         while ( _sim->isRunning() )
         {
             _sim->quit();
@@ -111,6 +130,18 @@ Manager::~Manager()
 
 void Manager::init()
 {
+    // independent loaders run while splash screen is shown, GUI and OpenGL
+    // objects are created in the GUI thread once their dependencies are done
+    TaskGraph startup( 2 );
+
+    int task_navdb = startup.add( "nav database", [](){ nav::DataBase::instance(); } );
+    int task_hid   = startup.add( "hid",          [](){ hid::Manager::instance()->init(); } );
+
+    startup.start();
+
+    // sound samples are loaded by SFX thread itself
+    _sfx->init();
+
     QPixmap pixmap(":/gui/images/splashscreen.png");
     QSplashScreen splash( pixmap );
     splash.show();
@@ -126,19 +157,18 @@ void Manager::init()
         qApp->processEvents();
     }
 
-    qRegisterMetaType< Data::DataBuf >( "Data::DataBuf" );
-    qRegisterMetaType< fdm::DataOut  >( "fdm::DataOut"  );
-
-    connect( this, SIGNAL(dataInpUpdated(const Data::DataBuf*)), _sim, SLOT(onDataInpUpdated(const Data::DataBuf*)) );
-    connect( this, SIGNAL(dataInpUpdated(const Data::DataBuf*)), _sfx, SLOT(onDataInpUpdated(const Data::DataBuf*)) );
-
-    connect( _sim, SIGNAL(dataOutUpdated(const fdm::DataOut&)), this, SLOT(onDataOutUpdated(const fdm::DataOut&)) );
-
-    hid::Manager::instance()->init();
+    // viewers are single threaded, so cull and draw run in the GUI thread
+    if ( !fdm::ThreadPlacement::apply( fdm::ThreadPlacement::Render ) )
+    {
+        Log::w() << "Cannot set render thread CPU affinity." << std::endl;
+    }
 
-    _sfx->init();
+    // simulation thread polls devices
+    startup.wait( task_hid );
     _sim->init();
 
+    // map icons are created from navigation database
+    startup.wait( task_navdb );
     _win->setup( _ap, _g1000_ifd );
     _win->show();
     splash.finish( _win );
@@ -150,6 +180,8 @@ void Manager::init()
 
     _timerSim->start();
     _timerOut->start();
+
+    startup.report( _startTime );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -160,20 +192,21 @@ void Manager::timerEvent( QTimerEvent *event )
     QObject::timerEvent( event );
     /////////////////////////////
 
-    _timeStep = Data::get()->timeCoef * (double)_timerSim->restart() / 1000.0;
-
-    if ( Data::get()->stateInp == fdm::DataInp::Idle )
+    if ( !_firstFrame && WidgetOSG::getFirstFrameTime() > 0.0 )
     {
-        hid::Manager::instance()->reset( Data::get()->initial.altitude_agl < FDM_MIN_INIT_ALTITUDE );
+        _firstFrame = true;
+        Log::i() << "Time to first frame: " << WidgetOSG::getFirstFrameTime() - _startTime << " s" << std::endl;
     }
-    else if ( Data::get()->stateInp == fdm::DataInp::Work )
+
+    _timeStep = Data::get()->timeCoef * (double)_timerSim->restart() / 1000.0;
+
+    if ( _sim->getDataOut( &_dataOut, &_dataOutTime, Data::get() ) )
     {
-        // TODO
+        onDataOutUpdated( _dataOut, _dataOutTime );
     }
 
-    hid::Manager::instance()->update( _timeStep );
-
-    _ap->update( _timeStep );
+    // devices are polled and autopilot is stepped by the simulation thread
+    _ap->update();
 
     updatedInputG1000();
     _g1000_ifd->update( _timeStep, _g1000_input );
@@ -182,71 +215,30 @@ void Manager::timerEvent( QTimerEvent *event )
     _nav->setFreqNAV( 1000 * _win->getFreqNav() );
     _nav->update();
 
-    // controls
-    double r_rv = hid::Manager::instance()->getCtrlRoll();
-    double p_rv = hid::Manager::instance()->getCtrlPitch();
-    double y_rv = hid::Manager::instance()->getCtrlYaw();
-
-    Aircrafts::Aircraft aircraft = _win->getCurrentAircraft();
-
-    double r_d = aircraft.axes.roll.deadzone;
-    double r_c = aircraft.axes.roll.curvature;
-    double r_s = aircraft.axes.roll.scale;
-
-    double p_d = aircraft.axes.pitch.deadzone;
-    double p_c = aircraft.axes.pitch.curvature;
-    double p_s = aircraft.axes.pitch.scale;
-
-    double y_d = aircraft.axes.yaw.deadzone;
-    double y_c = aircraft.axes.yaw.curvature;
-    double y_s = aircraft.axes.yaw.scale;
-
-    Data::get()->controls.roll         = -hid::AxisTune::getAxisTune( r_rv, r_d, r_c, r_s );
-    Data::get()->controls.pitch        = -hid::AxisTune::getAxisTune( p_rv, p_d, p_c, p_s );
-    Data::get()->controls.yaw          = -hid::AxisTune::getAxisTune( y_rv, y_d, y_c, y_s );
-    Data::get()->controls.trim_roll    = -hid::Manager::instance()->getTrimRoll();
-    Data::get()->controls.trim_pitch   = -hid::Manager::instance()->getTrimPitch();
-    Data::get()->controls.trim_yaw     = -hid::Manager::instance()->getTrimYaw();
-    Data::get()->controls.brake_l      =  hid::Manager::instance()->getBrakeLeft();
-    Data::get()->controls.brake_r      =  hid::Manager::instance()->getBrakeRight();
-    Data::get()->controls.wheel_brake  =  std::max( hid::Manager::instance()->getBrakeLeft(), hid::Manager::instance()->getBrakeRight() );
-    Data::get()->controls.landing_gear =  hid::Manager::instance()->getLandingGear();
-    Data::get()->controls.wheel_nose   =  hid::Manager::instance()->getCtrlYaw();
-    Data::get()->controls.flaps        =  hid::Manager::instance()->getFlaps();
-    Data::get()->controls.airbrake     =  hid::Manager::instance()->getAirbrake();
-    Data::get()->controls.spoilers     =  hid::Manager::instance()->getSpoilers();
-    Data::get()->controls.collective   =  hid::Manager::instance()->getCollective();
-
-    Data::get()->controls.lgh = hid::Manager::instance()->isLgHandleDown();
-    Data::get()->controls.nws = _win->getNWS();
-    Data::get()->controls.abs = _win->getABS();
-
-    if ( _ap->isActiveAP() && _ap->isActiveFD() && !hid::Manager::instance()->getCWS() )
-    {
-        Data::get()->controls.roll  -= _ap->getCtrlRoll();
-        Data::get()->controls.pitch -= _ap->getCtrlPitch();
+    // control input commands
+    ControlInput::Commands commands;
 
-        Data::get()->controls.roll  = std::max( -1.0, std::min( 1.0, Data::get()->controls.roll  ) );
-        Data::get()->controls.pitch = std::max( -1.0, std::min( 1.0, Data::get()->controls.pitch ) );
-    }
+    commands.axes = _win->getCurrentAircraft().axes;
 
-    if ( _ap->isActiveYD() )
-    {
-        Data::get()->controls.yaw -= _ap->getCtrlYaw();
-        Data::get()->controls.yaw = std::max( -1.0, std::min( 1.0, Data::get()->controls.yaw ) );
-    }
+    // autopilot commands are set by the simulation thread, see Simulation
+    commands.ap_ctrlRoll  = 0.0;
+    commands.ap_ctrlPitch = 0.0;
+    commands.ap_ctrlYaw   = 0.0;
 
-    // engines
-    for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
-    {
-        Data::get()->propulsion.engine[ i ].throttle  = hid::Manager::instance()->getThrottle  ( i );
-        Data::get()->propulsion.engine[ i ].mixture   = hid::Manager::instance()->getMixture   ( i );
-        Data::get()->propulsion.engine[ i ].propeller = hid::Manager::instance()->getPropeller ( i );
-    }
+    commands.ap_active = false;
+    commands.yd_active = false;
+
+    commands.nws = _win->getNWS();
+    commands.abs = _win->getABS();
 
-    ///////////////////////////////////
-    emit dataInpUpdated( Data::get() );
-    ///////////////////////////////////
+    _sim->setDataInp( Data::get(), commands );
+    _sfx->setData( Data::get() );
+
+#   ifdef SIM_LOW_POWER_IDLE
+    // input is already published, so simulation thread woken up on mode change fetches it
+    IdleMode::update( Data::get()->stateInp, Data::get()->stateOut );
+    IdleMode::updateTimer( this, &_timerId, &_idle, FDM_TIME_STEP, SIM_IDLE_TIME_STEP );
+#   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -295,7 +287,7 @@ void Manager::updatedInputG1000( const fdm::DataOut &dataOut )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::onDataOutUpdated( const fdm::DataOut &dataOut )
+void Manager::onDataOutUpdated( const fdm::DataOut &dataOut, double time )
 {
     double dt = Data::get()->timeCoef * (double)_timerOut->restart() / 1000.0;
 
@@ -341,6 +333,8 @@ void Manager::onDataOutUpdated( const fdm::DataOut &dataOut )
 
     Data::get()->ownship.tailRotor.azimuth     = dataOut.rotor.tailRotor_azimuth;
 
+    Data::get()->ownship.time = time;
+
     Data::get()->ownship.latitude  = dataOut.flight.latitude;
     Data::get()->ownship.longitude = dataOut.flight.longitude;
 
@@ -387,6 +381,10 @@ void Manager::onDataOutUpdated( const fdm::DataOut &dataOut )
     Data::get()->ownship.vel_north = dataOut.flight.vel_north;
     Data::get()->ownship.vel_east  = dataOut.flight.vel_east;
 
+    Data::get()->ownship.vel_u_bas = dataOut.flight.vel_u_bas;
+    Data::get()->ownship.vel_v_bas = dataOut.flight.vel_v_bas;
+    Data::get()->ownship.vel_w_bas = dataOut.flight.vel_w_bas;
+
     Data::get()->ownship.ailerons    = dataOut.controls.ailerons;
     Data::get()->ownship.elevator    = dataOut.controls.elevator;
     Data::get()->ownship.elevons     = dataOut.controls.elevons;
@@ -396,9 +394,9 @@ void Manager::onDataOutUpdated( const fdm::DataOut &dataOut )
     Data::get()->ownship.lef         = dataOut.controls.lef;
     Data::get()->ownship.airbrake    = dataOut.controls.airbrake;
 
-    Data::get()->ownship.norm_airbrake    = hid::Manager::instance()->getAirbrake();
-    Data::get()->ownship.norm_flaps       = hid::Manager::instance()->getFlaps();
-    Data::get()->ownship.norm_landingGear = hid::Manager::instance()->getLandingGear();
+    Data::get()->ownship.norm_airbrake    = Data::get()->controls.airbrake;
+    Data::get()->ownship.norm_flaps       = Data::get()->controls.flaps;
+    Data::get()->ownship.norm_landingGear = Data::get()->controls.landing_gear;
 
     if ( dataOut.stateOut == fdm::DataOut::Working )
     {
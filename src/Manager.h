@@ -28,6 +28,7 @@
 
 #include <g1000/sim/g1000_IFD.h>
 #include <gui/MainWindow.h>
+#include <gui/WidgetOSG.h>
 #include <nav/nav_Manager.h>
 #include <sfx/sfx_Thread.h>
 
@@ -38,6 +39,9 @@
 
 /**
  * @brief Simulation manager class.
+ *
+ * Startup loaders which do not depend on each other run in parallel,
+ * see TaskGraph. Startup tasks times and time to first frame are logged.
  */
 class Manager : public QObject
 {
@@ -52,10 +56,6 @@ public:
 
     void init();
 
-signals:
-
-    void dataInpUpdated( const Data::DataBuf *data );
-
 protected:
 
     void timerEvent( QTimerEvent *event );
@@ -71,19 +71,28 @@ private:
     g1000::IFD *_g1000_ifd;     ///< G1000 Integrated Flight Deck
     g1000::Input _g1000_input;  ///< G1000 Integrated Flight Deck input data
 
+    fdm::DataOut _dataOut;      ///< most recent flight dynamics model output data
+    double _dataOutTime;        ///< [s] monotonic clock time of the most recent output data
+
     QElapsedTimer *_timerSim;   ///< elapsed timer
     QElapsedTimer *_timerOut;   ///< elapsed timer
 
     double _timeStep;           ///< [s] time step
 
+    double _startTime;          ///< [s] monotonic clock time when startup began
+
+    bool _firstFrame;           ///< specifies if time to first frame has been reported
+
+#   ifdef SIM_LOW_POWER_IDLE
+    bool _idle;                 ///< specifies if timer ticks with idle period
+#   endif
+
     int _timerId;               ///< timer Id
 
     void updatedInputG1000();
     void updatedInputG1000( const fdm::DataOut &dataOut );
 
-private slots:
-
-    void onDataOutUpdated( const fdm::DataOut &dataOut );
+    void onDataOutUpdated( const fdm::DataOut &dataOut, double time );
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -22,8 +22,76 @@
 
 #include <Simulation.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <cgi/cgi_DeadReckoning.h>
+
+#include <fdm/utils/fdm_ThreadPlacement.h>
+#include <fdm/utils/fdm_Time.h>
+
+#include <sim/IdleMode.h>
 #include <sim/Log.h>
 
+#ifdef SIM_EVENT_SCRIPT
+#   include <sim/Path.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/**
+ * @brief Updates value if it differs from the given one.
+ * @param value value to be updated
+ * @param other new value
+ * @return true if value has changed, false otherwise
+ */
+template < typename TYPE >
+inline bool updateValue( TYPE *value, const TYPE &other )
+{
+    if ( (*value) != other )
+    {
+        (*value) = other;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Copies input data which might change every tick.
+ * @param src source input data
+ * @param dst destination input data
+ */
+void copyHot( const fdm::DataInp &src, fdm::DataInp *dst )
+{
+    dst->environment.temperature_0  = src.environment.temperature_0;
+    dst->environment.pressure_0     = src.environment.pressure_0;
+    dst->environment.wind_direction = src.environment.wind_direction;
+    dst->environment.wind_speed     = src.environment.wind_speed;
+    dst->environment.turbulence     = src.environment.turbulence;
+    dst->environment.windShear      = src.environment.windShear;
+
+    dst->ground   = src.ground;
+    dst->controls = src.controls;
+
+    for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        dst->engine[ i ] = src.engine[ i ];
+    }
+
+    dst->stateInp = src.stateInp;
+
+    dst->freezePosition = src.freezePosition;
+    dst->freezeAttitude = src.freezeAttitude;
+    dst->freezeVelocity = src.freezeVelocity;
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Simulation::Simulation() :
@@ -32,17 +100,102 @@ Simulation::Simulation() :
     _timeoutTimer ( NULLPTR ),
     _elapsedTimer ( NULLPTR ),
 
-    _fdm ( NULLPTR ),
+    _ap ( NULLPTR ),
+
+    _fleet ( NULLPTR ),
+
+    _inpColdVersion ( 1 ),
+    _dataInpColdVersion ( 0 ),
+    _fleetColdVersion ( 0 ),
 
     _timeStep ( 0.0 ),
     _timeCoef ( 1.0 ),
 
+    _lockstepTime ( 0.0 ),
+
+    _accelTime ( 0.0 ),
+    _stepCost ( 0.0 ),
+    _timeCoefMax ( 0.0 ),
+
+#   ifdef SIM_RENDER_BENCHMARK
+    _benchmarkFrameInp ( 0 ),
+    _benchmarkFrameOut ( 0 ),
+#   endif
+
+#   ifdef SIM_REMOTE_FDM
+    _remoteConnected ( false ),
+#   endif
+
+#   if defined(SIM_LOW_POWER_IDLE) && !defined(SIM_USE_THREADS)
+    _idle ( false ),
+#   endif
+
     _timerId ( 0 )
 {
+    memset( &_inpCold, 0, sizeof(InputCold) );
     memset( &_dataInp, 0, sizeof(fdm::DataInp) );
     memset( &_dataOut, 0, sizeof(fdm::DataOut) );
 
-    _fdm = new fdm::Manager( &_dataInp, &_dataOut );
+    memset( &_commands, 0, sizeof(ControlInput::Commands) );
+    memset( &_navigation, 0, sizeof(Autopilot::Navigation) );
+    memset( &_hid, 0, sizeof(Data::HID) );
+
+#   ifdef SIM_REMOTE_FDM
+    if ( !_remoteClient.open( SIM_REMOTE_FDM_ADDRESS,
+                              SIM_REMOTE_FDM_PORT,
+                              SIM_REMOTE_FDM_REDUNDANCY,
+                              SIM_REMOTE_FDM_TIMEOUT ) )
+    {
+        Log::e() << "Cannot open remote FDM client socket." << std::endl;
+    }
+#   else
+    // single aircraft is stepped in the simulation thread only
+    _fleet = new fdm::Fleet( SIM_WINGMEN > 0 ? SIM_FLEET_THREADS : 1 );
+
+    for ( unsigned int i = 0; i <= SIM_WINGMEN && i <= SIM_MAX_ENTITIES; i++ )
+    {
+        _fleet->addMember( i );
+    }
+
+    // aircraft switches and resets do not wait for model construction
+    _fleet->getMember( 0 ).manager->setPoolSize( SIM_FDM_POOL_SIZE );
+#   endif
+
+#   ifdef SIM_SHARED_DATAOUT
+    if ( !_sharedDataOut.create( SIM_SHARED_DATAOUT_NAME ) )
+    {
+        Log::w() << "Cannot create shared memory segment \"" << SIM_SHARED_DATAOUT_NAME << "\"." << std::endl;
+    }
+#   endif
+
+#   ifdef SIM_DATAOUT_STREAM
+    _dataOutStream.setRate( SIM_DATAOUT_STREAM_FRAME_RATE, SIM_DATAOUT_STREAM_SEND_RATE );
+
+    if ( !_dataOutStream.open( SIM_DATAOUT_STREAM_ADDRESS,
+                               SIM_DATAOUT_STREAM_PORT,
+                               SIM_DATAOUT_STREAM_TTL ) )
+    {
+        Log::w() << "Cannot open output data stream to " << SIM_DATAOUT_STREAM_ADDRESS
+                 << ":" << SIM_DATAOUT_STREAM_PORT << "." << std::endl;
+    }
+#   endif
+
+#   ifdef SIM_EVENT_SCRIPT
+    try
+    {
+        _eventScript.readFile( Path::get( SIM_EVENT_SCRIPT_FILE ).c_str() );
+    }
+    catch ( fdm::Exception &e )
+    {
+        Log::e() << e.getInfo() << std::endl;
+
+        while ( e.hasCause() )
+        {
+            e = e.getCause();
+            Log::e() << e.getInfo() << std::endl;
+        }
+    }
+#   endif
 
 #   ifdef SIM_USE_THREADS
     moveToThread( this );
@@ -60,7 +213,13 @@ Simulation::~Simulation()
     DELPTR( _timeoutTimer );
     DELPTR( _elapsedTimer );
 
-    DELPTR( _fdm );
+    DELPTR( _fleet );
+
+#   ifdef SIM_REMOTE_FDM
+    Log::i() << "Remote FDM round trip time mean: " << _remoteClient.getRoundTripMean()
+             << " s, max: " << _remoteClient.getRoundTripMax()
+             << " s, lost datagrams: " << _remoteClient.getLost() << std::endl;
+#   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +239,25 @@ void Simulation::init()
 
 void Simulation::run()
 {
+    if ( !fdm::ThreadPlacement::apply( fdm::ThreadPlacement::Simulation ) )
+    {
+        Log::w() << "Cannot set simulation thread CPU affinity." << std::endl;
+    }
+
+#   ifdef SIM_REALTIME_SCHEDULER
+    RealTimeScheduler scheduler( SIM_REALTIME_STEP,
+                                 SIM_REALTIME_PRIORITY,
+                                 SIM_REALTIME_CPU );
+
+    if ( scheduler.start() )
+    {
+        runRealTime( &scheduler );
+        return;
+    }
+
+    Log::w() << "Real-time scheduler is not available. Falling back to timer." << std::endl;
+#   endif
+
     _timeoutTimer = new QTimer();
     _elapsedTimer = new QElapsedTimer();
 
@@ -99,98 +277,109 @@ void Simulation::run()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Simulation::onDataInpUpdated( const Data::DataBuf *data )
+void Simulation::setDataInp( const Data::DataBuf *data, const ControlInput::Commands &commands )
 {
-    _timeCoef = data->timeCoef;
+    Input &input = _inpBuffer.getBackBuffer();
 
-    // environment
-    _dataInp.environment.temperature_0  = data->environment.temperature_0;
-    _dataInp.environment.pressure_0     = data->environment.pressure_0;
-    _dataInp.environment.wind_direction = data->environment.wind_direction;
-    _dataInp.environment.wind_speed     = data->environment.wind_speed;
-    _dataInp.environment.turbulence     = data->environment.turbulence;
-    _dataInp.environment.windShear      = data->environment.windShear;
+    input.commands = commands;
+    input.timeCoef = data->timeCoef;
 
-    // initial conditions
-    _dataInp.initial.latitude     = data->initial.latitude;
-    _dataInp.initial.longitude    = data->initial.longitude;
-    _dataInp.initial.altitude_agl = data->initial.altitude_agl;
-    _dataInp.initial.offset_x     = data->initial.offset_x;
-    _dataInp.initial.offset_y     = data->initial.offset_y;
-    _dataInp.initial.heading      = data->initial.heading;
-    _dataInp.initial.airspeed     = data->initial.airspeed;
-    _dataInp.initial.engineOn     = data->initial.engineOn;
+#   ifdef SIM_RENDER_BENCHMARK
+    input.benchmarkFrame = data->benchmark.frameInp;
+#   endif
+
+    // navigation
+    input.navigation.dme_distance     = data->navigation.dme_distance;
+    input.navigation.nav_deviation    = data->navigation.nav_deviation;
+    input.navigation.ils_heading      = data->navigation.ils_heading;
+    input.navigation.ils_lc_deviation = data->navigation.ils_lc_deviation;
+    input.navigation.ils_gs_deviation = data->navigation.ils_gs_deviation;
+    input.navigation.nav_active       = data->navigation.nav_cdi != Data::Navigation::NONE;
+    input.navigation.ils_lc_visible   = data->navigation.ils_lc_visible;
+    input.navigation.ils_gs_visible   = data->navigation.ils_gs_visible;
+
+    // environment
+    input.environment.temperature_0  = data->environment.temperature_0;
+    input.environment.pressure_0     = data->environment.pressure_0;
+    input.environment.wind_direction = data->environment.wind_direction;
+    input.environment.wind_speed     = data->environment.wind_speed;
+    input.environment.turbulence     = data->environment.turbulence;
+    input.environment.windShear      = data->environment.windShear;
 
     // ground
-    _dataInp.ground.elevation = data->ground.elevation;
-    _dataInp.ground.r_x_wgs   = data->ground.r_x_wgs;
-    _dataInp.ground.r_y_wgs   = data->ground.r_y_wgs;
-    _dataInp.ground.r_z_wgs   = data->ground.r_z_wgs;
-    _dataInp.ground.n_x_wgs   = data->ground.n_x_wgs;
-    _dataInp.ground.n_y_wgs   = data->ground.n_y_wgs;
-    _dataInp.ground.n_z_wgs   = data->ground.n_z_wgs;
-
-    // controls
-    _dataInp.controls.roll         = data->controls.roll;
-    _dataInp.controls.pitch        = data->controls.pitch;
-    _dataInp.controls.yaw          = data->controls.yaw;
-    _dataInp.controls.trim_roll    = data->controls.trim_roll;
-    _dataInp.controls.trim_pitch   = data->controls.trim_pitch;
-    _dataInp.controls.trim_yaw     = data->controls.trim_yaw;
-    _dataInp.controls.brake_l      = data->controls.brake_l;
-    _dataInp.controls.brake_r      = data->controls.brake_r;
-    _dataInp.controls.wheel_brake  = data->controls.wheel_brake;
-    _dataInp.controls.landing_gear = data->controls.landing_gear;
-    _dataInp.controls.wheel_nose   = data->controls.wheel_nose;
-    _dataInp.controls.flaps        = data->controls.flaps;
-    _dataInp.controls.airbrake     = data->controls.airbrake;
-    _dataInp.controls.spoilers     = data->controls.spoilers;
-    _dataInp.controls.collective   = data->controls.collective;
-
-    _dataInp.controls.lgh = data->controls.lgh;
-    _dataInp.controls.nws = data->controls.nws;
-    _dataInp.controls.abs = data->controls.abs;
+    input.ground.elevation = data->ground.elevation;
+    input.ground.r_x_wgs   = data->ground.r_x_wgs;
+    input.ground.r_y_wgs   = data->ground.r_y_wgs;
+    input.ground.r_z_wgs   = data->ground.r_z_wgs;
+    input.ground.n_x_wgs   = data->ground.n_x_wgs;
+    input.ground.n_y_wgs   = data->ground.n_y_wgs;
+    input.ground.n_z_wgs   = data->ground.n_z_wgs;
 
     // engines
     for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
     {
-        _dataInp.engine[ i ].throttle  = data->propulsion.engine[ i ].throttle;
-        _dataInp.engine[ i ].mixture   = data->propulsion.engine[ i ].mixture;
-        _dataInp.engine[ i ].propeller = data->propulsion.engine[ i ].propeller;
-        _dataInp.engine[ i ].fuel      = data->propulsion.engine[ i ].fuel;
-        _dataInp.engine[ i ].ignition  = data->propulsion.engine[ i ].ignition;
-        _dataInp.engine[ i ].starter   = data->propulsion.engine[ i ].starter;
+        input.engine[ i ].fuel      = data->propulsion.engine[ i ].fuel;
+        input.engine[ i ].ignition  = data->propulsion.engine[ i ].ignition;
+        input.engine[ i ].starter   = data->propulsion.engine[ i ].starter;
     }
 
-    // masses
-    for ( unsigned int i = 0; i < FDM_MAX_PILOTS; i++ )
+    // input state
+    input.stateInp = data->stateInp;
+
+    // freezes
+    input.freezePosition = data->freezePosition;
+    input.freezeAttitude = data->freezeAttitude;
+    input.freezeVelocity = data->freezeVelocity;
+
+    // cold data, every buffer is updated only when it holds outdated version
+    if ( updateInpCold( data ) )
     {
-        _dataInp.masses.pilot[ i ] = data->masses.pilot[ i ];
+        _inpColdVersion++;
     }
 
-    for ( unsigned int i = 0; i < FDM_MAX_TANKS; i++ )
+    if ( input.coldVersion != _inpColdVersion )
     {
-        _dataInp.masses.tank[ i ] = data->masses.tank[ i ];
+        input.cold = _inpCold;
+        input.coldVersion = _inpColdVersion;
     }
 
-    _dataInp.masses.cabin = data->masses.cabin;
-    _dataInp.masses.trunk = data->masses.trunk;
-    _dataInp.masses.slung = data->masses.slung;
+    ///////////////////////
+    _inpBuffer.publish();
+    ///////////////////////
+}
 
-    // recording
-    _dataInp.recording.mode = data->recording.mode;
-    strncpy( _dataInp.recording.file, data->recording.file, 4096 );
+////////////////////////////////////////////////////////////////////////////////
 
-    // aircraft type
-    _dataInp.aircraftType = data->aircraftType;
+bool Simulation::getDataOut( fdm::DataOut *dataOut, double *time, Data::DataBuf *data )
+{
+    if ( _outBuffer.fetch() )
+    {
+        const Output &output = _outBuffer.getFrontBuffer();
 
-    // input state
-    _dataInp.stateInp = data->stateInp;
+        (*dataOut) = output.dataOut;
+        (*time)    = output.time;
 
-    // freezes
-    _dataInp.freezePosition = data->freezePosition;
-    _dataInp.freezeAttitude = data->freezeAttitude;
-    _dataInp.freezeVelocity = data->freezeVelocity;
+        data->timeCoefMax = output.timeCoefMax;
+
+#       ifdef SIM_RENDER_BENCHMARK
+        data->benchmark.frameOut = output.benchmarkFrame;
+#       endif
+
+        data->entities = output.entities;
+        data->controls = output.controls;
+        data->hid      = output.hid;
+
+        for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+        {
+            data->propulsion.engine[ i ].throttle  = output.engine[ i ].throttle;
+            data->propulsion.engine[ i ].mixture   = output.engine[ i ].mixture;
+            data->propulsion.engine[ i ].propeller = output.engine[ i ].propeller;
+        }
+
+        return true;
+    }
+
+    return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -202,19 +391,480 @@ void Simulation::timerEvent( QTimerEvent *event )
     /////////////////////////////
 
 #   ifndef SIM_USE_THREADS
+#   ifdef SIM_LOW_POWER_IDLE
+    IdleMode::updateTimer( this, &_timerId, &_idle, FDM_TIME_STEP, SIM_IDLE_TIME_STEP );
+#   endif
+
     update();
 #   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Simulation::update()
+void Simulation::runRealTime( RealTimeScheduler *scheduler )
+{
+    Log::i() << "Real-time scheduler started with period "
+             << scheduler->getPeriod() << " s." << std::endl;
+
+    while ( !isInterruptionRequested() )
+    {
+#       ifdef SIM_LOW_POWER_IDLE
+        if ( IdleMode::wait( SIM_IDLE_WAIT ) )
+        {
+            // time spent blocked is neither simulated nor counted as overrun
+            scheduler->resync();
+            step( scheduler->getPeriod() );
+            continue;
+        }
+#       endif
+
+        step( scheduler->wait() );
+    }
+
+    Log::i() << "Real-time scheduler stopped with "
+             << scheduler->getOverruns() << " overrun(s)." << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::step( double timeStep )
 {
-    _timeStep = _timeCoef * (double)_elapsedTimer->restart() / 1000.0;
+    if ( _inpBuffer.fetch() )
+    {
+        const Input &input = _inpBuffer.getFrontBuffer();
+
+        _commands = input.commands;
+        _timeCoef = input.timeCoef;
+
+        _navigation = input.navigation;
+
+#       ifdef SIM_RENDER_BENCHMARK
+        _benchmarkFrameInp = input.benchmarkFrame;
+#       endif
+
+        _dataInp.environment.temperature_0  = input.environment.temperature_0;
+        _dataInp.environment.pressure_0     = input.environment.pressure_0;
+        _dataInp.environment.wind_direction = input.environment.wind_direction;
+        _dataInp.environment.wind_speed     = input.environment.wind_speed;
+        _dataInp.environment.turbulence     = input.environment.turbulence;
+        _dataInp.environment.windShear      = input.environment.windShear;
+
+        _dataInp.ground = input.ground;
+
+        // throttle, mixture and propeller are set by control input
+        for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+        {
+            _dataInp.engine[ i ] = input.engine[ i ];
+        }
+
+        _dataInp.stateInp = input.stateInp;
+
+        _dataInp.freezePosition = input.freezePosition;
+        _dataInp.freezeAttitude = input.freezeAttitude;
+        _dataInp.freezeVelocity = input.freezeVelocity;
+
+        if ( input.coldVersion != _dataInpColdVersion )
+        {
+            _dataInp.initial      = input.cold.initial;
+            _dataInp.masses       = input.cold.masses;
+            _dataInp.recording    = input.cold.recording;
+            _dataInp.aircraftType = input.cold.aircraftType;
+
+            _dataInpColdVersion = input.coldVersion;
+        }
+    }
+
+    // autopilot acts on the most recent step output at FDM rate
+    if ( _ap )
+    {
+        Autopilot::Controls controls;
+
+        _ap->step( _timeCoef * timeStep, _dataOut, _navigation, _hid.ap_disc, &controls );
+
+        _commands.ap_ctrlRoll  = controls.ctrlRoll;
+        _commands.ap_ctrlPitch = controls.ctrlPitch;
+        _commands.ap_ctrlYaw   = controls.ctrlYaw;
+
+        _commands.ap_active = controls.ap_active;
+        _commands.yd_active = controls.yd_active;
+    }
+
+    // devices are polled every step, even if GUI has not published new data
+    ControlInput::update( _timeCoef * timeStep, _commands, &_dataInp, &_hid );
+
+#   ifdef SIM_EVENT_SCRIPT
+    // events act on the same input path as controls, script restarts with every flight
+    if ( _dataInp.stateInp == fdm::DataInp::Idle || _dataInp.stateInp == fdm::DataInp::Init )
+    {
+        _eventScript.reset();
+    }
+    else if ( _dataOut.stateOut == fdm::DataOut::Working )
+    {
+        if ( _eventScript.update( _timeCoef * timeStep, _dataOut, &_dataInp ) > 0 )
+        {
+            for ( unsigned int i = 0; i < _eventScript.getEventsCount(); i++ )
+            {
+                if ( _eventScript.isFired( i )
+                  && _eventScript.getFiredTime( i ) == _eventScript.getTime() )
+                {
+                    Log::i() << "Event "" << _eventScript.getName( i ) << "" fired." << std::endl;
+                }
+            }
+        }
+    }
+#   endif
+
+#   ifndef SIM_REMOTE_FDM
+    updateFleetInput();
+#   endif
+
+#   if defined(SIM_REMOTE_FDM)
+    // server steps aircraft on its own schedule
+    _timeStep = timeStep;
+
+    updateRemote();
+#   elif defined(SIM_RENDER_BENCHMARK)
+    if ( _dataOut.stateOut == fdm::DataOut::Working
+      && _dataInp.stateInp == fdm::DataInp::Work )
+    {
+        // rendered frames, not wall-clock time, decide when fixed steps are due
+        _timeStep = 0.0;
+
+        if ( _benchmarkFrameOut < _benchmarkFrameInp )
+        {
+            for ( int i = 0; i < SIM_RENDER_BENCHMARK_FRAME_STEPS; i++ )
+            {
+                _fleet->step( FDM_TIME_STEP );
+            }
+
+            _timeStep = SIM_RENDER_BENCHMARK_FRAME_STEPS * FDM_TIME_STEP;
+            _benchmarkFrameOut++;
+        }
+    }
+    else
+    {
+        // state transitions are stepped as usual
+        _timeStep = _timeCoef * timeStep;
+
+        _fleet->step( _timeStep );
+
+        _benchmarkFrameOut = _benchmarkFrameInp;
+    }
 
-    _fdm->step( _timeStep );
+    _dataOut = _fleet->getMember( 0 ).dataOut;
+#   elif defined(FDM_LOCKSTEP)
+    // wall-clock time only decides how many fixed steps are due
+    _lockstepTime += _timeCoef * timeStep;
+
+    int steps = 0;
+
+    while ( _lockstepTime >= FDM_TIME_STEP && steps < SIM_LOCKSTEP_MAX_STEPS )
+    {
+        _fleet->step( FDM_TIME_STEP );
+        _lockstepTime -= FDM_TIME_STEP;
+        steps++;
+    }
+
+    // dropping time which cannot be caught up instead of spiralling
+    if ( steps == SIM_LOCKSTEP_MAX_STEPS ) _lockstepTime = 0.0;
+
+    _timeStep = steps * FDM_TIME_STEP;
+
+    _dataOut = _fleet->getMember( 0 ).dataOut;
+#   else
+    if ( _timeCoef > 1.0 )
+    {
+        stepAccelerated( timeStep );
+    }
+    else
+    {
+        _accelTime = 0.0;
+
+        _timeStep = _timeCoef * timeStep;
+
+        _fleet->step( _timeStep );
+    }
+
+    _dataOut = _fleet->getMember( 0 ).dataOut;
+#   endif
+
+    Output &output = _outBuffer.getBackBuffer();
+
+    output.dataOut = _dataOut;
+    output.time    = fdm::Time::get();
+
+    output.timeCoefMax = _timeCoefMax;
+
+#   ifdef SIM_RENDER_BENCHMARK
+    output.benchmarkFrame = _benchmarkFrameOut;
+#   endif
+
+    output.controls = _dataInp.controls;
+    output.hid      = _hid;
+
+    for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        output.engine[ i ] = _dataInp.engine[ i ];
+    }
+
+    updateEntities( &output.entities );
+
+    ///////////////////////
+    _outBuffer.publish();
+    ///////////////////////
+
+    // ownship pose for the CGI late latch
+    cgi::DeadReckoning::Frame frame;
+
+    frame.time = output.time;
+
+    frame.pos_wgs = fdm::Vector3( _dataOut.flight.pos_x_wgs,
+                                  _dataOut.flight.pos_y_wgs,
+                                  _dataOut.flight.pos_z_wgs );
+
+    frame.att_wgs = fdm::Quaternion( _dataOut.flight.att_e0_wgs,
+                                     _dataOut.flight.att_ex_wgs,
+                                     _dataOut.flight.att_ey_wgs,
+                                     _dataOut.flight.att_ez_wgs );
+
+    frame.vel_bas = fdm::Vector3( _dataOut.flight.vel_u_bas,
+                                  _dataOut.flight.vel_v_bas,
+                                  _dataOut.flight.vel_w_bas );
+
+    frame.omg_bas = fdm::Vector3( _dataOut.flight.rollRate,
+                                  _dataOut.flight.pitchRate,
+                                  _dataOut.flight.yawRate );
+
+    cgi::DeadReckoning::publish( frame );
+
+#   ifdef SIM_SHARED_DATAOUT
+    _sharedDataOut.publish( _dataOut );
+#   endif
+
+#   ifdef SIM_DATAOUT_STREAM
+    _dataOutStream.update( _dataOut );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(SIM_REMOTE_FDM) && !defined(FDM_LOCKSTEP)
+void Simulation::stepAccelerated( double timeStep )
+{
+    // single large step would be clamped by the FDM and loses accuracy,
+    // so accelerated time is simulated with fixed steps instead
+    _accelTime += _timeCoef * timeStep;
+
+    int stepsMax = SIM_TIME_ACCEL_MAX_STEPS;
+
+    if ( _stepCost > 0.0 )
+    {
+        stepsMax = std::max( 1, std::min( SIM_TIME_ACCEL_MAX_STEPS,
+                   (int)floor( SIM_TIME_ACCEL_BUDGET * timeStep / _stepCost ) ) );
+    }
+
+    int steps = 0;
+
+    double t_0 = fdm::Time::get();
+
+    while ( _accelTime >= FDM_TIME_STEP && steps < stepsMax )
+    {
+        _fleet->step( FDM_TIME_STEP );
+        _accelTime -= FDM_TIME_STEP;
+        steps++;
+    }
+
+    if ( steps > 0 )
+    {
+        double cost = ( fdm::Time::get() - t_0 ) / (double)steps;
+
+        _stepCost = ( _stepCost > 0.0 ) ? ( 0.9 * _stepCost + 0.1 * cost ) : cost;
+    }
+
+    // dropping time which cannot be simulated instead of spiralling
+    if ( steps == stepsMax ) _accelTime = std::min( _accelTime, FDM_TIME_STEP );
+
+    if ( timeStep > 0.0 )
+    {
+        _timeCoefMax = stepsMax * FDM_TIME_STEP / timeStep;
+    }
+
+    _timeStep = steps * FDM_TIME_STEP;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Simulation::updateInpCold( const Data::DataBuf *data )
+{
+    bool changed = false;
+
+    // initial conditions
+    changed |= updateValue( &_inpCold.initial.latitude     , data->initial.latitude     );
+    changed |= updateValue( &_inpCold.initial.longitude    , data->initial.longitude    );
+    changed |= updateValue( &_inpCold.initial.altitude_agl , data->initial.altitude_agl );
+    changed |= updateValue( &_inpCold.initial.offset_x     , data->initial.offset_x     );
+    changed |= updateValue( &_inpCold.initial.offset_y     , data->initial.offset_y     );
+    changed |= updateValue( &_inpCold.initial.heading      , data->initial.heading      );
+    changed |= updateValue( &_inpCold.initial.airspeed     , data->initial.airspeed     );
+    changed |= updateValue( &_inpCold.initial.engineOn     , data->initial.engineOn     );
+
+    // masses
+    for ( unsigned int i = 0; i < FDM_MAX_PILOTS; i++ )
+    {
+        changed |= updateValue( &_inpCold.masses.pilot[ i ], data->masses.pilot[ i ] );
+    }
+
+    for ( unsigned int i = 0; i < FDM_MAX_TANKS; i++ )
+    {
+        changed |= updateValue( &_inpCold.masses.tank[ i ], data->masses.tank[ i ] );
+    }
+
+    changed |= updateValue( &_inpCold.masses.cabin, data->masses.cabin );
+    changed |= updateValue( &_inpCold.masses.trunk, data->masses.trunk );
+    changed |= updateValue( &_inpCold.masses.slung, data->masses.slung );
+
+    // recording, file path is compared up to its terminating character only
+    changed |= updateValue( &_inpCold.recording.mode   , data->recording.mode   );
+    changed |= updateValue( &_inpCold.recording.rate   , data->recording.rate   );
+    changed |= updateValue( &_inpCold.recording.direct , data->recording.direct );
+
+    if ( strncmp( _inpCold.recording.file, data->recording.file, sizeof(_inpCold.recording.file) - 1 ) != 0 )
+    {
+        strncpy( _inpCold.recording.file, data->recording.file, sizeof(_inpCold.recording.file) - 1 );
+        changed = true;
+    }
+
+    // aircraft type
+    changed |= updateValue( &_inpCold.aircraftType, data->aircraftType );
+
+    return changed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::updateFleetInput()
+{
+    bool cold = _fleetColdVersion != _dataInpColdVersion;
+
+    _fleetColdVersion = _dataInpColdVersion;
+
+    for ( unsigned int i = 0; i < _fleet->getCount(); i++ )
+    {
+        fdm::DataInp &dataInp = _fleet->getMember( i ).dataInp;
+
+        if ( !cold )
+        {
+            copyHot( _dataInp, &dataInp );
+            continue;
+        }
+
+        dataInp = _dataInp;
+
+        if ( i == 0 ) continue;
+
+        // echelon formation, wingmen alternately on the right and on the left
+        double rank = (double)( ( i + 1 ) / 2 );
+        double side = ( i % 2 ) ? 1.0 : -1.0;
+
+        dataInp.initial.offset_x -= rank * SIM_WINGMEN_SPACING;
+        dataInp.initial.offset_y += rank * SIM_WINGMEN_SPACING * side;
+
+        dataInp.recording.mode = fdm::DataInp::Recording::Disabled;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::updateEntities( Data::Entities *entities )
+{
+    entities->count = 0;
+
+#   ifdef SIM_REMOTE_FDM
+    const RemoteProtocol::Entity *remote = _remoteClient.getEntities();
+
+    for ( unsigned int i = 0; i < _remoteClient.getEntitiesCount() && entities->count < SIM_MAX_ENTITIES; i++ )
+    {
+        // server sends all the aircraft including ownship
+        if ( remote[ i ].id == _remoteClient.getClientId() ) continue;
+
+        Data::Entities::Entity &entity = entities->entity[ entities->count++ ];
+
+        entity.id = remote[ i ].id;
+
+        entity.pos_x_wgs = remote[ i ].pos_x_wgs;
+        entity.pos_y_wgs = remote[ i ].pos_y_wgs;
+        entity.pos_z_wgs = remote[ i ].pos_z_wgs;
+
+        entity.att_e0_wgs = remote[ i ].att_e0_wgs;
+        entity.att_ex_wgs = remote[ i ].att_ex_wgs;
+        entity.att_ey_wgs = remote[ i ].att_ey_wgs;
+        entity.att_ez_wgs = remote[ i ].att_ez_wgs;
+    }
+
+    return;
+#   endif
+
+    for ( unsigned int i = 1; i < _fleet->getCount() && entities->count < SIM_MAX_ENTITIES; i++ )
+    {
+        const fdm::Fleet::Member &member = _fleet->getMember( i );
+
+        if ( member.dataOut.stateOut != fdm::DataOut::Working
+          && member.dataOut.stateOut != fdm::DataOut::Paused )
+        {
+            continue;
+        }
+
+        Data::Entities::Entity &entity = entities->entity[ entities->count++ ];
+
+        entity.id = member.id;
+
+        entity.pos_x_wgs = member.dataOut.flight.pos_x_wgs;
+        entity.pos_y_wgs = member.dataOut.flight.pos_y_wgs;
+        entity.pos_z_wgs = member.dataOut.flight.pos_z_wgs;
+
+        entity.att_e0_wgs = member.dataOut.flight.att_e0_wgs;
+        entity.att_ex_wgs = member.dataOut.flight.att_ex_wgs;
+        entity.att_ey_wgs = member.dataOut.flight.att_ey_wgs;
+        entity.att_ez_wgs = member.dataOut.flight.att_ez_wgs;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_REMOTE_FDM
+void Simulation::updateRemote()
+{
+    _remoteClient.send( _dataInp );
+    _remoteClient.receive( &_dataOut );
+
+    bool connected = _remoteClient.isConnected();
+
+    if ( connected != _remoteConnected )
+    {
+        _remoteConnected = connected;
+
+        if ( connected )
+            Log::i() << "Connected to FDM server as client " << _remoteClient.getClientId() << "." << std::endl;
+        else
+            Log::w() << "FDM server connection lost." << std::endl;
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Simulation::update()
+{
+#   if defined(SIM_LOW_POWER_IDLE) && defined(SIM_USE_THREADS)
+    if ( IdleMode::wait( SIM_IDLE_WAIT ) )
+    {
+        // time spent blocked is not simulated
+        _elapsedTimer->restart();
+        step( FDM_TIME_STEP );
+        return;
+    }
+#   endif
 
-    ////////////////////////////////
-    emit dataOutUpdated( _dataOut );
-    ////////////////////////////////
+    step( (double)_elapsedTimer->restart() / 1000.0 );
 }
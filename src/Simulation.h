@@ -28,15 +28,51 @@
 #include <QTimer>
 #include <QElapsedTimer>
 
-#include <fdm/fdm_Manager.h>
+#include <fdm/fdm_Fleet.h>
 
+#ifdef SIM_EVENT_SCRIPT
+#   include <fdm/main/fdm_EventScript.h>
+#endif
+
+#include <Autopilot.h>
+#include <ControlInput.h>
 #include <Data.h>
 #include <Defines.h>
 
+#include <sim/DataOutStream.h>
+#include <sim/RealTimeScheduler.h>
+#include <sim/RemoteClient.h>
+#include <sim/SharedDataOut.h>
+#include <sim/TripleBuffer.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
  * @brief Simulation class.
+ *
+ * Simulation thread also runs control input pipeline right before each
+ * step, so FDM input does not wait for GUI event loop. Autopilot, if set,
+ * is stepped at the same rate, its control commands are applied to the same
+ * step input.
+ *
+ * If SIM_REMOTE_FDM is defined, flight dynamics model is not run locally,
+ * input data is sent to the FDM server and output data is received back.
+ *
+ * Input data published every tick are kept compact, input data changed
+ * rarely (initial conditions, masses, recording and aircraft type) are
+ * versioned and copied only when they change, so 4 KB recording file path
+ * is not copied every tick.
+ *
+ * If SIM_LOW_POWER_IDLE is defined, simulation thread is blocked while
+ * simulation is idle or paused, until input state changes or SIM_IDLE_WAIT
+ * elapses, time spent blocked is not simulated.
+ *
+ * If SIM_RENDER_BENCHMARK is defined, working aircraft are not stepped by
+ * wall-clock time, but by SIM_RENDER_BENCHMARK_FRAME_STEPS fixed steps per
+ * every frame requested by the render benchmark, so each measured frame
+ * shows the same simulation time regardless of rendering performance.
+ *
+ * @see RemoteClient
  */
 class Simulation : public QThread
 {
@@ -56,15 +92,30 @@ public:
     /** */
     void run();
 
-public slots:
+    /**
+     * @brief Sets autopilot stepped by simulation thread.
+     * Must be called before thread is started.
+     * @param ap autopilot (not owned)
+     */
+    inline void setAutopilot( Autopilot *ap ) { _ap = ap; }
 
-    /** */
-    void onDataInpUpdated( const Data::DataBuf *data );
+    /**
+     * @brief Publishes input data snapshot for simulation thread.
+     * Might be called only from the thread which owns Data::DataBuf.
+     * @param data input data
+     * @param commands control input commands
+     */
+    void setDataInp( const Data::DataBuf *data, const ControlInput::Commands &commands );
 
-signals:
-
-    /** */
-    void dataOutUpdated( const fdm::DataOut &dataOut );
+    /**
+     * @brief Fetches most recent output data snapshot.
+     * Might be called only from the thread which owns Data::DataBuf.
+     * @param dataOut output data
+     * @param time [s] monotonic clock time of the step which produced data
+     * @param data simulation data to be updated with other simulated aircraft, controls and HID data
+     * @return true if new data has been fetched, false otherwise
+     */
+    bool getDataOut( fdm::DataOut *dataOut, double *time, Data::DataBuf *data );
 
 protected:
 
@@ -73,19 +124,167 @@ protected:
 
 private:
 
+    /** Simulation thread input environment data. */
+    struct Environment
+    {
+        double temperature_0;                               ///< [K] sea level air temperature
+        double pressure_0;                                  ///< [Pa] sea level air pressure
+        double wind_direction;                              ///< [rad] wind direction
+        double wind_speed;                                  ///< [m/s] wind speed
+
+        fdm::DataInp::Environment::Turbulence turbulence;   ///< turbulence intensity
+        fdm::DataInp::Environment::WindShear  windShear;    ///< active wind shear model
+    };
+
+    /** Simulation thread input data changed rarely, exchanged only when version changes. */
+    struct InputCold
+    {
+        fdm::DataInp::Initial   initial;                    ///< initial conditions
+        fdm::DataInp::Masses    masses;                     ///< masses data
+        fdm::DataInp::Recording recording;                  ///< recording data
+
+        fdm::DataInp::AircraftType aircraftType;            ///< input aircraft type
+    };
+
+    /** Simulation thread input data. */
+    struct Input
+    {
+        ControlInput::Commands commands;                    ///< control input commands
+        Autopilot::Navigation navigation;                   ///< autopilot navigation data
+        Environment environment;                            ///< environment data
+        fdm::DataInp::Ground ground;                        ///< ground data
+        fdm::DataInp::Engine engine[ FDM_MAX_ENGINES ];     ///< engines data
+        fdm::DataInp::StateInp stateInp;                    ///< input state
+        double timeCoef;                                    ///< [-] time coefficient
+        bool freezePosition;                                ///< specifies if aircraft position is to be frozen
+        bool freezeAttitude;                                ///< specifies if aircraft attitude is to be frozen
+        bool freezeVelocity;                                ///< specifies if aircraft velocity is to be frozen
+#       ifdef SIM_RENDER_BENCHMARK
+        unsigned int benchmarkFrame;                        ///< number of rendered frames to be stepped
+#       endif
+
+        unsigned int coldVersion;                           ///< cold data version, 0 means not set
+        InputCold cold;                                     ///< cold data
+    };
+
+    /** Simulation thread output data. */
+    struct Output
+    {
+        fdm::DataOut dataOut;                           ///< flight dynamics model output data
+        Data::Entities entities;                        ///< other simulated aircraft data
+        fdm::DataInp::Controls controls;                ///< controls input of the step
+        fdm::DataInp::Engine engine[ FDM_MAX_ENGINES ]; ///< engines input of the step
+        Data::HID hid;                                  ///< HID raw data
+        double time;                                    ///< [s] monotonic clock time of the step
+        double timeCoefMax;                             ///< [-] achievable time coefficient
+#       ifdef SIM_RENDER_BENCHMARK
+        unsigned int benchmarkFrame;                    ///< number of rendered frames stepped
+#       endif
+    };
+
+    TripleBuffer< Input  > _inpBuffer;          ///< input data channel
+    TripleBuffer< Output > _outBuffer;          ///< output data channel
+
+#   ifdef SIM_SHARED_DATAOUT
+    SharedDataOut _sharedDataOut;   ///< output data shared memory segment for external processes
+#   endif
+
+#   ifdef SIM_DATAOUT_STREAM
+    DataOutStream _dataOutStream;   ///< output data UDP stream for networked consumers
+#   endif
+
+#   ifdef SIM_EVENT_SCRIPT
+    fdm::EventScript _eventScript;  ///< scenario events script
+#   endif
+
+#   ifdef SIM_REMOTE_FDM
+    RemoteClient _remoteClient;     ///< remote flight dynamics model client
+    bool _remoteConnected;          ///< specifies if FDM server is connected
+#   endif
+
     QTimer        *_timeoutTimer;   ///<
     QElapsedTimer *_elapsedTimer;   ///<
 
-    fdm::Manager *_fdm;             ///< flight dynamics model
+    Autopilot *_ap;                 ///< autopilot (not owned, might be null)
+
+    fdm::Fleet *_fleet;             ///< simulated aircraft, ownship is the first member (null if FDM is remote)
 
-    fdm::DataInp _dataInp;          ///< flight dynamics model input data
-    fdm::DataOut _dataOut;          ///< flight dynamics model output data
+    InputCold _inpCold;                 ///< most recent cold input data (owner thread)
+    unsigned int _inpColdVersion;       ///< most recent cold input data version (owner thread)
+    unsigned int _dataInpColdVersion;   ///< cold input data version applied to ownship input data
+    unsigned int _fleetColdVersion;     ///< cold input data version applied to fleet members input data
+
+    fdm::DataInp _dataInp;          ///< ownship flight dynamics model input data
+    fdm::DataOut _dataOut;          ///< ownship flight dynamics model output data
+
+    ControlInput::Commands _commands;   ///< control input commands
+    Autopilot::Navigation _navigation;  ///< autopilot navigation data
+    Data::HID _hid;                     ///< HID raw data
 
     double _timeStep;               ///<
     double _timeCoef;               ///<
 
+    double _lockstepTime;           ///< [s] wall-clock time not yet simulated with fixed steps
+
+    double _accelTime;              ///< [s] accelerated time not yet simulated with fixed steps
+    double _stepCost;               ///< [s] averaged wall-clock time of a single fixed step of all fleet members
+    double _timeCoefMax;            ///< [-] achievable time coefficient within CPU budget (0 if not yet determined)
+
+#   ifdef SIM_RENDER_BENCHMARK
+    unsigned int _benchmarkFrameInp;    ///< number of rendered frames to be stepped
+    unsigned int _benchmarkFrameOut;    ///< number of rendered frames stepped
+#   endif
+
+#   if defined(SIM_LOW_POWER_IDLE) && !defined(SIM_USE_THREADS)
+    bool _idle;                     ///< specifies if timer ticks with idle period
+#   endif
+
     int _timerId;                   ///<
 
+    /**
+     * @brief Runs simulation loop driven by real-time scheduler.
+     * Loop runs until thread interruption is requested.
+     * @param scheduler started real-time scheduler
+     */
+    void runRealTime( RealTimeScheduler *scheduler );
+
+    /**
+     * @brief Fetches input data, steps simulation and publishes output data.
+     * @param timeStep [s] real time step
+     */
+    void step( double timeStep );
+
+#   if !defined(SIM_REMOTE_FDM) && !defined(FDM_LOCKSTEP)
+    /**
+     * @brief Steps fleet with fixed time steps when time is accelerated.
+     * Number of steps is limited so they take no more than SIM_TIME_ACCEL_BUDGET
+     * of the tick, accelerated time which cannot be simulated is dropped.
+     * @param timeStep [s] real time step
+     */
+    void stepAccelerated( double timeStep );
+#   endif
+
+    /**
+     * @brief Updates most recent cold input data.
+     * @param data input data
+     * @return true if cold input data has changed, false otherwise
+     */
+    bool updateInpCold( const Data::DataBuf *data );
+
+    /**
+     * @brief Sets fleet members input data, wingmen fly ownship inputs.
+     * Cold input data are copied only when their version changes.
+     */
+    void updateFleetInput();
+
+    /** @brief Fills entities data with fleet members other than ownship. */
+    void updateEntities( Data::Entities *entities );
+
+#   ifdef SIM_REMOTE_FDM
+    /** @brief Sends input data to and receives output data from the FDM server. */
+    void updateRemote();
+#   endif
+
 private slots:
 
     void update();
@@ -0,0 +1,95 @@
+QT -= core gui
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+TEMPLATE = app
+
+################################################################################
+
+DESTDIR = $$PWD/../../bin
+TARGET = mscsim_batch
+
+################################################################################
+
+CONFIG += c++11
+
+################################################################################
+
+unix: CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O2
+win32: CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O2
+
+################################################################################
+
+DEFINES += SIM_TEST
+#DEFINES += FDM_ALLOC_TRACKING
+#DEFINES += FDM_IMPLICIT_CONTACT
+#DEFINES += FDM_PROFILER
+#DEFINES += FDM_LOCKSTEP
+#DEFINES += FDM_UNCHECKED
+
+win32: DEFINES += \
+    NOMINMAX \
+    WIN32 \
+    _CRT_SECURE_NO_DEPRECATE \
+    _SCL_SECURE_NO_WARNINGS \
+    _USE_MATH_DEFINES
+
+unix: DEFINES += _LINUX_
+
+################################################################################
+
+INCLUDEPATH += ./ ../
+
+win32: INCLUDEPATH += \
+    $(OSG_ROOT)/include/libxml2
+
+unix: INCLUDEPATH += \
+    /usr/include/libxml2
+
+################################################################################
+
+win32: LIBS += \
+    -L$(OSG_ROOT)/lib \
+    -llibxml2
+
+unix: LIBS += \
+    -L/lib \
+    -L/usr/lib \
+    -lpthread \
+    -lxml2
+
+################################################################################
+
+HEADERS += \
+    $$PWD/batch_Benchmark.h \
+    $$PWD/batch_Regression.h \
+    $$PWD/batch_RotorSweep.h \
+    $$PWD/batch_Runner.h \
+    $$PWD/batch_Scenario.h \
+    $$PWD/batch_Sweep.h \
+    $$PWD/batch_ThreadPool.h
+
+SOURCES += \
+    $$PWD/main.cpp \
+    $$PWD/batch_Benchmark.cpp \
+    $$PWD/batch_Regression.cpp \
+    $$PWD/batch_RotorSweep.cpp \
+    $$PWD/batch_Runner.cpp \
+    $$PWD/batch_Scenario.cpp \
+    $$PWD/batch_Sweep.cpp \
+    $$PWD/batch_ThreadPool.cpp
+
+################################################################################
+
+include(../fdm/fdm.pri)
+include(../fdm_aw101/fdm_aw101.pri)
+include(../fdm_c130/fdm_c130.pri)
+include(../fdm_c172/fdm_c172.pri)
+include(../fdm_f16/fdm_f16.pri)
+include(../fdm_f35a/fdm_f35a.pri)
+include(../fdm_p51/fdm_p51.pri)
+include(../fdm_pw5/fdm_pw5.pri)
+include(../fdm_r44/fdm_r44.pri)
+include(../fdm_uh60/fdm_uh60.pri)
@@ -0,0 +1,245 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <batch/batch_Benchmark.h>
+
+#include <cstring>
+#include <iomanip>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_String.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+#include <batch/batch_Runner.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Benchmark::Benchmark() :
+    _repeats ( 1 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Benchmark::~Benchmark() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Benchmark::readFile( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() && 0 == fdm::String::icompare( rootNode.getName(), "batch_benchmark" ) )
+        {
+            int repeats = 1;
+
+            if ( FDM_SUCCESS != fdm::XmlUtils::read( rootNode, &repeats, "repeats", true )
+              || repeats <= 0 )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+            }
+
+            _repeats = repeats;
+
+            std::string benchmarkFile( file );
+            size_t sep = benchmarkFile.find_last_of( "/\\" );
+
+            fdm::XmlNode nodeCase = rootNode.getFirstChildElement( "case" );
+
+            while ( nodeCase.isValid() )
+            {
+                Case benchCase;
+
+                memset( &benchCase.result, 0, sizeof(Result) );
+
+                std::string scenarioFile;
+
+                benchCase.name = nodeCase.getAttribute( "name" );
+
+                if ( benchCase.name.empty()
+                  || FDM_SUCCESS != fdm::XmlUtils::read( nodeCase, &scenarioFile ) )
+                {
+                    fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeCase );
+                }
+
+                // scenario file path is relative to the benchmark file
+                scenarioFile = fdm::String::stripSpaces( scenarioFile );
+
+                if ( sep != std::string::npos && scenarioFile.size() > 0
+                  && scenarioFile[ 0 ] != '/' && scenarioFile[ 0 ] != '\\' )
+                {
+                    scenarioFile = benchmarkFile.substr( 0, sep + 1 ) + scenarioFile;
+                }
+
+                benchCase.scenario.readFile( scenarioFile.c_str() );
+
+                _cases.push_back( benchCase );
+
+                nodeCase = nodeCase.getNextSiblingElement( "case" );
+            }
+
+            if ( _cases.size() == 0 )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+            }
+        }
+        else
+        {
+            fdm::Exception e;
+
+            e.setType( fdm::Exception::FileReadingError );
+            e.setInfo( "Reading file \"" + std::string( file ) + "\" failed. Invalid root node." );
+
+            FDM_THROW( e );
+        }
+    }
+    else
+    {
+        fdm::Exception e;
+
+        e.setType( fdm::Exception::FileReadingError );
+        e.setInfo( "Reading file \"" + std::string( file ) + "\" failed." );
+
+        FDM_THROW( e );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Benchmark::run( bool verbose )
+{
+    for ( Cases::iterator it = _cases.begin(); it != _cases.end(); ++it )
+    {
+        runCase( &(*it), verbose );
+
+        fdm::Log::i() << "Benchmark case \"" << it->name << "\" "
+                      << ( it->result.result == FDM_SUCCESS ? "finished" : "failed" )
+                      << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Benchmark::writeResults( std::ostream &out ) const
+{
+    out << "case,result,steps,sim_time,work_time,steps_per_second,real_time_factor"
+        << ",deriv_per_step,deriv_time_ns,allocs_per_step"
+        << ",step_p50_us,step_p99_us,step_max_us" << std::endl;
+
+    for ( Cases::const_iterator it = _cases.begin(); it != _cases.end(); ++it )
+    {
+        const Result &result = it->result;
+
+        double steps = result.steps > 0 ? (double)result.steps : 1.0;
+        double derivCount = result.derivCount > 0 ? (double)result.derivCount : 1.0;
+
+        double workTime = result.workTime > 0.0 ? result.workTime : 1.0;
+
+        out << std::setprecision( 6 )
+            << it->name << ","
+            << ( result.result == FDM_SUCCESS ? 1 : 0 ) << ","
+            << result.steps    << ","
+            << result.simTime  << ","
+            << result.workTime << ","
+            << result.steps / workTime   << ","
+            << result.simTime / workTime << ","
+            << result.derivCount / steps << ","
+            << 1.0e9 * result.derivTime / derivCount << ","
+            << result.allocs / steps     << ","
+            << 1.0e6 * result.step_p50   << ","
+            << 1.0e6 * result.step_p99   << ","
+            << 1.0e6 * result.step_max
+            << "\n";
+    }
+
+    out.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Benchmark::getFailures() const
+{
+    unsigned int failures = 0;
+
+    for ( Cases::const_iterator it = _cases.begin(); it != _cases.end(); ++it )
+    {
+        if ( it->result.result != FDM_SUCCESS ) failures++;
+    }
+
+    return failures;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Benchmark::runCase( Case *benchCase, bool verbose )
+{
+    Result &best = benchCase->result;
+
+    best.result = FDM_FAILURE;
+
+    for ( unsigned int i = 0; i < _repeats; i++ )
+    {
+        // every run starts from the same scenario
+        Scenario scenario( benchCase->scenario );
+
+        Runner runner( &scenario, FDM_NULLPTR, verbose );
+
+        int result = runner.run();
+
+        // failed run disqualifies the whole case
+        if ( result != FDM_SUCCESS )
+        {
+            best.result = result;
+            return;
+        }
+
+        if ( i == 0 || runner.getWorkTime() < best.workTime )
+        {
+            const double percents[] = { 50.0, 99.0 };
+            double values[ 2 ];
+
+            runner.getStepTimeHist().getPercentiles( percents, values, 2 );
+
+            best.simTime    = runner.getSimTime();
+            best.workTime   = runner.getWorkTime();
+            best.derivTime  = runner.getDerivTime();
+            best.step_p50   = values[ 0 ];
+            best.step_p99   = values[ 1 ];
+            best.step_max   = runner.getStepTimeHist().getMax();
+            best.derivCount = runner.getDerivCount();
+            best.allocs     = runner.getAllocs();
+            best.steps      = runner.getSteps();
+            best.result     = result;
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BATCH_BENCHMARK_H
+#define BATCH_BENCHMARK_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fdm/fdm_Types.h>
+
+#include <batch/batch_Scenario.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace batch
+{
+
+/**
+ * @brief FDM performance benchmark class.
+ *
+ * Benchmark runs every case scenario headless given number of times, one
+ * after another in the calling thread, and reports statistics of the fastest
+ * run. Results are written as comma-separated values, one line per case, so
+ * they can be compared release over release.
+ *
+ * XML file format:
+ * @code
+ * <batch_benchmark>
+ *   [<repeats> { number of runs of every case } </repeats>]
+ *   <case name="{ case name }"> { scenario file path, relative to the benchmark file } </case>
+ *   ... { more cases }
+ * </batch_benchmark>
+ * @endcode
+ *
+ * @see Scenario
+ */
+class Benchmark
+{
+public:
+
+    /** @brief Constructor. */
+    Benchmark();
+
+    /** @brief Destructor. */
+    virtual ~Benchmark();
+
+    /**
+     * @brief Reads benchmark from XML file.
+     * @param file benchmark file path
+     */
+    void readFile( const char *file );
+
+    /**
+     * @brief Runs all cases.
+     * @param verbose specifies if FDM messages should be logged
+     */
+    void run( bool verbose = false );
+
+    /**
+     * @brief Writes cases results as comma-separated values.
+     * @param out output stream
+     */
+    void writeResults( std::ostream &out ) const;
+
+    /**
+     * @brief Returns number of failed cases.
+     * @return number of failed cases
+     */
+    unsigned int getFailures() const;
+
+    inline unsigned int getCases() const { return (unsigned int)_cases.size(); }
+
+private:
+
+    /** Case result. */
+    struct Result
+    {
+        double simTime;                     ///< [s] simulation time
+        double workTime;                    ///< [s] simulation steps computations time
+        double derivTime;                   ///< [s] state derivative computations time
+
+        double step_p50;                    ///< [s] step computations time median
+        double step_p99;                    ///< [s] step computations time 99th percentile
+        double step_max;                    ///< [s] step computations time maximum
+
+        fdm::UInt64 derivCount;             ///< number of state derivative evaluations
+        fdm::UInt64 allocs;                 ///< number of heap allocations
+
+        unsigned int steps;                 ///< number of steps
+
+        int result;                         ///< run result
+    };
+
+    /** Benchmark case. */
+    struct Case
+    {
+        std::string name;                   ///< case name
+        Scenario scenario;                  ///< case scenario
+        Result result;                      ///< fastest run result
+    };
+
+    typedef std::vector< Case > Cases;
+
+    Cases _cases;                           ///< cases
+
+    unsigned int _repeats;                  ///< number of runs of every case
+
+    void runCase( Case *benchCase, bool verbose );
+};
+
+} // end of batch namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCH_BENCHMARK_H
@@ -0,0 +1,549 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <batch/batch_Regression.h>
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_String.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+#include <batch/batch_Runner.h>
+#include <batch/batch_ThreadPool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Output data time history. */
+struct Trajectory
+{
+    std::vector< std::string > columns;     ///< columns names
+    std::vector< double > values;           ///< samples values, row by row
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Parses comma-separated values time history as written by Runner. */
+bool readTrajectory( std::istream &in, Trajectory *trajectory )
+{
+    std::string line;
+
+    if ( !std::getline( in, line ) ) return false;
+
+    trajectory->columns = fdm::String::split( fdm::String::stripSpaces( line ), "," );
+
+    if ( trajectory->columns.size() == 0 ) return false;
+
+    fdm::String::Views tokens;
+
+    while ( std::getline( in, line ) )
+    {
+        if ( line.empty() ) continue;
+
+        fdm::String::split( line, ',', &tokens );
+
+        if ( tokens.size() != trajectory->columns.size() ) return false;
+
+        for ( unsigned int i = 0; i < tokens.size(); i++ )
+        {
+            trajectory->values.push_back( fdm::String::toDouble( tokens[ i ] ) );
+        }
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Returns absolute difference, angles wrapping around are compared modulo full angle. */
+double getError( const std::string &column, double value, double reference )
+{
+    // NaN is equal only to NaN
+    if ( value != value || reference != reference )
+    {
+        return ( value != value && reference != reference ) ? 0.0
+                                                            : std::numeric_limits< double >::infinity();
+    }
+
+    double error = value - reference;
+
+    if ( column == "roll" || column == "heading" )
+    {
+        error = remainder( error, 360.0 );
+    }
+
+    return fabs( error );
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+Regression::Regression() :
+    _tolerance ( 1.0e-6 ),
+    _threshold ( 0.1 ),
+    _repeats ( 1 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Regression::~Regression() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Regression::readFile( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() && 0 == fdm::String::icompare( rootNode.getName(), "batch_regression" ) )
+        {
+            int result = FDM_SUCCESS;
+            int repeats = 1;
+
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_goldenDir, "golden_dir" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &repeats, "repeats", true );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_threshold, "threshold", true );
+
+            if ( result != FDM_SUCCESS || repeats <= 0 || _threshold < 0.0 )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+            }
+
+            _repeats = repeats;
+
+            // golden directory and scenarios paths are relative to the regression file
+            std::string regressionFile( file );
+            size_t sep = regressionFile.find_last_of( "/\\" );
+
+            _goldenDir = fdm::String::stripSpaces( _goldenDir );
+
+            if ( sep != std::string::npos && _goldenDir.size() > 0
+              && _goldenDir[ 0 ] != '/' && _goldenDir[ 0 ] != '\\' )
+            {
+                _goldenDir = regressionFile.substr( 0, sep + 1 ) + _goldenDir;
+            }
+
+            fdm::XmlNode nodeTolerances = rootNode.getFirstChildElement( "tolerances" );
+
+            if ( nodeTolerances.isValid() )
+            {
+                fdm::XmlNode nodeTolerance = nodeTolerances.getFirstChildElement();
+
+                while ( nodeTolerance.isValid() )
+                {
+                    double tolerance = 0.0;
+
+                    if ( FDM_SUCCESS != fdm::XmlUtils::read( nodeTolerance, &tolerance )
+                      || tolerance < 0.0 )
+                    {
+                        fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeTolerance );
+                    }
+
+                    if ( nodeTolerance.getName() == "default" )
+                        _tolerance = tolerance;
+                    else
+                        _tolerances[ nodeTolerance.getName() ] = tolerance;
+
+                    nodeTolerance = nodeTolerance.getNextSiblingElement();
+                }
+            }
+
+            fdm::XmlNode nodeCase = rootNode.getFirstChildElement( "case" );
+
+            while ( nodeCase.isValid() )
+            {
+                Case regCase;
+
+                std::string scenarioFile;
+
+                regCase.name = nodeCase.getAttribute( "name" );
+
+                if ( regCase.name.empty()
+                  || FDM_SUCCESS != fdm::XmlUtils::read( nodeCase, &scenarioFile ) )
+                {
+                    fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeCase );
+                }
+
+                scenarioFile = fdm::String::stripSpaces( scenarioFile );
+
+                if ( sep != std::string::npos && scenarioFile.size() > 0
+                  && scenarioFile[ 0 ] != '/' && scenarioFile[ 0 ] != '\\' )
+                {
+                    scenarioFile = regressionFile.substr( 0, sep + 1 ) + scenarioFile;
+                }
+
+                regCase.scenario.readFile( scenarioFile.c_str() );
+
+                _cases.push_back( regCase );
+
+                nodeCase = nodeCase.getNextSiblingElement( "case" );
+            }
+
+            if ( _cases.size() == 0 )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+            }
+        }
+        else
+        {
+            fdm::Exception e;
+
+            e.setType( fdm::Exception::FileReadingError );
+            e.setInfo( "Reading file \"" + std::string( file ) + "\" failed. Invalid root node." );
+
+            FDM_THROW( e );
+        }
+    }
+    else
+    {
+        fdm::Exception e;
+
+        e.setType( fdm::Exception::FileReadingError );
+        e.setInfo( "Reading file \"" + std::string( file ) + "\" failed." );
+
+        FDM_THROW( e );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Regression::run( unsigned int threads, bool update, bool verbose )
+{
+    _baselines.clear();
+
+    if ( !update ) readBaselines();
+
+    ThreadPool pool( threads );
+
+    fdm::Log::i() << "Running " << _cases.size() << " regression cases on "
+                  << pool.getThreads() << " threads." << std::endl;
+
+    pool.run( (unsigned int)_cases.size(), [ this, update, verbose ]( unsigned int index )
+    {
+        runCase( &_cases[ index ], update, verbose );
+    });
+
+    for ( Cases::iterator it = _cases.begin(); it != _cases.end(); ++it )
+    {
+        if ( update && it->result.status == Updated )
+        {
+            std::ofstream file( getGoldenFile( it->name ).c_str(),
+                                std::ios_base::out | std::ios_base::trunc );
+
+            if ( file.is_open() )
+            {
+                file << it->result.output;
+                _baselines[ it->name ] = it->result.stepsPerSecond;
+            }
+            else
+            {
+                fdm::Log::e() << "Cannot write golden recording \"" << getGoldenFile( it->name ) << "\"." << std::endl;
+                it->result.status = NoGolden;
+            }
+        }
+
+        fdm::Log::i() << "Regression case \"" << it->name << "\" "
+                      << getStatusName( it->result.status ) << std::endl;
+
+        // time history is not needed anymore
+        std::string().swap( it->result.output );
+    }
+
+    if ( update ) writeBaselines();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Regression::writeReport( std::ostream &out ) const
+{
+    out << "case,result,status,samples,error_ratio,error_column,error_time"
+        << ",steps_per_second,baseline_steps_per_second,throughput_change" << std::endl;
+
+    for ( Cases::const_iterator it = _cases.begin(); it != _cases.end(); ++it )
+    {
+        const Result &result = it->result;
+
+        double change = result.baseline > 0.0 ? result.stepsPerSecond / result.baseline - 1.0 : 0.0;
+
+        out << std::setprecision( 6 )
+            << it->name << ","
+            << ( ( result.status == Passed || result.status == Updated ) ? 1 : 0 ) << ","
+            << getStatusName( result.status ) << ","
+            << result.samples        << ","
+            << result.ratio          << ","
+            << result.column         << ","
+            << result.time           << ","
+            << result.stepsPerSecond << ","
+            << result.baseline       << ","
+            << change
+            << "\n";
+    }
+
+    out.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Regression::getFailures() const
+{
+    unsigned int failures = 0;
+
+    for ( Cases::const_iterator it = _cases.begin(); it != _cases.end(); ++it )
+    {
+        if ( it->result.status != Passed && it->result.status != Updated ) failures++;
+    }
+
+    return failures;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Regression::runCase( Case *regCase, bool update, bool verbose )
+{
+    Result &result = regCase->result;
+
+    result.output.clear();
+    result.column.clear();
+
+    result.time           = 0.0;
+    result.ratio          = 0.0;
+    result.stepsPerSecond = 0.0;
+    result.baseline       = 0.0;
+    result.samples        = 0;
+    result.status         = RunFailed;
+
+    double workTime = 0.0;
+
+    for ( unsigned int i = 0; i < _repeats; i++ )
+    {
+        // every run starts from the same scenario, only the first one is recorded
+        Scenario scenario( regCase->scenario );
+
+        std::ostringstream out;
+
+        Runner runner( &scenario, i == 0 ? &out : FDM_NULLPTR, verbose );
+
+        if ( FDM_SUCCESS != runner.run() ) return;
+
+        if ( i == 0 ) result.output = out.str();
+
+        if ( i == 0 || runner.getWorkTime() < workTime )
+        {
+            workTime = runner.getWorkTime();
+            result.stepsPerSecond = runner.getSteps() / ( workTime > 0.0 ? workTime : 1.0 );
+        }
+    }
+
+    if ( update )
+    {
+        result.status = Updated;
+        return;
+    }
+
+    compare( regCase );
+
+    if ( result.status == Passed )
+    {
+        Baselines::const_iterator it = _baselines.find( regCase->name );
+
+        if ( it != _baselines.end() )
+        {
+            result.baseline = it->second;
+
+            if ( result.stepsPerSecond < ( 1.0 - _threshold ) * result.baseline )
+            {
+                result.status = ThroughputRegression;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Regression::compare( Case *regCase ) const
+{
+    Result &result = regCase->result;
+
+    Trajectory golden;
+    Trajectory actual;
+
+    std::ifstream file( getGoldenFile( regCase->name ).c_str() );
+    std::istringstream out( result.output );
+
+    if ( !file.is_open() || !readTrajectory( file, &golden ) )
+    {
+        result.status = NoGolden;
+        return;
+    }
+
+    // runner output is well formed
+    readTrajectory( out, &actual );
+
+    result.status = Passed;
+
+    if ( golden.columns != actual.columns || golden.values.size() != actual.values.size() )
+    {
+        result.column = "samples";
+        result.ratio  = std::numeric_limits< double >::infinity();
+        result.status = TrajectoryMismatch;
+        return;
+    }
+
+    const size_t cols = golden.columns.size();
+
+    std::vector< double > tolerances( cols );
+
+    for ( size_t j = 0; j < cols; j++ )
+    {
+        tolerances[ j ] = getTolerance( golden.columns[ j ] );
+    }
+
+    for ( size_t i = 0; i < golden.values.size(); i += cols )
+    {
+        for ( size_t j = 0; j < cols; j++ )
+        {
+            double error = getError( golden.columns[ j ],
+                                     actual.values[ i + j ], golden.values[ i + j ] );
+
+            double ratio = 0.0;
+
+            if ( tolerances[ j ] > 0.0 )
+                ratio = error / tolerances[ j ];
+            else if ( error > 0.0 )
+                ratio = std::numeric_limits< double >::infinity();
+
+            if ( ratio > result.ratio )
+            {
+                result.ratio  = ratio;
+                result.column = golden.columns[ j ];
+                result.time   = golden.values[ i ];
+            }
+        }
+
+        result.samples++;
+    }
+
+    if ( result.ratio > 1.0 ) result.status = TrajectoryMismatch;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Regression::readBaselines()
+{
+    std::ifstream file( ( _goldenDir + "/throughput.csv" ).c_str() );
+
+    if ( !file.is_open() )
+    {
+        fdm::Log::w() << "No throughput baselines, throughput is not gated." << std::endl;
+        return;
+    }
+
+    std::string line;
+
+    // header
+    std::getline( file, line );
+
+    while ( std::getline( file, line ) )
+    {
+        std::vector< std::string > tokens = fdm::String::split( line, "," );
+
+        if ( tokens.size() == 2 )
+        {
+            double baseline = fdm::String::toDouble( tokens[ 1 ] );
+
+            if ( baseline > 0.0 ) _baselines[ tokens[ 0 ] ] = baseline;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Regression::writeBaselines() const
+{
+    std::ofstream file( ( _goldenDir + "/throughput.csv" ).c_str(),
+                        std::ios_base::out | std::ios_base::trunc );
+
+    if ( !file.is_open() )
+    {
+        fdm::Log::e() << "Cannot write throughput baselines." << std::endl;
+        return;
+    }
+
+    file << "case,steps_per_second" << std::endl;
+
+    for ( Baselines::const_iterator it = _baselines.begin(); it != _baselines.end(); ++it )
+    {
+        file << std::setprecision( 6 ) << it->first << "," << it->second << "\n";
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Regression::getTolerance( const std::string &column ) const
+{
+    Tolerances::const_iterator it = _tolerances.find( column );
+
+    return it != _tolerances.end() ? it->second : _tolerance;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Regression::getGoldenFile( const std::string &name ) const
+{
+    return _goldenDir + "/" + name + ".csv";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* Regression::getStatusName( Status status )
+{
+    switch ( status )
+    {
+        case Passed:               return "passed";
+        case Updated:              return "updated";
+        case RunFailed:            return "run_failed";
+        case NoGolden:             return "no_golden";
+        case TrajectoryMismatch:   return "trajectory_mismatch";
+        case ThroughputRegression: return "throughput_regression";
+    }
+
+    return "unknown";
+}
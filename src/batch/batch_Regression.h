@@ -0,0 +1,185 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BATCH_REGRESSION_H
+#define BATCH_REGRESSION_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <batch/batch_Scenario.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace batch
+{
+
+/**
+ * @brief Golden trajectory regression class.
+ *
+ * Regression runs every case scenario headless across work stealing thread
+ * pool and compares its output data time history against the stored golden
+ * recording, sample by sample, within per column absolute tolerances. Every
+ * case simulation steps throughput (steps per second of the fastest run) is
+ * compared against the stored baseline and the case fails if throughput
+ * dropped more than the given threshold. In update mode golden recordings
+ * and throughput baselines are written instead of being checked.
+ *
+ * Golden recordings are stored in the golden directory as "{ case name }.csv"
+ * files, in the same format as the batch run output, throughput baselines
+ * are stored in the "throughput.csv" file in the same directory. Cases
+ * without throughput baseline are not gated. Throughput depends on the load
+ * of the machine, so baselines should be recorded with the same number of
+ * threads as are used for checking.
+ *
+ * XML file format:
+ * @code
+ * <batch_regression>
+ *   <golden_dir> { golden recordings directory, relative to the regression file } </golden_dir>
+ *   [<repeats> { number of runs of every case } </repeats>]
+ *   [<threshold> { maximum allowed throughput drop, fraction of the baseline } </threshold>]
+ *   [<tolerances>
+ *     [<default> { default absolute tolerance } </default>]
+ *     [<{ column name }> { column absolute tolerance } </{ column name }>] ... { more columns }
+ *   </tolerances>]
+ *   <case name="{ case name }"> { scenario file path, relative to the regression file } </case>
+ *   ... { more cases }
+ * </batch_regression>
+ * @endcode
+ *
+ * @see Scenario
+ * @see Runner
+ */
+class Regression
+{
+public:
+
+    /** @brief Constructor. */
+    Regression();
+
+    /** @brief Destructor. */
+    virtual ~Regression();
+
+    /**
+     * @brief Reads regression from XML file.
+     * @param file regression file path
+     */
+    void readFile( const char *file );
+
+    /**
+     * @brief Runs all cases.
+     * @param threads number of worker threads, 0 means number of hardware threads
+     * @param update specifies if golden recordings and baselines should be written instead of checked
+     * @param verbose specifies if FDM messages should be logged
+     */
+    void run( unsigned int threads, bool update = false, bool verbose = false );
+
+    /**
+     * @brief Writes cases results report as comma-separated values.
+     * @param out output stream
+     */
+    void writeReport( std::ostream &out ) const;
+
+    /**
+     * @brief Returns number of failed cases.
+     * @return number of failed cases
+     */
+    unsigned int getFailures() const;
+
+    inline unsigned int getCases() const { return (unsigned int)_cases.size(); }
+
+private:
+
+    /** Case status. */
+    enum Status
+    {
+        Passed = 0,                         ///< case passed
+        Updated,                            ///< golden recording and baseline written
+        RunFailed,                          ///< simulation failed
+        NoGolden,                           ///< golden recording missing or invalid
+        TrajectoryMismatch,                 ///< trajectory out of tolerance
+        ThroughputRegression                ///< throughput dropped below threshold
+    };
+
+    /** Case result. */
+    struct Result
+    {
+        std::string output;                 ///< output data time history
+        std::string column;                 ///< column of the largest tolerance ratio
+
+        double time;                        ///< [s] time of the largest tolerance ratio
+        double ratio;                       ///< [-] largest error to tolerance ratio
+
+        double stepsPerSecond;              ///< fastest run steps per second
+        double baseline;                    ///< baseline steps per second, 0 if none
+
+        unsigned int samples;               ///< number of compared samples
+
+        Status status;                      ///< case status
+    };
+
+    /** Regression case. */
+    struct Case
+    {
+        std::string name;                   ///< case name
+        Scenario scenario;                  ///< case scenario
+        Result result;                      ///< case result
+    };
+
+    typedef std::vector< Case > Cases;
+    typedef std::map< std::string, double > Tolerances;
+    typedef std::map< std::string, double > Baselines;
+
+    Cases _cases;                           ///< cases
+
+    Tolerances _tolerances;                 ///< columns absolute tolerances
+    Baselines _baselines;                   ///< throughput baselines
+
+    std::string _goldenDir;                 ///< golden recordings directory
+
+    double _tolerance;                      ///< default absolute tolerance
+    double _threshold;                      ///< maximum allowed throughput drop
+
+    unsigned int _repeats;                  ///< number of runs of every case
+
+    void runCase( Case *regCase, bool update, bool verbose );
+
+    void compare( Case *regCase ) const;
+
+    void readBaselines();
+    void writeBaselines() const;
+
+    double getTolerance( const std::string &column ) const;
+
+    std::string getGoldenFile( const std::string &name ) const;
+
+    static const char* getStatusName( Status status );
+};
+
+} // end of batch namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCH_REGRESSION_H
@@ -0,0 +1,394 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <batch/batch_RotorSweep.h>
+
+#include <iomanip>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/models/fdm_MainRotorBE.h>
+
+#include <fdm/utils/fdm_String.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+#include <batch/batch_ThreadPool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+RotorSweep::RotorSweep() :
+    _points ( 0 ),
+    _revolutions ( 10 ),
+    _ccw ( false ),
+    _nb ( 0 ),
+    _radius  ( 0.0 ),
+    _inertia ( 0.0 ),
+    _inclination ( 0.0 ),
+    _omega ( 0.0 ),
+    _airDensity ( 1.225 ),
+    _timeStep ( 0.005 )
+{
+    for ( unsigned int i = 0; i < Surrogate::_args; i++ )
+    {
+        _strides[ i ] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RotorSweep::~RotorSweep() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorSweep::readFile( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() && 0 == fdm::String::icompare( rootNode.getName(), "rotor_sweep" ) )
+        {
+            int result = FDM_SUCCESS;
+            int revolutions = _revolutions;
+
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_rotorFile, "rotor" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_omega, "omega" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_airDensity, "air_density", true );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &revolutions, "revolutions", true );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_timeStep, "time_step", true );
+
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_keys[ Surrogate::AdvanceRatio ], "advance_ratio" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_keys[ Surrogate::InflowRatio  ], "inflow_ratio"  );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_keys[ Surrogate::Collective   ], "collective"    );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_keys[ Surrogate::CyclicCos    ], "cyclic_cos"    );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_keys[ Surrogate::CyclicSin    ], "cyclic_sin"    );
+
+            if ( result != FDM_SUCCESS || _omega <= 0.0 || _airDensity <= 0.0
+              || revolutions <= 0 || _timeStep <= 0.0 )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+            }
+
+            _revolutions = revolutions;
+
+            // grid size
+            _points = 1;
+
+            for ( int i = Surrogate::_args - 1; i >= 0; i-- )
+            {
+                _strides[ i ] = _points;
+                _points *= _keys[ i ].size();
+            }
+
+            // rotor file path is relative to the sweep file
+            _rotorFile = fdm::String::stripSpaces( _rotorFile );
+
+            std::string sweepFile( file );
+            size_t sep = sweepFile.find_last_of( "/\\" );
+
+            if ( sep != std::string::npos && _rotorFile.size() > 0
+              && _rotorFile[ 0 ] != '/' && _rotorFile[ 0 ] != '\\' )
+            {
+                _rotorFile = sweepFile.substr( 0, sep + 1 ) + _rotorFile;
+            }
+
+            // rotor data
+            fdm::XmlDoc rotorDoc( _rotorFile.c_str() );
+
+            if ( rotorDoc.isOpen() )
+            {
+                fdm::XmlNode rotorNode = rotorDoc.getRootNode();
+
+                fdm::MainRotorBE rotor;
+                rotor.readData( rotorNode );
+
+                fdm::XmlUtils::read( rotorNode, &_inclination, "inclination" );
+
+                _r_hub_bas = rotor.getR_hub_BAS();
+                _ccw       = rotor.getDirection() == fdm::MainRotorBE::CCW;
+                _nb        = rotor.getNumberOfBlades();
+                _radius    = rotor.getRadius();
+                _inertia   = rotor.getInertia();
+            }
+            else
+            {
+                fdm::Exception e;
+
+                e.setType( fdm::Exception::FileReadingError );
+                e.setInfo( "Reading file \"" + _rotorFile + "\" failed." );
+
+                FDM_THROW( e );
+            }
+        }
+        else
+        {
+            fdm::Exception e;
+
+            e.setType( fdm::Exception::FileReadingError );
+            e.setInfo( "Reading file \"" + std::string( file ) + "\" failed. Invalid root node." );
+
+            FDM_THROW( e );
+        }
+    }
+    else
+    {
+        fdm::Exception e;
+
+        e.setType( fdm::Exception::FileReadingError );
+        e.setInfo( "Reading file \"" + std::string( file ) + "\" failed." );
+
+        FDM_THROW( e );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorSweep::run( unsigned int threads )
+{
+    _table.clear();
+    _table.resize( _points * Surrogate::_vals, 0.0 );
+
+    _results.clear();
+    _results.resize( _points, FDM_FAILURE );
+
+    // grid points are already evaluated in parallel
+    bool parallelEnabled = fdm::MainRotorBE::getParallelEnabled();
+    fdm::MainRotorBE::setParallelEnabled( false );
+
+    ThreadPool pool( threads );
+
+    fdm::Log::i() << "Running " << _points << " rotor sweep points on "
+                  << pool.getThreads() << " threads." << std::endl;
+
+    pool.run( _points, [ this ]( unsigned int index )
+    {
+        try
+        {
+            runPoint( index );
+            _results[ index ] = FDM_SUCCESS;
+        }
+        catch ( fdm::Exception &e )
+        {
+            fdm::Log::e() << "Rotor sweep point " << index << " failed. "
+                          << e.getInfo() << std::endl;
+        }
+    });
+
+    fdm::MainRotorBE::setParallelEnabled( parallelEnabled );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorSweep::writeTable( std::ostream &out ) const
+{
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+    out << "<main_rotor counter-clockwise=\"" << ( _ccw ? 1 : 0 ) << "\">" << std::endl;
+
+    out << std::setprecision( 10 );
+
+    out << "  <hub_center> " << _r_hub_bas.x() << " " << _r_hub_bas.y() << " "
+        << _r_hub_bas.z() << " </hub_center>" << std::endl;
+    out << "  <inclination> " << _inclination << " </inclination>" << std::endl;
+    out << "  <number_of_blades> " << _nb << " </number_of_blades>" << std::endl;
+    out << "  <rotor_radius> " << _radius << " </rotor_radius>" << std::endl;
+    out << "  <rotor_inertia> " << _inertia << " </rotor_inertia>" << std::endl;
+
+    writeList( out, "advance_ratio" , _keys[ Surrogate::AdvanceRatio ] );
+    writeList( out, "inflow_ratio"  , _keys[ Surrogate::InflowRatio  ] );
+    writeList( out, "collective"    , _keys[ Surrogate::Collective   ] );
+    writeList( out, "cyclic_cos"    , _keys[ Surrogate::CyclicCos    ] );
+    writeList( out, "cyclic_sin"    , _keys[ Surrogate::CyclicSin    ] );
+
+    out << "  <coefficients>" << std::endl;
+
+    for ( unsigned int i = 0; i < _points; i++ )
+    {
+        out << "   ";
+
+        for ( unsigned int v = 0; v < Surrogate::_vals; v++ )
+        {
+            out << " " << _table[ i * Surrogate::_vals + v ];
+        }
+
+        out << "\n";
+    }
+
+    out << "  </coefficients>" << std::endl;
+    out << "</main_rotor>" << std::endl;
+
+    out.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int RotorSweep::getFailures() const
+{
+    unsigned int failures = 0;
+
+    for ( std::vector< int >::const_iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        if ( (*it) != FDM_SUCCESS ) failures++;
+    }
+
+    return failures;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorSweep::runPoint( unsigned int index )
+{
+    // every point has its own rotor instance
+    fdm::XmlDoc doc( _rotorFile.c_str() );
+    fdm::XmlNode rotorNode = doc.getRootNode();
+
+    fdm::MainRotorBE rotor;
+    rotor.readData( rotorNode );
+
+    double args[ Surrogate::_args ];
+
+    for ( unsigned int i = 0; i < Surrogate::_args; i++ )
+    {
+        args[ i ] = _keys[ i ][ ( index / _strides[ i ] ) % _keys[ i ].size() ];
+    }
+
+    const double cd = _ccw ? 1.0 : -1.0;
+
+    const double omegaR = _omega * _radius;
+
+    const double collective = args[ Surrogate::Collective ];
+    const double cyclicLat  = -cd * args[ Surrogate::CyclicCos ];
+    const double cyclicLon  = args[ Surrogate::CyclicSin ];
+
+    fdm::Matrix3x3 ras2bas = fdm::Matrix3x3( fdm::Angles( 0.0, -_inclination, 0.0 ) ).getTransposed();
+    fdm::Matrix3x3 bas2ras = ras2bas.getTransposed();
+
+    fdm::Vector3 vel_air_bas = ras2bas * fdm::Vector3( args[ Surrogate::AdvanceRatio ] * omegaR,
+                                                       0.0,
+                                                       args[ Surrogate::InflowRatio  ] * omegaR );
+    fdm::Vector3 grav_bas = ras2bas * fdm::Vector3( 0.0, 0.0, 9.80665 );
+    fdm::Vector3 zero;
+
+    // time step is adjusted so every revolution has integer number of steps
+    const unsigned int stepsPerRev = (unsigned int)ceil( 2.0 * M_PI / ( _omega * _timeStep ) );
+    const double timeStep = 2.0 * M_PI / ( _omega * stepsPerRev );
+
+    double azimuth = 0.0;
+
+    // hub loads sums
+    double vals[ Surrogate::CMZ + 1 ];
+
+    for ( unsigned int v = 0; v <= Surrogate::CMZ; v++ )
+    {
+        vals[ v ] = 0.0;
+    }
+
+    // flapping sums
+    double beta_0  = 0.0;
+    double beta_1c = 0.0;
+    double beta_1s = 0.0;
+
+    for ( unsigned int i = 0; i < _revolutions * stepsPerRev; i++ )
+    {
+        azimuth = fmod( azimuth + _omega * timeStep, 2.0 * M_PI );
+
+        rotor.update( timeStep, vel_air_bas, zero, zero, zero, zero, grav_bas,
+                      _omega, azimuth, _airDensity,
+                      collective, cyclicLat, cyclicLon );
+
+        // averaging over the last revolution
+        if ( i >= ( _revolutions - 1 ) * stepsPerRev )
+        {
+            rotor.computeForceAndMoment( vel_air_bas, zero, zero, zero, zero, grav_bas,
+                                         _airDensity );
+
+            fdm::Vector3 for_ras = bas2ras * rotor.getFor_BAS();
+            fdm::Vector3 mom_ras = bas2ras * ( rotor.getMom_BAS() - ( _r_hub_bas % rotor.getFor_BAS() ) );
+
+            vals[ Surrogate::CFX ] += for_ras.x();
+            vals[ Surrogate::CFY ] += for_ras.y();
+            vals[ Surrogate::CFZ ] += for_ras.z();
+            vals[ Surrogate::CMX ] += mom_ras.x();
+            vals[ Surrogate::CMY ] += mom_ras.y();
+            vals[ Surrogate::CMZ ] += mom_ras.z();
+
+            // flapping first harmonics
+            for ( int j = 0; j < rotor.getNumberOfBlades(); j++ )
+            {
+                double psi  = azimuth + 2.0 * M_PI * j / (double)rotor.getNumberOfBlades();
+                double beta = rotor.getBlade( j )->getBeta();
+
+                beta_0  += beta;
+                beta_1c += beta * cos( psi );
+                beta_1s += beta * sin( psi );
+            }
+        }
+    }
+
+    const double samples = stepsPerRev * rotor.getNumberOfBlades();
+
+    beta_0  /= samples;
+    beta_1c *= 2.0 / samples;
+    beta_1s *= 2.0 / samples;
+
+    const double area = M_PI * _radius * _radius;
+
+    const double f_coef = _airDensity * area * omegaR * omegaR * stepsPerRev;
+    const double m_coef = f_coef * _radius;
+
+    double *entry = &( _table[ index * Surrogate::_vals ] );
+
+    entry[ Surrogate::CFX ] = vals[ Surrogate::CFX ] / f_coef;
+    entry[ Surrogate::CFY ] = vals[ Surrogate::CFY ] / f_coef;
+    entry[ Surrogate::CFZ ] = vals[ Surrogate::CFZ ] / f_coef;
+    entry[ Surrogate::CMX ] = vals[ Surrogate::CMX ] / m_coef;
+    entry[ Surrogate::CMY ] = vals[ Surrogate::CMY ] / m_coef;
+    entry[ Surrogate::CMZ ] = vals[ Surrogate::CMZ ] / m_coef;
+
+    // disc attitude as in fdm::MainRotor
+    entry[ Surrogate::Coning    ] =  beta_0;
+    entry[ Surrogate::DiscRoll  ] = -beta_1s * cd;
+    entry[ Surrogate::DiscPitch ] = -beta_1c;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorSweep::writeList( std::ostream &out, const char *name,
+                            const std::vector< double > &list )
+{
+    out << "  <" << name << ">";
+
+    for ( unsigned int i = 0; i < list.size(); i++ )
+    {
+        out << " " << list[ i ];
+    }
+
+    out << " </" << name << ">" << std::endl;
+}
@@ -0,0 +1,146 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BATCH_ROTORSWEEP_H
+#define BATCH_ROTORSWEEP_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fdm/models/fdm_MainRotorSurrogate.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace batch
+{
+
+/**
+ * @brief Blade element main rotor sweep class.
+ *
+ * Rotor sweep evaluates blade element main rotor model (fdm::MainRotorBE)
+ * over a grid of advance ratio, inflow ratio, collective and cyclic pitch
+ * values and writes the results as fdm::MainRotorSurrogate data. At every
+ * grid point rotor is integrated at constant conditions over the given number
+ * of revolutions and hub loads and disc attitude are averaged over the last
+ * revolution, disc attitude is obtained from blades flapping angles first
+ * harmonics. Airflow is along RAS x-axis, so RAS is coincident with RWAS,
+ * and gravity acts along the shaft axis. Grid points are evaluated in
+ * parallel, each with its own rotor instance, so results do not depend on
+ * number of threads.
+ *
+ * XML file format:
+ * @code
+ * <rotor_sweep>
+ *   <rotor> { blade element main rotor data file path, relative to the sweep file } </rotor>
+ *   <omega> { [rad/s] rotor revolution speed } </omega>
+ *   [<air_density> { [kg/m^3] air density } </air_density>]
+ *   [<revolutions> { number of revolutions at every grid point } </revolutions>]
+ *   [<time_step> { [s] time step } </time_step>]
+ *   <advance_ratio> { [-] advance ratio values } </advance_ratio>
+ *   <inflow_ratio> { [-] inflow ratio values } </inflow_ratio>
+ *   <collective> { [rad] collective pitch values } </collective>
+ *   <cyclic_cos> { [rad] cyclic pitch cosine component values } </cyclic_cos>
+ *   <cyclic_sin> { [rad] cyclic pitch sine component values } </cyclic_sin>
+ * </rotor_sweep>
+ * @endcode
+ *
+ * Rotor data file root node is blade element main rotor node.
+ *
+ * @see fdm::MainRotorSurrogate
+ */
+class RotorSweep
+{
+public:
+
+    /** @brief Constructor. */
+    RotorSweep();
+
+    /** @brief Destructor. */
+    virtual ~RotorSweep();
+
+    /**
+     * @brief Reads rotor sweep from XML file.
+     * @param file rotor sweep file path
+     */
+    void readFile( const char *file );
+
+    /**
+     * @brief Evaluates all grid points.
+     * @param threads number of worker threads, 0 means number of hardware threads
+     */
+    void run( unsigned int threads );
+
+    /**
+     * @brief Writes surrogate main rotor data.
+     * @param out output stream
+     */
+    void writeTable( std::ostream &out ) const;
+
+    /**
+     * @brief Returns number of failed grid points.
+     * @return number of failed grid points
+     */
+    unsigned int getFailures() const;
+
+    inline unsigned int getPoints() const { return _points; }
+
+private:
+
+    typedef fdm::MainRotorSurrogate Surrogate;
+
+    std::string _rotorFile;                         ///< rotor data file path
+
+    std::vector< double > _keys[ Surrogate::_args ];///< grid arguments values
+    std::vector< double > _table;                   ///< grid points results
+    std::vector< int > _results;                    ///< grid points run results
+
+    unsigned int _strides[ Surrogate::_args ];      ///< grid strides (in points)
+
+    unsigned int _points;                           ///< number of grid points
+    unsigned int _revolutions;                      ///< number of revolutions at every grid point
+
+    fdm::Vector3 _r_hub_bas;                        ///< [m] rotor hub coordinates expressed in BAS
+
+    bool _ccw;                                      ///< specifies if rotor rotation direction is counter-clockwise
+
+    int _nb;                                        ///< number of rotor blades
+
+    double _radius;                                 ///< [m] rotor radius
+    double _inertia;                                ///< [kg*m^2] rotor total inertia about shaft axis
+    double _inclination;                            ///< [rad] rotor inclination angle
+    double _omega;                                  ///< [rad/s] rotor revolution speed
+    double _airDensity;                             ///< [kg/m^3] air density
+    double _timeStep;                               ///< [s] time step
+
+    void runPoint( unsigned int index );
+
+    static void writeList( std::ostream &out, const char *name,
+                           const std::vector< double > &list );
+};
+
+} // end of batch namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCH_ROTORSWEEP_H
@@ -0,0 +1,229 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <batch/batch_Runner.h>
+
+#include <cstring>
+#include <iomanip>
+
+#include <fdm/fdm_Log.h>
+#include <fdm/fdm_Manager.h>
+
+#include <fdm/utils/fdm_AllocTracker.h>
+#include <fdm/utils/fdm_Time.h>
+#include <fdm/utils/fdm_Units.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int Runner::_maxInitSteps = 10000;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Runner::Runner( Scenario *scenario, std::ostream *out, bool verbose ) :
+    _scenario ( scenario ),
+    _out ( out ),
+
+    _simTime  ( 0.0 ),
+    _compTime ( 0.0 ),
+    _workTime ( 0.0 ),
+    _derivTime ( 0.0 ),
+
+    _derivCount ( 0 ),
+    _allocs ( 0 ),
+
+    _steps ( 0 ),
+
+    _verbose ( verbose )
+{
+    memset( &_dataInp, 0, sizeof(fdm::DataInp) );
+    memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Runner::~Runner() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Runner::run()
+{
+    const double timeStep   = _scenario->getTimeStep();
+    const double duration   = _scenario->getDuration();
+    const double outputStep = _scenario->getOutputStep();
+
+    fdm::Manager manager( &_dataInp, &_dataOut );
+    manager.setVerbose( _verbose );
+
+    // runs are offline, waiting for the model to be built costs nothing
+    manager.setBackgroundBuild( false );
+
+    fdm::EventScript *events = _scenario->getEvents();
+
+    _scenario->initDataInp( &_dataInp );
+    _scenario->updateDataInp( 0.0, &_dataInp );
+
+    events->reset();
+
+    double compTime_0 = fdm::Time::get();
+
+    // initialization
+    _dataInp.stateInp = fdm::DataInp::Init;
+
+    for ( unsigned int i = 0; i < _maxInitSteps; i++ )
+    {
+        manager.step( timeStep );
+
+        if ( _dataOut.stateOut == fdm::DataOut::Ready
+          || _dataOut.stateOut == fdm::DataOut::Stopped )
+        {
+            break;
+        }
+    }
+
+    if ( _dataOut.stateOut != fdm::DataOut::Ready )
+    {
+        _compTime = fdm::Time::get() - compTime_0;
+        fdm::Log::e() << "Batch run initialization failed." << std::endl;
+        return FDM_FAILURE;
+    }
+
+    // simulation
+    writeHeader();
+    writeSample();
+
+    double outputTime = outputStep;
+
+    _dataInp.stateInp = fdm::DataInp::Work;
+
+    while ( _simTime < duration && _dataOut.stateOut != fdm::DataOut::Stopped )
+    {
+        _scenario->updateDataInp( _simTime, &_dataInp );
+
+        if ( events->update( timeStep, _dataOut, &_dataInp ) > 0 && _verbose )
+        {
+            for ( unsigned int i = 0; i < events->getEventsCount(); i++ )
+            {
+                if ( events->isFired( i ) && events->getFiredTime( i ) == events->getTime() )
+                {
+                    fdm::Log::i() << "Event \"" << events->getName( i ) << "\" fired at "
+                                  << _simTime << " s." << std::endl;
+                }
+            }
+        }
+
+        fdm::UInt64 allocs_0 = fdm::AllocTracker::getCount();
+        double stepTime_0 = fdm::Time::get();
+
+        manager.step( timeStep );
+
+        double stepTime = fdm::Time::get() - stepTime_0;
+
+        _allocs += fdm::AllocTracker::getCount() - allocs_0;
+
+        _workTime += stepTime;
+        _stepTimeHist.add( stepTime );
+
+        _derivTime  += _dataOut.timing.deriv;
+        _derivCount += _dataOut.timing.derivCount;
+
+        _steps++;
+        _simTime = _steps * timeStep;
+
+        if ( _simTime >= outputTime - 0.5 * timeStep )
+        {
+            writeSample();
+            outputTime += outputStep;
+        }
+    }
+
+    bool finished = _dataOut.stateOut == fdm::DataOut::Working;
+
+    // stopping
+    _dataInp.stateInp = fdm::DataInp::Stop;
+    manager.step( timeStep );
+
+    _compTime = fdm::Time::get() - compTime_0;
+
+    return finished ? FDM_SUCCESS : FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Runner::writeHeader()
+{
+    if ( _out == FDM_NULLPTR ) return;
+
+    (*_out) << "time,latitude,longitude,altitude_asl,altitude_agl,"
+            << "roll,pitch,heading,angle_of_attack,sideslip_angle,"
+            << "airspeed,climb_rate,roll_rate,pitch_rate,yaw_rate,"
+            << "g_force_x,g_force_y,g_force_z,on_ground,stall";
+
+    for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        (*_out) << ",engine_" << i << "_rpm";
+    }
+
+    (*_out) << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Runner::writeSample()
+{
+    if ( _out == FDM_NULLPTR ) return;
+
+    const fdm::DataOut::Flight &flight = _dataOut.flight;
+
+    (*_out) << std::setprecision( 10 )
+            << _simTime << ","
+            << fdm::Units::rad2deg( flight.latitude  ) << ","
+            << fdm::Units::rad2deg( flight.longitude ) << ","
+            << std::setprecision( 6 )
+            << flight.altitude_asl << ","
+            << flight.altitude_agl << ","
+            << fdm::Units::rad2deg( flight.roll    ) << ","
+            << fdm::Units::rad2deg( flight.pitch   ) << ","
+            << fdm::Units::rad2deg( flight.heading ) << ","
+            << fdm::Units::rad2deg( flight.angleOfAttack ) << ","
+            << fdm::Units::rad2deg( flight.sideslipAngle ) << ","
+            << flight.airspeed  << ","
+            << flight.climbRate << ","
+            << fdm::Units::rad2deg( flight.rollRate  ) << ","
+            << fdm::Units::rad2deg( flight.pitchRate ) << ","
+            << fdm::Units::rad2deg( flight.yawRate   ) << ","
+            << flight.g_force_x << ","
+            << flight.g_force_y << ","
+            << flight.g_force_z << ","
+            << ( flight.onGround ? 1 : 0 ) << ","
+            << ( flight.stall    ? 1 : 0 );
+
+    for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        (*_out) << "," << _dataOut.engine[ i ].rpm;
+    }
+
+    (*_out) << "\n";
+}
@@ -0,0 +1,117 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+
+#include <fdm/fdm_DataInp.h>
+#include <fdm/fdm_DataOut.h>
+
+#include <fdm/utils/fdm_Histogram.h>
+
+#include <batch/batch_Scenario.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace batch
+{
+
+/**
+ * @brief Headless batch run class.
+ *
+ * Runner steps fdm::Manager as fast as possible, without any wall-clock
+ * pacing, feeding scenario control inputs and writing output data samples
+ * as comma-separated values. Performance statistics (computations time,
+ * state derivative evaluations and heap allocations) are collected over
+ * simulation steps only, initialization is excluded.
+ */
+class Runner
+{
+public:
+
+    static const unsigned int _maxInitSteps;    ///< maximum number of initialization steps
+
+    /**
+     * @brief Constructor.
+     * @param scenario scenario
+     * @param out output data stream, might be null if no output is required
+     * @param verbose specifies if FDM messages should be logged
+     */
+    Runner( Scenario *scenario, std::ostream *out, bool verbose = false );
+
+    /** @brief Destructor. */
+    virtual ~Runner();
+
+    /**
+     * @brief Runs simulation.
+     * @return FDM_SUCCESS if whole scenario has been simulated, FDM_FAILURE otherwise
+     */
+    int run();
+
+    inline const fdm::DataOut& getDataOut() const { return _dataOut; }
+
+    inline double       getSimTime()  const { return _simTime;  }
+    inline double       getCompTime() const { return _compTime; }
+    inline double       getWorkTime() const { return _workTime; }
+    inline unsigned int getSteps()    const { return _steps;    }
+
+    inline double      getDerivTime()  const { return _derivTime;  }
+    inline fdm::UInt64 getDerivCount() const { return _derivCount; }
+    inline fdm::UInt64 getAllocs()     const { return _allocs;     }
+
+    /** @brief Returns simulation steps computations time histogram. */
+    inline const fdm::Histogram& getStepTimeHist() const { return _stepTimeHist; }
+
+private:
+
+    Scenario *_scenario;        ///< scenario
+    std::ostream *_out;         ///< output data stream
+
+    fdm::DataInp _dataInp;      ///< FDM input data
+    fdm::DataOut _dataOut;      ///< FDM output data
+
+    double _simTime;            ///< [s] simulation time
+    double _compTime;           ///< [s] computations time
+    double _workTime;           ///< [s] simulation steps computations time
+    double _derivTime;          ///< [s] state derivative computations time
+
+    fdm::UInt64 _derivCount;    ///< number of state derivative evaluations
+    fdm::UInt64 _allocs;        ///< number of heap allocations during simulation steps
+
+    fdm::Histogram _stepTimeHist;   ///< simulation steps computations time histogram
+
+    unsigned int _steps;        ///< number of steps
+
+    bool _verbose;              ///< specifies if FDM messages should be logged
+
+    void writeHeader();
+    void writeSample();
+};
+
+} // end of batch namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCH_RUNNER_H
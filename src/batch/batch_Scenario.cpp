@@ -0,0 +1,523 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <batch/batch_Scenario.h>
+
+#include <cstring>
+
+#include <fdm/fdm_Exception.h>
+
+#include <fdm/main/fdm_CollisionGeometry.h>
+
+#include <fdm/utils/fdm_String.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Scenario::Scenario() :
+    _timeStep   ( FDM_TIME_STEP ),
+    _duration   ( 0.0 ),
+    _outputStep ( 0.0 )
+{
+    memset( &_dataInp, 0, sizeof(fdm::DataInp) );
+
+    _dataInp.environment.temperature_0 = 288.15;
+    _dataInp.environment.pressure_0    = 101325.0;
+
+    _dataInp.controls.lgh = true;
+    _dataInp.controls.nws = true;
+    _dataInp.controls.abs = true;
+
+    for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        _dataInp.engine[ i ].mixture   = 1.0;
+        _dataInp.engine[ i ].propeller = 1.0;
+        _dataInp.engine[ i ].fuel      = true;
+        _dataInp.engine[ i ].ignition  = true;
+    }
+
+    _dataInp.recording.mode = fdm::DataInp::Recording::Disabled;
+
+    _dataInp.stateInp = fdm::DataInp::Idle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Scenario::Scenario( const Scenario &scenario ) :
+    _dataInp ( scenario._dataInp ),
+
+    _events ( scenario._events ),
+
+    _timeStep   ( scenario._timeStep   ),
+    _duration   ( scenario._duration   ),
+    _outputStep ( scenario._outputStep )
+{
+    copyChannels( scenario );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Scenario::~Scenario() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const Scenario& Scenario::operator= ( const Scenario &scenario )
+{
+    if ( this != &scenario )
+    {
+        _dataInp = scenario._dataInp;
+        _events  = scenario._events;
+
+        _timeStep   = scenario._timeStep;
+        _duration   = scenario._duration;
+        _outputStep = scenario._outputStep;
+
+        copyChannels( scenario );
+    }
+
+    return (*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readFile( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() && 0 == fdm::String::icompare( rootNode.getName(), "batch_scenario" ) )
+        {
+            readData( rootNode );
+        }
+        else
+        {
+            fdm::Exception e;
+
+            e.setType( fdm::Exception::FileReadingError );
+            e.setInfo( "Reading file \"" + std::string( file ) + "\" failed. Invalid root node." );
+
+            FDM_THROW( e );
+        }
+    }
+    else
+    {
+        fdm::Exception e;
+
+        e.setType( fdm::Exception::FileReadingError );
+        e.setInfo( "Reading file \"" + std::string( file ) + "\" failed." );
+
+        FDM_THROW( e );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::initDataInp( fdm::DataInp *dataInp ) const
+{
+    (*dataInp) = _dataInp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::updateDataInp( double time, fdm::DataInp *dataInp )
+{
+    for ( Channels::iterator it = _channels.begin(); it != _channels.end(); ++it )
+    {
+        double value = it->history.getValue( time, it->cursor );
+
+        if ( it->flag )
+            (*it->flag) = value > 0.5;
+        else
+            (*it->value) = value;
+    }
+
+    dataInp->controls = _dataInp.controls;
+
+    for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        dataInp->engine[ i ] = _dataInp.engine[ i ];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::copyChannels( const Scenario &scenario )
+{
+    // channels destinations have to point to this object input data
+    const char *src = reinterpret_cast< const char* >( &scenario._dataInp );
+    char *dst = reinterpret_cast< char* >( &_dataInp );
+
+    _channels = scenario._channels;
+
+    for ( Channels::iterator it = _channels.begin(); it != _channels.end(); ++it )
+    {
+        it->cursor = 0;
+
+        if ( it->value )
+            it->value = reinterpret_cast< double* >( dst + ( reinterpret_cast< const char* >( it->value ) - src ) );
+
+        if ( it->flag )
+            it->flag = reinterpret_cast< bool* >( dst + ( reinterpret_cast< const char* >( it->flag ) - src ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readData( const fdm::XmlNode &rootNode )
+{
+    int result = FDM_SUCCESS;
+
+    if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_timeStep   , "time_step"   , true );
+    if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_duration   , "duration"    );
+    if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &_outputStep , "output_step" , true );
+
+    if ( result != FDM_SUCCESS || _timeStep <= 0.0 || _duration <= 0.0 )
+    {
+        fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+    }
+
+    readAircraft    ( rootNode );
+    readInitial     ( rootNode );
+    readEnvironment ( rootNode );
+    readGround      ( rootNode );
+    readMasses      ( rootNode );
+    readControls    ( rootNode );
+    readEngines     ( rootNode );
+    readEvents      ( rootNode );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readAircraft( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeAircraft = rootNode.getFirstChildElement( "aircraft" );
+
+    std::string name;
+
+    if ( FDM_SUCCESS == fdm::XmlUtils::read( nodeAircraft, &name ) )
+    {
+        name = fdm::String::stripSpaces( name );
+
+        if      ( 0 == fdm::String::icompare( name, "aw101" ) ) _dataInp.aircraftType = fdm::DataInp::AW101;
+        else if ( 0 == fdm::String::icompare( name, "c130"  ) ) _dataInp.aircraftType = fdm::DataInp::C130;
+        else if ( 0 == fdm::String::icompare( name, "c172"  ) ) _dataInp.aircraftType = fdm::DataInp::C172;
+        else if ( 0 == fdm::String::icompare( name, "f16"   ) ) _dataInp.aircraftType = fdm::DataInp::F16;
+        else if ( 0 == fdm::String::icompare( name, "f35a"  ) ) _dataInp.aircraftType = fdm::DataInp::F35A;
+        else if ( 0 == fdm::String::icompare( name, "p51"   ) ) _dataInp.aircraftType = fdm::DataInp::P51;
+        else if ( 0 == fdm::String::icompare( name, "pw5"   ) ) _dataInp.aircraftType = fdm::DataInp::PW5;
+        else if ( 0 == fdm::String::icompare( name, "r44"   ) ) _dataInp.aircraftType = fdm::DataInp::R44;
+        else if ( 0 == fdm::String::icompare( name, "uh60"  ) ) _dataInp.aircraftType = fdm::DataInp::UH60;
+#       ifdef FDM_TEST
+        else if ( 0 == fdm::String::icompare( name, "xf"    ) ) _dataInp.aircraftType = fdm::DataInp::XF;
+        else if ( 0 == fdm::String::icompare( name, "xh"    ) ) _dataInp.aircraftType = fdm::DataInp::XH;
+#       endif
+        else
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeAircraft );
+        }
+    }
+    else
+    {
+        fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readInitial( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeInitial = rootNode.getFirstChildElement( "initial" );
+
+    if ( nodeInitial.isValid() )
+    {
+        fdm::DataInp::Initial &initial = _dataInp.initial;
+
+        int result = FDM_SUCCESS;
+        int engineOn = 0;
+
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &initial.latitude     , "latitude"     );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &initial.longitude    , "longitude"    );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &initial.altitude_agl , "altitude_agl" );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &initial.heading      , "heading"      );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &initial.airspeed     , "airspeed"     );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &initial.offset_x     , "offset_x"     , true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &initial.offset_y     , "offset_y"     , true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeInitial, &engineOn             , "engine_on"    , true );
+
+        if ( result != FDM_SUCCESS )
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeInitial );
+        }
+
+        initial.engineOn = engineOn != 0;
+    }
+    else
+    {
+        fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readEnvironment( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeEnvironment = rootNode.getFirstChildElement( "environment" );
+
+    if ( nodeEnvironment.isValid() )
+    {
+        fdm::DataInp::Environment &environment = _dataInp.environment;
+
+        int result = FDM_SUCCESS;
+        int seed = environment.seed;
+        int atmosphereTable = environment.atmosphereTable ? 1 : 0;
+
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeEnvironment, &environment.temperature_0  , "temperature_0"  , true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeEnvironment, &environment.pressure_0     , "pressure_0"     , true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeEnvironment, &environment.wind_direction , "wind_direction" , true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeEnvironment, &environment.wind_speed     , "wind_speed"     , true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeEnvironment, &seed                       , "seed"           , true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeEnvironment, &atmosphereTable            , "atmosphere_table" , true );
+
+        if ( result != FDM_SUCCESS )
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeEnvironment );
+        }
+
+        environment.seed = seed;
+        environment.atmosphereTable = atmosphereTable != 0;
+
+        fdm::XmlNode nodeWindField = nodeEnvironment.getFirstChildElement( "wind_field" );
+
+        if ( nodeWindField.isValid() )
+        {
+            std::string file = fdm::String::stripSpaces( nodeWindField.getText() );
+            strncpy( environment.windField, file.c_str(), 4095 );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readGround( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeGround = rootNode.getFirstChildElement( "ground" );
+
+    if ( nodeGround.isValid() )
+    {
+        if ( FDM_SUCCESS != fdm::XmlUtils::read( nodeGround, &_dataInp.ground.elevation, "elevation" ) )
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeGround );
+        }
+
+        fdm::XmlNode nodeMesh = nodeGround.getFirstChildElement( "collision_mesh" );
+
+        while ( nodeMesh.isValid() )
+        {
+            int result = FDM_SUCCESS;
+
+            std::string file;
+
+            double lat = 0.0;
+            double lon = 0.0;
+            double alt = 0.0;
+            double hdg = 0.0;
+            double vel = 0.0;
+            double rot = 0.0;
+
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMesh, &file , "file"      );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMesh, &lat  , "latitude"  );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMesh, &lon  , "longitude" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMesh, &alt  , "altitude"  );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMesh, &hdg  , "heading"   , true );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMesh, &vel  , "speed"     , true );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMesh, &rot  , "turn_rate" , true );
+
+            if ( result == FDM_SUCCESS ) result = fdm::CollisionGeometry::readMesh( file.c_str(), lat, lon, alt, hdg, vel, rot );
+
+            if ( result != FDM_SUCCESS )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeMesh );
+            }
+
+            nodeMesh = nodeMesh.getNextSiblingElement( "collision_mesh" );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readMasses( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeMasses = rootNode.getFirstChildElement( "masses" );
+
+    if ( nodeMasses.isValid() )
+    {
+        fdm::DataInp::Masses &masses = _dataInp.masses;
+
+        fdm::XmlNode nodePilot = nodeMasses.getFirstChildElement( "pilot" );
+
+        while ( nodePilot.isValid() )
+        {
+            int index = fdm::String::toInt( nodePilot.getAttribute( "index" ), -1 );
+
+            if ( index < 0 || index >= FDM_MAX_PILOTS
+              || FDM_SUCCESS != fdm::XmlUtils::read( nodePilot, &masses.pilot[ index ] ) )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, nodePilot );
+            }
+
+            nodePilot = nodePilot.getNextSiblingElement( "pilot" );
+        }
+
+        fdm::XmlNode nodeTank = nodeMasses.getFirstChildElement( "tank" );
+
+        while ( nodeTank.isValid() )
+        {
+            int index = fdm::String::toInt( nodeTank.getAttribute( "index" ), -1 );
+
+            if ( index < 0 || index >= FDM_MAX_TANKS
+              || FDM_SUCCESS != fdm::XmlUtils::read( nodeTank, &masses.tank[ index ] ) )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeTank );
+            }
+
+            nodeTank = nodeTank.getNextSiblingElement( "tank" );
+        }
+
+        int result = FDM_SUCCESS;
+
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMasses, &masses.cabin, "cabin", true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMasses, &masses.trunk, "trunk", true );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( nodeMasses, &masses.slung, "slung", true );
+
+        if ( result != FDM_SUCCESS )
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeMasses );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readControls( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeControls = rootNode.getFirstChildElement( "controls" );
+
+    if ( nodeControls.isValid() )
+    {
+        fdm::DataInp::Controls &controls = _dataInp.controls;
+
+        addChannel( nodeControls, "roll"         , &controls.roll         );
+        addChannel( nodeControls, "pitch"        , &controls.pitch        );
+        addChannel( nodeControls, "yaw"          , &controls.yaw          );
+        addChannel( nodeControls, "trim_roll"    , &controls.trim_roll    );
+        addChannel( nodeControls, "trim_pitch"   , &controls.trim_pitch   );
+        addChannel( nodeControls, "trim_yaw"     , &controls.trim_yaw     );
+        addChannel( nodeControls, "brake_l"      , &controls.brake_l      );
+        addChannel( nodeControls, "brake_r"      , &controls.brake_r      );
+        addChannel( nodeControls, "wheel_brake"  , &controls.wheel_brake  );
+        addChannel( nodeControls, "landing_gear" , &controls.landing_gear );
+        addChannel( nodeControls, "wheel_nose"   , &controls.wheel_nose   );
+        addChannel( nodeControls, "flaps"        , &controls.flaps        );
+        addChannel( nodeControls, "airbrake"     , &controls.airbrake     );
+        addChannel( nodeControls, "spoilers"     , &controls.spoilers     );
+        addChannel( nodeControls, "collective"   , &controls.collective   );
+
+        addChannel( nodeControls, "lgh", FDM_NULLPTR, &controls.lgh );
+        addChannel( nodeControls, "nws", FDM_NULLPTR, &controls.nws );
+        addChannel( nodeControls, "abs", FDM_NULLPTR, &controls.abs );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readEngines( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeEngine = rootNode.getFirstChildElement( "engine" );
+
+    while ( nodeEngine.isValid() )
+    {
+        int index = fdm::String::toInt( nodeEngine.getAttribute( "index" ), -1 );
+
+        if ( index < 0 || index >= FDM_MAX_ENGINES )
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, nodeEngine );
+        }
+
+        fdm::DataInp::Engine &engine = _dataInp.engine[ index ];
+
+        addChannel( nodeEngine, "throttle"  , &engine.throttle  );
+        addChannel( nodeEngine, "mixture"   , &engine.mixture   );
+        addChannel( nodeEngine, "propeller" , &engine.propeller );
+
+        addChannel( nodeEngine, "fuel"     , FDM_NULLPTR, &engine.fuel     );
+        addChannel( nodeEngine, "ignition" , FDM_NULLPTR, &engine.ignition );
+        addChannel( nodeEngine, "starter"  , FDM_NULLPTR, &engine.starter  );
+
+        nodeEngine = nodeEngine.getNextSiblingElement( "engine" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::addChannel( const fdm::XmlNode &parentNode, const char *name,
+                           double *value, bool *flag )
+{
+    fdm::XmlNode node = parentNode.getFirstChildElement( name );
+
+    if ( node.isValid() )
+    {
+        Channel channel;
+
+        channel.cursor = 0;
+        channel.value  = value;
+        channel.flag   = flag;
+
+        if ( FDM_SUCCESS != fdm::XmlUtils::read( node, &channel.history ) )
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, node );
+        }
+
+        _channels.push_back( channel );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenario::readEvents( const fdm::XmlNode &rootNode )
+{
+    fdm::XmlNode nodeEvents = rootNode.getFirstChildElement( "events" );
+
+    if ( nodeEvents.isValid() )
+    {
+        _events.readData( nodeEvents );
+    }
+}
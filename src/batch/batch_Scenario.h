@@ -0,0 +1,215 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BATCH_SCENARIO_H
+#define BATCH_SCENARIO_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_DataInp.h>
+
+#include <fdm/main/fdm_EventScript.h>
+
+#include <fdm/utils/fdm_Table1.h>
+
+#include <fdm/xml/fdm_XmlNode.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace batch
+{
+
+/**
+ * @brief Batch run scenario class.
+ *
+ * Scenario holds initial conditions and time histories of control inputs
+ * to be fed into fdm::DataInp structure during headless simulation run.
+ * Each control channel is given as time history table linearly interpolated
+ * in time, boolean channels are true when interpolated value exceeds 0.5.
+ *
+ * XML file format:
+ * @code
+ * <batch_scenario>
+ *   <aircraft> { aw101|c130|c172|f16|f35a|p51|pw5|r44|uh60 } </aircraft>
+ *   [<time_step> { [s] integration time step } </time_step>]
+ *   <duration> { [s] simulation time } </duration>
+ *   [<output_step> { [s] output sampling period } </output_step>]
+ *   <initial>
+ *     <latitude> { [rad] latitude } </latitude>
+ *     <longitude> { [rad] longitude } </longitude>
+ *     <altitude_agl> { [m] altitude above ground level } </altitude_agl>
+ *     <heading> { [rad] heading } </heading>
+ *     <airspeed> { [m/s] airspeed } </airspeed>
+ *     [<engine_on> { 0|1 } </engine_on>]
+ *   </initial>
+ *   [<environment>
+ *     [<temperature_0> { [K] sea level temperature } </temperature_0>]
+ *     [<pressure_0> { [Pa] sea level pressure } </pressure_0>]
+ *     [<wind_direction> { [rad] wind direction } </wind_direction>]
+ *     [<wind_speed> { [m/s] wind speed } </wind_speed>]
+ *     [<seed> { random number generator seed } </seed>]
+ *     [<atmosphere_table> { 0|1 } </atmosphere_table>]
+ *     [<wind_field> { wind field file } </wind_field>]
+ *   </environment>]
+ *   [<ground>
+ *     <elevation> { [m] ground elevation } </elevation>
+ *     [<collision_mesh>
+ *       <file> { Wavefront OBJ file } </file>
+ *       <latitude> { [rad] mesh origin latitude } </latitude>
+ *       <longitude> { [rad] mesh origin longitude } </longitude>
+ *       <altitude> { [m] mesh origin altitude above mean sea level } </altitude>
+ *       [<heading> { [rad] mesh heading } </heading>]
+ *       [<speed> { [m/s] moving platform (e.g. ship) speed } </speed>]
+ *       [<turn_rate> { [rad/s] moving platform turn rate } </turn_rate>]
+ *     </collision_mesh>] ... { more collision meshes }
+ *   </ground>]
+ *   [<masses>
+ *     [<pilot index="{ index }"> { [kg] mass } </pilot>] ... { more pilots }
+ *     [<tank index="{ index }"> { [kg] mass } </tank>] ... { more tanks }
+ *     [<cabin> { [kg] mass } </cabin>]
+ *     [<trunk> { [kg] mass } </trunk>]
+ *     [<slung> { [kg] mass } </slung>]
+ *   </masses>]
+ *   <controls>
+ *     [<{ channel name }> { time history table } </{ channel name }>] ... { more channels }
+ *   </controls>
+ *   [<engine index="{ index }">
+ *     [<{ channel name }> { time history table } </{ channel name }>] ... { more channels }
+ *   </engine>] ... { more engines }
+ *   [<events>
+ *     <event name="{ name }"> { event definition } </event> ... { more events }
+ *   </events>]
+ * </batch_scenario>
+ * @endcode
+ *
+ * Controls channels: roll, pitch, yaw, trim_roll, trim_pitch, trim_yaw,
+ * brake_l, brake_r, wheel_brake, landing_gear, wheel_nose, flaps, airbrake,
+ * spoilers, collective, lgh, nws, abs.
+ *
+ * Engine channels: throttle, mixture, propeller, fuel, ignition, starter.
+ *
+ * Collision meshes are added to the process wide collision geometry library
+ * when the scenario is read, so they are shared by all scenarios run later.
+ * Moving platforms are placed at the simulation time of every run, starting
+ * at given location at time 0.
+ *
+ * Events are evaluated by the runner every step after control channels
+ * have been applied, so event actions override scenario inputs.
+ *
+ * @see fdm::XmlUtils::read(const XmlNode &, Table1 *)
+ * @see fdm::EventScript
+ */
+class Scenario
+{
+public:
+
+    /** @brief Constructor. */
+    Scenario();
+
+    /** @brief Copy constructor. */
+    Scenario( const Scenario &scenario );
+
+    /** @brief Destructor. */
+    virtual ~Scenario();
+
+    /**
+     * @brief Reads scenario from XML file.
+     * @param file scenario file path
+     */
+    void readFile( const char *file );
+
+    /**
+     * @brief Initializes input data with scenario initial conditions.
+     * @param dataInp input data to be initialized
+     */
+    void initDataInp( fdm::DataInp *dataInp ) const;
+
+    /**
+     * @brief Updates input data controls at the given simulation time.
+     * @param time [s] simulation time
+     * @param dataInp input data to be updated
+     */
+    void updateDataInp( double time, fdm::DataInp *dataInp );
+
+    /** @brief Assignment operator. */
+    const Scenario& operator= ( const Scenario &scenario );
+
+    /**
+     * @brief Returns scenario input data, which might be altered before run.
+     * @return scenario input data
+     */
+    inline fdm::DataInp* getDataInp() { return &_dataInp; }
+
+    /** @brief Returns scenario events script. */
+    inline fdm::EventScript* getEvents() { return &_events; }
+
+    inline double getTimeStep()   const { return _timeStep;   }
+    inline double getDuration()   const { return _duration;   }
+    inline double getOutputStep() const { return _outputStep; }
+
+private:
+
+    /** Control input channel. */
+    struct Channel
+    {
+        fdm::Table1 history;            ///< time history
+        unsigned int cursor;            ///< time history lookup cursor
+
+        double *value;                  ///< destination value
+        bool   *flag;                   ///< destination flag
+    };
+
+    typedef std::vector< Channel > Channels;
+
+    fdm::DataInp _dataInp;              ///< scenario input data
+
+    Channels _channels;                 ///< control input channels
+
+    fdm::EventScript _events;           ///< events script
+
+    double _timeStep;                   ///< [s] integration time step
+    double _duration;                   ///< [s] simulation time
+    double _outputStep;                 ///< [s] output sampling period
+
+    void copyChannels( const Scenario &scenario );
+
+    void readData( const fdm::XmlNode &rootNode );
+
+    void readAircraft( const fdm::XmlNode &rootNode );
+    void readInitial( const fdm::XmlNode &rootNode );
+    void readEnvironment( const fdm::XmlNode &rootNode );
+    void readGround( const fdm::XmlNode &rootNode );
+    void readMasses( const fdm::XmlNode &rootNode );
+    void readControls( const fdm::XmlNode &rootNode );
+    void readEngines( const fdm::XmlNode &rootNode );
+    void readEvents( const fdm::XmlNode &rootNode );
+
+    void addChannel( const fdm::XmlNode &parentNode, const char *name,
+                     double *value, bool *flag = FDM_NULLPTR );
+};
+
+} // end of batch namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCH_SCENARIO_H
@@ -0,0 +1,327 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <batch/batch_Sweep.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_Random.h>
+#include <fdm/utils/fdm_String.h>
+#include <fdm/utils/fdm_Units.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+#include <batch/batch_Runner.h>
+#include <batch/batch_ThreadPool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Sweep::Sweep() :
+    _cases ( 0 ),
+    _seed  ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Sweep::~Sweep() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sweep::readFile( const char *file )
+{
+    fdm::XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        fdm::XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() && 0 == fdm::String::icompare( rootNode.getName(), "batch_sweep" ) )
+        {
+            std::string scenarioFile;
+
+            int result = FDM_SUCCESS;
+            int cases = 0;
+            int seed  = 0;
+
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &scenarioFile, "scenario" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &cases, "cases" );
+            if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( rootNode, &seed, "seed", true );
+
+            if ( result != FDM_SUCCESS || cases <= 0 )
+            {
+                fdm::XmlUtils::throwError( __FILE__, __LINE__, rootNode );
+            }
+
+            _cases = cases;
+            _seed  = seed;
+
+            // scenario file path is relative to the sweep file
+            scenarioFile = fdm::String::stripSpaces( scenarioFile );
+
+            std::string sweepFile( file );
+            size_t sep = sweepFile.find_last_of( "/\\" );
+
+            if ( sep != std::string::npos && scenarioFile.size() > 0
+              && scenarioFile[ 0 ] != '/' && scenarioFile[ 0 ] != '\\' )
+            {
+                scenarioFile = sweepFile.substr( 0, sep + 1 ) + scenarioFile;
+            }
+
+            _scenario.readFile( scenarioFile.c_str() );
+
+            fdm::XmlNode nodeVariation = rootNode.getFirstChildElement( "variation" );
+
+            if ( nodeVariation.isValid() )
+            {
+                readVariable( nodeVariation, "altitude_agl"   , AltitudeAGL   );
+                readVariable( nodeVariation, "heading"        , Heading       );
+                readVariable( nodeVariation, "airspeed"       , Airspeed      );
+                readVariable( nodeVariation, "temperature_0"  , Temperature   );
+                readVariable( nodeVariation, "pressure_0"     , Pressure      );
+                readVariable( nodeVariation, "wind_direction" , WindDirection );
+                readVariable( nodeVariation, "wind_speed"     , WindSpeed     );
+                readVariable( nodeVariation, "turbulence"     , Turbulence    , true );
+                readVariable( nodeVariation, "wind_shear"     , WindShear     , true );
+            }
+        }
+        else
+        {
+            fdm::Exception e;
+
+            e.setType( fdm::Exception::FileReadingError );
+            e.setInfo( "Reading file \"" + std::string( file ) + "\" failed. Invalid root node." );
+
+            FDM_THROW( e );
+        }
+    }
+    else
+    {
+        fdm::Exception e;
+
+        e.setType( fdm::Exception::FileReadingError );
+        e.setInfo( "Reading file \"" + std::string( file ) + "\" failed." );
+
+        FDM_THROW( e );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sweep::run( unsigned int threads, const char *outputDir, bool verbose )
+{
+    _results.clear();
+    _results.resize( _cases );
+
+    ThreadPool pool( threads );
+
+    fdm::Log::i() << "Running " << _cases << " cases on "
+                  << pool.getThreads() << " threads." << std::endl;
+
+    pool.run( _cases, [ this, outputDir, verbose ]( unsigned int index )
+    {
+        runCase( index, outputDir, verbose );
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sweep::writeSummary( std::ostream &out ) const
+{
+    out << "case,result,seed,steps,sim_time,comp_time";
+
+    for ( Variables::const_iterator it = _variables.begin(); it != _variables.end(); ++it )
+    {
+        out << "," << it->name;
+    }
+
+    out << ",final_latitude,final_longitude,final_altitude_asl,final_altitude_agl"
+        << ",final_roll,final_pitch,final_heading,final_airspeed,crash" << std::endl;
+
+    for ( unsigned int i = 0; i < _results.size(); i++ )
+    {
+        const Result &result = _results[ i ];
+
+        out << std::setprecision( 6 )
+            << i << ","
+            << ( result.result == FDM_SUCCESS ? 1 : 0 ) << ","
+            << result.seed     << ","
+            << result.steps    << ","
+            << result.simTime  << ","
+            << result.compTime;
+
+        for ( unsigned int j = 0; j < result.values.size(); j++ )
+        {
+            out << "," << result.values[ j ];
+        }
+
+        out << std::setprecision( 10 )
+            << "," << fdm::Units::rad2deg( result.flight.latitude  )
+            << "," << fdm::Units::rad2deg( result.flight.longitude )
+            << std::setprecision( 6 )
+            << "," << result.flight.altitude_asl
+            << "," << result.flight.altitude_agl
+            << "," << fdm::Units::rad2deg( result.flight.roll    )
+            << "," << fdm::Units::rad2deg( result.flight.pitch   )
+            << "," << fdm::Units::rad2deg( result.flight.heading )
+            << "," << result.flight.airspeed
+            << "," << (int)result.crash
+            << "\n";
+    }
+
+    out.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Sweep::getFailures() const
+{
+    unsigned int failures = 0;
+
+    for ( Results::const_iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        if ( it->result != FDM_SUCCESS ) failures++;
+    }
+
+    return failures;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sweep::runCase( unsigned int index, const char *outputDir, bool verbose )
+{
+    // every case has its own copy of the scenario and its own generator
+    Scenario scenario( _scenario );
+
+    fdm::Random generator( ( (fdm::UInt64)_seed << 32 ) | index );
+
+    Result &result = _results[ index ];
+
+    for ( Variables::const_iterator it = _variables.begin(); it != _variables.end(); ++it )
+    {
+        double value = 0.0;
+
+        if ( it->integer )
+            value = generator.getRandom( (int)it->min, (int)it->max );
+        else
+            value = generator.getRandom( it->min, it->max );
+
+        setValue( scenario.getDataInp(), it->id, value );
+        result.values.push_back( value );
+    }
+
+    // zero seed would mean non-deterministic time based seed
+    result.seed = (unsigned int)( generator.getNext() >> 32 );
+    if ( result.seed == 0 ) result.seed = 1;
+
+    scenario.getDataInp()->environment.seed = result.seed;
+
+    std::ofstream file;
+
+    if ( outputDir != FDM_NULLPTR )
+    {
+        char name[ 32 ];
+        sprintf( name, "/case_%05u.csv", index );
+
+        file.open( ( std::string( outputDir ) + name ).c_str(),
+                   std::ios_base::out | std::ios_base::trunc );
+
+        if ( !file.is_open() )
+        {
+            fdm::Log::w() << "Cannot open output file for case " << index << "." << std::endl;
+        }
+    }
+
+    Runner runner( &scenario, file.is_open() ? &file : FDM_NULLPTR, verbose );
+
+    result.result   = runner.run();
+    result.flight   = runner.getDataOut().flight;
+    result.crash    = runner.getDataOut().crash;
+    result.simTime  = runner.getSimTime();
+    result.compTime = runner.getCompTime();
+    result.steps    = runner.getSteps();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sweep::readVariable( const fdm::XmlNode &nodeVariation, const char *name,
+                          VariableId id, bool integer )
+{
+    fdm::XmlNode node = nodeVariation.getFirstChildElement( name );
+
+    if ( node.isValid() )
+    {
+        Variable variable;
+
+        variable.id      = id;
+        variable.name    = name;
+        variable.min     = 0.0;
+        variable.max     = 0.0;
+        variable.integer = integer;
+
+        int result = FDM_SUCCESS;
+
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( node, &variable.min, "min" );
+        if ( result == FDM_SUCCESS ) result = fdm::XmlUtils::read( node, &variable.max, "max" );
+
+        if ( result != FDM_SUCCESS || variable.min > variable.max )
+        {
+            fdm::XmlUtils::throwError( __FILE__, __LINE__, node );
+        }
+
+        _variables.push_back( variable );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sweep::setValue( fdm::DataInp *dataInp, VariableId id, double value )
+{
+    switch ( id )
+    {
+        case AltitudeAGL:   dataInp->initial.altitude_agl = value; break;
+        case Heading:       dataInp->initial.heading      = value; break;
+        case Airspeed:      dataInp->initial.airspeed     = value; break;
+
+        case Temperature:   dataInp->environment.temperature_0  = value; break;
+        case Pressure:      dataInp->environment.pressure_0     = value; break;
+        case WindDirection: dataInp->environment.wind_direction = value; break;
+        case WindSpeed:     dataInp->environment.wind_speed     = value; break;
+
+        case Turbulence:
+            dataInp->environment.turbulence = (fdm::DataInp::Environment::Turbulence)(int)value;
+            break;
+
+        case WindShear:
+            dataInp->environment.windShear = (fdm::DataInp::Environment::WindShear)(int)value;
+            break;
+    }
+}
@@ -0,0 +1,179 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BATCH_SWEEP_H
+#define BATCH_SWEEP_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fdm/fdm_DataOut.h>
+
+#include <fdm/xml/fdm_XmlNode.h>
+
+#include <batch/batch_Scenario.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace batch
+{
+
+/**
+ * @brief Monte Carlo parameter sweep class.
+ *
+ * Sweep runs given number of cases of the base scenario, each with its own
+ * FDM instance and parameters drawn from uniform distributions, across work
+ * stealing thread pool. Every case parameters and its FDM random number
+ * generator seed are drawn from generator seeded with the sweep seed and case
+ * index only, so results do not depend on number of threads nor order of
+ * execution.
+ *
+ * XML file format:
+ * @code
+ * <batch_sweep>
+ *   <scenario> { base scenario file path, relative to the sweep file } </scenario>
+ *   <cases> { number of cases } </cases>
+ *   [<seed> { random seed } </seed>]
+ *   <variation>
+ *     [<{ variable name }>
+ *       <min> { minimum value } </min>
+ *       <max> { maximum value } </max>
+ *     </{ variable name }>] ... { more variables }
+ *   </variation>
+ * </batch_sweep>
+ * @endcode
+ *
+ * Variables: altitude_agl, heading, airspeed, temperature_0, pressure_0,
+ * wind_direction, wind_speed, turbulence, wind_shear. Turbulence and wind
+ * shear are integer variables drawn from the inclusive range.
+ *
+ * @see Scenario
+ */
+class Sweep
+{
+public:
+
+    /** @brief Constructor. */
+    Sweep();
+
+    /** @brief Destructor. */
+    virtual ~Sweep();
+
+    /**
+     * @brief Reads sweep from XML file.
+     * @param file sweep file path
+     */
+    void readFile( const char *file );
+
+    /**
+     * @brief Runs all cases.
+     * @param threads number of worker threads, 0 means number of hardware threads
+     * @param outputDir directory for cases time histories, might be null if not required
+     * @param verbose specifies if FDM messages should be logged
+     */
+    void run( unsigned int threads, const char *outputDir = FDM_NULLPTR,
+              bool verbose = false );
+
+    /**
+     * @brief Writes cases results summary as comma-separated values
+     * @param out output stream
+     */
+    void writeSummary( std::ostream &out ) const;
+
+    /**
+     * @brief Returns number of failed cases.
+     * @return number of failed cases
+     */
+    unsigned int getFailures() const;
+
+    inline unsigned int getCases() const { return _cases; }
+
+private:
+
+    /** Variable identifiers. */
+    enum VariableId
+    {
+        AltitudeAGL = 0,                    ///< initial altitude above ground level
+        Heading,                            ///< initial heading
+        Airspeed,                           ///< initial airspeed
+        Temperature,                        ///< sea level air temperature
+        Pressure,                           ///< sea level air pressure
+        WindDirection,                      ///< wind direction
+        WindSpeed,                          ///< wind speed
+        Turbulence,                         ///< turbulence intensity
+        WindShear                           ///< wind shear model
+    };
+
+    /** Variable with uniform distribution. */
+    struct Variable
+    {
+        VariableId id;                      ///< variable identifier
+        std::string name;                   ///< variable name
+        double min;                         ///< minimum value
+        double max;                         ///< maximum value
+        bool integer;                       ///< specifies if variable is integer
+    };
+
+    /** Case result. */
+    struct Result
+    {
+        std::vector< double > values;       ///< variables values
+
+        unsigned int seed;                  ///< FDM random number generator seed
+
+        fdm::DataOut::Flight flight;        ///< final flight data
+        fdm::DataOut::Crash crash;          ///< crash cause
+
+        double simTime;                     ///< [s] simulation time
+        double compTime;                    ///< [s] computations time
+
+        unsigned int steps;                 ///< number of steps
+
+        int result;                         ///< run result
+    };
+
+    typedef std::vector< Variable > Variables;
+    typedef std::vector< Result > Results;
+
+    Scenario _scenario;                     ///< base scenario
+
+    Variables _variables;                   ///< variables
+    Results _results;                       ///< cases results
+
+    unsigned int _cases;                    ///< number of cases
+    unsigned int _seed;                     ///< random seed
+
+    void runCase( unsigned int index, const char *outputDir, bool verbose );
+
+    void readVariable( const fdm::XmlNode &nodeVariation, const char *name,
+                       VariableId id, bool integer = false );
+
+    static void setValue( fdm::DataInp *dataInp, VariableId id, double value );
+};
+
+} // end of batch namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCH_SWEEP_H
@@ -0,0 +1,136 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <batch/batch_ThreadPool.h>
+
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace batch;
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int ThreadPool::getHardwareThreads()
+{
+    unsigned int threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::ThreadPool( unsigned int threads ) :
+    _threads ( threads > 0 ? threads : getHardwareThreads() )
+{
+    for ( unsigned int i = 0; i < _threads; i++ )
+    {
+        _queues.push_back( new Queue() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::~ThreadPool()
+{
+    for ( unsigned int i = 0; i < _queues.size(); i++ )
+    {
+        delete _queues[ i ];
+    }
+
+    _queues.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::run( unsigned int count, const Task &task )
+{
+    // contiguous blocks
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        unsigned int worker = (unsigned int)( ( (unsigned long long)i * _threads ) / count );
+        _queues[ worker ]->indices.push_back( i );
+    }
+
+    std::vector< std::thread > threads;
+
+    for ( unsigned int i = 1; i < _threads; i++ )
+    {
+        threads.push_back( std::thread( &ThreadPool::work, this, i, std::cref( task ) ) );
+    }
+
+    // calling thread is also a worker
+    work( 0, task );
+
+    for ( unsigned int i = 0; i < threads.size(); i++ )
+    {
+        threads[ i ].join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::work( unsigned int worker, const Task &task )
+{
+    unsigned int index = 0;
+
+    while ( pop( worker, &index ) || steal( worker, &index ) )
+    {
+        task( index );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ThreadPool::pop( unsigned int worker, unsigned int *index )
+{
+    Queue *queue = _queues[ worker ];
+    std::lock_guard< std::mutex > lock( queue->mutex );
+
+    if ( !queue->indices.empty() )
+    {
+        (*index) = queue->indices.front();
+        queue->indices.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ThreadPool::steal( unsigned int worker, unsigned int *index )
+{
+    for ( unsigned int i = 1; i < _threads; i++ )
+    {
+        Queue *queue = _queues[ ( worker + i ) % _threads ];
+        std::lock_guard< std::mutex > lock( queue->mutex );
+
+        if ( !queue->indices.empty() )
+        {
+            (*index) = queue->indices.back();
+            queue->indices.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
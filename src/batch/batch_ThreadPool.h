@@ -0,0 +1,101 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef BATCH_THREADPOOL_H
+#define BATCH_THREADPOOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace batch
+{
+
+/**
+ * @brief Work stealing thread pool class.
+ *
+ * Tasks indices are initially distributed among workers queues in contiguous
+ * blocks. Each worker takes tasks from the front of its own queue and, when
+ * it runs out of work, steals tasks from the back of other workers queues.
+ */
+class ThreadPool
+{
+public:
+
+    typedef std::function< void ( unsigned int ) > Task;
+
+    /**
+     * @brief Returns number of hardware threads.
+     * @return number of hardware threads (at least 1)
+     */
+    static unsigned int getHardwareThreads();
+
+    /**
+     * @brief Constructor.
+     * @param threads number of worker threads, 0 means number of hardware threads
+     */
+    ThreadPool( unsigned int threads = 0 );
+
+    /** @brief Destructor. */
+    virtual ~ThreadPool();
+
+    /**
+     * @brief Runs task for every index from 0 to count - 1 and waits until
+     * all tasks have been completed.
+     * @param count number of tasks
+     * @param task task function called with task index
+     */
+    void run( unsigned int count, const Task &task );
+
+    inline unsigned int getThreads() const { return _threads; }
+
+private:
+
+    /** Worker tasks queue. */
+    struct Queue
+    {
+        std::mutex mutex;                       ///< queue mutex
+        std::deque< unsigned int > indices;     ///< tasks indices
+    };
+
+    std::vector< Queue* > _queues;              ///< workers queues
+
+    unsigned int _threads;                      ///< number of worker threads
+
+    ThreadPool( const ThreadPool & );
+    const ThreadPool& operator= ( const ThreadPool & );
+
+    void work( unsigned int worker, const Task &task );
+
+    bool pop( unsigned int worker, unsigned int *index );
+    bool steal( unsigned int worker, unsigned int *index );
+};
+
+} // end of batch namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // BATCH_THREADPOOL_H
@@ -0,0 +1,349 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_AllocTracker.h>
+#include <fdm/utils/fdm_Profiler.h>
+#include <fdm/utils/fdm_Time.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+
+#include <batch/batch_Benchmark.h>
+#include <batch/batch_Regression.h>
+#include <batch/batch_RotorSweep.h>
+#include <batch/batch_Runner.h>
+#include <batch/batch_Scenario.h>
+#include <batch/batch_Sweep.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage()
+{
+    std::cerr << "Usage: mscsim_batch [-v] [-x] <scenario_file> [output_file]" << std::endl;
+    std::cerr << "       mscsim_batch [-v] [-x] [-j threads] [-o output_dir] -s <sweep_file> [summary_file]" << std::endl;
+    std::cerr << "       mscsim_batch [-x] [-j threads] -r <rotor_sweep_file> [table_file]" << std::endl;
+    std::cerr << "       mscsim_batch [-v] [-x] -b <benchmark_file> [results_file]" << std::endl;
+    std::cerr << "       mscsim_batch [-v] [-x] [-j threads] [-u] -g <regression_file> [report_file]" << std::endl;
+    std::cerr << "       -x  use binary cache of XML data files" << std::endl;
+    std::cerr << "       -u  write golden recordings and throughput baselines instead of checking them" << std::endl;
+    std::cerr << "       -t <trace_file>  write profiler trace (requires FDM_PROFILER build)" << std::endl;
+    std::cerr << "       -a  abort on heap allocation in working step (requires FDM_ALLOC_TRACKING build)" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Logs exception info with all its causes. */
+void logException( fdm::Exception &e )
+{
+    fdm::Log::e() << e.getInfo() << std::endl;
+
+    while ( e.hasCause() )
+    {
+        e = e.getCause();
+        fdm::Log::e() << e.getInfo() << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Runs single scenario. */
+int runScenario( const char *scenarioFile, std::ostream &out, bool verbose )
+{
+    batch::Scenario scenario;
+
+    try
+    {
+        scenario.readFile( scenarioFile );
+    }
+    catch ( fdm::Exception &e )
+    {
+        logException( e );
+        return EXIT_FAILURE;
+    }
+
+    batch::Runner runner( &scenario, &out, verbose );
+
+    int result = runner.run();
+
+    out.flush();
+
+    double simTime  = runner.getSimTime();
+    double compTime = runner.getCompTime();
+
+    fdm::Log::i() << "Batch run " << ( result == FDM_SUCCESS ? "finished" : "aborted" )
+                  << " after " << runner.getSteps() << " steps, simulation time "
+                  << simTime << " s, computations time " << compTime << " s"
+                  << ", real time factor " << ( compTime > 0.0 ? simTime / compTime : 0.0 )
+                  << std::endl;
+
+    return result == FDM_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Runs parameter sweep. */
+int runSweep( const char *sweepFile, std::ostream &out, unsigned int threads,
+              const char *outputDir, bool verbose )
+{
+    batch::Sweep sweep;
+
+    try
+    {
+        sweep.readFile( sweepFile );
+    }
+    catch ( fdm::Exception &e )
+    {
+        logException( e );
+        return EXIT_FAILURE;
+    }
+
+    double time_0 = fdm::Time::get();
+
+    sweep.run( threads, outputDir, verbose );
+
+    double time = fdm::Time::get() - time_0;
+
+    sweep.writeSummary( out );
+
+    fdm::Log::i() << "Sweep finished, " << sweep.getCases() << " cases, "
+                  << sweep.getFailures() << " failed, wall time " << time << " s"
+                  << std::endl;
+
+    return sweep.getFailures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Runs rotor sweep. */
+int runRotorSweep( const char *rotorSweepFile, std::ostream &out, unsigned int threads )
+{
+    batch::RotorSweep rotorSweep;
+
+    try
+    {
+        rotorSweep.readFile( rotorSweepFile );
+    }
+    catch ( fdm::Exception &e )
+    {
+        logException( e );
+        return EXIT_FAILURE;
+    }
+
+    double time_0 = fdm::Time::get();
+
+    rotorSweep.run( threads );
+
+    double time = fdm::Time::get() - time_0;
+
+    rotorSweep.writeTable( out );
+
+    fdm::Log::i() << "Rotor sweep finished, " << rotorSweep.getPoints() << " points, "
+                  << rotorSweep.getFailures() << " failed, wall time " << time << " s"
+                  << std::endl;
+
+    return rotorSweep.getFailures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Runs benchmark. */
+int runBenchmark( const char *benchmarkFile, std::ostream &out, bool verbose )
+{
+    batch::Benchmark benchmark;
+
+    try
+    {
+        benchmark.readFile( benchmarkFile );
+    }
+    catch ( fdm::Exception &e )
+    {
+        logException( e );
+        return EXIT_FAILURE;
+    }
+
+    double time_0 = fdm::Time::get();
+
+    benchmark.run( verbose );
+
+    double time = fdm::Time::get() - time_0;
+
+    benchmark.writeResults( out );
+
+    fdm::Log::i() << "Benchmark finished, " << benchmark.getCases() << " cases, "
+                  << benchmark.getFailures() << " failed, wall time " << time << " s"
+                  << std::endl;
+
+    return benchmark.getFailures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Runs golden trajectory regression. */
+int runRegression( const char *regressionFile, std::ostream &out, unsigned int threads,
+                   bool update, bool verbose )
+{
+    batch::Regression regression;
+
+    try
+    {
+        regression.readFile( regressionFile );
+    }
+    catch ( fdm::Exception &e )
+    {
+        logException( e );
+        return EXIT_FAILURE;
+    }
+
+    double time_0 = fdm::Time::get();
+
+    regression.run( threads, update, verbose );
+
+    double time = fdm::Time::get() - time_0;
+
+    regression.writeReport( out );
+
+    fdm::Log::i() << "Regression " << ( update ? "updated" : "finished" ) << ", "
+                  << regression.getCases() << " cases, "
+                  << regression.getFailures() << " failed, wall time " << time << " s"
+                  << std::endl;
+
+    return regression.getFailures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** This is batch runner main function. */
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    const char *inputFile  = FDM_NULLPTR;
+    const char *outputFile = FDM_NULLPTR;
+    const char *outputDir  = FDM_NULLPTR;
+    const char *traceFile  = FDM_NULLPTR;
+
+    unsigned int threads = 0;
+
+    bool sweep      = false;
+    bool rotorSweep = false;
+    bool benchmark  = false;
+    bool regression = false;
+    bool update     = false;
+    bool verbose    = false;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        if ( 0 == strcmp( argv[ i ], "-v" ) )
+            verbose = true;
+        else if ( 0 == strcmp( argv[ i ], "-s" ) )
+            sweep = true;
+        else if ( 0 == strcmp( argv[ i ], "-r" ) )
+            rotorSweep = true;
+        else if ( 0 == strcmp( argv[ i ], "-b" ) )
+            benchmark = true;
+        else if ( 0 == strcmp( argv[ i ], "-g" ) )
+            regression = true;
+        else if ( 0 == strcmp( argv[ i ], "-u" ) )
+            update = true;
+        else if ( 0 == strcmp( argv[ i ], "-x" ) )
+            fdm::XmlDoc::setCacheEnabled( true );
+        else if ( 0 == strcmp( argv[ i ], "-a" ) )
+        {
+#           ifndef FDM_ALLOC_TRACKING
+            fdm::Log::w() << "Allocation tracking is compiled out, -a has no effect." << std::endl;
+#           endif
+            fdm::AllocTracker::setAbortOnViolation( true );
+        }
+        else if ( 0 == strcmp( argv[ i ], "-j" ) && i + 1 < argc )
+            threads = atoi( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-o" ) && i + 1 < argc )
+            outputDir = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-t" ) && i + 1 < argc )
+            traceFile = argv[ ++i ];
+        else if ( inputFile == FDM_NULLPTR )
+            inputFile = argv[ i ];
+        else if ( outputFile == FDM_NULLPTR )
+            outputFile = argv[ i ];
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ( inputFile == FDM_NULLPTR )
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream fileStream;
+
+    if ( outputFile != FDM_NULLPTR )
+    {
+        fileStream.open( outputFile, std::ios_base::out | std::ios_base::trunc );
+
+        if ( !fileStream.is_open() )
+        {
+            fdm::Log::e() << "Cannot open output file \"" << outputFile << "\"." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ostream &out = fileStream.is_open() ? fileStream : std::cout;
+
+    int result = EXIT_SUCCESS;
+
+    if ( benchmark )
+        result = runBenchmark( inputFile, out, verbose );
+    else if ( regression )
+        result = runRegression( inputFile, out, threads, update, verbose );
+    else if ( rotorSweep )
+        result = runRotorSweep( inputFile, out, threads );
+    else if ( sweep )
+        result = runSweep( inputFile, out, threads, outputDir, verbose );
+    else
+        result = runScenario( inputFile, out, verbose );
+
+    if ( traceFile != FDM_NULLPTR )
+    {
+#       ifndef FDM_PROFILER
+        fdm::Log::w() << "Profiler zones are compiled out, trace will be empty." << std::endl;
+#       endif
+
+        if ( FDM_SUCCESS != fdm::Profiler::writeTrace( traceFile ) )
+        {
+            fdm::Log::e() << "Cannot write trace file \"" << traceFile << "\"." << std::endl;
+        }
+    }
+
+    return result;
+}
@@ -1,12 +1,19 @@
 HEADERS += \
+    $$PWD/cgi_AsyncBuilder.h \
     $$PWD/cgi_Camera.h \
+    $$PWD/cgi_CollisionMesh.h \
     $$PWD/cgi_Colors.h \
+    $$PWD/cgi_DataSize.h \
     $$PWD/cgi_Defines.h \
+    $$PWD/cgi_DeadReckoning.h \
+    $$PWD/cgi_DynamicResolution.h \
     $$PWD/cgi_Ephemeris.h \
     $$PWD/cgi_FindNode.h \
     $$PWD/cgi_Fonts.h \
+    $$PWD/cgi_FrameStats.h \
     $$PWD/cgi_Geometry.h \
     $$PWD/cgi_Intersections.h \
+    $$PWD/cgi_Loader.h \
     $$PWD/cgi_Manager.h \
     $$PWD/cgi_ManipulatorMap.h \
     $$PWD/cgi_ManipulatorOrbit.h \
@@ -15,18 +22,27 @@ HEADERS += \
     $$PWD/cgi_Mercator.h \
     $$PWD/cgi_Models.h \
     $$PWD/cgi_Module.h \
+    $$PWD/cgi_Origin.h \
     $$PWD/cgi_Textures.h \
+    $$PWD/cgi_Trace.h \
     $$PWD/cgi_Utils.h \
     $$PWD/cgi_WGS84.h
 
 SOURCES += \
+    $$PWD/cgi_AsyncBuilder.cpp \
     $$PWD/cgi_Camera.cpp \
+    $$PWD/cgi_CollisionMesh.cpp \
     $$PWD/cgi_Colors.cpp \
+    $$PWD/cgi_DataSize.cpp \
+    $$PWD/cgi_DeadReckoning.cpp \
+    $$PWD/cgi_DynamicResolution.cpp \
     $$PWD/cgi_Ephemeris.cpp \
     $$PWD/cgi_FindNode.cpp \
     $$PWD/cgi_Fonts.cpp \
+    $$PWD/cgi_FrameStats.cpp \
     $$PWD/cgi_Geometry.cpp \
     $$PWD/cgi_Intersections.cpp \
+    $$PWD/cgi_Loader.cpp \
     $$PWD/cgi_Manager.cpp \
     $$PWD/cgi_ManipulatorMap.cpp \
     $$PWD/cgi_ManipulatorOrbit.cpp \
@@ -35,7 +51,9 @@ SOURCES += \
     $$PWD/cgi_Mercator.cpp \
     $$PWD/cgi_Models.cpp \
     $$PWD/cgi_Module.cpp \
+    $$PWD/cgi_Origin.cpp \
     $$PWD/cgi_Textures.cpp \
+    $$PWD/cgi_Trace.cpp \
     $$PWD/cgi_Utils.cpp \
     $$PWD/cgi_WGS84.cpp
 
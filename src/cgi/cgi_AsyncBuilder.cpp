@@ -0,0 +1,97 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_AsyncBuilder.h>
+
+#include <fdm/utils/fdm_ThreadPlacement.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+AsyncBuilder::AsyncBuilder() :
+    _done ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+AsyncBuilder::~AsyncBuilder()
+{
+    if ( _thread.joinable() ) _thread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool AsyncBuilder::start( const Job &job )
+{
+    if ( _thread.joinable() ) return false;
+
+    _done.store( false );
+    _result = 0;
+
+    _thread = std::thread( &AsyncBuilder::build, this, job );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::ref_ptr<osg::Group> AsyncBuilder::fetch()
+{
+    osg::ref_ptr<osg::Group> result;
+
+    if ( _thread.joinable() && _done.load( std::memory_order_acquire ) )
+    {
+        _thread.join();
+
+        result = _result;
+        _result = 0;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AsyncBuilder::build( Job job )
+{
+    if ( !fdm::ThreadPlacement::apply( fdm::ThreadPlacement::Workers ) )
+    {
+        Log::w() << "Cannot set scene builder thread CPU affinity." << std::endl;
+    }
+
+    try
+    {
+        _result = job();
+    }
+    catch ( ... )
+    {
+        Log::e() << "Building scene graph in the background failed." << std::endl;
+        _result = 0;
+    }
+
+    _done.store( true, std::memory_order_release );
+}
@@ -0,0 +1,96 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_ASYNCBUILDER_H
+#define CGI_ASYNCBUILDER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include <osg/Group>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Background subgraph builder class.
+ *
+ * Builds subgraph with the given job on a worker thread, so it might be
+ * swapped in with a single call at a frame boundary instead of being created
+ * on the update traversal. Job must not access the scene graph, nor any
+ * objects which might be modified by other threads while the job is running
+ * (e.g. state attributes shared with the scene graph), all data should be
+ * captured when the job is started.
+ */
+class AsyncBuilder
+{
+public:
+
+    typedef std::function< osg::Group* () > Job;
+
+    /** @brief Constructor. */
+    AsyncBuilder();
+
+    /** @brief Destructor, waits until running job is done. */
+    virtual ~AsyncBuilder();
+
+    /**
+     * @brief Starts job if there is no job running or waiting to be fetched.
+     * @param job job function returning new subgraph
+     * @return true if job has been started, false otherwise
+     */
+    bool start( const Job &job );
+
+    /**
+     * @brief Fetches job result.
+     * @return subgraph built by the job or null if job has not been done yet
+     */
+    osg::ref_ptr<osg::Group> fetch();
+
+    /** @return true if job is running or waiting to be fetched */
+    inline bool isBusy() const { return _thread.joinable(); }
+
+private:
+
+    std::thread _thread;                ///< worker thread
+    std::atomic< bool > _done;          ///< specifies if job is done
+
+    osg::ref_ptr<osg::Group> _result;   ///< job result
+
+    /**
+     * Using this constructor is forbidden.
+     */
+    AsyncBuilder( const AsyncBuilder & );
+
+    /** @brief Worker thread function. */
+    void build( Job job );
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_ASYNCBUILDER_H
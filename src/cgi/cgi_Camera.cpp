@@ -28,8 +28,14 @@
 #include <fdm/utils/fdm_WGS84.h>
 
 #include <cgi/cgi_Intersections.h>
+#include <cgi/cgi_Origin.h>
 #include <cgi/cgi_WGS84.h>
 
+#ifdef SIM_HEAD_TRACKING
+#   include <fdm/utils/fdm_Time.h>
+#   include <sim/HeadTracker.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
@@ -58,6 +64,42 @@ Camera::~Camera() {}
 ////////////////////////////////////////////////////////////////////////////////
 
 void Camera::update()
+{
+    updateManipulator( false );
+
+    //if ( _viewType != Data::Camera::ViewChase ) _deltaPitch = 0.0;
+
+    // world view center is expressed relative to the scene origin
+    if ( Origin::getShift().length2() > 0.0 )
+    {
+        _manipulatorWorld->setCenter( _manipulatorWorld->getCenter() - Origin::getShift() );
+    }
+
+    _attitude = _manipulator->getMatrix().getRotate();
+    _position = Origin::toWGS( _manipulator->getMatrix().getTrans() );
+
+    WGS84 wgs( _position );
+
+    float elevation = Intersections::instance()->getElevation( wgs.getLat(), wgs.getLon() );
+
+    Data::get()->cgi.camera.latitude     = wgs.getLat();
+    Data::get()->cgi.camera.longitude    = wgs.getLon();
+    Data::get()->cgi.camera.altitude_agl = wgs.getAlt() - elevation;
+    Data::get()->cgi.camera.altitude_asl = wgs.getAlt();
+
+    Data::get()->cgi.viewType = _viewType;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Camera::latch()
+{
+    updateManipulator( true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Camera::updateManipulator( bool latch )
 {
     if ( _viewType == Data::CGI::ViewChase || _viewType == Data::CGI::ViewPilot )
     {
@@ -65,19 +107,23 @@ void Camera::update()
                                  0.0, osg::Y_AXIS,
                           M_PI / 2.0, osg::Z_AXIS );
 
-        osg::Quat q_wgs( Data::get()->ownship.att_ex_wgs,
-                         Data::get()->ownship.att_ey_wgs,
-                         Data::get()->ownship.att_ez_wgs,
-                         Data::get()->ownship.att_e0_wgs );
+        osg::Quat q_wgs( Data::get()->cgi.ownship.att_ex_wgs,
+                         Data::get()->cgi.ownship.att_ey_wgs,
+                         Data::get()->cgi.ownship.att_ez_wgs,
+                         Data::get()->cgi.ownship.att_e0_wgs );
 
-        osg::Vec3d r_wgs( Data::get()->ownship.pos_x_wgs,
-                          Data::get()->ownship.pos_y_wgs,
-                          Data::get()->ownship.pos_z_wgs );
+        osg::Vec3d r_wgs( Data::get()->cgi.ownship.pos_x_wgs,
+                          Data::get()->cgi.ownship.pos_y_wgs,
+                          Data::get()->cgi.ownship.pos_z_wgs );
 
         if ( _viewType == Data::CGI::ViewChase )
         {
-            double deltaPitch = Data::get()->ownship.onGround ? -Data::get()->ownship.pitch : 0.0;
-            _deltaPitch = fdm::Misc::inertia( deltaPitch, _deltaPitch, CGI_TIME_STEP, 1.0 );
+            // pitch filter is stepped once per update, not when latched
+            if ( !latch )
+            {
+                double deltaPitch = Data::get()->ownship.onGround ? -Data::get()->ownship.pitch : 0.0;
+                _deltaPitch = fdm::Misc::inertia( deltaPitch, _deltaPitch, CGI_TIME_STEP, 1.0 );
+            }
 
             double d_phi = 0.0;
             double d_tht = _deltaPitch;// -0.5 * Data::get()->ownship.pitchRate;
@@ -97,7 +143,7 @@ void Camera::update()
             osg::Matrixd matrix( osg::Matrixd::rotate( q_tmp )
                                * osg::Matrixd::rotate( q_camera_bas )
                                * osg::Matrixd::rotate( q_wgs )
-                               * osg::Matrixd::translate( r_camera_wgs ) );
+                               * osg::Matrixd::translate( Origin::toScene( r_camera_wgs ) ) );
 
             _manipulatorShift->setByMatrix( matrix );
         }
@@ -107,31 +153,31 @@ void Camera::update()
                                      Data::get()->cgi.camera.offset_y,
                                      Data::get()->cgi.camera.offset_z );
 
+            osg::Quat q_camera_bas;
+
+#           ifdef SIM_HEAD_TRACKING
+            // head pose is latched straight from the tracker thread
+            HeadTracker::Pose head;
+
+            if ( HeadTracker::instance()->getPose( fdm::Time::get(), &head ) )
+            {
+                r_camera_bas += osg::Vec3d( head.x, head.y, head.z );
+                q_camera_bas = osg::Quat( head.phi, osg::X_AXIS,
+                                          head.tht, osg::Y_AXIS,
+                                          head.psi, osg::Z_AXIS );
+            }
+#           endif
+
             osg::Vec3d r_camera_wgs = r_wgs + q_wgs * r_camera_bas;
 
             osg::Matrixd matrix( osg::Matrixd::rotate( q_tmp )
+                               * osg::Matrixd::rotate( q_camera_bas )
                                * osg::Matrixd::rotate( q_wgs )
-                               * osg::Matrixd::translate( r_camera_wgs ) );
+                               * osg::Matrixd::translate( Origin::toScene( r_camera_wgs ) ) );
 
             _manipulatorShift->setByMatrix( matrix );
         }
     }
-
-    //if ( _viewType != Data::Camera::ViewChase ) _deltaPitch = 0.0;
-
-    _attitude = _manipulator->getMatrix().getRotate();
-    _position = _manipulator->getMatrix().getTrans();
-
-    WGS84 wgs( _position );
-
-    float elevation = Intersections::instance()->getElevation( wgs.getLat(), wgs.getLon() );
-
-    Data::get()->cgi.camera.latitude     = wgs.getLat();
-    Data::get()->cgi.camera.longitude    = wgs.getLon();
-    Data::get()->cgi.camera.altitude_agl = wgs.getAlt() - elevation;
-    Data::get()->cgi.camera.altitude_asl = wgs.getAlt();
-
-    Data::get()->cgi.viewType = _viewType;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
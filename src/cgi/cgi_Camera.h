@@ -53,6 +53,12 @@ public:
     /** @brief Updates camera position and attitude. */
     void update();
 
+    /**
+     * @brief Updates only manipulator attached to the ownship.
+     * Used by the late latch, ownship pose has to be already updated.
+     */
+    void latch();
+
     /** */
     inline osgGA::CameraManipulator* getManipulator()
     {
@@ -133,6 +139,12 @@ private:
     ViewType _viewType;     ///< view type
 
     double _deltaPitch;     ///< [rad] pitch difference
+
+    /**
+     * @brief Updates manipulator attached to the ownship (chase and pilot views).
+     * @param latch specifies if called by the late latch
+     */
+    void updateManipulator( bool latch );
 };
 
 } // end of cgi namespace
@@ -0,0 +1,143 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_CollisionMesh.h>
+
+#include <osg/Geode>
+#include <osg/NodeVisitor>
+#include <osg/Transform>
+#include <osg/TriangleFunctor>
+
+#include <fdm/main/fdm_CollisionGeometry.h>
+
+#include <cgi/cgi_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Triangles collecting functor. */
+struct CollectTriangles
+{
+    const osg::Matrixd *matrix;             ///< drawable to model matrix
+
+    std::vector< fdm::Vector3 > *vertices;  ///< collected vertices
+    std::vector< fdm::UInt32  > *indices;   ///< collected indices
+
+    CollectTriangles() :
+        matrix   ( NULLPTR ),
+        vertices ( NULLPTR ),
+        indices  ( NULLPTR )
+    {}
+
+    inline void operator() ( const osg::Vec3 &v1, const osg::Vec3 &v2, const osg::Vec3 &v3, bool )
+    {
+        add( v1 );
+        add( v2 );
+        add( v3 );
+    }
+
+    inline void add( const osg::Vec3 &v )
+    {
+        osg::Vec3d p = osg::Vec3d( v ) * (*matrix);
+        indices->push_back( static_cast< fdm::UInt32 >( vertices->size() ) );
+        vertices->push_back( fdm::Vector3( p.x(), p.y(), p.z() ) );
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Triangles collecting node visitor, accumulates transforms. */
+class CollectVisitor : public osg::NodeVisitor
+{
+public:
+
+    CollectVisitor( std::vector< fdm::Vector3 > *vertices,
+                    std::vector< fdm::UInt32  > *indices ) :
+        osg::NodeVisitor( osg::NodeVisitor::TRAVERSE_ALL_CHILDREN ),
+        _vertices ( vertices ),
+        _indices  ( indices )
+    {
+        _matrix.makeIdentity();
+    }
+
+    virtual void apply( osg::Transform &transform )
+    {
+        osg::Matrixd matrix = _matrix;
+        transform.computeLocalToWorldMatrix( _matrix, this );
+        traverse( transform );
+        _matrix = matrix;
+    }
+
+    virtual void apply( osg::Geode &geode )
+    {
+        for ( unsigned int i = 0; i < geode.getNumDrawables(); ++i )
+        {
+            osg::TriangleFunctor< CollectTriangles > functor;
+            functor.matrix   = &_matrix;
+            functor.vertices = _vertices;
+            functor.indices  = _indices;
+
+            geode.getDrawable( i )->accept( functor );
+        }
+    }
+
+private:
+
+    osg::Matrixd _matrix;                       ///< current node to model matrix
+
+    std::vector< fdm::Vector3 > *_vertices;     ///< collected vertices
+    std::vector< fdm::UInt32  > *_indices;      ///< collected indices
+};
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CollisionMesh::add( osg::Node *node, double lat, double lon, double alt, double hdg,
+                         double speed, double turn )
+{
+    std::vector< fdm::Vector3 > vertices;
+    std::vector< fdm::UInt32  > indices;
+
+    collect( node, &vertices, &indices );
+
+    return fdm::CollisionGeometry::addMesh( vertices, indices, lat, lon, alt, hdg, speed, turn );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionMesh::collect( osg::Node *node,
+                             std::vector< fdm::Vector3 > *vertices,
+                             std::vector< fdm::UInt32 > *indices )
+{
+    if ( node )
+    {
+        CollectVisitor visitor( vertices, indices );
+        node->accept( visitor );
+    }
+}
@@ -0,0 +1,81 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_COLLISIONMESH_H
+#define CGI_COLLISIONMESH_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <osg/Node>
+
+#include <fdm/fdm_Types.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Collision mesh extraction class.
+ *
+ * Collects triangles of the model once at load time and passes them to the
+ * FDM collision geometry library, so ground contact does not query OSG scene
+ * graph at run time.
+ *
+ * @see fdm::CollisionGeometry
+ */
+class CollisionMesh
+{
+public:
+
+    /**
+     * @brief Adds model triangles to the FDM collision geometry library.
+     * @param node model node
+     * @param lat [rad] model latitude
+     * @param lon [rad] model longitude
+     * @param alt [m] model altitude above mean sea level
+     * @param hdg [rad] model heading
+     * @param speed [m/s] moving platform (e.g. ship) speed
+     * @param turn [rad/s] moving platform turn rate
+     * @return true if mesh has been added, false otherwise
+     */
+    static bool add( osg::Node *node, double lat, double lon, double alt, double hdg,
+                     double speed = 0.0, double turn = 0.0 );
+
+    /**
+     * @brief Collects model triangles.
+     * @param node model node
+     * @param vertices [m] vertices coordinates expressed in model axis system
+     * @param indices vertices indices, 3 per triangle
+     */
+    static void collect( osg::Node *node,
+                         std::vector< fdm::Vector3 > *vertices,
+                         std::vector< fdm::UInt32 > *indices );
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_COLLISIONMESH_H
@@ -0,0 +1,169 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_DataSize.h>
+
+#include <set>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/NodeVisitor>
+#include <osg/Texture>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Visitor summing sizes of images and geometries data. */
+class SumDataSize : public osg::NodeVisitor
+{
+public:
+
+    SumDataSize() :
+        osg::NodeVisitor( TRAVERSE_ALL_CHILDREN ),
+        _bytes ( 0 )
+    {}
+
+    virtual void apply( osg::Node &node )
+    {
+        addStateSet( node.getStateSet() );
+        traverse( node );
+    }
+
+    virtual void apply( osg::Geode &geode )
+    {
+        addStateSet( geode.getStateSet() );
+
+        for ( unsigned int i = 0; i < geode.getNumDrawables(); i++ )
+        {
+            osg::Drawable *drawable = geode.getDrawable( i );
+
+            addStateSet( drawable->getStateSet() );
+
+            osg::Geometry *geometry = drawable->asGeometry();
+
+            if ( geometry )
+            {
+                addBufferData( geometry->getVertexArray() );
+                addBufferData( geometry->getNormalArray() );
+                addBufferData( geometry->getColorArray() );
+                addBufferData( geometry->getSecondaryColorArray() );
+                addBufferData( geometry->getFogCoordArray() );
+
+                for ( unsigned int j = 0; j < geometry->getNumTexCoordArrays(); j++ )
+                {
+                    addBufferData( geometry->getTexCoordArray( j ) );
+                }
+
+                for ( unsigned int j = 0; j < geometry->getNumVertexAttribArrays(); j++ )
+                {
+                    addBufferData( geometry->getVertexAttribArray( j ) );
+                }
+
+                for ( unsigned int j = 0; j < geometry->getNumPrimitiveSets(); j++ )
+                {
+                    addBufferData( geometry->getPrimitiveSet( j )->getDrawElements() );
+                }
+            }
+        }
+
+        traverse( geode );
+    }
+
+    inline fdm::UInt64 getBytes() const { return _bytes; }
+
+private:
+
+    std::set< const osg::Object* > _visited;    ///< objects already counted
+
+    fdm::UInt64 _bytes;                         ///< [B] sum of data sizes
+
+    bool visit( const osg::Object *object )
+    {
+        return object && _visited.insert( object ).second;
+    }
+
+    void addBufferData( const osg::BufferData *data )
+    {
+        if ( visit( data ) ) _bytes += data->getTotalDataSize();
+    }
+
+    void addStateSet( const osg::StateSet *stateSet )
+    {
+        if ( !visit( stateSet ) ) return;
+
+        for ( unsigned int i = 0; i < stateSet->getNumTextureAttributeLists(); i++ )
+        {
+            const osg::Texture *texture = dynamic_cast< const osg::Texture* >(
+                        stateSet->getTextureAttribute( i, osg::StateAttribute::TEXTURE ) );
+
+            if ( visit( texture ) )
+            {
+                for ( unsigned int j = 0; j < texture->getNumImages(); j++ )
+                {
+                    const osg::Image *image = texture->getImage( j );
+
+                    if ( visit( image ) ) _bytes += DataSize::get( image );
+                }
+            }
+        }
+    }
+};
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::UInt64 DataSize::get( const osg::Image *image )
+{
+    if ( image )
+    {
+        // images without mipmaps get them generated when applied
+        fdm::UInt64 bytes = image->getTotalSizeInBytesIncludingMipmaps();
+
+        if ( !image->isMipmap() ) bytes += bytes / 3;
+
+        return bytes;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::UInt64 DataSize::get( osg::Node *node )
+{
+    if ( node )
+    {
+        SumDataSize sumDataSize;
+        node->accept( sumDataSize );
+
+        return sumDataSize.getBytes();
+    }
+
+    return 0;
+}
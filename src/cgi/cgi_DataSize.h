@@ -0,0 +1,67 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_DATASIZE_H
+#define CGI_DATASIZE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <osg/Image>
+#include <osg/Node>
+
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Scene graph data size estimation class.
+ *
+ * Sizes are estimated from the client side data: images (including mipmaps)
+ * and geometries arrays and primitive sets. Objects shared within the given
+ * subgraph are counted once, GPU side copies are not counted.
+ */
+class DataSize
+{
+public:
+
+    /**
+     * @brief Returns image data size.
+     * @param image image
+     * @return [B] estimated image size
+     */
+    static fdm::UInt64 get( const osg::Image *image );
+
+    /**
+     * @brief Returns subgraph data size.
+     * @param node subgraph root node
+     * @return [B] estimated subgraph images and geometries size
+     */
+    static fdm::UInt64 get( osg::Node *node );
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_DATASIZE_H
@@ -0,0 +1,186 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_DeadReckoning.h>
+
+#include <algorithm>
+
+#include <fdm/utils/fdm_Matrix3x3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const double DeadReckoning::_maxTime = 0.1;
+
+TripleBuffer< DeadReckoning::Frame > DeadReckoning::_channel;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DeadReckoning::publish( const Frame &frame )
+{
+    _channel.publish( frame );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DeadReckoning::DeadReckoning()
+{
+    for ( int i = 0; i < 2; i++ )
+    {
+        _frames[ i ].time = 0.0;
+        _frames[ i ].att_wgs = fdm::Quaternion::createZeroRotationQuaternion();
+    }
+
+    _att_wgs = fdm::Quaternion::createZeroRotationQuaternion();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DeadReckoning::update( double time )
+{
+    const Data::Ownship &ownship = Data::get()->ownship;
+
+    // frame might have been already latched from the channel
+    if ( ownship.time > _frames[ 1 ].time )
+    {
+        Frame frame;
+
+        frame.time = ownship.time;
+
+        frame.pos_wgs = fdm::Vector3( ownship.pos_x_wgs,
+                                      ownship.pos_y_wgs,
+                                      ownship.pos_z_wgs );
+
+        frame.att_wgs = fdm::Quaternion( ownship.att_e0_wgs,
+                                         ownship.att_ex_wgs,
+                                         ownship.att_ey_wgs,
+                                         ownship.att_ez_wgs );
+
+        frame.vel_bas = fdm::Vector3( ownship.vel_u_bas,
+                                      ownship.vel_v_bas,
+                                      ownship.vel_w_bas );
+
+        frame.omg_bas = fdm::Vector3( ownship.rollRate,
+                                      ownship.pitchRate,
+                                      ownship.yawRate );
+
+        addFrame( frame );
+    }
+
+    updatePose( time );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DeadReckoning::latch( double time )
+{
+    if ( _channel.fetch() && _channel.getFrontBuffer().time > _frames[ 1 ].time )
+    {
+        addFrame( _channel.getFrontBuffer() );
+    }
+
+    updatePose( time );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DeadReckoning::latch( const Frame &frame, bool fresh, double time, double timeCoef )
+{
+    if ( fresh ) addFrame( frame );
+
+    double dt = fresh ? 0.0 : timeCoef * std::min( time - _frames[ 1 ].time, _maxTime );
+
+    extrapolate( _frames[ 1 ], std::max( 0.0, dt ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DeadReckoning::addFrame( const Frame &frame )
+{
+    // after a gap (pause, reset) previous frame is no longer related
+    bool continuous = frame.time - _frames[ 1 ].time < _maxTime;
+
+    _frames[ 0 ] = continuous ? _frames[ 1 ] : frame;
+    _frames[ 1 ] = frame;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DeadReckoning::updatePose( double time )
+{
+    const Frame &f_0 = _frames[ 0 ];
+    const Frame &f_1 = _frames[ 1 ];
+
+#   ifdef SIM_RENDER_BENCHMARK
+    // benchmark frames show exactly the simulated frame, regardless of render time
+    (void)time;
+    (void)f_0;
+
+    _pos_wgs = f_1.pos_wgs;
+    _att_wgs = f_1.att_wgs;
+#   else
+    if ( Data::get()->stateOut != fdm::DataOut::Working || f_1.time <= 0.0 )
+    {
+        _pos_wgs = f_1.pos_wgs;
+        _att_wgs = f_1.att_wgs;
+    }
+    else if ( time < f_1.time && f_0.time < f_1.time )
+    {
+        // render time between frames, normalized linear interpolation
+        double s = ( time - f_0.time ) / ( f_1.time - f_0.time );
+        s = std::max( 0.0, std::min( 1.0, s ) );
+
+        fdm::Quaternion att_1 = f_1.att_wgs;
+
+        double dot = f_0.att_wgs.e0() * att_1.e0()
+                   + f_0.att_wgs.ex() * att_1.ex()
+                   + f_0.att_wgs.ey() * att_1.ey()
+                   + f_0.att_wgs.ez() * att_1.ez();
+
+        // shortest path
+        if ( dot < 0.0 ) att_1 *= -1.0;
+
+        _pos_wgs = f_0.pos_wgs + s * ( f_1.pos_wgs - f_0.pos_wgs );
+        _att_wgs = ( ( 1.0 - s ) * f_0.att_wgs + s * att_1 ).getNormalized();
+    }
+    else
+    {
+        // frames are stamped with wall clock time, rates are in simulation time
+        double dt = Data::get()->timeCoef * std::min( time - f_1.time, _maxTime );
+
+        extrapolate( f_1, dt );
+    }
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DeadReckoning::extrapolate( const Frame &frame, double dt )
+{
+    fdm::Matrix3x3 bas2wgs = fdm::Matrix3x3( frame.att_wgs ).getTransposed();
+
+    _pos_wgs = frame.pos_wgs + dt * ( bas2wgs * frame.vel_bas );
+    _att_wgs = ( frame.att_wgs + dt * frame.att_wgs.getDerivative( frame.omg_bas ) ).getNormalized();
+}
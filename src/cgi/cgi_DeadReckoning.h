@@ -0,0 +1,136 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_DEADRECKONING_H
+#define CGI_DEADRECKONING_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/utils/fdm_Quaternion.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+#include <Data.h>
+
+#include <sim/TripleBuffer.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Ownship pose dead reckoning.
+ *
+ * Keeps two most recent FDM frames with their time stamps and computes
+ * ownship pose at the render time, so FDM and render rates mismatch does
+ * not show as judder. When render time falls between frames pose is
+ * interpolated, otherwise it is extrapolated from the most recent frame
+ * using its velocity and angular rates. Extrapolation time is limited, so
+ * pose freezes rather than drifts away when frames stop coming.
+ *
+ * Besides ownship data, frames are also published by the simulation thread
+ * through a lock-free channel, so pose can be late-latched right before
+ * rendering from the most recent FDM frame.
+ *
+ * If SIM_RENDER_BENCHMARK is defined, pose of the most recent frame is used
+ * as it is, since benchmark frames are stepped by rendering, not by time.
+ */
+class DeadReckoning
+{
+public:
+
+    /** FDM frame. */
+    struct Frame
+    {
+        double time;                ///< [s] frame time stamp
+
+        fdm::Vector3 pos_wgs;       ///< [m] position expressed in WGS
+        fdm::Quaternion att_wgs;    ///< attitude expressed as quaternion of rotation from WGS to BAS
+        fdm::Vector3 vel_bas;       ///< [m/s] velocity expressed in BAS
+        fdm::Vector3 omg_bas;       ///< [rad/s] angular velocity expressed in BAS
+    };
+
+    static const double _maxTime;   ///< [s] maximum extrapolation time
+
+    /**
+     * @brief Publishes the most recent FDM frame for the late latch.
+     * Might be called by simulation thread only.
+     * @param frame FDM frame
+     */
+    static void publish( const Frame &frame );
+
+    /** @brief Constructor. */
+    DeadReckoning();
+
+    /**
+     * @brief Updates pose using ownship data.
+     * @param time [s] render time (monotonic clock)
+     */
+    void update( double time );
+
+    /**
+     * @brief Updates pose using the most recent published FDM frame.
+     * Might be called by rendering thread only.
+     * @param time [s] render time (monotonic clock)
+     */
+    void latch( double time );
+
+    /**
+     * @brief Updates pose using frame received from the cluster master.
+     * Fresh frame pose is used as it is, so all cluster nodes show the same
+     * state, otherwise the most recent frame is extrapolated by its age.
+     * @param frame master frame stamped with its arrival time
+     * @param fresh specifies if frame has just arrived
+     * @param time [s] render time (monotonic clock)
+     * @param timeCoef master time coefficient
+     */
+    void latch( const Frame &frame, bool fresh, double time, double timeCoef );
+
+    inline const fdm::Vector3&    getPos_WGS() const { return _pos_wgs; }
+    inline const fdm::Quaternion& getAtt_WGS() const { return _att_wgs; }
+
+    inline const fdm::Vector3& getVel_BAS() const { return _frames[ 1 ].vel_bas; }
+    inline const fdm::Vector3& getOmg_BAS() const { return _frames[ 1 ].omg_bas; }
+
+private:
+
+    static TripleBuffer< Frame > _channel;  ///< most recent FDM frame channel
+
+    Frame _frames[ 2 ];             ///< previous and the most recent frame
+
+    fdm::Vector3    _pos_wgs;       ///< [m] position at render time expressed in WGS
+    fdm::Quaternion _att_wgs;       ///< attitude at render time expressed as quaternion of rotation from WGS to BAS
+
+    /** Adds frame as the most recent one. */
+    void addFrame( const Frame &frame );
+
+    /** Computes pose at the given render time. */
+    void updatePose( double time );
+
+    /** Extrapolates pose from the given frame by the given simulation time. */
+    void extrapolate( const Frame &frame, double dt );
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_DEADRECKONING_H
@@ -75,6 +75,11 @@
 #define CGI_SKYDOME_DIAMETER_SUN  0.54f
 #define CGI_SKYDOME_DIAMETER_MOON 0.53f
 
+#define CGI_EPHEMERIS_UPDATE_INTERVAL 1.0   ///< [s] simulation time interval of Sun and Moon positions update
+
+#define CGI_SKYDOME_COLORS_ELEV_STEP 1.0e-3f  ///< [rad] elevation change which updates sky colors
+#define CGI_SKYDOME_COLORS_AGE_STEP  1.0e-3f  ///< [-] Moon age change which updates sky colors
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #define CGI_LIGHT_SUN_NUM  0
@@ -88,4 +93,195 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#define CGI_AIRPORT_LIGHTS_SIZE      8.0f   ///< [px] airport batched light size at 0 distance
+#define CGI_AIRPORT_LIGHTS_SIZE_MIN  1.0f   ///< [px] airport batched light minimum size
+#define CGI_AIRPORT_LIGHTS_SIZE_MAX 12.0f   ///< [px] airport batched light maximum size
+#define CGI_AIRPORT_LIGHTS_FADE      2.0f   ///< [px] size below which airport batched lights fade out
+#define CGI_AIRPORT_LIGHTS_ATT    4.0e-6f   ///< [1/m^2] airport batched lights quadratic attenuation
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CGI_TRACE_CHUNK_SIZE
+#   define CGI_TRACE_CHUNK_SIZE 1024
+#endif
+
+#ifndef CGI_TRACE_MAX_CHUNKS
+#   define CGI_TRACE_MAX_CHUNKS 64
+#endif
+
+#ifndef CGI_TRACE_MIN_SPACING
+#   define CGI_TRACE_MIN_SPACING 1.0f
+#endif
+
+#ifndef CGI_TRACE_MAX_SPACING
+#   define CGI_TRACE_MAX_SPACING 50.0f
+#endif
+
+#ifndef CGI_TRACE_MAX_ANGLE
+#   define CGI_TRACE_MAX_ANGLE 0.005f /* ~0.3 deg */
+#endif
+
+#ifndef CGI_MAP_TILES_SPLIT
+#   define CGI_MAP_TILES_SPLIT 512.0f /* [px] on screen size above which map tile is replaced by its children */
+#endif
+
+#ifndef CGI_MAP_IMAGERY_PREFETCH
+#   define CGI_MAP_IMAGERY_PREFETCH 1.5 /* imagery tiles bounds scale, tiles around the view are paged in ahead */
+#endif
+
+#ifndef CGI_MAP_ICONS_DECLUTTER
+#   define CGI_MAP_ICONS_DECLUTTER 1.0 /* map icons declutter grid cell size relative to icon size, not less than 1 */
+#endif
+
+#ifndef CGI_MAP_TRACE_CHUNK_SIZE
+#   define CGI_MAP_TRACE_CHUNK_SIZE 1024
+#endif
+
+#ifndef CGI_MAP_TRACE_MAX_CHUNKS
+#   define CGI_MAP_TRACE_MAX_CHUNKS 32
+#endif
+
+#ifndef CGI_MAP_TRACE_MIN_SPACING
+#   define CGI_MAP_TRACE_MIN_SPACING 10.0f
+#endif
+
+#ifndef CGI_MAP_TRACE_MAX_SPACING
+#   define CGI_MAP_TRACE_MAX_SPACING 2000.0f
+#endif
+
+#ifndef CGI_MAP_TRACE_MAX_ANGLE
+#   define CGI_MAP_TRACE_MAX_ANGLE 0.01f /* ~0.6 deg */
+#endif
+
+#ifndef CGI_LOADER_THREADS
+#   define CGI_LOADER_THREADS 2
+#endif
+
+#ifndef CGI_TERRAIN_LOD_FACTOR
+#   define CGI_TERRAIN_LOD_FACTOR 3.0
+#endif
+
+#ifndef CGI_TERRAIN_MAX_PAGED_LOD
+#   define CGI_TERRAIN_MAX_PAGED_LOD 300
+#endif
+
+#ifndef CGI_TERRAIN_PREFETCH_TIME
+#   define CGI_TERRAIN_PREFETCH_TIME 30.0
+#endif
+
+#ifndef CGI_TERRAIN_PREFETCH_MAX
+#   define CGI_TERRAIN_PREFETCH_MAX 32
+#endif
+
+#ifndef CGI_INTERSECTIONS_CACHE_SIZE
+#   define CGI_INTERSECTIONS_CACHE_SIZE 512 /* number of paged tiles kept for intersections */
+#endif
+
+#ifndef CGI_INTERSECTIONS_PREFETCH_RADIUS
+#   define CGI_INTERSECTIONS_PREFETCH_RADIUS 2000.0 /* [m] radius around ownship of intersections tiles prefetch */
+#endif
+
+#ifndef CGI_INTERSECTIONS_PREFETCH_STEP
+#   define CGI_INTERSECTIONS_PREFETCH_STEP 200.0 /* [m] ownship displacement triggering intersections tiles prefetch */
+#endif
+
+#ifndef CGI_ORIGIN_REBASE_DISTANCE
+#   define CGI_ORIGIN_REBASE_DISTANCE 5000.0 /* [m] ownship distance from OTW scene origin triggering origin re-base */
+#endif
+
+#ifndef CGI_MODELS_LOD_RATIO
+#   define CGI_MODELS_LOD_RATIO 0.2f /* simplified model sample ratio */
+#endif
+
+#ifndef CGI_MODELS_LOD_PIXELS
+#   define CGI_MODELS_LOD_PIXELS 100.0f /* [px] on screen size below which ownship simplified model is displayed */
+#endif
+
+#ifndef CGI_MODELS_BUDGET
+#   define CGI_MODELS_BUDGET 0 /* [MiB] models cache budget, unused models are evicted above it, 0 means unlimited */
+#endif
+
+#ifndef CGI_TEXTURES_BUDGET
+#   define CGI_TEXTURES_BUDGET 0 /* [MiB] textures cache budget, unused textures are evicted above it, 0 means unlimited */
+#endif
+
+#ifndef CGI_ENTITIES_LOD_NEAR
+#   define CGI_ENTITIES_LOD_NEAR 500.0f
+#endif
+
+#ifndef CGI_ENTITIES_LOD_FAR
+#   define CGI_ENTITIES_LOD_FAR 20000.0f
+#endif
+
+#ifndef CGI_ENTITIES_IMPOSTOR_RANGE
+#   define CGI_ENTITIES_IMPOSTOR_RANGE 3000.0f
+#endif
+
+#ifndef CGI_SCENERY_TILE_SIZE
+#   define CGI_SCENERY_TILE_SIZE 1.0 /* [deg] scenery objects index tile size */
+#endif
+
+#ifndef CGI_SCENERY_ACTIVATION_RADIUS
+#   define CGI_SCENERY_ACTIVATION_RADIUS 50000.0 /* [m] airports and landmarks activation radius */
+#endif
+
+#ifndef CGI_SCENERY_ACTIVATION_STEP
+#   define CGI_SCENERY_ACTIVATION_STEP 1000.0 /* [m] ownship displacement triggering activation update */
+#endif
+
+#ifndef CGI_SHADOW_QUALITY
+#   define CGI_SHADOW_QUALITY 0 /* 0 - projected texture, 1 - Low, 2 - Medium, 3 - High */
+#endif
+
+#ifndef CGI_SHADOW_FAR
+#   define CGI_SHADOW_FAR 2000.0 /* [m] shadow maps far distance */
+#endif
+
+#define CGI_SHADOW_CAST_MASK    0x00000001  ///< shadow casters node mask bit
+#define CGI_SHADOW_RECEIVE_MASK 0x00000002  ///< shadow receivers node mask bit
+
+#ifndef CGI_REFLECTION_QUALITY
+#   define CGI_REFLECTION_QUALITY 2 /* 0 - Low, 1 - Medium, 2 - High */
+#endif
+
+#ifndef CGI_REFLECTION_CULL_MASK
+#   define CGI_REFLECTION_CULL_MASK 0xffffffff
+#endif
+
+#ifndef CGI_REFLECTION_RANGE
+#   define CGI_REFLECTION_RANGE 10000.0f
+#endif
+
+#if defined(SIM_OSG_DEBUG_INFO) || defined(FDM_PROFILER) || defined(FDM_METRICS)
+#   ifndef CGI_FRAME_STATS
+#       define CGI_FRAME_STATS
+#   endif
+#endif
+
+#ifndef CGI_FRAME_STATS_GPU_LAG
+#   define CGI_FRAME_STATS_GPU_LAG 8 /* frames */
+#endif
+
+#ifndef CGI_OTW_CHANNELS
+#   define CGI_OTW_CHANNELS 1
+#endif
+
+#ifndef CGI_OTW_CHANNELS_YAW
+#   define CGI_OTW_CHANNELS_YAW 0.0 /* [deg] 0 means adjacent channels */
+#endif
+
+#if defined(CGI_DYNAMIC_RESOLUTION) && ( CGI_OTW_CHANNELS > 1 )
+#   undef CGI_DYNAMIC_RESOLUTION /* not supported by multichannel OTW */
+#endif
+
+#ifndef CGI_DYNAMIC_RESOLUTION_BUDGET
+#   define CGI_DYNAMIC_RESOLUTION_BUDGET 0.013 /* [s] OTW GPU time budget, below 60 Hz vertical sync interval */
+#endif
+
+#ifndef CGI_DYNAMIC_RESOLUTION_MIN
+#   define CGI_DYNAMIC_RESOLUTION_MIN 0.5 /* minimum OTW render scale */
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 #endif // CGI_DEFINES_H
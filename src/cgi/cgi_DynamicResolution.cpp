@@ -0,0 +1,269 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_DynamicResolution.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <osg/Depth>
+#include <osg/Geode>
+
+#include <cgi/cgi_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const double headroom = 0.8;    ///< [-] budget fraction below which render scale is increased
+const double step_up  = 0.05;   ///< [-] render scale increase step
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+DynamicResolution::DynamicResolution( osg::Camera *camera ) :
+    _camera ( camera ),
+    _width  ( 0 ),
+    _height ( 0 ),
+    _scale ( 1.0 ),
+    _frameGPU   ( 0 ),
+    _frameScale ( 0 )
+{
+    osg::GraphicsContext *context = camera->getGraphicsContext();
+    const osg::GraphicsContext::Traits *traits = context->getTraits();
+
+    _width  = traits->width;
+    _height = traits->height;
+
+    _texture = new osg::Texture2D();
+    _texture->setTextureSize( _width, _height );
+    _texture->setInternalFormat( GL_RGBA );
+    _texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+    _texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+    _texture->setWrap( osg::Texture::WRAP_S, osg::Texture::CLAMP_TO_EDGE );
+    _texture->setWrap( osg::Texture::WRAP_T, osg::Texture::CLAMP_TO_EDGE );
+    _texture->setResizeNonPowerOfTwoHint( false );
+
+    unsigned int samples = traits->samples;
+
+    camera->setRenderTargetImplementation( osg::Camera::FRAME_BUFFER_OBJECT );
+    camera->setRenderOrder( osg::Camera::PRE_RENDER );
+    camera->attach( osg::Camera::COLOR_BUFFER, _texture.get(), 0, 0, false, samples, samples );
+    camera->attach( osg::Camera::DEPTH_BUFFER, GL_DEPTH_COMPONENT24 );
+
+    // GPU time is required regardless of CGI_FRAME_STATS
+    if ( !camera->getStats() )
+    {
+        camera->setStats( new osg::Stats( "Camera" ) );
+    }
+
+    camera->getStats()->collectStats( "gpu", true );
+
+    createCameraUpscale( context );
+
+    setScale( 1.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DynamicResolution::~DynamicResolution() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DynamicResolution::update()
+{
+    osg::ref_ptr<osg::Camera> camera;
+
+    if ( !_camera.lock( camera ) || !camera->getStats() ) return;
+
+    const osg::GraphicsContext::Traits *traits = camera->getGraphicsContext()->getTraits();
+
+    if ( traits->width != _width || traits->height != _height )
+    {
+        resize( traits->width, traits->height );
+    }
+
+    const osg::Stats *stats = camera->getStats();
+
+    unsigned int earliest = std::max( std::max( _frameGPU, _frameScale ) + 1, stats->getEarliestFrameNumber() );
+    unsigned int latest   = stats->getLatestFrameNumber();
+
+    // timer queries results are available a few frames later,
+    // frames drawn before render scale change are skipped
+    double gpu = 0.0;
+    bool valid = false;
+
+    for ( unsigned int f = latest; f >= earliest && f > 0 && !valid; f-- )
+    {
+        if ( stats->getAttribute( f, "GPU draw time taken", gpu ) )
+        {
+            _frameGPU = f;
+            valid = true;
+        }
+    }
+
+    if ( valid && gpu > 0.0 )
+    {
+        double scale = _scale;
+
+        if ( gpu > CGI_DYNAMIC_RESOLUTION_BUDGET )
+        {
+            // GPU time is roughly proportional to the number of pixels
+            scale = _scale * sqrt( CGI_DYNAMIC_RESOLUTION_BUDGET / gpu );
+        }
+        else if ( gpu < headroom * CGI_DYNAMIC_RESOLUTION_BUDGET )
+        {
+            scale = _scale + step_up;
+        }
+
+        scale = std::max( CGI_DYNAMIC_RESOLUTION_MIN, std::min( 1.0, scale ) );
+
+        if ( fabs( scale - _scale ) > 1.0e-3 )
+        {
+            setScale( scale );
+            _frameScale = latest;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DynamicResolution::createCameraUpscale( osg::GraphicsContext *context )
+{
+    const osg::GraphicsContext::Traits *traits = context->getTraits();
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
+
+    v->push_back( osg::Vec3( 0.0f, 0.0f, 0.0f ) );
+    v->push_back( osg::Vec3( 1.0f, 0.0f, 0.0f ) );
+    v->push_back( osg::Vec3( 0.0f, 1.0f, 0.0f ) );
+    v->push_back( osg::Vec3( 1.0f, 1.0f, 0.0f ) );
+
+    _texCoords = new osg::Vec2Array( 4 );
+
+    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
+    c->push_back( osg::Vec4( 1.0f, 1.0f, 1.0f, 1.0f ) );
+
+    geometry->setVertexArray( v.get() );
+    geometry->setTexCoordArray( 0, _texCoords.get() );
+    geometry->setColorArray( c.get(), osg::Array::BIND_OVERALL );
+    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
+
+    // texture coordinates are modified between frames
+    geometry->setDataVariance( osg::Object::DYNAMIC );
+    geometry->setUseDisplayList( false );
+    geometry->setUseVertexBufferObjects( true );
+
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    geode->addDrawable( geometry.get() );
+
+    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
+
+    stateSet->setTextureAttributeAndModes( 0, _texture.get(), osg::StateAttribute::ON );
+    stateSet->setMode( GL_LIGHTING   , osg::StateAttribute::OFF );
+    stateSet->setMode( GL_BLEND      , osg::StateAttribute::OFF );
+    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OFF );
+    stateSet->setAttributeAndModes( new osg::Depth( osg::Depth::ALWAYS, 0.0, 1.0, false ) );
+
+    GLenum buffer = traits->doubleBuffer ? GL_BACK : GL_FRONT;
+
+    _cameraUpscale = new osg::Camera();
+
+    _cameraUpscale->setName( "Upscale" );
+    _cameraUpscale->setGraphicsContext( context );
+    _cameraUpscale->setViewport( new osg::Viewport( 0, 0, traits->width, traits->height ) );
+    _cameraUpscale->setDrawBuffer( buffer );
+    _cameraUpscale->setReadBuffer( buffer );
+    _cameraUpscale->setProjectionMatrixAsOrtho2D( 0.0, 1.0, 0.0, 1.0 );
+    _cameraUpscale->setReferenceFrame( osg::Transform::ABSOLUTE_RF );
+    _cameraUpscale->setViewMatrix( osg::Matrix::identity() );
+    _cameraUpscale->setClearMask( 0 );
+    _cameraUpscale->setRenderOrder( osg::Camera::POST_RENDER );
+    _cameraUpscale->setAllowEventFocus( false );
+    _cameraUpscale->addChild( geode.get() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DynamicResolution::resize( int width, int height )
+{
+    osg::ref_ptr<osg::Camera> camera;
+
+    if ( !_camera.lock( camera ) ) return;
+
+    // cameras rendering to FBO are not resized with the window
+    double fovy   = 0.0;
+    double aspect = 0.0;
+    double zNear  = 0.0;
+    double zFar   = 0.0;
+
+    if ( camera->getProjectionMatrixAsPerspective( fovy, aspect, zNear, zFar ) )
+    {
+        aspect = (double)width / (double)height;
+        camera->setProjectionMatrixAsPerspective( fovy, aspect, zNear, zFar );
+    }
+
+    _width  = width;
+    _height = height;
+
+    _texture->setTextureSize( _width, _height );
+    _texture->dirtyTextureObject();
+
+    camera->dirtyAttachmentMap();
+
+    _cameraUpscale->setViewport( new osg::Viewport( 0, 0, _width, _height ) );
+
+    setScale( _scale );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DynamicResolution::setScale( double scale )
+{
+    osg::ref_ptr<osg::Camera> camera;
+
+    if ( !_camera.lock( camera ) ) return;
+
+    int w = std::max( 1, (int)floor( scale * _width  + 0.5 ) );
+    int h = std::max( 1, (int)floor( scale * _height + 0.5 ) );
+
+    // new viewport object, so the one of the frame still being drawn is intact
+    camera->setViewport( new osg::Viewport( 0, 0, w, h ) );
+
+    float s = (float)w / (float)_width;
+    float t = (float)h / (float)_height;
+
+    (*_texCoords)[ 0 ] = osg::Vec2( 0.0f, 0.0f );
+    (*_texCoords)[ 1 ] = osg::Vec2(    s, 0.0f );
+    (*_texCoords)[ 2 ] = osg::Vec2( 0.0f,    t );
+    (*_texCoords)[ 3 ] = osg::Vec2(    s,    t );
+    _texCoords->dirty();
+
+    _scale = scale;
+}
@@ -0,0 +1,106 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_DYNAMICRESOLUTION_H
+#define CGI_DYNAMICRESOLUTION_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <osg/Camera>
+#include <osg/Geometry>
+#include <osg/Texture2D>
+#include <osg/observer_ptr>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Dynamic resolution scaling class.
+ *
+ * Scene camera renders into an offscreen target, which is then upscaled to
+ * the window by the post-render camera. Rendered part of the target tracks
+ * CGI_DYNAMIC_RESOLUTION_BUDGET GPU time budget of the scene camera measured
+ * with timer queries, so with vertical sync enabled heavy frames are rendered
+ * at lower resolution instead of halving the frame rate. Render scale is
+ * decreased as soon as the budget is exceeded and increased in small steps
+ * only when there is some headroom left.
+ */
+class DynamicResolution
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param camera scene camera with window graphics context set
+     */
+    DynamicResolution( osg::Camera *camera );
+
+    /** @brief Destructor. */
+    virtual ~DynamicResolution();
+
+    /**
+     * @brief Updates render scale using the most recent GPU time available.
+     * Should be called once per frame, outside the viewer frame.
+     */
+    void update();
+
+    /** @brief Returns upscaling camera (to be added as a viewer slave). */
+    inline osg::Camera* getCamera() { return _cameraUpscale.get(); }
+
+    /** @brief Returns current render scale. */
+    inline double getScale() const { return _scale; }
+
+private:
+
+    osg::observer_ptr<osg::Camera> _camera;     ///< scene camera
+
+    osg::ref_ptr<osg::Camera>    _cameraUpscale;    ///< upscaling camera
+    osg::ref_ptr<osg::Texture2D> _texture;          ///< offscreen color target
+    osg::ref_ptr<osg::Vec2Array> _texCoords;        ///< upscaling quad texture coordinates
+
+    int _width;                     ///< [px] offscreen target width
+    int _height;                    ///< [px] offscreen target height
+
+    double _scale;                  ///< [-] render scale
+
+    unsigned int _frameGPU;         ///< last frame with GPU time read
+    unsigned int _frameScale;       ///< frame in which render scale has been changed
+
+    /** Using this constructor is forbidden. */
+    DynamicResolution( const DynamicResolution & ) {}
+
+    /** Creates upscaling camera. */
+    void createCameraUpscale( osg::GraphicsContext *context );
+
+    /** Resizes offscreen target to the window size. */
+    void resize( int width, int height );
+
+    /** Sets scene camera viewport and upscaling quad texture coordinates. */
+    void setScale( double scale );
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_DYNAMICRESOLUTION_H
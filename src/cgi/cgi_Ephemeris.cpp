@@ -24,6 +24,8 @@
 
 #include <cmath>
 
+#include <cgi/cgi_Defines.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
@@ -190,15 +192,48 @@ Ephemeris::Ephemeris() :
     _moonAlpha ( 0.0 ),
     _moonDelta ( 0.0 ),
     _moonElev ( 0.0 ),
-    _moonAzim ( 0.0 )
+    _moonAzim ( 0.0 ),
+
+    _lat ( 0.0 ),
+    _lon ( 0.0 ),
+
+    _sinLat ( 0.0 ),
+    _cosLat ( 1.0 ),
+
+    _valid ( false )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Ephemeris::update( DateTime dateTime, double lat, double lon )
+{
+    double jd = julianDay( dateTime );
+
+    // right ascensions and declinations evolve on a timescale of minutes,
+    // so these are recomputed only at low rate (in terms of simulation time),
+    // half a second margin since date and time has one second resolution
+    bool celestial = !_valid
+            || fabs( jd - _jd ) * 86400.0 > CGI_EPHEMERIS_UPDATE_INTERVAL - 0.5;
+
+    if ( celestial )
+    {
+        updateCelestial( dateTime, jd );
+    }
+
+    if ( celestial || lat != _lat || lon != _lon )
+    {
+        updateLocal( lat, lon );
+    }
+
+    _valid = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Ephemeris::updateCelestial( DateTime dateTime, double jd )
 {
     // Meeus J.: Astronomical Algorithms, p.87
-    _jd = julianDay( dateTime );
+    _jd = jd;
     _jc = ( _jd - 2451545.0 ) / 36525.0;
 
     _ut = dateTime.hour
@@ -216,12 +251,6 @@ void Ephemeris::update( DateTime dateTime, double lat, double lon )
     // Greenwich sidereal time
     _gst = M_PI * T0 / 12.0;
 
-    // local sidereal time angle
-    _lst = _gst + lon;
-
-    const double sinLat = sin( lat );
-    const double cosLat = cos( lat );
-
     // obliquity of the ecliptic
     double epsilon = 0.409093 - 0.000227 * _jc;
 
@@ -302,12 +331,29 @@ void Ephemeris::update( DateTime dateTime, double lat, double lon )
 
     // Moon declination
     _moonDelta = asin( sinMoonBeta*cosEpsilon + cosMoonBeta*sinEpsilon*sinMoonLambda );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Ephemeris::updateLocal( double lat, double lon )
+{
+    if ( !_valid || lat != _lat )
+    {
+        _sinLat = sin( lat );
+        _cosLat = cos( lat );
+    }
+
+    _lat = lat;
+    _lon = lon;
+
+    // local sidereal time angle
+    _lst = _gst + lon;
 
     // Sun elevation and azimuth
     computeElevAndAzim( _sunAlpha, _sunDelta, _sunElev, _sunAzim,
-                        sinLat, cosLat, _lst );
+                        _sinLat, _cosLat, _lst );
 
     // Moon elevation and azimuth
     computeElevAndAzim( _moonAlpha, _moonDelta, _moonElev, _moonAzim,
-                        sinLat, cosLat, _lst );
+                        _sinLat, _cosLat, _lst );
 }
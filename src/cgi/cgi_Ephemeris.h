@@ -72,6 +72,15 @@ public:
     /** @brief Constructor. */
     Ephemeris();
 
+    /**
+     * @brief Updates ephemeris.
+     * Sun and Moon right ascensions and declinations are recomputed only when
+     * date and time changed by at least CGI_EPHEMERIS_UPDATE_INTERVAL, when
+     * only position changed just local elevations and azimuths are updated.
+     * @param dateTime date and time
+     * @param lat [rad] latitude
+     * @param lon [rad] longitude
+     */
     void update( DateTime dateTime, double lat, double lon );
 
     inline double getJD() const { return _jd; }
@@ -109,6 +118,29 @@ private:
     double _moonDelta;      ///< [rad] Moon declination
     double _moonElev;       ///< [rad] Moon elevation
     double _moonAzim;       ///< [rad] Moon azimuth
+
+    double _lat;            ///< [rad] latitude elevations and azimuths were computed for
+    double _lon;            ///< [rad] longitude elevations and azimuths were computed for
+
+    double _sinLat;         ///< [-] latitude sine
+    double _cosLat;         ///< [-] latitude cosine
+
+    bool _valid;            ///< specifies if ephemeris has been computed
+
+    /**
+     * @brief Computes time dependent part of the ephemeris.
+     * Computes sidereal time, Sun and Moon right ascensions and declinations.
+     * @param dateTime date and time
+     * @param jd [-] Julian day
+     */
+    void updateCelestial( DateTime dateTime, double jd );
+
+    /**
+     * @brief Computes Sun and Moon local elevations and azimuths.
+     * @param lat [rad] latitude
+     * @param lon [rad] longitude
+     */
+    void updateLocal( double lat, double lon );
 };
 
 } // end of cgi namespace
@@ -0,0 +1,371 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_FrameStats.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include <osg/Depth>
+
+#include <fdm/utils/fdm_Time.h>
+
+#include <cgi/cgi_Fonts.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const double avg_coef = 0.1;    ///< [-] exponential averaging coefficient
+const double text_dt  = 0.5;    ///< [s] overlay text update interval
+
+const char *names_gpu  [] = { "GPU OTW" , "GPU HUD" , "GPU Map"  };
+const char *names_cull [] = { "Cull OTW", "Cull HUD", "Cull Map" };
+const char *names_draw [] = { "Draw OTW", "Draw HUD", "Draw Map" };
+
+#ifdef FDM_METRICS
+const char *metrics_cull  [] = { "cgi.otw.cull_time"  , "cgi.hud.cull_time"  , "cgi.map.cull_time"  };
+const char *metrics_draw  [] = { "cgi.otw.draw_time"  , "cgi.hud.draw_time"  , "cgi.map.draw_time"  };
+const char *metrics_gpu   [] = { "cgi.otw.gpu_time"   , "cgi.hud.gpu_time"   , "cgi.map.gpu_time"   };
+const char *metrics_calls [] = { "cgi.otw.draw_calls" , "cgi.hud.draw_calls" , "cgi.map.draw_calls" };
+#endif
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FrameStats::collect( osg::Camera *camera )
+{
+#   ifdef CGI_FRAME_STATS
+    if ( !camera->getStats() )
+    {
+        camera->setStats( new osg::Stats( "Camera" ) );
+    }
+
+    camera->getStats()->collectStats( "rendering" , true );
+    camera->getStats()->collectStats( "gpu"       , true );
+#   ifdef FDM_METRICS
+    camera->getStats()->collectStats( "scene"     , true );
+#   endif
+#   else
+    (void)camera;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FrameStats::collect( osgViewer::Viewer *viewer )
+{
+#   ifdef CGI_FRAME_STATS
+    viewer->getViewerStats()->collectStats( "frame_rate" , true );
+    viewer->getViewerStats()->collectStats( "event"      , true );
+    viewer->getViewerStats()->collectStats( "update"     , true );
+#   else
+    (void)viewer;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+FrameStats::FrameStats() :
+    _event_avg  ( 0.0 ),
+    _update_avg ( 0.0 ),
+    _frame_avg  ( 0.0 ),
+    _textTick ( osg::Timer::instance()->tick() )
+{
+    for ( int i = 0; i < ModulesCount; i++ )
+    {
+        _module_dt  [ i ] = 0.0;
+        _module_avg [ i ] = 0.0;
+    }
+
+    for ( int i = 0; i < PassesCount; i++ )
+    {
+        _cull_avg [ i ] = 0.0;
+        _draw_avg [ i ] = 0.0;
+        _gpu_avg  [ i ] = 0.0;
+    }
+
+#   ifdef FDM_METRICS
+    _frameTick = _textTick;
+
+    _metricFrame = fdm::Metrics::add( "cgi.frame_time", fdm::Metrics::Timer );
+
+    for ( int i = 0; i < PassesCount; i++ )
+    {
+        _metricCull  [ i ] = fdm::Metrics::add( metrics_cull  [ i ], fdm::Metrics::Gauge );
+        _metricDraw  [ i ] = fdm::Metrics::add( metrics_draw  [ i ], fdm::Metrics::Gauge );
+        _metricGPU   [ i ] = fdm::Metrics::add( metrics_gpu   [ i ], fdm::Metrics::Gauge );
+        _metricCalls [ i ] = fdm::Metrics::add( metrics_calls [ i ], fdm::Metrics::Gauge );
+    }
+#   endif
+
+    _geode = new osg::Geode();
+    _geode->setName( "FrameStats" );
+
+    osg::ref_ptr<osg::StateSet> stateSet = _geode->getOrCreateStateSet();
+
+    stateSet->setMode( GL_LIGHTING   , osg::StateAttribute::OFF );
+    stateSet->setMode( GL_DEPTH_TEST , osg::StateAttribute::OFF );
+    stateSet->setAttributeAndModes( new osg::Depth( osg::Depth::ALWAYS, 0.0, 1.0, false ) );
+    stateSet->setRenderBinDetails( CGI_DEPTH_SORTED_BIN_HUD, "DepthSortedBin" );
+
+    _text = new osgText::Text();
+    _text->setFont( Fonts::get( "fonts/hud.ttf" ) );
+    _text->setColor( osg::Vec4( 1.0f, 1.0f, 0.0f, 1.0f ) );
+    _text->setCharacterSize( 3.0f );
+    _text->setAxisAlignment( osgText::TextBase::XY_PLANE );
+    _text->setPosition( osg::Vec3( 0.0f, -CGI_HUD_Y_2 + 2.0f, -1.0f ) );
+    _text->setLayout( osgText::Text::LEFT_TO_RIGHT );
+    _text->setAlignment( osgText::Text::CENTER_BOTTOM_BASE_LINE );
+    _text->setDataVariance( osg::Object::DYNAMIC );
+    _geode->addDrawable( _text.get() );
+
+#   ifndef CGI_FRAME_STATS
+    _geode->setNodeMask( 0 );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+FrameStats::~FrameStats() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FrameStats::update( osgViewer::Viewer *viewer )
+{
+#   ifdef CGI_FRAME_STATS
+    // stats times are expressed relative to the viewer start
+    double offset = fdm::Time::get() - viewer->elapsedTime();
+
+    bool otw = 0 == viewer->getCamera()->getName().compare( "OTW" );
+
+    if ( otw )
+    {
+        for ( int i = 0; i < ModulesCount; i++ )
+        {
+            _module_avg[ i ] += avg_coef * ( _module_dt[ i ] - _module_avg[ i ] );
+            _module_dt[ i ] = 0.0;
+        }
+
+        const osg::Stats *stats = viewer->getViewerStats();
+
+        stats->getAveragedAttribute( "Event traversal time taken"  , _event_avg  );
+        stats->getAveragedAttribute( "Update traversal time taken" , _update_avg );
+        stats->getAveragedAttribute( "Frame duration"              , _frame_avg  );
+
+#       ifdef FDM_METRICS
+        osg::Timer_t tick = osg::Timer::instance()->tick();
+        fdm::Metrics::time( _metricFrame, osg::Timer::instance()->delta_s( _frameTick, tick ) );
+        _frameTick = tick;
+#       endif
+    }
+
+    double cull [ PassesCount ] = { 0.0 };
+    double draw [ PassesCount ] = { 0.0 };
+    double gpu  [ PassesCount ] = { 0.0 };
+#   ifdef FDM_METRICS
+    double calls[ PassesCount ] = { 0.0 };
+#   endif
+
+    bool valid [ PassesCount ] = { false };
+
+    osgViewer::ViewerBase::Cameras cameras;
+    viewer->getCameras( cameras );
+
+    for ( osgViewer::ViewerBase::Cameras::iterator it = cameras.begin(); it != cameras.end(); ++it )
+    {
+        const osg::Stats *stats = (*it)->getStats();
+        PassId id = getPassId( *it );
+
+        if ( stats && id != PassesCount )
+        {
+            double temp = 0.0;
+
+            // channels of the same pass are summed up
+            if ( stats->getAveragedAttribute( "Cull traversal time taken" , temp ) ) cull [ id ] += temp;
+            if ( stats->getAveragedAttribute( "Draw traversal time taken" , temp ) ) draw [ id ] += temp;
+            if ( stats->getAveragedAttribute( "GPU draw time taken"       , temp ) ) gpu  [ id ] += temp;
+
+#           ifdef FDM_METRICS
+            // collected as scene statistics, each drawable is a draw call
+            if ( stats->getAveragedAttribute( "Visible number of drawables", temp ) ) calls[ id ] += temp;
+#           endif
+
+            valid[ id ] = true;
+
+#           ifdef FDM_PROFILER
+            record( stats, id, offset );
+#           endif
+        }
+    }
+
+    for ( int i = 0; i < PassesCount; i++ )
+    {
+        if ( valid[ i ] )
+        {
+            _cull_avg [ i ] = cull [ i ];
+            _draw_avg [ i ] = draw [ i ];
+            _gpu_avg  [ i ] = gpu  [ i ];
+        }
+    }
+
+#   ifdef FDM_METRICS
+    publish( valid, calls );
+#   endif
+
+    if ( otw )
+    {
+        osg::Timer_t tick = osg::Timer::instance()->tick();
+
+        if ( osg::Timer::instance()->delta_s( _textTick, tick ) > text_dt )
+        {
+            updateText();
+            _textTick = tick;
+        }
+    }
+
+    (void)offset;
+#   else
+    (void)viewer;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+FrameStats::PassId FrameStats::getPassId( const osg::Camera *camera )
+{
+    const std::string &name = camera->getName();
+
+    if ( 0 == name.compare( "OTW" ) || 0 == name.compare( 0, 4, "OTW_" ) )
+    {
+        return PassOTW;
+    }
+    else if ( 0 == name.compare( "HUD" ) )
+    {
+        return PassHUD;
+    }
+    else if ( 0 == name.compare( "Map" ) )
+    {
+        return PassMap;
+    }
+
+    return PassesCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef FDM_METRICS
+void FrameStats::publish( const bool *valid, const double *calls )
+{
+    for ( int i = 0; i < PassesCount; i++ )
+    {
+        if ( valid[ i ] )
+        {
+            fdm::Metrics::set( _metricCull  [ i ], _cull_avg [ i ] );
+            fdm::Metrics::set( _metricDraw  [ i ], _draw_avg [ i ] );
+            fdm::Metrics::set( _metricGPU   [ i ], _gpu_avg  [ i ] );
+            fdm::Metrics::set( _metricCalls [ i ], calls     [ i ] );
+        }
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FrameStats::record( const osg::Stats *stats, PassId id, double offset )
+{
+    Recorded &recorded = _recorded[ stats ];
+
+    unsigned int earliest = stats->getEarliestFrameNumber();
+    unsigned int latest   = stats->getLatestFrameNumber();
+
+    double t_0 = 0.0;
+    double t_1 = 0.0;
+
+    // the latest frame might be still drawn by the graphics thread
+    for ( unsigned int f = std::max( recorded.cpu + 1, earliest ); f < latest; f++ )
+    {
+        if ( stats->getAttribute( f, "Cull traversal begin time", t_0 )
+          && stats->getAttribute( f, "Cull traversal end time"  , t_1 ) )
+        {
+            fdm::Profiler::record( names_cull[ id ], t_0 + offset, t_1 + offset );
+        }
+
+        if ( stats->getAttribute( f, "Draw traversal begin time", t_0 )
+          && stats->getAttribute( f, "Draw traversal end time"  , t_1 ) )
+        {
+            fdm::Profiler::record( names_draw[ id ], t_0 + offset, t_1 + offset );
+        }
+
+        recorded.cpu = f;
+    }
+
+    // timer queries results are available a few frames later
+    for ( unsigned int f = std::max( recorded.gpu + 1, earliest ); f <= latest; f++ )
+    {
+        if ( stats->getAttribute( f, "GPU draw begin time", t_0 )
+          && stats->getAttribute( f, "GPU draw end time"  , t_1 ) )
+        {
+            fdm::Profiler::record( names_gpu[ id ], t_0 + offset, t_1 + offset );
+        }
+        else if ( f + CGI_FRAME_STATS_GPU_LAG > latest )
+        {
+            break;
+        }
+
+        recorded.gpu = f;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FrameStats::updateText()
+{
+    char str[ 512 ] = { '\0' };
+
+    snprintf( str, sizeof(str),
+              "FRAME %5.2f  EVT %5.2f  UPD %5.2f [ms]\n"
+              "CULL OTW %5.2f  HUD %5.2f  MAP %5.2f [ms]\n"
+              "DRAW OTW %5.2f  HUD %5.2f  MAP %5.2f [ms]\n"
+              "GPU  OTW %5.2f  HUD %5.2f  MAP %5.2f [ms]\n"
+              "Clouds %5.2f  FogScene %5.2f  Ownship %5.2f  SkyDome %5.2f [ms]",
+              1000.0 * _frame_avg, 1000.0 * _event_avg, 1000.0 * _update_avg,
+              1000.0 * _cull_avg [ PassOTW ], 1000.0 * _cull_avg [ PassHUD ], 1000.0 * _cull_avg [ PassMap ],
+              1000.0 * _draw_avg [ PassOTW ], 1000.0 * _draw_avg [ PassHUD ], 1000.0 * _draw_avg [ PassMap ],
+              1000.0 * _gpu_avg  [ PassOTW ], 1000.0 * _gpu_avg  [ PassHUD ], 1000.0 * _gpu_avg  [ PassMap ],
+              1000.0 * _module_avg[ ModuleClouds   ],
+              1000.0 * _module_avg[ ModuleFogScene ],
+              1000.0 * _module_avg[ ModuleOwnship  ],
+              1000.0 * _module_avg[ ModuleSkyDome  ] );
+
+    if ( 0 != _str.compare( str ) )
+    {
+        _str = str;
+        _text->setText( _str );
+    }
+}
@@ -0,0 +1,232 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_FRAMESTATS_H
+#define CGI_FRAMESTATS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <string>
+
+#include <osg/Camera>
+#include <osg/Geode>
+#include <osg/Timer>
+
+#include <osgText/Text>
+
+#include <osgViewer/Viewer>
+
+#include <fdm/utils/fdm_Metrics.h>
+#include <fdm/utils/fdm_Profiler.h>
+
+#include <cgi/cgi_Defines.h>
+
+#include <sim/Singleton.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef CGI_FRAME_STATS
+#   define CGI_FRAME_STATS_ZONE( id, name ) \
+    FDM_PROFILE_ZONE( name ); \
+    cgi::FrameStats::ModuleZone cgi_frame_stats_zone_( cgi::FrameStats::id )
+#else
+#   define CGI_FRAME_STATS_ZONE( id, name ) FDM_PROFILE_ZONE( name )
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Renderer frame statistics class.
+ *
+ * Collects CPU event, update, cull and draw times together with GPU times of
+ * the OTW, HUD and map passes (measured by OSG with timer queries) and
+ * update times of the selected modules (recorded with CGI_FRAME_STATS_ZONE
+ * macro). Averaged values are displayed by the overlay node, when FDM_PROFILER
+ * is defined per frame timings are also recorded as profiler zones, so they
+ * can be matched against the FDM zones in the trace.
+ *
+ * Statistics are collected only when CGI_FRAME_STATS is defined, which is
+ * the default for SIM_OSG_DEBUG_INFO, FDM_PROFILER and FDM_METRICS builds.
+ * Cameras have to be named after their passes ("OTW", "HUD" or "Map", OTW
+ * channels "OTW_<n>"). When FDM_METRICS is defined OTW frame intervals,
+ * averaged pass times and numbers of drawn drawables are also published
+ * as metrics.
+ */
+class FrameStats : public Singleton< FrameStats >
+{
+    friend class Singleton< FrameStats >;
+
+public:
+
+    /** Modules whose update is timed. */
+    enum ModuleId
+    {
+        ModuleClouds = 0,               ///< clouds
+        ModuleFogScene,                 ///< fog scene (excluding children)
+        ModuleOwnship,                  ///< ownship
+        ModuleSkyDome,                  ///< sky dome
+        ModulesCount                    ///< number of timed modules
+    };
+
+    /** Render passes. */
+    enum PassId
+    {
+        PassOTW = 0,                    ///< Out-the-Window (all channels)
+        PassHUD,                        ///< Head-up Display
+        PassMap,                        ///< map
+        PassesCount                     ///< number of passes
+    };
+
+    /** @brief Scoped module update timer class. */
+    class ModuleZone
+    {
+    public:
+
+        /** @brief Constructor. */
+        inline ModuleZone( ModuleId id ) :
+            _id ( id ),
+            _t_0 ( osg::Timer::instance()->tick() )
+        {}
+
+        /** @brief Destructor. */
+        inline ~ModuleZone()
+        {
+            FrameStats::instance()->addModuleTime( _id, osg::Timer::instance()->delta_s( _t_0, osg::Timer::instance()->tick() ) );
+        }
+
+    private:
+
+        ModuleId _id;               ///< module ID
+        osg::Timer_t _t_0;          ///< zone start tick
+
+        ModuleZone( const ModuleZone & );
+        ModuleZone& operator= ( const ModuleZone & );
+    };
+
+    /**
+     * @brief Enables collecting CPU and GPU statistics of the camera.
+     * @param camera camera (named after its pass)
+     */
+    static void collect( osg::Camera *camera );
+
+    /**
+     * @brief Enables collecting viewer statistics.
+     * @param viewer viewer
+     */
+    static void collect( osgViewer::Viewer *viewer );
+
+    /** @brief Destructor. */
+    virtual ~FrameStats();
+
+    /**
+     * @brief Adds module update time of the current frame.
+     * @param id module ID
+     * @param dt [s] update time
+     */
+    inline void addModuleTime( ModuleId id, double dt )
+    {
+        _module_dt[ id ] += dt;
+    }
+
+    /**
+     * @brief Reads statistics of the frames completed by the viewer.
+     * Should be called once per frame of the viewer, after updating modules.
+     * @param viewer viewer
+     */
+    void update( osgViewer::Viewer *viewer );
+
+    /** @brief Returns overlay node (to be put under HUD camera). */
+    inline osg::Node* getNode() { return _geode.get(); }
+
+private:
+
+    /** Per camera frames already recorded. */
+    struct Recorded
+    {
+        unsigned int cpu;           ///< last frame with CPU times recorded
+        unsigned int gpu;           ///< last frame with GPU time recorded
+    };
+
+    typedef std::map< const osg::Stats*, Recorded > RecordedMap;
+
+    osg::ref_ptr<osg::Geode> _geode;            ///< overlay geode
+    osg::ref_ptr<osgText::Text> _text;          ///< overlay text
+
+    std::string _str;                           ///< overlay text string
+
+    RecordedMap _recorded;                      ///< recorded frames
+
+    double _module_dt  [ ModulesCount ];        ///< [s] module update times of the current frame
+    double _module_avg [ ModulesCount ];        ///< [s] module averaged update times
+
+    double _cull_avg [ PassesCount ];           ///< [s] averaged cull times
+    double _draw_avg [ PassesCount ];           ///< [s] averaged draw times
+    double _gpu_avg  [ PassesCount ];           ///< [s] averaged GPU times
+
+    double _event_avg;                          ///< [s] averaged event traversal time
+    double _update_avg;                         ///< [s] averaged update traversal time
+    double _frame_avg;                          ///< [s] averaged frame duration
+
+    osg::Timer_t _textTick;                     ///< last overlay text update tick
+
+#   ifdef FDM_METRICS
+    osg::Timer_t _frameTick;                    ///< last OTW frame tick
+
+    int _metricFrame;                           ///< OTW frame interval metric ID
+    int _metricCull  [ PassesCount ];           ///< averaged cull time metrics IDs
+    int _metricDraw  [ PassesCount ];           ///< averaged draw time metrics IDs
+    int _metricGPU   [ PassesCount ];           ///< averaged GPU time metrics IDs
+    int _metricCalls [ PassesCount ];           ///< averaged number of drawables metrics IDs
+#   endif
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to FrameStats class instance.
+     */
+    FrameStats();
+
+    /** Using this constructor is forbidden. */
+    FrameStats( const FrameStats & ) : Singleton< FrameStats >() {}
+
+    /** Returns camera pass ID or PassesCount if camera is not a known pass. */
+    static PassId getPassId( const osg::Camera *camera );
+
+#   ifdef FDM_METRICS
+    /** Publishes pass metrics. */
+    void publish( const bool *valid, const double *calls );
+#   endif
+
+    /** Records camera frames in the profiler trace. */
+    void record( const osg::Stats *stats, PassId id, double offset );
+
+    /** Updates overlay text. */
+    void updateText();
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_FRAMESTATS_H
@@ -22,12 +22,16 @@
 
 #include <cgi/cgi_Intersections.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <vector>
 
 #include <osgDB/ReadFile>
 
 #include <osgUtil/LineSegmentIntersector>
 
+#include <cgi/cgi_Defines.h>
 #include <cgi/cgi_WGS84.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,83 +40,192 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Intersections::ReadCallback::ReadCallback( bool prefetch ) :
+    _prefetch ( prefetch )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
 #if OPENSCENEGRAPH_SOVERSION < 140
 osg::Node* Intersections::ReadCallback::readNodeFile( const std::string& filename )
 {
-    return osgDB::readRefNodeFile( filename ).release();
+    return Intersections::instance()->getTile( filename, _prefetch ).release();
 }
 #else
 osg::ref_ptr<osg::Node> Intersections::ReadCallback::readNodeFile( const std::string& filename )
 {
-    return osgDB::readRefNodeFile( filename );
+    return Intersections::instance()->getTile( filename, _prefetch );
 }
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Intersections::Intersections()
+Intersections::Intersections() :
+    _prefetchRequests ( 0 ),
+    _quit ( false ),
+    _prefetched ( false )
 {
-    _rc = new ReadCallback();
+    _rc = new ReadCallback( false );
+    _rc_prefetch = new ReadCallback( true );
 
-//    _iv = new osgUtil::IntersectionVisitor();
-//    _iv->setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
-//    _iv->setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
-//    _iv->setReadCallback( _rc.get() );
+    // paged terrain tiles are shared with the database pager
+    _options = new osgDB::Options();
+    _options->setObjectCacheHint( osgDB::Options::CACHE_NODES );
 
-//    _ig = new osgUtil::IntersectorGroup();
-//    _iv->setIntersector( _ig.get() );
+    _loader = std::thread( &Intersections::loadTiles, this );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Intersections::~Intersections() {}
+Intersections::~Intersections()
+{
+    {
+        std::lock_guard< std::mutex > lock( _tilesMutex );
+        _quit = true;
+    }
+
+    _tilesCond.notify_all();
+
+    if ( _loader.joinable() ) _loader.join();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 bool Intersections::findFirst( const osg::Vec3d &b, const osg::Vec3d &e,
                                osg::Vec3d &r, osg::Vec3d &n )
 {
-//    _iv->reset();
-//    _ig->clear();
+    Segment segment;
 
-    if ( _scenery.valid() )
+    segment.b = b;
+    segment.e = e;
+
+    if ( findFirst( &segment, 1 ) > 0 )
     {
-        if ( ( e - b ).length2() > 1.0e-6 )
-        {
-            //osgUtil::LineSegmentIntersector tmp( b, e );
-            //osg::ref_ptr<osgUtil::LineSegmentIntersector> intersector = &tmp;
+        r = segment.r;
+        n = segment.n;
+
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Intersections::findFirst( Segment *segments, unsigned int count )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    std::vector< osg::ref_ptr<osgUtil::LineSegmentIntersector> > intersectors( count );
 
-            osg::ref_ptr<osgUtil::LineSegmentIntersector> intersector =
-                    new osgUtil::LineSegmentIntersector( b, e );
+    osg::ref_ptr<osgUtil::IntersectorGroup> group = new osgUtil::IntersectorGroup();
 
-            osgUtil::IntersectionVisitor iv( intersector.get(), _rc.get() );
-            iv.setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
-            iv.setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
-            _scenery->accept( iv );
+    bool empty = true;
 
-//            osg::ref_ptr<osgUtil::IntersectionVisitor> iv = new osgUtil::IntersectionVisitor( intersector.get(), _rc.get() );
-//            iv->setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
-//            iv->setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
-//            _scenery->accept( *iv );
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        segments[ i ].hit = false;
 
-//            _iv->setIntersector( intersector.get() );
-//            _ig->addIntersector( intersector.get() );
+        if ( ( segments[ i ].e - segments[ i ].b ).length2() > 1.0e-6 )
+        {
+            intersectors[ i ] = new osgUtil::LineSegmentIntersector( segments[ i ].b,
+                                                                     segments[ i ].e );
+            group->addIntersector( intersectors[ i ].get() );
+            empty = false;
+        }
+    }
 
-//            _scenery->accept( *_iv );
+    unsigned int hits = 0;
 
-            if ( intersector->containsIntersections() )
+    if ( _scenery.valid() && !empty )
+    {
+        osgUtil::IntersectionVisitor iv( group.get(), _rc.get() );
+        iv.setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
+        iv.setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
+        _scenery->accept( iv );
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            if ( intersectors[ i ].valid() && intersectors[ i ]->containsIntersections() )
             {
-                osgUtil::LineSegmentIntersector::Intersection intersection = intersector->getFirstIntersection();
+                osgUtil::LineSegmentIntersector::Intersection intersection =
+                        intersectors[ i ]->getFirstIntersection();
 
-                r = intersection.getWorldIntersectPoint();
-                n = intersection.getWorldIntersectNormal();
+                segments[ i ].r = intersection.getWorldIntersectPoint();
+                segments[ i ].n = intersection.getWorldIntersectNormal();
+                segments[ i ].hit = true;
 
-                return true;
+                hits++;
             }
         }
     }
 
-    return false;
+    return hits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::prefetch( double lat, double lon )
+{
+    osg::Vec3d pos_wgs = WGS84( lat, lon, 0.0 ).getPosition();
+
+    bool moved = ( pos_wgs - _prefetch_wgs ).length2()
+               > CGI_INTERSECTIONS_PREFETCH_STEP * CGI_INTERSECTIONS_PREFETCH_STEP;
+
+    // children of the loaded tiles are only discovered by the next traversal,
+    // so it is repeated when all tiles requested by the previous one are loaded
+    bool refresh = false;
+
+    {
+        std::lock_guard< std::mutex > lock( _tilesMutex );
+        refresh = _prefetchRequests > 0 && _requested.empty();
+    }
+
+    if ( ( _prefetched && !moved && !refresh ) || !_scenery.valid() )
+    {
+        return;
+    }
+
+    _prefetch_wgs = pos_wgs;
+    _prefetched = true;
+
+    {
+        std::lock_guard< std::mutex > lock( _tilesMutex );
+        _prefetchRequests = 0;
+    }
+
+    osg::ref_ptr<osgUtil::IntersectorGroup> group = new osgUtil::IntersectorGroup();
+
+    // center and ring of points around the position
+    const int points = 8;
+
+    double d_lat = CGI_INTERSECTIONS_PREFETCH_RADIUS / WGS84::_a;
+    double d_lon = d_lat / std::max( 0.01, cos( lat ) );
+
+    for ( int i = 0; i <= points; i++ )
+    {
+        double lat_i = lat;
+        double lon_i = lon;
+
+        if ( i > 0 )
+        {
+            double psi = 2.0 * M_PI * ( i - 1 ) / (double)points;
+
+            lat_i += d_lat * cos( psi );
+            lon_i += d_lon * sin( psi );
+        }
+
+        osg::Vec3d b_wgs = WGS84( lat_i, lon_i, 10000.0 ).getPosition();
+        osg::Vec3d e_wgs = WGS84( lat_i, lon_i, -1000.0 ).getPosition();
+
+        group->addIntersector( new osgUtil::LineSegmentIntersector( b_wgs, e_wgs ) );
+    }
+
+    // missing tiles are only requested, so traversal never reads files
+    osgUtil::IntersectionVisitor iv( group.get(), _rc_prefetch.get() );
+    iv.setLODSelectionMode( osgUtil::IntersectionVisitor::USE_HIGHEST_LEVEL_OF_DETAIL );
+    iv.setTraversalMode( osgUtil::IntersectionVisitor::TRAVERSE_ACTIVE_CHILDREN );
+    _scenery->accept( iv );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -131,3 +244,98 @@ double Intersections::getElevation( double lat, double lon )
 
     return std::numeric_limits< double >::quiet_NaN();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::ref_ptr<osg::Node> Intersections::getTile( const std::string &filename, bool prefetch )
+{
+    {
+        std::lock_guard< std::mutex > lock( _tilesMutex );
+
+        Tiles::iterator it = _tiles.find( filename );
+
+        if ( it != _tiles.end() )
+        {
+            _recent.splice( _recent.begin(), _recent, it->second.recent );
+            return it->second.node;
+        }
+
+        if ( prefetch )
+        {
+            if ( _requested.insert( filename ).second )
+            {
+                _requests.push_back( filename );
+                _prefetchRequests++;
+                _tilesCond.notify_one();
+            }
+
+            return osg::ref_ptr<osg::Node>();
+        }
+    }
+
+    // tile which has not been prefetched is read in the calling thread,
+    // outside the lock, so the loading thread is not blocked
+    osg::ref_ptr<osg::Node> node = osgDB::readRefNodeFile( filename, _options.get() );
+
+    // missing files are cached as well, so they are not read again
+    {
+        std::lock_guard< std::mutex > lock( _tilesMutex );
+        insertTile( filename, node.get() );
+    }
+
+    return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::insertTile( const std::string &filename, osg::Node *node )
+{
+    Tiles::iterator it = _tiles.find( filename );
+
+    if ( it != _tiles.end() )
+    {
+        _recent.splice( _recent.begin(), _recent, it->second.recent );
+        return;
+    }
+
+    _recent.push_front( filename );
+
+    Tile tile;
+
+    tile.node   = node;
+    tile.recent = _recent.begin();
+
+    _tiles[ filename ] = tile;
+
+    while ( _tiles.size() > CGI_INTERSECTIONS_CACHE_SIZE )
+    {
+        _tiles.erase( _recent.back() );
+        _recent.pop_back();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::loadTiles()
+{
+    std::unique_lock< std::mutex > lock( _tilesMutex );
+
+    while ( !_quit )
+    {
+        if ( _requests.empty() )
+        {
+            _tilesCond.wait( lock );
+            continue;
+        }
+
+        std::string filename = _requests.front();
+        _requests.pop_front();
+
+        lock.unlock();
+        osg::ref_ptr<osg::Node> node = osgDB::readRefNodeFile( filename, _options.get() );
+        lock.lock();
+
+        insertTile( filename, node.get() );
+        _requested.erase( filename );
+    }
+}
@@ -24,10 +24,21 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
 #include <osg/Node>
 #include <osg/Vec3d>
 #include <osg/Version>
 
+#include <osgDB/Options>
+
 #include <osgUtil/IntersectionVisitor>
 
 #include <sim/Singleton.h>
@@ -39,6 +50,12 @@ namespace cgi
 
 /**
  * @brief Intersections class.
+ *
+ * Paged nodes (e.g. paged terrain tiles) traversed by queries are kept in
+ * a bounded least recently used cache of CGI_INTERSECTIONS_CACHE_SIZE
+ * tiles, so repeated queries never read the same file again. Tiles around
+ * the ownship are prefetched in the background, so queries issued from the
+ * flight dynamics model thread do not read files either.
  */
 class Intersections : public Singleton< Intersections >
 {
@@ -46,8 +63,29 @@ class Intersections : public Singleton< Intersections >
 
 public:
 
+    /** Intersection query segment. */
+    struct Segment
+    {
+        osg::Vec3d b;               ///< segment line beginning coordinates
+        osg::Vec3d e;               ///< segment line ending coordinates
+        osg::Vec3d r;               ///< intersection coordinates
+        osg::Vec3d n;               ///< intersection normal
+        bool hit;                   ///< specifies if intersection has been found
+    };
+
+    /**
+     * @brief Intersection visitor read callback.
+     * Paged nodes are read through the intersections tiles cache.
+     */
     struct ReadCallback : public osgUtil::IntersectionVisitor::ReadCallback
     {
+        /**
+         * @brief Constructor.
+         * @param prefetch specifies if missing tiles are only requested to be loaded in the background
+         */
+        ReadCallback( bool prefetch = false );
+
+        bool _prefetch;                         ///< specifies if missing tiles are only requested
 #       if OPENSCENEGRAPH_SOVERSION < 140
         virtual osg::Node* readNodeFile( const std::string& filename );
 #       else
@@ -73,6 +111,7 @@ public:
 
     /**
      * @brief Finds intersections.
+     * Might be called from multiple threads, queries are serialized.
      * @param b segement line beginning coordinates
      * @param e segement line ending coordinates
      * @param r intersection coordinates
@@ -82,9 +121,32 @@ public:
     bool findFirst( const osg::Vec3d &b, const osg::Vec3d &e,
                     osg::Vec3d &r, osg::Vec3d &n );
 
+    /**
+     * @brief Finds first intersections of multiple segments.
+     * All segments are tested in a single scenery traversal.
+     * Might be called from multiple threads, queries are serialized.
+     * @param segments segments array, results are written into
+     * @param count number of segments
+     * @return number of segments which intersect scenery
+     */
+    unsigned int findFirst( Segment *segments, unsigned int count );
+
     /** */
     double getElevation( double lat, double lon );
 
+    /**
+     * @brief Requests loading paged tiles around the given position.
+     * Scenery is traversed down to the highest level of detail along
+     * vertical segments around the position, missing tiles are loaded by
+     * the background thread, so later queries do not read files. Traversal
+     * is done after position changed by more than
+     * CGI_INTERSECTIONS_PREFETCH_STEP or requested tiles have been loaded.
+     * Should be called from the update traversal.
+     * @param lat [rad] latitude
+     * @param lon [rad] longitude
+     */
+    void prefetch( double lat, double lon );
+
     /** */
     inline void setScenery( osg::Node *scenery )
     {
@@ -93,11 +155,60 @@ public:
 
 private:
 
+    typedef std::list< std::string > Recent;
+
+    /** Cached tile. */
+    struct Tile
+    {
+        osg::ref_ptr<osg::Node> node;       ///< tile node
+        Recent::iterator recent;            ///< position on the recently used list
+    };
+
+    typedef std::map< std::string, Tile > Tiles;
+
     osg::ref_ptr<osg::Node> _scenery;
     osg::ref_ptr<ReadCallback> _rc;
+    osg::ref_ptr<ReadCallback> _rc_prefetch;
+
+    osg::ref_ptr<osgDB::Options> _options;  ///< reading options
+
+    std::mutex _mutex;                      ///< queries mutex
+
+    Tiles  _tiles;                          ///< cached tiles
+    Recent _recent;                         ///< cached tiles file names, most recently used first
+
+    std::deque< std::string > _requests;    ///< tiles requested to be loaded
+    std::set< std::string > _requested;     ///< tiles requested or being loaded
+
+    std::mutex _tilesMutex;                 ///< tiles cache and requests mutex
+    std::condition_variable _tilesCond;     ///< requests condition variable
+    std::thread _loader;                    ///< tiles loading thread
+
+    osg::Vec3d _prefetch_wgs;               ///< [m] last prefetch position
+
+    unsigned int _prefetchRequests;         ///< number of tiles requested by the last prefetch
+
+    bool _quit;                             ///< specifies if loading thread should quit
+    bool _prefetched;                       ///< specifies if prefetch has been done
+
+    /**
+     * @brief Returns tile from the cache.
+     * @param filename tile file name
+     * @param prefetch if true missing tile is requested to be loaded in the background, otherwise it is read
+     * @return tile node, null if tile is missing and has been requested
+     */
+    osg::ref_ptr<osg::Node> getTile( const std::string &filename, bool prefetch );
+
+    /**
+     * @brief Inserts tile into the cache, evicting least recently used ones.
+     * Tiles mutex has to be locked.
+     * @param filename tile file name
+     * @param node tile node, null if file cannot be read
+     */
+    void insertTile( const std::string &filename, osg::Node *node );
 
-//    osg::ref_ptr<osgUtil::IntersectionVisitor> _iv;
-//    osg::ref_ptr<osgUtil::IntersectorGroup>    _ig;
+    /** @brief Tiles loading thread function. */
+    void loadTiles();
 };
 
 } // end of cgi namespace
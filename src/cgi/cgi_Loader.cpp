@@ -0,0 +1,460 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_Loader.h>
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include <sys/stat.h>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+
+#include <osgDB/FileNameUtils>
+#include <osgDB/FileUtils>
+#include <osgDB/ReadFile>
+#include <osgDB/WriteFile>
+
+#include <osgUtil/Optimizer>
+#include <osgUtil/Simplifier>
+
+#include <fdm/utils/fdm_ThreadPlacement.h>
+
+#include <cgi/cgi_Defines.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/**
+ * Forbids operations which would remove or change named nodes, since these
+ * are looked up and animated (transforms) or toggled (switches) later on.
+ */
+class NamedNodesCallback : public osgUtil::Optimizer::IsOperationPermissibleForObjectCallback
+{
+public:
+
+    using osgUtil::Optimizer::IsOperationPermissibleForObjectCallback::isOperationPermissibleForObjectImplementation;
+
+    virtual bool isOperationPermissibleForObjectImplementation( const osgUtil::Optimizer *optimizer,
+                                                                const osg::Node *node,
+                                                                unsigned int option ) const
+    {
+        if ( !node->getName().empty() )
+        {
+            const unsigned int structural = osgUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
+                                          | osgUtil::Optimizer::REMOVE_REDUNDANT_NODES
+                                          | osgUtil::Optimizer::MERGE_GEODES;
+
+            if ( option & structural ) return false;
+        }
+
+        return optimizer->isOperationPermissibleForObjectImplementation( node, option );
+    }
+};
+
+/** Switches all geometries to vertex buffer objects. */
+class UseVBOVisitor : public osg::NodeVisitor
+{
+public:
+
+    UseVBOVisitor() :
+        osg::NodeVisitor( osg::NodeVisitor::TRAVERSE_ALL_CHILDREN )
+    {}
+
+    virtual void apply( osg::Geode &geode )
+    {
+        for ( unsigned int i = 0; i < geode.getNumDrawables(); i++ )
+        {
+            osg::Geometry *geometry = geode.getDrawable( i )->asGeometry();
+
+            if ( geometry )
+            {
+                geometry->setUseDisplayList( false );
+                geometry->setUseVertexBufferObjects( true );
+            }
+        }
+
+        traverse( geode );
+    }
+};
+
+#ifdef CGI_MODELS_OSGB_CACHE
+/** Returns true if target file exists and is not older than source file. */
+bool isUpToDate( const std::string &sourceFile, const std::string &targetFile )
+{
+    struct stat stSource;
+    struct stat stTarget;
+
+    if ( 0 != stat( targetFile.c_str(), &stTarget ) ) return false;
+    if ( 0 != stat( sourceFile.c_str(), &stSource ) ) return true;
+
+    return stTarget.st_mtime >= stSource.st_mtime;
+}
+
+/** Writes cache file. */
+void writeCache( const osg::Node &node, const std::string &sourceFile,
+                 const std::string &cacheFile )
+{
+    // written into temporary file first and then renamed, so other
+    // instances never read a partially written cache file
+    std::stringstream tempFile;
+    tempFile << sourceFile << "." << std::this_thread::get_id() << ".osgb";
+
+    if ( osgDB::writeNodeFile( node, tempFile.str() ) )
+    {
+        remove( cacheFile.c_str() );
+
+        if ( 0 != rename( tempFile.str().c_str(), cacheFile.c_str() ) )
+        {
+            remove( tempFile.str().c_str() );
+        }
+    }
+    else
+    {
+        Log::w() << "Cannot write file: " << cacheFile << std::endl;
+    }
+}
+#endif // CGI_MODELS_OSGB_CACHE
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+osgDB::ReaderWriter::ReadResult Loader::ReadFileCallback::readImage( const std::string &filename,
+                                                                     const osgDB::Options *options )
+{
+    if ( 0 != osgDB::getLowerCaseFileExtension( filename ).compare( "dds" ) )
+    {
+        std::string ddsFile = osgDB::findDataFile( osgDB::getNameLessExtension( filename ) + ".dds",
+                                                   options );
+
+        if ( !ddsFile.empty() )
+        {
+            osgDB::ReaderWriter::ReadResult result = osgDB::Registry::instance()->readImageImplementation( ddsFile, options );
+
+            if ( result.validImage() ) return result;
+        }
+    }
+
+    return osgDB::Registry::instance()->readImageImplementation( filename, options );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::init()
+{
+    osgDB::Registry::instance()->setReadFileCallback( new ReadFileCallback() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* Loader::readNode( const std::string &filePath, bool straight )
+{
+    osg::ref_ptr<osg::Node> node;
+
+    if ( straight )
+    {
+        node = osgDB::readNodeFile( filePath );
+        return node.release();
+    }
+
+#   ifdef CGI_MODELS_OSGB_CACHE
+    std::string cacheFile = filePath + ".osgb";
+
+    if ( isUpToDate( filePath, cacheFile ) )
+    {
+        node = osgDB::readNodeFile( cacheFile );
+
+        if ( node.valid() ) return node.release();
+    }
+#   endif // CGI_MODELS_OSGB_CACHE
+
+    node = osgDB::readNodeFile( filePath );
+
+    if ( node.valid() )
+    {
+        optimize( node.get() );
+
+#       ifdef CGI_MODELS_OSGB_CACHE
+        writeCache( *node, filePath, cacheFile );
+#       endif // CGI_MODELS_OSGB_CACHE
+    }
+
+    return node.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::optimize( osg::Node *node )
+{
+    osgUtil::Optimizer optimizer;
+    optimizer.setIsOperationPermissibleForObjectCallback( new NamedNodesCallback() );
+
+    // structure first, so geometries of flattened transforms and merged
+    // geodes might be merged afterwards
+    optimizer.optimize( node, osgUtil::Optimizer::STATIC_OBJECT_DETECTION
+                            | osgUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS
+                            | osgUtil::Optimizer::REMOVE_REDUNDANT_NODES
+                            | osgUtil::Optimizer::REMOVE_LOADED_PROXY_NODES
+                            | osgUtil::Optimizer::SHARE_DUPLICATE_STATE
+                            | osgUtil::Optimizer::MERGE_GEODES
+                            | osgUtil::Optimizer::MERGE_GEOMETRY
+                            | osgUtil::Optimizer::CHECK_GEOMETRY
+                            | osgUtil::Optimizer::INDEX_MESH
+                            | osgUtil::Optimizer::VERTEX_POSTTRANSFORM
+                            | osgUtil::Optimizer::VERTEX_PRETRANSFORM );
+
+    UseVBOVisitor useVBO;
+    node->accept( useVBO );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* Loader::simplify( const std::string &filePath, const osg::Node *node, float ratio )
+{
+    osg::ref_ptr<osg::Node> simplified;
+
+#   ifdef CGI_MODELS_OSGB_CACHE
+    std::stringstream cacheFile;
+    cacheFile << filePath << ".lod" << (int)floor( 100.0f * ratio + 0.5f ) << ".osgb";
+
+    if ( isUpToDate( filePath, cacheFile.str() ) )
+    {
+        simplified = osgDB::readNodeFile( cacheFile.str() );
+
+        if ( simplified.valid() ) return simplified.release();
+    }
+#   endif // CGI_MODELS_OSGB_CACHE
+
+    simplified = osg::clone( node, osg::CopyOp::DEEP_COPY_NODES
+                                 | osg::CopyOp::DEEP_COPY_DRAWABLES
+                                 | osg::CopyOp::DEEP_COPY_ARRAYS
+                                 | osg::CopyOp::DEEP_COPY_PRIMITIVES );
+
+    if ( simplified.valid() )
+    {
+        osgUtil::Simplifier simplifier( ratio );
+        simplified->accept( simplifier );
+
+#       ifdef CGI_MODELS_OSGB_CACHE
+        writeCache( *simplified, filePath, cacheFile.str() );
+#       endif // CGI_MODELS_OSGB_CACHE
+    }
+
+    return simplified.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Image* Loader::readImage( const std::string &filePath )
+{
+    osg::ref_ptr<osg::Image> image = osgDB::readImageFile( filePath );
+
+    return image.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::requestNode( const std::string &filePath, bool straight,
+                          osg::Group *placeholder,
+                          const osgDB::Options *options )
+{
+    Request request;
+
+    request.filePath    = filePath;
+    request.straight    = straight;
+    request.placeholder = placeholder;
+    request.options     = options;
+
+    instance()->push( request );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::requestImage( const std::string &filePath,
+                           osg::Texture2D *texture )
+{
+    Request request;
+
+    request.filePath = filePath;
+    request.straight = true;
+    request.texture  = texture;
+
+    instance()->push( request );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::update()
+{
+    std::deque< Request > done;
+
+    {
+        std::lock_guard< std::mutex > lock( instance()->_mutex );
+        done.swap( instance()->_done );
+    }
+
+    for ( std::deque< Request >::iterator it = done.begin(); it != done.end(); ++it )
+    {
+        if ( it->placeholder.valid() )
+        {
+            if ( it->node.valid() )
+            {
+                it->placeholder->addChild( it->node.get() );
+            }
+            else
+            {
+                Log::e() << "Cannot open file: " << it->filePath << std::endl;
+            }
+        }
+        else if ( it->texture.valid() )
+        {
+            if ( it->image.valid() )
+            {
+                it->texture->setImage( it->image.get() );
+            }
+            else
+            {
+                Log::e() << "Cannot open file: " << it->filePath << std::endl;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Loader::getPending()
+{
+    std::lock_guard< std::mutex > lock( instance()->_mutex );
+    return instance()->_queue.size() + instance()->_busy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Loader::Loader() :
+    _busy ( 0 ),
+    _quit ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Loader::~Loader()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _quit = true;
+        _queue.clear();
+    }
+
+    _condition.notify_all();
+
+    for ( unsigned int i = 0; i < _threads.size(); i++ )
+    {
+        if ( _threads[ i ].joinable() ) _threads[ i ].join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::push( const Request &request )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _queue.push_back( request );
+
+        // workers are started on the first request
+        while ( _threads.size() < CGI_LOADER_THREADS )
+        {
+            _threads.push_back( std::thread( &Loader::work, this ) );
+        }
+    }
+
+    _condition.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Loader::work()
+{
+    if ( !fdm::ThreadPlacement::apply( fdm::ThreadPlacement::Workers ) )
+    {
+        Log::w() << "Cannot set loader thread CPU affinity." << std::endl;
+    }
+
+    while ( true )
+    {
+        Request request;
+
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+
+            _condition.wait( lock, [ this ]() { return _quit || !_queue.empty(); } );
+
+            if ( _quit ) return;
+
+            request = _queue.front();
+            _queue.pop_front();
+
+            _busy++;
+        }
+
+        try
+        {
+            if ( request.placeholder.valid() && request.options.valid() )
+            {
+                request.node = osgDB::readNodeFile( request.filePath, request.options.get() );
+            }
+            else if ( request.placeholder.valid() )
+            {
+                request.node = readNode( request.filePath, request.straight );
+            }
+            else
+            {
+                request.image = readImage( request.filePath );
+            }
+        }
+        catch ( ... )
+        {
+            request.node  = 0;
+            request.image = 0;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+
+            _done.push_back( request );
+
+            _busy--;
+        }
+    }
+}
@@ -0,0 +1,207 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_LOADER_H
+#define CGI_LOADER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <osg/Group>
+#include <osg/Texture2D>
+
+#include <osgDB/Options>
+#include <osgDB/Registry>
+
+#include <sim/Singleton.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Models and textures files loader class.
+ *
+ * Files are read by the pool of worker threads. Results are handed over to
+ * the scene graph only by update() which should be called on the update
+ * traversal, so workers never touch nodes which are part of the scene graph.
+ * Models are attached to the placeholder group given with the request, images
+ * are set to the texture given with the request.
+ *
+ * Models (unless read straight) are optimized after reading. When
+ * CGI_MODELS_OSGB_CACHE is defined, optimized models are stored next to the
+ * source file as native binary (.osgb) files, which are read instead of the
+ * source files as long as they are up to date. The same applies to simplified
+ * models generated by simplify().
+ *
+ * Images (including these referenced by models) are read from compressed
+ * DDS variants ("<name>.dds" next to the source file) when they exist, see
+ * run_dds.sh for offline conversion.
+ */
+class Loader : public Singleton< Loader >
+{
+    friend class Singleton< Loader >;
+
+public:
+
+    /**
+     * @brief Read file callback preferring compressed DDS image variants.
+     */
+    class ReadFileCallback : public osgDB::Registry::ReadFileCallback
+    {
+    public:
+
+        /** Reads "<name>.dds" instead of the given image if it exists. */
+        virtual osgDB::ReaderWriter::ReadResult readImage( const std::string &filename,
+                                                           const osgDB::Options *options );
+    };
+
+    /**
+     * @brief Installs read file callback, should be called before any file is read.
+     */
+    static void init();
+
+    /**
+     * @brief Reads model file, uses and updates binary cache when enabled.
+     * @param filePath model file path
+     * @param straight specifies if model should be read as is, without cache
+     * @return model node or null on failure
+     */
+    static osg::Node* readNode( const std::string &filePath, bool straight = false );
+
+    /**
+     * @brief Optimizes model for rendering.
+     * Flattens static transforms, removes redundant nodes, shares duplicated
+     * state sets, merges geodes and geometries, indexes meshes and switches
+     * geometries to VBOs. Named nodes are neither removed nor flattened.
+     * @param node model node
+     */
+    static void optimize( osg::Node *node );
+
+    /**
+     * @brief Returns simplified copy of the model, uses and updates binary
+     * cache ("<file>.lod<percent>.osgb") when enabled.
+     * @param filePath model file path
+     * @param node model node
+     * @param ratio [-] sample ratio
+     * @return simplified model node or null on failure
+     */
+    static osg::Node* simplify( const std::string &filePath, const osg::Node *node, float ratio );
+
+    /**
+     * @brief Reads image file.
+     * @param filePath image file path
+     * @return image or null on failure
+     */
+    static osg::Image* readImage( const std::string &filePath );
+
+    /**
+     * @brief Requests model reading in the background.
+     * @param filePath model file path
+     * @param straight specifies if model should be read as is, without cache
+     * @param placeholder group the model will be attached to
+     * @param options reading options, if given model is read as is using them
+     */
+    static void requestNode( const std::string &filePath, bool straight,
+                             osg::Group *placeholder,
+                             const osgDB::Options *options = NULLPTR );
+
+    /**
+     * @brief Requests image reading in the background.
+     * @param filePath image file path
+     * @param texture texture the image will be set to
+     */
+    static void requestImage( const std::string &filePath,
+                              osg::Texture2D *texture );
+
+    /**
+     * @brief Hands over loaded files to the scene graph.
+     * Must be called from the thread which updates the scene graph.
+     */
+    static void update();
+
+    /** @return number of requests waiting or being processed */
+    static unsigned int getPending();
+
+private:
+
+    /** Loader request. */
+    struct Request
+    {
+        std::string filePath;                   ///< file path
+        bool straight;                          ///< specifies if model should be read as is
+
+        osg::ref_ptr<osg::Group>     placeholder;   ///< model placeholder (model requests)
+        osg::ref_ptr<osg::Texture2D> texture;       ///< texture (image requests)
+
+        osg::ref_ptr<const osgDB::Options> options; ///< reading options (model requests)
+
+        osg::ref_ptr<osg::Node>  node;          ///< loaded model
+        osg::ref_ptr<osg::Image> image;         ///< loaded image
+    };
+
+    std::vector< std::thread > _threads;    ///< worker threads
+
+    std::mutex _mutex;                      ///< queues mutex
+    std::condition_variable _condition;     ///< workers wake up condition
+
+    std::deque< Request > _queue;           ///< requests waiting for workers
+    std::deque< Request > _done;            ///< requests waiting for update()
+
+    unsigned int _busy;                     ///< number of requests being processed
+
+    bool _quit;                             ///< specifies if workers should quit
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to Loader class instance.
+     */
+    Loader();
+
+    /** Using this constructor is forbidden. */
+    Loader( const Loader & ) : Singleton< Loader >() {}
+
+public:
+
+    /** @brief Destructor, stops worker threads. */
+    virtual ~Loader();
+
+private:
+
+    /** Pushes request to the queue and starts workers if necessary. */
+    void push( const Request &request );
+
+    /** Worker thread function. */
+    void work();
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_LOADER_H
@@ -24,8 +24,19 @@
 
 #include <cgi/cgi_FindNode.h>
 #include <cgi/cgi_Intersections.h>
+#include <cgi/cgi_Loader.h>
+#include <cgi/cgi_Models.h>
+#include <cgi/cgi_Origin.h>
+#include <cgi/cgi_Textures.h>
 #include <cgi/cgi_WGS84.h>
 
+#include <fdm/utils/fdm_Profiler.h>
+#include <fdm/utils/fdm_Time.h>
+
+#ifdef SIM_CLUSTER_SYNC
+#   include <sim/ClusterSync.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
@@ -37,13 +48,19 @@ Manager::Manager() :
     _map ( NULLPTR ),
     _otw ( NULLPTR ),
 
-    _camera ( NULLPTR )
+    _camera ( NULLPTR ),
+
+    _deadReckoning ( NULLPTR )
 {
+    Loader::init();
+
     _hud = new HUD();
     _map = new Map();
     _otw = new OTW();
 
     _camera = new Camera();
+
+    _deadReckoning = new DeadReckoning();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -55,6 +72,8 @@ Manager::~Manager()
     DELPTR( _otw );
 
     DELPTR( _camera );
+
+    DELPTR( _deadReckoning );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -68,6 +87,8 @@ void Manager::updateHUD()
 
 void Manager::updateMap()
 {
+    Loader::update();
+
     _map->update();
 }
 
@@ -75,10 +96,66 @@ void Manager::updateMap()
 
 void Manager::updateOTW()
 {
+    FDM_PROFILE_FUNCTION();
+
+    Loader::update();
+
+    updateOwnship();
+
+    Origin::instance()->update( osg::Vec3d( Data::get()->cgi.ownship.pos_x_wgs,
+                                            Data::get()->cgi.ownship.pos_y_wgs,
+                                            Data::get()->cgi.ownship.pos_z_wgs ) );
+
     _otw->update();
 
     _camera->update();
     updateGround();
+
+    // scene references all the models and textures in use at this point
+    Models::trim();
+    Textures::trim();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::latchOTW()
+{
+    FDM_PROFILE_FUNCTION();
+
+#   ifdef SIM_CLUSTER_SYNC
+    syncOwnshipPose();
+#   else
+    _deadReckoning->latch( fdm::Time::get() );
+#   endif
+
+    setOwnshipPose();
+
+    if ( !_ownshipPat.valid() )
+    {
+        osg::ref_ptr<osg::Node> ownshipNode = FindNode::findFirst( _otw->getNode(), "Ownship" );
+
+        if ( ownshipNode.valid() && ownshipNode->getNumParents() > 0 )
+        {
+            _ownshipPat = dynamic_cast<osg::PositionAttitudeTransform*>( ownshipNode->getParent( 0 ) );
+        }
+    }
+
+    osg::ref_ptr<osg::PositionAttitudeTransform> ownshipPat;
+
+    if ( _ownshipPat.lock( ownshipPat ) )
+    {
+        // origin is not re-based here, scene is placed relative to the current one
+        ownshipPat->setAttitude( osg::Quat( Data::get()->cgi.ownship.att_ex_wgs,
+                                            Data::get()->cgi.ownship.att_ey_wgs,
+                                            Data::get()->cgi.ownship.att_ez_wgs,
+                                            Data::get()->cgi.ownship.att_e0_wgs ) );
+
+        ownshipPat->setPosition( Origin::toScene( osg::Vec3d( Data::get()->cgi.ownship.pos_x_wgs,
+                                                              Data::get()->cgi.ownship.pos_y_wgs,
+                                                              Data::get()->cgi.ownship.pos_z_wgs ) ) );
+    }
+
+    _camera->latch();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -154,6 +231,10 @@ void Manager::setMapScale( double scale )
 
 void Manager::updateGround()
 {
+    // paged tiles around the ownship are loaded ahead of ground queries
+    Intersections::instance()->prefetch( Data::get()->ownship.latitude,
+                                         Data::get()->ownship.longitude );
+
     WGS84 wgs_b( Data::get()->ownship.latitude, Data::get()->ownship.longitude, 10000.0 );
     WGS84 wgs_e( Data::get()->ownship.latitude, Data::get()->ownship.longitude, -1000.0 );
 
@@ -174,3 +255,90 @@ void Manager::updateGround()
         Data::get()->ground.n_z_wgs = n.z();
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::updateOwnship()
+{
+#   ifdef SIM_CLUSTER_SYNC
+    // slaves show master pose only, the late latch updates it
+    if ( ClusterSync::instance()->isOpen() && !ClusterSync::instance()->isMaster() ) return;
+#   endif
+
+    _deadReckoning->update( fdm::Time::get() );
+
+    setOwnshipPose();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::setOwnshipPose()
+{
+    Data::get()->cgi.ownship.pos_x_wgs = _deadReckoning->getPos_WGS().x();
+    Data::get()->cgi.ownship.pos_y_wgs = _deadReckoning->getPos_WGS().y();
+    Data::get()->cgi.ownship.pos_z_wgs = _deadReckoning->getPos_WGS().z();
+
+    Data::get()->cgi.ownship.att_e0_wgs = _deadReckoning->getAtt_WGS().e0();
+    Data::get()->cgi.ownship.att_ex_wgs = _deadReckoning->getAtt_WGS().ex();
+    Data::get()->cgi.ownship.att_ey_wgs = _deadReckoning->getAtt_WGS().ey();
+    Data::get()->cgi.ownship.att_ez_wgs = _deadReckoning->getAtt_WGS().ez();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_CLUSTER_SYNC
+void Manager::syncOwnshipPose()
+{
+    ClusterSync *cluster = ClusterSync::instance();
+
+    ClusterSync::Frame frame;
+
+    if ( cluster->isMaster() || !cluster->isOpen() )
+    {
+        frame.time     = fdm::Time::get();
+        frame.simTime  = Data::get()->ownship.time;
+        frame.timeCoef = Data::get()->timeCoef;
+
+        _deadReckoning->latch( frame.time );
+
+        const fdm::Vector3    &pos_wgs = _deadReckoning->getPos_WGS();
+        const fdm::Quaternion &att_wgs = _deadReckoning->getAtt_WGS();
+        const fdm::Vector3    &vel_bas = _deadReckoning->getVel_BAS();
+        const fdm::Vector3    &omg_bas = _deadReckoning->getOmg_BAS();
+
+        for ( int i = 0; i < 3; i++ )
+        {
+            frame.pos_wgs[ i ] = pos_wgs( i );
+            frame.vel_bas[ i ] = vel_bas( i );
+            frame.omg_bas[ i ] = omg_bas( i );
+        }
+
+        frame.att_wgs[ 0 ] = att_wgs.e0();
+        frame.att_wgs[ 1 ] = att_wgs.ex();
+        frame.att_wgs[ 2 ] = att_wgs.ey();
+        frame.att_wgs[ 3 ] = att_wgs.ez();
+
+        cluster->publish( &frame );
+    }
+    else
+    {
+        bool fresh = cluster->latch( &frame );
+
+        // nothing to show until the first master frame arrives
+        if ( frame.number == 0 ) return;
+
+        DeadReckoning::Frame drFrame;
+
+        drFrame.time = frame.time;
+
+        drFrame.pos_wgs = fdm::Vector3( frame.pos_wgs[ 0 ], frame.pos_wgs[ 1 ], frame.pos_wgs[ 2 ] );
+        drFrame.vel_bas = fdm::Vector3( frame.vel_bas[ 0 ], frame.vel_bas[ 1 ], frame.vel_bas[ 2 ] );
+        drFrame.omg_bas = fdm::Vector3( frame.omg_bas[ 0 ], frame.omg_bas[ 1 ], frame.omg_bas[ 2 ] );
+
+        drFrame.att_wgs = fdm::Quaternion( frame.att_wgs[ 0 ], frame.att_wgs[ 1 ],
+                                           frame.att_wgs[ 2 ], frame.att_wgs[ 3 ] );
+
+        _deadReckoning->latch( drFrame, fresh, fdm::Time::get(), frame.timeCoef );
+    }
+}
+#endif
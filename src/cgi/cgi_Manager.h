@@ -24,6 +24,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <osg/PositionAttitudeTransform>
+#include <osg/observer_ptr>
+
 #include <sim/Singleton.h>
 
 #include <cgi/hud/cgi_HUD.h>
@@ -31,6 +34,7 @@
 #include <cgi/otw/cgi_OTW.h>
 
 #include <cgi/cgi_Camera.h>
+#include <cgi/cgi_DeadReckoning.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -71,6 +75,16 @@ public:
     /** @brief Updates OTW. */
     void updateOTW();
 
+    /**
+     * @brief Late-latches ownship pose and camera manipulator.
+     * Should be called right before the OTW rendering traversals, after the
+     * view update. Ownship pose is updated from the most recent FDM frame,
+     * only ownship transform and camera manipulator are updated.
+     * If SIM_CLUSTER_SYNC is defined, master sends latched pose to slaves
+     * and slaves wait for the master pose instead.
+     */
+    void latchOTW();
+
     /** */
     inline osgGA::CameraManipulator* getCameraManipulator()
     {
@@ -147,8 +161,23 @@ private:
 
     Camera *_camera;            ///< camera object
 
+    DeadReckoning *_deadReckoning;  ///< ownship pose dead reckoning
+
+    osg::observer_ptr<osg::PositionAttitudeTransform> _ownshipPat;  ///< ownship transform updated by the late latch
+
     /** */
     void updateGround();
+
+    /** @brief Updates ownship pose at render time. */
+    void updateOwnship();
+
+    /** @brief Sets ownship data pose from dead reckoning. */
+    void setOwnshipPose();
+
+#   ifdef SIM_CLUSTER_SYNC
+    /** @brief Sends latched pose to slaves (master) or latches master pose (slave). */
+    void syncOwnshipPose();
+#   endif
 };
 
 } // end of cgi namespace
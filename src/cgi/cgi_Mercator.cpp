@@ -21,6 +21,11 @@
  ******************************************************************************/
 
 #include <cgi/cgi_Mercator.h>
+
+#include <vector>
+
+#include <fdm/utils/fdm_Simd.h>
+
 #include <cgi/cgi_WGS84.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +34,40 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+/** Sine series coefficients, error below 1.0e-15 for |x| <= pi/2. */
+const double sinCoefs[] =
+{
+     1.0,
+    -1.0 / 6.0,
+     1.0 / 120.0,
+    -1.0 / 5040.0,
+     1.0 / 362880.0,
+    -1.0 / 39916800.0,
+     1.0 / 6227020800.0,
+    -1.0 / 1307674368000.0,
+     1.0 / 355687428096000.0,
+    -1.0 / 121645100408832000.0
+};
+
+/** Inverse hyperbolic tangent series coefficients, error below 1.0e-17 for |x| <= e. */
+const double atanhCoefs[] =
+{
+    1.0,
+    1.0 / 3.0,
+    1.0 / 5.0,
+    1.0 / 7.0,
+    1.0 / 9.0,
+    1.0 / 11.0,
+    1.0 / 13.0
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 const double Mercator::_max_x = Mercator::x( osg::DegreesToRadians( 180.0 ) );
 const double Mercator::_max_y = Mercator::y( osg::DegreesToRadians(  85.0 ) );
 
@@ -66,6 +105,45 @@ double Mercator::y( double lat )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Mercator::x( unsigned int n, const double *lon, double *x )
+{
+    // for lat_ts=0 k0=a
+    for ( unsigned int i = 0; i < n; i++ )
+    {
+        x[ i ] = WGS84::_a * lon[ i ];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Mercator::y( unsigned int n, const double *lat, double *y )
+{
+    if ( n == 0 ) return;
+
+    // ln( t( lat ) ) = atanh( sin( lat ) ) - e * atanh( e * sin( lat ) )
+    std::vector< double > sinLat( n );
+    std::vector< double > e_sinLat( n );
+    std::vector< double > atanh_e( n );
+
+    fdm::Simd::polyOdd( n, lat, sinCoefs, sizeof( sinCoefs ) / sizeof( double ), &sinLat[ 0 ] );
+
+    for ( unsigned int i = 0; i < n; i++ )
+    {
+        e_sinLat[ i ] = WGS84::_e * sinLat[ i ];
+    }
+
+    fdm::Simd::polyOdd( n, &e_sinLat[ 0 ], atanhCoefs, sizeof( atanhCoefs ) / sizeof( double ), &atanh_e[ 0 ] );
+
+    // for lat_ts=0 k0=a
+    for ( unsigned int i = 0; i < n; i++ )
+    {
+        double atanh_s = 0.5 * log( ( 1.0 + sinLat[ i ] ) / ( 1.0 - sinLat[ i ] ) );
+        y[ i ] = WGS84::_a * ( atanh_s - WGS84::_e * atanh_e[ i ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 double Mercator::k0( double lat_ts )
 {
     double sinLat = sin( lat_ts );
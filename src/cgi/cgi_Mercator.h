@@ -70,6 +70,25 @@ public:
      */
     static double y( double lat );
 
+    /**
+     * @brief Computes Mercator x-coordinates of array of points.
+     * @param n number of points
+     * @param lon [rad] geodetic longitudes array
+     * @param x [m] resulting Mercator x-coordinates array
+     */
+    static void x( unsigned int n, const double *lon, double *x );
+
+    /**
+     * @brief Computes Mercator y-coordinates of array of points.
+     * Latitude sine and ellipsoid eccentricity term are evaluated as SIMD
+     * truncated series, results differ from y( double ) by less than
+     * 1.0e-6 m up to latitude 85 deg.
+     * @param n number of points
+     * @param lat [rad] geodetic latitudes array
+     * @param y [m] resulting Mercator y-coordinates array
+     */
+    static void y( unsigned int n, const double *lat, double *y );
+
     /**
      * @brief Computes ellipsoid parallel radius.
      * @param lat_ts [rad] geodetic latitude of true scale
@@ -26,7 +26,11 @@
 #include <osg/Geometry>
 #include <osg/LineWidth>
 
-#include <osgDB/ReadFile>
+#include <fdm/utils/fdm_MemoryStats.h>
+
+#include <cgi/cgi_DataSize.h>
+#include <cgi/cgi_Defines.h>
+#include <cgi/cgi_Loader.h>
 
 #include <sim/Log.h>
 #include <sim/Path.h>
@@ -37,23 +41,61 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::Node* Models::get( const char *objectFile, bool straight )
+namespace
+{
+
+/**
+ * @brief Visitor indexing named nodes, nodes of the same name are stored
+ * in the traversal order, so the first one is the one FindNode finds first.
+ */
+class IndexNodes : public osg::NodeVisitor
 {
-    for ( unsigned int i = 0; i < instance()->_fileNames.size(); i++ )
+public:
+
+    typedef std::unordered_map< std::string, FindNode::Nodes > NodesIndex;
+
+    IndexNodes( NodesIndex *index ) :
+        osg::NodeVisitor( TRAVERSE_ALL_CHILDREN ),
+        _index ( index )
+    {}
+
+    virtual void apply( osg::Node &node )
     {
-        if ( objectFile == instance()->_fileNames.at( i ) )
+        if ( !node.getName().empty() )
         {
-            return instance()->_objects.at( i );
+            (*_index)[ node.getName() ].push_back( &node );
         }
+
+        traverse( node );
+    }
+
+private:
+
+    NodesIndex *_index;     ///< nodes index
+};
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* Models::get( const char *objectFile, bool straight )
+{
+    Objects::iterator it = instance()->_objects.find( objectFile );
+
+    if ( it != instance()->_objects.end() )
+    {
+        it->second.used = ++instance()->_tick;
+        return it->second.node.get();
     }
 
     std::string filePath = Path::get( objectFile );
-    osg::ref_ptr<osg::Node> object = ( straight ) ? osgDB::readNodeFile( filePath ) : readNodeFile( filePath );
+    osg::ref_ptr<osg::Node> object = Loader::readNode( filePath, straight );
 
     if ( object.valid() )
     {
-        instance()->_objects.push_back( object.get() );
-        instance()->_fileNames.push_back( objectFile );
+        add( &instance()->_objects, objectFile, object.get() );
+
+        updateIndex( object.get() );
 
         return object.get();
     }
@@ -67,19 +109,213 @@ osg::Node* Models::get( const char *objectFile, bool straight )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+osg::Node* Models::getAsync( const char *objectFile, bool straight )
+{
+    Objects::iterator it = instance()->_objects.find( objectFile );
+
+    if ( it != instance()->_objects.end() )
+    {
+        it->second.used = ++instance()->_tick;
+        return it->second.node.get();
+    }
+
+    osg::ref_ptr<osg::Group> placeholder = new osg::Group();
+    placeholder->setName( objectFile );
+
+    add( &instance()->_objects, objectFile, placeholder.get() );
+
+    Loader::requestNode( Path::get( objectFile ), straight, placeholder.get() );
+
+    return placeholder.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* Models::getSimplified( const char *objectFile )
+{
+    Objects::iterator it = instance()->_simplified.find( objectFile );
+
+    if ( it != instance()->_simplified.end() )
+    {
+        it->second.used = ++instance()->_tick;
+        return it->second.node.get();
+    }
+
+    Objects::iterator object = instance()->_objects.find( objectFile );
+
+    // placeholder of the model being read has no valid bound
+    if ( object != instance()->_objects.end() && object->second.node->getBound().valid() )
+    {
+        osg::ref_ptr<osg::Node> simplified = Loader::simplify( Path::get( objectFile ),
+                                                               object->second.node.get(),
+                                                               CGI_MODELS_LOD_RATIO );
+
+        if ( simplified.valid() )
+        {
+            add( &instance()->_simplified, objectFile, simplified.get() );
+        }
+
+        return simplified.release();
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 osg::Node* Models::readNodeFile( std::string objectFile )
 {
-    osg::ref_ptr<osg::Node> object = osgDB::readNodeFile( objectFile );
+    return Loader::readNode( objectFile );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Node* Models::findFirst( osg::Node *node, const char *name )
+{
+    Indices::iterator it = instance()->_indices.find( node );
+
+    if ( it != instance()->_indices.end() && name[ 0 ] != '\0' )
+    {
+        NodesIndex::iterator found = it->second.find( name );
+
+        if ( found != it->second.end() )
+        {
+            return found->second.front().get();
+        }
+
+        return 0;
+    }
+
+    return FindNode::findFirst( node, name );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+FindNode::Nodes Models::findNodes( osg::Node *node, const char *name )
+{
+    Indices::iterator it = instance()->_indices.find( node );
+
+    if ( it != instance()->_indices.end() && name[ 0 ] != '\0' )
+    {
+        NodesIndex::iterator found = it->second.find( name );
+
+        if ( found != it->second.end() )
+        {
+            return found->second;
+        }
 
-    return object.release();
+        return FindNode::Nodes();
+    }
+
+    return FindNode::findNodes( node, name );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Models::Models()
+void Models::updateIndex( osg::Node *model )
+{
+    if ( model )
+    {
+        NodesIndex &index = instance()->_indices[ model ];
+        index.clear();
+
+        IndexNodes indexNodes( &index );
+        model->accept( indexNodes );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Models::trim()
+{
+    Models *models = instance();
+
+    // placeholders of models read in the background are accounted when filled
+    if ( models->_unsized > 0 )
+    {
+        for ( Objects::iterator it = models->_objects.begin(); it != models->_objects.end(); ++it )
+        {
+            osg::Group *group = it->second.node->asGroup();
+
+            if ( it->second.bytes == 0 && group && group->getNumChildren() > 0 )
+            {
+                it->second.bytes = DataSize::get( it->second.node.get() );
+                fdm::MemoryStats::allocate( models->_memoryId, it->second.bytes );
+                models->_unsized--;
+            }
+        }
+    }
+
+    while ( fdm::MemoryStats::isOverBudget( models->_memoryId ) )
+    {
+        Objects *objects = NULLPTR;
+        Objects::iterator lru;
+
+        // model referenced only by the cache is no longer used
+        Objects *lists[] = { &models->_objects, &models->_simplified };
+
+        for ( unsigned int i = 0; i < 2; i++ )
+        {
+            for ( Objects::iterator it = lists[ i ]->begin(); it != lists[ i ]->end(); ++it )
+            {
+                if ( it->second.node->referenceCount() == 1 && it->second.bytes > 0
+                  && ( objects == NULLPTR || it->second.used < lru->second.used ) )
+                {
+                    objects = lists[ i ];
+                    lru = it;
+                }
+            }
+        }
+
+        if ( objects == NULLPTR ) break;
+
+        remove( objects, lru );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Models::add( Objects *objects, const char *objectFile, osg::Node *node )
+{
+    Entry &entry = (*objects)[ objectFile ];
+
+    entry.node  = node;
+    entry.bytes = node->getBound().valid() ? DataSize::get( node ) : 0;
+    entry.used  = ++instance()->_tick;
+
+    if ( entry.bytes > 0 )
+    {
+        fdm::MemoryStats::allocate( instance()->_memoryId, entry.bytes );
+    }
+    else if ( objects == &instance()->_objects )
+    {
+        instance()->_unsized++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Models::remove( Objects *objects, Objects::iterator it )
+{
+    fdm::MemoryStats::release( instance()->_memoryId, it->second.bytes );
+
+    instance()->_indices.erase( it->second.node.get() );
+
+    objects->erase( it );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Models::Models() :
+    _tick ( 0 ),
+    _unsized ( 0 )
 {
-    _fileNames.clear();
     _objects.clear();
+    _simplified.clear();
+    _indices.clear();
+
+    _memoryId = fdm::MemoryStats::add( "cgi.models" );
+    fdm::MemoryStats::setBudget( _memoryId, (fdm::UInt64)CGI_MODELS_BUDGET * 1024 * 1024 );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
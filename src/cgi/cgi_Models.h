@@ -24,9 +24,17 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <string>
+#include <unordered_map>
+
 #include <osg/LOD>
 #include <osg/NodeVisitor>
 
+#include <fdm/fdm_Types.h>
+
+#include <cgi/cgi_FindNode.h>
+
 #include <sim/Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +44,16 @@ namespace cgi
 
 /**
  * @brief 3D models container class.
+ *
+ * Names of nodes of models read by get() are indexed when the model is read,
+ * so nodes of these models are looked up without traversing whole subgraph.
+ *
+ * Simplified models (to be used as lower levels of detail) are generated once
+ * per model file, see Loader::simplify().
+ *
+ * Models data sizes are accounted as "cgi.models" memory subsystem. If
+ * CGI_MODELS_BUDGET is not 0, least recently used models which are no longer
+ * used by the scene are evicted when budget is exceeded.
  */
 class Models : public Singleton< Models >
 {
@@ -52,9 +70,61 @@ public:
      */
     static osg::Node* get( const char *objectFile, bool straight = false );
 
+    /**
+     * @brief Returns model placeholder group, model is read in the background.
+     * Model is attached to the returned group as soon as it is read, so it
+     * shouldn't be used for models which nodes are looked up right away.
+     * @param objectFile model file
+     * @param straight specifies if model should be read as is
+     * @return model placeholder group
+     */
+    static osg::Node* getAsync( const char *objectFile, bool straight = false );
+
+    /**
+     * @brief Returns simplified model (sampled by CGI_MODELS_LOD_RATIO).
+     * Simplified model is static, named nodes of the model are not indexed.
+     * @param objectFile model file, model has to be read by get() or getAsync()
+     * @return simplified model or null if model has not been read yet
+     */
+    static osg::Node* getSimplified( const char *objectFile );
+
     /** Reads object from file. */
     static osg::Node* readNodeFile( std::string objectFile );
 
+    /**
+     * @brief Returns first node of the given name.
+     * Nodes names index is used if node is a model read by get(), otherwise
+     * node subgraph is traversed.
+     * @param node model or subgraph root node
+     * @param name node name
+     * @return first found node or null if there is no such node
+     */
+    static osg::Node* findFirst( osg::Node *node, const char *name );
+
+    /**
+     * @brief Returns all nodes of the given name.
+     * Nodes names index is used if node is a model read by get(), otherwise
+     * node subgraph is traversed.
+     * @param node model or subgraph root node
+     * @param name node name
+     * @return found nodes list
+     */
+    static FindNode::Nodes findNodes( osg::Node *node, const char *name );
+
+    /**
+     * @brief Rebuilds nodes names index of model which subgraph was modified.
+     * @param model model read by get()
+     */
+    static void updateIndex( osg::Node *model );
+
+    /**
+     * @brief Updates sizes of models read in the background and evicts
+     * least recently used unused models while budget is exceeded.
+     * Should be called between frames only, as model returned by get()
+     * but not yet referenced by the scene might be evicted.
+     */
+    static void trim();
+
 private:
 
     /**
@@ -73,8 +143,33 @@ public:
 
 private:
 
-    List _objects;                          ///< objects list
-    std::vector< std::string > _fileNames;  ///< file names
+    /** Cached model. */
+    struct Entry
+    {
+        osg::ref_ptr<osg::Node> node;       ///< model node
+        fdm::UInt64 bytes;                  ///< [B] accounted data size
+        fdm::UInt64 used;                   ///< last use tick
+    };
+
+    typedef std::map< std::string, Entry > Objects;
+    typedef std::unordered_map< std::string, FindNode::Nodes > NodesIndex;
+    typedef std::map< const osg::Node*, NodesIndex > Indices;
+
+    Objects _objects;                       ///< objects indexed by file names
+    Objects _simplified;                    ///< simplified objects indexed by file names
+    Indices _indices;                       ///< models nodes indexed by names
+
+    fdm::UInt64 _tick;                      ///< use tick
+
+    unsigned int _unsized;                  ///< number of models being read
+
+    int _memoryId;                          ///< memory subsystem ID
+
+    /** Adds model to the cache. */
+    static void add( Objects *objects, const char *objectFile, osg::Node *node );
+
+    /** Removes model from the cache. */
+    static void remove( Objects *objects, Objects::iterator it );
 };
 
 } // end of cgi namespace
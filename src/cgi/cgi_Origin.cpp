@@ -0,0 +1,56 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_Origin.h>
+
+#include <cgi/cgi_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Origin::Origin() :
+    _valid ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Origin::~Origin() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Origin::update( const osg::Vec3d &pos_wgs )
+{
+    const double dist2 = CGI_ORIGIN_REBASE_DISTANCE * CGI_ORIGIN_REBASE_DISTANCE;
+
+    _shift = osg::Vec3d();
+
+    if ( !_valid || ( pos_wgs - _pos_wgs ).length2() > dist2 )
+    {
+        if ( _valid ) _shift = pos_wgs - _pos_wgs;
+
+        _pos_wgs = pos_wgs;
+        _valid = true;
+    }
+}
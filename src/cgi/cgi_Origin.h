@@ -0,0 +1,123 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_ORIGIN_H
+#define CGI_ORIGIN_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <osg/Vec3d>
+
+#include <sim/Singleton.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief OTW scene floating origin class.
+ *
+ * OTW modules place their nodes relative to the origin instead of the WGS
+ * center, so scene transforms and camera matrices near the viewer do not
+ * hold Earth radius magnitude translations. Origin is re-based to the ownship
+ * position as soon as ownship gets farther than CGI_ORIGIN_REBASE_DISTANCE.
+ */
+class Origin : public Singleton< Origin >
+{
+    friend class Singleton< Origin >;
+
+public:
+
+    /**
+     * @brief Returns origin position expressed in WGS.
+     * @return [m] origin position expressed in WGS
+     */
+    static inline const osg::Vec3d& getPosition()
+    {
+        return instance()->_pos_wgs;
+    }
+
+    /**
+     * @brief Returns origin displacement of the last update.
+     * @return [m] origin displacement expressed in WGS, zero if origin was not re-based
+     */
+    static inline const osg::Vec3d& getShift()
+    {
+        return instance()->_shift;
+    }
+
+    /**
+     * @brief Converts position expressed in WGS to scene coordinates.
+     * @param pos_wgs [m] position expressed in WGS
+     * @return [m] position relative to the origin
+     */
+    static inline osg::Vec3d toScene( const osg::Vec3d &pos_wgs )
+    {
+        return pos_wgs - instance()->_pos_wgs;
+    }
+
+    /**
+     * @brief Converts scene coordinates to position expressed in WGS.
+     * @param pos_scene [m] position relative to the origin
+     * @return [m] position expressed in WGS
+     */
+    static inline osg::Vec3d toWGS( const osg::Vec3d &pos_scene )
+    {
+        return pos_scene + instance()->_pos_wgs;
+    }
+
+private:
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to Origin class instance.
+     */
+    Origin();
+
+    /** Using this constructor is forbidden. */
+    Origin( const Origin & ) : Singleton< Origin >() {}
+
+public:
+
+    /** @brief Destructor. */
+    virtual ~Origin();
+
+    /**
+     * @brief Updates origin, re-bases it if ownship is too far from it.
+     * Should be called before OTW modules are updated.
+     * @param pos_wgs [m] ownship position expressed in WGS
+     */
+    void update( const osg::Vec3d &pos_wgs );
+
+private:
+
+    osg::Vec3d _pos_wgs;    ///< [m] origin position expressed in WGS
+    osg::Vec3d _shift;      ///< [m] origin displacement of the last update
+
+    bool _valid;            ///< specifies if origin has been set
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_ORIGIN_H
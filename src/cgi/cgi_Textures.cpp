@@ -22,7 +22,11 @@
 
 #include <cgi/cgi_Textures.h>
 
-#include <osgDB/ReadFile>
+#include <fdm/utils/fdm_MemoryStats.h>
+
+#include <cgi/cgi_DataSize.h>
+#include <cgi/cgi_Defines.h>
+#include <cgi/cgi_Loader.h>
 
 #include <sim/Log.h>
 #include <sim/Path.h>
@@ -36,53 +40,149 @@ using namespace cgi;
 osg::Texture2D* Textures::get( const char *textureFile, float maxAnisotropy,
                                osg::Texture::WrapMode mode )
 {
-    for ( unsigned int i = 0; i < instance()->_fileNames.size(); i++ )
+    Objects::iterator it = instance()->_textures.find( textureFile );
+
+    if ( it != instance()->_textures.end() )
     {
-        if ( textureFile == instance()->_fileNames.at( i ) )
-        {
-            instance()->_textures.at( i )->setMaxAnisotropy( maxAnisotropy );
-            return instance()->_textures.at( i );
-        }
+        it->second.used = ++instance()->_tick;
+        it->second.texture->setMaxAnisotropy( maxAnisotropy );
+        return it->second.texture.get();
     }
 
     std::string filePath = Path::get( textureFile );
-    osg::ref_ptr<osg::Image> image = osgDB::readImageFile( filePath );
+    osg::ref_ptr<osg::Image> image = Loader::readImage( filePath );
 
     if ( image.valid() )
     {
-        osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D();
+        osg::ref_ptr<osg::Texture2D> texture = create( maxAnisotropy, mode );
         texture->setImage( image.get() );
 
-        texture->setWrap( osg::Texture2D::WRAP_S, mode );
-        texture->setWrap( osg::Texture2D::WRAP_T, mode );
+        add( textureFile, texture.get() );
 
-        texture->setNumMipmapLevels( 4 );
-        texture->setMaxAnisotropy( maxAnisotropy );
+        return texture.get();
+    }
+    else
+    {
+        Log::e() << "Cannot open file: " << filePath << std::endl;
+    }
 
-        texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR_MIPMAP_NEAREST );
-        texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+    return 0;
+}
 
-        texture->setUnRefImageDataAfterApply( false );
+////////////////////////////////////////////////////////////////////////////////
 
-        instance()->_textures.push_back( texture.get() );
-        instance()->_fileNames.push_back( textureFile );
+osg::Texture2D* Textures::getAsync( const char *textureFile, float maxAnisotropy,
+                                    osg::Texture::WrapMode mode )
+{
+    Objects::iterator it = instance()->_textures.find( textureFile );
 
-        return texture.get();
+    if ( it != instance()->_textures.end() )
+    {
+        it->second.used = ++instance()->_tick;
+        it->second.texture->setMaxAnisotropy( maxAnisotropy );
+        return it->second.texture.get();
+    }
+
+    osg::ref_ptr<osg::Texture2D> texture = create( maxAnisotropy, mode );
+
+    add( textureFile, texture.get() );
+
+    Loader::requestImage( Path::get( textureFile ), texture.get() );
+
+    return texture.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Textures::trim()
+{
+    Textures *textures = instance();
+
+    // images of textures read in the background are accounted when ready
+    if ( textures->_unsized > 0 )
+    {
+        for ( Objects::iterator it = textures->_textures.begin(); it != textures->_textures.end(); ++it )
+        {
+            if ( it->second.bytes == 0 && it->second.texture->getImage() )
+            {
+                it->second.bytes = DataSize::get( it->second.texture->getImage() );
+                fdm::MemoryStats::allocate( textures->_memoryId, it->second.bytes );
+                textures->_unsized--;
+            }
+        }
+    }
+
+    while ( fdm::MemoryStats::isOverBudget( textures->_memoryId ) )
+    {
+        Objects::iterator lru = textures->_textures.end();
+
+        // texture referenced only by the cache is no longer used
+        for ( Objects::iterator it = textures->_textures.begin(); it != textures->_textures.end(); ++it )
+        {
+            if ( it->second.texture->referenceCount() == 1 && it->second.bytes > 0
+              && ( lru == textures->_textures.end() || it->second.used < lru->second.used ) )
+            {
+                lru = it;
+            }
+        }
+
+        if ( lru == textures->_textures.end() ) break;
+
+        fdm::MemoryStats::release( textures->_memoryId, lru->second.bytes );
+        textures->_textures.erase( lru );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Textures::add( const char *textureFile, osg::Texture2D *texture )
+{
+    Entry &entry = instance()->_textures[ textureFile ];
+
+    entry.texture = texture;
+    entry.bytes   = DataSize::get( texture->getImage() );
+    entry.used    = ++instance()->_tick;
+
+    if ( entry.bytes > 0 )
+    {
+        fdm::MemoryStats::allocate( instance()->_memoryId, entry.bytes );
     }
     else
     {
-        Log::e() << "Cannot open file: " << filePath << std::endl;
+        instance()->_unsized++;
     }
+}
 
-    return 0;
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Texture2D* Textures::create( float maxAnisotropy, osg::Texture::WrapMode mode )
+{
+    osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D();
+
+    texture->setWrap( osg::Texture2D::WRAP_S, mode );
+    texture->setWrap( osg::Texture2D::WRAP_T, mode );
+
+    texture->setNumMipmapLevels( 4 );
+    texture->setMaxAnisotropy( maxAnisotropy );
+
+    texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR_MIPMAP_NEAREST );
+    texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+    texture->setUnRefImageDataAfterApply( false );
+
+    return texture.release();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Textures::Textures()
+Textures::Textures() :
+    _tick ( 0 ),
+    _unsized ( 0 )
 {
-    _fileNames.clear();
     _textures.clear();
+
+    _memoryId = fdm::MemoryStats::add( "cgi.textures" );
+    fdm::MemoryStats::setBudget( _memoryId, (fdm::UInt64)CGI_TEXTURES_BUDGET * 1024 * 1024 );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,8 +24,13 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <string>
+
 #include <osg/Texture2D>
 
+#include <fdm/fdm_Types.h>
+
 #include <sim/Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +40,10 @@ namespace cgi
 
 /**
  * @brief Textures container class.
+ *
+ * Textures images sizes are accounted as "cgi.textures" memory subsystem.
+ * If CGI_TEXTURES_BUDGET is not 0, least recently used textures which are
+ * no longer used by the scene are evicted when budget is exceeded.
  */
 class Textures : public Singleton< Textures >
 {
@@ -48,6 +57,21 @@ public:
     static osg::Texture2D* get( const char *textureFile, float maxAnisotropy = 1.0f,
                                 osg::Texture::WrapMode mode = osg::Texture::MIRROR );
 
+    /**
+     * @brief Returns texture which image is read in the background.
+     * Texture has no image until it is read.
+     */
+    static osg::Texture2D* getAsync( const char *textureFile, float maxAnisotropy = 1.0f,
+                                     osg::Texture::WrapMode mode = osg::Texture::MIRROR );
+
+    /**
+     * @brief Updates sizes of textures read in the background and evicts
+     * least recently used unused textures while budget is exceeded.
+     * Should be called between frames only, as texture returned by get()
+     * but not yet referenced by the scene might be evicted.
+     */
+    static void trim();
+
 private:
 
     /**
@@ -66,8 +90,29 @@ public:
 
 private:
 
-    List _textures;                         ///<
-    std::vector< std::string > _fileNames;  ///<
+    /** Cached texture. */
+    struct Entry
+    {
+        osg::ref_ptr<osg::Texture2D> texture;   ///< texture
+        fdm::UInt64 bytes;                      ///< [B] accounted image size
+        fdm::UInt64 used;                       ///< last use tick
+    };
+
+    typedef std::map< std::string, Entry > Objects;
+
+    Objects _textures;                      ///< textures indexed by file names
+
+    fdm::UInt64 _tick;                      ///< use tick
+
+    unsigned int _unsized;                  ///< number of textures which images are being read
+
+    int _memoryId;                          ///< memory subsystem ID
+
+    /** Adds texture to the cache. */
+    static void add( const char *textureFile, osg::Texture2D *texture );
+
+    /** Creates texture with default parameters. */
+    static osg::Texture2D* create( float maxAnisotropy, osg::Texture::WrapMode mode );
 };
 
 } // end of cgi namespace
@@ -0,0 +1,194 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <cgi/cgi_Trace.h>
+
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace cgi;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Trace::Trace( unsigned int chunkSize, unsigned int maxChunks,
+              float minSpacing, float maxSpacing, float maxAngle ) :
+    _chunkSize ( chunkSize > 2 ? chunkSize : 2 ),
+    _maxChunks ( maxChunks > 1 ? maxChunks : 1 ),
+    _minSpacing2 ( minSpacing * minSpacing ),
+    _maxSpacing2 ( maxSpacing * maxSpacing ),
+    _minCosAngle ( cos( maxAngle ) )
+{
+    _geode = new osg::Geode();
+    _geode->setDataVariance( osg::Object::DYNAMIC );
+
+    _colors = new osg::Vec4Array();
+    _colors->push_back( osg::Vec4( 0.0f, 0.0f, 0.0f, 1.0f ) );
+
+    _lineWidth = new osg::LineWidth();
+    _lineWidth->setWidth( 1.0f );
+
+    _geode->getOrCreateStateSet()->setAttributeAndModes( _lineWidth.get(), osg::StateAttribute::ON );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Trace::~Trace() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::addPoint( const osg::Vec3 &point )
+{
+    if ( _chunks.size() > 0 )
+    {
+        if ( ( point - _last ).length2() < _minSpacing2 ) return;
+
+        Chunk &chunk = _chunks.back();
+
+        // the first vertex of a chunk is shared with the previous one
+        if ( chunk.count > 1 )
+        {
+            osg::Vec3 prev = (*chunk.vertices)[ chunk.count - 2 ];
+
+            osg::Vec3 dir_0 = _last - prev;
+            osg::Vec3 dir_1 = point - _last;
+
+            float len2_0 = dir_0.length2();
+            float len2_1 = dir_1.length2();
+
+            if ( len2_0 > 0.0f && ( point - prev ).length2() < _maxSpacing2
+              && dir_0 * dir_1 > _minCosAngle * sqrt( len2_0 * len2_1 ) )
+            {
+                chunk.count--;
+            }
+        }
+    }
+
+    if ( _chunks.size() == 0 || _chunks.back().count == _chunkSize )
+    {
+        addChunk();
+    }
+
+    Chunk &chunk = _chunks.back();
+
+    (*chunk.vertices)[ chunk.count ] = point;
+    chunk.count++;
+
+    // only the current chunk buffer is uploaded
+    chunk.vertices->dirty();
+    chunk.drawArrays->setCount( chunk.count );
+    chunk.drawArrays->dirty();
+    chunk.geometry->dirtyBound();
+
+    _last = point;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::clear()
+{
+    while ( _chunks.size() > 0 )
+    {
+        _geode->removeDrawable( _chunks.front().geometry.get() );
+        _spare.push_back( _chunks.front() );
+        _chunks.pop_front();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::setColor( const osg::Vec3 &color )
+{
+    (*_colors)[ 0 ] = osg::Vec4( color, 1.0f );
+    _colors->dirty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::setLineWidth( float width )
+{
+    _lineWidth->setWidth( width );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::addChunk()
+{
+    Chunk chunk;
+
+    if ( _chunks.size() >= _maxChunks )
+    {
+        // retiring the oldest chunk
+        chunk = _chunks.front();
+        _chunks.pop_front();
+        _geode->removeDrawable( chunk.geometry.get() );
+    }
+    else if ( _spare.size() > 0 )
+    {
+        chunk = _spare.back();
+        _spare.pop_back();
+    }
+    else
+    {
+        createChunk( &chunk );
+    }
+
+    chunk.count = 0;
+
+    // new chunk starts with the last point of the previous one to keep line continuous
+    if ( _chunks.size() > 0 )
+    {
+        (*chunk.vertices)[ 0 ] = _last;
+        chunk.count = 1;
+    }
+
+    chunk.drawArrays->setCount( chunk.count );
+
+    _geode->addDrawable( chunk.geometry.get() );
+    _chunks.push_back( chunk );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Trace::createChunk( Chunk *chunk )
+{
+    chunk->geometry   = new osg::Geometry();
+    chunk->vertices   = new osg::Vec3Array( _chunkSize );
+    chunk->drawArrays = new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, 0 );
+    chunk->count = 0;
+
+    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
+    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
+
+    chunk->vertices->setDataVariance( osg::Object::DYNAMIC );
+
+    chunk->geometry->setDataVariance( osg::Object::DYNAMIC );
+    chunk->geometry->setUseDisplayList( false );
+    chunk->geometry->setUseVertexBufferObjects( true );
+
+    chunk->geometry->setVertexArray( chunk->vertices.get() );
+    chunk->geometry->addPrimitiveSet( chunk->drawArrays.get() );
+    chunk->geometry->setNormalArray( n.get() );
+    chunk->geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
+    chunk->geometry->setColorArray( _colors.get() );
+    chunk->geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+}
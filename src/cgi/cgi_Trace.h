@@ -0,0 +1,126 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CGI_TRACE_H
+#define CGI_TRACE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <vector>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/LineWidth>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cgi
+{
+
+/**
+ * @brief Trace line class.
+ *
+ * Trace is made of fixed-size line strip chunks used as a circular buffer.
+ * Points are written in place into the current chunk, so only this chunk
+ * vertex buffer is dirtied when a point is added. When chunks count reaches
+ * its limit, the oldest chunk is retired and reused, so trace length and per
+ * frame cost are bounded regardless of flight duration.
+ *
+ * Points are decimated when added: a point closer than minimum spacing to
+ * the previous one is dropped, and a point extending the last segment in
+ * nearly the same direction moves the segment end instead of being
+ * appended, unless segment would exceed maximum spacing.
+ */
+class Trace
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param chunkSize number of points in a single chunk
+     * @param maxChunks maximum number of chunks
+     * @param minSpacing minimum distance between consecutive points
+     * @param maxSpacing maximum length of a segment merged with the next point
+     * @param maxAngle [rad] maximum direction change of a merged segment
+     */
+    Trace( unsigned int chunkSize, unsigned int maxChunks,
+           float minSpacing, float maxSpacing, float maxAngle );
+
+    /** @brief Destructor. */
+    virtual ~Trace();
+
+    /**
+     * @brief Adds point to the trace.
+     * @param point [m] point coordinates
+     */
+    void addPoint( const osg::Vec3 &point );
+
+    /** @brief Removes all points. */
+    void clear();
+
+    /** @brief Sets trace color. */
+    void setColor( const osg::Vec3 &color );
+
+    /** @brief Sets trace line width. */
+    void setLineWidth( float width );
+
+    /** @brief Returns trace OSG node. */
+    inline osg::Geode* getNode() { return _geode.get(); }
+
+private:
+
+    /** Trace chunk. */
+    struct Chunk
+    {
+        osg::ref_ptr<osg::Geometry>   geometry;     ///< chunk geometry
+        osg::ref_ptr<osg::Vec3Array>  vertices;     ///< preallocated vertices
+        osg::ref_ptr<osg::DrawArrays> drawArrays;   ///< line strip primitive
+        unsigned int count;                         ///< number of points
+    };
+
+    typedef std::deque< Chunk > Chunks;
+
+    osg::ref_ptr<osg::Geode> _geode;        ///< trace geode
+    osg::ref_ptr<osg::Vec4Array> _colors;   ///< shared color array
+    osg::ref_ptr<osg::LineWidth> _lineWidth;///< line width
+
+    Chunks _chunks;                         ///< active chunks, the newest is the last one
+    std::vector< Chunk > _spare;            ///< retired chunks ready to be reused
+
+    const unsigned int _chunkSize;          ///< number of points in a single chunk
+    const unsigned int _maxChunks;          ///< maximum number of chunks
+
+    const float _minSpacing2;               ///< minimum distance between consecutive points squared
+    const float _maxSpacing2;               ///< maximum length of a merged segment squared
+    const float _minCosAngle;               ///< cosine of maximum direction change of a merged segment
+
+    osg::Vec3 _last;                        ///< last point
+
+    void addChunk();
+    void createChunk( Chunk *chunk );
+};
+
+} // end of cgi namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CGI_TRACE_H
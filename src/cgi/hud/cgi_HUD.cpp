@@ -73,6 +73,19 @@ HUD::HUD() :
 
     createStall();
 
+    // texts are modified at runtime, which multi-threaded viewer must know
+    osg::Geode *texts[] = { _airspeed.get(), _altitude.get(), _machNo.get(),
+                            _climbRate.get(), _heading.get(), _gForce.get(),
+                            _radioAlt.get() };
+
+    for ( unsigned int i = 0; i < sizeof(texts) / sizeof(texts[ 0 ]); i++ )
+    {
+        for ( unsigned int j = 0; j < texts[ i ]->getNumDrawables(); j++ )
+        {
+            texts[ i ]->getDrawable( j )->setDataVariance( osg::Object::DYNAMIC );
+        }
+    }
+
     osg::ref_ptr<osg::StateSet> stateSet = _root->getOrCreateStateSet();
 
     stateSet->setMode( GL_RESCALE_NORMAL , osg::StateAttribute::ON  );
@@ -893,6 +906,8 @@ void HUD::createTextR()
         text->setAlignment( osgText::Text::RIGHT_CENTER );
         text->setText( "RA 9999" );
         _radioAlt->addDrawable( text );
+
+        _radioAltStr = "RA 9999";
     }
 }
 
@@ -1128,8 +1143,6 @@ void HUD::updatePitchLadder()
 
 void HUD::updateHeadingScale()
 {
-    osg::ref_ptr<osgText::Text> text;
-
     float head_deg = osg::RadiansToDegrees( Data::get()->cgi.hud.heading );
 
     short head_ind = floor( ( ( ( head_deg < 180.0f ) ? 360.0f : 0.0f ) + head_deg ) / 5.0 + 0.5 );
@@ -1149,14 +1162,9 @@ void HUD::updateHeadingScale()
     float x = ( 100.0f / 50.0f ) * ( ( head_deg < 180.0f ) ? head_deg : head_deg - 360.0f );
     _patHeadingScale->setPosition( osg::Vec3( -x, 0.0, 0.0 ) );
 
-    text = dynamic_cast< osgText::Text* >( _heading->getDrawable( 0 ) );
-
-    if ( text.valid() )
-    {
-        char heading_str[256];
-        sprintf( heading_str, "%d", (int)( floor( head_deg + 0.5 ) ) );
-        text->setText( heading_str );
-    }
+    char heading_str[256];
+    sprintf( heading_str, "%d", (int)( floor( head_deg + 0.5 ) ) );
+    setText( _heading.get(), &_headingStr, heading_str );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1230,87 +1238,67 @@ void HUD::updateStall()
 
 void HUD::updateTextL()
 {
-    osg::ref_ptr<osgText::Text> text;
-
     // airspeed
-    text = dynamic_cast< osgText::Text* >( _airspeed->getDrawable( 0 ) );
+    float airspeed = Data::get()->cgi.hud.airspeed * Data::get()->cgi.hud.factor_vel;
 
-    if ( text.valid() )
-    {
-        float airspeed = Data::get()->cgi.hud.airspeed * Data::get()->cgi.hud.factor_vel;
-
-        char airspeed_str[256];
-        sprintf( airspeed_str, "%d", (int)( floor( airspeed + 0.5 ) ) );
-        text->setText( airspeed_str );
-    }
+    char airspeed_str[256];
+    sprintf( airspeed_str, "%d", (int)( floor( airspeed + 0.5 ) ) );
+    setText( _airspeed.get(), &_airspeedStr, airspeed_str );
 
     // Mach no
-    text = dynamic_cast< osgText::Text* >( _machNo->getDrawable( 0 ) );
-
-    if ( text.valid() )
-    {
-        char machNo_str[256];
-        sprintf( machNo_str, "M %.2f", Data::get()->cgi.hud.machNumber );
-        text->setText( machNo_str );
-    }
+    char machNo_str[256];
+    sprintf( machNo_str, "M %.2f", Data::get()->cgi.hud.machNumber );
+    setText( _machNo.get(), &_machNoStr, machNo_str );
 
     // G-Force
-    text = dynamic_cast< osgText::Text* >( _gForce->getDrawable( 0 ) );
-
-    if ( text.valid() )
-    {
-        char gForce_str[256];
-        sprintf( gForce_str, "%.1fG", Data::get()->cgi.hud.g_force );
-        text->setText( gForce_str );
-    }
+    char gForce_str[256];
+    sprintf( gForce_str, "%.1fG", Data::get()->cgi.hud.g_force );
+    setText( _gForce.get(), &_gForceStr, gForce_str );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void HUD::updateTextR()
 {
-    osg::ref_ptr<osgText::Text> text;
-
     // altitude
-    text = dynamic_cast< osgText::Text* >( _altitude->getDrawable( 0 ) );
-
-    if ( text.valid() )
-    {
-        float altitude = Data::get()->cgi.hud.altitude * Data::get()->cgi.hud.factor_alt;
+    float altitude = Data::get()->cgi.hud.altitude * Data::get()->cgi.hud.factor_alt;
 
-        char altitude_str[256];
-        sprintf( altitude_str, "%d", (int)( floor( altitude + 0.5 ) ) );
-        text->setText( altitude_str );
-    }
+    char altitude_str[256];
+    sprintf( altitude_str, "%d", (int)( floor( altitude + 0.5 ) ) );
+    setText( _altitude.get(), &_altitudeStr, altitude_str );
 
     // climb rate
-    text = dynamic_cast< osgText::Text* >( _climbRate->getDrawable( 0 ) );
+    float climbRate = 60.0f * Data::get()->cgi.hud.climbRate * Data::get()->cgi.hud.factor_alt;
 
-    if ( text.valid() )
-    {
-        float climbRate = 60.0f * Data::get()->cgi.hud.climbRate * Data::get()->cgi.hud.factor_alt;
+    char climbRate_str[256];
+    sprintf( climbRate_str, "%d", (int)( floor( climbRate + 0.5 ) ) );
+    setText( _climbRate.get(), &_climbRateStr, climbRate_str );
+
+    // radio altitude
+    float radioAlt = Data::get()->cgi.hud.radioAlt * Data::get()->cgi.hud.factor_alt;
 
-        char climbRate_str[256];
-        sprintf( climbRate_str, "%d", (int)( floor( climbRate + 0.5 ) ) );
-        text->setText( climbRate_str );
+    char radioAlt_str[256] = "";
+
+    if ( radioAlt < 3000.0 )
+    {
+        sprintf( radioAlt_str, "RA %d", (int)( floor( radioAlt + 0.5 ) ) );
     }
 
-    // radio altitude
-    text = dynamic_cast< osgText::Text* >( _radioAlt->getDrawable( 0 ) );
+    setText( _radioAlt.get(), &_radioAltStr, radioAlt_str );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HUD::setText( osg::Geode *geode, std::string *cache, const char *str )
+{
+    // text layout is rebuilt only when displayed value changes
+    if ( 0 == cache->compare( str ) ) return;
+
+    osg::ref_ptr<osgText::Text> text = dynamic_cast< osgText::Text* >( geode->getDrawable( 0 ) );
 
     if ( text.valid() )
     {
-        float altitude = Data::get()->cgi.hud.radioAlt * Data::get()->cgi.hud.factor_alt;
-
-        if ( altitude < 3000.0 )
-        {
-            char altitude_str[256];
-            sprintf( altitude_str, "RA %d", (int)( floor( altitude + 0.5 ) ) );
-            text->setText( altitude_str );
-        }
-        else
-        {
-            text->setText( "" );
-        }
+        text->setText( str );
+        *cache = str;
     }
 }
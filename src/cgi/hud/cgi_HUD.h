@@ -98,6 +98,14 @@ private:
 
     std::vector< osg::ref_ptr<osgText::Text> > _texts;
 
+    std::string _airspeedStr;       ///< displayed airspeed text
+    std::string _altitudeStr;       ///< displayed altitude text
+    std::string _machNoStr;         ///< displayed Mach number text
+    std::string _climbRateStr;      ///< displayed climb rate text
+    std::string _headingStr;        ///< displayed heading text
+    std::string _gForceStr;         ///< displayed G-force text
+    std::string _radioAltStr;       ///< displayed radio altitude text
+
     osg::Vec4 _color;
 
     float _sideslipAngleFPM_deg;
@@ -135,6 +143,9 @@ private:
 
     void updateTextL();
     void updateTextR();
+
+    /** Sets geode text if it differs from the displayed one. */
+    void setText( osg::Geode *geode, std::string *cache, const char *str );
 };
 
 } // end of cgi namespace
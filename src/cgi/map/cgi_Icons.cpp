@@ -22,11 +22,19 @@
 
 #include <cgi/map/cgi_Icons.h>
 
+#include <algorithm>
+
 #include <osg/LineWidth>
 #include <osg/Material>
+#include <osg/Program>
+#include <osg/Shader>
+#include <osg/VertexAttribDivisor>
+
+#include <osgUtil/CullVisitor>
 
 #include <Data.h>
 
+#include <cgi/cgi_CollisionMesh.h>
 #include <cgi/cgi_Geometry.h>
 #include <cgi/cgi_Mercator.h>
 #include <cgi/cgi_Models.h>
@@ -34,8 +42,6 @@
 
 #include <cgi/map/cgi_Map.h>
 
-#include <fdm/utils/fdm_WGS84.h>
-
 #include <nav/nav_DataBase.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -44,25 +50,141 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+/** Computes Mercator coordinates of positions given as latitudes and longitudes arrays. */
+void getMercator( const std::vector< double > &lat, const std::vector< double > &lon,
+                  std::vector< double > *x, std::vector< double > *y )
+{
+    x->resize( lon.size() );
+    y->resize( lat.size() );
+
+    if ( lat.size() > 0 )
+    {
+        Mercator::x( lon.size(), &lon[ 0 ], &(*x)[ 0 ] );
+        Mercator::y( lat.size(), &lat[ 0 ], &(*y)[ 0 ] );
+    }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char Icons::_frag[] =
+    "uniform vec4 iconColor;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   gl_FragColor = iconColor;\n"
+    "}\n"
+    "\n";
+
+const char Icons::_vert[] =
+    "attribute vec4 instancePos;\n"
+    "attribute vec2 instanceSize;\n"
+    "\n"
+    "uniform float iconScale;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   // symbol is scaled, rotated clockwise by heading and translated\n"
+    "   vec2 v = gl_Vertex.xy * instanceSize * iconScale;\n"
+    "   float sinHdg = sin( instancePos.w );\n"
+    "   float cosHdg = cos( instancePos.w );\n"
+    "   vec4 p = vec4( instancePos.x + cosHdg * v.x + sinHdg * v.y,\n"
+    "                  instancePos.y - sinHdg * v.x + cosHdg * v.y,\n"
+    "                  instancePos.z + gl_Vertex.z, 1.0 );\n"
+    "\n"
+    "   gl_Position = gl_ModelViewProjectionMatrix * p;\n"
+    "}\n"
+    "\n";
+
+const double Icons::_iconSize = 1.5e6;
+
+const unsigned int Icons::_attribPos  = 6;
+const unsigned int Icons::_attribSize = 7;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Icons::ViewCallback::ViewCallback() :
+    left   ( 0.0 ),
+    right  ( 0.0 ),
+    bottom ( 0.0 ),
+    top    ( 0.0 ),
+    valid  ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Icons::ViewCallback::operator()( osg::Node *node, osg::NodeVisitor *nv )
+{
+    osgUtil::CullVisitor *cv = dynamic_cast< osgUtil::CullVisitor* >( nv );
+
+    if ( cv )
+    {
+        osg::Matrixd mvp = (*cv->getModelViewMatrix()) * (*cv->getProjectionMatrix());
+        osg::Matrixd inv;
+
+        if ( inv.invert( mvp ) )
+        {
+            // map camera is orthographic, so clip volume corners are view extents
+            osg::Vec3d p0 = osg::Vec3d( -1.0, -1.0, 0.0 ) * inv;
+            osg::Vec3d p1 = osg::Vec3d(  1.0,  1.0, 0.0 ) * inv;
+
+            left   = std::min( p0.x(), p1.x() );
+            right  = std::max( p0.x(), p1.x() );
+            bottom = std::min( p0.y(), p1.y() );
+            top    = std::max( p0.y(), p1.y() );
+
+            valid = true;
+        }
+    }
+
+    traverse( node, nv );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Icons::Icons( const Module *parent ) :
-    Module( parent )
+    Module( parent ),
+
+    _scale      ( 1.0 ),
+    _lastLeft   ( 0.0 ),
+    _lastRight  ( 0.0 ),
+    _lastBottom ( 0.0 ),
+    _lastTop    ( 0.0 ),
+    _lastScale  ( 0.0 )
 {
-    _symbolAerodrome    = Models::get( "map/icons/aerodrome.stl" );
-    _symbolNavaidVOR    = Models::get( "map/icons/vor.stl" );
-    _symbolNavaidVORTAC = Models::get( "map/icons/vortac.stl" );
-    _symbolNavaidVORDME = Models::get( "map/icons/vor_dme.stl" );
-    _symbolNavaidILSLOC = createSymbolILS();
+    _instances.resize( SymbolsCount );
 
-    osg::ref_ptr<osg::Material> material = new osg::Material();
+    _iconScale = new osg::Uniform( "iconScale", 1.0f );
 
-    material->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
-    material->setAmbient( osg::Material::FRONT, osg::Vec4( Map::_colorAeroData, 1.0f ) );
-    material->setDiffuse( osg::Material::FRONT, osg::Vec4( Map::_colorAeroData, 1.0f ) );
+    // instanced symbols are spread all over the map, view extents are
+    // recorded even if ownship is out of the view
+    _viewCallback = new ViewCallback();
+    _root->setCullCallback( _viewCallback.get() );
+    _root->setCullingActive( false );
 
-    _symbolAerodrome    ->getOrCreateStateSet()->setAttribute( material.get() );
-    _symbolNavaidVOR    ->getOrCreateStateSet()->setAttribute( material.get() );
-    _symbolNavaidVORTAC ->getOrCreateStateSet()->setAttribute( material.get() );
-    _symbolNavaidVORDME ->getOrCreateStateSet()->setAttribute( material.get() );
+    osg::ref_ptr<osg::Group> symbols = new osg::Group();
+    _root->addChild( symbols.get() );
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
+    program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
+    program->addBindAttribLocation( "instancePos"  , _attribPos  );
+    program->addBindAttribLocation( "instanceSize" , _attribSize );
+
+    osg::ref_ptr<osg::StateSet> stateSet = symbols->getOrCreateStateSet();
+    stateSet->setAttributeAndModes( program.get() );
+    stateSet->setMode( GL_LIGHTING, osg::StateAttribute::OFF );
+
+    createInstances( symbols.get(), Aerodrome    , Models::get( "map/icons/aerodrome.stl" ) , Map::_colorAeroData );
+    createInstances( symbols.get(), NavaidVOR    , Models::get( "map/icons/vor.stl" )       , Map::_colorAeroData );
+    createInstances( symbols.get(), NavaidVORTAC , Models::get( "map/icons/vortac.stl" )    , Map::_colorAeroData );
+    createInstances( symbols.get(), NavaidVORDME , Models::get( "map/icons/vor_dme.stl" )   , Map::_colorAeroData );
+    createInstances( symbols.get(), Localizer    , createSymbolILS()    , Map::_colorAeroData , false );
+    createInstances( symbols.get(), Runway       , createSymbolRunway() , Map::_colorAirports , false );
 
     createOwnship();
 
@@ -83,26 +205,21 @@ Icons::~Icons() {}
 void Icons::update()
 {
     updateOwnship();
+    updateInstances();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::setScale( double scale )
 {
-    double s = 1.5 * 1.0e6 * scale;
+    _scale = scale;
+
+    double s = _iconSize * scale;
     osg::Vec3d sv( s, s, 1.0 );
 
     _ownship.pat->setScale( sv );
 
-    for ( PATs::iterator it = _aerodromes.begin(); it != _aerodromes.end(); ++it )
-    {
-        (*it)->setScale( sv );
-    }
-
-    for ( PATs::iterator it = _navaids.begin(); it != _navaids.end(); ++it )
-    {
-        (*it)->setScale( sv );
-    }
+    _iconScale->set( static_cast< float >( s ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,52 +279,85 @@ void Icons::createOwnship()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::Node* Icons::createRunway( double length, double width )
+void Icons::createInstances( osg::Group *parent, Symbol symbol, osg::Geometry *geometry,
+                             const osg::Vec3 &color, bool scaled )
 {
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    Instances &instances = _instances[ symbol ];
 
-    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();
+    instances.geode = new osg::Geode();
+    instances.geode->addDrawable( geometry );
+    instances.geode->setCullingActive( false );
+    instances.geode->setNodeMask( 0 );
+    parent->addChild( instances.geode.get() );
 
-    c->push_back( osg::Vec4( Map::_colorAirports, 1.0f ) );
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
+    instances.geometry  = geometry;
+    instances.drawnPos  = new osg::Vec4Array();
+    instances.drawnSize = new osg::Vec2Array();
 
-    osg::ref_ptr<osg::Geometry> geom = new osg::Geometry();
+    instances.radius = 0.0;
+    instances.scaled = scaled;
 
-    geode->addDrawable( geom.get() );
+    const osg::Vec3Array *v = dynamic_cast< const osg::Vec3Array* >( geometry->getVertexArray() );
 
-    v->push_back( osg::Vec3( -width / 2.0, -length / 2.0, 0.0 ) );
-    v->push_back( osg::Vec3(  width / 2.0, -length / 2.0, 0.0 ) );
-    v->push_back( osg::Vec3(  width / 2.0,  length / 2.0, 0.0 ) );
-    v->push_back( osg::Vec3( -width / 2.0,  length / 2.0, 0.0 ) );
+    if ( v )
+    {
+        for ( osg::Vec3Array::const_iterator it = v->begin(); it != v->end(); ++it )
+        {
+            instances.radius = std::max( instances.radius, (double)osg::Vec2( it->x(), it->y() ).length() );
+        }
+    }
 
-    geom->setVertexArray( v.get() );
-    geom->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::QUADS, 0, v->size() ) );
-    geom->setNormalArray( n.get() );
-    geom->setNormalBinding( osg::Geometry::BIND_OVERALL );
-    geom->setColorArray( c.get() );
-    geom->setColorBinding( osg::Geometry::BIND_OVERALL );
+    // per-instance arrays are advanced once per instance by attribute divisors
+    geometry->setUseDisplayList( false );
+    geometry->setUseVertexBufferObjects( true );
+    geometry->setVertexAttribArray( _attribPos  , instances.drawnPos.get()  , osg::Array::BIND_PER_VERTEX );
+    geometry->setVertexAttribArray( _attribSize , instances.drawnSize.get() , osg::Array::BIND_PER_VERTEX );
+
+    osg::ref_ptr<osg::StateSet> stateSet = instances.geode->getOrCreateStateSet();
 
-    return geode.release();
+    stateSet->setAttribute( new osg::VertexAttribDivisor( _attribPos  , 1 ) );
+    stateSet->setAttribute( new osg::VertexAttribDivisor( _attribSize , 1 ) );
+
+    stateSet->addUniform( new osg::Uniform( "iconColor", osg::Vec4( color, 1.0f ) ) );
+    stateSet->addUniform( scaled ? _iconScale.get() : new osg::Uniform( "iconScale", 1.0f ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::Node* Icons::createSymbolILS()
+void Icons::createInstances( osg::Group *parent, Symbol symbol, osg::Node *model,
+                             const osg::Vec3 &color, bool scaled )
 {
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    std::vector< fdm::Vector3 > vertices;
+    std::vector< fdm::UInt32 > indices;
+
+    if ( model )
+    {
+        CollisionMesh::collect( model, &vertices, &indices );
+    }
 
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();
 
-    c->push_back( osg::Vec4( Map::_colorAeroData, 1.0f ) );
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
+    // collected triangles do not share vertices
+    for ( unsigned int i = 0; i < vertices.size(); i++ )
+    {
+        v->push_back( osg::Vec3( vertices[ i ].x(), vertices[ i ].y(), vertices[ i ].z() ) );
+    }
 
-    osg::ref_ptr<osg::Geometry> geom = new osg::Geometry();
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
 
-    geode->addDrawable( geom.get() );
+    geometry->setVertexArray( v.get() );
+    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLES, 0, v->size() ) );
+
+    createInstances( parent, symbol, geometry.get(), color, scaled );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Geometry* Icons::createSymbolILS()
+{
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
+
+    osg::ref_ptr<osg::Geometry> geom = new osg::Geometry();
 
     v->push_back( osg::Vec3(    0.0f,      0.0f, 0.0f ) );
     v->push_back( osg::Vec3(    0.0f, -10500.0f, 0.0f ) );
@@ -218,48 +368,75 @@ osg::Node* Icons::createSymbolILS()
 
     geom->setVertexArray( v.get() );
     geom->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, v->size() ) );
-    geom->setNormalArray( n.get() );
-    geom->setNormalBinding( osg::Geometry::BIND_OVERALL );
-    geom->setColorArray( c.get() );
-    geom->setColorBinding( osg::Geometry::BIND_OVERALL );
 
-    return geode.release();
+    return geom.release();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-osg::Node* Icons::getNavaidSymbol( int type )
+osg::Geometry* Icons::createSymbolRunway()
+{
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
+
+    osg::ref_ptr<osg::Geometry> geom = new osg::Geometry();
+
+    // unit size, scaled by per-instance width and length
+    v->push_back( osg::Vec3( -0.5f, -0.5f, 0.0f ) );
+    v->push_back( osg::Vec3(  0.5f, -0.5f, 0.0f ) );
+    v->push_back( osg::Vec3(  0.5f,  0.5f, 0.0f ) );
+    v->push_back( osg::Vec3( -0.5f,  0.5f, 0.0f ) );
+
+    geom->setVertexArray( v.get() );
+    geom->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::QUADS, 0, v->size() ) );
+
+    return geom.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Icons::Symbol Icons::getNavaidSymbol( int type )
 {
     switch ( type )
     {
-        case nav::DataBase::NAV::VOR:     return _symbolNavaidVOR.get();
-        case nav::DataBase::NAV::VORTAC:  return _symbolNavaidVORTAC.get();
-//        case nav::DataBase::NAV::TACAN:   return _symbolNavaidTACAN.get();
-        case nav::DataBase::NAV::VOR_DME: return _symbolNavaidVORDME.get();
-//        case nav::DataBase::NAV::NDB:     return _symbolNavaidNDB.get();
-//        case nav::DataBase::NAV::NDB_DME: return _symbolNavaidNDB_DME.get();
-//        case nav::DataBase::NAV::LOCATOR: return _symbolNavaidLOCATOR.get();
-//        case nav::DataBase::NAV::DME:     return _symbolNavaidDME.get();
+        case nav::DataBase::NAV::VOR:     return NavaidVOR;
+        case nav::DataBase::NAV::VORTAC:  return NavaidVORTAC;
+//        case nav::DataBase::NAV::TACAN:   return NavaidTACAN;
+        case nav::DataBase::NAV::VOR_DME: return NavaidVORDME;
+//        case nav::DataBase::NAV::NDB:     return NavaidNDB;
+//        case nav::DataBase::NAV::NDB_DME: return NavaidNDB_DME;
+//        case nav::DataBase::NAV::LOCATOR: return NavaidLOCATOR;
+//        case nav::DataBase::NAV::DME:     return NavaidDME;
     }
 
-    return _symbolNavaidVOR.get();;
+    return NavaidVOR;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::initAerodromes()
 {
-    nav::DataBase::ListAPT list = nav::DataBase::instance()->getListAPT();
+    const nav::DataBase::ListAPT &list = nav::DataBase::instance()->getListAPT();
+
+    std::vector< double > lat( list.size() );
+    std::vector< double > lon( list.size() );
 
-    for ( nav::DataBase::ListAPT::iterator it = list.begin(); it != list.end(); ++it )
+    for ( unsigned int i = 0; i < list.size(); i++ )
     {
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _root->addChild( pat.get() );
-        pat->addChild( _symbolAerodrome.get() );
-        pat->setPosition( osg::Vec3d(  Mercator::x( (*it).lon ),
-                                       Mercator::y( (*it).lat ),
-                                       Map::_zAerodromes ) );
-        _aerodromes.push_back( pat.get() );
+        lat[ i ] = list[ i ].lat;
+        lon[ i ] = list[ i ].lon;
+    }
+
+    std::vector< double > x;
+    std::vector< double > y;
+
+    getMercator( lat, lon, &x, &y );
+
+    Instances &instances = _instances[ Aerodrome ];
+
+    for ( unsigned int i = 0; i < list.size(); i++ )
+    {
+        instances.pos.push_back( osg::Vec4d( x[ i ], y[ i ], Map::_zAerodromes, 0.0 ) );
+        instances.size.push_back( osg::Vec2( 1.0f, 1.0f ) );
     }
 }
 
@@ -267,39 +444,62 @@ void Icons::initAerodromes()
 
 void Icons::initLocalizers()
 {
-    nav::DataBase::ListILS listILS = nav::DataBase::instance()->getListILS();
+    const nav::DataBase::ListILS &listILS = nav::DataBase::instance()->getListILS();
+
+    std::vector< double > lat;
+    std::vector< double > lon;
+    std::vector< double > bearing;
 
-    for ( nav::DataBase::ListILS::iterator it = listILS.begin(); it != listILS.end(); ++it )
+    for ( nav::DataBase::ListILS::const_iterator it = listILS.begin(); it != listILS.end(); ++it )
     {
         if ( (*it).type == nav::DataBase::ILS::LOC )
         {
-            osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-            _root->addChild( pat.get() );
-            pat->addChild( _symbolNavaidILSLOC.get() );
-            pat->setPosition( osg::Vec3d(  Mercator::x( (*it).lon ),
-                                           Mercator::y( (*it).lat ),
-                                           Map::_zNavaids ) );
-            pat->setAttitude( osg::Quat( -(*it).true_bearing, osg::Z_AXIS ) );
-            _localizers.push_back( pat.get() );
+            lat.push_back( (*it).lat );
+            lon.push_back( (*it).lon );
+            bearing.push_back( (*it).true_bearing );
         }
     }
+
+    std::vector< double > x;
+    std::vector< double > y;
+
+    getMercator( lat, lon, &x, &y );
+
+    Instances &instances = _instances[ Localizer ];
+
+    for ( unsigned int i = 0; i < lat.size(); i++ )
+    {
+        instances.pos.push_back( osg::Vec4d( x[ i ], y[ i ], Map::_zNavaids, bearing[ i ] ) );
+        instances.size.push_back( osg::Vec2( 1.0f, 1.0f ) );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Icons::initNavaids()
 {
-    nav::DataBase::ListNAV listNAV = nav::DataBase::instance()->getListNAV();
+    const nav::DataBase::ListNAV &listNAV = nav::DataBase::instance()->getListNAV();
+
+    std::vector< double > lat( listNAV.size() );
+    std::vector< double > lon( listNAV.size() );
+
+    for ( unsigned int i = 0; i < listNAV.size(); i++ )
+    {
+        lat[ i ] = listNAV[ i ].lat;
+        lon[ i ] = listNAV[ i ].lon;
+    }
+
+    std::vector< double > x;
+    std::vector< double > y;
 
-    for ( nav::DataBase::ListNAV::iterator it = listNAV.begin(); it != listNAV.end(); ++it )
+    getMercator( lat, lon, &x, &y );
+
+    for ( unsigned int i = 0; i < listNAV.size(); i++ )
     {
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _root->addChild( pat.get() );
-        pat->addChild( getNavaidSymbol( (*it).type ) );
-        pat->setPosition( osg::Vec3d(  Mercator::x( (*it).lon ),
-                                       Mercator::y( (*it).lat ),
-                                       Map::_zNavaids ) );
-        _navaids.push_back( pat.get() );
+        Instances &instances = _instances[ getNavaidSymbol( listNAV[ i ].type ) ];
+
+        instances.pos.push_back( osg::Vec4d( x[ i ], y[ i ], Map::_zNavaids, 0.0 ) );
+        instances.size.push_back( osg::Vec2( 1.0f, 1.0f ) );
     }
 }
 
@@ -307,47 +507,169 @@ void Icons::initNavaids()
 
 void Icons::initRunways()
 {
-    nav::DataBase::ListRWY listRWY = nav::DataBase::instance()->getListRWY();
+    const nav::DataBase::ListRWY &listRWY = nav::DataBase::instance()->getListRWY();
 
-    for ( nav::DataBase::ListRWY::iterator it = listRWY.begin(); it != listRWY.end(); ++it )
+    const unsigned int count = listRWY.size();
+
+    // high ends followed by low ends
+    std::vector< double > lat( 2 * count );
+    std::vector< double > lon( 2 * count );
+
+    for ( unsigned int i = 0; i < count; i++ )
     {
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        _root->addChild( pat.get() );
-        pat->addChild( createRunway( (*it).length, (*it).width ) );
+        lat[ i ] = listRWY[ i ].he_lat;
+        lon[ i ] = listRWY[ i ].he_lon;
+
+        lat[ count + i ] = listRWY[ i ].le_lat;
+        lon[ count + i ] = listRWY[ i ].le_lon;
+    }
 
-        double he_x = Mercator::x( (*it).he_lon );
-        double he_y = Mercator::y( (*it).he_lat );
-        double le_x = Mercator::x( (*it).le_lon );
-        double le_y = Mercator::y( (*it).le_lat );
+    std::vector< double > x;
+    std::vector< double > y;
 
-        fdm::WGS84::Geo he_pos_geo;
-        fdm::WGS84::Geo le_pos_geo;
+    getMercator( lat, lon, &x, &y );
 
-        he_pos_geo.lat = (*it).he_lat;
-        he_pos_geo.lon = (*it).he_lon;
-        he_pos_geo.alt = (*it).he_elev;
+    Instances &instances = _instances[ Runway ];
 
-        le_pos_geo.lat = (*it).le_lat;
-        le_pos_geo.lon = (*it).le_lon;
-        le_pos_geo.alt = (*it).le_elev;
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        double he_x = x[ i ];
+        double he_y = y[ i ];
+        double le_x = x[ count + i ];
+        double le_y = y[ count + i ];
+
+        // Mercator projection is conformal, so runway heading is the same
+        // as its direction on the map
+        double heading = atan2( he_x - le_x, he_y - le_y );
+
+        instances.pos.push_back( osg::Vec4d( 0.5 * ( he_x + le_x ),
+                                             0.5 * ( he_y + le_y ),
+                                             Map::_zAirports, heading ) );
+        instances.size.push_back( osg::Vec2( listRWY[ i ].width, listRWY[ i ].length ) );
+    }
+}
 
-        fdm::Vector3 he_pos_wgs = fdm::WGS84::geo2wgs( he_pos_geo );
-        fdm::Vector3 le_pos_wgs = fdm::WGS84::geo2wgs( le_pos_geo );
+////////////////////////////////////////////////////////////////////////////////
 
-        fdm::WGS84 av_pos_wgs( 0.5 * ( he_pos_wgs + le_pos_wgs ) );
+void Icons::updateInstances()
+{
+    double x_max = Mercator::x( M_PI );
 
-        fdm::Vector3 he_pos_ned = av_pos_wgs.getWGS2NED() * ( he_pos_wgs - av_pos_wgs.getPos_WGS() );
-        fdm::Vector3 le_pos_ned = av_pos_wgs.getWGS2NED() * ( le_pos_wgs - av_pos_wgs.getPos_WGS() );
+    // whole map until view extents are recorded by the first cull traversal
+    double left   = -x_max;
+    double right  =  x_max;
+    double bottom = -x_max;
+    double top    =  x_max;
 
-        fdm::Vector3 v_delta_ned = he_pos_ned - le_pos_ned;
+    if ( _viewCallback->valid )
+    {
+        left   = _viewCallback->left;
+        right  = _viewCallback->right;
+        bottom = _viewCallback->bottom;
+        top    = _viewCallback->top;
+    }
 
-        double heading = atan2( v_delta_ned.v(), v_delta_ned.u() );
+    if ( left   == _lastLeft   && right == _lastRight
+      && bottom == _lastBottom && top   == _lastTop
+      && _scale == _lastScale )
+    {
+        return;
+    }
+
+    _lastLeft   = left;
+    _lastRight  = right;
+    _lastBottom = bottom;
+    _lastTop    = top;
+    _lastScale  = _scale;
+
+    const double size = _iconSize * _scale;
+    const double cell = std::max( 1.0, (double)CGI_MAP_ICONS_DECLUTTER ) * size;
+
+    // grid is anchored to the map origin, so panning does not reshuffle icons
+    const int i0 = static_cast< int >( floor( left   / cell ) ) - 1;
+    const int j0 = static_cast< int >( floor( bottom / cell ) ) - 1;
+
+    const int cols = static_cast< int >( floor( right / cell ) ) - i0 + 2;
+    const int rows = static_cast< int >( floor( top   / cell ) ) - j0 + 2;
+
+    _grid.assign( cols * rows, -1 );
+    _drawn.clear();
+
+    for ( unsigned int k = 0; k < _instances.size(); k++ )
+    {
+        Instances &instances = _instances[ k ];
+
+        instances.drawnPos->clear();
+        instances.drawnSize->clear();
+
+        const double scale = instances.scaled ? size : 1.0;
+
+        for ( unsigned int i = 0; i < instances.pos.size(); i++ )
+        {
+            const osg::Vec4d &p = instances.pos[ i ];
+            const osg::Vec2  &s = instances.size[ i ];
+
+            double r = instances.radius * std::max( s.x(), s.y() ) * scale;
+
+            if ( p.x() + r < left || p.x() - r > right || p.y() + r < bottom || p.y() - r > top )
+            {
+                continue;
+            }
+
+            if ( instances.scaled )
+            {
+                int ic = static_cast< int >( floor( p.x() / cell ) ) - i0;
+                int jc = static_cast< int >( floor( p.y() / cell ) ) - j0;
+
+                if ( ic < 0 || ic >= cols || jc < 0 || jc >= rows )
+                {
+                    continue;
+                }
+
+                // overlapping icons are in the same or adjacent cells,
+                // so every cell holds at most one drawn icon
+                bool overlapping = false;
+
+                for ( int jj = std::max( 0, jc - 1 ); jj <= std::min( rows - 1, jc + 1 ) && !overlapping; jj++ )
+                {
+                    for ( int ii = std::max( 0, ic - 1 ); ii <= std::min( cols - 1, ic + 1 ) && !overlapping; ii++ )
+                    {
+                        int d = _grid[ jj * cols + ii ];
+
+                        if ( d >= 0 )
+                        {
+                            overlapping = fabs( _drawn[ d ].x() - p.x() ) < cell
+                                       && fabs( _drawn[ d ].y() - p.y() ) < cell;
+                        }
+                    }
+                }
+
+                if ( overlapping )
+                {
+                    continue;
+                }
+
+                _grid[ jc * cols + ic ] = _drawn.size();
+                _drawn.push_back( osg::Vec2d( p.x(), p.y() ) );
+            }
+
+            instances.drawnPos->push_back( osg::Vec4( p.x(), p.y(), p.z(), p.w() ) );
+            instances.drawnSize->push_back( s );
+        }
+
+        const unsigned int count = instances.drawnPos->size();
+
+        instances.drawnPos->dirty();
+        instances.drawnSize->dirty();
+
+        for ( unsigned int n = 0; n < instances.geometry->getNumPrimitiveSets(); n++ )
+        {
+            instances.geometry->getPrimitiveSet( n )->setNumInstances( count );
+            instances.geometry->getPrimitiveSet( n )->dirty();
+        }
 
-        pat->setPosition( osg::Vec3d( 0.5 * ( he_x + le_x ),
-                                      0.5 * ( he_y + le_y ),
-                                      Map::_zAirports ) );
-        pat->setAttitude( osg::Quat( -heading, osg::Z_AXIS ) );
-        _runways.push_back( pat.get() );
+        // zero number of instances would mean non-instanced draw
+        instances.geode->setNodeMask( count > 0 ? 0xffffffff : 0 );
     }
 }
 
@@ -24,7 +24,13 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/NodeCallback>
 #include <osg/PositionAttitudeTransform>
+#include <osg/Uniform>
 
 #include <cgi/cgi_Module.h>
 
@@ -33,18 +39,66 @@
 namespace cgi
 {
 
-/** Icons class. */
+/**
+ * @brief Icons class.
+ *
+ * Aerodromes, navaids, localizers and runways of the same symbol are drawn
+ * as a single instanced geometry with per-instance position, heading and size.
+ * Scaled icons (aerodromes and navaids) are decluttered in screen space on
+ * a grid of icon sized cells, so only visible, non-overlapping icons are drawn.
+ */
 class Icons : public Module
 {
 public:
 
+    static const char _frag[];          ///< instanced icons fragment shader
+    static const char _vert[];          ///< instanced icons vertex shader
+
+    static const double _iconSize;      ///< [m] icon size at unit map scale
+
+    static const unsigned int _attribPos;   ///< per-instance position and heading vertex attribute index
+    static const unsigned int _attribSize;  ///< per-instance size vertex attribute index
+
     struct Ownship
     {
         osg::ref_ptr<osg::PositionAttitudeTransform> pat;
         osg::ref_ptr<osg::Group> speedLeader;
     };
 
-    typedef std::vector< osg::ref_ptr<osg::PositionAttitudeTransform> > PATs;
+    /** Instanced symbol. */
+    struct Instances
+    {
+        osg::ref_ptr<osg::Geode> geode;             ///< symbol geode
+        osg::ref_ptr<osg::Geometry> geometry;       ///< symbol geometry drawn once per instance
+        osg::ref_ptr<osg::Vec4Array> drawnPos;      ///< drawn instances x, y, z and heading
+        osg::ref_ptr<osg::Vec2Array> drawnSize;     ///< drawn instances sizes
+
+        std::vector< osg::Vec4d > pos;              ///< all instances x, y, z and heading
+        std::vector< osg::Vec2  > size;             ///< all instances sizes
+
+        double radius;                              ///< [m] symbol radius at unit size
+        bool scaled;                                ///< specifies if symbol is scaled and decluttered
+    };
+
+    /** View extents recording cull callback. */
+    class ViewCallback : public osg::NodeCallback
+    {
+    public:
+
+        ViewCallback();
+
+        /** */
+        virtual void operator()( osg::Node *node, osg::NodeVisitor *nv );
+
+        double left;        ///< [m] view left extent
+        double right;       ///< [m] view right extent
+        double bottom;      ///< [m] view bottom extent
+        double top;         ///< [m] view top extent
+
+        bool valid;         ///< specifies if view extents have been recorded
+    };
+
+    typedef std::vector< Instances > InstancesList;
 
     /** @brief Constructor. */
     Icons( const Module *parent = NULLPTR );
@@ -60,33 +114,58 @@ public:
 
 private:
 
+    /** Instanced symbols indices, scaled symbols in declutter priority order. */
+    enum Symbol
+    {
+        Aerodrome = 0,      ///< aerodrome
+        NavaidVOR,          ///< VOR
+        NavaidVORTAC,       ///< VORTAC
+        NavaidVORDME,       ///< VOR-DME
+        Localizer,          ///< ILS localizer
+        Runway,             ///< runway
+        SymbolsCount        ///< number of symbols
+    };
+
     Ownship _ownship;
 
-    PATs _aerodromes;
-    PATs _navaids;
-    PATs _localizers;
-    PATs _runways;
+    InstancesList _instances;               ///< instanced symbols
 
-    osg::ref_ptr<osg::Node> _symbolAerodrome;
-    osg::ref_ptr<osg::Node> _symbolNavaidVOR;
-    osg::ref_ptr<osg::Node> _symbolNavaidVORTAC;
-    osg::ref_ptr<osg::Node> _symbolNavaidVORDME;
-    osg::ref_ptr<osg::Node> _symbolNavaidILSLOC;
+    osg::ref_ptr<ViewCallback> _viewCallback;
+
+    osg::ref_ptr<osg::Uniform> _iconScale;  ///< scaled symbols scale uniform
+
+    std::vector< int > _grid;               ///< declutter grid cells, drawn icon index or -1
+    std::vector< osg::Vec2d > _drawn;       ///< drawn scaled icons positions
+
+    double _scale;                          ///< current map scale
+    double _lastLeft;                       ///< [m] view left extent of last instances update
+    double _lastRight;                      ///< [m] view right extent of last instances update
+    double _lastBottom;                     ///< [m] view bottom extent of last instances update
+    double _lastTop;                        ///< [m] view top extent of last instances update
+    double _lastScale;                      ///< map scale of last instances update
 
     void createIcon( osg::Group *parent, float z, const char *textureFile );
 
+    void createInstances( osg::Group *parent, Symbol symbol, osg::Geometry *geometry,
+                          const osg::Vec3 &color, bool scaled = true );
+
+    void createInstances( osg::Group *parent, Symbol symbol, osg::Node *model,
+                          const osg::Vec3 &color, bool scaled = true );
+
     void createOwnship();
 
-    osg::Node* createRunway( double length, double width );
-    osg::Node* createSymbolILS();
+    osg::Geometry* createSymbolILS();
+    osg::Geometry* createSymbolRunway();
 
-    osg::Node* getNavaidSymbol( int type );
+    Symbol getNavaidSymbol( int type );
 
     void initAerodromes();
     void initLocalizers();
     void initNavaids();
     void initRunways();
 
+    void updateInstances();
+
     void updateOwnship();
 };
 
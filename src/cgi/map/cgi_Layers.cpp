@@ -22,12 +22,26 @@
 
 #include <cgi/map/cgi_Layers.h>
 
+#include <cfloat>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <sstream>
+
 #include <osg/Geode>
 #include <osg/Geometry>
 #include <osg/LineWidth>
 #include <osg/PositionAttitudeTransform>
 #include <osg/Material>
+#include <osg/Texture2D>
+
+#include <osgDB/FileNameUtils>
+#include <osgDB/FileUtils>
+#include <osgDB/ReadFile>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
 
+#include <cgi/cgi_Defines.h>
 #include <cgi/cgi_Geometry.h>
 #include <cgi/cgi_Mercator.h>
 #include <cgi/cgi_Models.h>
@@ -36,6 +50,7 @@
 
 #include <fdm/utils/fdm_String.h>
 #include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
 
 #include <sim/Path.h>
 
@@ -45,6 +60,194 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const char tilesChildrenExt[] = "cgi_map_tiles";
+const char tilesImageryExt[]  = "cgi_map_image";
+
+std::mutex tilesMutex;                                  ///< tiles sets mutex
+std::map< std::string, Layers::Tiles > tilesSets;       ///< tiles sets indexed by directories
+
+/** Returns tile file name. */
+std::string getTileFile( const Layers::Tiles &tiles, int level, int x, int y,
+                         const char *ext )
+{
+    std::stringstream ss;
+    ss << tiles.dir << "/" << level << "/" << x << "_" << y << "." << ext;
+    return ss.str();
+}
+
+/** Creates textured quad of imagery tile. */
+osg::Node* createImageryTile( osg::Image *image, int level, int x, int y )
+{
+    double size = 2.0 * Mercator::_max_x / ( 1 << level );
+
+    double x_0 = -Mercator::_max_x + x * size;
+    double y_0 = -Mercator::_max_x + y * size;
+
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geode->addDrawable( geometry.get() );
+
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
+
+    v->push_back( osg::Vec3( x_0        , y_0        , 0.0 ) );
+    v->push_back( osg::Vec3( x_0 + size , y_0        , 0.0 ) );
+    v->push_back( osg::Vec3( x_0 + size , y_0 + size , 0.0 ) );
+    v->push_back( osg::Vec3( x_0        , y_0 + size , 0.0 ) );
+
+    Geometry::createQuad( geometry.get(), v.get(), true );
+
+    osg::ref_ptr<osg::Texture2D> texture = new osg::Texture2D( image );
+
+    // compressed on upload, image data is released afterwards
+    texture->setInternalFormatMode( osg::Texture::USE_S3TC_DXT1_COMPRESSION );
+    texture->setUnRefImageDataAfterApply( true );
+    texture->setWrap( osg::Texture2D::WRAP_S, osg::Texture2D::CLAMP_TO_EDGE );
+    texture->setWrap( osg::Texture2D::WRAP_T, osg::Texture2D::CLAMP_TO_EDGE );
+    texture->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+    texture->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
+    stateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON );
+    stateSet->setMode( GL_LIGHTING, osg::StateAttribute::OFF );
+
+    return geode.release();
+}
+
+/**
+ * Pseudo-loader of map tiles. File "<dir>/<L>/<x>_<y>.cgi_map_tiles" is not
+ * a real file, it stands for the group of existing child tiles of the given
+ * tile. File "<dir>/<L>/<x>_<y>.<ext>.cgi_map_image" stands for the imagery
+ * tile quad textured with "<dir>/<L>/<x>_<y>.<ext>" image.
+ */
+class TilesReader : public osgDB::ReaderWriter
+{
+public:
+
+    TilesReader()
+    {
+        supportsExtension( tilesChildrenExt, "MScSim map layer tile children" );
+        supportsExtension( tilesImageryExt, "MScSim map imagery tile" );
+    }
+
+    virtual const char* className() const { return "MScSim map layer tiles"; }
+
+    virtual ReadResult readNode( const std::string &file, const Options *options ) const
+    {
+        std::string ext = osgDB::getLowerCaseFileExtension( file );
+
+        if ( !acceptsExtension( ext ) )
+        {
+            return ReadResult::FILE_NOT_HANDLED;
+        }
+
+        std::string levelDir = osgDB::getFilePath( file );
+        std::string dir = osgDB::getFilePath( levelDir );
+        std::string name = osgDB::getStrippedName( file );
+
+        int level = 0;
+        int x = 0;
+        int y = 0;
+
+        if ( 1 != sscanf( osgDB::getSimpleFileName( levelDir ).c_str(), "%d", &level )
+          || 2 != sscanf( name.c_str(), "%d_%d", &x, &y ) )
+        {
+            return ReadResult::FILE_NOT_FOUND;
+        }
+
+        if ( ext == tilesImageryExt )
+        {
+            osg::ref_ptr<osg::Image> image = osgDB::readImageFile( osgDB::getNameLessExtension( file ), options );
+
+            if ( !image.valid() ) return ReadResult::FILE_NOT_FOUND;
+
+            return createImageryTile( image.get(), level, x, y );
+        }
+
+        Layers::Tiles tiles;
+
+        {
+            std::lock_guard< std::mutex > lock( tilesMutex );
+
+            std::map< std::string, Layers::Tiles >::iterator it = tilesSets.find( dir );
+
+            if ( it == tilesSets.end() ) return ReadResult::FILE_NOT_FOUND;
+
+            tiles = it->second;
+        }
+
+        osg::ref_ptr<Options> tilesOptions = options ? new Options( *options ) : new Options();
+
+        osg::ref_ptr<osg::Group> group = new osg::Group();
+
+        for ( int k = 0; k < 4; k++ )
+        {
+            osg::ref_ptr<osg::PagedLOD> tile = Layers::createTile( tiles, level + 1,
+                                                                   2 * x + k % 2, 2 * y + k / 2,
+                                                                   tilesOptions.get() );
+
+            if ( tile.valid() )
+            {
+                group->addChild( tile.get() );
+            }
+        }
+
+        return group.release();
+    }
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::PagedLOD* Layers::createTile( const Tiles &tiles, int level, int x, int y,
+                                   osgDB::Options *options )
+{
+    std::string tileFile = getTileFile( tiles, level, x, y, tiles.ext.c_str() );
+
+    // areas not covered by the layer have no tiles
+    if ( !osgDB::fileExists( tileFile ) ) return NULLPTR;
+
+    double size = 2.0 * Mercator::_max_x / ( 1 << level );
+
+    double x_0 = -Mercator::_max_x + x * size;
+    double y_0 = -Mercator::_max_x + y * size;
+
+    // imagery bounds are enlarged to page in tiles around the view ahead,
+    // split size is scaled accordingly to keep the same level of detail
+    double scale = tiles.imagery ? CGI_MAP_IMAGERY_PREFETCH : 1.0;
+    float split = scale * CGI_MAP_TILES_SPLIT;
+
+    osg::ref_ptr<osg::PagedLOD> tile = new osg::PagedLOD();
+
+    tile->setCenterMode( osg::LOD::USER_DEFINED_CENTER );
+    tile->setCenter( osg::Vec3d( x_0 + 0.5 * size, y_0 + 0.5 * size, 0.0 ) );
+    tile->setRadius( scale * M_SQRT1_2 * size );
+    tile->setRangeMode( osg::LOD::PIXEL_SIZE_ON_SCREEN );
+    tile->setDatabaseOptions( options );
+
+    tile->setFileName( 0, tiles.imagery ? tileFile + "." + tilesImageryExt : tileFile );
+
+    if ( level < tiles.levels - 1 )
+    {
+        // tile is replaced by its children when zoomed in
+        tile->setRange( 0, 0.0f, split );
+
+        tile->setFileName( 1, getTileFile( tiles, level, x, y, tilesChildrenExt ) );
+        tile->setRange( 1, split, FLT_MAX );
+    }
+    else
+    {
+        tile->setRange( 0, 0.0f, FLT_MAX );
+    }
+
+    return tile.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Layers::Layers( const Module *parent ) :
     Module( parent )
 {
@@ -128,6 +331,11 @@ Layers::Layers( const Module *parent ) :
     initLayer( _water_inland .get() , Map::_colorWaterInland );
     initLayer( _borders      .get() , Map::_colorBorders     );
 
+    // tiles are kept in the object cache, expired by the database pager
+    // when they are no longer referenced
+    _options = new osgDB::Options();
+    _options->setObjectCacheHint( osgDB::Options::CACHE_NODES );
+
     createOcean();
     readLayers();
 }
@@ -323,7 +531,7 @@ void Layers::readLayer( const fdm::XmlNode &node, osg::Group *parent )
         {
             std::string file = fileTextNode.getText();
 
-            osg::ref_ptr<osg::Node> layerNode = Models::get( file.c_str(), true );
+            osg::ref_ptr<osg::Node> layerNode = Models::getAsync( file.c_str(), true );
 
             if ( layerNode.valid() )
             {
@@ -333,4 +541,50 @@ void Layers::readLayer( const fdm::XmlNode &node, osg::Group *parent )
 
         fileNode = fileNode.getNextSiblingElement( "file" );
     }
+
+    readTiles( node, parent );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Layers::readTiles( const fdm::XmlNode &node, osg::Group *parent )
+{
+    fdm::XmlNode tilesNode = node.getFirstChildElement( "tiles" );
+
+    while ( tilesNode.isValid() )
+    {
+        Tiles tiles;
+
+        tiles.imagery = fdm::String::toBool( tilesNode.getAttribute( "imagery" ), false );
+        tiles.ext = tiles.imagery ? "jpg" : "osgb";
+
+        if ( FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &tiles.dir    , "dir"    )
+          && FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &tiles.levels , "levels" )
+          && tiles.levels > 0 )
+        {
+            fdm::XmlUtils::read( tilesNode, &tiles.ext, "ext", true );
+
+            tiles.dir = osgDB::convertFileNameToUnixStyle( Path::get( tiles.dir ) );
+
+            {
+                std::lock_guard< std::mutex > lock( tilesMutex );
+
+                if ( tilesSets.empty() )
+                {
+                    osgDB::Registry::instance()->addReaderWriter( new TilesReader() );
+                }
+
+                tilesSets[ tiles.dir ] = tiles;
+            }
+
+            osg::ref_ptr<osg::PagedLOD> tile = createTile( tiles, 0, 0, 0, _options.get() );
+
+            if ( tile.valid() )
+            {
+                parent->addChild( tile.get() );
+            }
+        }
+
+        tilesNode = tilesNode.getNextSiblingElement( "tiles" );
+    }
 }
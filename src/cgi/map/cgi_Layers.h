@@ -24,9 +24,12 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <osg/PagedLOD>
 #include <osg/PositionAttitudeTransform>
 #include <osg/Switch>
 
+#include <osgDB/Options>
+
 #include <fdm/xml/fdm_XmlNode.h>
 
 #include <cgi/cgi_Module.h>
@@ -36,11 +39,52 @@
 namespace cgi
 {
 
-/** Layers class. */
+/**
+ * @brief Layers class.
+ *
+ * Layer might be given as a list of whole models or as a set of tiles.
+ * Tiles are paged in by the database pager for the viewed area only and
+ * the level of detail depends on the map zoom.
+ */
 class Layers : public Module
 {
 public:
 
+    /**
+     * @brief Map layer tiles set description.
+     *
+     * Tiles make a quadtree covering whole Mercator map, level 0 is a single
+     * tile, level L consists of 2^L x 2^L tiles. Tile files are expected to be
+     * "<dir>/<L>/<x>_<y>.<ext>" where x is index from west and y is index from
+     * south. Each level is expected to be simplified accordingly to its map
+     * scale. Missing tiles (areas not covered by the layer) are skipped.
+     *
+     * Imagery tiles are image files (e.g. JPEG or PNG), decoded by the
+     * database pager threads into textured quads. Tiles no longer viewed
+     * are expired by the database pager, least recently used first.
+     */
+    struct Tiles
+    {
+        std::string dir;        ///< tiles directory
+        std::string ext;        ///< tiles files extension
+
+        int levels;             ///< number of quadtree levels
+
+        bool imagery;           ///< specifies if tiles are imagery
+    };
+
+    /**
+     * @brief Creates tile paged LOD node.
+     * @param tiles tiles set
+     * @param level tile quadtree level
+     * @param x tile index from west
+     * @param y tile index from south
+     * @param options tiles reading options
+     * @return tile paged LOD node or NULLPTR if tile does not exist
+     */
+    static osg::PagedLOD* createTile( const Tiles &tiles, int level, int x, int y,
+                                      osgDB::Options *options );
+
     /** @brief Constructor. */
     Layers( const Module *parent = NULLPTR );
 
@@ -84,12 +128,15 @@ private:
     osg::ref_ptr<osg::PositionAttitudeTransform> _satellite;
     osg::ref_ptr<osg::PositionAttitudeTransform> _borders;
 
+    osg::ref_ptr<osgDB::Options> _options;  ///< tiles reading options
+
     void createOcean();
 
     void initLayer( osg::Node* layer, osg::Vec3 color, float width = 1.0f );
 
     void readLayers();
     void readLayer( const fdm::XmlNode &node, osg::Group *parent );
+    void readTiles( const fdm::XmlNode &node, osg::Group *parent );
 };
 
 } // end of cgi namespace
@@ -22,9 +22,7 @@
 
 #include <cgi/map/cgi_Traces.h>
 
-#include <osg/Geode>
-#include <osg/Geometry>
-
+#include <cgi/cgi_Defines.h>
 #include <cgi/cgi_Mercator.h>
 
 #include <cgi/map/cgi_Map.h>
@@ -39,6 +37,7 @@ using namespace cgi;
 
 Traces::Traces( const Module *parent ) :
     Module( parent ),
+    _trace ( NULLPTR ),
     _visible ( true ),
     _counter ( 0 ),
     _prevState ( fdm::DataOut::Idle )
@@ -46,12 +45,18 @@ Traces::Traces( const Module *parent ) :
     _switch = new osg::Switch();
     _root->addChild( _switch.get() );
 
-    _positions = new osg::Vec3Array();
+    _trace = new Trace( CGI_MAP_TRACE_CHUNK_SIZE, CGI_MAP_TRACE_MAX_CHUNKS,
+                        CGI_MAP_TRACE_MIN_SPACING, CGI_MAP_TRACE_MAX_SPACING,
+                        CGI_MAP_TRACE_MAX_ANGLE );
+    _switch->addChild( _trace->getNode() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Traces::~Traces() {}
+Traces::~Traces()
+{
+    DELPTR( _trace );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -63,34 +68,9 @@ void Traces::update()
         {
             _counter = 0;
 
-            if ( _switch->getNumChildren() > 0 )
-            {
-                _switch->removeChildren( 0, _switch->getNumChildren() );
-            }
-
-            _positions->push_back( osg::Vec3( Mercator::x( Data::get()->ownship.longitude ),
-                                              Mercator::y( Data::get()->ownship.latitude ),
-                                              Map::_zTraces ) );
-
-            osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-            _switch->addChild( geode.get() );
-
-            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-            osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-            osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-            n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-            c->push_back( osg::Vec4( 0.0f, 0.0f, 0.0f, 1.0f ) );
-
-            geometry->setVertexArray( _positions.get() );
-            geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, _positions->size() ) );
-            geometry->setNormalArray( n.get() );
-            geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-            geometry->setColorArray( c.get() );
-            geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-            geode->addDrawable( geometry.get() );
+            _trace->addPoint( osg::Vec3( Mercator::x( Data::get()->ownship.longitude ),
+                                         Mercator::y( Data::get()->ownship.latitude ),
+                                         Map::_zTraces ) );
         }
 
         _counter++;
@@ -107,14 +87,9 @@ void Traces::update()
 
 void Traces::reset()
 {
-    _positions->clear();
+    _trace->clear();
 
     _counter = 0;
-
-    if ( _switch->getNumChildren() > 0 )
-    {
-        _switch->removeChildren( 0, _switch->getNumChildren() );
-    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -131,10 +106,5 @@ void Traces::setVisibility( bool visible )
     else
     {
         _switch->setAllChildrenOff();
-
-        if ( _switch->getNumChildren() > 0 )
-        {
-            _switch->removeChildren( 0, _switch->getNumChildren() );
-        }
     }
 }
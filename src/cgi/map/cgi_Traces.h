@@ -29,6 +29,7 @@
 #include <fdm/fdm_DataOut.h>
 
 #include <cgi/cgi_Module.h>
+#include <cgi/cgi_Trace.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -56,7 +57,7 @@ public:
 private:
 
     osg::ref_ptr<osg::Switch> _switch;
-    osg::ref_ptr<osg::Vec3Array> _positions;
+    Trace *_trace;
     bool _visible;
     unsigned int _counter;
     fdm::DataOut::StateOut _prevState;
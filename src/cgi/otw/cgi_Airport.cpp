@@ -22,8 +22,17 @@
 
 #include <cgi/otw/cgi_Airport.h>
 
+#include <osg/BlendFunc>
+#include <osg/Depth>
+#include <osg/Geode>
+#include <osg/Geometry>
+#include <osg/Point>
+
+#include <osgSim/LightPointNode>
+
 #include <Data.h>
 
+#include <cgi/cgi_Defines.h>
 #include <cgi/cgi_FindNode.h>
 #include <cgi/cgi_Models.h>
 #include <cgi/cgi_WGS84.h>
@@ -34,6 +43,37 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+/** Collects light point nodes paths. */
+class LightPointsVisitor : public osg::NodeVisitor
+{
+public:
+
+    std::vector< osg::NodePath > paths;     ///< light point nodes paths
+
+    LightPointsVisitor() :
+        osg::NodeVisitor( osg::NodeVisitor::TRAVERSE_ALL_CHILDREN )
+    {}
+
+    virtual void apply( osg::Node &node )
+    {
+        if ( dynamic_cast<osgSim::LightPointNode*>( &node ) )
+        {
+            paths.push_back( getNodePath() );
+        }
+        else
+        {
+            traverse( node );
+        }
+    }
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 Airport::Airport( const char *file, double lat, double lon, double alt,
                   const Module *parent ) :
     Module( parent )
@@ -49,6 +89,8 @@ Airport::Airport( const char *file, double lat, double lon, double alt,
 
         WGS84::setLatLonAltHdg( _pat.get(), lat, lon, alt );
 
+        createLights( node.get() );
+
         switchesAdd( &_lightsRALS, node.get(), "RALS_L" );
         switchesAdd( &_lightsTDZL, node.get(), "TDZL_L" );
         switchesAdd( &_lightsVGSI, node.get(), "VGSI_L" );
@@ -92,9 +134,141 @@ void Airport::update()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Airport::createLights( osg::Node *node )
+{
+    osg::ref_ptr<osg::Group> root = node->asGroup();
+
+    // models are shared, lights might have been already batched
+    if ( !root.valid() || Models::findFirst( node, "AirportLights" ) ) return;
+
+    const char *names[] = { "RALS_L", "TDZL_L", "RALS_H", "TDZL_H",
+                            "RCLS", "RELS", "HELI", "TELS", "TWRL" };
+
+    osg::ref_ptr<osg::Group> lights = new osg::Group();
+    lights->setName( "AirportLights" );
+
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
+    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
+
+    for ( unsigned int i = 0; i < sizeof(names) / sizeof(names[ 0 ]); i++ )
+    {
+        unsigned int first = v->size();
+
+        FindNode::Nodes switches = Models::findNodes( node, names[ i ] );
+
+        for ( FindNode::Nodes::iterator it = switches.begin(); it != switches.end(); it++ )
+        {
+            osg::NodePathList parentalPaths = (*it)->getParentalNodePaths( node );
+
+            if ( parentalPaths.empty() ) continue;
+
+            LightPointsVisitor visitor;
+            (*it)->accept( visitor );
+
+            for ( unsigned int j = 0; j < visitor.paths.size(); j++ )
+            {
+                osg::NodePath path = parentalPaths[ 0 ];
+                path.insert( path.end(), visitor.paths[ j ].begin() + 1, visitor.paths[ j ].end() );
+
+                osg::ref_ptr<osgSim::LightPointNode> lpn = dynamic_cast<osgSim::LightPointNode*>( path.back() );
+
+                bool simple = lpn->getNumLightPoints() > 0;
+
+                for ( unsigned int k = 0; k < lpn->getNumLightPoints() && simple; k++ )
+                {
+                    const osgSim::LightPoint &lp = lpn->getLightPoint( k );
+                    simple = !lp._sector.valid() && !lp._blinkSequence.valid();
+                }
+
+                if ( !simple ) continue;
+
+                osg::Matrixd matrix = osg::computeLocalToWorld( path );
+
+                for ( unsigned int k = 0; k < lpn->getNumLightPoints(); k++ )
+                {
+                    const osgSim::LightPoint &lp = lpn->getLightPoint( k );
+
+                    if ( !lp._on ) continue;
+
+                    osg::Vec4 color = lp._color;
+                    color.a() *= osg::clampBetween( lp._intensity, 0.0f, 1.0f );
+
+                    v->push_back( lp._position * matrix );
+                    c->push_back( color );
+                }
+
+                // light point node is replaced by batched points
+                while ( lpn->getNumParents() > 0 )
+                {
+                    lpn->getParent( 0 )->removeChild( lpn.get() );
+                }
+            }
+        }
+
+        unsigned int count = v->size() - first;
+
+        if ( count > 0 )
+        {
+            osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+
+            geometry->setVertexArray( v.get() );
+            geometry->setColorArray( c.get() );
+            geometry->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+            geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::POINTS, first, count ) );
+            geometry->setUseDisplayList( false );
+            geometry->setUseVertexBufferObjects( true );
+
+            osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+            geode->addDrawable( geometry.get() );
+
+            osg::ref_ptr<osg::Switch> sw = new osg::Switch();
+            sw->setName( std::string( names[ i ] ) + "_Batch" );
+            sw->addChild( geode.get() );
+
+            lights->addChild( sw.get() );
+        }
+    }
+
+    if ( v->size() > 0 )
+    {
+        osg::ref_ptr<osg::StateSet> stateSet = lights->getOrCreateStateSet();
+
+        // size and intensity (fade) attenuated with distance
+        osg::ref_ptr<osg::Point> point = new osg::Point();
+        point->setSize( CGI_AIRPORT_LIGHTS_SIZE );
+        point->setMinSize( CGI_AIRPORT_LIGHTS_SIZE_MIN );
+        point->setMaxSize( CGI_AIRPORT_LIGHTS_SIZE_MAX );
+        point->setFadeThresholdSize( CGI_AIRPORT_LIGHTS_FADE );
+        point->setDistanceAttenuation( osg::Vec3( 1.0f, 0.0f, CGI_AIRPORT_LIGHTS_ATT ) );
+        stateSet->setAttribute( point.get() );
+
+        osg::ref_ptr<osg::BlendFunc> blendFunc = new osg::BlendFunc( GL_SRC_ALPHA, GL_ONE );
+        stateSet->setAttributeAndModes( blendFunc.get(), osg::StateAttribute::ON );
+
+        osg::ref_ptr<osg::Depth> depth = new osg::Depth();
+        depth->setWriteMask( false );
+        stateSet->setAttributeAndModes( depth.get(), osg::StateAttribute::ON );
+
+        stateSet->setMode( GL_POINT_SMOOTH, osg::StateAttribute::ON );
+        stateSet->setMode( GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED );
+        stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
+
+        root->addChild( lights.get() );
+    }
+
+    // shared model subgraph has changed
+    Models::updateIndex( node );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Airport::switchesAdd( Switches *switches, osg::Node *node, const char *name )
 {
-    FindNode::Nodes nodes = FindNode::findNodes( node, name );
+    FindNode::Nodes nodes = Models::findNodes( node, name );
+
+    // batched lights
+    FindNode::Nodes batched = Models::findNodes( node, ( std::string( name ) + "_Batch" ).c_str() );
+    nodes.insert( nodes.end(), batched.begin(), batched.end() );
 
     for ( FindNode::Nodes::iterator it = nodes.begin(); it != nodes.end(); it++ )
     {
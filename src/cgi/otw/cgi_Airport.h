@@ -69,6 +69,15 @@ private:
     Switches _lightsTELS;   ///<
     Switches _lightsTWRL;   ///<
 
+    /**
+     * Moves light points of switched light groups into a single vertex
+     * buffer per airport model, drawn as distance attenuated points. Each
+     * group is drawn with its own primitive set under a switch named
+     * "<group>_Batch". Light points with sectors or blink sequences (e.g.
+     * VGSI) are left untouched.
+     */
+    void createLights( osg::Node *node );
+
     void switchesAdd( Switches *switches, osg::Node *node, const char *name );
 
     void switchesSet( Switches *switches, bool enabled );
@@ -25,6 +25,8 @@
 #include <cgi/otw/cgi_CloudsBlock.h>
 #include <cgi/otw/cgi_CloudsLayer.h>
 
+#include <cgi/cgi_FrameStats.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
@@ -41,3 +43,14 @@ Clouds::Clouds( const Module *parent ) :
 ////////////////////////////////////////////////////////////////////////////////
 
 Clouds::~Clouds() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Clouds::update()
+{
+    CGI_FRAME_STATS_ZONE( ModuleClouds, "Clouds::update" );
+
+    /////////////////
+    Module::update();
+    /////////////////
+}
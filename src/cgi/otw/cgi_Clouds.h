@@ -41,6 +41,9 @@ public:
 
     /** @brief Destructor. */
     virtual ~Clouds();
+
+    /** @brief Updates clouds. */
+    void update();
 };
 
 } // end of cgi namespace
@@ -33,14 +33,15 @@
 #include <osg/Geometry>
 #include <osg/Material>
 
+#include <climits>
+
 #include <Data.h>
 
 #include <cgi/cgi_Defines.h>
 #include <cgi/cgi_Geometry.h>
+#include <cgi/cgi_Origin.h>
 #include <cgi/cgi_WGS84.h>
 
-#include <fdm/utils/fdm_Random.h>
-
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
@@ -79,6 +80,12 @@ CloudsBlock::CloudsBlock( const Module *parent ) :
     _textures.push_back( Textures::get( "cgi/textures/cloud_cu_4.png" ) );
     _textures.push_back( Textures::get( "cgi/textures/cloud_cu_5.png" ) );
     _textures.push_back( Textures::get( "cgi/textures/cloud_cu_6.png" ) );
+
+    // private copies, as their parents lists are modified by the builder thread
+    for ( unsigned int i = 0; i < _textures.size(); i++ )
+    {
+        _textures[ i ] = new osg::Texture2D( *_textures[ i ], osg::CopyOp::SHALLOW_COPY );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +102,15 @@ void CloudsBlock::update()
 
     if ( Data::get()->cgi.environment.clouds.type == Data::CGI::Environment::Clouds::Block )
     {
+        osg::ref_ptr<osg::Group> clouds = _builder.fetch();
+
+        if ( clouds.valid() ) swap( clouds.get() );
+
+        if ( _patField.valid() )
+        {
+            _patField->setPosition( Origin::toScene( _field_wgs ) );
+        }
+
         if ( _framesCounter % 10 == 0 )
         {
             _framesCounter = 0;
@@ -107,11 +123,11 @@ void CloudsBlock::update()
 
             float radius2 = CGI_SKYDOME_RADIUS * CGI_SKYDOME_RADIUS;
 
-            if ( !_created
+            if ( !_builder.isBusy() && ( !_created
               || _count     != Data::get()->cgi.environment.clouds.data.block.count
               || _base_asl  != Data::get()->cgi.environment.clouds.data.block.base_asl
               || _thickness != Data::get()->cgi.environment.clouds.data.block.thickness
-              || ( _pos_wgs - wgs_cam.getPosition() ).length2() > 0.01 * radius2 )
+              || ( _pos_wgs - wgs_cam.getPosition() ).length2() > 0.01 * radius2 ) )
             {
                 _count     = Data::get()->cgi.environment.clouds.data.block.count;
                 _base_asl  = Data::get()->cgi.environment.clouds.data.block.base_asl;
@@ -120,27 +136,46 @@ void CloudsBlock::update()
                 create();
             }
 
-            float azim = 0.0f;
-            float dist = 0.0f;
-
-            for ( unsigned int i = 0; i < _patClouds.size(); i++ )
+            if ( _patField.valid() )
             {
-                osg::Vec3 pos_wgs = _patClouds[ i ]->getPosition();
+                if ( ( _field_wgs - wgs_cam.getPosition() ).length2() > radius2 )
+                {
+                    moveField( wgs_cam );
+                }
+
+                osg::Vec3d pos_field = _field_wgs;
+                osg::Quat  att_field = _patField->getAttitude();
 
-                if ( ( wgs_cam.getPosition() - pos_wgs ).length2() > radius2 )
+                float azim = 0.0f;
+                float dist = 0.0f;
+
+                for ( unsigned int i = 0; i < _clouds.size(); i++ )
                 {
-                    azim = fdm::Random::get( 0.0, 2.0 * M_PI );
-                    dist = 0.95f * CGI_SKYDOME_RADIUS;
+                    // the first sprite position is a cloud reference position
+                    osg::Vec3 pos_loc = _clouds[ i ]->getPosition( 0 );
+                    osg::Vec3d pos_wgs = pos_field + att_field * osg::Vec3d( pos_loc );
+
+                    if ( ( wgs_cam.getPosition() - pos_wgs ).length2() > radius2 )
+                    {
+                        azim = fdm::Random::get( 0.0, 2.0 * M_PI );
+                        dist = 0.95f * CGI_SKYDOME_RADIUS;
 
-                    osg::Vec3 pos_ned( dist * cos( azim ), dist * sin( azim ), 0.0f );
+                        osg::Vec3 pos_ned( dist * cos( azim ), dist * sin( azim ), 0.0f );
 
-                    pos_wgs = wgs_cam.getPosition() + wgs_cam.getAttitude() * pos_ned;
+                        pos_wgs = wgs_cam.getPosition() + wgs_cam.getAttitude() * pos_ned;
 
-                    WGS84 wgs_new( pos_wgs );
-                    wgs_new = WGS84( wgs_new.getLat(), wgs_new.getLon(), alt );
+                        WGS84 wgs_new( pos_wgs );
+                        wgs_new = WGS84( wgs_new.getLat(), wgs_new.getLon(), alt );
 
-                    _patClouds[ i ]->setPosition( wgs_new.getPosition() );
-                    _patClouds[ i ]->setAttitude( wgs_new.getAttitude() );
+                        osg::Vec3 delta = att_field.inverse() * ( wgs_new.getPosition() - pos_field ) - pos_loc;
+
+                        for ( unsigned int j = 0; j < _clouds[ i ]->getNumDrawables(); j++ )
+                        {
+                            _clouds[ i ]->setPosition( j, _clouds[ i ]->getPosition( j ) + delta );
+                        }
+
+                        _clouds[ i ]->dirtyBound();
+                    }
                 }
             }
 
@@ -151,7 +186,11 @@ void CloudsBlock::update()
     }
     else
     {
-        remove();
+        // result of a job started before clouds type has changed is dropped
+        _builder.fetch();
+
+        // textures parents lists might be modified by running job
+        if ( !_builder.isBusy() ) remove();
 
         _framesCounter = 0;
         _count = 0;
@@ -162,97 +201,172 @@ void CloudsBlock::update()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void CloudsBlock::create()
+osg::Group* CloudsBlock::createClouds( Textures::List textures, fdm::UInt64 seed,
+                                       int count, float thickness,
+                                       float lat, float lon, float alt )
 {
-    remove();
+    fdm::Random random( seed );
 
-    _created = true;
+    WGS84 wgs_field( lat, lon, alt );
+
+    osg::ref_ptr<osg::PositionAttitudeTransform> field = new osg::PositionAttitudeTransform();
+
+    field->setPosition( wgs_field.getPosition() );
+    field->setAttitude( wgs_field.getAttitude() );
+
+    osg::Quat att_inv = wgs_field.getAttitude().inverse();
+
+    // sprites using the same texture share state set
+    std::vector< osg::ref_ptr<osg::StateSet> > stateSets;
+
+    osg::ref_ptr<osg::Material> material = new osg::Material();
+    material->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
+    material->setAmbient( osg::Material::FRONT_AND_BACK, osg::Vec4f( 0.8f, 0.8f, 0.8f, 1.0f ) );
+    material->setDiffuse( osg::Material::FRONT_AND_BACK, osg::Vec4f( 1.0f, 1.0f, 1.0f, 1.0f ) );
+
+    for ( unsigned int i = 0; i < textures.size(); i++ )
+    {
+        osg::ref_ptr<osg::StateSet> stateSet = new osg::StateSet();
+        stateSet->setTextureAttributeAndModes( 0, textures.at( i ).get(), osg::StateAttribute::ON );
+        stateSet->setAttribute( material.get() );
+        stateSets.push_back( stateSet );
+    }
 
-    float lat = Data::get()->cgi.camera.latitude;
-    float lon = Data::get()->cgi.camera.longitude;
-    float alt = _base_asl;
     float ang = CGI_SKYDOME_RADIUS / 1852.0f / 60.0f;
 
-    int cloudsNumber = _count;
+    int cloudsNumber = count;
     cloudsNumber = std::min( std::max( cloudsNumber, 0 ), CGI_CLOUDS_MAX_COUNT );
 
     for ( int i = 0; i < cloudsNumber; i++ )
     {
-        osg::ref_ptr< osg::PositionAttitudeTransform > pat = new osg::PositionAttitudeTransform();
-        _root->addChild( pat.get() );
-        _patClouds.push_back( pat );
+        float d_lat = osg::DegreesToRadians( random.getRandom( -ang, ang ) );
+        float d_lon = osg::DegreesToRadians( random.getRandom( -ang, ang ) );
 
-        createBlock( pat.get() );
+        WGS84 wgs( lat + d_lat, lon + d_lon, alt );
 
-        float d_lat = osg::DegreesToRadians( fdm::Random::get( -ang, ang ) );
-        float d_lon = osg::DegreesToRadians( fdm::Random::get( -ang, ang ) );
+        osg::Vec3 pos = att_inv * ( wgs.getPosition() - wgs_field.getPosition() );
 
-        WGS84 wgs( lat + d_lat, lon + d_lon, alt );
+        osg::ref_ptr<osg::Billboard> billboard = new osg::Billboard();
+        field->addChild( billboard.get() );
 
-        pat->setPosition( wgs.getPosition() );
-        pat->setAttitude( wgs.getAttitude() );
+        billboard->setMode( osg::Billboard::AXIAL_ROT );
+        billboard->setNormal( osg::Vec3f( 0.0f, 1.0f, 0.0f ) );
+
+        createBlock( billboard.get(), pos, stateSets, &random, thickness );
     }
+
+    return field.release();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void CloudsBlock::createBlock( osg::Group *parent )
+void CloudsBlock::createBlock( osg::Billboard *billboard, const osg::Vec3 &pos,
+                               const std::vector< osg::ref_ptr<osg::StateSet> > &stateSets,
+                               fdm::Random *random, float thickness )
 {
-    int spritesNumber = fdm::Random::get( 2, 5 );
+    int spritesNumber = random->getRandom( 2, 5 );
     spritesNumber = std::min( std::max( spritesNumber, 0 ), CGI_CLOUDS_MAX_SPRITES );
 
     for ( int i = 0; i < spritesNumber; i++ )
     {
-        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-        parent->addChild( pat.get() );
+        float scale = thickness * random->getRandom( 0.6f, 1.0f );
 
-        createSprite( pat.get() );
+        osg::Vec3 offset( thickness * random->getRandom( 0.1f, 1.0f ),
+                          thickness * random->getRandom( 0.1f, 1.0f ),
+                          0.0 );
 
-        double scale = _thickness * fdm::Random::get( 0.6f, 1.0f );
+        // the first sprite is placed exactly at the cloud position
+        if ( i == 0 ) offset = osg::Vec3( 0.0f, 0.0f, 0.0f );
 
-        osg::Vec3 pos( _thickness * fdm::Random::get( 0.1f, 1.0f ),
-                       _thickness * fdm::Random::get( 0.1f, 1.0f ),
-                       0.0 );
+        int i_tex = random->getRandom( 0, stateSets.size() - 1 );
 
-        pat->setScale( osg::Vec3( scale, scale, scale ) );
-        pat->setPosition( pos );
+        createSprite( billboard, pos + offset, stateSets.at( i_tex ).get(), scale );
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void CloudsBlock::createSprite( osg::Group *parent )
+void CloudsBlock::createSprite( osg::Billboard *billboard, const osg::Vec3 &pos,
+                                osg::StateSet *stateSet, float scale )
 {
-    osg::ref_ptr<osg::Billboard> billboard = new osg::Billboard();
-    parent->addChild( billboard.get() );
-
-    billboard->setMode( osg::Billboard::AXIAL_ROT );
-    billboard->setNormal( osg::Vec3f( 0.0f, 1.0f, 0.0f ) );
-
     osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-    billboard->addDrawable( geometry.get(), osg::Vec3( 0.0, 0.0, 0.0 ) );
+    billboard->addDrawable( geometry.get(), pos );
 
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
 
-    v->push_back( osg::Vec3f( -1.0f, 0.0f,  0.0f ) );
-    v->push_back( osg::Vec3f(  1.0f, 0.0f,  0.0f ) );
-    v->push_back( osg::Vec3f(  1.0f, 0.0f, -1.0f ) );
-    v->push_back( osg::Vec3f( -1.0f, 0.0f, -1.0f ) );
+    v->push_back( osg::Vec3f( -scale, 0.0f,   0.0f ) );
+    v->push_back( osg::Vec3f(  scale, 0.0f,   0.0f ) );
+    v->push_back( osg::Vec3f(  scale, 0.0f, -scale ) );
+    v->push_back( osg::Vec3f( -scale, 0.0f, -scale ) );
 
     Geometry::createQuad( geometry.get(), v.get(), true );
 
-    osg::ref_ptr<osg::StateSet> billboardStateSet = billboard->getOrCreateStateSet();
+    geometry->setStateSet( stateSet );
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-    // texture
-    int i_tex = fdm::Random::get( 0, _textures.size() - 1 );
-    billboardStateSet->setTextureAttributeAndModes( 0, _textures.at( i_tex ).get(), osg::StateAttribute::ON );
+void CloudsBlock::create()
+{
+    _created = true;
 
-    // material
-    osg::ref_ptr<osg::Material> material = new osg::Material();
-    material->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
-    material->setAmbient( osg::Material::FRONT_AND_BACK, osg::Vec4f( 0.8f, 0.8f, 0.8f, 1.0f ) );
-    material->setDiffuse( osg::Material::FRONT_AND_BACK, osg::Vec4f( 1.0f, 1.0f, 1.0f, 1.0f ) );
-    billboardStateSet->setAttribute( material.get() );
+    fdm::UInt64 seed = fdm::Random::get( 0, INT_MAX );
+
+    _builder.start( std::bind( &CloudsBlock::createClouds, _textures, seed,
+                               _count, _thickness,
+                               Data::get()->cgi.camera.latitude,
+                               Data::get()->cgi.camera.longitude,
+                               _base_asl ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CloudsBlock::moveField( const WGS84 &wgs )
+{
+    osg::Vec3d pos_old = _field_wgs;
+    osg::Quat  att_old = _patField->getAttitude();
+
+    osg::Quat att_inv = wgs.getAttitude().inverse();
+
+    // clouds stay in place, only their coordinates are expressed in the new frame
+    for ( unsigned int i = 0; i < _clouds.size(); i++ )
+    {
+        for ( unsigned int j = 0; j < _clouds[ i ]->getNumDrawables(); j++ )
+        {
+            osg::Vec3d pos_wgs = pos_old + att_old * osg::Vec3d( _clouds[ i ]->getPosition( j ) );
+            _clouds[ i ]->setPosition( j, att_inv * ( pos_wgs - wgs.getPosition() ) );
+        }
+
+        _clouds[ i ]->dirtyBound();
+    }
+
+    _field_wgs = wgs.getPosition();
+
+    _patField->setPosition( Origin::toScene( _field_wgs ) );
+    _patField->setAttitude( wgs.getAttitude() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CloudsBlock::swap( osg::Group *clouds )
+{
+    remove();
+
+    _created = true;
+
+    _patField = clouds->asTransform()->asPositionAttitudeTransform();
+    _root->addChild( _patField.get() );
+
+    // field is created in WGS and placed relative to the scene origin
+    _field_wgs = _patField->getPosition();
+    _patField->setPosition( Origin::toScene( _field_wgs ) );
+
+    for ( unsigned int i = 0; i < _patField->getNumChildren(); i++ )
+    {
+        osg::Billboard *billboard = dynamic_cast< osg::Billboard* >( _patField->getChild( i ) );
+
+        if ( billboard ) _clouds.push_back( billboard );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -266,10 +380,6 @@ void CloudsBlock::remove()
         _root->removeChildren( 0, _root->getNumChildren() );
     }
 
-    for ( unsigned int i = 0; i < _patClouds.size(); i++ )
-    {
-        _patClouds[ i ] = 0;
-    }
-
-    _patClouds.clear();
+    _patField = 0;
+    _clouds.clear();
 }
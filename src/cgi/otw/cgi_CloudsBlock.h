@@ -24,17 +24,36 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <osg/Billboard>
 #include <osg/PositionAttitudeTransform>
 
+#include <fdm/utils/fdm_Random.h>
+
+#include <cgi/cgi_AsyncBuilder.h>
 #include <cgi/cgi_Module.h>
 #include <cgi/cgi_Textures.h>
+#include <cgi/cgi_WGS84.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace cgi
 {
 
-/** @brief Block clouds class. */
+/**
+ * @brief Block clouds class.
+ *
+ * Clouds field is generated on a background thread and swapped in when
+ * ready. Field is continuous: clouds leaving visual range are moved to its
+ * opposite edge, so it is regenerated only when clouds parameters change
+ * or camera jumps to another place.
+ *
+ * Every cloud is a single billboard node with its sprites as drawables,
+ * positioned in the field local frame. Sprites scale is baked into their
+ * vertices and sprites using the same texture share state set, so cull
+ * traversal visits one node per cloud instead of a transforms hierarchy
+ * per sprite. Field frame is moved along with camera without moving
+ * clouds themselves.
+ */
 class CloudsBlock : public Module
 {
 public:
@@ -50,11 +69,15 @@ public:
 
 private:
 
-    std::vector< osg::ref_ptr< osg::PositionAttitudeTransform > > _patClouds;
+    osg::ref_ptr<osg::PositionAttitudeTransform> _patField;     ///< clouds field local frame
+    std::vector< osg::ref_ptr<osg::Billboard> > _clouds;        ///< clouds
+
+    AsyncBuilder _builder;      ///< clouds field builder
 
     Textures::List _textures;   ///<
 
-    osg::Vec3 _pos_wgs;         ///<
+    osg::Vec3d _pos_wgs;        ///< [m] camera position of the last field update expressed in WGS
+    osg::Vec3d _field_wgs;      ///< [m] clouds field position expressed in WGS
 
     short _count;               ///< number of clouds within visual range
     float _base_asl;            ///< [m] clouds base above mean sea level
@@ -63,9 +86,20 @@ private:
     short _framesCounter;       ///<
     bool _created;              ///<
 
+    static osg::Group* createClouds( Textures::List textures, fdm::UInt64 seed,
+                                     int count, float thickness,
+                                     float lat, float lon, float alt );
+
+    static void createBlock( osg::Billboard *billboard, const osg::Vec3 &pos,
+                             const std::vector< osg::ref_ptr<osg::StateSet> > &stateSets,
+                             fdm::Random *random, float thickness );
+
+    static void createSprite( osg::Billboard *billboard, const osg::Vec3 &pos,
+                              osg::StateSet *stateSet, float scale );
+
     void create();
-    void createBlock( osg::Group *parent );
-    void createSprite( osg::Group *parent );
+    void moveField( const WGS84 &wgs );
+    void swap( osg::Group *clouds );
 
     void remove();
 };
@@ -27,9 +27,11 @@
 #include <osg/Geode>
 #include <osg/Geometry>
 #include <osg/Material>
-#include <osg/PositionAttitudeTransform>
+#include <osg/Program>
+#include <osg/Shader>
 
 #include <cgi/cgi_Defines.h>
+#include <cgi/cgi_Origin.h>
 #include <cgi/cgi_WGS84.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,19 +40,94 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const unsigned short mesh_cells = 20;   ///< number of layer mesh cells along each axis
+const double tile_size = 2500.0;        ///< [m] clouds texture tile size
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char CloudsLayer::_frag[] =
+    "uniform sampler2D cloudsTex;\n"
+    "uniform float coverage;\n"
+    "uniform float density;\n"
+    "\n"
+    "varying float edgeFactor;\n"
+    "varying float fogFactor;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   vec4 color = texture2D( cloudsTex, gl_TexCoord[ 0 ].st );\n"
+    "\n"
+    "   // thinnest parts of the clouds are removed as coverage decreases\n"
+    "   float alpha = clamp( ( color.a - 1.0 + coverage ) / max( coverage, 0.01 ), 0.0, 1.0 );\n"
+    "\n"
+    "   color.rgb *= gl_Color.rgb;\n"
+#   ifndef SIM_TEST_WORLD
+    "   color.rgb = mix( gl_Fog.color.rgb, color.rgb, fogFactor );\n"
+#   endif
+    "   color.a = alpha * density * edgeFactor;\n"
+    "\n"
+    "   gl_FragColor = color;\n"
+    "}\n"
+    "\n";
+
+const char CloudsLayer::_vert[] =
+    "uniform vec2 texOffset;\n"
+    "uniform float tileSize;\n"
+    "uniform float radius;\n"
+    "\n"
+    "varying float edgeFactor;\n"
+    "varying float fogFactor;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   // vertex x and y are layer local north and east coordinates\n"
+    "   gl_TexCoord[ 0 ] = vec4( gl_Vertex.xy / tileSize + texOffset, 0.0, 1.0 );\n"
+    "\n"
+    "   // layer fades out at the mesh edge, so it has no visible border\n"
+    "   edgeFactor = 1.0 - smoothstep( 0.8, 1.0, length( gl_Vertex.xy ) / radius );\n"
+    "\n"
+    "   vec3 n = normalize( gl_NormalMatrix * gl_Normal );\n"
+    "   vec3 l = normalize( gl_LightSource[ 0 ].position.xyz );\n"
+    "\n"
+    "   gl_FrontColor = gl_FrontLightModelProduct.sceneColor\n"
+    "                 + gl_FrontLightProduct[ 0 ].ambient\n"
+    "                 + gl_FrontLightProduct[ 0 ].diffuse * max( dot( n, l ), 0.0 );\n"
+    "\n"
+    "   vec4 v_eye = gl_ModelViewMatrix * gl_Vertex;\n"
+    "   fogFactor = clamp( ( gl_Fog.end - length( v_eye.xyz ) ) * gl_Fog.scale, 0.0, 1.0 );\n"
+    "\n"
+    "   gl_Position = gl_ProjectionMatrix * v_eye;\n"
+    "}\n"
+    "\n";
+
+////////////////////////////////////////////////////////////////////////////////
+
 CloudsLayer::CloudsLayer( const Module *parent ) :
     Module( parent ),
 
     _cover ( Data::CGI::Environment::Clouds::Data::Layer::SKC ),
-    _base_asl ( 0.0f ),
 
-    _framesCounter ( 0 ),
     _created ( false )
 {
     _textures.push_back( Textures::get( "cgi/textures/cloud_st_few.png" ) );
     _textures.push_back( Textures::get( "cgi/textures/cloud_st_sct.png" ) );
     _textures.push_back( Textures::get( "cgi/textures/cloud_st_bkn.png" ) );
     _textures.push_back( Textures::get( "cgi/textures/cloud_st_ovc.png" ) );
+
+    _switch = new osg::Switch();
+    _root->addChild( _switch.get() );
+
+    _patLayer = new osg::PositionAttitudeTransform();
+    _switch->addChild( _patLayer.get() );
+
+    _switch->setAllChildrenOff();
+
+    create();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -65,152 +142,161 @@ void CloudsLayer::update()
     Module::update();
     /////////////////
 
-    if ( Data::get()->cgi.environment.clouds.type == Data::CGI::Environment::Clouds::Layer )
+    if ( Data::get()->cgi.environment.clouds.type == Data::CGI::Environment::Clouds::Layer
+      && Data::get()->cgi.environment.clouds.data.layer.cover != Data::CGI::Environment::Clouds::Data::Layer::SKC )
     {
-        if ( _framesCounter % 10 == 0 )
-        {
-            _framesCounter = 0;
-
-            if ( !_created
-              || _cover     != Data::get()->cgi.environment.clouds.data.layer.cover
-              || _base_asl  != Data::get()->cgi.environment.clouds.data.layer.base_asl )
-            {
-                _cover     = Data::get()->cgi.environment.clouds.data.layer.cover;
-                _base_asl  = Data::get()->cgi.environment.clouds.data.layer.base_asl;
+        double lat = Data::get()->cgi.camera.latitude;
+        double lon = Data::get()->cgi.camera.longitude;
 
-                create();
-            }
-        }
+        WGS84 wgs_cam( lat, lon, 0.0 );
+        WGS84 wgs_layer( lat, lon, Data::get()->cgi.environment.clouds.data.layer.base_asl );
 
-        _framesCounter++;
-    }
-    else
-    {
-        remove();
-
-        _framesCounter = 0;
-    }
-}
+        if ( _created )
+        {
+            // texture follows the world, so it is shifted by the camera displacement ...
+            osg::Vec3d d_ned = WGS84::r_wgs2ned( _pos_wgs, wgs_cam.getPosition() );
 
-////////////////////////////////////////////////////////////////////////////////
+            // ... and by the clouds drift due to the wind
+            double wind_n = -cos( Data::get()->environment.wind_direction ) * Data::get()->environment.wind_speed;
+            double wind_e = -sin( Data::get()->environment.wind_direction ) * Data::get()->environment.wind_speed;
 
-void CloudsLayer::create()
-{
-    remove();
+            _offset.x() += d_ned.x() - wind_n * CGI_TIME_STEP;
+            _offset.y() += d_ned.y() - wind_e * CGI_TIME_STEP;
 
-    _created = true;
+            // offset is wrapped to keep single precision texture coordinates accurate,
+            // textures are mirrored, so pattern period is twice the tile size
+            _offset.x() -= 2.0 * tile_size * floor( _offset.x() / ( 2.0 * tile_size ) );
+            _offset.y() -= 2.0 * tile_size * floor( _offset.y() / ( 2.0 * tile_size ) );
+        }
+        else
+        {
+            _created = true;
+            _switch->setAllChildrenOn();
+        }
 
-    osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
-    _root->addChild( pat.get() );
+        _pos_wgs = wgs_cam.getPosition();
 
-    WGS84 wgs( Data::get()->cgi.camera.latitude,
-               Data::get()->cgi.camera.longitude,
-               0.0 );
+        if ( _cover != Data::get()->cgi.environment.clouds.data.layer.cover )
+        {
+            setCover( Data::get()->cgi.environment.clouds.data.layer.cover );
+        }
 
-    pat->setAttitude( wgs.getAttitude() );
-    pat->setPosition( wgs.getPosition() );
+        _patLayer->setAttitude( wgs_layer.getAttitude() );
+        _patLayer->setPosition( Origin::toScene( wgs_layer.getPosition() ) );
 
-    createLayer( pat.get(),
-                 Data::get()->cgi.camera.latitude,
-                 Data::get()->cgi.camera.longitude,
-                 _base_asl );
+        _texOffset->set( osg::Vec2( _offset.x() / tile_size, _offset.y() / tile_size ) );
+    }
+    else if ( _created )
+    {
+        _created = false;
+        _switch->setAllChildrenOff();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void CloudsLayer::createLayer( osg::Group *parent, double lat , double lon, double alt  )
+void CloudsLayer::create()
 {
-    osg::Vec3 ctr_wgs = WGS84::geo2wgs( lat, lon, 0.0 );
-
     osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
-    osg::ref_ptr<osg::StateSet> geodeStateSet = geode->getOrCreateStateSet();
+    _patLayer->addChild( geode.get() );
 
     osg::ref_ptr<osg::Geometry> geom = new osg::Geometry();
     geode->addDrawable( geom.get() );
 
     osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
-    osg::ref_ptr<osg::Vec2Array> t = new osg::Vec2Array();
     osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();
 
-    short k = 20;
+    const double radius = CGI_SKYDOME_RADIUS;
+    const double r_earth = WGS84::getRadiusEquatorial();
+    const double step = 2.0 * radius / (double)mesh_cells;
 
-    float x = -CGI_SKYDOME_RADIUS;
-    float y = -CGI_SKYDOME_RADIUS;
+    // layer follows the Earth curvature
+    for ( unsigned short ix = 0; ix < mesh_cells + 1; ix++ )
+    {
+        for ( unsigned short iy = 0; iy < mesh_cells + 1; iy++ )
+        {
+            double x = -radius + step * ix;
+            double y = -radius + step * iy;
+            double z = ( x*x + y*y ) / ( 2.0 * r_earth );
 
-    float dx = 2.0f * CGI_SKYDOME_RADIUS / (float)k;
-    float dy = 2.0f * CGI_SKYDOME_RADIUS / (float)k;
+            osg::Vec3 n_ned( x, y, z - r_earth );
+            n_ned.normalize();
 
-    osg::Vec3 v1_ned;
-    osg::Vec3 v2_ned;
-    osg::Vec3 v1_wgs;
-    osg::Vec3 v2_wgs;
+            v->push_back( osg::Vec3( x, y, z ) );
+            n->push_back( n_ned );
+        }
+    }
 
-    double lat1 = 0.0;
-    double lat2 = 0.0;
-    double lon1 = 0.0;
-    double lon2 = 0.0;
-    double dummy = 0.0;
+    geom->setVertexArray( v.get() );
+    geom->setNormalArray( n.get() );
+    geom->setNormalBinding( osg::Geometry::BIND_PER_VERTEX );
 
-    for ( short ix = 0; ix < k + 1; ix++ )
+    for ( unsigned short ix = 0; ix < mesh_cells; ix++ )
     {
-        y = ( ix % 2 == 0 ) ? -CGI_SKYDOME_RADIUS : CGI_SKYDOME_RADIUS;
+        osg::ref_ptr<osg::DrawElementsUShort> strip =
+                new osg::DrawElementsUShort( osg::PrimitiveSet::TRIANGLE_STRIP );
 
-        for ( short iy = 0; iy < k + 1; iy++ )
+        for ( unsigned short iy = 0; iy < mesh_cells + 1; iy++ )
         {
-            v1_ned.set( x      , y, 0.0f );
-            v2_ned.set( x + dx , y, 0.0f );
+            strip->push_back(   ix       * ( mesh_cells + 1 ) + iy );
+            strip->push_back( ( ix + 1 ) * ( mesh_cells + 1 ) + iy );
+        }
 
-            v1_wgs = WGS84::r_ned2wgs( ctr_wgs, v1_ned );
-            v2_wgs = WGS84::r_ned2wgs( ctr_wgs, v2_ned );
+        geom->addPrimitiveSet( strip.get() );
+    }
 
-            WGS84::wgs2geo( v1_wgs, lat1, lon1, dummy );
-            WGS84::wgs2geo( v2_wgs, lat2, lon2, dummy );
+    // geometry is static, it is only moved with the camera
+    geom->setUseVertexBufferObjects( true );
 
-            v1_wgs = WGS84::geo2wgs( lat1, lon1, alt );
-            v2_wgs = WGS84::geo2wgs( lat2, lon2, alt );
+    _stateSet = geode->getOrCreateStateSet();
 
-            v1_ned = WGS84::r_wgs2ned( ctr_wgs, v1_wgs );
-            v2_ned = WGS84::r_wgs2ned( ctr_wgs, v2_wgs );
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
+    program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
+    _stateSet->setAttributeAndModes( program.get() );
 
-            osg::Vec3f n1 = WGS84::wgs2ned( ctr_wgs, v1_wgs );
-            osg::Vec3f n2 = WGS84::wgs2ned( ctr_wgs, v2_wgs );
+    _texOffset = new osg::Uniform( "texOffset" , osg::Vec2( 0.0f, 0.0f ) );
 
-            n1.normalize();
-            n2.normalize();
+    // covers textures are used as they are, coverage and density might be
+    // modified to thin the layer without changing the texture
+    _stateSet->addUniform( _texOffset.get() );
+    _stateSet->addUniform( new osg::Uniform( "coverage"  , 1.0f ) );
+    _stateSet->addUniform( new osg::Uniform( "density"   , 1.0f ) );
+    _stateSet->addUniform( new osg::Uniform( "cloudsTex" , 0 ) );
+    _stateSet->addUniform( new osg::Uniform( "tileSize"  , (float)tile_size ) );
+    _stateSet->addUniform( new osg::Uniform( "radius"    , (float)radius ) );
 
-            v->push_back( v1_ned );
-            v->push_back( v2_ned );
+    // uniforms and texture are modified between frames
+    _stateSet->setDataVariance( osg::Object::DYNAMIC );
 
-            n->push_back( n1 );
-            n->push_back( n2 );
+    // material
+    osg::ref_ptr<osg::Material> material = new osg::Material();
+    material->setColorMode( osg::Material::OFF );
+    material->setAmbient( osg::Material::FRONT_AND_BACK, osg::Vec4f( 0.8f, 0.8f, 0.8f, 1.0f ) );
+    material->setDiffuse( osg::Material::FRONT_AND_BACK, osg::Vec4f( 1.0f, 1.0f, 1.0f, 1.0f ) );
 
-            if ( iy % 2 == 0 )
-            {
-                t->push_back( osg::Vec2( 0, 0 ) );
-                t->push_back( osg::Vec2( 0, 1 ) );
-            }
-            else
-            {
-                t->push_back( osg::Vec2( 1, 0 ) );
-                t->push_back( osg::Vec2( 1, 1 ) );
-            }
+    _stateSet->setAttribute( material.get() );
 
-            y += ( ix % 2 == 0 ) ? dy : -dy;
-        }
+    // alpha blending
+    osg::ref_ptr<osg::AlphaFunc> alphaFunc = new osg::AlphaFunc();
+    osg::ref_ptr<osg::BlendFunc> blendFunc = new osg::BlendFunc();
+    alphaFunc->setFunction( osg::AlphaFunc::GEQUAL, 0.01 );
 
-        x += dx;
-    }
+    _stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
+    _stateSet->setAttributeAndModes( blendFunc.get(), osg::StateAttribute::ON );
+    _stateSet->setAttributeAndModes( alphaFunc.get(), osg::StateAttribute::ON );
+    _stateSet->setMode( GL_BLEND, osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+    _stateSet->setRenderBinDetails( CGI_DEPTH_SORTED_BIN_CLOUDS, "DepthSortedBin" );
+}
 
-    geom->setNormalArray( n.get() );
-    geom->setNormalBinding( osg::Geometry::BIND_PER_VERTEX );
-    geom->setVertexArray( v.get() );
-    geom->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
-    geom->setTexCoordArray( 0, t.get() );
+////////////////////////////////////////////////////////////////////////////////
+
+void CloudsLayer::setCover( Cover cover )
+{
+    _cover = cover;
 
-    // texture
     osg::ref_ptr<osg::Texture2D> texture;
+
     switch ( _cover )
     {
     case Data::CGI::Environment::Clouds::Data::Layer::FEW:
@@ -230,36 +316,6 @@ void CloudsLayer::createLayer( osg::Group *parent, double lat , double lon, doub
         texture = _textures.at( 3 ).get();
         break;
     }
-    geodeStateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON );
-
-    // material
-    osg::ref_ptr<osg::Material> material = new osg::Material();
-    material->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
-    material->setAmbient( osg::Material::FRONT, osg::Vec4f( 0.8f, 0.8f, 0.8f, 1.0f ) );
-    material->setDiffuse( osg::Material::FRONT, osg::Vec4f( 1.0f, 1.0f, 1.0f, 1.0f ) );
 
-    geodeStateSet->setAttribute( material.get() );
-
-    // alpha blending
-    osg::ref_ptr<osg::AlphaFunc> alphaFunc = new osg::AlphaFunc();
-    osg::ref_ptr<osg::BlendFunc> blendFunc = new osg::BlendFunc();
-    alphaFunc->setFunction( osg::AlphaFunc::GEQUAL, 0.01 );
-
-    geodeStateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-    geodeStateSet->setAttributeAndModes( blendFunc.get(), osg::StateAttribute::ON );
-    geodeStateSet->setAttributeAndModes( alphaFunc.get(), osg::StateAttribute::ON );
-    geodeStateSet->setMode( GL_BLEND, osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
-    geodeStateSet->setRenderBinDetails( CGI_DEPTH_SORTED_BIN_CLOUDS, "DepthSortedBin" );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void CloudsLayer::remove()
-{
-    _created = false;
-
-    if ( _root->getNumChildren() > 0 )
-    {
-        _root->removeChildren( 0, _root->getNumChildren() );
-    }
+    _stateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON );
 }
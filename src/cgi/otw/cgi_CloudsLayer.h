@@ -24,6 +24,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <osg/PositionAttitudeTransform>
+#include <osg/Switch>
+#include <osg/Uniform>
+#include <osg/Vec2d>
+
 #include <Data.h>
 
 #include <cgi/cgi_Module.h>
@@ -34,7 +39,16 @@
 namespace cgi
 {
 
-/** @brief Layer clouds class. */
+/**
+ * @brief Layer clouds class.
+ *
+ * Layer is a single static mesh created once and kept centered at the camera
+ * position at the clouds base altitude. Mesh is never regenerated, instead
+ * texture coordinates are computed by the vertex shader from the layer local
+ * position and the texture offset which follows camera displacement and wind
+ * drift, so the layer appears infinite and fixed to the world. Cover change
+ * only swaps the texture, coverage and density are passed as uniforms.
+ */
 class CloudsLayer : public Module
 {
 public:
@@ -52,18 +66,28 @@ public:
 
 private:
 
-    Textures::List _textures;   ///<
+    static const char _frag[];      ///< clouds layer fragment shader
+    static const char _vert[];      ///< clouds layer vertex shader
+
+    Textures::List _textures;       ///< covers textures
+
+    osg::ref_ptr<osg::Switch> _switch;                          ///< clouds layer switch
+    osg::ref_ptr<osg::PositionAttitudeTransform> _patLayer;     ///< clouds layer local frame
+
+    osg::ref_ptr<osg::StateSet> _stateSet;  ///< clouds layer state set
+
+    osg::ref_ptr<osg::Uniform> _texOffset;  ///< [-] texture coordinates offset
+
+    osg::Vec3d _pos_wgs;            ///< [m] previous camera position projected on sea level expressed in WGS
+    osg::Vec2d _offset;             ///< [m] texture offset (north, east), wrapped to the texture pattern period
 
-    Cover _cover;               ///< cover
-    float _base_asl;            ///< [m] clouds base above mean sea level
+    Cover _cover;                   ///< cover
 
-    short _framesCounter;       ///<
-    bool _created;              ///<
+    bool _created;                  ///< specifies if layer is shown
 
     void create();
-    void createLayer( osg::Group *parent, double lat, double lon, double alt );
 
-    void remove();
+    void setCover( Cover cover );
 };
 
 } // end of cgi namespace
@@ -22,11 +22,19 @@
 
 #include <cgi/otw/cgi_Entities.h>
 
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+#include <Data.h>
+
+#include <cgi/cgi_CollisionMesh.h>
 #include <cgi/cgi_Models.h>
 #include <cgi/cgi_WGS84.h>
 
 #include <cgi/otw/cgi_Reflection.h>
 
+#include <sim/Path.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace cgi;
@@ -45,7 +53,17 @@ Entities::Entities( const Module *parent ) :
     addEntity( _patLCS.get(), "cgi/entities/lcs.osgb"  );
     //addEntity( _patCVN.get(), "cgi/entities/cvn.osgb" );
 
-    WGS84::setLatLonAltHdg( _patLCS.get(), osg::DegreesToRadians( 21.3529540 ), osg::DegreesToRadians( -157.9685000 ), 0.0, osg::DegreesToRadians( 180.0 ) );
+    const double lat_lcs = osg::DegreesToRadians( 21.3529540 );
+    const double lon_lcs = osg::DegreesToRadians( -157.9685000 );
+    const double hdg_lcs = osg::DegreesToRadians( 180.0 );
+
+    WGS84::setLatLonAltHdg( _patLCS.get(), lat_lcs, lon_lcs, 0.0, hdg_lcs );
+
+    // deck is available to FDM landing gear
+    CollisionMesh::add( Models::get( "cgi/entities/lcs.osgb" ), lat_lcs, lon_lcs, 0.0, hdg_lcs );
+
+    _switchAircrafts = new osg::Switch();
+    _root->addChild( _switchAircrafts.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +77,9 @@ void Entities::update()
     /////////////////
     Module::update();
     /////////////////
+
+    updateAircrafts();
+    updateTypes();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -69,8 +90,188 @@ void Entities::addEntity( osg::PositionAttitudeTransform *pat, const char *file
 
     if ( node.valid() )
     {
-        pat->addChild( node.get() );
+        Type &type = getType( file, file );
+
+        pat->addChild( type.lod.get() );
 
         Reflection::create( node.get(), pat );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+Entities::Type& Entities::getType( const std::string &key, const std::string &modelFile )
+{
+    Types::iterator it = _types.find( key );
+
+    if ( it != _types.end() )
+    {
+        return it->second;
+    }
+
+    Type &type = _types[ key ];
+
+    type.model = new osg::PositionAttitudeTransform();
+    type.lod   = new osgSim::Impostor();
+    type.modelFile  = modelFile;
+    type.simplified = false;
+
+    osg::ref_ptr<osg::Node> node = Models::getAsync( modelFile.c_str() );
+
+    if ( node.valid() ) type.model->addChild( node.get() );
+
+    // full detail model is displayed in the whole range until simplified
+    // model is generated
+    type.lod->addChild( type.model.get(), 0.0f, CGI_ENTITIES_LOD_FAR );
+    type.lod->setImpostorThreshold( CGI_ENTITIES_IMPOSTOR_RANGE );
+
+    return type;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::reloadAircraftModel()
+{
+    _aircraftFile = Data::get()->ownship.aircraftFile;
+    _aircraftType = NULLPTR;
+
+    Types::iterator it = _types.find( _aircraftFile );
+
+    if ( it != _types.end() )
+    {
+        _aircraftType = it->second.lod.get();
+    }
+    else
+    {
+        fdm::XmlDoc doc( Path::get( _aircraftFile ).c_str() );
+
+        if ( doc.isOpen() )
+        {
+            fdm::XmlNode rootNode = doc.getRootNode();
+
+            if ( rootNode.isValid() )
+            {
+                std::string model;
+
+                if ( FDM_SUCCESS == fdm::XmlUtils::read( rootNode, &model, "model" ) )
+                {
+                    // aircraft types are keyed by aircraft file due to model offset
+                    Type &type = getType( _aircraftFile, model );
+
+                    fdm::XmlNode nodeOffset = rootNode.getFirstChildElement( "offset" );
+
+                    if ( nodeOffset.isValid() )
+                    {
+                        fdm::XmlNode nodeShift = nodeOffset.getFirstChildElement( "shift" );
+                        fdm::XmlNode nodeAngle = nodeOffset.getFirstChildElement( "angle" );
+
+                        double x = 0.0;
+                        double y = 0.0;
+                        double z = 0.0;
+
+                        if ( nodeShift.isValid()
+                          && FDM_SUCCESS == fdm::XmlUtils::read( nodeShift, &x, "x" )
+                          && FDM_SUCCESS == fdm::XmlUtils::read( nodeShift, &y, "y" )
+                          && FDM_SUCCESS == fdm::XmlUtils::read( nodeShift, &z, "z" ) )
+                        {
+                            type.model->setPosition( osg::Vec3( x, y, z ) );
+                        }
+
+                        if ( nodeAngle.isValid()
+                          && FDM_SUCCESS == fdm::XmlUtils::read( nodeAngle, &x, "x" )
+                          && FDM_SUCCESS == fdm::XmlUtils::read( nodeAngle, &y, "y" )
+                          && FDM_SUCCESS == fdm::XmlUtils::read( nodeAngle, &z, "z" ) )
+                        {
+                            type.model->setAttitude( osg::Quat( x, osg::X_AXIS,
+                                                                y, osg::Y_AXIS,
+                                                                z, osg::Z_AXIS ) );
+                        }
+                    }
+
+                    _aircraftType = type.lod.get();
+                }
+            }
+        }
+    }
+
+    // all aircraft share the same type subgraph
+    for ( Aircrafts::iterator it = _aircrafts.begin(); it != _aircrafts.end(); ++it )
+    {
+        (*it)->removeChildren( 0, (*it)->getNumChildren() );
+
+        if ( _aircraftType.valid() ) (*it)->addChild( _aircraftType.get() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::updateAircrafts()
+{
+    const Data::Entities &entities = Data::get()->entities;
+
+    if ( entities.count > 0 && 0 != _aircraftFile.compare( Data::get()->ownship.aircraftFile ) )
+    {
+        reloadAircraftModel();
+    }
+
+    while ( _aircrafts.size() < entities.count )
+    {
+        osg::ref_ptr<osg::PositionAttitudeTransform> pat = new osg::PositionAttitudeTransform();
+
+        // all aircraft share the same type subgraph
+        if ( _aircraftType.valid() ) pat->addChild( _aircraftType.get() );
+
+        _switchAircrafts->addChild( pat.get() );
+        _aircrafts.push_back( pat );
+    }
+
+    for ( unsigned int i = 0; i < _aircrafts.size(); i++ )
+    {
+        bool visible = i < entities.count;
+
+        _switchAircrafts->setValue( i, visible );
+
+        if ( visible )
+        {
+            const Data::Entities::Entity &entity = entities.entity[ i ];
+
+            _aircrafts[ i ]->setAttitude( osg::Quat( entity.att_ex_wgs,
+                                                     entity.att_ey_wgs,
+                                                     entity.att_ez_wgs,
+                                                     entity.att_e0_wgs ) );
+
+            _aircrafts[ i ]->setPosition( osg::Vec3d( entity.pos_x_wgs,
+                                                      entity.pos_y_wgs,
+                                                      entity.pos_z_wgs ) );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Entities::updateTypes()
+{
+    for ( Types::iterator it = _types.begin(); it != _types.end(); ++it )
+    {
+        Type &type = it->second;
+
+        if ( !type.simplified )
+        {
+            // null until the model is loaded
+            osg::ref_ptr<osg::Node> node = Models::getSimplified( type.modelFile.c_str() );
+
+            if ( !node.valid() ) continue;
+
+            // simplified model shares type model offset
+            osg::ref_ptr<osg::PositionAttitudeTransform> simplified = new osg::PositionAttitudeTransform();
+            simplified->setPosition( type.model->getPosition() );
+            simplified->setAttitude( type.model->getAttitude() );
+            simplified->addChild( node.get() );
+
+            type.lod->setRange( 0, 0.0f, CGI_ENTITIES_LOD_NEAR );
+            type.lod->addChild( simplified.get(), CGI_ENTITIES_LOD_NEAR, CGI_ENTITIES_LOD_FAR );
+
+            type.simplified = true;
+        }
+    }
+}
@@ -24,7 +24,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include <osg/PositionAttitudeTransform>
+#include <osg/Switch>
+
+#include <osgSim/Impostor>
 
 #include <cgi/cgi_Module.h>
 
@@ -35,6 +42,13 @@ namespace cgi
 
 /**
  * @brief Entities.
+ *
+ * Besides static entities, other simulated aircraft (e.g. wingmen) are
+ * rendered using ownship aircraft model.
+ *
+ * Entities of the same type (model) share one LOD subgraph, so adding an
+ * entity adds only its transform. Other simulated aircraft are updated in
+ * a single pass over the entities data array.
  */
 class Entities : public Module
 {
@@ -51,10 +65,52 @@ public:
 
 private:
 
+    /**
+     * @brief Entity type, subgraph shared by all the entities of the type.
+     *
+     * Full detail model is displayed up to CGI_ENTITIES_LOD_NEAR, then
+     * simplified model (see Models::getSimplified(), generated once the model
+     * is loaded) is displayed up to CGI_ENTITIES_LOD_FAR. Beyond CGI_ENTITIES_IMPOSTOR_RANGE simplified
+     * model is rendered as an impostor billboard.
+     */
+    struct Type
+    {
+        osg::ref_ptr<osg::PositionAttitudeTransform> model; ///< full detail model with offset
+        osg::ref_ptr<osgSim::Impostor> lod;                 ///< LOD node, shared by all the entities of the type
+        std::string modelFile;                              ///< model file
+        bool simplified;                                    ///< specifies if simplified model has been generated
+    };
+
+    typedef std::map< std::string, Type > Types;
+    typedef std::vector< osg::ref_ptr<osg::PositionAttitudeTransform> > Aircrafts;
+
     osg::ref_ptr<osg::PositionAttitudeTransform> _patLCS;   ///< Littoral Combat Ship
     osg::ref_ptr<osg::PositionAttitudeTransform> _patCVN;   ///< Supercarrier
 
+    osg::ref_ptr<osg::Switch> _switchAircrafts;             ///< other simulated aircraft switch
+    osg::ref_ptr<osg::Node> _aircraftType;                  ///< aircraft type LOD node, shared by all other simulated aircraft
+
+    Types _types;                                           ///< entity types keyed by model (or aircraft) file
+    Aircrafts _aircrafts;                                   ///< other simulated aircraft
+
+    std::string _aircraftFile;                              ///< aircraft file of the loaded model
+
     void addEntity( osg::PositionAttitudeTransform *pat, const char *file );
+
+    /**
+     * @brief Returns entity type, creates it if necessary.
+     * @param key type key
+     * @param modelFile model file
+     * @return entity type
+     */
+    Type& getType( const std::string &key, const std::string &modelFile );
+
+    void reloadAircraftModel();
+
+    void updateAircrafts();
+
+    /** Generates simplified models of the types which have been loaded. */
+    void updateTypes();
 };
 
 } // end of cgi namespace
@@ -26,9 +26,11 @@
 
 #include <cgi/cgi_Colors.h>
 #include <cgi/cgi_Defines.h>
+#include <cgi/cgi_FrameStats.h>
 
 #include <cgi/otw/cgi_Clouds.h>
 #include <cgi/otw/cgi_Ownship.h>
+#include <cgi/otw/cgi_Reflection.h>
 #include <cgi/otw/cgi_Scenery.h>
 #include <cgi/otw/cgi_SkyDome.h>
 
@@ -97,13 +99,22 @@ FogScene::FogScene( const Module *parent ) :
     stateSet->setMode( GL_FOG, osg::StateAttribute::ON );
 #   endif // SIM_TEST_WORLD
 
+#   if ( CGI_SHADOW_QUALITY > 0 ) && !defined(SIM_TEST_WORLD)
+    createShadowMaps();
+#   endif
+
     Clouds  *clouds  = new Clouds  ( this );
     Scenery *scenery = new Scenery ( this );
     Ownship *ownship = new Ownship ( this, scenery );
 
+    // clouds neither cast nor receive shadows
+    clouds->getNode()->setNodeMask( ~( CGI_SHADOW_CAST_MASK | CGI_SHADOW_RECEIVE_MASK ) );
+
     addChild( clouds  );
     addChild( ownship );
     addChild( scenery );
+
+    _root->addChild( Reflection::instance()->getNode() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -112,27 +123,88 @@ FogScene::~FogScene() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void FogScene::addChild( Module *child )
+{
+    if ( child && _shadowedScene.valid() )
+    {
+        _children.push_back( child );
+        _shadowedScene->addChild( child->getNode() );
+    }
+    else
+    {
+        Module::addChild( child );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void FogScene::update()
 {
     /////////////////
     Module::update();
     /////////////////
 
+    CGI_FRAME_STATS_ZONE( ModuleFogScene, "FogScene::update" );
+
+    Reflection::instance()->update();
+
 #   ifndef SIM_TEST_WORLD
     float visibility = Data::get()->cgi.environment.visibility;
     visibility = std::min( std::max( visibility, 1.0f ), 0.9f * CGI_SKYDOME_RADIUS );
 
-    osg::ref_ptr<osg::StateSet> stateSet = _root->getOrCreateStateSet();
-
     float elevation_deg = osg::RadiansToDegrees( Data::get()->cgi.skyDome.sunElev );
 
-    _fog->setMode( osg::Fog::LINEAR );
-    _fog->setDensity( 0.5f );
-    _fog->setColor( getFogColor( elevation_deg, visibility ) );
-    _fog->setStart( 0.0f );
-    _fog->setEnd( visibility );
+    osg::Vec4 color = getFogColor( elevation_deg, visibility );
 
-    stateSet->setAttributeAndModes( _fog.get(), osg::StateAttribute::ON );
-    stateSet->setMode( GL_FOG, osg::StateAttribute::ON );
+    // fog attribute is touched only when it actually changes, which is rare
+    // since both visibility and fog color (stepped with Sun elevation) are
+    // changing slowly
+    if ( color != _fog->getColor() )
+    {
+        _fog->setColor( color );
+    }
+
+    if ( visibility != _fog->getEnd() )
+    {
+        _fog->setEnd( visibility );
+    }
 #   endif // SIM_TEST_WORLD
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FogScene::setLightSun( osg::Light *light )
+{
+    if ( _shadowMap.valid() )
+    {
+        _shadowMap->setUserLight( light );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FogScene::createShadowMaps()
+{
+    unsigned int resolution = 1024;
+    int cascades = 2;
+
+    switch ( CGI_SHADOW_QUALITY )
+    {
+        case 1:  resolution = 1024; cascades = 2; break;
+        case 2:  resolution = 2048; cascades = 3; break;
+        default: resolution = 4096; cascades = 4; break;
+    }
+
+    _shadowMap = new osgShadow::ParallelSplitShadowMap( NULLPTR, cascades );
+
+    _shadowMap->setTextureResolution( resolution );
+    _shadowMap->setMaxFarDistance( CGI_SHADOW_FAR );
+    _shadowMap->setPolygonOffset( osg::Vec2( 1.0f, 4.0f ) );
+
+    _shadowedScene = new osgShadow::ShadowedScene();
+    _shadowedScene->setCastsShadowTraversalMask( CGI_SHADOW_CAST_MASK );
+    _shadowedScene->setReceivesShadowTraversalMask( CGI_SHADOW_RECEIVE_MASK );
+    _shadowedScene->setShadowTechnique( _shadowMap.get() );
+
+    _root->addChild( _shadowedScene.get() );
+}
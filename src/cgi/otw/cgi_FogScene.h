@@ -25,6 +25,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <osg/Fog>
+#include <osg/Light>
+
+#include <osgShadow/ParallelSplitShadowMap>
+#include <osgShadow/ShadowedScene>
 
 #include <cgi/cgi_Module.h>
 
@@ -61,12 +65,26 @@ public:
     /** @brief Destructor. */
     virtual ~FogScene();
 
+    /** @brief Adds child to the module. */
+    void addChild( Module *child );
+
     /** @brief Updates fog scene. */
     void update();
 
+    /**
+     * @brief Sets Sun light used by shadow maps.
+     * @param light Sun light expressed in world coordinates
+     */
+    void setLightSun( osg::Light *light );
+
 private:
 
     osg::ref_ptr<osg::Fog> _fog;
+
+    osg::ref_ptr<osgShadow::ShadowedScene> _shadowedScene;          ///< shadowed scene, valid if shadow maps are enabled
+    osg::ref_ptr<osgShadow::ParallelSplitShadowMap> _shadowMap;     ///< cascaded shadow maps
+
+    void createShadowMaps();
 };
 
 } // end of cgi namespace
@@ -22,6 +22,7 @@
 
 #include <cgi/otw/cgi_Landmark.h>
 
+#include <cgi/cgi_CollisionMesh.h>
 #include <cgi/cgi_Models.h>
 #include <cgi/cgi_WGS84.h>
 
@@ -34,7 +35,7 @@ using namespace cgi;
 ////////////////////////////////////////////////////////////////////////////////
 
 Landmark::Landmark( const char *file, double lat, double lon, double alt,
-                    double hdg, bool reflection,
+                    double hdg, bool reflection, bool collision,
                     const Module *parent ) :
     Module( parent )
 {
@@ -53,6 +54,11 @@ Landmark::Landmark( const char *file, double lat, double lon, double alt,
         {
             Reflection::create( node.get(), _pat.get() );
         }
+
+        if ( collision )
+        {
+            CollisionMesh::add( node.get(), lat, lon, alt, hdg );
+        }
     }
 }
 
@@ -40,9 +40,12 @@ class Landmark : public Module
 {
 public:
 
-    /** @brief Constructor. */
+    /**
+     * @brief Constructor.
+     * @param collision specifies if landmark model is added to FDM collision geometry
+     */
     Landmark( const char *file, double lat, double lon, double alt,
-              double hdg, bool reflection,
+              double hdg, bool reflection, bool collision = false,
               const Module *parent = NULLPTR );
 
     /** @brief Destructor. */
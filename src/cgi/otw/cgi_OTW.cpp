@@ -44,9 +44,13 @@ OTW::OTW( const Module *parent ) :
     stateSet->setMode( GL_DEPTH_TEST     , osg::StateAttribute::ON  );
     stateSet->setMode( GL_DITHER         , osg::StateAttribute::OFF );
 
-    addChild( new FogScene( this ) );
+    FogScene *fogScene = new FogScene( this );
+    addChild( fogScene );
 #   ifndef SIM_TEST_WORLD
-    addChild( new SkyDome( this ) );
+    SkyDome *skyDome = new SkyDome( this );
+    addChild( skyDome );
+
+    fogScene->setLightSun( skyDome->getLightShadow() );
 #   endif
 }
 
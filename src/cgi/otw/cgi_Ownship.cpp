@@ -22,14 +22,13 @@
 
 #include <cgi/otw/cgi_Ownship.h>
 
+#include <cfloat>
 #include <sstream>
 
 #include <osg/AlphaFunc>
 #include <osg/BlendFunc>
 #include <osg/Depth>
-#include <osg/Geode>
-#include <osg/Geometry>
-#include <osg/LineWidth>
+#include <osg/LOD>
 
 #include <fdm/utils/fdm_Units.h>
 #include <fdm/xml/fdm_XmlDoc.h>
@@ -40,7 +39,9 @@
 #include <cgi/cgi_Colors.h>
 #include <cgi/cgi_Defines.h>
 #include <cgi/cgi_FindNode.h>
+#include <cgi/cgi_FrameStats.h>
 #include <cgi/cgi_Models.h>
+#include <cgi/cgi_Origin.h>
 
 #include <sim/Path.h>
 
@@ -58,6 +59,9 @@ Ownship::Ownship( const Module *parent, Scenery *scenery ) :
     _rotor  ( NULLPTR ),
     _vector ( NULLPTR ),
 
+    _trace_1 ( NULLPTR ),
+    _trace_2 ( NULLPTR ),
+
     _ab_angle ( 0.0 )
 {
     _vector = new Vector();
@@ -78,8 +82,16 @@ Ownship::Ownship( const Module *parent, Scenery *scenery ) :
     _switchRibbons = new osg::Switch();
     _patRibbons->addChild( _switchRibbons.get() );
 
-    _trace_1 = new osg::Vec3Array();
-    _trace_2 = new osg::Vec3Array();
+    _trace_1 = new Trace( CGI_TRACE_CHUNK_SIZE, CGI_TRACE_MAX_CHUNKS,
+                          CGI_TRACE_MIN_SPACING, CGI_TRACE_MAX_SPACING, CGI_TRACE_MAX_ANGLE );
+    _trace_2 = new Trace( CGI_TRACE_CHUNK_SIZE, CGI_TRACE_MAX_CHUNKS,
+                          CGI_TRACE_MIN_SPACING, CGI_TRACE_MAX_SPACING, CGI_TRACE_MAX_ANGLE );
+
+    _trace_1->setLineWidth( 2.0f );
+    _trace_2->setLineWidth( 2.0f );
+
+    _switchRibbons->addChild( _trace_1->getNode() );
+    _switchRibbons->addChild( _trace_2->getNode() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -88,12 +100,17 @@ Ownship::~Ownship()
 {
     DELPTR( _rotor  );
     DELPTR( _vector );
+
+    DELPTR( _trace_1 );
+    DELPTR( _trace_2 );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Ownship::update()
 {
+    CGI_FRAME_STATS_ZONE( ModuleOwnship, "Ownship::update" );
+
     if ( 0 != strcmp( _aircraftFile.c_str(), Data::get()->ownship.aircraftFile ) )
     {
         reload();
@@ -108,17 +125,17 @@ void Ownship::update()
         _switch->setAllChildrenOn();
     }
 
-    _att_wgs = osg::Quat( Data::get()->ownship.att_ex_wgs,
-                          Data::get()->ownship.att_ey_wgs,
-                          Data::get()->ownship.att_ez_wgs,
-                          Data::get()->ownship.att_e0_wgs );
+    _att_wgs = osg::Quat( Data::get()->cgi.ownship.att_ex_wgs,
+                          Data::get()->cgi.ownship.att_ey_wgs,
+                          Data::get()->cgi.ownship.att_ez_wgs,
+                          Data::get()->cgi.ownship.att_e0_wgs );
 
-    _pos_wgs = osg::Vec3d( Data::get()->ownship.pos_x_wgs,
-                           Data::get()->ownship.pos_y_wgs,
-                           Data::get()->ownship.pos_z_wgs );
+    _pos_wgs = osg::Vec3d( Data::get()->cgi.ownship.pos_x_wgs,
+                           Data::get()->cgi.ownship.pos_y_wgs,
+                           Data::get()->cgi.ownship.pos_z_wgs );
 
     _pat->setAttitude( _att_wgs );
-    _pat->setPosition( _pos_wgs );
+    _pat->setPosition( Origin::toScene( _pos_wgs ) );
 
     updateModel();
     updateTraces();
@@ -159,53 +176,66 @@ void Ownship::loadModel( const char *modelFile )
 
     if ( model.valid() )
     {
-        _patOffset->addChild( model.get() );
+        // simplified model is displayed when ownship is small on screen,
+        // e.g. in world view
+        osg::ref_ptr<osg::LOD> lod = new osg::LOD();
+        lod->setRangeMode( osg::LOD::PIXEL_SIZE_ON_SCREEN );
+        lod->addChild( model.get(), CGI_MODELS_LOD_PIXELS, FLT_MAX );
+
+        osg::ref_ptr<osg::Node> simplified = Models::getSimplified( modelFile );
+
+        if ( simplified.valid() )
+        {
+            lod->addChild( simplified.get(), 0.0f, CGI_MODELS_LOD_PIXELS );
+        }
+
+        _patOffset->addChild( lod.get() );
 
-        _aileronL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "AileronL" ) );
-        _aileronR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "AileronR" ) );
+        _aileronL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "AileronL" ) );
+        _aileronR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "AileronR" ) );
 
-        _elevatorL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "ElevatorL" ) );
-        _elevatorR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "ElevatorR" ) );
+        _elevatorL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "ElevatorL" ) );
+        _elevatorR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "ElevatorR" ) );
 
         if ( !_elevatorL.valid() )
         {
-            _elevatorL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "Elevator" ) );
+            _elevatorL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "Elevator" ) );
         }
 
-        _rudderL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "RudderL" ) );
-        _rudderR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "RudderR" ) );
+        _rudderL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "RudderL" ) );
+        _rudderR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "RudderR" ) );
 
         if ( !_rudderL.valid() )
         {
-            _rudderL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "Rudder" ) );
+            _rudderL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "Rudder" ) );
         }
 
-        _elevonL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "ElevonL" ) );
-        _elevonR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "ElevonR" ) );
+        _elevonL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "ElevonL" ) );
+        _elevonR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "ElevonR" ) );
 
-        _flaperonL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlaperonL" ) );
-        _flaperonR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlaperonR" ) );
+        _flaperonL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlaperonL" ) );
+        _flaperonR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlaperonR" ) );
 
-        _flapL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlapTEL" ) );
-        _flapR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlapTER" ) );
+        _flapL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlapTEL" ) );
+        _flapR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlapTER" ) );
 
         if ( !_flapL.valid() && !_flapR.valid() )
         {
-            _flapL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlapL" ) );
-            _flapR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlapR" ) );
+            _flapL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlapL" ) );
+            _flapR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlapR" ) );
         }
 
-        _lefL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlapLEL" ) );
-        _lefR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "FlapLER" ) );
+        _lefL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlapLEL" ) );
+        _lefR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "FlapLER" ) );
 
         if ( !_lefL.valid() && !_lefR.valid() )
         {
-            _lefL = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "LEFL" ) );
-            _lefR = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "LEFR" ) );
+            _lefL = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "LEFL" ) );
+            _lefR = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "LEFR" ) );
         }
 
         // landing gear
-        _landingGear = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "LandingGear" ) );
+        _landingGear = dynamic_cast<osg::Switch*>( Models::findFirst( model, "LandingGear" ) );
 
         for ( unsigned int i = 0; i < CGI_MAX_LANDING_GEAR_ELEMENTS; i++ )
         {
@@ -213,7 +243,7 @@ void Ownship::loadModel( const char *modelFile )
             ss << "LandingGear" << ( i + 1 );
 
             osg::ref_ptr<osg::PositionAttitudeTransform> gearElement =
-                    dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, ss.str().c_str() ) );
+                    dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, ss.str().c_str() ) );
 
             if ( gearElement.valid() )
             {
@@ -232,7 +262,7 @@ void Ownship::loadModel( const char *modelFile )
             ss << "Flap" << ( i + 1 );
 
             osg::ref_ptr<osg::PositionAttitudeTransform> flapElement =
-                    dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, ss.str().c_str() ) );
+                    dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, ss.str().c_str() ) );
 
             if ( flapElement.valid() )
             {
@@ -251,7 +281,7 @@ void Ownship::loadModel( const char *modelFile )
             ss << "Airbrake" << ( i + 1 );
 
             osg::ref_ptr<osg::PositionAttitudeTransform> abrkElement =
-                    dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, ss.str().c_str() ) );
+                    dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, ss.str().c_str() ) );
 
             if ( abrkElement.valid() )
             {
@@ -264,28 +294,28 @@ void Ownship::loadModel( const char *modelFile )
         }
 
         // propellers
-        _propeller1 = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "Propeller1" ) );
-        _propeller2 = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "Propeller2" ) );
-        _propeller3 = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "Propeller3" ) );
-        _propeller4 = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "Propeller4" ) );
+        _propeller1 = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "Propeller1" ) );
+        _propeller2 = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "Propeller2" ) );
+        _propeller3 = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "Propeller3" ) );
+        _propeller4 = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "Propeller4" ) );
 
         if ( !_propeller1.valid() || !_propeller2.valid() )
         {
-            _propeller1 = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "PropellerL" ) );
-            _propeller2 = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "PropellerR" ) );
+            _propeller1 = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "PropellerL" ) );
+            _propeller2 = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "PropellerR" ) );
         }
 
         if ( !_propeller1.valid() )
         {
-            _propeller1 = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "Propeller" ) );
+            _propeller1 = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "Propeller" ) );
         }
 
         // main and tail rotor
-        _mainRotor = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "MainRotor" ) );
-        _tailRotor = dynamic_cast<osg::PositionAttitudeTransform*>( FindNode::findFirst( model, "TailRotor" ) );
+        _mainRotor = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "MainRotor" ) );
+        _tailRotor = dynamic_cast<osg::PositionAttitudeTransform*>( Models::findFirst( model, "TailRotor" ) );
 
         // main rotor blades
-        FindNode::Nodes bladeNodes = FindNode::findNodes( model, "BladeHinge" );
+        FindNode::Nodes bladeNodes = Models::findNodes( model, "BladeHinge" );
 
         for ( unsigned int i = 0; i < bladeNodes.size(); i++ )
         {
@@ -303,20 +333,20 @@ void Ownship::loadModel( const char *modelFile )
         }
 
         // afterburner
-        _afterburner1 = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "Afterburner1" ) );
-        _afterburner2 = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "Afterburner2" ) );
-        _afterburner3 = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "Afterburner3" ) );
-        _afterburner4 = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "Afterburner4" ) );
+        _afterburner1 = dynamic_cast<osg::Switch*>( Models::findFirst( model, "Afterburner1" ) );
+        _afterburner2 = dynamic_cast<osg::Switch*>( Models::findFirst( model, "Afterburner2" ) );
+        _afterburner3 = dynamic_cast<osg::Switch*>( Models::findFirst( model, "Afterburner3" ) );
+        _afterburner4 = dynamic_cast<osg::Switch*>( Models::findFirst( model, "Afterburner4" ) );
 
         if ( !_afterburner1.valid() || !_afterburner2.valid() )
         {
-            _afterburner1 = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "AfterburnerL" ) );
-            _afterburner2 = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "AfterburnerR" ) );
+            _afterburner1 = dynamic_cast<osg::Switch*>( Models::findFirst( model, "AfterburnerL" ) );
+            _afterburner2 = dynamic_cast<osg::Switch*>( Models::findFirst( model, "AfterburnerR" ) );
         }
 
         if ( !_afterburner1.valid() )
         {
-            _afterburner1 = dynamic_cast<osg::Switch*>( FindNode::findFirst( model, "Afterburner" ) );
+            _afterburner1 = dynamic_cast<osg::Switch*>( Models::findFirst( model, "Afterburner" ) );
         }
 
         _exhaust1 = initAfterburnerAndGetExhaust( _afterburner1.get() );
@@ -541,6 +571,9 @@ void Ownship::reload()
 
             _double_trace = ( _wing_tip_l.length() + _wing_tip_r.length() ) > 1.0e-9;
 
+            _trace_1->setColor( _double_trace ? Colors::_red : Colors::_black );
+            _trace_2->setColor( Colors::_lime );
+
             fdm::XmlNode rotorNode = rootNode.getFirstChildElement( "rotor" );
 
             if ( rotorNode.isValid() )
@@ -592,11 +625,6 @@ void Ownship::reset()
     _patOffset->setPosition( osg::Vec3() );
     _patOffset->setAttitude( osg::Quat() );
 
-    if ( _switchRibbons->getNumChildren() > 0 )
-    {
-        _switchRibbons->removeChildren( 0, _switchRibbons->getNumChildren() );
-    }
-
     _aileronL  = NULLPTR;
     _aileronR  = NULLPTR;
     _elevatorL = NULLPTR;
@@ -869,86 +897,38 @@ void Ownship::updateAfterburner( double value, osg::Switch *afterburner,
 
 void Ownship::updateTraces()
 {
-    if ( _switchRibbons->getNumChildren() > 0 )
-    {
-        _switchRibbons->removeChildren( 0, _switchRibbons->getNumChildren() );
-    }
-
     if ( Data::get()->stateOut == fdm::DataOut::Idle )
     {
         _trace_1->clear();
         _trace_2->clear();
-
-        if ( _switchRibbons->getNumChildren() > 0 )
-        {
-            _switchRibbons->removeChildren( 0, _switchRibbons->getNumChildren() );
-        }
     }
     else if ( Data::get()->stateOut == fdm::DataOut::Ready )
     {
         _pos_0_wgs = _pos_wgs;
-        _patRibbons->setPosition( _pos_wgs );
     }
     else if ( Data::get()->stateOut == fdm::DataOut::Working )
     {
         if ( _double_trace )
         {
-            _trace_1->push_back( _pos_wgs + _att_wgs * _wing_tip_l - _pos_0_wgs );
-            _trace_2->push_back( _pos_wgs + _att_wgs * _wing_tip_r - _pos_0_wgs );
+            _trace_1->addPoint( _pos_wgs + _att_wgs * _wing_tip_l - _pos_0_wgs );
+            _trace_2->addPoint( _pos_wgs + _att_wgs * _wing_tip_r - _pos_0_wgs );
         }
         else
         {
-            _trace_1->push_back( _pos_wgs - _pos_0_wgs );
+            _trace_1->addPoint( _pos_wgs - _pos_0_wgs );
         }
     }
 
+    // traces points are relative to the trace start, which is placed relative
+    // to the scene origin
+    _patRibbons->setPosition( Origin::toScene( _pos_0_wgs ) );
+
     if ( Data::get()->cgi.show_traces )
     {
         _switchRibbons->setAllChildrenOn();
-
-        if ( _double_trace )
-        {
-            updateTrace( _switchRibbons.get(), _trace_1.get(), Colors::_red  );
-            updateTrace( _switchRibbons.get(), _trace_2.get(), Colors::_lime );
-        }
-        else
-        {
-            updateTrace( _switchRibbons.get(), _trace_1.get(), Colors::_black );
-        }
     }
     else
     {
         _switchRibbons->setAllChildrenOff();
     }
 }
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Ownship::updateTrace( osg::Group *parent, osg::Vec3Array *positions,
-                           const osg::Vec3 &color )
-{
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-    c->push_back( osg::Vec4( color, 1.0f ) );
-
-    geometry->setVertexArray( positions );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, positions->size() ) );
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
-    lineWidth->setWidth( 2.0f );
-
-    geode->getOrCreateStateSet()->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
-}
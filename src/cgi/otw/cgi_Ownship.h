@@ -31,6 +31,7 @@
 #include <fdm/xml/fdm_XmlNode.h>
 
 #include <cgi/cgi_Module.h>
+#include <cgi/cgi_Trace.h>
 
 #include <cgi/otw/cgi_Rotor.h>
 #include <cgi/otw/cgi_Scenery.h>
@@ -88,6 +89,9 @@ private:
     Rotor  *_rotor;         ///< rotor
     Vector *_vector;        ///< vector
 
+    Trace *_trace_1;        ///< left wing tip or center of gravity trace
+    Trace *_trace_2;        ///< right wing tip trace
+
     osg::Quat  _att_wgs;    ///< aircraft attitude
     osg::Vec3d _pos_wgs;    ///< aircraft position
 
@@ -151,9 +155,6 @@ private:
 
     osg::Vec3 _rotor_center;                                    ///< [m] rotor hub center
 
-    osg::ref_ptr<osg::Vec3Array> _trace_1;                      ///<
-    osg::ref_ptr<osg::Vec3Array> _trace_2;                      ///<
-
     double _ab_angle;                                           ///< [rad]
 
     double _hinge_offset;                                       ///< [m] flapping hinge offset from rotor shaft
@@ -182,8 +183,6 @@ private:
                             osg::PositionAttitudeTransform *exhaust );
 
     void updateTraces();
-    void updateTrace( osg::Group *parent, osg::Vec3Array *positions,
-                      const osg::Vec3 &color );
 };
 
 } // end of cgi namespace
@@ -22,6 +22,8 @@
 
 #include <cgi/otw/cgi_Reflection.h>
 
+#include <algorithm>
+
 #include <osg/ClipNode>
 #include <osg/Geode>
 #include <osg/Geometry>
@@ -107,14 +109,158 @@ const char Reflection::_vert[] =
 ////////////////////////////////////////////////////////////////////////////////
 
 void Reflection::create( osg::Node *model, osg::Group *parent )
+{
+    instance()->addSurface( model, parent );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Reflection::Reflection() :
+    _quality ( High ),
+    _cullMask ( CGI_REFLECTION_CULL_MASK ),
+    _interval ( 1 ),
+    _counter ( 0 )
+{
+    _texture = new osg::Texture2D();
+    _texture->setInternalFormat( GL_RGBA );
+    _texture->setFilter( osg::Texture2D::MIN_FILTER, osg::Texture2D::LINEAR );
+    _texture->setFilter( osg::Texture2D::MAG_FILTER, osg::Texture2D::LINEAR );
+
+    _camera = new osg::Camera();
+    _camera->setName( "Reflection" );
+    _camera->setClearColor( osg::Vec4() );
+    _camera->setClearMask( GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT );
+    _camera->setRenderTargetImplementation( osg::Camera::FRAME_BUFFER_OBJECT );
+    _camera->setRenderOrder( osg::Camera::PRE_RENDER );
+    _camera->attach( osg::Camera::COLOR_BUFFER, _texture.get() );
+    _camera->setCullMask( _cullMask );
+    _camera->setNodeMask( 0 );
+
+    osg::ref_ptr<osg::Texture2D> texWaterDUDV = Textures::get( "cgi/textures/water_dudv.png" );
+    texWaterDUDV->setWrap( osg::Texture::WRAP_S, osg::Texture::REPEAT );
+    texWaterDUDV->setWrap( osg::Texture::WRAP_T, osg::Texture::REPEAT );
+    texWaterDUDV->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+    texWaterDUDV->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+    osg::ref_ptr<osg::Texture2D> texWaterNM = Textures::get( "cgi/textures/water_nm.png" );
+    texWaterNM->setWrap( osg::Texture::WRAP_S, osg::Texture::REPEAT );
+    texWaterNM->setWrap( osg::Texture::WRAP_T, osg::Texture::REPEAT );
+    texWaterNM->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
+    texWaterNM->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
+
+    _stateSet = new osg::StateSet();
+    _stateSet->setTextureAttributeAndModes( 0, _texture.get()      , osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+    _stateSet->setTextureAttributeAndModes( 1, texWaterDUDV.get() , osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+    _stateSet->setTextureAttributeAndModes( 2, texWaterNM.get()   , osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
+    program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
+    _stateSet->setAttributeAndModes( program.get() );
+    _stateSet->addUniform( new osg::Uniform("defaultTex", 0) );
+    _stateSet->addUniform( new osg::Uniform("refraction", 1) );
+    _stateSet->addUniform( new osg::Uniform("normalTex", 2) );
+
+    setQuality( (Quality)CGI_REFLECTION_QUALITY );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Reflection::~Reflection() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Reflection::update()
+{
+    // mirrored models of the removed water surfaces are dropped
+    for ( int i = (int)_camera->getNumChildren() - 1; i >= 0; i-- )
+    {
+        MirrorTransform *mirror = dynamic_cast<MirrorTransform*>( _camera->getChild( i ) );
+
+        if ( mirror && mirror->isValid() )
+        {
+            // water surfaces detached from the scene (e.g. distant landmarks) are not mirrored
+            bool attached = _camera->getNumParents() > 0 && mirror->isAttached( _camera->getParent( 0 ) );
+            mirror->setNodeMask( attached ? 0xffffffff : 0 );
+
+            // water surfaces might be moving
+            mirror->dirtyBound();
+        }
+        else
+        {
+            _camera->removeChild( i );
+        }
+    }
+
+    bool render = ( _counter % _interval ) == 0;
+
+    _camera->setNodeMask( ( render && _camera->getNumChildren() > 0 ) ? 0xffffffff : 0 );
+
+    _counter++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Reflection::setQuality( Quality quality )
+{
+    int size = 1024;
+
+    switch ( quality )
+    {
+        case Low:    size =  256; _interval = 4; break;
+        case Medium: size =  512; _interval = 2; break;
+        case High:   size = 1024; _interval = 1; break;
+    }
+
+    _quality = quality;
+
+    if ( size != _texture->getTextureWidth() )
+    {
+        _texture->setTextureSize( size, size );
+        _texture->dirtyTextureObject();
+
+        _camera->setViewport( 0, 0, size, size );
+
+        // frame buffer object has to be recreated for the new texture size
+        _camera->setRenderingCache( NULLPTR );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Reflection::setCullMask( osg::Node::NodeMask cullMask )
+{
+    _cullMask = cullMask;
+    _camera->setCullMask( _cullMask );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Reflection::addSurface( osg::Node *model, osg::Group *parent )
 {
     const float z = -0.1f;
 
+    // The water plane
+    const osg::Vec3& center = model->getBound().center();
+    float planeSize = 4.0f * model->getBound().radius();
+
+    osg::Vec3 planeCorner( center.x() - 0.5f*planeSize, center.y() - 0.5f*planeSize, z );
+
+    osg::ref_ptr<osg::Geometry> quad = osg::createTexturedQuadGeometry(
+                planeCorner,
+                osg::Vec3( planeSize, 0.0f, 0.0f ),
+                osg::Vec3( 0.0f, planeSize, 0.0f ) );
+
+    osg::ref_ptr<osg::Geode> geodeQuad = new osg::Geode;
+    geodeQuad->addDrawable( quad.get() );
+    geodeQuad->setStateSet( _stateSet.get() );
+
     osg::ref_ptr<osg::LOD> lodReflection = new osg::LOD();
-    osg::ref_ptr<osg::Group> groupReflection = new osg::Group();
+    lodReflection->addChild( geodeQuad.get(), 0.0f, CGI_REFLECTION_RANGE );
 
-    lodReflection->addChild( groupReflection.get(), 0.0f, 10000.0f );
+    parent->addChild( lodReflection.get() );
 
+    // The mirrored model
     osg::ref_ptr<osg::MatrixTransform> reverse = new osg::MatrixTransform;
     reverse->preMult( osg::Matrix::translate(0.0f, 0.0f, -z) *
                       osg::Matrix::scale(1.0f, 1.0f, -1.0f) *
@@ -129,79 +275,88 @@ void Reflection::create( osg::Node *model, osg::Group *parent )
     clipNode->addClipPlane( clipPlane.get() );
     clipNode->addChild( reverse.get() );
 
-    ////////////////////////////////
+    osg::ref_ptr<osg::LOD> lodMirror = new osg::LOD();
+    lodMirror->addChild( clipNode.get(), 0.0f, CGI_REFLECTION_RANGE );
+
+    osg::ref_ptr<MirrorTransform> mirror = new MirrorTransform( lodReflection.get() );
+    mirror->addChild( lodMirror.get() );
+
+    _camera->addChild( mirror.get() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Reflection::MirrorTransform::MirrorTransform( osg::Node *surface ) :
+    _surface ( surface )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Reflection::MirrorTransform::isValid() const
+{
+    osg::ref_ptr<osg::Node> surface;
+
+    if ( _surface.lock( surface ) )
+    {
+        return surface->getNumParents() > 0;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Reflection::MirrorTransform::isAttached( const osg::Node *root ) const
+{
+    osg::ref_ptr<osg::Node> surface;
 
-    if ( 1 )
+    if ( _surface.lock( surface ) )
     {
-        // The RTT camera
-        osg::ref_ptr<osg::Texture2D> tex2D = new osg::Texture2D();
-        tex2D->setTextureSize( 1024, 1024 );
-        tex2D->setInternalFormat( GL_RGBA );
-        tex2D->setFilter( osg::Texture2D::MIN_FILTER, osg::Texture2D::LINEAR );
-        tex2D->setFilter( osg::Texture2D::MAG_FILTER, osg::Texture2D::LINEAR );
-
-        osg::ref_ptr<osg::Camera> cameraRTT = new osg::Camera();
-
-        cameraRTT->setClearColor( osg::Vec4() );
-        cameraRTT->setClearMask( GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT );
-        cameraRTT->setRenderTargetImplementation( osg::Camera::FRAME_BUFFER_OBJECT );
-        cameraRTT->setRenderOrder( osg::Camera::PRE_RENDER );
-
-        cameraRTT->setViewport( 0, 0, tex2D->getTextureWidth(), tex2D->getTextureHeight() );
-        cameraRTT->attach( osg::Camera::COLOR_BUFFER, tex2D.get() );
-
-        cameraRTT->addChild( clipNode.get() );
-
-        // The water plane
-        const osg::Vec3& center = model->getBound().center();
-        float planeSize = 4.0f * model->getBound().radius();
-        //float planeSize = 200.0f;
-
-        osg::Vec3 planeCorner( center.x() - 0.5f*planeSize, center.y() - 0.5f*planeSize, z );
-
-        osg::ref_ptr<osg::Geometry> quad = osg::createTexturedQuadGeometry(
-                    planeCorner,
-                    osg::Vec3( planeSize, 0.0f, 0.0f ),
-                    osg::Vec3( 0.0f, planeSize, 0.0f ) );
-
-        osg::ref_ptr<osg::Geode> geodeQuad = new osg::Geode;
-        geodeQuad->addDrawable( quad.get() );
-
-        osg::ref_ptr<osg::Texture2D> texWaterDUDV = Textures::get( "cgi/textures/water_dudv.png" );
-        texWaterDUDV->setWrap( osg::Texture::WRAP_S, osg::Texture::REPEAT );
-        texWaterDUDV->setWrap( osg::Texture::WRAP_T, osg::Texture::REPEAT );
-        texWaterDUDV->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
-        texWaterDUDV->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
-
-        osg::ref_ptr<osg::Texture2D> texWaterNM = Textures::get( "cgi/textures/water_nm.png" );
-        texWaterNM->setWrap( osg::Texture::WRAP_S, osg::Texture::REPEAT );
-        texWaterNM->setWrap( osg::Texture::WRAP_T, osg::Texture::REPEAT );
-        texWaterNM->setFilter( osg::Texture::MIN_FILTER, osg::Texture::LINEAR );
-        texWaterNM->setFilter( osg::Texture::MAG_FILTER, osg::Texture::LINEAR );
-
-        osg::ref_ptr<osg::StateSet> stateSet = geodeQuad->getOrCreateStateSet();
-        stateSet->setTextureAttributeAndModes( 0, tex2D.get()        , osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
-        stateSet->setTextureAttributeAndModes( 1, texWaterDUDV.get() , osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
-        stateSet->setTextureAttributeAndModes( 2, texWaterNM.get()   , osg::StateAttribute::ON | osg::StateAttribute::OVERRIDE );
-
-        osg::ref_ptr<osg::Program> program = new osg::Program();
-        program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
-        program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
-        stateSet->setAttributeAndModes( program.get() );
-        stateSet->addUniform( new osg::Uniform("defaultTex", 0) );
-        stateSet->addUniform( new osg::Uniform("refraction", 1) );
-        stateSet->addUniform( new osg::Uniform("normalTex", 2) );
-
-        ////////////////////////////////
-
-        //groupReflection->addChild( model );
-        groupReflection->addChild( cameraRTT.get() );
-        groupReflection->addChild( geodeQuad.get() );
-
-        parent->addChild( lodReflection.get() );
+        osg::NodePathList paths = surface->getParentalNodePaths();
+
+        for ( osg::NodePathList::iterator it = paths.begin(); it != paths.end(); ++it )
+        {
+            if ( std::find( it->begin(), it->end(), root ) != it->end() )
+            {
+                return true;
+            }
+        }
     }
-    else
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Reflection::MirrorTransform::computeLocalToWorldMatrix( osg::Matrix &matrix, osg::NodeVisitor * ) const
+{
+    matrix.preMult( getSurfaceMatrix() );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Reflection::MirrorTransform::computeWorldToLocalMatrix( osg::Matrix &matrix, osg::NodeVisitor * ) const
+{
+    matrix.postMult( osg::Matrix::inverse( getSurfaceMatrix() ) );
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Matrix Reflection::MirrorTransform::getSurfaceMatrix() const
+{
+    osg::ref_ptr<osg::Node> surface;
+
+    if ( _surface.lock( surface ) )
     {
-        parent->addChild( clipNode.get() );
+        osg::NodePathList paths = surface->getParentalNodePaths();
+
+        if ( paths.size() > 0 )
+        {
+            return osg::computeLocalToWorld( paths[ 0 ] );
+        }
     }
+
+    return osg::Matrix::identity();
 }
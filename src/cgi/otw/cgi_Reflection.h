@@ -24,7 +24,15 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <osg/Camera>
 #include <osg/Group>
+#include <osg/observer_ptr>
+#include <osg/Texture2D>
+#include <osg/Transform>
+
+#include <cgi/cgi_Defines.h>
+
+#include <sim/Singleton.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -33,15 +41,115 @@ namespace cgi
 
 /**
  * @brief Reflection.
+ *
+ * Mirrored copies of the models of all the water surfaces are rendered
+ * by one shared render-to-texture camera, which is put under the scene by
+ * the FogScene. Each water surface is just a quad sampling that texture in
+ * the screen space, so reflections do not add geometry to the main pass.
+ *
+ * Quality level selects reflection texture resolution and how often the
+ * texture is rendered (every Nth frame), additionally camera cull mask might
+ * be used to leave details out of the reflection. With multiple OTW channels
+ * texture is rendered for each channel in turn, so only High quality (every
+ * frame) gives correct reflections then.
  */
-class Reflection
+class Reflection : public Singleton< Reflection >
 {
+    friend class Singleton< Reflection >;
+
 public:
 
+    /** Reflection quality levels. */
+    enum Quality
+    {
+        Low = 0,                    ///< 256x256 texture, every 4th frame
+        Medium,                     ///< 512x512 texture, every 2nd frame
+        High                        ///< 1024x1024 texture, every frame
+    };
+
     static const char _frag[];      ///<
     static const char _vert[];      ///<
 
+    /**
+     * @brief Creates water surface reflecting model.
+     * @param model reflected model
+     * @param parent parent group of the model
+     */
     static void create( osg::Node *model, osg::Group *parent );
+
+    /** @brief Destructor. */
+    virtual ~Reflection();
+
+    /** @brief Updates reflection, should be called every frame. */
+    void update();
+
+    /** @brief Returns reflection RTT camera node. */
+    inline osg::Node* getNode() { return _camera.get(); }
+
+    /** @brief Returns reflection quality level. */
+    inline Quality getQuality() const { return _quality; }
+
+    /** @brief Sets reflection quality level. */
+    void setQuality( Quality quality );
+
+    /** @brief Sets reflection camera cull mask. */
+    void setCullMask( osg::Node::NodeMask cullMask );
+
+private:
+
+    /**
+     * @brief Mirror transform class.
+     * Places mirrored model under the RTT camera at the current world
+     * position of the water surface.
+     */
+    class MirrorTransform : public osg::Transform
+    {
+    public:
+
+        /** @brief Constructor. */
+        MirrorTransform( osg::Node *surface );
+
+        /** @brief Returns false if water surface has been removed. */
+        bool isValid() const;
+
+        /** @brief Returns true if water surface is attached to the given scene root. */
+        bool isAttached( const osg::Node *root ) const;
+
+        /** */
+        virtual bool computeLocalToWorldMatrix( osg::Matrix &matrix, osg::NodeVisitor * ) const;
+
+        /** */
+        virtual bool computeWorldToLocalMatrix( osg::Matrix &matrix, osg::NodeVisitor * ) const;
+
+    private:
+
+        osg::observer_ptr<osg::Node> _surface;  ///< water surface node
+
+        /** Returns water surface world matrix. */
+        osg::Matrix getSurfaceMatrix() const;
+    };
+
+    osg::ref_ptr<osg::Camera> _camera;          ///< shared RTT camera
+    osg::ref_ptr<osg::Texture2D> _texture;      ///< reflection texture
+    osg::ref_ptr<osg::StateSet> _stateSet;      ///< water surfaces state set
+
+    Quality _quality;                           ///< quality level
+    osg::Node::NodeMask _cullMask;              ///< camera cull mask
+
+    unsigned int _interval;                     ///< [-] texture is rendered every _interval frame
+    unsigned int _counter;                      ///< [-] frames counter
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to Reflection class instance.
+     */
+    Reflection();
+
+    /** Using this constructor is forbidden. */
+    Reflection( const Reflection & ) : Singleton< Reflection >() {}
+
+    /** Creates water surface reflecting model. */
+    void addSurface( osg::Node *model, osg::Group *parent );
 };
 
 } // end of cgi namespace
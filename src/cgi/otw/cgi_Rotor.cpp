@@ -22,19 +22,21 @@
 
 #include <cgi/otw/cgi_Rotor.h>
 
+#include <algorithm>
+
 #include <osg/AlphaFunc>
 #include <osg/BlendFunc>
 #include <osg/Depth>
 #include <osg/Geode>
 #include <osg/Geometry>
 #include <osg/LineWidth>
-
-#include <fdm/utils/fdm_Units.h>
+#include <osg/Program>
+#include <osg/Shader>
 
 #include <Data.h>
 
+#include <cgi/cgi_Colors.h>
 #include <cgi/cgi_Defines.h>
-#include <cgi/cgi_Utils.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -42,6 +44,46 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const unsigned int path_capacity = 256; ///< maximum number of blade tip path positions
+const unsigned int blur_segments = 36;  ///< number of rotor blur disc segments
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char Rotor::_frag[] =
+    "void main()\n"
+    "{\n"
+    "   gl_FragColor = gl_Color;\n"
+    "}\n"
+    "\n";
+
+const char Rotor::_vert[] =
+    "uniform float coning;\n"
+    "uniform float diskPitch;\n"
+    "uniform float diskRoll;\n"
+    "uniform float hingeOffset;\n"
+    "uniform float bladeSpan;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "   // vertex x and y are azimuth cosine and sine, z is 0 at hinge and 1 at tip\n"
+    "   float cosPsi = gl_Vertex.x;\n"
+    "   float sinPsi = gl_Vertex.y;\n"
+    "   float beta = coning + cosPsi * diskPitch - sinPsi * diskRoll;\n"
+    "   float r = hingeOffset + gl_Vertex.z * cos( beta ) * bladeSpan;\n"
+    "   vec4 v = vec4( cosPsi * r, sinPsi * r, -gl_Vertex.z * sin( beta ) * bladeSpan, 1.0 );\n"
+    "\n"
+    "   gl_FrontColor = gl_Color;\n"
+    "   gl_Position = gl_ModelViewProjectionMatrix * v;\n"
+    "}\n"
+    "\n";
+
+////////////////////////////////////////////////////////////////////////////////
+
 Rotor::Rotor( const osg::Vec3 &center, int blades_count,
               double radius, double offset, double inclination ) :
     _center ( center ),
@@ -73,12 +115,10 @@ Rotor::Rotor( const osg::Vec3 &center, int blades_count,
     _switchVectors = new osg::Switch();
     _pat->addChild( _switchVectors.get() );
 
-    for ( int i = 0; i < _blades_count; i++ )
-    {
-        _paths.push_back( new osg::Vec3Array() );
-    }
-
+    createBlur();
     createDatum();
+    createPaths();
+    createVectors();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +137,78 @@ void Rotor::update()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Rotor::createBlur()
+{
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    _switchBlur->addChild( geode.get() );
+
+    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
+    geode->addDrawable( geometry.get() );
+
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
+    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();
+    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
+
+    // disc is deformed by the vertex shader
+    for ( unsigned int i = 0; i <= blur_segments; i++ )
+    {
+        double psi = 2.0 * M_PI * (double)i / (double)blur_segments;
+
+        v->push_back( osg::Vec3( cos( psi ), sin( psi ), 0.0 ) );
+        v->push_back( osg::Vec3( cos( psi ), sin( psi ), 1.0 ) );
+    }
+
+    n->push_back( osg::Vec3( 0.0f, 0.0f, -1.0f ) );
+    c->push_back( osg::Vec4( 0.0f, 0.0f, 0.0f, 0.2f ) );
+
+    geometry->setVertexArray( v.get() );
+    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::TRIANGLE_STRIP, 0, v->size() ) );
+    geometry->setNormalArray( n.get() );
+    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
+    geometry->setColorArray( c.get() );
+    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+
+    // vertices are not actual positions
+    geometry->setInitialBound( osg::BoundingBox( -_radius, -_radius, -_radius,
+                                                  _radius,  _radius,  _radius ) );
+
+    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
+
+    osg::ref_ptr<osg::Program> program = new osg::Program();
+    program->addShader( new osg::Shader( osg::Shader::VERTEX   , _vert ) );
+    program->addShader( new osg::Shader( osg::Shader::FRAGMENT , _frag ) );
+    stateSet->setAttributeAndModes( program.get() );
+
+    _coning    = new osg::Uniform( "coning"    , 0.0f );
+    _diskPitch = new osg::Uniform( "diskPitch" , 0.0f );
+    _diskRoll  = new osg::Uniform( "diskRoll"  , 0.0f );
+
+    stateSet->addUniform( _coning.get() );
+    stateSet->addUniform( _diskPitch.get() );
+    stateSet->addUniform( _diskRoll.get() );
+    stateSet->addUniform( new osg::Uniform( "hingeOffset" , (float)_offset ) );
+    stateSet->addUniform( new osg::Uniform( "bladeSpan"   , (float)( _radius - _offset ) ) );
+
+    // uniforms are modified between frames
+    stateSet->setDataVariance( osg::Object::DYNAMIC );
+
+    osg::ref_ptr<osg::AlphaFunc> alphaFunc = new osg::AlphaFunc();
+    osg::ref_ptr<osg::BlendFunc> blendFunc = new osg::BlendFunc();
+    alphaFunc->setFunction( osg::AlphaFunc::GEQUAL, 0.05 );
+    blendFunc->setFunction( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+    osg::ref_ptr<osg::Depth> depth = new osg::Depth;
+    depth->setWriteMask( false );
+    stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
+    stateSet->setAttributeAndModes( blendFunc.get(), osg::StateAttribute::ON );
+    stateSet->setAttributeAndModes( alphaFunc.get(), osg::StateAttribute::ON );
+    stateSet->setAttributeAndModes( depth.get(), osg::StateAttribute::ON );
+    stateSet->setMode( GL_BLEND     , osg::StateAttribute::ON  | osg::StateAttribute::OVERRIDE );
+    stateSet->setMode( GL_CULL_FACE , osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE  );
+    stateSet->setRenderBinDetails( CGI_DEPTH_SORTED_BIN_EFFECTS, "DepthSortedBin" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Rotor::createDatum()
 {
     const double r = _radius;
@@ -210,80 +322,114 @@ void Rotor::createDatum()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Rotor::updateBlur()
+void Rotor::createPaths()
 {
-    if ( _switchBlur->getNumChildren() > 0 )
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    _switchPaths->addChild( geode.get() );
+
+    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
+    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
+
+    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
+    c->push_back( osg::Vec4( 1.0f, 1.0f, 0.0f, 1.0f ) );
+
+    for ( int i = 0; i < _blades_count; i++ )
     {
-        _switchBlur->removeChildren( 0, _switchBlur->getNumChildren() );
+        Path path;
+
+        path.positions = new osg::Vec3Array( 2 * path_capacity );
+        path.draw      = new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, 0 );
+        path.geometry  = new osg::Geometry();
+        path.head  = 0;
+        path.count = 0;
+
+        path.geometry->setVertexArray( path.positions.get() );
+        path.geometry->addPrimitiveSet( path.draw.get() );
+        path.geometry->setNormalArray( n.get() );
+        path.geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
+        path.geometry->setColorArray( c.get() );
+        path.geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+
+        // positions are modified between frames
+        path.geometry->setDataVariance( osg::Object::DYNAMIC );
+        path.geometry->setUseDisplayList( false );
+        path.geometry->setUseVertexBufferObjects( true );
+
+        geode->addDrawable( path.geometry.get() );
+
+        _paths.push_back( path );
     }
 
-    if ( Data::get()->cgi.show_rotor_blur )
-    {
-        osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-        _switchBlur->addChild( geode.get() );
+    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
+    lineWidth->setWidth( 2.0f );
 
-        osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-        geode->addDrawable( geometry.get() );
+    geode->getOrCreateStateSet()->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
+}
 
-        osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
-        osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();
-        osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();
+////////////////////////////////////////////////////////////////////////////////
 
-        const double span = _radius - _offset;
+void Rotor::createVectors()
+{
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    _switchVectors->addChild( geode.get() );
 
-        for ( int i = 0; i <= 36; i++ )
-        {
-            double psi = fdm::Units::deg2rad( 10.0 * i );
+    _vectors     = new osg::Vec3Array( 8 * FDM_MAX_VECTORS );
+    _vectorsDraw = new osg::DrawArrays( osg::PrimitiveSet::LINES, 0, 0 );
+    _vectorsGeom = new osg::Geometry();
 
-            double cosPsi = cos( psi );
-            double sinPsi = sin( psi );
+    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
+    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
 
-            double beta = Data::get()->ownship.mainRotor.coningAngle
-                        + cosPsi * Data::get()->ownship.mainRotor.diskPitch
-                        - sinPsi * Data::get()->ownship.mainRotor.diskRoll;
+    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
 
-            double cosBeta = cos( beta );
-            double sinBeta = sin( beta );
+    // vector and its components lines, the same for every vector
+    for ( int i = 0; i < FDM_MAX_VECTORS; i++ )
+    {
+        c->push_back( osg::Vec4( Colors::_amber , 1.0f ) );
+        c->push_back( osg::Vec4( Colors::_amber , 1.0f ) );
+        c->push_back( osg::Vec4( Colors::_red   , 1.0f ) );
+        c->push_back( osg::Vec4( Colors::_red   , 1.0f ) );
+        c->push_back( osg::Vec4( Colors::_lime  , 1.0f ) );
+        c->push_back( osg::Vec4( Colors::_lime  , 1.0f ) );
+        c->push_back( osg::Vec4( Colors::_blue  , 1.0f ) );
+        c->push_back( osg::Vec4( Colors::_blue  , 1.0f ) );
+    }
 
-            double span_real = cosBeta * span;
+    _vectorsGeom->setVertexArray( _vectors.get() );
+    _vectorsGeom->addPrimitiveSet( _vectorsDraw.get() );
+    _vectorsGeom->setNormalArray( n.get() );
+    _vectorsGeom->setNormalBinding( osg::Geometry::BIND_OVERALL );
+    _vectorsGeom->setColorArray( c.get() );
+    _vectorsGeom->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
 
-            double xi = cosPsi * _offset;
-            double xo = cosPsi * ( _offset + span_real );
+    // vertices are modified between frames
+    _vectorsGeom->setDataVariance( osg::Object::DYNAMIC );
+    _vectorsGeom->setUseDisplayList( false );
+    _vectorsGeom->setUseVertexBufferObjects( true );
 
-            double yi = sinPsi * _offset;
-            double yo = sinPsi * ( _offset + span_real );
+    geode->addDrawable( _vectorsGeom.get() );
 
-            double zo = sinBeta * span;
+    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
+    lineWidth->setWidth( 2.0f );
 
-            v->push_back( osg::Vec3( xi, yi, 0.0 ) );
-            v->push_back( osg::Vec3( xo, yo, -zo ) );
-        }
+    geode->getOrCreateStateSet()->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
+}
 
-        n->push_back( osg::Vec3( 0.0f, 0.0f, -1.0f ) );
-        c->push_back( osg::Vec4( 0.0f, 0.0f, 0.0f, 0.2f ) );
+////////////////////////////////////////////////////////////////////////////////
 
-        geometry->setVertexArray( v );
-        geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::QUAD_STRIP, 0, v->size() ) );
-        geometry->setNormalArray( n.get() );
-        geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-        geometry->setColorArray( c.get() );
-        geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
+void Rotor::updateBlur()
+{
+    if ( Data::get()->cgi.show_rotor_blur )
+    {
+        _coning    ->set( (float)Data::get()->ownship.mainRotor.coningAngle );
+        _diskPitch ->set( (float)Data::get()->ownship.mainRotor.diskPitch   );
+        _diskRoll  ->set( (float)Data::get()->ownship.mainRotor.diskRoll    );
 
-        osg::ref_ptr<osg::StateSet> stateSet = _root->getOrCreateStateSet();
-
-        osg::ref_ptr<osg::AlphaFunc> alphaFunc = new osg::AlphaFunc();
-        osg::ref_ptr<osg::BlendFunc> blendFunc = new osg::BlendFunc();
-        alphaFunc->setFunction( osg::AlphaFunc::GEQUAL, 0.05 );
-        blendFunc->setFunction( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
-        osg::ref_ptr<osg::Depth> depth = new osg::Depth;
-        depth->setWriteMask( false );
-        stateSet->setRenderingHint( osg::StateSet::TRANSPARENT_BIN );
-        stateSet->setAttributeAndModes( blendFunc.get(), osg::StateAttribute::ON );
-        stateSet->setAttributeAndModes( alphaFunc.get(), osg::StateAttribute::ON );
-        stateSet->setAttributeAndModes( depth.get(), osg::StateAttribute::ON );
-        stateSet->setMode( GL_BLEND     , osg::StateAttribute::ON  | osg::StateAttribute::OVERRIDE );
-        stateSet->setMode( GL_CULL_FACE , osg::StateAttribute::OFF | osg::StateAttribute::OVERRIDE  );
-        stateSet->setRenderBinDetails( CGI_DEPTH_SORTED_BIN_EFFECTS, "DepthSortedBin" );
+        _switchBlur->setAllChildrenOn();
+    }
+    else
+    {
+        _switchBlur->setAllChildrenOff();
     }
 }
 
@@ -306,23 +452,16 @@ void Rotor::updateDatum()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+
 void Rotor::updatePaths()
 {
-    if ( _switchPaths->getNumChildren() > 0 )
-    {
-        _switchPaths->removeChildren( 0, _switchPaths->getNumChildren() );
-    }
-
     if ( Data::get()->stateOut == fdm::DataOut::Idle )
     {
         for ( Paths::iterator it = _paths.begin(); it != _paths.end(); ++it )
         {
-            (*it)->clear();
-        }
-
-        if ( _switchPaths->getNumChildren() > 0 )
-        {
-            _switchPaths->removeChildren( 0, _switchPaths->getNumChildren() );
+            it->head  = 0;
+            it->count = 0;
+            it->draw->setCount( 0 );
         }
     }
     else if ( Data::get()->stateOut == fdm::DataOut::Working )
@@ -330,6 +469,14 @@ void Rotor::updatePaths()
         double azimuth = Data::get()->ownship.mainRotor.azimuth;
         double delta_psi = 2.0 * M_PI / (double)(_blades_count);
 
+        double rot_time = ( 2.0 * M_PI ) / Data::get()->ownship.mainRotor.omega / Data::get()->timeCoef;
+        double frames = rot_time / CGI_TIME_STEP / (double)_blades_count;
+
+        // also handles not spinning rotor
+        unsigned int max = path_capacity;
+        unsigned int min = 10;
+        if ( frames < (double)path_capacity ) max = std::max( min, (unsigned int)ceil( frames ) );
+
         // main rotor blades
         for ( int i = 0; i < (int)_paths.size() && i < _blades_count; i++ )
         {
@@ -347,30 +494,27 @@ void Rotor::updatePaths()
             osg::Vec3 r_tp_ras = q_sra * r_fh_sra
                     + q_sra * ( q_bsa * r_tp_bsa );
 
-            _paths[ i ]->push_back( r_tp_ras );
+            Path &path = _paths[ i ];
+
+            // every position is stored twice, so the most recent ones are
+            // always contiguous in the second half
+            (*path.positions)[ path.head                 ] = r_tp_ras;
+            (*path.positions)[ path.head + path_capacity ] = r_tp_ras;
+
+            path.count = std::min( path.count + 1, max );
 
-            double rot_time = ( 2.0 * M_PI ) / Data::get()->ownship.mainRotor.omega / Data::get()->timeCoef;
-            double frames = rot_time / CGI_TIME_STEP / (double)_blades_count;
+            path.draw->setFirst( path.head + path_capacity + 1 - path.count );
+            path.draw->setCount( path.count );
 
-            int max = ceil( frames );
-            int min = 10;
-            if ( max < min ) max = min;
+            path.head = ( path.head + 1 ) % path_capacity;
 
-            while ( _paths[ i ]->size() > (unsigned int)max )
-            {
-                _paths[ i ]->erase( _paths[ i ]->begin(),
-                                    _paths[ i ]->begin() + 1 );
-            }
+            path.positions->dirty();
+            path.geometry->dirtyBound();
         }
     }
 
     if ( Data::get()->cgi.show_blades_paths )
     {
-        for ( Paths::iterator it = _paths.begin(); it != _paths.end(); ++it )
-        {
-            updatePath( _switchPaths.get(), (*it).get() );
-        }
-
         _switchPaths->setAllChildrenOn();
     }
     else
@@ -381,42 +525,9 @@ void Rotor::updatePaths()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Rotor::updatePath( osg::Group *parent, osg::Vec3Array *positions )
-{
-    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
-    parent->addChild( geode.get() );
-
-    osg::ref_ptr<osg::Geometry> geometry = new osg::Geometry();
-
-    osg::ref_ptr<osg::Vec3Array> n = new osg::Vec3Array();  // normals
-    osg::ref_ptr<osg::Vec4Array> c = new osg::Vec4Array();  // colors
-
-    n->push_back( osg::Vec3( 0.0f, 0.0f, 1.0f ) );
-    c->push_back( osg::Vec4( 1.0f, 1.0f, 0.0f, 1.0f ) );
-
-    geometry->setVertexArray( positions );
-    geometry->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::LINE_STRIP, 0, positions->size() ) );
-    geometry->setNormalArray( n.get() );
-    geometry->setNormalBinding( osg::Geometry::BIND_OVERALL );
-    geometry->setColorArray( c.get() );
-    geometry->setColorBinding( osg::Geometry::BIND_OVERALL );
-
-    geode->addDrawable( geometry.get() );
-
-    osg::ref_ptr<osg::LineWidth> lineWidth = new osg::LineWidth();
-    lineWidth->setWidth( 2.0f );
-
-    geode->getOrCreateStateSet()->setAttributeAndModes( lineWidth, osg::StateAttribute::ON );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 void Rotor::updateVectors()
 {
-    if ( _switchVectors->getNumChildren() > 0 )
-    {
-        _switchVectors->removeChildren( 0, _switchVectors->getNumChildren() );
-    }
+    unsigned int count = 0;
 
     for ( int i = 0; i < FDM_MAX_VECTORS; i++ )
     {
@@ -430,8 +541,23 @@ void Rotor::updateVectors()
                          Data::get()->cgi.rotor.v[ i ].v_y,
                          Data::get()->cgi.rotor.v[ i ].v_z );
 
-            Utils::drawVector( _switchVectors.get(), b, v );
+            // visible vectors are packed at the beginning
+            (*_vectors)[ count++ ] = b;
+            (*_vectors)[ count++ ] = b + v;
+            (*_vectors)[ count++ ] = b;
+            (*_vectors)[ count++ ] = b + osg::Vec3( v.x(), 0.0, 0.0 );
+            (*_vectors)[ count++ ] = b;
+            (*_vectors)[ count++ ] = b + osg::Vec3( 0.0, v.y(), 0.0 );
+            (*_vectors)[ count++ ] = b;
+            (*_vectors)[ count++ ] = b + osg::Vec3( 0.0, 0.0, v.z() );
         }
     }
-}
 
+    if ( count > 0 || _vectorsDraw->getCount() > 0 )
+    {
+        _vectorsDraw->setCount( count );
+
+        _vectors->dirty();
+        _vectorsGeom->dirtyBound();
+    }
+}
@@ -24,8 +24,12 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
+#include <osg/Geometry>
 #include <osg/PositionAttitudeTransform>
 #include <osg/Switch>
+#include <osg/Uniform>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -34,12 +38,28 @@ namespace cgi
 
 /**
  * @brief Helicopter rotor class.
+ *
+ * Rotor blur is a static disc mesh deformed by the vertex shader, coning
+ * angle and disc tilt are passed as uniforms, so it costs the same
+ * regardless of blades count. Blades tip paths and rotor vectors are
+ * updated in place in preallocated buffers, no nodes are created after
+ * construction.
  */
 class Rotor
 {
 public:
 
-    typedef std::vector< osg::ref_ptr<osg::Vec3Array> > Paths;
+    /** Blade tip path. */
+    struct Path
+    {
+        osg::ref_ptr<osg::Vec3Array> positions; ///< ring buffer stored twice, so recent positions are contiguous
+        osg::ref_ptr<osg::DrawArrays> draw;     ///< recent positions line strip
+        osg::ref_ptr<osg::Geometry> geometry;   ///< path geometry
+        unsigned int head;                      ///< next position index
+        unsigned int count;                     ///< number of recent positions
+    };
+
+    typedef std::vector< Path > Paths;
 
     /** @brief Constructor. */
     Rotor( const osg::Vec3 &center, int blades_count,
@@ -56,6 +76,9 @@ public:
 
 private:
 
+    static const char _frag[];      ///< rotor blur fragment shader
+    static const char _vert[];      ///< rotor blur vertex shader
+
     const osg::Vec3 _center;        ///< [m] rotor hub center
 
     const int _blades_count;        ///< number of rotor blades
@@ -74,16 +97,29 @@ private:
     osg::ref_ptr<osg::Switch> _switchPaths;
     osg::ref_ptr<osg::Switch> _switchVectors;
 
-    Paths _paths;
+    osg::ref_ptr<osg::Uniform> _coning;         ///< [rad] coning angle
+    osg::ref_ptr<osg::Uniform> _diskPitch;      ///< [rad] disc pitch angle
+    osg::ref_ptr<osg::Uniform> _diskRoll;       ///< [rad] disc roll angle
+
+    osg::ref_ptr<osg::Vec3Array> _vectors;      ///< vectors lines vertices
+    osg::ref_ptr<osg::DrawArrays> _vectorsDraw; ///< visible vectors lines
+    osg::ref_ptr<osg::Geometry> _vectorsGeom;   ///< vectors geometry
+
+    Paths _paths;                               ///< blades tip paths
+
+    void createBlur();
 
     void createDatum();
 
+    void createPaths();
+
+    void createVectors();
+
     void updateBlur();
 
     void updateDatum();
 
     void updatePaths();
-    void updatePath( osg::Group *parent, osg::Vec3Array *positions );
 
     void updateVectors();
 };
@@ -22,6 +22,9 @@
 
 #include <cgi/otw/cgi_Scenery.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <osg/Geode>
 #include <osg/Geometry>
 #include <osg/Material>
@@ -31,9 +34,11 @@
 
 #include <fdm/utils/fdm_String.h>
 #include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
 
 #include <cgi/cgi_Geometry.h>
 #include <cgi/cgi_Intersections.h>
+#include <cgi/cgi_Origin.h>
 #include <cgi/cgi_Textures.h>
 #include <cgi/cgi_WGS84.h>
 
@@ -51,7 +56,8 @@ using namespace cgi;
 ////////////////////////////////////////////////////////////////////////////////
 
 Scenery::Scenery( const Module *parent ) :
-    Module( parent )
+    Module( parent ),
+    _activationValid ( false )
 {
     _root->setName( "Scenery" );
 
@@ -71,9 +77,6 @@ Scenery::Scenery( const Module *parent ) :
     _on->getOrCreateStateSet()->setRenderBinDetails( CGI_DEPTH_SORTED_BIN_WORLD, "RenderBin" );
     _patMasterAtt->addChild( _on.get() );
 
-    //_groupScenery = new osg::Group();
-    //_on->addChild( _groupScenery.get() );
-
     _patSceneryPos = new osg::PositionAttitudeTransform();
     _patSceneryAtt = new osg::PositionAttitudeTransform();
 
@@ -81,8 +84,14 @@ Scenery::Scenery( const Module *parent ) :
 
     _on->addChild( _patSceneryAtt.get() );
 
+    // scenery objects expressed in WGS
+    _groupScenery = new osg::Group();
+    _patSceneryPos->addChild( _groupScenery.get() );
+
     _patShadow = new osg::PositionAttitudeTransform();
+#   if ( CGI_SHADOW_QUALITY == 0 )
     _on->setOverlaySubgraph( _patShadow.get() );
+#   endif
 
     createShadow();
 
@@ -103,14 +112,39 @@ Scenery::Scenery( const Module *parent ) :
         }
     }
 
+#   if ( CGI_SHADOW_QUALITY > 0 )
+    // static scenery only receives shadows
+    for ( List::iterator it = _children.begin(); it != _children.end(); ++it )
+    {
+        (*it)->getNode()->setNodeMask( ~CGI_SHADOW_CAST_MASK );
+    }
+
+    for ( Objects::iterator it = _objects.begin(); it != _objects.end(); ++it )
+    {
+        it->module->getNode()->setNodeMask( ~CGI_SHADOW_CAST_MASK );
+    }
+#   endif
+
     addChild( new Entities( this ) ); // entities after terrain!
 
-    Intersections::instance()->setScenery( _root.get() );
+    // scenery root is placed relative to the scene origin, while
+    // intersections are expressed in WGS
+    Intersections::instance()->setScenery( _groupScenery.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Scenery::~Scenery() {}
+Scenery::~Scenery()
+{
+    // active objects are deleted along with other children
+    for ( Objects::iterator it = _objects.begin(); it != _objects.end(); ++it )
+    {
+        if ( !it->active )
+        {
+            DELPTR( it->module );
+        }
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -119,7 +153,7 @@ void Scenery::addChild( Module *child )
     if ( child )
     {
         _children.push_back( child );
-        _patSceneryPos->addChild( child->getNode() );
+        _groupScenery->addChild( child->getNode() );
     }
 }
 
@@ -127,21 +161,23 @@ void Scenery::addChild( Module *child )
 
 void Scenery::update()
 {
+    osg::Vec3d v( Data::get()->cgi.ownship.pos_x_wgs,
+                  Data::get()->cgi.ownship.pos_y_wgs,
+                  Data::get()->cgi.ownship.pos_z_wgs );
+
+    WGS84 wgs( v );
+
+    updateObjects( wgs );
+
     /////////////////
     Module::update();
     /////////////////
 
-    osg::Vec3d v( Data::get()->ownship.pos_x_wgs,
-                  Data::get()->ownship.pos_y_wgs,
-                  Data::get()->ownship.pos_z_wgs );
-
-    WGS84 wgs( v );
-
     _patSceneryAtt->setAttitude(  wgs.getAttitude().inverse() );
     _patSceneryPos->setPosition( -wgs.getPosition() );
 
     _patMasterAtt->setAttitude(  wgs.getAttitude() );
-    _patMasterPos->setPosition(  wgs.getPosition() );
+    _patMasterPos->setPosition( Origin::toScene( wgs.getPosition() ) );
 
     osg::Quat att( Data::get()->ownship.roll    , osg::X_AXIS,
                    Data::get()->ownship.pitch   , osg::Y_AXIS,
@@ -165,6 +201,23 @@ void Scenery::setShadow( const char *shadowFile )
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenery::addObject( Module *object, double lat, double lon, double alt )
+{
+    Object obj;
+
+    obj.module  = object;
+    obj.pos_wgs = WGS84::geo2wgs( lat, lon, alt );
+    obj.active  = false;
+
+    TileKey key( (int)floor( osg::RadiansToDegrees( lat ) / CGI_SCENERY_TILE_SIZE ),
+                 (int)floor( osg::RadiansToDegrees( lon ) / CGI_SCENERY_TILE_SIZE ) );
+
+    _tiles[ key ].push_back( (int)_objects.size() );
+    _objects.push_back( obj );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void Scenery::createShadow()
@@ -242,7 +295,7 @@ void Scenery::readAirports( const fdm::XmlNode &node )
                     double lon = osg::DegreesToRadians( fdm::String::toDouble( lonTextNode.getText() ) );
                     double alt = fdm::String::toDouble( altTextNode.getText() );
 
-                    addChild( new Airport( file.c_str(), lat, lon, alt, this ) );
+                    addObject( new Airport( file.c_str(), lat, lon, alt, this ), lat, lon, alt );
                 }
             }
 
@@ -295,8 +348,9 @@ void Scenery::readLandmarks( const fdm::XmlNode &node )
                     double hdg = osg::DegreesToRadians( fdm::String::toDouble( hdgTextNode.getText() ) );
 
                     bool reflection = fdm::String::toBool( landmarkNode.getAttribute( "reflection" ), false );
+                    bool collision  = fdm::String::toBool( landmarkNode.getAttribute( "collision"  ), false );
 
-                    addChild( new Landmark( file.c_str(), lat, lon, alt, hdg, reflection, this ) );
+                    addObject( new Landmark( file.c_str(), lat, lon, alt, hdg, reflection, collision, this ), lat, lon, alt );
                 }
             }
 
@@ -313,13 +367,155 @@ void Scenery::readTerrain( const fdm::XmlNode &node )
 
     if ( terrainNode.isValid() )
     {
-        fdm::XmlNode terrainTextNode = terrainNode.getFirstChild();
+        fdm::XmlNode tilesNode = terrainNode.getFirstChildElement( "tiles" );
+
+        if ( tilesNode.isValid() )
+        {
+            Terrain::Tiles tiles;
+
+            tiles.ext = "osgb";
+
+            double lat_min = 0.0;
+            double lat_max = 0.0;
+            double lon_min = 0.0;
+            double lon_max = 0.0;
+
+            if ( FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &tiles.dir    , "dir"     )
+              && FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &tiles.levels , "levels"  )
+              && FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &lat_min      , "lat_min" )
+              && FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &lat_max      , "lat_max" )
+              && FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &lon_min      , "lon_min" )
+              && FDM_SUCCESS == fdm::XmlUtils::read( tilesNode, &lon_max      , "lon_max" )
+              && tiles.levels > 0 && lat_max > lat_min && lon_max > lon_min )
+            {
+                fdm::XmlUtils::read( tilesNode, &tiles.ext, "ext", true );
+
+                tiles.lat_min = osg::DegreesToRadians( lat_min );
+                tiles.lat_max = osg::DegreesToRadians( lat_max );
+                tiles.lon_min = osg::DegreesToRadians( lon_min );
+                tiles.lon_max = osg::DegreesToRadians( lon_max );
+
+                addChild( new Terrain( tiles, this ) );
+            }
+        }
+        else
+        {
+            fdm::XmlNode terrainTextNode = terrainNode.getFirstChild();
+
+            if ( terrainTextNode.isValid() && terrainTextNode.isText() )
+            {
+                std::string file = terrainTextNode.getText();
+
+                addChild( new Terrain( file.c_str(), this ) );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenery::setActive( int index, bool active )
+{
+    Object &obj = _objects[ index ];
+
+    if ( obj.active == active ) return;
+
+    obj.active = active;
+
+    if ( active )
+    {
+        _children.push_back( obj.module );
+        _groupScenery->addChild( obj.module->getNode() );
+    }
+    else
+    {
+        List::iterator it = std::find( _children.begin(), _children.end(), obj.module );
 
-        if ( terrainTextNode.isValid() && terrainTextNode.isText() )
+        if ( it != _children.end() )
         {
-            std::string file = terrainTextNode.getText();
+            _children.erase( it );
+        }
+
+        _groupScenery->removeChild( obj.module->getNode() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Scenery::updateObjects( const WGS84 &wgs )
+{
+    osg::Vec3d pos_wgs = wgs.getPosition();
+
+    if ( _activationValid
+      && ( pos_wgs - _activationPos ).length() < CGI_SCENERY_ACTIVATION_STEP )
+    {
+        return;
+    }
+
+    _activationPos = pos_wgs;
+    _activationValid = true;
+
+    // deactivation radius is increased by activation step to avoid toggling
+    const double r_on  = CGI_SCENERY_ACTIVATION_RADIUS;
+    const double r_off = CGI_SCENERY_ACTIVATION_RADIUS + CGI_SCENERY_ACTIVATION_STEP;
 
-            addChild( new Terrain( file.c_str(), this ) );
+    std::vector< int >::iterator it = _active.begin();
+    while ( it != _active.end() )
+    {
+        if ( ( _objects[ *it ].pos_wgs - pos_wgs ).length() > r_off )
+        {
+            setActive( *it, false );
+            it = _active.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // tiles range covering activation radius
+    double lat = wgs.getLat();
+    double lon = wgs.getLon();
+
+    double delta_lat = r_on / WGS84::getRadiusPolar();
+    double cos_lat = cos( lat );
+    double delta_lon = cos_lat > 1.0e-3 ? delta_lat / cos_lat : M_PI;
+
+    int lat_min = (int)floor( osg::RadiansToDegrees( lat - delta_lat ) / CGI_SCENERY_TILE_SIZE );
+    int lat_max = (int)floor( osg::RadiansToDegrees( lat + delta_lat ) / CGI_SCENERY_TILE_SIZE );
+    int lon_min = (int)floor( osg::RadiansToDegrees( lon - delta_lon ) / CGI_SCENERY_TILE_SIZE );
+    int lon_max = (int)floor( osg::RadiansToDegrees( lon + delta_lon ) / CGI_SCENERY_TILE_SIZE );
+
+    const int lon_tiles = (int)ceil( 360.0 / CGI_SCENERY_TILE_SIZE );
+    const int lon_first = (int)floor( -180.0 / CGI_SCENERY_TILE_SIZE );
+
+    if ( lon_max - lon_min >= lon_tiles )
+    {
+        lon_min = lon_first;
+        lon_max = lon_first + lon_tiles - 1;
+    }
+
+    for ( int i_lat = lat_min; i_lat <= lat_max; ++i_lat )
+    {
+        for ( int i_lon = lon_min; i_lon <= lon_max; ++i_lon )
+        {
+            // wrapping around antimeridian
+            int i_lon_wrapped = lon_first + ( ( ( i_lon - lon_first ) % lon_tiles ) + lon_tiles ) % lon_tiles;
+
+            Tiles::iterator tile = _tiles.find( TileKey( i_lat, i_lon_wrapped ) );
+
+            if ( tile != _tiles.end() )
+            {
+                for ( std::vector< int >::iterator jt = tile->second.begin(); jt != tile->second.end(); ++jt )
+                {
+                    if ( !_objects[ *jt ].active
+                      && ( _objects[ *jt ].pos_wgs - pos_wgs ).length() < r_on )
+                    {
+                        setActive( *jt, true );
+                        _active.push_back( *jt );
+                    }
+                }
+            }
         }
     }
 }
@@ -24,11 +24,15 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
+#include <utility>
+
 #include <osgSim/OverlayNode>
 
 #include <fdm/xml/fdm_XmlNode.h>
 
 #include <cgi/cgi_Module.h>
+#include <cgi/cgi_WGS84.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -37,6 +41,10 @@ namespace cgi
 
 /**
  * @brief Scenery class.
+ *
+ * Airports and landmarks are kept in a spatial index of lat/lon tiles and
+ * only objects within CGI_SCENERY_ACTIVATION_RADIUS from the ownship are
+ * attached to the scene graph and updated.
  */
 class Scenery : public Module
 {
@@ -58,6 +66,25 @@ public:
 
 private:
 
+    /** Scenery object (airport or landmark). */
+    struct Object
+    {
+        Module *module;         ///< object module
+        osg::Vec3d pos_wgs;     ///< [m] object position expressed in WGS
+        bool active;            ///< specifies if object is attached to the scene
+    };
+
+    typedef std::vector< Object > Objects;
+    typedef std::pair< int, int > TileKey;                  ///< latitude and longitude tile indices
+    typedef std::map< TileKey, std::vector< int > > Tiles;  ///< objects indices by tile
+
+    Objects _objects;               ///< all scenery objects
+    Tiles _tiles;                   ///< scenery objects spatial index
+    std::vector< int > _active;     ///< active objects indices
+
+    osg::Vec3d _activationPos;      ///< [m] ownship position of the last activation update
+    bool _activationValid;          ///< specifies if activation update has been done
+
     osg::ref_ptr<osg::PositionAttitudeTransform> _patShadow;
 
     osg::ref_ptr<osg::PositionAttitudeTransform> _patMasterPos;
@@ -66,16 +93,24 @@ private:
     osg::ref_ptr<osg::PositionAttitudeTransform> _patSceneryPos;
     osg::ref_ptr<osg::PositionAttitudeTransform> _patSceneryAtt;
 
+    osg::ref_ptr<osg::Group> _groupScenery;
+
     osg::ref_ptr<osg::Geode> _geodeShadow;
 
     osg::ref_ptr<osgSim::OverlayNode> _on;
 
+    void addObject( Module *object, double lat, double lon, double alt );
+
     void createShadow();
 
     void readAirports( const fdm::XmlNode &node );
     void readLandmarks( const fdm::XmlNode &node );
 
     void readTerrain( const fdm::XmlNode &node );
+
+    void setActive( int index, bool active );
+
+    void updateObjects( const WGS84 &wgs );
 };
 
 } // end of cgi namespace
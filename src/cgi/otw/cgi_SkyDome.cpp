@@ -26,11 +26,18 @@
 #   include <algorithm>
 #endif
 
+#include <cfloat>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
 #include <osg/Geode>
 #include <osg/Geometry>
 #include <osg/Light>
+#include <osg/Point>
+#include <osg/PointSprite>
 #include <osg/PolygonOffset>
 
 #include <Data.h>
@@ -39,7 +46,9 @@
 
 #include <cgi/cgi_Colors.h>
 #include <cgi/cgi_Defines.h>
+#include <cgi/cgi_FrameStats.h>
 #include <cgi/cgi_Geometry.h>
+#include <cgi/cgi_Origin.h>
 #include <cgi/cgi_WGS84.h>
 
 #include <sim/Path.h>
@@ -50,6 +59,38 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const char starsCacheMagic[ 8 ] = { 'C', 'G', 'I', 'S', 'T', 'A', 'R', '1' };
+
+/** Star cache record, plain data which might be copied with memcpy. */
+struct StarRecord
+{
+    float x;            ///< [m] position x-coordinate
+    float y;            ///< [m] position y-coordinate
+    float z;            ///< [m] position z-coordinate
+    float brightness;   ///< [-] relative brightness
+};
+
+/** Computes hash (FNV-1a) of the catalog content. */
+fdm::UInt64 getHash( const std::string &data )
+{
+    fdm::UInt64 hash = 14695981039346656037ULL;
+
+    for ( size_t i = 0; i < data.size(); i++ )
+    {
+        hash ^= (fdm::UInt8)data[ i ];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 const float SkyDome::_sunRadius  = CGI_SKYDOME_RADIUS * tan( osg::DegreesToRadians( CGI_SKYDOME_DIAMETER_SUN  / 2.0 ) );
 const float SkyDome::_moonRadius = CGI_SKYDOME_RADIUS * tan( osg::DegreesToRadians( CGI_SKYDOME_DIAMETER_MOON / 2.0 ) );
 
@@ -79,8 +120,12 @@ SkyDome::SkyDome( const Module *parent ) :
     _moonElev  ( 0.0f ),
     _moonAzim  ( 0.0f ),
 
-    _starIntensity ( 0 ),
-    _starsCount ( 0 )
+    _starsIntensity ( 0.0f ),
+
+    _sunElevColors  ( -FLT_MAX ),
+    _moonElevColors ( -FLT_MAX ),
+    _moonAgeColors  ( -FLT_MAX ),
+    _foggyColors ( false )
 {
     _root->setName( "SkyDome" );
 
@@ -122,11 +167,7 @@ SkyDome::SkyDome( const Module *parent ) :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SkyDome::~SkyDome()
-{
-    if ( _starIntensity ) delete [] _starIntensity;
-    _starIntensity = 0;
-}
+SkyDome::~SkyDome() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -136,6 +177,8 @@ void SkyDome::update()
     Module::update();
     /////////////////
 
+    CGI_FRAME_STATS_ZONE( ModuleSkyDome, "SkyDome::update" );
+
     _dateTime.year   = Data::get()->dateTime.year;
     _dateTime.month  = Data::get()->dateTime.month;
     _dateTime.day    = Data::get()->dateTime.day;
@@ -197,7 +240,7 @@ void SkyDome::update()
                delta_h );
 
     _attitude->setAttitude( wgs.getAttitude() );
-    _position->setPosition( wgs.getPosition() );
+    _position->setPosition( Origin::toScene( wgs.getPosition() ) );
 #   ifdef SIM_SKYDOME_SCALING
     osg::Vec3 vecSkyScale( _skyScale, _skyScale, _skyScale );
     _position ->setScale( vecSkyScale );
@@ -219,77 +262,9 @@ void SkyDome::update()
     _patSun->setAttitude( Q_sun );
     _patMoon->setAttitude( Q_moon );
 
-    float sun_elevation_deg  = osg::RadiansToDegrees( _sunElev  );
-    float moon_elevation_deg = osg::RadiansToDegrees( _moonElev );
-
-    // Sky
-    unsigned short sky_num = 0;
-
-    if ( sun_elevation_deg >= -10.0f )
-    {
-        if ( sun_elevation_deg < 10.0f )
-        {
-            sky_num = floor( 8 * ( sun_elevation_deg + 10.0f ) / 20.0f + 0.5f );
-            sky_num = std::min( std::max( (int)sky_num, 0 ), 8 );
-        }
-        else
-        {
-            sky_num = 8;
-        }
-    }
-
-    if ( Data::get()->cgi.environment.visibility < CGI_FOG_LIMIT )
-    {
-        unsigned short fog_num = FogScene::getFogNumber( sun_elevation_deg );
-
-        if ( _textureFog != fog_num && fog_num < _texturesFog.size() )
-        {
-            _textureSky = 0;
-            _textureFog = fog_num;
-            _geodeSky->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesFog[ _textureFog ], osg::StateAttribute::ON );
-        }
-    }
-    else
-    {
-        if ( _textureSky != sky_num && sky_num < _texturesSky.size() )
-        {
-            _textureFog = 0;
-            _textureSky = sky_num;
-            _geodeSky->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesSky[ _textureSky ], osg::StateAttribute::ON );
-        }
-    }
-
-    // Sun
-    unsigned short numSun = 0;
-
-    if ( sun_elevation_deg >= 0.0f && sun_elevation_deg < 10.0f )
-    {
-        numSun = floor( 10.0f * ( sun_elevation_deg ) / 10.0f + 0.5f );
-    }
-    else
-    {
-        numSun = ( sun_elevation_deg < 0.0f ) ? 0 : 10;
-    }
-
-    numSun = std::min( std::max( (int)numSun, 0 ), 10 );
-
-    osg::Vec4 sunColor( Colors::_sun[ numSun ], 1.0f );
-
-    _materialSun->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
-    _materialSun->setAmbient( osg::Material::FRONT, sunColor );
-    _materialSun->setDiffuse( osg::Material::FRONT, sunColor );
-
-    _geodeSunFace->getOrCreateStateSet()->setAttribute( _materialSun.get() );
-
-    if ( _textureSun != numSun && numSun < _texturesSun.size() )
-    {
-        _textureSun = numSun;
-
-        _geodeSunHalo->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesSun[ _textureSun ], osg::StateAttribute::ON );
-    }
-
-    // Moon
-    unsigned short numMoon = 0;
+    // Sun direction in world coordinates
+    osg::Vec3d dir_sun = ( Q_sun * wgs.getAttitude() ) * osg::X_AXIS;
+    _lightShadow->setPosition( osg::Vec4d( dir_sun, 0.0 ) );
 
     // known new moon : 2000-01-06 18:15 UTC
     // synodic month  : 29.530587981 days
@@ -299,116 +274,19 @@ void SkyDome::update()
     // 3rd Quarter : 0.75
     // New Moon    : 1.0
     double moonTmp = ( _ephemeris.getJD() - 2451550.0 ) / 29.530587981;
-    double moonAge = moonTmp - floor( moonTmp );
+    float moonAge = moonTmp - floor( moonTmp );
 
-    numMoon = floor( 7.0 * moonAge + 0.5 );
-    numMoon = std::min( std::max( (int)numMoon, 0 ), 7 );
+    bool foggy = Data::get()->cgi.environment.visibility < CGI_FOG_LIMIT;
 
-    if ( _textureMoon != numMoon && numMoon < _texturesMoon.size() )
+    // sky, Sun, Moon, stars and lights colors depend only on the Sun and Moon
+    // elevations, Moon age and whether it is foggy, so they are updated only
+    // when these change noticeably
+    if ( fabs( _sunElev  - _sunElevColors  ) > CGI_SKYDOME_COLORS_ELEV_STEP
+      || fabs( _moonElev - _moonElevColors ) > CGI_SKYDOME_COLORS_ELEV_STEP
+      || fabs( moonAge   - _moonAgeColors  ) > CGI_SKYDOME_COLORS_AGE_STEP
+      || foggy != _foggyColors )
     {
-        _textureMoon = numMoon;
-
-        _geodeMoon->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesMoon[ _textureMoon ], osg::StateAttribute::ON );
-    }
-
-    // Stars
-    float starsIntensity = 0.0f;
-
-    if ( -5.0f < sun_elevation_deg && sun_elevation_deg < 5.0f )
-    {
-        starsIntensity = 1.0f - ( sun_elevation_deg + 5.0f ) / 10.0f;
-    }
-    else
-    {
-        if ( sun_elevation_deg < -5.0f )
-        {
-            starsIntensity = 1.0f;
-        }
-        else
-        {
-            starsIntensity = 0.0f;
-        }
-    }
-
-    if ( starsIntensity > 0.0f )
-    {
-        _switchStars->setAllChildrenOn();
-
-        if ( starsIntensity > 1.0f ) starsIntensity = 1.0f;
-
-        osgSim::LightPointNode::LightPointList lightPointList = _stars->getLightPointList();
-
-        for ( unsigned int i = 0; i < lightPointList.size(); i++ )
-        {
-            lightPointList[ i ]._intensity = starsIntensity * _starIntensity[ i ];
-        }
-
-        _stars->setLightPointList( lightPointList );
-    }
-    else
-    {
-        _switchStars->setAllChildrenOff();
-    }
-
-    // Sun Light
-    osg::ref_ptr<osg::Light> lightSun = _lightSourceSun->getLight();
-
-    if ( lightSun.valid() )
-    {
-        float intensityDiffuse = 0.0f;
-        float intensityAmbient = 0.0f;
-
-        if ( -0.5f < sun_elevation_deg && sun_elevation_deg < 0.5f )
-        {
-            intensityDiffuse = sun_elevation_deg + 0.5f;
-        }
-        else
-        {
-            intensityDiffuse = ( sun_elevation_deg < -0.5f ) ? 0.0f : 1.0f;
-        }
-
-        if ( -5.0f < sun_elevation_deg && sun_elevation_deg < 5.0f )
-        {
-            intensityAmbient = ( sun_elevation_deg + 5.0f ) / 10.0f;
-        }
-        else
-        {
-            intensityAmbient = ( sun_elevation_deg < -5.0f ) ? 0.0f : 0.9f;
-        }
-
-        osg::Vec4 sunLightColorDiffuse( Colors::_sun[ numSun ] * intensityDiffuse, 0.0f );
-        osg::Vec4 sunLightColorAmbient( Colors::_sun[   10   ] * intensityAmbient, 0.0f );
-
-        lightSun->setAmbient( sunLightColorAmbient );
-        lightSun->setDiffuse( sunLightColorDiffuse );
-    }
-
-    // Moon Light
-    osg::ref_ptr<osg::Light> lightMoon = _lightSourceMoon->getLight();
-
-    if ( lightMoon.valid() )
-    {
-        float intensity = 0.0f;
-
-        if ( 0.0f < moon_elevation_deg )
-        {
-            if ( moon_elevation_deg < 5.0f )
-            {
-                intensity = moon_elevation_deg / 5.0f;
-            }
-            else
-            {
-                intensity = 1.0f;
-            }
-
-            float ageCoef = 1.0 - fabs( 2.0f * ( moonAge - 0.5f ) );
-            intensity *= ageCoef;
-        }
-
-        osg::Vec4 moonLightColor( Colors::_moon * intensity, 0.0f );
-
-        lightMoon->setAmbient( moonLightColor );
-        lightMoon->setDiffuse( moonLightColor );
+        updateColors( moonAge, foggy );
     }
 
     Data::get()->cgi.skyDome.skyScale = _skyScale;
@@ -640,146 +518,399 @@ void SkyDome::createStars()
     _switchStars = new osg::Switch();
     _patSky->addChild( _switchStars.get() );
 
-    _stars = new osgSim::LightPointNode();
-    _switchStars->addChild( _stars.get() );
+    osg::ref_ptr<osg::Geode> geode = new osg::Geode();
+    _switchStars->addChild( geode.get() );
 
-    float magLimit = 4.5f;
+    _stars = new osg::Geometry();
+    geode->addDrawable( _stars.get() );
 
-    FILE *file = fopen( Path::get( "cgi/stars.csv" ).c_str(), "r" );
+    osg::ref_ptr<osg::Vec3Array> v = new osg::Vec3Array();
 
-    if ( file )
-    {
-        float alpha = 0.0f;
-        float delta = 0.0f;
-        float mag = 0.0f;
+    readStars( v.get() );
 
-        while ( !feof( file ) )
-        {
-            if ( fscanf( file, "%f,%f,%f\n", &alpha, &delta, &mag ) == 3 )
-            {
-                if ( mag < magLimit )
-                {
-                    createStar( alpha, delta, mag );
-                }
-                else
-                {
-                    break;
-                }
-            }
-            else
-            {
-                break;
-            }
-        }
+    _starsColors = new osg::Vec4Array( v->size() );
 
-        //osg::notify(osg::ALWAYS) << starsCount << " stars brighter than " << magLimit << "mag" << std::endl;
+    _stars->setVertexArray( v.get() );
+    _stars->setColorArray( _starsColors.get() );
+    _stars->setColorBinding( osg::Geometry::BIND_PER_VERTEX );
+    _stars->addPrimitiveSet( new osg::DrawArrays( osg::PrimitiveSet::POINTS, 0, v->size() ) );
+    _stars->setUseDisplayList( false );
+    _stars->setUseVertexBufferObjects( true );
+    _stars->setDataVariance( osg::Object::DYNAMIC );
 
-        fclose( file );
-    }
+    updateStars( 1.0f );
+
+    osg::ref_ptr<osg::StateSet> stateSet = geode->getOrCreateStateSet();
 
     // texture
     osg::ref_ptr<osg::Texture2D> texture = _texturesStars.at( 0 );
     if ( texture.valid() )
     {
-        osg::ref_ptr<osg::StateSet> stateSet = _stars->getOrCreateStateSet();
-        _stars->setPointSprite();
+        osg::ref_ptr<osg::PointSprite> pointSprite = new osg::PointSprite();
+        stateSet->setTextureAttributeAndModes( 0, pointSprite.get(), osg::StateAttribute::ON );
         stateSet->setTextureAttributeAndModes( 0, texture.get(), osg::StateAttribute::ON );
     }
 
+    osg::ref_ptr<osg::Point> point = new osg::Point();
+    point->setSize( 4.0f );
+    stateSet->setAttribute( point.get() );
+
+    stateSet->setMode( GL_LIGHTING, osg::StateAttribute::OFF | osg::StateAttribute::PROTECTED );
+    stateSet->setMode( GL_BLEND, osg::StateAttribute::ON );
+
     _switchStars->getOrCreateStateSet()->setAttributeAndModes( new osg::PolygonOffset( 1.0f, _offsetStars ), osg::StateAttribute::ON );
     _switchStars->getOrCreateStateSet()->setRenderBinDetails( CGI_DEPTH_SORTED_BIN_STARS, "DepthSortedBin" );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void SkyDome::createStar( float alpha, float delta, float mag, bool trueIntensity )
+void SkyDome::readStars( osg::Vec3Array *positions )
 {
-    float intensity = 0.0f;
+    std::string catalogFile = Path::get( "cgi/stars.csv" );
+    std::string cacheFile = catalogFile + ".cache";
 
-    if ( !trueIntensity )
+    std::string data;
+
+    std::ifstream ifs( catalogFile.c_str(), std::ios_base::in | std::ios_base::binary );
+
+    if ( ifs.is_open() )
     {
-        if ( mag < 1.0 ) mag = 1.0;
-        if ( mag > 3.0 ) mag = 3.0;
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        data = ss.str();
     }
 
-    // illuminance (bisection)
-    double E_0 = 1.0e-7;
-    double E_1 = 1.0;
+    fdm::UInt64 hash = getHash( data );
+
+    if ( readStarsCache( cacheFile, hash, positions ) ) return;
 
-    double E_C = E_0 + ( E_1 - E_0 ) / 2.0;
+    positions->clear();
+    _starsBrightness.clear();
+
+    const float magLimit = 4.5f;
+
+    float r = CGI_SKYDOME_RADIUS + _offsetStars;
 
-    for ( int i = 0; i < 10000; i++ )
+    float alpha = 0.0f;
+    float delta = 0.0f;
+    float mag = 0.0f;
+
+    std::istringstream iss( data );
+    std::string line;
+
+    while ( std::getline( iss, line ) )
+    {
+        if ( sscanf( line.c_str(), "%f,%f,%f", &alpha, &delta, &mag ) != 3 ) break;
+
+        // catalog is sorted by magnitude
+        if ( mag >= magLimit ) break;
+
+        double alpha_rad = M_PI * alpha / 12.0;
+        double delta_rad = osg::DegreesToRadians( delta );
+
+        double z  = r * sin( delta_rad );
+        double xy = r * cos( delta_rad );
+        double x  = xy * cos( alpha_rad );
+        double y  = xy * sin( alpha_rad );
+
+        positions->push_back( osg::Vec3( x, y, z ) );
+
+        // illuminance is proportional to 10^(-0.4 m), relative to 1 mag star
+        if ( mag < 1.0f ) mag = 1.0f;
+        if ( mag > 3.0f ) mag = 3.0f;
+
+        _starsBrightness.push_back( pow( 10.0, -0.4 * ( mag - 1.0 ) ) );
+    }
+
+    if ( positions->size() > 0 ) writeStarsCache( cacheFile, hash, positions );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SkyDome::readStarsCache( const std::string &cacheFile, fdm::UInt64 hash,
+                              osg::Vec3Array *positions )
+{
+    std::ifstream ifs( cacheFile.c_str(), std::ios_base::in | std::ios_base::binary );
+
+    if ( !ifs.is_open() ) return false;
+
+    char magic[ sizeof(starsCacheMagic) ];
+
+    fdm::UInt64 cacheHash = 0;
+    fdm::UInt32 count = 0;
+
+    ifs.read( magic, sizeof(magic) );
+    ifs.read( (char*)&cacheHash, sizeof(fdm::UInt64) );
+    ifs.read( (char*)&count, sizeof(fdm::UInt32) );
+
+    if ( ifs.fail()
+      || 0 != memcmp( magic, starsCacheMagic, sizeof(starsCacheMagic) )
+      || cacheHash != hash || count == 0 )
+    {
+        return false;
+    }
+
+    std::vector< StarRecord > records( count );
+
+    ifs.read( (char*)&records[ 0 ], count * sizeof(StarRecord) );
+
+    if ( ifs.fail() ) return false;
+
+    positions->resize( count );
+    _starsBrightness.resize( count );
+
+    for ( fdm::UInt32 i = 0; i < count; i++ )
+    {
+        (*positions)[ i ] = osg::Vec3( records[ i ].x, records[ i ].y, records[ i ].z );
+        _starsBrightness[ i ] = records[ i ].brightness;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SkyDome::writeStarsCache( const std::string &cacheFile, fdm::UInt64 hash,
+                               const osg::Vec3Array *positions )
+{
+    std::vector< StarRecord > records( positions->size() );
+
+    for ( unsigned int i = 0; i < positions->size(); i++ )
+    {
+        records[ i ].x = (*positions)[ i ].x();
+        records[ i ].y = (*positions)[ i ].y();
+        records[ i ].z = (*positions)[ i ].z();
+        records[ i ].brightness = _starsBrightness[ i ];
+    }
+
+    // written into temporary file first and then renamed, so other instances
+    // never read a partially written cache file
+    std::stringstream tempFile;
+    tempFile << cacheFile << "." << (const void*)this;
+
+    std::ofstream ofs( tempFile.str().c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+
+    // data directory might be read-only, catalog is parsed every time then
+    if ( !ofs.is_open() ) return;
+
+    fdm::UInt32 count = records.size();
+
+    ofs.write( starsCacheMagic, sizeof(starsCacheMagic) );
+    ofs.write( (const char*)&hash, sizeof(fdm::UInt64) );
+    ofs.write( (const char*)&count, sizeof(fdm::UInt32) );
+    ofs.write( (const char*)&records[ 0 ], count * sizeof(StarRecord) );
+
+    ofs.close();
+
+    if ( ofs.fail() || 0 != rename( tempFile.str().c_str(), cacheFile.c_str() ) )
     {
-        double m = -2.5 * log10( E_C ) - 14.05;
+        remove( tempFile.str().c_str() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SkyDome::updateColors( float moonAge, bool foggy )
+{
+    _sunElevColors  = _sunElev;
+    _moonElevColors = _moonElev;
+    _moonAgeColors  = moonAge;
+    _foggyColors    = foggy;
 
-        if ( m > mag )
-            E_0 = E_C;
+    float sun_elevation_deg  = osg::RadiansToDegrees( _sunElev  );
+    float moon_elevation_deg = osg::RadiansToDegrees( _moonElev );
+
+    // Sky
+    unsigned short sky_num = 0;
+
+    if ( sun_elevation_deg >= -10.0f )
+    {
+        if ( sun_elevation_deg < 10.0f )
+        {
+            sky_num = floor( 8 * ( sun_elevation_deg + 10.0f ) / 20.0f + 0.5f );
+            sky_num = std::min( std::max( (int)sky_num, 0 ), 8 );
+        }
         else
-            E_1 = E_C;
+        {
+            sky_num = 8;
+        }
+    }
 
-        E_C = E_0 + ( E_1 - E_0 ) / 2.0;
+    if ( foggy )
+    {
+        unsigned short fog_num = FogScene::getFogNumber( sun_elevation_deg );
 
-        if ( fabs( mag - m ) < 0.001 ) break;
+        if ( _textureFog != fog_num && fog_num < _texturesFog.size() )
+        {
+            _textureSky = 0;
+            _textureFog = fog_num;
+            _geodeSky->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesFog[ _textureFog ], osg::StateAttribute::ON );
+        }
+    }
+    else
+    {
+        if ( _textureSky != sky_num && sky_num < _texturesSky.size() )
+        {
+            _textureFog = 0;
+            _textureSky = sky_num;
+            _geodeSky->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesSky[ _textureSky ], osg::StateAttribute::ON );
+        }
     }
 
-    // sphere area
-    float r = CGI_SKYDOME_RADIUS + _offsetStars;
-    float S = 4.0 * M_PI * r * r;
+    // Sun
+    unsigned short numSun = 0;
 
-    // total luminous flux
-    float phi = S * E_C;
+    if ( sun_elevation_deg >= 0.0f && sun_elevation_deg < 10.0f )
+    {
+        numSun = floor( 10.0f * ( sun_elevation_deg ) / 10.0f + 0.5f );
+    }
+    else
+    {
+        numSun = ( sun_elevation_deg < 0.0f ) ? 0 : 10;
+    }
 
-    intensity = phi / 1000.0;
+    numSun = std::min( std::max( (int)numSun, 0 ), 10 );
 
-    // intensity tuning
-    intensity *= 2.0f;
+    osg::Vec4 sunColor( Colors::_sun[ numSun ], 1.0f );
 
-    ////////////////////////////////////////
+    _materialSun->setColorMode( osg::Material::AMBIENT_AND_DIFFUSE );
+    _materialSun->setAmbient( osg::Material::FRONT, sunColor );
+    _materialSun->setDiffuse( osg::Material::FRONT, sunColor );
 
-    double alpha_rad = M_PI * alpha / 12.0;
-    double delta_rad = osg::DegreesToRadians( delta );
+    _geodeSunFace->getOrCreateStateSet()->setAttribute( _materialSun.get() );
 
-    double z  = r * sin( delta_rad );
-    double xy = r * cos( delta_rad );
-    double x  = xy * cos( alpha_rad );
-    double y  = xy * sin( alpha_rad );
+    if ( _textureSun != numSun && numSun < _texturesSun.size() )
+    {
+        _textureSun = numSun;
 
-    osg::Vec3d position( x, y, z );
-    osg::Vec4 color( 1.0, 1.0, 1.0, 1.0 );
+        _geodeSunHalo->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesSun[ _textureSun ], osg::StateAttribute::ON );
+    }
 
-    osgSim::LightPoint star( position, color );
+    // Moon
+    unsigned short numMoon = 0;
 
-    star._intensity = intensity;
-    star._radius    = 0.0005f * CGI_SKYDOME_RADIUS;
+    numMoon = floor( 7.0 * moonAge + 0.5 );
+    numMoon = std::min( std::max( (int)numMoon, 0 ), 7 );
 
-    if ( _starsCount > 0 )
+    if ( _textureMoon != numMoon && numMoon < _texturesMoon.size() )
     {
-        std::vector< float > tempIntensity;
+        _textureMoon = numMoon;
+
+        _geodeMoon->getOrCreateStateSet()->setTextureAttributeAndModes( 0, _texturesMoon[ _textureMoon ], osg::StateAttribute::ON );
+    }
+
+    // Stars
+    float starsIntensity = 0.0f;
 
-        for ( int i = 0; i < _starsCount; i++ )
+    if ( -5.0f < sun_elevation_deg && sun_elevation_deg < 5.0f )
+    {
+        starsIntensity = 1.0f - ( sun_elevation_deg + 5.0f ) / 10.0f;
+    }
+    else
+    {
+        if ( sun_elevation_deg < -5.0f )
+        {
+            starsIntensity = 1.0f;
+        }
+        else
         {
-            tempIntensity.push_back( _starIntensity[ i ] );
+            starsIntensity = 0.0f;
         }
+    }
 
-        delete [] _starIntensity;
+    if ( starsIntensity > 0.0f )
+    {
+        _switchStars->setAllChildrenOn();
 
-        _starIntensity = new float [ _starsCount + 1 ];
+        if ( starsIntensity > 1.0f ) starsIntensity = 1.0f;
 
-        for ( int i = 0; i < _starsCount; i++ )
+        // colors are rewritten only during twilight, when intensity changes
+        if ( fabs( starsIntensity - _starsIntensity ) > 0.01f || starsIntensity == 1.0f )
         {
-            _starIntensity[ i ] = tempIntensity.at( i );
+            updateStars( starsIntensity );
         }
     }
     else
     {
-        _starIntensity = new float [ 1 ];
+        _switchStars->setAllChildrenOff();
+    }
+
+    // Sun Light
+    osg::ref_ptr<osg::Light> lightSun = _lightSourceSun->getLight();
+
+    if ( lightSun.valid() )
+    {
+        float intensityDiffuse = 0.0f;
+        float intensityAmbient = 0.0f;
+
+        if ( -0.5f < sun_elevation_deg && sun_elevation_deg < 0.5f )
+        {
+            intensityDiffuse = sun_elevation_deg + 0.5f;
+        }
+        else
+        {
+            intensityDiffuse = ( sun_elevation_deg < -0.5f ) ? 0.0f : 1.0f;
+        }
+
+        if ( -5.0f < sun_elevation_deg && sun_elevation_deg < 5.0f )
+        {
+            intensityAmbient = ( sun_elevation_deg + 5.0f ) / 10.0f;
+        }
+        else
+        {
+            intensityAmbient = ( sun_elevation_deg < -5.0f ) ? 0.0f : 0.9f;
+        }
+
+        osg::Vec4 sunLightColorDiffuse( Colors::_sun[ numSun ] * intensityDiffuse, 0.0f );
+        osg::Vec4 sunLightColorAmbient( Colors::_sun[   10   ] * intensityAmbient, 0.0f );
+
+        lightSun->setAmbient( sunLightColorAmbient );
+        lightSun->setDiffuse( sunLightColorDiffuse );
+    }
+
+    // Moon Light
+    osg::ref_ptr<osg::Light> lightMoon = _lightSourceMoon->getLight();
+
+    if ( lightMoon.valid() )
+    {
+        float intensity = 0.0f;
+
+        if ( 0.0f < moon_elevation_deg )
+        {
+            if ( moon_elevation_deg < 5.0f )
+            {
+                intensity = moon_elevation_deg / 5.0f;
+            }
+            else
+            {
+                intensity = 1.0f;
+            }
+
+            float ageCoef = 1.0 - fabs( 2.0f * ( moonAge - 0.5f ) );
+            intensity *= ageCoef;
+        }
+
+        osg::Vec4 moonLightColor( Colors::_moon * intensity, 0.0f );
+
+        lightMoon->setAmbient( moonLightColor );
+        lightMoon->setDiffuse( moonLightColor );
     }
+}
 
-    _starIntensity[ _starsCount ] = star._intensity;
+////////////////////////////////////////////////////////////////////////////////
 
-    _starsCount++;
+void SkyDome::updateStars( float intensity )
+{
+    if ( intensity == _starsIntensity ) return;
+
+    _starsIntensity = intensity;
+
+    for ( unsigned int i = 0; i < _starsColors->size() && i < _starsBrightness.size(); i++ )
+    {
+        (*_starsColors)[ i ] = osg::Vec4( 1.0f, 1.0f, 1.0f, intensity * _starsBrightness[ i ] );
+    }
 
-    _stars->addLightPoint( star );
+    _starsColors->dirty();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -828,6 +959,8 @@ void SkyDome::createLightSun()
 
     _lightSourceSun->setLight( lightSun.get() );
 
+    _lightShadow = new osg::Light( *lightSun );
+
     _lightSourceSun->setLocalStateSetModes( osg::StateAttribute::ON );
     _lightSourceSun->setStateSetModes( *_root->getOrCreateStateSet(), osg::StateAttribute::ON );
 }
@@ -24,13 +24,17 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <string>
+#include <vector>
+
+#include <osg/Geometry>
 #include <osg/LightSource>
 #include <osg/Material>
 #include <osg/PositionAttitudeTransform>
 #include <osg/Switch>
 #include <osg/Texture2D>
 
-#include <osgSim/LightPointNode>
+#include <fdm/fdm_Types.h>
 
 #include <cgi/cgi_Ephemeris.h>
 #include <cgi/cgi_Module.h>
@@ -65,6 +69,9 @@ public:
     /** @brief Updates sky dome. */
     void update();
 
+    /** @brief Returns Sun light expressed in world coordinates (used by shadow maps). */
+    inline osg::Light* getLightShadow() { return _lightShadow.get(); }
+
 private:
 
     Ephemeris _ephemeris;
@@ -92,7 +99,10 @@ private:
     osg::ref_ptr<osg::LightSource> _lightSourceMoon;
     osg::ref_ptr<osg::LightSource> _lightSourceStars;
 
-    osg::ref_ptr<osgSim::LightPointNode> _stars;
+    osg::ref_ptr<osg::Light> _lightShadow;      ///< Sun light in world coordinates, not attached to the scene
+
+    osg::ref_ptr<osg::Geometry> _stars;         ///< stars point sprites
+    osg::ref_ptr<osg::Vec4Array> _starsColors;  ///< stars colors
 
     Textures::List _texturesSky;    ///<
     Textures::List _texturesFog;    ///<
@@ -116,8 +126,13 @@ private:
     float _moonElev;        ///< [rad] Moon elevation
     float _moonAzim;        ///< [rad] Moon azimuth
 
-    float *_starIntensity;  ///<
-    int _starsCount;        ///<
+    std::vector< float > _starsBrightness;      ///< [-] stars relative brightness
+    float _starsIntensity;  ///< [-] stars intensity applied to stars colors
+
+    float _sunElevColors;   ///< [rad] Sun elevation colors were updated for
+    float _moonElevColors;  ///< [rad] Moon elevation colors were updated for
+    float _moonAgeColors;   ///< [-] Moon age colors were updated for
+    bool _foggyColors;      ///< specifies if colors were updated for foggy sky
 
     void createTextures();
 
@@ -127,7 +142,21 @@ private:
     void createSunHalo();
     void createMoon();
     void createStars();
-    void createStar( float alpha, float delta, float mag, bool trueIntensity = false );
+
+    void readStars( osg::Vec3Array *positions );
+    bool readStarsCache( const std::string &cacheFile, fdm::UInt64 hash,
+                         osg::Vec3Array *positions );
+    void writeStarsCache( const std::string &cacheFile, fdm::UInt64 hash,
+                          const osg::Vec3Array *positions );
+
+    void updateStars( float intensity );
+
+    /**
+     * @brief Updates sky, Sun, Moon and stars textures and colors and lights.
+     * @param moonAge [-] Moon age (0.0 new moon, 0.5 full moon)
+     * @param foggy specifies if visibility is below fog limit
+     */
+    void updateColors( float moonAge, bool foggy );
 
     void createLightMoon();
     void createLightSun();
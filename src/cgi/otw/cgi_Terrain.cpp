@@ -22,7 +22,26 @@
 
 #include <cgi/otw/cgi_Terrain.h>
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include <osgDB/FileNameUtils>
+#include <osgDB/ReaderWriter>
+#include <osgDB/Registry>
+
+#include <Data.h>
+
+#include <cgi/cgi_Defines.h>
+#include <cgi/cgi_Loader.h>
 #include <cgi/cgi_Models.h>
+#include <cgi/cgi_WGS84.h>
+
+#include <sim/Path.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -30,8 +49,167 @@ using namespace cgi;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const char tilesChildrenExt[] = "cgi_tiles";
+
+std::mutex tilesMutex;                                  ///< tiles sets mutex
+std::map< std::string, Terrain::Tiles > tilesSets;      ///< tiles sets indexed by directories
+
+/** Returns tile mesh file name. */
+std::string getTileFile( const Terrain::Tiles &tiles, int level, int i, int j,
+                         const char *ext )
+{
+    std::stringstream ss;
+    ss << tiles.dir << "/" << level << "/" << i << "_" << j << "." << ext;
+    return ss.str();
+}
+
+/** Computes tile bounding sphere. */
+void getTileBound( const Terrain::Tiles &tiles, int level, int i, int j,
+                   osg::Vec3d *center, double *radius )
+{
+    int n = 1 << level;
+
+    double d_lat = ( tiles.lat_max - tiles.lat_min ) / n;
+    double d_lon = ( tiles.lon_max - tiles.lon_min ) / n;
+
+    double lat_0 = tiles.lat_min + i * d_lat;
+    double lon_0 = tiles.lon_min + j * d_lon;
+
+    *center = WGS84::geo2wgs( lat_0 + 0.5 * d_lat, lon_0 + 0.5 * d_lon, 0.0 );
+    *radius = 0.0;
+
+    for ( int k = 0; k < 4; k++ )
+    {
+        osg::Vec3d corner = WGS84::geo2wgs( lat_0 + ( k / 2 ) * d_lat,
+                                            lon_0 + ( k % 2 ) * d_lon, 0.0 );
+
+        *radius = std::max( *radius, ( corner - *center ).length() );
+    }
+
+    // margin for terrain elevation and tile bulge
+    *radius *= 1.1;
+}
+
+/** Returns index of tile containing given coordinate, -1 if outside. */
+int getTileIndex( double val, double min, double max, int level )
+{
+    int n = 1 << level;
+    int i = static_cast< int >( floor( n * ( val - min ) / ( max - min ) ) );
+
+    return ( i < 0 || i >= n ) ? -1 : i;
+}
+
+/**
+ * Pseudo-loader of tile children. File "<dir>/<L>/<i>_<j>.cgi_tiles" is not
+ * a real file, it stands for the group of 4 child tiles of the given tile.
+ */
+class TilesReader : public osgDB::ReaderWriter
+{
+public:
+
+    TilesReader()
+    {
+        supportsExtension( tilesChildrenExt, "MScSim paged terrain tile children" );
+    }
+
+    virtual const char* className() const { return "MScSim paged terrain tiles"; }
+
+    virtual ReadResult readNode( const std::string &file, const Options *options ) const
+    {
+        if ( !acceptsExtension( osgDB::getLowerCaseFileExtension( file ) ) )
+        {
+            return ReadResult::FILE_NOT_HANDLED;
+        }
+
+        std::string levelDir = osgDB::getFilePath( file );
+        std::string dir = osgDB::getFilePath( levelDir );
+        std::string name = osgDB::getStrippedName( file );
+
+        int level = 0;
+        int i = 0;
+        int j = 0;
+
+        if ( 1 != sscanf( osgDB::getSimpleFileName( levelDir ).c_str(), "%d", &level )
+          || 2 != sscanf( name.c_str(), "%d_%d", &i, &j ) )
+        {
+            return ReadResult::FILE_NOT_FOUND;
+        }
+
+        Terrain::Tiles tiles;
+
+        {
+            std::lock_guard< std::mutex > lock( tilesMutex );
+
+            std::map< std::string, Terrain::Tiles >::iterator it = tilesSets.find( dir );
+
+            if ( it == tilesSets.end() ) return ReadResult::FILE_NOT_FOUND;
+
+            tiles = it->second;
+        }
+
+        osg::ref_ptr<Options> tilesOptions = options ? new Options( *options ) : new Options();
+
+        osg::ref_ptr<osg::Group> group = new osg::Group();
+
+        for ( int k = 0; k < 4; k++ )
+        {
+            group->addChild( Terrain::createTile( tiles, level + 1,
+                                                  2 * i + k / 2, 2 * j + k % 2,
+                                                  tilesOptions.get() ) );
+        }
+
+        return group.release();
+    }
+};
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::PagedLOD* Terrain::createTile( const Tiles &tiles, int level, int i, int j,
+                                    osgDB::Options *options )
+{
+    osg::Vec3d center;
+    double radius = 0.0;
+
+    getTileBound( tiles, level, i, j, &center, &radius );
+
+    osg::ref_ptr<osg::PagedLOD> tile = new osg::PagedLOD();
+
+    tile->setCenterMode( osg::LOD::USER_DEFINED_CENTER );
+    tile->setCenter( center );
+    tile->setRadius( radius );
+    tile->setRangeMode( osg::LOD::DISTANCE_FROM_EYE_POINT );
+    tile->setDatabaseOptions( options );
+
+    tile->setFileName( 0, getTileFile( tiles, level, i, j, tiles.ext.c_str() ) );
+
+    if ( level < tiles.levels - 1 )
+    {
+        // tile is replaced by its children when viewed from closer than this
+        double split = CGI_TERRAIN_LOD_FACTOR * radius;
+
+        tile->setRange( 0, split, FLT_MAX );
+
+        tile->setFileName( 1, getTileFile( tiles, level, i, j, tilesChildrenExt ) );
+        tile->setRange( 1, 0.0f, split );
+    }
+    else
+    {
+        tile->setRange( 0, 0.0f, FLT_MAX );
+    }
+
+    return tile.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Terrain::Terrain( const char *file, const Module *parent ) :
-    Module( parent )
+    Module( parent ),
+    _paged ( false )
 {
     osg::ref_ptr<osg::Node> terrain = Models::get( file );
 
@@ -43,4 +221,105 @@ Terrain::Terrain( const char *file, const Module *parent ) :
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Terrain::Terrain( const Tiles &tiles, const Module *parent ) :
+    Module( parent ),
+    _tiles ( tiles ),
+    _paged ( true )
+{
+    _tiles.dir = osgDB::convertFileNameToUnixStyle( Path::get( tiles.dir ) );
+
+    {
+        std::lock_guard< std::mutex > lock( tilesMutex );
+
+        if ( tilesSets.empty() )
+        {
+            osgDB::Registry::instance()->addReaderWriter( new TilesReader() );
+        }
+
+        tilesSets[ _tiles.dir ] = _tiles;
+    }
+
+    // tiles are kept in the object cache, expired by the database pager
+    // when they are no longer referenced
+    _options = new osgDB::Options();
+    _options->setObjectCacheHint( osgDB::Options::CACHE_NODES );
+
+    _prefetched = new osg::Group();
+
+    _root->addChild( createTile( _tiles, 0, 0, 0, _options.get() ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Terrain::~Terrain() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Terrain::update()
+{
+    /////////////////
+    Module::update();
+    /////////////////
+
+    if ( !_paged ) return;
+
+    // predicted ownship position
+    double lat = Data::get()->ownship.latitude;
+    double lon = Data::get()->ownship.longitude;
+    double alt = Data::get()->ownship.altitude_asl;
+
+    double r = WGS84::getRadiusEquatorial() + alt;
+
+    lat += CGI_TERRAIN_PREFETCH_TIME * Data::get()->ownship.vel_north / r;
+    lon += CGI_TERRAIN_PREFETCH_TIME * Data::get()->ownship.vel_east  / ( r * std::max( cos( lat ), 0.01 ) );
+
+    osg::Vec3d pos_wgs = WGS84::geo2wgs( lat, lon, alt );
+
+    for ( int level = 0; level < _tiles.levels - 1; level++ )
+    {
+        int i = getTileIndex( lat, _tiles.lat_min, _tiles.lat_max, level );
+        int j = getTileIndex( lon, _tiles.lon_min, _tiles.lon_max, level );
+
+        if ( i < 0 || j < 0 ) break;
+
+        osg::Vec3d center;
+        double radius = 0.0;
+
+        getTileBound( _tiles, level, i, j, &center, &radius );
+
+        // children of the tile will not be needed at predicted position
+        if ( ( pos_wgs - center ).length() > CGI_TERRAIN_LOD_FACTOR * radius ) break;
+
+        int ic = getTileIndex( lat, _tiles.lat_min, _tiles.lat_max, level + 1 );
+        int jc = getTileIndex( lon, _tiles.lon_min, _tiles.lon_max, level + 1 );
+
+        prefetch( getTileFile( _tiles, level + 1, ic, jc, _tiles.ext.c_str() ) );
+    }
+
+    while ( _prefetched->getNumChildren() > CGI_TERRAIN_PREFETCH_MAX )
+    {
+        _prefetched->removeChild( 0u );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Terrain::prefetch( const std::string &tileFile )
+{
+    if ( std::find( _prefetchedFiles.begin(), _prefetchedFiles.end(), tileFile )
+         != _prefetchedFiles.end() )
+    {
+        return;
+    }
+
+    _prefetchedFiles.push_back( tileFile );
+
+    while ( _prefetchedFiles.size() > CGI_TERRAIN_PREFETCH_MAX )
+    {
+        _prefetchedFiles.pop_front();
+    }
+
+    // tile read with the same options as the database pager uses lands in
+    // the object cache, prefetched group keeps it there until it is paged in
+    Loader::requestNode( tileFile, true, _prefetched.get(), _options.get() );
+}
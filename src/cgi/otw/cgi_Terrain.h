@@ -24,6 +24,13 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <deque>
+#include <string>
+
+#include <osg/PagedLOD>
+
+#include <osgDB/Options>
+
 #include <cgi/cgi_Module.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,11 +45,63 @@ class Terrain : public Module
 {
 public:
 
-    /** @brief Constructor. */
+    /**
+     * @brief Paged terrain tiles set description.
+     *
+     * Tiles make a quadtree covering given area, level 0 is a single tile,
+     * level L consists of 2^L x 2^L tiles. Tile files are expected to be
+     * "<dir>/<L>/<i>_<j>.<ext>" where i is latitude index (from south) and
+     * j is longitude index (from west).
+     */
+    struct Tiles
+    {
+        std::string dir;        ///< tiles directory
+        std::string ext;        ///< tiles files extension
+
+        double lat_min;         ///< [rad] area minimum latitude
+        double lat_max;         ///< [rad] area maximum latitude
+        double lon_min;         ///< [rad] area minimum longitude
+        double lon_max;         ///< [rad] area maximum longitude
+
+        int levels;             ///< number of quadtree levels
+    };
+
+    /** @brief Constructor, reads whole terrain from a single file. */
     Terrain( const char *file, const Module *parent = NULLPTR );
 
+    /** @brief Constructor, creates paged terrain from tiles set. */
+    Terrain( const Tiles &tiles, const Module *parent = NULLPTR );
+
     /** @brief Destructor. */
     virtual ~Terrain();
+
+    /** @brief Updates terrain, prefetches tiles along predicted flight path. */
+    void update();
+
+    /**
+     * @brief Creates tile paged LOD node.
+     * @param tiles tiles set
+     * @param level tile quadtree level
+     * @param i tile latitude index
+     * @param j tile longitude index
+     * @param options tiles reading options
+     * @return tile paged LOD node
+     */
+    static osg::PagedLOD* createTile( const Tiles &tiles, int level, int i, int j,
+                                      osgDB::Options *options );
+
+private:
+
+    Tiles _tiles;                                   ///< tiles set
+    bool _paged;                                    ///< specifies if terrain is paged
+
+    osg::ref_ptr<osgDB::Options> _options;          ///< tiles reading options
+
+    osg::ref_ptr<osg::Group> _prefetched;           ///< prefetched tiles (not part of the scene)
+    std::deque< std::string > _prefetchedFiles;     ///< recently requested tiles files
+
+    /** Requests tile if it has not been requested recently. */
+    void prefetch( const std::string &tileFile );
 };
 
 } // end of cgi namespace
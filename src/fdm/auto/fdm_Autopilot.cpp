@@ -22,6 +22,8 @@
 
 #include <fdm/auto/fdm_Autopilot.h>
 
+#include <cfloat>
+
 #include <fdm/utils/fdm_Misc.h>
 #include <fdm/utils/fdm_Units.h>
 
@@ -64,7 +66,10 @@ Autopilot::Autopilot( FlightDirector *fd ) :
     _yaw_damper ( false ),
 
     _testing ( false ),
-    _engaged ( false )
+    _engaged ( false ),
+
+    _active_rp ( true ),
+    _active_y  ( true )
 {
     _pid_r.setAntiWindup( PID::Calculation );
     _pid_p.setAntiWindup( PID::Calculation );
@@ -146,12 +151,31 @@ void Autopilot::update( double timeStep,
                  loc_deviation, loc_active,
                  gs_deviation, gs_active );
 
-    if ( _engaged && _fd->isEngaged() )
+    // inactive channels outputs are zero, so their control laws,
+    // gain scheduling and rate limiting are skipped
+    bool active_rp = _engaged && _fd->isEngaged();
+
+    if ( active_rp )
     {
         _pid_r.update( timeStep, _fd->getCmdRoll()  - roll  );
         _pid_p.update( timeStep, _fd->getCmdPitch() - pitch );
+
+        double ctrl_roll  = _gain_ias_r.getValue( airspeed ) * _pid_r.getValue();
+        double ctrl_pitch = _gain_ias_p.getValue( airspeed ) * _pid_p.getValue();
+
+//        if ( _softRide )
+//        {
+//            ctrl_roll  *= _softRideCoef;
+//            ctrl_pitch *= _softRideCoef;
+//        }
+
+        _ctrl_roll  = Misc::rate( timeStep, _max_rate_roll  , _ctrl_roll  , ctrl_roll  );
+        _ctrl_pitch = Misc::rate( timeStep, _max_rate_pitch , _ctrl_pitch , ctrl_pitch );
+
+        _ctrl_roll  = Misc::satur( -1.0, 1.0, _ctrl_roll  );
+        _ctrl_pitch = Misc::satur( -1.0, 1.0, _ctrl_pitch );
     }
-    else
+    else if ( _active_rp )
     {
         _pid_r.reset();
         _pid_p.reset();
@@ -163,31 +187,25 @@ void Autopilot::update( double timeStep,
     if ( _yaw_damper )
     {
         _pid_y.update( timeStep, -yaw_rate );
+
+        double ctrl_yaw = _gain_ias_y.getValue( airspeed ) * _pid_y.getValue();
+
+//        if ( _softRide )
+//        {
+//            ctrl_yaw *= _softRideCoef;
+//        }
+
+        _ctrl_yaw = Misc::rate( timeStep, _max_rate_yaw, _ctrl_yaw, ctrl_yaw );
+        _ctrl_yaw = Misc::satur( -1.0, 1.0, _ctrl_yaw );
     }
-    else
+    else if ( _active_y )
     {
         _pid_y.reset();
         _ctrl_yaw = 0.0;
     }
 
-    double ctrl_roll  = _gain_ias_r.getValue( airspeed ) * _pid_r.getValue();
-    double ctrl_pitch = _gain_ias_p.getValue( airspeed ) * _pid_p.getValue();
-    double ctrl_yaw   = _gain_ias_y.getValue( airspeed ) * _pid_y.getValue();
-
-//    if ( _softRide )
-//    {
-//        ctrl_roll  *= _softRideCoef;
-//        ctrl_pitch *= _softRideCoef;
-//        ctrl_yaw   *= _softRideCoef;
-//    }
-
-    _ctrl_roll  = Misc::rate( timeStep, _max_rate_roll  , _ctrl_roll  , ctrl_roll  );
-    _ctrl_pitch = Misc::rate( timeStep, _max_rate_pitch , _ctrl_pitch , ctrl_pitch );
-    _ctrl_yaw   = Misc::rate( timeStep, _max_rate_yaw   , _ctrl_yaw   , ctrl_yaw   );
-
-    _ctrl_roll  = Misc::satur( -1.0, 1.0, _ctrl_roll  );
-    _ctrl_pitch = Misc::satur( -1.0, 1.0, _ctrl_pitch );
-    _ctrl_yaw   = Misc::satur( -1.0, 1.0, _ctrl_yaw   );
+    _active_rp = active_rp;
+    _active_y  = _yaw_damper;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
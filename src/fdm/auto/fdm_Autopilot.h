@@ -27,6 +27,7 @@
 #include <fdm/fdm_Defines.h>
 
 #include <fdm/ctrl/fdm_PID.h>
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -45,7 +46,7 @@ namespace fdm
  * @see Bociek S., Gruszecki J.: Uklady sterowania automatycznego samolotem, 1999 [in Polish]
  * @see Polak Z., Rypulak A.: Awionika przyrzady i systemy pokladowe, 2002 [in Polish]
  */
-class FDMEXPORT Autopilot
+class FDMEXPORT Autopilot : public ArenaObject
 {
 public:
 
@@ -162,6 +163,9 @@ protected:
     bool _testing;          ///< specifies if test is active
     bool _engaged;          ///< specifies if autopilot is engaged
 
+    bool _active_rp;        ///< specifies if roll and pitch channels were active during the last update
+    bool _active_y;         ///< specifies if yaw channel was active during the last update
+
     virtual void readChannel( const XmlNode &dataNode, double *max_rate,
                               PID *pid, Table1 *gain_ias );
 };
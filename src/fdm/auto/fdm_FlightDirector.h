@@ -30,6 +30,8 @@
 
 #include <fdm/xml/fdm_XmlNode.h>
 
+#include <fdm/utils/fdm_Arena.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -40,7 +42,7 @@ class Autopilot;
 /**
  * @brief Flight director class.
  */
-class FDMEXPORT FlightDirector
+class FDMEXPORT FlightDirector : public ArenaObject
 {
 public:
 
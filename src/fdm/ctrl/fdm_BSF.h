@@ -26,6 +26,8 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -36,7 +38,7 @@ namespace fdm
  *
  * @todo TODO
  */
-class FDMEXPORT BSF
+class FDMEXPORT BSF : public ArenaObject
 {
 public:
 
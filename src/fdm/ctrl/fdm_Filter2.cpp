@@ -137,3 +137,23 @@ void Filter2::update( double dt, double u )
         _y_prev_1 = _y;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Filter2::archiveState( StateArchive *archive )
+{
+    archive->add( &_c1 );
+    archive->add( &_c2 );
+    archive->add( &_c3 );
+    archive->add( &_c4 );
+    archive->add( &_c5 );
+    archive->add( &_c6 );
+
+    archive->add( &_u_prev_1 );
+    archive->add( &_u_prev_2 );
+
+    archive->add( &_y_prev_1 );
+    archive->add( &_y_prev_2 );
+
+    archive->add( &_y );
+}
@@ -26,6 +26,9 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -37,7 +40,7 @@ namespace fdm
  * Transfer function:
  * G(s)  =  ( c1*s^2 + c2*s + c3 ) / ( c4*s^2 + c5*s + c6 )
  */
-class FDMEXPORT Filter2
+class FDMEXPORT Filter2 : public ArenaObject
 {
 public:
 
@@ -73,6 +76,12 @@ public:
      */
     void update( double dt, double u );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 protected:
 
     double _c1;             ///< c1 coefficient
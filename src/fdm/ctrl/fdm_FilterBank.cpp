@@ -0,0 +1,331 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/ctrl/fdm_FilterBank.h>
+
+#include <cmath>
+
+#include <fdm/ctrl/fdm_Filter2.h>
+#include <fdm/ctrl/fdm_HPF.h>
+#include <fdm/ctrl/fdm_Lag.h>
+#include <fdm/ctrl/fdm_Lag2.h>
+#include <fdm/ctrl/fdm_Lead.h>
+#include <fdm/ctrl/fdm_LeadLag.h>
+
+#include <fdm/utils/fdm_Simd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+FilterBank::FilterBank() :
+    _size ( 0 ),
+    _dt ( 0.0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+FilterBank::~FilterBank() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addLag( double tc, double y )
+{
+    double c[] = { tc, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    return addSection( TypeLag, c, y );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addLag2( double tc1, double tc2, double y )
+{
+    double c[] = { tc1, tc2, 0.0, 0.0, 0.0, 0.0 };
+    return addSection( TypeLag2, c, y );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addLead( double tc, double y )
+{
+    double c[] = { tc, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    return addSection( TypeLead, c, y );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addHPF( double omega, double y )
+{
+    double c[] = { 1.0 / omega, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    return addSection( TypeHPF, c, y );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addLeadLag( double c1, double c2, double c3, double c4,
+                                     double y )
+{
+    double c[] = { c1, c2, c3, c4, 0.0, 0.0 };
+    return addSection( TypeLeadLag, c, y );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addFilter2( double c1, double c2, double c3,
+                                     double c4, double c5, double c6,
+                                     double y )
+{
+    double c[] = { c1, c2, c3, c4, c5, c6 };
+    return addSection( TypeFilter2, c, y );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::add( const Lag &lag )
+{
+    return addLag( lag.getTimeConst(), lag.getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::add( const Lag2 &lag2 )
+{
+    return addLag2( lag2.getTimeConst1(), lag2.getTimeConst2(), lag2.getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::add( const Lead &lead )
+{
+    return addLead( lead.getTimeConst(), lead.getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::add( const HPF &hpf )
+{
+    return addHPF( hpf.getOmega(), hpf.getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::add( const LeadLag &leadLag )
+{
+    return addLeadLag( leadLag.getC1(), leadLag.getC2(),
+                       leadLag.getC3(), leadLag.getC4(),
+                       leadLag.getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::add( const Filter2 &filter )
+{
+    return addFilter2( filter.getC1(), filter.getC2(), filter.getC3(),
+                       filter.getC4(), filter.getC5(), filter.getC6(),
+                       filter.getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::clear()
+{
+    _size = 0;
+
+    _type.clear();
+    _c.clear();
+
+    _b0.clear();
+    _b1.clear();
+    _b2.clear();
+    _a1.clear();
+    _a2.clear();
+
+    _u1.clear();
+    _u2.clear();
+    _y1.clear();
+    _y2.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::setTimeStep( double dt )
+{
+    if ( dt > 0.0 && dt != _dt )
+    {
+        _dt = dt;
+
+        for ( unsigned int i = 0; i < _size; i++ )
+        {
+            discretize( i );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::update( const double *u )
+{
+    if ( _size > 0 )
+    {
+        Simd::updateSOS( _size,
+                         &_b0[ 0 ], &_b1[ 0 ], &_b2[ 0 ], &_a1[ 0 ], &_a2[ 0 ],
+                         u,
+                         &_u1[ 0 ], &_u2[ 0 ], &_y1[ 0 ], &_y2[ 0 ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::setValue( unsigned int index, double y )
+{
+    if ( index < _size )
+    {
+        _y1[ index ] = y;
+        _y2[ index ] = y;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int FilterBank::addSection( Type type, const double *c, double y )
+{
+    _type.push_back( type );
+
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        _c.push_back( c[ i ] );
+    }
+
+    // holding current value until time step is set
+    _b0.push_back(  0.0 );
+    _b1.push_back(  0.0 );
+    _b2.push_back(  0.0 );
+    _a1.push_back( -1.0 );
+    _a2.push_back(  0.0 );
+
+    _u1.push_back( 0.0 );
+    _u2.push_back( 0.0 );
+    _y1.push_back( y );
+    _y2.push_back( y );
+
+    unsigned int index = _size++;
+
+    if ( _dt > 0.0 ) discretize( index );
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::discretize( unsigned int index )
+{
+    const double *c = &_c[ 6 * index ];
+
+    const double dt  = _dt;
+    const double dt2 = dt * dt;
+
+    double b0 =  0.0;
+    double b1 =  0.0;
+    double b2 =  0.0;
+    double a1 = -1.0;
+    double a2 =  0.0;
+
+    switch ( _type[ index ] )
+    {
+    case TypeLag:
+        b0 = 1.0 - exp( -dt / c[ 0 ] );
+        a1 = b0 - 1.0;
+        break;
+
+    case TypeLag2:
+        {
+            // two lags in series
+            double p1 = exp( -dt / c[ 0 ] );
+            double p2 = exp( -dt / c[ 1 ] );
+
+            b0 = ( 1.0 - p1 ) * ( 1.0 - p2 );
+            a1 = -( p1 + p2 );
+            a2 = p1 * p2;
+        }
+        break;
+
+    case TypeLead:
+        b0 = 1.0 + c[ 0 ] / dt;
+        b1 = -c[ 0 ] / dt;
+        a1 = 0.0;
+        break;
+
+    case TypeHPF:
+        {
+            double k = 1.0 - exp( -dt / c[ 0 ] );
+
+            b0 =  k * c[ 0 ] / dt;
+            b1 = -b0;
+            a1 =  k - 1.0;
+        }
+        break;
+
+    case TypeLeadLag:
+        {
+            double den = 2.0 * c[ 2 ] + dt * c[ 3 ];
+
+            b0 =  ( 2.0 * c[ 0 ] + dt  * c[ 1 ] ) / den;
+            b1 =  ( dt  * c[ 1 ] - 2.0 * c[ 0 ] ) / den;
+            a1 = -( 2.0 * c[ 2 ] - dt  * c[ 3 ] ) / den;
+        }
+        break;
+
+    case TypeFilter2:
+        {
+            double den = 4.0 * c[ 3 ] + 2.0 * c[ 4 ] * dt + c[ 5 ] * dt2;
+
+            b0 = ( 4.0 * c[ 0 ]       + 2.0 * c[ 1 ] * dt + c[ 2 ] * dt2 ) / den;
+            b1 = ( 2.0 * c[ 2 ] * dt2 - 8.0 * c[ 0 ]                     ) / den;
+            b2 = ( 4.0 * c[ 0 ]       - 2.0 * c[ 1 ] * dt + c[ 2 ] * dt2 ) / den;
+            a1 = ( 2.0 * c[ 5 ] * dt2 - 8.0 * c[ 3 ]                     ) / den;
+            a2 = ( 4.0 * c[ 3 ]       - 2.0 * c[ 4 ] * dt + c[ 5 ] * dt2 ) / den;
+        }
+        break;
+    }
+
+    _b0[ index ] = b0;
+    _b1[ index ] = b1;
+    _b2[ index ] = b2;
+    _a1[ index ] = a1;
+    _a2[ index ] = a2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBank::archiveState( StateArchive *archive )
+{
+    // coefficients are discretized again if time step differs
+    double dt = _dt;
+    archive->add( &dt );
+    if ( archive->isRestoring() ) setTimeStep( dt );
+
+    archive->add( &_u1, _size );
+    archive->add( &_u2, _size );
+    archive->add( &_y1, _size );
+    archive->add( &_y2, _size );
+}
@@ -0,0 +1,286 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_FILTERBANK_H
+#define FDM_FILTERBANK_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+#include <fdm/utils/fdm_StateArchive.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+class Filter2;
+class HPF;
+class Lag;
+class Lag2;
+class Lead;
+class LeadLag;
+
+/**
+ * @brief Bank of discrete filters sections.
+ *
+ * Every filter is stored as discrete second-order section:
+ * y[n] = b0*u[n] + b1*u[n-1] + b2*u[n-2] - a1*y[n-1] - a2*y[n-2]
+ *
+ * Coefficients and states of all sections are stored in contiguous arrays
+ * (structure of arrays), so heterogeneous sections can be advanced together
+ * in one SIMD loop. Discrete coefficients are cached and computed only when
+ * time step changes, so for fixed rate control laws they are computed only
+ * once. Sections are discretized the same way as the reference classes,
+ * i.e. Lag, Lag2, LPF and HPF use exact discretization, Lead uses backward
+ * difference, LeadLag and Filter2 use Tustin (bilinear) transform.
+ *
+ * LPF sections are added as Lag sections.
+ *
+ * @see Filter2
+ * @see HPF
+ * @see Lag
+ * @see Lag2
+ * @see Lead
+ * @see LeadLag
+ * @see LPF
+ */
+class FDMEXPORT FilterBank
+{
+public:
+
+    /** @brief Constructor. */
+    FilterBank();
+
+    /** @brief Destructor. */
+    virtual ~FilterBank();
+
+    /**
+     * @brief Adds first-order lag section.
+     * @param tc [s] time constant
+     * @param y initial value
+     * @return section index
+     * @see Lag
+     */
+    unsigned int addLag( double tc, double y = 0.0 );
+
+    /**
+     * @brief Adds second-order lag section.
+     * G(s) = 1 / ( tc1*s + 1 )( tc2*s + 1 )
+     * @param tc1 [s] time constant
+     * @param tc2 [s] time constant
+     * @param y initial value
+     * @return section index
+     * @see Lag2
+     */
+    unsigned int addLag2( double tc1, double tc2, double y = 0.0 );
+
+    /**
+     * @brief Adds first-order lead section.
+     * G(s) = tc*s + 1
+     * @param tc [s] time constant
+     * @param y initial value
+     * @return section index
+     * @see Lead
+     */
+    unsigned int addLead( double tc, double y = 0.0 );
+
+    /**
+     * @brief Adds first-order high-pass filter section.
+     * G(s) = s / ( s + omega )
+     * @param omega [rad/s] cutoff angular frequency
+     * @param y initial value
+     * @return section index
+     * @see HPF
+     */
+    unsigned int addHPF( double omega, double y = 0.0 );
+
+    /**
+     * @brief Adds lead-lag section.
+     * G(s) = ( c1*s + c2 ) / ( c3*s + c4 )
+     * @return section index
+     * @see LeadLag
+     */
+    unsigned int addLeadLag( double c1, double c2, double c3, double c4,
+                             double y = 0.0 );
+
+    /**
+     * @brief Adds second-order filter section.
+     * G(s) = ( c1*s^2 + c2*s + c3 ) / ( c4*s^2 + c5*s + c6 )
+     * @return section index
+     * @see Filter2
+     */
+    unsigned int addFilter2( double c1, double c2, double c3,
+                             double c4, double c5, double c6,
+                             double y = 0.0 );
+
+    /**
+     * @brief Adds section with the same parameters and value as given lag.
+     * @param lag reference lag object
+     * @return section index
+     */
+    unsigned int add( const Lag &lag );
+
+    /**
+     * @brief Adds section with the same parameters and value as given lag.
+     * @param lag2 reference second-order lag object
+     * @return section index
+     */
+    unsigned int add( const Lag2 &lag2 );
+
+    /**
+     * @brief Adds section with the same parameters and value as given lead.
+     * @param lead reference lead object
+     * @return section index
+     */
+    unsigned int add( const Lead &lead );
+
+    /**
+     * @brief Adds section with the same parameters and value as given filter.
+     * @param hpf reference high-pass filter object
+     * @return section index
+     */
+    unsigned int add( const HPF &hpf );
+
+    /**
+     * @brief Adds section with the same parameters and value as given lead-lag.
+     * @param leadLag reference lead-lag object
+     * @return section index
+     */
+    unsigned int add( const LeadLag &leadLag );
+
+    /**
+     * @brief Adds section with the same parameters and value as given filter.
+     * @param filter reference second-order filter object
+     * @return section index
+     */
+    unsigned int add( const Filter2 &filter );
+
+    /** @brief Removes all sections. */
+    void clear();
+
+    /**
+     * @brief Sets time step and discretizes sections if time step changed.
+     * @param dt [s] time step
+     */
+    void setTimeStep( double dt );
+
+    /**
+     * @brief Updates single section.
+     * Sections depending on other sections outputs have to be updated in
+     * order.
+     * @param index section index
+     * @param u input value
+     * @return section output value
+     */
+    inline double update( unsigned int index, double u )
+    {
+        double y = _b0[ index ] * u
+                 + _b1[ index ] * _u1[ index ]
+                 + _b2[ index ] * _u2[ index ]
+                 - _a1[ index ] * _y1[ index ]
+                 - _a2[ index ] * _y2[ index ];
+
+        _u2[ index ] = _u1[ index ];
+        _u1[ index ] = u;
+
+        _y2[ index ] = _y1[ index ];
+        _y1[ index ] = y;
+
+        return y;
+    }
+
+    /**
+     * @brief Updates all sections at once.
+     * @param u input values array of getSize() elements
+     */
+    void update( const double *u );
+
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
+    /**
+     * @brief Returns section output value.
+     * @param index section index
+     * @return section output value
+     */
+    inline double getValue( unsigned int index ) const { return _y1[ index ]; }
+
+    /** @brief Returns number of sections. */
+    inline unsigned int getSize() const { return _size; }
+
+    /** @brief Returns time step sections are discretized for. */
+    inline double getTimeStep() const { return _dt; }
+
+    /**
+     * @brief Sets section output value.
+     * @param index section index
+     * @param y output value
+     */
+    void setValue( unsigned int index, double y );
+
+private:
+
+    /** Section types. */
+    enum Type
+    {
+        TypeLag = 0,                ///< first-order lag
+        TypeLag2,                   ///< second-order lag
+        TypeLead,                   ///< first-order lead
+        TypeHPF,                    ///< first-order high-pass filter
+        TypeLeadLag,                ///< lead-lag
+        TypeFilter2                 ///< second-order filter
+    };
+
+    unsigned int _size;             ///< number of sections
+
+    double _dt;                     ///< [s] time step
+
+    std::vector< Type > _type;      ///< sections types
+    std::vector< double > _c;       ///< continuous coefficients (6 per section)
+
+    std::vector< double > _b0;      ///< discrete coefficients
+    std::vector< double > _b1;      ///< discrete coefficients
+    std::vector< double > _b2;      ///< discrete coefficients
+    std::vector< double > _a1;      ///< discrete coefficients
+    std::vector< double > _a2;      ///< discrete coefficients
+
+    std::vector< double > _u1;      ///< previous input value
+    std::vector< double > _u2;      ///< input value before previous
+    std::vector< double > _y1;      ///< current output value
+    std::vector< double > _y2;      ///< previous output value
+
+    unsigned int addSection( Type type, const double *c, double y );
+
+    void discretize( unsigned int index );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_FILTERBANK_H
@@ -81,3 +81,15 @@ void HPF::update( double dt, double u )
         _u_prev = u;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HPF::archiveState( StateArchive *archive )
+{
+    archive->add( &_omega );
+    archive->add( &_tc );
+
+    archive->add( &_u_prev );
+
+    archive->add( &_y );
+}
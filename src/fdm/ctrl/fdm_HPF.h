@@ -26,6 +26,9 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -37,7 +40,7 @@ namespace fdm
  * Transfer function:
  * G(s)  =  s / ( s + omega )  =  ( s / omega ) / ( s/omega + 1 )
  */
-class FDMEXPORT HPF
+class FDMEXPORT HPF : public ArenaObject
 {
 public:
 
@@ -79,6 +82,12 @@ public:
      */
     void update( double dt, double u );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 protected:
 
     double _omega;          ///< [rad/s] cutoff angular frequency
@@ -75,3 +75,11 @@ void Lag::update( double dt, double u )
         _y = update( u, _y, dt, _tc );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Lag::archiveState( StateArchive *archive )
+{
+    archive->add( &_tc );
+    archive->add( &_y );
+}
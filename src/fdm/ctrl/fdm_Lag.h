@@ -26,6 +26,9 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -44,7 +47,7 @@ namespace fdm
  * @see https://www.mathworks.com/help/physmod/sps/powersys/ref/firstorderfilter.html
  * @see https://pages.mtu.edu/~tbco/cm416/TFBODE.html
  */
-class FDMEXPORT Lag
+class FDMEXPORT Lag : public ArenaObject
 {
 public:
 
@@ -90,6 +93,12 @@ public:
      */
     void update( double dt, double u );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 protected:
 
     double _tc;             ///< time constant
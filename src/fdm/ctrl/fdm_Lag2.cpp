@@ -83,3 +83,13 @@ void Lag2::update( double dt, double u )
         _y = Lag::update( _lag1->getValue(), _y, dt, _tc2 );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Lag2::archiveState( StateArchive *archive )
+{
+    _lag1->archiveState( archive );
+
+    archive->add( &_tc2 );
+    archive->add( &_y );
+}
@@ -26,6 +26,9 @@
 
 #include <fdm/ctrl/fdm_Lag.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -37,7 +40,7 @@ namespace fdm
  * Transfer function:
  * G(s)  =  1 / ( Tc1*s + 1 )( Tc2*s + 1 )
  */
-class FDMEXPORT Lag2
+class FDMEXPORT Lag2 : public ArenaObject
 {
 public:
 
@@ -57,6 +60,9 @@ public:
 
     inline double getValue() const { return _y; }
 
+    inline double getTimeConst1() const { return _lag1->getTimeConst(); }
+    inline double getTimeConst2() const { return _tc2; }
+
     /**
      * @brief Sets output value
      * @param youtput value
@@ -82,6 +88,12 @@ public:
      */
     void update( double dt, double u );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 protected:
 
     Lag *_lag1;             ///< first-order lag element
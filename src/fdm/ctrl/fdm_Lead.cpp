@@ -40,6 +40,7 @@ Lead::Lead() :
 
 Lead::Lead( double tc, double y ) :
     _tc ( tc ),
+    _u ( 0.0 ),
     _y ( y )
 {}
 
@@ -71,3 +72,12 @@ void Lead::update( double dt, double u )
         _u = u;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Lead::archiveState( StateArchive *archive )
+{
+    archive->add( &_tc );
+    archive->add( &_u );
+    archive->add( &_y );
+}
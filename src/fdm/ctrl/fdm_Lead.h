@@ -26,6 +26,9 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -41,7 +44,7 @@ namespace fdm
  * @see Kaczorek T.: Teoria ukladow regulacji automatycznej, 1970, p.224. [in Polish]
  * @see https://pages.mtu.edu/~tbco/cm416/TFBODE.html
  */
-class FDMEXPORT Lead
+class FDMEXPORT Lead : public ArenaObject
 {
 public:
 
@@ -73,6 +76,12 @@ public:
      */
     void update( double dt, double u );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 protected:
 
     double _tc;             ///< time constant
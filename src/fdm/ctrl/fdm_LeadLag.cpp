@@ -106,3 +106,18 @@ void LeadLag::update( double dt, double u )
         _y_prev = _y;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LeadLag::archiveState( StateArchive *archive )
+{
+    archive->add( &_c1 );
+    archive->add( &_c2 );
+    archive->add( &_c3 );
+    archive->add( &_c4 );
+
+    archive->add( &_u_prev );
+    archive->add( &_y_prev );
+
+    archive->add( &_y );
+}
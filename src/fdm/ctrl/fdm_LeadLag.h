@@ -26,6 +26,9 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -40,7 +43,7 @@ namespace fdm
  * @see Boulet B.: Fundamentals of Signals and Systems, 2006, p.300
  * @see Kaczorek T.: Teoria ukladow regulacji automatycznej, 1970, p.228. [in Polish]
  */
-class FDMEXPORT LeadLag
+class FDMEXPORT LeadLag : public ArenaObject
 {
 public:
 
@@ -78,6 +81,12 @@ public:
      */
     void update( double dt, double u );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 protected:
 
     double _c1;             ///< c1 coefficient of the transfer function
@@ -200,3 +200,28 @@ void PID::setValue( double timeStep, double error, double value )
     _value = value;
     _delta = 0.0;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PID::archiveState( StateArchive *archive )
+{
+    archive->addEnum( &_antiWindup );
+
+    archive->add( &_kp );
+    archive->add( &_ki );
+    archive->add( &_kd );
+
+    archive->add( &_kaw );
+
+    archive->add( &_min );
+    archive->add( &_max );
+
+    archive->add( &_error );
+    archive->add( &_error_i );
+    archive->add( &_error_d );
+
+    archive->add( &_value );
+    archive->add( &_delta );
+
+    archive->add( &_saturation );
+}
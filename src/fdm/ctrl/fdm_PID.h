@@ -26,6 +26,9 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -54,7 +57,7 @@ namespace fdm
  * @see https://en.wikipedia.org/wiki/Ziegler%E2%80%93Nichols_method
  * @see https://www.scilab.org/pid-anti-windup-schemes
  */
-class FDMEXPORT PID
+class FDMEXPORT PID : public ArenaObject
 {
 public:
 
@@ -97,6 +100,12 @@ public:
      */
     virtual void update( double dt, double u );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
     /** @brief Resets controller. */
     virtual void reset();
 
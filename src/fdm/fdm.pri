@@ -1,6 +1,16 @@
 !fdm_test: {
-HEADERS += $$PWD/fdm_Manager.h
-SOURCES += $$PWD/fdm_Manager.cpp
+HEADERS += \
+    $$PWD/fdm_Builder.h \
+    $$PWD/fdm_CApi.h \
+    $$PWD/fdm_CData.h \
+    $$PWD/fdm_Fleet.h \
+    $$PWD/fdm_Manager.h
+
+SOURCES += \
+    $$PWD/fdm_Builder.cpp \
+    $$PWD/fdm_CApi.cpp \
+    $$PWD/fdm_Fleet.cpp \
+    $$PWD/fdm_Manager.cpp
 }
 
 HEADERS += \
@@ -35,6 +45,7 @@ HEADERS += \
     $$PWD/ctrl/fdm_BPF.h \
     $$PWD/ctrl/fdm_BSF.h \
     $$PWD/ctrl/fdm_Filter2.h \
+    $$PWD/ctrl/fdm_FilterBank.h \
     $$PWD/ctrl/fdm_HPF.h \
     $$PWD/ctrl/fdm_Lag.h \
     $$PWD/ctrl/fdm_Lag2.h \
@@ -47,6 +58,7 @@ SOURCES += \
     $$PWD/ctrl/fdm_BPF.cpp \
     $$PWD/ctrl/fdm_BSF.cpp \
     $$PWD/ctrl/fdm_Filter2.cpp \
+    $$PWD/ctrl/fdm_FilterBank.cpp \
     $$PWD/ctrl/fdm_HPF.cpp \
     $$PWD/ctrl/fdm_Lag.cpp \
     $$PWD/ctrl/fdm_Lag2.cpp \
@@ -60,8 +72,11 @@ SOURCES += \
 HEADERS += \
     $$PWD/main/fdm_Aerodynamics.h \
     $$PWD/main/fdm_Aircraft.h \
+    $$PWD/main/fdm_CollisionGeometry.h \
     $$PWD/main/fdm_Controls.h \
+    $$PWD/main/fdm_DataLogger.h \
     $$PWD/main/fdm_Environment.h \
+    $$PWD/main/fdm_EventScript.h \
     $$PWD/main/fdm_FDM.h \
     $$PWD/main/fdm_Input.h \
     $$PWD/main/fdm_Intersections.h \
@@ -69,20 +84,29 @@ HEADERS += \
     $$PWD/main/fdm_Mass.h \
     $$PWD/main/fdm_Module.h \
     $$PWD/main/fdm_Propulsion.h \
-    $$PWD/main/fdm_Recorder.h
+    $$PWD/main/fdm_Recorder.h \
+    $$PWD/main/fdm_RecorderCodec.h \
+    $$PWD/main/fdm_RecorderWriter.h \
+    $$PWD/main/fdm_TerrainCache.h
 
 SOURCES += \
     $$PWD/main/fdm_Aerodynamics.cpp \
     $$PWD/main/fdm_Aircraft.cpp \
+    $$PWD/main/fdm_CollisionGeometry.cpp \
     $$PWD/main/fdm_Controls.cpp \
+    $$PWD/main/fdm_DataLogger.cpp \
     $$PWD/main/fdm_Environment.cpp \
+    $$PWD/main/fdm_EventScript.cpp \
     $$PWD/main/fdm_FDM.cpp \
     $$PWD/main/fdm_Input.cpp \
     $$PWD/main/fdm_Intersections.cpp \
     $$PWD/main/fdm_LandingGear.cpp \
     $$PWD/main/fdm_Mass.cpp \
     $$PWD/main/fdm_Propulsion.cpp \
-    $$PWD/main/fdm_Recorder.cpp
+    $$PWD/main/fdm_Recorder.cpp \
+    $$PWD/main/fdm_RecorderCodec.cpp \
+    $$PWD/main/fdm_RecorderWriter.cpp \
+    $$PWD/main/fdm_TerrainCache.cpp
 
 ################################################################################
 
@@ -93,9 +117,11 @@ HEADERS += \
     $$PWD/models/fdm_HingeMoment.h \
     $$PWD/models/fdm_MainRotor.h \
     $$PWD/models/fdm_MainRotorBE.h \
+    $$PWD/models/fdm_MainRotorSurrogate.h \
     $$PWD/models/fdm_PistonEngine.h \
     $$PWD/models/fdm_Propeller.h \
     $$PWD/models/fdm_RotorBlade.h \
+    $$PWD/models/fdm_RotorWake.h \
     $$PWD/models/fdm_Schrenk.h \
     $$PWD/models/fdm_SimpleRotor.h \
     $$PWD/models/fdm_StabilizerHor.h \
@@ -103,8 +129,10 @@ HEADERS += \
     $$PWD/models/fdm_TailOff.h \
     $$PWD/models/fdm_TailRotor.h \
     $$PWD/models/fdm_Turbofan.h \
+    $$PWD/models/fdm_Turbulence.h \
     $$PWD/models/fdm_Wheel.h \
     $$PWD/models/fdm_WinchLauncher.h \
+    $$PWD/models/fdm_WindField.h \
     $$PWD/models/fdm_WindShear.h \
     $$PWD/models/fdm_WingRunner.h
 
@@ -115,9 +143,11 @@ SOURCES += \
     $$PWD/models/fdm_HingeMoment.cpp \
     $$PWD/models/fdm_MainRotor.cpp \
     $$PWD/models/fdm_MainRotorBE.cpp \
+    $$PWD/models/fdm_MainRotorSurrogate.cpp \
     $$PWD/models/fdm_PistonEngine.cpp \
     $$PWD/models/fdm_Propeller.cpp \
     $$PWD/models/fdm_RotorBlade.cpp \
+    $$PWD/models/fdm_RotorWake.cpp \
     $$PWD/models/fdm_Schrenk.cpp \
     $$PWD/models/fdm_SimpleRotor.cpp \
     $$PWD/models/fdm_StabilizerHor.cpp \
@@ -125,63 +155,102 @@ SOURCES += \
     $$PWD/models/fdm_TailOff.cpp \
     $$PWD/models/fdm_TailRotor.cpp \
     $$PWD/models/fdm_Turbofan.cpp \
+    $$PWD/models/fdm_Turbulence.cpp \
     $$PWD/models/fdm_Wheel.cpp \
     $$PWD/models/fdm_WinchLauncher.cpp \
+    $$PWD/models/fdm_WindField.cpp \
     $$PWD/models/fdm_WindShear.cpp \
     $$PWD/models/fdm_WingRunner.cpp
 
 ################################################################################
 
 HEADERS += \
+    $$PWD/utils/fdm_AllocTracker.h \
     $$PWD/utils/fdm_Angles.h \
+    $$PWD/utils/fdm_Arena.h \
+    $$PWD/utils/fdm_Compressor.h \
     $$PWD/utils/fdm_DataNode.h \
+    $$PWD/utils/fdm_DataPool.h \
     $$PWD/utils/fdm_DataRef.h \
+    $$PWD/utils/fdm_DelayLine.h \
+    $$PWD/utils/fdm_DormandPrince45.h \
     $$PWD/utils/fdm_EulerRect.h \
+    $$PWD/utils/fdm_EulerSemiImplicit.h \
+    $$PWD/utils/fdm_FPEnv.h \
     $$PWD/utils/fdm_GaussJordan.h \
     $$PWD/utils/fdm_Geom.h \
+    $$PWD/utils/fdm_Histogram.h \
     $$PWD/utils/fdm_Integrator.h \
     $$PWD/utils/fdm_Map.h \
+    $$PWD/utils/fdm_MappedFile.h \
     $$PWD/utils/fdm_Matrix.h \
     $$PWD/utils/fdm_Matrix3x3.h \
     $$PWD/utils/fdm_Matrix4x4.h \
     $$PWD/utils/fdm_Matrix6x6.h \
+    $$PWD/utils/fdm_MemoryStats.h \
+    $$PWD/utils/fdm_Metrics.h \
     $$PWD/utils/fdm_Misc.h \
     $$PWD/utils/fdm_Oscillation.h \
+    $$PWD/utils/fdm_Profiler.h \
     $$PWD/utils/fdm_Quaternion.h \
     $$PWD/utils/fdm_Random.h \
+    $$PWD/utils/fdm_RingBuffer.h \
     $$PWD/utils/fdm_RungeKutta4.h \
+    $$PWD/utils/fdm_RungeKuttaMuntheKaas4.h \
+    $$PWD/utils/fdm_Simd.h \
     $$PWD/utils/fdm_Singleton.h \
+    $$PWD/utils/fdm_StateArchive.h \
     $$PWD/utils/fdm_String.h \
     $$PWD/utils/fdm_Table1.h \
     $$PWD/utils/fdm_Table2.h \
+    $$PWD/utils/fdm_Table2Pack.h \
+    $$PWD/utils/fdm_ThreadPlacement.h \
     $$PWD/utils/fdm_Time.h \
+    $$PWD/utils/fdm_TriangleBVH.h \
     $$PWD/utils/fdm_Units.h \
     $$PWD/utils/fdm_Vector.h \
     $$PWD/utils/fdm_Vector3.h \
     $$PWD/utils/fdm_Vector4.h \
     $$PWD/utils/fdm_Vector6.h \
+    $$PWD/utils/fdm_VectorExpr.h \
     $$PWD/utils/fdm_VectorN.h \
-    $$PWD/utils/fdm_WGS84.h
+    $$PWD/utils/fdm_WGS84.h \
+    $$PWD/utils/fdm_WorkerPool.h
 
 SOURCES += \
+    $$PWD/utils/fdm_AllocTracker.cpp \
     $$PWD/utils/fdm_Angles.cpp \
+    $$PWD/utils/fdm_Arena.cpp \
+    $$PWD/utils/fdm_Compressor.cpp \
     $$PWD/utils/fdm_DataNode.cpp \
+    $$PWD/utils/fdm_DataPool.cpp \
+    $$PWD/utils/fdm_FPEnv.cpp \
     $$PWD/utils/fdm_Geom.cpp \
+    $$PWD/utils/fdm_Histogram.cpp \
+    $$PWD/utils/fdm_MappedFile.cpp \
     $$PWD/utils/fdm_Matrix3x3.cpp \
     $$PWD/utils/fdm_Matrix4x4.cpp \
     $$PWD/utils/fdm_Matrix6x6.cpp \
+    $$PWD/utils/fdm_MemoryStats.cpp \
+    $$PWD/utils/fdm_Metrics.cpp \
     $$PWD/utils/fdm_Oscillation.cpp \
+    $$PWD/utils/fdm_Profiler.cpp \
     $$PWD/utils/fdm_Quaternion.cpp \
     $$PWD/utils/fdm_Random.cpp \
+    $$PWD/utils/fdm_StateArchive.cpp \
     $$PWD/utils/fdm_String.cpp \
     $$PWD/utils/fdm_Table1.cpp \
     $$PWD/utils/fdm_Table2.cpp \
+    $$PWD/utils/fdm_Table2Pack.cpp \
+    $$PWD/utils/fdm_ThreadPlacement.cpp \
+    $$PWD/utils/fdm_TriangleBVH.cpp \
     $$PWD/utils/fdm_Units.cpp \
     $$PWD/utils/fdm_Vector3.cpp \
     $$PWD/utils/fdm_Vector4.cpp \
     $$PWD/utils/fdm_Vector6.cpp \
     $$PWD/utils/fdm_VectorN.cpp \
-    $$PWD/utils/fdm_WGS84.cpp
+    $$PWD/utils/fdm_WGS84.cpp \
+    $$PWD/utils/fdm_WorkerPool.cpp
 
 ################################################################################
 
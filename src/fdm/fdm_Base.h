@@ -30,6 +30,8 @@
 
 #include <fdm/main/fdm_Input.h>
 
+#include <fdm/utils/fdm_Arena.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -38,7 +40,7 @@ namespace fdm
 /**
  * @brief Base class.
  */
-class FDMEXPORT Base
+class FDMEXPORT Base : public ArenaObject
 {
 public:
 
@@ -0,0 +1,422 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/fdm_Builder.h>
+
+#include <algorithm>
+
+#include <fdm_aw101/aw101_FDM.h>
+#include <fdm_c130/c130_FDM.h>
+#include <fdm_c172/c172_FDM.h>
+#include <fdm_f16/f16_FDM.h>
+#include <fdm_f35a/f35a_FDM.h>
+#include <fdm_p51/p51_FDM.h>
+#include <fdm_pw5/pw5_FDM.h>
+#include <fdm_r44/r44_FDM.h>
+#include <fdm_uh60/uh60_FDM.h>
+
+#ifdef FDM_TEST
+#   include <fdm_xf/xf_FDM.h>
+#   include <fdm_xh/xh_FDM.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Builder::Builder( const DataInp *dataInpPtr, DataOut *dataOutPtr ) :
+    _dataInpPtr ( dataInpPtr ),
+    _dataOutPtr ( dataOutPtr ),
+
+    _building  ( DataInp::C172 ),
+    _requested ( DataInp::C172 ),
+
+    _poolSize ( 0 ),
+
+    _background  ( true ),
+    _isBuilding  ( false ),
+    _isRequested ( false ),
+    _quit        ( false ),
+    _verbose     ( true )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Builder::~Builder()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _quit = true;
+    }
+
+    _cv.notify_all();
+
+    if ( _thread.joinable() ) _thread.join();
+
+    for ( Entries::iterator it = _ready.begin(); it != _ready.end(); ++it )
+    {
+        destroy( &(*it).instance );
+    }
+
+    for ( Instances::iterator it = _garbage.begin(); it != _garbage.end(); ++it )
+    {
+        destroy( &(*it) );
+    }
+
+    _ready.clear();
+    _garbage.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::request( AircraftType aircraftType )
+{
+    if ( !_background ) return;
+
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _requested   = aircraftType;
+    _isRequested = true;
+
+    schedule( aircraftType );
+    discard();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Builder::acquire( AircraftType aircraftType, Instance *instance )
+{
+    if ( !_background )
+    {
+        Entry entry;
+
+        build( aircraftType, &entry );
+
+        if ( entry.failed ) throw entry.exception;
+
+        (*instance) = entry.instance;
+
+        return true;
+    }
+
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _requested   = aircraftType;
+    _isRequested = true;
+
+    for ( Entries::iterator it = _ready.begin(); it != _ready.end(); ++it )
+    {
+        if ( (*it).type == aircraftType )
+        {
+            Entry entry = (*it);
+
+            _ready.erase( it );
+
+            if ( entry.failed )
+            {
+                throw entry.exception;
+            }
+
+            (*instance) = entry.instance;
+
+            if ( _poolSize > 0 )
+            {
+                _recent.erase( std::remove( _recent.begin(), _recent.end(), aircraftType ),
+                               _recent.end() );
+                _recent.insert( _recent.begin(), aircraftType );
+
+                if ( _recent.size() > _poolSize ) _recent.resize( _poolSize );
+
+                // another one is built in advance for the next reset
+                schedule( aircraftType );
+            }
+
+            discard();
+
+            return true;
+        }
+    }
+
+    schedule( aircraftType );
+    discard();
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::release( Instance *instance )
+{
+    if ( !_background )
+    {
+        destroy( instance );
+    }
+    else if ( instance->fdm != FDM_NULLPTR || instance->arena != FDM_NULLPTR )
+    {
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+
+            if ( !_thread.joinable() )
+            {
+                _thread = std::thread( &Builder::work, this );
+            }
+
+            _garbage.push_back( (*instance) );
+        }
+
+        _cv.notify_one();
+    }
+
+    instance->fdm   = FDM_NULLPTR;
+    instance->arena = FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::setBackground( bool background )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _background = background;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::setPoolSize( unsigned int poolSize )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _poolSize = poolSize;
+
+    if ( _recent.size() > _poolSize ) _recent.resize( _poolSize );
+
+    discard();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+FDM* Builder::createFDM( AircraftType aircraftType )
+{
+    FDM *fdm = 0;
+
+    switch ( aircraftType )
+    {
+        case DataInp::AW101: fdm = new AW101_FDM ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::C130:  fdm = new C130_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::C172:  fdm = new C172_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::F16:   fdm = new F16_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::F35A:  fdm = new F35A_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::P51:   fdm = new P51_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::PW5:   fdm = new PW5_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::R44:   fdm = new R44_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::UH60:  fdm = new UH60_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+#       ifdef FDM_TEST
+        case DataInp::XF:    fdm = new XF_FDM    ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+        case DataInp::XH:    fdm = new XH_FDM    ( _dataInpPtr, _dataOutPtr, _verbose ); break;
+#       endif
+    }
+
+    return fdm;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::build( AircraftType aircraftType, Entry *entry )
+{
+    entry->type           = aircraftType;
+    entry->instance.fdm   = FDM_NULLPTR;
+    entry->instance.arena = FDM_NULLPTR;
+    entry->failed         = false;
+
+    try
+    {
+        entry->instance.arena = new Arena();
+
+        // the whole model is allocated from its own arena
+        ArenaScope arenaScope( entry->instance.arena );
+
+        entry->instance.fdm = createFDM( aircraftType );
+
+        if ( entry->instance.fdm == FDM_NULLPTR )
+        {
+            Exception e;
+
+            e.setType( Exception::UnknownException );
+            e.setInfo( "Unknown aircraft type." );
+
+            FDM_THROW( e );
+        }
+    }
+    catch ( Exception &e )
+    {
+        entry->exception = e;
+        entry->failed    = true;
+    }
+    catch ( ... )
+    {
+        entry->exception.setType( Exception::UnknownException );
+        entry->exception.setInfo( "Building flight dynamics model failed." );
+        entry->failed = true;
+    }
+
+    if ( entry->failed ) destroy( &entry->instance );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Builder::isWanted( AircraftType aircraftType ) const
+{
+    if ( _isRequested && aircraftType == _requested ) return true;
+
+    return std::find( _recent.begin(), _recent.end(), aircraftType ) != _recent.end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::schedule( AircraftType aircraftType )
+{
+    if ( _isBuilding && _building == aircraftType ) return;
+
+    if ( std::find( _pending.begin(), _pending.end(), aircraftType ) != _pending.end() ) return;
+
+    for ( Entries::const_iterator it = _ready.begin(); it != _ready.end(); ++it )
+    {
+        if ( (*it).type == aircraftType ) return;
+    }
+
+    // requested type goes first, ahead of pool refills
+    if ( _isRequested && aircraftType == _requested )
+        _pending.insert( _pending.begin(), aircraftType );
+    else
+        _pending.push_back( aircraftType );
+
+    if ( !_thread.joinable() )
+    {
+        _thread = std::thread( &Builder::work, this );
+    }
+
+    _cv.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::discard()
+{
+    Entries::iterator it = _ready.begin();
+
+    while ( it != _ready.end() )
+    {
+        if ( isWanted( (*it).type ) )
+        {
+            ++it;
+        }
+        else
+        {
+            if ( !(*it).failed ) _garbage.push_back( (*it).instance );
+            it = _ready.erase( it );
+        }
+    }
+
+    Types::iterator jt = _pending.begin();
+
+    while ( jt != _pending.end() )
+    {
+        if ( isWanted( *jt ) )
+            ++jt;
+        else
+            jt = _pending.erase( jt );
+    }
+
+    if ( !_garbage.empty() ) _cv.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::work()
+{
+    while ( true )
+    {
+        Instances garbage;
+
+        AircraftType aircraftType = DataInp::C172;
+        bool building = false;
+
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+
+            _cv.wait( lock, [this]()
+            {
+                return _quit || !_pending.empty() || !_garbage.empty();
+            });
+
+            if ( _quit ) break;
+
+            garbage.swap( _garbage );
+
+            if ( !_pending.empty() )
+            {
+                aircraftType = _pending.front();
+                _pending.erase( _pending.begin() );
+
+                _building   = aircraftType;
+                _isBuilding = true;
+
+                building = true;
+            }
+        }
+
+        for ( Instances::iterator it = garbage.begin(); it != garbage.end(); ++it )
+        {
+            destroy( &(*it) );
+        }
+
+        if ( building )
+        {
+            Entry entry;
+
+            build( aircraftType, &entry );
+
+            std::lock_guard< std::mutex > lock( _mutex );
+
+            _isBuilding = false;
+
+            if ( isWanted( aircraftType ) )
+            {
+                _ready.push_back( entry );
+            }
+            else if ( !entry.failed )
+            {
+                _garbage.push_back( entry.instance );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Builder::destroy( Instance *instance )
+{
+    FDM_DELPTR( instance->fdm );
+    FDM_DELPTR( instance->arena );
+}
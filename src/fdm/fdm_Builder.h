@@ -0,0 +1,218 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_BUILDER_H
+#define FDM_BUILDER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fdm/fdm_DataInp.h>
+#include <fdm/fdm_DataOut.h>
+#include <fdm/fdm_Exception.h>
+
+#include <fdm/main/fdm_FDM.h>
+
+#include <fdm/utils/fdm_Arena.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Flight dynamics model background builder class.
+ *
+ * Builder constructs flight dynamics model objects (which involves parsing
+ * aircraft data files and building tables) in its own thread, so caller
+ * thread stepping simulation is never stalled. Ready object is handed off
+ * by acquire() which does not block for longer than taking a lock. Released
+ * objects are destroyed in the builder thread as well.
+ *
+ * Optionally builder keeps a pool of pre-built, not yet initialized objects
+ * of recently used aircraft types. Once such object is acquired another one
+ * of the same type is built in the background, so aircraft switches and
+ * resets do not have to wait for construction.
+ *
+ * Every object is allocated from its own memory arena.
+ */
+class FDMEXPORT Builder
+{
+public:
+
+    typedef DataInp::AircraftType AircraftType;
+
+    /** Built flight dynamics model instance. */
+    struct Instance
+    {
+        FDM   *fdm;                     ///< flight dynamics model object
+        Arena *arena;                   ///< memory arena the object is allocated from
+    };
+
+    /**
+     * @brief Constructor.
+     * @param dataInpPtr input data pointer passed to built objects
+     * @param dataOutPtr output data pointer passed to built objects
+     */
+    Builder( const DataInp *dataInpPtr, DataOut *dataOutPtr );
+
+    /** @brief Destructor. */
+    virtual ~Builder();
+
+    /**
+     * @brief Requests building object of the given type.
+     * Does nothing if such object is already built or being built.
+     * @param aircraftType aircraft type
+     */
+    void request( AircraftType aircraftType );
+
+    /**
+     * @brief Takes ready object of the given type if there is one.
+     * Requests building object if there is none.
+     * @param aircraftType aircraft type
+     * @param instance instance to be filled with taken object
+     * @return true if object has been taken, false otherwise
+     * @throws Exception if building object of the given type failed
+     */
+    bool acquire( AircraftType aircraftType, Instance *instance );
+
+    /**
+     * @brief Passes object to be destroyed in the builder thread.
+     * @param instance instance to be released (cleared afterwards)
+     */
+    void release( Instance *instance );
+
+    inline unsigned int getPoolSize() const { return _poolSize; }
+    inline bool getBackground() const { return _background; }
+    inline bool getVerbose() const { return _verbose; }
+
+    /**
+     * @brief Sets if objects are built in the background.
+     * If not, objects are built in acquire() and destroyed in release()
+     * without starting builder thread (e.g. for offline batch runs).
+     * @param background specifies if objects are built in the background
+     */
+    void setBackground( bool background );
+
+    /**
+     * @brief Sets number of recently used aircraft types kept pre-built.
+     * @param poolSize number of aircraft types (0 disables pool)
+     */
+    void setPoolSize( unsigned int poolSize );
+
+    inline void setVerbose( bool verbose ) { _verbose = verbose; }
+
+private:
+
+    /** Pending or built object entry. */
+    struct Entry
+    {
+        AircraftType type;              ///< aircraft type
+        Instance instance;              ///< built instance
+        Exception exception;            ///< building exception
+        bool failed;                    ///< specifies if building failed
+    };
+
+    typedef std::vector< AircraftType > Types;
+    typedef std::vector< Entry > Entries;
+    typedef std::vector< Instance > Instances;
+
+    const DataInp *_dataInpPtr;         ///< input data pointer
+    DataOut       *_dataOutPtr;         ///< output data pointer
+
+    std::thread _thread;                ///< builder thread (started on first request)
+
+    std::mutex _mutex;                  ///< mutex guarding builder state
+    std::condition_variable _cv;        ///< builder thread wake up condition
+
+    Types _pending;                     ///< aircraft types to be built
+    Types _recent;                      ///< recently acquired aircraft types, most recent first
+    Entries _ready;                     ///< built objects
+    Instances _garbage;                 ///< objects to be destroyed
+
+    AircraftType _building;             ///< aircraft type being built
+    AircraftType _requested;            ///< most recently requested aircraft type
+
+    unsigned int _poolSize;             ///< number of recently used aircraft types kept pre-built
+
+    bool _background;                   ///< specifies if objects are built in the background
+    bool _isBuilding;                   ///< specifies if object is being built
+    bool _isRequested;                  ///< specifies if any aircraft type has been requested
+    bool _quit;                         ///< specifies if builder thread should quit
+    bool _verbose;                      ///< specifies if extra information should be printed
+
+    /** Using this constructor is forbidden. */
+    Builder( const Builder & );
+
+    /**
+     * @brief Creates flight dynamics model object.
+     * @param aircraftType aircraft type
+     * @return aircraft object on success null pointer on failure
+     */
+    FDM* createFDM( AircraftType aircraftType );
+
+    /**
+     * @brief Builds object.
+     * @param aircraftType aircraft type
+     * @param entry entry to be filled with built object or building exception
+     */
+    void build( AircraftType aircraftType, Entry *entry );
+
+    /**
+     * @brief Checks if object of the given type is still wanted.
+     * Must be called with the mutex locked.
+     * @param aircraftType aircraft type
+     * @return true if object is wanted, false otherwise
+     */
+    bool isWanted( AircraftType aircraftType ) const;
+
+    /**
+     * @brief Adds aircraft type to the pending ones, starts thread if needed.
+     * Must be called with the mutex locked.
+     * @param aircraftType aircraft type
+     */
+    void schedule( AircraftType aircraftType );
+
+    /**
+     * @brief Moves objects which are not wanted anymore to the garbage.
+     * Must be called with the mutex locked.
+     */
+    void discard();
+
+    /** @brief Builder thread function. */
+    void work();
+
+    /**
+     * @brief Destroys object.
+     * @param instance instance to be destroyed
+     */
+    static void destroy( Instance *instance );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_BUILDER_H
@@ -0,0 +1,477 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/fdm_CApi.h>
+
+#include <cstddef>
+
+#include <fdm/fdm_DataInp.h>
+#include <fdm/fdm_DataOut.h>
+#include <fdm/fdm_Log.h>
+#include <fdm/fdm_Manager.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+// C declarations of fdm_CData.h have to match fdm::DataInp and fdm::DataOut
+// layouts exactly, as buffers are passed to the manager without copying
+
+#define FDM_CAPI_CHECK_SIZE( c_type, cpp_type ) \
+    static_assert( sizeof(c_type) == sizeof(cpp_type), \
+                   #c_type " size does not match " #cpp_type )
+
+#define FDM_CAPI_CHECK_FIELD( c_type, cpp_type, field ) \
+    static_assert( offsetof(c_type, field) == offsetof(cpp_type, field) \
+                && sizeof(c_type::field) == sizeof(cpp_type::field), \
+                   #c_type "::" #field " does not match " #cpp_type )
+
+#define FDM_CAPI_CHECK_VALUE( c_value, cpp_value ) \
+    static_assert( (int)c_value == (int)cpp_value, \
+                   #c_value " value does not match " #cpp_value )
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp_Initial, DataInp::Initial );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, latitude );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, longitude );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, altitude_agl );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, offset_x );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, offset_y );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, heading );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, airspeed );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Initial, DataInp::Initial, engineOn );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp_Environment, DataInp::Environment );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, temperature_0 );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, pressure_0 );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, wind_direction );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, wind_speed );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, turbulence );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, windShear );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, seed );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, windField );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Environment, DataInp::Environment, atmosphereTable );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp_Ground, DataInp::Ground );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Ground, DataInp::Ground, elevation );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Ground, DataInp::Ground, r_x_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Ground, DataInp::Ground, r_y_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Ground, DataInp::Ground, r_z_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Ground, DataInp::Ground, n_x_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Ground, DataInp::Ground, n_y_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Ground, DataInp::Ground, n_z_wgs );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp_Controls, DataInp::Controls );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, roll );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, pitch );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, yaw );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, trim_roll );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, trim_pitch );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, trim_yaw );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, brake_l );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, brake_r );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, wheel_brake );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, landing_gear );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, wheel_nose );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, flaps );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, airbrake );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, spoilers );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, collective );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, lgh );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, nws );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Controls, DataInp::Controls, abs );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp_Engine, DataInp::Engine );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Engine, DataInp::Engine, throttle );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Engine, DataInp::Engine, mixture );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Engine, DataInp::Engine, propeller );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Engine, DataInp::Engine, fuel );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Engine, DataInp::Engine, ignition );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Engine, DataInp::Engine, starter );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp_Masses, DataInp::Masses );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Masses, DataInp::Masses, pilot );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Masses, DataInp::Masses, tank );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Masses, DataInp::Masses, cabin );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Masses, DataInp::Masses, trunk );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Masses, DataInp::Masses, slung );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp_Recording, DataInp::Recording );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Recording, DataInp::Recording, mode );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Recording, DataInp::Recording, rate );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Recording, DataInp::Recording, direct );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp_Recording, DataInp::Recording, file );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataInp, DataInp );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, initial );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, environment );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, ground );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, controls );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, engine );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, masses );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, recording );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, aircraftType );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, stateInp );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, freezePosition );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, freezeAttitude );
+FDM_CAPI_CHECK_FIELD( fdm_DataInp, DataInp, freezeVelocity );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Flight, DataOut::Flight );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, latitude );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, longitude );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, altitude_asl );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, altitude_agl );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, roll );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, pitch );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, heading );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, angleOfAttack );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, sideslipAngle );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, climbAngle );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, trackAngle );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, slipSkidAngle );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, airspeed );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, ias );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, tas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, groundSpeed );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, machNumber );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, climbRate );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, rollRate );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, pitchRate );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, yawRate );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, turnRate );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, pos_x_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, pos_y_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, pos_z_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, att_e0_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, att_ex_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, att_ey_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, att_ez_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, vel_u_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, vel_v_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, vel_w_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, omg_p_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, omg_q_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, omg_r_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, phi_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, tht_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, psi_wgs );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, airspeed_u_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, airspeed_v_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, airspeed_w_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, vel_north );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, vel_east );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, acc_x_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, acc_y_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, acc_z_bas );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, g_force_x );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, g_force_y );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, g_force_z );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, g_pilot_x );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, g_pilot_y );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, g_pilot_z );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, onGround );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Flight, DataOut::Flight, stall );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Controls, DataOut::Controls );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, ailerons );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, elevator );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, elevons );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, rudder );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, flaps );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, flaperons );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, lef );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Controls, DataOut::Controls, airbrake );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Engine, DataOut::Engine );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, state );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, afterburner );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, rpm );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, prop );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, ng );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, n1 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, n2 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, trq );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, epr );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, map );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, egt );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, cht );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, itt );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, tit );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Engine, DataOut::Engine, fuelFlow );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Environment, DataOut::Environment );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Environment, DataOut::Environment, air_pressure );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Environment, DataOut::Environment, air_density );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Environment, DataOut::Environment, air_temperature );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Rotor, DataOut::Rotor );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_omega );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_azimuth );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_coningAngle );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_diskRoll );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_diskPitch );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_collective );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_cyclicLon );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, mainRotor_cyclicLat );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Rotor, DataOut::Rotor, tailRotor_azimuth );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Blade, DataOut::Blade );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Blade, DataOut::Blade, flapping );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Blade, DataOut::Blade, feathering );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Timing, DataOut::Timing );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, compTime );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, compTime_p50 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, compTime_p99 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, compTime_p999 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, compTime_max );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, timeStep );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, timeStep_p50 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, timeStep_p99 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, timeStep_p999 );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, timeStep_max );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, aero );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, ctrl );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, gear );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, mass );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, prop );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, integrator );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, deriv );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Timing, DataOut::Timing, derivCount );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut_Lockstep, DataOut::Lockstep );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Lockstep, DataOut::Lockstep, frame );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut_Lockstep, DataOut::Lockstep, stateHash );
+
+FDM_CAPI_CHECK_SIZE( fdm_DataOut, DataOut );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, flight );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, controls );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, engine );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, environment );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, rotor );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, blade );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, timing );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, lockstep );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, crash );
+FDM_CAPI_CHECK_FIELD( fdm_DataOut, DataOut, stateOut );
+
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_AW101 , DataInp::AW101 );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_C130  , DataInp::C130  );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_C172  , DataInp::C172  );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_F16   , DataInp::F16   );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_F35A  , DataInp::F35A  );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_P51   , DataInp::P51   );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_PW5   , DataInp::PW5   );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_R44   , DataInp::R44   );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_UH60  , DataInp::UH60  );
+#ifdef FDM_TEST
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_XF    , DataInp::XF    );
+FDM_CAPI_CHECK_VALUE( FDM_AIRCRAFT_XH    , DataInp::XH    );
+#endif
+
+FDM_CAPI_CHECK_VALUE( FDM_STATE_INP_IDLE  , DataInp::Idle  );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_INP_INIT  , DataInp::Init  );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_INP_WORK  , DataInp::Work  );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_INP_PAUSE , DataInp::Pause );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_INP_STOP  , DataInp::Stop  );
+
+FDM_CAPI_CHECK_VALUE( FDM_TURBULENCE_NONE     , DataInp::Environment::TurbulenceNone     );
+FDM_CAPI_CHECK_VALUE( FDM_TURBULENCE_MILD     , DataInp::Environment::TurbulenceMild     );
+FDM_CAPI_CHECK_VALUE( FDM_TURBULENCE_MODERATE , DataInp::Environment::TurbulenceModerate );
+FDM_CAPI_CHECK_VALUE( FDM_TURBULENCE_SEVERE   , DataInp::Environment::TurbulenceSevere   );
+FDM_CAPI_CHECK_VALUE( FDM_TURBULENCE_EXTREME  , DataInp::Environment::TurbulenceExtreme  );
+
+FDM_CAPI_CHECK_VALUE( FDM_WIND_SHEAR_NONE   , DataInp::Environment::WindShearNone   );
+FDM_CAPI_CHECK_VALUE( FDM_WIND_SHEAR_MODEL1 , DataInp::Environment::WindShearModel1 );
+FDM_CAPI_CHECK_VALUE( FDM_WIND_SHEAR_MODEL2 , DataInp::Environment::WindShearModel2 );
+FDM_CAPI_CHECK_VALUE( FDM_WIND_SHEAR_MODEL3 , DataInp::Environment::WindShearModel3 );
+FDM_CAPI_CHECK_VALUE( FDM_WIND_SHEAR_MODEL4 , DataInp::Environment::WindShearModel4 );
+
+FDM_CAPI_CHECK_VALUE( FDM_RECORDING_DISABLED , DataInp::Recording::Disabled );
+FDM_CAPI_CHECK_VALUE( FDM_RECORDING_RECORD   , DataInp::Recording::Record   );
+FDM_CAPI_CHECK_VALUE( FDM_RECORDING_REPLAY   , DataInp::Recording::Replay   );
+
+FDM_CAPI_CHECK_VALUE( FDM_STATE_OUT_IDLE         , DataOut::Idle         );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_OUT_INITIALIZING , DataOut::Initializing );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_OUT_READY        , DataOut::Ready        );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_OUT_WORKING      , DataOut::Working      );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_OUT_PAUSED       , DataOut::Paused       );
+FDM_CAPI_CHECK_VALUE( FDM_STATE_OUT_STOPPED      , DataOut::Stopped      );
+
+FDM_CAPI_CHECK_VALUE( FDM_CRASH_NONE       , DataOut::NoCrash    );
+FDM_CAPI_CHECK_VALUE( FDM_CRASH_COLLISION  , DataOut::Collision  );
+FDM_CAPI_CHECK_VALUE( FDM_CRASH_OVERSPEED  , DataOut::Overspeed  );
+FDM_CAPI_CHECK_VALUE( FDM_CRASH_OVERSTRESS , DataOut::Overstress );
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct fdm_Handle
+{
+    Manager *manager;               ///< flight dynamics model manager
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+int fdm_getVersion( void )
+{
+    return FDM_CAPI_VERSION;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t fdm_getDataInpSize( void )
+{
+    return sizeof(DataInp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+size_t fdm_getDataOutSize( void )
+{
+    return sizeof(DataOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm_Handle* fdm_create( const fdm_DataInp *dataInp, fdm_DataOut *dataOut )
+{
+    if ( dataInp == FDM_NULLPTR || dataOut == FDM_NULLPTR )
+    {
+        return FDM_NULLPTR;
+    }
+
+    try
+    {
+        Manager *manager = new Manager( reinterpret_cast<const DataInp*>( dataInp ),
+                                        reinterpret_cast<DataOut*>( dataOut ) );
+
+        fdm_Handle *handle = new fdm_Handle();
+        handle->manager = manager;
+
+        return handle;
+    }
+    catch ( ... )
+    {
+        Log::e() << "Cannot create flight dynamics model manager." << std::endl;
+    }
+
+    return FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void fdm_destroy( fdm_Handle *handle )
+{
+    if ( handle != FDM_NULLPTR )
+    {
+        FDM_DELPTR( handle->manager );
+
+        delete handle;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void fdm_setVerbose( fdm_Handle *handle, int verbose )
+{
+    if ( handle != FDM_NULLPTR )
+    {
+        handle->manager->setVerbose( verbose != 0 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void fdm_setBackgroundBuild( fdm_Handle *handle, int background )
+{
+    if ( handle != FDM_NULLPTR )
+    {
+        handle->manager->setBackgroundBuild( background != 0 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int fdm_step( fdm_Handle *handle, double timeStep, unsigned int steps )
+{
+    if ( handle == FDM_NULLPTR )
+    {
+        return FDM_CAPI_FAILURE;
+    }
+
+    try
+    {
+        for ( unsigned int i = 0; i < steps; i++ )
+        {
+            handle->manager->step( timeStep );
+        }
+
+        return FDM_CAPI_SUCCESS;
+    }
+    catch ( Exception &e )
+    {
+        Log::e() << e.getInfo() << std::endl;
+    }
+    catch ( ... )
+    {
+        Log::e() << "Unknown exception in flight dynamics model step." << std::endl;
+    }
+
+    return FDM_CAPI_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int fdm_getStateSize( const fdm_Handle *handle )
+{
+    if ( handle == FDM_NULLPTR )
+    {
+        return 0;
+    }
+
+    return handle->manager->getStateSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int fdm_saveState( const fdm_Handle *handle, double *state )
+{
+    if ( handle == FDM_NULLPTR || state == FDM_NULLPTR )
+    {
+        return FDM_CAPI_FAILURE;
+    }
+
+    return handle->manager->saveState( state ) == FDM_SUCCESS ? FDM_CAPI_SUCCESS : FDM_CAPI_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int fdm_restoreState( fdm_Handle *handle, const double *state )
+{
+    if ( handle == FDM_NULLPTR || state == FDM_NULLPTR )
+    {
+        return FDM_CAPI_FAILURE;
+    }
+
+    return handle->manager->restoreState( state ) == FDM_SUCCESS ? FDM_CAPI_SUCCESS : FDM_CAPI_FAILURE;
+}
@@ -0,0 +1,188 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_CAPI_H
+#define FDM_CAPI_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file fdm_CApi.h
+ * @brief C interface of the flight dynamics model manager.
+ *
+ * Interface allows embedding fdm::Manager in external processes (e.g.
+ * instructor stations or simulation gateways) written in any language able
+ * to call C functions. It has no Qt nor OSG dependencies.
+ *
+ * Input and output data are caller provided fdm_DataInp and fdm_DataOut
+ * structures (C declarations of fdm::DataInp and fdm::DataOut), they are
+ * read and written in place by the manager in every step, so no data is
+ * copied. Setting inputs is writing input structure and getting outputs is
+ * reading output structure between steps. Structures sizes might be checked
+ * against fdm_getDataInpSize() and fdm_getDataOutSize() to detect mismatched
+ * headers. Structures have to remain valid until the handle is destroyed.
+ *
+ * Handle is not thread-safe, all functions for the given handle have to be
+ * called from one thread at a time. Exceptions do not cross the interface.
+ *
+ * Example:
+ * @code
+ * fdm_DataInp dataInp;
+ * fdm_DataOut dataOut;
+ *
+ * memset( &dataInp, 0, sizeof(dataInp) );
+ * memset( &dataOut, 0, sizeof(dataOut) );
+ *
+ * fdm_Handle *fdm = fdm_create( &dataInp, &dataOut );
+ *
+ * dataInp.aircraftType = FDM_AIRCRAFT_C172;
+ * dataInp.stateInp     = FDM_STATE_INP_INIT;
+ *
+ * while ( dataOut.stateOut != FDM_STATE_OUT_READY )
+ * {
+ *     fdm_step( fdm, 0.01, 1 );
+ * }
+ *
+ * dataInp.stateInp = FDM_STATE_INP_WORK;
+ * fdm_step( fdm, 0.01, 100 );
+ *
+ * fdm_destroy( fdm );
+ * @endcode
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+
+#include <fdm/fdm_CData.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+#   if defined(FDM_DLL_EXPORTS)
+#       define FDM_CAPI __declspec(dllexport)
+#   elif defined(FDM_DLL_IMPORTS)
+#       define FDM_CAPI __declspec(dllimport)
+#   else
+#       define FDM_CAPI
+#   endif
+#else
+#   define FDM_CAPI
+#endif
+
+#define FDM_CAPI_VERSION 2          ///< interface version
+
+#define FDM_CAPI_SUCCESS 0          ///< same as FDM_SUCCESS
+#define FDM_CAPI_FAILURE 1          ///< same as FDM_FAILURE
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Flight dynamics model manager handle. */
+typedef struct fdm_Handle fdm_Handle;
+
+/**
+ * @brief Returns interface version.
+ * @return interface version (FDM_CAPI_VERSION of the library)
+ */
+FDM_CAPI int fdm_getVersion( void );
+
+/** @return size of the fdm_DataInp structure */
+FDM_CAPI size_t fdm_getDataInpSize( void );
+
+/** @return size of the fdm_DataOut structure */
+FDM_CAPI size_t fdm_getDataOutSize( void );
+
+/**
+ * @brief Creates flight dynamics model manager.
+ * @param dataInp input data
+ * @param dataOut output data
+ * @return manager handle on success, null pointer on failure
+ */
+FDM_CAPI fdm_Handle* fdm_create( const fdm_DataInp *dataInp, fdm_DataOut *dataOut );
+
+/**
+ * @brief Destroys flight dynamics model manager.
+ * @param handle manager handle, might be null pointer
+ */
+FDM_CAPI void fdm_destroy( fdm_Handle *handle );
+
+/**
+ * @brief Sets if extra information should be printed.
+ * @param handle manager handle
+ * @param verbose non-zero if extra information should be printed
+ */
+FDM_CAPI void fdm_setVerbose( fdm_Handle *handle, int verbose );
+
+/**
+ * @brief Sets if flight dynamics model objects are built in the background.
+ * When building in the background is disabled the step requesting model
+ * construction blocks until the model is built.
+ * @param handle manager handle
+ * @param background non-zero if objects are built in the background
+ */
+FDM_CAPI void fdm_setBackgroundBuild( fdm_Handle *handle, int background );
+
+/**
+ * @brief Performs given number of manager steps.
+ * Input data are read and output data are written in every step.
+ * @param handle manager handle
+ * @param timeStep [s] simulation time step
+ * @param steps number of steps
+ * @return FDM_CAPI_SUCCESS on success, FDM_CAPI_FAILURE on failure
+ */
+FDM_CAPI int fdm_step( fdm_Handle *handle, double timeStep, unsigned int steps );
+
+/**
+ * @brief Returns number of values needed to save state.
+ * @param handle manager handle
+ * @return number of values, 0 if there is no flight dynamics model
+ */
+FDM_CAPI unsigned int fdm_getStateSize( const fdm_Handle *handle );
+
+/**
+ * @brief Saves flight dynamics model state (snapshot).
+ * @param handle manager handle
+ * @param state output array of fdm_getStateSize() values
+ * @return FDM_CAPI_SUCCESS on success, FDM_CAPI_FAILURE on failure
+ */
+FDM_CAPI int fdm_saveState( const fdm_Handle *handle, double *state );
+
+/**
+ * @brief Restores flight dynamics model state saved with fdm_saveState().
+ * State might be restored in the same or another manager running the same
+ * aircraft type.
+ * @param handle manager handle
+ * @param state array of fdm_getStateSize() values
+ * @return FDM_CAPI_SUCCESS on success, FDM_CAPI_FAILURE on failure
+ */
+FDM_CAPI int fdm_restoreState( fdm_Handle *handle, const double *state );
+
+#ifdef __cplusplus
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_CAPI_H
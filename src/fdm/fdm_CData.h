@@ -0,0 +1,461 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_CDATA_H
+#define FDM_CDATA_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @file fdm_CData.h
+ * @brief C declarations of the simulation input and output data.
+ *
+ * Structures mirror fdm::DataInp and fdm::DataOut field by field, layout
+ * equality is checked at compile time in fdm_CApi.cpp.
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __cplusplus
+#   include <stdbool.h>
+#endif
+#include <stdint.h>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Aircraft type. */
+typedef enum fdm_AircraftType
+{
+    FDM_AIRCRAFT_AW101 = 1,             ///< AW101
+    FDM_AIRCRAFT_C130 = 2,              ///< C-130
+    FDM_AIRCRAFT_C172 = 3,              ///< Cessna 172
+    FDM_AIRCRAFT_F16 = 4,               ///< F-16
+    FDM_AIRCRAFT_F35A = 5,              ///< F-35A
+    FDM_AIRCRAFT_P51 = 6,               ///< P-51
+    FDM_AIRCRAFT_PW5 = 7,               ///< PW-5
+    FDM_AIRCRAFT_R44 = 8,               ///< R44
+    FDM_AIRCRAFT_UH60 = 9               ///< UH-60
+
+#   ifdef FDM_TEST
+    ,FDM_AIRCRAFT_XF = 901              ///< eXperimental jet Fighter
+    ,FDM_AIRCRAFT_XH = 902              ///< eXperimental Helicopter
+#   endif
+
+} fdm_AircraftType;
+
+/** State input. */
+typedef enum fdm_StateInp
+{
+    FDM_STATE_INP_IDLE = 0,             ///< idle
+    FDM_STATE_INP_INIT,                 ///< initialize
+    FDM_STATE_INP_WORK,                 ///< work
+    FDM_STATE_INP_PAUSE,                ///< pause
+    FDM_STATE_INP_STOP                  ///< stop
+} fdm_StateInp;
+
+/** Turbulence intensity. */
+typedef enum fdm_Turbulence
+{
+    FDM_TURBULENCE_NONE = 0,            ///< none
+    FDM_TURBULENCE_MILD,                ///< mild
+    FDM_TURBULENCE_MODERATE,            ///< moderate
+    FDM_TURBULENCE_SEVERE,              ///< severe
+    FDM_TURBULENCE_EXTREME              ///< extreme
+} fdm_Turbulence;
+
+/** Wind shear types. */
+typedef enum fdm_WindShear
+{
+    FDM_WIND_SHEAR_NONE = 0,            ///< none
+    FDM_WIND_SHEAR_MODEL1,              ///< FAA Windshear Training Aid Vol. 2, Reference Wind Model #1, p. 4.3-146
+    FDM_WIND_SHEAR_MODEL2,              ///< FAA Windshear Training Aid Vol. 2, Reference Wind Model #2, p. 4.3-148
+    FDM_WIND_SHEAR_MODEL3,              ///< FAA Windshear Training Aid Vol. 2, Reference Wind Model #3, p. 4.3-150
+    FDM_WIND_SHEAR_MODEL4               ///< FAA Windshear Training Aid Vol. 2, Reference Wind Model #4, p. 4.3-152
+} fdm_WindShear;
+
+/** Recording modes. */
+typedef enum fdm_RecordingMode
+{
+    FDM_RECORDING_DISABLED = 0,         ///< disabled
+    FDM_RECORDING_RECORD,               ///< record
+    FDM_RECORDING_REPLAY                ///< replay
+} fdm_RecordingMode;
+
+/** Initial conditions. */
+typedef struct fdm_DataInp_Initial
+{
+    double latitude;                    ///< [rad] geodetic latitude (positive north)
+    double longitude;                   ///< [rad] geodetic longitude (positive east)
+    double altitude_agl;                ///< [m] altitude above ground level
+    double offset_x;                    ///< [m] initial position longitudinal offset
+    double offset_y;                    ///< [m] initial position lateral offset
+    double heading;                     ///< [rad] true heading
+    double airspeed;                    ///< [m/s] airspeed
+
+    bool engineOn;                      ///< specifies if engine is working at start
+} fdm_DataInp_Initial;
+
+/** Environment data. */
+typedef struct fdm_DataInp_Environment
+{
+    double temperature_0;               ///< [K] sea level air temperature
+    double pressure_0;                  ///< [Pa] sea level air pressure
+    double wind_direction;              ///< [rad] wind direction
+    double wind_speed;                  ///< [m/s] wind speed
+
+    fdm_Turbulence turbulence;          ///< turbulence intensity
+    fdm_WindShear windShear;            ///< active wind shear model
+
+    unsigned int seed;                  ///< random number generator seed (0 means seed based on current time, or FDM_LOCKSTEP_SEED if FDM_LOCKSTEP is defined)
+
+    char windField[ 4096 ];             ///< wind field file (empty means no wind field)
+
+    bool atmosphereTable;               ///< specifies if atmospheric data are interpolated from lookup table
+} fdm_DataInp_Environment;
+
+/** Ground data. */
+typedef struct fdm_DataInp_Ground
+{
+    double elevation;                   ///< [m] ground elevation above mean sea level
+
+    double r_x_wgs;                     ///< [m] ground x coordinate expressed in WGS
+    double r_y_wgs;                     ///< [m] ground y coordinate expressed in WGS
+    double r_z_wgs;                     ///< [m] ground z coordinate expressed in WGS
+
+    double n_x_wgs;                     ///< [-] vector normal to ground x coordinate expressed in WGS
+    double n_y_wgs;                     ///< [-] vector normal to ground y coordinate expressed in WGS
+    double n_z_wgs;                     ///< [-] vector normal to ground z coordinate expressed in WGS
+} fdm_DataInp_Ground;
+
+/**
+ * Controls data.
+ * @see ISO 1151-4:1994
+ * @see ISO 1151-6:1982
+ */
+typedef struct fdm_DataInp_Controls
+{
+    double roll;                        ///< [-1.0,1.0] roll control (positive in the port direction)
+    double pitch;                       ///< [-1.0,1.0] pitch control (positive in the forward direction)
+    double yaw;                         ///< [-1.0,1.0] yaw control (positive when the left foot moves in the forward direction)
+
+    double trim_roll;                   ///< [-1.0,1.0] roll trim
+    double trim_pitch;                  ///< [-1.0,1.0] pitch trim
+    double trim_yaw;                    ///< [-1.0,1.0] yaw trim
+
+    double brake_l;                     ///< [0.0,1.0] left brake
+    double brake_r;                     ///< [0.0,1.0] right brake
+    double wheel_brake;                 ///< [0.0,1.0] wheel brake
+
+    double landing_gear;                ///< [0.0,1.0] landing gear
+    double wheel_nose;                  ///< [-1.0,1.0] nose wheel steering (positive when the left foot moves in the forward direction)
+
+    double flaps;                       ///< [0.0,1.0] flaps
+    double airbrake;                    ///< [0.0,1.0] airbrake
+    double spoilers;                    ///< [0.0,1.0] spoilers
+
+    double collective;                  ///< [0.0,1.0] collective control (positive in the upward direction)
+
+    bool lgh;                           ///< landing gear handle
+    bool nws;                           ///< nose wheel steering
+    bool abs;                           ///< anti-skid braking system
+} fdm_DataInp_Controls;
+
+/** Engine data. */
+typedef struct fdm_DataInp_Engine
+{
+    double throttle;                    ///< [0.0,1.0] throttle
+    double mixture;                     ///< [0.0,1.0] mixture lever
+    double propeller;                   ///< [0.0,1.0] propeller lever
+
+    bool fuel;                          ///< specifies if fuel is provided
+    bool ignition;                      ///< specifies if ignition is enabled
+    bool starter;                       ///< specifies if starter is enabled
+} fdm_DataInp_Engine;
+
+/** Masses data. */
+typedef struct fdm_DataInp_Masses
+{
+    double pilot[ FDM_MAX_PILOTS ];     ///< [kg] pilots
+    double tank[ FDM_MAX_TANKS ];       ///< [kg] fuel tanks
+    double cabin;                       ///< [kg] cabin
+    double trunk;                       ///< [kg] cargo trunk
+    double slung;                       ///< [kg] slung load
+} fdm_DataInp_Masses;
+
+/** Recording data. */
+typedef struct fdm_DataInp_Recording
+{
+    fdm_RecordingMode mode;             ///< recording mode
+    double rate;                        ///< [-] replay rate, negative rates replay backwards (binary recordings only), 0 means real-time
+    bool direct;                        ///< specifies if recorded outputs are replayed directly, without computing aircraft model
+    char file[ 4096 ];                  ///< recording file
+} fdm_DataInp_Recording;
+
+/**
+ * @brief Simulation input data.
+ * @see fdm::DataInp
+ */
+typedef struct fdm_DataInp
+{
+    fdm_DataInp_Initial     initial;                        ///< initial conditions
+    fdm_DataInp_Environment environment;                    ///< environment data
+    fdm_DataInp_Ground      ground;                         ///< ground data
+    fdm_DataInp_Controls    controls;                       ///< controls data
+    fdm_DataInp_Engine      engine[ FDM_MAX_ENGINES ];      ///< engines data
+    fdm_DataInp_Masses      masses;                         ///< masses data
+    fdm_DataInp_Recording   recording;                      ///< recording data
+
+    fdm_AircraftType aircraftType;                          ///< input aircraft type
+    fdm_StateInp stateInp;                                  ///< input state
+
+    bool freezePosition;                                    ///< specifies if aircraft position is to be frozen
+    bool freezeAttitude;                                    ///< specifies if aircraft attitude is to be frozen
+    bool freezeVelocity;                                    ///< specifies if aircraft velocity is to be frozen
+} fdm_DataInp;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** State output. */
+typedef enum fdm_StateOut
+{
+    FDM_STATE_OUT_IDLE = 0,             ///< idle
+    FDM_STATE_OUT_INITIALIZING,         ///< initializing
+    FDM_STATE_OUT_READY,                ///< ready
+    FDM_STATE_OUT_WORKING,              ///< working
+    FDM_STATE_OUT_PAUSED,               ///< paused
+    FDM_STATE_OUT_STOPPED               ///< stopped
+} fdm_StateOut;
+
+/** Aircraft crash condition. */
+typedef enum fdm_Crash
+{
+    FDM_CRASH_NONE = 0,                 ///< no crash
+    FDM_CRASH_COLLISION,                ///< collision with terrain or obstacle
+    FDM_CRASH_OVERSPEED,                ///< airspeed too high
+    FDM_CRASH_OVERSTRESS                ///< load factor too high
+} fdm_Crash;
+
+/** Flight data. */
+typedef struct fdm_DataOut_Flight
+{
+    double latitude;                    ///< [rad] geodetic latitude (positive north)
+    double longitude;                   ///< [rad] geodetic longitude (positive east)
+
+    double altitude_asl;                ///< [m] altitude above mean sea level
+    double altitude_agl;                ///< [m] altitude above ground level
+
+    double roll;                        ///< [rad] roll angle
+    double pitch;                       ///< [rad] pitch angle
+    double heading;                     ///< [rad] true heading
+
+    double angleOfAttack;               ///< [rad] angle of attack
+    double sideslipAngle;               ///< [rad] angle of sideslip
+
+    double climbAngle;                  ///< [rad] climb angle
+    double trackAngle;                  ///< [rad] track angle
+
+    double slipSkidAngle;               ///< [rad] slip/skid angle
+
+    double airspeed;                    ///< [m/s] airspeed (real aircraft airspeed)
+    double ias;                         ///< [m/s] IAS (along x-axis)
+    double tas;                         ///< [m/s] TAS (along x-axis)
+    double groundSpeed;                 ///< [m/s] ground speed (horizontal velocity)
+    double machNumber;                  ///< [-]   Mach number
+    double climbRate;                   ///< [m/s] climb rate
+
+    double rollRate;                    ///< [rad/s] roll rate  (angular velcoity p component expressed in BAS)
+    double pitchRate;                   ///< [rad/s] pitch rate (angular velcoity q component expressed in BAS)
+    double yawRate;                     ///< [rad/s] yaw rate   (angular velcoity r component expressed in BAS)
+    double turnRate;                    ///< [rad/s] turn rate  (heading change rate)
+
+    double pos_x_wgs;                   ///< [m] postion x coordinate expressed in WGS
+    double pos_y_wgs;                   ///< [m] postion y coordinate expressed in WGS
+    double pos_z_wgs;                   ///< [m] postion z coordinate expressed in WGS
+
+    double att_e0_wgs;                  ///< [-] attitude quaternion e0 component expressed as rotation from WGS to BAS
+    double att_ex_wgs;                  ///< [-] attitude quaternion ex component expressed as rotation from WGS to BAS
+    double att_ey_wgs;                  ///< [-] attitude quaternion ey component expressed as rotation from WGS to BAS
+    double att_ez_wgs;                  ///< [-] attitude quaternion ez component expressed as rotation from WGS to BAS
+
+    double vel_u_bas;                   ///< [m/s] velcoity u component expressed in BAS
+    double vel_v_bas;                   ///< [m/s] velcoity v component expressed in BAS
+    double vel_w_bas;                   ///< [m/s] velcoity w component expressed in BAS
+
+    double omg_p_bas;                   ///< [rad/s] angular velcoity p component expressed in BAS
+    double omg_q_bas;                   ///< [rad/s] angular velcoity q component expressed in BAS
+    double omg_r_bas;                   ///< [rad/s] angular velcoity r component expressed in BAS
+
+    double phi_wgs;                     ///< [rad] angle of rotation about x axis from WGS to BAS expressed in zyx convention (Bryant angles)
+    double tht_wgs;                     ///< [rad] angle of rotation about y axis from WGS to BAS expressed in zyx convention (Bryant angles)
+    double psi_wgs;                     ///< [rad] angle of rotation about z axis from WGS to BAS expressed in zyx convention (Bryant angles)
+
+    double airspeed_u_bas;              ///< [m/s] velcoity relative to airflow u component expressed in BAS
+    double airspeed_v_bas;              ///< [m/s] velcoity relative to airflow v component expressed in BAS
+    double airspeed_w_bas;              ///< [m/s] velcoity relative to airflow w component expressed in BAS
+
+    double vel_north;                   ///< [m/s] north velcoity u component expressed in BAS
+    double vel_east;                    ///< [m/s] east velcoity v component expressed in BAS
+
+    double acc_x_bas;                   ///< [m/s^2] linear acceleration x component expressed in BAS
+    double acc_y_bas;                   ///< [m/s^2] linear acceleration y component expressed in BAS
+    double acc_z_bas;                   ///< [m/s^2] linear acceleration z component expressed in BAS
+
+    double g_force_x;                   ///< [-] x component of G-Force vector expressed in BAS (aircraft)
+    double g_force_y;                   ///< [-] y component of G-Force vector expressed in BAS (aircraft)
+    double g_force_z;                   ///< [-] z component of G-Force vector expressed in BAS (aircraft)
+
+    double g_pilot_x;                   ///< [-] x component of G-Force vector expressed in BAS (pilot)
+    double g_pilot_y;                   ///< [-] y component of G-Force vector expressed in BAS (pilot)
+    double g_pilot_z;                   ///< [-] z component of G-Force vector expressed in BAS (pilot)
+
+    bool onGround;                      ///< specifies if aircraft is on ground
+    bool stall;                         ///< specifies if aircraft is stalling
+} fdm_DataOut_Flight;
+
+/** Controls data. */
+typedef struct fdm_DataOut_Controls
+{
+    double ailerons;                    ///< [rad] ailerons deflection (positive left aileron in the upward direction)
+    double elevator;                    ///< [rad] elevator deflection (positive in the downward direction)
+    double elevons;                     ///< [rad] elevons differential deflection
+    double rudder;                      ///< [rad] rudder deflection (positive in the port direction)
+    double flaps;                       ///< [rad] flaps deflection
+    double flaperons;                   ///< [rad] flaperons differtial deflection
+    double lef;                         ///< [rad] leading edge flaps deflection
+    double airbrake;                    ///< [rad] airbrake deflection
+} fdm_DataOut_Controls;
+
+/** Engine data. */
+typedef struct fdm_DataOut_Engine
+{
+    bool state;                         ///< specifies if engine is working
+    bool afterburner;                   ///< afterburner
+
+    double rpm;                         ///< [rpm] engine rpm
+    double prop;                        ///< [rpm] propeller rpm
+    double ng;                          ///< [%] gas generator rotational speed
+    double n1;                          ///< [%] low pressure spool rotational speed
+    double n2;                          ///< [%] high pressure spool rotational speed
+    double trq;                         ///< [%] torque
+    double epr;                         ///< [-] engine pressure ratio
+    double map;                         ///< [Pa] manifold absolute pressure
+    double egt;                         ///< [deg C] exhaust gas temperature
+    double cht;                         ///< [deg C] cylinder head temperature
+    double itt;                         ///< [deg C] interstage turbine temperature
+    double tit;                         ///< [deg C] turbine inlet temperature
+
+    double fuelFlow;                    ///< [kg/s] fuel flow
+} fdm_DataOut_Engine;
+
+/** Environment data. */
+typedef struct fdm_DataOut_Environment
+{
+    double air_pressure;                ///< [Pa] air pressure
+    double air_density;                 ///< [kg/m^3] air density
+    double air_temperature;             ///< [K] air temperature
+} fdm_DataOut_Environment;
+
+/** Rotor data. */
+typedef struct fdm_DataOut_Rotor
+{
+    double mainRotor_omega;             ///< [rad/s] main rotor rotation speed
+    double mainRotor_azimuth;           ///< [rad] main rotor rotation angle (azimuth)
+    double mainRotor_coningAngle;       ///< [rad] main rotor coning angle
+    double mainRotor_diskRoll;          ///< [rad] main rotor disk roll angle
+    double mainRotor_diskPitch;         ///< [rad] main rotor disk pitch angle
+    double mainRotor_collective;        ///< [rad] main rotor collective pitch angle
+    double mainRotor_cyclicLon;         ///< [rad] main rotor longitudinal cyclic pitch angle
+    double mainRotor_cyclicLat;         ///< [rad] main rotor lateral cyclic pitch angle
+    double tailRotor_azimuth;           ///< [rad] tail rotor rotation angle
+} fdm_DataOut_Rotor;
+
+/** Blade data. */
+typedef struct fdm_DataOut_Blade
+{
+    double flapping;                    ///< [rad] flapping angle
+    double feathering;                  ///< [rad] feathering angle
+} fdm_DataOut_Blade;
+
+/** Step timing data. */
+typedef struct fdm_DataOut_Timing
+{
+    double compTime;                    ///< [s] last step computations time
+    double compTime_p50;                ///< [s] computations time median
+    double compTime_p99;                ///< [s] computations time 99th percentile
+    double compTime_p999;               ///< [s] computations time 99.9th percentile
+    double compTime_max;                ///< [s] computations time maximum
+
+    double timeStep;                    ///< [s] last raw time step
+    double timeStep_p50;                ///< [s] raw time step median
+    double timeStep_p99;                ///< [s] raw time step 99th percentile
+    double timeStep_p999;               ///< [s] raw time step 99.9th percentile
+    double timeStep_max;                ///< [s] raw time step maximum
+
+    double aero;                        ///< [s] last step aerodynamics computations time
+    double ctrl;                        ///< [s] last step controls computations time
+    double gear;                        ///< [s] last step landing gear computations time
+    double mass;                        ///< [s] last step mass computations time
+    double prop;                        ///< [s] last step propulsion computations time
+    double integrator;                  ///< [s] last step integrator and state variables update computations time
+
+    double deriv;                       ///< [s] last step state derivative computations time
+    unsigned int derivCount;            ///< number of state derivative evaluations in the last step
+} fdm_DataOut_Timing;
+
+/** Lockstep data (updated only if FDM_LOCKSTEP is defined). */
+typedef struct fdm_DataOut_Lockstep
+{
+    uint64_t frame;                     ///< number of working steps since initialization
+    uint64_t stateHash;                 ///< FNV-1a hash of the frame number and the state vector
+} fdm_DataOut_Lockstep;
+
+/**
+ * @brief Simulation output data.
+ * @see fdm::DataOut
+ */
+typedef struct fdm_DataOut
+{
+    fdm_DataOut_Flight      flight;                         ///< flight data
+    fdm_DataOut_Controls    controls;                       ///< controls data
+    fdm_DataOut_Engine      engine[ FDM_MAX_ENGINES ];      ///< engines data
+    fdm_DataOut_Environment environment;                    ///< environment data
+    fdm_DataOut_Rotor       rotor;                          ///< rotor data
+    fdm_DataOut_Blade       blade[ FDM_MAX_BLADES ];        ///< blades data
+    fdm_DataOut_Timing      timing;                         ///< step timing data
+    fdm_DataOut_Lockstep    lockstep;                       ///< lockstep data
+
+    fdm_Crash crash;                                        ///< crash cause
+    fdm_StateOut stateOut;                                  ///< output state
+} fdm_DataOut;
+
+#ifdef __cplusplus
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_CDATA_H
@@ -110,6 +110,12 @@ struct DataInp
 
         Turbulence turbulence;              ///< turbulence intensity
         WindShear  windShear;               ///< active wind shear model
+
+        unsigned int seed;                  ///< random number generator seed (0 means seed based on current time, or FDM_LOCKSTEP_SEED if FDM_LOCKSTEP is defined)
+
+        char windField[ 4096 ];             ///< wind field file (empty means no wind field)
+
+        bool atmosphereTable;               ///< specifies if atmospheric data are interpolated from lookup table
     };
 
     /** Ground data. */
@@ -193,6 +199,8 @@ struct DataInp
         };
 
         Mode mode;                          ///< recording mode
+        double rate;                        ///< [-] replay rate, negative rates replay backwards (binary recordings only), 0 means real-time
+        bool direct;                        ///< specifies if recorded outputs are replayed directly, without computing aircraft model
         char file[ 4096 ];                  ///< recording file
     };
 
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -197,12 +198,47 @@ struct DataOut
         double feathering;                  ///< [rad] feathering angle
     };
 
+    /** Step timing data. */
+    struct Timing
+    {
+        double compTime;                    ///< [s] last step computations time
+        double compTime_p50;                ///< [s] computations time median
+        double compTime_p99;                ///< [s] computations time 99th percentile
+        double compTime_p999;               ///< [s] computations time 99.9th percentile
+        double compTime_max;                ///< [s] computations time maximum
+
+        double timeStep;                    ///< [s] last raw time step
+        double timeStep_p50;                ///< [s] raw time step median
+        double timeStep_p99;                ///< [s] raw time step 99th percentile
+        double timeStep_p999;               ///< [s] raw time step 99.9th percentile
+        double timeStep_max;                ///< [s] raw time step maximum
+
+        double aero;                        ///< [s] last step aerodynamics computations time
+        double ctrl;                        ///< [s] last step controls computations time
+        double gear;                        ///< [s] last step landing gear computations time
+        double mass;                        ///< [s] last step mass computations time
+        double prop;                        ///< [s] last step propulsion computations time
+        double integrator;                  ///< [s] last step integrator and state variables update computations time
+
+        double deriv;                       ///< [s] last step state derivative computations time
+        unsigned int derivCount;            ///< number of state derivative evaluations in the last step
+    };
+
+    /** Lockstep data (updated only if FDM_LOCKSTEP is defined). */
+    struct Lockstep
+    {
+        UInt64 frame;                       ///< number of working steps since initialization
+        UInt64 stateHash;                   ///< FNV-1a hash of the frame number and the state vector
+    };
+
     Flight      flight;                     ///< flight data
     Controls    controls;                   ///< controls data
     Engine      engine[ FDM_MAX_ENGINES ];  ///< engines data
     Environment environment;                ///< environment data
     Rotor       rotor;                      ///< rotor data
     Blade       blade[ FDM_MAX_BLADES ];    ///< blades data
+    Timing      timing;                     ///< step timing data
+    Lockstep    lockstep;                   ///< lockstep data
 
     Crash crash;                            ///< crash cause
     StateOut stateOut;                      ///< output state
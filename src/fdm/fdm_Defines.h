@@ -24,7 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef FDM_TEST
+#if defined(FDM_TEST) && defined(__cplusplus)
 #   include <iostream>
 #endif
 
@@ -58,6 +58,20 @@
 #define FDM_TIME_STEP_MIN 0.001
 #define FDM_TIME_STEP_MAX 0.1
 
+#ifdef FDM_LOCKSTEP
+#   define FDM_LOCKSTEP_SEED 0x4D534353494D0001ULL  /* used if no seed is given */
+#endif
+
+#if defined(FDM_UNCHECKED) && defined(_DEBUG)
+#   undef FDM_UNCHECKED /* debug builds keep full runtime checks */
+#endif
+
+#ifdef FDM_UNCHECKED
+#   ifndef FDM_NAN_CHECK_STEPS
+#       define FDM_NAN_CHECK_STEPS 10   /* number of steps per state vector NaN check */
+#   endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #define FDM_MAX_PILOTS  2
@@ -67,6 +81,8 @@
 
 #define FDM_MAX_VECTORS 16
 
+#define FDM_MAX_DOWNWASH_SAMPLES 128   /* 1.28 s at 100 Hz */
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #define FDM_MIN_INIT_ALTITUDE 30.0
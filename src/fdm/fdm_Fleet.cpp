@@ -0,0 +1,128 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/fdm_Fleet.h>
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Fleet::Fleet( unsigned int threads ) :
+    _workerPool ( FDM_NULLPTR )
+{
+    if ( threads == 0 ) threads = WorkerPool::getHardwareThreads();
+
+    if ( threads > 1 )
+    {
+        _workerPool = new WorkerPool( threads );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Fleet::~Fleet()
+{
+    for ( unsigned int i = 0; i < _members.size(); i++ )
+    {
+        FDM_DELPTR( _members[ i ]->manager );
+        FDM_DELPTR( _members[ i ] );
+    }
+
+    _members.clear();
+
+    FDM_DELPTR( _workerPool );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Fleet::addMember( UInt32 id )
+{
+    if ( getIndex( id ) >= 0 ) return FDM_FAILURE;
+
+    Member *member = new Member();
+
+    member->id = id;
+
+    memset( &member->dataInp, 0, sizeof(DataInp) );
+    memset( &member->dataOut, 0, sizeof(DataOut) );
+
+    // member is allocated on heap, so data pointers stay valid
+    member->manager = new Manager( &member->dataInp, &member->dataOut );
+
+    _members.push_back( member );
+
+    return FDM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Fleet::removeMember( UInt32 id )
+{
+    int index = getIndex( id );
+
+    if ( index < 0 ) return FDM_FAILURE;
+
+    FDM_DELPTR( _members[ index ]->manager );
+    FDM_DELPTR( _members[ index ] );
+
+    _members.erase( _members.begin() + index );
+
+    return FDM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Fleet::getIndex( UInt32 id ) const
+{
+    for ( unsigned int i = 0; i < _members.size(); i++ )
+    {
+        if ( _members[ i ]->id == id ) return (int)i;
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Fleet::step( double timeStep )
+{
+    if ( _workerPool && _members.size() > 1 )
+    {
+        WorkerPool::Task task = [ this, timeStep ]( unsigned int index )
+        {
+            _members[ index ]->manager->step( timeStep );
+        };
+
+        _workerPool->run( _members.size(), task );
+    }
+    else
+    {
+        for ( unsigned int i = 0; i < _members.size(); i++ )
+        {
+            _members[ i ]->manager->step( timeStep );
+        }
+    }
+}
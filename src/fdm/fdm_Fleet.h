@@ -0,0 +1,124 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_FLEET_H
+#define FDM_FLEET_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Manager.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/utils/fdm_WorkerPool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Multiple aircraft simulation class.
+ *
+ * Fleet owns several simulation managers, each with its own input and
+ * output data and an entity ID, and steps them all in a worker threads
+ * pool. Managers are entirely independent (every one has its own memory
+ * arena), so they are stepped concurrently without any locking. Calling
+ * thread takes part in stepping and step() returns when all of them have
+ * been stepped.
+ *
+ * Members inputs might be modified and outputs read only between steps.
+ */
+class Fleet
+{
+public:
+
+    /** Fleet member. */
+    struct Member
+    {
+        UInt32 id;                  ///< entity ID
+        DataInp dataInp;            ///< input data
+        DataOut dataOut;            ///< output data
+        Manager *manager;           ///< simulation manager
+    };
+
+    /**
+     * @brief Constructor.
+     * @param threads total number of threads including calling thread, 0 means number of hardware threads
+     */
+    Fleet( unsigned int threads = 0 );
+
+    /** @brief Destructor. */
+    virtual ~Fleet();
+
+    /**
+     * @brief Adds member.
+     * Member input and output data are zeroed.
+     * @param id entity ID
+     * @return FDM_SUCCESS on success or FDM_FAILURE if ID is already used
+     */
+    int addMember( UInt32 id );
+
+    /**
+     * @brief Removes member.
+     * @param id entity ID
+     * @return FDM_SUCCESS on success or FDM_FAILURE if there is no such member
+     */
+    int removeMember( UInt32 id );
+
+    /**
+     * @brief Returns member index.
+     * @param id entity ID
+     * @return member index or -1 if there is no such member
+     */
+    int getIndex( UInt32 id ) const;
+
+    /**
+     * @brief Steps all members.
+     * Managers handle flight dynamics model exceptions on their own, any
+     * other exception thrown while stepping is rethrown in calling thread.
+     * @param timeStep [s] simulation time step
+     */
+    void step( double timeStep );
+
+    inline unsigned int getCount() const { return _members.size(); }
+
+    inline unsigned int getThreads() const { return _workerPool ? _workerPool->getThreads() : 1; }
+
+    inline       Member& getMember( unsigned int index )       { return *_members[ index ]; }
+    inline const Member& getMember( unsigned int index ) const { return *_members[ index ]; }
+
+private:
+
+    std::vector< Member* > _members;    ///< members
+
+    WorkerPool *_workerPool;            ///< stepping worker pool (null if members are stepped serially)
+
+    /** Using this constructor is forbidden. */
+    Fleet( const Fleet & );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_FLEET_H
@@ -22,10 +22,21 @@
 
 #include <fdm/fdm_Log.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fdm/fdm_Types.h>
 
 #ifdef _LINUX_
 #   include <sys/time.h>
@@ -41,11 +52,151 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::ostream& Log::_out = std::cerr;
+namespace
+{
+
+/** Time tag data captured when message begins. */
+struct Stamp
+{
+#   ifdef _LINUX_
+    struct timeval tp;          ///< time of day
+#   endif
+
+#   ifdef WIN32
+    SYSTEMTIME st;              ///< local time
+#   endif
+};
+
+/** Queued message. */
+struct Record
+{
+    UInt64 seq;                 ///< sequence number
+    Log::Level level;           ///< message level
+    Stamp stamp;                ///< time tag data
+    std::string text;           ///< message text
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::ostream& Log::timeTag()
+/**
+ * @brief Single producer single consumer lock-free messages queue.
+ * Producer is the thread owning the queue, consumer is the flush thread.
+ * Consumer mutex is taken also by the producer when the queue is full, so
+ * producer is able to drain it on its own without breaking messages order.
+ */
+class Queue
+{
+public:
+
+    static const size_t _size = 1024;   ///< number of records
+
+    Queue() : _head ( 0 ), _tail ( 0 ), _abandoned ( false ) {}
+
+    /**
+     * @brief Pushes record, record text is swapped with a free slot text.
+     * @param record record to be pushed
+     * @return true on success, false if queue is full
+     */
+    bool push( Record *record )
+    {
+        size_t head = _head.load( std::memory_order_relaxed );
+        size_t next = ( head + 1 ) % _size;
+
+        if ( next == _tail.load( std::memory_order_acquire ) ) return false;
+
+        Record &slot = _records[ head ];
+
+        slot.seq   = record->seq;
+        slot.level = record->level;
+        slot.stamp = record->stamp;
+
+        // slot keeps its capacity, so steady state pushing does not allocate
+        slot.text.swap( record->text );
+
+        _head.store( next, std::memory_order_release );
+
+        return true;
+    }
+
+    /** @return number of records ready to be consumed */
+    size_t getCount() const
+    {
+        size_t head = _head.load( std::memory_order_acquire );
+        size_t tail = _tail.load( std::memory_order_relaxed );
+
+        return ( head + _size - tail ) % _size;
+    }
+
+    /**
+     * @brief Returns record ready to be consumed.
+     * @param index record index counted from the oldest one
+     */
+    Record* getRecord( size_t index )
+    {
+        return &_records[ ( _tail.load( std::memory_order_relaxed ) + index ) % _size ];
+    }
+
+    /**
+     * @brief Removes consumed records.
+     * @param count number of records
+     */
+    void pop( size_t count )
+    {
+        size_t tail = _tail.load( std::memory_order_relaxed );
+        _tail.store( ( tail + count ) % _size, std::memory_order_release );
+    }
+
+    inline bool isAbandoned() const { return _abandoned.load( std::memory_order_acquire ); }
+
+    inline void setAbandoned() { _abandoned.store( true, std::memory_order_release ); }
+
+    inline std::mutex& getConsumerMutex() { return _consumer; }
+
+private:
+
+    Record _records[ _size ];           ///< records ring
+
+    std::atomic< size_t > _head;        ///< next record to be pushed
+    std::atomic< size_t > _tail;        ///< next record to be consumed
+
+    std::atomic< bool > _abandoned;     ///< specifies if owning thread has exited
+
+    std::mutex _consumer;               ///< consumer mutex
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+const std::chrono::milliseconds flushInterval( 50 );    ///< flush thread wake up interval
+
+std::atomic< bool > async( false );     ///< specifies if asynchronous mode is started
+std::atomic< UInt64 > seq( 0 );         ///< next message sequence number
+
+std::mutex queuesMutex;                 ///< mutex guarding queues list
+std::vector< Queue* > queues;           ///< all threads queues
+
+std::mutex outMutex;                    ///< mutex guarding output stream in asynchronous mode
+
+std::mutex flushMutex;                  ///< mutex guarding flush thread state
+std::condition_variable flushCv;        ///< flush thread wake up condition
+std::thread flushThread;                ///< flush thread
+bool quit = false;                      ///< specifies if flush thread should quit
+
+////////////////////////////////////////////////////////////////////////////////
+
+void getStamp( Stamp *stamp )
+{
+#   ifdef _LINUX_
+    gettimeofday( &stamp->tp, NULL );
+#   endif
+
+#   ifdef WIN32
+    GetLocalTime( &stamp->st );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void writeTimeTag( std::ostream &out, const Stamp &stamp )
 {
     int year = 2000;
     int mon  = 1;
@@ -56,47 +207,375 @@ std::ostream& Log::timeTag()
     int msec = 0;
 
 #   ifdef _LINUX_
-    struct timeval tp;
-    gettimeofday( &tp, NULL );
-    std::tm *tm = std::localtime( &tp.tv_sec );
-
-    year = 1900 + tm->tm_year;
-    mon  = tm->tm_mon + 1;
-    day  = tm->tm_mday;
-    hour = tm->tm_hour;
-    min  = tm->tm_min;
-    sec  = tm->tm_sec;
-    msec = floor( tp.tv_usec * 0.001 );
+    std::tm tm;
+    localtime_r( &stamp.tp.tv_sec, &tm );
+
+    year = 1900 + tm.tm_year;
+    mon  = tm.tm_mon + 1;
+    day  = tm.tm_mday;
+    hour = tm.tm_hour;
+    min  = tm.tm_min;
+    sec  = tm.tm_sec;
+    msec = floor( stamp.tp.tv_usec * 0.001 );
 #   endif
 
 #   ifdef WIN32
-    SYSTEMTIME st;
-    GetLocalTime( &st );
-
-    year = st.wYear;
-    mon  = st.wMonth;
-    day  = st.wDay;
-    hour = st.wHour;
-    min  = st.wMinute;
-    sec  = st.wSecond;
-    msec = st.wMilliseconds;
+    year = stamp.st.wYear;
+    mon  = stamp.st.wMonth;
+    day  = stamp.st.wDay;
+    hour = stamp.st.wHour;
+    min  = stamp.st.wMinute;
+    sec  = stamp.st.wSecond;
+    msec = stamp.st.wMilliseconds;
 #   endif
 
-    _out << "[";
-    _out << year;
-    _out << "-";
-    _out << std::setfill('0') << std::setw( 2 ) << mon;
-    _out << "-";
-    _out << std::setfill('0') << std::setw( 2 ) << day;
-    _out << " ";
-    _out << std::setfill('0') << std::setw( 2 ) << hour;
-    _out << ":";
-    _out << std::setfill('0') << std::setw( 2 ) << min;
-    _out << ":";
-    _out << std::setfill('0') << std::setw( 2 ) << sec;
-    _out << ".";
-    _out << std::setfill('0') << std::setw( 3 ) << msec;
-    _out << "]";
+    out << "[";
+    out << year;
+    out << "-";
+    out << std::setfill('0') << std::setw( 2 ) << mon;
+    out << "-";
+    out << std::setfill('0') << std::setw( 2 ) << day;
+    out << " ";
+    out << std::setfill('0') << std::setw( 2 ) << hour;
+    out << ":";
+    out << std::setfill('0') << std::setw( 2 ) << min;
+    out << ":";
+    out << std::setfill('0') << std::setw( 2 ) << sec;
+    out << ".";
+    out << std::setfill('0') << std::setw( 3 ) << msec;
+    out << "]";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* getLevelTag( Log::Level level )
+{
+    switch ( level )
+    {
+        case Log::Info:    return "[INFO] ";
+        case Log::Warning: return "[WARNING] ";
+        case Log::Error:   return "[ERROR] ";
+        default: break;
+    }
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void write( std::ostream &out, const Record &record )
+{
+    if ( record.level != Log::Untagged )
+    {
+        writeTimeTag( out, record.stamp );
+        out << getLevelTag( record.level );
+    }
+
+    out << record.text;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Thread own log stream buffer.
+ * Message text is collected until the stream is flushed and then pushed to
+ * the thread queue.
+ */
+class Stream : public std::streambuf
+{
+public:
+
+    Stream() :
+        _stream ( this ),
+        _queue ( new Queue() )
+    {
+        _record.seq   = 0;
+        _record.level = Log::Untagged;
+
+        memset( &_record.stamp, 0, sizeof(Stamp) );
+
+        _record.text.reserve( 256 );
+
+        std::lock_guard< std::mutex > lock( queuesMutex );
+        queues.push_back( _queue );
+    }
+
+    virtual ~Stream()
+    {
+        commit();
+
+        // queue is deleted by the flush thread when drained
+        _queue->setAbandoned();
+    }
+
+    /**
+     * @brief Begins message.
+     * Untagged output continues current message if there is one.
+     * @param level message level
+     * @return output stream
+     */
+    std::ostream& begin( Log::Level level )
+    {
+        if ( level != Log::Untagged || _record.text.empty() )
+        {
+            commit();
+
+            _record.level = level;
+
+            if ( level != Log::Untagged ) getStamp( &_record.stamp );
+        }
+
+        return _stream;
+    }
+
+protected:
+
+    virtual int overflow( int c )
+    {
+        if ( c != EOF ) _record.text.push_back( (char)c );
+        return c;
+    }
+
+    virtual std::streamsize xsputn( const char *s, std::streamsize n )
+    {
+        _record.text.append( s, n );
+        return n;
+    }
+
+    virtual int sync()
+    {
+        commit();
+        return 0;
+    }
+
+private:
+
+    std::ostream _stream;       ///< output stream
+    Queue *_queue;              ///< thread queue
+    Record _record;             ///< current message
+
+    /** @brief Pushes current message to the queue. */
+    void commit()
+    {
+        if ( _record.text.empty() ) return;
+
+        _record.seq = seq.fetch_add( 1 );
+
+        if ( !async.load( std::memory_order_acquire ) )
+        {
+            std::lock_guard< std::mutex > lock( outMutex );
+            write( Log::_out, _record );
+        }
+        else if ( !_queue->push( &_record ) )
+        {
+            // queue is full, older messages are written first
+            std::lock_guard< std::mutex > consumerLock( _queue->getConsumerMutex() );
+            std::lock_guard< std::mutex > lock( outMutex );
+
+            size_t count = _queue->getCount();
+
+            for ( size_t i = 0; i < count; i++ )
+            {
+                write( Log::_out, *_queue->getRecord( i ) );
+            }
+
+            _queue->pop( count );
+
+            write( Log::_out, _record );
+        }
+
+        _record.text.clear();
+        _record.level = Log::Untagged;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+Stream& getStream()
+{
+    thread_local Stream stream;
+    return stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool compareSeq( const Record *r1, const Record *r2 )
+{
+    return r1->seq < r2->seq;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Writes all queued messages in order they were committed. */
+void flush()
+{
+    std::vector< Queue* > snapshot;
+
+    {
+        std::lock_guard< std::mutex > lock( queuesMutex );
+        snapshot = queues;
+    }
+
+    // consumer mutexes are always taken before the output stream mutex
+    for ( size_t i = 0; i < snapshot.size(); i++ )
+    {
+        snapshot[ i ]->getConsumerMutex().lock();
+    }
+
+    std::vector< size_t > counts( snapshot.size() );
+    std::vector< bool > abandoned( snapshot.size() );
+    std::vector< const Record* > records;
+
+    for ( size_t i = 0; i < snapshot.size(); i++ )
+    {
+        // abandoned flag has to be read first, no pushes follow it
+        abandoned[ i ] = snapshot[ i ]->isAbandoned();
+        counts[ i ] = snapshot[ i ]->getCount();
+
+        for ( size_t j = 0; j < counts[ i ]; j++ )
+        {
+            records.push_back( snapshot[ i ]->getRecord( j ) );
+        }
+    }
+
+    if ( !records.empty() )
+    {
+        std::sort( records.begin(), records.end(), compareSeq );
+
+        std::lock_guard< std::mutex > lock( outMutex );
+
+        for ( size_t i = 0; i < records.size(); i++ )
+        {
+            write( Log::_out, *records[ i ] );
+        }
+
+        Log::_out.flush();
+    }
+
+    std::vector< Queue* > drained;
+
+    for ( size_t i = 0; i < snapshot.size(); i++ )
+    {
+        snapshot[ i ]->pop( counts[ i ] );
+        snapshot[ i ]->getConsumerMutex().unlock();
+
+        if ( abandoned[ i ] ) drained.push_back( snapshot[ i ] );
+    }
+
+    if ( !drained.empty() )
+    {
+        std::lock_guard< std::mutex > lock( queuesMutex );
+
+        for ( size_t i = 0; i < drained.size(); i++ )
+        {
+            queues.erase( std::remove( queues.begin(), queues.end(), drained[ i ] ), queues.end() );
+            delete drained[ i ];
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Flush thread function. */
+void work()
+{
+    while ( true )
+    {
+        {
+            std::unique_lock< std::mutex > lock( flushMutex );
+
+            flushCv.wait_for( lock, flushInterval, [](){ return quit; } );
+
+            if ( quit ) break;
+        }
+
+        flush();
+    }
+
+    flush();
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::ostream& Log::_out = std::cerr;
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::ostream& Log::out()
+{
+    if ( async.load( std::memory_order_acquire ) )
+    {
+        return getStream().begin( Untagged );
+    }
+
+    return _out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::ostream& Log::timeTag()
+{
+    Stamp stamp;
+    getStamp( &stamp );
+
+    writeTimeTag( _out, stamp );
+
+    return _out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Log::startAsync()
+{
+    std::lock_guard< std::mutex > lock( flushMutex );
+
+    if ( !flushThread.joinable() )
+    {
+        quit = false;
+        async.store( true, std::memory_order_release );
+        flushThread = std::thread( work );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Log::stopAsync()
+{
+    {
+        std::lock_guard< std::mutex > lock( flushMutex );
+
+        if ( !flushThread.joinable() ) return;
+
+        async.store( false, std::memory_order_release );
+        quit = true;
+    }
+
+    flushCv.notify_all();
+    flushThread.join();
+
+    // messages pushed while the thread was finishing
+    flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Log::isAsync()
+{
+    return async.load( std::memory_order_acquire );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::ostream& Log::begin( Level level )
+{
+    if ( async.load( std::memory_order_acquire ) )
+    {
+        return getStream().begin( level );
+    }
+
+    if ( level != Untagged ) timeTag() << getLevelTag( level );
 
     return _out;
 }
@@ -35,24 +35,67 @@ namespace fdm
 
 /**
  * @brief Logging class.
+ *
+ * By default messages are written synchronously to the output stream.
+ * Once asynchronous mode is started every thread writes messages to its
+ * own lock-free queue instead. Time tag is captured when message begins,
+ * but it is formatted, and messages are written to the output stream, by
+ * a background flush thread, so logging does not stall time critical
+ * threads. Messages are committed to the queue when the stream is flushed
+ * (e.g. with std::endl). If the queue is full the message is written
+ * synchronously.
  */
 class FDMEXPORT Log
 {
 public:
 
+    /** Message level. */
+    enum Level
+    {
+        Untagged = 0,           ///< untagged output
+        Info,                   ///< information
+        Warning,                ///< warning
+        Error                   ///< error
+    };
+
     static std::ostream &_out;  ///< log output stream
 
-    inline static std::ostream& i() { return ( timeTag() << "[INFO] "    ); }
-    inline static std::ostream& w() { return ( timeTag() << "[WARNING] " ); }
-    inline static std::ostream& e() { return ( timeTag() << "[ERROR] "   ); }
+    inline static std::ostream& i() { return begin( Info    ); }
+    inline static std::ostream& w() { return begin( Warning ); }
+    inline static std::ostream& e() { return begin( Error   ); }
 
-    inline static std::ostream& out() { return _out; }
+    /** @return stream for untagged output (continues current message if there is one) */
+    static std::ostream& out();
 
     /**
      * @brief Creates time tag.
      * @return output stream
      */
     static std::ostream& timeTag();
+
+    /**
+     * @brief Starts asynchronous mode and background flush thread.
+     * Output stream should not be redirected until asynchronous mode is stopped.
+     */
+    static void startAsync();
+
+    /**
+     * @brief Stops asynchronous mode, writes all queued messages.
+     * Should be called when other threads do not log anymore.
+     */
+    static void stopAsync();
+
+    /** @return true if asynchronous mode is started, false otherwise */
+    static bool isAsync();
+
+private:
+
+    /**
+     * @brief Begins message.
+     * @param level message level
+     * @return output stream
+     */
+    static std::ostream& begin( Level level );
 };
 
 } // end of fdm namespace
@@ -22,40 +22,35 @@
 
 #include <fdm/fdm_Manager.h>
 
+#include <cfloat>
 #include <cstring>
 
 #include <fdm/fdm_Log.h>
 
+#include <fdm/utils/fdm_AllocTracker.h>
+#include <fdm/utils/fdm_FPEnv.h>
+#include <fdm/utils/fdm_Metrics.h>
 #include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Time.h>
 #include <fdm/utils/fdm_Units.h>
 
-#include <fdm_aw101/aw101_FDM.h>
-#include <fdm_c130/c130_FDM.h>
-#include <fdm_c172/c172_FDM.h>
-#include <fdm_f16/f16_FDM.h>
-#include <fdm_f35a/f35a_FDM.h>
-#include <fdm_p51/p51_FDM.h>
-#include <fdm_pw5/pw5_FDM.h>
-#include <fdm_r44/r44_FDM.h>
-#include <fdm_uh60/uh60_FDM.h>
-
-#ifdef FDM_TEST
-#   include <fdm_xf/xf_FDM.h>
-#   include <fdm_xh/xh_FDM.h>
-#endif
-
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const unsigned int Manager::_timingInterval = 100;
+
+////////////////////////////////////////////////////////////////////////////////
+
 Manager::Manager( const DataInp *dataInpPtr, DataOut *dataOutPtr ) :
     _dataInpPtr ( dataInpPtr ),
     _dataOutPtr ( dataOutPtr ),
 
     _fdm ( FDM_NULLPTR ),
+    _arena ( FDM_NULLPTR ),
+    _builder ( FDM_NULLPTR ),
 
     _stateInp ( DataInp::Idle ),
     _stateOut ( DataOut::Idle ),
@@ -78,14 +73,26 @@ Manager::Manager( const DataInp *dataInpPtr, DataOut *dataOutPtr ) :
     _stepsLT_def ( 0 ),
     _stepsGT_def ( 0 ),
 
+    _stepAllocs ( 0 ),
+    _frame ( 0 ),
+    _stateHash ( 0 ),
+
+    _requested ( false ),
     _verbose ( true )
-{}
+{
+    memset( &_timing, 0, sizeof(DataOut::Timing) );
+
+    _builder = new Builder( _dataInpPtr, _dataOutPtr );
+    _builder->setVerbose( _verbose );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Manager::~Manager()
 {
     FDM_DELPTR( _fdm );
+    FDM_DELPTR( _arena );
+    FDM_DELPTR( _builder );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,16 +101,41 @@ void Manager::step( double timeStep )
 {
     _timeStep = _timeStepRaw = timeStep;
 
+#   ifdef FDM_LOCKSTEP
+    // raw time step is used only for statistics, replicas have to integrate
+    // exactly the same steps whatever their wall-clock timing is
+    _timeStep = FDM_TIME_STEP;
+
+    FPEnv::setDeterministic();
+#   else
     if ( _timeStep < FDM_TIME_STEP_MIN ) _timeStep = FDM_TIME_STEP_MIN;
     if ( _timeStep > FDM_TIME_STEP_MAX ) _timeStep = FDM_TIME_STEP_MAX;
+#   endif
 
     updateStateInp();
 
     if ( _stateOut == DataOut::Idle )
     {
+        // model is being built while aircraft type is still selected
+        if ( _aircraftType != _dataInpPtr->aircraftType || !_requested )
+        {
+            _builder->request( _dataInpPtr->aircraftType );
+            _requested = true;
+        }
+
         _aircraftType = _dataInpPtr->aircraftType;
     }
 
+#   ifdef FDM_ALLOC_TRACKING
+    // only steps continuing work have to be allocation-free
+    bool guarded = _stateOut == DataOut::Working && _stateInp == DataInp::Work;
+
+    UInt64 allocs_0     = AllocTracker::getCount();
+    UInt64 violations_0 = AllocTracker::getViolations();
+
+    AllocTracker::setGuarded( guarded );
+#   endif
+
     switch ( _stateInp )
     {
         case DataInp::Idle:  updateStateIdle();  break;
@@ -114,33 +146,62 @@ void Manager::step( double timeStep )
         case DataInp::Stop:  updateStateStop();  break;
     }
 
+#   ifdef FDM_ALLOC_TRACKING
+    AllocTracker::setGuarded( false );
+
+    _stepAllocs = AllocTracker::getCount() - allocs_0;
+
+    if ( AllocTracker::getViolations() != violations_0 )
+    {
+        Log::e() << "Heap allocations in working step: " << _stepAllocs << std::endl;
+    }
+#   endif
+
     _dataOutPtr->stateOut = _stateOut;
+    _dataOutPtr->timing   = _timing;
+
+    _dataOutPtr->lockstep.frame     = _frame;
+    _dataOutPtr->lockstep.stateHash = _stateHash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Manager::getStateSize() const
+{
+    return ( _fdm != FDM_NULLPTR ) ? _fdm->getStateSize() : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-FDM* Manager::createFDM( AircraftType aircraftType )
+int Manager::saveState( double *state ) const
 {
-    FDM *fdm = 0;
+    if ( _fdm != FDM_NULLPTR && _fdm->isReady() )
+    {
+        _fdm->saveState( state );
+        return FDM_SUCCESS;
+    }
+
+    return FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-    switch ( aircraftType )
+int Manager::restoreState( const double *state )
+{
+    if ( _fdm != FDM_NULLPTR )
     {
-        case DataInp::AW101: fdm = new AW101_FDM ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::C130:  fdm = new C130_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::C172:  fdm = new C172_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::F16:   fdm = new F16_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::F35A:  fdm = new F35A_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::P51:   fdm = new P51_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::PW5:   fdm = new PW5_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::R44:   fdm = new R44_FDM   ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::UH60:  fdm = new UH60_FDM  ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-#       ifdef FDM_TEST
-        case DataInp::XF:    fdm = new XF_FDM    ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-        case DataInp::XH:    fdm = new XH_FDM    ( _dataInpPtr, _dataOutPtr, _verbose ); break;
-#       endif
+        try
+        {
+            _fdm->restoreState( state );
+            return FDM_SUCCESS;
+        }
+        catch ( Exception &e )
+        {
+            Log::e() << e.getInfo() << std::endl;
+        }
     }
 
-    return fdm;
+    return FDM_FAILURE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -221,21 +282,7 @@ void Manager::updateStateInp()
 
 void Manager::updateStateIdle()
 {
-    _realTime = 0.0;
-
-    _compTimeMax  = 0.0;
-    _compTimeSum  = 0.0;
-    _compTimeSum2 = 0.0;
-
-    _timeStepMin  = DBL_MAX;
-    _timeStepMax  = 0.0;
-    _timeStepSum  = 0.0;
-    _timeStepSum2 = 0.0;
-
-    _timeSteps = 0;
-
-    _stepsLT_def = 0;
-    _stepsGT_def = 0;
+    resetTimeStepStats();
 
     WGS84::Geo pos_geo;
 
@@ -400,7 +447,19 @@ void Manager::updateStateInit()
             {
                 _stateOut = DataOut::Initializing;
 
-                _fdm = createFDM( _aircraftType );
+                Builder::Instance instance;
+
+                // output data keeps being updated until model is built
+                if ( !_builder->acquire( _aircraftType, &instance ) ) return;
+
+                _fdm   = instance.fdm;
+                _arena = instance.arena;
+
+                // the whole model is allocated from the arena
+                ArenaScope arenaScope( _arena );
+
+                _frame     = 0;
+                _stateHash = 0;
 
                 if ( _fdm != FDM_NULLPTR )
                 {
@@ -460,6 +519,10 @@ void Manager::updateStateWork()
             _realTime += _timeStep;
             _timeSteps++;
 
+#           ifdef FDM_LOCKSTEP
+            updateStateHash();
+#           endif
+
             if ( DataOut::NoCrash == _fdm->getCrash() || _fdm->isReplaying() )
             {
                 if ( _dataInpPtr->recording.mode == DataInp::Recording::Replay && !_fdm->isReplaying() )
@@ -533,13 +596,57 @@ void Manager::updateStateStop()
         printFlightEndInfo();
     }
 
-    FDM_DELPTR( _fdm );
+    // model is destroyed in the background
+    Builder::Instance instance;
+
+    instance.fdm   = _fdm;
+    instance.arena = _arena;
+
+    _builder->release( &instance );
+
+    _fdm   = FDM_NULLPTR;
+    _arena = FDM_NULLPTR;
 
     _stateOut = DataOut::Stopped;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Manager::updateStateHash()
+{
+    const Aircraft::StateVector &stateVect = _fdm->getAircraft()->getStateVect();
+
+    _frame++;
+
+    // FNV-1a over the bit patterns, so even the least significant bit
+    // difference (or -0.0 vs 0.0) between replicas changes the hash
+    UInt64 hash = 14695981039346656037ULL;
+
+    const unsigned char *frame = (const unsigned char*)&_frame;
+
+    for ( unsigned int i = 0; i < sizeof(_frame); i++ )
+    {
+        hash ^= frame[ i ];
+        hash *= 1099511628211ULL;
+    }
+
+    for ( unsigned int i = 0; i < stateVect.getSize(); i++ )
+    {
+        double value = stateVect( i );
+        const unsigned char *bytes = (const unsigned char*)&value;
+
+        for ( unsigned int j = 0; j < sizeof(value); j++ )
+        {
+            hash ^= bytes[ j ];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    _stateHash = hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Manager::updateTimeStepStats( double compTime_0 )
 {
     _timeStepMin = Misc::min( _timeStepMin, _timeStepRaw );
@@ -556,6 +663,87 @@ void Manager::updateTimeStepStats( double compTime_0 )
 
     if ( _timeStepRaw < FDM_TIME_STEP ) _stepsLT_def++;
     if ( _timeStepRaw > FDM_TIME_STEP ) _stepsGT_def++;
+
+    _compTimeHist.add( compTime );
+    _timeStepHist.add( _timeStepRaw );
+
+    FDM_METRICS_TIME( "fdm.comp_time" , compTime );
+    FDM_METRICS_TIME( "fdm.time_step" , _timeStepRaw );
+
+    const Aircraft *aircraft = _fdm->getAircraft();
+
+    for ( int i = 0; i < Aircraft::TimingCount; i++ )
+    {
+        _timingHist[ i ].add( aircraft->getTiming( (Aircraft::Timing)i ) );
+    }
+
+    _timing.compTime = compTime;
+    _timing.timeStep = _timeStepRaw;
+
+    _timing.aero       = aircraft->getTiming( Aircraft::TimingAero       );
+    _timing.ctrl       = aircraft->getTiming( Aircraft::TimingCtrl       );
+    _timing.gear       = aircraft->getTiming( Aircraft::TimingGear       );
+    _timing.mass       = aircraft->getTiming( Aircraft::TimingMass       );
+    _timing.prop       = aircraft->getTiming( Aircraft::TimingProp       );
+    _timing.integrator = aircraft->getTiming( Aircraft::TimingIntegrator );
+
+    _timing.deriv      = aircraft->getDerivTime();
+    _timing.derivCount = aircraft->getDerivCount();
+
+    _timing.compTime_max = _compTimeMax;
+    _timing.timeStep_max = _timeStepMax;
+
+    // percentiles need a pass over histogram, so they are not updated every step
+    if ( _timeSteps % _timingInterval == 1 ) updateTimingPercentiles();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::updateTimingPercentiles()
+{
+    const double percents[] = { 50.0, 99.0, 99.9 };
+
+    double values[ 3 ];
+
+    _compTimeHist.getPercentiles( percents, values, 3 );
+
+    _timing.compTime_p50  = values[ 0 ];
+    _timing.compTime_p99  = values[ 1 ];
+    _timing.compTime_p999 = values[ 2 ];
+
+    _timeStepHist.getPercentiles( percents, values, 3 );
+
+    _timing.timeStep_p50  = values[ 0 ];
+    _timing.timeStep_p99  = values[ 1 ];
+    _timing.timeStep_p999 = values[ 2 ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::resetTimeStepStats()
+{
+    _realTime = 0.0;
+
+    _compTimeMax  = 0.0;
+    _compTimeSum  = 0.0;
+    _compTimeSum2 = 0.0;
+
+    _timeStepMin  = DBL_MAX;
+    _timeStepMax  = 0.0;
+    _timeStepSum  = 0.0;
+    _timeStepSum2 = 0.0;
+
+    _timeSteps = 0;
+
+    _stepsLT_def = 0;
+    _stepsGT_def = 0;
+
+    _compTimeHist.reset();
+    _timeStepHist.reset();
+
+    for ( int i = 0; i < Aircraft::TimingCount; i++ ) _timingHist[ i ].reset();
+
+    memset( &_timing, 0, sizeof(DataOut::Timing) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -597,6 +785,24 @@ void Manager::printTimeStepStats()
     //Log::out() << "   mean_ct + 6*sigma_ct [s] : " << std::setprecision( 6 ) << ( meanComp + 6.0 * sdComp ) << " (99.99983% is less than this value)"   << std::endl;
     //Log::out() << "   mean_ts + 7*sigma_ts [s] : " << std::setprecision( 6 ) << ( meanStep + 7.0 * sdStep ) << " (99.99999905% is less than this value)" << std::endl;
     //Log::out() << "   mean_ct + 7*sigma_ct [s] : " << std::setprecision( 6 ) << ( meanComp + 7.0 * sdComp ) << " (99.99999905% is less than this value)" << std::endl;
+    updateTimingPercentiles();
+
+    Log::out() << "  Computations time p50 [s] : " << std::setprecision( 6 ) << _timing.compTime_p50  << std::endl;
+    Log::out() << "  Computations time p99 [s] : " << std::setprecision( 6 ) << _timing.compTime_p99  << std::endl;
+    Log::out() << "Computations time p99.9 [s] : " << std::setprecision( 6 ) << _timing.compTime_p999 << std::endl;
+    Log::out() << "          Time step p50 [s] : " << std::setprecision( 6 ) << _timing.timeStep_p50  << std::endl;
+    Log::out() << "          Time step p99 [s] : " << std::setprecision( 6 ) << _timing.timeStep_p99  << std::endl;
+    Log::out() << "        Time step p99.9 [s] : " << std::setprecision( 6 ) << _timing.timeStep_p999 << std::endl;
+
+    const char *names[] = { "aerodynamics", "controls", "landing gear", "mass", "propulsion", "integrator" };
+
+    for ( int i = 0; i < Aircraft::TimingCount; i++ )
+    {
+        Log::out() << "  Mean " << std::setw( 12 ) << names[ i ] << " time [s] : "
+                   << std::setprecision( 6 ) << _timingHist[ i ].getMean()
+                   << " (p99 " << _timingHist[ i ].getPercentile( 99.0 ) << ")" << std::endl;
+    }
+
     Log::out() << "            Number of steps : " << _timeSteps << std::endl;
     Log::out() << "     Steps less than " << std::setprecision( 3 ) << FDM_TIME_STEP << "s : " << _stepsLT_def << std::endl;
     Log::out() << "  Steps greater than " << std::setprecision( 3 ) << FDM_TIME_STEP << "s : " << _stepsGT_def << std::endl;
@@ -27,8 +27,13 @@
 #include <fdm/fdm_DataInp.h>
 #include <fdm/fdm_DataOut.h>
 
+#include <fdm/fdm_Builder.h>
+
 #include <fdm/main/fdm_FDM.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_Histogram.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -36,6 +41,24 @@ namespace fdm
 
 /**
  * @brief Simulation manager class.
+ *
+ * If FDM_ALLOC_TRACKING is defined, heap allocations are counted in every
+ * step, and steps made while working are guarded, so any allocation there
+ * is reported with its call stack.
+ *
+ * If FDM_LOCKSTEP is defined, wall-clock time step is ignored and model is
+ * always integrated with FDM_TIME_STEP in deterministic floating-point
+ * environment, so replicas given the same inputs stay bit-exact. Hash of
+ * the state vector is computed after every working step and might be
+ * exchanged between replicas to detect divergence.
+ *
+ * Flight dynamics model objects are built and destroyed in a background
+ * thread, so aircraft construction does not stall stepping. Manager reports
+ * Initializing state until the object is handed off.
+ *
+ * @see AllocTracker
+ * @see Builder
+ * @see FPEnv
  */
 class Manager
 {
@@ -55,7 +78,71 @@ public:
 
     inline bool getVerbose() const { return _verbose; }
 
-    inline void setVerbose( bool verbose ) { _verbose = verbose; }
+    inline void setVerbose( bool verbose ) { _verbose = verbose; _builder->setVerbose( verbose ); }
+
+    /**
+     * @brief Sets if flight dynamics model objects are built in the background.
+     * @param background specifies if objects are built in the background
+     * @see Builder::setBackground()
+     */
+    inline void setBackgroundBuild( bool background ) { _builder->setBackground( background ); }
+
+    /**
+     * @brief Sets number of recently used aircraft types kept pre-built.
+     * @param poolSize number of aircraft types (0 disables pool)
+     * @see Builder::setPoolSize()
+     */
+    inline void setPoolSize( unsigned int poolSize ) { _builder->setPoolSize( poolSize ); }
+
+    /**
+     * @brief Returns number of values needed to save state.
+     * @return number of values, 0 if there is no flight dynamics model
+     */
+    unsigned int getStateSize() const;
+
+    /**
+     * @brief Saves flight dynamics model state.
+     * @param state output array of getStateSize() values
+     * @return FDM_SUCCESS on success, FDM_FAILURE if model is not ready
+     * @see FDM::saveState()
+     */
+    int saveState( double *state ) const;
+
+    /**
+     * @brief Restores flight dynamics model state saved with saveState().
+     * @param state array of getStateSize() values
+     * @return FDM_SUCCESS on success, FDM_FAILURE on failure
+     * @see FDM::restoreState()
+     */
+    int restoreState( const double *state );
+
+    /** @return step timing data (also exported through output data) */
+    inline const DataOut::Timing& getTiming() const { return _timing; }
+
+    /** @return computations time histogram */
+    inline const Histogram& getCompTimeHistogram() const { return _compTimeHist; }
+
+    /** @return raw time step histogram */
+    inline const Histogram& getTimeStepHistogram() const { return _timeStepHist; }
+
+    /**
+     * @brief Returns computations time histogram of the given part.
+     * @param timing computations time breakdown item
+     * @return computations time histogram
+     */
+    inline const Histogram& getTimingHistogram( Aircraft::Timing timing ) const
+    {
+        return _timingHist[ timing ];
+    }
+
+    /** @return number of heap allocations in the last step (counted only if FDM_ALLOC_TRACKING is defined) */
+    inline UInt64 getStepAllocs() const { return _stepAllocs; }
+
+    /** @return number of working steps since initialization (counted only if FDM_LOCKSTEP is defined) */
+    inline UInt64 getFrame() const { return _frame; }
+
+    /** @return state hash of the last working step (computed only if FDM_LOCKSTEP is defined) */
+    inline UInt64 getStateHash() const { return _stateHash; }
 
 private:
 
@@ -69,6 +156,10 @@ private:
 
     FDM *_fdm;                      ///< flight dynamics model object
 
+    Arena *_arena;                  ///< flight dynamics model memory arena
+
+    Builder *_builder;              ///< flight dynamics model background builder
+
     AircraftType _aircraftType;     ///< aircraft type
 
     StateInp _stateInp;             ///< internal state input
@@ -91,14 +182,22 @@ private:
     unsigned int _stepsLT_def;      ///< number of steps less than default time step
     unsigned int _stepsGT_def;      ///< number of steps greater than default time step
 
-    bool _verbose;                  ///< specifies if extra information should be printed
+    static const unsigned int _timingInterval;  ///< number of steps between percentiles updates
 
-    /**
-     * @brief Creates flight dynamics model object.
-     * @param aircraftType aircraft type
-     * @return aircraft object on success null pointer on failure
-     */
-    FDM* createFDM( AircraftType aircraftType );
+    Histogram _compTimeHist;        ///< computations time histogram
+    Histogram _timeStepHist;        ///< raw time step histogram
+
+    Histogram _timingHist[ Aircraft::TimingCount ]; ///< computations time breakdown histograms
+
+    DataOut::Timing _timing;        ///< step timing data
+
+    UInt64 _stepAllocs;             ///< number of heap allocations in the last step
+
+    UInt64 _frame;                  ///< number of working steps since initialization
+    UInt64 _stateHash;              ///< state hash of the last working step
+
+    bool _requested;                ///< specifies if building model of the selected aircraft type has been requested
+    bool _verbose;                  ///< specifies if extra information should be printed
 
     /**
      * @brief Updates internal state input.
@@ -111,7 +210,14 @@ private:
     void updateStatePause();
     void updateStateStop();
 
+    /**
+     * @brief Updates frame number and state hash.
+     */
+    void updateStateHash();
+
     void updateTimeStepStats( double compTime_0 );
+    void updateTimingPercentiles();
+    void resetTimeStepStats();
 
     void printFlightEndInfo();
     void printState();
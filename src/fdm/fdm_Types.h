@@ -39,10 +39,12 @@ namespace fdm
 typedef uint8_t        UInt8;   ///< 8-bits unsigned integer type
 typedef uint16_t       UInt16;  ///< 16-bits unsigned integer type
 typedef uint32_t       UInt32;  ///< 32-bits unsigned integer type
+typedef uint64_t       UInt64;  ///< 64-bits unsigned integer type
 #else
 typedef unsigned char  UInt8;   ///< 8-bits unsigned integer type
 typedef unsigned short UInt16;  ///< 16-bits unsigned integer type
 typedef unsigned int   UInt32;  ///< 32-bits unsigned integer type
+typedef unsigned long long UInt64;  ///< 64-bits unsigned integer type
 #endif
 
 } // end of fdm namespace
@@ -187,3 +187,21 @@ void Aerodynamics::updateMatrices()
     _bas2aero = _aero2bas.getTransposed();
     _bas2stab = _stab2bas.getTransposed();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aerodynamics::archiveState( StateArchive *archive )
+{
+    Module::archiveState( archive );
+
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_for_aero );
+    archive->add( &_mom_stab );
+
+    archive->add( &_aero2bas );
+    archive->add( &_stab2bas );
+    archive->add( &_bas2aero );
+    archive->add( &_bas2stab );
+}
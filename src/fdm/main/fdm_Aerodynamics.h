@@ -138,6 +138,12 @@ public:
     /** @brief Updates aerodynamics. */
     virtual void update();
 
+    /**
+     * @brief Archives module internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -24,7 +24,8 @@
 
 #include <cstring>
 
-#include <fdm/utils/fdm_GaussJordan.h>
+#include <fdm/utils/fdm_Profiler.h>
+#include <fdm/utils/fdm_String.h>
 
 
 #include <fdm/xml/fdm_XmlDoc.h>
@@ -36,6 +37,39 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+/**
+ * @brief Reads module update divisor attribute.
+ * Missing attribute means module is updated every time step.
+ * @param node module XML node
+ * @param divisor result update divisor
+ * @return FDM_SUCCESS on success or FDM_FAILURE if value is not positive
+ */
+int readUpdateDivisor( const XmlNode &node, UInt32 *divisor )
+{
+    std::string str = node.getAttribute( "update_divisor" );
+
+    if ( str.length() == 0 )
+    {
+        (*divisor) = 1;
+        return FDM_SUCCESS;
+    }
+
+    int value = String::toInt( str, 0 );
+
+    if ( value < 1 ) return FDM_FAILURE;
+
+    (*divisor) = value;
+
+    return FDM_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 const UInt8 Aircraft::_i_x  = 0;
 const UInt8 Aircraft::_i_y  = 1;
 const UInt8 Aircraft::_i_z  = 2;
@@ -50,6 +84,42 @@ const UInt8 Aircraft::_i_p  = 10;
 const UInt8 Aircraft::_i_q  = 11;
 const UInt8 Aircraft::_i_r  = 12;
 
+const double Aircraft::_cp_margin = 100.0;
+const double Aircraft::_lin_step = 1.0e-7;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::computeStateMatrix( Aircraft *const *aircrafts, unsigned int count,
+                                  const StateVector &stateVect,
+                                  StateMatrix *stateMatrix,
+                                  WorkerPool *pool )
+{
+    if ( count == 0 ) return;
+
+    // columns are interleaved among instances, each instance is used
+    // by a single task only so no aircraft is shared between threads
+    WorkerPool::Task task = [ aircrafts, count, &stateVect, stateMatrix ]( unsigned int i )
+    {
+        for ( unsigned int j = i; j < FDM_STATE_DIMENSION; j += count )
+        {
+            aircrafts[ i ]->computeStateMatrixColumn( stateVect, j, stateMatrix );
+        }
+
+        // restoring instance variables
+        aircrafts[ i ]->computeStateDeriv( aircrafts[ i ]->_stateVect,
+                                           &aircrafts[ i ]->_derivVect );
+    };
+
+    if ( pool && count > 1 )
+    {
+        pool->run( count, task );
+    }
+    else
+    {
+        for ( unsigned int i = 0; i < count; i++ ) task( i );
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Aircraft::Aircraft( Input *input ) :
@@ -77,6 +147,8 @@ Aircraft::Aircraft( Input *input ) :
 
     _integrator ( FDM_NULLPTR ),
 
+    _integrationMethod ( RK4 ),
+
     _timeStep ( 0.0 ),
 
     _crash ( DataOut::NoCrash ),
@@ -84,6 +156,11 @@ Aircraft::Aircraft( Input *input ) :
     _initPropState ( Stopped ),
 
     _cp_index ( 0 ),
+    _cp_radius ( 0.0 ),
+
+#   ifdef FDM_UNCHECKED
+    _nanCheckStep ( 0 ),
+#   endif
 
     _elevation     ( 0.0 ),
     _altitude_asl  ( 0.0 ),
@@ -108,12 +185,17 @@ Aircraft::Aircraft( Input *input ) :
 
     _freeze_position ( false ),
     _freeze_attitude ( false ),
-    _freeze_velocity ( false )
+    _freeze_velocity ( false ),
+
+    _derivTime  ( 0.0 ),
+    _derivCount ( 0 )
 {
+    for ( int i = 0; i < TimingCount; i++ ) _timing[ i ] = 0.0;
+
     _envir = new Environment();
     _isect = new Intersections();
 
-    _integrator = new Aircraft::Integrator( this, &Aircraft::computeStateDeriv );
+    _integrator = new RungeKutta4< Aircraft >( this, &Aircraft::computeStateDeriv );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -147,8 +229,15 @@ void Aircraft::update( double timeStep, bool integrate )
 {
     _timeStep = timeStep;
 
+    for ( int i = 0; i < TimingCount; i++ ) _timing[ i ] = 0.0;
+
+    _derivTime  = 0.0;
+    _derivCount = 0;
+
     try
     {
+        double t_0 = Time::get();
+
         anteIntegration();
 
         if ( integrate )
@@ -156,8 +245,16 @@ void Aircraft::update( double timeStep, bool integrate )
             /////////////////////////////////////////////////
             _integrator->integrate( _timeStep, &_stateVect );
             /////////////////////////////////////////////////
+
+            // moving platforms are placed at the integrated state time
+            _isect->step( _timeStep );
         }
 
+        // everything which is not due to modules
+        double modules = 0.0;
+        for ( int i = 0; i < TimingIntegrator; i++ ) modules += _timing[ i ];
+        _timing[ TimingIntegrator ] = Time::get() - t_0 - modules;
+
         postIntegration();
     }
     catch ( Exception &catched )
@@ -185,6 +282,100 @@ void Aircraft::setStateVector( const StateVector &stateVector )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Aircraft::archiveState( StateArchive *archive )
+{
+    archive->add( &_stateVect );
+    archive->add( &_statePrev );
+    archive->add( &_derivVect );
+
+    _envir->archiveState( archive );
+
+    if ( archive->isRestoring() ) updateVariables( _stateVect, _derivVect );
+
+    // values depending on the intersections history are restored over
+    // those computed from the state vector
+    archive->add( &_ground_wgs );
+    archive->add( &_ground_bas );
+
+    archive->add( &_normal_wgs );
+    archive->add( &_normal_bas );
+
+    archive->add( &_elevation );
+    archive->add( &_altitude_agl );
+
+    archive->add( &_turnRate );
+    archive->add( &_headingPrev );
+
+    archive->addEnum( &_crash );
+
+    archive->add( &_cp_index );
+
+#   ifdef FDM_UNCHECKED
+    archive->add( &_nanCheckStep );
+#   endif
+
+    _isect->archiveState( archive );
+
+    _aero->archiveState( archive );
+    _ctrl->archiveState( archive );
+    _gear->archiveState( archive );
+    _mass->archiveState( archive );
+    _prop->archiveState( archive );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::computeStateMatrix( const StateVector &stateVect,
+                                  StateMatrix *stateMatrix )
+{
+    Aircraft *aircraft = this;
+    computeStateMatrix( &aircraft, 1, stateVect, stateMatrix );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::setIntegrationMethod( IntegrationMethod method, double tolerance )
+{
+    FDM_DELPTR( _integrator );
+
+    _integrationMethod = method;
+
+    switch ( _integrationMethod )
+    {
+    case RK45:
+        {
+            DormandPrince45< Aircraft > *integrator =
+                    new DormandPrince45< Aircraft >( this, &Aircraft::computeStateDeriv );
+
+            integrator->setTolerance( tolerance );
+
+            _integrator = integrator;
+        }
+        break;
+
+    case EulerSI:
+        _integrator = new EulerSemiImplicit< Aircraft >( this,
+                                                         &Aircraft::computeStateDeriv,
+                                                         &Aircraft::computeKinematicsDeriv,
+                                                         _i_u );
+        break;
+
+    case RK4MK:
+        _integrator = new RungeKuttaMuntheKaas4< Aircraft >( this,
+                                                             &Aircraft::computeStateDeriv,
+                                                             _i_e0 );
+        break;
+
+    case RK4:
+    default:
+        _integrationMethod = RK4;
+        _integrator = new RungeKutta4< Aircraft >( this, &Aircraft::computeStateDeriv );
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Aircraft::readFile( const char *dataFile )
 {
     XmlDoc doc( dataFile );
@@ -242,6 +433,7 @@ void Aircraft::readData( XmlNode &dataNode )
                 if ( result == FDM_SUCCESS )
                 {
                     _cp.push_back( collision_point );
+                    _cp_radius = Misc::max( _cp_radius, collision_point.getLength() );
                     nodeCollisionPoint = nodeCollisionPoint.getNextSiblingElement( "collision_point" );
                 }
             }
@@ -258,6 +450,27 @@ void Aircraft::readData( XmlNode &dataNode )
         // pilot position
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_pos_pilot_bas, "pilot_position" );
 
+        // integrator
+        XmlNode nodeIntegrator = dataNode.getFirstChildElement( "integrator" );
+
+        if ( result == FDM_SUCCESS && nodeIntegrator.isValid() )
+        {
+            std::string type = String::toLower( nodeIntegrator.getAttribute( "type" ) );
+
+            double tolerance = 1.0e-6;
+
+            result = XmlUtils::read( nodeIntegrator, &tolerance, "tolerance", true );
+
+            if ( result == FDM_SUCCESS )
+            {
+                if      ( type == "rk4"      ) setIntegrationMethod( RK4 );
+                else if ( type == "rk45"     ) setIntegrationMethod( RK45, tolerance );
+                else if ( type == "euler_si" ) setIntegrationMethod( EulerSI );
+                else if ( type == "rk4_mk"   ) setIntegrationMethod( RK4MK );
+                else result = FDM_FAILURE;
+            }
+        }
+
         if ( result != FDM_SUCCESS )
         {
             XmlUtils::throwError( __FILE__, __LINE__, dataNode );
@@ -275,6 +488,27 @@ void Aircraft::readData( XmlNode &dataNode )
             _gear->readData( nodeGear );
             _mass->readData( nodeMass );
             _prop->readData( nodeProp );
+
+            // modules update rates
+            UInt32 divisorAero = 1;
+            UInt32 divisorCtrl = 1;
+            UInt32 divisorGear = 1;
+            UInt32 divisorMass = 1;
+            UInt32 divisorProp = 1;
+
+            if ( result == FDM_SUCCESS ) result = readUpdateDivisor( nodeAero, &divisorAero );
+            if ( result == FDM_SUCCESS ) result = readUpdateDivisor( nodeCtrl, &divisorCtrl );
+            if ( result == FDM_SUCCESS ) result = readUpdateDivisor( nodeGear, &divisorGear );
+            if ( result == FDM_SUCCESS ) result = readUpdateDivisor( nodeMass, &divisorMass );
+            if ( result == FDM_SUCCESS ) result = readUpdateDivisor( nodeProp, &divisorProp );
+
+            if ( result != FDM_SUCCESS ) XmlUtils::throwError( __FILE__, __LINE__, dataNode );
+
+            _aero->setUpdateDivisor( divisorAero );
+            _ctrl->setUpdateDivisor( divisorCtrl );
+            _gear->setUpdateDivisor( divisorGear );
+            _mass->setUpdateDivisor( divisorMass );
+            _prop->setUpdateDivisor( divisorProp );
         }
     }
     else
@@ -287,13 +521,18 @@ void Aircraft::readData( XmlNode &dataNode )
 
 void Aircraft::anteIntegration()
 {
+    // turbulence is advanced once per time step, not per derivatives evaluation
+    _envir->updateTurbulence( _airspeed * _timeStep, _altitude_agl );
+
     updateVariables( _stateVect, _derivVect );
 
-    _aero->update();
-    _ctrl->update();
-    _gear->update();
-    _mass->update();
-    _prop->update();
+    double t = Time::get();
+
+    _aero->updateScheduled( _timeStep ); t = addTiming( TimingAero, t );
+    _ctrl->updateScheduled( _timeStep ); t = addTiming( TimingCtrl, t );
+    _gear->updateScheduled( _timeStep ); t = addTiming( TimingGear, t );
+    _mass->updateScheduled( _timeStep ); t = addTiming( TimingMass, t );
+    _prop->updateScheduled( _timeStep ); addTiming( TimingProp, t );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -307,7 +546,16 @@ void Aircraft::postIntegration()
     _stateVect( _i_ey ) = _att_wgs.ey();
     _stateVect( _i_ez ) = _att_wgs.ez();
 
+#   ifdef FDM_UNCHECKED
+    // NaN propagates through the state vector, so it is still detected by
+    // checks done every FDM_NAN_CHECK_STEPS steps only
+    bool check = ++_nanCheckStep >= FDM_NAN_CHECK_STEPS;
+    if ( check ) _nanCheckStep = 0;
+
+    if ( !check || _stateVect.isValid() )
+#   else
     if ( _stateVect.isValid() )
+#   endif
     {
         if ( _timeStep > 1.0e-9 )
         {
@@ -337,8 +585,13 @@ void Aircraft::postIntegration()
 
 void Aircraft::detectCrash()
 {
+    // collision points bounding sphere clearly above the local ground plane
+    // means no collision is possible, so scenery queries are skipped
+    double height = _normal_wgs * ( _pos_wgs - _ground_wgs );
+    bool airborne = height > _cp_radius + _cp_margin;
+
     // detect collisions
-    if ( _crash == DataOut::NoCrash )
+    if ( _crash == DataOut::NoCrash && !airborne )
     {
         if ( _isect->isIntersection( _pos_wgs, _pos_wgs + _bas2wgs * _cp.at( _cp_index ), true ) )
         {
@@ -365,7 +618,7 @@ void Aircraft::detectCrash()
         double weight_inv = 1.0 / ( _mass->getMass() * WGS84::_g );
 
         double load_factor_aero = _aero->getFor_BAS().getLength() * weight_inv;
-        double load_factor_gear = _gear->getFor_BAS().getLength() * weight_inv;
+        double load_factor_gear = _gear->isRetired() ? 0.0 : _gear->getFor_BAS().getLength() * weight_inv;
 
         if ( load_factor_aero > _load_aero_max
           || load_factor_aero < _load_aero_min
@@ -378,26 +631,48 @@ void Aircraft::detectCrash()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Aircraft::computeStateMatrixColumn( const StateVector &stateVect,
+                                        unsigned int column,
+                                        StateMatrix *stateMatrix )
+{
+    StateVector x( stateVect );
+    StateVector f_p( FDM_STATE_DIMENSION );
+    StateVector f_m( FDM_STATE_DIMENSION );
+
+    // derivative of the state vector is used only as a previous value
+    f_p = _derivVect;
+    f_m = _derivVect;
+
+    double dx = _lin_step * Misc::max( 1.0, fabs( stateVect( column ) ) );
+
+    x( column ) = stateVect( column ) + dx;
+    computeStateDeriv( x, &f_p );
+
+    x( column ) = stateVect( column ) - dx;
+    computeStateDeriv( x, &f_m );
+
+    for ( unsigned int i = 0; i < FDM_STATE_DIMENSION; i++ )
+    {
+        (*stateMatrix)( i, column ) = ( f_p( i ) - f_m( i ) ) / ( 2.0 * dx );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Aircraft::computeStateDeriv( const StateVector &stateVect,
                                   StateVector *derivVect )
 {
+    FDM_PROFILE_FUNCTION();
+
+    double t_deriv = Time::get();
+
     updateVariables( stateVect, *derivVect );
 
     // computing forces and moments
-    _aero->computeForceAndMoment();
-    _gear->computeForceAndMoment();
-    _mass->computeForceAndMoment();
-    _prop->computeForceAndMoment();
+    Vector3 for_bas;
+    Vector3 mom_bas;
 
-    Vector3 for_bas = _aero->getFor_BAS()
-                    + _mass->getFor_BAS()
-                    + _gear->getFor_BAS()
-                    + _prop->getFor_BAS();
-
-    Vector3 mom_bas = _aero->getMom_BAS()
-                    + _mass->getMom_BAS()
-                    + _gear->getMom_BAS()
-                    + _prop->getMom_BAS();
+    computeForceAndMoment( &for_bas, &mom_bas );
 
     // computing position derivatives
     Vector3 pos_dot_wgs = _bas2wgs * _vel_bas;
@@ -449,23 +724,10 @@ void Aircraft::computeStateDeriv( const StateVector &stateVect,
     // right-hand-side moment vector
     Vector3 mom_rhs = mom_bas - ( _vel_bas % p_bas ) - ( _omg_bas % h_bas );
 
-    // right-hand-side combined vector
-    Vector6 vec_rhs;
-
-    vec_rhs( 0 ) = for_rhs.x();
-    vec_rhs( 1 ) = for_rhs.y();
-    vec_rhs( 2 ) = for_rhs.z();
-    vec_rhs( 3 ) = mom_rhs.x();
-    vec_rhs( 4 ) = mom_rhs.y();
-    vec_rhs( 5 ) = mom_rhs.z();
-
-    // inertia matrix
-    Matrix6x6 mi_bas = _mass->getInertiaMatrix();
-
     // state derivatives (results)
     Vector6 acc_bas;
 
-    GaussJordan< 6 >::solve( mi_bas, vec_rhs, &acc_bas );
+    _mass->solveAccelerations( for_rhs, mom_rhs, &acc_bas );
 
     // Coriolis effect due to Earth rotation
     Vector3 acc_coriolis_bas = -2.0 * ( _wgs2bas * ( WGS84::getOmega_WGS() % _vel_bas ) );
@@ -489,6 +751,69 @@ void Aircraft::computeStateDeriv( const StateVector &stateVect,
             (*derivVect)( i ) = 0.0;
         }
     }
+
+    _derivCount++;
+    _derivTime += Time::get() - t_deriv;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas )
+{
+    sumForceAndMoment( _aero, _gear, _mass, _prop, for_bas, mom_bas );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircraft::computeKinematicsDeriv( const StateVector &stateVect,
+                                       StateVector *derivVect )
+{
+    Quaternion att_wgs( stateVect( _i_e0 ),
+                        stateVect( _i_ex ),
+                        stateVect( _i_ey ),
+                        stateVect( _i_ez ) );
+
+    Vector3 vel_bas( stateVect( _i_u ),
+                     stateVect( _i_v ),
+                     stateVect( _i_w ) );
+
+    Vector3 omg_bas( stateVect( _i_p ),
+                     stateVect( _i_q ),
+                     stateVect( _i_r ) );
+
+    // computing position derivatives
+    Vector3 pos_dot_wgs = Matrix3x3( att_wgs ).getTransposed() * vel_bas;
+
+    if ( !_freeze_position )
+    {
+        (*derivVect)( _i_x ) = pos_dot_wgs.x();
+        (*derivVect)( _i_y ) = pos_dot_wgs.y();
+        (*derivVect)( _i_z ) = pos_dot_wgs.z();
+    }
+    else
+    {
+        (*derivVect)( _i_x ) = 0.0;
+        (*derivVect)( _i_y ) = 0.0;
+        (*derivVect)( _i_z ) = 0.0;
+    }
+
+    // computing attitude derivatives
+    Quaternion att_dot_wgs = att_wgs.getDerivative( omg_bas, 2.0 * FDM_TIME_STEP );
+
+    if ( !_freeze_attitude )
+    {
+        (*derivVect)( _i_e0 ) = att_dot_wgs.e0();
+        (*derivVect)( _i_ex ) = att_dot_wgs.ex();
+        (*derivVect)( _i_ey ) = att_dot_wgs.ey();
+        (*derivVect)( _i_ez ) = att_dot_wgs.ez();
+    }
+    else
+    {
+        (*derivVect)( _i_e0 ) = 0.0;
+        (*derivVect)( _i_ex ) = 0.0;
+        (*derivVect)( _i_ey ) = 0.0;
+        (*derivVect)( _i_ez ) = 0.0;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -516,7 +841,8 @@ void Aircraft::updateVariables( const StateVector &stateVect,
     _wgs.setPos_WGS( _pos_wgs );
 
     _envir->update( _wgs.getPos_Geo().alt );
-    _isect->update( _wgs.getPos_Geo().lat, _wgs.getPos_Geo().lon );
+    // velocity from the previous step is accurate enough for prediction
+    _isect->update( _wgs.getPos_Geo().lat, _wgs.getPos_Geo().lon, _vel_ned );
 
     _wgs2bas = Matrix3x3( _att_wgs );
     _wgs2ned = Matrix3x3( _wgs.getWGS2NED() );
@@ -530,7 +856,8 @@ void Aircraft::updateVariables( const StateVector &stateVect,
 
     _vel_ned = _bas2ned * _vel_bas;
 
-    _vel_air_bas = _vel_bas - _ned2bas * _envir->getWind_NED();
+    _vel_air_bas = _vel_bas - _ned2bas * _envir->getWind_NED( _pos_wgs, &_windBracket )
+                 - _envir->getTurb_BAS();
     _omg_air_bas = _omg_bas;
 
     _acc_bas.u() = derivVect( _i_u );
@@ -40,8 +40,15 @@
 #include <fdm/main/fdm_Mass.h>
 #include <fdm/main/fdm_Propulsion.h>
 
+#include <fdm/utils/fdm_DormandPrince45.h>
+#include <fdm/utils/fdm_EulerSemiImplicit.h>
+#include <fdm/utils/fdm_Matrix.h>
 #include <fdm/utils/fdm_RungeKutta4.h>
+#include <fdm/utils/fdm_RungeKuttaMuntheKaas4.h>
+#include <fdm/utils/fdm_StateArchive.h>
+#include <fdm/utils/fdm_Time.h>
 #include <fdm/utils/fdm_WGS84.h>
+#include <fdm/utils/fdm_WorkerPool.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -104,24 +111,39 @@ namespace fdm
  *     <load_gear_max> { [-] maximum absolute load factor due to landing gear (exceeding this value causes crash) } </load_gear_max>
  *   </limitations>
  *   <pilot_position> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </pilot_position>
- *   <aerodynamics>
+ *   [<integrator type="{ rk4 | rk45 | euler_si }">
+ *     [<tolerance> { [-] error tolerance (rk45 only) } </tolerance>]
+ *   </integrator>]
+ *   <aerodynamics [update_divisor="{ divisor }"]>
  *     { aerodynamics data }
  *   </aerodynamics>
- *   <controls>
+ *   <controls [update_divisor="{ divisor }"]>
  *     { controls data }
  *   </controls>
- *   <landing_gear>
+ *   <landing_gear [update_divisor="{ divisor }"]>
  *     { landing gear data }
  *   </landing_gear>
- *   <mass>
+ *   <mass [update_divisor="{ divisor }"]>
  *     { mass data }
  *   </mass>
- *   <propulsion>
+ *   <propulsion [update_divisor="{ divisor }"]>
  *     { propulsion data }
  *   </propulsion>
  * </fdm>
  * @endcode
  *
+ * Optional integrator element selects numerical integration method:
+ * rk4 - Runge-Kutta 4th order (default), 4 derivatives evaluations per step,
+ * rk45 - adaptive Dormand-Prince 5(4) with error control,
+ * euler_si - semi-implicit Euler, 1 derivatives evaluation per step, meant
+ * for benign regimes (e.g. ground taxi) and batch runs.
+ *
+ * Optional update_divisor attribute specifies every which simulation step
+ * module is updated (default 1, every step), e.g. slowly changing mass can
+ * be updated every 20th step. Forces and moments are still computed at
+ * integration rate.
+ *
+ * @see fdm::Module
  * @see Taylor J.: Classical Mechanics, 2005
  * @see Osinski Z.: Mechanika ogolna, 1997, [in Polish]
  * @see Allerton D.: Principles of Flight Simulation, 2009
@@ -140,6 +162,29 @@ public:
     typedef std::vector< Vector3 > CollisionPoints; ///< collision points
     typedef VectorN StateVector;                    ///< state vector
 
+    typedef Matrix< FDM_STATE_DIMENSION, FDM_STATE_DIMENSION > StateMatrix; ///< linearized model state matrix
+
+    /** Integration method enum. */
+    enum IntegrationMethod
+    {
+        RK4     = 0,    ///< Runge-Kutta 4th order
+        RK45    = 1,    ///< adaptive Dormand-Prince 5(4)
+        EulerSI = 2,    ///< semi-implicit Euler
+        RK4MK   = 3     ///< Runge-Kutta-Munthe-Kaas 4th order, attitude propagated by exponential map
+    };
+
+    /** Computations time breakdown enum. */
+    enum Timing
+    {
+        TimingAero = 0,     ///< aerodynamics
+        TimingCtrl,         ///< controls
+        TimingGear,         ///< landing gear
+        TimingMass,         ///< mass
+        TimingProp,         ///< propulsion
+        TimingIntegrator,   ///< integrator and state variables update
+        TimingCount         ///< number of timing items
+    };
+
     /** Propuslion state enum. */
     enum PropState
     {
@@ -161,6 +206,28 @@ public:
     static const UInt8 _i_q;    ///< index of aircraft angular velocity y-coordinate expressed in BAS axis system
     static const UInt8 _i_r;    ///< index of aircraft angular velocity z-coordinate expressed in BAS axis system
 
+    static const double _cp_margin; ///< [m] terrain relief margin above collision points bounding sphere
+    static const double _lin_step;  ///< relative state perturbation used for linearization
+
+    /**
+     * @brief Computes state matrix A = df/dx of the aircraft model linearized
+     * about given state (e.g. trim point) using central differences.
+     * Columns of the matrix are split among given aircraft instances, which
+     * are evaluated in parallel with the given worker pool. All instances
+     * have to be independent (separate inputs, environment and intersections)
+     * and identically configured models of the same aircraft. Every instance
+     * state vector derivative is re-evaluated at its own state afterwards.
+     * @param aircrafts aircraft instances
+     * @param count number of aircraft instances
+     * @param stateVect state vector about which model is linearized
+     * @param stateMatrix resulting state matrix
+     * @param pool worker pool (might be null, instances are evaluated serially then)
+     */
+    static void computeStateMatrix( Aircraft *const *aircrafts, unsigned int count,
+                                    const StateVector &stateVect,
+                                    StateMatrix *stateMatrix,
+                                    WorkerPool *pool = FDM_NULLPTR );
+
     /**
      * @brief Class destructor.
      * @param input
@@ -204,6 +271,19 @@ public:
 
     inline double getTimeStep() const { return _timeStep; }
 
+    /**
+     * @brief Returns computations time of the given part in the last step.
+     * @param timing computations time breakdown item
+     * @return [s] computations time
+     */
+    inline double getTiming( Timing timing ) const { return _timing[ timing ]; }
+
+    /** @brief Returns state derivative computations time in the last step. */
+    inline double getDerivTime() const { return _derivTime; }
+
+    /** @brief Returns number of state derivative evaluations in the last step. */
+    inline unsigned int getDerivCount() const { return _derivCount; }
+
     inline const Vector3&    getPos_WGS() const { return _pos_wgs; }
     inline const Quaternion& getAtt_WGS() const { return _att_wgs; }
     inline const Vector3&    getVel_BAS() const { return _vel_bas; }
@@ -226,6 +306,19 @@ public:
     inline const Vector3& getVel_air_BAS() const { return _vel_air_bas; }
     inline const Vector3& getOmg_air_BAS() const { return _omg_air_bas; }
 
+    /**
+     * @brief Returns wind at the given point of the aircraft.
+     * Modules sampling wind at their own points (e.g. landing gear units,
+     * rotor hub, tail surfaces) should keep their own brackets.
+     * @param pos_bas [m] point position expressed in BAS
+     * @param bracket point cached wind field cell (might be null)
+     * @return [m/s] wind velocity expressed in BAS
+     */
+    inline Vector3 getWind_BAS( const Vector3 &pos_bas, WindField::Bracket *bracket ) const
+    {
+        return _ned2bas * _envir->getWind_NED( _pos_wgs + _bas2wgs * pos_bas, bracket );
+    }
+
     inline const Vector3& getAcc_BAS() const { return _acc_bas; }
     inline const Vector3& getEps_BAS() const { return _eps_bas; }
 
@@ -273,33 +366,43 @@ public:
      */
     virtual void setStateVector( const StateVector &stateVector );
 
-    inline void setFreezePosition( bool freeze_position ) { _freeze_position = freeze_position; }
-    inline void setFreezeAttitude( bool freeze_attitude ) { _freeze_attitude = freeze_attitude; }
-    inline void setFreezeVelocity( bool freeze_velocity ) { _freeze_velocity = freeze_velocity; }
+    /**
+     * @brief Archives aircraft state (state vector, its derivative, values
+     * kept between steps, environment, intersections and modules internal
+     * states).
+     * Variables are computed from the restored state vector, so restoring
+     * gives the same subsequent steps as those which followed saving.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
 
-protected:
+    /**
+     * @brief Sets numerical integration method.
+     * @param method integration method
+     * @param tolerance error tolerance (adaptive methods only)
+     */
+    virtual void setIntegrationMethod( IntegrationMethod method,
+                                       double tolerance = 1.0e-6 );
 
     /**
-     * @brief Integrator wrapping class.
-     * fdm::Aircraft::computeStateDeriv(const StateVector &,StateVector &)
-     * is right-hand-side function for integration procedure.
-     * Because fdm::Aircraft::computeStateDeriv(const StateVector &,StateVector &)
-     * is private fdm::Aircraft::Integrator is declared friend class for the
-     * fdm::Aircraft class.
-     * fdm::Aircraft::Integrator is declared private due to friendship with
-     * the fdm::Aircraft to avoid possible access issues.
-     * Because it is used entirely inside fdm::Aircraft, there is no need
-     * to make it public.
+     * @brief Computes state matrix of the aircraft model linearized about
+     * given state using this instance only.
+     * @param stateVect state vector about which model is linearized
+     * @param stateMatrix resulting state matrix
+     * @see computeStateMatrix( Aircraft *const*, unsigned int, const StateVector&, StateMatrix*, WorkerPool* )
      */
-    class Integrator : public RungeKutta4< Aircraft >
-    {
-    public:
+    void computeStateMatrix( const StateVector &stateVect,
+                             StateMatrix *stateMatrix );
 
-        Integrator( Aircraft *obj, void (Aircraft::*fun)(const StateVector &, StateVector *) ) :
-            RungeKutta4( obj, fun ) {}
-    };
+    inline IntegrationMethod getIntegrationMethod() const { return _integrationMethod; }
+
+    inline void setFreezePosition( bool freeze_position ) { _freeze_position = freeze_position; }
+    inline void setFreezeAttitude( bool freeze_attitude ) { _freeze_attitude = freeze_attitude; }
+    inline void setFreezeVelocity( bool freeze_velocity ) { _freeze_velocity = freeze_velocity; }
+
+protected:
 
-    friend class Aircraft::Integrator;
+    typedef fdm::Integrator< Aircraft > Integrator;   ///< integrator base type
 
     Input *_input;              ///< input data tree root node
 
@@ -325,8 +428,12 @@ protected:
     StateVector _statePrev;     ///< aircraft state vector (previous)
     StateVector _derivVect;     ///< aircraft state vector derivative (for output purposes only)
 
+    double _timing[ TimingCount ];  ///< [s] computations time breakdown of the last step
+
     Integrator *_integrator;    ///< integration procedure object
 
+    IntegrationMethod _integrationMethod;   ///< numerical integration method
+
     double _timeStep;           ///< [s] simulation time step
 
     Vector3    _pos_wgs;        ///< [m] aircraft position expressed in WGS
@@ -351,6 +458,8 @@ protected:
     Vector3 _vel_air_bas;       ///< [m/s] aircraft linear velocity vector relative to the air expressed in BAS
     Vector3 _omg_air_bas;       ///< [rad/s] aircraft angular velocity relative to the air expressed in BAS
 
+    WindField::Bracket _windBracket;    ///< center of mass wind field cached cell
+
     Vector3 _acc_bas;           ///< [m/s^2] aircraft linear acceleration vector expressed in BAS
     Vector3 _eps_bas;           ///< [rad/s^2] aircraft angular acceleration vector expressed in BAS
 
@@ -371,6 +480,11 @@ protected:
     PropState _initPropState;   ///< initial propulsion state
 
     UInt32 _cp_index;           ///< current collision point index
+    double _cp_radius;          ///< [m] collision points bounding sphere radius
+
+#   ifdef FDM_UNCHECKED
+    UInt32 _nanCheckStep;       ///< number of steps since the last state vector NaN check
+#   endif
 
     double _elevation;          ///< [m] ground elevation above mean sea level
     double _altitude_asl;       ///< [m] altitude above sea level
@@ -397,6 +511,9 @@ protected:
     bool _freeze_attitude;      ///< specifies if attitude is to be frozen (is not integrating)
     bool _freeze_velocity;      ///< specifies if velocity is to be frozen (is not integrating)
 
+    double _derivTime;          ///< [s] state derivative computations time in the last step
+    unsigned int _derivCount;   ///< number of state derivative evaluations in the last step
+
     /**
      * @brief Reads data.
      * @param dataFile XML data file path
@@ -426,6 +543,74 @@ protected:
     virtual void computeStateDeriv( const StateVector &stateVect,
                                     StateVector *derivVect );
 
+    /**
+     * @brief Computes total force and moment of all modules.
+     * Default implementation calls modules through base classes pointers.
+     * Concrete aircraft classes override it calling sumForceAndMoment()
+     * with their own final modules classes, so modules functions are
+     * dispatched statically and can be inlined.
+     * @param for_bas [N] resulting total force vector expressed in BAS
+     * @param mom_bas [N*m] resulting total moment vector expressed in BAS
+     */
+    virtual void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
+
+    /**
+     * @brief Computes and sums force and moment of the given modules.
+     * Retired modules are dropped entirely.
+     * @param aero aerodynamics model
+     * @param gear landing gear model
+     * @param mass mass and inertia model
+     * @param prop propulsion model
+     * @param for_bas [N] resulting total force vector expressed in BAS
+     * @param mom_bas [N*m] resulting total moment vector expressed in BAS
+     */
+    template < class TAero, class TGear, class TMass, class TProp >
+    inline void sumForceAndMoment( TAero *aero, TGear *gear, TMass *mass, TProp *prop,
+                                   Vector3 *for_bas, Vector3 *mom_bas )
+    {
+        bool gearActive = !gear->isRetired();
+        bool propActive = !prop->isRetired();
+
+        double t = Time::get();
+
+        aero->computeForceAndMoment();
+        t = addTiming( TimingAero, t );
+
+        if ( gearActive ) gear->computeForceAndMoment();
+        t = addTiming( TimingGear, t );
+
+        mass->computeForceAndMoment();
+        t = addTiming( TimingMass, t );
+
+        if ( propActive ) prop->computeForceAndMoment();
+        addTiming( TimingProp, t );
+
+        (*for_bas) = aero->getFor_BAS() + mass->getFor_BAS();
+        (*mom_bas) = aero->getMom_BAS() + mass->getMom_BAS();
+
+        if ( gearActive )
+        {
+            (*for_bas) += gear->getFor_BAS();
+            (*mom_bas) += gear->getMom_BAS();
+        }
+
+        if ( propActive )
+        {
+            (*for_bas) += prop->getFor_BAS();
+            (*mom_bas) += prop->getMom_BAS();
+        }
+    }
+
+    /**
+     * @brief Computes only kinematic (position and attitude) state vector
+     * derivatives due to given state vector.
+     * Used by the semi-implicit Euler's integration method.
+     * @param stateVect state vector
+     * @param derivVect resulting state vector derivative
+     */
+    virtual void computeKinematicsDeriv( const StateVector &stateVect,
+                                         StateVector *derivVect );
+
     /**
      * @brief Updates aircraft state variables.
      * @param stateVect state vector
@@ -434,10 +619,33 @@ protected:
     virtual void updateVariables( const StateVector &stateVect,
                                   const StateVector &derivVect );
 
+    /**
+     * @brief Computes single column of the linearized model state matrix.
+     * @param stateVect state vector about which model is linearized
+     * @param column column index
+     * @param stateMatrix resulting state matrix
+     */
+    void computeStateMatrixColumn( const StateVector &stateVect,
+                                   unsigned int column,
+                                   StateMatrix *stateMatrix );
+
 private:
 
     /** Using this constructor is forbidden. */
     Aircraft( const Aircraft & ) : Base() {}
+
+    /**
+     * @brief Adds time elapsed since given time to the computations time breakdown.
+     * @param timing computations time breakdown item
+     * @param t_0 [s] start time
+     * @return [s] current time
+     */
+    inline double addTiming( Timing timing, double t_0 )
+    {
+        double t = Time::get();
+        _timing[ timing ] += t - t_0;
+        return t;
+    }
 };
 
 } // end of fdm namespace
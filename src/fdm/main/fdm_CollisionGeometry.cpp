@@ -0,0 +1,387 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#include <fdm/main/fdm_CollisionGeometry.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_Angles.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::mutex CollisionGeometry::_mutex;
+std::vector< CollisionGeometry::Mesh > CollisionGeometry::_library;
+std::atomic< unsigned int > CollisionGeometry::_version ( 0 );
+
+const unsigned int CollisionGeometry::_contacts_max = 16;
+const double CollisionGeometry::_contact_tolerance = 0.05;
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CollisionGeometry::addMesh( const std::vector< Vector3 > &vertices,
+                                 const std::vector< UInt32 > &indices,
+                                 double lat, double lon, double alt, double hdg,
+                                 double speed, double turn )
+{
+    std::shared_ptr< TriangleBVH > bvh = std::make_shared< TriangleBVH >();
+
+    bvh->build( vertices, indices );
+
+    if ( bvh->isEmpty() ) return false;
+
+    Mesh mesh;
+
+    mesh.bvh = bvh;
+
+    mesh.origin.lat = lat;
+    mesh.origin.lon = lon;
+    mesh.origin.alt = alt;
+
+    mesh.heading = hdg;
+    mesh.speed   = speed;
+    mesh.turn    = turn;
+
+    mesh.moving = speed != 0.0 || turn != 0.0;
+
+    place( &mesh, 0.0 );
+
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _library.push_back( mesh );
+    _version.fetch_add( 1, std::memory_order_acq_rel );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int CollisionGeometry::readMesh( const char *file,
+                                 double lat, double lon, double alt, double hdg,
+                                 double speed, double turn )
+{
+    std::ifstream ifs( file );
+
+    if ( !ifs.is_open() )
+    {
+        Log::e() << "Cannot open collision mesh file: " << file << std::endl;
+        return FDM_FAILURE;
+    }
+
+    std::vector< Vector3 > vertices;
+    std::vector< UInt32 > indices;
+
+    std::string line;
+
+    while ( std::getline( ifs, line ) )
+    {
+        std::istringstream ss( line );
+        std::string type;
+
+        ss >> type;
+
+        if ( type == "v" )
+        {
+            double x = 0.0;
+            double y = 0.0;
+            double z = 0.0;
+
+            ss >> x >> y >> z;
+
+            vertices.push_back( Vector3( x, y, z ) );
+        }
+        else if ( type == "f" )
+        {
+            std::vector< UInt32 > face;
+            std::string token;
+
+            // vertex index might be followed by texture and normal indices
+            while ( ss >> token )
+            {
+                long index = atol( token.c_str() );
+
+                if ( index < 0 ) index += (long)vertices.size() + 1;
+
+                if ( index < 1 || index > (long)vertices.size() )
+                {
+                    Log::e() << "Invalid collision mesh face: " << file << std::endl;
+                    return FDM_FAILURE;
+                }
+
+                face.push_back( (UInt32)( index - 1 ) );
+            }
+
+            // triangle fan
+            for ( unsigned int i = 2; i < face.size(); i++ )
+            {
+                indices.push_back( face[ 0 ] );
+                indices.push_back( face[ i - 1 ] );
+                indices.push_back( face[ i ] );
+            }
+        }
+    }
+
+    if ( !addMesh( vertices, indices, lat, lon, alt, hdg, speed, turn ) )
+    {
+        Log::e() << "Collision mesh contains no triangles: " << file << std::endl;
+        return FDM_FAILURE;
+    }
+
+    return FDM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionGeometry::clear()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    _library.clear();
+    _version.fetch_add( 1, std::memory_order_acq_rel );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CollisionGeometry::CollisionGeometry() :
+    _contactsNext ( 0 ),
+    _meshesVersion ( 0 ),
+    _time ( 0.0 )
+{
+    _contacts.reserve( _contacts_max );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CollisionGeometry::~CollisionGeometry() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionGeometry::update()
+{
+    if ( _meshesVersion != getVersion() )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _meshes = _library;
+        _meshesVersion = _version.load( std::memory_order_acquire );
+
+        // cached hierarchies might have been released
+        _contacts.clear();
+        _contactsNext = 0;
+
+        for ( std::vector< Mesh >::iterator it = _meshes.begin(); it != _meshes.end(); ++it )
+        {
+            if ( it->moving ) place( &(*it), _time );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionGeometry::step( double timeStep )
+{
+    _time += timeStep;
+
+    for ( std::vector< Mesh >::iterator it = _meshes.begin(); it != _meshes.end(); ++it )
+    {
+        if ( it->moving ) place( &(*it), _time );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CollisionGeometry::getIntersection( const Vector3 &b, const Vector3 &e,
+                                         double *u, Vector3 *n, Vector3 *v ) const
+{
+    bool result = false;
+
+    double u_best = 1.0;
+
+    Vector3 b2e = e - b;
+    double len2 = b2e.getLength2();
+
+    for ( std::vector< Mesh >::const_iterator it = _meshes.begin(); it != _meshes.end(); ++it )
+    {
+        // segment and bounding sphere distance
+        Vector3 b2c = it->ctr_wgs - b;
+
+        double t = len2 > 0.0 ? ( b2c * b2e ) / len2 : 0.0;
+
+        if ( t < 0.0 ) t = 0.0;
+        if ( t > 1.0 ) t = 1.0;
+
+        double r = it->bvh->getRadius();
+
+        if ( Vector3( b2c - t * b2e ).getLength2() > r * r ) continue;
+
+        Vector3 b_msh = it->wgs2msh * ( b - it->pos_wgs );
+        Vector3 e_msh = it->wgs2msh * ( e - it->pos_wgs );
+
+        double u_msh = 0.0;
+        Vector3 n_msh;
+
+        if ( getIntersection( *it, b_msh, e_msh, &u_msh, &n_msh ) && u_msh <= u_best )
+        {
+            u_best = u_msh;
+
+            (*u) = u_msh;
+            (*n) = it->msh2wgs * n_msh;
+
+            if ( v )
+            {
+                Vector3 r_wgs = b + u_msh * b2e;
+                (*v) = it->vel_wgs + ( it->omg_wgs % Vector3( r_wgs - it->pos_wgs ) );
+            }
+
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionGeometry::place( Mesh *mesh, double time )
+{
+    double hdg = mesh->heading;
+
+    double offset_x = mesh->speed * time;
+    double offset_y = 0.0;
+
+    // constant turn rate circle
+    if ( fabs( mesh->turn ) > 1.0e-9 )
+    {
+        double radius = mesh->speed / mesh->turn;
+        double angle  = mesh->turn * time;
+
+        offset_x = radius * sin( angle );
+        offset_y = radius * ( 1.0 - cos( angle ) );
+
+        hdg += angle;
+    }
+
+    WGS84::Geo geo = mesh->origin;
+
+    if ( time != 0.0 )
+    {
+        geo = WGS84::getGeoOffset( mesh->origin, mesh->heading, offset_x, offset_y );
+        geo.alt = mesh->origin.alt;
+    }
+
+    WGS84 wgs( geo );
+
+    mesh->pos_wgs = wgs.getPos_WGS();
+
+    mesh->wgs2msh = Matrix3x3( Angles( 0.0, 0.0, hdg ) ) * wgs.getWGS2NED();
+    mesh->msh2wgs = mesh->wgs2msh.getTransposed();
+
+    mesh->ctr_wgs = mesh->pos_wgs + mesh->msh2wgs * mesh->bvh->getCenter();
+
+    mesh->vel_wgs = wgs.getNED2WGS() * Vector3( mesh->speed * cos( hdg ),
+                                                mesh->speed * sin( hdg ),
+                                                0.0 );
+    mesh->omg_wgs = wgs.getNED2WGS() * Vector3( 0.0, 0.0, mesh->turn );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CollisionGeometry::getIntersection( const Mesh &mesh,
+                                         const Vector3 &b_msh, const Vector3 &e_msh,
+                                         double *u, Vector3 *n_msh ) const
+{
+    const double tol2 = _contact_tolerance * _contact_tolerance;
+
+    Contact *contact = FDM_NULLPTR;
+
+    for ( std::vector< Contact >::iterator it = _contacts.begin(); it != _contacts.end(); ++it )
+    {
+        if ( it->bvh == mesh.bvh.get()
+          && Vector3( it->b_msh - b_msh ).getLength2() < tol2
+          && Vector3( it->e_msh - e_msh ).getLength2() < tol2 )
+        {
+            contact = &(*it);
+            break;
+        }
+    }
+
+    // segment has barely moved relative to the mesh, testing only the most
+    // recently intersected triangle
+    if ( contact && mesh.bvh->getIntersection( contact->tri, b_msh, e_msh, u, n_msh ) )
+    {
+        contact->b_msh = b_msh;
+        contact->e_msh = e_msh;
+
+        return true;
+    }
+
+    UInt32 tri = 0;
+
+    if ( mesh.bvh->getIntersection( b_msh, e_msh, u, n_msh, &tri ) )
+    {
+        if ( contact == FDM_NULLPTR )
+        {
+            if ( _contacts.size() < _contacts_max )
+            {
+                _contacts.push_back( Contact() );
+                contact = &_contacts.back();
+            }
+            else
+            {
+                contact = &_contacts[ _contactsNext ];
+                _contactsNext = ( _contactsNext + 1 ) % _contacts_max;
+            }
+        }
+
+        contact->bvh   = mesh.bvh.get();
+        contact->b_msh = b_msh;
+        contact->e_msh = e_msh;
+        contact->tri   = tri;
+
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CollisionGeometry::archiveState( StateArchive *archive )
+{
+    archive->add( &_time );
+
+    if ( archive->isRestoring() )
+    {
+        for ( std::vector< Mesh >::iterator it = _meshes.begin(); it != _meshes.end(); ++it )
+        {
+            if ( it->moving ) place( &(*it), _time );
+        }
+    }
+}
@@ -0,0 +1,233 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_COLLISIONGEOMETRY_H
+#define FDM_COLLISIONGEOMETRY_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_StateArchive.h>
+#include <fdm/utils/fdm_TriangleBVH.h>
+#include <fdm/utils/fdm_Vector3.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Collision geometry class.
+ *
+ * Collision meshes (e.g. decks, rooftops, bridges) are added to the process
+ * wide library at load time, either from triangles extracted from scenery
+ * models or read from Wavefront OBJ files, and an immutable bounding volume
+ * hierarchy is built for every mesh at once. Every collision geometry
+ * instance keeps its own list of placed meshes which is refreshed from the
+ * library only when library version changes, so queries neither lock nor
+ * depend on CGI.
+ *
+ * Mesh axis system is the same as for scenery models: x-axis along heading,
+ * y-axis to the right and z-axis downwards, origin at given location.
+ *
+ * Meshes of moving platforms (e.g. ships) are given kinematic state instead
+ * of fixed placement: initial location and heading, speed and turn rate.
+ * Every instance advances its own time in step() and places platforms at
+ * this time, so concurrent simulations (e.g. batch runs) never share mutable
+ * platform state. Queries are made in the mesh axis system and intersection
+ * velocity includes platform velocity and rotation.
+ *
+ * The most recent intersected triangles are cached by segment coordinates
+ * expressed in the mesh axis system, if a segment moved less than
+ * _contact_tolerance relative to the mesh since a cached query (e.g. landing
+ * gear of an aircraft standing on a moving deck), only the cached triangle
+ * is tested, otherwise the hierarchy is queried.
+ *
+ * update(), step() and query functions might be called only from a single
+ * thread, library functions might be called from any thread.
+ */
+class FDMEXPORT CollisionGeometry
+{
+public:
+
+    static const unsigned int _contacts_max;    ///< maximum number of cached contacts
+    static const double _contact_tolerance;     ///< [m] maximum segment displacement for which cached contact is used
+
+    /**
+     * @brief Adds mesh to the library.
+     * @param vertices [m] vertices coordinates expressed in mesh axis system
+     * @param indices vertices indices, 3 per triangle
+     * @param lat [rad] mesh origin latitude
+     * @param lon [rad] mesh origin longitude
+     * @param alt [m] mesh origin altitude above mean sea level
+     * @param hdg [rad] mesh heading
+     * @param speed [m/s] moving platform speed
+     * @param turn [rad/s] moving platform turn rate
+     * @return true if mesh has been added, false if it contains no valid triangle
+     */
+    static bool addMesh( const std::vector< Vector3 > &vertices,
+                         const std::vector< UInt32 > &indices,
+                         double lat, double lon, double alt, double hdg,
+                         double speed = 0.0, double turn = 0.0 );
+
+    /**
+     * @brief Reads mesh from Wavefront OBJ file and adds it to the library.
+     * Only vertices and faces are read, polygons are split into triangles.
+     * @param file mesh file path
+     * @param lat [rad] mesh origin latitude
+     * @param lon [rad] mesh origin longitude
+     * @param alt [m] mesh origin altitude above mean sea level
+     * @param hdg [rad] mesh heading
+     * @param speed [m/s] moving platform speed
+     * @param turn [rad/s] moving platform turn rate
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    static int readMesh( const char *file,
+                         double lat, double lon, double alt, double hdg,
+                         double speed = 0.0, double turn = 0.0 );
+
+    /** @brief Removes all meshes from the library. */
+    static void clear();
+
+    /** @return library version, incremented every time library changes */
+    inline static unsigned int getVersion() { return _version.load( std::memory_order_acquire ); }
+
+    /** @brief Constructor. */
+    CollisionGeometry();
+
+    /** @brief Destructor. */
+    virtual ~CollisionGeometry();
+
+    /** @brief Refreshes placed meshes if library has changed. */
+    void update();
+
+    /**
+     * @brief Advances time and moves platforms.
+     * @param timeStep [s] time step
+     */
+    void step( double timeStep );
+
+    /**
+     * @brief Archives platforms time.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
+    /**
+     * @brief Gets the segment intersection closest to its beginning.
+     * @param b [m] beginning of intersection segment expressed in WGS
+     * @param e [m] end of intersection segment expressed in WGS
+     * @param u [-] intersection parameter, intersection point is b + u * ( e - b )
+     * @param n [-] intersection normal vector expressed in WGS
+     * @param v [m/s] intersection point velocity expressed in WGS (optional)
+     * @return true if there is an intersection, false otherwise
+     */
+    bool getIntersection( const Vector3 &b, const Vector3 &e,
+                          double *u, Vector3 *n, Vector3 *v = FDM_NULLPTR ) const;
+
+    /** @return true if there are no meshes */
+    inline bool isEmpty() const { return _meshes.empty(); }
+
+    /** @return [s] time platforms are placed at */
+    inline double getTime() const { return _time; }
+
+private:
+
+    typedef std::shared_ptr< const TriangleBVH > BVHPtr;
+
+    /** Placed mesh. */
+    struct Mesh
+    {
+        BVHPtr bvh;                 ///< mesh hierarchy (shared, read-only)
+
+        WGS84::Geo origin;          ///< mesh origin at time 0
+        double heading;             ///< [rad] mesh heading at time 0
+        double speed;               ///< [m/s] platform speed
+        double turn;                ///< [rad/s] platform turn rate
+
+        bool moving;                ///< specifies if mesh is a moving platform
+
+        Vector3 pos_wgs;            ///< [m] mesh origin expressed in WGS
+        Vector3 ctr_wgs;            ///< [m] mesh bounding sphere center expressed in WGS
+        Vector3 vel_wgs;            ///< [m/s] mesh origin velocity expressed in WGS
+        Vector3 omg_wgs;            ///< [rad/s] mesh angular velocity expressed in WGS
+
+        Matrix3x3 wgs2msh;          ///< matrix of rotation from WGS to mesh axis system
+        Matrix3x3 msh2wgs;          ///< matrix of rotation from mesh axis system to WGS
+    };
+
+    /** Cached contact. */
+    struct Contact
+    {
+        const TriangleBVH *bvh;     ///< intersected mesh hierarchy
+        Vector3 b_msh;              ///< [m] segment beginning expressed in mesh axis system
+        Vector3 e_msh;              ///< [m] segment end expressed in mesh axis system
+        UInt32 tri;                 ///< intersected triangle index
+    };
+
+    static std::mutex _mutex;                   ///< library mutex
+    static std::vector< Mesh > _library;        ///< library meshes
+    static std::atomic< unsigned int > _version;    ///< library version
+
+    std::vector< Mesh > _meshes;    ///< placed meshes
+
+    mutable std::vector< Contact > _contacts;   ///< cached contacts
+    mutable unsigned int _contactsNext;         ///< index of the cached contact to be replaced
+
+    unsigned int _meshesVersion;    ///< library version of placed meshes
+
+    double _time;                   ///< [s] time platforms are placed at
+
+    /**
+     * @brief Places mesh at the given time.
+     * @param mesh mesh
+     * @param time [s] time
+     */
+    static void place( Mesh *mesh, double time );
+
+    /**
+     * @brief Gets the segment intersection with the given mesh.
+     * @param mesh mesh
+     * @param b_msh [m] beginning of intersection segment expressed in mesh axis system
+     * @param e_msh [m] end of intersection segment expressed in mesh axis system
+     * @param u [-] intersection parameter
+     * @param n_msh [-] intersection normal vector expressed in mesh axis system
+     * @return true if there is an intersection, false otherwise
+     */
+    bool getIntersection( const Mesh &mesh,
+                          const Vector3 &b_msh, const Vector3 &e_msh,
+                          double *u, Vector3 *n_msh ) const;
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_COLLISIONGEOMETRY_H
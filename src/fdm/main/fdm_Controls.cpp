@@ -105,3 +105,15 @@ void Controls::update()
             ch.output = ch.table.getValue( 0.0 );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Controls::archiveState( StateArchive *archive )
+{
+    Module::archiveState( archive );
+
+    for ( Channels::iterator it = _channels.begin(); it != _channels.end(); ++it )
+    {
+        archive->add( &(*it).second.output );
+    }
+}
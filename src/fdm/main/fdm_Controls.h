@@ -86,6 +86,12 @@ public:
     /** @brief Updates controls. */
     virtual void update();
 
+    /**
+     * @brief Archives module internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
 protected:
 
     Channels _channels;         ///< control channels
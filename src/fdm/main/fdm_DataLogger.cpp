@@ -0,0 +1,255 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/main/fdm_DataLogger.h>
+
+#include <cstring>
+#include <sstream>
+
+#include <fdm/fdm_Log.h>
+
+#include <fdm/main/fdm_Recorder.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataLogger::DataLogger( DataNode *root ) :
+    _root ( root ),
+
+    _time ( 0.0 ),
+    _steps ( 0 ),
+
+    _open ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataLogger::~DataLogger()
+{
+    close();
+
+    Groups::iterator it = _groups.begin();
+    while ( it != _groups.end() )
+    {
+        FDM_DELPTR( (*it)->writer );
+        FDM_DELPTR( (*it) );
+        it = _groups.erase( it );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int DataLogger::subscribe( const char *path, UInt32 decimation, UInt8 precision )
+{
+    if ( _open || decimation == 0 ) return FDM_FAILURE;
+
+    const DataNode *node = _root->getNode( path );
+
+    if ( node == FDM_NULLPTR || node->getType() == DataNode::Group )
+    {
+        Log::w() << "Cannot subscribe logging channel \"" << path << "\"." << std::endl;
+        return FDM_FAILURE;
+    }
+
+    Channel channel;
+
+    channel.node      = node;
+    channel.name      = path;
+    channel.precision = precision;
+
+    getGroup( decimation )->channels.push_back( channel );
+
+    return FDM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int DataLogger::open( const char *file )
+{
+    close();
+
+    const bool binary = !Recorder::isTextFile( file );
+
+    int result = FDM_SUCCESS;
+
+    for ( Groups::iterator it = _groups.begin(); it != _groups.end(); ++it )
+    {
+        Group *group = (*it);
+
+        RecorderWriter::Columns columns;
+        Recorder::Names names;
+
+        for ( Channels::iterator ch = group->channels.begin(); ch != group->channels.end(); ++ch )
+        {
+            // all the channels are logged as double
+            RecorderWriter::Column column;
+
+            column.type      = 'd';
+            column.precision = ch->precision;
+            column.encoding  = RecorderCodec::Delta;
+            column.size      = sizeof( double );
+
+            columns.push_back( column );
+            names.push_back( ch->name );
+        }
+
+        std::string header = binary ? Recorder::getHeaderBin( names, columns, true )
+                                    : Recorder::getHeader( names );
+
+        group->frame.resize( sizeof( double ) * ( group->channels.size() + 1 ) );
+
+        if ( !group->writer->open( getFile( file, group ).c_str(), header, columns, !binary, true ) )
+        {
+            result = FDM_FAILURE;
+        }
+    }
+
+    _time  = 0.0;
+    _steps = 0;
+    _open  = true;
+
+    if ( result != FDM_SUCCESS )
+    {
+        Log::e() << "Cannot open logging file \"" << file << "\"." << std::endl;
+        close();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLogger::close()
+{
+    if ( _open )
+    {
+        for ( Groups::iterator it = _groups.begin(); it != _groups.end(); ++it )
+        {
+            (*it)->writer->close();
+        }
+
+        UInt32 dropped = getDropped();
+
+        if ( dropped > 0 )
+        {
+            Log::w() << "Data logger dropped " << dropped << " sample(s)." << std::endl;
+        }
+
+        _open = false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLogger::step( double timeStep )
+{
+    if ( _open )
+    {
+        for ( Groups::iterator it = _groups.begin(); it != _groups.end(); ++it )
+        {
+            if ( _steps % (*it)->decimation == 0 ) write( *it );
+        }
+
+        _steps++;
+        _time += timeStep;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt32 DataLogger::getDropped() const
+{
+    UInt32 dropped = 0;
+
+    for ( Groups::const_iterator it = _groups.begin(); it != _groups.end(); ++it )
+    {
+        dropped += (*it)->writer->getDropped();
+    }
+
+    return dropped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataLogger::Group* DataLogger::getGroup( UInt32 decimation )
+{
+    for ( Groups::iterator it = _groups.begin(); it != _groups.end(); ++it )
+    {
+        if ( (*it)->decimation == decimation ) return (*it);
+    }
+
+    Group *group = new Group();
+
+    group->decimation = decimation;
+    group->writer = new RecorderWriter();
+
+    _groups.push_back( group );
+
+    return group;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string DataLogger::getFile( const char *file, const Group *group ) const
+{
+    std::string path( file );
+
+    if ( _groups.size() > 1 )
+    {
+        std::ostringstream suffix;
+        suffix << "_" << group->decimation;
+
+        size_t dot = path.find_last_of( '.' );
+        size_t sep = path.find_last_of( "/\\" );
+
+        if ( dot == std::string::npos || ( sep != std::string::npos && dot < sep ) )
+        {
+            dot = path.length();
+        }
+
+        path.insert( dot, suffix.str() );
+    }
+
+    return path;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLogger::write( Group *group )
+{
+    char *frame = &group->frame[ 0 ];
+
+    memcpy( frame, &_time, sizeof( double ) );
+    frame += sizeof( double );
+
+    for ( Channels::iterator it = group->channels.begin(); it != group->channels.end(); ++it )
+    {
+        double value = it->node->getValue();
+        memcpy( frame, &value, sizeof( double ) );
+        frame += sizeof( double );
+    }
+
+    group->writer->push( &group->frame[ 0 ] );
+}
@@ -0,0 +1,147 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_DATALOGGER_H
+#define FDM_DATALOGGER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/main/fdm_RecorderWriter.h>
+
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_DataNode.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Data logging class.
+ *
+ * Any data node of the data tree can be subscribed as a logging channel at
+ * a chosen decimation rate. Paths are resolved once, when subscribing, so
+ * logging step only reads node values into preallocated frame buffers which
+ * are pushed to the background writers. Channels of the same decimation
+ * rate are written into the same file. Files use Recorder format (binary
+ * compressed or CSV, depending on the file extension), so they might be
+ * exported with Recorder::exportText(). When channels of more than one
+ * decimation rate are subscribed decimation is appended to the file name,
+ * e.g. "log_10.rec" for decimation rate of 10.
+ */
+class FDMEXPORT DataLogger : public ArenaObject
+{
+public:
+
+    /** @brief Constructor. */
+    DataLogger( DataNode *root );
+
+    /** @brief Destructor. */
+    virtual ~DataLogger();
+
+    /**
+     * @brief Subscribes data node as a logging channel.
+     * Channels can be subscribed only while logger is closed.
+     * @param path data node path relative to the root node
+     * @param decimation logging decimation rate (every n-th step is logged)
+     * @param precision floating point number precision
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    int subscribe( const char *path, UInt32 decimation = 1, UInt8 precision = 6 );
+
+    /**
+     * @brief Opens logging files.
+     * @param file file path
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    int open( const char *file );
+
+    /** @brief Writes all the pending samples and closes logging files. */
+    void close();
+
+    /**
+     * @brief Performs logging step.
+     * @param timeStep [s] simulation time step
+     */
+    void step( double timeStep );
+
+    /** @return number of samples dropped by the writers */
+    UInt32 getDropped() const;
+
+    /** @return true if logger is open */
+    inline bool isOpen() const { return _open; }
+
+private:
+
+    /** Logging channel. */
+    struct Channel
+    {
+        const DataNode *node;       ///< data node
+        std::string name;           ///< channel name
+        UInt8 precision;            ///< floating point number precision
+    };
+
+    typedef std::vector< Channel > Channels;
+
+    /** Channels group of the same decimation rate. */
+    struct Group
+    {
+        UInt32 decimation;          ///< decimation rate
+        Channels channels;          ///< group channels
+        std::vector< char > frame;  ///< frame buffer
+        RecorderWriter *writer;     ///< group writer
+    };
+
+    typedef std::vector< Group* > Groups;
+
+    DataNode *_root;                ///< data tree root node
+
+    Groups _groups;                 ///< channels groups
+
+    double _time;                   ///< [s] logging time
+    UInt32 _steps;                  ///< steps counter
+
+    bool _open;                     ///< specifies if logger is open
+
+    /** Using this constructor is forbidden. */
+    DataLogger( const DataLogger & ) {}
+
+    /** Returns group of the given decimation rate (created if necessary). */
+    Group* getGroup( UInt32 decimation );
+
+    /** Returns file path of the given group. */
+    std::string getFile( const char *file, const Group *group ) const;
+
+    /** Writes down group frame. */
+    void write( Group *group );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_DATALOGGER_H
@@ -30,6 +30,8 @@ using namespace fdm;
 
 Environment::Environment() :
     _atmosphere ( FDM_NULLPTR ),
+    _turbulence ( FDM_NULLPTR ),
+    _windField  ( FDM_NULLPTR ),
 
     _temperature     ( 0.0 ),
     _pressure        ( 0.0 ),
@@ -41,6 +43,8 @@ Environment::Environment() :
     _wind_speed     ( 0.0 )
 {
     _atmosphere = new Atmosphere();
+    _turbulence = new Turbulence();
+    _windField  = new WindField();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +52,8 @@ Environment::Environment() :
 Environment::~Environment()
 {
     FDM_DELPTR( _atmosphere );
+    FDM_DELPTR( _turbulence );
+    FDM_DELPTR( _windField );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -67,3 +73,24 @@ void Environment::update( double altitude_asl )
     _wind_ned.x() = -cos( _wind_direction ) * _wind_speed;
     _wind_ned.y() = -sin( _wind_direction ) * _wind_speed;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Environment::updateTurbulence( double distance, double altitude_agl )
+{
+    _turbulence->update( distance, altitude_agl );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Environment::archiveState( StateArchive *archive )
+{
+    _random.archiveState( archive );
+
+    _turbulence->archiveState( archive );
+
+    archive->add( &_wind_direction );
+    archive->add( &_wind_speed );
+
+    archive->add( &_wind_ned );
+}
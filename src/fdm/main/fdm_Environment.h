@@ -25,7 +25,12 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/models/fdm_Atmosphere.h>
+#include <fdm/models/fdm_Turbulence.h>
+#include <fdm/models/fdm_WindField.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_Random.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,7 +41,7 @@ namespace fdm
 /**
  * @brief Environment model interface class.
  */
-class FDMEXPORT Environment
+class FDMEXPORT Environment : public ArenaObject
 {
 public:
 
@@ -52,6 +57,19 @@ public:
      */
     virtual void update( double altitude_asl );
 
+    /**
+     * @brief Updates turbulence, should be called once every time step.
+     * @param distance [m] distance flown since previous update
+     * @param altitude_agl [m] altitude above ground level
+     */
+    virtual void updateTurbulence( double distance, double altitude_agl );
+
+    /**
+     * @brief Archives environment internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline double getTemperature()     const { return _temperature;     }
     inline double getPressure()        const { return _pressure;        }
     inline double getDensity()         const { return _density;         }
@@ -60,6 +78,44 @@ public:
 
     inline Vector3 getWind_NED() const { return _wind_ned; }
 
+    /**
+     * @brief Returns wind at the given point (uniform wind and wind field).
+     * @param pos_wgs [m] point position expressed in WGS
+     * @param bracket querying point cached wind field cell (might be null)
+     * @return [m/s] wind velocity expressed in NED
+     */
+    inline Vector3 getWind_NED( const Vector3 &pos_wgs, WindField::Bracket *bracket ) const
+    {
+        if ( _windField->isLoaded() )
+        {
+            return _wind_ned + _windField->getWind_NED( pos_wgs, bracket );
+        }
+
+        return _wind_ned;
+    }
+
+    inline const Vector3& getTurb_BAS() const { return _turbulence->getVel_BAS(); }
+
+    /**
+     * @brief Returns random number generator owned by this environment.
+     * Stochastic models (e.g. turbulence) should draw numbers only from this
+     * generator, so results are reproducible for the given seed.
+     * @return random number generator
+     */
+    inline Random* getRandom() { return &_random; }
+
+    inline const Random* getRandom() const { return &_random; }
+
+    /**
+     * @brief Seeds random number generator.
+     * @param seed generator seed
+     */
+    inline void setRandomSeed( UInt64 seed )
+    {
+        _random.setSeed( seed );
+        _turbulence->setSeed( ~seed );
+    }
+
     /**
      * @brief Sets sea level air temperature value.
      * @param slAirTemperature [K] sea level air temperature
@@ -78,6 +134,15 @@ public:
         _atmosphere->setPressureSL( pressure_0 );
     }
 
+    /**
+     * @brief Sets atmosphere lookup table mode.
+     * @param tableMode specifies if atmospheric data are interpolated from lookup table
+     */
+    inline void setAtmosphereTableMode( bool tableMode )
+    {
+        _atmosphere->setTableMode( tableMode );
+    }
+
     inline void setWindDirection( double wind_direction )
     {
         _wind_direction = wind_direction;
@@ -88,9 +153,27 @@ public:
         _wind_speed = wind_speed;
     }
 
+    inline void setTurbulence( Turbulence::Intensity intensity )
+    {
+        _turbulence->setIntensity( intensity );
+    }
+
+    /**
+     * @brief Reads wind field from file.
+     * @param fileName wind field file name
+     */
+    inline void readWindField( const char *fileName )
+    {
+        _windField->readFile( fileName );
+    }
+
 protected:
 
     Atmosphere *_atmosphere;    ///< atmosphere object
+    Turbulence *_turbulence;    ///< turbulence object
+    WindField  *_windField;     ///< wind field object
+
+    Random _random;             ///< random number generator
 
     double _temperature;        ///< [K] air temperature
     double _pressure;           ///< [Pa] air static pressure
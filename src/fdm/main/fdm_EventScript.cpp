@@ -0,0 +1,522 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/main/fdm_EventScript.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <fdm/fdm_Exception.h>
+
+#include <fdm/utils/fdm_String.h>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Variable descriptor. */
+struct Variable
+{
+    const char *name;               ///< variable name
+    size_t offset;                  ///< offset within parent structure
+    EventScript::Type type;         ///< variable type
+};
+
+#define FDM_EVENTSCRIPT_MEMBER( NAME, PARENT, MEMBER, TYPE ) \
+    { NAME, offsetof( PARENT, MEMBER ), EventScript::TYPE }
+
+const Variable outFlight[] = {
+    FDM_EVENTSCRIPT_MEMBER( "latitude"      , DataOut::Flight, latitude      , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "longitude"     , DataOut::Flight, longitude     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "altitude_asl"  , DataOut::Flight, altitude_asl  , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "altitude_agl"  , DataOut::Flight, altitude_agl  , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "roll"          , DataOut::Flight, roll          , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "pitch"         , DataOut::Flight, pitch         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "heading"       , DataOut::Flight, heading       , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "angleOfAttack" , DataOut::Flight, angleOfAttack , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "sideslipAngle" , DataOut::Flight, sideslipAngle , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "climbAngle"    , DataOut::Flight, climbAngle    , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "trackAngle"    , DataOut::Flight, trackAngle    , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "slipSkidAngle" , DataOut::Flight, slipSkidAngle , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "airspeed"      , DataOut::Flight, airspeed      , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "ias"           , DataOut::Flight, ias           , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "tas"           , DataOut::Flight, tas           , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "groundSpeed"   , DataOut::Flight, groundSpeed   , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "machNumber"    , DataOut::Flight, machNumber    , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "climbRate"     , DataOut::Flight, climbRate     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "rollRate"      , DataOut::Flight, rollRate      , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "pitchRate"     , DataOut::Flight, pitchRate     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "yawRate"       , DataOut::Flight, yawRate       , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "turnRate"      , DataOut::Flight, turnRate      , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "g_force_x"     , DataOut::Flight, g_force_x     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "g_force_y"     , DataOut::Flight, g_force_y     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "g_force_z"     , DataOut::Flight, g_force_z     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "onGround"      , DataOut::Flight, onGround      , Bool   ),
+    FDM_EVENTSCRIPT_MEMBER( "stall"         , DataOut::Flight, stall         , Bool   )
+};
+
+const Variable outEngine[] = {
+    FDM_EVENTSCRIPT_MEMBER( "state"       , DataOut::Engine, state       , Bool   ),
+    FDM_EVENTSCRIPT_MEMBER( "afterburner" , DataOut::Engine, afterburner , Bool   ),
+    FDM_EVENTSCRIPT_MEMBER( "rpm"         , DataOut::Engine, rpm         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "prop"        , DataOut::Engine, prop        , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "ng"          , DataOut::Engine, ng          , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "n1"          , DataOut::Engine, n1          , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "n2"          , DataOut::Engine, n2          , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "trq"         , DataOut::Engine, trq         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "epr"         , DataOut::Engine, epr         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "map"         , DataOut::Engine, map         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "egt"         , DataOut::Engine, egt         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "cht"         , DataOut::Engine, cht         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "itt"         , DataOut::Engine, itt         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "tit"         , DataOut::Engine, tit         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "fuelFlow"    , DataOut::Engine, fuelFlow    , Double )
+};
+
+const Variable inpEnvironment[] = {
+    FDM_EVENTSCRIPT_MEMBER( "temperature_0"  , DataInp::Environment, temperature_0  , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "pressure_0"     , DataInp::Environment, pressure_0     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "wind_direction" , DataInp::Environment, wind_direction , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "wind_speed"     , DataInp::Environment, wind_speed     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "turbulence"     , DataInp::Environment, turbulence     , Enum   ),
+    FDM_EVENTSCRIPT_MEMBER( "windShear"      , DataInp::Environment, windShear      , Enum   )
+};
+
+const Variable inpControls[] = {
+    FDM_EVENTSCRIPT_MEMBER( "roll"         , DataInp::Controls, roll         , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "pitch"        , DataInp::Controls, pitch        , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "yaw"          , DataInp::Controls, yaw          , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "trim_roll"    , DataInp::Controls, trim_roll    , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "trim_pitch"   , DataInp::Controls, trim_pitch   , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "trim_yaw"     , DataInp::Controls, trim_yaw     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "brake_l"      , DataInp::Controls, brake_l      , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "brake_r"      , DataInp::Controls, brake_r      , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "wheel_brake"  , DataInp::Controls, wheel_brake  , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "landing_gear" , DataInp::Controls, landing_gear , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "wheel_nose"   , DataInp::Controls, wheel_nose   , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "flaps"        , DataInp::Controls, flaps        , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "airbrake"     , DataInp::Controls, airbrake     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "spoilers"     , DataInp::Controls, spoilers     , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "collective"   , DataInp::Controls, collective   , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "lgh"          , DataInp::Controls, lgh          , Bool   ),
+    FDM_EVENTSCRIPT_MEMBER( "nws"          , DataInp::Controls, nws          , Bool   ),
+    FDM_EVENTSCRIPT_MEMBER( "abs"          , DataInp::Controls, abs          , Bool   )
+};
+
+const Variable inpMisc[] = {
+    FDM_EVENTSCRIPT_MEMBER( "freezePosition" , DataInp, freezePosition , Bool ),
+    FDM_EVENTSCRIPT_MEMBER( "freezeAttitude" , DataInp, freezeAttitude , Bool ),
+    FDM_EVENTSCRIPT_MEMBER( "freezeVelocity" , DataInp, freezeVelocity , Bool )
+};
+
+const Variable inpEngine[] = {
+    FDM_EVENTSCRIPT_MEMBER( "throttle"  , DataInp::Engine, throttle  , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "mixture"   , DataInp::Engine, mixture   , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "propeller" , DataInp::Engine, propeller , Double ),
+    FDM_EVENTSCRIPT_MEMBER( "fuel"      , DataInp::Engine, fuel      , Bool   ),
+    FDM_EVENTSCRIPT_MEMBER( "ignition"  , DataInp::Engine, ignition  , Bool   ),
+    FDM_EVENTSCRIPT_MEMBER( "starter"   , DataInp::Engine, starter   , Bool   )
+};
+
+#undef FDM_EVENTSCRIPT_MEMBER
+
+// enumerations are written and read as int
+static_assert( sizeof(DataInp::Environment::Turbulence) == sizeof(int), "Unexpected enumeration size." );
+static_assert( sizeof(DataInp::Environment::WindShear)  == sizeof(int), "Unexpected enumeration size." );
+static_assert( sizeof(DataOut::Crash)                   == sizeof(int), "Unexpected enumeration size." );
+
+////////////////////////////////////////////////////////////////////////////////
+
+template < size_t N >
+bool findVariable( const Variable (&table)[ N ], const std::string &name,
+                   size_t base, size_t *offset, EventScript::Type *type )
+{
+    for ( size_t i = 0; i < N; i++ )
+    {
+        if ( name == table[ i ].name )
+        {
+            (*offset) = base + table[ i ].offset;
+            (*type)   = table[ i ].type;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Splits engine variable name, e.g. "engine_0_rpm" into index and member.
+ */
+bool splitEngineName( const std::string &name, int *index, std::string *member )
+{
+    const std::string prefix = "engine_";
+
+    if ( name.compare( 0, prefix.length(), prefix ) != 0 ) return false;
+
+    size_t separator = name.find( '_', prefix.length() );
+
+    if ( separator == std::string::npos || separator == prefix.length() ) return false;
+
+    (*index)  = atoi( name.substr( prefix.length(), separator - prefix.length() ).c_str() );
+    (*member) = name.substr( separator + 1 );
+
+    return (*index) >= 0 && (*index) < FDM_MAX_ENGINES;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+EventScript::EventScript() :
+    _time ( 0.0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+EventScript::~EventScript() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScript::readFile( const char *file )
+{
+    XmlDoc doc( file );
+
+    if ( doc.isOpen() )
+    {
+        XmlNode rootNode = doc.getRootNode();
+
+        if ( rootNode.isValid() && 0 == String::icompare( rootNode.getName(), "event_script" ) )
+        {
+            readData( rootNode );
+        }
+        else
+        {
+            Exception e;
+
+            e.setType( Exception::FileReadingError );
+            e.setInfo( "Reading file \"" + std::string( file ) + "\" failed. Invalid root node." );
+
+            FDM_THROW( e );
+        }
+    }
+    else
+    {
+        Exception e;
+
+        e.setType( Exception::FileReadingError );
+        e.setInfo( "Reading file \"" + std::string( file ) + "\" failed." );
+
+        FDM_THROW( e );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScript::readData( const XmlNode &rootNode )
+{
+    _predicates.clear();
+    _actions.clear();
+    _events.clear();
+
+    XmlNode eventNode = rootNode.getFirstChildElement( "event" );
+
+    while ( eventNode.isValid() )
+    {
+        readEvent( eventNode );
+        eventNode = eventNode.getNextSiblingElement( "event" );
+    }
+
+    // active actions are never more than all actions, no allocation in update
+    _active.reserve( _actions.size() );
+    _pending.reserve( _events.size() );
+
+    reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScript::reset()
+{
+    _time = 0.0;
+
+    _pending.clear();
+    _active.clear();
+
+    for ( unsigned int i = 0; i < _events.size(); i++ )
+    {
+        _events[ i ].timer = 0.0;
+        _events[ i ].time  = 0.0;
+        _events[ i ].fired = false;
+
+        _pending.push_back( i );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int EventScript::update( double timeStep, const DataOut &dataOut, DataInp *dataInp )
+{
+    unsigned int fired = 0;
+
+    _time += timeStep;
+
+    for ( unsigned int i = 0; i < _pending.size(); )
+    {
+        Event &event = _events[ _pending[ i ] ];
+
+        bool active = true;
+
+        for ( unsigned int j = 0; j < event.predicates_n && active; j++ )
+        {
+            active = test( _predicates[ event.predicates_0 + j ], dataOut, _time );
+        }
+
+        event.timer = active ? event.timer + timeStep : 0.0;
+
+        if ( active && event.timer >= event.delay )
+        {
+            event.fired = true;
+            event.time  = _time;
+
+            for ( unsigned int j = 0; j < event.actions_n; j++ )
+            {
+                _active.push_back( event.actions_0 + j );
+            }
+
+            _pending.erase( _pending.begin() + i );
+            fired++;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    char *base = reinterpret_cast< char* >( dataInp );
+
+    for ( unsigned int i = 0; i < _active.size(); i++ )
+    {
+        const Action &action = _actions[ _active[ i ] ];
+
+        switch ( action.type )
+        {
+        case Double:
+            (*reinterpret_cast< double* >( base + action.offset )) = action.value;
+            break;
+
+        case Bool:
+            (*reinterpret_cast< bool* >( base + action.offset )) = action.value > 0.5;
+            break;
+
+        case Enum:
+        {
+            int value = (int)action.value;
+            memcpy( base + action.offset, &value, sizeof(int) );
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    return fired;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScript::readEvent( const XmlNode &eventNode )
+{
+    Event event;
+
+    event.name = eventNode.getAttribute( "name" );
+
+    event.predicates_0 = _predicates.size();
+    event.actions_0    = _actions.size();
+
+    event.delay = 0.0;
+    event.timer = 0.0;
+    event.time  = 0.0;
+    event.fired = false;
+
+    if ( FDM_SUCCESS != XmlUtils::read( eventNode, &event.delay, "delay", true ) )
+    {
+        XmlUtils::throwError( __FILE__, __LINE__, eventNode );
+    }
+
+    XmlNode conditionNode = eventNode.getFirstChildElement( "condition" );
+
+    while ( conditionNode.isValid() )
+    {
+        Predicate predicate;
+
+        std::string name = String::stripSpaces( conditionNode.getAttribute( "variable" ) );
+        std::string op   = String::stripSpaces( conditionNode.getAttribute( "op" ) );
+
+        if      ( op == "lt" ) predicate.op = LT;
+        else if ( op == "le" ) predicate.op = LE;
+        else if ( op == "gt" ) predicate.op = GT;
+        else if ( op == "ge" ) predicate.op = GE;
+        else if ( op == "eq" ) predicate.op = EQ;
+        else if ( op == "ne" ) predicate.op = NE;
+        else
+        {
+            XmlUtils::throwError( __FILE__, __LINE__, conditionNode );
+        }
+
+        if ( !getOutput( name, &predicate.offset, &predicate.type )
+          || FDM_SUCCESS != XmlUtils::read( conditionNode, &predicate.value ) )
+        {
+            XmlUtils::throwError( __FILE__, __LINE__, conditionNode );
+        }
+
+        _predicates.push_back( predicate );
+
+        conditionNode = conditionNode.getNextSiblingElement( "condition" );
+    }
+
+    XmlNode setNode = eventNode.getFirstChildElement( "set" );
+
+    while ( setNode.isValid() )
+    {
+        Action action;
+
+        std::string name = String::stripSpaces( setNode.getAttribute( "input" ) );
+
+        if ( !getInput( name, &action.offset, &action.type )
+          || FDM_SUCCESS != XmlUtils::read( setNode, &action.value ) )
+        {
+            XmlUtils::throwError( __FILE__, __LINE__, setNode );
+        }
+
+        _actions.push_back( action );
+
+        setNode = setNode.getNextSiblingElement( "set" );
+    }
+
+    event.predicates_n = _predicates.size() - event.predicates_0;
+    event.actions_n    = _actions.size()    - event.actions_0;
+
+    _events.push_back( event );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool EventScript::getOutput( const std::string &name, size_t *offset, Type *type )
+{
+    if ( name == "time" )
+    {
+        (*offset) = 0;
+        (*type)   = Time;
+        return true;
+    }
+
+    if ( name == "crash" )
+    {
+        (*offset) = offsetof( DataOut, crash );
+        (*type)   = Enum;
+        return true;
+    }
+
+    int index = 0;
+    std::string member;
+
+    if ( splitEngineName( name, &index, &member ) )
+    {
+        size_t base = offsetof( DataOut, engine ) + index * sizeof(DataOut::Engine);
+        return findVariable( outEngine, member, base, offset, type );
+    }
+
+    return findVariable( outFlight, name, offsetof( DataOut, flight ), offset, type );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool EventScript::getInput( const std::string &name, size_t *offset, Type *type )
+{
+    int index = 0;
+    std::string member;
+
+    if ( splitEngineName( name, &index, &member ) )
+    {
+        size_t base = offsetof( DataInp, engine ) + index * sizeof(DataInp::Engine);
+        return findVariable( inpEngine, member, base, offset, type );
+    }
+
+    return findVariable( inpEnvironment , name, offsetof( DataInp, environment ), offset, type )
+        || findVariable( inpControls    , name, offsetof( DataInp, controls    ), offset, type )
+        || findVariable( inpMisc        , name, 0                               , offset, type );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool EventScript::test( const Predicate &predicate, const DataOut &dataOut, double time )
+{
+    const char *base = reinterpret_cast< const char* >( &dataOut );
+
+    double value = 0.0;
+
+    switch ( predicate.type )
+    {
+    case Time:
+        value = time;
+        break;
+
+    case Double:
+        value = (*reinterpret_cast< const double* >( base + predicate.offset ));
+        break;
+
+    case Bool:
+        value = (*reinterpret_cast< const bool* >( base + predicate.offset )) ? 1.0 : 0.0;
+        break;
+
+    case Enum:
+    {
+        int temp = 0;
+        memcpy( &temp, base + predicate.offset, sizeof(int) );
+        value = temp;
+        break;
+    }
+    }
+
+    switch ( predicate.op )
+    {
+        case LT: return value <  predicate.value;
+        case LE: return value <= predicate.value;
+        case GT: return value >  predicate.value;
+        case GE: return value >= predicate.value;
+        case EQ: return value == predicate.value;
+        case NE: return value != predicate.value;
+    }
+
+    return false;
+}
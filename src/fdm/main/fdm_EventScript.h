@@ -0,0 +1,205 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_EVENTSCRIPT_H
+#define FDM_EVENTSCRIPT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <fdm/fdm_DataInp.h>
+#include <fdm/fdm_DataOut.h>
+#include <fdm/fdm_Defines.h>
+
+#include <fdm/xml/fdm_XmlNode.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Event-driven scenario script class.
+ *
+ * Script consists of events, each made of trigger conditions evaluated
+ * against DataOut (and script time) and actions setting DataInp values.
+ * Event fires once, when all its conditions have held continuously for its
+ * delay. Actions of fired events override input data every frame from then
+ * on, so they persist even though input data is rebuilt every frame (later
+ * events override earlier ones).
+ *
+ * Variable names are resolved when script is read: conditions are compiled
+ * into a flat predicate table of output data offsets and actions into a flat
+ * table of input data offsets, so update() only compares and copies plain
+ * values and does not allocate.
+ *
+ * XML file format:
+ * @code
+ * <event_script>
+ *   <event name="{ name }">
+ *     [<condition variable="{ output variable }" op="{ lt|le|gt|ge|eq|ne }" [unit="{ unit }"]> { value } </condition>] ... { more conditions }
+ *     [<delay [unit="{ unit }"]> { [s] time conditions have to hold } </delay>]
+ *     <set input="{ input variable }" [unit="{ unit }"]> { value } </set> ... { more actions }
+ *   </event> ... { more events }
+ * </event_script>
+ * @endcode
+ *
+ * Event without conditions fires at the first frame (after its delay).
+ *
+ * Output variables: time (script time), flight data members (e.g.
+ * altitude_agl, ias, climbRate, onGround, stall), crash, and engine data
+ * members prefixed with engine index (e.g. engine_0_rpm, engine_1_state).
+ *
+ * Input variables: environment members (temperature_0, pressure_0,
+ * wind_direction, wind_speed, turbulence, windShear), controls members
+ * (e.g. roll, flaps, lgh), freezePosition, freezeAttitude, freezeVelocity,
+ * and engine members prefixed with engine index (e.g. engine_0_fuel).
+ * Boolean values are true when greater than 0.5.
+ *
+ * Repositioning is not supported, as it requires FDM reinitialization.
+ */
+class FDMEXPORT EventScript
+{
+public:
+
+    /** Comparison operators. */
+    enum Operator
+    {
+        LT = 0,                     ///< less than
+        LE,                         ///< less than or equal
+        GT,                         ///< greater than
+        GE,                         ///< greater than or equal
+        EQ,                         ///< equal
+        NE                          ///< not equal
+    };
+
+    /** Variable types. */
+    enum Type
+    {
+        Time = 0,                   ///< script time (output only)
+        Double,                     ///< double
+        Bool,                       ///< bool
+        Enum                        ///< enumeration
+    };
+
+    /** @brief Constructor. */
+    EventScript();
+
+    /** @brief Destructor. */
+    virtual ~EventScript();
+
+    /**
+     * @brief Reads script from XML file.
+     * @param file script file path
+     */
+    void readFile( const char *file );
+
+    /**
+     * @brief Reads script events from XML node.
+     * @param rootNode node containing event elements
+     */
+    void readData( const XmlNode &rootNode );
+
+    /** @brief Restarts script, none of events is fired. */
+    void reset();
+
+    /**
+     * @brief Evaluates triggers and applies actions of fired events.
+     * Should be called once per frame, before FDM step.
+     * @param timeStep [s] time step
+     * @param dataOut most recent output data
+     * @param dataInp input data to be updated
+     * @return number of events fired in this frame
+     */
+    unsigned int update( double timeStep, const DataOut &dataOut, DataInp *dataInp );
+
+    inline unsigned int getEventsCount() const { return _events.size(); }
+
+    inline const std::string& getName( unsigned int index ) const { return _events[ index ].name; }
+
+    inline bool isFired( unsigned int index ) const { return _events[ index ].fired; }
+
+    /** @return [s] script time event has been fired at */
+    inline double getFiredTime( unsigned int index ) const { return _events[ index ].time; }
+
+    inline double getTime() const { return _time; }
+
+private:
+
+    /** Compiled trigger condition. */
+    struct Predicate
+    {
+        size_t offset;              ///< output data offset
+        Type type;                  ///< variable type
+        Operator op;                ///< comparison operator
+        double value;               ///< reference value
+    };
+
+    /** Compiled action. */
+    struct Action
+    {
+        size_t offset;              ///< input data offset
+        Type type;                  ///< variable type
+        double value;               ///< value
+    };
+
+    /** Event data. */
+    struct Event
+    {
+        std::string name;           ///< event name
+
+        unsigned int predicates_0;  ///< index of the first predicate
+        unsigned int predicates_n;  ///< number of predicates
+        unsigned int actions_0;     ///< index of the first action
+        unsigned int actions_n;     ///< number of actions
+
+        double delay;               ///< [s] time conditions have to hold
+        double timer;               ///< [s] time conditions have been holding
+        double time;                ///< [s] script time event has been fired at
+
+        bool fired;                 ///< specifies if event has been fired
+    };
+
+    std::vector< Predicate > _predicates;   ///< predicates table
+    std::vector< Action > _actions;         ///< actions table
+    std::vector< Event > _events;           ///< events
+
+    std::vector< unsigned int > _pending;   ///< indices of events not fired yet
+    std::vector< unsigned int > _active;    ///< indices of actions of fired events in firing order
+
+    double _time;                           ///< [s] script time
+
+    void readEvent( const XmlNode &eventNode );
+
+    static bool getOutput( const std::string &name, size_t *offset, Type *type );
+    static bool getInput( const std::string &name, size_t *offset, Type *type );
+
+    static bool test( const Predicate &predicate, const DataOut &dataOut, double time );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_EVENTSCRIPT_H
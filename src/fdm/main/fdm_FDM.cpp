@@ -23,6 +23,7 @@
 #include <fdm/main/fdm_FDM.h>
 
 #include <cstring>
+#include <ctime>
 
 #include <fdm/fdm_Exception.h>
 #include <fdm/fdm_Log.h>
@@ -45,7 +46,8 @@ FDM::FDM( const DataInp *dataInpPtr, DataOut *dataOutPtr, bool verbose ) :
     _input ( getInput() ),
 
     _aircraft ( FDM_NULLPTR ),
-    _recorder ( new Recorder( 0.1 ) ),
+    _recorder ( new Recorder( 0.1, true ) ),
+    _logger ( new DataLogger( _input ) ),
 
     _initStep ( 0 ),
 
@@ -71,6 +73,7 @@ FDM::FDM( const DataInp *dataInpPtr, DataOut *dataOutPtr, bool verbose ) :
 
 FDM::~FDM()
 {
+    FDM_DELPTR( _logger );
     FDM_DELPTR( _input );
     FDM_DELPTR( _recorder );
 }
@@ -84,8 +87,19 @@ void FDM::initialize()
     if ( !_initialized )
     {
         _initialized = true;
+
+        // data tree structure is complete when models are created
+        _input->freeze();
+
         initializeRecorder();
+        initializeRandom();
         updateEnvironment();
+
+        if ( _dataInp.environment.windField[ 0 ] != '\0' )
+        {
+            _aircraft->getEnvir()->readWindField( _dataInp.environment.windField );
+        }
+
         _aircraft->initialize( _dataInp.initial.engineOn );
     }
     else
@@ -110,8 +124,17 @@ void FDM::update( double timeStep )
 
     if ( _ready )
     {
+        _recorder->setRate( _dataInp.recording.rate != 0.0 ? _dataInp.recording.rate : 1.0 );
         _recorder->step( timeStep );
 
+        if ( _dataInp.recording.mode == DataInp::Recording::Replay && _dataInp.recording.direct )
+        {
+            // aircraft model is not computed, recorded outputs are replayed directly
+            updateDataOutReplay();
+            (*_dataOutPtr) = _dataOut;
+            return;
+        }
+
         updateEnvironment();
 
         _aircraft->setFreezePosition( _dataInp.freezePosition );
@@ -122,6 +145,8 @@ void FDM::update( double timeStep )
         {
             _aircraft->update( timeStep, !_recorder->isReplaying() );
         }
+
+        _logger->step( timeStep );
     }
 
     updateAndSetDataOut();
@@ -185,6 +210,55 @@ void FDM::printState()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+unsigned int FDM::getStateSize() const
+{
+    StateArchive archive;
+    _aircraft->archiveState( &archive );
+
+    return archive.getSize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FDM::saveState( double *state ) const
+{
+    // saving archive only reads the model
+    StateArchive archive( state );
+    _aircraft->archiveState( &archive );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FDM::restoreState( const double *state )
+{
+    if ( !_initialized ) initialize();
+
+    StateArchive archive( state );
+    _aircraft->archiveState( &archive );
+
+    _ready = true;
+
+    updateAndSetDataOut();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FDM::initializeRandom()
+{
+    UInt64 seed = _dataInp.environment.seed;
+
+#   ifdef FDM_LOCKSTEP
+    // replicas have to draw the same sequences
+    if ( seed == 0 ) seed = FDM_LOCKSTEP_SEED;
+#   else
+    if ( seed == 0 ) seed = (UInt64)time( FDM_NULLPTR );
+#   endif
+
+    _aircraft->getEnvir()->setRandomSeed( seed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void FDM::initializeOnGround()
 {
     if ( _initStep == 0 )
@@ -199,74 +273,30 @@ void FDM::initializeOnGround()
         _init_phi =  0.0;
         _init_tht =  0.0;
         _init_alt = FDM_MIN_INIT_ALTITUDE + _dataInp.ground.elevation;
+
+        // ground normal does not depend on iterated variables
+        _init_n_wgs = _aircraft->getIsect()->getNormal( _dataInp.initial.latitude,
+                                                        _dataInp.initial.longitude,
+                                                        true );
     }
 
     if ( _initStep < FDM_MAX_INIT_STEPS )
     {
+        // finite difference Jacobian perturbations
+        const double dx[] = { 1.0e-5, 1.0e-5, 1.0e-4 };
+
+        // Newton step limits
+        const double dx_max[] = { 0.05, 0.05, 0.5 };
+
         for ( UInt32 i = 0; i < 1000 && !_ready; i++  )
         {
-            Vector3 n_wgs = _aircraft->getIsect()->getNormal( _dataInp.initial.latitude,
-                                                              _dataInp.initial.longitude,
-                                                              true );
-
-            WGS84::Geo pos_geo;
-
-            pos_geo.lat = _dataInp.initial.latitude;
-            pos_geo.lon = _dataInp.initial.longitude;
-            pos_geo.alt = _init_alt;
-
-            Quaternion ned2bas( Angles( _init_phi,
-                                        _init_tht,
-                                        _dataInp.initial.heading ) );
-
-            WGS84 wgs( pos_geo );
-
-            _init_pos_wgs = wgs.getPos_WGS();
-            _init_att_wgs = wgs.getWGS2BAS( ned2bas );
-
-            Aircraft::StateVector stateVector( _aircraft->getStateVect() );
-            Aircraft::StateVector derivVector( _aircraft->getDerivVect() );
-
-            stateVector( Aircraft::_i_x  ) = _init_pos_wgs.x();
-            stateVector( Aircraft::_i_y  ) = _init_pos_wgs.y();
-            stateVector( Aircraft::_i_z  ) = _init_pos_wgs.z();
-            stateVector( Aircraft::_i_e0 ) = _init_att_wgs.e0();
-            stateVector( Aircraft::_i_ex ) = _init_att_wgs.ex();
-            stateVector( Aircraft::_i_ey ) = _init_att_wgs.ey();
-            stateVector( Aircraft::_i_ez ) = _init_att_wgs.ez();
-            stateVector( Aircraft::_i_u  ) = 0.0;
-            stateVector( Aircraft::_i_v  ) = 0.0;
-            stateVector( Aircraft::_i_w  ) = 0.0;
-            stateVector( Aircraft::_i_p  ) = 0.0;
-            stateVector( Aircraft::_i_q  ) = 0.0;
-            stateVector( Aircraft::_i_r  ) = 0.0;
-
-            _aircraft->setStateVector( stateVector );
-            derivVector = _aircraft->getDerivVect();
-
-            double dp_dt = derivVector( Aircraft::_i_p );
-            double dq_dt = derivVector( Aircraft::_i_q );
-            double dn_dt = ( _aircraft->getWGS2BAS() * n_wgs )
-                         * Vector3( derivVector( Aircraft::_i_u ),
-                                    derivVector( Aircraft::_i_v ),
-                                    derivVector( Aircraft::_i_w ) );
-
-            // attitude updating only on the ground
-            if ( _aircraft->getGear()->getFor_BAS().getLength2() > 0.0 )
-            {
-                _init_phi += dp_dt * _init_g_coef_p;
-                _init_tht += dq_dt * _init_g_coef_q;
-                _init_alt += dn_dt * _init_g_coef_n;
-            }
-            else
-            {
-                _init_alt += dn_dt * _init_g_coef_n;
-            }
+            Vector3 res;
+            bool onGround = getInitResiduals( _init_phi, _init_tht, _init_alt, &res );
 
             if ( _init_alt > 0.0
-              && fabs( dp_dt ) < 1.0e-3
-              && fabs( dq_dt ) < 1.0e-3
-              && fabs( dn_dt ) < 1.0e-3 )
+              && fabs( res.x() ) < 1.0e-3
+              && fabs( res.y() ) < 1.0e-3
+              && fabs( res.z() ) < 1.0e-3 )
             {
                 _ready = true;
 
@@ -275,10 +305,97 @@ void FDM::initializeOnGround()
                     Log::i() << "On-ground initialization finished in " << _initStep << " steps" << std::endl;
                     printState();
                 }
+
+                break;
             }
-            else
+
+            _initStep++;
+
+            bool newton = false;
+
+            // Newton iteration only on the ground, in the air residuals do not
+            // depend on attitude and its Jacobian is singular
+            if ( onGround )
             {
-                _initStep++;
+                double x0[] = { _init_phi, _init_tht, _init_alt };
+
+                Vector3 jac[ 3 ];
+
+                for ( int k = 0; k < 3; k++ )
+                {
+                    double x[] = { x0[ 0 ], x0[ 1 ], x0[ 2 ] };
+                    x[ k ] += dx[ k ];
+
+                    Vector3 res_k;
+                    getInitResiduals( x[ 0 ], x[ 1 ], x[ 2 ], &res_k );
+                    _initStep++;
+
+                    jac[ k ] = ( res_k - res ) / dx[ k ];
+                }
+
+                double det = jac[ 0 ] * ( jac[ 1 ] % jac[ 2 ] );
+                double det_ref = jac[ 0 ].getLength() * jac[ 1 ].getLength() * jac[ 2 ].getLength();
+
+                if ( fabs( det ) > 1.0e-9 * det_ref )
+                {
+                    // Cramer's rule, J * delta = -res
+                    double delta[ 3 ];
+
+                    delta[ 0 ] = -( res * ( jac[ 1 ] % jac[ 2 ] ) ) / det;
+                    delta[ 1 ] = -( jac[ 0 ] * ( res % jac[ 2 ] ) ) / det;
+                    delta[ 2 ] = -( jac[ 0 ] * ( jac[ 1 ] % res ) ) / det;
+
+                    double scale = 1.0;
+
+                    for ( int k = 0; k < 3; k++ )
+                    {
+                        if ( fabs( delta[ k ] ) * scale > dx_max[ k ] )
+                        {
+                            scale = dx_max[ k ] / fabs( delta[ k ] );
+                        }
+                    }
+
+                    // backtracking, residual norm has to decrease
+                    double res_norm = res.getLength();
+
+                    for ( int j = 0; j < 4 && !newton; j++ )
+                    {
+                        double phi = x0[ 0 ] + scale * delta[ 0 ];
+                        double tht = x0[ 1 ] + scale * delta[ 1 ];
+                        double alt = x0[ 2 ] + scale * delta[ 2 ];
+
+                        Vector3 res_new;
+                        getInitResiduals( phi, tht, alt, &res_new );
+                        _initStep++;
+
+                        if ( res_new.getLength() < res_norm )
+                        {
+                            _init_phi = phi;
+                            _init_tht = tht;
+                            _init_alt = alt;
+
+                            newton = true;
+                        }
+
+                        scale *= 0.5;
+                    }
+                }
+            }
+
+            // fixed-gain iteration when Newton step is not available
+            if ( !newton )
+            {
+                // attitude updating only on the ground
+                if ( onGround )
+                {
+                    _init_phi += res.x() * _init_g_coef_p;
+                    _init_tht += res.y() * _init_g_coef_q;
+                    _init_alt += res.z() * _init_g_coef_n;
+                }
+                else
+                {
+                    _init_alt += res.z() * _init_g_coef_n;
+                }
             }
         }
     }
@@ -337,6 +454,53 @@ void FDM::initializeInFlight()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool FDM::getInitResiduals( double phi, double tht, double alt, Vector3 *res )
+{
+    WGS84::Geo pos_geo;
+
+    pos_geo.lat = _dataInp.initial.latitude;
+    pos_geo.lon = _dataInp.initial.longitude;
+    pos_geo.alt = alt;
+
+    Quaternion ned2bas( Angles( phi, tht, _dataInp.initial.heading ) );
+
+    WGS84 wgs( pos_geo );
+
+    _init_pos_wgs = wgs.getPos_WGS();
+    _init_att_wgs = wgs.getWGS2BAS( ned2bas );
+
+    Aircraft::StateVector stateVector( _aircraft->getStateVect() );
+
+    stateVector( Aircraft::_i_x  ) = _init_pos_wgs.x();
+    stateVector( Aircraft::_i_y  ) = _init_pos_wgs.y();
+    stateVector( Aircraft::_i_z  ) = _init_pos_wgs.z();
+    stateVector( Aircraft::_i_e0 ) = _init_att_wgs.e0();
+    stateVector( Aircraft::_i_ex ) = _init_att_wgs.ex();
+    stateVector( Aircraft::_i_ey ) = _init_att_wgs.ey();
+    stateVector( Aircraft::_i_ez ) = _init_att_wgs.ez();
+    stateVector( Aircraft::_i_u  ) = 0.0;
+    stateVector( Aircraft::_i_v  ) = 0.0;
+    stateVector( Aircraft::_i_w  ) = 0.0;
+    stateVector( Aircraft::_i_p  ) = 0.0;
+    stateVector( Aircraft::_i_q  ) = 0.0;
+    stateVector( Aircraft::_i_r  ) = 0.0;
+
+    _aircraft->setStateVector( stateVector );
+
+    const Aircraft::StateVector &derivVector = _aircraft->getDerivVect();
+
+    res->x() = derivVector( Aircraft::_i_p );
+    res->y() = derivVector( Aircraft::_i_q );
+    res->z() = ( _aircraft->getWGS2BAS() * _init_n_wgs )
+             * Vector3( derivVector( Aircraft::_i_u ),
+                        derivVector( Aircraft::_i_v ),
+                        derivVector( Aircraft::_i_w ) );
+
+    return _aircraft->getGear()->getFor_BAS().getLength2() > 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void FDM::initializeRecorder()
 {
     // state
@@ -578,6 +742,44 @@ void FDM::updateAndSetDataInp()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void FDM::updateDataOutReplay()
+{
+    // flight data recorded variables are interpolated by the recorder
+    // into output data directly, pose is taken from the recorded state
+    const Aircraft::StateVector &stateVect = _aircraft->getStateVect();
+
+    _dataOut.flight.pos_x_wgs = stateVect( Aircraft::_i_x );
+    _dataOut.flight.pos_y_wgs = stateVect( Aircraft::_i_y );
+    _dataOut.flight.pos_z_wgs = stateVect( Aircraft::_i_z );
+
+    Quaternion att_wgs( stateVect( Aircraft::_i_e0 ),
+                        stateVect( Aircraft::_i_ex ),
+                        stateVect( Aircraft::_i_ey ),
+                        stateVect( Aircraft::_i_ez ) );
+
+    // interpolated quaternion is no longer normalized
+    att_wgs.normalize();
+
+    _dataOut.flight.att_e0_wgs = att_wgs.e0();
+    _dataOut.flight.att_ex_wgs = att_wgs.ex();
+    _dataOut.flight.att_ey_wgs = att_wgs.ey();
+    _dataOut.flight.att_ez_wgs = att_wgs.ez();
+
+    _dataOut.flight.vel_u_bas = stateVect( Aircraft::_i_u );
+    _dataOut.flight.vel_v_bas = stateVect( Aircraft::_i_v );
+    _dataOut.flight.vel_w_bas = stateVect( Aircraft::_i_w );
+
+    _dataOut.flight.omg_p_bas = stateVect( Aircraft::_i_p );
+    _dataOut.flight.omg_q_bas = stateVect( Aircraft::_i_q );
+    _dataOut.flight.omg_r_bas = stateVect( Aircraft::_i_r );
+
+    _dataOut.flight.rollRate  = _dataOut.flight.omg_p_bas;
+    _dataOut.flight.pitchRate = _dataOut.flight.omg_q_bas;
+    _dataOut.flight.yawRate   = _dataOut.flight.omg_r_bas;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void FDM::updateAndSetDataOut()
 {
     ///////////////////////////////////////////
@@ -593,9 +795,12 @@ void FDM::updateEnvironment()
     {
         _aircraft->getEnvir()->setTemperatureSL( _dataInp.environment.temperature_0 );
         _aircraft->getEnvir()->setPressureSL( _dataInp.environment.pressure_0 );
+        _aircraft->getEnvir()->setAtmosphereTableMode( _dataInp.environment.atmosphereTable );
 
         _aircraft->getEnvir()->setWindDirection( _dataInp.environment.wind_direction );
         _aircraft->getEnvir()->setWindSpeed( _dataInp.environment.wind_speed );
+
+        _aircraft->getEnvir()->setTurbulence( (Turbulence::Intensity)_dataInp.environment.turbulence );
     }
 }
 
@@ -28,6 +28,7 @@
 #include <fdm/fdm_DataOut.h>
 
 #include <fdm/main/fdm_Aircraft.h>
+#include <fdm/main/fdm_DataLogger.h>
 #include <fdm/main/fdm_Recorder.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,12 +59,43 @@ public:
     /** */
     virtual void printState();
 
+    /**
+     * @brief Returns number of values needed to save state.
+     * @return number of values
+     */
+    virtual unsigned int getStateSize() const;
+
+    /**
+     * @brief Saves flight dynamics model state.
+     * State consists of the aircraft state vector, the environment (random
+     * number generators and turbulence sequences), intersections and all
+     * the modules internal states (e.g. rotor blades flapping, dynamic
+     * inflow, engines, control filters, wheels). It is a plain array, so it
+     * might be copied with memcpy and restored in the same or another
+     * instance of the same aircraft type (e.g. to branch simulation from
+     * a warmed-up trim). Terrain cache is not a part of the state.
+     * @param state output array of getStateSize() values
+     */
+    virtual void saveState( double *state ) const;
+
+    /**
+     * @brief Restores flight dynamics model state saved with saveState().
+     * Flight dynamics model is kept ready, no initialization is performed.
+     * @param state array of getStateSize() values
+     */
+    virtual void restoreState( const double *state );
+
     inline DataOut::Crash getCrash() const { return _aircraft->getCrash(); }
 
     inline bool isReady() const { return _ready; }
 
+    inline const Aircraft* getAircraft() const { return _aircraft; }
+
     inline bool isReplaying() const { return _recorder->isReplaying(); }
 
+    /** @return data logger, channels should be subscribed before opening */
+    inline DataLogger* getLogger() { return _logger; }
+
 protected:
 
     /** Data references. */
@@ -142,10 +174,13 @@ protected:
 
     Aircraft *_aircraft;                            ///< aircraft model
     Recorder *_recorder;                            ///< recorder object
+    DataLogger *_logger;                            ///< data logger object
 
     Vector3    _init_pos_wgs;                       ///< [m] initial position expressed in WGS
     Quaternion _init_att_wgs;                       ///< initial attitude expressed as quaternion of rotation from WGS to BAS
 
+    Vector3 _init_n_wgs;                            ///< ground normal at initial position expressed in WGS
+
     UInt32 _initStep;                               ///< initialization step number
 
     double _init_g_coef_p;                          ///< initialization iteration coefficient
@@ -163,7 +198,20 @@ protected:
     virtual void initializeOnGround();
     virtual void initializeInFlight();
 
+    /**
+     * @brief Computes on-ground initialization residuals.
+     * Sets aircraft state for the given attitude and altitude and computes
+     * roll and pitch accelerations and acceleration along ground normal.
+     * @param phi [rad] roll angle
+     * @param tht [rad] pitch angle
+     * @param alt [m] altitude
+     * @param res [rad/s^2],[rad/s^2],[m/s^2] residuals
+     * @return true if aircraft touches the ground
+     */
+    virtual bool getInitResiduals( double phi, double tht, double alt, Vector3 *res );
+
     virtual void initializeRecorder();
+    virtual void initializeRandom();
 
     virtual void updateDataInp();
     virtual void updateDataOut();
@@ -171,6 +219,14 @@ protected:
     virtual void updateAndSetDataInp();
     virtual void updateAndSetDataOut();
 
+    /**
+     * @brief Updates output data when replaying recorded outputs directly.
+     * Only pose and velocities are set from the replayed state vector, other
+     * recorded flight data are interpolated into output data by the recorder,
+     * output data which are not recorded keep values of the last computed step.
+     */
+    void updateDataOutReplay();
+
     virtual void updateEnvironment();
 
     virtual void updateInitialPositionAndAttitude();
@@ -23,11 +23,13 @@
 #include <fdm/main/fdm_Intersections.h>
 
 #ifdef SIM_INTERSECTIONS
+#   include <vector>
 #   include <cgi/cgi_Intersections.h>
 #   include <cgi/cgi_WGS84.h>
 #endif
 
 #include <fdm/utils/fdm_Geom.h>
+#include <fdm/utils/fdm_Metrics.h>
 #include <fdm/utils/fdm_WGS84.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,18 +38,163 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+/** Intersects segment with the ground plane. */
+bool getPlaneIntersection( const Vector3 &b, const Vector3 &e,
+                           const Vector3 &ground, const Vector3 &normal,
+                           Vector3 *r, Vector3 *n )
+{
+    double num = normal * ( ground - b );
+    double den = normal * ( e - b );
+
+    if ( fabs( den ) > 10e-15 )
+    {
+        double u = num / den;
+
+        if ( 0.0 < u && u < 1.0 )
+        {
+            (*r) = b + u * ( e - b );
+            (*n) = normal;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_INTERSECTIONS
+/** Scenery terrain sampler. */
+class ScenerySampler : public TerrainCache::Sampler
+{
+public:
+
+    bool sample( double lat, double lon, double *elev, Vector3 *norm_wgs )
+    {
+        char valid = 0;
+        sampleMany( 1, &lat, &lon, elev, norm_wgs, &valid );
+        return valid != 0;
+    }
+
+    void sampleMany( unsigned int count,
+                     const double *lat, const double *lon,
+                     double *elev, Vector3 *norm_wgs, char *valid )
+    {
+        _segments.resize( count );
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            Vector3 b_wgs = WGS84::geo2wgs( lat[ i ], lon[ i ],  10000.0 );
+            Vector3 e_wgs = WGS84::geo2wgs( lat[ i ], lon[ i ], -1000.0 );
+
+            _segments[ i ].b = osg::Vec3d( b_wgs.x(), b_wgs.y(), b_wgs.z() );
+            _segments[ i ].e = osg::Vec3d( e_wgs.x(), e_wgs.y(), e_wgs.z() );
+        }
+
+        cgi::Intersections::instance()->findFirst( &_segments[ 0 ], count );
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            const cgi::Intersections::Segment &s = _segments[ i ];
+
+            valid[ i ] = s.hit ? 1 : 0;
+
+            if ( s.hit )
+            {
+                elev[ i ] = WGS84::wgs2geo( Vector3( s.r.x(), s.r.y(), s.r.z() ) ).alt;
+                norm_wgs[ i ] = Vector3( s.n.x(), s.n.y(), s.n.z() );
+            }
+        }
+    }
+
+private:
+
+    std::vector< cgi::Intersections::Segment > _segments;
+};
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 Intersections::Intersections() :
+    _cache ( FDM_NULLPTR ),
     _inited ( false )
-{}
+{
+#   if defined(SIM_INTERSECTIONS) && !defined(FDM_LOCKSTEP)
+    // cache is filled by the background thread, so elevations available at
+    // the given step depend on timing, lockstep replicas query scenery directly
+    _cache = new TerrainCache( new ScenerySampler() );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Intersections::~Intersections()
+{
+    FDM_DELPTR( _cache );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Intersections::~Intersections() {}
+void Intersections::update( double lat, double lon, const Vector3 &vel_ned )
+{
+    _collision.update();
+
+    updateTerrain( lat, lon, vel_ned );
+
+    if ( !_collision.isEmpty() )
+    {
+        Vector3 b_wgs = WGS84::geo2wgs( lat, lon,  10000.0 );
+        Vector3 e_wgs = WGS84::geo2wgs( lat, lon, -1000.0 );
+
+        double u = 0.0;
+        Vector3 n_wgs;
+
+        if ( _collision.getIntersection( b_wgs, e_wgs, &u, &n_wgs ) )
+        {
+            Vector3 r_wgs = b_wgs + u * ( e_wgs - b_wgs );
+
+            if ( !_inited || Vector3( r_wgs - b_wgs ).getLength2() < Vector3( _ground_wgs - b_wgs ).getLength2() )
+            {
+                _inited = true;
+
+                _ground_wgs = r_wgs;
+                _normal_wgs = n_wgs;
+            }
+        }
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Intersections::update( double lat, double lon )
+void Intersections::updateTerrain( double lat, double lon, const Vector3 &vel_ned )
 {
+    if ( _cache )
+    {
+        _cache->update( lat, lon, vel_ned.x(), vel_ned.y() );
+
+        double elev = 0.0;
+        Vector3 norm;
+
+        if ( _cache->getElevation( lat, lon, &elev, &norm ) )
+        {
+            _inited = true;
+
+            _ground_wgs = WGS84::geo2wgs( lat, lon, elev );
+            _normal_wgs = norm;
+
+            return;
+        }
+
+        // keeping the most recent ground plane instead of waiting for scenery
+        if ( _cache->isReady() && _inited ) return;
+    }
+
 #   ifdef SIM_INTERSECTIONS
     cgi::WGS84 wgs_b( lat, lon, 10000.0 );
     cgi::WGS84 wgs_e( lat, lon, -1000.0 );
@@ -108,6 +255,68 @@ double Intersections::getElevation( double lat, double lon ) const
 int Intersections::getIntersection( const Vector3 &b, const Vector3 &e,
                                     Vector3 *r, Vector3 *n, bool update ) const
 {
+    FDM_METRICS_ZONE( "fdm.ground_query" );
+
+    int result = getTerrainIntersection( b, e, r, n, update );
+
+    double u = 0.0;
+    Vector3 n_msh;
+
+    if ( _collision.getIntersection( b, e, &u, &n_msh ) )
+    {
+        Vector3 r_msh = b + u * ( e - b );
+
+        if ( result != FDM_SUCCESS || Vector3( r_msh - b ).getLength2() < Vector3( (*r) - b ).getLength2() )
+        {
+            (*r) = r_msh;
+            (*n) = n_msh;
+
+            result = FDM_SUCCESS;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Intersections::getTerrainIntersection( const Vector3 &b, const Vector3 &e,
+                                           Vector3 *r, Vector3 *n, bool update ) const
+{
+    if ( update && _cache )
+    {
+        WGS84::Geo e_geo = WGS84::wgs2geo( e );
+
+        double elev = 0.0;
+        Vector3 norm;
+
+        if ( _cache->getElevation( e_geo.lat, e_geo.lon, &elev, &norm ) )
+        {
+            Vector3 ground_wgs = WGS84::geo2wgs( e_geo.lat, e_geo.lon, elev );
+
+            double num = norm * ( ground_wgs - b );
+            double den = norm * ( e - b );
+
+            if ( fabs( den ) > 10e-15 )
+            {
+                double u = num / den;
+
+                if ( 0.0 < u && u < 1.0 )
+                {
+                    (*r) = b + u * ( e - b );
+                    (*n) = norm;
+
+                    return FDM_SUCCESS;
+                }
+            }
+
+            return FDM_FAILURE;
+        }
+
+        // using the most recent ground plane instead of waiting for scenery
+        if ( _cache->isReady() && _inited ) update = false;
+    }
+
 #   ifdef SIM_INTERSECTIONS
     if ( update )
     {
@@ -151,6 +360,138 @@ int Intersections::getIntersection( const Vector3 &b, const Vector3 &e,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+unsigned int Intersections::getIntersections( unsigned int count,
+                                              const Vector3 *b, const Vector3 *e,
+                                              Vector3 *r, Vector3 *n, char *hit,
+                                              bool update, Vector3 *v ) const
+{
+    FDM_METRICS_ZONE( "fdm.ground_query" );
+
+    unsigned int hits = 0;
+
+    if ( v )
+    {
+        for ( unsigned int i = 0; i < count; i++ ) v[ i ].zeroize();
+    }
+
+#   ifdef SIM_INTERSECTIONS
+    std::vector< cgi::Intersections::Segment > segments;
+    std::vector< unsigned int > indices;
+#   endif
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        hit[ i ] = 0;
+
+        bool scenery = update;
+
+        if ( update && _cache )
+        {
+            WGS84::Geo e_geo = WGS84::wgs2geo( e[ i ] );
+
+            double elev = 0.0;
+            Vector3 norm;
+
+            if ( _cache->getElevation( e_geo.lat, e_geo.lon, &elev, &norm ) )
+            {
+                Vector3 ground_wgs = WGS84::geo2wgs( e_geo.lat, e_geo.lon, elev );
+
+                if ( getPlaneIntersection( b[ i ], e[ i ], ground_wgs, norm, &r[ i ], &n[ i ] ) )
+                {
+                    hit[ i ] = 1;
+                    hits++;
+                }
+
+                continue;
+            }
+
+            // using the most recent ground plane instead of waiting for scenery
+            if ( _cache->isReady() && _inited ) scenery = false;
+        }
+
+#       ifdef SIM_INTERSECTIONS
+        if ( scenery )
+        {
+            cgi::Intersections::Segment segment;
+
+            segment.b = osg::Vec3d( b[ i ].x(), b[ i ].y(), b[ i ].z() );
+            segment.e = osg::Vec3d( e[ i ].x(), e[ i ].y(), e[ i ].z() );
+            segment.hit = false;
+
+            segments.push_back( segment );
+            indices.push_back( i );
+
+            continue;
+        }
+#       else
+        (void)scenery;
+#       endif
+
+        if ( _inited )
+        {
+            if ( getPlaneIntersection( b[ i ], e[ i ], _ground_wgs, _normal_wgs, &r[ i ], &n[ i ] ) )
+            {
+                hit[ i ] = 1;
+                hits++;
+            }
+        }
+    }
+
+#   ifdef SIM_INTERSECTIONS
+    if ( segments.size() > 0 )
+    {
+        cgi::Intersections::instance()->findFirst( &segments[ 0 ], segments.size() );
+
+        for ( unsigned int j = 0; j < segments.size(); j++ )
+        {
+            const cgi::Intersections::Segment &s = segments[ j ];
+
+            if ( s.hit )
+            {
+                unsigned int i = indices[ j ];
+
+                r[ i ] = Vector3( s.r.x(), s.r.y(), s.r.z() );
+                n[ i ] = Vector3( s.n.x(), s.n.y(), s.n.z() );
+
+                hit[ i ] = 1;
+                hits++;
+            }
+        }
+    }
+#   endif
+
+    if ( !_collision.isEmpty() )
+    {
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            double u = 0.0;
+            Vector3 n_msh;
+            Vector3 v_msh;
+
+            if ( _collision.getIntersection( b[ i ], e[ i ], &u, &n_msh, &v_msh ) )
+            {
+                Vector3 r_msh = b[ i ] + u * ( e[ i ] - b[ i ] );
+
+                if ( !hit[ i ] || Vector3( r_msh - b[ i ] ).getLength2() < Vector3( r[ i ] - b[ i ] ).getLength2() )
+                {
+                    if ( !hit[ i ] ) hits++;
+
+                    r[ i ] = r_msh;
+                    n[ i ] = n_msh;
+
+                    if ( v ) v[ i ] = v_msh;
+
+                    hit[ i ] = 1;
+                }
+            }
+        }
+    }
+
+    return hits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool Intersections::isIntersection( const Vector3 &b, const Vector3 &e,
                                     bool update ) const
 {
@@ -204,3 +545,15 @@ Vector3 Intersections::getNormal( double lat, double lon, bool update ) const
         return WGS84( b_wgs ).getNorm_WGS();
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Intersections::archiveState( StateArchive *archive )
+{
+    _collision.archiveState( archive );
+
+    archive->add( &_inited );
+
+    archive->add( &_ground_wgs );
+    archive->add( &_normal_wgs );
+}
@@ -24,6 +24,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/main/fdm_CollisionGeometry.h>
+#include <fdm/main/fdm_TerrainCache.h>
+
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,8 +38,18 @@ namespace fdm
 
 /**
  * @brief Intersections interface class.
+ *
+ * Besides terrain, all queries test collision meshes of the collision
+ * geometry library, the intersection closer to the segment beginning wins.
+ * Collision meshes are tested exactly and do not depend on CGI, so they are
+ * available in headless and batch runs as well. Moving platforms (e.g. ship
+ * decks) are moved by step() and getIntersections() returns their velocity
+ * at intersection points, so landing gear forces depend on velocity relative
+ * to the deck.
+ *
+ * @see CollisionGeometry
  */
-class FDMEXPORT Intersections
+class FDMEXPORT Intersections : public ArenaObject
 {
 public:
 
@@ -44,8 +59,25 @@ public:
     /** @brief Destructor. */
     virtual ~Intersections();
 
-    /** */
-    virtual void update( double lat, double lon );
+    /**
+     * @brief Updates ground intersection data.
+     * If terrain cache covers given location it is used instead of querying
+     * scenery. Once the cache is ready scenery is never queried directly,
+     * if location is not covered the most recent ground plane is kept.
+     * Collision mesh above terrain replaces terrain ground plane.
+     * @param lat [rad] ownship latitude
+     * @param lon [rad] ownship longitude
+     * @param vel_ned [m/s] ownship velocity expressed in NED used to predict
+     * ownship position for terrain cache
+     */
+    virtual void update( double lat, double lon,
+                         const Vector3 &vel_ned = Vector3() );
+
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
 
     /**
      * @brief Returns ground elevation above mean sea level.
@@ -61,12 +93,35 @@ public:
      * @param e [m] end of intersection line expressed in WGS
      * @param r [m] intersection point coordinates expressed in WGS
      * @param n [-] intersection normal vector expressed in WGS
-     * @param update specifies if ground intersection data should be updated
+     * @param update specifies if ground intersection data should be updated,
+     * if terrain cache covers segment end local terrain plane is used instead,
+     * if cache is ready but does not cover it the most recent plane is used
      * @return FDM_SUCCESS on success or FDM_FAILURE on failure
      */
     virtual int getIntersection( const Vector3 &b, const Vector3 &e,
                                  Vector3 *r, Vector3 *n, bool update = false ) const;
 
+    /**
+     * @brief Gets intersections of multiple segments.
+     * Segments are resolved the same way as in getIntersection(), but those
+     * which require scenery query are tested in a single scenery traversal.
+     * @param count number of segments
+     * @param b [m] array of beginnings of intersection lines expressed in WGS
+     * @param e [m] array of ends of intersection lines expressed in WGS
+     * @param r [m] array of intersection points coordinates expressed in WGS
+     * @param n [-] array of intersection normal vectors expressed in WGS
+     * @param hit array of flags set to 1 if intersection was found, 0 otherwise
+     * @param update specifies if ground intersection data should be updated
+     * @param v [m/s] array of intersection points velocities expressed in WGS
+     * (optional), non-zero only for moving platforms (e.g. ship decks)
+     * @return number of segments which intersect ground
+     */
+    virtual unsigned int getIntersections( unsigned int count,
+                                           const Vector3 *b, const Vector3 *e,
+                                           Vector3 *r, Vector3 *n, char *hit,
+                                           bool update = false,
+                                           Vector3 *v = FDM_NULLPTR ) const;
+
     /**
      * @brief Checks intersection.
      * @param b [m] beginning of intersection line expressed in WGS
@@ -86,15 +141,38 @@ public:
      */
     virtual Vector3 getNormal( double lat, double lon, bool update = false ) const;
 
+    /**
+     * @brief Advances collision geometry time, moves platforms (e.g. ships).
+     * @param timeStep [s] time step
+     */
+    inline void step( double timeStep ) { _collision.step( timeStep ); }
+
     void setGroundWGS( const Vector3 &ground_wgs ) { _ground_wgs = ground_wgs; }
     void setNormalWGS( const Vector3 &normal_wgs ) { _normal_wgs = normal_wgs; }
 
 protected:
 
+    CollisionGeometry _collision;   ///< collision meshes
+
+    TerrainCache *_cache;       ///< terrain cache
+
     bool _inited;               ///< specifies if intersections are initialized
 
     Vector3 _ground_wgs;        ///< [m] ground intersection expressed in WGS
     Vector3 _normal_wgs;        ///< ground normal vector
+
+    /**
+     * @brief Updates terrain ground intersection data.
+     * @see update()
+     */
+    void updateTerrain( double lat, double lon, const Vector3 &vel_ned );
+
+    /**
+     * @brief Gets terrain intersection.
+     * @see getIntersection()
+     */
+    int getTerrainIntersection( const Vector3 &b, const Vector3 &e,
+                                Vector3 *r, Vector3 *n, bool update ) const;
 };
 
 } // end of fdm namespace
@@ -32,6 +32,11 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const double LandingGear::_sleepBand = 2.0;
+const double LandingGear::_sleepTime = 2.0;
+
+////////////////////////////////////////////////////////////////////////////////
+
 LandingGear::LandingGear( const Aircraft *aircraft, Input *input ) :
     Module ( aircraft, input ),
 
@@ -45,7 +50,13 @@ LandingGear::LandingGear( const Aircraft *aircraft, Input *input ) :
     _antiskid ( false ),
     _steering ( false ),
 
-    _onGround ( false )
+    _onGround ( false ),
+
+    _reach ( 0.0 ),
+    _agl_prev ( 0.0 ),
+    _agl_rate ( 0.0 ),
+
+    _agl_valid ( false )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -76,12 +87,37 @@ void LandingGear::update()
 {
     _onGround = _for_bas.getLength2() > 0.0;
 
+    double agl = _aircraft->getAltitude_AGL();
+
+    _agl_rate = 0.0;
+
+    if ( _agl_valid && getUpdateTimeStep() > 0.0 )
+    {
+        _agl_rate = ( agl - _agl_prev ) / getUpdateTimeStep();
+    }
+
+    _agl_prev  = agl;
+    _agl_valid = true;
+
     _antiskid = _inputABS.getDatab();
     _steering = _inputNWS.getDatab();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool LandingGear::isSleeping() const
+{
+    double descent = -_aircraft->getClimbRate();
+    if ( -_agl_rate > descent ) descent = -_agl_rate;
+    if ( descent < 0.0 ) descent = 0.0;
+
+    double band = _sleepBand + descent * _sleepTime;
+
+    return _aircraft->getAltitude_AGL() - _reach > band;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool LandingGear::getIsect( const Vector3 &r_a_bas, const Vector3 &r_u_bas,
                             Vector3 *r_c_bas, Vector3 *n_c_bas )
 {
@@ -124,6 +160,12 @@ int LandingGear::readWheelsData( XmlNode &dataNode, Wheels &wheels )
         wheelAndInput.input = getDataRef( input );
         wheelAndInput.wheel.readData( wheelNode );
 
+        double reach_a = wheelAndInput.wheel.getRa_BAS().getLength();
+        double reach_u = wheelAndInput.wheel.getRu_BAS().getLength();
+
+        if ( reach_a > _reach ) _reach = reach_a;
+        if ( reach_u > _reach ) _reach = reach_u;
+
         result = wheels.addItem( name, wheelAndInput );
 
         wheelNode = wheelNode.getNextSiblingElement( "wheel" );
@@ -131,3 +173,169 @@ int LandingGear::readWheelsData( XmlNode &dataNode, Wheels &wheels )
 
     return result;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LandingGear::updateContacts( Wheels &wheels, bool extendedOnly )
+{
+    _contacts.wheels.clear();
+
+    for ( Wheels::iterator it = wheels.begin(); it != wheels.end(); ++it )
+    {
+        Wheel *wheel = &( (*it).second.wheel );
+
+        if ( !extendedOnly || wheel->getPosition() >= 1.0 )
+        {
+            _contacts.wheels.push_back( wheel );
+        }
+    }
+
+    const unsigned int count = _contacts.wheels.size();
+
+    _contacts.b_wgs   .resize( count );
+    _contacts.e_wgs   .resize( count );
+    _contacts.r_wgs   .resize( count );
+    _contacts.n_wgs   .resize( count );
+    _contacts.v_wgs   .resize( count );
+    _contacts.r_c_bas .resize( count );
+    _contacts.n_c_bas .resize( count );
+    _contacts.v_c_bas .resize( count );
+    _contacts.hit     .resize( count );
+
+    if ( count == 0 ) return;
+
+    const Matrix3x3 &bas2wgs = _aircraft->getBAS2WGS();
+    const Matrix3x3 &wgs2bas = _aircraft->getWGS2BAS();
+    const Vector3   &pos_wgs = _aircraft->getPos_WGS();
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        _contacts.b_wgs[ i ] = bas2wgs * _contacts.wheels[ i ]->getRa_BAS() + pos_wgs;
+        _contacts.e_wgs[ i ] = bas2wgs * _contacts.wheels[ i ]->getRu_BAS() + pos_wgs;
+    }
+
+    _aircraft->getIsect()->getIntersections( count,
+                                             &_contacts.b_wgs[ 0 ],
+                                             &_contacts.e_wgs[ 0 ],
+                                             &_contacts.r_wgs[ 0 ],
+                                             &_contacts.n_wgs[ 0 ],
+                                             &_contacts.hit[ 0 ],
+                                             true,
+                                             &_contacts.v_wgs[ 0 ] );
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        if ( _contacts.hit[ i ] )
+        {
+            _contacts.r_c_bas[ i ] = wgs2bas * ( _contacts.r_wgs[ i ] - pos_wgs );
+            _contacts.n_c_bas[ i ] = wgs2bas * _contacts.n_wgs[ i ];
+            _contacts.v_c_bas[ i ] = _aircraft->getVel_BAS() - wgs2bas * _contacts.v_wgs[ i ];
+        }
+        else
+        {
+            _contacts.r_c_bas[ i ] = _contacts.wheels[ i ]->getRu_BAS();
+            _contacts.n_c_bas[ i ].zeroize();
+            _contacts.v_c_bas[ i ] = _aircraft->getVel_BAS();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LandingGear::computeWheelsForceAndMoment( Wheels &wheels )
+{
+    if ( isSleeping() )
+    {
+        _contacts.wheels.clear();
+        return;
+    }
+
+    updateContacts( wheels, true );
+
+#   ifdef FDM_IMPLICIT_CONTACT
+    unsigned int hits = 0;
+
+    for ( unsigned int i = 0; i < _contacts.hit.size(); i++ )
+    {
+        if ( _contacts.hit[ i ] ) hits++;
+    }
+
+    // aircraft mass is shared by the wheels in contact
+    double mass = hits > 0 ? _aircraft->getMass()->getMass() / hits : 0.0;
+#   endif
+
+    for ( unsigned int i = 0; i < _contacts.wheels.size(); i++ )
+    {
+        Wheel *wheel = _contacts.wheels[ i ];
+
+#       ifdef FDM_IMPLICIT_CONTACT
+        wheel->setImplicitContact( mass, _aircraft->getTimeStep(), _aircraft->getGrav_BAS() );
+#       endif
+
+        wheel->computeForceAndMoment( _contacts.v_c_bas[ i ],
+                                      _aircraft->getOmg_BAS(),
+                                      _contacts.r_c_bas[ i ],
+                                      _contacts.n_c_bas[ i ],
+                                      _steering, _antiskid );
+
+        _for_bas += wheel->getFor_BAS();
+        _mom_bas += wheel->getMom_BAS();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LandingGear::integrateWheels( Wheels &wheels )
+{
+    // wheels state changes only while in contact with the ground
+    if ( isSleeping() ) return;
+
+    updateContacts( wheels, false );
+
+    for ( unsigned int i = 0; i < _contacts.wheels.size(); i++ )
+    {
+        _contacts.wheels[ i ]->integrate( getUpdateTimeStep(),
+                                          _contacts.v_c_bas[ i ],
+                                          _aircraft->getOmg_BAS(),
+                                          _contacts.r_c_bas[ i ],
+                                          _contacts.n_c_bas[ i ],
+                                          _steering );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LandingGear::archiveState( StateArchive *archive )
+{
+    Module::archiveState( archive );
+
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_ctrlAngle );
+
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+
+    archive->add( &_position );
+
+    archive->add( &_antiskid );
+    archive->add( &_steering );
+
+    archive->add( &_onGround );
+
+    archive->add( &_agl_prev );
+    archive->add( &_agl_rate );
+
+    archive->add( &_agl_valid );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void LandingGear::archiveWheels( StateArchive *archive, Wheels &wheels )
+{
+    for ( Wheels::iterator it = wheels.begin(); it != wheels.end(); ++it )
+    {
+        (*it).second.wheel.archiveState( archive );
+    }
+}
@@ -39,6 +39,15 @@ namespace fdm
 
 /**
  * @brief Landing gear base class.
+ *
+ * Wheels computations are skipped while the aircraft is well above the
+ * ground. Landing gear sleeps when altitude above ground level exceeds the
+ * longest wheel reach (the distance from the center of gravity to the
+ * furthest strut point) by a fixed band increased by the distance covered
+ * within the prediction time at current descent rate, so it wakes up
+ * before the wheels could touch the ground. Descent rate is the greater
+ * of the inertial one and the one derived from altitude above ground
+ * level changes, so rising terrain is also taken into account.
  */
 class FDMEXPORT LandingGear : public Module
 {
@@ -53,6 +62,25 @@ public:
 
     typedef Map< std::string, WheelAndInput > Wheels;
 
+    /**
+     * Wheels contact data struct of arrays.
+     * Data of all the wheels are gathered, so ground intersections can be
+     * queried at once and transformations computed in a single loop.
+     */
+    struct Contacts
+    {
+        std::vector< Wheel* >  wheels;      ///< wheels
+        std::vector< Vector3 > b_wgs;       ///< [m] struts attachment points expressed in WGS
+        std::vector< Vector3 > e_wgs;       ///< [m] unloaded wheels coordinates expressed in WGS
+        std::vector< Vector3 > r_wgs;       ///< [m] intersection points expressed in WGS
+        std::vector< Vector3 > n_wgs;       ///< [-] intersection normal vectors expressed in WGS
+        std::vector< Vector3 > v_wgs;       ///< [m/s] intersection points velocities (e.g. moving deck) expressed in WGS
+        std::vector< Vector3 > r_c_bas;     ///< [m] contact points expressed in BAS
+        std::vector< Vector3 > n_c_bas;     ///< [-] contact normal vectors expressed in BAS
+        std::vector< Vector3 > v_c_bas;     ///< [m/s] aircraft velocities relative to contact surfaces expressed in BAS
+        std::vector< char >    hit;         ///< intersection flags
+    };
+
     /** @brief Constructor. */
     LandingGear( const Aircraft *aircraft, Input *input );
 
@@ -74,6 +102,12 @@ public:
     /** @brief Updates landing gear. */
     virtual void update();
 
+    /**
+     * @brief Archives module internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -81,6 +115,12 @@ public:
 
     inline bool getOnGround() const { return _onGround; }
 
+    /**
+     * @brief Checks if landing gear is sleeping as aircraft is airborne.
+     * @return true if wheels computations are skipped, false otherwise
+     */
+    bool isSleeping() const;
+
 protected:
 
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
@@ -98,13 +138,19 @@ protected:
 
     bool _onGround;             ///< specifies if aircraft is on the ground
 
+    static const double _sleepBand;     ///< [m] fixed sleeping height band
+    static const double _sleepTime;     ///< [s] sleeping prediction time
+
+    double _reach;              ///< [m] the longest wheel reach from the center of gravity
+    double _agl_prev;           ///< [m] altitude above ground level at previous update
+    double _agl_rate;           ///< [m/s] altitude above ground level rate of change
+
+    bool _agl_valid;            ///< specifies if previous altitude above ground level is valid
+
     DataRef _inputABS;          ///< ABS input data reference
     DataRef _inputNWS;          ///< NWS input data reference
 
-    /**
-     * @brief Returns landing gear strut and ground plane intersection point expressed in BAS.
-     * @return [m] landing gear strut and ground plane intersection point expressed in BAS
-     */
+    Contacts _contacts;         ///< wheels contact data
 
     /**
      * @brief Returns landing gear strut and ground plane intersection point expressed in BAS.
@@ -119,6 +165,35 @@ protected:
 
     virtual int readWheelsData( XmlNode &dataNode, Wheels &wheels );
 
+    /**
+     * @brief Updates wheels contact data.
+     * Gathers struts of all the given wheels and queries ground
+     * intersections of all of them at once.
+     * @param wheels wheels
+     * @param extendedOnly specifies if only fully extended wheels should be included
+     */
+    void updateContacts( Wheels &wheels, bool extendedOnly );
+
+    /**
+     * @brief Computes fully extended wheels forces and moments and adds them
+     * to the landing gear total force and moment.
+     * @param wheels wheels
+     */
+    void computeWheelsForceAndMoment( Wheels &wheels );
+
+    /**
+     * @brief Integrates all the wheels models.
+     * @param wheels wheels
+     */
+    void integrateWheels( Wheels &wheels );
+
+    /**
+     * @brief Archives all the wheels models internal states.
+     * @param archive state archive
+     * @param wheels wheels
+     */
+    void archiveWheels( StateArchive *archive, Wheels &wheels );
+
 private:
 
     /** Using this constructor is forbidden. */
@@ -36,7 +36,9 @@ Mass::Mass( const Aircraft *aircraft, Input *input ) :
     Module ( aircraft, input ),
 
     _mass_e ( 0.0 ),
-    _mass_t ( 0.0 )
+    _mass_t ( 0.0 ),
+
+    _mass_t_inv ( 0.0 )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -71,10 +73,22 @@ void Mass::readData( XmlNode &dataNode )
 
             if ( result == FDM_SUCCESS )
             {
-                std::pair<Masses::iterator,bool> temp =
-                        _masses.insert( std::pair<std::string,VarMass>( name, varMass ) );
-
-                if ( temp.second != true )
+                if ( getVariableMassByName( name.c_str() ) == FDM_NULLPTR )
+                {
+                    double r_x = varMass.r_bas.x();
+                    double r_y = varMass.r_bas.y();
+                    double r_z = varMass.r_bas.z();
+
+                    // Taylor J.: Classical Mechanics, p.411
+                    varMass.name  = name;
+                    varMass.mass  = 0.0;
+                    varMass.j_bas = Matrix3x3( r_y * r_y + r_z * r_z, -r_x * r_y, -r_x * r_z,
+                                               -r_x * r_y, r_x * r_x + r_z * r_z, -r_y * r_z,
+                                               -r_x * r_z, -r_y * r_z, r_x * r_x + r_y * r_y );
+
+                    _masses.push_back( varMass );
+                }
+                else
                 {
                     result = FDM_FAILURE;
                 }
@@ -97,6 +111,19 @@ void Mass::readData( XmlNode &dataNode )
 
 void Mass::initialize()
 {
+    _mass_t  = _mass_e;
+    _s_t_bas = _mass_e * _r_cm_e_bas;
+    _i_t_bas = _i_e_bas;
+
+    for ( Masses::iterator it = _masses.begin(); it != _masses.end(); ++it )
+    {
+        (*it).mass = 0.0;
+    }
+
+    _r_cm_t_bas = _s_t_bas / _mass_t;
+
+    updateFactorization();
+
     update();
 }
 
@@ -122,23 +149,35 @@ void Mass::computeForceAndMoment()
 
 void Mass::update()
 {
-    _mass_t   = _mass_e;
-    _s_t_bas = _mass_e * _r_cm_e_bas;
-    _i_t_bas = _i_e_bas;
+    bool changed = false;
 
     for ( Masses::iterator it = _masses.begin(); it != _masses.end(); ++it )
     {
-        VarMass &vm = (*it).second;
+        VarMass &vm = (*it);
+
+        double mass = 0.0;
 
         if ( vm.dr_input.isValid() )
-            vm.mass = Misc::satur( 0.0, vm.mass_max, vm.dr_input.getValue() );
+            mass = Misc::satur( 0.0, vm.mass_max, vm.dr_input.getValue() );
         else
-            vm.mass = Misc::satur( 0.0, vm.mass_max, 0.0 );
+            mass = Misc::satur( 0.0, vm.mass_max, 0.0 );
+
+        // only contributions of masses that changed are updated
+        if ( mass != vm.mass )
+        {
+            addVariableMass( vm, mass - vm.mass );
 
-        addVariableMass( vm );
+            vm.mass = mass;
+            changed = true;
+        }
     }
 
-    _r_cm_t_bas = _s_t_bas / _mass_t;
+    if ( changed )
+    {
+        _r_cm_t_bas = _s_t_bas / _mass_t;
+
+        updateFactorization();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -194,43 +233,104 @@ Matrix6x6 Mass::getInertiaMatrix() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Mass::addVariableMass( const VarMass &varMass )
+void Mass::solveAccelerations( const Vector3 &for_rhs, const Vector3 &mom_rhs,
+                               Vector6 *acc_bas ) const
 {
-    // Taylor J.: Classical Mechanics, p.411
-    _mass_t  += varMass.mass;
-    _s_t_bas += varMass.mass * varMass.r_bas;
-
-    double r_x2 = varMass.r_bas.x() * varMass.r_bas.x();
-    double r_y2 = varMass.r_bas.y() * varMass.r_bas.y();
-    double r_z2 = varMass.r_bas.z() * varMass.r_bas.z();
+    // inertia matrix is [ m*I , -S ; S , I_t ], where S is cross product
+    // matrix of the first moment of mass, angular accelerations are solved
+    // using Schur complement (which is inertia tensor about center of mass)
+    // and then linear accelerations are obtained by back substitution
+    Vector3 eps_bas = _i_cm_inv_bas * ( mom_rhs - _mass_t_inv * ( _s_t_bas % for_rhs ) );
+    Vector3 acc_lin = _mass_t_inv * ( for_rhs + ( _s_t_bas % eps_bas ) );
+
+    (*acc_bas)( 0 ) = acc_lin.x();
+    (*acc_bas)( 1 ) = acc_lin.y();
+    (*acc_bas)( 2 ) = acc_lin.z();
+    (*acc_bas)( 3 ) = eps_bas.x();
+    (*acc_bas)( 4 ) = eps_bas.y();
+    (*acc_bas)( 5 ) = eps_bas.z();
+}
 
-    double d_it_xy = varMass.mass * varMass.r_bas.x() * varMass.r_bas.y();
-    double d_it_xz = varMass.mass * varMass.r_bas.x() * varMass.r_bas.z();
-    double d_it_yz = varMass.mass * varMass.r_bas.y() * varMass.r_bas.z();
+////////////////////////////////////////////////////////////////////////////////
 
-    _i_t_bas.xx() += varMass.mass * ( r_y2 + r_z2 );
-    _i_t_bas.xy() -= d_it_xy;
-    _i_t_bas.xz() -= d_it_xz;
+void Mass::updateFactorization()
+{
+    _mass_t_inv = 1.0 / _mass_t;
+
+    // Schur complement I_t + S*S/m = I_t - ( |s|^2 * I - s*s^T ) / m
+    // which is inertia tensor about center of mass (parallel axis theorem)
+    double s_x = _s_t_bas.x();
+    double s_y = _s_t_bas.y();
+    double s_z = _s_t_bas.z();
+
+    double i_xx = _i_t_bas.xx() - _mass_t_inv * ( s_y * s_y + s_z * s_z );
+    double i_yy = _i_t_bas.yy() - _mass_t_inv * ( s_x * s_x + s_z * s_z );
+    double i_zz = _i_t_bas.zz() - _mass_t_inv * ( s_x * s_x + s_y * s_y );
+    double i_xy = _i_t_bas.xy() + _mass_t_inv * s_x * s_y;
+    double i_xz = _i_t_bas.xz() + _mass_t_inv * s_x * s_z;
+    double i_yz = _i_t_bas.yz() + _mass_t_inv * s_y * s_z;
+
+    // inverting symmetric 3x3 matrix using adjugate matrix
+    double c_xx = i_yy * i_zz - i_yz * i_yz;
+    double c_xy = i_xz * i_yz - i_xy * i_zz;
+    double c_xz = i_xy * i_yz - i_xz * i_yy;
+    double c_yy = i_xx * i_zz - i_xz * i_xz;
+    double c_yz = i_xy * i_xz - i_xx * i_yz;
+    double c_zz = i_xx * i_yy - i_xy * i_xy;
+
+    double det_inv = 1.0 / ( i_xx * c_xx + i_xy * c_xy + i_xz * c_xz );
+
+    _i_cm_inv_bas = Matrix3x3( c_xx * det_inv, c_xy * det_inv, c_xz * det_inv,
+                               c_xy * det_inv, c_yy * det_inv, c_yz * det_inv,
+                               c_xz * det_inv, c_yz * det_inv, c_zz * det_inv );
+}
 
-    _i_t_bas.yx() -= d_it_xy;
-    _i_t_bas.yy() += varMass.mass * ( r_x2 + r_z2 );
-    _i_t_bas.yz() -= d_it_yz;
+////////////////////////////////////////////////////////////////////////////////
 
-    _i_t_bas.zx() -= d_it_xz;
-    _i_t_bas.zy() -= d_it_yz;
-    _i_t_bas.zz() += varMass.mass * ( r_x2 + r_y2 );
+void Mass::addVariableMass( const VarMass &varMass, double deltaMass )
+{
+    _mass_t  += deltaMass;
+    _s_t_bas += deltaMass * varMass.r_bas;
+    _i_t_bas += deltaMass * varMass.j_bas;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Mass::VarMass* Mass::getVariableMassByName( const char *name )
 {
-    Masses::iterator it = _masses.find( name );
+    for ( Masses::iterator it = _masses.begin(); it != _masses.end(); ++it )
+    {
+        if ( (*it).name == name )
+        {
+            return &(*it);
+        }
+    }
 
-    if ( it != _masses.end() )
+    return FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Mass::archiveState( StateArchive *archive )
+{
+    Module::archiveState( archive );
+
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    // totals are updated incrementally, so they are archived as well
+    for ( Masses::iterator it = _masses.begin(); it != _masses.end(); ++it )
     {
-        return &(it->second);
+        archive->add( &(*it).mass );
     }
 
-    return 0;
+    archive->add( &_mass_t );
+
+    archive->add( &_r_cm_t_bas );
+    archive->add( &_s_t_bas );
+
+    archive->add( &_i_t_bas );
+    archive->add( &_i_cm_inv_bas );
+
+    archive->add( &_mass_t_inv );
 }
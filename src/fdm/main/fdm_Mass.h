@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <string>
 #include <vector>
 
 #include <fdm/main/fdm_Module.h>
@@ -43,6 +44,10 @@ namespace fdm
  * Input data reference is created for each variable mass component. Name of
  * this data reference is "input/mass/variable_mass_component_name".
  *
+ * Variable masses are stored in an array with inputs resolved when data is
+ * read. Total mass, first moment of mass and inertia tensor are updated
+ * incrementally, only with the contributions of the masses that changed.
+ *
  * XML configuration file format:
  * @code
  * <mass>
@@ -73,13 +78,15 @@ public:
     /** Variable mass component data. */
     struct VarMass
     {
+        std::string name;   ///< variable mass name
         DataRef dr_input;   ///< mass input data reference
         double mass;        ///< [kg] mass
         double mass_max;    ///< [kg] maximum mass
         Vector3 r_bas;      ///< [m] position expressed in BAS
+        Matrix3x3 j_bas;    ///< [m^2] inertia tensor of a unit mass at the position
     };
 
-    typedef std::map< std::string, VarMass > Masses;
+    typedef std::vector< VarMass > Masses;
 
     /** @brief Constructor. */
     Mass( const Aircraft *aircraft, Input *input );
@@ -102,6 +109,12 @@ public:
     /** @brief Updates mass. */
     virtual void update();
 
+    /**
+     * @brief Archives module internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -119,6 +132,18 @@ public:
      */
     virtual Matrix6x6 getInertiaMatrix() const;
 
+    /**
+     * @brief Solves equations of motion for accelerations.
+     * Uses block factorization of the inertia matrix computed in update(),
+     * which is equivalent to solving system of linear equations with the
+     * inertia matrix as left hand side matrix.
+     * @param for_rhs [N] right hand side force vector expressed in BAS
+     * @param mom_rhs [N*m] right hand side moment vector expressed in BAS
+     * @param acc_bas [m/s^2] and [rad/s^2] resulting linear and angular accelerations vector
+     */
+    void solveAccelerations( const Vector3 &for_rhs, const Vector3 &mom_rhs,
+                             Vector6 *acc_bas ) const;
+
     /**
      * @brief Returns inertia tensor for total mass.
      * @return [kg*m^2] inertia tensor
@@ -148,17 +173,24 @@ protected:
 
     Matrix3x3 _i_e_bas;         ///< [kg*m^2] inertia tensor (empty)
     Matrix3x3 _i_t_bas;         ///< [kg*m^2] inertia tensor (total)
+    Matrix3x3 _i_cm_inv_bas;    ///< [1/(kg*m^2)] inverted inertia tensor (total) about center of mass
+
+    double _mass_t_inv;         ///< [1/kg] inverted total aircraft mass
+
+    /** @brief Updates inertia matrix factorization used to solve for accelerations. */
+    void updateFactorization();
 
     /**
-     * @brief Adds variable mass to the total aircraft mass.
-     * @param variableMass variable mass component
+     * @brief Adds variable mass change to the total aircraft mass.
+     * @param varMass variable mass component
+     * @param deltaMass [kg] variable mass change
      */
-    virtual void addVariableMass( const VarMass &varMass );
+    virtual void addVariableMass( const VarMass &varMass, double deltaMass );
 
     /**
      * @brief Returns variable mass by name.
      * @param name variable mass name
-     * @return channel
+     * @return variable mass on success, null pointer on failure
      */
     virtual VarMass* getVariableMassByName( const char *name );
 
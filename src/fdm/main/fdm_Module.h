@@ -26,6 +26,8 @@
 
 #include <fdm/fdm_Base.h>
 
+#include <fdm/utils/fdm_StateArchive.h>
+
 #include <fdm/xml/fdm_XmlNode.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +39,15 @@ class Aircraft; // aircraft class forward declaration
 
 /**
  * @brief Module base class.
+ *
+ * Module can be updated at a lower rate than the simulation rate. Update
+ * divisor specifies every which simulation step module is updated. Module
+ * update function should use getUpdateTimeStep() instead of aircraft time
+ * step, as it returns time elapsed since previous module update.
+ *
+ * Module can be permanently retired, e.g. winch launcher after release,
+ * it is then no longer updated and its forces and moments are no longer
+ * computed by the aircraft.
  */
 class FDMEXPORT Module : public Base
 {
@@ -45,7 +56,12 @@ public:
     /** @brief Constructor. */
     Module( const Aircraft *aircraft, Input *input ) :
         Base ( input ),
-        _aircraft ( aircraft )
+        _aircraft ( aircraft ),
+        _updateDivisor ( 1 ),
+        _updateCounter ( 0 ),
+        _updateTimeStep ( 0.0 ),
+        _timeStepSum ( 0.0 ),
+        _retired ( false )
     {}
 
     /** @brief Destructor. */
@@ -63,12 +79,85 @@ public:
     /** @brief Updates module. */
     virtual void update() = 0;
 
+    /**
+     * @brief Archives module internal states.
+     * Modules with internal states (e.g. integrated rotor speed, filters,
+     * values kept between updates) should override this function and call
+     * base class function first.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive )
+    {
+        archive->add( &_updateCounter );
+
+        archive->add( &_updateTimeStep );
+        archive->add( &_timeStepSum );
+
+        archive->add( &_retired );
+    }
+
+    /**
+     * @brief Updates module if it is scheduled for update in the current step.
+     * @param timeStep simulation time step [s]
+     */
+    inline void updateScheduled( double timeStep )
+    {
+        if ( _retired ) return;
+
+        _timeStepSum += timeStep;
+        _updateCounter++;
+
+        if ( _updateCounter >= _updateDivisor )
+        {
+            _updateTimeStep = _timeStepSum;
+
+            _updateCounter = 0;
+            _timeStepSum = 0.0;
+
+            update();
+        }
+    }
+
+    inline UInt32 getUpdateDivisor() const { return _updateDivisor; }
+
+    /** @return true if module is retired */
+    inline bool isRetired() const { return _retired; }
+
+    /**
+     * @brief Sets module update divisor.
+     * @param updateDivisor module is updated every updateDivisor simulation steps
+     */
+    inline void setUpdateDivisor( UInt32 updateDivisor )
+    {
+        _updateDivisor = updateDivisor > 0 ? updateDivisor : 1;
+        _updateCounter = 0;
+        _timeStepSum = 0.0;
+    }
+
 protected:
 
     const Aircraft *_aircraft;  ///< aircraft model main object
 
+    /** @return [s] time elapsed since previous module update */
+    inline double getUpdateTimeStep() const { return _updateTimeStep; }
+
+    /**
+     * @brief Permanently retires module.
+     * Retired module is neither updated nor its forces and moments are
+     * computed. Only landing gear and propulsion modules can be retired.
+     */
+    inline void retire() { _retired = true; }
+
 private:
 
+    UInt32 _updateDivisor;      ///< module is updated every _updateDivisor simulation steps
+    UInt32 _updateCounter;      ///< simulation steps since previous module update
+
+    double _updateTimeStep;     ///< [s] time elapsed since previous module update
+    double _timeStepSum;        ///< [s] time accumulated since previous module update
+
+    bool _retired;              ///< specifies if module is permanently retired
+
     /** Using this constructor is forbidden. */
     Module( const Module & ) : Base() {}
 };
@@ -40,3 +40,13 @@ Propulsion::~Propulsion() {}
 ////////////////////////////////////////////////////////////////////////////////
 
 void Propulsion::initialize() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Propulsion::archiveState( StateArchive *archive )
+{
+    Module::archiveState( archive );
+
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+}
@@ -61,6 +61,12 @@ public:
     /** @brief Updates propulsion. */
     virtual void update() = 0;
 
+    /**
+     * @brief Archives module internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -22,7 +22,13 @@
 
 #include <fdm/main/fdm_Recorder.h>
 
+#include <algorithm>
+#include <sstream>
+
 #include <fdm/fdm_Exception.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_Misc.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -30,19 +36,275 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Recorder::Recorder( double desiredTimeStep ) :
+const char   Recorder::_magic[ 8 ] = { 'M', 'S', 'C', 'S', 'I', 'M', 'R', 'C' };
+const UInt32 Recorder::_version    = 2;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+template < class TYPE >
+void writeBin( std::ostream &stream, TYPE value )
+{
+    stream.write( (const char*)&value, sizeof( TYPE ) );
+}
+
+template < class TYPE >
+bool readBin( const char *data, size_t size, size_t *offset, TYPE *value )
+{
+    if ( (*offset) + sizeof( TYPE ) > size ) return false;
+
+    memcpy( value, data + (*offset), sizeof( TYPE ) );
+    (*offset) += sizeof( TYPE );
+
+    return true;
+}
+
+/** Binary file variable description. */
+struct VarInfo
+{
+    std::string name;
+    char type;
+    UInt8 precision;
+    UInt8 encoding;
+    UInt32 size;
+};
+
+/** Binary file header. */
+struct Header
+{
+    UInt32 frameSize;
+    UInt32 dataOffset;
+    UInt32 frames;
+    UInt32 compressed;
+    std::vector< VarInfo > vars;
+    std::vector< UInt32 > blockFirst;
+    std::vector< size_t > blockOffset;
+};
+
+UInt32 getTypeSize( char type )
+{
+    switch ( type )
+    {
+        case 'b': return sizeof( bool   );
+        case 'i': return sizeof( int    );
+        case 'f': return sizeof( float  );
+        case 'd': return sizeof( double );
+    }
+
+    return 0;
+}
+
+bool readHeader( const char *data, size_t size, Header *header )
+{
+    size_t offset = 0;
+
+    if ( size < sizeof( Recorder::_magic ) ) return false;
+    if ( 0 != memcmp( data, Recorder::_magic, sizeof( Recorder::_magic ) ) ) return false;
+
+    offset += sizeof( Recorder::_magic );
+
+    UInt32 version = 0;
+    UInt32 count = 0;
+
+    if ( !readBin( data, size, &offset, &version ) ) return false;
+    if ( version < 1 || version > Recorder::_version ) return false;
+
+    if ( !readBin( data, size, &offset, &count              ) ) return false;
+    if ( !readBin( data, size, &offset, &header->frameSize  ) ) return false;
+    if ( !readBin( data, size, &offset, &header->dataOffset ) ) return false;
+
+    header->compressed = 0;
+
+    if ( version > 1 && !readBin( data, size, &offset, &header->compressed ) ) return false;
+
+    UInt32 frameSize = sizeof( double );
+
+    header->vars.resize( count );
+
+    for ( UInt32 i = 0; i < count; i++ )
+    {
+        VarInfo &var = header->vars[ i ];
+        UInt16 length = 0;
+
+        if ( !readBin( data, size, &offset, &var.type      ) ) return false;
+        if ( !readBin( data, size, &offset, &var.precision ) ) return false;
+
+        var.encoding = RecorderCodec::Raw;
+
+        if ( version > 1 && !readBin( data, size, &offset, &var.encoding ) ) return false;
+        if ( !readBin( data, size, &offset, &length ) ) return false;
+
+        if ( offset + length > size ) return false;
+
+        var.name.assign( data + offset, length );
+        var.size = getTypeSize( var.type );
+        offset += length;
+
+        if ( var.size == 0 ) return false;
+
+        frameSize += var.size;
+    }
+
+    if ( frameSize != header->frameSize ) return false;
+    if ( header->dataOffset < offset || header->dataOffset > size ) return false;
+
+    if ( header->compressed )
+    {
+        // incomplete trailing block is ignored
+        header->frames = 0;
+        offset = header->dataOffset;
+
+        UInt32 frames = 0;
+        UInt32 packedSize = 0;
+
+        while ( RecorderCodec::readBlockHeader( data + offset, size - offset, &frames, &packedSize ) )
+        {
+            header->blockFirst.push_back( header->frames );
+            header->blockOffset.push_back( offset );
+
+            header->frames += frames;
+            offset += RecorderCodec::_blockHeaderSize + packedSize;
+        }
+    }
+    else
+    {
+        // incomplete trailing frame is ignored
+        header->frames = (UInt32)( ( size - header->dataOffset ) / header->frameSize );
+    }
+
+    return true;
+}
+
+RecorderCodec::Columns getColumns( const Header &header )
+{
+    RecorderCodec::Columns columns;
+
+    for ( UInt32 i = 0; i < header.vars.size(); i++ )
+    {
+        RecorderCodec::Column column;
+
+        column.type      = header.vars[ i ].type;
+        column.precision = header.vars[ i ].precision;
+        column.encoding  = header.vars[ i ].encoding;
+        column.size      = header.vars[ i ].size;
+
+        columns.push_back( column );
+    }
+
+    return columns;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Recorder::isTextFile( const char *file )
+{
+    size_t length = strlen( file );
+
+    if ( length < 4 ) return false;
+
+    const char *ext = file + length - 4;
+
+    return 0 == strcmp( ext, ".csv" ) || 0 == strcmp( ext, ".CSV" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Recorder::exportText( const char *binFile, const char *csvFile )
+{
+    MappedFile mapped;
+
+    if ( !mapped.open( binFile ) ) return FDM_FAILURE;
+
+    Header header;
+
+    if ( !readHeader( mapped.getData(), mapped.getSize(), &header ) )
+    {
+        return FDM_FAILURE;
+    }
+
+    std::fstream fstream( csvFile, std::ios_base::out );
+
+    if ( !fstream.is_open() ) return FDM_FAILURE;
+
+    fstream << "\"time\"";
+
+    for ( UInt32 i = 0; i < header.vars.size(); i++ )
+    {
+        fstream << ";\"" << header.vars[ i ].name << "\"";
+    }
+
+    fstream << "\n";
+
+    fstream.setf( std::ios_base::showpoint );
+    fstream.setf( std::ios_base::fixed );
+
+    RecorderCodec::Columns columns = getColumns( header );
+
+    if ( header.compressed )
+    {
+        RecorderCodec codec;
+        codec.setColumns( columns );
+
+        std::vector< char > frames;
+
+        for ( UInt32 b = 0; b < header.blockOffset.size(); b++ )
+        {
+            const size_t offset = header.blockOffset[ b ];
+
+            if ( !codec.decode( mapped.getData() + offset, mapped.getSize() - offset, &frames ) )
+            {
+                return FDM_FAILURE;
+            }
+
+            for ( size_t f = 0; f < frames.size(); f += header.frameSize )
+            {
+                RecorderWriter::writeText( fstream, columns, &frames[ f ] );
+            }
+        }
+    }
+    else
+    {
+        for ( UInt32 f = 0; f < header.frames; f++ )
+        {
+            RecorderWriter::writeText( fstream, columns, mapped.getData() + header.dataOffset
+                                                       + (size_t)f * header.frameSize );
+        }
+    }
+
+    return fstream.good() ? FDM_SUCCESS : FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Recorder::Recorder( double desiredTimeStep, bool compressed ) :
     _desiredTimeStep ( desiredTimeStep ),
 
     _mode ( DataInp::Recording::Disabled ),
 
-    _time      ( 0.0 ),
-    _time_next ( 0.0 ),
-    _time_prev ( 0.0 ),
-    _time_rec  ( 0.0 ),
+    _frameSize  ( 0 ),
+    _dataOffset ( 0 ),
+    _frames     ( 0 ),
+    _frameIndex ( 0 ),
+
+    _blockIndex ( 0xffffffff ),
+
+    _time       ( 0.0 ),
+    _time_next  ( 0.0 ),
+    _time_prev  ( 0.0 ),
+    _time_rec   ( 0.0 ),
+    _time_start ( 0.0 ),
+    _time_end   ( 0.0 ),
+    _rate       ( 1.0 ),
 
     _records ( 0 ),
 
-    _recording ( false ),
+    _binary     ( false ),
+    _compressed ( compressed ),
+    _recording  ( false ),
     _replaying ( false )
 {}
 
@@ -52,10 +314,21 @@ Recorder::~Recorder()
 {
     if ( _fstream.is_open() )
     {
-        _fstream.flush();
         _fstream.close();
     }
 
+    _mapped.close();
+
+    if ( _writer.isOpen() )
+    {
+        _writer.close();
+
+        if ( _writer.getDropped() > 0 )
+        {
+            Log::w() << "Recorder dropped " << _writer.getDropped() << " frame(s)." << std::endl;
+        }
+    }
+
     Variables::iterator it = _variables.begin();
     while ( it != _variables.end() )
     {
@@ -79,24 +352,64 @@ void Recorder::initialize( Mode mode, const char *file )
 
     if ( _mode != DataInp::Recording::Disabled )
     {
-        _fstream.open( file, getOpenMode( _mode ) );
+        _binary = !isTextFile( file );
+
+        _frameSize = sizeof( double );
 
-        if ( _fstream.is_open() )
+        for ( Variables::iterator it = _variables.begin(); it != _variables.end(); ++it )
         {
-            _recording = _mode == DataInp::Recording::Record;
-            _replaying = _mode == DataInp::Recording::Replay;
+            _frameSize += (*it)->size();
+        }
+
+        _frame.resize( _frameSize );
 
-            if ( _recording )
+        if ( _mode == DataInp::Recording::Record )
+        {
+            RecorderWriter::Columns columns;
+            Names names;
+
+            for ( Variables::iterator it = _variables.begin(); it != _variables.end(); ++it )
             {
-                headerWrite();
+                RecorderWriter::Column column;
 
-                _fstream.setf( std::ios_base::showpoint );
-                _fstream.setf( std::ios_base::fixed );
+                column.type      = (*it)->type();
+                column.precision = (*it)->precision();
+                column.encoding  = (*it)->encoding();
+                column.size      = (*it)->size();
+
+                columns.push_back( column );
+                names.push_back( (*it)->name() );
             }
-            else
+
+            _writer.open( file, _binary ? getHeaderBin( names, columns, _compressed ) : getHeader( names ),
+                          columns, !_binary, _compressed );
+        }
+        else if ( _binary )
+        {
+            _mapped.open( file );
+        }
+        else
+        {
+            _fstream.open( file, std::ios_base::in );
+        }
+
+        if ( isOpen() )
+        {
+            _recording = _mode == DataInp::Recording::Record;
+            _replaying = _mode == DataInp::Recording::Replay;
+
+            if ( _replaying )
             {
-                headerRead();
-                recordRead( _time_next );
+                if ( _binary )
+                {
+                    headerReadBin();
+                }
+                else
+                {
+                    headerRead();
+                }
+
+                if ( !recordRead( _time_next ) ) _replaying = false;
 
                 for ( Variables::iterator it = _variables.begin(); it != _variables.end(); ++it )
                 {
@@ -106,12 +419,7 @@ void Recorder::initialize( Mode mode, const char *file )
         }
         else
         {
-            Exception e;
-
-            e.setType( Exception::FileReadingError );
-            e.setInfo( "Cannot open recording file file \"" + std::string( file ) + "\"." );
-
-            FDM_THROW( e );
+            throwFileError( "Cannot open recording file file \"" + std::string( file ) + "\"." );
         }
     }
 }
@@ -120,7 +428,7 @@ void Recorder::initialize( Mode mode, const char *file )
 
 void Recorder::step( double timeStep )
 {
-    if ( _fstream.is_open() )
+    if ( isOpen() )
     {
         switch ( _mode )
         {
@@ -136,6 +444,7 @@ void Recorder::step( double timeStep )
 
         case DataInp::Recording::Replay:
             stepReplay();
+            _time += ( _rate - 1.0 ) * timeStep;
             break;
         }
     }
@@ -145,14 +454,33 @@ void Recorder::step( double timeStep )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::ios_base::openmode Recorder::getOpenMode( Mode mode )
+bool Recorder::seek( double time )
 {
-    if ( mode == DataInp::Recording::Record )
+    // interval of at least two frames is required for random access
+    if ( _replaying && _binary && _frames > 1 )
     {
-        return std::ios_base::out;
+        _time = Misc::satur( getStartTime(), getEndTime(), time );
+        loadInterval( findFrame( _time ) );
+        stepReplay();
+
+        return true;
     }
 
-    return std::ios_base::in;
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Recorder::setRate( double rate )
+{
+    _rate = _binary ? rate : Misc::max( 0.0, rate );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Recorder::isOpen() const
+{
+    return _fstream.is_open() || _mapped.isOpen() || _writer.isOpen();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,22 +493,120 @@ void Recorder::headerRead()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Recorder::headerWrite()
+void Recorder::headerReadBin()
 {
-    _fstream << "\"time\"";
+    Header header;
 
-    for ( Variables::iterator it = _variables.begin(); it != _variables.end(); ++it )
+    if ( !readHeader( _mapped.getData(), _mapped.getSize(), &header ) )
+    {
+        throwFileError( "Invalid recording file header." );
+    }
+
+    bool valid = header.frameSize == _frameSize
+              && header.vars.size() == _variables.size();
+
+    for ( UInt32 i = 0; valid && i < header.vars.size(); i++ )
+    {
+        valid = header.vars[ i ].name == _variables[ i ]->name()
+             && header.vars[ i ].type == _variables[ i ]->type();
+    }
+
+    if ( !valid )
+    {
+        throwFileError( "Recording file variables do not match." );
+    }
+
+    _dataOffset = header.dataOffset;
+    _frames     = header.frames;
+    _frameIndex = 0;
+
+    _compressed  = header.compressed != 0;
+    _blockFirst  = header.blockFirst;
+    _blockOffset = header.blockOffset;
+    _blockIndex  = 0xffffffff;
+
+    _codec.setColumns( getColumns( header ) );
+
+    _time_start = _frames > 0 ? getFrameTime( 0 ) : 0.0;
+    _time_end   = _frames > 0 ? getFrameTime( _frames - 1 ) : 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Recorder::getHeader( const Names &names )
+{
+    std::ostringstream stream;
+
+    stream << "\"time\"";
+
+    for ( Names::const_iterator it = names.begin(); it != names.end(); ++it )
     {
-        _fstream << ";\"" << (*it)->name() << "\"";
+        stream << ";\"" << (*it) << "\"";
     }
 
-    _fstream << "\n";
+    stream << "\n";
+
+    return stream.str();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Recorder::recordRead( double &time )
+std::string Recorder::getHeaderBin( const Names &names,
+                                    const RecorderCodec::Columns &columns,
+                                    bool compressed )
 {
+    std::ostringstream stream;
+
+    UInt32 frameSize = sizeof( double );
+    UInt32 dataOffset = sizeof( _magic ) + 5 * sizeof( UInt32 );
+
+    for ( UInt32 i = 0; i < names.size(); i++ )
+    {
+        frameSize  += columns[ i ].size;
+        dataOffset += 3 * sizeof( char ) + sizeof( UInt16 ) + names[ i ].length();
+    }
+
+    stream.write( _magic, sizeof( _magic ) );
+
+    writeBin< UInt32 >( stream, _version );
+    writeBin< UInt32 >( stream, (UInt32)names.size() );
+    writeBin< UInt32 >( stream, frameSize );
+    writeBin< UInt32 >( stream, dataOffset );
+    writeBin< UInt32 >( stream, compressed ? 1 : 0 );
+
+    for ( UInt32 i = 0; i < names.size(); i++ )
+    {
+        UInt16 length = (UInt16)names[ i ].length();
+
+        writeBin< char   >( stream, columns[ i ].type );
+        writeBin< UInt8  >( stream, columns[ i ].precision );
+        writeBin< UInt8  >( stream, columns[ i ].encoding );
+        writeBin< UInt16 >( stream, length );
+
+        stream.write( names[ i ].c_str(), length );
+    }
+
+    return stream.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Recorder::recordRead( double &time )
+{
+    if ( _binary )
+    {
+        if ( !( _frameIndex < _frames ) ) return false;
+
+        time = getFrameTime( _frameIndex );
+        loadFrame( _frameIndex );
+
+        _frameIndex++;
+
+        return true;
+    }
+
+    if ( _fstream.eof() ) return false;
+
     _fstream >> time;
 
     char separator;
@@ -190,27 +616,136 @@ void Recorder::recordRead( double &time )
         _fstream >> separator;
         (*it)->read( _fstream );
     }
+
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Recorder::recordWrite( double time )
 {
-    _fstream << std::setprecision( 4 );
-    _fstream << time;
+    char *frame = &_frame[ 0 ];
+
+    memcpy( frame, &time, sizeof( double ) );
+    frame += sizeof( double );
 
     for ( Variables::iterator it = _variables.begin(); it != _variables.end(); ++it )
     {
-        _fstream << ";";
-        (*it)->write( _fstream );
+        (*it)->pack( frame );
+        frame += (*it)->size();
     }
 
-    _fstream << "\n";
+    _writer.push( &_frame[ 0 ] );
+
     _records++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const char* Recorder::getFrame( UInt32 index ) const
+{
+    if ( !_compressed )
+    {
+        return _mapped.getData() + _dataOffset + (size_t)index * _frameSize;
+    }
+
+    UInt32 block = (UInt32)( std::upper_bound( _blockFirst.begin(), _blockFirst.end(), index )
+                           - _blockFirst.begin() ) - 1;
+
+    if ( block != _blockIndex )
+    {
+        const size_t offset = _blockOffset[ block ];
+
+        if ( !_codec.decode( _mapped.getData() + offset, _mapped.getSize() - offset, &_block ) )
+        {
+            throwFileError( "Corrupted recording file block." );
+        }
+
+        _blockIndex = block;
+    }
+
+    return &_block[ (size_t)( index - _blockFirst[ block ] ) * _frameSize ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Recorder::getFrameTime( UInt32 index ) const
+{
+    double time = 0.0;
+    memcpy( &time, getFrame( index ), sizeof( double ) );
+    return time;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Recorder::loadFrame( UInt32 index )
+{
+    const char *frame = getFrame( index ) + sizeof( double );
+
+    for ( Variables::iterator it = _variables.begin(); it != _variables.end(); ++it )
+    {
+        (*it)->unpack( frame );
+        frame += (*it)->size();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Recorder::loadInterval( UInt32 index )
+{
+    // previous values are taken from the first frame, current from the second
+    _time_prev = getFrameTime( index );
+    loadFrame( index );
+
+    _time_next = getFrameTime( index + 1 );
+    loadFrame( index + 1 );
+
+    _frameIndex = index + 2;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt32 Recorder::findFrame( double time ) const
+{
+    // returns index i of the frame that t_i <= time < t_(i+1)
+    // for regularly sampled recordings initial guess is exact or nearly exact
+    // so only a few steps of local search are necessary
+    // recordings of less than two frames have no interval to be found
+    if ( _frames < 2 ) return 0;
+
+    const UInt32 last = _frames - 2;
+
+    double t_0 = getStartTime();
+    double t_n = getEndTime();
+
+    UInt32 index = 0;
+
+    if ( t_n > t_0 )
+    {
+        double guess = ( _frames - 1 ) * ( time - t_0 ) / ( t_n - t_0 );
+        index = (UInt32)Misc::satur( 0.0, (double)last, floor( guess ) );
+    }
+
+    while ( index > 0 && getFrameTime( index ) > time ) index--;
+    while ( index < last && getFrameTime( index + 1 ) <= time ) index++;
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Recorder::throwFileError( const std::string &info )
+{
+    Exception e;
+
+    e.setType( Exception::FileReadingError );
+    e.setInfo( info );
+
+    FDM_THROW( e );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Recorder::stepRecord()
 {
     if ( _time_rec > _desiredTimeStep || _records == 0 )
@@ -225,15 +760,29 @@ void Recorder::stepRecord()
 
 void Recorder::stepReplay()
 {
-    while ( _replaying && _time_next <= _time )
+    if ( _binary && _replaying && _frames > 1 )
     {
-        _time_prev = _time_next;
+        bool inside = _time_prev <= _time && _time < _time_next;
+        bool next = _time_next <= _time
+                 && _frameIndex < _frames && _time < getFrameTime( _frameIndex );
 
-        if ( !_fstream.eof() )
+        if ( _time >= getEndTime() && _rate >= 0.0 )
         {
-            recordRead( _time_next );
+            _replaying = false;
         }
-        else
+        else if ( !inside && !next )
+        {
+            // random access (seeking, scrubbing or fast replay)
+            if ( _time < getStartTime() ) _time = getStartTime();
+            loadInterval( findFrame( _time ) );
+        }
+    }
+
+    while ( _replaying && _time_next <= _time )
+    {
+        _time_prev = _time_next;
+
+        if ( !recordRead( _time_next ) )
         {
             _replaying = false;
         }
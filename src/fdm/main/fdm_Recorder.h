@@ -24,14 +24,21 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <string>
 #include <vector>
 
 #include <fdm/fdm_Defines.h>
 #include <fdm/fdm_DataInp.h>
 #include <fdm/fdm_Types.h>
 
+#include <fdm/main/fdm_RecorderWriter.h>
+
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_MappedFile.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -40,16 +47,33 @@ namespace fdm
 /**
  * @brief Flight recording and replaying class.
  *
- * This class uses CSV file format.
+ * Files with ".csv" extension use CSV text format, all other files use
+ * versioned binary format. Binary file starts with a header which consists
+ * of magic string "MSCSIMRC", format version, number of variables, frame
+ * size, data offset (all as 32-bit unsigned integers) and variables list
+ * (type code, precision, name length and name of each variable). Header is
+ * followed by fixed-size frames, each consists of time and raw values of all
+ * the variables in native byte order. Binary files are memory-mapped for
+ * replaying and might be exported to CSV format.
+ *
+ * Since format version 2 header also contains compression flag and encoding
+ * of each variable. Compressed files store frames in independently
+ * compressed blocks (see RecorderCodec), floating point variables using
+ * delta encoding are quantized to their precision. Only the block being
+ * replayed is decompressed.
+ *
+ * Recorded frames are written into file by a background writer thread. If
+ * the writer cannot keep up frames are dropped rather than the simulation
+ * step stretched.
  *
  * @see Shafranovich Y.: Common Format and MIME Type for Comma-Separated Values (CSV) Files, RFC 4180, 2005
  */
-class FDMEXPORT Recorder
+class FDMEXPORT Recorder : public ArenaObject
 {
 public:
 
     /** @brief Variable base class. */
-    class VariableBase
+    class VariableBase : public ArenaObject
     {
     public:
 
@@ -68,11 +92,29 @@ public:
         /** @brief Returns variable name. */
         virtual const char* name() const = 0;
 
+        /** @brief Returns variable type code. */
+        virtual char type() const = 0;
+
+        /** @brief Returns variable floating point number precision. */
+        virtual UInt8 precision() const = 0;
+
+        /** @brief Returns variable compressed binary format encoding. */
+        virtual UInt8 encoding() const = 0;
+
+        /** @brief Returns variable binary representation size. */
+        virtual UInt32 size() const = 0;
+
         /** @brief Reads variable from stream. */
         virtual void read( std::fstream &fstream ) = 0;
 
         /** @brief Writes variable into stream. */
         virtual void write( std::fstream &fstream ) = 0;
+
+        /** @brief Reads variable from binary frame. */
+        virtual void unpack( const char *buffer ) = 0;
+
+        /** @brief Writes variable into binary frame. */
+        virtual void pack( char *buffer ) const = 0;
     };
 
     /** @brief Variable class implementation. */
@@ -82,10 +124,12 @@ public:
     public:
 
         /** Constructor. */
-        Variable( const char *name, TYPE *ptr, UInt8 precision = 1 ) :
+        Variable( const char *name, TYPE *ptr, UInt8 precision = 1,
+                  RecorderCodec::Encoding encoding = RecorderCodec::Delta ) :
             _name       ( name ),
             _ptr        ( ptr ),
             _precision  ( precision ),
+            _encoding   ( encoding ),
             _value      ( 0.0 ),
             _value_prev ( 0.0 )
         {}
@@ -111,6 +155,30 @@ public:
             return _name.c_str();
         }
 
+        /** @brief Returns variable type code. */
+        virtual char type() const
+        {
+            return getTypeCode( _ptr );
+        }
+
+        /** @brief Returns variable floating point number precision. */
+        virtual UInt8 precision() const
+        {
+            return _precision;
+        }
+
+        /** @brief Returns variable compressed binary format encoding. */
+        virtual UInt8 encoding() const
+        {
+            return _encoding;
+        }
+
+        /** @brief Returns variable binary representation size. */
+        virtual UInt32 size() const
+        {
+            return sizeof( TYPE );
+        }
+
         /** @brief Reads variable from stream. */
         virtual void read( std::fstream &fstream )
         {
@@ -125,23 +193,80 @@ public:
             fstream << ( *_ptr );
         }
 
+        /** @brief Reads variable from binary frame. */
+        virtual void unpack( const char *buffer )
+        {
+            _value_prev = _value;
+            memcpy( &_value, buffer, sizeof( TYPE ) );
+        }
+
+        /** @brief Writes variable into binary frame. */
+        virtual void pack( char *buffer ) const
+        {
+            memcpy( buffer, _ptr, sizeof( TYPE ) );
+        }
+
     private:
 
         std::string _name;  ///< variable name
         TYPE *_ptr;         ///< pointer to actual variable
         UInt8 _precision;   ///< floating point number precision
+        UInt8 _encoding;    ///< compressed binary format encoding
         TYPE _value;        ///< variable value
         TYPE _value_prev;   ///< previous variable value
     };
 
     typedef DataInp::Recording::Mode Mode;
     typedef std::vector< VariableBase* > Variables;
+    typedef std::vector< std::string > Names;
+
+    static const char   _magic[ 8 ];    ///< binary format magic string
+    static const UInt32 _version;       ///< binary format version
+
+    inline static char getTypeCode( const bool   * ) { return 'b'; }
+    inline static char getTypeCode( const int    * ) { return 'i'; }
+    inline static char getTypeCode( const float  * ) { return 'f'; }
+    inline static char getTypeCode( const double * ) { return 'd'; }
+
+    /**
+     * @brief Checks if file uses text (CSV) format.
+     * @param file file path
+     * @return true if file has ".csv" extension, false otherwise
+     */
+    static bool isTextFile( const char *file );
+
+    /**
+     * @brief Returns text (CSV) file header.
+     * @param names variables names
+     * @return text file header
+     */
+    static std::string getHeader( const Names &names );
+
+    /**
+     * @brief Returns binary file header.
+     * @param names variables names
+     * @param columns variables columns
+     * @param compressed specifies if frames are compressed
+     * @return binary file header
+     */
+    static std::string getHeaderBin( const Names &names,
+                                     const RecorderCodec::Columns &columns,
+                                     bool compressed );
+
+    /**
+     * @brief Exports binary recording file to CSV format.
+     * @param binFile binary recording file path
+     * @param csvFile output CSV file path
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    static int exportText( const char *binFile, const char *csvFile );
 
     /**
      * @brief Constructor.
      * @param desiredTimeStep
+     * @param compressed specifies if binary recordings should be compressed
      */
-    Recorder( double desiredTimeStep = 0.0 );
+    Recorder( double desiredTimeStep = 0.0, bool compressed = false );
 
     /** @brief Destructor. */
     virtual ~Recorder();
@@ -162,6 +287,38 @@ public:
      */
     void step( double timeStep );
 
+    /**
+     * @brief Seeks replay to the given time.
+     * Seeking is available only for binary recordings. Cost does not depend
+     * on recording length for regularly sampled recordings.
+     * @param time [s] replay time
+     * @return true on success, false if seeking is not available
+     */
+    bool seek( double time );
+
+    /**
+     * @brief Sets replay rate.
+     * Negative rates (scrubbing backwards) are available only for binary
+     * recordings and are clamped to zero otherwise.
+     * @param rate [-] replay rate, 1.0 means real-time
+     */
+    void setRate( double rate );
+
+    /** @return [s] current recording or replay time */
+    inline double getTime() const { return _time; }
+
+    /** @return [-] replay rate */
+    inline double getRate() const { return _rate; }
+
+    /** @return [s] binary recording start time */
+    inline double getStartTime() const { return _time_start; }
+
+    /** @return [s] binary recording end time */
+    inline double getEndTime() const { return _time_end; }
+
+    /** @return number of recorded frames dropped by the writer */
+    inline UInt32 getDroppedFrames() const { return _writer.getDropped(); }
+
     inline bool isRecording() const { return _recording; }
     inline bool isReplaying() const { return _replaying; }
 
@@ -177,26 +334,56 @@ private:
     Variables _variables;           ///< variables
 
     Mode _mode;                     ///< recording mode
-    std::fstream _fstream;          ///< recording file stream
+    std::fstream _fstream;          ///< replayed text file stream
+    MappedFile _mapped;             ///< replayed binary file
+    RecorderWriter _writer;         ///< recording file writer
+
+    std::vector< char > _frame;     ///< binary frame buffer
+
+    UInt32 _frameSize;              ///< [B] binary frame size
+    UInt32 _dataOffset;             ///< [B] binary frames data offset
+    UInt32 _frames;                 ///< number of binary frames
+    UInt32 _frameIndex;             ///< next binary frame index
+
+    std::vector< UInt32 > _blockFirst;  ///< first frame index of each compressed block
+    std::vector< size_t > _blockOffset; ///< [B] offset of each compressed block
+
+    mutable RecorderCodec _codec;           ///< compressed blocks codec
+    mutable std::vector< char > _block;     ///< decompressed block frames
+    mutable UInt32 _blockIndex;             ///< decompressed block index
 
     double _time;                   ///< [s] time
     double _time_next;              ///< [s] next time
     double _time_prev;              ///< [s] previous time
     double _time_rec;               ///< [s] recording time variable (used to determine when write down data record)
+    double _time_start;             ///< [s] binary recording start time
+    double _time_end;               ///< [s] binary recording end time
+    double _rate;                   ///< [-] replay rate
 
     UInt32 _records;                ///< record counter
 
+    bool _binary;                   ///< specifies if binary format is used
+    bool _compressed;               ///< specifies if compressed binary format is used
     bool _recording;                ///< recording active
     bool _replaying;                ///< replaying active
 
-    std::ios_base::openmode getOpenMode( Mode mode );
+    bool isOpen() const;
 
     void headerRead();
-    void headerWrite();
+    void headerReadBin();
 
-    void recordRead( double &time );
+
+    bool recordRead( double &time );
+
+    const char* getFrame( UInt32 index ) const;
+    double getFrameTime( UInt32 index ) const;
+    void loadFrame( UInt32 index );
+    void loadInterval( UInt32 index );
+    UInt32 findFrame( double time ) const;
     void recordWrite( double time );
 
+    static void throwFileError( const std::string &info );
+
     /** @brief Performs recording step. */
     void stepRecord();
 
@@ -0,0 +1,315 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/main/fdm_RecorderCodec.h>
+
+#include <cmath>
+#include <cstring>
+
+#include <fdm/utils/fdm_Compressor.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const UInt32 RecorderCodec::_blockFrames     = 256;
+const UInt32 RecorderCodec::_blockHeaderSize = 3 * sizeof( UInt32 );
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const double timeScale = 1.0e6;
+
+inline long long quantize( double value, double scale )
+{
+    double q = floor( value * scale + 0.5 );
+
+    if ( q != q ) return 0;
+
+    if ( q >  1.0e18 ) q =  1.0e18;
+    if ( q < -1.0e18 ) q = -1.0e18;
+
+    return (long long)q;
+}
+
+inline void writeVarInt( long long value, std::vector< char > *dst )
+{
+    // zigzag encoding
+    UInt64 z = ( (UInt64)value << 1 ) ^ ( value < 0 ? ~(UInt64)0 : (UInt64)0 );
+
+    while ( z >= 0x80 )
+    {
+        dst->push_back( (char)( ( z & 0x7f ) | 0x80 ) );
+        z >>= 7;
+    }
+
+    dst->push_back( (char)z );
+}
+
+inline bool readVarInt( const char **src, const char *end, long long *value )
+{
+    UInt64 z = 0;
+    int shift = 0;
+
+    while ( true )
+    {
+        if ( (*src) >= end || shift > 63 ) return false;
+
+        UInt8 byte = (UInt8)*( (*src)++ );
+        z |= (UInt64)( byte & 0x7f ) << shift;
+        shift += 7;
+
+        if ( !( byte & 0x80 ) ) break;
+    }
+
+    (*value) = (long long)( z >> 1 ) ^ -(long long)( z & 1 );
+
+    return true;
+}
+
+inline double getScale( UInt8 precision )
+{
+    return pow( 10.0, (double)precision );
+}
+
+inline double getValue( const char *ptr, char type )
+{
+    if ( type == 'f' )
+    {
+        float v;
+        memcpy( &v, ptr, sizeof( v ) );
+        return v;
+    }
+
+    double v;
+    memcpy( &v, ptr, sizeof( v ) );
+    return v;
+}
+
+inline void setValue( char *ptr, char type, double value )
+{
+    if ( type == 'f' )
+    {
+        float v = (float)value;
+        memcpy( ptr, &v, sizeof( v ) );
+    }
+    else
+    {
+        memcpy( ptr, &value, sizeof( value ) );
+    }
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RecorderCodec::readBlockHeader( const char *data, size_t size,
+                                     UInt32 *frames, UInt32 *packedSize )
+{
+    if ( size < _blockHeaderSize ) return false;
+
+    memcpy( frames     , data                      , sizeof( UInt32 ) );
+    memcpy( packedSize , data + 2 * sizeof( UInt32 ), sizeof( UInt32 ) );
+
+    return size - _blockHeaderSize >= (*packedSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RecorderCodec::RecorderCodec() :
+    _frameSize ( sizeof( double ) )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderCodec::setColumns( const Columns &columns )
+{
+    _columns = columns;
+    _frameSize = sizeof( double );
+
+    for ( Columns::const_iterator it = _columns.begin(); it != _columns.end(); ++it )
+    {
+        _frameSize += it->size;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderCodec::encode( const char *frames, UInt32 count, std::vector< char > *block )
+{
+    _encoded.clear();
+
+    // time
+    long long q_1 = 0;
+    long long q_2 = 0;
+
+    for ( UInt32 f = 0; f < count; f++ )
+    {
+        long long q = quantize( getValue( frames + (size_t)f * _frameSize, 'd' ), timeScale );
+        writeVarInt( q - ( 2 * q_1 - q_2 ), &_encoded );
+        q_2 = q_1;
+        q_1 = q;
+    }
+
+    // columns
+    UInt32 offset = sizeof( double );
+
+    for ( Columns::const_iterator it = _columns.begin(); it != _columns.end(); ++it )
+    {
+        const bool delta = it->encoding == Delta && it->type != 'b';
+        const double scale = getScale( it->precision );
+
+        q_1 = 0;
+        q_2 = 0;
+
+        for ( UInt32 f = 0; f < count; f++ )
+        {
+            const char *ptr = frames + (size_t)f * _frameSize + offset;
+
+            if ( !delta )
+            {
+                _encoded.insert( _encoded.end(), ptr, ptr + it->size );
+            }
+            else if ( it->type == 'i' )
+            {
+                int v;
+                memcpy( &v, ptr, sizeof( v ) );
+                writeVarInt( (long long)v - q_1, &_encoded );
+                q_1 = v;
+            }
+            else
+            {
+                long long q = quantize( getValue( ptr, it->type ), scale );
+                writeVarInt( q - ( 2 * q_1 - q_2 ), &_encoded );
+                q_2 = q_1;
+                q_1 = q;
+            }
+        }
+
+        offset += it->size;
+    }
+
+    size_t headerOffset = block->size();
+    block->resize( headerOffset + _blockHeaderSize );
+
+    Compressor::compress( _encoded.data(), (UInt32)_encoded.size(), block );
+
+    UInt32 header[ 3 ];
+
+    header[ 0 ] = count;
+    header[ 1 ] = (UInt32)_encoded.size();
+    header[ 2 ] = (UInt32)( block->size() - headerOffset - _blockHeaderSize );
+
+    memcpy( &(*block)[ headerOffset ], header, _blockHeaderSize );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RecorderCodec::decode( const char *block, size_t size, std::vector< char > *frames )
+{
+    UInt32 count = 0;
+    UInt32 encodedSize = 0;
+    UInt32 packedSize = 0;
+
+    if ( !readBlockHeader( block, size, &count, &packedSize ) ) return false;
+
+    memcpy( &encodedSize, block + sizeof( UInt32 ), sizeof( UInt32 ) );
+
+    _encoded.resize( encodedSize );
+
+    if ( !Compressor::decompress( block + _blockHeaderSize, packedSize,
+                                  _encoded.data(), encodedSize ) )
+    {
+        return false;
+    }
+
+    frames->resize( (size_t)count * _frameSize );
+
+    const char *src = _encoded.data();
+    const char *end = src + _encoded.size();
+
+    // time
+    long long q_1 = 0;
+    long long q_2 = 0;
+
+    for ( UInt32 f = 0; f < count; f++ )
+    {
+        long long r = 0;
+        if ( !readVarInt( &src, end, &r ) ) return false;
+
+        long long q = r + ( 2 * q_1 - q_2 );
+        setValue( &(*frames)[ (size_t)f * _frameSize ], 'd', q / timeScale );
+        q_2 = q_1;
+        q_1 = q;
+    }
+
+    // columns
+    UInt32 offset = sizeof( double );
+
+    for ( Columns::const_iterator it = _columns.begin(); it != _columns.end(); ++it )
+    {
+        const bool delta = it->encoding == Delta && it->type != 'b';
+        const double scale = getScale( it->precision );
+
+        q_1 = 0;
+        q_2 = 0;
+
+        for ( UInt32 f = 0; f < count; f++ )
+        {
+            char *ptr = &(*frames)[ (size_t)f * _frameSize + offset ];
+
+            if ( !delta )
+            {
+                if ( (size_t)( end - src ) < it->size ) return false;
+                memcpy( ptr, src, it->size );
+                src += it->size;
+            }
+            else
+            {
+                long long r = 0;
+                if ( !readVarInt( &src, end, &r ) ) return false;
+
+                if ( it->type == 'i' )
+                {
+                    int v = (int)( q_1 + r );
+                    memcpy( ptr, &v, sizeof( v ) );
+                    q_1 = v;
+                }
+                else
+                {
+                    long long q = r + ( 2 * q_1 - q_2 );
+                    setValue( ptr, it->type, q / scale );
+                    q_2 = q_1;
+                    q_1 = q;
+                }
+            }
+        }
+
+        offset += it->size;
+    }
+
+    return src == end;
+}
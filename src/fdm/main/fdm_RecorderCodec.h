@@ -0,0 +1,132 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_RECORDERCODEC_H
+#define FDM_RECORDERCODEC_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Recording frames block codec.
+ *
+ * Block of frames is stored column-wise: times of all the frames first,
+ * followed by values of each column in turn. Time and floating point columns
+ * using delta encoding are quantized (time to microseconds, values to column
+ * precision decimal places) and stored as residuals of linear prediction
+ * from the two previous values, integer columns using delta encoding are
+ * stored as differences from the previous value. Residuals are zigzag
+ * encoded as variable length integers, thus slowly changing signals take
+ * single bytes. Raw columns are stored as they are. Encoded block is then
+ * compressed with LZ77 class compressor.
+ *
+ * Block consists of frames count, encoded size and compressed size (all as
+ * 32-bit unsigned integers) followed by compressed data. Every block is
+ * independent of the others, so blocks serve as key frames for seeking.
+ */
+class FDMEXPORT RecorderCodec
+{
+public:
+
+    /** Column encoding. */
+    enum Encoding
+    {
+        Raw   = 0,                  ///< raw values
+        Delta = 1                   ///< quantized delta encoding
+    };
+
+    /** Frame column description. */
+    struct Column
+    {
+        char type;                  ///< type code
+        UInt8 precision;            ///< floating point number precision
+        UInt8 encoding;             ///< encoding
+        UInt32 size;                ///< [B] value size
+    };
+
+    typedef std::vector< Column > Columns;
+
+    static const UInt32 _blockFrames;       ///< default number of frames per block
+    static const UInt32 _blockHeaderSize;   ///< [B] block header size
+
+    /**
+     * @brief Reads block header.
+     * @param data block data
+     * @param size [B] available data size
+     * @param frames output number of frames
+     * @param packedSize output [B] compressed data size
+     * @return true on success, false if block is incomplete
+     */
+    static bool readBlockHeader( const char *data, size_t size,
+                                 UInt32 *frames, UInt32 *packedSize );
+
+    /** @brief Constructor. */
+    RecorderCodec();
+
+    /**
+     * @brief Sets frame columns.
+     * @param columns frame columns
+     */
+    void setColumns( const Columns &columns );
+
+    /**
+     * @brief Encodes and compresses block of frames.
+     * @param frames raw frames data
+     * @param count number of frames
+     * @param block output block (appended)
+     */
+    void encode( const char *frames, UInt32 count, std::vector< char > *block );
+
+    /**
+     * @brief Decompresses and decodes block of frames.
+     * @param block block data
+     * @param size [B] available data size
+     * @param frames output raw frames data
+     * @return true on success, false if block is corrupted
+     */
+    bool decode( const char *block, size_t size, std::vector< char > *frames );
+
+    /** @return [B] raw frame size */
+    inline UInt32 getFrameSize() const { return _frameSize; }
+
+private:
+
+    Columns _columns;               ///< frame columns
+    UInt32 _frameSize;              ///< [B] raw frame size
+
+    std::vector< char > _encoded;   ///< encoded block buffer
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_RECORDERCODEC_H
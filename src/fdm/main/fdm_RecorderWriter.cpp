@@ -0,0 +1,236 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/main/fdm_RecorderWriter.h>
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+#include <fdm/utils/fdm_Metrics.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderWriter::writeText( std::ostream &stream, const Columns &columns,
+                                const char *frame )
+{
+    double time = 0.0;
+    memcpy( &time, frame, sizeof( double ) );
+    frame += sizeof( double );
+
+    stream << std::setprecision( 4 ) << time;
+
+    for ( Columns::const_iterator it = columns.begin(); it != columns.end(); ++it )
+    {
+        stream << ";" << std::setprecision( it->precision );
+
+        switch ( it->type )
+        {
+        case 'b': { bool   v; memcpy( &v, frame, sizeof( v ) ); stream << v; } break;
+        case 'i': { int    v; memcpy( &v, frame, sizeof( v ) ); stream << v; } break;
+        case 'f': { float  v; memcpy( &v, frame, sizeof( v ) ); stream << v; } break;
+        case 'd': { double v; memcpy( &v, frame, sizeof( v ) ); stream << v; } break;
+        }
+
+        frame += it->size;
+    }
+
+    stream << "\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RecorderWriter::RecorderWriter( UInt32 capacity ) :
+    _capacity ( capacity ),
+
+    _ring ( FDM_NULLPTR ),
+    _frameSize ( 0 ),
+
+    _pendingFrames ( 0 ),
+
+    _quit ( false ),
+
+    _dropped ( 0 ),
+
+    _text ( false ),
+    _compressed ( false ),
+    _open ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RecorderWriter::~RecorderWriter()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RecorderWriter::open( const char *file, const std::string &header,
+                           const Columns &columns, bool text, bool compressed )
+{
+    close();
+
+    _columns = columns;
+    _text = text;
+    _compressed = compressed && !text;
+
+    _codec.setColumns( _columns );
+    _frameSize = _codec.getFrameSize();
+
+    _pending.resize( (size_t)RecorderCodec::_blockFrames * _frameSize );
+    _pendingFrames = 0;
+
+    std::ios_base::openmode mode = std::ios_base::out;
+    if ( !_text ) mode |= std::ios_base::binary;
+
+    _stream.open( file, mode );
+
+    if ( _stream.is_open() )
+    {
+        if ( _text )
+        {
+            _stream.setf( std::ios_base::showpoint );
+            _stream.setf( std::ios_base::fixed );
+        }
+
+        _stream.write( header.data(), header.size() );
+
+        _ring = new RingBuffer( _capacity, _frameSize );
+
+        MemoryStats::allocate( MemoryAllocator< char, MemoryTag >::getId(),
+                               (UInt64)_capacity * _frameSize );
+
+        _dropped = 0;
+        _quit = false;
+        _open = true;
+
+        _thread = std::thread( &RecorderWriter::work, this );
+    }
+
+    return _open;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderWriter::close()
+{
+    if ( _open )
+    {
+        _quit = true;
+
+        if ( _thread.joinable() ) _thread.join();
+
+        // last incomplete block
+        if ( _compressed ) flushBlock();
+
+        _stream.flush();
+        _stream.close();
+
+        _open = false;
+    }
+
+    if ( _ring )
+    {
+        MemoryStats::release( MemoryAllocator< char, MemoryTag >::getId(),
+                              (UInt64)_capacity * _frameSize );
+    }
+
+    FDM_DELPTR( _ring );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RecorderWriter::push( const char *frame )
+{
+    if ( _open && _ring->push( frame ) )
+    {
+        FDM_METRICS_GAUGE( "recorder.queue_depth", _ring->getCount() );
+        return true;
+    }
+
+    _dropped++;
+
+    FDM_METRICS_COUNT( "recorder.dropped", 1 );
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderWriter::work()
+{
+    while ( !_quit )
+    {
+        drain();
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+
+    drain();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderWriter::drain()
+{
+    const char *frame = _ring->front();
+
+    while ( frame )
+    {
+        if ( _text )
+        {
+            writeText( _stream, _columns, frame );
+        }
+        else if ( _compressed )
+        {
+            memcpy( &_pending[ (size_t)_pendingFrames * _frameSize ], frame, _frameSize );
+            _pendingFrames++;
+
+            if ( _pendingFrames == RecorderCodec::_blockFrames ) flushBlock();
+        }
+        else
+        {
+            _stream.write( frame, _frameSize );
+        }
+
+        _ring->pop();
+        frame = _ring->front();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderWriter::flushBlock()
+{
+    if ( _pendingFrames > 0 )
+    {
+        _block.clear();
+        _codec.encode( _pending.data(), _pendingFrames, &_block );
+        _stream.write( _block.data(), _block.size() );
+
+        _pendingFrames = 0;
+    }
+}
@@ -0,0 +1,164 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_RECORDERWRITER_H
+#define FDM_RECORDERWRITER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/main/fdm_RecorderCodec.h>
+
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_MemoryStats.h>
+#include <fdm/utils/fdm_RingBuffer.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Background recording file writer.
+ *
+ * Frames are pushed into a lock-free ring buffer by the simulation thread and
+ * written into file by a dedicated I/O thread, so disk stalls never stretch
+ * simulation step. Frames which do not fit into the buffer are dropped and
+ * counted. Each frame consists of time followed by raw column values. In the
+ * text mode frames are formatted by the I/O thread as well.
+ *
+ * Ring buffer and pending frames buffer are accounted as "fdm.recorder"
+ * memory subsystem.
+ */
+class FDMEXPORT RecorderWriter : public ArenaObject
+{
+public:
+
+    typedef RecorderCodec::Column  Column;
+    typedef RecorderCodec::Columns Columns;
+
+    /** Memory accounting tag. */
+    struct MemoryTag
+    {
+        static const char* getName() { return "fdm.recorder"; }
+    };
+
+    typedef std::vector< char, MemoryAllocator< char, MemoryTag > > Buffer;
+
+    /**
+     * @brief Writes frame as a text line.
+     * @param stream output stream
+     * @param columns frame columns
+     * @param frame frame data
+     */
+    static void writeText( std::ostream &stream, const Columns &columns,
+                           const char *frame );
+
+    /**
+     * @brief Constructor.
+     * @param capacity ring buffer capacity (number of frames)
+     */
+    RecorderWriter( UInt32 capacity = 1024 );
+
+    /** @brief Destructor. */
+    virtual ~RecorderWriter();
+
+    /**
+     * @brief Opens file, writes header and starts I/O thread.
+     * @param file file path
+     * @param header file header data
+     * @param columns frame columns
+     * @param text specifies if frames should be formatted as text
+     * @param compressed specifies if binary frames should be written as compressed blocks
+     * @return true on success, false on failure
+     */
+    bool open( const char *file, const std::string &header,
+               const Columns &columns, bool text, bool compressed = false );
+
+    /** @brief Writes all the pending frames, stops I/O thread and closes file. */
+    void close();
+
+    /**
+     * @brief Pushes frame, might be called only from a single thread.
+     * @param frame frame data
+     * @return true on success, false if frame has been dropped
+     */
+    bool push( const char *frame );
+
+    /** @return frame size */
+    inline UInt32 getFrameSize() const { return _frameSize; }
+
+    /** @return number of dropped frames */
+    inline UInt32 getDropped() const { return _dropped; }
+
+    /** @return true if file is open */
+    inline bool isOpen() const { return _open; }
+
+private:
+
+    const UInt32 _capacity;         ///< ring buffer capacity
+
+    RingBuffer *_ring;              ///< frames ring buffer
+    Columns _columns;               ///< frame columns
+    UInt32 _frameSize;              ///< [B] frame size
+
+    RecorderCodec _codec;           ///< block codec
+    Buffer _pending;                ///< frames pending for compression
+    std::vector< char > _block;     ///< compressed block buffer
+    UInt32 _pendingFrames;          ///< number of frames pending for compression
+
+    std::ofstream _stream;          ///< output file stream
+    std::thread _thread;            ///< I/O thread
+
+    std::atomic< bool > _quit;      ///< specifies if I/O thread should quit
+
+    UInt32 _dropped;                ///< number of dropped frames
+
+    bool _text;                     ///< specifies if text format is used
+    bool _compressed;               ///< specifies if compressed blocks are used
+    bool _open;                     ///< specifies if file is open
+
+    /** Using this constructor is forbidden. */
+    RecorderWriter( const RecorderWriter & ) : _capacity( 0 ) {}
+
+    /** I/O thread loop. */
+    void work();
+
+    /** Writes all the frames available in ring buffer. */
+    void drain();
+
+    /** Compresses and writes pending frames. */
+    void flushBlock();
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_RECORDERWRITER_H
@@ -0,0 +1,270 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/main/fdm_TerrainCache.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TerrainCache::TerrainCache( Sampler *sampler, int size, double spacing,
+                            double horizon ) :
+    _sampler ( sampler ),
+
+    _size ( size > 2 ? size : 2 ),
+    _spacing ( spacing ),
+    _horizon ( horizon ),
+
+    _req_lat ( 0.0 ),
+    _req_lon ( 0.0 ),
+
+    _requested ( false ),
+    _pending   ( false ),
+    _quit      ( false )
+{
+    _worker = std::thread( &TerrainCache::work, this );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TerrainCache::~TerrainCache()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _quit = true;
+    }
+
+    _cv.notify_one();
+
+    if ( _worker.joinable() ) _worker.join();
+
+    FDM_DELPTR( _sampler );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCache::update( double lat, double lon, double vel_n, double vel_e )
+{
+    // predicted position limited to a quarter of the tile size
+    double limit = 0.25 * ( _size - 1 ) * _spacing;
+
+    double d_n = Misc::satur( -limit, limit, vel_n * _horizon );
+    double d_e = Misc::satur( -limit, limit, vel_e * _horizon );
+
+    double d_lat = 0.0;
+    double d_lon = 0.0;
+
+    getSpacing( lat, &d_lat, &d_lon );
+
+    double lat_p = lat + d_n * d_lat / _spacing;
+    double lon_p = lon + d_e * d_lon / _spacing;
+
+    // new tile is requested when predicted position leaves central half of the tile
+    bool request = !isInside( _tile.get(), lat_p, lon_p, 0.25 );
+
+    std::unique_lock< std::mutex > lock( _mutex, std::try_to_lock );
+
+    // it is better to skip a frame than wait for the worker
+    if ( !lock.owns_lock() ) return;
+
+    if ( _done )
+    {
+        _tile = _done;
+        _done.reset();
+
+        request = !isInside( _tile.get(), lat_p, lon_p, 0.25 );
+    }
+
+    if ( request && !_pending )
+    {
+        _req_lat = lat_p;
+        _req_lon = lon_p;
+
+        _requested = true;
+        _pending   = true;
+
+        lock.unlock();
+        _cv.notify_one();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TerrainCache::getElevation( double lat, double lon,
+                                 double *elev, Vector3 *norm_wgs ) const
+{
+    const Tile *tile = _tile.get();
+
+    if ( !isInside( tile, lat, lon, 0.0 ) ) return false;
+
+    double x = ( lat - tile->lat_0 ) / tile->d_lat;
+    double y = ( lon - tile->lon_0 ) / tile->d_lon;
+
+    int i = (int)floor( x );
+    int j = (int)floor( y );
+
+    // points on tile edges might fall outside of the grid due to rounding
+    if ( i < 0 ) i = 0;
+    if ( j < 0 ) j = 0;
+    if ( i > _size - 2 ) i = _size - 2;
+    if ( j > _size - 2 ) j = _size - 2;
+
+    double u = x - i;
+    double v = y - j;
+
+    int i00 = i * _size + j;
+    int i01 = i00 + 1;
+    int i10 = i00 + _size;
+    int i11 = i10 + 1;
+
+    if ( !tile->valid[ i00 ] || !tile->valid[ i01 ]
+      || !tile->valid[ i10 ] || !tile->valid[ i11 ] )
+    {
+        return false;
+    }
+
+    double w00 = ( 1.0 - u ) * ( 1.0 - v );
+    double w01 = ( 1.0 - u ) * v;
+    double w10 = u * ( 1.0 - v );
+    double w11 = u * v;
+
+    (*elev) = w00 * tile->elev[ i00 ] + w01 * tile->elev[ i01 ]
+            + w10 * tile->elev[ i10 ] + w11 * tile->elev[ i11 ];
+
+    (*norm_wgs) = w00 * tile->norm[ i00 ] + w01 * tile->norm[ i01 ]
+                + w10 * tile->norm[ i10 ] + w11 * tile->norm[ i11 ];
+
+    norm_wgs->normalize();
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TerrainCache::isInside( const Tile *tile, double lat, double lon,
+                             double margin ) const
+{
+    if ( tile )
+    {
+        double half_lat = ( 0.5 - margin ) * ( _size - 1 ) * tile->d_lat;
+        double half_lon = ( 0.5 - margin ) * ( _size - 1 ) * tile->d_lon;
+
+        return fabs( lat - tile->lat_c ) <= half_lat
+            && fabs( lon - tile->lon_c ) <= half_lon;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCache::getSpacing( double lat, double *d_lat, double *d_lon ) const
+{
+    // meridian and prime vertical radii of curvature
+    double sinLat = sin( lat );
+    double den = 1.0 - WGS84::_e2 * sinLat * sinLat;
+    double r_m = WGS84::_a * ( 1.0 - WGS84::_e2 ) / ( den * sqrt( den ) );
+    double r_n = WGS84::_a / sqrt( den );
+
+    double cosLat = cos( lat );
+    if ( cosLat < 1.0e-6 ) cosLat = 1.0e-6;
+
+    (*d_lat) = _spacing / r_m;
+    (*d_lon) = _spacing / ( r_n * cosLat );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TerrainCache::TilePtr TerrainCache::createTile( double lat, double lon )
+{
+    TilePtr tile = std::make_shared< Tile >();
+
+    getSpacing( lat, &tile->d_lat, &tile->d_lon );
+
+    tile->lat_c = lat;
+    tile->lon_c = lon;
+    tile->lat_0 = lat - 0.5 * ( _size - 1 ) * tile->d_lat;
+    tile->lon_0 = lon - 0.5 * ( _size - 1 ) * tile->d_lon;
+
+    const int count = _size * _size;
+
+    tile->elev  .resize( count, 0.0 );
+    tile->norm  .resize( count );
+    tile->valid .resize( count, 0 );
+
+    std::vector< double > lat_row( _size );
+    std::vector< double > lon_row( _size );
+
+    for ( int j = 0; j < _size; j++ )
+    {
+        lon_row[ j ] = tile->lon_0 + j * tile->d_lon;
+    }
+
+    // sampling row by row
+    for ( int i = 0; i < _size; i++ )
+    {
+        std::fill( lat_row.begin(), lat_row.end(), tile->lat_0 + i * tile->d_lat );
+
+        int index = i * _size;
+
+        _sampler->sampleMany( _size, &lat_row[ 0 ], &lon_row[ 0 ],
+                              &tile->elev  [ index ],
+                              &tile->norm  [ index ],
+                              &tile->valid [ index ] );
+    }
+
+    return tile;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCache::work()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    while ( !_quit )
+    {
+        _cv.wait( lock, [ this ] { return _quit || _requested; } );
+
+        if ( _quit ) break;
+
+        double lat = _req_lat;
+        double lon = _req_lon;
+
+        _requested = false;
+
+        lock.unlock();
+        TilePtr tile = createTile( lat, lon );
+        lock.lock();
+
+        _done = tile;
+        _pending = false;
+    }
+}
@@ -0,0 +1,197 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_TERRAINCACHE_H
+#define FDM_TERRAINCACHE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Local terrain elevation and normal tile cache.
+ *
+ * Terrain is sampled on a regular latitude-longitude grid centered on the
+ * ownship position predicted from the most recently posted position and
+ * velocity. Sampling is done by a background worker thread using the given
+ * sampler, so the thread calling update() and query functions only does
+ * bilinear lookups and never waits for scenery queries. New tile is
+ * requested when the predicted position leaves the central part of the
+ * current tile.
+ *
+ * update() and query functions might be called only from a single thread.
+ */
+class FDMEXPORT TerrainCache : public ArenaObject
+{
+public:
+
+    /**
+     * @brief Terrain sampler interface.
+     * Sampler is called from the cache worker thread only.
+     */
+    class Sampler
+    {
+    public:
+
+        /** @brief Destructor. */
+        virtual ~Sampler() {}
+
+        /**
+         * @brief Samples terrain.
+         * @param lat [rad] latitude
+         * @param lon [rad] longitude
+         * @param elev [m] terrain elevation above mean sea level
+         * @param norm_wgs [-] terrain normal vector expressed in WGS
+         * @return true on success, false on failure
+         */
+        virtual bool sample( double lat, double lon,
+                             double *elev, Vector3 *norm_wgs ) = 0;
+
+        /**
+         * @brief Samples terrain at multiple locations.
+         * Default implementation calls sample() for each location, samplers
+         * able to handle many queries at once should override it.
+         * @param count number of locations
+         * @param lat [rad] latitudes array
+         * @param lon [rad] longitudes array
+         * @param elev [m] terrain elevations above mean sea level array
+         * @param norm_wgs [-] terrain normal vectors expressed in WGS array
+         * @param valid array of flags specifying if sample is valid
+         */
+        virtual void sampleMany( unsigned int count,
+                                 const double *lat, const double *lon,
+                                 double *elev, Vector3 *norm_wgs, char *valid )
+        {
+            for ( unsigned int i = 0; i < count; i++ )
+            {
+                valid[ i ] = sample( lat[ i ], lon[ i ], &elev[ i ], &norm_wgs[ i ] ) ? 1 : 0;
+            }
+        }
+    };
+
+    /**
+     * @brief Constructor.
+     * @param sampler terrain sampler, cache takes ownership of it
+     * @param size [-] number of samples along tile edge
+     * @param spacing [m] distance between samples
+     * @param horizon [s] prediction time horizon
+     */
+    TerrainCache( Sampler *sampler, int size = 33, double spacing = 20.0,
+                  double horizon = 1.0 );
+
+    /** @brief Destructor, stops worker thread. */
+    virtual ~TerrainCache();
+
+    /**
+     * @brief Posts ownship position and picks up tile if a new one is ready.
+     * Predicted position is limited to a quarter of the tile size away from
+     * the current one, so the tile always covers current position.
+     * @param lat [rad] ownship latitude
+     * @param lon [rad] ownship longitude
+     * @param vel_n [m/s] ownship north velocity
+     * @param vel_e [m/s] ownship east velocity
+     */
+    void update( double lat, double lon, double vel_n = 0.0, double vel_e = 0.0 );
+
+    /**
+     * @brief Gets terrain elevation and normal by bilinear interpolation.
+     * @param lat [rad] latitude
+     * @param lon [rad] longitude
+     * @param elev [m] terrain elevation above mean sea level
+     * @param norm_wgs [-] terrain normal vector expressed in WGS
+     * @return true on success, false if location is not covered by the cache
+     */
+    bool getElevation( double lat, double lon,
+                       double *elev, Vector3 *norm_wgs ) const;
+
+    /** @return true if tile is available */
+    inline bool isReady() const { return _tile.get() != FDM_NULLPTR; }
+
+private:
+
+    /** Terrain tile. */
+    struct Tile
+    {
+        double lat_c;               ///< [rad] tile center latitude
+        double lon_c;               ///< [rad] tile center longitude
+        double lat_0;               ///< [rad] south edge latitude
+        double lon_0;               ///< [rad] west edge longitude
+        double d_lat;               ///< [rad] latitude spacing
+        double d_lon;               ///< [rad] longitude spacing
+
+        std::vector< double  > elev;    ///< [m] elevations
+        std::vector< Vector3 > norm;    ///< [-] normal vectors expressed in WGS
+        std::vector< char    > valid;   ///< specifies if sample is valid
+    };
+
+    typedef std::shared_ptr< Tile > TilePtr;
+
+    Sampler *_sampler;              ///< terrain sampler
+
+    const int _size;                ///< [-] number of samples along tile edge
+    const double _spacing;          ///< [m] distance between samples
+    const double _horizon;          ///< [s] prediction time horizon
+
+    TilePtr _tile;                  ///< current tile (owned by calling thread)
+    TilePtr _done;                  ///< tile completed by worker thread
+
+    std::thread _worker;            ///< worker thread
+    std::mutex _mutex;              ///< mutex guarding shared state
+    std::condition_variable _cv;    ///< worker wake-up condition
+
+    double _req_lat;                ///< [rad] requested tile center latitude
+    double _req_lon;                ///< [rad] requested tile center longitude
+
+    bool _requested;                ///< specifies if new tile has been requested
+    bool _pending;                  ///< specifies if request is being processed
+    bool _quit;                     ///< specifies if worker should quit
+
+    /** Using this constructor is forbidden. */
+    TerrainCache( const TerrainCache & ) : _size( 0 ), _spacing( 0.0 ), _horizon( 0.0 ) {}
+
+    bool isInside( const Tile *tile, double lat, double lon, double margin ) const;
+
+    void getSpacing( double lat, double *d_lat, double *d_lon ) const;
+
+    TilePtr createTile( double lat, double lon );
+
+    void work();
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_TERRAINCACHE_H
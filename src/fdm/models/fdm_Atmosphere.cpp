@@ -139,6 +139,11 @@ const double Atmosphere::_std_sl_p = 101325.0;  // US Standard Atmosphere 1976,
 const double Atmosphere::_std_sl_t = 288.15;    // US Standard Atmosphere 1976, Table 2, p.2
 const double Atmosphere::_std_sl_rho = 1.225;
 
+// table altitudes are multiples of the step, so nodes coincide with layers boundaries
+const double Atmosphere::_table_h_min  = -2000.0;
+const double Atmosphere::_table_h_max  = 84850.0;
+const double Atmosphere::_table_h_step = 25.0;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 double Atmosphere::getDensityAltitude( double pressure, double temperature,
@@ -160,6 +165,9 @@ double Atmosphere::getDensityAltitude( double pressure, double temperature,
 ////////////////////////////////////////////////////////////////////////////////
 
 Atmosphere::Atmosphere() :
+    _tableMode  ( false ),
+    _tableValid ( false ),
+
     _temperature_0 ( _std_sl_t ),
     _pressure_0    ( _std_sl_p )
 {
@@ -173,13 +181,95 @@ Atmosphere::~Atmosphere() {}
 ////////////////////////////////////////////////////////////////////////////////
 
 void Atmosphere::update( double altitude )
+{
+    if ( _tableMode && altitude >= _table_h_min && altitude < _table_h_max )
+    {
+        if ( !_tableValid ) updateTable();
+
+        double x = ( altitude - _table_h_min ) / _table_h_step;
+        unsigned int i = static_cast< unsigned int >( x );
+
+        double w1 = x - i;
+        double w0 = 1.0 - w1;
+
+        // the lowest layer ends with its own node, as sea level conditions
+        // make atmospheric data discontinuous at the layer boundary
+        if ( altitude >= _h_b[ 0 ] ) i++;
+
+        const TableNode &n0 = _table[ i ];
+        const TableNode &n1 = _table[ i + 1 ];
+
+        _temperature  = w0 * n0.temperature  + w1 * n1.temperature;
+        _pressure     = w0 * n0.pressure     + w1 * n1.pressure;
+        _density      = w0 * n0.density      + w1 * n1.density;
+        _speedOfSound = w0 * n0.speedOfSound + w1 * n1.speedOfSound;
+        _dynViscosity = w0 * n0.dynViscosity + w1 * n1.dynViscosity;
+        _kinViscosity = w0 * n0.kinViscosity + w1 * n1.kinViscosity;
+    }
+    else
+    {
+        compute( altitude, altitude < _h_b[ 0 ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Atmosphere::setPressureSL( double pressure_0 )
+{
+    if ( pressure_0 > 90000.0 && pressure_0 < 110000.0 )
+    {
+        if ( pressure_0 != _pressure_0 ) _tableValid = false;
+
+        _pressure_0 = pressure_0;
+    }
+    else
+    {
+        Log::w() << "Atmosphere wrong value of sea level pressure." << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Atmosphere::setTemperatureSL( double temperature_0 )
+{
+    if ( temperature_0 > 173.15 && temperature_0 < 373.15 )
+    {
+        if ( temperature_0 != _temperature_0 ) _tableValid = false;
+
+        _temperature_0 = temperature_0;
+    }
+    else
+    {
+        Log::w() << "Atmosphere wrong value of sea level temperature." << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Atmosphere::setTableMode( bool tableMode )
+{
+    if ( tableMode != _tableMode )
+    {
+        _tableMode = tableMode;
+
+        if ( !_tableMode )
+        {
+            Table().swap( _table );
+            _tableValid = false;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Atmosphere::compute( double altitude, bool troposphere )
 {
     double h_b = _h_b[ 5 ];
     double p_b = _p_b[ 6 ];
     double t_b = _t_b[ 6 ];
     double l_b = 0.0;
 
-    if ( altitude < _h_b[ 0 ] )
+    if ( troposphere )
     {
         h_b = 0.0;
         p_b = _p_b[ 0 ];
@@ -221,7 +311,7 @@ void Atmosphere::update( double altitude )
     {
         _pressure = p_b * pow( t_b / _temperature, ( WGS84::_g * _m ) / ( _r * l_b ) );
 
-        if ( altitude < _h_b[ 0 ] )
+        if ( troposphere )
         {
             _pressure = ( _pressure / _std_sl_p ) * _pressure_0;
         }
@@ -242,28 +332,29 @@ void Atmosphere::update( double altitude )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Atmosphere::setPressureSL( double pressure_0 )
+void Atmosphere::updateTable()
 {
-    if ( pressure_0 > 90000.0 && pressure_0 < 110000.0 )
-    {
-        _pressure_0 = pressure_0;
-    }
-    else
-    {
-        Log::w() << "Atmosphere wrong value of sea level pressure." << std::endl;
-    }
-}
+    unsigned int size_lo = static_cast< unsigned int >( ( _h_b[ 0 ] - _table_h_min ) / _table_h_step ) + 1;
+    unsigned int size_hi = static_cast< unsigned int >( ( _table_h_max - _h_b[ 0 ] ) / _table_h_step ) + 1;
 
-////////////////////////////////////////////////////////////////////////////////
+    _table.resize( size_lo + size_hi );
 
-void Atmosphere::setTemperatureSL( double temperature_0 )
-{
-    if ( temperature_0 > 173.15 && temperature_0 < 373.15 )
+    for ( unsigned int i = 0; i < _table.size(); i++ )
     {
-        _temperature_0 = temperature_0;
-    }
-    else
-    {
-        Log::w() << "Atmosphere wrong value of sea level temperature." << std::endl;
+        if ( i < size_lo )
+            compute( _table_h_min + i * _table_h_step, true );
+        else
+            compute( _h_b[ 0 ] + ( i - size_lo ) * _table_h_step, false );
+
+        TableNode &node = _table[ i ];
+
+        node.temperature  = _temperature;
+        node.pressure     = _pressure;
+        node.density      = _density;
+        node.speedOfSound = _speedOfSound;
+        node.dynViscosity = _dynViscosity;
+        node.kinViscosity = _kinViscosity;
     }
+
+    _tableValid = true;
 }
@@ -24,8 +24,12 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -40,9 +44,15 @@ namespace fdm
  * up to 11,000 m above mean sea level.
  * Model is valid up to 84,852 meters above mean sea level.
  *
+ * Optionally atmospheric data can be interpolated from the lookup table
+ * precomputed for the current sea level conditions. The table is rebuilt
+ * only when sea level conditions change. Table nodes coincide with layers
+ * boundaries, so temperature is exact and other data differ from the
+ * computed ones by less than 1.0e-5 of relative error.
+ *
  * @see US Standard Atmosphere 1976, NASA, TM-X-74335
  */
-class FDMEXPORT Atmosphere
+class FDMEXPORT Atmosphere : public ArenaObject
 {
 public:
 
@@ -79,6 +89,10 @@ public:
     static const double _std_sl_p;      ///< [Pa] standard sea level pressure (1013.25 hPa)
     static const double _std_sl_rho;    ///< [kg/m^3] standard sea level density (1.225 kg/m^3)
 
+    static const double _table_h_min;   ///< [m] lookup table minimum altitude
+    static const double _table_h_max;   ///< [m] lookup table maximum altitude
+    static const double _table_h_step;  ///< [m] lookup table altitude step
+
     /**
      * @brief Computes density altitude.
      * @param pressure [Pa] outside pressure
@@ -113,6 +127,14 @@ public:
      */
     virtual void setTemperatureSL( double temperature_0 );
 
+    /**
+     * @brief Sets lookup table mode.
+     * @param tableMode specifies if atmospheric data are interpolated from lookup table
+     */
+    void setTableMode( bool tableMode );
+
+    inline bool getTableMode() const { return _tableMode; }
+
     inline double getTemperature()  const { return _temperature;  }
     inline double getPressure()     const { return _pressure;     }
     inline double getDensity()      const { return _density;      }
@@ -122,6 +144,24 @@ public:
 
 private:
 
+    /** Lookup table node. */
+    struct TableNode
+    {
+        double temperature;     ///< [K] air temperature
+        double pressure;        ///< [Pa] air static pressure
+        double density;         ///< [kg/m^3] air density
+        double speedOfSound;    ///< [m/s] speed of sound
+        double dynViscosity;    ///< [Pa*s] dynamic viscosity
+        double kinViscosity;    ///< [m^2/s] kinematic viscosity
+    };
+
+    typedef std::vector< TableNode > Table;
+
+    Table _table;               ///< lookup table
+
+    bool _tableMode;            ///< specifies if lookup table is used
+    bool _tableValid;           ///< specifies if lookup table is valid for current sea level conditions
+
     double _temperature_0;      ///< [K] sea level air temperature
     double _pressure_0;         ///< [Pa] sea level air pressure
 
@@ -131,6 +171,16 @@ private:
     double _speedOfSound;       ///< [m/s] speed of sound
     double _dynViscosity;       ///< [Pa*s] dynamic viscosity
     double _kinViscosity;       ///< [m^2/s] kinematic viscosity
+
+    /**
+     * @brief Computes atmospheric data due to altitude.
+     * @param altitude [m] altitude above sea level
+     * @param troposphere specifies if the lowest layer is used (affected by sea level conditions)
+     */
+    void compute( double altitude, bool troposphere );
+
+    /** @brief Computes lookup table for current sea level conditions. */
+    void updateTable();
 };
 
 } // end of fdm namespace
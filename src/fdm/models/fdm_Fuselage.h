@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Vector3.h>
 
@@ -75,7 +76,7 @@ namespace fdm
  *
  * @see Talbot P., et al.: A Mathematical Model of a Single Main Rototr Helicopter for Piloted Simulation. NASA, TM-84281, 1982
  */
-class FDMEXPORT Fuselage
+class FDMEXPORT Fuselage : public ArenaObject
 {
 public:
 
@@ -69,3 +69,10 @@ void Governor::update( double propellerLever, double rpm )
     double error = _prop_rpm.getValue( propellerLever ) - rpm;
     _pitch = propellerLever + _gain_1 * error + _gain_2 * error * fabs( error );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Governor::archiveState( StateArchive *archive )
+{
+    archive->add( &_pitch );
+}
@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -42,7 +44,7 @@ namespace fdm
  * </governor>
  * @endcode
  */
-class FDMEXPORT Governor
+class FDMEXPORT Governor : public ArenaObject
 {
 public:
 
@@ -60,6 +62,12 @@ public:
 
     virtual void update( double propellerLever, double rpm );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline double getPitch() const { return _pitch; }
 
 protected:
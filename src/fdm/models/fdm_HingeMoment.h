@@ -26,6 +26,8 @@
 
 #include <fdm/xml/fdm_XmlNode.h>
 
+#include <fdm/utils/fdm_Arena.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -48,7 +50,7 @@ namespace fdm
  * @see Etkin B.: Dynamics of Atmosferic Flight, 1972, p.222
  * @see Paturski Z.: Przewodnik po projektach z Mechaniki Lotu, Projekt nr 9: Rownowaga podluzna samolotu i sily na sterownicy wysokosci, p.IX-3. [in Polish]
  */
-class FDMEXPORT HingeMoment
+class FDMEXPORT HingeMoment : public ArenaObject
 {
 public:
 
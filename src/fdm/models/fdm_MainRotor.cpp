@@ -23,6 +23,8 @@
 #include <fdm/models/fdm_MainRotor.h>
 #include <fdm/main/fdm_Aerodynamics.h>
 
+#include <cfloat>
+
 #include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Units.h>
 
@@ -38,8 +40,16 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const double MainRotor::_inflowMass0 = 8.0 / ( 3.0 * M_PI );
+const double MainRotor::_inflowMass1 = 16.0 / ( 45.0 * M_PI );
+const double MainRotor::_inflowSkew  = 15.0 * M_PI / 64.0;
+
+////////////////////////////////////////////////////////////////////////////////
+
 MainRotor::MainRotor() :
     _ccw ( false ),
+    _dynamicInflow ( false ),
+    _inflowReady ( false ),
 
     _nb ( 0 ),
 
@@ -101,7 +111,16 @@ MainRotor::MainRotor() :
 
     _vel_i ( 0.0 ),
 
-    _wakeSkew ( 0.0 )
+    _wakeSkew ( 0.0 ),
+
+    _lambda_0  ( 0.0 ),
+    _lambda_1c ( 0.0 ),
+    _lambda_1s ( 0.0 ),
+
+    _l_00 ( 0.0 ),
+    _l_20 ( 0.0 ),
+    _l_11 ( 0.0 ),
+    _l_22 ( 0.0 )
 {
     _bas2ras  = Matrix3x3::identityMatrix();
     _ras2bas  = Matrix3x3::identityMatrix();
@@ -130,6 +149,9 @@ void MainRotor::readData( XmlNode &dataNode )
 
         _ccw = String::toBool( dataNode.getAttribute( "counter-clockwise" ), false );
 
+        _dynamicInflow = String::toBool( dataNode.getAttribute( "dynamic-inflow" ), false );
+        _inflowReady = false;
+
         double blade_mass  = 0.0;
         double inclination = 0.0;
 
@@ -290,10 +312,25 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
 
     if ( fabs( lambda_i ) < 10e-14 ) lambda_i = 10e-14;
 
+    // dynamic inflow
+    const bool dynamicInflow = _dynamicInflow && _inflowReady;
+
+    double lambda_1c = 0.0;
+    double lambda_1s = 0.0;
+
+    if ( dynamicInflow )
+    {
+        lambda_i  = _lambda_0;
+        lambda_1c = _lambda_1c;
+        lambda_1s = _lambda_1s;
+    }
+
     // TODO Young approximation
 
-    // iteration loop
-    for ( int i = 0; i < 100; i++ )
+    // iteration loop (single pass when inflow is integrated)
+    const int iterations = dynamicInflow ? 1 : 100;
+
+    for ( int i = 0; i < iterations; i++ )
     {
         lambda = mu_z - lambda_i;
 
@@ -302,10 +339,12 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
                 - a_z * _sb / ( _ib * omega2 );
 
         beta_1c_cwas = 2.0 * mu * ( lambda + 4.0 * _b * _theta_0 / 3.0 ) / ( mu2 / 2.0 - _b2 )
-                + _cd * ( _b4 * p / _omega - _cd * 16.0 * q / ( gamma * _omega ) ) / ( _b2 * ( mu2 / 2.0 - _b2 ) );
+                + _cd * ( _b4 * p / _omega - _cd * 16.0 * q / ( gamma * _omega ) ) / ( _b2 * ( mu2 / 2.0 - _b2 ) )
+                - lambda_1s * _b2 / ( mu2 / 2.0 - _b2 );
 
         beta_1s_cwas = -4.0 * _beta_0 * mu * _b / ( mu2 / 2.0 + _b2 ) / 3.0
-                + ( _b4 * q / _omega + _cd * 16.0 * p / ( gamma * _omega ) ) / ( _b2 * ( mu2 / 2.0 + _b2 ) );
+                + ( _b4 * q / _omega + _cd * 16.0 * p / ( gamma * _omega ) ) / ( _b2 * ( mu2 / 2.0 + _b2 ) )
+                - lambda_1c * _b2 / ( mu2 / 2.0 + _b2 );
 
         //if ( _ccw )
         //{
@@ -341,6 +380,8 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
                                   + _b * mu * beta_1c_cwas / 4.0 );
         if ( _ct > _ct_max ) _ct = _ct_max;
 
+        if ( dynamicInflow ) break;
+
         // zero function (Padfield p.124)
         double lambda_d = mu2 + lambda * lambda;
         double g_0 = lambda_i - _ct / ( 2.0 * sqrt( lambda_d ) );
@@ -416,6 +457,18 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
     // rotor wake skew angle (Padfield p.121)
     _wakeSkew = atan2( mu, lambda_i - mu_z );
 
+    if ( _dynamicInflow )
+    {
+        computeInflowGains( mu, lambda, lambda_i );
+
+        if ( !_inflowReady )
+        {
+            _lambda_0  = lambda_i;
+            _lambda_1c = _l_20 * _ct;
+            _lambda_1s = 0.0;
+        }
+    }
+
     _thrust = _thrust_factor * airDensity * _ad * _r2 * omega2 * _ct;
     _hforce = _hforce_factor * airDensity * _ad * _r2 * omega2 * _ch;
     _torque = _torque_factor * airDensity * _ad * _r3 * omega2 * _cq;
@@ -447,12 +500,15 @@ void MainRotor::computeForceAndMoment( const Vector3 &vel_bas,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void MainRotor::update( double omega,
+void MainRotor::update( double timeStep,
+                        double omega,
                         double azimuth,
                         double collective,
                         double cyclicLat,
                         double cyclicLon )
 {
+    if ( _dynamicInflow ) updateInflow( timeStep );
+
     _omega   = omega;
     _azimuth = azimuth;
 
@@ -461,3 +517,137 @@ void MainRotor::update( double omega,
     _theta_1s =  cyclicLon;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotor::updateInflow( double timeStep )
+{
+    if ( !_inflowReady )
+    {
+        // states are initialized with the quasi-steady solution computed
+        // by the most recent force and moment computation as soon as
+        // momentum theory iterations converged
+        _inflowReady = _l_00 > 0.0
+                && Misc::isValid( _lambda_0 )
+                && Misc::isValid( _lambda_1c )
+                && fabs( _lambda_0 - _l_00 * _ct ) < 1.0e-6;
+
+        return;
+    }
+
+    if ( timeStep <= 0.0 || _omega <= 0.0 ) return;
+
+    // (Peters, HaQuang) M * dlambda/dpsi + L^-1 * lambda = C
+    // backward Euler: ( I + L * K ) * lambda_new = L * ( C + K * lambda_old )
+    // where K = M / ( omega * dt ), hub moments are neglected (C = [ ct 0 0 ])
+    // so the system is lower triangular
+    double dpsi = _omega * timeStep;
+
+    double k_0 = _inflowMass0 / dpsi;
+    double k_1 = _inflowMass1 / dpsi;
+
+    double c_0 = _ct + k_0 * _lambda_0;
+
+    double lambda_0  = _l_00 * c_0 / ( 1.0 + _l_00 * k_0 );
+    double lambda_1c = ( _l_20 * ( c_0 - k_0 * lambda_0 ) + _l_22 * k_1 * _lambda_1c )
+                     / ( 1.0 + _l_22 * k_1 );
+    double lambda_1s = _l_11 * k_1 * _lambda_1s / ( 1.0 + _l_11 * k_1 );
+
+    if ( Misc::isValid( lambda_0 )
+      && Misc::isValid( lambda_1c )
+      && Misc::isValid( lambda_1s ) )
+    {
+        _lambda_0  = lambda_0;
+        _lambda_1c = lambda_1c;
+        _lambda_1s = lambda_1s;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotor::computeInflowGains( double mu, double lambda, double lambda_i )
+{
+    // total inflow ratio positive downwards
+    double lambda_t = -lambda;
+
+    // total (v_t) and mass flow (v_m) velocity parameters (Peters, HaQuang)
+    double v_t = sqrt( mu*mu + lambda_t*lambda_t );
+
+    if ( v_t < 1.0e-6 ) v_t = 1.0e-6;
+
+    double v_m = ( mu*mu + lambda_t * ( lambda_t + lambda_i ) ) / v_t;
+
+    if ( v_m < 1.0e-6 ) v_m = 1.0e-6;
+
+    // wake skew angle limited to 90 deg (edgewise flow)
+    double cosChi = Misc::max( 0.0, lambda_t / v_t );
+    double sinChi = sqrt( 1.0 - cosChi*cosChi );
+    double tanChi_2 = sinChi / ( 1.0 + cosChi );
+
+    _l_00 = 0.5 / v_t;
+    _l_20 = _inflowSkew * tanChi_2 / v_t;
+    _l_11 = 4.0 / ( v_m * ( 1.0 + cosChi ) );
+    _l_22 = 4.0 * cosChi / ( v_m * ( 1.0 + cosChi ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotor::archiveState( StateArchive *archive )
+{
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_ras2cas );
+    archive->add( &_cas2ras );
+
+    archive->add( &_bas2cas );
+
+    archive->add( &_bas2das );
+    archive->add( &_das2bas );
+
+    archive->add( &_ras2rwas );
+    archive->add( &_rwas2ras );
+
+    archive->add( &_cas2cwas );
+    archive->add( &_cwas2cas );
+
+    archive->add( &_bas2cwas );
+    archive->add( &_cwas2bas );
+
+    archive->add( &_inflowReady );
+
+    archive->add( &_omega );
+    archive->add( &_azimuth );
+
+    archive->add( &_beta_0 );
+    archive->add( &_beta_1c );
+    archive->add( &_beta_1s );
+
+    archive->add( &_theta_0 );
+    archive->add( &_theta_1c );
+    archive->add( &_theta_1s );
+
+    archive->add( &_coningAngle );
+    archive->add( &_diskRoll );
+    archive->add( &_diskPitch );
+
+    archive->add( &_ct );
+    archive->add( &_ch );
+    archive->add( &_cq );
+
+    archive->add( &_thrust );
+    archive->add( &_hforce );
+    archive->add( &_torque );
+
+    archive->add( &_vel_i );
+
+    archive->add( &_wakeSkew );
+
+    archive->add( &_lambda_0 );
+    archive->add( &_lambda_1c );
+    archive->add( &_lambda_1s );
+
+    archive->add( &_l_00 );
+    archive->add( &_l_20 );
+    archive->add( &_l_11 );
+    archive->add( &_l_22 );
+}
@@ -24,7 +24,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/xml/fdm_XmlNode.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -72,9 +74,23 @@ namespace fdm
  * points directly into relative wind, so there is no lateral airspeed
  * component.
  *
+ * Induced velocity is by default obtained from the momentum theory at every
+ * computation. Optionally finite-state dynamic inflow model (3-state
+ * Pitt-Peters model, which is the lowest order Peters-He model) can be used
+ * instead. In that case uniform, longitudinal and lateral inflow components
+ * are integrated in the update function and only a single pass of the
+ * flapping and thrust equations is performed at every computation. Inflow
+ * harmonics affect cyclic flapping. Aerodynamic hub moments driving inflow
+ * harmonics are neglected as for the zero offset analytic flapping solution
+ * they vanish in steady conditions, so harmonics are driven only through the
+ * wake skew coupling. Coupling of the uniform component with the pitching
+ * moment is omitted along with the moments, which does not change the steady
+ * solution and keeps inflow dynamics stable close to the edgewise flow where
+ * the full gain matrix becomes indefinite.
+ *
  * XML configuration file format:
  * @code
- * <main_rotor>
+ * <main_rotor [counter-clockwise="{ true|false }"] [dynamic-inflow="{ 0|1 }"]>
  *   <hub_center> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </hub_center>
  *   <inclination> { [rad] rotor inclination angle (positive if forward) } </inclination>
  *   <number_of_blades> { number of blades } </number_of_blades>
@@ -105,8 +121,10 @@ namespace fdm
  * @see Padfield G.: Helicopter Flight Dynamics, 2007
  * @see Stepniewski W.: Rotary-Wing Aerodynamics. Volume I: Basic Theories of Rotor Aerodynamics, 1984
  * @see Johnson W.: Helicopter Theory, 1980
+ * @see Pitt D., Peters D.: Theoretical Prediction of Dynamic-Inflow Derivatives, 1981
+ * @see Peters D., HaQuang N.: Dynamic Inflow for Practical Applications, 1988
  */
-class FDMEXPORT MainRotor
+class FDMEXPORT MainRotor : public ArenaObject
 {
 public:
 
@@ -144,18 +162,26 @@ public:
 
     /**
      * @brief Updates main rotor model.
+     * @param timeStep   [s]     time step
      * @param omega      [rad/s] rotor revolution speed
      * @param azimuth    [rad]   rotor azimuth
      * @param collective [rad]   collective pitch angle
      * @param cyclicLat  [rad]   cyclic lateral pitch angle
      * @param cyclicLon  [rad]   cyclic longitudinal pitch angle
      */
-    virtual void update( double omega,
+    virtual void update( double timeStep,
+                         double omega,
                          double azimuth,
                          double collective,
                          double cyclicLat,
                          double cyclicLon );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -167,6 +193,8 @@ public:
 
     inline const Vector3& getR_hub_BAS() const { return _r_hub_bas; }
 
+    inline const Matrix3x3& getBAS2RAS() const { return _bas2ras; }
+
     inline bool getCCW() const { return _ccw; }
 
     inline int getNumberOfBlades() const { return _nb; }
@@ -191,10 +219,20 @@ public:
 
     inline double getVel_i() const { return _vel_i; }
 
+    inline double getLambda0()  const { return _lambda_0;  }
+    inline double getLambda1c() const { return _lambda_1c; }
+    inline double getLambda1s() const { return _lambda_1s; }
+
+    inline bool getDynamicInflow() const { return _dynamicInflow; }
+
     inline double getWakeSkew() const { return _wakeSkew; }
 
 protected:
 
+    static const double _inflowMass0;   ///< [-] apparent mass coefficient of the uniform inflow component
+    static const double _inflowMass1;   ///< [-] apparent mass coefficient of the inflow harmonics
+    static const double _inflowSkew;    ///< [-] wake skew coupling coefficient
+
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
     Vector3 _mom_bas;           ///< [N*m] total moment vector expressed in BAS
 
@@ -221,6 +259,8 @@ protected:
     Matrix3x3 _cwas2bas;        ///< matrix of rotation from CWAS to BAS
 
     bool _ccw;                  ///< specifies if rotor rotation direction is counter-clockwise
+    bool _dynamicInflow;        ///< specifies if dynamic inflow model is used
+    bool _inflowReady;          ///< specifies if dynamic inflow states are initialized
 
     int _nb;                    ///< number of rotor blades
 
@@ -285,6 +325,32 @@ protected:
     double _vel_i;              ///< [m/s] rotor induced velocity
 
     double _wakeSkew;           ///< [rad] rotor wake skew angle
+
+    double _lambda_0;           ///< [-] uniform induced inflow ratio (positive downwards)
+    double _lambda_1c;          ///< [-] longitudinal induced inflow ratio (positive downwards at the rear)
+    double _lambda_1s;          ///< [-] lateral induced inflow ratio
+
+    double _l_00;               ///< [-] inflow gain matrix item (uniform component due to thrust)
+    double _l_20;               ///< [-] inflow gain matrix item (longitudinal component due to thrust)
+    double _l_11;               ///< [-] inflow gain matrix item (lateral component due to rolling moment)
+    double _l_22;               ///< [-] inflow gain matrix item (longitudinal component due to pitching moment)
+
+    /**
+     * @brief Updates dynamic inflow states.
+     * Linear part of the inflow equations is integrated implicitly, so it is
+     * stable regardless of the time step, thrust coefficient is taken from
+     * the most recent computation.
+     * @param timeStep [s] time step
+     */
+    virtual void updateInflow( double timeStep );
+
+    /**
+     * @brief Computes inflow gain matrix.
+     * @param mu       [-] advance ratio
+     * @param lambda   [-] total inflow ratio (positive upwards)
+     * @param lambda_i [-] uniform induced inflow ratio (positive downwards)
+     */
+    void computeInflowGains( double mu, double lambda, double lambda_i );
 };
 
 } // end of fdm namespace
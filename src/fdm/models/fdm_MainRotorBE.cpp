@@ -23,6 +23,7 @@
 #include <fdm/models/fdm_MainRotorBE.h>
 
 #include <fdm/utils/fdm_GaussJordan.h>
+#include <fdm/utils/fdm_Profiler.h>
 #include <fdm/utils/fdm_String.h>
 
 #include <fdm/xml/fdm_XmlUtils.h>
@@ -35,12 +36,40 @@ using namespace fdm;
 
 const double MainRotorBE::_timeStepMax = 1.0e-2;
 
+const double MainRotorBE::_timeStepMin         = 1.0e-3;
+const double MainRotorBE::_adaptiveTimeStepMax = 2.5e-2;
+const double MainRotorBE::_azimuthStepMax      = 0.5;
+const double MainRotorBE::_betaStepMax         = 2.0e-2;
+const double MainRotorBE::_betaTolerance       = 1.0e-3;
+
+const unsigned int MainRotorBE::_parallelThreshold  = 40;
+const unsigned int MainRotorBE::_parallelThreadsMax = 4;
+
+bool MainRotorBE::_parallelEnabled = true;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorBE::setParallelEnabled( bool enabled )
+{
+    _parallelEnabled = enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool MainRotorBE::getParallelEnabled()
+{
+    return _parallelEnabled;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 MainRotorBE::MainRotorBE() :
     _direction ( CW ),
 
     _blades_no ( 0 ),
+    _steps ( 0 ),
+
+    _adaptive ( false ),
 
     _radius ( 0.0 ),
 
@@ -111,6 +140,8 @@ void MainRotorBE::readData( XmlNode &dataNode )
             _direction = CW;
         }
 
+        _adaptive = String::toBool( dataNode.getAttribute( "adaptive-steps" ), false );
+
         double inclination = 0.0;
 
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_r_hub_bas  , "hub_center" );
@@ -141,6 +172,26 @@ void MainRotorBE::readData( XmlNode &dataNode )
             _i_tot += blade->getInertia();
 
             _blades.push_back( blade );
+
+            // blade azimuth offset
+            _cosDeltaPsi.push_back( cos( i * _d_psi ) );
+            _sinDeltaPsi.push_back( sin( i * _d_psi ) );
+
+            _prev_beta_dot.push_back( 0.0 );
+        }
+
+        // parallel blades integration
+        _workerPool.reset();
+
+        unsigned int threads = WorkerPool::getHardwareThreads();
+
+        if ( threads > _parallelThreadsMax ) threads = _parallelThreadsMax;
+        if ( threads > _blades.size()      ) threads = _blades.size();
+
+        if ( _parallelEnabled && threads > 1
+          && _blades.size() * RotorBlade::_stations >= _parallelThreshold )
+        {
+            _workerPool = WorkerPool::getShared( threads );
         }
     }
     else
@@ -172,30 +223,32 @@ void MainRotorBE::computeForceAndMoment( const Vector3 &vel_air_bas,
     Vector3 eps_ras     = _bas2ras * eps_bas;
     Vector3 grav_ras    = _bas2ras * grav_bas;
 
-    double delta_psi = 0.0;
+    double cosPsi = cos( _azimuth );
+    double sinPsi = sin( _azimuth );
 
-    for ( Blades::iterator it = _blades.begin(); it != _blades.end(); ++it )
+    for ( unsigned int i = 0; i < _blades.size(); i++ )
     {
-        (*it)->computeForceAndMoment( vel_air_ras,
+        RotorBlade *blade = _blades[ i ];
+
+        blade->computeForceAndMoment( vel_air_ras,
                                       omg_air_ras,
                                       omg_ras,
                                       acc_ras,
                                       eps_ras,
                                       grav_ras,
                                       _omega,
-                                      _azimuth + delta_psi,
+                                      cosPsi * _cosDeltaPsi[ i ] - sinPsi * _sinDeltaPsi[ i ],
+                                      sinPsi * _cosDeltaPsi[ i ] + cosPsi * _sinDeltaPsi[ i ],
                                       airDensity,
                                       _theta_0,
                                       _theta_1c,
                                       _theta_1s
                                     );
 
-        _for_bas += _ras2bas * (*it)->getFor_RAS();
-        _mom_bas += _ras2bas * (*it)->getMom_RAS();
-
-        _torque += (*it)->getTorque();
+        _for_bas += _ras2bas * blade->getFor_RAS();
+        _mom_bas += _ras2bas * blade->getMom_RAS();
 
-        delta_psi += _d_psi;
+        _torque += blade->getTorque();
     }
 
     _mom_bas += _r_hub_bas % _for_bas;
@@ -217,6 +270,8 @@ void MainRotorBE::update( double timeStep,
                           double cyclicLat,
                           double cyclicLon )
 {
+    FDM_PROFILE_FUNCTION();
+
     _prev_vel_air_ras = _vel_air_ras;
     _prev_omg_air_ras = _omg_air_ras;
     _prev_omg_ras     = _omg_ras;
@@ -257,9 +312,25 @@ void MainRotorBE::update( double timeStep,
     double d_theta_1c = _theta_1c - _prev_theta_1c;
     double d_theta_1s = _theta_1s - _prev_theta_1s;
 
-    const int steps = ceil( timeStep / _timeStepMax );
+    const int steps = _adaptive ? getAdaptiveSteps( timeStep )
+                                : ceil( timeStep / _timeStepMax );
     double timeStepInt = timeStep / ( (double)steps );
 
+    _steps = steps;
+
+    for ( unsigned int i = 0; i < _blades.size(); i++ )
+    {
+        _prev_beta_dot[ i ] = _blades[ i ]->getBetaDot();
+    }
+
+    // azimuth advances by the same angle every sub-step, so its sine
+    // and cosine are updated incrementally
+    double cosPsi = cos( _prev_azimuth );
+    double sinPsi = sin( _prev_azimuth );
+
+    const double cosStep = cos( d_azimuth / ( (double)steps ) );
+    const double sinStep = sin( d_azimuth / ( (double)steps ) );
+
     for ( int i = 0; i < steps; i++ )
     {
         const double coef = ( (double)( i + 1 ) ) / ( (double)steps );
@@ -271,34 +342,92 @@ void MainRotorBE::update( double timeStep,
         Vector3 eps_ras     = _prev_eps_ras     + coef * d_eps_ras;
         Vector3 grav_ras    = _prev_grav_ras    + coef * d_grav_ras;
 
-        double azimuth = _prev_azimuth + coef * d_azimuth;
+        double cosPsi_prev = cosPsi;
+
+        cosPsi = cosPsi_prev * cosStep - sinPsi * sinStep;
+        sinPsi = sinPsi * cosStep + cosPsi_prev * sinStep;
 
         double theta_0  = _prev_theta_0  + coef * d_theta_0;
         double theta_1c = _prev_theta_1c + coef * d_theta_1c;
         double theta_1s = _prev_theta_1s + coef * d_theta_1s;
 
-        double delta_psi = 0.0;
+        // blades are independent given the hub state
+        WorkerPool::Task task = [ & ]( unsigned int index )
+        {
+            _blades[ index ]->integrate( timeStepInt,
+                                         vel_air_ras,
+                                         omg_air_ras,
+                                         omg_ras,
+                                         acc_ras,
+                                         eps_ras,
+                                         grav_ras,
+                                         omega,
+                                         cosPsi * _cosDeltaPsi[ index ] - sinPsi * _sinDeltaPsi[ index ],
+                                         sinPsi * _cosDeltaPsi[ index ] + cosPsi * _sinDeltaPsi[ index ],
+                                         airDensity,
+                                         theta_0,
+                                         theta_1c,
+                                         theta_1s
+                                       );
+        };
+
+        if ( !_workerPool || !_workerPool->tryRun( _blades.size(), task ) )
+        {
+            for ( unsigned int j = 0; j < _blades.size(); j++ ) task( j );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
 
-        for ( Blades::iterator it = _blades.begin(); it != _blades.end(); ++it )
+int MainRotorBE::getAdaptiveSteps( double timeStep ) const
+{
+    // coefficient chosen so at advance ratio 0.4 azimuth resolution is
+    // the same as with the fixed maximum time step at typical rotor speed
+    const double mu_coef = 2.5;
+
+    double timeStepMax = _adaptiveTimeStepMax;
+
+    // azimuth advance
+    double omega = fabs( _omega );
+
+    if ( omega > 1.0e-3 )
+    {
+        double vel_tip = omega * _radius;
+        double vel_xy = sqrt( _vel_air_ras.x() * _vel_air_ras.x()
+                            + _vel_air_ras.y() * _vel_air_ras.y() );
+
+        double mu = vel_tip > 1.0e-3 ? vel_xy / vel_tip : 0.0;
+
+        double h = _azimuthStepMax / ( ( 1.0 + mu_coef * mu ) * omega );
+
+        if ( h < timeStepMax ) timeStepMax = h;
+    }
+
+    for ( unsigned int i = 0; i < _blades.size(); i++ )
+    {
+        double beta_dot = _blades[ i ]->getBetaDot();
+
+        // flapping angle variation
+        if ( fabs( beta_dot ) * timeStepMax > _betaStepMax )
         {
-            (*it)->integrate( timeStepInt,
-                              vel_air_ras,
-                              omg_air_ras,
-                              omg_ras,
-                              acc_ras,
-                              eps_ras,
-                              grav_ras,
-                              omega,
-                              azimuth + delta_psi,
-                              airDensity,
-                              theta_0,
-                              theta_1c,
-                              theta_1s
-                            );
-
-            delta_psi += _d_psi;
+            timeStepMax = _betaStepMax / fabs( beta_dot );
+        }
+
+        // flapping angle second order variation since the previous update
+        double d_beta_dot = fabs( beta_dot - _prev_beta_dot[ i ] );
+
+        if ( d_beta_dot * timeStepMax * timeStepMax > 2.0 * _betaTolerance * timeStep )
+        {
+            timeStepMax = sqrt( 2.0 * _betaTolerance * timeStep / d_beta_dot );
         }
     }
+
+    if ( timeStepMax < _timeStepMin ) timeStepMax = _timeStepMin;
+
+    int steps = ceil( timeStep / timeStepMax );
+
+    return steps > 1 ? steps : 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -335,3 +464,65 @@ void MainRotorBE::inducedVelcoity()
 //        if ( Misc::isValid( lambda_i_new ) ) lambda_i = lambda_i_new;
 //    }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorBE::archiveState( StateArchive *archive )
+{
+    for ( Blades::iterator it = _blades.begin(); it != _blades.end(); ++it )
+    {
+        (*it)->archiveState( archive );
+    }
+
+    archive->add( &_prev_beta_dot, _blades_no );
+
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_vel_air_ras );
+    archive->add( &_omg_air_ras );
+    archive->add( &_omg_ras );
+    archive->add( &_acc_ras );
+    archive->add( &_eps_ras );
+    archive->add( &_grav_ras );
+
+    archive->add( &_prev_vel_air_ras );
+    archive->add( &_prev_omg_air_ras );
+    archive->add( &_prev_omg_ras );
+    archive->add( &_prev_acc_ras );
+    archive->add( &_prev_eps_ras );
+    archive->add( &_prev_grav_ras );
+
+    archive->add( &_steps );
+
+    archive->add( &_omega );
+    archive->add( &_azimuth );
+
+    archive->add( &_beta_0 );
+    archive->add( &_beta_1c );
+    archive->add( &_beta_1s );
+
+    archive->add( &_theta_0 );
+    archive->add( &_theta_1c );
+    archive->add( &_theta_1s );
+
+    archive->add( &_coningAngle );
+    archive->add( &_diskRoll );
+    archive->add( &_diskPitch );
+
+    archive->add( &_ct );
+    archive->add( &_cq );
+
+    archive->add( &_thrust );
+    archive->add( &_torque );
+
+    archive->add( &_vel_i );
+
+    archive->add( &_wakeSkew );
+
+    archive->add( &_prev_azimuth );
+
+    archive->add( &_prev_theta_0 );
+    archive->add( &_prev_theta_1c );
+    archive->add( &_prev_theta_1s );
+}
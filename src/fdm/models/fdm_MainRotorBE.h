@@ -24,8 +24,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <memory>
+
 #include <fdm/models/fdm_RotorBlade.h>
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
+#include <fdm/utils/fdm_WorkerPool.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -47,7 +53,7 @@ namespace fdm
  *
  * XML configuration file format:
  * @code
- * <main_rotor>
+ * <main_rotor [counter-clockwise="{ true|false }"] [adaptive-steps="{ 0|1 }"]>
  *   <hub_center> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </hub_center>
  *   <inclination> { [rad] rotor inclination angle (positive if forward) } </inclination>
  *   <number_of_blades> { number of blades } </number_of_blades>
@@ -58,9 +64,23 @@ namespace fdm
  * </main_rotor>
  * @endcode
  *
+ * Blades are independent within a single integration sub-step, so they are
+ * integrated in parallel by the process-wide worker pool when the number of
+ * blades spanwise stations reaches _parallelThreshold and there is more
+ * than one hardware thread (see setParallelEnabled()). Rotors share the pool,
+ * if it is busy integrating another rotor blades are integrated serially.
+ *
+ * By default rotor is integrated with fixed sub-step not greater than
+ * _timeStepMax. When adaptive-steps attribute is set to 1 number of
+ * sub-steps is chosen every update, within _timeStepMin and
+ * _adaptiveTimeStepMax bounds, due to the following criteria:
+ * - azimuth advance per sub-step, limited more the greater is advance ratio,
+ * - flapping angle variation per sub-step,
+ * - flapping angle rate variation since the previous update.
+ *
  * @see fdm::Blade
  */
-class FDMEXPORT MainRotorBE
+class FDMEXPORT MainRotorBE : public ArenaObject
 {
 public:
 
@@ -75,6 +95,25 @@ public:
 
     static const double _timeStepMax;       ///< [s] maximum integration time step
 
+    static const double _timeStepMin;           ///< [s] minimum adaptive integration time step
+    static const double _adaptiveTimeStepMax;   ///< [s] maximum adaptive integration time step
+    static const double _azimuthStepMax;        ///< [rad] maximum azimuth advance per adaptive sub-step at zero advance ratio
+    static const double _betaStepMax;           ///< [rad] maximum flapping angle variation per adaptive sub-step
+    static const double _betaTolerance;         ///< [rad] flapping angle variation error tolerance
+
+    static const unsigned int _parallelThreshold;   ///< minimum number of blades spanwise stations for parallel integration
+    static const unsigned int _parallelThreadsMax;  ///< maximum number of threads integrating blades
+
+    /**
+     * @brief Enables or disables parallel blades integration.
+     * Affects only rotors which data is read afterwards. Enabled by default.
+     * @param enabled specifies if parallel blades integration is enabled
+     */
+    static void setParallelEnabled( bool enabled );
+
+    /** @return true if parallel blades integration is enabled */
+    static bool getParallelEnabled();
+
     /** @brief Constructor. */
     MainRotorBE();
 
@@ -135,6 +174,12 @@ public:
                          double cyclicLat,
                          double cyclicLon );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline Direction getDirection() const { return _direction; }
 
     inline const RotorBlade* getBlade( int index ) const { return _blades[ index ]; }
@@ -173,12 +218,22 @@ public:
 
     inline double getWakeSkew() const { return _wakeSkew; }
 
+    /** @return number of integration sub-steps used in the last update */
+    inline int getSteps() const { return _steps; }
+
 protected:
 
     Direction _direction;       ///< rotor rotation direction (clockwise or counter-clockwise)
 
     Blades _blades;             ///< main rotor blades
 
+    std::vector< double > _cosDeltaPsi; ///< [-] blades azimuth offsets cosines
+    std::vector< double > _sinDeltaPsi; ///< [-] blades azimuth offsets sines
+
+    std::vector< double > _prev_beta_dot;   ///< [rad/s] blades flapping angles rates (previous values)
+
+    std::shared_ptr< WorkerPool > _workerPool;  ///< blades integration worker pool (null if blades are integrated serially)
+
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
     Vector3 _mom_bas;           ///< [N*m] total moment vector expressed in BAS
 
@@ -202,6 +257,9 @@ protected:
     Vector3 _prev_grav_ras;     ///< [m/s^2]   gravity acceleration vector expressed in RAS (previous value)
 
     int _blades_no;             ///< number of rotor blades
+    int _steps;                 ///< number of integration sub-steps used in the last update
+
+    bool _adaptive;             ///< specifies if number of integration sub-steps is adaptive
 
     double _radius;             ///< [m] rotor radius
 
@@ -241,6 +299,22 @@ protected:
 
     /** */
     virtual void inducedVelcoity();
+
+    /**
+     * @brief Returns adaptive number of integration sub-steps.
+     * @param timeStep [s] time step
+     * @return number of integration sub-steps
+     */
+    virtual int getAdaptiveSteps( double timeStep ) const;
+
+private:
+
+    static bool _parallelEnabled;   ///< specifies if parallel blades integration is enabled
+
+    /**
+     * Using this constructor is forbidden.
+     */
+    MainRotorBE( const MainRotorBE & );
 };
 
 } // end of fdm namespace
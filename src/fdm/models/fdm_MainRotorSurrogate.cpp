@@ -0,0 +1,335 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/models/fdm_MainRotorSurrogate.h>
+#include <fdm/main/fdm_Aerodynamics.h>
+
+#include <fdm/utils/fdm_String.h>
+
+#include <fdm/xml/fdm_XmlUtils.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int MainRotorSurrogate::_args;
+const unsigned int MainRotorSurrogate::_vals;
+
+////////////////////////////////////////////////////////////////////////////////
+
+MainRotorSurrogate::MainRotorSurrogate() :
+    MainRotor()
+{
+    for ( unsigned int i = 0; i < _args; i++ )
+    {
+        _strides[ i ] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MainRotorSurrogate::~MainRotorSurrogate() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogate::readData( XmlNode &dataNode )
+{
+    if ( dataNode.isValid() )
+    {
+        int result = FDM_SUCCESS;
+
+        _ccw = String::toBool( dataNode.getAttribute( "counter-clockwise" ), false );
+
+        double inclination = 0.0;
+        double inertia = 0.0;
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_r_hub_bas, "hub_center" );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &inclination, "inclination" );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_nb, "number_of_blades" );
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_r, "rotor_radius" );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &inertia, "rotor_inertia" );
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_keys[ AdvanceRatio ] , "advance_ratio" );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_keys[ InflowRatio  ] , "inflow_ratio"  );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_keys[ Collective   ] , "collective"    );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_keys[ CyclicCos    ] , "cyclic_cos"    );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_keys[ CyclicSin    ] , "cyclic_sin"    );
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_table, "coefficients" );
+
+        // table size and arguments order
+        unsigned int entries = 1;
+
+        for ( int i = _args - 1; i >= 0 && result == FDM_SUCCESS; i-- )
+        {
+            _strides[ i ] = entries;
+            entries *= _keys[ i ].size();
+
+            for ( unsigned int j = 1; j < _keys[ i ].size(); j++ )
+            {
+                if ( _keys[ i ][ j - 1 ] >= _keys[ i ][ j ] ) result = FDM_FAILURE;
+            }
+        }
+
+        if ( result == FDM_SUCCESS && _table.size() != entries * _vals )
+        {
+            result = FDM_FAILURE;
+        }
+
+        if ( result == FDM_SUCCESS && _nb > 0 )
+        {
+            _bas2ras = Matrix3x3( Angles( 0.0, -inclination, 0.0 ) );
+            _ras2bas = _bas2ras.getTransposed();
+
+            _r2 = _r * _r;
+            _r3 = _r * _r2;
+            _r4 = _r * _r3;
+
+            _ad = M_PI * _r2;
+
+            _ib = inertia / (double)_nb;
+
+            _cd = _ccw ? 1.0 : -1.0;
+        }
+        else
+        {
+            XmlUtils::throwError( __FILE__, __LINE__, dataNode );
+        }
+    }
+    else
+    {
+        XmlUtils::throwError( __FILE__, __LINE__, dataNode );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogate::computeForceAndMoment( const Vector3 &,
+                                                const Vector3 &,
+                                                const Vector3 &,
+                                                const Vector3 &,
+                                                const Vector3 &vel_air_bas,
+                                                const Vector3 &omg_air_bas,
+                                                const Vector3 &,
+                                                double airDensity )
+{
+    double omegaR = _omega * _r;
+    double omegaR2 = omegaR * omegaR;
+
+    // velocity transformations
+    Vector3 vel_air_ras = _bas2ras * ( vel_air_bas + ( omg_air_bas % _r_hub_bas ) );
+
+    // RAS <-> RWAS
+    double beta_ras = Aerodynamics::getSideslipAngle( vel_air_ras );
+
+    _ras2rwas = Matrix3x3( Angles( 0.0, 0.0, beta_ras ) );
+    _rwas2ras = _ras2rwas.getTransposed();
+
+    Vector3 vel_air_rwas = _ras2rwas * vel_air_ras;
+
+    // cyclic pitch expressed as control axes tilt in RWAS
+    Vector3 theta_rwas = _ras2rwas * Vector3( _theta_1c, _theta_1s, 0.0 );
+
+    double args[ _args ];
+    double vals[ _vals ];
+
+    const double omegaR_inv = omegaR > 1.0e-6 ? 1.0 / omegaR : 0.0;
+
+    args[ AdvanceRatio ] = vel_air_rwas.x() * omegaR_inv;
+    args[ InflowRatio  ] = vel_air_rwas.z() * omegaR_inv;
+    args[ Collective   ] = _theta_0;
+    args[ CyclicCos    ] = theta_rwas.x();
+    args[ CyclicSin    ] = theta_rwas.y();
+
+    getValues( args, vals );
+
+    const double mu   =  args[ AdvanceRatio ];
+    const double mu_z = -args[ InflowRatio  ];
+
+    _ct = -vals[ CFZ ];
+    _ch = -vals[ CFX ];
+    _cq = _cd * vals[ CMZ ];
+
+    // disc attitude
+    Vector3 disc_ras = _rwas2ras * Vector3( vals[ DiscRoll ], vals[ DiscPitch ], 0.0 );
+
+    _coningAngle = vals[ Coning ];
+    _diskRoll    = disc_ras.x();
+    _diskPitch   = disc_ras.y();
+
+    _beta_0  =  _coningAngle;
+    _beta_1c = -_diskPitch;
+    _beta_1s = -_diskRoll * _cd;
+
+    _das2bas = Matrix3x3( Angles( _diskRoll, _diskPitch, 0.0 ) ).getTransposed() * _ras2bas;
+    _bas2das = _das2bas.getTransposed();
+
+    // induced velocity (momentum theory, Padfield p.117)
+    double lambda_i = _vel_i * omegaR_inv / _vel_i_factor;
+
+    if ( _ct > 0.0 )
+    {
+        if ( lambda_i < 1.0e-6 ) lambda_i = sqrt( 0.5 * _ct );
+
+        for ( int i = 0; i < 10; i++ )
+        {
+            double lambda = mu_z - lambda_i;
+            double lambda_i_new = 0.5 * ( lambda_i + _ct / ( 2.0 * sqrt( mu*mu + lambda*lambda ) ) );
+
+            if ( !Misc::isValid( lambda_i_new ) ) break;
+
+            bool converged = fabs( lambda_i_new - lambda_i ) < 1.0e-6;
+
+            lambda_i = lambda_i_new;
+
+            if ( converged ) break;
+        }
+    }
+    else
+    {
+        lambda_i = 0.0;
+    }
+
+    _vel_i = _vel_i_factor * lambda_i * omegaR;
+
+    // rotor wake skew angle (Padfield p.121)
+    _wakeSkew = atan2( mu, lambda_i - mu_z );
+
+    // loads
+    double f_coef = airDensity * _ad * omegaR2;
+    double m_coef = f_coef * _r;
+
+    Vector3 for_rwas( vals[ CFX ], vals[ CFY ], vals[ CFZ ] );
+    Vector3 mom_rwas( vals[ CMX ], vals[ CMY ], vals[ CMZ ] );
+
+    _thrust = _ct * f_coef;
+    _hforce = _ch * f_coef;
+    _torque = _cq * m_coef;
+
+    _for_bas = _ras2bas * ( _rwas2ras * for_rwas ) * f_coef;
+    _mom_bas = ( _r_hub_bas % _for_bas )
+             + _ras2bas * ( _rwas2ras * mom_rwas ) * m_coef;
+
+    if ( !_for_bas.isValid() || !_mom_bas.isValid() )
+    {
+        Exception e;
+
+        e.setType( Exception::UnexpectedNaN );
+        e.setInfo( "NaN detected in the main rotor surrogate model." );
+
+        FDM_THROW( e );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogate::getValues( const double args[], double vals[] ) const
+{
+    for ( unsigned int v = 0; v < _vals; v++ )
+    {
+        vals[ v ] = 0.0;
+    }
+
+    if ( _table.size() == 0 ) return;
+
+    unsigned int index[ _args ];
+    double weight[ _args ];
+
+    for ( unsigned int i = 0; i < _args; i++ )
+    {
+        const std::vector< double > &keys = _keys[ i ];
+
+        const unsigned int size = keys.size();
+
+        index  [ i ] = 0;
+        weight [ i ] = 0.0;
+
+        if ( size > 1 )
+        {
+            // arguments are limited to the table range
+            if ( args[ i ] <= keys[ 0 ] )
+            {
+                index[ i ] = 0;
+            }
+            else if ( args[ i ] >= keys[ size - 1 ] )
+            {
+                index  [ i ] = size - 2;
+                weight [ i ] = 1.0;
+            }
+            else
+            {
+                unsigned int lo = 0;
+                unsigned int hi = size - 1;
+
+                while ( hi - lo > 1 )
+                {
+                    unsigned int mid = ( lo + hi ) / 2;
+
+                    if ( keys[ mid ] <= args[ i ] )
+                        lo = mid;
+                    else
+                        hi = mid;
+                }
+
+                index  [ i ] = lo;
+                weight [ i ] = ( args[ i ] - keys[ lo ] ) / ( keys[ hi ] - keys[ lo ] );
+            }
+        }
+    }
+
+    // multilinear interpolation over hypercube corners
+    for ( unsigned int corner = 0; corner < ( 1u << _args ); corner++ )
+    {
+        double coef = 1.0;
+        unsigned int offset = 0;
+
+        for ( unsigned int i = 0; i < _args && coef != 0.0; i++ )
+        {
+            if ( corner & ( 1u << i ) )
+            {
+                // single value argument has no upper corner
+                if ( _keys[ i ].size() < 2 ) coef = 0.0;
+
+                coef   *= weight[ i ];
+                offset += ( index[ i ] + 1 ) * _strides[ i ];
+            }
+            else
+            {
+                coef   *= ( 1.0 - weight[ i ] );
+                offset += index[ i ] * _strides[ i ];
+            }
+        }
+
+        if ( coef != 0.0 )
+        {
+            const double *entry = &( _table[ offset * _vals ] );
+
+            for ( unsigned int v = 0; v < _vals; v++ )
+            {
+                vals[ v ] += coef * entry[ v ];
+            }
+        }
+    }
+}
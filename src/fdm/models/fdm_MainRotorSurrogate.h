@@ -0,0 +1,170 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_MAINROTORSURROGATE_H
+#define FDM_MAINROTORSURROGATE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/models/fdm_MainRotor.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Helicopter main rotor lookup table surrogate model class.
+ *
+ * This model replaces the rotor aerodynamics with a table of rotor hub
+ * loads, usually generated offline by sweeping blade element rotor model
+ * (see mscsim_batch -r option). It has the same interface as MainRotor, so it
+ * can be used instead of it where rotor fidelity is less important than
+ * computation cost, e.g. for fleet-scale batch runs.
+ *
+ * Table is expressed in Rotor-Wind Axis System and is nondimensional, so it
+ * is valid for all sideslip angles, air densities and, apart from the
+ * compressibility effects, rotor revolution speeds. Table arguments are
+ * advance ratio, inflow ratio (hub airspeed component along the rotor shaft
+ * axis, positive downwards, over tip speed), collective pitch and cyclic
+ * pitch cosine and sine components in the rotor-wind axes. Table values are
+ * force and moment coefficients (divided by rho*A*(Omega*R)^2 and
+ * rho*A*R*(Omega*R)^2 respectively, moment is about the hub center), coning
+ * angle and disc roll and pitch angles. Values are interpolated multilinearly
+ * and arguments are limited to the table range.
+ *
+ * Rotor loads due to angular rates and accelerations are not tabulated.
+ * Induced velocity and wake skew angle are estimated from the thrust
+ * coefficient using the momentum theory.
+ *
+ * XML configuration file format:
+ * @code
+ * <main_rotor [counter-clockwise="{ 0|1 }"]>
+ *   <hub_center> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </hub_center>
+ *   <inclination> { [rad] rotor inclination angle (positive if forward) } </inclination>
+ *   <number_of_blades> { number of blades } </number_of_blades>
+ *   <rotor_radius> { [m] rotor radius } </rotor_radius>
+ *   <rotor_inertia> { [kg*m^2] rotor total inertia about shaft axis } </rotor_inertia>
+ *   <advance_ratio> { [-] advance ratio values } </advance_ratio>
+ *   <inflow_ratio> { [-] inflow ratio values } </inflow_ratio>
+ *   <collective> { [rad] collective pitch values } </collective>
+ *   <cyclic_cos> { [rad] cyclic pitch cosine component values } </cyclic_cos>
+ *   <cyclic_sin> { [rad] cyclic pitch sine component values } </cyclic_sin>
+ *   <coefficients>
+ *     { cfx } { cfy } { cfz } { cmx } { cmy } { cmz } { coning } { disc roll } { disc pitch }
+ *     ... { more entries, cyclic sine changes fastest, advance ratio slowest }
+ *   </coefficients>
+ * </main_rotor>
+ * @endcode
+ *
+ * @see MainRotor
+ * @see MainRotorBE
+ */
+class FDMEXPORT MainRotorSurrogate : public MainRotor
+{
+public:
+
+    /** Table arguments. */
+    enum Argument
+    {
+        AdvanceRatio = 0,   ///< advance ratio
+        InflowRatio,        ///< inflow ratio
+        Collective,         ///< collective pitch
+        CyclicCos,          ///< cyclic pitch cosine component
+        CyclicSin           ///< cyclic pitch sine component
+    };
+
+    /** Table values. */
+    enum Value
+    {
+        CFX = 0,            ///< x-axis force coefficient
+        CFY,                ///< y-axis force coefficient
+        CFZ,                ///< z-axis force coefficient
+        CMX,                ///< x-axis moment coefficient
+        CMY,                ///< y-axis moment coefficient
+        CMZ,                ///< z-axis moment coefficient
+        Coning,             ///< coning angle
+        DiscRoll,           ///< disc roll angle
+        DiscPitch           ///< disc pitch angle
+    };
+
+    static const unsigned int _args = 5;    ///< number of table arguments
+    static const unsigned int _vals = 9;    ///< number of table values
+
+    /** @brief Constructor. */
+    MainRotorSurrogate();
+
+    /** @brief Destructor. */
+    virtual ~MainRotorSurrogate();
+
+    /**
+     * @brief Reads data.
+     * @param dataNode XML node
+     */
+    virtual void readData( XmlNode &dataNode );
+
+    /**
+     * @brief Computes force and moment.
+     * @param vel_bas     [m/s]     aircraft linear velocity vector expressed in BAS
+     * @param omg_bas     [rad/s]   aircraft angular velocity expressed in BAS
+     * @param acc_bas     [m/s^2]   aircraft linear acceleration vector expressed in BAS
+     * @param eps_bas     [rad/s^2] aircraft angular acceleration vector expressed in BAS
+     * @param vel_air_bas [m/s]     aircraft linear velocity relative to the air expressed in BAS
+     * @param omg_air_bas [rad/s]   aircraft angular velocity relative to the air expressed in BAS
+     * @param grav_bas    [m/s^2]   gravity acceleration vector expressed in BAS
+     * @param airDensity  [kg/m^3]  air density
+     */
+    virtual void computeForceAndMoment( const Vector3 &vel_bas,
+                                        const Vector3 &omg_bas,
+                                        const Vector3 &acc_bas,
+                                        const Vector3 &eps_bas,
+                                        const Vector3 &vel_air_bas,
+                                        const Vector3 &omg_air_bas,
+                                        const Vector3 &grav_bas,
+                                        double airDensity );
+
+    /**
+     * @brief Interpolates table values.
+     * @param args table arguments (see Argument)
+     * @param vals table values (see Value)
+     */
+    void getValues( const double args[], double vals[] ) const;
+
+protected:
+
+    std::vector< double > _keys[ _args ];   ///< table arguments values
+    std::vector< double > _table;           ///< table values
+
+    unsigned int _strides[ _args ];         ///< table strides (in entries)
+
+private:
+
+    /** Using this constructor is forbidden. */
+    MainRotorSurrogate( const MainRotorSurrogate & );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_MAINROTORSURROGATE_H
@@ -46,7 +46,11 @@ PistonEngine::PistonEngine() :
     _power    ( 0.0 ),
     _torque   ( 0.0 ),
     _airFlow  ( 0.0 ),
-    _fuelFlow ( 0.0 )
+    _fuelFlow ( 0.0 ),
+
+    _torque_omega ( 0.0 ),
+
+    _torqueDerivative ( false )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -110,6 +114,26 @@ void PistonEngine::update( double throttleLever,
     // engine torque [N*m]
     _torque = ( omega > 1.0 ) ? _power / omega : _power;
 
+    if ( _torqueDerivative )
+    {
+        // central difference, engine power tables are piecewise linear
+        double rpm_1 = Misc::max( 0.0, _rpm - 1.0 );
+        double rpm_2 = _rpm + 1.0;
+
+        double omega_1 = M_PI * rpm_1 / 30.0;
+        double omega_2 = M_PI * rpm_2 / 30.0;
+
+        double power_1 = getNetPower( throttleLever, mixtureLever, rpm_1, airDensity, densityAlt,
+                                      fuel, magneto_l, magneto_r );
+        double power_2 = getNetPower( throttleLever, mixtureLever, rpm_2, airDensity, densityAlt,
+                                      fuel, magneto_l, magneto_r );
+
+        double torque_1 = ( omega_1 > 1.0 ) ? power_1 / omega_1 : power_1;
+        double torque_2 = ( omega_2 > 1.0 ) ? power_2 / omega_2 : power_2;
+
+        _torque_omega = ( torque_2 - torque_1 ) / ( omega_2 - omega_1 );
+    }
+
     // state
     if ( _power > 0.0 || ( _rpm > _rpm_min && fuel && ( magneto_l || magneto_r ) ) )
     {
@@ -203,3 +227,19 @@ double PistonEngine::getNetPower( double throttleLever, double mixtureLever, dou
 
     return power;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PistonEngine::archiveState( StateArchive *archive )
+{
+    archive->addEnum( &_state );
+
+    archive->add( &_rpm );
+    archive->add( &_map );
+    archive->add( &_power );
+    archive->add( &_torque );
+    archive->add( &_airFlow );
+    archive->add( &_fuelFlow );
+
+    archive->add( &_torque_omega );
+}
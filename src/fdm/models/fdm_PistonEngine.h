@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -77,7 +79,7 @@ namespace fdm
  *
  * @see Allerton D.: Principles of Flight Simulation, 2009, p.128
  */
-class FDMEXPORT PistonEngine
+class FDMEXPORT PistonEngine : public ArenaObject
 {
 public:
 
@@ -125,6 +127,12 @@ public:
                          bool magneto_l = true,
                          bool magneto_r = true );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     /**
      * @brief Returns engine state.
      * @return engine state
@@ -197,6 +205,25 @@ public:
         return _torque;
     }
 
+    /**
+     * @brief Returns torque derivative with respect to angular velocity.
+     * Valid only if torque derivative computation is enabled.
+     * @return [N*m*s/rad] torque derivative with respect to angular velocity
+     */
+    inline double getTorqueDerivative() const
+    {
+        return _torque_omega;
+    }
+
+    /**
+     * @brief Enables or disables torque derivative computation.
+     * @param enabled specifies if torque derivative should be computed
+     */
+    inline void setTorqueDerivativeEnabled( bool enabled )
+    {
+        _torqueDerivative = enabled;
+    }
+
     void setRPM( double rpm );
 
 protected:
@@ -225,6 +252,10 @@ protected:
     double _airFlow;            ///< [kg/s] air flow
     double _fuelFlow;           ///< [kg/s] fuel flow
 
+    double _torque_omega;       ///< [N*m*s/rad] torque derivative with respect to angular velocity
+
+    bool _torqueDerivative;     ///< specifies if torque derivative is computed
+
     /**
      * @brief Computes manifold absolute pressure.
      * @param throttleLever [0.0,1.0] throttle lever position
@@ -48,8 +48,23 @@ Propeller::Propeller() :
     _thrust    ( 0.0 ),
 
     _torqueAvailable ( 0.0 ),
-    _torqueRequired  ( 0.0 )
-{}
+    _torqueRequired  ( 0.0 ),
+
+    _torqueRequired_omega ( 0.0 ),
+
+    _index_thrust ( 0 ),
+    _index_power  ( 0 ),
+
+    _precomputed ( false ),
+    _implicit    ( false )
+{
+    _coefs.thrust         = 0.0;
+    _coefs.power          = 0.0;
+    _coefs.thrust_advance = 0.0;
+    _coefs.thrust_pitch   = 0.0;
+    _coefs.power_advance  = 0.0;
+    _coefs.power_pitch    = 0.0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -72,6 +87,12 @@ void Propeller::readData( XmlNode &dataNode )
             _direction = CW;
         }
 
+        _precomputed = String::toBool( dataNode.getAttribute( "precomputed" ), false );
+        _implicit    = String::toBool( dataNode.getAttribute( "implicit"    ), false );
+
+        // implicit integration uses derivatives provided by propeller map
+        if ( _implicit ) _precomputed = true;
+
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_pos_bas   , "position"   );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_gearRatio , "gear_ratio" );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_diameter  , "diameter"   );
@@ -88,6 +109,10 @@ void Propeller::readData( XmlNode &dataNode )
 
             _coefThrust .multiplyCols( Units::deg2rad() );
             _coefPower  .multiplyCols( Units::deg2rad() );
+
+            _map.clear();
+            _index_thrust = _map.add( _coefThrust );
+            _index_power  = _map.add( _coefPower  );
         }
         else
         {
@@ -107,7 +132,18 @@ void Propeller::computeThrust( double airspeed, double airDensity )
     if ( _speed_rps > 0.0 )
     {
         double advance = airspeed / ( _diameter * _speed_rps );
-        double coefThrust = _coefThrust.getValue( advance, _pitch );
+        double coefThrust = 0.0;
+
+        if ( _precomputed )
+        {
+            Coefs coefs;
+            getCoefs( advance, _pitch, &coefs );
+            coefThrust = coefs.thrust;
+        }
+        else
+        {
+            coefThrust = _coefThrust.getValue( advance, _pitch );
+        }
 
         _thrust = coefThrust * airDensity * Misc::pow2( _speed_rps ) * Misc::pow4( _diameter );
     }
@@ -138,6 +174,42 @@ void Propeller::integrate( double timeStep, double engineInertia )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Propeller::integrate( double timeStep, double engineInertia,
+                           double engineTorqueDerivative )
+{
+    if ( _implicit )
+    {
+        double inertia = _inertia + engineInertia;
+
+        // engine angular velocity is propeller angular velocity divided by gear ratio
+        double torqueAvailable_omega = engineTorqueDerivative / ( _gearRatio * _gearRatio );
+
+        // linearized backward Euler
+        // I * ( omega_1 - omega_0 ) / dt = Qa - Qr + ( dQa/domega - dQr/domega ) * ( omega_1 - omega_0 )
+        // negative damping is not taken into account to keep it unconditionally stable
+        double damping = Misc::max( 0.0, _torqueRequired_omega - torqueAvailable_omega );
+
+        _omega += ( ( _torqueAvailable - _torqueRequired ) / ( inertia + damping * timeStep ) ) * timeStep;
+
+        _speed_rps = Misc::max( 0.0, _omega / ( 2.0 * M_PI ) );
+
+        // engine friction stops propeller
+        if ( _torqueAvailable < _torqueRequired && _speed_rps < 1.0 )
+        {
+            _speed_rps = _speed_rps < 0.1 ? 0.0 : Misc::inertia( 0.0, _speed_rps, timeStep, 0.1 );
+            _omega = 2.0 * M_PI * _speed_rps;
+        }
+
+        _speed_rpm = 60.0 * _speed_rps;
+    }
+    else
+    {
+        integrate( timeStep, engineInertia );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Propeller::update( double propellerLever,
                         double engineTorque,
                         double airspeed,
@@ -146,13 +218,163 @@ void Propeller::update( double propellerLever,
     _pitch = getPropellerPitch( propellerLever );
 
     double advance = airspeed / ( _diameter * ( _speed_rps > 0.1 ? _speed_rps : 0.1 ) );
-    double coefPower = _coefPower.getValue( advance, _pitch );
+    double coefPower = 0.0;
+
+    if ( _precomputed )
+    {
+        getCoefs( advance, _pitch, &_coefs );
+        coefPower = _coefs.power;
+    }
+    else
+    {
+        coefPower = _coefPower.getValue( advance, _pitch );
+    }
+
     double powerRequired = coefPower * airDensity * Misc::pow3( _speed_rps ) * Misc::pow5( _diameter );
 
     _inducedVelocity = getInducedVelocity( airspeed, airDensity );
 
     _torqueRequired  = powerRequired / ( _omega > 1.0 ? _omega : 1.0 );
     _torqueAvailable = engineTorque / _gearRatio;
+
+    if ( _precomputed )
+    {
+        // Q = Cp * rho * n^2 * D^5 / ( 2*pi ), J = V / ( n * D ), omega = 2*pi*n
+        // dQ/domega = rho * n * D^5 * ( 2*Cp - J * dCp/dJ ) / ( 4*pi^2 )
+        if ( _speed_rps > 0.1 && _omega > 1.0 )
+        {
+            _torqueRequired_omega = airDensity * _speed_rps * Misc::pow5( _diameter )
+                    * ( 2.0 * coefPower - advance * _coefs.power_advance )
+                    / ( 4.0 * M_PI * M_PI );
+        }
+        else
+        {
+            _torqueRequired_omega = 0.0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Propeller::computeThrust( Propeller *const *props, unsigned int count,
+                               double airspeed, double airDensity )
+{
+    if ( count > 0 && props[ 0 ]->_precomputed )
+    {
+        // propeller map already evaluates all coefficients in one lookup
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            props[ i ]->Propeller::computeThrust( airspeed, airDensity );
+        }
+
+        return;
+    }
+
+    double advance    [ _lockstep ];
+    double pitch      [ _lockstep ];
+    double coefThrust [ _lockstep ];
+
+    for ( unsigned int i0 = 0; i0 < count; i0 += _lockstep )
+    {
+        unsigned int n = ( count - i0 < _lockstep ) ? count - i0 : _lockstep;
+
+        for ( unsigned int i = 0; i < n; i++ )
+        {
+            const Propeller *prop = props[ i0 + i ];
+
+            advance [ i ] = prop->_speed_rps > 0.0 ? airspeed / ( prop->_diameter * prop->_speed_rps ) : 0.0;
+            pitch   [ i ] = prop->_pitch;
+        }
+
+        props[ 0 ]->_coefThrust.getValues( n, advance, pitch, coefThrust );
+
+        for ( unsigned int i = 0; i < n; i++ )
+        {
+            Propeller *prop = props[ i0 + i ];
+
+            if ( prop->_speed_rps > 0.0 )
+            {
+                prop->_thrust = coefThrust[ i ] * airDensity
+                        * Misc::pow2( prop->_speed_rps ) * Misc::pow4( prop->_diameter );
+            }
+            else
+            {
+                prop->_thrust = 0.0;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Propeller::update( Propeller *const *props, unsigned int count,
+                        const double *propellerLever,
+                        const double *engineTorque,
+                        double airspeed,
+                        double airDensity )
+{
+    if ( count > 0 && props[ 0 ]->_precomputed )
+    {
+        // propeller map already evaluates all coefficients in one lookup
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            props[ i ]->Propeller::update( propellerLever[ i ], engineTorque[ i ], airspeed, airDensity );
+        }
+
+        return;
+    }
+
+    double advance   [ _lockstep ];
+    double pitch     [ _lockstep ];
+    double coefPower [ _lockstep ];
+
+    for ( unsigned int i0 = 0; i0 < count; i0 += _lockstep )
+    {
+        unsigned int n = ( count - i0 < _lockstep ) ? count - i0 : _lockstep;
+
+        for ( unsigned int i = 0; i < n; i++ )
+        {
+            Propeller *prop = props[ i0 + i ];
+
+            prop->_pitch = prop->getPropellerPitch( propellerLever[ i0 + i ] );
+
+            advance [ i ] = airspeed / ( prop->_diameter * ( prop->_speed_rps > 0.1 ? prop->_speed_rps : 0.1 ) );
+            pitch   [ i ] = prop->_pitch;
+        }
+
+        props[ 0 ]->_coefPower.getValues( n, advance, pitch, coefPower );
+
+        for ( unsigned int i = 0; i < n; i++ )
+        {
+            Propeller *prop = props[ i0 + i ];
+
+            double powerRequired = coefPower[ i ] * airDensity
+                    * Misc::pow3( prop->_speed_rps ) * Misc::pow5( prop->_diameter );
+
+            prop->_inducedVelocity = prop->getInducedVelocity( airspeed, airDensity );
+
+            prop->_torqueRequired  = powerRequired / ( prop->_omega > 1.0 ? prop->_omega : 1.0 );
+            prop->_torqueAvailable = engineTorque[ i0 + i ] / prop->_gearRatio;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Propeller::getCoefs( double advance, double pitch, Coefs *coefs ) const
+{
+    double values      [ 2 ];
+    double derivs_adv  [ 2 ];
+    double derivs_pitch[ 2 ];
+
+    _map.getValues( advance, pitch, values, derivs_adv, derivs_pitch );
+
+    coefs->thrust         = values       [ _index_thrust ];
+    coefs->power          = values       [ _index_power  ];
+    coefs->thrust_advance = derivs_adv   [ _index_thrust ];
+    coefs->thrust_pitch   = derivs_pitch [ _index_thrust ];
+    coefs->power_advance  = derivs_adv   [ _index_power  ];
+    coefs->power_pitch    = derivs_pitch [ _index_power  ];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -195,3 +417,28 @@ double Propeller::getPropellerPitch( double propellerLever )
 {
     return _propPitch.getValue( propellerLever );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Propeller::archiveState( StateArchive *archive )
+{
+    archive->add( &_coefs.thrust );
+    archive->add( &_coefs.power );
+    archive->add( &_coefs.thrust_advance );
+    archive->add( &_coefs.thrust_pitch );
+    archive->add( &_coefs.power_advance );
+    archive->add( &_coefs.power_pitch );
+
+    archive->add( &_pitch );
+    archive->add( &_omega );
+    archive->add( &_speed_rps );
+    archive->add( &_speed_rpm );
+    archive->add( &_thrust );
+
+    archive->add( &_inducedVelocity );
+
+    archive->add( &_torqueAvailable );
+    archive->add( &_torqueRequired );
+
+    archive->add( &_torqueRequired_omega );
+}
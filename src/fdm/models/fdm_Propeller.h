@@ -24,8 +24,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_Table2Pack.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -40,7 +43,7 @@ namespace fdm
  *
  * XML configuration file format:
  * @code
- * <propeller>
+ * <propeller [counter-clockwise="{ 0|1 }"] [precomputed="{ 0|1 }"] [implicit="{ 0|1 }"]>
  *   <position> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </position>
  *   <gear_ratio> { [-] gear ratio (propeller rpm / engine rpm) } </gear_ratio>
  *   <diameter> { [m] propeller diameter } </diameter>
@@ -62,12 +65,21 @@ namespace fdm
  * </propeller>
  * @endcode
  *
+ * Optional "precomputed" attribute enables propeller map evaluating thrust
+ * and power coefficients together with their partial derivatives in a single
+ * lookup, which also provides required torque derivative with respect to
+ * angular velocity.
+ *
+ * Optional "implicit" attribute enables linearized implicit (backward Euler)
+ * integration of propeller angular velocity, which stays stable for large
+ * time steps and low inertia. It requires and enables propeller map.
+ *
  * @see Allerton D.: Principles of Flight Simulation, 2009, p.131
  * @see Raymer D.: Aircraft Design: A Conceptual Approach, 1992, p.327
  * @see Torenbeek E.: Synthesis of Subsonic Airplane Design, 1982, p.191
  * @see Paturski Z.: Przewodnik po projektach z Mechaniki Lotu, Projekt nr 5: Charakterystyki zespolu napedowego. [in Polish]
  */
-class FDMEXPORT Propeller
+class FDMEXPORT Propeller : public ArenaObject
 {
 public:
 
@@ -78,6 +90,17 @@ public:
         CCW = 1     ///< counter-clockwise (looking from cockpit)
     };
 
+    /** Propeller coefficients and their partial derivatives. */
+    struct Coefs
+    {
+        double thrust;              ///< [-]     thrust coefficient
+        double power;               ///< [-]     power coefficient
+        double thrust_advance;      ///< [-]     thrust coefficient derivative with respect to advance
+        double thrust_pitch;        ///< [1/rad] thrust coefficient derivative with respect to pitch
+        double power_advance;       ///< [-]     power coefficient derivative with respect to advance
+        double power_pitch;         ///< [1/rad] power coefficient derivative with respect to pitch
+    };
+
     /** @brief Constructor. */
     Propeller();
 
@@ -104,6 +127,18 @@ public:
      */
     virtual void integrate( double timeStep, double engineInertia );
 
+    /**
+     * @brief Integrates model.
+     * If implicit integration is enabled, required and available torques
+     * are linearized with respect to angular velocity, otherwise it is
+     * equivalent to integrate( double, double ).
+     * @param timeStep [s] time step
+     * @param engineInertia [kg*m^2] engine polar moment of inertia
+     * @param engineTorqueDerivative [N*m*s/rad] engine torque derivative with respect to engine angular velocity
+     */
+    virtual void integrate( double timeStep, double engineInertia,
+                            double engineTorqueDerivative );
+
     /**
      * @brief Updates propeller.
      * @param normPitch    <0.0;1.0> normalized propeller lever position
@@ -116,6 +151,50 @@ public:
                          double airspeed,
                          double airDensity );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
+    /**
+     * @brief Computes thrust of many propellers in lockstep.
+     * All propellers have to share the same thrust coefficient data, which is
+     * taken from the first one, e.g. identical propellers of a multi-engine
+     * aircraft. Results are the same as the ones of computeThrust().
+     * @param props propellers array
+     * @param count number of propellers
+     * @param airspeed [m/s] airspeed
+     * @param airDensity [kg/m^3] air density
+     */
+    static void computeThrust( Propeller *const *props, unsigned int count,
+                               double airspeed, double airDensity );
+
+    /**
+     * @brief Updates many propellers in lockstep.
+     * All propellers have to share the same power coefficient data, which is
+     * taken from the first one. Results are the same as the ones of update().
+     * @param props          propellers array
+     * @param count          number of propellers
+     * @param propellerLever <0.0;1.0> normalized propeller lever positions
+     * @param engineTorque   [N]       engines torques
+     * @param airspeed       [m/s]     airspeed
+     * @param airDensity     [kg/m^3]  air density
+     */
+    static void update( Propeller *const *props, unsigned int count,
+                        const double *propellerLever,
+                        const double *engineTorque,
+                        double airspeed,
+                        double airDensity );
+
+    /**
+     * @brief Computes coefficients using propeller map.
+     * @param advance [-] propeller advance
+     * @param pitch [rad] propeller pitch at 0.75 radius
+     * @param coefs resulting coefficients and their derivatives
+     */
+    void getCoefs( double advance, double pitch, Coefs *coefs ) const;
+
     /**
      * @brief Returns propeller direction.
      * @return propeller direction
@@ -197,6 +276,44 @@ public:
         return ( _torqueRequired < _torqueAvailable ) ? _torqueRequired : _torqueAvailable;
     }
 
+    /**
+     * @brief Returns coefficients computed during the last update.
+     * Valid only if propeller map is enabled.
+     * @return coefficients and their derivatives
+     */
+    inline const Coefs& getCoefs() const
+    {
+        return _coefs;
+    }
+
+    /**
+     * @brief Returns required torque derivative with respect to angular velocity.
+     * Valid only if propeller map is enabled.
+     * @return [N*m*s/rad] required torque derivative with respect to angular velocity
+     */
+    inline double getTorqueRequiredDerivative() const
+    {
+        return _torqueRequired_omega;
+    }
+
+    /**
+     * @brief Returns true if propeller map is enabled.
+     * @return true if propeller map is enabled
+     */
+    inline bool isPrecomputed() const
+    {
+        return _precomputed;
+    }
+
+    /**
+     * @brief Returns true if implicit integration is enabled.
+     * @return true if implicit integration is enabled
+     */
+    inline bool isImplicit() const
+    {
+        return _implicit;
+    }
+
     void setRPM( double rpm );
 
 protected:
@@ -208,6 +325,10 @@ protected:
     Table2 _coefThrust;         ///< [-] thrust coefficient
     Table2 _coefPower;          ///< [-] power coefficient
 
+    Table2Pack _map;            ///< propeller map (thrust and power coefficients)
+
+    Coefs _coefs;               ///< coefficients computed during the last update
+
     Direction _direction;       ///< propeller direction looking from cockpit
 
     double _gearRatio;          ///< [-] gear ratio (propeller rpm / engine rpm)
@@ -227,6 +348,16 @@ protected:
     double _torqueAvailable;    ///< [N*m] available torque
     double _torqueRequired;     ///< [N*m] required torque
 
+    double _torqueRequired_omega;   ///< [N*m*s/rad] required torque derivative with respect to angular velocity
+
+    unsigned int _index_thrust; ///< thrust coefficient index in propeller map results
+    unsigned int _index_power;  ///< power coefficient index in propeller map results
+
+    bool _precomputed;          ///< specifies if propeller map is enabled
+    bool _implicit;             ///< specifies if implicit integration is enabled
+
+    static const unsigned int _lockstep = 8;    ///< max number of propellers evaluated in one pass
+
     /**
      * @brief Computes induced velocity.
      * @param airspeed [m/s] airspeed
@@ -35,7 +35,18 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const unsigned int RotorBlade::_stations;
+
+////////////////////////////////////////////////////////////////////////////////
+
 Matrix3x3 RotorBlade::getRAS2SRA( double psi, bool ccw )
+{
+    return getRAS2SRA( cos( psi ), sin( psi ), ccw );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Matrix3x3 RotorBlade::getRAS2SRA( double cosPsi, double sinPsi, bool ccw )
 {
     double ccw_coef = ccw ? 1.0 : -1.0;
 
@@ -53,8 +64,8 @@ Matrix3x3 RotorBlade::getRAS2SRA( double psi, bool ccw )
     a(2,1) =  0.0;
     a(2,2) = -1.0;
 
-    double cosPsi = cos( ccw_coef * psi );
-    double sinPsi = sin( ccw_coef * psi );
+    // cos( ccw_coef * psi ) and sin( ccw_coef * psi )
+    sinPsi *= ccw_coef;
 
     Matrix3x3 b;
 
@@ -115,6 +126,7 @@ RotorBlade::RotorBlade( bool ccw ) :
 
     _sb ( 0.0 ),
     _ib ( 0.0 ),
+    _dm ( 0.0 ),
 
     _xforce ( 0.0 ),
     _yforce ( 0.0 ),
@@ -136,6 +148,15 @@ RotorBlade::RotorBlade( bool ccw ) :
     _sra2ras = Matrix3x3::identityMatrix();
     //_sra2bsa = Matrix3x3::identityMatrix();
     //_bsa2sra = Matrix3x3::identityMatrix();
+
+    for ( unsigned int i = 0; i < _stations; i++ )
+    {
+        _span_p     [ i ] = 0.0;
+        _span_twist [ i ] = 0.0;
+
+        _cd_cursor[ i ] = 0;
+        _cl_cursor[ i ] = 0;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -169,9 +190,20 @@ void RotorBlade::readData( XmlNode &dataNode )
 
             _sb = _m * _b / 2.0;
             _ib = _m * _b * _b / 3.0;
+            _dm = _m / (double)(_stations);
 
             _cd.multiplyKeys( Units::deg2rad() );
             _cl.multiplyKeys( Units::deg2rad() );
+
+            double dy = _b / (double)(_stations);
+
+            for ( unsigned int i = 0; i < _stations; i++ )
+            {
+                double y = ( i + 0.5 ) * dy;
+
+                _span_p     [ i ] = _dirFactor * y;
+                _span_twist [ i ] = _twist.getValue( y );
+            }
         }
         else
         {
@@ -205,19 +237,20 @@ void RotorBlade::computeForceAndMoment( const Vector3 &vel_air_ras,
                                         const Vector3 &eps_ras,
                                         const Vector3 &grav_ras,
                                         double omega,
-                                        double azimuth,
+                                        double cosPsi,
+                                        double sinPsi,
                                         double airDensity,
                                         double theta_0,
                                         double theta_1c,
                                         double theta_1s )
 {
-    _ras2sra = getRAS2SRA( azimuth, _ccw );
+    _ras2sra = getRAS2SRA( cosPsi, sinPsi, _ccw );
     _sra2ras = _ras2sra.getTransposed();
 
     //_sra2bsa = getSRA2BSA( _beta, _direction );
     //_bsa2sra = _sra2bsa.getTransposed();
 
-    _theta = getTheta( azimuth, theta_0, theta_1c, theta_1s );
+    _theta = getTheta( cosPsi, sinPsi, theta_0, theta_1c, theta_1s );
 
     integrateSpanwise( vel_air_ras,
                        omg_air_ras,
@@ -244,16 +277,17 @@ void RotorBlade::integrate( double timeStep,
                             const Vector3 &eps_ras,
                             const Vector3 &grav_ras,
                             double omega,
-                            double azimuth,
+                            double cosPsi,
+                            double sinPsi,
                             double airDensity,
                             double theta_0,
                             double theta_1c,
                             double theta_1s )
 {
-    _ras2sra = getRAS2SRA( azimuth, _ccw );
+    _ras2sra = getRAS2SRA( cosPsi, sinPsi, _ccw );
     _sra2ras = _ras2sra.getTransposed();
 
-    _theta = getTheta( azimuth, theta_0, theta_1c, theta_1s );
+    _theta = getTheta( cosPsi, sinPsi, theta_0, theta_1c, theta_1s );
 
     double beta_prev = _beta;
 
@@ -305,14 +339,12 @@ void RotorBlade::computeStateDeriv( const StateVector &stateVect,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-double RotorBlade::getTheta( double azimuth,
+double RotorBlade::getTheta( double cosPsi,
+                             double sinPsi,
                              double theta_0,
                              double theta_1c,
                              double theta_1s )
 {
-    double cosPsi = cos( azimuth );
-    double sinPsi = sin( azimuth );
-
     return theta_0 + theta_1c * cosPsi + theta_1s * sinPsi;
 }
 
@@ -485,108 +517,144 @@ void RotorBlade::integrateSpanwise( const Vector3 &vel_air_ras,
     // gravity acceleration
     Vector3 grav_bsa = sra2bsa * ( _ras2sra * grav_ras );
 
-    const int steps = 10;
+    const double cosBeta = sra2bsa( 1, 1 );
+    const double sinBeta = sra2bsa( 1, 2 );
 
-    double dy = _b / (double)(steps);
-    double dm = _m / (double)(steps);
+    // spanwise stations values, all cross products with station position
+    // vector (0,p,0) are expanded, so loops over stations have no branches
+    // nor function calls (except the middle one) and can be vectorized
+    double u[ _stations ];          // [m/s] section airflow velocity x component
+    double w[ _stations ];          // [m/s] section airflow velocity z component
+    double dynPress[ _stations ];   // [Pa] section dynamic pressure
+    double mom_gi[ _stations ];     // [N*m] moment due to gravity and inertia (x component)
+    double dX[ _stations ];         // [N] section x force expressed in BSA
+    double dZ[ _stations ];         // [N] section z force expressed in BSA
 
-    _xforce = 0.0;
-    _yforce = 0.0;
-    _zforce = 0.0;
-    _torque = 0.0;
-    _moment = 0.0;
+    const double acc_z = acc_bsa.z();
+    const double acc_p = omg_tot_bsa.y() * omg_tot_bsa.z() + eps_bsa.x();
 
-    for ( int i = 0; i < steps; i++ )
+    for ( unsigned int i = 0; i < _stations; i++ )
     {
-        double y = ( i + 0.5 ) * dy;
-
-        Vector3 pos_i_bsa( 0.0, _dirFactor * y, 0.0 );
-        //Vector3 pos_i_sra = _pos_fh_sra + _bsa2sra * pos_i_bsa;
+        const double p = _span_p[ i ];
 
-        // moment due to gravity
-        Vector3 mom_grav_bsa = dm * ( pos_i_bsa % grav_bsa );
+        // velocity (relative to airflow)
+        double vel_x = vel_fh_air_bsa.x() - omg_air_tot_bsa.z() * p;
+        double vel_y = vel_fh_air_bsa.y();
+        double vel_z = vel_fh_air_bsa.z() + omg_air_tot_bsa.x() * p;
 
-        // moment due to inertia
-        Vector3 acc_i_bsa
-                = acc_bsa
-                + ( omg_tot_bsa % ( omg_tot_bsa % pos_i_bsa ) ) // centrifugal acceleration
-                + ( eps_bsa % pos_i_bsa )                       // Euler acceleration
-                ;
-        Vector3 mom_iner_bsa = -dm * ( pos_i_bsa % acc_i_bsa );
+        u[ i ] = -vel_x;
+        w[ i ] = -vel_z;
 
-        // moment due to
-        //Vector3 for_cf_sra = -dm * ( omg_tot_sra % ( omg_tot_sra % pos_i_sra ) );
-        //Vector3 for_cf_bsa = _sra2bsa * for_cf_sra;
-        //Vector3 mom_cf_bsa = pos_i_bsa % for_cf_bsa;
+        dynPress[ i ] = 0.5 * airDensity * ( vel_x*vel_x + vel_y*vel_y + vel_z*vel_z );
 
-        // velocity (relative to airflow)
-        Vector3 vel_i_air_bsa = vel_fh_air_bsa + omg_air_tot_bsa % pos_i_bsa;
+        // moments due to gravity and inertia (including centrifugal
+        // and Euler accelerations)
+        mom_gi[ i ] = _dm * p * ( grav_bsa.z() - acc_z - acc_p * p );
+    }
 
+    for ( unsigned int i = 0; i < _stations; i++ )
+    {
         // section angle of attack
-        double u = -vel_i_air_bsa.u();
-        double w = -vel_i_air_bsa.w();
-        double angleOfAttack = Aerodynamics::getAngleOfAttack( u, w );
+        double sinAlpha = 0.0;
+        double cosAlpha = 1.0;
+        double angleOfAttack = Aerodynamics::getAngleOfAttack( u[ i ], w[ i ] );
+        if ( angleOfAttack != 0.0 )
+        {
+            double uw_inv = 1.0 / sqrt( u[ i ]*u[ i ] + w[ i ]*w[ i ] );
+            sinAlpha = w[ i ] * uw_inv;
+            cosAlpha = u[ i ] * uw_inv;
+        }
         double angleOfAttackTot = angleOfAttack;
-        if ( fabs( u ) > 0.1 )
+        if ( fabs( u[ i ] ) > 0.1 )
         {
-            angleOfAttackTot += _theta + _twist.getValue( y );
+            angleOfAttackTot += _theta + _span_twist[ i ];
             angleOfAttackTot = Angles::normalize( angleOfAttackTot, -M_PI );
         }
 
-        // dynamic pressure
-        double dynPress = 0.5 * airDensity * vel_i_air_bsa.getLength2();
-
         // elementary forces
-        double dD = dynPress * _cd.getValue( angleOfAttackTot ) * _c;
-        double dL = dynPress * _cl.getValue( angleOfAttackTot ) * _c;
+        double dD = dynPress[ i ] * _cd.getValue( angleOfAttackTot, _cd_cursor[ i ] ) * _c;
+        double dL = dynPress[ i ] * _cl.getValue( angleOfAttackTot, _cl_cursor[ i ] ) * _c;
 
-        double sinAlpha = sin( angleOfAttack );
-        double cosAlpha = cos( angleOfAttack );
+        dX[ i ] = cosAlpha * dD - sinAlpha * dL;
+        dZ[ i ] = sinAlpha * dD + cosAlpha * dL;
+    }
 
-        double dX = cosAlpha * dD - sinAlpha * dL;
-        double dZ = sinAlpha * dD + cosAlpha * dL;
+    double xforce = 0.0;
+    double yforce = 0.0;
+    double zforce = 0.0;
+    double torque = 0.0;
+    double moment = 0.0;
 
-        Vector3 for_aero_bsa( dX, 0.0, dZ );
-        Vector3 for_aero_sra = bsa2sra * for_aero_bsa;
-        Vector3 mom_aero_bsa = pos_i_bsa % for_aero_sra;
-        Vector3 mom_aero_sra = bsa2sra * mom_aero_bsa;
+    for ( unsigned int i = 0; i < _stations; i++ )
+    {
+        const double p = _span_p[ i ];
 
-#       ifdef SIM_ROTOR_TEST
-        {
-            Vector3 pos_i_sra = _pos_fh_sra + bsa2sra * pos_i_bsa;
+        // aerodynamic force expressed in SRA
+        double for_x =  dX[ i ];
+        double for_y = -sinBeta * dZ[ i ];
+        double for_z =  cosBeta * dZ[ i ];
 
-            int i1 = 3 * i;
-            int i2 = i1 + 1;
-            int i3 = i2 + 1;
+        xforce += for_x;
+        yforce += for_y;
+        zforce += for_z;
 
-            span[ i1 ].visible = true;
-            span[ i2 ].visible = true;
-            span[ i3 ].visible = true;
+        torque -= cosBeta * p * for_x;
 
-            span[ i1 ].b_sra = pos_i_sra;
-            span[ i2 ].b_sra = pos_i_sra;
-            span[ i3 ].b_sra = pos_i_sra;
+        // total moment about flapping hinge
+        moment += mom_gi[ i ] + p * for_z;
+    }
 
-            span[ i1 ].v_sra = bsa2sra * Vector3(  dX, 0.0, 0.0 );
-            span[ i2 ].v_sra = bsa2sra * Vector3( 0.0, 0.0,  dZ );
-            span[ i3 ].v_sra = bsa2sra * vel_i_air_bsa;
-        }
-#       endif
+#   ifdef SIM_ROTOR_TEST
+    for ( unsigned int i = 0; i < _stations; i++ )
+    {
+        Vector3 pos_i_bsa( 0.0, _span_p[ i ], 0.0 );
+        Vector3 pos_i_sra = _pos_fh_sra + bsa2sra * pos_i_bsa;
 
-        // aerodynamic forces
-        _xforce += for_aero_sra.x();
-        _yforce += for_aero_sra.y();
-        _zforce += for_aero_sra.z();
+        Vector3 vel_i_air_bsa = vel_fh_air_bsa + omg_air_tot_bsa % pos_i_bsa;
 
-        _torque += _dirFactor * mom_aero_sra.z();
+        int i1 = 3 * i;
+        int i2 = i1 + 1;
+        int i3 = i2 + 1;
 
-        // total moment about flapping hinge
-        Vector3 mom_tot_bsa
-                = mom_grav_bsa
-                + mom_iner_bsa
-                + mom_aero_bsa
-                ;
+        span[ i1 ].visible = true;
+        span[ i2 ].visible = true;
+        span[ i3 ].visible = true;
 
-        _moment += _dirFactor * mom_tot_bsa.x();
+        span[ i1 ].b_sra = pos_i_sra;
+        span[ i2 ].b_sra = pos_i_sra;
+        span[ i3 ].b_sra = pos_i_sra;
+
+        span[ i1 ].v_sra = bsa2sra * Vector3( dX[ i ], 0.0, 0.0 );
+        span[ i2 ].v_sra = bsa2sra * Vector3( 0.0, 0.0, dZ[ i ] );
+        span[ i3 ].v_sra = bsa2sra * vel_i_air_bsa;
     }
+#   endif
+
+    _xforce = xforce;
+    _yforce = yforce;
+    _zforce = zforce;
+    _torque = _dirFactor * torque;
+    _moment = _dirFactor * moment;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorBlade::archiveState( StateArchive *archive )
+{
+    archive->add( &_stateVect );
+    archive->add( &_derivVect );
+
+    archive->add( &_for_ras );
+    archive->add( &_mom_ras );
+
+    archive->add( &_ras2sra );
+    archive->add( &_sra2ras );
+
+    archive->add( &_xforce );
+    archive->add( &_yforce );
+    archive->add( &_zforce );
+    archive->add( &_torque );
+    archive->add( &_moment );
+
+    archive->add( &_theta );
 }
@@ -26,7 +26,9 @@
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Vector3.h>
 
@@ -91,12 +93,14 @@ namespace fdm
  * </blade>
  * @endcode
  */
-class FDMEXPORT RotorBlade
+class FDMEXPORT RotorBlade : public ArenaObject
 {
 public:
 
     typedef Vector< 2 > StateVector;
 
+    static const unsigned int _stations = 10;   ///< number of spanwise stations
+
 #   ifdef SIM_ROTOR_TEST
     struct Vect
     {
@@ -111,6 +115,15 @@ public:
 
     static Matrix3x3 getRAS2SRA( double psi, bool ccw = false );
 
+    /**
+     * @brief Returns matrix of rotation from RAS to SRA.
+     * @param cosPsi [-] blade azimuth cosine
+     * @param sinPsi [-] blade azimuth sine
+     * @param ccw specifies if rotor direction is counter clockwise
+     * @return matrix of rotation from RAS to SRA
+     */
+    static Matrix3x3 getRAS2SRA( double cosPsi, double sinPsi, bool ccw = false );
+
     static Matrix3x3 getSRA2BSA( double beta, bool ccw = false );
 
     /** @brief Constructor. */
@@ -138,7 +151,8 @@ public:
      * @param eps_ras     [rad/s^2] angular acceleration expressed in RAS
      * @param grav_ras    [m/s^2]   gravity acceleration vector expressed in RAS
      * @param omega       [rad/s]   rotor speed
-     * @param azimuth     [rad]     blade azimuth
+     * @param cosPsi      [-]       blade azimuth cosine
+     * @param sinPsi      [-]       blade azimuth sine
      * @param airDensity  [kg/m^3]  air density
      * @param theta_0     [rad]     collective feathering angle
      * @param theta_1c    [rad]     logitudinal feathering angle
@@ -151,7 +165,8 @@ public:
                                         const Vector3 &eps_ras,
                                         const Vector3 &grav_ras,
                                         double omega,
-                                        double azimuth,
+                                        double cosPsi,
+                                        double sinPsi,
                                         double airDensity,
                                         double theta_0,
                                         double theta_1c,
@@ -167,7 +182,8 @@ public:
      * @param eps_ras     [rad/s^2] angular acceleration expressed in RAS
      * @param grav_ras    [m/s^2]   gravity acceleration vector expressed in RAS
      * @param omega       [rad/s]   rotor speed
-     * @param azimuth     [rad]     blade azimuth
+     * @param cosPsi      [-]       blade azimuth cosine
+     * @param sinPsi      [-]       blade azimuth sine
      * @param airDensity  [kg/m^3]  air density
      * @param theta_0     [rad]     collective feathering angle
      * @param theta_1c    [rad]     logitudinal feathering angle
@@ -181,12 +197,19 @@ public:
                             const Vector3 &eps_ras,
                             const Vector3 &grav_ras,
                             double omega,
-                            double azimuth,
+                            double cosPsi,
+                            double sinPsi,
                             double airDensity,
                             double theta_0,
                             double theta_1c,
                             double theta_1s );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_RAS() const { return _for_ras; }
     inline const Vector3& getMom_RAS() const { return _mom_ras; }
 
@@ -195,6 +218,7 @@ public:
     inline double getTorque() const { return _torque; }
 
     inline double getBeta()  const { return _beta; }
+    inline double getBetaDot() const { return _beta_dot; }
     inline double getTheta() const { return _theta; }
 
 protected:
@@ -222,6 +246,12 @@ protected:
     Table1 _cd;                 ///< [-] blade section drag coefficient vs angle of attack
     Table1 _cl;                 ///< [-] blade section lift coefficient vs angle of attack
 
+    double _span_p     [ _stations ];   ///< [m] spanwise stations y coordinates expressed in BSA
+    double _span_twist [ _stations ];   ///< [rad] spanwise stations twist angles
+
+    unsigned int _cd_cursor[ _stations ];   ///< spanwise stations drag coefficient table cursors
+    unsigned int _cl_cursor[ _stations ];   ///< spanwise stations lift coefficient table cursors
+
     double _m;                  ///< [kg] blage mass
     double _b;                  ///< [m] blade length
     double _c;                  ///< [m] blade chord
@@ -232,6 +262,7 @@ protected:
 
     double _sb;                 ///< [kg*m] blade first moment of mass about flapping hinge
     double _ib;                 ///< [kg*m^2] blade inertia moment about flapping hinge
+    double _dm;                 ///< [kg] spanwise station mass
 
     double _xforce;             ///< [N] force x component expressed in SRA
     double _yforce;             ///< [N] force y component expressed in SRA
@@ -247,7 +278,8 @@ protected:
     virtual void computeStateDeriv( const StateVector &stateVect,
                                     StateVector *derivVect );
 
-    virtual double getTheta( double azimuth,
+    virtual double getTheta( double cosPsi,
+                             double sinPsi,
                              double theta_0,
                              double theta_1c,
                              double theta_1s );
@@ -274,6 +306,9 @@ protected:
 
     /**
      * @brief Integrates blade spanwise.
+     * Spanwise stations are processed as arrays in three passes: airflow
+     * velocities and inertial moments, angles of attack and aerodynamic
+     * coefficients, forces and moments sums.
      * @param vel_air_ras [m/s]     rotor hub linear velocity relative to airflow expressed in RAS
      * @param omg_air_ras [rad/s]   rotor hub angular velocity relative to airflow expressed in RAS
      * @param omg_ras     [rad/s]   angular velocity expressed in RAS
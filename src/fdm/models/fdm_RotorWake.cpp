@@ -0,0 +1,167 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/models/fdm_RotorWake.h>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/xml/fdm_XmlUtils.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+RotorWake::RotorWake() :
+    _wake_factor ( 1.0 ),
+    _r ( 0.0 ),
+    _vel_i ( 0.0 ),
+    _wakeSkew ( 0.0 ),
+    _tanSkew_x ( 0.0 ),
+    _tanSkew_y ( 0.0 ),
+    _enabled ( false )
+{
+    _bas2ras = Matrix3x3::identityMatrix();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RotorWake::~RotorWake() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWake::readData( XmlNode &dataNode )
+{
+    if ( dataNode.isValid() )
+    {
+        int result = FDM_SUCCESS;
+
+        _wake_factor = 1.0;
+
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_wake_factor, "wake_factor", true );
+
+        if ( result == FDM_SUCCESS )
+        {
+            _enabled = true;
+        }
+        else
+        {
+            XmlUtils::throwError( __FILE__, __LINE__, dataNode );
+        }
+    }
+    else
+    {
+        XmlUtils::throwError( __FILE__, __LINE__, dataNode );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWake::update( const MainRotor *mainRotor,
+                        const Vector3 &vel_air_bas,
+                        const Vector3 &omg_air_bas )
+{
+    if ( !_enabled ) return;
+
+    _bas2ras   = mainRotor->getBAS2RAS();
+    _r_hub_bas = mainRotor->getR_hub_BAS();
+
+    _r = mainRotor->getRadius();
+
+    _vel_i    = _wake_factor * mainRotor->getVel_i();
+    _wakeSkew = mainRotor->getWakeSkew();
+
+    // induced velocity acts along the rotor shaft axis
+    _vel_i_bas = _bas2ras.getTransposed() * Vector3( 0.0, 0.0, 1.0 );
+
+    // wake is skewed towards the in-plane airflow direction
+    Vector3 vel_air_ras = _bas2ras * ( vel_air_bas + ( omg_air_bas % _r_hub_bas ) );
+
+    double vel_xy = vel_air_ras.getLengthXY();
+
+    _tanSkew_x = 0.0;
+    _tanSkew_y = 0.0;
+
+    if ( vel_xy > 1.0e-6 )
+    {
+        // limited to avoid singularity in the edgewise flow
+        double tanSkew = tan( Misc::satur( 0.0, 0.45 * M_PI, _wakeSkew ) );
+
+        _tanSkew_x = -tanSkew * vel_air_ras.x() / vel_xy;
+        _tanSkew_y = -tanSkew * vel_air_ras.y() / vel_xy;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Vector3 RotorWake::getVel_i_BAS( const Vector3 &r_bas ) const
+{
+    if ( !_enabled || _r < 1.0e-6 ) return Vector3();
+
+    Vector3 r_ras = _bas2ras * ( r_bas - _r_hub_bas );
+
+    // distance below the rotor disc plane
+    double z = r_ras.z();
+
+    // point projected onto the rotor disc plane along the wake axis
+    double x_0 = r_ras.x();
+    double y_0 = r_ras.y();
+
+    if ( z > 0.0 )
+    {
+        x_0 -= z * _tanSkew_x;
+        y_0 -= z * _tanSkew_y;
+    }
+
+    double rho = sqrt( x_0*x_0 + y_0*y_0 );
+
+    // wake boundary
+    double coef_b = Misc::satur( 0.0, 1.0, ( 1.1 * _r - rho ) / ( 0.2 * _r ) );
+
+    if ( coef_b > 0.0 )
+    {
+        // actuator disc axial induced velocity distribution
+        double coef_z = 1.0 + z / sqrt( z*z + _r*_r );
+
+        return _vel_i_bas * ( _vel_i * coef_z * coef_b );
+    }
+
+    return Vector3();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWake::archiveState( StateArchive *archive )
+{
+    archive->add( &_bas2ras );
+
+    archive->add( &_r_hub_bas );
+    archive->add( &_vel_i_bas );
+
+    archive->add( &_r );
+
+    archive->add( &_vel_i );
+    archive->add( &_wakeSkew );
+
+    archive->add( &_tanSkew_x );
+    archive->add( &_tanSkew_y );
+}
@@ -0,0 +1,148 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_ROTORWAKE_H
+#define FDM_ROTORWAKE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/models/fdm_MainRotor.h>
+
+#include <fdm/utils/fdm_StateArchive.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Main rotor wake interference model class.
+ *
+ * Wake geometry is computed once per step from the main rotor state (see
+ * update()) and then reused by all the components immersed in the wake
+ * (tail rotor, stabilizers and fuselage), so adding interference to
+ * another component costs only a single velocity query.
+ *
+ * Wake is modeled as a skewed cylinder of the rotor radius. Its axis is
+ * inclined from the shaft axis by the rotor wake skew angle towards the
+ * in-plane airflow direction. Induced velocity inside the wake acts along
+ * the rotor shaft axis and grows from the rotor disc value at the hub plane
+ * to the doubled far wake value, according to the actuator disc theory.
+ * Wake boundary is smoothed over 20% of the rotor radius.
+ *
+ * XML configuration file format:
+ * @code
+ * <rotor_wake>
+ *   [<wake_factor> { [-] induced velocity factor } </wake_factor>]
+ * </rotor_wake>
+ * @endcode
+ *
+ * Optional elements: "wake_factor"
+ *
+ * @see Johnson W.: Helicopter Theory, 1980
+ * @see Padfield G.: Helicopter Flight Dynamics, 2007
+ */
+class FDMEXPORT RotorWake : public ArenaObject
+{
+public:
+
+    /** @brief Constructor. */
+    RotorWake();
+
+    /** @brief Destructor. */
+    virtual ~RotorWake();
+
+    /**
+     * @brief Reads data.
+     * @param dataNode XML node
+     */
+    virtual void readData( XmlNode &dataNode );
+
+    /**
+     * @brief Updates wake geometry.
+     * This function should be called once per step after main rotor forces
+     * and moments were computed.
+     * @param mainRotor main rotor object
+     * @param vel_air_bas [m/s] aircraft linear velocity relative to the air expressed in BAS
+     * @param omg_air_bas [rad/s] aircraft angular velocity relative to the air expressed in BAS
+     */
+    virtual void update( const MainRotor *mainRotor,
+                         const Vector3 &vel_air_bas,
+                         const Vector3 &omg_air_bas );
+
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
+    /**
+     * @brief Returns wake induced air velocity at the given point.
+     * Returned velocity should be subtracted from the component velocity
+     * relative to the air.
+     * @param r_bas [m] point coordinates expressed in BAS
+     * @return [m/s] rotor wake induced air velocity expressed in BAS
+     */
+    Vector3 getVel_i_BAS( const Vector3 &r_bas ) const;
+
+    /**
+     * @brief Returns aircraft velocity relative to the air at the given point
+     * including rotor wake induced velocity.
+     * @param vel_air_bas [m/s] aircraft linear velocity relative to the air expressed in BAS
+     * @param r_bas [m] point coordinates expressed in BAS
+     * @return [m/s] aircraft linear velocity relative to the air expressed in BAS
+     */
+    inline Vector3 getVel_air_BAS( const Vector3 &vel_air_bas,
+                                   const Vector3 &r_bas ) const
+    {
+        return _enabled ? vel_air_bas - getVel_i_BAS( r_bas ) : vel_air_bas;
+    }
+
+    inline bool isEnabled() const { return _enabled; }
+
+    inline double getVel_i()    const { return _vel_i;    }
+    inline double getWakeSkew() const { return _wakeSkew; }
+
+private:
+
+    Matrix3x3 _bas2ras;         ///< matrix of rotation from BAS to RAS
+
+    Vector3 _r_hub_bas;         ///< [m] rotor hub coordinates expressed in BAS
+    Vector3 _vel_i_bas;         ///< [m/s] unit wake induced velocity expressed in BAS
+
+    double _wake_factor;        ///< [-] induced velocity factor
+
+    double _r;                  ///< [m] rotor radius
+
+    double _vel_i;              ///< [m/s] rotor induced velocity
+    double _wakeSkew;           ///< [rad] rotor wake skew angle
+
+    double _tanSkew_x;          ///< [-] wake skew tangent, RAS x component
+    double _tanSkew_y;          ///< [-] wake skew tangent, RAS y component
+
+    bool _enabled;              ///< specifies if wake interference is enabled
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_ROTORWAKE_H
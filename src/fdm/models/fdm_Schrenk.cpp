@@ -22,6 +22,8 @@
 
 #include <fdm/models/fdm_Schrenk.h>
 
+#include <vector>
+
 #include <fdm/utils/fdm_Misc.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -63,8 +65,11 @@ double Schrenk::getMeanAerodynamicChord( const Table1 &chord )
 Schrenk::Schrenk() :
     _area ( 0.0 ),
     _span ( 0.0 ),
+    _stations ( 21 ),
     _4S_bpi ( 0.0 ),
-    _2_b ( 0.0 )
+    _2_b ( 0.0 ),
+    _mac ( 0.0 ),
+    _dirty ( true )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +78,14 @@ Schrenk::~Schrenk() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+double Schrenk::getMeanAerodynamicChord() const
+{
+    updateIfDirty();
+    return _mac;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 double Schrenk::getDragCoefDist( double y ) const
 {
     return ( y < 0.4 * _span ) ? 0.95 : 1.2;
@@ -82,17 +95,28 @@ double Schrenk::getDragCoefDist( double y ) const
 
 double Schrenk::getLiftCoefDist( double y ) const
 {
-    // equivalent elliptical wing chord
-    double chord_e = _4S_bpi * sqrt( 1.0 - Misc::pow2( y * _2_b ) );
+    updateIfDirty();
+
+    // equivalent elliptical wing chord (zero beyond the wing tip)
+    double eta2 = Misc::pow2( y * _2_b );
+    double chord_e = ( eta2 < 1.0 ) ? _4S_bpi * sqrt( 1.0 - eta2 ) : 0.0;
     return 0.5 * ( 1.0 + chord_e / _chord.getValue( y ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const Table1& Schrenk::getLiftCoefDistTable() const
+{
+    updateIfDirty();
+    return _liftDist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Schrenk::setArea( double area )
 {
     _area = area;
-    updateAxiliaryParameters();
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -100,7 +124,7 @@ void Schrenk::setArea( double area )
 void Schrenk::setSpan( double span )
 {
     _span = span;
-    updateAxiliaryParameters();
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -108,12 +132,51 @@ void Schrenk::setSpan( double span )
 void Schrenk::setChord( const Table1 &chord )
 {
     _chord = chord;
+    _dirty = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Schrenk::setStations( unsigned int stations )
+{
+    _stations = ( stations > 2 ) ? stations : 2;
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Schrenk::updateAxiliaryParameters()
+void Schrenk::updateAxiliaryParameters() const
 {
+    _dirty = false;
+
     _4S_bpi = ( 4.0 * _area ) / ( _span * M_PI );
     _2_b = 2.0 / _span;
+
+    _mac = 0.0;
+    _liftDist = Table1();
+
+    if ( _chord.getSize() > 1 )
+    {
+        _mac = getMeanAerodynamicChord( _chord );
+    }
+    else if ( _chord.getSize() > 0 )
+    {
+        _mac = _chord.getValueByIndex( 0 );
+    }
+
+    if ( _chord.getSize() > 0 && _span > 0.0 )
+    {
+        std::vector< double > y( _stations );
+        std::vector< double > cl( _stations );
+
+        double dy = 0.5 * _span / (double)( _stations - 1 );
+
+        for ( unsigned int i = 0; i < _stations; i++ )
+        {
+            y  [ i ] = i * dy;
+            cl [ i ] = getLiftCoefDist( y[ i ] );
+        }
+
+        _liftDist = Table1( y, cl );
+    }
 }
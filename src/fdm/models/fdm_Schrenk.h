@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Table1.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -34,10 +35,15 @@ namespace fdm
 /**
  * @brief Wing Schrenk approximation class.
  *
+ * Auxiliary parameters, mean aerodynamic chord and spanwise lift coefficient
+ * distribution table are updated lazily, on the first query after any of
+ * the wing parameters has changed, so setters are cheap and repeated
+ * queries do not re-integrate the chord table.
+ *
  * @see Schrenk O.: A Simple Approximation Method for Obtaining the Spanwise Lift Distribution, NACA, TM-948
  * @see Galinski C.: Wybrane zagadnienia projektowania samolotow, 2016, p.118. [in Polish]
  */
-class FDMEXPORT Schrenk
+class FDMEXPORT Schrenk : public ArenaObject
 {
 public:
 
@@ -63,6 +69,12 @@ public:
     /** @brief Destructor. */
     virtual ~Schrenk();
 
+    /**
+     * @brief Returns mean aerodynamic chord of the wing.
+     * @return [m] mean aerodynamic chord
+     */
+    double getMeanAerodynamicChord() const;
+
     /**
      * @brief Computes approximation of drag coefficient.
      * Computes simple approximation of normalized spanwise drag coefficient
@@ -81,6 +93,15 @@ public:
      */
     virtual double getLiftCoefDist( double y ) const;
 
+    /**
+     * @brief Returns precomputed spanwise lift coefficient distribution.
+     * Distribution is sampled at evenly spaced stations from the wing root
+     * to the wing tip and can be interpolated instead of evaluating
+     * getLiftCoefDist() at every point.
+     * @return [-] spanwise lift coefficient vs [m] spanwise coordinate
+     */
+    const Table1& getLiftCoefDistTable() const;
+
     /**
      * @brief Sets wing area.
      * @param area [m^2] wing area
@@ -99,6 +120,12 @@ public:
      */
     void setChord( const Table1 &chord );
 
+    /**
+     * @brief Sets number of spanwise lift distribution table stations.
+     * @param stations number of stations (at least 2)
+     */
+    void setStations( unsigned int stations );
+
 protected:
 
     double _area;               ///< [m^2] wing area
@@ -106,11 +133,24 @@ protected:
 
     Table1 _chord;              ///< [m] wing chord vs [m] spanwise coordinate
 
-    double _4S_bpi;             ///< [m] 4*S/(b*pi) where S is wing area and b is wing span
-    double _2_b;                ///< [1/m] 2/b where b is wing span
+    unsigned int _stations;     ///< number of spanwise lift distribution table stations
+
+    mutable Table1 _liftDist;   ///< [-] spanwise lift coefficient vs [m] spanwise coordinate
+
+    mutable double _4S_bpi;     ///< [m] 4*S/(b*pi) where S is wing area and b is wing span
+    mutable double _2_b;        ///< [1/m] 2/b where b is wing span
+    mutable double _mac;        ///< [m] mean aerodynamic chord
+
+    mutable bool _dirty;        ///< specifies if derived parameters need update
+
+    /** @brief Updates derived parameters if any of the wing parameters changed. */
+    inline void updateIfDirty() const
+    {
+        if ( _dirty ) updateAxiliaryParameters();
+    }
 
-    /** */
-    void updateAxiliaryParameters();
+    /** @brief Updates auxiliary parameters, MAC and lift distribution table. */
+    void updateAxiliaryParameters() const;
 };
 
 } // end of fdm namespace
@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Matrix3x3.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -38,7 +39,7 @@ namespace fdm
  *
  * @todo TODO
  */
-class FDMEXPORT SimpleRotor
+class FDMEXPORT SimpleRotor : public ArenaObject
 {
 public:
 
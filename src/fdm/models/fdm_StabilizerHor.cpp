@@ -34,7 +34,9 @@ using namespace fdm;
 
 StabilizerHor::StabilizerHor() :
     _area ( 0.0 ),
-    _incidence ( 0.0 )
+    _incidence ( 0.0 ),
+    _tailArm ( 0.0 ),
+    _downwashStep ( 0.0 )
 {
     _cx = Table1::oneRecordTable( 0.0 );
     _cz = Table1::oneRecordTable( 0.0 );
@@ -61,6 +63,7 @@ void StabilizerHor::readData( XmlNode &dataNode )
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_incidence, "incidence", true );
 
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_downwash, "downwash", true );
+        if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_tailArm, "tail_arm", true );
 
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cx, "cx" );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_cz, "cz" );
@@ -121,11 +124,45 @@ void StabilizerHor::computeForceAndMoment( const Vector3 &vel_air_bas,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void StabilizerHor::update( double timeStep, double wingAngleOfAttack )
+{
+    if ( _tailArm > 0.0 && timeStep > FDM_TIME_STEP_MIN )
+    {
+        _downwashStep = timeStep;
+        _downwashHistory.push( _downwash.getValue( wingAngleOfAttack ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 double StabilizerHor::getAngleOfAttack( const Vector3 &vel_air_bas,
                                         double wingAngleOfAttack )
 {
     return Aerodynamics::getAngleOfAttack( vel_air_bas )
-         + _incidence - _downwash.getValue( wingAngleOfAttack );
+         + _incidence - getDownwash( vel_air_bas, wingAngleOfAttack );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double StabilizerHor::getDownwash( const Vector3 &vel_air_bas,
+                                   double wingAngleOfAttack )
+{
+    if ( _tailArm > 0.0 && _downwashHistory.getCount() > 0 )
+    {
+        double airspeed = vel_air_bas.getLength();
+
+        // delay in samples, history is clamped to the oldest sample at low airspeed
+        double delay = _downwashHistory.getSize();
+
+        if ( airspeed * _downwashStep * delay > _tailArm )
+        {
+            delay = _tailArm / ( airspeed * _downwashStep );
+        }
+
+        return _downwashHistory.getValue( delay );
+    }
+
+    return _downwash.getValue( wingAngleOfAttack );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -141,3 +178,15 @@ double StabilizerHor::getCz( double angle ) const
 {
     return _cz.getValue( angle );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StabilizerHor::archiveState( StateArchive *archive )
+{
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    _downwashHistory.archiveState( archive );
+
+    archive->add( &_downwashStep );
+}
@@ -24,6 +24,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_DelayLine.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Vector3.h>
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -47,6 +50,7 @@ namespace fdm
  *     { [deg] wing angle of attack } { [deg] downwash angle }
  *     ... { more entries }
  *   </downwash>]
+ *   [<tail_arm> { [m] wing to stabilizer aerodynamic centers distance } </tail_arm>]
  *   <cx>
  *     { [deg] angle } { [-] drag coefficient }
  *     ... { more entries }
@@ -58,9 +62,14 @@ namespace fdm
  * </stab_hor>
  * @endcode
  *
- * Optional elements: "incidence", "downwash"
+ * Optional elements: "incidence", "downwash", "tail_arm"
+ *
+ * If tail arm is given, downwash at the stabilizer is lagged by the time
+ * the air takes to travel from the wing to the stabilizer. Wing downwash is
+ * sampled once per time step (see update()) into fixed-capacity history,
+ * which is looked up with the delay computed from stabilizer airspeed.
  */
-class FDMEXPORT StabilizerHor
+class FDMEXPORT StabilizerHor : public ArenaObject
 {
 public:
 
@@ -91,9 +100,24 @@ public:
                                         double airDensity,
                                         double wingAngleOfAttack = 0.0 );
 
+    /**
+     * @brief Updates stabilizer model, samples wing downwash.
+     * @param timeStep [s] time step
+     * @param wingAngleOfAttack [rad] wing angle of attack
+     */
+    virtual void update( double timeStep, double wingAngleOfAttack );
+
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
+    inline const Vector3& getR_ac_BAS() const { return _r_ac_bas; }
+
 protected:
 
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
@@ -106,10 +130,24 @@ protected:
 
     Table1 _downwash;           ///< [rad] downwash angle vs wing angle of attack
 
+    DelayLine< FDM_MAX_DOWNWASH_SAMPLES > _downwashHistory;    ///< [rad] wing downwash angle history
+
     double _area;               ///< [m^2] stabilizer reference area
 
     double _incidence;          ///< [rad] stabilizer incidence angle
 
+    double _tailArm;            ///< [m] wing to stabilizer distance, zero means no downwash lag
+    double _downwashStep;       ///< [s] wing downwash history sampling period
+
+    /**
+     * @brief Computes downwash angle at the stabilizer.
+     * @param vel_air_bas [m/s] stabilizer linear velocity relative to the air expressed in BAS
+     * @param wingAngleOfAttack [rad] wing angle of attack
+     * @return [rad] downwash angle
+     */
+    virtual double getDownwash( const Vector3 &vel_air_bas,
+                                double wingAngleOfAttack );
+
     /**
      * @brief Computes stabilizer angle of attack.
      * @see Etkin B.: Dynamics of Atmosferic Flight, 1972, p.210
@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Vector3.h>
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -53,7 +54,7 @@ namespace fdm
  * </stab_ver>
  * @endcode
  */
-class FDMEXPORT StabilizerVer
+class FDMEXPORT StabilizerVer : public ArenaObject
 {
 public:
 
@@ -85,6 +86,8 @@ public:
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
+    inline const Vector3& getR_ac_BAS() const { return _r_ac_bas; }
+
 protected:
 
     Vector3 _for_bas;           ///< [N] total force vector expressed in BAS
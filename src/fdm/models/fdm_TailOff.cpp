@@ -221,3 +221,16 @@ double TailOff::getCn( double sideslipAngle ) const
 {
     return _cn.getValue( sideslipAngle );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TailOff::archiveState( StateArchive *archive )
+{
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_aoa_l );
+    archive->add( &_aoa_r );
+
+    archive->add( &_stall );
+}
@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Vector3.h>
 
@@ -78,7 +80,7 @@ namespace fdm
  *
  * Optional elements: "cy", "cl", "cn"
  */
-class FDMEXPORT TailOff
+class FDMEXPORT TailOff : public ArenaObject
 {
 public:
 
@@ -111,6 +113,12 @@ public:
      */
     virtual void update( const Vector3 &vel_air_bas, const Vector3 &omg_air_bas );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
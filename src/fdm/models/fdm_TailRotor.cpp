@@ -23,6 +23,8 @@
 #include <fdm/models/fdm_TailRotor.h>
 #include <fdm/main/fdm_Aerodynamics.h>
 
+#include <cfloat>
+
 #include <fdm/xml/fdm_XmlUtils.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -234,3 +236,19 @@ void TailRotor::update( double omega, double theta )
     _omega = omega;
     _theta = theta;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TailRotor::archiveState( StateArchive *archive )
+{
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_vel_i_bas );
+
+    archive->add( &_omega );
+    archive->add( &_theta );
+
+    archive->add( &_thrust );
+    archive->add( &_torque );
+}
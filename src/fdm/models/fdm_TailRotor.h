@@ -24,7 +24,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_StateArchive.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -66,7 +68,7 @@ namespace fdm
  * @see Padfield G.: Helicopter Flight Dynamics, 2007
  * @see Johnson W.: Helicopter Theory, 1980
  */
-class FDMEXPORT TailRotor
+class FDMEXPORT TailRotor : public ArenaObject
 {
 public:
 
@@ -99,9 +101,17 @@ public:
      */
     virtual void update( double omega, double collective );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
+    inline const Vector3& getR_hub_BAS() const { return _r_hub_bas; }
+
     inline const Vector3& getVel_i_BAS() const { return _vel_i_bas; }
 
     inline double getMomentOfInertia() const { return _nb * _i_b; }
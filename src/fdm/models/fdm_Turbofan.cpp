@@ -101,3 +101,16 @@ void Turbofan::update( double throttle,
     computeThrust( machNumber, densityAltitude );
     // TODO
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbofan::archiveState( StateArchive *archive )
+{
+    archive->addEnum( &_state );
+
+    archive->add( &_n1 );
+    archive->add( &_n2 );
+    archive->add( &_tit );
+    archive->add( &_fuelFlow );
+    archive->add( &_thrust );
+}
@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -36,7 +38,7 @@ namespace fdm
 /**
  * @brief Twin-spool turbofan engine class.
  */
-class FDMEXPORT Turbofan
+class FDMEXPORT Turbofan : public ArenaObject
 {
 public:
 
@@ -92,6 +94,12 @@ public:
                          bool fuel,
                          bool starter );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     /**
      * @brief Returns propeller position expressed in BAS.
      * @return [m] propeller position expressed in BAS
@@ -0,0 +1,390 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/models/fdm_Turbulence.h>
+
+#include <cmath>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_Units.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int Turbulence::_block_size = 4096;
+const unsigned int Turbulence::_fade_size  = 256;
+
+const double Turbulence::_step = 0.05;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::getScales( double altitude_agl, Intensity intensity,
+                            double *l_uv, double *l_w,
+                            double *sigma_uv, double *sigma_w )
+{
+    // wind speed at 20 ft
+    double w_20 = 0.0;
+
+    switch ( intensity )
+    {
+        case Mild:     w_20 = Units::kts2mps( 15.0 ); break;
+        case Moderate: w_20 = Units::kts2mps( 30.0 ); break;
+        case Severe:   w_20 = Units::kts2mps( 45.0 ); break;
+        case Extreme:  w_20 = Units::kts2mps( 60.0 ); break;
+        case None: default: break;
+    }
+
+    double h_ft = Misc::max( 10.0, Units::m2ft( altitude_agl ) );
+
+    *sigma_w = 0.1 * w_20;
+
+    if ( h_ft < 1000.0 )
+    {
+        double coef = 0.177 + 0.000823 * h_ft;
+
+        *l_w  = Units::ft2m( h_ft );
+        *l_uv = Units::ft2m( h_ft / pow( coef, 1.2 ) );
+
+        *sigma_uv = *sigma_w / pow( coef, 0.4 );
+    }
+    else
+    {
+        double l_ft = 1750.0;
+
+        if ( h_ft < 2000.0 )
+        {
+            l_ft = 1000.0 + 750.0 * ( h_ft - 1000.0 ) / 1000.0;
+        }
+
+        *l_w  = Units::ft2m( l_ft );
+        *l_uv = Units::ft2m( l_ft );
+
+        *sigma_uv = *sigma_w;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Turbulence::Turbulence() :
+    _random ( 0 ),
+    _intensity ( None ),
+    _started ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Turbulence::~Turbulence() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::setSeed( UInt64 seed )
+{
+    _random.setSeed( seed );
+    _started = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::setIntensity( Intensity intensity )
+{
+    _intensity = intensity;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::update( double distance, double altitude_agl )
+{
+    if ( _intensity == None )
+    {
+        _vel_bas.set( 0.0, 0.0, 0.0 );
+        return;
+    }
+
+    if ( !_started ) start();
+
+    double l_uv = 0.0;
+    double l_w  = 0.0;
+    double sigma_uv = 0.0;
+    double sigma_w  = 0.0;
+
+    getScales( altitude_agl, _intensity, &l_uv, &l_w, &sigma_uv, &sigma_w );
+
+    distance = Misc::max( 0.0, distance );
+
+    _vel_bas.u() = sigma_uv * advance( &_u, Longitudinal, distance / l_uv );
+    _vel_bas.v() = sigma_uv * advance( &_v, Lateral, distance / l_uv );
+    _vel_bas.w() = sigma_w  * advance( &_w, Lateral, distance / l_w  );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::initAmplitudes()
+{
+    const unsigned int n_2 = _block_size / 2;
+
+    _amp_lon.resize( n_2, 0.0 );
+    _amp_lat.resize( n_2, 0.0 );
+
+    _re.resize( _block_size, 0.0 );
+    _im.resize( _block_size, 0.0 );
+
+    double d_omega = 2.0 * M_PI / ( _block_size * _step );
+
+    double sum_lon = 0.0;
+    double sum_lat = 0.0;
+
+    for ( unsigned int k = 1; k < n_2; k++ )
+    {
+        double omega_2 = Misc::pow2( k * d_omega );
+
+        // normalized (unit scale length and intensity) power spectral densities
+        double phi_lon = ( 2.0 / M_PI ) / ( 1.0 + omega_2 );
+        double phi_lat = ( 1.0 / M_PI ) * ( 1.0 + 3.0 * omega_2 )
+                       / Misc::pow2( 1.0 + omega_2 );
+
+        _amp_lon[ k ] = phi_lon * d_omega;
+        _amp_lat[ k ] = phi_lat * d_omega;
+
+        sum_lon += _amp_lon[ k ];
+        sum_lat += _amp_lat[ k ];
+    }
+
+    // discrete variance is normalized to exactly one
+    for ( unsigned int k = 1; k < n_2; k++ )
+    {
+        _amp_lon[ k ] = sqrt( _amp_lon[ k ] / sum_lon );
+        _amp_lat[ k ] = sqrt( _amp_lat[ k ] / sum_lat );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::start()
+{
+    if ( _amp_lon.empty() ) initAmplitudes();
+
+    start( &_u, Longitudinal );
+    start( &_v, Lateral );
+    start( &_w, Lateral );
+
+    _started = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::start( Stream *stream, Spectrum spectrum )
+{
+    stream->tail.clear();
+
+    generate( stream, spectrum, &stream->curr );
+    generate( stream, spectrum, &stream->next );
+
+    stream->pos = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::generate( Stream *stream, Spectrum spectrum,
+                           std::vector< double > *block )
+{
+    const std::vector< double > &amp = ( spectrum == Longitudinal ) ? _amp_lon : _amp_lat;
+
+    const unsigned int n_2 = _block_size / 2;
+    const unsigned int size = _block_size - _fade_size;
+
+    for ( unsigned int k = 0; k < _block_size; k++ )
+    {
+        _re[ k ] = 0.0;
+        _im[ k ] = 0.0;
+    }
+
+    // conjugated spectrum, real part of its forward transform is the same
+    // as real part of the inverse transform of the spectrum
+    for ( unsigned int k = 1; k < n_2; k++ )
+    {
+        _re[ k ] = amp[ k ] * getNormal();
+        _im[ k ] = amp[ k ] * getNormal();
+    }
+
+    transform();
+
+    block->resize( size );
+
+    for ( unsigned int i = 0; i < size; i++ )
+    {
+        (*block)[ i ] = _re[ i ];
+    }
+
+    if ( stream->tail.size() == _fade_size )
+    {
+        for ( unsigned int i = 0; i < _fade_size; i++ )
+        {
+            double t = ( i + 0.5 ) / _fade_size;
+
+            (*block)[ i ] = sqrt( 1.0 - t ) * stream->tail[ i ]
+                          + sqrt( t ) * (*block)[ i ];
+        }
+    }
+
+    stream->tail.resize( _fade_size );
+
+    for ( unsigned int i = 0; i < _fade_size; i++ )
+    {
+        stream->tail[ i ] = _re[ size + i ];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Turbulence::advance( Stream *stream, Spectrum spectrum, double delta )
+{
+    stream->pos += delta / _step;
+
+    while ( stream->pos >= stream->curr.size() )
+    {
+        stream->pos -= stream->curr.size();
+        stream->curr.swap( stream->next );
+        generate( stream, spectrum, &stream->next );
+    }
+
+    unsigned int i = static_cast< unsigned int >( stream->pos );
+    double f = stream->pos - i;
+
+    double v_0 = stream->curr[ i ];
+    double v_1 = ( i + 1 < stream->curr.size() ) ? stream->curr[ i + 1 ] : stream->next[ 0 ];
+
+    return v_0 + f * ( v_1 - v_0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Turbulence::getNormal()
+{
+    // Irwin-Hall approximation, uses only additions
+    double sum = 0.0;
+
+    for ( int i = 0; i < 12; i++ )
+    {
+        sum += _random.getUniform();
+    }
+
+    return sum - 6.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::transform()
+{
+    const unsigned int n = _block_size;
+
+    // bit reversal permutation
+    for ( unsigned int i = 1, j = 0; i < n; i++ )
+    {
+        unsigned int bit = n >> 1;
+
+        for ( ; j & bit; bit >>= 1 ) j ^= bit;
+
+        j ^= bit;
+
+        if ( i < j )
+        {
+            double tr = _re[ i ]; _re[ i ] = _re[ j ]; _re[ j ] = tr;
+            double ti = _im[ i ]; _im[ i ] = _im[ j ]; _im[ j ] = ti;
+        }
+    }
+
+    // cosine and sine of 2*pi/len angle are computed from the previous ones
+    // with half angle formulas instead of library trigonometric functions
+    double c = -1.0;
+    double s =  0.0;
+
+    for ( unsigned int len = 2; len <= n; len <<= 1 )
+    {
+        if ( len > 2 )
+        {
+            double c_2 = sqrt( 0.5 * ( 1.0 + c ) );
+            double s_2 = ( c_2 > 0.5 ) ? ( s / ( 2.0 * c_2 ) ) : sqrt( 0.5 * ( 1.0 - c ) );
+
+            c = c_2;
+            s = s_2;
+        }
+
+        for ( unsigned int i = 0; i < n; i += len )
+        {
+            double wr = 1.0;
+            double wi = 0.0;
+
+            for ( unsigned int j = 0; j < len / 2; j++ )
+            {
+                unsigned int i_0 = i + j;
+                unsigned int i_1 = i + j + len / 2;
+
+                double tr = _re[ i_1 ] * wr - _im[ i_1 ] * wi;
+                double ti = _re[ i_1 ] * wi + _im[ i_1 ] * wr;
+
+                _re[ i_1 ] = _re[ i_0 ] - tr;
+                _im[ i_1 ] = _im[ i_0 ] - ti;
+                _re[ i_0 ] += tr;
+                _im[ i_0 ] += ti;
+
+                // forward transform twiddle factor exp( -i*2*pi/len )
+                double wr_n = wr * c + wi * s;
+                double wi_n = wi * c - wr * s;
+
+                wr = wr_n;
+                wi = wi_n;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::archiveState( StateArchive *archive )
+{
+    _random.archiveState( archive );
+
+    archive->add( &_started );
+
+    archiveStream( archive, &_u );
+    archiveStream( archive, &_v );
+    archiveStream( archive, &_w );
+
+    archive->add( &_vel_bas );
+
+    // spectra amplitudes are constant, they are computed when needed
+    if ( archive->isRestoring() && _started && _amp_lon.empty() ) initAmplitudes();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Turbulence::archiveStream( StateArchive *archive, Stream *stream )
+{
+    archive->add( &stream->curr, _block_size - _fade_size );
+    archive->add( &stream->next, _block_size - _fade_size );
+    archive->add( &stream->tail, _fade_size );
+
+    archive->add( &stream->pos );
+}
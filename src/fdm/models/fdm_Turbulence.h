@@ -0,0 +1,212 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_TURBULENCE_H
+#define FDM_TURBULENCE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_Random.h>
+#include <fdm/utils/fdm_StateArchive.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Dryden turbulence model class.
+ *
+ * Turbulence velocity components are generated in blocks as spectrally
+ * shaped random sequences (Fourier synthesis of the Dryden spectra with
+ * random amplitudes) and streamed by the distance flown, so no filtering is
+ * done at simulation steps. Sequences are generated in distance normalized
+ * by the turbulence scale length with unit intensity, altitude affects only
+ * the playback rate and the scale of velocities. Subsequent blocks are cross
+ * faded with constant variance weights.
+ *
+ * Sequences are generated with the model own random number generator using
+ * only basic arithmetic operations and square roots, so the same seed gives
+ * bit-identical sequences on every machine.
+ *
+ * Scale lengths and intensities are due to low altitude (below 1000 ft)
+ * model, above 2000 ft scale lengths are 1750 ft and between they are
+ * interpolated linearly. Intensities above 1000 ft are the same as at
+ * 1000 ft. Velocities are expressed in BAS.
+ *
+ * @see MIL-F-8785C Flying Qualities of Piloted Airplanes, 1980, p. 49-57
+ * @see MIL-HDBK-1797 Flying Qualities of Piloted Aircraft, 1997, p. 677-706
+ * @see Shinozuka M.: Simulation of Multivariate and Multidimensional Processes, 1971
+ */
+class FDMEXPORT Turbulence : public ArenaObject
+{
+public:
+
+    /** Turbulence intensity. */
+    enum Intensity
+    {
+        None = 0,                   ///< none
+        Mild,                       ///< mild
+        Moderate,                   ///< moderate
+        Severe,                     ///< severe
+        Extreme                     ///< extreme
+    };
+
+    static const unsigned int _block_size;  ///< number of samples of generated block (power of 2)
+    static const unsigned int _fade_size;   ///< number of cross faded samples between blocks
+    static const double _step;              ///< [-] samples spacing normalized by scale length
+
+    /**
+     * @brief Computes scale lengths and intensities.
+     * @param altitude_agl [m] altitude above ground level
+     * @param intensity turbulence intensity
+     * @param l_uv [m] longitudinal and lateral scale length
+     * @param l_w [m] vertical scale length
+     * @param sigma_uv [m/s] longitudinal and lateral intensity
+     * @param sigma_w [m/s] vertical intensity
+     */
+    static void getScales( double altitude_agl, Intensity intensity,
+                           double *l_uv, double *l_w,
+                           double *sigma_uv, double *sigma_w );
+
+    /** @brief Constructor. */
+    Turbulence();
+
+    /** @brief Destructor. */
+    virtual ~Turbulence();
+
+    /**
+     * @brief Seeds random number generator and restarts sequences.
+     * @param seed generator seed
+     */
+    void setSeed( UInt64 seed );
+
+    /**
+     * @brief Sets turbulence intensity.
+     * @param intensity turbulence intensity
+     */
+    void setIntensity( Intensity intensity );
+
+    /**
+     * @brief Updates turbulence.
+     * @param distance [m] distance flown since previous update
+     * @param altitude_agl [m] altitude above ground level
+     */
+    void update( double distance, double altitude_agl );
+
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
+    inline const Vector3& getVel_BAS() const { return _vel_bas; }
+
+    inline Intensity getIntensity() const { return _intensity; }
+
+private:
+
+    /** Normalized turbulence velocity component sequence. */
+    struct Stream
+    {
+        std::vector< double > curr;     ///< current block
+        std::vector< double > next;     ///< next block
+        std::vector< double > tail;     ///< samples to be cross faded into next block
+        double pos;                     ///< [-] position within current block (samples)
+    };
+
+    /** Spectrum type. */
+    enum Spectrum
+    {
+        Longitudinal = 0,               ///< longitudinal spectrum
+        Lateral                         ///< lateral and vertical spectrum
+    };
+
+    Random _random;                     ///< random number generator
+
+    Intensity _intensity;               ///< turbulence intensity
+
+    Stream _u;                          ///< longitudinal velocity sequence
+    Stream _v;                          ///< lateral velocity sequence
+    Stream _w;                          ///< vertical velocity sequence
+
+    std::vector< double > _amp_lon;     ///< longitudinal spectrum amplitudes
+    std::vector< double > _amp_lat;     ///< lateral spectrum amplitudes
+
+    std::vector< double > _re;          ///< FFT buffer real parts
+    std::vector< double > _im;          ///< FFT buffer imaginary parts
+
+    Vector3 _vel_bas;                   ///< [m/s] turbulence velocity expressed in BAS
+
+    bool _started;                      ///< specifies if sequences are generated
+
+    /** Computes spectra amplitudes. */
+    void initAmplitudes();
+
+    /**
+     * @brief Archives sequence.
+     * @param archive state archive
+     * @param stream velocity sequence
+     */
+    void archiveStream( StateArchive *archive, Stream *stream );
+
+    /** Starts all sequences. */
+    void start();
+
+    /**
+     * @brief Starts sequence.
+     * @param stream sequence
+     * @param spectrum spectrum type
+     */
+    void start( Stream *stream, Spectrum spectrum );
+
+    /**
+     * @brief Generates next block of the sequence.
+     * @param stream sequence
+     * @param spectrum spectrum type
+     * @param block output block
+     */
+    void generate( Stream *stream, Spectrum spectrum, std::vector< double > *block );
+
+    /**
+     * @brief Advances sequence and returns its interpolated value.
+     * @param stream sequence
+     * @param spectrum spectrum type
+     * @param delta [-] normalized distance
+     */
+    double advance( Stream *stream, Spectrum spectrum, double delta );
+
+    /** @brief Gets normally distributed random number. */
+    double getNormal();
+
+    /** @brief Transforms FFT buffer (forward in-place radix-2 FFT). */
+    void transform();
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_TURBULENCE_H
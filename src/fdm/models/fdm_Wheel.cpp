@@ -22,6 +22,8 @@
 
 #include <fdm/models/fdm_Wheel.h>
 
+#include <algorithm>
+
 #include <fdm/utils/fdm_String.h>
 #include <fdm/xml/fdm_XmlUtils.h>
 
@@ -49,6 +51,9 @@ Wheel::Wheel( bool staticFriction ) :
 
     _brakeGroup ( None ),
 
+    _contactMass ( 0.0 ),
+    _contactTimeStep ( 0.0 ),
+
     _d_roll ( 0.0 ),
     _d_slip ( 0.0 ),
 
@@ -137,9 +142,24 @@ void Wheel::computeForceAndMoment( const Vector3 &vel_bas,
                             &dir_lon_bas, &dir_lat_bas,
                             &cosDelta, &sinDelta, &v_norm, &v_roll, &v_slip );
 
+        const bool implicit = _contactMass > 0.0 && _contactTimeStep > 0.0;
+
+        const double dt = _contactTimeStep;
+        const double m  = _contactMass;
+
         // normal force
         double for_norm = _k * deflection_norm - _c * v_norm;
 
+        if ( implicit )
+        {
+            // linearized backward Euler, deflection rate is -v_norm
+            double a_norm = n_c_bas * _contactAcc_bas;
+            double v_norm_1 = ( v_norm + dt * ( _k * deflection_norm / m + a_norm ) )
+                            / ( 1.0 + dt * ( _c + _k * dt ) / m );
+
+            for_norm = m * ( ( v_norm_1 - v_norm ) / dt - a_norm );
+        }
+
         // friction coefs
         double mu_surf_s = _mu_s * surf_coef;
         double mu_surf_k = _mu_k * surf_coef;
@@ -149,14 +169,49 @@ void Wheel::computeForceAndMoment( const Vector3 &vel_bas,
         double coef_roll = 0.0;
         double coef_slip = 0.0;
 
-        if ( _v_max > 0.0 )
+        double v_max_roll = _v_max;
+        double v_max_slip = _v_max;
+
+        double stat_coef = 1.0;
+
+        if ( implicit )
         {
-            coef_roll = Misc::satur( 0.0, 1.0, fabs( v_roll ) / _v_max ) * Misc::sign( v_roll );
-            coef_slip = Misc::satur( 0.0, 1.0, fabs( v_slip ) / _v_max ) * Misc::sign( v_slip );
+            // end of step velocities due to external acceleration
+            double a_lon = _contactAcc_bas * dir_lon_bas;
+            double a_lat = _contactAcc_bas * dir_lat_bas;
+
+            v_roll += dt * ( a_lon * cosDelta - a_lat * sinDelta );
+            v_slip += dt * ( a_lat * cosDelta - a_lon * sinDelta );
+
+            // velocity change maximum friction force causes in a single step
+            double for_norm_max = ( for_norm < 0.0 ) ? 0.0 : for_norm;
+            double mu_roll_max  = std::min( _mu_r + mu_surf_s * _brake, mu_surf_s );
+
+            v_max_roll += dt * for_norm_max * mu_roll_max / m;
+            v_max_slip += dt * for_norm_max * mu_surf_k   / m;
+
+            // static friction spring linearized stiffness is 1.5*F/d_max
+            if ( _d_max > 0.0 )
+            {
+                stat_coef = 1.0 / ( 1.0 + 1.5 * dt * dt * for_norm_max * mu_surf_s / ( _d_max * m ) );
+            }
+        }
+
+        if ( v_max_roll > 0.0 )
+        {
+            coef_roll = Misc::satur( 0.0, 1.0, fabs( v_roll ) / v_max_roll ) * Misc::sign( v_roll );
         }
         else
         {
             coef_roll = Misc::sign( v_roll );
+        }
+
+        if ( v_max_slip > 0.0 )
+        {
+            coef_slip = Misc::satur( 0.0, 1.0, fabs( v_slip ) / v_max_slip ) * Misc::sign( v_slip );
+        }
+        else
+        {
             coef_slip = Misc::sign( v_slip );
         }
 
@@ -168,6 +223,9 @@ void Wheel::computeForceAndMoment( const Vector3 &vel_bas,
                 double cr = ( 2.0 / ( 1.0 + exp( -3.0 * Misc::satur( 0.0, 1.0, fabs( _d_roll ) / _d_max ) ) ) - 1.0 ) * Misc::sign( _d_roll );
                 double cs = ( 2.0 / ( 1.0 + exp( -3.0 * Misc::satur( 0.0, 1.0, fabs( _d_slip ) / _d_max ) ) ) - 1.0 ) * Misc::sign( _d_slip );
 
+                cr *= stat_coef;
+                cs *= stat_coef;
+
                 if      ( coef_roll < 0.0 && cr < 0.0 ) { if ( cr < coef_roll ) coef_roll = cr; }
                 else if ( coef_roll > 0.0 && cr > 0.0 ) { if ( cr > coef_roll ) coef_roll = cr; }
                 else
@@ -341,3 +399,18 @@ void Wheel::calculateVariables( const Vector3 &vel_bas,
     (*v_roll) = vel_lon * (*cosDelta) - vel_lat * (*sinDelta);
     (*v_slip) = vel_lat * (*cosDelta) - vel_lon * (*sinDelta);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Wheel::archiveState( StateArchive *archive )
+{
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_d_roll );
+    archive->add( &_d_slip );
+
+    archive->add( &_position );
+    archive->add( &_delta );
+    archive->add( &_brake );
+}
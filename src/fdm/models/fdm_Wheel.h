@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -54,12 +56,21 @@ namespace fdm
  *
  * Optional elements: "max_angle", "vel_break"
  *
+ * If contact mass is given (see setImplicitContact()) strut spring and
+ * damper and tyre friction are computed semi-implicitly: forces are those
+ * for which explicit integration over the time step gives the same velocity
+ * change as linearized backward Euler integration of the supported mass
+ * loaded with given external acceleration (gravity). Static equilibrium is
+ * the same as for explicit forces, but strut does not bounce and friction
+ * does not chatter at time steps several times larger than explicit forces
+ * allow.
+ *
  * @see J. O’Rourke, Computational Geometry in C, 1998
  * @see K. Studzinski: Samochod. Teoria, konstrukcja i obliczenia, 1980 [in Polish]
  * @see P.R. Dahl: A Solid Friction Model, ADA041920, 1968
  * @see V. van Geffen: A study of friction models and friction compensation, 2009
  */
-class FDMEXPORT Wheel
+class FDMEXPORT Wheel : public ArenaObject
 {
 public:
 
@@ -120,6 +131,20 @@ public:
                             const Vector3 &n_c_bas,
                             bool steering );
 
+    /**
+     * @brief Sets semi-implicit contact parameters.
+     * @param mass [kg] mass supported by the wheel, 0 means explicit contact forces
+     * @param timeStep [s] integration time step
+     * @param acc_bas [m/s^2] supported mass acceleration due to forces other than contact forces (e.g. gravity) expressed in BAS
+     */
+    inline void setImplicitContact( double mass, double timeStep,
+                                    const Vector3 &acc_bas = Vector3() )
+    {
+        _contactMass     = mass;
+        _contactTimeStep = timeStep;
+        _contactAcc_bas  = acc_bas;
+    }
+
     /**
      * @brief Update wheel model.
      * @param position [-] normalized position (0.0 - retracted, 1.0 - extended)
@@ -128,6 +153,12 @@ public:
      */
     virtual void update( double position, double delta, double brake );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
@@ -165,6 +196,11 @@ protected:
 
     BrakeGroup _brakeGroup; ///< brake group
 
+    Vector3 _contactAcc_bas;    ///< [m/s^2] supported mass acceleration due to other than contact forces expressed in BAS
+
+    double _contactMass;        ///< [kg] mass supported by the wheel used for semi-implicit contact
+    double _contactTimeStep;    ///< [s] time step used for semi-implicit contact
+
     double _d_roll;         ///< [m] roll direction distance for static friction spring like model
     double _d_slip;         ///< [m] slip direction distance for static friction spring like model
 
@@ -46,6 +46,9 @@ WinchLauncher::WinchLauncher() :
     _vel ( 0.0 ),
     _len ( 0.0 ),
 
+    _cableMass     ( 0.0 ),
+    _cableTimeStep ( 0.0 ),
+
     _active ( true )
 {}
 
@@ -86,7 +89,9 @@ void WinchLauncher::readData( XmlNode &dataNode )
 ////////////////////////////////////////////////////////////////////////////////
 
 void WinchLauncher::computeForceAndMoment( const fdm::Matrix3x3 &wgs2bas,
-                                           const Vector3 &pos_wgs )
+                                           const Vector3 &pos_wgs,
+                                           const Vector3 &vel_bas,
+                                           const Vector3 &omg_bas )
 {
     _for_bas.zeroize();
     _mom_bas.zeroize();
@@ -94,10 +99,31 @@ void WinchLauncher::computeForceAndMoment( const fdm::Matrix3x3 &wgs2bas,
     if ( _active )
     {
         Vector3 pos_bas = wgs2bas * ( _pos_wgs - pos_wgs );
+        Vector3 dir_bas = pos_bas.getNormalized();
 
         double x = Misc::max( 0.0, pos_bas.getLength() - _len );
 
-        _for_bas = Misc::max( _for, fabs( x ) * x * _stiffness ) * pos_bas.getNormalized();
+        double for_cable = fabs( x ) * x * _stiffness;
+
+        if ( _cableMass > 0.0 && _cableTimeStep > 0.0 && x > 0.0 )
+        {
+            // stretch rate due to attachment point velocity and cable reeling in
+            Vector3 vel_att_bas = vel_bas + ( omg_bas % _r_a_bas );
+
+            double x_dot = _vel - vel_att_bas * dir_bas;
+            double a_ext = -( _cableAcc_bas * dir_bas );
+
+            // linearized backward Euler: m * x_ddot = -F + m * a_ext, F = F_0 + k_x * dx
+            double k_x = 2.0 * _stiffness * x;
+            double dt = _cableTimeStep;
+
+            for_cable = ( for_cable + k_x * dt * ( x_dot + dt * a_ext ) )
+                      / ( 1.0 + k_x * dt * dt / _cableMass );
+
+            for_cable = Misc::max( 0.0, for_cable );
+        }
+
+        _for_bas = Misc::max( _for, for_cable ) * dir_bas;
         _mom_bas = _r_a_bas % _for_bas;
     }
 }
@@ -135,3 +161,19 @@ void WinchLauncher::update( double timeStep,
         }
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WinchLauncher::archiveState( StateArchive *archive )
+{
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_pos_wgs );
+
+    archive->add( &_for );
+    archive->add( &_vel );
+    archive->add( &_len );
+
+    archive->add( &_active );
+}
@@ -24,7 +24,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_StateArchive.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -49,8 +51,14 @@ namespace fdm
  *   <stiffnes> { [N/m^2] cable stiffness } </stiffnes>
  * </winch_launcher>
  * @endcode
+ *
+ * If towed mass is given (see setImplicitCable()) cable stretch force is
+ * computed semi-implicitly: force is the one given by linearized backward
+ * Euler integration of the towed mass stretching the cable, loaded with given
+ * external acceleration (gravity). Stiff cable does not oscillate then and
+ * launch can be run at the same time step as free flight.
  */
-class FDMEXPORT WinchLauncher
+class FDMEXPORT WinchLauncher : public ArenaObject
 {
 public:
 
@@ -70,9 +78,28 @@ public:
      * @brief Computes force and moment.
      * @param wgs2bas matrix of rotation from WGS to BAS
      * @param pos_wgs [m] aircraft position expressed in WGS
+     * @param vel_bas [m/s] aircraft linear velocity vector expressed in BAS
+     * @param omg_bas [rad/s] aircraft angular velocity expressed in BAS
      */
     virtual void computeForceAndMoment( const fdm::Matrix3x3 &wgs2bas,
-                                        const Vector3 &pos_wgs );
+                                        const Vector3 &pos_wgs,
+                                        const Vector3 &vel_bas = Vector3(),
+                                        const Vector3 &omg_bas = Vector3() );
+
+    /**
+     * @brief Sets semi-implicit cable force parameters.
+     * Zero mass (default) means explicit cable force.
+     * @param mass [kg] towed mass
+     * @param timeStep [s] integration time step
+     * @param acc_bas [m/s^2] towed mass acceleration due to forces other than cable force (e.g. gravity) expressed in BAS
+     */
+    inline void setImplicitCable( double mass, double timeStep,
+                                  const Vector3 &acc_bas = Vector3() )
+    {
+        _cableMass     = mass;
+        _cableTimeStep = timeStep;
+        _cableAcc_bas  = acc_bas;
+    }
 
     /**
      * @brief Update winch model.
@@ -88,9 +115,17 @@ public:
                          const Vector3 &pos_wgs,
                          double altitude_agl );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
+    inline bool isActive() const { return _active; }
+
 protected:
 
     Vector3 _for_bas;       ///< [N] total force vector expressed in BAS
@@ -114,6 +149,11 @@ protected:
     double _vel;            ///< [m/s] current cable velocity
     double _len;            ///< [m]   current cable length
 
+    Vector3 _cableAcc_bas;  ///< [m/s^2] towed mass external acceleration expressed in BAS (semi-implicit force)
+
+    double _cableMass;      ///< [kg] towed mass (semi-implicit force), zero means explicit force
+    double _cableTimeStep;  ///< [s]  integration time step (semi-implicit force)
+
     bool _active;           ///< specify if winch is active
 };
 
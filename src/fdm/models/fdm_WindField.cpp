@@ -0,0 +1,298 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/models/fdm_WindField.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <fdm/fdm_Exception.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char WindField::_magic[ 8 ] = { 'F', 'D', 'M', 'W', 'I', 'N', 'D', '1' };
+
+////////////////////////////////////////////////////////////////////////////////
+
+WindField::WindField() :
+    _vel_ptr ( FDM_NULLPTR ),
+    _loaded ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+WindField::~WindField() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::readFile( const char *fileName )
+{
+    clear();
+
+    if ( !_file.open( fileName ) )
+    {
+        throwError( "Cannot open wind field file \"" + std::string( fileName ) + "\"." );
+    }
+
+    const char *data = _file.getData();
+    const size_t size = _file.getSize();
+
+    const size_t header_size = sizeof( _magic ) + 4 * sizeof( UInt32 ) + 3 * sizeof( double );
+
+    if ( size < header_size || 0 != memcmp( data, _magic, sizeof( _magic ) ) )
+    {
+        clear();
+        throwError( "Invalid wind field file header." );
+    }
+
+    UInt32 n[ 3 ] = { 0, 0, 0 };
+    WGS84::Geo origin;
+
+    size_t pos = sizeof( _magic );
+
+    memcpy( n, data + pos, sizeof( n ) );
+    pos += 4 * sizeof( UInt32 );
+
+    memcpy( &origin.lat, data + pos, sizeof( double ) ); pos += sizeof( double );
+    memcpy( &origin.lon, data + pos, sizeof( double ) ); pos += sizeof( double );
+    memcpy( &origin.alt, data + pos, sizeof( double ) ); pos += sizeof( double );
+
+    // sanity limit, prevents size overflow due to corrupted header
+    const UInt32 n_max = 4096;
+
+    if ( n[ 0 ] < 2 || n[ 1 ] < 2 || n[ 2 ] < 2
+      || n[ 0 ] > n_max || n[ 1 ] > n_max || n[ 2 ] > n_max )
+    {
+        clear();
+        throwError( "Invalid wind field grid size." );
+    }
+
+    const size_t nodes = static_cast< size_t >( n[ 0 ] ) * n[ 1 ] * n[ 2 ];
+
+    if ( size != pos + ( n[ 0 ] + n[ 1 ] + n[ 2 ] ) * sizeof( double )
+                     + 3 * nodes * sizeof( float ) )
+    {
+        clear();
+        throwError( "Invalid wind field file size." );
+    }
+
+    std::vector< double > x( n[ 0 ] );
+    std::vector< double > y( n[ 1 ] );
+    std::vector< double > z( n[ 2 ] );
+
+    memcpy( &x[ 0 ], data + pos, x.size() * sizeof( double ) ); pos += x.size() * sizeof( double );
+    memcpy( &y[ 0 ], data + pos, y.size() * sizeof( double ) ); pos += y.size() * sizeof( double );
+    memcpy( &z[ 0 ], data + pos, z.size() * sizeof( double ) ); pos += z.size() * sizeof( double );
+
+    try
+    {
+        setNodes( origin, x, y, z );
+    }
+    catch ( ... )
+    {
+        clear();
+        throw;
+    }
+
+    // header layout keeps velocities aligned within the page aligned mapping
+    _vel_ptr = reinterpret_cast< const float* >( data + pos );
+    _loaded = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::setGrid( const WGS84::Geo &origin,
+                         const std::vector< double > &x,
+                         const std::vector< double > &y,
+                         const std::vector< double > &z,
+                         const std::vector< float > &vel )
+{
+    clear();
+
+    setNodes( origin, x, y, z );
+
+    if ( vel.size() != 3 * x.size() * y.size() * z.size() )
+    {
+        clear();
+        throwError( "Invalid wind field data size." );
+    }
+
+    _vel = vel;
+    _vel_ptr = &_vel[ 0 ];
+    _loaded = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::clear()
+{
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _vel.clear();
+
+    _file.close();
+
+    _vel_ptr = FDM_NULLPTR;
+    _loaded = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Vector3 WindField::getWind_NED( const Vector3 &pos_wgs, Bracket *bracket ) const
+{
+    Vector3 result;
+
+    if ( !_loaded ) return result;
+
+    Bracket temp;
+    if ( !bracket ) bracket = &temp;
+
+    Vector3 pos_ned = _wgs2ned * ( pos_wgs - _origin_wgs );
+
+    if ( findCell( _x, pos_ned.x(), &bracket->i )
+      && findCell( _y, pos_ned.y(), &bracket->j )
+      && findCell( _z, pos_ned.z(), &bracket->k ) )
+    {
+        const UInt32 i = bracket->i;
+        const UInt32 j = bracket->j;
+        const UInt32 k = bracket->k;
+
+        double fx = ( pos_ned.x() - _x[ i ] ) / ( _x[ i + 1 ] - _x[ i ] );
+        double fy = ( pos_ned.y() - _y[ j ] ) / ( _y[ j + 1 ] - _y[ j ] );
+        double fz = ( pos_ned.z() - _z[ k ] ) / ( _z[ k + 1 ] - _z[ k ] );
+
+        const UInt32 nx = _x.size();
+        const UInt32 ny = _y.size();
+
+        // strides between neighbouring nodes
+        const UInt32 sx = 3;
+        const UInt32 sy = 3 * nx;
+        const UInt32 sz = 3 * nx * ny;
+
+        const float *v = _vel_ptr + 3 * ( i + nx * ( j + ny * k ) );
+
+        for ( int c = 0; c < 3; c++ )
+        {
+            double v00 = v[ c ]           + fx * ( v[ c + sx ]           - v[ c ]           );
+            double v10 = v[ c + sy ]      + fx * ( v[ c + sy + sx ]      - v[ c + sy ]      );
+            double v01 = v[ c + sz ]      + fx * ( v[ c + sz + sx ]      - v[ c + sz ]      );
+            double v11 = v[ c + sz + sy ] + fx * ( v[ c + sz + sy + sx ] - v[ c + sz + sy ] );
+
+            double v_0 = v00 + fy * ( v10 - v00 );
+            double v_1 = v01 + fy * ( v11 - v01 );
+
+            result( c ) = v_0 + fz * ( v_1 - v_0 );
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::setNodes( const WGS84::Geo &origin,
+                          const std::vector< double > &x,
+                          const std::vector< double > &y,
+                          const std::vector< double > &z )
+{
+    const std::vector< double > *nodes[] = { &x, &y, &z };
+
+    for ( int n = 0; n < 3; n++ )
+    {
+        if ( nodes[ n ]->size() < 2 )
+        {
+            throwError( "Invalid wind field grid size." );
+        }
+
+        for ( UInt32 i = 1; i < nodes[ n ]->size(); i++ )
+        {
+            if ( !( (*nodes[ n ])[ i ] > (*nodes[ n ])[ i - 1 ] ) )
+            {
+                throwError( "Wind field grid nodes are not strictly increasing." );
+            }
+        }
+    }
+
+    _x = x;
+    _y = y;
+    _z = z;
+
+    WGS84 wgs( origin );
+
+    _origin_wgs = wgs.getPos_WGS();
+    _wgs2ned = wgs.getWGS2NED();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool WindField::findCell( const std::vector< double > &nodes, double coord,
+                          UInt32 *index )
+{
+    const UInt32 cells = nodes.size() - 1;
+
+    if ( !( coord >= nodes.front() && coord <= nodes.back() ) ) return false;
+
+    UInt32 i = *index;
+
+    if ( i < cells )
+    {
+        // cached cell and its neighbours
+        if ( coord >= nodes[ i ] && coord <= nodes[ i + 1 ] ) return true;
+
+        if ( i + 1 < cells && coord >= nodes[ i + 1 ] && coord <= nodes[ i + 2 ] )
+        {
+            *index = i + 1;
+            return true;
+        }
+
+        if ( i > 0 && coord >= nodes[ i - 1 ] && coord <= nodes[ i ] )
+        {
+            *index = i - 1;
+            return true;
+        }
+    }
+
+    std::vector< double >::const_iterator it =
+            std::upper_bound( nodes.begin(), nodes.end(), coord );
+
+    i = static_cast< UInt32 >( it - nodes.begin() );
+    *index = ( i > 0 ) ? std::min( i - 1, cells - 1 ) : 0;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindField::throwError( const std::string &info )
+{
+    Exception e;
+
+    e.setType( Exception::FileReadingError );
+    e.setInfo( info );
+
+    FDM_THROW( e );
+}
@@ -0,0 +1,171 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_WINDFIELD_H
+#define FDM_WINDFIELD_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <fdm/fdm_Types.h>
+
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_MappedFile.h>
+#include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_Vector3.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Spatial wind field class.
+ *
+ * Wind field is defined on a rectilinear (not necessarily uniform) grid
+ * expressed in the local NED axis system of the grid origin and is queried
+ * with trilinear interpolation. Outside the grid wind field velocity is zero,
+ * so fields should fade out towards their boundaries.
+ *
+ * Every querying point (e.g. aircraft center of mass, landing gear unit,
+ * rotor hub) should keep its own bracket, as consecutive queries of a moving
+ * point usually fall into the same or neighbouring cell, bracket makes cell
+ * lookup constant time.
+ *
+ * Wind field file is memory-mapped and velocities are read directly from
+ * the mapping, so large fields are neither copied nor loaded entirely.
+ *
+ * Binary file format (little-endian, header keeps all values aligned):
+ * <pre>
+ * char[8] "FDMWIND1"
+ * UInt32  nx, ny, nz               number of grid nodes along axes (at least 2 each)
+ * UInt32  reserved                 zero
+ * double  lat, lon, alt            [rad],[rad],[m] grid origin
+ * double  x[nx], y[ny], z[nz]      [m] strictly increasing nodes coordinates expressed in NED
+ * float   vel[nz][ny][nx][3]       [m/s] wind velocity (north, east, down components)
+ * </pre>
+ */
+class FDMEXPORT WindField : public ArenaObject
+{
+public:
+
+    static const char _magic[ 8 ];  ///< file magic number
+
+    /** Cached grid cell of the querying point. */
+    struct Bracket
+    {
+        Bracket() : i ( 0 ), j ( 0 ), k ( 0 ) {}
+
+        UInt32 i;                   ///< x-axis cell index
+        UInt32 j;                   ///< y-axis cell index
+        UInt32 k;                   ///< z-axis cell index
+    };
+
+    /** @brief Constructor. */
+    WindField();
+
+    /** @brief Destructor. */
+    virtual ~WindField();
+
+    /**
+     * @brief Reads wind field from file.
+     * Throws exception if file cannot be read or is invalid, previous wind
+     * field is removed in any case.
+     * @param fileName file name
+     */
+    void readFile( const char *fileName );
+
+    /**
+     * @brief Sets wind field grid.
+     * Throws exception if grid is invalid, previous wind field is removed
+     * in any case.
+     * @param origin grid origin
+     * @param x [m] nodes x-coordinates expressed in NED
+     * @param y [m] nodes y-coordinates expressed in NED
+     * @param z [m] nodes z-coordinates expressed in NED
+     * @param vel [m/s] wind velocities expressed in NED (x index changes fastest)
+     */
+    void setGrid( const WGS84::Geo &origin,
+                  const std::vector< double > &x,
+                  const std::vector< double > &y,
+                  const std::vector< double > &z,
+                  const std::vector< float > &vel );
+
+    /** @brief Removes wind field. */
+    void clear();
+
+    /**
+     * @brief Returns wind field velocity at the given point.
+     * @param pos_wgs [m] point position expressed in WGS
+     * @param bracket querying point cached cell (might be null)
+     * @return [m/s] wind velocity expressed in NED
+     */
+    Vector3 getWind_NED( const Vector3 &pos_wgs, Bracket *bracket = FDM_NULLPTR ) const;
+
+    inline bool isLoaded() const { return _loaded; }
+
+private:
+
+    std::vector< double > _x;       ///< [m] nodes x-coordinates expressed in NED
+    std::vector< double > _y;       ///< [m] nodes y-coordinates expressed in NED
+    std::vector< double > _z;       ///< [m] nodes z-coordinates expressed in NED
+    std::vector< float > _vel;      ///< [m/s] wind velocities expressed in NED (set directly)
+
+    MappedFile _file;               ///< mapped wind field file
+
+    const float *_vel_ptr;          ///< [m/s] wind velocities expressed in NED (either set directly or mapped)
+
+    Vector3 _origin_wgs;            ///< [m] grid origin expressed in WGS
+    Matrix3x3 _wgs2ned;             ///< matrix of rotation from WGS to grid NED
+
+    bool _loaded;                   ///< specifies if wind field is loaded
+
+    /**
+     * @brief Finds cell containing given coordinate.
+     * @param nodes nodes coordinates
+     * @param coord coordinate
+     * @param index cell index, cached value is checked first
+     * @return true if coordinate is within nodes range
+     */
+    /**
+     * @brief Sets grid nodes and origin.
+     * Throws exception if nodes are invalid.
+     */
+    void setNodes( const WGS84::Geo &origin,
+                   const std::vector< double > &x,
+                   const std::vector< double > &y,
+                   const std::vector< double > &z );
+
+    static bool findCell( const std::vector< double > &nodes, double coord,
+                          UInt32 *index );
+
+    /** Throws invalid data exception. */
+    static void throwError( const std::string &info );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_WINDFIELD_H
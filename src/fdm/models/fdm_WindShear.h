@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,7 +37,7 @@ namespace fdm
  *
  * @see Windshear Training Aid, Volume 2 - Substantiating Data, FAA, 1990, p. 4.3-144 - 4.3-153
  */
-class FDMEXPORT WindShear
+class FDMEXPORT WindShear : public ArenaObject
 {
 public:
 
@@ -109,3 +109,13 @@ void WingRunner::update( double timeStep, const Vector3 &vel_bas, bool onGround
         }
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WingRunner::archiveState( StateArchive *archive )
+{
+    archive->add( &_for_bas );
+    archive->add( &_mom_bas );
+
+    archive->add( &_active );
+}
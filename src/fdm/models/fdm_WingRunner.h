@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Arena.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -46,7 +48,7 @@ namespace fdm
  * </wing_runner>
  * @endcode
  */
-class FDMEXPORT WingRunner
+class FDMEXPORT WingRunner : public ArenaObject
 {
 public:
 
@@ -80,9 +82,17 @@ public:
      */
     virtual void update( double timeStep, const Vector3 &vel_bas, bool onGround );
 
+    /**
+     * @brief Archives internal states.
+     * @param archive state archive
+     */
+    virtual void archiveState( StateArchive *archive );
+
     inline const Vector3& getFor_BAS() const { return _for_bas; }
     inline const Vector3& getMom_BAS() const { return _mom_bas; }
 
+    inline bool isActive() const { return _active; }
+
     inline Vector3 getRw_BAS() const { return _r_w_bas; }
     inline Vector3 getRf_BAS() const { return _r_f_bas; }
 
@@ -0,0 +1,182 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_AllocTracker.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _LINUX_
+#   include <execinfo.h>
+#   include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+thread_local UInt64 allocs = 0;
+thread_local UInt64 violations = 0;
+thread_local bool guarded = false;
+
+std::atomic< bool > abortOnViolation( false );
+
+/** Reports violation, must not allocate through operator new. */
+void reportViolation( std::size_t size )
+{
+    // reporting itself is not guarded
+    guarded = false;
+
+    violations++;
+
+    fprintf( stderr, "[ERROR] Heap allocation of %u bytes in guarded thread. Call stack:\n",
+             (unsigned int)size );
+
+#   ifdef _LINUX_
+    void *frames[ 32 ];
+    int count = backtrace( frames, 32 );
+    backtrace_symbols_fd( frames, count, STDERR_FILENO );
+#   endif
+
+    fflush( stderr );
+
+    if ( abortOnViolation.load() ) abort();
+
+    guarded = true;
+}
+
+void* allocate( std::size_t size )
+{
+    allocs++;
+
+    if ( guarded ) reportViolation( size );
+
+    return malloc( size > 0 ? size : 1 );
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* operator new( std::size_t size )
+{
+    void *ptr = allocate( size );
+
+    if ( ptr == FDM_NULLPTR ) throw std::bad_alloc();
+
+    return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* operator new[]( std::size_t size )
+{
+    void *ptr = allocate( size );
+
+    if ( ptr == FDM_NULLPTR ) throw std::bad_alloc();
+
+    return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* operator new( std::size_t size, const std::nothrow_t & ) noexcept
+{
+    return allocate( size );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* operator new[]( std::size_t size, const std::nothrow_t & ) noexcept
+{
+    return allocate( size );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void operator delete( void *ptr ) noexcept
+{
+    free( ptr );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void operator delete[]( void *ptr ) noexcept
+{
+    free( ptr );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void operator delete( void *ptr, const std::nothrow_t & ) noexcept
+{
+    free( ptr );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void operator delete[]( void *ptr, const std::nothrow_t & ) noexcept
+{
+    free( ptr );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt64 AllocTracker::getCount()
+{
+    return allocs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt64 AllocTracker::getViolations()
+{
+    return violations;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool AllocTracker::isGuarded()
+{
+    return guarded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AllocTracker::setAbortOnViolation( bool abortOnViolation )
+{
+    ::abortOnViolation.store( abortOnViolation );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AllocTracker::setGuarded( bool guarded )
+{
+    ::guarded = guarded;
+}
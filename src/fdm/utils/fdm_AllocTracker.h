@@ -0,0 +1,88 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_ALLOCTRACKER_H
+#define FDM_ALLOCTRACKER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Heap allocations tracker class.
+ *
+ * Global operator new is replaced, so that every heap allocation made by
+ * operator new (including std::string and std::vector storage) is counted.
+ * Counters are kept per thread, so allocations of other threads do not
+ * affect each other. The replacement is linked only into programs which use
+ * this class.
+ *
+ * While the calling thread is guarded any allocation is a violation. Call
+ * stack of the violating allocation is written to the standard error output
+ * (on Linux program has to be linked with -rdynamic to get function names,
+ * otherwise addresses can be resolved with addr2line) and optionally the
+ * program is aborted, so it can be examined in a debugger.
+ *
+ * Manager guards working steps if FDM_ALLOC_TRACKING is defined.
+ */
+class FDMEXPORT AllocTracker
+{
+public:
+
+    /**
+     * @brief Returns number of heap allocations made by the calling thread.
+     * @return number of allocations
+     */
+    static UInt64 getCount();
+
+    /**
+     * @brief Returns number of violations made by the calling thread.
+     * @return number of violations
+     */
+    static UInt64 getViolations();
+
+    /** @brief Returns true if the calling thread is guarded. */
+    static bool isGuarded();
+
+    /**
+     * @brief Sets if program should be aborted on violation.
+     * @param abortOnViolation specifies if program should be aborted on violation
+     */
+    static void setAbortOnViolation( bool abortOnViolation );
+
+    /**
+     * @brief Guards or unguards the calling thread.
+     * @param guarded specifies if allocations are forbidden in the calling thread
+     */
+    static void setGuarded( bool guarded );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_ALLOCTRACKER_H
@@ -72,13 +72,6 @@ Angles::Angles()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Angles::Angles( const Angles &angl )
-{
-    set( angl._phi, angl._tht, angl._psi );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Angles::Angles( double phi, double tht, double psi )
 {
     set( phi, tht, psi );
@@ -140,15 +133,6 @@ std::string Angles::toString() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-const Angles& Angles::operator= ( const Angles &angl )
-{
-    set( angl._phi, angl._tht, angl._psi );
-
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 bool Angles::operator== ( const Angles &angl ) const
 {
     return ( ( _phi == angl._phi )
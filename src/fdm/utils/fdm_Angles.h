@@ -71,9 +71,6 @@ public:
     /** @brief Constructor. */
     Angles();
 
-    /** @brief Copy constructor. */
-    Angles( const Angles &angl );
-
     /**
      * @brief Constructor.
      * @param [rad] angle of rotation about x-axis
@@ -104,9 +101,6 @@ public:
     /** @brief Returns string represtation of the angles. */
     std::string toString() const;
 
-    /** @brief Assignment operator. */
-    const Angles& operator= ( const Angles &angl );
-
     /** @brief Equality operator. */
     bool operator== ( const Angles &angl ) const;
 
@@ -0,0 +1,178 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_Arena.h>
+
+#include <new>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    thread_local Arena *currentArena = FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const size_t Arena::_alignment        = 16;
+const size_t Arena::_defaultBlockSize = 64 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Arena* Arena::getCurrent()
+{
+    return currentArena;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Arena::setCurrent( Arena *arena )
+{
+    currentArena = arena;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Arena::Arena( size_t blockSize ) :
+    _blockSize ( blockSize > _alignment ? blockSize : _alignment ),
+    _used      ( 0 ),
+    _allocated ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Arena::~Arena()
+{
+    for ( Blocks::iterator it = _blocks.begin(); it != _blocks.end(); ++it )
+    {
+        ::operator delete( (*it).data );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* Arena::allocate( size_t size )
+{
+    size = ( size + _alignment - 1 ) & ~( _alignment - 1 );
+
+    if ( _blocks.empty() || _used + size > _blocks.back().size )
+    {
+        addBlock( size > _blockSize ? size : _blockSize );
+    }
+
+    void *ptr = _blocks.back().data + _used;
+
+    _used      += size;
+    _allocated += size;
+
+    return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Arena::clear()
+{
+    if ( !_blocks.empty() )
+    {
+        for ( Blocks::iterator it = _blocks.begin() + 1; it != _blocks.end(); ++it )
+        {
+            ::operator delete( (*it).data );
+        }
+
+        _blocks.resize( 1 );
+    }
+
+    _used      = 0;
+    _allocated = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Arena::addBlock( size_t size )
+{
+    Block block;
+
+    // ::operator new returns memory suitably aligned for any fundamental type
+    block.data = static_cast< char* >( ::operator new( size ) );
+    block.size = size;
+
+    _blocks.push_back( block );
+
+    _used = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ArenaScope::ArenaScope( Arena *arena ) :
+    _previous ( Arena::getCurrent() )
+{
+    Arena::setCurrent( arena );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ArenaScope::~ArenaScope()
+{
+    Arena::setCurrent( _previous );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void* ArenaObject::operator new( size_t size )
+{
+    // each object is preceded by a header holding pointer to the arena it
+    // was allocated from (or null pointer for heap allocated objects)
+    const size_t header = Arena::_alignment;
+
+    Arena *arena = Arena::getCurrent();
+
+    char *ptr = FDM_NULLPTR;
+
+    if ( arena )
+        ptr = static_cast< char* >( arena->allocate( header + size ) );
+    else
+        ptr = static_cast< char* >( ::operator new( header + size ) );
+
+    *reinterpret_cast< Arena** >( ptr ) = arena;
+
+    return ptr + header;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ArenaObject::operator delete( void *ptr )
+{
+    if ( ptr )
+    {
+        char *base = static_cast< char* >( ptr ) - Arena::_alignment;
+
+        // arena allocated memory is released by the arena itself
+        if ( *reinterpret_cast< Arena** >( base ) == FDM_NULLPTR )
+        {
+            ::operator delete( base );
+        }
+    }
+}
@@ -0,0 +1,184 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_ARENA_H
+#define FDM_ARENA_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Memory arena class.
+ *
+ * Arena allocates memory from a few large contiguous blocks by bumping
+ * a pointer. Memory is never freed piecemeal, all blocks are released at once
+ * when arena is cleared or destroyed, so teardown cost does not depend on
+ * the number of allocated objects.
+ *
+ * Objects derived from ArenaObject are allocated from the arena which is
+ * current for the calling thread (see ArenaScope), or from the regular heap
+ * when there is no current arena.
+ */
+class FDMEXPORT Arena
+{
+public:
+
+    static const size_t _alignment;        ///< [B] allocation alignment
+    static const size_t _defaultBlockSize; ///< [B] default block size
+
+    /**
+     * @brief Returns arena current for the calling thread.
+     * @return current arena or null pointer if there is no current arena
+     */
+    static Arena* getCurrent();
+
+    /**
+     * @brief Constructor.
+     * @param blockSize [B] block size
+     */
+    Arena( size_t blockSize = _defaultBlockSize );
+
+    /** @brief Destructor. */
+    virtual ~Arena();
+
+    /**
+     * @brief Allocates memory.
+     * @param size [B] requested size
+     * @return pointer to allocated memory aligned to _alignment
+     */
+    void* allocate( size_t size );
+
+    /**
+     * @brief Releases all memory at once.
+     * The first block is kept for reuse. Objects allocated from the arena
+     * must be destroyed before calling this function.
+     */
+    void clear();
+
+    /** @return number of blocks */
+    inline size_t getBlocksCount() const { return _blocks.size(); }
+
+    /** @return [B] allocated size */
+    inline size_t getAllocatedSize() const { return _allocated; }
+
+private:
+
+    friend class ArenaScope;
+
+    /** Memory block. */
+    struct Block
+    {
+        char  *data;                    ///< block data
+        size_t size;                    ///< [B] block size
+    };
+
+    typedef std::vector< Block > Blocks;
+
+    Blocks _blocks;                     ///< memory blocks
+
+    size_t _blockSize;                  ///< [B] block size
+    size_t _used;                       ///< [B] used size of the last block
+    size_t _allocated;                  ///< [B] allocated size
+
+    /** Using this constructor is forbidden. */
+    Arena( const Arena & ) {}
+
+    /**
+     * @brief Adds new block.
+     * @param size [B] block size
+     */
+    void addBlock( size_t size );
+
+    /**
+     * @brief Sets arena current for the calling thread.
+     * @param arena arena to be current or null pointer
+     */
+    static void setCurrent( Arena *arena );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Sets arena current for the calling thread within a scope.
+ *
+ * Previously current arena is restored when scope ends.
+ *
+ * @code
+ * {
+ *     ArenaScope scope( &arena );
+ *     object = new Object(); // Object is derived from ArenaObject
+ * }
+ * @endcode
+ */
+class FDMEXPORT ArenaScope
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param arena arena to be current within the scope
+     */
+    ArenaScope( Arena *arena );
+
+    /** @brief Destructor. */
+    ~ArenaScope();
+
+private:
+
+    Arena *_previous;                   ///< previously current arena
+
+    /** Using this constructor is forbidden. */
+    ArenaScope( const ArenaScope & ) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Arena allocated object base class.
+ *
+ * Objects of classes derived from this class are allocated from the arena
+ * current for the calling thread when created with operator new. Deleting
+ * such an object runs its destructor, but memory is released only when the
+ * arena is cleared or destroyed. Objects allocated when there is no current
+ * arena use the regular heap.
+ */
+class FDMEXPORT ArenaObject
+{
+public:
+
+    static void* operator new( size_t size );
+    static void operator delete( void *ptr );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_ARENA_H
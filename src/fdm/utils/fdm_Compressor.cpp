@@ -0,0 +1,204 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_Compressor.h>
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const UInt32 Compressor::_minMatch  = 4;
+const UInt32 Compressor::_maxOffset = 65535;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const int hashBits = 12;
+
+inline UInt32 read32( const UInt8 *ptr )
+{
+    UInt32 value;
+    memcpy( &value, ptr, sizeof( UInt32 ) );
+    return value;
+}
+
+inline UInt32 hash( UInt32 value )
+{
+    return ( value * 2654435761U ) >> ( 32 - hashBits );
+}
+
+void writeCount( UInt32 count, std::vector< char > *dst )
+{
+    while ( count >= 255 )
+    {
+        dst->push_back( (char)255 );
+        count -= 255;
+    }
+
+    dst->push_back( (char)count );
+}
+
+bool readCount( const UInt8 **src, const UInt8 *end, UInt32 *count )
+{
+    UInt8 byte = 255;
+
+    while ( byte == 255 )
+    {
+        if ( (*src) >= end ) return false;
+
+        byte = *( (*src)++ );
+        (*count) += byte;
+    }
+
+    return true;
+}
+
+void writeToken( const UInt8 *literals, UInt32 literalsCount,
+                 UInt32 offset, UInt32 matchLength,
+                 std::vector< char > *dst )
+{
+    UInt32 matchCount = matchLength > 0 ? matchLength - Compressor::_minMatch : 0;
+
+    UInt8 token = (UInt8)( ( literalsCount < 15 ? literalsCount : 15 ) << 4 )
+                | (UInt8)(   matchCount    < 15 ? matchCount    : 15 );
+
+    dst->push_back( (char)token );
+
+    if ( literalsCount >= 15 ) writeCount( literalsCount - 15, dst );
+
+    dst->insert( dst->end(), (const char*)literals, (const char*)literals + literalsCount );
+
+    if ( matchLength > 0 )
+    {
+        dst->push_back( (char)(   offset        & 0xff ) );
+        dst->push_back( (char)( ( offset >> 8 ) & 0xff ) );
+
+        if ( matchCount >= 15 ) writeCount( matchCount - 15, dst );
+    }
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Compressor::compress( const char *src, UInt32 size, std::vector< char > *dst )
+{
+    const UInt8 *data = (const UInt8*)src;
+
+    UInt32 table[ 1 << hashBits ];
+    memset( table, 0xff, sizeof( table ) );
+
+    UInt32 anchor = 0;
+    UInt32 i = 0;
+
+    while ( i + _minMatch <= size )
+    {
+        UInt32 value = read32( data + i );
+        UInt32 h = hash( value );
+        UInt32 candidate = table[ h ];
+        table[ h ] = i;
+
+        if ( candidate != 0xffffffff && i - candidate <= _maxOffset
+          && read32( data + candidate ) == value )
+        {
+            UInt32 length = _minMatch;
+
+            while ( i + length < size && data[ candidate + length ] == data[ i + length ] )
+            {
+                length++;
+            }
+
+            writeToken( data + anchor, i - anchor, i - candidate, length, dst );
+
+            i += length;
+            anchor = i;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    // last token holds remaining literals only
+    writeToken( data + anchor, size - anchor, 0, 0, dst );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Compressor::decompress( const char *src, UInt32 size, char *dst, UInt32 dstSize )
+{
+    const UInt8 *in  = (const UInt8*)src;
+    const UInt8 *end = in + size;
+
+    UInt8 *out = (UInt8*)dst;
+    UInt32 pos = 0;
+
+    while ( in < end )
+    {
+        UInt8 token = *( in++ );
+
+        UInt32 literalsCount = token >> 4;
+
+        if ( literalsCount == 15 && !readCount( &in, end, &literalsCount ) ) return false;
+
+        if ( (UInt32)( end - in ) < literalsCount ) return false;
+        if ( dstSize - pos < literalsCount ) return false;
+
+        memcpy( out + pos, in, literalsCount );
+        in  += literalsCount;
+        pos += literalsCount;
+
+        // last token
+        if ( in == end ) return pos == dstSize;
+
+        if ( end - in < 2 ) return false;
+
+        UInt32 offset = in[ 0 ] | ( in[ 1 ] << 8 );
+        in += 2;
+
+        UInt32 matchLength = token & 0x0f;
+
+        if ( matchLength == 15 && !readCount( &in, end, &matchLength ) ) return false;
+
+        matchLength += _minMatch;
+
+        if ( offset == 0 || offset > pos ) return false;
+        if ( dstSize - pos < matchLength ) return false;
+
+        // byte by byte copy since match might overlap output
+        for ( UInt32 j = 0; j < matchLength; j++ )
+        {
+            out[ pos + j ] = out[ pos + j - offset ];
+        }
+
+        pos += matchLength;
+    }
+
+    // last token is missing
+    return false;
+}
@@ -0,0 +1,77 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_COMPRESSOR_H
+#define FDM_COMPRESSOR_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Fast LZ77 class block compressor.
+ *
+ * Compressed block is a sequence of tokens. Each token consists of a single
+ * byte holding literals count (high nibble) and match length minus minimum
+ * match length (low nibble), optional count extension bytes, literals and
+ * 16-bit match offset. Nibble value of 15 is extended with following bytes,
+ * each adding up to 255. The last token holds only literals. Matches are
+ * found using a single-entry hash table, which favours speed over ratio.
+ */
+class FDMEXPORT Compressor
+{
+public:
+
+    static const UInt32 _minMatch;      ///< [B] minimum match length
+    static const UInt32 _maxOffset;     ///< [B] maximum match offset
+
+    /**
+     * @brief Compresses data block.
+     * @param src source data
+     * @param size [B] source data size
+     * @param dst output compressed data (appended)
+     */
+    static void compress( const char *src, UInt32 size, std::vector< char > *dst );
+
+    /**
+     * @brief Decompresses data block.
+     * @param src compressed data
+     * @param size [B] compressed data size
+     * @param dst output buffer
+     * @param dstSize [B] expected decompressed data size
+     * @return true on success, false if data is corrupted
+     */
+    static bool decompress( const char *src, UInt32 size, char *dst, UInt32 dstSize );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_COMPRESSOR_H
@@ -22,6 +22,7 @@
 
 #include <fdm/utils/fdm_DataNode.h>
 
+#include <cstring>
 #include <limits>
 
 #include <fdm/utils/fdm_String.h>
@@ -32,9 +33,18 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const unsigned int DataNode::_capacity = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+
 DataNode::DataNode() :
     _parent( 0 ),
-    _type( Group )
+    _type( Group ),
+    _data( 0 ),
+    _index( -1 ),
+    _storage( 0 ),
+    _count( 0 ),
+    _frozen( false )
 {
     _children.clear();
 }
@@ -62,13 +72,19 @@ DataNode::~DataNode()
     }
 
     _children.clear();
+
+    if ( _storage )
+    {
+        delete [] _storage;
+        _storage = 0;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 int DataNode::addNode( const char *path, Type type )
 {
-    if ( _type == Group )
+    if ( _type == Group && !getRoot()->_frozen )
     {
         std::string path_temp = path;
 
@@ -107,6 +123,8 @@ int DataNode::addNode( const char *path, Type type )
                     {
                         DataNode *node = createNode( pathLead.c_str(), type, this );
 
+                        if ( node == 0 ) return FDM_FAILURE;
+
                         std::pair<DataNodes::iterator,bool> result;
 
                         result = _children.insert( std::pair<std::string,DataNode*>( pathLead, node ) );
@@ -134,7 +152,7 @@ bool DataNode::getDatab() const
 {
     if ( _type == Bool )
     {
-        return _data.bData;
+        return _data->bData;
     }
 
     return std::numeric_limits< bool >::quiet_NaN();
@@ -146,7 +164,7 @@ int DataNode::getDatai() const
 {
     if ( _type == Int )
     {
-        return _data.iData;
+        return _data->iData;
     }
 
     return std::numeric_limits< int >::quiet_NaN();
@@ -158,7 +176,7 @@ long DataNode::getDatal() const
 {
     if ( _type == Long )
     {
-        return _data.lData;
+        return _data->lData;
     }
 
     return std::numeric_limits< long >::quiet_NaN();
@@ -170,7 +188,7 @@ float DataNode::getDataf() const
 {
     if ( _type == Float )
     {
-        return _data.fData;
+        return _data->fData;
     }
 
     return std::numeric_limits< float >::quiet_NaN();
@@ -182,7 +200,7 @@ double DataNode::getDatad() const
 {
     if ( _type == Double )
     {
-        return _data.dData;
+        return _data->dData;
     }
 
     return std::numeric_limits< double >::quiet_NaN();
@@ -190,6 +208,34 @@ double DataNode::getDatad() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void DataNode::freeze()
+{
+    getRoot()->_frozen = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int DataNode::getSnapshotSize() const
+{
+    return _count * sizeof( Data );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNode::getSnapshot( void *buffer ) const
+{
+    if ( _storage ) memcpy( buffer, _storage, getSnapshotSize() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNode::setSnapshot( const void *buffer )
+{
+    if ( _storage ) memcpy( _storage, buffer, getSnapshotSize() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 DataNode* DataNode::getNode( const char *path )
 {
     std::string path_temp = String::toLower( path );
@@ -236,11 +282,11 @@ double DataNode::getValue() const
     switch ( _type )
     {
         case Group:  return std::numeric_limits< double >::quiet_NaN(); break;
-        case Bool:   return (double)_data.bData; break;
-        case Int:    return (double)_data.iData; break;
-        case Long:   return (double)_data.lData; break;
-        case Float:  return (double)_data.fData; break;
-        case Double: return (double)_data.dData; break;
+        case Bool:   return (double)_data->bData; break;
+        case Int:    return (double)_data->iData; break;
+        case Long:   return (double)_data->lData; break;
+        case Float:  return (double)_data->fData; break;
+        case Double: return (double)_data->dData; break;
     }
 
     return std::numeric_limits< double >::quiet_NaN();
@@ -252,7 +298,7 @@ int DataNode::setDatab( bool value )
 {
     if ( _type == Bool )
     {
-        _data.bData = value;
+        _data->bData = value;
         return FDM_SUCCESS;
     }
 
@@ -265,7 +311,7 @@ int DataNode::setDatai( int value )
 {
     if ( _type == Int )
     {
-        _data.iData = value;
+        _data->iData = value;
         return FDM_SUCCESS;
     }
 
@@ -278,7 +324,7 @@ int DataNode::setDatal( long value )
 {
     if ( _type == Long )
     {
-        _data.lData = value;
+        _data->lData = value;
         return FDM_SUCCESS;
     }
 
@@ -291,7 +337,7 @@ int DataNode::setDataf( float value )
 {
     if ( _type == Float )
     {
-        _data.fData = value;
+        _data->fData = value;
         return FDM_SUCCESS;
     }
 
@@ -304,7 +350,7 @@ int DataNode::setDatad( double value )
 {
     if ( _type == Double )
     {
-        _data.dData = value;
+        _data->dData = value;
         return FDM_SUCCESS;
     }
 
@@ -317,11 +363,11 @@ int DataNode::setValue( double value )
 {
     switch ( _type )
     {
-        case Bool:   _data.bData = value != 0.0;  return FDM_SUCCESS; break;
-        case Int:    _data.iData = (int)   value; return FDM_SUCCESS; break;
-        case Long:   _data.lData = (long)  value; return FDM_SUCCESS; break;
-        case Float:  _data.fData = (float) value; return FDM_SUCCESS; break;
-        case Double: _data.dData =         value; return FDM_SUCCESS; break;
+        case Bool:   _data->bData = value != 0.0;  return FDM_SUCCESS; break;
+        case Int:    _data->iData = (int)   value; return FDM_SUCCESS; break;
+        case Long:   _data->lData = (long)  value; return FDM_SUCCESS; break;
+        case Float:  _data->fData = (float) value; return FDM_SUCCESS; break;
+        case Double: _data->dData =         value; return FDM_SUCCESS; break;
 
         default: return FDM_FAILURE; break;
     }
@@ -357,8 +403,31 @@ DataNode* DataNode::createNode( const char *name, Type type, DataNode *parent )
 {
     std::string name_temp = String::toLower( name );
 
+    Data *data = 0;
+    int index = -1;
+
+    if ( type != Group )
+    {
+        DataNode *root = parent->getRoot();
+
+        if ( root->_storage == 0 )
+        {
+            root->_storage = new Data [ _capacity ];
+        }
+
+        if ( root->_count >= _capacity ) return 0;
+
+        index = root->_count;
+        data = &( root->_storage[ index ] );
+
+        root->_count++;
+    }
+
     DataNode *node = new DataNode();
 
+    node->_data  = data;
+    node->_index = index;
+
     node->_parent = parent;
 
     node->_name = name_temp;
@@ -367,11 +436,11 @@ DataNode* DataNode::createNode( const char *name, Type type, DataNode *parent )
     switch ( node->_type )
     {
         case Group:  node->_children.clear();    break;
-        case Bool:   node->_data.bData = false;  break;
-        case Int:    node->_data.iData = 0;      break;
-        case Long:   node->_data.lData = 0L;     break;
-        case Float:  node->_data.fData = 0.0f;   break;
-        case Double: node->_data.dData = 0.0;    break;
+        case Bool:   node->_data->bData = false;  break;
+        case Int:    node->_data->iData = 0;      break;
+        case Long:   node->_data->lData = 0L;     break;
+        case Float:  node->_data->fData = 0.0f;   break;
+        case Double: node->_data->dData = 0.0;    break;
     }
 
     return node;
@@ -36,9 +36,17 @@ namespace fdm
 
 /**
  * @brief Data node class.
+ *
+ * Values of all the leaf nodes of a tree are stored in a single contiguous
+ * storage owned by the root node. Storage is allocated once with a fixed
+ * capacity, so value addresses never change and DataRef resolves them only
+ * once. After the tree is frozen its structure cannot change and the whole
+ * storage can be saved or restored as a single memory block.
  */
 class FDMEXPORT DataNode
 {
+    friend class DataRef;
+
 public:
 
     typedef std::map< std::string, DataNode* > DataNodes;
@@ -54,6 +62,8 @@ public:
         Double = 5      ///< double type
     };
 
+    static const unsigned int _capacity;    ///< tree storage capacity (number of leaf nodes)
+
     /** @brief Constructor. */
     DataNode();
 
@@ -111,6 +121,18 @@ public:
     /** @brief Returns node's root node. */
     DataNode* getRoot();
 
+    /** @return leaf node index in the tree storage or -1 for group nodes */
+    inline int getIndex() const
+    {
+        return _index;
+    }
+
+    /** @return number of leaf nodes in the tree storage (valid for root node) */
+    inline unsigned int getCount() const
+    {
+        return _count;
+    }
+
     /** @return Data node type. */
     inline Type getType() const
     {
@@ -120,6 +142,36 @@ public:
     /** */
     double getValue() const;
 
+    /** @return true if tree is frozen */
+    inline bool isFrozen() const
+    {
+        return _frozen;
+    }
+
+    /**
+     * @brief Freezes tree structure.
+     * No nodes can be added to the tree after it has been frozen.
+     * Shall be called on the root node.
+     */
+    void freeze();
+
+    /** @return [B] tree storage snapshot size (valid for root node) */
+    unsigned int getSnapshotSize() const;
+
+    /**
+     * @brief Copies all the tree values into buffer.
+     * Shall be called on the root node.
+     * @param buffer output buffer of at least getSnapshotSize() bytes
+     */
+    void getSnapshot( void *buffer ) const;
+
+    /**
+     * @brief Restores all the tree values from buffer.
+     * Shall be called on the root node.
+     * @param buffer snapshot buffer of at least getSnapshotSize() bytes
+     */
+    void setSnapshot( const void *buffer );
+
     /**
      * @return FDM_SUCCESS on success or FDM_FAILURE on failure
      */
@@ -168,7 +220,13 @@ private:
     std::string _name;      ///< data node name
 
     Type _type;             ///< type
-    Data _data;             ///< data
+    Data *_data;            ///< data (points into the tree storage)
+    int _index;             ///< index in the tree storage
+
+    Data *_storage;         ///< tree storage (root node only)
+    unsigned int _count;    ///< number of leaf nodes in the tree storage (root node only)
+
+    bool _frozen;           ///< specifies if tree is frozen (root node only)
 
     /** Using this constructor is forbidden. */
     DataNode( const DataNode & ) {}
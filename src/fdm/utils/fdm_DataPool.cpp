@@ -0,0 +1,141 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_DataPool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+typedef std::weak_ptr< const DataPool::Data > WeakDataPtr;
+typedef std::multimap< UInt64, WeakDataPtr > Blocks;
+
+const size_t pruneSizeMin = 64;  ///< minimum number of entries triggering pruning
+
+std::mutex mutex;       ///< mutex guarding pool blocks
+Blocks blocks;          ///< shared data blocks by hash
+
+size_t pruneSize = pruneSizeMin;    ///< number of entries triggering next pruning
+
+// FNV-1a hash of the block contents
+UInt64 getHash( const DataPool::Data &data )
+{
+    UInt64 hash = 14695981039346656037ULL;
+
+    const UInt8 *bytes = reinterpret_cast< const UInt8* >( data.data() );
+    const size_t size = data.size() * sizeof(double);
+
+    for ( size_t i = 0; i < size; i++ )
+    {
+        hash ^= bytes[ i ];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// blocks are compared bitwise, so NaN items doesn't prevent sharing
+bool isEqual( const DataPool::Data &data_1, const DataPool::Data &data_2 )
+{
+    return data_1.size() == data_2.size()
+        && 0 == memcmp( data_1.data(), data_2.data(), data_1.size() * sizeof(double) );
+}
+
+// removes entries of blocks no longer in use, has to be called with mutex locked
+void prune()
+{
+    Blocks::iterator it = blocks.begin();
+
+    while ( it != blocks.end() )
+    {
+        if ( it->second.expired() )
+            blocks.erase( it++ );
+        else
+            ++it;
+    }
+
+    // doubling threshold keeps pruning cost amortized constant per insertion
+    pruneSize = std::max( pruneSizeMin, 2 * blocks.size() );
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataPool::DataPtr DataPool::share( const DataPtr &data )
+{
+    if ( !data ) return data;
+
+    UInt64 hash = getHash( *data );
+
+    std::lock_guard< std::mutex > lock( mutex );
+
+    std::pair< Blocks::iterator, Blocks::iterator > range = blocks.equal_range( hash );
+
+    Blocks::iterator it = range.first;
+
+    while ( it != range.second )
+    {
+        DataPtr block = it->second.lock();
+
+        if ( block )
+        {
+            if ( isEqual( *block, *data ) ) return block;
+
+            ++it;
+        }
+        else
+        {
+            blocks.erase( it++ );
+        }
+    }
+
+    // expired entries of other hashes would otherwise pile up
+    if ( blocks.size() >= pruneSize ) prune();
+
+    blocks.insert( Blocks::value_type( hash, WeakDataPtr( data ) ) );
+
+    return data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int DataPool::getCount()
+{
+    std::lock_guard< std::mutex > lock( mutex );
+
+    prune();
+
+    return static_cast< unsigned int >( blocks.size() );
+}
@@ -0,0 +1,83 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_DATAPOOL_H
+#define FDM_DATAPOOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <memory>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+#include <fdm/utils/fdm_MemoryStats.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Pool of shared immutable data blocks.
+ *
+ * Tables data are stored in immutable reference-counted blocks. Tables read
+ * from XML files register their blocks in the pool, so all the instances of
+ * the same aircraft (and all the identical tables within one aircraft) use
+ * one copy of the data regardless of the number of simulation instances.
+ * Pool holds weak references only, block is released along with the last
+ * table using it. Pool is thread-safe.
+ *
+ * Data blocks storage is accounted as "fdm.tables" memory subsystem.
+ */
+class FDMEXPORT DataPool
+{
+public:
+
+    /** Memory accounting tag. */
+    struct MemoryTag
+    {
+        static const char* getName() { return "fdm.tables"; }
+    };
+
+    typedef std::vector< double, MemoryAllocator< double, MemoryTag > > Data;   ///< data block type
+    typedef std::shared_ptr< const Data > DataPtr;   ///< data block pointer type
+
+    /**
+     * @brief Returns shared data block identical to the given one.
+     * If there is no such block in the pool the given one is registered.
+     * @param data data block
+     * @return shared data block
+     */
+    static DataPtr share( const DataPtr &data );
+
+    /**
+     * @brief Returns number of data blocks currently shared by the pool.
+     * @return number of shared data blocks
+     */
+    static unsigned int getCount();
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_DATAPOOL_H
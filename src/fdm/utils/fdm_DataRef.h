@@ -1,242 +1,337 @@
-/****************************************************************************//*
- * Copyright (C) 2021 Marek M. Cel
- *
- * Permission is hereby granted, free of charge, to any person obtaining
- * a copy of this software and associated documentation files (the "Software"),
- * to deal in the Software without restriction, including without limitation
- * the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom
- * the Software is furnished to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included
- * in all copies or substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
- * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
- * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
- * IN THE SOFTWARE.
- ******************************************************************************/
-#ifndef DataRef_H
-#define DataRef_H
-
-////////////////////////////////////////////////////////////////////////////////
-
-#include <limits>
-
-#include <fdm/utils/fdm_DataNode.h>
-
-////////////////////////////////////////////////////////////////////////////////
-
-namespace fdm
-{
-
-/**
- * @brief Data reference class.
- */
-class FDMEXPORT DataRef
-{
-public:
-
-    /** @brief Constructor. */
-    DataRef( DataNode *dataNode = 0 ) : _dataNode( dataNode ) {}
-
-    /** @brief Copy constructor. */
-    DataRef( const DataRef &dataRef )
-    {
-        _dataNode = dataRef._dataNode;
-    }
-
-    /** @brief Destructor. */
-    virtual ~DataRef() {}
-
-    /**
-     * @return returns data value on success or NaN on failure
-     */
-    inline bool getDatab( bool def = false ) const
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->getDatab();
-        }
-
-        return def;
-    }
-
-    /**
-     * @return returns data value on success or NaN on failure
-     */
-    inline int getDatai( int def = std::numeric_limits< int >::quiet_NaN() ) const
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->getDatai();
-        }
-
-        return def;
-    }
-
-    /**
-     * @return returns data value on success or NaN on failure
-     */
-    inline long getDatal( long def = std::numeric_limits< long >::quiet_NaN() ) const
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->getDatal();
-        }
-
-        return def;
-    }
-
-    /**
-     * @return returns data value on success or NaN on failure
-     */
-    inline float getDataf( float def = std::numeric_limits< float >::quiet_NaN() ) const
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->getDataf();
-        }
-
-        return def;
-    }
-
-    /**
-     * @return returns data value on success or NaN on failure
-     */
-    inline double getDatad( double def = std::numeric_limits< double >::quiet_NaN() ) const
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->getDatad();
-        }
-
-        return def;
-    }
-
-    /**
-     * @return data value on success or NaN on failure
-     */
-    inline double getValue( double def = std::numeric_limits< double >::quiet_NaN() ) const
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->getValue();
-        }
-
-        return def;
-    }
-
-    /**
-     * @return TRUE if refference is valid, FALSE otherwise
-     */
-    inline bool isValid() const
-    {
-        return ( _dataNode != 0 );
-    }
-
-    /**
-     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
-     */
-    inline int setDatab( bool value )
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->setDatab( value );
-        }
-
-        return FDM_FAILURE;
-    }
-
-    /**
-     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
-     */
-    inline int setDatai( int value )
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->setDatai( value );
-        }
-
-        return FDM_FAILURE;
-    }
-
-    /**
-     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
-     */
-    inline int setDatal( long value )
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->setDatal( value );
-        }
-
-        return FDM_FAILURE;
-    }
-
-    /**
-     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
-     */
-    inline int setDataf( float value )
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->setDataf( value );
-        }
-
-        return FDM_FAILURE;
-    }
-
-    /**
-     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
-     */
-    inline int setDatad( double value )
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->setDatad( value );
-        }
-
-        return FDM_FAILURE;
-    }
-
-    /**
-     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
-     */
-    inline int setValue( double value )
-    {
-        if ( _dataNode )
-        {
-            return _dataNode->setValue( value );
-        }
-
-        return FDM_FAILURE;
-    }
-
-    /**
-     * @brief Resets data reference.
-     */
-    inline void reset() { _dataNode = 0; }
-
-    /**
-     * @brief Assignment operator.
-     */
-    const DataRef& operator= ( const DataRef &dataRef )
-    {
-        _dataNode = dataRef._dataNode;
-        return (*this);
-    }
-
-private:
-
-    DataNode *_dataNode;    ///< data node pointer
-};
-
-} // end of fdm namespace
-
-////////////////////////////////////////////////////////////////////////////////
-
-#endif // DataRef_H
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef DataRef_H
+#define DataRef_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <limits>
+
+#include <fdm/utils/fdm_DataNode.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Data reference class.
+ *
+ * Data reference resolves data node value address and type once, when it
+ * is created, so getting and setting value of the matching type is a single
+ * load or store in the tree storage.
+ */
+class FDMEXPORT DataRef
+{
+public:
+
+    /** @brief Constructor. */
+    DataRef( DataNode *dataNode = 0 ) :
+        _dataNode ( dataNode ),
+        _data ( dataNode ? dataNode->_data : 0 ),
+        _type ( dataNode ? dataNode->_type : DataNode::Group )
+    {}
+
+    /** @brief Copy constructor. */
+    DataRef( const DataRef &dataRef ) :
+        _dataNode ( dataRef._dataNode ),
+        _data ( dataRef._data ),
+        _type ( dataRef._type )
+    {}
+
+    /** @brief Destructor. */
+    virtual ~DataRef() {}
+
+    /**
+     * @return returns data value on success or NaN on failure
+     */
+    inline bool getDatab( bool def = false ) const
+    {
+        if ( _type == DataNode::Bool )
+        {
+            return _data->bData;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->getDatab();
+        }
+
+        return def;
+    }
+
+    /**
+     * @return returns data value on success or NaN on failure
+     */
+    inline int getDatai( int def = std::numeric_limits< int >::quiet_NaN() ) const
+    {
+        if ( _type == DataNode::Int )
+        {
+            return _data->iData;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->getDatai();
+        }
+
+        return def;
+    }
+
+    /**
+     * @return returns data value on success or NaN on failure
+     */
+    inline long getDatal( long def = std::numeric_limits< long >::quiet_NaN() ) const
+    {
+        if ( _type == DataNode::Long )
+        {
+            return _data->lData;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->getDatal();
+        }
+
+        return def;
+    }
+
+    /**
+     * @return returns data value on success or NaN on failure
+     */
+    inline float getDataf( float def = std::numeric_limits< float >::quiet_NaN() ) const
+    {
+        if ( _type == DataNode::Float )
+        {
+            return _data->fData;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->getDataf();
+        }
+
+        return def;
+    }
+
+    /**
+     * @return returns data value on success or NaN on failure
+     */
+    inline double getDatad( double def = std::numeric_limits< double >::quiet_NaN() ) const
+    {
+        if ( _type == DataNode::Double )
+        {
+            return _data->dData;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->getDatad();
+        }
+
+        return def;
+    }
+
+    /**
+     * @return data value on success or NaN on failure
+     */
+    inline double getValue( double def = std::numeric_limits< double >::quiet_NaN() ) const
+    {
+        switch ( _type )
+        {
+            case DataNode::Bool:   return (double)_data->bData;
+            case DataNode::Int:    return (double)_data->iData;
+            case DataNode::Long:   return (double)_data->lData;
+            case DataNode::Float:  return (double)_data->fData;
+            case DataNode::Double: return _data->dData;
+
+            default: break;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->getValue();
+        }
+
+        return def;
+    }
+
+    /**
+     * @return TRUE if refference is valid, FALSE otherwise
+     */
+    inline bool isValid() const
+    {
+        return ( _dataNode != 0 );
+    }
+
+    /**
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    inline int setDatab( bool value )
+    {
+        if ( _type == DataNode::Bool )
+        {
+            _data->bData = value;
+            return FDM_SUCCESS;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->setDatab( value );
+        }
+
+        return FDM_FAILURE;
+    }
+
+    /**
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    inline int setDatai( int value )
+    {
+        if ( _type == DataNode::Int )
+        {
+            _data->iData = value;
+            return FDM_SUCCESS;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->setDatai( value );
+        }
+
+        return FDM_FAILURE;
+    }
+
+    /**
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    inline int setDatal( long value )
+    {
+        if ( _type == DataNode::Long )
+        {
+            _data->lData = value;
+            return FDM_SUCCESS;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->setDatal( value );
+        }
+
+        return FDM_FAILURE;
+    }
+
+    /**
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    inline int setDataf( float value )
+    {
+        if ( _type == DataNode::Float )
+        {
+            _data->fData = value;
+            return FDM_SUCCESS;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->setDataf( value );
+        }
+
+        return FDM_FAILURE;
+    }
+
+    /**
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    inline int setDatad( double value )
+    {
+        if ( _type == DataNode::Double )
+        {
+            _data->dData = value;
+            return FDM_SUCCESS;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->setDatad( value );
+        }
+
+        return FDM_FAILURE;
+    }
+
+    /**
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    inline int setValue( double value )
+    {
+        switch ( _type )
+        {
+            case DataNode::Bool:   _data->bData = value != 0.0;  return FDM_SUCCESS;
+            case DataNode::Int:    _data->iData = (int)   value; return FDM_SUCCESS;
+            case DataNode::Long:   _data->lData = (long)  value; return FDM_SUCCESS;
+            case DataNode::Float:  _data->fData = (float) value; return FDM_SUCCESS;
+            case DataNode::Double: _data->dData =         value; return FDM_SUCCESS;
+
+            default: break;
+        }
+
+        if ( _dataNode )
+        {
+            return _dataNode->setValue( value );
+        }
+
+        return FDM_FAILURE;
+    }
+
+    /**
+     * @brief Resets data reference.
+     */
+    inline void reset()
+    {
+        _dataNode = 0;
+        _data = 0;
+        _type = DataNode::Group;
+    }
+
+    /**
+     * @brief Assignment operator.
+     */
+    const DataRef& operator= ( const DataRef &dataRef )
+    {
+        _dataNode = dataRef._dataNode;
+        _data = dataRef._data;
+        _type = dataRef._type;
+        return (*this);
+    }
+
+private:
+
+    DataNode *_dataNode;        ///< data node pointer
+    DataNode::Data *_data;      ///< data node value
+    DataNode::Type _type;       ///< data node type
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // DataRef_H
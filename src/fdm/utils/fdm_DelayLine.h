@@ -0,0 +1,138 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_DELAYLINE_H
+#define FDM_DELAYLINE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_Defines.h>
+
+#include <fdm/utils/fdm_StateArchive.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Fixed-capacity history of uniformly sampled values template class.
+ *
+ * New sample overwrites the oldest one when history is full. Value delayed
+ * by a given (fractional) number of samples is linearly interpolated between
+ * two adjacent samples, so lookups are O(1) and no allocations are made
+ * at all.
+ *
+ * @tparam SIZE maximum number of samples
+ */
+template < unsigned int SIZE >
+class DelayLine
+{
+public:
+
+    /** @brief Constructor. */
+    DelayLine() :
+        _head ( 0 ),
+        _count ( 0 )
+    {
+        for ( unsigned int i = 0; i < SIZE; i++ ) _data[ i ] = 0.0;
+    }
+
+    /**
+     * @brief Pushes new sample.
+     * @param value sample value
+     */
+    inline void push( double value )
+    {
+        _head = ( _head + 1 ) % SIZE;
+        _data[ _head ] = value;
+
+        if ( _count < SIZE ) _count++;
+    }
+
+    /** @brief Removes all samples. */
+    inline void reset()
+    {
+        _count = 0;
+    }
+
+    /**
+     * @brief Returns sample.
+     * @param index sample index, 0 is the newest one
+     * @return sample value, index is not checked
+     */
+    inline double get( unsigned int index ) const
+    {
+        return _data[ ( _head + SIZE - index ) % SIZE ];
+    }
+
+    /**
+     * @brief Returns value delayed by given number of samples.
+     * Delay is clamped to the available history.
+     * @param delay [-] number of samples (fractional), 0 is the newest sample
+     * @return delayed value, 0.0 if history is empty
+     */
+    inline double getValue( double delay ) const
+    {
+        if ( _count == 0 ) return 0.0;
+
+        double d_max = (double)( _count - 1 );
+        double d = delay < 0.0 ? 0.0 : ( delay > d_max ? d_max : delay );
+
+        unsigned int i = (unsigned int)d;
+        unsigned int j = i + 1 < _count ? i + 1 : i;
+
+        double f = d - (double)i;
+
+        return ( 1.0 - f ) * get( i ) + f * get( j );
+    }
+
+    /** @return number of samples */
+    inline unsigned int getCount() const { return _count; }
+
+    /** @return maximum number of samples */
+    inline unsigned int getSize() const { return SIZE; }
+
+    /**
+     * @brief Archives samples.
+     * @param archive state archive
+     */
+    inline void archiveState( StateArchive *archive )
+    {
+        archive->add( _data, SIZE );
+
+        archive->add( &_head );
+        archive->add( &_count );
+    }
+
+private:
+
+    double _data[ SIZE ];       ///< samples
+
+    unsigned int _head;         ///< newest sample index
+    unsigned int _count;        ///< number of samples
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_DELAYLINE_H
@@ -0,0 +1,333 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_DORMANDPRINCE45_H
+#define FDM_DORMANDPRINCE45_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <fdm/fdm_Exception.h>
+
+#include <fdm/utils/fdm_Integrator.h>
+#include <fdm/utils/fdm_Misc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Dormand-Prince 5(4) adaptive step size numerical integration template class.
+ *
+ * Integration step is divided into as many sub-steps as required to keep
+ * local truncation error estimate below given tolerance. Sub-step size is
+ * kept between calls, so in benign conditions whole step is done at once.
+ * Last stage derivative of an accepted sub-step is reused as the first stage
+ * of the next sub-step (FSAL - First Same As Last). When the maximum number
+ * of sub-steps is reached, the last sub-step covers the rest of the step
+ * regardless of the error estimate, so the step is never truncated.
+ * Non-finite error estimate (NaN or infinite state or derivatives) throws
+ * an exception.
+ *
+ * @see Dormand J., Prince P.: A family of embedded Runge-Kutta formulae, 1980
+ * @see Press W., et al.: Numerical Recipes: The Art of Scientific Computing, 2007, p.911
+ * @see https://en.wikipedia.org/wiki/Dormand%E2%80%93Prince_method
+ */
+template < class TYPE, class VECTOR = VectorN >
+class DormandPrince45 : public Integrator< TYPE, VECTOR >
+{
+public:
+
+    /** @brief Constructor. */
+    DormandPrince45( TYPE *obj = FDM_NULLPTR, void (TYPE::*fun)(const VECTOR &, VECTOR *) = FDM_NULLPTR ) :
+        Integrator< TYPE, VECTOR > ( obj, fun ),
+        _tolerance ( 1.0e-6 ),
+        _step_min ( 1.0e-5 ),
+        _step_next ( 0.0 ),
+        _steps_max ( 100 ),
+        _evaluations ( 0 )
+    {}
+
+    /** @brief Destructor. */
+    virtual ~DormandPrince45() {}
+
+    /**
+     * @brief Integrates given vector using Dormand-Prince 5(4) integration algorithm.
+     * @param step integration time step [s]
+     * @param vect integrating vector
+     */
+    void integrate( double step, VECTOR *vect )
+    {
+        const unsigned int size = vect->getSize();
+
+        // assignment reallocates VectorN only if size changes
+        _xt = (*vect);
+        _x5 = (*vect);
+
+        _k1 = (*vect);
+        _k2 = (*vect);
+        _k3 = (*vect);
+        _k4 = (*vect);
+        _k5 = (*vect);
+        _k6 = (*vect);
+        _k7 = (*vect);
+
+        _k1.zeroize();
+
+        _evaluations = 0;
+
+        double h = ( _step_next > 0.0 && _step_next < step ) ? _step_next : step;
+        double t = 0.0;
+
+        unsigned int steps = 0;
+
+        // k1 - derivatives calculation
+        this->fun( (*vect), &_k1 );
+        _evaluations++;
+
+        while ( step - t > 1.0e-12 )
+        {
+            // the last allowed sub-step finishes the step
+            bool last = steps + 1 >= _steps_max;
+
+            double h_try = ( t + h > step || last ) ? step - t : h;
+
+            _k2.zeroize();
+            _k3.zeroize();
+            _k4.zeroize();
+            _k5.zeroize();
+            _k6.zeroize();
+            _k7.zeroize();
+
+            // k2 - derivatives calculation
+            for ( unsigned int i = 0; i < size; i++ )
+            {
+                _xt( i ) = (*vect)( i ) + h_try * ( _a21 * _k1( i ) );
+            }
+
+            this->fun( _xt, &_k2 );
+
+            // k3 - derivatives calculation
+            for ( unsigned int i = 0; i < size; i++ )
+            {
+                _xt( i ) = (*vect)( i ) + h_try * ( _a31 * _k1( i ) + _a32 * _k2( i ) );
+            }
+
+            this->fun( _xt, &_k3 );
+
+            // k4 - derivatives calculation
+            for ( unsigned int i = 0; i < size; i++ )
+            {
+                _xt( i ) = (*vect)( i ) + h_try * ( _a41 * _k1( i ) + _a42 * _k2( i )
+                                                  + _a43 * _k3( i ) );
+            }
+
+            this->fun( _xt, &_k4 );
+
+            // k5 - derivatives calculation
+            for ( unsigned int i = 0; i < size; i++ )
+            {
+                _xt( i ) = (*vect)( i ) + h_try * ( _a51 * _k1( i ) + _a52 * _k2( i )
+                                                  + _a53 * _k3( i ) + _a54 * _k4( i ) );
+            }
+
+            this->fun( _xt, &_k5 );
+
+            // k6 - derivatives calculation
+            for ( unsigned int i = 0; i < size; i++ )
+            {
+                _xt( i ) = (*vect)( i ) + h_try * ( _a61 * _k1( i ) + _a62 * _k2( i )
+                                                  + _a63 * _k3( i ) + _a64 * _k4( i )
+                                                  + _a65 * _k5( i ) );
+            }
+
+            this->fun( _xt, &_k6 );
+
+            // 5th order solution
+            for ( unsigned int i = 0; i < size; i++ )
+            {
+                _x5( i ) = (*vect)( i ) + h_try * ( _b1 * _k1( i ) + _b3 * _k3( i )
+                                                  + _b4 * _k4( i ) + _b5 * _k5( i )
+                                                  + _b6 * _k6( i ) );
+            }
+
+            // k7 - derivatives calculation
+            this->fun( _x5, &_k7 );
+
+            _evaluations += 6;
+
+            // error estimate
+            double error = 0.0;
+
+            for ( unsigned int i = 0; i < size; i++ )
+            {
+                double delta = h_try * ( _e1 * _k1( i ) + _e3 * _k3( i )
+                                       + _e4 * _k4( i ) + _e5 * _k5( i )
+                                       + _e6 * _k6( i ) + _e7 * _k7( i ) );
+
+                double scale = _tolerance * ( 1.0 + std::max( fabs( (*vect)( i ) ), fabs( _x5( i ) ) ) );
+                double ratio = delta / scale;
+
+                error += ratio * ratio;
+            }
+
+            error = sqrt( error / static_cast< double >( size ) );
+
+            if ( !Misc::isValid( error ) )
+            {
+                Exception e;
+
+                e.setType( Exception::UnexpectedNaN );
+                e.setInfo( "Integration error estimate is not a finite number." );
+
+                FDM_THROW( e );
+            }
+
+            double factor = ( error > 0.0 ) ? 0.9 * pow( error, -0.2 ) : 5.0;
+
+            if ( factor < 0.2 ) factor = 0.2;
+            if ( factor > 5.0 ) factor = 5.0;
+
+            double h_new = h_try * factor;
+
+            if ( error <= 1.0 || h_try <= _step_min || last )
+            {
+                (*vect) = _x5;
+                _k1 = _k7;
+
+                t += h_try;
+                steps++;
+
+                // sub-step shortened to reach the end of the step is not
+                // used to reduce predicted sub-step size
+                if ( h_try < h ) h_new = std::max( h_new, h );
+            }
+
+            h = std::max( h_new, _step_min );
+        }
+
+        _step_next = h;
+    }
+
+    /** @return number of derivative evaluations during last integration step */
+    inline unsigned int getEvaluations() const { return _evaluations; }
+
+    /** @brief Sets error tolerance [-] */
+    inline void setTolerance( double tolerance ) { _tolerance = tolerance; }
+
+    /** @brief Sets minimum sub-step size [s] */
+    inline void setStepMin( double step_min ) { _step_min = step_min; }
+
+    /** @brief Sets maximum number of sub-steps. */
+    inline void setStepsMax( unsigned int steps_max ) { _steps_max = steps_max; }
+
+private:
+
+    static const double _a21;   ///< Butcher tableau coefficient
+    static const double _a31;   ///< Butcher tableau coefficient
+    static const double _a32;   ///< Butcher tableau coefficient
+    static const double _a41;   ///< Butcher tableau coefficient
+    static const double _a42;   ///< Butcher tableau coefficient
+    static const double _a43;   ///< Butcher tableau coefficient
+    static const double _a51;   ///< Butcher tableau coefficient
+    static const double _a52;   ///< Butcher tableau coefficient
+    static const double _a53;   ///< Butcher tableau coefficient
+    static const double _a54;   ///< Butcher tableau coefficient
+    static const double _a61;   ///< Butcher tableau coefficient
+    static const double _a62;   ///< Butcher tableau coefficient
+    static const double _a63;   ///< Butcher tableau coefficient
+    static const double _a64;   ///< Butcher tableau coefficient
+    static const double _a65;   ///< Butcher tableau coefficient
+
+    static const double _b1;    ///< 5th order solution weight
+    static const double _b3;    ///< 5th order solution weight
+    static const double _b4;    ///< 5th order solution weight
+    static const double _b5;    ///< 5th order solution weight
+    static const double _b6;    ///< 5th order solution weight
+
+    static const double _e1;    ///< error estimate weight (5th minus 4th order)
+    static const double _e3;    ///< error estimate weight (5th minus 4th order)
+    static const double _e4;    ///< error estimate weight (5th minus 4th order)
+    static const double _e5;    ///< error estimate weight (5th minus 4th order)
+    static const double _e6;    ///< error estimate weight (5th minus 4th order)
+    static const double _e7;    ///< error estimate weight (5th minus 4th order)
+
+    VECTOR _k1;         ///< auxiliary vector
+    VECTOR _k2;         ///< auxiliary vector
+    VECTOR _k3;         ///< auxiliary vector
+    VECTOR _k4;         ///< auxiliary vector
+    VECTOR _k5;         ///< auxiliary vector
+    VECTOR _k6;         ///< auxiliary vector
+    VECTOR _k7;         ///< auxiliary vector
+
+    VECTOR _xt;         ///< auxiliary vector
+    VECTOR _x5;         ///< auxiliary vector (5th order solution)
+
+    double _tolerance;          ///< [-] error tolerance
+    double _step_min;           ///< [s] minimum sub-step size
+    double _step_next;          ///< [s] predicted next sub-step size
+
+    unsigned int _steps_max;    ///< maximum number of sub-steps
+    unsigned int _evaluations;  ///< number of derivative evaluations during last step
+
+    /** Using this constructor is forbidden. */
+    DormandPrince45( const DormandPrince45 & ) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a21 =  1.0 / 5.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a31 =  3.0 / 40.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a32 =  9.0 / 40.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a41 =  44.0 / 45.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a42 = -56.0 / 15.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a43 =  32.0 / 9.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a51 =  19372.0 / 6561.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a52 = -25360.0 / 2187.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a53 =  64448.0 / 6561.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a54 = -212.0 / 729.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a61 =  9017.0 / 3168.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a62 = -355.0 / 33.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a63 =  46732.0 / 5247.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a64 =  49.0 / 176.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_a65 = -5103.0 / 18656.0;
+
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_b1 =  35.0 / 384.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_b3 =  500.0 / 1113.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_b4 =  125.0 / 192.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_b5 = -2187.0 / 6784.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_b6 =  11.0 / 84.0;
+
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_e1 =  71.0 / 57600.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_e3 = -71.0 / 16695.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_e4 =  71.0 / 1920.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_e5 = -17253.0 / 339200.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_e6 =  22.0 / 525.0;
+template < class TYPE, class VECTOR > const double DormandPrince45< TYPE, VECTOR >::_e7 = -1.0 / 40.0;
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_DORMANDPRINCE45_H
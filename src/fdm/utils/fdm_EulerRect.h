@@ -41,14 +41,14 @@ namespace fdm
  * @see Matulewski J., et. al.: Grafika fizyka metody numeryczne, 2010, p.309. [in Polish]
  * @see https://en.wikipedia.org/wiki/Euler_method
  */
-template < class TYPE >
-class EulerRect : public Integrator< TYPE >
+template < class TYPE, class VECTOR = VectorN >
+class EulerRect : public Integrator< TYPE, VECTOR >
 {
 public:
 
     /** @brief Constructor. */
-    EulerRect( TYPE *obj = FDM_NULLPTR, void (TYPE::*fun)(const VectorN &, VectorN *) = FDM_NULLPTR ) :
-        Integrator< TYPE > ( obj, fun )
+    EulerRect( TYPE *obj = FDM_NULLPTR, void (TYPE::*fun)(const VECTOR &, VECTOR *) = FDM_NULLPTR ) :
+        Integrator< TYPE, VECTOR > ( obj, fun )
     {}
 
     /** @brief Destructor. */
@@ -59,24 +59,30 @@ public:
      * @param step integration time step [s]
      * @param vect integrating vector
      */
-    void integrate( double step, VectorN *vect )
+    void integrate( double step, VECTOR *vect )
     {
+        const unsigned int size = vect->getSize();
+
+        // assignment reallocates VectorN only if size changes
         _xt = (*vect);
+        _k0 = (*vect);
 
-        _k0.resize( vect->getSize() );
         _k0.zeroize();
 
         // derivatives calculation
         this->fun( _xt, &_k0 );
 
         // integration
-        (*vect) = (*vect) + _k0 * step;
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            (*vect)( i ) = (*vect)( i ) + _k0( i ) * step;
+        }
     }
 
 private:
 
-    VectorN _k0;        ///< auxiliary vector
-    VectorN _xt;        ///< auxiliary vector
+    VECTOR _k0;         ///< auxiliary vector
+    VECTOR _xt;         ///< auxiliary vector
 
     /** Using this constructor is forbidden. */
     EulerRect( const EulerRect & ) {}
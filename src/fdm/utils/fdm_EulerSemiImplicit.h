@@ -0,0 +1,138 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_EULERSEMIIMPLICIT_H
+#define FDM_EULERSEMIIMPLICIT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/utils/fdm_Integrator.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Semi-implicit (symplectic) Euler's numerical integration template class.
+ *
+ * Integrated vector is divided into kinematic part (items before given
+ * index, e.g. position and attitude) and dynamic part (remaining items,
+ * e.g. velocities). Dynamic part is integrated explicitly, then kinematic
+ * part is integrated using derivatives computed for the already updated
+ * dynamic part. Kinematic derivatives function is expected to be much
+ * cheaper than the full derivatives function, so the cost is about one
+ * derivatives evaluation per step.
+ *
+ * @see Hairer E., Lubich C., Wanner G.: Geometric Numerical Integration, 2006, p.189
+ * @see https://en.wikipedia.org/wiki/Semi-implicit_Euler_method
+ */
+template < class TYPE, class VECTOR = VectorN >
+class EulerSemiImplicit : public Integrator< TYPE, VECTOR >
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param obj object pointer
+     * @param fun pointer to function which calculates vector derivative
+     * @param fun_kin pointer to function which calculates only kinematic part of vector derivative
+     * @param index_dyn index of the first item of the dynamic part
+     */
+    EulerSemiImplicit( TYPE *obj = FDM_NULLPTR,
+                       void (TYPE::*fun)(const VECTOR &, VECTOR *) = FDM_NULLPTR,
+                       void (TYPE::*fun_kin)(const VECTOR &, VECTOR *) = FDM_NULLPTR,
+                       unsigned int index_dyn = 0 ) :
+        Integrator< TYPE, VECTOR > ( obj, fun ),
+        _obj ( obj ),
+        _fun_kin ( fun_kin ),
+        _index_dyn ( index_dyn )
+    {
+        if ( _fun_kin == FDM_NULLPTR )
+        {
+            Exception e;
+
+            e.setType( Exception::NullPointer );
+            e.setInfo( "Function pointer NULL." );
+
+            FDM_THROW( e );
+        }
+    }
+
+    /** @brief Destructor. */
+    virtual ~EulerSemiImplicit() {}
+
+    /**
+     * @brief Integrates given vector using semi-implicit Euler's integration algorithm.
+     * @param step integration time step [s]
+     * @param vect integrating vector
+     */
+    void integrate( double step, VECTOR *vect )
+    {
+        const unsigned int size = vect->getSize();
+
+        // assignment reallocates VectorN only if size changes
+        _xt = (*vect);
+        _k0 = (*vect);
+
+        _k0.zeroize();
+
+        // derivatives calculation
+        this->fun( _xt, &_k0 );
+
+        // dynamic part integration
+        for ( unsigned int i = _index_dyn; i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k0( i ) * step;
+        }
+
+        // kinematic derivatives calculation due to new dynamic part
+        (_obj->*_fun_kin)( _xt, &_k0 );
+
+        // kinematic part integration
+        for ( unsigned int i = 0; i < _index_dyn && i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k0( i ) * step;
+        }
+
+        (*vect) = _xt;
+    }
+
+private:
+
+    TYPE *const _obj;           ///< object pointer
+
+    void (TYPE::*_fun_kin)(const VECTOR &, VECTOR *); ///< kinematic derivatives function pointer
+
+    const unsigned int _index_dyn;  ///< index of the first item of the dynamic part
+
+    VECTOR _k0;         ///< auxiliary vector
+    VECTOR _xt;         ///< auxiliary vector
+
+    /** Using this constructor is forbidden. */
+    EulerSemiImplicit( const EulerSemiImplicit & ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_EULERSEMIIMPLICIT_H
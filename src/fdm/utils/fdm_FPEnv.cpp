@@ -0,0 +1,69 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_FPEnv.h>
+
+#include <cfenv>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#   include <xmmintrin.h>
+#   define FDM_FPENV_MXCSR
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef FDM_FPENV_MXCSR
+// all exceptions masked (bits 7-12), round to nearest (bits 13-14 cleared),
+// flush-to-zero (bit 15) and denormals-are-zero (bit 6) disabled
+static const unsigned int mxcsr_deterministic = 0x1F80;
+static const unsigned int mxcsr_control_mask  = 0xFFC0;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FPEnv::setDeterministic()
+{
+    std::fesetround( FE_TONEAREST );
+
+#   ifdef FDM_FPENV_MXCSR
+    // status flags (bits 0-5) are preserved
+    unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr( ( mxcsr & ~mxcsr_control_mask ) | mxcsr_deterministic );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool FPEnv::isDeterministic()
+{
+    if ( std::fegetround() != FE_TONEAREST ) return false;
+
+#   ifdef FDM_FPENV_MXCSR
+    if ( ( _mm_getcsr() & mxcsr_control_mask ) != mxcsr_deterministic ) return false;
+#   endif
+
+    return true;
+}
@@ -0,0 +1,75 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_FPENV_H
+#define FDM_FPENV_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Floating-point environment class.
+ *
+ * Sets floating-point environment required for bit-exact results of replicas
+ * running lockstep (FDM_LOCKSTEP): round to nearest, all exceptions masked,
+ * denormals neither flushed to zero nor treated as zero. The environment is
+ * per thread and might be changed by third-party code (e.g. graphics drivers),
+ * so it has to be set by every thread running FDM before each step.
+ *
+ * Environment alone is not enough, replicas also have to:
+ * <ul>
+ *   <li>run the same binary (or builds made with the same compiler, flags
+ *   and math library), as e.g. sin() and exp() differ between libm versions,</li>
+ *   <li>use SSE2 scalar math (default on x86-64, -mfpmath=sse -msse2 on x86),
+ *   as x87 extended precision makes results depend on register allocation,</li>
+ *   <li>be built without -ffast-math (/fp:fast) and with contractions disabled
+ *   (-ffp-contract=off, /fp:precise), as fused multiply-add is not
+ *   bit-equal to separate multiplication and addition,</li>
+ *   <li>use fixed time step and the same random seed.</li>
+ * </ul>
+ */
+class FDMEXPORT FPEnv
+{
+public:
+
+    /**
+     * @brief Sets deterministic floating-point environment of the calling thread.
+     */
+    static void setDeterministic();
+
+    /**
+     * @brief Checks floating-point environment of the calling thread.
+     * @return true if environment is deterministic, false otherwise
+     */
+    static bool isDeterministic();
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_FPENV_H
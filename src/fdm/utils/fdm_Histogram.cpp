@@ -0,0 +1,151 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_Histogram.h>
+
+#include <cfloat>
+
+#include <fdm/utils/fdm_Misc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int Histogram::_sub_bits  = 5;
+const unsigned int Histogram::_sub_count = 1 << Histogram::_sub_bits;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Histogram::Histogram( double resolution, double maximum ) :
+    _resolution ( resolution ),
+    _limit ( 0 ),
+    _count ( 0 ),
+    _sum ( 0.0 ),
+    _min ( DBL_MAX ),
+    _max ( 0.0 )
+{
+    _limit = static_cast< UInt64 >( Misc::max( 1.0, maximum / _resolution ) );
+    _buckets.resize( getIndex( _limit ) + 1, 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Histogram::~Histogram() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Histogram::add( double value )
+{
+    value = Misc::max( 0.0, value );
+
+    double quantized = value / _resolution;
+
+    UInt64 v = ( quantized < (double)_limit ) ? static_cast< UInt64 >( quantized ) : _limit;
+
+    _buckets[ getIndex( v ) ]++;
+
+    _count++;
+    _sum += value;
+    _min = Misc::min( _min, value );
+    _max = Misc::max( _max, value );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Histogram::reset()
+{
+    for ( unsigned int i = 0; i < _buckets.size(); i++ ) _buckets[ i ] = 0;
+
+    _count = 0;
+    _sum = 0.0;
+    _min = DBL_MAX;
+    _max = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Histogram::getPercentile( double percent ) const
+{
+    double value = 0.0;
+    getPercentiles( &percent, &value, 1 );
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Histogram::getPercentiles( const double *percents, double *values,
+                                unsigned int count ) const
+{
+    unsigned int n = 0;
+
+    if ( _count > 0 )
+    {
+        UInt64 sum = 0;
+
+        for ( unsigned int i = 0; i < _buckets.size() && n < count; i++ )
+        {
+            sum += _buckets[ i ];
+
+            // several percentiles might fall into the same bucket
+            while ( n < count && 100.0 * sum >= percents[ n ] * _count )
+            {
+                // last bucket holds also values greater than maximum
+                double upper = ( i + 1 < _buckets.size() )
+                             ? ( getUpperBound( i ) + 1 ) * _resolution : _max;
+
+                values[ n ] = Misc::min( upper, _max );
+                n++;
+            }
+        }
+    }
+
+    for ( ; n < count; n++ ) values[ n ] = _max;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Histogram::getIndex( UInt64 value )
+{
+    if ( value < _sub_count ) return static_cast< unsigned int >( value );
+
+    unsigned int shift = 0;
+
+    while ( ( value >> shift ) >= 2 * _sub_count ) shift++;
+
+    unsigned int sub = static_cast< unsigned int >( value >> shift );
+
+    return ( shift + 1 ) * _sub_count + ( sub - _sub_count );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt64 Histogram::getUpperBound( unsigned int index )
+{
+    if ( index < 2 * _sub_count ) return index;
+
+    unsigned int shift = index / _sub_count - 1;
+    UInt64 sub = index % _sub_count + _sub_count;
+
+    return ( ( sub + 1 ) << shift ) - 1;
+}
@@ -0,0 +1,131 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_HISTOGRAM_H
+#define FDM_HISTOGRAM_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Log-linear histogram class.
+ *
+ * Histogram is intended for collecting latency statistics at every
+ * simulation step. Values are quantized with the given resolution and
+ * counted in buckets which are linear within every power of 2 range
+ * (as in HDR histograms), so relative error of percentiles is bounded by
+ * 1/_sub_count regardless of value magnitude. Adding value is constant
+ * time and memory is allocated only by the constructor.
+ */
+class FDMEXPORT Histogram
+{
+public:
+
+    static const unsigned int _sub_bits;    ///< number of bits of sub-bucket index
+    static const unsigned int _sub_count;   ///< number of sub-buckets within every power of 2 range
+
+    /**
+     * @brief Constructor.
+     * @param resolution smallest distinguishable value
+     * @param maximum maximum value, greater values are counted as maximum
+     */
+    Histogram( double resolution = 1.0e-7, double maximum = 10.0 );
+
+    /** @brief Destructor. */
+    virtual ~Histogram();
+
+    /**
+     * @brief Adds value.
+     * @param value value
+     */
+    void add( double value );
+
+    /** @brief Removes all values. */
+    void reset();
+
+    /**
+     * @brief Returns percentile.
+     * @param percent [%] percent of values less than or equal to the result
+     * @return percentile value (upper bound of the bucket, not greater than maximum value added)
+     */
+    double getPercentile( double percent ) const;
+
+    /**
+     * @brief Returns several percentiles at once (within a single pass).
+     * @param percents [%] ascending percents of values
+     * @param values output percentiles values
+     * @param count number of percentiles
+     */
+    void getPercentiles( const double *percents, double *values,
+                         unsigned int count ) const;
+
+    inline UInt64 getCount() const { return _count; }
+
+    inline double getMin() const { return _min; }
+    inline double getMax() const { return _max; }
+
+    /** @return mean value (due to not quantized values) */
+    inline double getMean() const
+    {
+        return _count > 0 ? ( _sum / (double)_count ) : 0.0;
+    }
+
+private:
+
+    std::vector< UInt32 > _buckets;     ///< buckets counts
+
+    const double _resolution;           ///< smallest distinguishable value
+    UInt64 _limit;                      ///< maximum quantized value
+
+    UInt64 _count;                      ///< number of values
+    double _sum;                        ///< sum of values
+    double _min;                        ///< minimum value
+    double _max;                        ///< maximum value
+
+    /**
+     * @brief Returns bucket index of the given quantized value.
+     * @param value quantized value
+     * @return bucket index
+     */
+    static unsigned int getIndex( UInt64 value );
+
+    /**
+     * @brief Returns upper bound of the bucket.
+     * @param index bucket index
+     * @return upper bound (quantized value)
+     */
+    static UInt64 getUpperBound( unsigned int index );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_HISTOGRAM_H
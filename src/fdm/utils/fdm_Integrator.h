@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_Vector.h>
 #include <fdm/utils/fdm_VectorN.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,8 +34,12 @@ namespace fdm
 
 /**
  * @brief Abstract numerical integration template class.
+ *
+ * @tparam TYPE class computing vector derivative
+ * @tparam VECTOR integrated vector type, either fdm::VectorN or fixed-size
+ * fdm::Vector, the latter avoids any heap allocations
  */
-template < class TYPE >
+template < class TYPE, class VECTOR = VectorN >
 class Integrator
 {
 public:
@@ -45,7 +50,7 @@ public:
      * @param object pointer
      * @param pointer to function which calculates vector derivative and takes current vector as first argument and resulting vector derivative as second
      */
-    Integrator( TYPE *obj = FDM_NULLPTR, void (TYPE::*fun)(const VectorN &, VectorN *) = FDM_NULLPTR ) :
+    Integrator( TYPE *obj = FDM_NULLPTR, void (TYPE::*fun)(const VECTOR &, VECTOR *) = FDM_NULLPTR ) :
         _obj ( obj ),
         _fun ( fun )
     {
@@ -70,18 +75,21 @@ public:
         }
     }
 
+    /** @brief Destructor. */
+    virtual ~Integrator() {}
+
     /**
      * @brief Integrates given vector.
      * This is interface abstract method.
      * @param step integration time step [s]
      * @param vect integrating vector
      */
-    virtual void integrate( double step, VectorN *vect ) = 0;
+    virtual void integrate( double step, VECTOR *vect ) = 0;
 
 protected:
 
     /** @brief Calls function calculating derivative of the given vector. */
-    inline void fun( const VectorN &x_0, VectorN *x_dot )
+    inline void fun( const VECTOR &x_0, VECTOR *x_dot )
     {
         (_obj->*_fun)( x_0, x_dot );
     }
@@ -90,7 +98,7 @@ private:
 
     TYPE *const _obj;           ///< object pointer
 
-    void (TYPE::*_fun)(const VectorN &, VectorN *); ///< function pointer
+    void (TYPE::*_fun)(const VECTOR &, VECTOR *); ///< function pointer
 
     /** Using this constructor is forbidden. */
     Integrator( const Integrator & ) {}
@@ -0,0 +1,131 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_MappedFile.h>
+
+#ifdef _LINUX_
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#ifdef WIN32
+#   include <windows.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile() :
+    _data ( FDM_NULLPTR ),
+    _size ( 0 )
+{
+#   ifdef WIN32
+    _file    = INVALID_HANDLE_VALUE;
+    _mapping = NULL;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool MappedFile::open( const char *file )
+{
+    close();
+
+#   ifdef _LINUX_
+    int fd = ::open( file, O_RDONLY );
+
+    if ( fd < 0 ) return false;
+
+    struct stat st;
+
+    if ( 0 == fstat( fd, &st ) && st.st_size > 0 )
+    {
+        void *data = mmap( FDM_NULLPTR, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+        if ( data != MAP_FAILED )
+        {
+            _data = (const char*)data;
+            _size = st.st_size;
+        }
+    }
+
+    // mapping stays valid after closing file descriptor
+    ::close( fd );
+#   endif
+
+#   ifdef WIN32
+    _file = CreateFileA( file, GENERIC_READ, FILE_SHARE_READ, NULL,
+                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+    if ( _file == INVALID_HANDLE_VALUE ) return false;
+
+    LARGE_INTEGER size;
+
+    if ( GetFileSizeEx( _file, &size ) && size.QuadPart > 0 )
+    {
+        _mapping = CreateFileMappingA( _file, NULL, PAGE_READONLY, 0, 0, NULL );
+
+        if ( _mapping )
+        {
+            _data = (const char*)MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, 0 );
+            _size = _data ? (size_t)size.QuadPart : 0;
+        }
+    }
+
+    if ( !_data ) close();
+#   endif
+
+    return _data != FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MappedFile::close()
+{
+#   ifdef _LINUX_
+    if ( _data ) munmap( (void*)_data, _size );
+#   endif
+
+#   ifdef WIN32
+    if ( _data ) UnmapViewOfFile( _data );
+    if ( _mapping ) CloseHandle( _mapping );
+    if ( _file != INVALID_HANDLE_VALUE ) CloseHandle( _file );
+
+    _file    = INVALID_HANDLE_VALUE;
+    _mapping = NULL;
+#   endif
+
+    _data = FDM_NULLPTR;
+    _size = 0;
+}
@@ -0,0 +1,86 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_MAPPEDFILE_H
+#define FDM_MAPPEDFILE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Read-only memory-mapped file.
+ */
+class FDMEXPORT MappedFile
+{
+public:
+
+    /** @brief Constructor. */
+    MappedFile();
+
+    /** @brief Destructor. */
+    virtual ~MappedFile();
+
+    /**
+     * @brief Maps file into memory.
+     * @param file file path
+     * @return true on success, false on failure
+     */
+    bool open( const char *file );
+
+    /** @brief Unmaps file. */
+    void close();
+
+    /** @return pointer to mapped file data or null pointer if not mapped */
+    inline const char* getData() const { return _data; }
+
+    /** @return [B] mapped file size */
+    inline size_t getSize() const { return _size; }
+
+    /** @return true if file is mapped */
+    inline bool isOpen() const { return _data != FDM_NULLPTR; }
+
+private:
+
+    const char *_data;          ///< mapped file data
+    size_t _size;               ///< [B] mapped file size
+
+#   ifdef WIN32
+    void *_file;                ///< file handle
+    void *_mapping;             ///< file mapping handle
+#   endif
+
+    /** Using this constructor is forbidden. */
+    MappedFile( const MappedFile & ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_MAPPEDFILE_H
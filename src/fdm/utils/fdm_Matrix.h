@@ -26,6 +26,7 @@
 
 #include <sstream>
 
+#include <fdm/utils/fdm_Simd.h>
 #include <fdm/utils/fdm_Vector.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +42,10 @@ namespace fdm
  * mathematical operation between matrices which sizes do not match each other
  * as they are of different types.
  *
+ * Matrices have no virtual functions and no data members other than items
+ * array, they are trivially copyable and can be stored densely and copied
+ * with memcpy.
+ *
  * @tparam ROWS matrix rows count
  * @tparam COLS matrix columns count
  */
@@ -50,10 +55,7 @@ class Matrix
 public:
 
     /** @brief Constructor. */
-    Matrix() :
-        _rows ( ROWS ),
-        _cols ( COLS ),
-        _size ( ROWS * COLS )
+    Matrix()
     {
         for ( unsigned int i = 0; i < _size; i++ )
         {
@@ -61,32 +63,23 @@ public:
         }
     }
 
-    /** @brief Copy constructor. */
-    Matrix( const Matrix< ROWS, COLS > &mtrx ) :
-        _rows ( ROWS ),
-        _cols ( COLS ),
-        _size ( ROWS * COLS )
-    {
-        setArray( mtrx._items );
-    }
-
     /** @brief Constructor. */
-    Matrix( const double items[] ) :
-        _rows ( ROWS ),
-        _cols ( COLS ),
-        _size ( ROWS * COLS )
+    Matrix( const double items[] )
     {
         setArray( items );
     }
 
+    /** @return pointer to matrix items array (row-major order) */
+    inline const double* getItems() const { return _items; }
+
     /** @return "true" if all items are valid */
-    virtual bool isValid() const
+    bool isValid() const
     {
         return Misc::isValid( _items, _size );
     }
 
     /** @brief Puts matrix items into given array. */
-    virtual void getArray( double items[] ) const
+    void getArray( double items[] ) const
     {
         for ( unsigned int i = 0; i < _size; i++ )
         {
@@ -100,7 +93,7 @@ public:
      * Throws an exception when row or column index is out of range.
      * @return matrix item of given indicies.
      */
-    virtual double getItem( unsigned int row, unsigned int col ) const
+    double getItem( unsigned int row, unsigned int col ) const
     {
         if ( ( row < _rows ) && ( col < _cols ) )
         {
@@ -120,7 +113,7 @@ public:
     }
 
     /** @brief Sets matrix items from given array. */
-    virtual void setArray( const double items[] )
+    void setArray( const double items[] )
     {
         for ( unsigned int i = 0; i < _size; i++ )
         {
@@ -133,7 +126,7 @@ public:
      * This function is bound-checked which may affect performance.
      * Throws an exception when row or column index is out of range.
      */
-    virtual void setItem( unsigned int row, unsigned int col, double value )
+    void setItem( unsigned int row, unsigned int col, double value )
     {
         if ( ( row < _rows ) && ( col < _cols ) )
         {
@@ -151,7 +144,7 @@ public:
     }
 
     /** @brief Swaps matrix rows. */
-    virtual void swapRows( unsigned int row1, unsigned int row2 )
+    void swapRows( unsigned int row1, unsigned int row2 )
     {
         if ( ( row1 < _rows ) && ( row2 < _rows ) )
         {
@@ -176,7 +169,7 @@ public:
     }
 
     /** @brief Returns string representation of the matrix. */
-    virtual std::string toString() const
+    std::string toString() const
     {
         std::stringstream ss;
 
@@ -239,14 +232,6 @@ public:
         return _items[ row * _cols + col ];
     }
 
-    /** @brief Assignment operator. */
-    const Matrix< ROWS, COLS >& operator= ( const Matrix< ROWS, COLS > &mtrx )
-    {
-        setArray( mtrx._items );
-
-        return (*this);
-    }
-
     /** @brief Addition operator. */
     Matrix< ROWS, COLS > operator+ ( const Matrix< ROWS, COLS > &mtrx ) const
     {
@@ -286,24 +271,6 @@ public:
         return result;
     }
 
-    /** @brief Multiplication operator (by vector). */
-    Vector<ROWS> operator* ( const Vector<COLS> &vect ) const
-    {
-        Vector<ROWS> result;
-
-        for ( unsigned int r = 0; r < _rows; r++ )
-        {
-            result(r) = 0.0;
-
-            for ( unsigned int c = 0; c < _cols; c++ )
-            {
-                result(r) += ( _items[ r*_cols + c ] * vect(c) );
-            }
-        }
-
-        return result;
-    }
-
     /** @brief Division operator (by scalar). */
     Matrix< ROWS, COLS > operator/ ( double value ) const
     {
@@ -382,13 +349,87 @@ public:
 
 protected:
 
-    double _items[ ROWS * COLS ];   ///< matrix items
+    static const unsigned int _rows = ROWS;         ///< number of rows
+    static const unsigned int _cols = COLS;         ///< number of columns
+    static const unsigned int _size = ROWS * COLS;  ///< matrix size
 
-    const unsigned int _rows;       ///< number of rows
-    const unsigned int _cols;       ///< number of columns
-    const unsigned int _size;       ///< matrix size
+    double _items[ ROWS * COLS ];                   ///< matrix items
 };
 
+template < unsigned int ROWS, unsigned int COLS >
+const unsigned int Matrix< ROWS, COLS >::_rows;
+
+template < unsigned int ROWS, unsigned int COLS >
+const unsigned int Matrix< ROWS, COLS >::_cols;
+
+template < unsigned int ROWS, unsigned int COLS >
+const unsigned int Matrix< ROWS, COLS >::_size;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Matrix by vector multiplication expression.
+ *
+ * Unlike other vector expressions the product is computed once on
+ * construction, as every result item depends on all the vector items.
+ * This also makes it safe to assign the product to the multiplied vector.
+ */
+template < unsigned int ROWS, unsigned int COLS >
+class MatrixVectorProduct : public VectorExpr< MatrixVectorProduct< ROWS, COLS >, ROWS >
+{
+public:
+
+    /** @brief Constructor. */
+    template < class E >
+    MatrixVectorProduct( const Matrix< ROWS, COLS > &mtrx,
+                         const VectorExpr< E, COLS > &expr )
+    {
+        const double *m = mtrx.getItems();
+
+        double v[ COLS ];
+
+        for ( unsigned int c = 0; c < COLS; c++ )
+        {
+            v[ c ] = expr.self()( c );
+        }
+
+        if ( ROWS == 3 && COLS == 3 )
+        {
+            Simd::mulMat3Vec3( m, v, _items );
+        }
+        else
+        {
+            for ( unsigned int r = 0; r < ROWS; r++ )
+            {
+                _items[ r ] = 0.0;
+
+                for ( unsigned int c = 0; c < COLS; c++ )
+                {
+                    _items[ r ] += ( m[ r*COLS + c ] * v[ c ] );
+                }
+            }
+        }
+    }
+
+    /** @brief Items accessor. */
+    inline double operator() ( unsigned int index ) const
+    {
+        return _items[ index ];
+    }
+
+private:
+
+    double _items[ ROWS ];  ///< product items
+};
+
+/** @brief Multiplication operator (by vector). */
+template < unsigned int ROWS, unsigned int COLS, class E >
+inline MatrixVectorProduct< ROWS, COLS > operator* ( const Matrix< ROWS, COLS > &mtrx,
+                                                     const VectorExpr< E, COLS > &expr )
+{
+    return MatrixVectorProduct< ROWS, COLS >( mtrx, expr );
+}
+
 } // end of fdm namespace
 
 ////////////////////////////////////////////////////////////////////////////////
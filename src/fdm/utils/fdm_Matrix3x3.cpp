@@ -22,6 +22,8 @@
 
 #include <fdm/utils/fdm_Matrix3x3.h>
 
+#include <fdm/utils/fdm_Simd.h>
+
 #ifdef _MSC_VER
 #   include <algorithm>
 #endif
@@ -42,49 +44,13 @@ Matrix3x3 Matrix3x3::identityMatrix()
 ////////////////////////////////////////////////////////////////////////////////
 
 Matrix3x3::Matrix3x3() :
-    Matrix< 3,3 >(),
-
-    _xx ( _items[ 0 ] ),
-    _xy ( _items[ 1 ] ),
-    _xz ( _items[ 2 ] ),
-    _yx ( _items[ 3 ] ),
-    _yy ( _items[ 4 ] ),
-    _yz ( _items[ 5 ] ),
-    _zx ( _items[ 6 ] ),
-    _zy ( _items[ 7 ] ),
-    _zz ( _items[ 8 ] )
-{}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Matrix3x3::Matrix3x3( const Matrix3x3 &mtrx ) :
-    Matrix< 3,3 >( mtrx ),
-
-    _xx ( _items[ 0 ] ),
-    _xy ( _items[ 1 ] ),
-    _xz ( _items[ 2 ] ),
-    _yx ( _items[ 3 ] ),
-    _yy ( _items[ 4 ] ),
-    _yz ( _items[ 5 ] ),
-    _zx ( _items[ 6 ] ),
-    _zy ( _items[ 7 ] ),
-    _zz ( _items[ 8 ] )
+    Matrix< 3,3 >()
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Matrix3x3::Matrix3x3( const double items[] ) :
-    Matrix< 3,3 >( items ),
-
-    _xx ( _items[ 0 ] ),
-    _xy ( _items[ 1 ] ),
-    _xz ( _items[ 2 ] ),
-    _yx ( _items[ 3 ] ),
-    _yy ( _items[ 4 ] ),
-    _yz ( _items[ 5 ] ),
-    _zx ( _items[ 6 ] ),
-    _zy ( _items[ 7 ] ),
-    _zz ( _items[ 8 ] )
+    Matrix< 3,3 >( items )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -92,45 +58,25 @@ Matrix3x3::Matrix3x3( const double items[] ) :
 Matrix3x3::Matrix3x3( double xx, double xy, double xz,
                       double yx, double yy, double yz,
                       double zx, double zy, double zz ) :
-    Matrix< 3,3 >(),
-
-    _xx ( _items[ 0 ] ),
-    _xy ( _items[ 1 ] ),
-    _xz ( _items[ 2 ] ),
-    _yx ( _items[ 3 ] ),
-    _yy ( _items[ 4 ] ),
-    _yz ( _items[ 5 ] ),
-    _zx ( _items[ 6 ] ),
-    _zy ( _items[ 7 ] ),
-    _zz ( _items[ 8 ] )
+    Matrix< 3,3 >()
 {
-    _xx = xx;
-    _xy = xy;
-    _xz = xz;
+    _items[ 0 ] = xx;
+    _items[ 1 ] = xy;
+    _items[ 2 ] = xz;
 
-    _yx = yx;
-    _yy = yy;
-    _yz = yz;
+    _items[ 3 ] = yx;
+    _items[ 4 ] = yy;
+    _items[ 5 ] = yz;
 
-    _zx = zx;
-    _zy = zy;
-    _zz = zz;
+    _items[ 6 ] = zx;
+    _items[ 7 ] = zy;
+    _items[ 8 ] = zz;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Matrix3x3::Matrix3x3( const Angles &angl ) :
-    Matrix< 3,3 >(),
-
-    _xx ( _items[ 0 ] ),
-    _xy ( _items[ 1 ] ),
-    _xz ( _items[ 2 ] ),
-    _yx ( _items[ 3 ] ),
-    _yy ( _items[ 4 ] ),
-    _yz ( _items[ 5 ] ),
-    _zx ( _items[ 6 ] ),
-    _zy ( _items[ 7 ] ),
-    _zz ( _items[ 8 ] )
+    Matrix< 3,3 >()
 {
     double sinPhi = sin( angl.phi() );
     double cosPhi = cos( angl.phi() );
@@ -144,33 +90,23 @@ Matrix3x3::Matrix3x3( const Angles &angl ) :
     double sinPhiSinTht = sinPhi * sinTht;
     double cosPhiSinTht = cosPhi * sinTht;
 
-    _xx =  cosTht * cosPsi;
-    _xy =  cosTht * sinPsi;
-    _xz = -sinTht;
+    xx() =  cosTht * cosPsi;
+    xy() =  cosTht * sinPsi;
+    xz() = -sinTht;
 
-    _yx = -( cosPhi * sinPsi ) + ( sinPhiSinTht * cosPsi );
-    _yy =  ( cosPhi * cosPsi ) + ( sinPhiSinTht * sinPsi );
-    _yz =  ( sinPhi * cosTht );
+    yx() = -( cosPhi * sinPsi ) + ( sinPhiSinTht * cosPsi );
+    yy() =  ( cosPhi * cosPsi ) + ( sinPhiSinTht * sinPsi );
+    yz() =  ( sinPhi * cosTht );
 
-    _zx =  ( sinPhi * sinPsi ) + ( cosPhiSinTht * cosPsi );
-    _zy = -( sinPhi * cosPsi ) + ( cosPhiSinTht * sinPsi );
-    _zz =  ( cosPhi * cosTht );
+    zx() =  ( sinPhi * sinPsi ) + ( cosPhiSinTht * cosPsi );
+    zy() = -( sinPhi * cosPsi ) + ( cosPhiSinTht * sinPsi );
+    zz() =  ( cosPhi * cosTht );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Matrix3x3::Matrix3x3( const Quaternion &qtrn ) :
-    Matrix< 3,3 >(),
-
-    _xx ( _items[ 0 ] ),
-    _xy ( _items[ 1 ] ),
-    _xz ( _items[ 2 ] ),
-    _yx ( _items[ 3 ] ),
-    _yy ( _items[ 4 ] ),
-    _yz ( _items[ 5 ] ),
-    _zx ( _items[ 6 ] ),
-    _zy ( _items[ 7 ] ),
-    _zz ( _items[ 8 ] )
+    Matrix< 3,3 >()
 {
     double e0 = qtrn.e0();
     double ex = qtrn.ex();
@@ -182,17 +118,17 @@ Matrix3x3::Matrix3x3( const Quaternion &qtrn ) :
     double ey2 = ey*ey;
     double ez2 = ez*ez;
 
-    _xx = e02 + ex2 - ey2 - ez2;
-    _xy = 2.0 * ( e0*ez + ex*ey );
-    _xz = 2.0 * ( ex*ez - e0*ey );
+    xx() = e02 + ex2 - ey2 - ez2;
+    xy() = 2.0 * ( e0*ez + ex*ey );
+    xz() = 2.0 * ( ex*ez - e0*ey );
 
-    _yx = 2.0 * ( ex*ey - e0*ez );
-    _yy = e02 - ex2 + ey2 - ez2;
-    _yz = 2.0 * ( e0*ex + ey*ez );
+    yx() = 2.0 * ( ex*ey - e0*ez );
+    yy() = e02 - ex2 + ey2 - ez2;
+    yz() = 2.0 * ( e0*ex + ey*ez );
 
-    _zx = 2.0 * ( e0*ey + ex*ez );
-    _zy = 2.0 * ( ey*ez - e0*ex );
-    _zz = e02 - ex2 - ey2 + ez2;
+    zx() = 2.0 * ( e0*ey + ex*ez );
+    zy() = 2.0 * ( ey*ez - e0*ex );
+    zz() = e02 - ex2 - ey2 + ez2;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -216,19 +152,19 @@ Angles Matrix3x3::getAngles() const
 {
     Angles result;
 
-    double sinTht = -_xz;
+    double sinTht = -xz();
     double cosTht = sqrt( 1.0 - std::min( 1.0, sinTht*sinTht ) );
 
     result.tht() = atan2( sinTht, cosTht );
 
     if ( cosTht > 0.0 )
     {
-        result.phi() = atan2( _yz,  _zz );
-        result.psi() = atan2( _xy,  _xx );
+        result.phi() = atan2( yz(),  zz() );
+        result.psi() = atan2( xy(),  xx() );
     }
     else
     {
-        result.phi() = atan2( _yx, -_zx );
+        result.phi() = atan2( yx(), -zx() );
         result.psi() = 0.0;
     }
 
@@ -246,10 +182,10 @@ Quaternion Matrix3x3::getQuaternion() const
     // traces
     double tr[ 4 ];
 
-    tr[ 0 ] = 1.0 + _xx + _yy + _zz;
-    tr[ 1 ] = 1.0 + _xx - _yy - _zz;
-    tr[ 2 ] = 1.0 - _xx + _yy - _zz;
-    tr[ 3 ] = 1.0 - _xx - _yy + _zz;
+    tr[ 0 ] = 1.0 + xx() + yy() + zz();
+    tr[ 1 ] = 1.0 + xx() - yy() - zz();
+    tr[ 2 ] = 1.0 - xx() + yy() - zz();
+    tr[ 3 ] = 1.0 - xx() - yy() + zz();
 
     int index = 0;
     for ( int i = 1; i < 4; i++ ) index = ( tr[ i ] > tr[ index ] ) ? i : index;
@@ -257,29 +193,29 @@ Quaternion Matrix3x3::getQuaternion() const
     if ( index == 0 )
     {
         result.e0() = tr[ 0 ];
-        result.ex() = _yz - _zy;
-        result.ey() = _zx - _xz;
-        result.ez() = _xy - _yx;
+        result.ex() = yz() - zy();
+        result.ey() = zx() - xz();
+        result.ez() = xy() - yx();
     }
     else if ( index == 1 )
     {
-        result.e0() = _yz - _zy;
+        result.e0() = yz() - zy();
         result.ex() = tr[ 1 ];
-        result.ey() = _xy + _yx;
-        result.ez() = _zx + _xz;
+        result.ey() = xy() + yx();
+        result.ez() = zx() + xz();
     }
     else if ( index == 2 )
     {
-        result.e0() = _zx - _xz;
-        result.ex() = _xy + _yx;
+        result.e0() = zx() - xz();
+        result.ex() = xy() + yx();
         result.ey() = tr[ 2 ];
-        result.ez() = _yz + _zy;
+        result.ez() = yz() + zy();
     }
     else
     {
-        result.e0() = _xy - _yx;
-        result.ex() = _zx + _xz;
-        result.ey() = _yz + _zy;
+        result.e0() = xy() - yx();
+        result.ex() = zx() + xz();
+        result.ey() = yz() + zy();
         result.ez() = tr[ 3 ];
     }
 
@@ -303,15 +239,6 @@ Matrix3x3 Matrix3x3::getTransposed() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-const Matrix3x3& Matrix3x3::operator= ( const Matrix3x3 &mtrx )
-{
-    setArray( mtrx._items );
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Matrix3x3 Matrix3x3::operator+ ( const Matrix3x3 &mtrx ) const
 {
     Matrix3x3 result;
@@ -358,38 +285,8 @@ Matrix3x3 Matrix3x3::operator* ( const Matrix3x3 &mtrx ) const
 {
     Matrix3x3 result;
 
-    for ( unsigned int r = 0; r < _rows; r++ )
-    {
-        for ( unsigned int c = 0; c < _cols; c++ )
-        {
-            result(r,c) = 0.0;
-
-            for ( unsigned int i = 0; i < _cols; i++ )
-            {
-                result(r,c) += ( _items[ r*_cols + i ] * mtrx(i,c) );
-            }
-        }
-    }
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3 Matrix3x3::operator* ( const Vector3 &vect ) const
-{
-    Vector3 result;
+    Simd::mulMat3Mat3( _items, mtrx._items, result._items );
 
-    for ( unsigned int r = 0; r < _rows; r++ )
-    {
-        result(r) = 0.0;
-
-        for ( unsigned int c = 0; c < _cols; c++ )
-        {
-            result(r) += ( _items[ r*_cols + c ] * vect(c) );
-        }
-    }
-    
     return result;
 }
 
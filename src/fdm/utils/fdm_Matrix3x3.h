@@ -58,9 +58,6 @@ public:
     /** @brief Constructor. */
     Matrix3x3();
 
-    /** @brief Copy constructor. */
-    Matrix3x3( const Matrix3x3 &mtrx );
-
     /** @brief Constructor. */
     Matrix3x3( const double items[] );
 
@@ -75,25 +72,25 @@ public:
     /** @brief Creates passive (alias) rotation matrix. */
     Matrix3x3( const Quaternion &qtrn );
 
-    inline double xx() const { return _xx; }
-    inline double xy() const { return _xy; }
-    inline double xz() const { return _xz; }
-    inline double yx() const { return _yx; }
-    inline double yy() const { return _yy; }
-    inline double yz() const { return _yz; }
-    inline double zx() const { return _zx; }
-    inline double zy() const { return _zy; }
-    inline double zz() const { return _zz; }
-
-    inline double& xx() { return _xx; }
-    inline double& xy() { return _xy; }
-    inline double& xz() { return _xz; }
-    inline double& yx() { return _yx; }
-    inline double& yy() { return _yy; }
-    inline double& yz() { return _yz; }
-    inline double& zx() { return _zx; }
-    inline double& zy() { return _zy; }
-    inline double& zz() { return _zz; }
+    inline double xx() const { return _items[ 0 ]; }
+    inline double xy() const { return _items[ 1 ]; }
+    inline double xz() const { return _items[ 2 ]; }
+    inline double yx() const { return _items[ 3 ]; }
+    inline double yy() const { return _items[ 4 ]; }
+    inline double yz() const { return _items[ 5 ]; }
+    inline double zx() const { return _items[ 6 ]; }
+    inline double zy() const { return _items[ 7 ]; }
+    inline double zz() const { return _items[ 8 ]; }
+
+    inline double& xx() { return _items[ 0 ]; }
+    inline double& xy() { return _items[ 1 ]; }
+    inline double& xz() { return _items[ 2 ]; }
+    inline double& yx() { return _items[ 3 ]; }
+    inline double& yy() { return _items[ 4 ]; }
+    inline double& yz() { return _items[ 5 ]; }
+    inline double& zx() { return _items[ 6 ]; }
+    inline double& zy() { return _items[ 7 ]; }
+    inline double& zz() { return _items[ 8 ]; }
 
     /** @brief Transposes matrix. */
     void transpose();
@@ -107,9 +104,6 @@ public:
     /** @brief Returns transposed matrix. */
     Matrix3x3 getTransposed() const;
 
-    /** @brief Assignment operator. */
-    const Matrix3x3& operator= ( const Matrix3x3 &mtrx );
-
     /** @brief Addition operator. */
     Matrix3x3 operator+ ( const Matrix3x3 &mtrx ) const;
 
@@ -122,9 +116,6 @@ public:
     /** @brief Multiplication operator (by matrix). */
     Matrix3x3 operator* ( const Matrix3x3 &mtrx ) const;
 
-    /** @brief Multiplication operator (by vector). */
-    Vector3 operator* ( const Vector3 &vect ) const;
-
     /** @brief Division operator (by scalar). */
     Matrix3x3 operator/ ( double value ) const;
 
@@ -139,32 +130,16 @@ public:
 
     /** @brief Unary division operator (by scalar). */
     Matrix3x3& operator/= ( double value );
-
-private:
-
-    double &_xx;    ///< xx element
-    double &_xy;    ///< xy element
-    double &_xz;    ///< xz element
-
-    double &_yx;    ///< yx element
-    double &_yy;    ///< yy element
-    double &_yz;    ///< yz element
-
-    double &_zx;    ///< zx element
-    double &_zy;    ///< zy element
-    double &_zz;    ///< zz element
 };
 
-} // end of fdm namespace
-
-////////////////////////////////////////////////////////////////////////////////
-
 /** @brief Multiplication operator (by scalar). */
-inline fdm::Matrix3x3 operator* ( double value, const fdm::Matrix3x3 &mtrx )
+inline Matrix3x3 operator* ( double value, const Matrix3x3 &mtrx )
 {
     return ( mtrx * value );
 }
 
+} // end of fdm namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // FDM_MATRIX3X3_H
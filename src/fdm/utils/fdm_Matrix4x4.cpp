@@ -34,12 +34,6 @@ Matrix4x4::Matrix4x4() :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Matrix4x4::Matrix4x4( const Matrix4x4 &mtrx ) :
-    Matrix< 4,4 >( mtrx )
-{}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Matrix4x4::Matrix4x4( const double items[] ) :
     Matrix< 4,4 >( items )
 {}
@@ -71,15 +65,6 @@ Matrix4x4 Matrix4x4::getTransposed() const
 }
 ////////////////////////////////////////////////////////////////////////////////
 
-const Matrix4x4& Matrix4x4::operator= ( const Matrix4x4 &mtrx )
-{
-    setArray( mtrx._items );
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Matrix4x4 Matrix4x4::operator+ ( const Matrix4x4 &mtrx ) const
 {
     Matrix4x4 result;
@@ -144,25 +129,6 @@ Matrix4x4 Matrix4x4::operator* ( const Matrix4x4 &mtrx ) const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Vector4 Matrix4x4::operator* ( const Vector4 &vect ) const
-{
-    Vector4 result;
-
-    for ( unsigned int r = 0; r < _rows; r++ )
-    {
-        result(r) = 0.0;
-
-        for ( unsigned int c = 0; c < _cols; c++ )
-        {
-            result(r) += ( _items[ r*_cols + c ] * vect(c) );
-        }
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Matrix4x4 Matrix4x4::operator/ ( double value ) const
 {
     Matrix4x4 result;
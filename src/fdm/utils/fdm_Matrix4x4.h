@@ -42,9 +42,6 @@ public:
     /** @brief Constructor. */
     Matrix4x4();
 
-    /** @brief Copy constructor. */
-    Matrix4x4( const Matrix4x4 &mtrx );
-
     /** @brief Constructor. */
     Matrix4x4( const double items[] );
 
@@ -54,9 +51,6 @@ public:
     /** @brief Returns transposed matrix. */
     Matrix4x4 getTransposed() const;
 
-    /** @brief Assignment operator. */
-    const Matrix4x4& operator= ( const Matrix4x4 &mtrx );
-
     /** @brief Addition operator. */
     Matrix4x4 operator+ ( const Matrix4x4 &mtrx ) const;
 
@@ -69,9 +63,6 @@ public:
     /** @brief Multiplication operator (by matrix). */
     Matrix4x4 operator* ( const Matrix4x4 &mtrx ) const;
 
-    /** @brief Multiplication operator (by vector). */
-    Vector4 operator* ( const Vector4 &vect ) const;
-
     /** @brief Division operator (by scalar). */
     Matrix4x4 operator/ ( double value ) const;
 
@@ -88,16 +79,14 @@ public:
     Matrix4x4& operator/= ( double value );
 };
 
-} // end of fdm namespace
-
-////////////////////////////////////////////////////////////////////////////////
-
 /** @brief Multiplication operator (by scalar). */
-inline fdm::Matrix4x4 operator* ( double value, const fdm::Matrix4x4 &mtrx )
+inline Matrix4x4 operator* ( double value, const Matrix4x4 &mtrx )
 {
     return ( mtrx * value );
 }
 
+} // end of fdm namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // FDM_MATRIX4X4_H
@@ -34,12 +34,6 @@ Matrix6x6::Matrix6x6() :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Matrix6x6::Matrix6x6( const Matrix6x6 &mtrx ) :
-    Matrix< 6,6 >( mtrx )
-{}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Matrix6x6::Matrix6x6( const double items[] ) :
     Matrix< 6,6 >( items )
 {}
@@ -72,15 +66,6 @@ Matrix6x6 Matrix6x6::getTransposed() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-const Matrix6x6& Matrix6x6::operator= ( const Matrix6x6 &mtrx )
-{
-    setArray( mtrx._items );
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Matrix6x6 Matrix6x6::operator+ ( const Matrix6x6 &mtrx ) const
 {
     Matrix6x6 result;
@@ -145,25 +130,6 @@ Matrix6x6 Matrix6x6::operator* ( const Matrix6x6 &mtrx ) const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Vector6 Matrix6x6::operator* ( const Vector6 &vect ) const
-{
-    Vector6 result;
-
-    for ( unsigned int r = 0; r < _rows; r++ )
-    {
-        result(r) = 0.0;
-
-        for ( unsigned int c = 0; c < _cols; c++ )
-        {
-            result(r) += ( _items[ r*_cols + c ] * vect(c) );
-        }
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Matrix6x6 Matrix6x6::operator/ ( double value ) const
 {
     Matrix6x6 result;
@@ -42,9 +42,6 @@ public:
     /** @brief Constructor. */
     Matrix6x6();
 
-    /** @brief Copy constructor. */
-    Matrix6x6( const Matrix6x6 &mtrx );
-
     /** @brief Constructor. */
     Matrix6x6( const double items[] );
 
@@ -54,9 +51,6 @@ public:
     /** @brief Returns transposed matrix. */
     Matrix6x6 getTransposed() const;
 
-    /** @brief Assignment operator. */
-    const Matrix6x6& operator= ( const Matrix6x6 &mtrx );
-
     /** @brief Addition operator. */
     Matrix6x6 operator+ ( const Matrix6x6 &mtrx ) const;
 
@@ -69,9 +63,6 @@ public:
     /** @brief Multiplication operator (by matrix). */
     Matrix6x6 operator* ( const Matrix6x6 &mtrx ) const;
 
-    /** @brief Multiplication operator (by vector). */
-    Vector6 operator* ( const Vector6 &vect ) const;
-
     /** @brief Division operator (by scalar). */
     Matrix6x6 operator/ ( double value ) const;
 
@@ -88,16 +79,14 @@ public:
     Matrix6x6& operator/= ( double value );
 };
 
-} // end of fdm namespace
-
-////////////////////////////////////////////////////////////////////////////////
-
 /** @brief Binary multiplication by scalar operator. */
-inline fdm::Matrix6x6 operator* ( double value, const fdm::Matrix6x6 &mtrx )
+inline Matrix6x6 operator* ( double value, const Matrix6x6 &mtrx )
 {
     return ( mtrx * value );
 }
 
+} // end of fdm namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // FDM_MATRIX6X6_H
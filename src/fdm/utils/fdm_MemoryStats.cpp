@@ -0,0 +1,242 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_MemoryStats.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct Subsystem
+{
+    const char *name;               ///< subsystem name
+
+    std::atomic< UInt64 > bytes;    ///< [B] currently accounted bytes
+    std::atomic< UInt64 > peak;     ///< [B] peak accounted bytes
+    std::atomic< UInt64 > budget;   ///< [B] budget, 0 if unlimited
+};
+
+struct Registry
+{
+    std::mutex mutex;
+
+    Subsystem subsystems[ MemoryStats::_max_subsystems ];
+
+    std::atomic< unsigned int > count;
+};
+
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+inline Subsystem* getSubsystem( int id )
+{
+    Registry &registry = getRegistry();
+
+    if ( id >= 0 && (unsigned int)id < registry.count.load( std::memory_order_acquire ) )
+    {
+        return &registry.subsystems[ id ];
+    }
+
+    return FDM_NULLPTR;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+int MemoryStats::add( const char *name )
+{
+    Registry &registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    unsigned int count = registry.count.load( std::memory_order_relaxed );
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        if ( 0 == strcmp( registry.subsystems[ i ].name, name ) ) return (int)i;
+    }
+
+    if ( count < _max_subsystems )
+    {
+        Subsystem &subsystem = registry.subsystems[ count ];
+
+        subsystem.name   = name;
+        subsystem.bytes  = 0;
+        subsystem.peak   = 0;
+        subsystem.budget = 0;
+
+        registry.count.store( count + 1, std::memory_order_release );
+
+        return (int)count;
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStats::allocate( int id, UInt64 bytes )
+{
+    Subsystem *subsystem = getSubsystem( id );
+
+    if ( subsystem )
+    {
+        UInt64 current = subsystem->bytes.fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+        UInt64 peak = subsystem->peak.load( std::memory_order_relaxed );
+
+        while ( current > peak
+             && !subsystem->peak.compare_exchange_weak( peak, current, std::memory_order_relaxed ) ) {}
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStats::release( int id, UInt64 bytes )
+{
+    Subsystem *subsystem = getSubsystem( id );
+
+    if ( subsystem )
+    {
+        subsystem->bytes.fetch_sub( bytes, std::memory_order_relaxed );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStats::dump( std::ostream &out )
+{
+    Values values;
+    snapshot( &values );
+
+    UInt64 total = 0;
+
+    char line[ 256 ];
+
+    snprintf( line, sizeof(line), "%-24s %12s %12s %12s", "subsystem", "KiB", "peak KiB", "budget KiB" );
+    out << line << std::endl;
+
+    for ( Values::const_iterator it = values.begin(); it != values.end(); ++it )
+    {
+        if ( (*it).budget > 0 )
+        {
+            snprintf( line, sizeof(line), "%-24s %12llu %12llu %12llu", (*it).name,
+                      (unsigned long long)( (*it).bytes  / 1024 ),
+                      (unsigned long long)( (*it).peak   / 1024 ),
+                      (unsigned long long)( (*it).budget / 1024 ) );
+        }
+        else
+        {
+            snprintf( line, sizeof(line), "%-24s %12llu %12llu %12s", (*it).name,
+                      (unsigned long long)( (*it).bytes / 1024 ),
+                      (unsigned long long)( (*it).peak  / 1024 ),
+                      "-" );
+        }
+
+        out << line << std::endl;
+
+        total += (*it).bytes;
+    }
+
+    snprintf( line, sizeof(line), "%-24s %12llu", "total", (unsigned long long)( total / 1024 ) );
+    out << line << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt64 MemoryStats::getBytes( int id )
+{
+    Subsystem *subsystem = getSubsystem( id );
+
+    return subsystem ? subsystem->bytes.load( std::memory_order_relaxed ) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt64 MemoryStats::getBudget( int id )
+{
+    Subsystem *subsystem = getSubsystem( id );
+
+    return subsystem ? subsystem->budget.load( std::memory_order_relaxed ) : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool MemoryStats::isOverBudget( int id, UInt64 extra )
+{
+    Subsystem *subsystem = getSubsystem( id );
+
+    if ( subsystem )
+    {
+        UInt64 budget = subsystem->budget.load( std::memory_order_relaxed );
+
+        return budget > 0
+            && subsystem->bytes.load( std::memory_order_relaxed ) + extra > budget;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStats::setBudget( int id, UInt64 budget )
+{
+    Subsystem *subsystem = getSubsystem( id );
+
+    if ( subsystem )
+    {
+        subsystem->budget.store( budget, std::memory_order_relaxed );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStats::snapshot( Values *values )
+{
+    Registry &registry = getRegistry();
+
+    unsigned int count = registry.count.load( std::memory_order_acquire );
+
+    values->resize( count );
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        Value &value = (*values)[ i ];
+
+        value.name   = registry.subsystems[ i ].name;
+        value.bytes  = registry.subsystems[ i ].bytes.load( std::memory_order_relaxed );
+        value.peak   = registry.subsystems[ i ].peak.load( std::memory_order_relaxed );
+        value.budget = registry.subsystems[ i ].budget.load( std::memory_order_relaxed );
+    }
+}
@@ -0,0 +1,206 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_MEMORYSTATS_H
+#define FDM_MEMORYSTATS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <new>
+#include <ostream>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Per-subsystem memory accounting class.
+ *
+ * Subsystem is registered once by name, which has to be a string literal
+ * (or otherwise outlive the registry), registering the same name again
+ * returns the same ID. Every subsystem has atomic current and peak bytes
+ * counters and optional budget, so accounting takes no locks and caches
+ * might check their budgets before inserting new items.
+ *
+ * Counters are updated either exactly, by containers using MemoryAllocator,
+ * or with estimated sizes reported by the subsystem (e.g. OSG images and
+ * arrays, OpenAL buffers).
+ *
+ * @see MemoryAllocator
+ */
+class FDMEXPORT MemoryStats
+{
+public:
+
+    static const unsigned int _max_subsystems = 32;     ///< [-] maximum number of subsystems
+
+    /** Subsystem snapshot. */
+    struct Value
+    {
+        const char *name;               ///< subsystem name
+
+        UInt64 bytes;                   ///< [B] currently accounted bytes
+        UInt64 peak;                    ///< [B] peak accounted bytes
+        UInt64 budget;                  ///< [B] budget, 0 if unlimited
+    };
+
+    typedef std::vector< Value > Values;
+
+    /**
+     * @brief Registers subsystem.
+     * @param name subsystem name
+     * @return subsystem ID or -1 if there is no room for a new subsystem
+     */
+    static int add( const char *name );
+
+    /**
+     * @brief Accounts allocated bytes.
+     * @param id subsystem ID
+     * @param bytes [B] allocated bytes
+     */
+    static void allocate( int id, UInt64 bytes );
+
+    /**
+     * @brief Accounts released bytes.
+     * @param id subsystem ID
+     * @param bytes [B] released bytes
+     */
+    static void release( int id, UInt64 bytes );
+
+    /**
+     * @brief Writes all the subsystems counters as human readable table.
+     * @param out output stream
+     */
+    static void dump( std::ostream &out );
+
+    /**
+     * @brief Returns subsystem currently accounted bytes.
+     * @param id subsystem ID
+     * @return [B] accounted bytes
+     */
+    static UInt64 getBytes( int id );
+
+    /**
+     * @brief Returns subsystem budget.
+     * @param id subsystem ID
+     * @return [B] budget, 0 if unlimited
+     */
+    static UInt64 getBudget( int id );
+
+    /**
+     * @brief Checks if subsystem exceeds its budget.
+     * @param id subsystem ID
+     * @param extra [B] bytes about to be allocated
+     * @return true if accounted bytes and extra bytes exceed budget
+     */
+    static bool isOverBudget( int id, UInt64 extra = 0 );
+
+    /**
+     * @brief Sets subsystem budget.
+     * @param id subsystem ID
+     * @param budget [B] budget, 0 means unlimited
+     */
+    static void setBudget( int id, UInt64 budget );
+
+    /**
+     * @brief Takes snapshot of all the subsystems counters.
+     * @param values output subsystems values
+     */
+    static void snapshot( Values *values );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Memory accounting standard allocator.
+ *
+ * Allocator is stateless, subsystem is given by the tag type which has to
+ * provide static getName() function returning subsystem name, so containers
+ * using it are as cheap as those using std::allocator.
+ *
+ * @see MemoryStats
+ */
+template < typename T, typename TAG >
+class MemoryAllocator
+{
+public:
+
+    typedef T value_type;
+
+    template < typename U >
+    struct rebind
+    {
+        typedef MemoryAllocator< U, TAG > other;
+    };
+
+    /** @brief Constructor. */
+    MemoryAllocator() {}
+
+    /** @brief Copy constructor. */
+    template < typename U >
+    MemoryAllocator( const MemoryAllocator< U, TAG > & ) {}
+
+    /** @brief Allocates storage for n objects. */
+    T* allocate( std::size_t n )
+    {
+        T *ptr = static_cast< T* >( ::operator new( n * sizeof(T) ) );
+        MemoryStats::allocate( getId(), n * sizeof(T) );
+        return ptr;
+    }
+
+    /** @brief Deallocates storage for n objects. */
+    void deallocate( T *ptr, std::size_t n )
+    {
+        MemoryStats::release( getId(), n * sizeof(T) );
+        ::operator delete( ptr );
+    }
+
+    /** @brief Returns subsystem ID. */
+    static int getId()
+    {
+        static const int id = MemoryStats::add( TAG::getName() );
+        return id;
+    }
+};
+
+template < typename T, typename U, typename TAG >
+inline bool operator== ( const MemoryAllocator< T, TAG > &, const MemoryAllocator< U, TAG > & )
+{
+    return true;
+}
+
+template < typename T, typename U, typename TAG >
+inline bool operator!= ( const MemoryAllocator< T, TAG > &, const MemoryAllocator< U, TAG > & )
+{
+    return false;
+}
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_MEMORYSTATS_H
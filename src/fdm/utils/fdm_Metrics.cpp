@@ -0,0 +1,295 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#include <fdm/utils/fdm_Metrics.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#include <fdm/utils/fdm_Histogram.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct Sample
+{
+    int id;                         ///< metric ID
+    double value;                   ///< [s] sample value
+};
+
+struct Buffer
+{
+    Sample samples[ Metrics::_buffer_size ];
+
+    std::atomic< UInt64 > head;     ///< number of samples pushed so far
+    std::atomic< UInt64 > tail;     ///< number of samples drained so far
+    std::atomic< UInt64 > dropped;  ///< number of samples dropped so far
+};
+
+struct Metric
+{
+    const char *name;               ///< metric name
+    Metrics::Type type;             ///< metric type
+
+    std::atomic< UInt64 > data;     ///< gauge value bits or counter sum
+
+    UInt64 reported;                ///< counter sum at the previous snapshot
+    Histogram *histogram;           ///< timer samples collected since the previous snapshot
+};
+
+/** Buffers are never freed, so samples of finished threads can be drained. */
+struct Registry
+{
+    std::mutex mutex;
+    std::vector< Buffer* > buffers;
+
+    Metric metrics[ Metrics::_max_metrics ];
+
+    std::atomic< unsigned int > count;
+
+    UInt64 dropped;                 ///< number of samples dropped at the previous snapshot
+};
+
+std::atomic< bool > enabled( false );
+
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+Buffer* getBuffer()
+{
+    static thread_local Buffer *buffer = FDM_NULLPTR;
+
+    if ( buffer == FDM_NULLPTR )
+    {
+        Registry &registry = getRegistry();
+        std::lock_guard< std::mutex > lock( registry.mutex );
+
+        buffer = new Buffer();
+        buffer->head    = 0;
+        buffer->tail    = 0;
+        buffer->dropped = 0;
+
+        registry.buffers.push_back( buffer );
+    }
+
+    return buffer;
+}
+
+inline bool isValid( int id, Metrics::Type type )
+{
+    Registry &registry = getRegistry();
+
+    return id >= 0
+        && (unsigned int)id < registry.count.load( std::memory_order_acquire )
+        && registry.metrics[ id ].type == type;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Metrics::add( const char *name, Type type )
+{
+    Registry &registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    unsigned int count = registry.count.load( std::memory_order_relaxed );
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        if ( 0 == strcmp( registry.metrics[ i ].name, name ) )
+        {
+            return registry.metrics[ i ].type == type ? (int)i : -1;
+        }
+    }
+
+    if ( count < _max_metrics )
+    {
+        Metric &metric = registry.metrics[ count ];
+
+        metric.name      = name;
+        metric.type      = type;
+        metric.data      = 0;
+        metric.reported  = 0;
+        metric.histogram = type == Timer ? new Histogram() : FDM_NULLPTR;
+
+        registry.count.store( count + 1, std::memory_order_release );
+
+        return (int)count;
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Metrics::count( int id, UInt64 increment )
+{
+    if ( isEnabled() && isValid( id, Counter ) )
+    {
+        getRegistry().metrics[ id ].data.fetch_add( increment, std::memory_order_relaxed );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Metrics::isEnabled()
+{
+    return enabled.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Metrics::set( int id, double value )
+{
+    if ( isEnabled() && isValid( id, Gauge ) )
+    {
+        UInt64 bits = 0;
+        memcpy( &bits, &value, sizeof(double) );
+
+        getRegistry().metrics[ id ].data.store( bits, std::memory_order_relaxed );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Metrics::setEnabled( bool enabled )
+{
+    ::enabled.store( enabled, std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt64 Metrics::snapshot( Values *values )
+{
+    Registry &registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    UInt64 dropped = 0;
+
+    for ( size_t i = 0; i < registry.buffers.size(); i++ )
+    {
+        Buffer *buffer = registry.buffers[ i ];
+
+        UInt64 head = buffer->head.load( std::memory_order_acquire );
+        UInt64 tail = buffer->tail.load( std::memory_order_relaxed );
+
+        for ( UInt64 j = tail; j < head; j++ )
+        {
+            const Sample &sample = buffer->samples[ j % _buffer_size ];
+            registry.metrics[ sample.id ].histogram->add( sample.value );
+        }
+
+        buffer->tail.store( head, std::memory_order_release );
+
+        dropped += buffer->dropped.load( std::memory_order_relaxed );
+    }
+
+    values->clear();
+
+    unsigned int count = registry.count.load( std::memory_order_relaxed );
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        Metric &metric = registry.metrics[ i ];
+
+        Value value;
+
+        value.name  = metric.name;
+        value.type  = metric.type;
+        value.value = 0.0;
+        value.p50   = 0.0;
+        value.p99   = 0.0;
+        value.p999  = 0.0;
+        value.max   = 0.0;
+
+        if ( metric.type == Gauge )
+        {
+            UInt64 bits = metric.data.load( std::memory_order_relaxed );
+            memcpy( &value.value, &bits, sizeof(double) );
+        }
+        else if ( metric.type == Counter )
+        {
+            UInt64 sum = metric.data.load( std::memory_order_relaxed );
+            value.value = (double)( sum - metric.reported );
+            metric.reported = sum;
+        }
+        else
+        {
+            const double percents[] = { 50.0, 99.0, 99.9 };
+            double result[ 3 ] = { 0.0 };
+
+            metric.histogram->getPercentiles( percents, result, 3 );
+
+            value.value = (double)metric.histogram->getCount();
+            value.p50   = result[ 0 ];
+            value.p99   = result[ 1 ];
+            value.p999  = result[ 2 ];
+            value.max   = metric.histogram->getCount() > 0 ? metric.histogram->getMax() : 0.0;
+
+            metric.histogram->reset();
+        }
+
+        values->push_back( value );
+    }
+
+    UInt64 result = dropped - registry.dropped;
+    registry.dropped = dropped;
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Metrics::time( int id, double value )
+{
+    if ( isEnabled() && isValid( id, Timer ) )
+    {
+        Buffer *buffer = getBuffer();
+
+        UInt64 head = buffer->head.load( std::memory_order_relaxed );
+        UInt64 tail = buffer->tail.load( std::memory_order_acquire );
+
+        if ( head - tail < _buffer_size )
+        {
+            Sample &sample = buffer->samples[ head % _buffer_size ];
+
+            sample.id    = id;
+            sample.value = value;
+
+            buffer->head.store( head + 1, std::memory_order_release );
+        }
+        else
+        {
+            buffer->dropped.fetch_add( 1, std::memory_order_relaxed );
+        }
+    }
+}
@@ -0,0 +1,188 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_METRICS_H
+#define FDM_METRICS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/utils/fdm_Time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define FDM_METRICS_CONCAT_( a, b ) a ## b
+#define FDM_METRICS_CONCAT( a, b ) FDM_METRICS_CONCAT_( a, b )
+
+#ifdef FDM_METRICS
+#   define FDM_METRICS_ADD( name, type, func, value ) \
+    do \
+    { \
+        static const int fdm_metrics_id_ = fdm::Metrics::add( name, fdm::Metrics::type ); \
+        fdm::Metrics::func( fdm_metrics_id_, value ); \
+    } \
+    while ( 0 )
+#   define FDM_METRICS_ZONE( name ) \
+    static const int FDM_METRICS_CONCAT( fdm_metrics_id_, __LINE__ ) = fdm::Metrics::add( name, fdm::Metrics::Timer ); \
+    fdm::Metrics::Zone FDM_METRICS_CONCAT( fdm_metrics_zone_, __LINE__ )( FDM_METRICS_CONCAT( fdm_metrics_id_, __LINE__ ) )
+#else
+#   define FDM_METRICS_ADD( name, type, func, value ) do {} while ( 0 )
+#   define FDM_METRICS_ZONE( name )
+#endif
+
+#define FDM_METRICS_GAUGE( name, value ) FDM_METRICS_ADD( name, Gauge   , set   , value )
+#define FDM_METRICS_COUNT( name, value ) FDM_METRICS_ADD( name, Counter , count , value )
+#define FDM_METRICS_TIME( name, value )  FDM_METRICS_ADD( name, Timer   , time  , value )
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Live metrics registry class.
+ *
+ * Metrics are gauges (last value), counters (increments) and timers (samples
+ * summarized with percentiles). Metric is registered once by name, which has
+ * to be a string literal (or otherwise outlive the registry), registering
+ * the same name again returns the same ID.
+ *
+ * Collection takes no locks: gauges and counters are atomic values, timer
+ * samples are pushed into per-thread single producer ring buffers, which
+ * are drained by the snapshot() caller (exporter thread). Only the first
+ * sample of a thread registers its buffer. Samples which do not fit into
+ * the buffer are dropped and counted.
+ *
+ * Metrics are put in the code with FDM_METRICS_GAUGE, FDM_METRICS_COUNT,
+ * FDM_METRICS_TIME and FDM_METRICS_ZONE macros, which expand to nothing
+ * unless FDM_METRICS is defined. Collection is disabled until exporter
+ * enables it, so hot threads do not fill buffers nobody drains.
+ */
+class FDMEXPORT Metrics
+{
+public:
+
+    static const unsigned int _max_metrics = 128;       ///< [-] maximum number of metrics
+    static const unsigned int _buffer_size = 8192;      ///< [-] number of timer samples per thread
+
+    /** Metric types. */
+    enum Type
+    {
+        Gauge = 0,                      ///< last value
+        Counter,                        ///< sum of increments
+        Timer                           ///< samples percentiles
+    };
+
+    /** Metric snapshot. */
+    struct Value
+    {
+        const char *name;               ///< metric name
+        Type type;                      ///< metric type
+
+        double value;                   ///< gauge value, counter increment or number of timer samples since the previous snapshot
+
+        double p50;                     ///< timer samples median
+        double p99;                     ///< timer samples 99th percentile
+        double p999;                    ///< timer samples 99.9th percentile
+        double max;                     ///< timer samples maximum
+    };
+
+    typedef std::vector< Value > Values;
+
+    /** @brief Scoped timer zone class. */
+    class FDMEXPORT Zone
+    {
+    public:
+
+        /** @brief Constructor. */
+        inline Zone( int id ) :
+            _id ( id ),
+            _t_0 ( Metrics::isEnabled() ? Time::get() : -1.0 )
+        {}
+
+        /** @brief Destructor. */
+        inline ~Zone()
+        {
+            if ( _t_0 >= 0.0 ) Metrics::time( _id, Time::get() - _t_0 );
+        }
+
+    private:
+
+        int _id;            ///< metric ID
+        double _t_0;        ///< [s] zone start time, negative if disabled
+
+        Zone( const Zone & );
+        Zone& operator= ( const Zone & );
+    };
+
+    /**
+     * @brief Registers metric.
+     * @param name metric name
+     * @param type metric type
+     * @return metric ID or -1 if there is no room for a new metric
+     */
+    static int add( const char *name, Type type );
+
+    /**
+     * @brief Increments counter.
+     * @param id metric ID
+     * @param increment increment
+     */
+    static void count( int id, UInt64 increment = 1 );
+
+    /** @brief Returns true if collection is enabled. */
+    static bool isEnabled();
+
+    /**
+     * @brief Sets gauge value.
+     * @param id metric ID
+     * @param value value
+     */
+    static void set( int id, double value );
+
+    /** @brief Enables or disables collection (disabled by default). */
+    static void setEnabled( bool enabled );
+
+    /**
+     * @brief Takes snapshot of all the metrics, might be called only from
+     * a single thread. Timers are reset after each snapshot.
+     * @param values output metrics values
+     * @return number of timer samples dropped since the previous snapshot
+     */
+    static UInt64 snapshot( Values *values );
+
+    /**
+     * @brief Adds timer sample.
+     * @param id metric ID
+     * @param value [s] sample value
+     */
+    static void time( int id, double value );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_METRICS_H
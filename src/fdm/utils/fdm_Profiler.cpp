@@ -0,0 +1,185 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_Profiler.h>
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+struct Event
+{
+    const char *name;       ///< zone name
+    double t_0;             ///< [s] zone start time
+    double t_1;             ///< [s] zone end time
+};
+
+struct Buffer
+{
+    Event events[ Profiler::_buffer_size ];
+
+    std::atomic< UInt64 > head;     ///< number of zones recorded so far
+    std::atomic< UInt64 > tail;     ///< number of zones dropped by reset
+
+    unsigned int id;                ///< thread id in the trace
+};
+
+/** Buffers are never freed, so zones of finished threads can be written. */
+struct Registry
+{
+    std::mutex mutex;
+    std::vector< Buffer* > buffers;
+};
+
+std::atomic< bool > enabled( true );
+
+Registry& getRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+Buffer* getBuffer()
+{
+    static thread_local Buffer *buffer = FDM_NULLPTR;
+
+    if ( buffer == FDM_NULLPTR )
+    {
+        Registry &registry = getRegistry();
+        std::lock_guard< std::mutex > lock( registry.mutex );
+
+        buffer = new Buffer();
+        buffer->head = 0;
+        buffer->tail = 0;
+        buffer->id = (unsigned int)registry.buffers.size() + 1;
+
+        registry.buffers.push_back( buffer );
+    }
+
+    return buffer;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Profiler::isEnabled()
+{
+    return enabled.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Profiler::record( const char *name, double t_0, double t_1 )
+{
+    Buffer *buffer = getBuffer();
+
+    UInt64 head = buffer->head.load( std::memory_order_relaxed );
+
+    Event &event = buffer->events[ head % _buffer_size ];
+
+    event.name = name;
+    event.t_0  = t_0;
+    event.t_1  = t_1;
+
+    buffer->head.store( head + 1, std::memory_order_release );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Profiler::reset()
+{
+    Registry &registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    for ( size_t i = 0; i < registry.buffers.size(); i++ )
+    {
+        Buffer *buffer = registry.buffers[ i ];
+        buffer->tail.store( buffer->head.load( std::memory_order_acquire ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Profiler::setEnabled( bool enabled )
+{
+    ::enabled.store( enabled, std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int Profiler::writeTrace( const char *fileName )
+{
+    FILE *file = fopen( fileName, "w" );
+
+    if ( file == FDM_NULLPTR )
+    {
+        return FDM_FAILURE;
+    }
+
+    Registry &registry = getRegistry();
+    std::lock_guard< std::mutex > lock( registry.mutex );
+
+    fprintf( file, "{\"traceEvents\":[\n" );
+
+    bool first = true;
+
+    for ( size_t i = 0; i < registry.buffers.size(); i++ )
+    {
+        Buffer *buffer = registry.buffers[ i ];
+
+        UInt64 head = buffer->head.load( std::memory_order_acquire );
+        UInt64 tail = buffer->tail.load();
+
+        if ( head - tail > _buffer_size ) tail = head - _buffer_size;
+
+        for ( UInt64 j = tail; j < head; j++ )
+        {
+            const Event &event = buffer->events[ j % _buffer_size ];
+
+            fprintf( file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                           "\"ts\":%.3f,\"dur\":%.3f}",
+                     first ? "" : ",\n", event.name, buffer->id,
+                     1.0e6 * event.t_0, 1.0e6 * ( event.t_1 - event.t_0 ) );
+
+            first = false;
+        }
+    }
+
+    fprintf( file, "\n],\"displayTimeUnit\":\"ms\"}\n" );
+
+    int result = ferror( file ) ? FDM_FAILURE : FDM_SUCCESS;
+
+    fclose( file );
+
+    return result;
+}
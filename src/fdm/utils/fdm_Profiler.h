@@ -0,0 +1,129 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_PROFILER_H
+#define FDM_PROFILER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/utils/fdm_Time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define FDM_PROFILE_CONCAT_( a, b ) a ## b
+#define FDM_PROFILE_CONCAT( a, b ) FDM_PROFILE_CONCAT_( a, b )
+
+#ifdef FDM_PROFILER
+#   define FDM_PROFILE_ZONE( name ) \
+    fdm::Profiler::Zone FDM_PROFILE_CONCAT( fdm_profile_zone_, __LINE__ )( name )
+#else
+#   define FDM_PROFILE_ZONE( name )
+#endif
+
+#define FDM_PROFILE_FUNCTION() FDM_PROFILE_ZONE( __FUNCTION__ )
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Scoped zones profiler class.
+ *
+ * Zones are recorded into per-thread ring buffers. Each buffer has a single
+ * writer (its owning thread), so recording takes no locks; only the first
+ * zone recorded by a thread registers its buffer. When the buffer is full
+ * the oldest zones are overwritten.
+ *
+ * Zones are put in the code with FDM_PROFILE_ZONE and FDM_PROFILE_FUNCTION
+ * macros, which expand to nothing unless FDM_PROFILER is defined. Zone name
+ * has to be a string literal (or otherwise outlive the profiler).
+ *
+ * Recorded zones are written in the Chrome trace event format, which can be
+ * viewed with chrome://tracing or Perfetto UI. Trace should be written while
+ * the profiled threads are stopped, otherwise zones being overwritten at the
+ * time might be garbled.
+ */
+class FDMEXPORT Profiler
+{
+public:
+
+    static const unsigned int _buffer_size = 65536;     ///< [-] number of zones per thread
+
+    /** @brief Scoped zone class. */
+    class FDMEXPORT Zone
+    {
+    public:
+
+        /** @brief Constructor. */
+        inline Zone( const char *name ) :
+            _name ( name ),
+            _t_0 ( Profiler::isEnabled() ? Time::get() : -1.0 )
+        {}
+
+        /** @brief Destructor. */
+        inline ~Zone()
+        {
+            if ( _t_0 >= 0.0 ) Profiler::record( _name, _t_0, Time::get() );
+        }
+
+    private:
+
+        const char *_name;  ///< zone name
+        double _t_0;        ///< [s] zone start time, negative if disabled
+
+        Zone( const Zone & );
+        Zone& operator= ( const Zone & );
+    };
+
+    /** @brief Returns true if recording is enabled. */
+    static bool isEnabled();
+
+    /**
+     * @brief Records zone.
+     * @param name zone name
+     * @param t_0 [s] zone start time
+     * @param t_1 [s] zone end time
+     */
+    static void record( const char *name, double t_0, double t_1 );
+
+    /** @brief Drops all recorded zones. */
+    static void reset();
+
+    /** @brief Enables or disables recording (enabled by default). */
+    static void setEnabled( bool enabled );
+
+    /**
+     * @brief Writes recorded zones to the file as Chrome trace events.
+     * @param fileName output file name
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure
+     */
+    static int writeTrace( const char *fileName );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_PROFILER_H
@@ -26,6 +26,7 @@
 
 #include <fdm/utils/fdm_Matrix3x3.h>
 #include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_Simd.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -49,16 +50,6 @@ Quaternion::Quaternion()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Quaternion::Quaternion( const Quaternion &quat )
-{
-    _e0 = quat._e0;
-    _ex = quat._ex;
-    _ey = quat._ey;
-    _ez = quat._ez;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Quaternion::Quaternion( double e0, double ex, double ey, double ez )
 {
     set( e0, ex, ey, ez );
@@ -154,15 +145,14 @@ double Quaternion::getLength() const
 
 void Quaternion::normalize()
 {
-    double length = getLength();
+    double q[] = { _e0, _ex, _ey, _ez };
 
-    if ( length > 0.0 )
-    {
-        _e0 = _e0 / length;
-        _ex = _ex / length;
-        _ey = _ey / length;
-        _ez = _ez / length;
-    }
+    Simd::normalize4( q );
+
+    _e0 = q[ 0 ];
+    _ex = q[ 1 ];
+    _ey = q[ 2 ];
+    _ez = q[ 3 ];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -300,18 +290,6 @@ std::string Quaternion::toString() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-const Quaternion& Quaternion::operator= ( const Quaternion &quat )
-{
-    _e0 = quat._e0;
-    _ex = quat._ex;
-    _ey = quat._ey;
-    _ez = quat._ez;
-
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Quaternion Quaternion::operator+ ( const Quaternion &quat ) const
 {
     Quaternion result;
@@ -356,27 +334,19 @@ Quaternion Quaternion::operator* ( double val ) const
 
 Quaternion Quaternion::operator* ( const Quaternion &quat ) const
 {
+    const double a[] = { _e0, _ex, _ey, _ez };
+    const double b[] = { quat._e0, quat._ex, quat._ey, quat._ez };
+
+    double r[ 4 ];
+
+    Simd::mulQuat( a, b, r );
+
     Quaternion result;
 
-    result._e0 = _e0 * quat._e0
-               - _ex * quat._ex
-               - _ey * quat._ey
-               - _ez * quat._ez;
-
-    result._ex = _e0 * quat._ex
-               + _ex * quat._e0
-               + _ey * quat._ez
-               - _ez * quat._ey;
-
-    result._ey = _e0 * quat._ey
-               - _ex * quat._ez
-               + _ey * quat._e0
-               + _ez * quat._ex;
-
-    result._ez = _e0 * quat._ez
-               + _ex * quat._ey
-               - _ey * quat._ex
-               + _ez * quat._e0;
+    result._e0 = r[ 0 ];
+    result._ex = r[ 1 ];
+    result._ey = r[ 2 ];
+    result._ez = r[ 3 ];
 
     return result;
 }
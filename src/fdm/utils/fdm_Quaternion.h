@@ -60,9 +60,6 @@ public:
     /** @brief Constructor. */
     Quaternion();
 
-    /** @brief Copy constructor. */
-    Quaternion( const Quaternion &quat );
-
     /** @brief Constructor. */
     Quaternion( double e0, double ex, double ey, double ez );
 
@@ -125,9 +122,6 @@ public:
     /** @brief Returns string representation of the quaternion. */
     std::string toString() const;
 
-    /** @brief Assignment operator. */
-    const Quaternion& operator= ( const Quaternion &quat );
-
     /** @brief Addition operator. */
     Quaternion operator+ ( const Quaternion &quat ) const;
 
@@ -169,16 +163,14 @@ private:
     double _ez;     ///< quaternion ez (z) component
 };
 
-} // end of fdm namespace
-
-////////////////////////////////////////////////////////////////////////////////
-
 /** @brief Multiplication operator (by scalar). */
-inline fdm::Quaternion operator* ( double val, const fdm::Quaternion &quat )
+inline Quaternion operator* ( double val, const Quaternion &quat )
 {
     return quat * val;
 }
 
+} // end of fdm namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // FDM_QUATERNION_H
@@ -22,7 +22,7 @@
 
 #include <fdm/utils/fdm_Random.h>
 
-#include <cstdlib>
+#include <cmath>
 #include <ctime>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,7 +33,14 @@ using namespace fdm;
 
 Random::Random()
 {
-    srand( (unsigned int)time( FDM_NULLPTR ) );
+    setSeed( (UInt64)time( FDM_NULLPTR ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Random::Random( UInt64 seed )
+{
+    setSeed( seed );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,30 +49,136 @@ Random::~Random() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Random::setSeed( UInt64 seed )
+{
+    // splitmix64
+    for ( int i = 0; i < 4; i++ )
+    {
+        UInt64 z = ( seed += 0x9e3779b97f4a7c15ULL );
+
+        z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+
+        _s[ i ] = z ^ ( z >> 31 );
+    }
+
+    _spare = 0.0;
+    _hasSpare = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Random::getState( State *state ) const
+{
+    for ( int i = 0; i < 4; i++ ) state->s[ i ] = _s[ i ];
+
+    state->spare    = _spare;
+    state->hasSpare = _hasSpare;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Random::setState( const State &state )
+{
+    for ( int i = 0; i < 4; i++ ) _s[ i ] = state.s[ i ];
+
+    _spare    = state.spare;
+    _hasSpare = state.hasSpare;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Random::archiveState( StateArchive *archive )
+{
+    for ( int i = 0; i < 4; i++ ) archive->add( &_s[ i ] );
+
+    archive->add( &_spare );
+    archive->add( &_hasSpare );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Random::getNormal( double mean, double stdDev )
+{
+    if ( _hasSpare )
+    {
+        _hasSpare = false;
+        return mean + stdDev * _spare;
+    }
+
+    double z0 = 0.0;
+
+    getNormalPair( &z0, &_spare );
+    _hasSpare = true;
+
+    return mean + stdDev * z0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Random::getNormals( double *values, unsigned int count,
+                         double mean, double stdDev )
+{
+    unsigned int i = 0;
+
+    if ( _hasSpare && count > 0 )
+    {
+        _hasSpare = false;
+        values[ i++ ] = mean + stdDev * _spare;
+    }
+
+    for ( ; i + 1 < count; i += 2 )
+    {
+        getNormalPair( &values[ i ], &values[ i + 1 ] );
+
+        values[ i     ] = mean + stdDev * values[ i     ];
+        values[ i + 1 ] = mean + stdDev * values[ i + 1 ];
+    }
+
+    if ( i < count )
+    {
+        values[ i ] = getNormal( mean, stdDev );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 int Random::getRandom( int min, int max )
 {
-    if ( max > 0 && max > min && max <= RAND_MAX )
+    if ( max > min )
     {
-        return min + rand() % ( max - min + 1 );
+        UInt64 range = (UInt64)( (long long)max - (long long)min ) + 1;
+        return (int)( (long long)min + (long long)( getNext() % range ) );
     }
 
-    return 0;
+    return min;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 float Random::getRandom( float min, float max )
 {
-    int random = getRandom( 0, RAND_MAX );
-
-    return min + ( max - min ) * ( (float)random / (float)RAND_MAX );
+    return min + ( max - min ) * (float)getUniform();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 double Random::getRandom( double min, double max )
 {
-    int random = getRandom( 0, RAND_MAX );
+    return min + ( max - min ) * getUniform();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Random::getNormalPair( double *z0, double *z1 )
+{
+    // Box-Muller transform, u1 is in range (0.0,1.0]
+    double u1 = 1.0 - getUniform();
+    double u2 = getUniform();
+
+    double r = sqrt( -2.0 * log( u1 ) );
+    double a = 2.0 * M_PI * u2;
 
-    return min + ( max - min ) * ( (double)random / (double)RAND_MAX );
+    (*z0) = r * cos( a );
+    (*z1) = r * sin( a );
 }
@@ -25,8 +25,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
 
 #include <fdm/utils/fdm_Singleton.h>
+#include <fdm/utils/fdm_StateArchive.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -35,13 +37,28 @@ namespace fdm
 
 /**
  * @brief Random number generator.
+ *
+ * Generator is based on xoshiro256** algorithm, its state is expanded from
+ * the 64-bit seed with splitmix64 algorithm. Every instance has its own state,
+ * so sequences are reproducible for the given seed and independent of other
+ * instances. Static functions use shared instance seeded with current time
+ * and are intended for non-deterministic purposes (e.g. visuals) only.
+ *
+ * @see Blackman D., Vigna S.: Scrambled Linear Pseudorandom Number Generators, 2018
+ * @see Box G., Muller M.: A Note on the Generation of Random Normal Deviates, 1958
  */
 class FDMEXPORT Random : public Singleton< Random >
 {
-    friend class Singleton< Random >;
-
 public:
 
+    /** Generator state, plain data which might be copied with memcpy. */
+    struct State
+    {
+        UInt64 s[ 4 ];      ///< xoshiro256** state
+        double spare;       ///< spare normally distributed value
+        bool hasSpare;      ///< specifies if spare value is available
+    };
+
     /**
      * @brief Gets random number from the given range.
      * @param min minimum random number value
@@ -75,9 +92,92 @@ public:
         return Random::instance()->getRandom( min, max );
     }
 
-    /** Destructor. */
+    /** @brief Constructor, seeds generator with current time. */
+    Random();
+
+    /**
+     * @brief Constructor.
+     * @param seed generator seed
+     */
+    explicit Random( UInt64 seed );
+
+    /** @brief Destructor. */
     virtual ~Random();
 
+    /**
+     * @brief Seeds generator.
+     * @param seed generator seed
+     */
+    void setSeed( UInt64 seed );
+
+    /**
+     * @brief Gets generator state.
+     * @param state output generator state
+     */
+    void getState( State *state ) const;
+
+    /**
+     * @brief Sets generator state, subsequent numbers are the same as those
+     * which followed when the state was saved.
+     * @param state generator state
+     */
+    void setState( const State &state );
+
+    /**
+     * @brief Archives generator state.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
+    /**
+     * @brief Gets next 64-bit random number.
+     * @return random value
+     */
+    inline UInt64 getNext()
+    {
+        const UInt64 result = rotl( _s[ 1 ] * 5, 7 ) * 9;
+        const UInt64 t = _s[ 1 ] << 17;
+
+        _s[ 2 ] ^= _s[ 0 ];
+        _s[ 3 ] ^= _s[ 1 ];
+        _s[ 1 ] ^= _s[ 2 ];
+        _s[ 0 ] ^= _s[ 3 ];
+
+        _s[ 2 ] ^= t;
+
+        _s[ 3 ] = rotl( _s[ 3 ], 45 );
+
+        return result;
+    }
+
+    /**
+     * @brief Gets random number uniformly distributed in range [0.0,1.0).
+     * @return random value
+     */
+    inline double getUniform()
+    {
+        return ( getNext() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+    }
+
+    /**
+     * @brief Gets normally distributed random number.
+     * @param mean mean value
+     * @param stdDev standard deviation
+     * @return random value
+     */
+    double getNormal( double mean = 0.0, double stdDev = 1.0 );
+
+    /**
+     * @brief Fills array with normally distributed random numbers.
+     * Result is the same as for count subsequent getNormal() calls.
+     * @param values output array
+     * @param count number of values
+     * @param mean mean value
+     * @param stdDev standard deviation
+     */
+    void getNormals( double *values, unsigned int count,
+                     double mean = 0.0, double stdDev = 1.0 );
+
     /**
      * @brief Gets random number from the given range.
      * @param min minimum random number value
@@ -104,14 +204,17 @@ public:
 
 private:
 
-    /**
-     * You should use static function instance() due to get refernce
-     * to Random class instance.
-     */
-    Random();
+    UInt64 _s[ 4 ];         ///< generator state
+
+    double _spare;          ///< spare normally distributed value
+    bool _hasSpare;         ///< specifies if spare value is available
+
+    inline static UInt64 rotl( const UInt64 x, int k )
+    {
+        return ( x << k ) | ( x >> ( 64 - k ) );
+    }
 
-    /** Using this constructor is forbidden. */
-    Random( const Random & ) {}
+    void getNormalPair( double *z0, double *z1 );
 };
 
 } // end of fdm namespace
@@ -0,0 +1,146 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_RINGBUFFER_H
+#define FDM_RINGBUFFER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Lock-free single producer single consumer ring buffer of fixed-size
+ * byte records.
+ *
+ * Producer and consumer positions run modulo twice the capacity, so a full
+ * buffer (positions differ by the capacity) can be told from an empty one
+ * (positions are equal). Neither side ever blocks, producer fails to push
+ * when buffer is full.
+ */
+class FDMEXPORT RingBuffer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param capacity maximum number of records
+     * @param size [B] record size
+     */
+    RingBuffer( UInt32 capacity = 1, UInt32 size = 1 ) :
+        _capacity ( capacity > 0 ? capacity : 1 ),
+        _size ( size ),
+        _data ( _capacity * _size ),
+        _head ( 0 ),
+        _tail ( 0 )
+    {}
+
+    /**
+     * @brief Pushes record, might be called by producer thread only.
+     * @param record record data of record size
+     * @return true on success, false if buffer is full
+     */
+    inline bool push( const char *record )
+    {
+        UInt32 head = _head.load( std::memory_order_relaxed );
+
+        UInt32 tail = _tail.load( std::memory_order_acquire );
+
+        if ( ( head + 2 * _capacity - tail ) % ( 2 * _capacity ) == _capacity )
+        {
+            return false;
+        }
+
+        memcpy( &_data[ ( head % _capacity ) * _size ], record, _size );
+        _head.store( ( head + 1 ) % ( 2 * _capacity ), std::memory_order_release );
+
+        return true;
+    }
+
+    /**
+     * @brief Returns oldest record, might be called by consumer thread only.
+     * @return oldest record or null pointer if buffer is empty
+     */
+    inline const char* front() const
+    {
+        UInt32 tail = _tail.load( std::memory_order_relaxed );
+
+        if ( tail == _head.load( std::memory_order_acquire ) )
+        {
+            return FDM_NULLPTR;
+        }
+
+        return &_data[ ( tail % _capacity ) * _size ];
+    }
+
+    /**
+     * @brief Removes oldest record, might be called by consumer thread only
+     * after front() returned valid record.
+     */
+    inline void pop()
+    {
+        UInt32 tail = _tail.load( std::memory_order_relaxed );
+        _tail.store( ( tail + 1 ) % ( 2 * _capacity ), std::memory_order_release );
+    }
+
+    /** @return number of records in the buffer (might be outdated when used by the other side) */
+    inline UInt32 getCount() const
+    {
+        UInt32 head = _head.load( std::memory_order_acquire );
+        UInt32 tail = _tail.load( std::memory_order_acquire );
+
+        return ( head + 2 * _capacity - tail ) % ( 2 * _capacity );
+    }
+
+    /** @return maximum number of records */
+    inline UInt32 getCapacity() const { return _capacity; }
+
+    /** @return [B] record size */
+    inline UInt32 getSize() const { return _size; }
+
+private:
+
+    const UInt32 _capacity;         ///< maximum number of records
+    const UInt32 _size;             ///< [B] record size
+
+    std::vector< char > _data;      ///< records data
+
+    std::atomic< UInt32 > _head;    ///< producer position
+    std::atomic< UInt32 > _tail;    ///< consumer position
+
+    /** Using this constructor is forbidden. */
+    RingBuffer( const RingBuffer & ) : _capacity( 0 ), _size( 0 ) {}
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_RINGBUFFER_H
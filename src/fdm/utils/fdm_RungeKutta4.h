@@ -38,15 +38,19 @@ namespace fdm
  * @see Krupowicz A.: Metody numeryczne zagadnien poczatkowych rownan rozniczkowych zwyczajnych, 1986, p.185. [in Polish]
  * @see Baron B., Piatek L.: Metody numeryczne w C++ Builder, 2004, p.331. [in Polish]
  * @see https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta_methods
+ *
+ * Stages are computed in place, so no temporary vectors are created. When
+ * fixed-size fdm::Vector is used as VECTOR integration doesn't involve any
+ * heap allocations at all.
  */
-template < class TYPE >
-class RungeKutta4 : public Integrator< TYPE >
+template < class TYPE, class VECTOR = VectorN >
+class RungeKutta4 : public Integrator< TYPE, VECTOR >
 {
 public:
 
     /** @brief Constructor. */
-    RungeKutta4( TYPE *obj = FDM_NULLPTR, void (TYPE::*fun)(const VectorN &, VectorN *) = FDM_NULLPTR ) :
-        Integrator< TYPE > ( obj, fun )
+    RungeKutta4( TYPE *obj = FDM_NULLPTR, void (TYPE::*fun)(const VECTOR &, VECTOR *) = FDM_NULLPTR ) :
+        Integrator< TYPE, VECTOR > ( obj, fun )
     {}
 
     /** @brief Destructor. */
@@ -57,14 +61,20 @@ public:
      * @param step integration time step [s]
      * @param vect integrating vector
      */
-    void integrate( double step, VectorN *vect )
+    void integrate( double step, VECTOR *vect )
     {
+        const unsigned int size = vect->getSize();
+
+        const double step_2 = step / 2.0;
+        const double step_6 = step / 6.0;
+
+        // assignment reallocates VectorN only if size changes
         _xt = (*vect);
 
-        _k1.resize( vect->getSize() );
-        _k2.resize( vect->getSize() );
-        _k3.resize( vect->getSize() );
-        _k4.resize( vect->getSize() );
+        _k1 = (*vect);
+        _k2 = (*vect);
+        _k3 = (*vect);
+        _k4 = (*vect);
 
         _k1.zeroize();
         _k2.zeroize();
@@ -75,29 +85,45 @@ public:
         this->fun( _xt, &_k1 );
 
         // k2 - derivatives calculation
-        _xt = (*vect) + _k1 * ( step / 2.0 );
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k1( i ) * step_2;
+        }
+
         this->fun( _xt, &_k2 );
 
         // k3 - derivatives calculation
-        _xt = (*vect) + _k2 * ( step / 2.0 );
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k2( i ) * step_2;
+        }
+
         this->fun( _xt, &_k3 );
 
         // k4 - derivatives calculation
-        _xt = (*vect) + _k3 * step;
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k3( i ) * step;
+        }
+
         this->fun( _xt, &_k4 );
 
         // integration
-        (*vect) = (*vect) + ( _k1 + _k2 * 2.0 + _k3 * 2.0 + _k4 ) * ( step / 6.0 );
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            (*vect)( i ) = (*vect)( i )
+                    + ( _k1( i ) + _k2( i ) * 2.0 + _k3( i ) * 2.0 + _k4( i ) ) * step_6;
+        }
     }
 
 private:
 
-    VectorN _k1;        ///< auxiliary vector
-    VectorN _k2;        ///< auxiliary vector
-    VectorN _k3;        ///< auxiliary vector
-    VectorN _k4;        ///< auxiliary vector
+    VECTOR _k1;         ///< auxiliary vector
+    VECTOR _k2;         ///< auxiliary vector
+    VECTOR _k3;         ///< auxiliary vector
+    VECTOR _k4;         ///< auxiliary vector
 
-    VectorN _xt;        ///< auxiliary vector
+    VECTOR _xt;         ///< auxiliary vector
 
     /** Using this constructor is forbidden. */
     RungeKutta4( const RungeKutta4 & ) {}
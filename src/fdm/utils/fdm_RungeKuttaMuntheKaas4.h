@@ -0,0 +1,228 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_RUNGEKUTTAMUNTHEKAAS4_H
+#define FDM_RUNGEKUTTAMUNTHEKAAS4_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/utils/fdm_Integrator.h>
+#include <fdm/utils/fdm_Quaternion.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Runge-Kutta-Munthe-Kaas 4th order (Lie group) numerical integration
+ * template class.
+ *
+ * Integrated vector contains attitude quaternion, which is propagated on the
+ * unit quaternion group by the exponential map of rotation vector, while all
+ * the other items are integrated with classical Runge-Kutta 4th order scheme.
+ * Quaternion derivative is expected to be q_dot = 0.5 * q * omega (angular
+ * velocity expressed in the rotated axes), angular velocity of each stage is
+ * recovered from the derivative, so that no extra function is needed and
+ * frozen attitude (zero derivative) is kept frozen. Attitude keeps unit norm
+ * by construction and its accuracy doesn't drop at high angular rates as
+ * quickly as when quaternion items are integrated as independent variables.
+ *
+ * @see Hairer E., Lubich C., Wanner G.: Geometric Numerical Integration, 2006, p.124
+ * @see Munthe-Kaas H.: High order Runge-Kutta methods on manifolds, 1999
+ * @see https://en.wikipedia.org/wiki/Runge%E2%80%93Kutta%E2%80%93Munthe-Kaas_method
+ */
+template < class TYPE, class VECTOR = VectorN >
+class RungeKuttaMuntheKaas4 : public Integrator< TYPE, VECTOR >
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param obj object pointer
+     * @param fun pointer to function which calculates vector derivative
+     * @param index_att index of the first item of the attitude quaternion (e0, ex, ey, ez)
+     */
+    RungeKuttaMuntheKaas4( TYPE *obj = FDM_NULLPTR,
+                           void (TYPE::*fun)(const VECTOR &, VECTOR *) = FDM_NULLPTR,
+                           unsigned int index_att = 0 ) :
+        Integrator< TYPE, VECTOR > ( obj, fun ),
+        _index_att ( index_att )
+    {}
+
+    /** @brief Destructor. */
+    virtual ~RungeKuttaMuntheKaas4() {}
+
+    /**
+     * @brief Integrates given vector using Runge-Kutta-Munthe-Kaas 4th order integration algorithm.
+     * @param step integration time step [s]
+     * @param vect integrating vector
+     */
+    void integrate( double step, VECTOR *vect )
+    {
+        const unsigned int size = vect->getSize();
+
+        const double step_2 = step / 2.0;
+        const double step_6 = step / 6.0;
+
+        const Quaternion q0 = getQuaternion( *vect ).getNormalized();
+
+        // assignment reallocates VectorN only if size changes
+        _xt = (*vect);
+
+        _k1 = (*vect);
+        _k2 = (*vect);
+        _k3 = (*vect);
+        _k4 = (*vect);
+
+        _k1.zeroize();
+        _k2.zeroize();
+        _k3.zeroize();
+        _k4.zeroize();
+
+        // k1 - derivatives calculation
+        setQuaternion( q0, &_xt );
+
+        this->fun( _xt, &_k1 );
+
+        Vector3 u1 = step * getOmega( _xt, _k1 );
+
+        // k2 - derivatives calculation
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k1( i ) * step_2;
+        }
+
+        setQuaternion( q0 * getExp( 0.5 * u1 ), &_xt );
+
+        this->fun( _xt, &_k2 );
+
+        Vector3 u2 = step * getOmega( _xt, _k2 );
+
+        // k3 - derivatives calculation
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k2( i ) * step_2;
+        }
+
+        setQuaternion( q0 * getExp( 0.5 * u2 + ( u1 % u2 ) / 8.0 ), &_xt );
+
+        this->fun( _xt, &_k3 );
+
+        Vector3 u3 = step * getOmega( _xt, _k3 );
+
+        // k4 - derivatives calculation
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            _xt( i ) = (*vect)( i ) + _k3( i ) * step;
+        }
+
+        setQuaternion( q0 * getExp( u3 ), &_xt );
+
+        this->fun( _xt, &_k4 );
+
+        Vector3 u4 = step * getOmega( _xt, _k4 );
+
+        // integration
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            (*vect)( i ) = (*vect)( i )
+                    + ( _k1( i ) + _k2( i ) * 2.0 + _k3( i ) * 2.0 + _k4( i ) ) * step_6;
+        }
+
+        Vector3 u = ( u1 + 2.0 * u2 + 2.0 * u3 + u4 ) / 6.0 + ( u1 % u4 ) / 12.0;
+
+        setQuaternion( q0 * getExp( u ), vect );
+    }
+
+private:
+
+    const unsigned int _index_att;  ///< index of the first item of the attitude quaternion
+
+    VECTOR _k1;         ///< auxiliary vector
+    VECTOR _k2;         ///< auxiliary vector
+    VECTOR _k3;         ///< auxiliary vector
+    VECTOR _k4;         ///< auxiliary vector
+
+    VECTOR _xt;         ///< auxiliary vector
+
+    /** Using this constructor is forbidden. */
+    RungeKuttaMuntheKaas4( const RungeKuttaMuntheKaas4 & ) {}
+
+    /**
+     * @brief Returns exponential map of rotation vector.
+     * @param u rotation vector [rad]
+     * @return unit quaternion
+     */
+    static Quaternion getExp( const Vector3 &u )
+    {
+        double angl = u.getLength();
+
+        if ( angl < 1.0e-12 )
+        {
+            return Quaternion( 1.0, 0.5 * u.x(), 0.5 * u.y(), 0.5 * u.z() ).getNormalized();
+        }
+
+        return Quaternion( angl, u );
+    }
+
+    /**
+     * @brief Returns angular velocity recovered from quaternion derivative.
+     * @param x vector
+     * @param k vector derivative
+     * @return angular velocity [rad/s]
+     */
+    Vector3 getOmega( const VECTOR &x, const VECTOR &k ) const
+    {
+        Quaternion q = getQuaternion( x );
+        Quaternion q_dot = getQuaternion( k );
+
+        // omega = 2 * q^-1 * q_dot, any normalization term is a scalar part
+        Quaternion w = q.getConjugated() * q_dot * ( 2.0 / q.getLength2() );
+
+        return Vector3( w.ex(), w.ey(), w.ez() );
+    }
+
+    /** @brief Returns vector items as quaternion. */
+    Quaternion getQuaternion( const VECTOR &x ) const
+    {
+        return Quaternion( x( _index_att     ),
+                           x( _index_att + 1 ),
+                           x( _index_att + 2 ),
+                           x( _index_att + 3 ) );
+    }
+
+    /** @brief Sets vector items from quaternion. */
+    void setQuaternion( const Quaternion &q, VECTOR *x ) const
+    {
+        (*x)( _index_att     ) = q.e0();
+        (*x)( _index_att + 1 ) = q.ex();
+        (*x)( _index_att + 2 ) = q.ey();
+        (*x)( _index_att + 3 ) = q.ez();
+    }
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_RUNGEKUTTAMUNTHEKAAS4_H
@@ -0,0 +1,452 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_SIMD_H
+#define FDM_SIMD_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FDM_NO_SIMD
+#   if defined(__AVX__)
+#       define FDM_SIMD_AVX
+#       define FDM_SIMD_SSE2
+#   elif defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#       define FDM_SIMD_SSE2
+#   elif defined(__ARM_NEON) && defined(__aarch64__)
+#       define FDM_SIMD_NEON
+#   endif
+#endif
+
+#if defined(FDM_SIMD_AVX)
+#   include <immintrin.h>
+#elif defined(FDM_SIMD_SSE2)
+#   include <emmintrin.h>
+#elif defined(FDM_SIMD_NEON)
+#   include <arm_neon.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief SIMD kernels of the most frequently used 3D math operations.
+ *
+ * Implementation is chosen at compile time: AVX, SSE2 (all x86-64
+ * processors) or NEON (AArch64), with scalar fallback. SIMD can be disabled
+ * by defining FDM_NO_SIMD. Kernels operate on row-major arrays, vectors are
+ * stored as (x,y,z) and quaternions as (e0,ex,ey,ez). Output arrays must not
+ * alias input arrays. Operations are performed in the same order as in the
+ * scalar code, so results do not depend on implementation.
+ */
+class FDMEXPORT Simd
+{
+public:
+
+    /**
+     * @brief Multiplies 3x3 matrix by 3 vector.
+     * @param m matrix items
+     * @param v vector items
+     * @param r result vector items
+     */
+    inline static void mulMat3Vec3( const double *m, const double *v, double *r )
+    {
+#       if defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        Pd2 r01 = add2( add2( mul2( set2( m[ 0 ], m[ 3 ] ), dup2( v[ 0 ] ) ),
+                              mul2( set2( m[ 1 ], m[ 4 ] ), dup2( v[ 1 ] ) ) ),
+                              mul2( set2( m[ 2 ], m[ 5 ] ), dup2( v[ 2 ] ) ) );
+        store2( r, r01 );
+#       else
+        r[ 0 ] = m[ 0 ] * v[ 0 ] + m[ 1 ] * v[ 1 ] + m[ 2 ] * v[ 2 ];
+        r[ 1 ] = m[ 3 ] * v[ 0 ] + m[ 4 ] * v[ 1 ] + m[ 5 ] * v[ 2 ];
+#       endif
+        r[ 2 ] = m[ 6 ] * v[ 0 ] + m[ 7 ] * v[ 1 ] + m[ 8 ] * v[ 2 ];
+    }
+
+    /**
+     * @brief Multiplies 3x3 matrices.
+     * @param a left hand side matrix items
+     * @param b right hand side matrix items
+     * @param r result matrix items
+     */
+    inline static void mulMat3Mat3( const double *a, const double *b, double *r )
+    {
+#       if defined(FDM_SIMD_AVX)
+        const __m256i mask = _mm256_set_epi64x( 0, -1, -1, -1 );
+
+        const __m256d b0 = _mm256_maskload_pd( b     , mask );
+        const __m256d b1 = _mm256_maskload_pd( b + 3 , mask );
+        const __m256d b2 = _mm256_maskload_pd( b + 6 , mask );
+
+        for ( int i = 0; i < 9; i += 3 )
+        {
+            __m256d ri = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( _mm256_broadcast_sd( a + i     ), b0 ),
+                                                       _mm256_mul_pd( _mm256_broadcast_sd( a + i + 1 ), b1 ) ),
+                                                       _mm256_mul_pd( _mm256_broadcast_sd( a + i + 2 ), b2 ) );
+            _mm256_maskstore_pd( r + i, mask, ri );
+        }
+#       elif defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        const Pd2 b0 = load2( b     );
+        const Pd2 b1 = load2( b + 3 );
+        const Pd2 b2 = load2( b + 6 );
+
+        for ( int i = 0; i < 9; i += 3 )
+        {
+            Pd2 ri = add2( add2( mul2( dup2( a[ i     ] ), b0 ),
+                                 mul2( dup2( a[ i + 1 ] ), b1 ) ),
+                                 mul2( dup2( a[ i + 2 ] ), b2 ) );
+            store2( r + i, ri );
+
+            r[ i + 2 ] = a[ i ] * b[ 2 ] + a[ i + 1 ] * b[ 5 ] + a[ i + 2 ] * b[ 8 ];
+        }
+#       else
+        for ( int i = 0; i < 9; i += 3 )
+        {
+            for ( int c = 0; c < 3; c++ )
+            {
+                r[ i + c ] = a[ i ] * b[ c ] + a[ i + 1 ] * b[ c + 3 ] + a[ i + 2 ] * b[ c + 6 ];
+            }
+        }
+#       endif
+    }
+
+    /**
+     * @brief Computes vector (cross) product.
+     * @param a left hand side vector items
+     * @param b right hand side vector items
+     * @param r result vector items
+     */
+    inline static void cross3( const double *a, const double *b, double *r )
+    {
+#       if defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        Pd2 r01 = sub2( mul2( load2( a + 1 ), set2( b[ 2 ], b[ 0 ] ) ),
+                        mul2( set2( a[ 2 ], a[ 0 ] ), load2( b + 1 ) ) );
+        store2( r, r01 );
+#       else
+        r[ 0 ] = a[ 1 ] * b[ 2 ] - a[ 2 ] * b[ 1 ];
+        r[ 1 ] = a[ 2 ] * b[ 0 ] - a[ 0 ] * b[ 2 ];
+#       endif
+        r[ 2 ] = a[ 0 ] * b[ 1 ] - a[ 1 ] * b[ 0 ];
+    }
+
+    /**
+     * @brief Multiplies quaternions.
+     * @param a left hand side quaternion items
+     * @param b right hand side quaternion items
+     * @param r result quaternion items
+     */
+    inline static void mulQuat( const double *a, const double *b, double *r )
+    {
+#       if defined(FDM_SIMD_AVX)
+        const __m256d b_0123 = _mm256_loadu_pd( b );
+        const __m256d b_1032 = _mm256_permute_pd( b_0123, 0x5 );
+        const __m256d b_2301 = _mm256_permute2f128_pd( b_0123, b_0123, 0x1 );
+        const __m256d b_3210 = _mm256_permute_pd( b_2301, 0x5 );
+
+        __m256d t0 = _mm256_mul_pd( _mm256_set1_pd( a[ 0 ] ), b_0123 );
+        __m256d t1 = _mm256_mul_pd( _mm256_set_pd(  a[ 1 ], -a[ 1 ],  a[ 1 ], -a[ 1 ] ), b_1032 );
+        __m256d t2 = _mm256_mul_pd( _mm256_set_pd( -a[ 2 ],  a[ 2 ],  a[ 2 ], -a[ 2 ] ), b_2301 );
+        __m256d t3 = _mm256_mul_pd( _mm256_set_pd(  a[ 3 ],  a[ 3 ], -a[ 3 ], -a[ 3 ] ), b_3210 );
+
+        _mm256_storeu_pd( r, _mm256_add_pd( _mm256_add_pd( _mm256_add_pd( t0, t1 ), t2 ), t3 ) );
+#       elif defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        const Pd2 b_01 = load2( b );
+        const Pd2 b_23 = load2( b + 2 );
+        const Pd2 b_10 = swap2( b_01 );
+        const Pd2 b_32 = swap2( b_23 );
+
+        Pd2 r_01 = add2( add2( add2( mul2( dup2( a[ 0 ] ), b_01 ),
+                                     mul2( set2( -a[ 1 ], a[ 1 ] ), b_10 ) ),
+                                     mul2( set2( -a[ 2 ], a[ 2 ] ), b_23 ) ),
+                                     mul2( dup2( -a[ 3 ] ), b_32 ) );
+
+        Pd2 r_23 = add2( add2( add2( mul2( dup2( a[ 0 ] ), b_23 ),
+                                     mul2( set2( -a[ 1 ], a[ 1 ] ), b_32 ) ),
+                                     mul2( set2( a[ 2 ], -a[ 2 ] ), b_01 ) ),
+                                     mul2( dup2( a[ 3 ] ), b_10 ) );
+
+        store2( r     , r_01 );
+        store2( r + 2 , r_23 );
+#       else
+        r[ 0 ] = a[ 0 ] * b[ 0 ] - a[ 1 ] * b[ 1 ] - a[ 2 ] * b[ 2 ] - a[ 3 ] * b[ 3 ];
+        r[ 1 ] = a[ 0 ] * b[ 1 ] + a[ 1 ] * b[ 0 ] + a[ 2 ] * b[ 3 ] - a[ 3 ] * b[ 2 ];
+        r[ 2 ] = a[ 0 ] * b[ 2 ] - a[ 1 ] * b[ 3 ] + a[ 2 ] * b[ 0 ] + a[ 3 ] * b[ 1 ];
+        r[ 3 ] = a[ 0 ] * b[ 3 ] + a[ 1 ] * b[ 2 ] - a[ 2 ] * b[ 1 ] + a[ 3 ] * b[ 0 ];
+#       endif
+    }
+
+    /**
+     * @brief Normalizes 4 items array (quaternion).
+     * @param q array items
+     */
+    inline static void normalize4( double *q )
+    {
+#       if defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        Pd2 q_01 = load2( q );
+        Pd2 q_23 = load2( q + 2 );
+
+        Pd2 sq_01 = mul2( q_01, q_01 );
+        Pd2 sq_23 = mul2( q_23, q_23 );
+
+        double length = sqrt( lo2( sq_01 ) + hi2( sq_01 ) + lo2( sq_23 ) + hi2( sq_23 ) );
+
+        if ( length > 0.0 )
+        {
+            Pd2 l = dup2( length );
+            store2( q     , div2( q_01, l ) );
+            store2( q + 2 , div2( q_23, l ) );
+        }
+#       else
+        double length = sqrt( q[ 0 ]*q[ 0 ] + q[ 1 ]*q[ 1 ] + q[ 2 ]*q[ 2 ] + q[ 3 ]*q[ 3 ] );
+
+        if ( length > 0.0 )
+        {
+            for ( int i = 0; i < 4; i++ ) q[ i ] /= length;
+        }
+#       endif
+    }
+
+    /**
+     * @brief Updates discrete second-order sections.
+     * y[n] = b0*u[n] + b1*u[n-1] + b2*u[n-2] - a1*y[n-1] - a2*y[n-2]
+     * Sections states are shifted after update.
+     * @param n number of sections
+     * @param b0 b0 coefficients
+     * @param b1 b1 coefficients
+     * @param b2 b2 coefficients
+     * @param a1 a1 coefficients
+     * @param a2 a2 coefficients
+     * @param u input values
+     * @param u1 previous input values
+     * @param u2 input values before previous
+     * @param y1 current output values
+     * @param y2 previous output values
+     */
+    inline static void updateSOS( unsigned int n,
+                                  const double *b0, const double *b1, const double *b2,
+                                  const double *a1, const double *a2,
+                                  const double *u,
+                                  double *u1, double *u2, double *y1, double *y2 )
+    {
+        unsigned int i = 0;
+
+#       if defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        for ( ; i + 1 < n; i += 2 )
+        {
+            const Pd2 u_0 = load2( u  + i );
+            const Pd2 u_1 = load2( u1 + i );
+            const Pd2 u_2 = load2( u2 + i );
+            const Pd2 y_1 = load2( y1 + i );
+            const Pd2 y_2 = load2( y2 + i );
+
+            Pd2 y = sub2( sub2( add2( add2( mul2( load2( b0 + i ), u_0 ),
+                                            mul2( load2( b1 + i ), u_1 ) ),
+                                            mul2( load2( b2 + i ), u_2 ) ),
+                                            mul2( load2( a1 + i ), y_1 ) ),
+                                            mul2( load2( a2 + i ), y_2 ) );
+
+            store2( u2 + i, u_1 );
+            store2( u1 + i, u_0 );
+            store2( y2 + i, y_1 );
+            store2( y1 + i, y   );
+        }
+#       endif
+
+        for ( ; i < n; i++ )
+        {
+            double y = b0[ i ] * u[ i ] + b1[ i ] * u1[ i ] + b2[ i ] * u2[ i ]
+                     - a1[ i ] * y1[ i ] - a2[ i ] * y2[ i ];
+
+            u2[ i ] = u1[ i ];
+            u1[ i ] = u[ i ];
+
+            y2[ i ] = y1[ i ];
+            y1[ i ] = y;
+        }
+    }
+
+    /**
+     * @brief Evaluates odd polynomial for array of arguments.
+     * r = x * ( c[0] + c[1]*x^2 + c[2]*x^4 + ... + c[m-1]*x^(2m-2) )
+     * Polynomial is evaluated using Horner's scheme, e.g. truncated series of
+     * sine or inverse hyperbolic tangent within their convergence ranges.
+     * @param n number of arguments
+     * @param x arguments
+     * @param c coefficients
+     * @param m number of coefficients
+     * @param r results
+     */
+    inline static void polyOdd( unsigned int n, const double *x,
+                                const double *c, unsigned int m,
+                                double *r )
+    {
+        unsigned int i = 0;
+
+        if ( m == 0 )
+        {
+            for ( ; i < n; i++ ) r[ i ] = 0.0;
+            return;
+        }
+
+#       if defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        for ( ; i + 1 < n; i += 2 )
+        {
+            const Pd2 x_1 = load2( x + i );
+            const Pd2 x_2 = mul2( x_1, x_1 );
+
+            Pd2 p = dup2( c[ m - 1 ] );
+
+            for ( unsigned int j = m - 1; j > 0; j-- )
+            {
+                p = add2( mul2( p, x_2 ), dup2( c[ j - 1 ] ) );
+            }
+
+            store2( r + i, mul2( p, x_1 ) );
+        }
+#       endif
+
+        for ( ; i < n; i++ )
+        {
+            const double x_2 = x[ i ] * x[ i ];
+
+            double p = c[ m - 1 ];
+
+            for ( unsigned int j = m - 1; j > 0; j-- )
+            {
+                p = p * x_2 + c[ j - 1 ];
+            }
+
+            r[ i ] = p * x[ i ];
+        }
+    }
+
+    /**
+     * @brief Advances bank of oscillators by one step and sums their outputs.
+     * Every oscillator is a unit phasor (re,im) rotated by its own angle step.
+     * @param n number of oscillators
+     * @param cos_w cosines of angle steps
+     * @param sin_w sines of angle steps
+     * @param amp amplitudes
+     * @param re phasors real parts
+     * @param im phasors imaginary parts
+     * @return sum of amplitudes multiplied by phasors imaginary parts
+     */
+    inline static double updateOscillators( unsigned int n,
+                                            const double *cos_w, const double *sin_w,
+                                            const double *amp,
+                                            double *re, double *im )
+    {
+        unsigned int i = 0;
+        double sum = 0.0;
+
+#       if defined(FDM_SIMD_SSE2) || defined(FDM_SIMD_NEON)
+        for ( ; i + 1 < n; i += 2 )
+        {
+            const Pd2 c  = load2( cos_w + i );
+            const Pd2 s  = load2( sin_w + i );
+            const Pd2 r0 = load2( re + i );
+            const Pd2 i0 = load2( im + i );
+
+            const Pd2 r1 = sub2( mul2( r0, c ), mul2( i0, s ) );
+            const Pd2 i1 = add2( mul2( r0, s ), mul2( i0, c ) );
+
+            store2( re + i, r1 );
+            store2( im + i, i1 );
+
+            // summed in the scalar code order
+            const Pd2 a = mul2( load2( amp + i ), i1 );
+
+            sum += lo2( a );
+            sum += hi2( a );
+        }
+#       endif
+
+        for ( ; i < n; i++ )
+        {
+            const double r1 = re[ i ] * cos_w[ i ] - im[ i ] * sin_w[ i ];
+            const double i1 = re[ i ] * sin_w[ i ] + im[ i ] * cos_w[ i ];
+
+            re[ i ] = r1;
+            im[ i ] = i1;
+
+            sum += amp[ i ] * i1;
+        }
+
+        return sum;
+    }
+
+private:
+
+#   if defined(FDM_SIMD_SSE2)
+
+    typedef __m128d Pd2;
+
+    inline static Pd2 load2( const double *p ) { return _mm_loadu_pd( p ); }
+    inline static void store2( double *p, Pd2 v ) { _mm_storeu_pd( p, v ); }
+
+    inline static Pd2 set2( double lo, double hi ) { return _mm_set_pd( hi, lo ); }
+    inline static Pd2 dup2( double v ) { return _mm_set1_pd( v ); }
+
+    inline static Pd2 add2( Pd2 a, Pd2 b ) { return _mm_add_pd( a, b ); }
+    inline static Pd2 sub2( Pd2 a, Pd2 b ) { return _mm_sub_pd( a, b ); }
+    inline static Pd2 mul2( Pd2 a, Pd2 b ) { return _mm_mul_pd( a, b ); }
+    inline static Pd2 div2( Pd2 a, Pd2 b ) { return _mm_div_pd( a, b ); }
+
+    inline static Pd2 swap2( Pd2 v ) { return _mm_shuffle_pd( v, v, 0x1 ); }
+
+    inline static double lo2( Pd2 v ) { return _mm_cvtsd_f64( v ); }
+    inline static double hi2( Pd2 v ) { return _mm_cvtsd_f64( _mm_unpackhi_pd( v, v ) ); }
+
+#   elif defined(FDM_SIMD_NEON)
+
+    typedef float64x2_t Pd2;
+
+    inline static Pd2 load2( const double *p ) { return vld1q_f64( p ); }
+    inline static void store2( double *p, Pd2 v ) { vst1q_f64( p, v ); }
+
+    inline static Pd2 set2( double lo, double hi ) { return vcombine_f64( vdup_n_f64( lo ), vdup_n_f64( hi ) ); }
+    inline static Pd2 dup2( double v ) { return vdupq_n_f64( v ); }
+
+    inline static Pd2 add2( Pd2 a, Pd2 b ) { return vaddq_f64( a, b ); }
+    inline static Pd2 sub2( Pd2 a, Pd2 b ) { return vsubq_f64( a, b ); }
+    inline static Pd2 mul2( Pd2 a, Pd2 b ) { return vmulq_f64( a, b ); }
+    inline static Pd2 div2( Pd2 a, Pd2 b ) { return vdivq_f64( a, b ); }
+
+    inline static Pd2 swap2( Pd2 v ) { return vextq_f64( v, v, 1 ); }
+
+    inline static double lo2( Pd2 v ) { return vgetq_lane_f64( v, 0 ); }
+    inline static double hi2( Pd2 v ) { return vgetq_lane_f64( v, 1 ); }
+
+#   endif
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_SIMD_H
@@ -0,0 +1,152 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_StateArchive.h>
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+StateArchive::StateArchive() :
+    _mode ( Count ),
+    _out ( FDM_NULLPTR ),
+    _inp ( FDM_NULLPTR ),
+    _size ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+StateArchive::StateArchive( double *data ) :
+    _mode ( Save ),
+    _out ( data ),
+    _inp ( FDM_NULLPTR ),
+    _size ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+StateArchive::StateArchive( const double *data ) :
+    _mode ( Restore ),
+    _out ( FDM_NULLPTR ),
+    _inp ( data ),
+    _size ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( double *value )
+{
+    switch ( _mode )
+    {
+        case Save:    _out[ _size ] = *value; break;
+        case Restore: *value = _inp[ _size ]; break;
+        case Count: default: break;
+    }
+
+    _size++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( bool *value )
+{
+    double temp = *value ? 1.0 : 0.0;
+    add( &temp );
+    *value = temp != 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( int *value )
+{
+    double temp = *value;
+    add( &temp );
+    *value = static_cast< int >( temp );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( unsigned int *value )
+{
+    double temp = *value;
+    add( &temp );
+    *value = static_cast< unsigned int >( temp );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( UInt64 *value )
+{
+    // 64-bit integers do not fit into double mantissa
+    double temp = 0.0;
+    memcpy( &temp, value, sizeof( UInt64 ) );
+    add( &temp );
+    memcpy( value, &temp, sizeof( UInt64 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( double *values, unsigned int count )
+{
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        add( &values[ i ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( std::vector< double > *values, unsigned int size )
+{
+    if ( _mode == Restore ) values->resize( size, 0.0 );
+
+    for ( unsigned int i = 0; i < size; i++ )
+    {
+        double temp = ( i < values->size() ) ? (*values)[ i ] : 0.0;
+        add( &temp );
+        if ( _mode == Restore ) (*values)[ i ] = temp;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( VectorN *vect )
+{
+    for ( unsigned int i = 0; i < vect->getSize(); i++ )
+    {
+        add( &(*vect)( i ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchive::add( Quaternion *quat )
+{
+    add( &quat->e0() );
+    add( &quat->ex() );
+    add( &quat->ey() );
+    add( &quat->ez() );
+}
@@ -0,0 +1,198 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_STATEARCHIVE_H
+#define FDM_STATEARCHIVE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/utils/fdm_Matrix.h>
+#include <fdm/utils/fdm_Quaternion.h>
+#include <fdm/utils/fdm_Vector.h>
+#include <fdm/utils/fdm_VectorN.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Model state archive class.
+ *
+ * Archive walks over model internal states in one of three modes: counting
+ * values, saving them to the array of doubles or restoring them from such
+ * array. Every class with internal states has a single archiveState()
+ * function which adds its states in a fixed order, so the same function
+ * defines state size, saving and restoring and they cannot get out of sync.
+ * Integers, booleans and enumerations are stored as doubles, 64-bit
+ * integers are copied bitwise.
+ */
+class FDMEXPORT StateArchive
+{
+public:
+
+    /** Archive mode. */
+    enum Mode
+    {
+        Count = 0,                  ///< counting values
+        Save,                       ///< saving values
+        Restore                     ///< restoring values
+    };
+
+    /** @brief Constructor (counting mode). */
+    StateArchive();
+
+    /**
+     * @brief Constructor (saving mode).
+     * @param data output array of values
+     */
+    StateArchive( double *data );
+
+    /**
+     * @brief Constructor (restoring mode).
+     * @param data array of values
+     */
+    StateArchive( const double *data );
+
+    /**
+     * @brief Adds value.
+     * @param value value to be saved or restored
+     */
+    void add( double *value );
+
+    /**
+     * @brief Adds value.
+     * @param value value to be saved or restored
+     */
+    void add( bool *value );
+
+    /**
+     * @brief Adds value.
+     * @param value value to be saved or restored
+     */
+    void add( int *value );
+
+    /**
+     * @brief Adds value.
+     * @param value value to be saved or restored
+     */
+    void add( unsigned int *value );
+
+    /**
+     * @brief Adds value, value is copied bitwise.
+     * @param value value to be saved or restored
+     */
+    void add( UInt64 *value );
+
+    /**
+     * @brief Adds values.
+     * @param values array of values to be saved or restored
+     * @param count number of values
+     */
+    void add( double *values, unsigned int count );
+
+    /**
+     * @brief Adds values of the given fixed size, vector is resized when
+     * restoring and missing values are saved as zeros.
+     * @param values vector of values to be saved or restored
+     * @param size number of values
+     */
+    void add( std::vector< double > *values, unsigned int size );
+
+    /**
+     * @brief Adds vector, vector size has to be the same when restoring.
+     * @param vect vector to be saved or restored
+     */
+    void add( VectorN *vect );
+
+    /**
+     * @brief Adds quaternion.
+     * @param quat quaternion to be saved or restored
+     */
+    void add( Quaternion *quat );
+
+    /**
+     * @brief Adds vector.
+     * @param vect vector to be saved or restored
+     */
+    template < unsigned int SIZE >
+    inline void add( Vector< SIZE > *vect )
+    {
+        add( vect->getItems(), SIZE );
+    }
+
+    /**
+     * @brief Adds matrix.
+     * @param mtrx matrix to be saved or restored
+     */
+    template < unsigned int ROWS, unsigned int COLS >
+    inline void add( Matrix< ROWS, COLS > *mtrx )
+    {
+        for ( unsigned int r = 0; r < ROWS; r++ )
+        {
+            for ( unsigned int c = 0; c < COLS; c++ )
+            {
+                add( &(*mtrx)( r, c ) );
+            }
+        }
+    }
+
+    /**
+     * @brief Adds enumeration value.
+     * @param value value to be saved or restored
+     */
+    template < typename TYPE >
+    inline void addEnum( TYPE *value )
+    {
+        int temp = static_cast< int >( *value );
+        add( &temp );
+        *value = static_cast< TYPE >( temp );
+    }
+
+    /** @return archive mode */
+    inline Mode getMode() const { return _mode; }
+
+    /** @return true if archive is restoring values */
+    inline bool isRestoring() const { return _mode == Restore; }
+
+    /** @return number of values added so far */
+    inline unsigned int getSize() const { return _size; }
+
+private:
+
+    Mode _mode;                     ///< archive mode
+
+    double *_out;                   ///< output array (saving mode)
+    const double *_inp;             ///< input array (restoring mode)
+
+    unsigned int _size;             ///< number of values added so far
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_STATEARCHIVE_H
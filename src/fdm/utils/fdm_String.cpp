@@ -22,16 +22,74 @@
 
 #include <fdm/utils/fdm_String.h>
 
+#include <cctype>
 #include <cstdio>
+#include <cstdlib>
 #include <sstream>
 #include <cstring>
 
+#include <fdm/fdm_Types.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const int maxDigits = 19;           ///< maximum number of significant digits parsed without library call
+const int maxExp10  = 22;           ///< maximum decimal exponent of double exact power of ten
+
+const UInt64 maxMantissa = 1ULL << 53;   ///< maximum double exact integer mantissa
+
+/** Double exact powers of ten. */
+const double exactPow10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool isDigit( char c )
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool isSpace( char c )
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief Parses number with strtod() copying only the token to keep it bounded.
+ * @param str beginning of the number
+ * @param end end of the text
+ * @param val result value
+ * @return pointer to the first character after the number or null pointer if there is no number
+ */
+const char* parseDoubleSlow( const char *str, const char *end, double *val )
+{
+    const char *token_end = str;
+
+    while ( token_end < end && !isSpace( *token_end ) ) token_end++;
+
+    std::string token( str, token_end - str );
+
+    char *num_end = FDM_NULLPTR;
+    double temp = strtod( token.c_str(), &num_end );
+
+    if ( num_end == token.c_str() ) return FDM_NULLPTR;
+
+    (*val) = temp;
+
+    return str + ( num_end - token.c_str() );
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 std::string String::getFirstLine( const std::string &str )
 {
     std::istringstream iss( str );
@@ -76,6 +134,160 @@ std::vector< std::string > String::split( const std::string &str, const std::str
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void String::split( const std::string &str, char sep, Views *tokens )
+{
+    tokens->clear();
+
+    const char *data = str.c_str();
+    size_t begin = 0;
+
+    for ( size_t i = 0; i < str.size(); i++ )
+    {
+        if ( data[ i ] == sep )
+        {
+            tokens->push_back( View( data + begin, i - begin ) );
+            begin = i + 1;
+        }
+    }
+
+    tokens->push_back( View( data + begin, str.size() - begin ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char* String::parseDouble( const char *str, const char *end, double *val )
+{
+    while ( str < end && isSpace( *str ) ) str++;
+
+    const char *ptr = str;
+
+    bool negative = false;
+
+    if ( ptr < end && ( *ptr == '+' || *ptr == '-' ) )
+    {
+        negative = *ptr == '-';
+        ptr++;
+    }
+
+    UInt64 mantissa = 0;
+
+    int digits = 0;
+    int exp10  = 0;
+
+    bool any = false;
+    bool truncated = false;
+
+    // integer part
+    while ( ptr < end && isDigit( *ptr ) )
+    {
+        any = true;
+
+        if ( mantissa > 0 || *ptr != '0' )
+        {
+            if ( digits < maxDigits )
+            {
+                mantissa = 10 * mantissa + ( *ptr - '0' );
+                digits++;
+            }
+            else
+            {
+                truncated = true;
+                exp10++;
+            }
+        }
+
+        ptr++;
+    }
+
+    // fractional part
+    if ( ptr < end && *ptr == '.' )
+    {
+        ptr++;
+
+        while ( ptr < end && isDigit( *ptr ) )
+        {
+            any = true;
+
+            if ( mantissa > 0 || *ptr != '0' )
+            {
+                if ( digits < maxDigits )
+                {
+                    mantissa = 10 * mantissa + ( *ptr - '0' );
+                    digits++;
+                    exp10--;
+                }
+                else
+                {
+                    truncated = true;
+                }
+            }
+            else
+            {
+                exp10--;
+            }
+
+            ptr++;
+        }
+    }
+
+    if ( !any ) return parseDoubleSlow( str, end, val );
+
+    // exponent
+    if ( ptr < end && ( *ptr == 'e' || *ptr == 'E' ) )
+    {
+        const char *exp_ptr = ptr + 1;
+
+        bool exp_negative = false;
+
+        if ( exp_ptr < end && ( *exp_ptr == '+' || *exp_ptr == '-' ) )
+        {
+            exp_negative = *exp_ptr == '-';
+            exp_ptr++;
+        }
+
+        if ( exp_ptr >= end || !isDigit( *exp_ptr ) ) return parseDoubleSlow( str, end, val );
+
+        int exp = 0;
+
+        while ( exp_ptr < end && isDigit( *exp_ptr ) )
+        {
+            if ( exp < 10000 ) exp = 10 * exp + ( *exp_ptr - '0' );
+            exp_ptr++;
+        }
+
+        exp10 += exp_negative ? -exp : exp;
+        ptr = exp_ptr;
+    }
+
+    // anything unusual is left to the library
+    if ( ptr < end && !isSpace( *ptr ) ) return parseDoubleSlow( str, end, val );
+
+    if ( mantissa == 0 )
+    {
+        (*val) = negative ? -0.0 : 0.0;
+        return ptr;
+    }
+
+    if ( truncated || mantissa > maxMantissa || exp10 > maxExp10 || exp10 < -maxExp10 )
+    {
+        return parseDoubleSlow( str, end, val );
+    }
+
+    // both operands are exact, so the single operation is correctly rounded
+    double result = (double)mantissa;
+
+    if ( exp10 < 0 )
+        result /= exactPow10[ -exp10 ];
+    else
+        result *= exactPow10[ exp10 ];
+
+    (*val) = negative ? -result : result;
+
+    return ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 std::string String::stripLeadingSpaces( const std::string &str )
 {
     unsigned int offset = 0;
@@ -182,6 +394,50 @@ double String::toDouble( const std::string &str, double def )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+int String::toInt( const View &str, int def )
+{
+    const char *ptr = str.data;
+    const char *end = str.data + str.size;
+
+    while ( ptr < end && isSpace( *ptr ) ) ptr++;
+
+    bool negative = false;
+
+    if ( ptr < end && ( *ptr == '+' || *ptr == '-' ) )
+    {
+        negative = *ptr == '-';
+        ptr++;
+    }
+
+    if ( ptr >= end || !isDigit( *ptr ) ) return def;
+
+    long result = 0;
+
+    while ( ptr < end && isDigit( *ptr ) )
+    {
+        result = 10 * result + ( *ptr - '0' );
+        ptr++;
+    }
+
+    return (int)( negative ? -result : result );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double String::toDouble( const View &str, double def )
+{
+    double result = def;
+
+    if ( FDM_NULLPTR == parseDouble( str.data, str.data + str.size, &result ) )
+    {
+        return def;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 std::string String::toString( int val )
 {
     char valueStr[ 255 ];
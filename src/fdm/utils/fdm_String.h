@@ -42,6 +42,29 @@ class FDMEXPORT String
 {
 public:
 
+    /**
+     * @brief Non-owning reference to a part of a string.
+     * View is valid as long as referred string is not modified or destroyed.
+     */
+    struct View
+    {
+        const char *data;               ///< first character
+        size_t size;                    ///< number of characters
+
+        View() : data ( "" ), size ( 0 ) {}
+        View( const char *d, size_t s ) : data ( d ), size ( s ) {}
+
+        inline bool empty() const { return size == 0; }
+        inline size_t length() const { return size; }
+
+        inline char operator[]( size_t index ) const { return data[ index ]; }
+
+        /** @return copy of the referred characters */
+        inline std::string str() const { return std::string( data, size ); }
+    };
+
+    typedef std::vector< View > Views;
+
     /**
      * @brief Returns string first line;
      * @param str string to be processed
@@ -65,6 +88,29 @@ public:
      */
     static std::vector< std::string > split( const std::string &str, const std::string &sep );
 
+    /**
+     * @brief Splits string with the given delimeter without copying.
+     * Tokens are the same as returned by split() but refer to the given
+     * string, so reusing tokens vector does not allocate in steady state.
+     * @param str string to be splitted
+     * @param sep separator character
+     * @param tokens vector of views to be filled with tokens
+     */
+    static void split( const std::string &str, char sep, Views *tokens );
+
+    /**
+     * @brief Parses floating point number.
+     * Leading white spaces are skipped as by strtod(). Numbers with up to
+     * 19 significant digits and decimal exponent within double exact powers
+     * of ten range are parsed without a library call, the result is exactly
+     * the same (correctly rounded), other ones are parsed by the strtod().
+     * @param str beginning of the text
+     * @param end end of the text (one past the last character)
+     * @param val result value
+     * @return pointer to the first character after the number or null pointer if there is no number
+     */
+    static const char* parseDouble( const char *str, const char *end, double *val );
+
     /**
      * @brief Returns string with leading white spaces removed.
      * @param str string to be processed
@@ -113,6 +159,24 @@ public:
     static double toDouble( const std::string &str,
                             double def = std::numeric_limits< double >::quiet_NaN() );
 
+    /**
+     * @brief Converts string into variable.
+     * @param str string to be processed
+     * @param def default value
+     * @return result value
+     */
+    static int toInt( const View &str,
+                      int def = std::numeric_limits< int >::quiet_NaN() );
+
+    /**
+     * @brief Converts string into variable.
+     * @param str string to be processed
+     * @param def default value
+     * @return result value
+     */
+    static double toDouble( const View &str,
+                            double def = std::numeric_limits< double >::quiet_NaN() );
+
     /**
      * @brief Converts variable into string.
      * @param val value to be processed
@@ -35,6 +35,10 @@ using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const unsigned int Table1::_fixedSizeMax = 8;
+
+////////////////////////////////////////////////////////////////////////////////
+
 Table1 Table1::oneRecordTable( double val )
 {
     std::vector< double > keyValues;
@@ -48,11 +52,52 @@ Table1 Table1::oneRecordTable( double val )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+unsigned int Table1::getUniformGridSize( const double *keys, unsigned int size,
+                                         unsigned int max_size )
+{
+    if ( size < 2 ) return 0;
+
+    double range = keys[ size - 1 ] - keys[ 0 ];
+    double step_min = range;
+
+    for ( unsigned int i = 1; i < size; i++ )
+    {
+        double step = keys[ i ] - keys[ i - 1 ];
+        if ( step < step_min ) step_min = step;
+    }
+
+    unsigned int intervals = static_cast< unsigned int >( ceil( range / step_min - 1.0e-6 ) );
+
+    while ( intervals + 1 <= max_size )
+    {
+        bool aligned = true;
+
+        for ( unsigned int i = 1; i < size - 1 && aligned; i++ )
+        {
+            double node = intervals * ( keys[ i ] - keys[ 0 ] ) / range;
+            aligned = fabs( node - floor( node + 0.5 ) ) < 1.0e-9 * intervals;
+        }
+
+        if ( aligned ) return intervals + 1;
+
+        intervals++;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 Table1::Table1() :
     _size ( 0 ),
     _key_values ( FDM_NULLPTR ),
     _table_data ( FDM_NULLPTR ),
-    _inter_data ( FDM_NULLPTR )
+    _inter_data ( FDM_NULLPTR ),
+    _bake_size ( 0 ),
+    _bake_key_min ( 0.0 ),
+    _bake_step_inv ( 0.0 ),
+    _bake_data ( FDM_NULLPTR ),
+    _bake_inter ( FDM_NULLPTR )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,7 +107,12 @@ Table1::Table1( const std::vector< double > &key_values,
     _size ( 0 ),
     _key_values ( FDM_NULLPTR ),
     _table_data ( FDM_NULLPTR ),
-    _inter_data ( FDM_NULLPTR )
+    _inter_data ( FDM_NULLPTR ),
+    _bake_size ( 0 ),
+    _bake_key_min ( 0.0 ),
+    _bake_step_inv ( 0.0 ),
+    _bake_data ( FDM_NULLPTR ),
+    _bake_inter ( FDM_NULLPTR )
 {
     if ( key_values.size() == table_data.size() )
     {
@@ -70,18 +120,15 @@ Table1::Table1( const std::vector< double > &key_values,
 
         if ( _size > 0 )
         {
-            _key_values = new double [ _size ];
-            _table_data = new double [ _size ];
-            _inter_data = new double [ _size ];
+            DataPool::Data data( 3 * _size, 0.0 );
 
             for ( unsigned int i = 0; i < _size; i++ )
             {
-                _key_values[ i ] = key_values[ i ];
-                _table_data[ i ] = table_data[ i ];
-                _inter_data[ i ] = 0.0;
+                data[ i ]         = key_values[ i ];
+                data[ i + _size ] = table_data[ i ];
             }
 
-            updateInterpolationData();
+            createData( &data );
         }
     }
     else
@@ -99,33 +146,21 @@ Table1::Table1( const std::vector< double > &key_values,
 
 Table1::Table1( const Table1 &table ) :
     _size ( table._size ),
-    _key_values ( FDM_NULLPTR ),
-    _table_data ( FDM_NULLPTR ),
-    _inter_data ( FDM_NULLPTR )
-{
-    if ( _size > 0 )
-    {
-        _key_values = new double [ _size ];
-        _table_data = new double [ _size ];
-        _inter_data = new double [ _size ];
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            _key_values[ i ] = table._key_values[ i ];
-            _table_data[ i ] = table._table_data[ i ];
-            _inter_data[ i ] = table._inter_data[ i ];
-        }
-    }
-}
+    _data ( table._data ),
+    _key_values ( table._key_values ),
+    _table_data ( table._table_data ),
+    _inter_data ( table._inter_data ),
+    _bake_size ( table._bake_size ),
+    _bake_key_min ( table._bake_key_min ),
+    _bake_step_inv ( table._bake_step_inv ),
+    _bake ( table._bake ),
+    _bake_data ( table._bake_data ),
+    _bake_inter ( table._bake_inter )
+{}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Table1::~Table1()
-{
-    FDM_DELTAB( _key_values );
-    FDM_DELTAB( _table_data );
-    FDM_DELTAB( _inter_data );
-}
+Table1::~Table1() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -237,33 +272,24 @@ double Table1::getKeyOfValueMax( double key_min, double key_max ) const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifndef FDM_UNCHECKED
 double Table1::getValue( double key_value ) const
 {
     if ( _size > 0 )
     {
+        if ( _size == 1 )
+            return _table_data[ 0 ];
+
         if ( key_value < _key_values[ 0 ] )
             return getFirstValue();
 
         if ( key_value > _key_values[ _size - 1 ] )
             return getLastValue();
 
-        unsigned int key_1 = 0;
-        unsigned int key_2 = 0;
-
-        for ( unsigned int i = 1; i < _size; i++ )
-        {
-            key_1 = i - 1;
-            key_2 = i;
-
-            if ( key_value >= _key_values[ key_1 ]
-              && key_value <  _key_values[ key_2 ] )
-            {
-                break;
-            }
-        }
+        if ( _bake_size > 0 )
+            return getBakedValue( key_value );
 
-        return ( key_value - _key_values[ key_1 ] ) * _inter_data[ key_1 ]
-                + _table_data[ key_1 ];
+        return interpolate( key_value, getKeyIndex( key_value ) );
     }
     else
     {
@@ -277,6 +303,77 @@ double Table1::getValue( double key_value ) const
 
     return std::numeric_limits< double >::quiet_NaN();
 }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Table1::getValue( double key_value, unsigned int &cursor ) const
+{
+#   ifndef FDM_UNCHECKED
+    if ( _size == 0 )
+    {
+        Exception e;
+
+        e.setType( Exception::UnknownException );
+        e.setInfo( "Invalid size of table." );
+
+        FDM_THROW( e );
+    }
+#   endif
+
+    if ( _size == 1 )
+    {
+        cursor = 0;
+        return _table_data[ 0 ];
+    }
+
+    if ( key_value < _key_values[ 0 ] )
+    {
+        cursor = 0;
+        return getFirstValue();
+    }
+
+    if ( key_value > _key_values[ _size - 1 ] )
+    {
+        cursor = _size > 1 ? _size - 2 : 0;
+        return getLastValue();
+    }
+
+    if ( _bake_size > 0 )
+        return getBakedValue( key_value );
+
+    if ( cursor + 1 < _size )
+    {
+        // same interval as previously
+        if ( key_value >= _key_values[ cursor ]
+          && key_value <= _key_values[ cursor + 1 ] )
+        {
+            return interpolate( key_value, cursor );
+        }
+
+        // next interval
+        if ( cursor + 2 < _size
+          && key_value >  _key_values[ cursor + 1 ]
+          && key_value <= _key_values[ cursor + 2 ] )
+        {
+            cursor++;
+            return interpolate( key_value, cursor );
+        }
+
+        // previous interval
+        if ( cursor > 0
+          && key_value <  _key_values[ cursor ]
+          && key_value >= _key_values[ cursor - 1 ] )
+        {
+            cursor--;
+            return interpolate( key_value, cursor );
+        }
+    }
+
+    cursor = getKeyIndex( key_value );
+
+    return interpolate( key_value, cursor );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -363,26 +460,135 @@ bool Table1::isValid() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Table1::multiplyKeys( double factor )
+bool Table1::bake( double tolerance, unsigned int max_size )
 {
-    for ( unsigned int i = 0; i < _size; i++ )
+    deleteBakedData();
+
+    if ( _size < 2 || !isValid() ) return false;
+
+    double range = _key_values[ _size - 1 ] - _key_values[ 0 ];
+
+    // grid containing all the original breakpoints is exact, if there is
+    // no such grid the finest one is refined until tolerance is met
+    unsigned int size = getUniformGridSize( _key_values, _size, max_size );
+
+    if ( size == 0 )
     {
-        _key_values[ i ] *= factor;
+        double step_min = range;
+
+        for ( unsigned int i = 1; i < _size; i++ )
+        {
+            double step = _key_values[ i ] - _key_values[ i - 1 ];
+            if ( step < step_min ) step_min = step;
+        }
+
+        size = static_cast< unsigned int >( ceil( range / step_min - 1.0e-6 ) ) + 1;
     }
 
-    updateInterpolationData();
+    while ( size <= max_size )
+    {
+        double step = range / static_cast< double >( size - 1 );
+
+        DataPool::Data bake( 2 * size, 0.0 );
+
+        double *data  = bake.data();
+        double *inter = data + size;
+
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            data[ i ] = getValue( _key_values[ 0 ] + step * i );
+        }
+
+        data[ size - 1 ] = getLastValue();
+
+        for ( unsigned int i = 0; i < size - 1; i++ )
+        {
+            inter[ i ] = data[ i + 1 ] - data[ i ];
+        }
+
+        _bake_size     = size;
+        _bake_key_min  = _key_values[ 0 ];
+        _bake_step_inv = 1.0 / step;
+        _bake          = std::make_shared< DataPool::Data >( std::move( bake ) );
+        _bake_data     = _bake->data();
+        _bake_inter    = _bake_data + size;
+
+        // both tables are piecewise linear and baked table is exact at its
+        // grid nodes, so the maximum error is at the original breakpoints
+        double error_max = 0.0;
+
+        for ( unsigned int i = 0; i < _size; i++ )
+        {
+            double error = fabs( getBakedValue( _key_values[ i ] ) - _table_data[ i ] );
+            if ( error > error_max ) error_max = error;
+        }
+
+        if ( error_max <= tolerance )
+        {
+            return true;
+        }
+
+        deleteBakedData();
+
+        size = 2 * ( size - 1 ) + 1;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1::multiplyKeys( double factor )
+{
+    deleteBakedData();
+
+    if ( _size > 0 )
+    {
+        DataPool::Data data( *_data );
+
+        for ( unsigned int i = 0; i < _size; i++ )
+        {
+            data[ i ] *= factor;
+        }
+
+        createData( &data );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Table1::multiplyValues( double factor )
 {
-    for ( unsigned int i = 0; i < _size; i++ )
+    deleteBakedData();
+
+    if ( _size > 0 )
+    {
+        DataPool::Data data( *_data );
+
+        for ( unsigned int i = 0; i < _size; i++ )
+        {
+            data[ i + _size ] *= factor;
+        }
+
+        createData( &data );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1::share()
+{
+    if ( _data )
     {
-        _table_data[ i ] *= factor;
+        setData( DataPool::share( _data ) );
     }
 
-    updateInterpolationData();
+    if ( _bake )
+    {
+        _bake = DataPool::share( _bake );
+        _bake_data  = _bake->data();
+        _bake_inter = _bake_data + _bake_size;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -403,26 +609,22 @@ std::string Table1::toString()
 
 const Table1& Table1::operator= ( const Table1 &table )
 {
-    FDM_DELTAB( _key_values );
-    FDM_DELTAB( _table_data );
-    FDM_DELTAB( _inter_data );
-
     _size = table._size;
 
-    if ( _size > 0 )
-    {
-        _key_values = new double [ _size ];
-        _table_data = new double [ _size ];
+    _data = table._data;
 
-        _inter_data = new double [ _size ];
+    _key_values = table._key_values;
+    _table_data = table._table_data;
+    _inter_data = table._inter_data;
 
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            _key_values[ i ] = table._key_values [ i ];
-            _table_data[ i ] = table._table_data [ i ];
-            _inter_data[ i ] = table._inter_data [ i ];
-        }
-    }
+    _bake_size     = table._bake_size;
+    _bake_key_min  = table._bake_key_min;
+    _bake_step_inv = table._bake_step_inv;
+
+    _bake = table._bake;
+
+    _bake_data  = table._bake_data;
+    _bake_inter = table._bake_inter;
 
     return (*this);
 }
@@ -463,11 +665,81 @@ Table1 Table1::operator* ( double val ) const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Table1::updateInterpolationData()
+void Table1::deleteBakedData()
+{
+    _bake_size = 0;
+
+    _bake_key_min  = 0.0;
+    _bake_step_inv = 0.0;
+
+    _bake.reset();
+
+    _bake_data  = FDM_NULLPTR;
+    _bake_inter = FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Table1::getKeyIndex( double key_value ) const
 {
+    static_assert( _fixedSizeMax == 8, "Fixed size search cases have to match _fixedSizeMax." );
+
+    if ( _size <= _fixedSizeMax )
+    {
+        switch ( _size )
+        {
+            case 1: return 0;
+            case 2: return 0;
+            case 3: return getKeyIndexFixed< 3 >( key_value );
+            case 4: return getKeyIndexFixed< 4 >( key_value );
+            case 5: return getKeyIndexFixed< 5 >( key_value );
+            case 6: return getKeyIndexFixed< 6 >( key_value );
+            case 7: return getKeyIndexFixed< 7 >( key_value );
+            case 8: return getKeyIndexFixed< 8 >( key_value );
+        }
+    }
+
+    unsigned int key_1 = 0;
+    unsigned int key_2 = _size - 1;
+
+    while ( key_2 - key_1 > 1 )
+    {
+        unsigned int key_m = ( key_1 + key_2 ) / 2;
+
+        if ( key_value < _key_values[ key_m ] )
+            key_2 = key_m;
+        else
+            key_1 = key_m;
+    }
+
+    return key_1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1::createData( DataPool::Data *data )
+{
+    const double *keys   = data->data();
+    const double *values = keys + _size;
+
+    double *inter = data->data() + 2 * _size;
+
     for ( unsigned int i = 0; i < _size - 1; i++ )
     {
-        _inter_data[ i ] = ( _table_data[ i + 1 ] - _table_data[ i ] )
-                         / ( _key_values[ i + 1 ] - _key_values[ i ] );
+        inter[ i ] = ( values[ i + 1 ] - values[ i ] )
+                   / ( keys[ i + 1 ] - keys[ i ] );
     }
+
+    setData( std::make_shared< DataPool::Data >( std::move( *data ) ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1::setData( const DataPool::DataPtr &data )
+{
+    _data = data;
+
+    _key_values = _data->data();
+    _table_data = _key_values + _size;
+    _inter_data = _table_data + _size;
 }
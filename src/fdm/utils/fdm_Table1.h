@@ -24,11 +24,15 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+#include <limits>
 #include <string>
 #include <vector>
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_DataPool.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -36,17 +40,35 @@ namespace fdm
 
 /**
  * @brief 1D table and linear interpolation class.
+ *
+ * Table data are stored in immutable reference-counted blocks. Copying table
+ * doesn't copy data, modifying operations create new block.
+ *
+ * @see DataPool
  */
 class FDMEXPORT Table1
 {
 public:
 
+    static const unsigned int _fixedSizeMax;    ///< maximum size of table using fixed size search
+
     /**
      * @brief Creates table with only one record.
      * @param val record value
      */
     static Table1 oneRecordTable( double val = 0.0 );
 
+    /**
+     * @brief Returns number of uniform grid nodes containing all given keys.
+     * Used to resample tables onto uniform grid without any loss of accuracy.
+     * @param keys strictly ascending keys values array
+     * @param size number of keys
+     * @param max_size maximum number of grid nodes
+     * @return number of grid nodes on success or 0 if there is no such grid
+     */
+    static unsigned int getUniformGridSize( const double *keys, unsigned int size,
+                                            unsigned int max_size );
+
     /** @brief Constructor. */
     Table1();
 
@@ -54,7 +76,7 @@ public:
     Table1( const std::vector< double > &key_values,
             const std::vector< double > &table_data );
 
-    /** @brief Copy constructor. */
+    /** @brief Copy constructor (shares table data). */
     Table1( const Table1 &table );
 
     /** @brief Destructor. */
@@ -101,11 +123,41 @@ public:
     /**
      * @brief Returns table value for the given key.
      * Returns table value for the given key value using linear interpolation
-     * algorithm.
+     * algorithm. If FDM_UNCHECKED is defined table size is not checked and
+     * function is inlined, tables are validated when read instead.
      * @param key_value key value
      * @return interpolated value on success or NaN on failure
      */
+#   ifdef FDM_UNCHECKED
+    inline double getValue( double key_value ) const
+    {
+        if ( key_value <= _key_values[ 0 ] )
+            return _table_data[ 0 ];
+
+        if ( key_value > _key_values[ _size - 1 ] )
+            return _table_data[ _size - 1 ];
+
+        if ( _bake_size > 0 )
+            return getBakedValue( key_value );
+
+        return interpolate( key_value, getKeyIndex( key_value ) );
+    }
+#   else
     double getValue( double key_value ) const;
+#   endif
+
+    /**
+     * @brief Returns table value for the given key.
+     * Returns table value for the given key value using linear interpolation
+     * algorithm. Given cursor holds index of the last used interval and is
+     * checked (along with its neighbours) before performing binary search,
+     * so temporally coherent lookups are resolved in constant time. Each
+     * caller should keep its own cursor.
+     * @param key_value key value
+     * @param cursor last used interval index (input and output)
+     * @return interpolated value on success or NaN on failure
+     */
+    double getValue( double key_value, unsigned int &cursor ) const;
 
     /**
      * @brief Returns table value for the given key index.
@@ -144,6 +196,22 @@ public:
      */
     bool isValid() const;
 
+    /**
+     * @brief Resamples table onto uniform grid.
+     * Baked table lookups doesn't require any searching. Resampled table is
+     * checked against the original breakpoints and is used only if the
+     * maximum error doesn't exceed given tolerance. Grid is refined until
+     * tolerance is met or maximum size is exceeded. Baked data is discarded
+     * when table keys or values are modified.
+     * @param tolerance maximum allowed absolute error
+     * @param max_size maximum number of baked grid elements
+     * @return true on success, false if tolerance cannot be met
+     */
+    bool bake( double tolerance, unsigned int max_size = 4096 );
+
+    /** @brief Returns true if table lookups use baked uniform grid. */
+    inline bool isBaked() const { return _bake_size > 0; }
+
     /**
      * @brief Multiplies keys by the given factor.
      * @param factor given factor
@@ -156,12 +224,20 @@ public:
      */
     void multiplyValues( double factor );
 
+    /**
+     * @brief Shares table data with all identical tables.
+     * Replaces table data with the identical block registered in the data
+     * pool, registers table data if there is no such block.
+     * @see DataPool::share()
+     */
+    void share();
+
     /**
      * @brief Returns string representation of the table.
      */
     std::string toString();
 
-    /** @brief Assignment operator. */
+    /** @brief Assignment operator (shares table data). */
     const Table1& operator= ( const Table1 &table );
 
     /** @brief Addition operator. */
@@ -174,25 +250,112 @@ private:
 
     unsigned int _size;     ///< number of table elements
 
-    double *_key_values;    ///< key values
-    double *_table_data;    ///< table data
+    DataPool::DataPtr _data;    ///< keys values, table data and interpolation data
 
-    double *_inter_data;    ///< interpolation data matrix
+    const double *_key_values;  ///< key values
+    const double *_table_data;  ///< table data
 
-    /** Updates interpolation data due to table data. */
-    void updateInterpolationData();
-};
+    const double *_inter_data;  ///< interpolation data matrix
 
-} // end of fdm namespace
+    unsigned int _bake_size;    ///< number of baked uniform grid elements
 
-////////////////////////////////////////////////////////////////////////////////
+    double _bake_key_min;       ///< baked grid first key value
+    double _bake_step_inv;      ///< baked grid inverted key step
+
+    DataPool::DataPtr _bake;    ///< baked table data and interpolation data
+
+    const double *_bake_data;   ///< baked table data
+    const double *_bake_inter;  ///< baked interpolation data
+
+    /** @brief Deletes baked data. */
+    void deleteBakedData();
+
+    /**
+     * @brief Returns value interpolated using baked uniform grid.
+     * Key value should be within table range, grid position is clamped
+     * before it is converted to index.
+     * @param key_value key value
+     * @return interpolated value, NaN if key value is not finite
+     */
+    inline double getBakedValue( double key_value ) const
+    {
+        double x = ( key_value - _bake_key_min ) * _bake_step_inv;
+
+        if ( !std::isfinite( x ) ) return std::numeric_limits< double >::quiet_NaN();
+
+        x = x > 0.0 ? x : 0.0;
+        x = x < _bake_size - 1 ? x : _bake_size - 1;
+
+        unsigned int i = static_cast< unsigned int >( x );
+        if ( i > _bake_size - 2 ) i = _bake_size - 2;
+        return ( x - i ) * _bake_inter[ i ] + _bake_data[ i ];
+    }
+
+    /**
+     * @brief Returns index of interval containing given key value.
+     * Tables of up to _fixedSizeMax elements use search specialized for
+     * the table size, bigger tables use binary search. Key value has to be
+     * within table range.
+     * @param key_value key value
+     * @return index of interval lower bound
+     */
+    unsigned int getKeyIndex( double key_value ) const;
+
+    /**
+     * @brief Returns index of interval containing given key value.
+     * Counts inner breakpoints not greater than key value. Loop bounds are
+     * known at compile time, so the loop is unrolled and has no branches.
+     * Key value has to be within table range.
+     * @tparam SIZE table size
+     * @param key_value key value
+     * @return index of interval lower bound
+     */
+    template < unsigned int SIZE >
+    inline unsigned int getKeyIndexFixed( double key_value ) const
+    {
+        unsigned int key_index = 0;
+
+        for ( unsigned int i = 1; i < SIZE - 1; i++ )
+        {
+            key_index += ( key_value >= _key_values[ i ] ) ? 1 : 0;
+        }
+
+        return key_index;
+    }
+
+    /**
+     * @brief Returns value interpolated within given interval.
+     * @param key_value key value
+     * @param key_index index of interval lower bound
+     * @return interpolated value
+     */
+    inline double interpolate( double key_value, unsigned int key_index ) const
+    {
+        return ( key_value - _key_values[ key_index ] ) * _inter_data[ key_index ]
+                + _table_data[ key_index ];
+    }
+
+    /**
+     * @brief Computes interpolation data and moves given data into new block.
+     * @param data keys values, table data and interpolation data
+     */
+    void createData( DataPool::Data *data );
+
+    /**
+     * @brief Sets table data block.
+     * @param data keys values, table data and interpolation data
+     */
+    void setData( const DataPool::DataPtr &data );
+};
 
 /** @brief Multiplication operator (by scalar). */
-inline fdm::Table1 operator* ( double val, const fdm::Table1 &table )
+inline Table1 operator* ( double val, const Table1 &table )
 {
     return ( table * val );
 }
 
+} // end of fdm namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // FDM_TABLE1_H
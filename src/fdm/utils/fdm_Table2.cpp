@@ -57,7 +57,14 @@ Table2::Table2() :
     _row_values ( FDM_NULLPTR ),
     _col_values ( FDM_NULLPTR ),
     _table_data ( FDM_NULLPTR ),
-    _inter_data ( FDM_NULLPTR )
+    _inter_data ( FDM_NULLPTR ),
+    _bake_rows ( 0 ),
+    _bake_cols ( 0 ),
+    _bake_row_min ( 0.0 ),
+    _bake_col_min ( 0.0 ),
+    _bake_row_step_inv ( 0.0 ),
+    _bake_col_step_inv ( 0.0 ),
+    _bake_data ( FDM_NULLPTR )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -71,7 +78,14 @@ Table2::Table2( const std::vector< double > &row_values,
     _row_values ( FDM_NULLPTR ),
     _col_values ( FDM_NULLPTR ),
     _table_data ( FDM_NULLPTR ),
-    _inter_data ( FDM_NULLPTR )
+    _inter_data ( FDM_NULLPTR ),
+    _bake_rows ( 0 ),
+    _bake_cols ( 0 ),
+    _bake_row_min ( 0.0 ),
+    _bake_col_min ( 0.0 ),
+    _bake_row_step_inv ( 0.0 ),
+    _bake_col_step_inv ( 0.0 ),
+    _bake_data ( FDM_NULLPTR )
 {
     if ( row_values.size() * col_values.size() == table_data.size() )
     {
@@ -82,22 +96,17 @@ Table2::Table2( const std::vector< double > &row_values,
             _rows = row_values.size();
             _cols = col_values.size();
 
-            _row_values = new double [ _rows ];
-            _col_values = new double [ _cols ];
-            _table_data = new double [ _size ];
+            DataPool::Data data( _rows + _cols + 2 * _size, 0.0 );
 
-            _inter_data = new double [ _size ];
-
-            for ( unsigned int i = 0; i < _rows; i++ ) _row_values[ i ] = row_values[ i ];
-            for ( unsigned int i = 0; i < _cols; i++ ) _col_values[ i ] = col_values[ i ];
+            for ( unsigned int i = 0; i < _rows; i++ ) data[ i ] = row_values[ i ];
+            for ( unsigned int i = 0; i < _cols; i++ ) data[ _rows + i ] = col_values[ i ];
 
             for ( unsigned int i = 0; i < _size; i++ )
             {
-                _table_data[ i ] = table_data[ i ];
-                _inter_data[ i ] = 0.0;
+                data[ _rows + _cols + i ] = table_data[ i ];
             }
 
-            updateInterpolationData();
+            createData( &data );
         }
     }
     else
@@ -117,39 +126,24 @@ Table2::Table2( const Table2 &table ) :
     _rows ( table._rows ),
     _cols ( table._cols ),
     _size ( table._size ),
-    _row_values ( FDM_NULLPTR ),
-    _col_values ( FDM_NULLPTR ),
-    _table_data ( FDM_NULLPTR ),
-    _inter_data ( FDM_NULLPTR )
-{
-    if ( _size > 0 )
-    {
-        _row_values = new double [ _rows ];
-        _col_values = new double [ _cols ];
-        _table_data = new double [ _size ];
-
-        _inter_data = new double [ _size ];
-
-        for ( unsigned int i = 0; i < _rows; i++ ) _row_values[ i ] = table._row_values[ i ];
-        for ( unsigned int i = 0; i < _cols; i++ ) _col_values[ i ] = table._col_values[ i ];
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            _table_data[ i ] = table._table_data[ i ];
-            _inter_data[ i ] = table._inter_data[ i ] ;
-        }
-    }
-}
+    _data ( table._data ),
+    _row_values ( table._row_values ),
+    _col_values ( table._col_values ),
+    _table_data ( table._table_data ),
+    _inter_data ( table._inter_data ),
+    _bake_rows ( table._bake_rows ),
+    _bake_cols ( table._bake_cols ),
+    _bake_row_min ( table._bake_row_min ),
+    _bake_col_min ( table._bake_col_min ),
+    _bake_row_step_inv ( table._bake_row_step_inv ),
+    _bake_col_step_inv ( table._bake_col_step_inv ),
+    _bake ( table._bake ),
+    _bake_data ( table._bake_data )
+{}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Table2::~Table2()
-{
-    FDM_DELTAB( _row_values );
-    FDM_DELTAB( _col_values );
-    FDM_DELTAB( _table_data );
-    FDM_DELTAB( _inter_data );
-}
+Table2::~Table2() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -171,51 +165,137 @@ Table1 Table2::getTable( double col_value ) const
 
 double Table2::getValue( double row_value, double col_value ) const
 {
-    if ( _size > 0 )
+#   ifndef FDM_UNCHECKED
+    if ( _size == 0 )
     {
-        if ( row_value < _row_values[ 0 ] ) return getValue( _row_values[ 0 ], col_value );
-        if ( col_value < _col_values[ 0 ] ) return getValue( row_value, _col_values[ 0 ] );
+        Exception e;
 
-        if ( row_value > _row_values[ _rows - 1 ] ) return getValue( _row_values[ _rows - 1 ], col_value );
-        if ( col_value > _col_values[ _cols - 1 ] ) return getValue( row_value, _col_values[ _cols - 1 ] );
+        e.setType( Exception::UnknownException );
+        e.setInfo( "Invalid table size." );
 
-        unsigned int row_1 = 0;
-        unsigned int row_2 = 0;
+        FDM_THROW( e );
+    }
+#   endif
 
-        for ( unsigned int r = 1; r < _rows; r++ )
-        {
-            row_1 = r - 1;
-            row_2 = r;
+    if ( row_value < _row_values[ 0 ] ) return getValue( _row_values[ 0 ], col_value );
+    if ( col_value < _col_values[ 0 ] ) return getValue( row_value, _col_values[ 0 ] );
 
-            if ( row_value >= _row_values[ row_1 ] && row_value < _row_values[ row_2 ] ) break;
-        }
+    if ( row_value > _row_values[ _rows - 1 ] ) return getValue( _row_values[ _rows - 1 ], col_value );
+    if ( col_value > _col_values[ _cols - 1 ] ) return getValue( row_value, _col_values[ _cols - 1 ] );
 
-        unsigned int col_1 = 0;
-        unsigned int col_2 = 0;
+    if ( _bake_rows > 0 ) return getBakedValue( row_value, col_value );
 
-        for ( unsigned int c = 1; c < _cols; c++ )
-        {
-            col_1 = c - 1;
-            col_2 = c;
+    unsigned int row_1 = 0;
+    unsigned int row_2 = 0;
 
-            if ( col_value >= _col_values[ col_1 ] && col_value < _col_values[ col_2 ] ) break;
-        }
+    for ( unsigned int r = 1; r < _rows; r++ )
+    {
+        row_1 = r - 1;
+        row_2 = r;
+
+        if ( row_value >= _row_values[ row_1 ] && row_value < _row_values[ row_2 ] ) break;
+    }
+
+    unsigned int col_1 = 0;
+    unsigned int col_2 = 0;
+
+    for ( unsigned int c = 1; c < _cols; c++ )
+    {
+        col_1 = c - 1;
+        col_2 = c;
+
+        if ( col_value >= _col_values[ col_1 ] && col_value < _col_values[ col_2 ] ) break;
+    }
+
+    double result_1 = ( col_value - _col_values[ col_1 ] ) * _inter_data[ row_1 * _cols + col_1 ]
+                    + _table_data[ row_1 * _cols + col_1 ];
+
+    double result_2 = ( col_value - _col_values[ col_1 ] ) * _inter_data[ row_2 * _cols + col_1 ]
+                    + _table_data[ row_2 * _cols + col_1 ];
 
-        double result_1 = ( col_value - _col_values[ col_1 ] ) * _inter_data[ row_1 * _cols + col_1 ]
-                        + _table_data[ row_1 * _cols + col_1 ];
+    double rowDelta  = _row_values[ row_2 ] - _row_values[ row_1 ];
+    double rowFactor = 0.0;
 
-        double result_2 = ( col_value - _col_values[ col_1 ] ) * _inter_data[ row_2 * _cols + col_1 ]
-                        + _table_data[ row_2 * _cols + col_1 ];
+    if ( fabs( rowDelta ) > 1.0e-16 )
+    {
+        rowFactor = ( row_value - _row_values[ row_1 ] ) / rowDelta;
+    }
 
-        double rowDelta  = _row_values[ row_2 ] - _row_values[ row_1 ];
-        double rowFactor = 0.0;
+    return rowFactor * ( result_2 - result_1 ) + result_1;
+}
 
-        if ( fabs( rowDelta ) > 1.0e-16 )
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2::getValues( unsigned int count,
+                        const double *row_values, const double *col_values,
+                        double *values ) const
+{
+    if ( _size > 0 )
+    {
+        const double row_min = _row_values[ 0 ];
+        const double col_min = _col_values[ 0 ];
+        const double row_max = _row_values[ _rows - 1 ];
+        const double col_max = _col_values[ _cols - 1 ];
+
+        for ( unsigned int i = 0; i < count; i++ )
         {
-            rowFactor = ( row_value - _row_values[ row_1 ] ) / rowDelta;
-        }
+            double row_value = row_values[ i ];
+            double col_value = col_values[ i ];
+
+            if ( row_value < row_min ) row_value = row_min;
+            if ( col_value < col_min ) col_value = col_min;
+
+            if ( row_value > row_max ) row_value = row_max;
+            if ( col_value > col_max ) col_value = col_max;
+
+            if ( _bake_rows > 0 )
+            {
+                values[ i ] = getBakedValue( row_value, col_value );
+                continue;
+            }
+
+            unsigned int row_1 = 0;
+            unsigned int row_2 = _rows - 1;
+
+            while ( row_2 - row_1 > 1 )
+            {
+                unsigned int row_m = ( row_1 + row_2 ) / 2;
+
+                if ( row_value < _row_values[ row_m ] )
+                    row_2 = row_m;
+                else
+                    row_1 = row_m;
+            }
+
+            unsigned int col_1 = 0;
+            unsigned int col_2 = _cols - 1;
+
+            while ( col_2 - col_1 > 1 )
+            {
+                unsigned int col_m = ( col_1 + col_2 ) / 2;
+
+                if ( col_value < _col_values[ col_m ] )
+                    col_2 = col_m;
+                else
+                    col_1 = col_m;
+            }
+
+            double result_1 = ( col_value - _col_values[ col_1 ] ) * _inter_data[ row_1 * _cols + col_1 ]
+                            + _table_data[ row_1 * _cols + col_1 ];
+
+            double result_2 = ( col_value - _col_values[ col_1 ] ) * _inter_data[ row_2 * _cols + col_1 ]
+                            + _table_data[ row_2 * _cols + col_1 ];
 
-        return rowFactor * ( result_2 - result_1 ) + result_1;
+            double rowDelta  = _row_values[ row_2 ] - _row_values[ row_1 ];
+            double rowFactor = 0.0;
+
+            if ( fabs( rowDelta ) > 1.0e-16 )
+            {
+                rowFactor = ( row_value - _row_values[ row_1 ] ) / rowDelta;
+            }
+
+            values[ i ] = rowFactor * ( result_2 - result_1 ) + result_1;
+        }
     }
     else
     {
@@ -226,8 +306,6 @@ double Table2::getValue( double row_value, double col_value ) const
 
         FDM_THROW( e );
     }
-
-    return std::numeric_limits< double >::quiet_NaN();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -245,6 +323,30 @@ double Table2::getValueByIndex( unsigned int row_index, unsigned int col_index )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+double Table2::getRowValue( unsigned int row_index ) const
+{
+    if ( row_index < _rows )
+    {
+        return _row_values[ row_index ];
+    }
+
+    return std::numeric_limits< double >::quiet_NaN();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double Table2::getColValue( unsigned int col_index ) const
+{
+    if ( col_index < _cols )
+    {
+        return _col_values[ col_index ];
+    }
+
+    return std::numeric_limits< double >::quiet_NaN();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool Table2::isValid() const
 {
     bool result = ( _size > 0 ) ? true : false;
@@ -289,55 +391,216 @@ bool Table2::isValid() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Table2::multiplyColsAndRows( double f_cols, double f_rows )
+bool Table2::bake( double tolerance, unsigned int max_size )
 {
-    for ( unsigned int i = 0; i < _cols; i++ )
+    deleteBakedData();
+
+    if ( _rows < 2 || _cols < 2 || !isValid() ) return false;
+
+    double row_range = _row_values[ _rows - 1 ] - _row_values[ 0 ];
+    double col_range = _col_values[ _cols - 1 ] - _col_values[ 0 ];
+
+    // grid containing all the original breakpoints is exact, if there is
+    // no such grid the finest one is refined until tolerance is met
+    unsigned int rows = Table1::getUniformGridSize( _row_values, _rows, max_size / 2 );
+    unsigned int cols = Table1::getUniformGridSize( _col_values, _cols, max_size / 2 );
+
+    if ( rows == 0 )
     {
-        _col_values[ i ] *= f_cols;
+        double row_step_min = row_range;
+
+        for ( unsigned int r = 1; r < _rows; r++ )
+        {
+            double step = _row_values[ r ] - _row_values[ r - 1 ];
+            if ( step < row_step_min ) row_step_min = step;
+        }
+
+        rows = static_cast< unsigned int >( ceil( row_range / row_step_min - 1.0e-6 ) ) + 1;
     }
 
-    for ( unsigned int i = 0; i < _rows; i++ )
+    if ( cols == 0 )
+    {
+        double col_step_min = col_range;
+
+        for ( unsigned int c = 1; c < _cols; c++ )
+        {
+            double step = _col_values[ c ] - _col_values[ c - 1 ];
+            if ( step < col_step_min ) col_step_min = step;
+        }
+
+        cols = static_cast< unsigned int >( ceil( col_range / col_step_min - 1.0e-6 ) ) + 1;
+    }
+
+    while ( rows * cols <= max_size )
     {
-        _row_values[ i ] *= f_rows;
+        double row_step = row_range / static_cast< double >( rows - 1 );
+        double col_step = col_range / static_cast< double >( cols - 1 );
+
+        DataPool::Data bake( rows * cols, 0.0 );
+
+        double *data = bake.data();
+
+        for ( unsigned int r = 0; r < rows; r++ )
+        {
+            double row_value = ( r < rows - 1 ) ? _row_values[ 0 ] + row_step * r
+                                                : _row_values[ _rows - 1 ];
+
+            for ( unsigned int c = 0; c < cols; c++ )
+            {
+                double col_value = ( c < cols - 1 ) ? _col_values[ 0 ] + col_step * c
+                                                    : _col_values[ _cols - 1 ];
+
+                data[ r * cols + c ] = getValue( row_value, col_value );
+            }
+        }
+
+        _bake_rows = rows;
+        _bake_cols = cols;
+
+        _bake_row_min = _row_values[ 0 ];
+        _bake_col_min = _col_values[ 0 ];
+
+        _bake_row_step_inv = 1.0 / row_step;
+        _bake_col_step_inv = 1.0 / col_step;
+
+        _bake = std::make_shared< DataPool::Data >( std::move( bake ) );
+        _bake_data = _bake->data();
+
+        // checking original breakpoints and original cells centers
+        double error_max = 0.0;
+
+        for ( unsigned int r = 0; r < _rows; r++ )
+        {
+            for ( unsigned int c = 0; c < _cols; c++ )
+            {
+                double error = fabs( getBakedValue( _row_values[ r ], _col_values[ c ] )
+                                   - _table_data[ r * _cols + c ] );
+                if ( error > error_max ) error_max = error;
+
+                if ( r < _rows - 1 && c < _cols - 1 )
+                {
+                    double row_value = 0.5 * ( _row_values[ r ] + _row_values[ r + 1 ] );
+                    double col_value = 0.5 * ( _col_values[ c ] + _col_values[ c + 1 ] );
+
+                    _bake_rows = 0;
+                    double value = getValue( row_value, col_value );
+                    _bake_rows = rows;
+
+                    error = fabs( getBakedValue( row_value, col_value ) - value );
+                    if ( error > error_max ) error_max = error;
+                }
+            }
+        }
+
+        if ( error_max <= tolerance )
+        {
+            return true;
+        }
+
+        deleteBakedData();
+
+        rows = 2 * ( rows - 1 ) + 1;
+        cols = 2 * ( cols - 1 ) + 1;
     }
 
-    updateInterpolationData();
+    return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Table2::multiplyCols( double factor )
+void Table2::multiplyColsAndRows( double f_cols, double f_rows )
 {
-    for ( unsigned int i = 0; i < _cols; i++ )
+    deleteBakedData();
+
+    if ( _size > 0 )
     {
-        _col_values[ i ] *= factor;
+        DataPool::Data data( *_data );
+
+        for ( unsigned int i = 0; i < _cols; i++ )
+        {
+            data[ _rows + i ] *= f_cols;
+        }
+
+        for ( unsigned int i = 0; i < _rows; i++ )
+        {
+            data[ i ] *= f_rows;
+        }
+
+        createData( &data );
     }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2::multiplyCols( double factor )
+{
+    deleteBakedData();
+
+    if ( _size > 0 )
+    {
+        DataPool::Data data( *_data );
+
+        for ( unsigned int i = 0; i < _cols; i++ )
+        {
+            data[ _rows + i ] *= factor;
+        }
 
-    updateInterpolationData();
+        createData( &data );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Table2::multiplyRows( double factor )
 {
-    for ( unsigned int i = 0; i < _rows; i++ )
+    deleteBakedData();
+
+    if ( _size > 0 )
     {
-        _row_values[ i ] *= factor;
-    }
+        DataPool::Data data( *_data );
+
+        for ( unsigned int i = 0; i < _rows; i++ )
+        {
+            data[ i ] *= factor;
+        }
 
-    updateInterpolationData();
+        createData( &data );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Table2::multiplyValues( double factor )
 {
-    for ( unsigned int i = 0; i < _size; i++ )
+    deleteBakedData();
+
+    if ( _size > 0 )
     {
-        _table_data[ i ] *= factor;
+        DataPool::Data data( *_data );
+
+        for ( unsigned int i = 0; i < _size; i++ )
+        {
+            data[ _rows + _cols + i ] *= factor;
+        }
+
+        createData( &data );
     }
+}
 
-    updateInterpolationData();
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2::share()
+{
+    if ( _data )
+    {
+        setData( DataPool::share( _data ) );
+    }
+
+    if ( _bake )
+    {
+        _bake = DataPool::share( _bake );
+        _bake_data = _bake->data();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -374,47 +637,81 @@ std::string Table2::toString()
 
 const Table2& Table2::operator= ( const Table2 &table )
 {
-    FDM_DELTAB( _row_values );
-    FDM_DELTAB( _col_values );
-    FDM_DELTAB( _table_data );
-    FDM_DELTAB( _inter_data );
-
     _rows = table._rows;
     _cols = table._cols;
     _size = table._size;
 
-    if ( _size > 0 )
-    {
-        _row_values = new double [ _rows ];
-        _col_values = new double [ _cols ];
-        _table_data = new double [ _size ];
+    _data = table._data;
 
-        _inter_data = new double [ _size ];
+    _row_values = table._row_values;
+    _col_values = table._col_values;
+    _table_data = table._table_data;
+    _inter_data = table._inter_data;
 
-        for ( unsigned int i = 0; i < _rows; i++ ) _row_values[ i ] = table._row_values[ i ];
-        for ( unsigned int i = 0; i < _cols; i++ ) _col_values[ i ] = table._col_values[ i ];
+    _bake_rows = table._bake_rows;
+    _bake_cols = table._bake_cols;
 
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            _table_data[ i ] = table._table_data[ i ];
-            _inter_data[ i ] = table._inter_data[ i ] ;
-        }
-    }
+    _bake_row_min = table._bake_row_min;
+    _bake_col_min = table._bake_col_min;
+
+    _bake_row_step_inv = table._bake_row_step_inv;
+    _bake_col_step_inv = table._bake_col_step_inv;
+
+    _bake = table._bake;
+
+    _bake_data = table._bake_data;
 
     return (*this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Table2::updateInterpolationData()
+void Table2::deleteBakedData()
+{
+    _bake_rows = 0;
+    _bake_cols = 0;
+
+    _bake_row_min = 0.0;
+    _bake_col_min = 0.0;
+
+    _bake_row_step_inv = 0.0;
+    _bake_col_step_inv = 0.0;
+
+    _bake.reset();
+
+    _bake_data = FDM_NULLPTR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2::createData( DataPool::Data *data )
 {
+    const double *cols   = data->data() + _rows;
+    const double *values = cols + _cols;
+
+    double *inter = data->data() + _rows + _cols + _size;
+
     for ( unsigned int r = 0; r < _rows; r++ )
     {
         for ( unsigned int c = 0; c < _cols - 1; c++ )
         {
-            _inter_data[ r * _cols + c ] =
-                ( _table_data[ r * _cols + c + 1 ] - _table_data[ r * _cols + c ] )
-              / ( _col_values[ c + 1 ] - _col_values[ c ] );
+            inter[ r * _cols + c ] =
+                ( values[ r * _cols + c + 1 ] - values[ r * _cols + c ] )
+              / ( cols[ c + 1 ] - cols[ c ] );
         }
     }
+
+    setData( std::make_shared< DataPool::Data >( std::move( *data ) ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2::setData( const DataPool::DataPtr &data )
+{
+    _data = data;
+
+    _row_values = _data->data();
+    _col_values = _row_values + _rows;
+    _table_data = _col_values + _cols;
+    _inter_data = _table_data + _size;
 }
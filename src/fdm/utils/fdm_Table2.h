@@ -24,11 +24,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+#include <limits>
 #include <string>
 #include <vector>
 
 #include <fdm/fdm_Defines.h>
 
+#include <fdm/utils/fdm_DataPool.h>
 #include <fdm/utils/fdm_Table1.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +41,11 @@ namespace fdm
 
 /**
  * @brief 2D table and bilinear interpolation class.
+ *
+ * Table data are stored in immutable reference-counted blocks. Copying table
+ * doesn't copy data, modifying operations create new block.
+ *
+ * @see DataPool
  */
 class FDMEXPORT Table2
 {
@@ -57,7 +65,7 @@ public:
             const std::vector< double > &col_values,
             const std::vector< double > &table_data );
 
-    /** @brief Copy constructor. */
+    /** @brief Copy constructor (shares table data). */
     Table2( const Table2 &table );
 
     /** @brief Destructor. */
@@ -66,6 +74,20 @@ public:
     inline unsigned int getCols() const { return _cols; }
     inline unsigned int getRows() const { return _rows; }
 
+    /**
+     * @brief Returns row key value for the given index.
+     * @param row_index row index
+     * @return row key value on success or NaN on failure
+     */
+    double getRowValue( unsigned int row_index ) const;
+
+    /**
+     * @brief Returns column key value for the given index.
+     * @param col_index column index
+     * @return column key value on success or NaN on failure
+     */
+    double getColValue( unsigned int col_index ) const;
+
     /**
      * @brief Returns 1-dimensional table for the given col value.
      * @param colValue column key value
@@ -83,6 +105,19 @@ public:
      */
     double getValue( double row_value, double col_value ) const;
 
+    /**
+     * @brief Returns table values for the given arrays of keys.
+     * Evaluates many lookups of the same table in one pass. Results are the
+     * same as the ones returned by getValue().
+     * @param count number of lookups
+     * @param row_values row keys values
+     * @param col_values column keys values
+     * @param values results array
+     */
+    void getValues( unsigned int count,
+                    const double *row_values, const double *col_values,
+                    double *values ) const;
+
     /**
      * @brief Returns table value for the given key index.
      * @param rowIndex row index
@@ -97,6 +132,22 @@ public:
      */
     bool isValid() const;
 
+    /**
+     * @brief Resamples table onto uniform grid.
+     * Baked table lookups doesn't require any searching. Resampled table is
+     * checked against the original breakpoints (and cells centers) and is
+     * used only if the maximum error doesn't exceed given tolerance. Grid is
+     * refined until tolerance is met or maximum size is exceeded. Baked data
+     * is discarded when table keys or values are modified.
+     * @param tolerance maximum allowed absolute error
+     * @param max_size maximum number of baked grid elements
+     * @return true on success, false if tolerance cannot be met
+     */
+    bool bake( double tolerance, unsigned int max_size = 65536 );
+
+    /** @brief Returns true if table lookups use baked uniform grid. */
+    inline bool isBaked() const { return _bake_rows > 0; }
+
     /**
      * @brief Multiplies columns and rows values by the given factors.
      * @param f_cols columns factor
@@ -122,12 +173,20 @@ public:
      */
     void multiplyValues( double factor );
 
+    /**
+     * @brief Shares table data with all identical tables.
+     * Replaces table data with the identical block registered in the data
+     * pool, registers table data if there is no such block.
+     * @see DataPool::share()
+     */
+    void share();
+
     /**
      * @brief Returns string representation of the table.
      */
     std::string toString();
 
-    /** @brief Assignment operator. */
+    /** @brief Assignment operator (shares table data). */
     const Table2& operator= ( const Table2 &table );
 
 private:
@@ -136,14 +195,77 @@ private:
     unsigned int _cols;     ///< number of columns
     unsigned int _size;     ///< number of table elements
 
-    double *_row_values;    ///< rows keys values
-    double *_col_values;    ///< columns keys values
-    double *_table_data;    ///< table data
+    DataPool::DataPtr _data;    ///< keys values, table data and interpolation data
+
+    const double *_row_values;  ///< rows keys values
+    const double *_col_values;  ///< columns keys values
+    const double *_table_data;  ///< table data
+
+    const double *_inter_data;  ///< interpolation data matrix
 
-    double *_inter_data;    ///< interpolation data matrix
+    unsigned int _bake_rows;    ///< number of baked uniform grid rows
+    unsigned int _bake_cols;    ///< number of baked uniform grid columns
 
-    /** @brief Updates interpolation data due to table data. */
-    void updateInterpolationData();
+    double _bake_row_min;       ///< baked grid first row key value
+    double _bake_col_min;       ///< baked grid first column key value
+    double _bake_row_step_inv;  ///< baked grid inverted row key step
+    double _bake_col_step_inv;  ///< baked grid inverted column key step
+
+    DataPool::DataPtr _bake;    ///< baked table data
+
+    const double *_bake_data;   ///< baked table data
+
+    /** @brief Deletes baked data. */
+    void deleteBakedData();
+
+    /**
+     * @brief Returns value interpolated using baked uniform grid.
+     * Keys values should be within table range, grid position is clamped
+     * before it is converted to indices.
+     * @param row_value row key value
+     * @param col_value column key value
+     * @return interpolated value, NaN if keys values are not finite
+     */
+    inline double getBakedValue( double row_value, double col_value ) const
+    {
+        double r = ( row_value - _bake_row_min ) * _bake_row_step_inv;
+        double c = ( col_value - _bake_col_min ) * _bake_col_step_inv;
+
+        if ( !std::isfinite( r ) || !std::isfinite( c ) )
+        {
+            return std::numeric_limits< double >::quiet_NaN();
+        }
+
+        r = r > 0.0 ? r : 0.0;
+        c = c > 0.0 ? c : 0.0;
+        r = r < _bake_rows - 1 ? r : _bake_rows - 1;
+        c = c < _bake_cols - 1 ? c : _bake_cols - 1;
+
+        unsigned int ir = static_cast< unsigned int >( r );
+        unsigned int ic = static_cast< unsigned int >( c );
+
+        if ( ir > _bake_rows - 2 ) ir = _bake_rows - 2;
+        if ( ic > _bake_cols - 2 ) ic = _bake_cols - 2;
+
+        const double *d = _bake_data + ir * _bake_cols + ic;
+
+        double v_1 = ( c - ic ) * ( d[ 1 ] - d[ 0 ] ) + d[ 0 ];
+        double v_2 = ( c - ic ) * ( d[ _bake_cols + 1 ] - d[ _bake_cols ] ) + d[ _bake_cols ];
+
+        return ( r - ir ) * ( v_2 - v_1 ) + v_1;
+    }
+
+    /**
+     * @brief Computes interpolation data and moves given data into new block.
+     * @param data keys values, table data and interpolation data
+     */
+    void createData( DataPool::Data *data );
+
+    /**
+     * @brief Sets table data block.
+     * @param data keys values, table data and interpolation data
+     */
+    void setData( const DataPool::DataPtr &data );
 };
 
 } // end of fdm namespace
@@ -0,0 +1,281 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_Table2Pack.h>
+
+#include <cmath>
+
+#include <fdm/fdm_Exception.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Table2Pack::Table2Pack() :
+    _size ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Table2Pack::~Table2Pack() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Table2Pack::add( const Table2 &table )
+{
+    unsigned int rows = table.getRows();
+    unsigned int cols = table.getCols();
+
+    if ( rows == 0 || cols == 0 )
+    {
+        Exception e;
+
+        e.setType( Exception::UnknownException );
+        e.setInfo( "Invalid table size." );
+
+        FDM_THROW( e );
+    }
+
+    Block *block = FDM_NULLPTR;
+
+    for ( unsigned int i = 0; i < _blocks.size() && !block; i++ )
+    {
+        if ( _blocks[ i ].row_values.size() == rows
+          && _blocks[ i ].col_values.size() == cols )
+        {
+            bool same_keys = true;
+
+            for ( unsigned int r = 0; r < rows && same_keys; r++ )
+            {
+                same_keys = _blocks[ i ].row_values[ r ] == table.getRowValue( r );
+            }
+
+            for ( unsigned int c = 0; c < cols && same_keys; c++ )
+            {
+                same_keys = _blocks[ i ].col_values[ c ] == table.getColValue( c );
+            }
+
+            if ( same_keys ) block = &_blocks[ i ];
+        }
+    }
+
+    if ( !block )
+    {
+        _blocks.push_back( Block() );
+        block = &_blocks.back();
+
+        block->layers = 0;
+
+        for ( unsigned int r = 0; r < rows; r++ ) block->row_values.push_back( table.getRowValue( r ) );
+        for ( unsigned int c = 0; c < cols; c++ ) block->col_values.push_back( table.getColValue( c ) );
+    }
+
+    // appending new layer to every node
+    unsigned int layers = block->layers + 1;
+
+    std::vector< double > data( rows * cols * layers );
+
+    for ( unsigned int r = 0; r < rows; r++ )
+    {
+        for ( unsigned int c = 0; c < cols; c++ )
+        {
+            unsigned int node = r * cols + c;
+
+            for ( unsigned int l = 0; l < block->layers; l++ )
+            {
+                data[ node * layers + l ] = block->data[ node * block->layers + l ];
+            }
+
+            data[ node * layers + block->layers ] = table.getValueByIndex( r, c );
+        }
+    }
+
+    block->data.swap( data );
+    block->index.push_back( _size );
+    block->layers = layers;
+
+    return _size++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2Pack::clear()
+{
+    _blocks.clear();
+    _size = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2Pack::getValues( double row_value, double col_value, double *values ) const
+{
+    for ( unsigned int i = 0; i < _blocks.size(); i++ )
+    {
+        const Block &block = _blocks[ i ];
+
+        unsigned int rows = static_cast< unsigned int >( block.row_values.size() );
+        unsigned int cols = static_cast< unsigned int >( block.col_values.size() );
+
+        double r_val = row_value;
+        double c_val = col_value;
+
+        if ( r_val < block.row_values[ 0 ] ) r_val = block.row_values[ 0 ];
+        if ( c_val < block.col_values[ 0 ] ) c_val = block.col_values[ 0 ];
+
+        if ( r_val > block.row_values[ rows - 1 ] ) r_val = block.row_values[ rows - 1 ];
+        if ( c_val > block.col_values[ cols - 1 ] ) c_val = block.col_values[ cols - 1 ];
+
+        unsigned int row_1 = getKeyIndex( block.row_values, r_val );
+        unsigned int col_1 = getKeyIndex( block.col_values, c_val );
+
+        unsigned int row_2 = ( rows > 1 ) ? row_1 + 1 : row_1;
+        unsigned int col_2 = ( cols > 1 ) ? col_1 + 1 : col_1;
+
+        double rowDelta  = block.row_values[ row_2 ] - block.row_values[ row_1 ];
+        double colDelta  = block.col_values[ col_2 ] - block.col_values[ col_1 ];
+        double rowFactor = 0.0;
+        double colFactor = 0.0;
+
+        if ( fabs( rowDelta ) > 1.0e-16 )
+        {
+            rowFactor = ( r_val - block.row_values[ row_1 ] ) / rowDelta;
+        }
+
+        if ( fabs( colDelta ) > 1.0e-16 )
+        {
+            colFactor = ( c_val - block.col_values[ col_1 ] ) / colDelta;
+        }
+
+        const unsigned int layers = block.layers;
+
+        const double *d_11 = &block.data[ ( row_1 * cols + col_1 ) * layers ];
+        const double *d_12 = &block.data[ ( row_1 * cols + col_2 ) * layers ];
+        const double *d_21 = &block.data[ ( row_2 * cols + col_1 ) * layers ];
+        const double *d_22 = &block.data[ ( row_2 * cols + col_2 ) * layers ];
+
+        for ( unsigned int l = 0; l < layers; l++ )
+        {
+            double result_1 = colFactor * ( d_12[ l ] - d_11[ l ] ) + d_11[ l ];
+            double result_2 = colFactor * ( d_22[ l ] - d_21[ l ] ) + d_21[ l ];
+
+            values[ block.index[ l ] ] = rowFactor * ( result_2 - result_1 ) + result_1;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2Pack::getValues( double row_value, double col_value, double *values,
+                            double *row_derivs, double *col_derivs ) const
+{
+    for ( unsigned int i = 0; i < _blocks.size(); i++ )
+    {
+        const Block &block = _blocks[ i ];
+
+        unsigned int rows = static_cast< unsigned int >( block.row_values.size() );
+        unsigned int cols = static_cast< unsigned int >( block.col_values.size() );
+
+        double r_val = row_value;
+        double c_val = col_value;
+
+        bool r_out = r_val < block.row_values[ 0 ] || r_val > block.row_values[ rows - 1 ];
+        bool c_out = c_val < block.col_values[ 0 ] || c_val > block.col_values[ cols - 1 ];
+
+        if ( r_val < block.row_values[ 0 ] ) r_val = block.row_values[ 0 ];
+        if ( c_val < block.col_values[ 0 ] ) c_val = block.col_values[ 0 ];
+
+        if ( r_val > block.row_values[ rows - 1 ] ) r_val = block.row_values[ rows - 1 ];
+        if ( c_val > block.col_values[ cols - 1 ] ) c_val = block.col_values[ cols - 1 ];
+
+        unsigned int row_1 = getKeyIndex( block.row_values, r_val );
+        unsigned int col_1 = getKeyIndex( block.col_values, c_val );
+
+        unsigned int row_2 = ( rows > 1 ) ? row_1 + 1 : row_1;
+        unsigned int col_2 = ( cols > 1 ) ? col_1 + 1 : col_1;
+
+        double rowDelta  = block.row_values[ row_2 ] - block.row_values[ row_1 ];
+        double colDelta  = block.col_values[ col_2 ] - block.col_values[ col_1 ];
+        double rowFactor = 0.0;
+        double colFactor = 0.0;
+
+        // inverse of keys deltas, zero when derivative does not exist
+        double rowDeltaInv = 0.0;
+        double colDeltaInv = 0.0;
+
+        if ( fabs( rowDelta ) > 1.0e-16 )
+        {
+            rowFactor = ( r_val - block.row_values[ row_1 ] ) / rowDelta;
+            if ( !r_out ) rowDeltaInv = 1.0 / rowDelta;
+        }
+
+        if ( fabs( colDelta ) > 1.0e-16 )
+        {
+            colFactor = ( c_val - block.col_values[ col_1 ] ) / colDelta;
+            if ( !c_out ) colDeltaInv = 1.0 / colDelta;
+        }
+
+        const unsigned int layers = block.layers;
+
+        const double *d_11 = &block.data[ ( row_1 * cols + col_1 ) * layers ];
+        const double *d_12 = &block.data[ ( row_1 * cols + col_2 ) * layers ];
+        const double *d_21 = &block.data[ ( row_2 * cols + col_1 ) * layers ];
+        const double *d_22 = &block.data[ ( row_2 * cols + col_2 ) * layers ];
+
+        for ( unsigned int l = 0; l < layers; l++ )
+        {
+            double delta_1 = d_12[ l ] - d_11[ l ];
+            double delta_2 = d_22[ l ] - d_21[ l ];
+
+            double result_1 = colFactor * delta_1 + d_11[ l ];
+            double result_2 = colFactor * delta_2 + d_21[ l ];
+
+            unsigned int index = block.index[ l ];
+
+            values     [ index ] = rowFactor * ( result_2 - result_1 ) + result_1;
+            row_derivs [ index ] = ( result_2 - result_1 ) * rowDeltaInv;
+            col_derivs [ index ] = ( rowFactor * ( delta_2 - delta_1 ) + delta_1 ) * colDeltaInv;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int Table2Pack::getKeyIndex( const std::vector< double > &keys,
+                                      double key_value )
+{
+    unsigned int key_1 = 0;
+    unsigned int key_2 = static_cast< unsigned int >( keys.size() ) - 1;
+
+    while ( key_2 - key_1 > 1 )
+    {
+        unsigned int key_m = ( key_1 + key_2 ) / 2;
+
+        if ( key_value < keys[ key_m ] )
+            key_2 = key_m;
+        else
+            key_1 = key_m;
+    }
+
+    return key_1;
+}
@@ -0,0 +1,132 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_TABLE2PACK_H
+#define FDM_TABLE2PACK_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+#include <fdm/utils/fdm_Table2.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Pack of 2D tables evaluated together.
+ *
+ * Tables sharing the same row and column keys are packed into a single 3D
+ * block (row, column, layer) with all layers values stored contiguously for
+ * every node. Keys intervals are searched only once per block and all layers
+ * are interpolated in one pass. Tables with distinct keys are placed in
+ * separate blocks, so any set of tables can be packed.
+ *
+ * Values are extrapolated the same way as in Table2, i.e. keys values are
+ * limited to the table range.
+ *
+ * @see Table2
+ */
+class FDMEXPORT Table2Pack
+{
+public:
+
+    /** @brief Constructor. */
+    Table2Pack();
+
+    /** @brief Destructor. */
+    virtual ~Table2Pack();
+
+    /**
+     * @brief Adds table to the pack.
+     * @param table table to be added
+     * @return index of the table values in the results array
+     */
+    unsigned int add( const Table2 &table );
+
+    /** @brief Removes all tables. */
+    void clear();
+
+    /**
+     * @brief Computes all tables values for the given keys.
+     * Results are stored in order in which tables were added.
+     * @param row_value row key value
+     * @param col_value column key value
+     * @param values results array of at least getSize() elements
+     */
+    void getValues( double row_value, double col_value, double *values ) const;
+
+    /**
+     * @brief Computes all tables values and their partial derivatives.
+     * Derivatives are the ones of the bilinear interpolation within the
+     * keys cell, and are equal to zero for key values outside table range.
+     * @param row_value row key value
+     * @param col_value column key value
+     * @param values results array of at least getSize() elements
+     * @param row_derivs derivatives with respect to row key array of at least getSize() elements
+     * @param col_derivs derivatives with respect to column key array of at least getSize() elements
+     */
+    void getValues( double row_value, double col_value, double *values,
+                    double *row_derivs, double *col_derivs ) const;
+
+    /** @brief Returns number of blocks. */
+    inline unsigned int getBlocks() const { return static_cast< unsigned int >( _blocks.size() ); }
+
+    /** @brief Returns number of packed tables. */
+    inline unsigned int getSize() const { return _size; }
+
+private:
+
+    /** @brief Block of tables sharing the same keys. */
+    struct Block
+    {
+        std::vector< double > row_values;   ///< rows keys values
+        std::vector< double > col_values;   ///< columns keys values
+        std::vector< double > data;         ///< nodes values, layers stored contiguously
+
+        std::vector< unsigned int > index;  ///< layers result indices
+
+        unsigned int layers;                ///< number of layers
+    };
+
+    std::vector< Block > _blocks;           ///< tables blocks
+
+    unsigned int _size;                     ///< number of packed tables
+
+    /**
+     * @brief Returns lower key interval index for the given key value.
+     * @param keys keys values
+     * @param key_value key value within keys range
+     * @return lower key interval index
+     */
+    static unsigned int getKeyIndex( const std::vector< double > &keys,
+                                     double key_value );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_TABLE2PACK_H
@@ -0,0 +1,336 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_ThreadPlacement.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#ifdef _LINUX_
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
+#ifdef WIN32
+#   include <windows.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::mutex ThreadPlacement::_mutex;
+ThreadPlacement::CPUs ThreadPlacement::_plan[ RolesCount ];
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _LINUX_
+static bool readFile( const std::string &path, std::string *text )
+{
+    std::ifstream file( path.c_str() );
+
+    if ( !file.is_open() ) return false;
+
+    std::getline( file, (*text) );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static ThreadPlacement::CPUs readList( const std::string &path )
+{
+    ThreadPlacement::CPUs list;
+
+    std::string text;
+
+    if ( readFile( path, &text ) )
+    {
+        // list format, e.g. "0-3,8-11"
+        std::stringstream ss( text );
+        std::string range;
+
+        while ( std::getline( ss, range, ',' ) )
+        {
+            int first = 0;
+            int last  = 0;
+
+            int count = sscanf( range.c_str(), "%d-%d", &first, &last );
+
+            if ( count == 1 ) last = first;
+
+            for ( int i = first; count > 0 && i <= last; i++ )
+            {
+                list.push_back( i );
+            }
+        }
+    }
+
+    return list;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static int readInt( const std::string &path, int def )
+{
+    std::string text;
+
+    if ( readFile( path, &text ) && text.length() > 0 )
+    {
+        return atoi( text.c_str() );
+    }
+
+    return def;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPlacement::Topology ThreadPlacement::getTopology()
+{
+    Topology topology;
+
+#   ifdef _LINUX_
+    const std::string sys_cpu  = "/sys/devices/system/cpu/";
+    const std::string sys_node = "/sys/devices/system/node/";
+
+    CPUs online = readList( sys_cpu + "online" );
+
+    for ( unsigned int i = 0; i < online.size(); i++ )
+    {
+        std::string dir = sys_cpu + "cpu" + std::to_string( online[ i ] ) + "/topology/";
+
+        CPU cpu;
+
+        cpu.id      = online[ i ];
+        cpu.package = readInt( dir + "physical_package_id", 0 );
+        cpu.core    = readInt( dir + "core_id", online[ i ] );
+        cpu.node    = 0;
+
+        topology.push_back( cpu );
+    }
+
+    CPUs nodes = readList( sys_node + "online" );
+
+    for ( unsigned int i = 0; i < nodes.size(); i++ )
+    {
+        CPUs cpus = readList( sys_node + "node" + std::to_string( nodes[ i ] ) + "/cpulist" );
+
+        for ( unsigned int j = 0; j < topology.size(); j++ )
+        {
+            if ( std::find( cpus.begin(), cpus.end(), topology[ j ].id ) != cpus.end() )
+            {
+                topology[ j ].node = nodes[ i ];
+            }
+        }
+    }
+#   endif
+
+    if ( topology.empty() )
+    {
+        int count = std::max( 1, (int)std::thread::hardware_concurrency() );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            CPU cpu;
+
+            cpu.id      = i;
+            cpu.package = 0;
+            cpu.core    = i;
+            cpu.node    = 0;
+
+            topology.push_back( cpu );
+        }
+    }
+
+    return topology;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacement::configure( const Config &config )
+{
+    configure( config, getTopology() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacement::configure( const Config &config, const Topology &topology )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    for ( int i = 0; i < RolesCount; i++ ) _plan[ i ].clear();
+
+    // candidate CPUs, falling back to all nodes if configured node has no CPUs
+    Topology candidates;
+
+    for ( unsigned int i = 0; i < topology.size(); i++ )
+    {
+        if ( config.node < 0 || topology[ i ].node == config.node )
+        {
+            candidates.push_back( topology[ i ] );
+        }
+    }
+
+    if ( candidates.empty() ) candidates = topology;
+
+    // physical cores in order of appearance, every core with its logical CPUs
+    std::vector< std::pair< int, int > > keys;
+    std::vector< CPUs > cores;
+
+    for ( unsigned int i = 0; i < candidates.size(); i++ )
+    {
+        std::pair< int, int > key( candidates[ i ].package, candidates[ i ].core );
+
+        std::vector< std::pair< int, int > >::iterator it = std::find( keys.begin(), keys.end(), key );
+
+        if ( it == keys.end() )
+        {
+            keys.push_back( key );
+            cores.push_back( CPUs( 1, candidates[ i ].id ) );
+        }
+        else
+        {
+            cores[ it - keys.begin() ].push_back( candidates[ i ].id );
+        }
+    }
+
+    // allocation units, without sibling avoidance first logical CPUs of all
+    // cores come before siblings, so roles are spread over physical cores
+    std::vector< CPUs > units;
+
+    if ( config.avoidSiblings )
+    {
+        units = cores;
+    }
+    else
+    {
+        for ( unsigned int n = 0; units.size() < candidates.size(); n++ )
+        {
+            for ( unsigned int i = 0; i < cores.size(); i++ )
+            {
+                if ( n < cores[ i ].size() ) units.push_back( CPUs( 1, cores[ i ][ n ] ) );
+            }
+        }
+    }
+
+    std::set< int > reserved[ RolesCount ];
+    unsigned int next = 0;
+
+    // dedicated cores
+    for ( int r = 0; r < RolesCount; r++ )
+    {
+        for ( int i = 0; i < config.cores[ r ] && next < units.size(); i++, next++ )
+        {
+            _plan[ r ].push_back( units[ next ][ 0 ] );
+            reserved[ r ].insert( units[ next ].begin(), units[ next ].end() );
+        }
+    }
+
+    // shared CPUs
+    for ( int r = 0; r < RolesCount; r++ )
+    {
+        if ( config.cores[ r ] < 0 || !_plan[ r ].empty() ) continue;
+
+        for ( unsigned int i = 0; i < candidates.size(); i++ )
+        {
+            bool shared = true;
+
+            for ( int j = 0; j < RolesCount && shared; j++ )
+            {
+                if ( j == Render && !config.isolateRender ) continue;
+
+                shared = reserved[ j ].end() == reserved[ j ].find( candidates[ i ].id );
+            }
+
+            if ( shared ) _plan[ r ].push_back( candidates[ i ].id );
+        }
+
+        // all CPUs are dedicated, sharing everything but simulation cores
+        for ( unsigned int i = 0; i < candidates.size() && _plan[ r ].empty(); i++ )
+        {
+            if ( reserved[ Simulation ].end() == reserved[ Simulation ].find( candidates[ i ].id ) )
+            {
+                _plan[ r ].push_back( candidates[ i ].id );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacement::reset()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    for ( int i = 0; i < RolesCount; i++ ) _plan[ i ].clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPlacement::CPUs ThreadPlacement::getCPUs( Role role )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+    return _plan[ role ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ThreadPlacement::apply( Role role )
+{
+    CPUs cpus = getCPUs( role );
+
+    if ( cpus.empty() ) return true;
+
+#   ifdef _LINUX_
+    cpu_set_t cpuset;
+    CPU_ZERO( &cpuset );
+
+    for ( unsigned int i = 0; i < cpus.size(); i++ )
+    {
+        if ( cpus[ i ] < CPU_SETSIZE ) CPU_SET( cpus[ i ], &cpuset );
+    }
+
+    return 0 == pthread_setaffinity_np( pthread_self(), sizeof(cpu_set_t), &cpuset );
+#   elif defined(WIN32)
+    DWORD_PTR mask = 0;
+
+    for ( unsigned int i = 0; i < cpus.size(); i++ )
+    {
+        if ( cpus[ i ] < (int)( 8 * sizeof(DWORD_PTR) ) ) mask |= (DWORD_PTR)1 << cpus[ i ];
+    }
+
+    return 0 != SetThreadAffinityMask( GetCurrentThread(), mask );
+#   else
+    return true;
+#   endif
+}
@@ -0,0 +1,140 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_THREADPLACEMENT_H
+#define FDM_THREADPLACEMENT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <mutex>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief CPU topology aware thread placement class.
+ *
+ * Placement plan is computed once from CPU topology (sockets, physical cores,
+ * hyperthread siblings and NUMA nodes) and thread placement configuration.
+ * Every thread role is given a set of logical CPUs and threads pin themselves
+ * by calling apply() with their role. Roles are given dedicated physical
+ * cores in order: simulation, render, sound, workers, so the most latency
+ * sensitive threads get cores first. If hyperthread sibling avoidance is
+ * enabled, only one logical CPU of a dedicated core is used and its siblings
+ * are not given to any other role. Roles configured to share CPUs are given
+ * all CPUs not dedicated to other roles; render dedicated CPUs are excluded
+ * as well if render isolation is enabled.
+ *
+ * If placement has not been configured apply() does nothing, so threads
+ * started by code which does not configure placement (e.g. headless runner)
+ * are not affected.
+ *
+ * On Linux topology is read from sysfs, on other systems every logical CPU
+ * is assumed to be a separate core of a single node.
+ */
+class FDMEXPORT ThreadPlacement
+{
+public:
+
+    /** Thread roles. */
+    enum Role
+    {
+        Simulation = 0,             ///< flight dynamics model thread
+        Render,                     ///< render (OSG cull/draw) thread
+        Sound,                      ///< sound thread
+        Workers,                    ///< worker pools threads
+        RolesCount                  ///< number of roles
+    };
+
+    /** Logical CPU data. */
+    struct CPU
+    {
+        int id;                     ///< logical CPU index
+        int package;                ///< physical package (socket) index
+        int core;                   ///< physical core index within package
+        int node;                   ///< NUMA node index
+    };
+
+    typedef std::vector< CPU > Topology;
+    typedef std::vector< int > CPUs;
+
+    /** Placement configuration. */
+    struct Config
+    {
+        int cores[ RolesCount ];    ///< number of dedicated physical cores per role, 0 means sharing remaining CPUs, negative means no pinning
+        int node;                   ///< NUMA node all roles are placed on, negative means any node
+        bool avoidSiblings;         ///< specifies if hyperthread siblings of dedicated cores are left idle
+        bool isolateRender;         ///< specifies if render dedicated CPUs are excluded from shared CPUs
+    };
+
+    /**
+     * @brief Reads CPU topology of the machine.
+     * @return topology, logical CPUs are ordered by index
+     */
+    static Topology getTopology();
+
+    /**
+     * @brief Computes placement plan for the machine CPU topology.
+     * Should be called before threads are started.
+     * @param config placement configuration
+     */
+    static void configure( const Config &config );
+
+    /**
+     * @brief Computes placement plan for the given CPU topology.
+     * @param config placement configuration
+     * @param topology CPU topology
+     */
+    static void configure( const Config &config, const Topology &topology );
+
+    /** @brief Clears placement plan. */
+    static void reset();
+
+    /**
+     * @brief Returns CPUs planned for the given role.
+     * @param role thread role
+     * @return CPUs set, empty if role is not pinned
+     */
+    static CPUs getCPUs( Role role );
+
+    /**
+     * @brief Pins calling thread to the CPUs planned for the given role.
+     * @param role thread role
+     * @return false if pinning has failed, true otherwise (also if role is not pinned)
+     */
+    static bool apply( Role role );
+
+private:
+
+    static std::mutex _mutex;               ///< mutex guarding placement plan
+    static CPUs _plan[ RolesCount ];        ///< placement plan
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_THREADPLACEMENT_H
@@ -0,0 +1,436 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#include <fdm/utils/fdm_TriangleBVH.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Maximum depth of traversal stack. */
+const unsigned int stackSize = 64;
+
+/** Compares triangle references centers along given axis. */
+struct CompareRefs
+{
+    CompareRefs( int axis ) : _axis ( axis ) {}
+
+    template < class TYPE >
+    bool operator()( const TYPE &ref_1, const TYPE &ref_2 ) const
+    {
+        return ref_1.c[ _axis ] < ref_2.c[ _axis ];
+    }
+
+    int _axis;
+};
+
+/**
+ * @brief Intersects segment with node bounding box (slab test).
+ * @param node hierarchy node
+ * @param o segment beginning relative to mesh center
+ * @param inv inverse of segment direction
+ * @param t_max maximum segment parameter
+ * @param t_min entry segment parameter to be set
+ * @return true if segment intersects node bounding box
+ */
+inline bool intersectNode( const TriangleBVH::Node &node,
+                           const double *o, const double *inv,
+                           double t_max, double *t_min )
+{
+    double t_0 = 0.0;
+    double t_1 = t_max;
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        double t_a = ( node.min[ i ] - o[ i ] ) * inv[ i ];
+        double t_b = ( node.max[ i ] - o[ i ] ) * inv[ i ];
+
+        if ( t_a > t_b ) std::swap( t_a, t_b );
+
+        t_0 = std::max( t_0, t_a );
+        t_1 = std::min( t_1, t_b );
+    }
+
+    (*t_min) = t_0;
+
+    return t_0 <= t_1;
+}
+
+/**
+ * @brief Intersects segment with triangle (Moller-Trumbore).
+ * @param tri triangle
+ * @param o segment beginning relative to mesh center
+ * @param d segment direction (from beginning to end)
+ * @param t segment parameter to be set
+ * @return true if segment line intersects triangle
+ */
+inline bool intersectTriangle( const TriangleBVH::Triangle &tri,
+                               const double *o, const double *d, double *t )
+{
+    double p[ 3 ] = { d[ 1 ] * tri.e2[ 2 ] - d[ 2 ] * tri.e2[ 1 ],
+                      d[ 2 ] * tri.e2[ 0 ] - d[ 0 ] * tri.e2[ 2 ],
+                      d[ 0 ] * tri.e2[ 1 ] - d[ 1 ] * tri.e2[ 0 ] };
+
+    double det = tri.e1[ 0 ] * p[ 0 ] + tri.e1[ 1 ] * p[ 1 ] + tri.e1[ 2 ] * p[ 2 ];
+
+    if ( fabs( det ) < 1.0e-15 ) return false;
+
+    double det_inv = 1.0 / det;
+
+    double s[ 3 ] = { o[ 0 ] - tri.v0[ 0 ], o[ 1 ] - tri.v0[ 1 ], o[ 2 ] - tri.v0[ 2 ] };
+
+    double t_u = ( s[ 0 ] * p[ 0 ] + s[ 1 ] * p[ 1 ] + s[ 2 ] * p[ 2 ] ) * det_inv;
+
+    if ( t_u < 0.0 || t_u > 1.0 ) return false;
+
+    double q[ 3 ] = { s[ 1 ] * tri.e1[ 2 ] - s[ 2 ] * tri.e1[ 1 ],
+                      s[ 2 ] * tri.e1[ 0 ] - s[ 0 ] * tri.e1[ 2 ],
+                      s[ 0 ] * tri.e1[ 1 ] - s[ 1 ] * tri.e1[ 0 ] };
+
+    double t_v = ( d[ 0 ] * q[ 0 ] + d[ 1 ] * q[ 1 ] + d[ 2 ] * q[ 2 ] ) * det_inv;
+
+    if ( t_v < 0.0 || t_u + t_v > 1.0 ) return false;
+
+    (*t) = ( tri.e2[ 0 ] * q[ 0 ] + tri.e2[ 1 ] * q[ 1 ] + tri.e2[ 2 ] * q[ 2 ] ) * det_inv;
+
+    return true;
+}
+
+/**
+ * @brief Returns triangle unit normal vector facing segment beginning.
+ * @param tri triangle
+ * @param d segment direction (from beginning to end)
+ */
+inline Vector3 getNormal( const TriangleBVH::Triangle &tri, const Vector3 &d )
+{
+    Vector3 e1( tri.e1[ 0 ], tri.e1[ 1 ], tri.e1[ 2 ] );
+    Vector3 e2( tri.e2[ 0 ], tri.e2[ 1 ], tri.e2[ 2 ] );
+
+    Vector3 norm = ( e1 % e2 ).getNormalized();
+
+    if ( norm * d > 0.0 ) norm = -norm;
+
+    return norm;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int TriangleBVH::_leaf_size = 4;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TriangleBVH::TriangleBVH() :
+    _radius ( 0.0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TriangleBVH::~TriangleBVH() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVH::build( const std::vector< Vector3 > &vertices,
+                         const std::vector< UInt32 > &indices )
+{
+    _nodes.clear();
+    _tris.clear();
+
+    _center = Vector3();
+    _radius = 0.0;
+
+    Vector3 v_min(  DBL_MAX,  DBL_MAX,  DBL_MAX );
+    Vector3 v_max( -DBL_MAX, -DBL_MAX, -DBL_MAX );
+
+    std::vector< UInt32 > valid;
+
+    for ( unsigned int i = 0; i + 2 < indices.size(); i += 3 )
+    {
+        if ( indices[ i ] < vertices.size() && indices[ i + 1 ] < vertices.size()
+          && indices[ i + 2 ] < vertices.size() )
+        {
+            valid.push_back( i );
+
+            for ( int j = 0; j < 3; j++ )
+            {
+                const Vector3 &v = vertices[ indices[ i + j ] ];
+
+                v_min.x() = std::min( v_min.x(), v.x() );
+                v_min.y() = std::min( v_min.y(), v.y() );
+                v_min.z() = std::min( v_min.z(), v.z() );
+
+                v_max.x() = std::max( v_max.x(), v.x() );
+                v_max.y() = std::max( v_max.y(), v.y() );
+                v_max.z() = std::max( v_max.z(), v.z() );
+            }
+        }
+    }
+
+    if ( valid.empty() ) return;
+
+    _center = 0.5 * ( v_min + v_max );
+    _radius = 0.5 * Vector3( v_max - v_min ).getLength();
+
+    std::vector< Triangle > tris;
+    std::vector< Ref > refs;
+
+    tris.reserve( valid.size() );
+    refs.reserve( valid.size() );
+
+    for ( unsigned int i = 0; i < valid.size(); i++ )
+    {
+        float p[ 3 ][ 3 ];
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            Vector3 v = vertices[ indices[ valid[ i ] + j ] ] - _center;
+
+            p[ j ][ 0 ] = (float)v.x();
+            p[ j ][ 1 ] = (float)v.y();
+            p[ j ][ 2 ] = (float)v.z();
+        }
+
+        Triangle tri;
+        Ref ref;
+
+        for ( int k = 0; k < 3; k++ )
+        {
+            tri.v0[ k ] = p[ 0 ][ k ];
+            tri.e1[ k ] = p[ 1 ][ k ] - p[ 0 ][ k ];
+            tri.e2[ k ] = p[ 2 ][ k ] - p[ 0 ][ k ];
+
+            ref.min[ k ] = std::min( p[ 0 ][ k ], std::min( p[ 1 ][ k ], p[ 2 ][ k ] ) );
+            ref.max[ k ] = std::max( p[ 0 ][ k ], std::max( p[ 1 ][ k ], p[ 2 ][ k ] ) );
+            ref.c[ k ] = 0.5f * ( ref.min[ k ] + ref.max[ k ] );
+        }
+
+        // degenerate triangles
+        Vector3 e1( tri.e1[ 0 ], tri.e1[ 1 ], tri.e1[ 2 ] );
+        Vector3 e2( tri.e2[ 0 ], tri.e2[ 1 ], tri.e2[ 2 ] );
+
+        if ( ( e1 % e2 ).getLength2() > 0.0 )
+        {
+            ref.tri = (UInt32)tris.size();
+
+            tris.push_back( tri );
+            refs.push_back( ref );
+        }
+    }
+
+    if ( refs.empty() ) return;
+
+    _nodes.reserve( 2 * ( refs.size() / _leaf_size + 1 ) );
+    _tris.reserve( tris.size() );
+
+    buildNode( &refs, 0, (UInt32)refs.size(), tris );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TriangleBVH::getIntersection( const Vector3 &b, const Vector3 &e,
+                                   double *u, Vector3 *n, UInt32 *tri ) const
+{
+    if ( _nodes.empty() ) return false;
+
+    const double o[ 3 ] = { b.x() - _center.x(), b.y() - _center.y(), b.z() - _center.z() };
+    const double d[ 3 ] = { e.x() - b.x(), e.y() - b.y(), e.z() - b.z() };
+
+    double inv[ 3 ];
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        inv[ i ] = ( fabs( d[ i ] ) > 1.0e-30 ) ? 1.0 / d[ i ] : ( d[ i ] < 0.0 ? -1.0e30 : 1.0e30 );
+    }
+
+    double t_best = 1.0;
+    int    i_best = -1;
+
+    UInt32 stack[ stackSize ];
+    unsigned int size = 0;
+
+    double t_min = 0.0;
+
+    if ( !intersectNode( _nodes[ 0 ], o, inv, t_best, &t_min ) ) return false;
+
+    stack[ size++ ] = 0;
+
+    while ( size > 0 )
+    {
+        const Node &node = _nodes[ stack[ --size ] ];
+
+        if ( node.count > 0 )
+        {
+            for ( UInt32 i = node.index; i < node.index + node.count; i++ )
+            {
+                double t = 0.0;
+
+                if ( !intersectTriangle( _tris[ i ], o, d, &t ) ) continue;
+
+                if ( t >= 0.0 && t <= t_best )
+                {
+                    t_best = t;
+                    i_best = (int)i;
+                }
+            }
+        }
+        else
+        {
+            // nearer child is visited first
+            UInt32 i_l = (UInt32)( &node - &_nodes[ 0 ] ) + 1;
+            UInt32 i_r = node.index;
+
+            double t_l = 0.0;
+            double t_r = 0.0;
+
+            bool hit_l = intersectNode( _nodes[ i_l ], o, inv, t_best, &t_l );
+            bool hit_r = intersectNode( _nodes[ i_r ], o, inv, t_best, &t_r );
+
+            if ( hit_l && hit_r )
+            {
+                if ( t_l > t_r ) std::swap( i_l, i_r );
+
+                stack[ size++ ] = i_r;
+                stack[ size++ ] = i_l;
+            }
+            else if ( hit_l )
+            {
+                stack[ size++ ] = i_l;
+            }
+            else if ( hit_r )
+            {
+                stack[ size++ ] = i_r;
+            }
+        }
+    }
+
+    if ( i_best < 0 ) return false;
+
+    (*u) = t_best;
+    (*n) = getNormal( _tris[ i_best ], e - b );
+
+    if ( tri ) (*tri) = (UInt32)i_best;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TriangleBVH::getIntersection( UInt32 tri, const Vector3 &b, const Vector3 &e,
+                                   double *u, Vector3 *n ) const
+{
+    if ( tri >= _tris.size() ) return false;
+
+    const double o[ 3 ] = { b.x() - _center.x(), b.y() - _center.y(), b.z() - _center.z() };
+    const double d[ 3 ] = { e.x() - b.x(), e.y() - b.y(), e.z() - b.z() };
+
+    double t = 0.0;
+
+    if ( intersectTriangle( _tris[ tri ], o, d, &t ) && t >= 0.0 && t <= 1.0 )
+    {
+        (*u) = t;
+        (*n) = getNormal( _tris[ tri ], e - b );
+
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVH::buildNode( std::vector< Ref > *refs, UInt32 first, UInt32 count,
+                             const std::vector< Triangle > &tris )
+{
+    UInt32 index = (UInt32)_nodes.size();
+
+    _nodes.push_back( Node() );
+
+    Node node;
+
+    float c_min[ 3 ] = {  FLT_MAX,  FLT_MAX,  FLT_MAX };
+    float c_max[ 3 ] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for ( int k = 0; k < 3; k++ )
+    {
+        node.min[ k ] =  FLT_MAX;
+        node.max[ k ] = -FLT_MAX;
+    }
+
+    for ( UInt32 i = first; i < first + count; i++ )
+    {
+        const Ref &ref = (*refs)[ i ];
+
+        for ( int k = 0; k < 3; k++ )
+        {
+            node.min[ k ] = std::min( node.min[ k ], ref.min[ k ] );
+            node.max[ k ] = std::max( node.max[ k ], ref.max[ k ] );
+
+            c_min[ k ] = std::min( c_min[ k ], ref.c[ k ] );
+            c_max[ k ] = std::max( c_max[ k ], ref.c[ k ] );
+        }
+    }
+
+    if ( count <= _leaf_size )
+    {
+        node.index = (UInt32)_tris.size();
+        node.count = count;
+
+        for ( UInt32 i = first; i < first + count; i++ )
+        {
+            _tris.push_back( tris[ (*refs)[ i ].tri ] );
+        }
+
+        _nodes[ index ] = node;
+
+        return;
+    }
+
+    int axis = 0;
+
+    if ( c_max[ 1 ] - c_min[ 1 ] > c_max[ axis ] - c_min[ axis ] ) axis = 1;
+    if ( c_max[ 2 ] - c_min[ 2 ] > c_max[ axis ] - c_min[ axis ] ) axis = 2;
+
+    UInt32 half = count / 2;
+
+    std::nth_element( refs->begin() + first,
+                      refs->begin() + first + half,
+                      refs->begin() + first + count,
+                      CompareRefs( axis ) );
+
+    buildNode( refs, first, half, tris );
+
+    node.index = (UInt32)_nodes.size();
+    node.count = 0;
+
+    buildNode( refs, first + half, count - half, tris );
+
+    _nodes[ index ] = node;
+}
@@ -0,0 +1,159 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_TRIANGLEBVH_H
+#define FDM_TRIANGLEBVH_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Types.h>
+
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Triangle mesh bounding volume hierarchy class.
+ *
+ * Hierarchy is built once from indexed triangles and is read-only afterwards,
+ * so it might be queried by many threads at once. Nodes are flattened into
+ * a single array in depth-first order (left child directly follows its
+ * parent) and stored as 32 bytes records of single precision bounds, so
+ * two nodes share a cache line and slab tests of all three axes are
+ * performed on contiguous data. Coordinates are stored relative to the mesh
+ * bounding box center, so single precision is sufficient for meshes up to
+ * several kilometers, while segment and triangle tests are computed in
+ * double precision.
+ */
+class FDMEXPORT TriangleBVH
+{
+public:
+
+    static const unsigned int _leaf_size;   ///< maximum number of triangles in leaf node
+
+    /** Flattened hierarchy node. */
+    struct Node
+    {
+        float min[ 3 ];             ///< [m] bounding box minimum coordinates
+        float max[ 3 ];             ///< [m] bounding box maximum coordinates
+        UInt32 index;               ///< first triangle index (leaf) or right child index (inner node)
+        UInt32 count;               ///< number of triangles, 0 means inner node
+    };
+
+    /** Triangle. */
+    struct Triangle
+    {
+        float v0[ 3 ];              ///< [m] first vertex coordinates
+        float e1[ 3 ];              ///< [m] first edge (from first to second vertex)
+        float e2[ 3 ];              ///< [m] second edge (from first to third vertex)
+    };
+
+    /** @brief Constructor. */
+    TriangleBVH();
+
+    /** @brief Destructor. */
+    virtual ~TriangleBVH();
+
+    /**
+     * @brief Builds hierarchy.
+     * Triangles are split at the median of their centroids along the longest
+     * axis of the centroids bounds. Degenerate triangles are skipped.
+     * @param vertices [m] vertices coordinates
+     * @param indices vertices indices, 3 per triangle
+     */
+    void build( const std::vector< Vector3 > &vertices,
+                const std::vector< UInt32 > &indices );
+
+    /**
+     * @brief Gets the segment intersection closest to its beginning.
+     * @param b [m] beginning of intersection segment
+     * @param e [m] end of intersection segment
+     * @param u [-] intersection parameter, intersection point is b + u * ( e - b )
+     * @param n [-] intersection normal vector (unit length, facing segment beginning)
+     * @param tri intersected triangle index (optional)
+     * @return true if there is an intersection, false otherwise
+     */
+    bool getIntersection( const Vector3 &b, const Vector3 &e,
+                          double *u, Vector3 *n, UInt32 *tri = FDM_NULLPTR ) const;
+
+    /**
+     * @brief Gets the segment intersection with the given triangle only.
+     * @param tri triangle index
+     * @param b [m] beginning of intersection segment
+     * @param e [m] end of intersection segment
+     * @param u [-] intersection parameter, intersection point is b + u * ( e - b )
+     * @param n [-] intersection normal vector (unit length, facing segment beginning)
+     * @return true if there is an intersection, false otherwise
+     */
+    bool getIntersection( UInt32 tri, const Vector3 &b, const Vector3 &e,
+                          double *u, Vector3 *n ) const;
+
+    /** @return true if hierarchy contains no triangles */
+    inline bool isEmpty() const { return _tris.empty(); }
+
+    inline unsigned int getNodesCount() const { return (unsigned int)_nodes.size(); }
+    inline unsigned int getTrianglesCount() const { return (unsigned int)_tris.size(); }
+
+    /** @return [m] bounding box center */
+    inline const Vector3& getCenter() const { return _center; }
+
+    /** @return [m] bounding sphere radius (around bounding box center) */
+    inline double getRadius() const { return _radius; }
+
+private:
+
+    /** Triangle reference used while building. */
+    struct Ref
+    {
+        float min[ 3 ];             ///< [m] triangle bounding box minimum coordinates
+        float max[ 3 ];             ///< [m] triangle bounding box maximum coordinates
+        float c[ 3 ];               ///< [m] triangle bounding box center
+        UInt32 tri;                 ///< triangle index
+    };
+
+    std::vector< Node > _nodes;     ///< flattened nodes, first one is root
+    std::vector< Triangle > _tris;  ///< triangles sorted by leaves
+
+    Vector3 _center;                ///< [m] bounding box center
+    double _radius;                 ///< [m] bounding sphere radius
+
+    /**
+     * @brief Builds subtree of the given triangle references range.
+     * @param refs triangle references
+     * @param first first reference index
+     * @param count number of references
+     * @param tris unsorted triangles
+     */
+    void buildNode( std::vector< Ref > *refs, UInt32 first, UInt32 count,
+                    const std::vector< Triangle > &tris );
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_TRIANGLEBVH_H
@@ -31,6 +31,7 @@
 
 #include <fdm/fdm_Exception.h>
 #include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_VectorExpr.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -45,42 +46,57 @@ namespace fdm
  * mathematical operation between vectors which sizes do not match each other
  * as they are of different types.
  *
+ * Arithmetic operators are implemented as expression templates (see
+ * VectorExpr), compound expressions are evaluated in a single loop without
+ * temporary vectors when assigned to a vector.
+ *
+ * Vectors have no virtual functions and no data members other than items
+ * array, they are trivially copyable and can be stored densely and copied
+ * with memcpy.
+ *
  * @tparam SIZE vector size
  */
 template < unsigned int SIZE >
-class Vector
+class Vector : public VectorExpr< Vector< SIZE >, SIZE >
 {
 public:
 
     /** @brief Constructor. */
-    Vector() :
-        _size ( SIZE )
+    Vector()
     {
         zeroize();
     }
 
-    /** @brief Copy constructor. */
-    Vector( const Vector< SIZE > &vect ) :
-        _size ( SIZE )
+    /** @brief Constructor. */
+    Vector( const double items[] )
     {
-        setArray( vect._items );
+        setArray( items );
     }
 
-    /** @brief Constructor. */
-    Vector( const double items[] ) :
-        _size ( SIZE )
+    /** @brief Constructor (evaluates vector expression). */
+    template < class E >
+    Vector( const VectorExpr< E, SIZE > &expr )
     {
-        setArray( items );
+        assign( expr.self() );
     }
 
+    /** @return vector size */
+    inline unsigned int getSize() const { return _size; }
+
+    /** @return pointer to vector items array */
+    inline const double* getItems() const { return _items; }
+
+    /** @return pointer to vector items array */
+    inline double* getItems() { return _items; }
+
     /** @return TRUE if all items are valid */
-    virtual bool isValid() const
+    bool isValid() const
     {
         return Misc::isValid( _items, _size );
     }
 
     /** @return vector length squared */
-    virtual double getLength2() const
+    double getLength2() const
     {
         double length2 = 0.0;
 
@@ -93,13 +109,13 @@ public:
     }
 
     /** @return vector length */
-    virtual double getLength() const
+    double getLength() const
     {
         return sqrt( getLength2() );
     }
 
     /** @brief Normalizes vector. */
-    virtual void normalize()
+    void normalize()
     {
         double length = getLength();
 
@@ -115,7 +131,7 @@ public:
     }
 
     /** @brief Puts vector items into given array. */
-    virtual void getArray( double items[] ) const
+    void getArray( double items[] ) const
     {
         for ( unsigned int i = 0; i < _size; i++ )
         {
@@ -129,7 +145,7 @@ public:
      * Throws an exception when index is out of range.
      * @return vector item of given indicies.
      */
-    virtual double getItem( unsigned int index ) const
+    double getItem( unsigned int index ) const
     {
         if ( index < _size )
         {
@@ -149,7 +165,7 @@ public:
     }
 
     /** @brief Sets vector items from given array. */
-    virtual void setArray( const double items[] )
+    void setArray( const double items[] )
     {
         for ( unsigned int i = 0; i < _size; i++ )
         {
@@ -162,7 +178,7 @@ public:
      * This function is bound-checked which may affect performance.
      * Throws an exception when index is out of range.
      */
-    virtual void setItem( unsigned int index, double val )
+    void setItem( unsigned int index, double val )
     {
         if ( index < _size )
         {
@@ -180,7 +196,7 @@ public:
     }
 
     /** @brief Swaps vector rows. */
-    virtual void swapRows( unsigned int row1, unsigned int row2 )
+    void swapRows( unsigned int row1, unsigned int row2 )
     {
         if ( row1 < _size && row2 < _size )
         {
@@ -200,7 +216,7 @@ public:
     }
 
     /** @brief Returns string representation of the vector. */
-    virtual std::string toString() const
+    std::string toString() const
     {
         std::stringstream ss;
 
@@ -215,7 +231,7 @@ public:
     }
 
     /** @brief Sets all vector items to zero. */
-    virtual void zeroize()
+    void zeroize()
     {
         for ( unsigned int i = 0; i < _size; i++ )
         {
@@ -269,109 +285,34 @@ public:
         return _items[ index ];
     }
 
-    /** @brief Assignment operator. */
-    const Vector< SIZE >& operator= ( const Vector< SIZE > &vect )
+    /** @brief Assignment operator (evaluates vector expression). */
+    template < class E >
+    const Vector< SIZE >& operator= ( const VectorExpr< E, SIZE > &expr )
     {
-        setArray( vect._items );
+        assign( expr.self() );
 
         return (*this);
     }
 
-    /** @brief Addition operator. */
-    Vector< SIZE > operator+ ( const Vector< SIZE > &vect ) const
-    {
-        Vector< SIZE > result;
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            result._items[ i ] = _items[ i ] + vect._items[ i ];
-        }
-
-        return result;
-    }
-
-    /** @brief Negation operator. */
-    Vector< SIZE > operator- () const
-    {
-        Vector< SIZE > result;
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            result._items[ i ] = - _items[ i ];
-        }
-
-        return result;
-    }
-
-    /** @brief Subtraction operator. */
-    Vector< SIZE > operator- ( const Vector< SIZE > &vect ) const
-    {
-        Vector< SIZE > result;
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            result._items[ i ] = _items[ i ] - vect._items[ i ];
-        }
-
-        return result;
-    }
-
-    /** @brief Multiplication operator (by scalar). */
-    Vector< SIZE > operator* ( double val ) const
-    {
-        Vector< SIZE > result;
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            result._items[ i ] = _items[ i ] * val;
-        }
-
-        return result;
-    }
-
-    /** @brief Dot product operator. */
-    double operator* ( const Vector< SIZE > &vect ) const
-    {
-        double result = 0.0;
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            result += _items[ i ] * vect._items[ i ];
-        }
-
-        return result;
-    }
-
-    /** @brief Division operator (by scalar). */
-    Vector< SIZE > operator/ ( double val ) const
-    {
-        Vector< SIZE > result;
-
-        for ( unsigned int i = 0; i < _size; i++ )
-        {
-            result._items[ i ] = _items[ i ] / val;
-        }
-
-        return result;
-    }
-
     /** @brief Unary addition operator. */
-    Vector< SIZE >& operator+= ( const Vector< SIZE > &vect )
+    template < class E >
+    Vector< SIZE >& operator+= ( const VectorExpr< E, SIZE > &expr )
     {
-        for ( unsigned int i = 0; i < _size; i++ )
+        for ( unsigned int i = 0; i < SIZE; i++ )
         {
-            _items[ i ] += vect._items[ i ];
+            _items[ i ] += expr.self()( i );
         }
 
         return (*this);
     }
 
     /** @brief Unary subtraction operator. */
-    Vector< SIZE >& operator-= ( const Vector< SIZE > &vect )
+    template < class E >
+    Vector< SIZE >& operator-= ( const VectorExpr< E, SIZE > &expr )
     {
-        for ( unsigned int i = 0; i < _size; i++ )
+        for ( unsigned int i = 0; i < SIZE; i++ )
         {
-            _items[ i ] -= vect._items[ i ];
+            _items[ i ] -= expr.self()( i );
         }
 
         return (*this);
@@ -420,11 +361,28 @@ public:
 
 protected:
 
-    double _items[ SIZE ];      ///< vector items
+    static const unsigned int _size = SIZE;     ///< vector size
 
-    const unsigned int _size;   ///< vector size
+    double _items[ SIZE ];                      ///< vector items
+
+    /**
+     * @brief Evaluates vector expression into vector items.
+     * Each item depends only on the same items of the operands, so it is
+     * safe to assign an expression which refers to the vector itself.
+     */
+    template < class E >
+    inline void assign( const E &expr )
+    {
+        for ( unsigned int i = 0; i < SIZE; i++ )
+        {
+            _items[ i ] = expr( i );
+        }
+    }
 };
 
+template < unsigned int SIZE >
+const unsigned int Vector< SIZE >::_size;
+
 } // end of fdm namespace
 
 ////////////////////////////////////////////////////////////////////////////////
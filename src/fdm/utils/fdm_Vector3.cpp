@@ -35,45 +35,20 @@ const Vector3 Vector3::_ez = Vector3( 0.0, 0.0, 1.0 );
 ////////////////////////////////////////////////////////////////////////////////
 
 Vector3::Vector3() :
-    Vector< 3 >(),
-
-    _x ( _items[ 0 ] ),
-    _y ( _items[ 1 ] ),
-    _z ( _items[ 2 ] )
-{}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3::Vector3( const Vector3 &vect ) :
-    Vector< 3 >( vect ),
-
-    _x ( _items[ 0 ] ),
-    _y ( _items[ 1 ] ),
-    _z ( _items[ 2 ] )
+    Vector< 3 >()
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Vector3::Vector3( const double items[] ) :
-    Vector< 3 >( items ),
-
-    _x ( _items[ 0 ] ),
-    _y ( _items[ 1 ] ),
-    _z ( _items[ 2 ] )
+    Vector< 3 >( items )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Vector3::Vector3( double x, double y, double z ) :
-    Vector< 3 >(),
-
-    _x ( _items[ 0 ] ),
-    _y ( _items[ 1 ] ),
-    _z ( _items[ 2 ] )
+Vector3::Vector3( double x, double y, double z )
 {
-    _x = x;
-    _y = y;
-    _z = z;
+    set( x, y, z );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -92,7 +67,7 @@ Vector3 Vector3::getNormalized() const
 Vector3 Vector3::getRotated( const Quaternion quat )
 {
     // passive rotation
-    Quaternion qv( 0.0, _x, _y, _z );
+    Quaternion qv( 0.0, _items[ 0 ], _items[ 1 ], _items[ 2 ] );
     Quaternion qr = quat.getConjugated() * qv * quat;
 
     return Vector3( qr.ex(), qr.ey(), qr.ez() );
@@ -102,149 +77,9 @@ Vector3 Vector3::getRotated( const Quaternion quat )
 
 void Vector3::set( double x, double y, double z )
 {
-    _x = x;
-    _y = y;
-    _z = z;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-const Vector3& Vector3::operator= ( const Vector3 &vect )
-{
-    _x = vect._x;
-    _y = vect._y;
-    _z = vect._z;
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3 Vector3::operator+ ( const Vector3 &vect ) const
-{
-    Vector3 result;
-    
-    result._x = _x + vect._x;
-    result._y = _y + vect._y;
-    result._z = _z + vect._z;
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3 Vector3::operator- () const
-{
-    Vector3 result;
-    
-    result._x = -_x;
-    result._y = -_y;
-    result._z = -_z;
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3 Vector3::operator- ( const Vector3 &vect ) const
-{
-    Vector3 result;
-    
-    result._x = _x - vect._x;
-    result._y = _y - vect._y;
-    result._z = _z - vect._z;
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3 Vector3::operator* ( double val ) const
-{
-    Vector3 result;
-    
-    result._x = _x * val;
-    result._y = _y * val;
-    result._z = _z * val;
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3 Vector3::operator/ ( double val ) const
-{
-    Vector3 result;
-    
-    result._x = _x / val;
-    result._y = _y / val;
-    result._z = _z / val;
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-double Vector3::operator* ( const Vector3 &vect ) const
-{
-    return ( _x*vect._x + _y*vect._y + _z*vect._z );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3 Vector3::operator% ( const Vector3 &vect ) const
-{
-    Vector3 result;
-    
-    result._x = _y * vect._z - _z * vect._y;
-    result._y = _z * vect._x - _x * vect._z;
-    result._z = _x * vect._y - _y * vect._x;
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3& Vector3::operator+= ( const Vector3 &vect )
-{
-    _x += vect._x;
-    _y += vect._y;
-    _z += vect._z;
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3& Vector3::operator-= ( const Vector3 &vect )
-{
-    _x -= vect._x;
-    _y -= vect._y;
-    _z -= vect._z;
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3& Vector3::operator*= ( double val )
-{
-    _x *= val;
-    _y *= val;
-    _z *= val;
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector3& Vector3::operator/= ( double val )
-{
-    _x /= val;
-    _y /= val;
-    _z /= val;
-    
-    return (*this);
+    _items[ 0 ] = x;
+    _items[ 1 ] = y;
+    _items[ 2 ] = z;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
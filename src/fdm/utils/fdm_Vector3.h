@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/utils/fdm_Quaternion.h>
+#include <fdm/utils/fdm_Simd.h>
 #include <fdm/utils/fdm_Vector.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,26 +55,29 @@ public:
     /** @brief Constructor. */
     Vector3();
 
-    /** @brief Copy constructor. */
-    Vector3( const Vector3 &vect );
-
     /** @brief Constructor. */
     Vector3( const double items[] );
 
     /** @brief Constructor. */
     Vector3( double x, double y, double z );
 
+    /** @brief Constructor (evaluates vector expression). */
+    template < class E >
+    Vector3( const VectorExpr< E, 3 > &expr ) :
+        Vector< 3 > ( expr )
+    {}
+
     /** @return vector length squared */
-    inline double getLength2() const { return _x*_x + _y*_y + _z*_z; }
+    inline double getLength2() const { return x()*x() + y()*y() + z()*z(); }
 
     /** @return length of projection of vector on XY-plane */
-    inline double getLengthXY() const { return sqrt( _x*_x + _y*_y ); }
+    inline double getLengthXY() const { return sqrt( x()*x() + y()*y() ); }
 
     /** @return length of projection of vector on XZ-plane */
-    inline double getLengthXZ() const { return sqrt( _x*_x + _z*_z ); }
+    inline double getLengthXZ() const { return sqrt( x()*x() + z()*z() ); }
 
     /** @return length of projection of vector on YZ-plane */
-    inline double getLengthYZ() const { return sqrt( _y*_y + _z*_z ); }
+    inline double getLengthYZ() const { return sqrt( y()*y() + z()*z() ); }
 
     /** @return normalized vector */
     Vector3 getNormalized() const;
@@ -81,86 +85,64 @@ public:
     /** @return rotated vector (passive or alias rotation) */
     Vector3 getRotated( const Quaternion quat );
 
-    inline double  x() const { return _x; }
-    inline double  y() const { return _y; }
-    inline double  z() const { return _z; }
-    inline double& x()       { return _x; }
-    inline double& y()       { return _y; }
-    inline double& z()       { return _z; }
-
-    inline double  p() const { return _x; }
-    inline double  q() const { return _y; }
-    inline double  r() const { return _z; }
-    inline double& p()       { return _x; }
-    inline double& q()       { return _y; }
-    inline double& r()       { return _z; }
-
-    inline double  u() const { return _x; }
-    inline double  v() const { return _y; }
-    inline double  w() const { return _z; }
-    inline double& u()       { return _x; }
-    inline double& v()       { return _y; }
-    inline double& w()       { return _z; }
+    inline double  x() const { return _items[ 0 ]; }
+    inline double  y() const { return _items[ 1 ]; }
+    inline double  z() const { return _items[ 2 ]; }
+    inline double& x()       { return _items[ 0 ]; }
+    inline double& y()       { return _items[ 1 ]; }
+    inline double& z()       { return _items[ 2 ]; }
+
+    inline double  p() const { return _items[ 0 ]; }
+    inline double  q() const { return _items[ 1 ]; }
+    inline double  r() const { return _items[ 2 ]; }
+    inline double& p()       { return _items[ 0 ]; }
+    inline double& q()       { return _items[ 1 ]; }
+    inline double& r()       { return _items[ 2 ]; }
+
+    inline double  u() const { return _items[ 0 ]; }
+    inline double  v() const { return _items[ 1 ]; }
+    inline double  w() const { return _items[ 2 ]; }
+    inline double& u()       { return _items[ 0 ]; }
+    inline double& v()       { return _items[ 1 ]; }
+    inline double& w()       { return _items[ 2 ]; }
 
     /** @brief Sets vector values. */
     void set( double x, double y, double z );
 
-    /** @brief Assignment operator. */
-    const Vector3& operator= ( const Vector3 &vect );
-
-    /** @brief Addition operator. */
-    Vector3 operator+ ( const Vector3 &vect ) const;
-
-    /** @brief Negation operator. */
-    Vector3 operator- () const;
-
-    /** @brief Subtraction operator. */
-    Vector3 operator- ( const Vector3 &vect ) const;
-
-    /** @brief Multiplication operator (by scalar). */
-    Vector3 operator* ( double val ) const;
-
-    /** @brief Division operator (by scalar). */
-    Vector3 operator/ ( double val ) const;
-
-    /** @brief Dot product operator. */
-    double operator* ( const Vector3 &vect ) const;
-
-    /** @brief Cross product operator. */
-    Vector3 operator% ( const Vector3 &vect ) const;
-
-    /** @brief Unary addition operator. */
-    Vector3& operator+= ( const Vector3 &vect );
-
-    /** @brief Unary subtraction operator. */
-    Vector3& operator-= ( const Vector3 &vect );
-
-    /** @brief Unary multiplication operator (by scalar). */
-    Vector3& operator*= ( double val );
+    /** @brief Assignment operator (evaluates vector expression). */
+    template < class E >
+    const Vector3& operator= ( const VectorExpr< E, 3 > &expr )
+    {
+        assign( expr.self() );
 
-    /** @brief Unary division operator (by scalar). */
-    Vector3& operator/= ( double val );
+        return (*this);
+    }
 
     /** @brief Unary cross product operator. */
     Vector3& operator%= ( const Vector3 &vect );
-
-private:
-
-    double &_x;     ///< x element
-    double &_y;     ///< y element
-    double &_z;     ///< z element
 };
 
-} // end of fdm namespace
+/**
+ * @brief Cross product operator.
+ * Cross product is evaluated immediately as it cannot be computed item
+ * by item.
+ */
+template < class L, class R >
+inline Vector3 operator% ( const VectorExpr< L, 3 > &lhs,
+                           const VectorExpr< R, 3 > &rhs )
+{
+    const double a[] = { lhs.self()( 0 ), lhs.self()( 1 ), lhs.self()( 2 ) };
+    const double b[] = { rhs.self()( 0 ), rhs.self()( 1 ), rhs.self()( 2 ) };
 
-////////////////////////////////////////////////////////////////////////////////
+    Vector3 result;
 
-/** @brief Multiplication operator (by scalar). */
-inline fdm::Vector3 operator* ( double val, const fdm::Vector3 &vect )
-{
-    return ( vect * val );
+    Simd::cross3( a, b, result.getItems() );
+
+    return result;
 }
 
+} // end of fdm namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // FDM_VECTOR3_H
@@ -34,12 +34,6 @@ Vector4::Vector4() :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Vector4::Vector4( const Vector4 &vect ) :
-    Vector< 4 >( vect )
-{}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Vector4::Vector4( const double items[] ) :
     Vector< 4 >( items )
 {}
@@ -54,130 +48,3 @@ Vector4 Vector4::getNormalized() const
 
     return result;
 }
-
-////////////////////////////////////////////////////////////////////////////////
-
-const Vector4& Vector4::operator= ( const Vector4 &vect )
-{
-    setArray( vect._items );
-
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4 Vector4::operator+ ( const Vector4 &vect ) const
-{
-    Vector4 result;
-
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] + vect._items[ i ];
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4 Vector4::operator- () const
-{
-    Vector4 result;
-
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = -_items[ i ];
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4 Vector4::operator- ( const Vector4 &vect ) const
-{
-    Vector4 result;
-
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] - vect._items[ i ];
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4 Vector4::operator* ( double val ) const
-{
-    Vector4 result;
-
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] * val;
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4 Vector4::operator/ ( double val ) const
-{
-    Vector4 result;
-
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] / val;
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4& Vector4::operator+= ( const Vector4 &vect )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] += vect._items[ i ];
-    }
-
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4& Vector4::operator-= ( const Vector4 &vect )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] -= vect._items[ i ];
-    }
-
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4& Vector4::operator*= ( double val )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] *= val;
-    }
-
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector4& Vector4::operator/= ( double val )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] /= val;
-    }
-
-    return (*this);
-}
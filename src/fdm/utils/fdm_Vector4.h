@@ -41,57 +41,30 @@ public:
     /** @brief Constructor. */
     Vector4();
 
-    /** @brief Copy constructor. */
-    Vector4( const Vector4 &vect );
-
     /** @brief Constructor. */
     Vector4( const double items[] );
 
+    /** @brief Constructor (evaluates vector expression). */
+    template < class E >
+    Vector4( const VectorExpr< E, 4 > &expr ) :
+        Vector< 4 > ( expr )
+    {}
+
     /** @return normalized vector */
     Vector4 getNormalized() const;
 
-    /** @brief Assignment operator. */
-    const Vector4& operator= ( const Vector4 &vect );
-
-    /** @brief Addition operator. */
-    Vector4 operator+ ( const Vector4 &vect ) const;
-
-    /** @brief Negation operator. */
-    Vector4 operator- () const;
-
-    /** @brief Subtraction operator. */
-    Vector4 operator- ( const Vector4 &vect ) const;
-
-    /** @brief Multiplication operator (by scalar). */
-    Vector4 operator* ( double val ) const;
-
-    /** @brief Division operator (by scalar). */
-    Vector4 operator/ ( double val ) const;
-
-    /** @brief Unary addition operator. */
-    Vector4& operator+= ( const Vector4 &vect );
-
-    /** @brief Unary subtraction operator. */
-    Vector4& operator-= ( const Vector4 &vect );
-
-    /** @brief Unary multiplication operator (by scalar). */
-    Vector4& operator*= ( double val );
-
-    /** Unary division operator (by scalar). */
-    Vector4& operator/= ( double val );
+    /** @brief Assignment operator (evaluates vector expression). */
+    template < class E >
+    const Vector4& operator= ( const VectorExpr< E, 4 > &expr )
+    {
+        assign( expr.self() );
 
+        return (*this);
+    }
 };
 
 } // end of fdm namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 
-/** @brief Multiplication operator (by scalar). */
-inline fdm::Vector4 operator* ( double val, const fdm::Vector4 &vect )
-{
-    return ( vect * val );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 #endif // FDM_VECTOR4_H
@@ -34,12 +34,6 @@ Vector6::Vector6() :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Vector6::Vector6( const Vector6 &vect ) :
-    Vector< 6 >( vect )
-{}
-
-////////////////////////////////////////////////////////////////////////////////
-
 Vector6::Vector6( const double items[] ) :
     Vector< 6 >( items )
 {}
@@ -54,130 +48,3 @@ Vector6 Vector6::getNormalized() const
 
     return result;
 }
-
-////////////////////////////////////////////////////////////////////////////////
-
-const Vector6& Vector6::operator= ( const Vector6 &vect )
-{
-    setArray( vect._items );
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6 Vector6::operator+ ( const Vector6 &vect ) const
-{
-    Vector6 result;
-    
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] + vect._items[ i ];
-    }
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6 Vector6::operator- () const
-{
-    Vector6 result;
-    
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = - _items[ i ];
-    }
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6 Vector6::operator- ( const Vector6 &vect ) const
-{
-    Vector6 result;
-    
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] - vect._items[ i ];
-    }
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6 Vector6::operator* ( double val ) const
-{
-    Vector6 result;
-    
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] * val;
-    }
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6 Vector6::operator/ ( double val ) const
-{
-    Vector6 result;
-    
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        result._items[ i ] = _items[ i ] / val;
-    }
-    
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6& Vector6::operator+= ( const Vector6 &vect )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] += vect._items[ i ];
-    }
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6& Vector6::operator-= ( const Vector6 &vect )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] -= vect._items[ i ];
-    }
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6& Vector6::operator*= ( double val )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] *= val;
-    }
-    
-    return (*this);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-Vector6& Vector6::operator/= ( double val )
-{
-    for ( unsigned int i = 0; i < _size; i++ )
-    {
-        _items[ i ] /= val;
-    }
-    
-    return (*this);
-}
@@ -41,57 +41,30 @@ public:
     /** @brief Constructor. */
     Vector6();
 
-    /** @brief Copy constructor. */
-    Vector6( const Vector6 &vect );
-
     /** @brief Constructor. */
     Vector6( const double items[] );
 
+    /** @brief Constructor (evaluates vector expression). */
+    template < class E >
+    Vector6( const VectorExpr< E, 6 > &expr ) :
+        Vector< 6 > ( expr )
+    {}
+
     /** @return normalized vector */
     Vector6 getNormalized() const;
 
-    /** @brief Assignment operator. */
-    const Vector6& operator= ( const Vector6 &vect );
-
-    /** @brief Addition operator. */
-    Vector6 operator+ ( const Vector6 &vect ) const;
-
-    /** @brief Negation operator. */
-    Vector6 operator- () const;
-
-    /** @brief Subtraction operator. */
-    Vector6 operator- ( const Vector6 &vect ) const;
-
-    /** @brief Multiplication operator (by scalar). */
-    Vector6 operator* ( double val ) const;
-
-    /** @brief Division operator (by scalar). */
-    Vector6 operator/ ( double val ) const;
-
-    /** @brief Unary addition operator. */
-    Vector6& operator+= ( const Vector6 &vect );
-
-    /** @brief Unary subtraction operator. */
-    Vector6& operator-= ( const Vector6 &vect );
-
-    /** @brief Unary multiplication operator (by scalar). */
-    Vector6& operator*= ( double val );
-
-    /** @brief Unary division operator (by scalar). */
-    Vector6& operator/= ( double val );
+    /** @brief Assignment operator (evaluates vector expression). */
+    template < class E >
+    const Vector6& operator= ( const VectorExpr< E, 6 > &expr )
+    {
+        assign( expr.self() );
 
+        return (*this);
+    }
 };
 
 } // end of fdm namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 
-/** @brief Multiplication operator (by scalar). */
-inline fdm::Vector6 operator* ( double val, const fdm::Vector6 & vect )
-{
-    return ( vect * val );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
 #endif // FDM_VECTOR6_H
@@ -0,0 +1,275 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_VECTOREXPR_H
+#define FDM_VECTOREXPR_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+template < unsigned int SIZE > class Vector;
+
+/**
+ * @brief Vector expression base class template.
+ *
+ * Vector arithmetic operators do not compute their results immediately but
+ * return lightweight expression objects instead. Compound expressions, e.g.
+ * a + b * ( c - d ), are evaluated item by item in a single loop when they
+ * are assigned to a vector, so no temporary vectors are created.
+ *
+ * Expressions keep references to their vector operands, therefore they are
+ * meant to be evaluated within the same full expression and should never be
+ * stored.
+ *
+ * @tparam E expression type
+ * @tparam SIZE vector size
+ */
+template < class E, unsigned int SIZE >
+class VectorExpr
+{
+public:
+
+    /** @return expression object */
+    inline const E& self() const
+    {
+        return static_cast< const E& >( *this );
+    }
+};
+
+/**
+ * @brief Vector expression operand type.
+ * Expression operands are stored by value, while vectors by reference.
+ */
+template < class E >
+struct VectorExprRef
+{
+    typedef const E Type;
+};
+
+/**
+ * @brief Vector expression operand type.
+ * Expression operands are stored by value, while vectors by reference.
+ */
+template < unsigned int SIZE >
+struct VectorExprRef< Vector< SIZE > >
+{
+    typedef const Vector< SIZE > &Type;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Vector sum expression. */
+template < class L, class R, unsigned int SIZE >
+class VectorSum : public VectorExpr< VectorSum< L, R, SIZE >, SIZE >
+{
+public:
+
+    /** @brief Constructor. */
+    VectorSum( const L &lhs, const R &rhs ) :
+        _lhs ( lhs ),
+        _rhs ( rhs )
+    {}
+
+    /** @brief Items accessor. */
+    inline double operator() ( unsigned int index ) const
+    {
+        return _lhs( index ) + _rhs( index );
+    }
+
+private:
+
+    typename VectorExprRef< L >::Type _lhs;     ///< left hand side operand
+    typename VectorExprRef< R >::Type _rhs;     ///< right hand side operand
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Vector difference expression. */
+template < class L, class R, unsigned int SIZE >
+class VectorDifference : public VectorExpr< VectorDifference< L, R, SIZE >, SIZE >
+{
+public:
+
+    /** @brief Constructor. */
+    VectorDifference( const L &lhs, const R &rhs ) :
+        _lhs ( lhs ),
+        _rhs ( rhs )
+    {}
+
+    /** @brief Items accessor. */
+    inline double operator() ( unsigned int index ) const
+    {
+        return _lhs( index ) - _rhs( index );
+    }
+
+private:
+
+    typename VectorExprRef< L >::Type _lhs;     ///< left hand side operand
+    typename VectorExprRef< R >::Type _rhs;     ///< right hand side operand
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Vector negation expression. */
+template < class E, unsigned int SIZE >
+class VectorNegation : public VectorExpr< VectorNegation< E, SIZE >, SIZE >
+{
+public:
+
+    /** @brief Constructor. */
+    VectorNegation( const E &expr ) :
+        _expr ( expr )
+    {}
+
+    /** @brief Items accessor. */
+    inline double operator() ( unsigned int index ) const
+    {
+        return - _expr( index );
+    }
+
+private:
+
+    typename VectorExprRef< E >::Type _expr;    ///< operand
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Vector multiplied by scalar expression. */
+template < class E, unsigned int SIZE >
+class VectorProduct : public VectorExpr< VectorProduct< E, SIZE >, SIZE >
+{
+public:
+
+    /** @brief Constructor. */
+    VectorProduct( const E &expr, double val ) :
+        _expr ( expr ),
+        _val  ( val )
+    {}
+
+    /** @brief Items accessor. */
+    inline double operator() ( unsigned int index ) const
+    {
+        return _expr( index ) * _val;
+    }
+
+private:
+
+    typename VectorExprRef< E >::Type _expr;    ///< operand
+    const double _val;                          ///< scalar
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Vector divided by scalar expression. */
+template < class E, unsigned int SIZE >
+class VectorQuotient : public VectorExpr< VectorQuotient< E, SIZE >, SIZE >
+{
+public:
+
+    /** @brief Constructor. */
+    VectorQuotient( const E &expr, double val ) :
+        _expr ( expr ),
+        _val  ( val )
+    {}
+
+    /** @brief Items accessor. */
+    inline double operator() ( unsigned int index ) const
+    {
+        return _expr( index ) / _val;
+    }
+
+private:
+
+    typename VectorExprRef< E >::Type _expr;    ///< operand
+    const double _val;                          ///< scalar
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** @brief Addition operator. */
+template < class L, class R, unsigned int SIZE >
+inline VectorSum< L, R, SIZE > operator+ ( const VectorExpr< L, SIZE > &lhs,
+                                           const VectorExpr< R, SIZE > &rhs )
+{
+    return VectorSum< L, R, SIZE >( lhs.self(), rhs.self() );
+}
+
+/** @brief Subtraction operator. */
+template < class L, class R, unsigned int SIZE >
+inline VectorDifference< L, R, SIZE > operator- ( const VectorExpr< L, SIZE > &lhs,
+                                                  const VectorExpr< R, SIZE > &rhs )
+{
+    return VectorDifference< L, R, SIZE >( lhs.self(), rhs.self() );
+}
+
+/** @brief Negation operator. */
+template < class E, unsigned int SIZE >
+inline VectorNegation< E, SIZE > operator- ( const VectorExpr< E, SIZE > &expr )
+{
+    return VectorNegation< E, SIZE >( expr.self() );
+}
+
+/** @brief Multiplication operator (by scalar). */
+template < class E, unsigned int SIZE >
+inline VectorProduct< E, SIZE > operator* ( const VectorExpr< E, SIZE > &expr,
+                                            double val )
+{
+    return VectorProduct< E, SIZE >( expr.self(), val );
+}
+
+/** @brief Multiplication operator (by scalar). */
+template < class E, unsigned int SIZE >
+inline VectorProduct< E, SIZE > operator* ( double val,
+                                            const VectorExpr< E, SIZE > &expr )
+{
+    return VectorProduct< E, SIZE >( expr.self(), val );
+}
+
+/** @brief Division operator (by scalar). */
+template < class E, unsigned int SIZE >
+inline VectorQuotient< E, SIZE > operator/ ( const VectorExpr< E, SIZE > &expr,
+                                             double val )
+{
+    return VectorQuotient< E, SIZE >( expr.self(), val );
+}
+
+/** @brief Dot product operator. */
+template < class L, class R, unsigned int SIZE >
+inline double operator* ( const VectorExpr< L, SIZE > &lhs,
+                          const VectorExpr< R, SIZE > &rhs )
+{
+    double result = lhs.self()( 0 ) * rhs.self()( 0 );
+
+    for ( unsigned int i = 1; i < SIZE; i++ )
+    {
+        result += lhs.self()( i ) * rhs.self()( i );
+    }
+
+    return result;
+}
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_VECTOREXPR_H
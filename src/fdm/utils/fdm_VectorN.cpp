@@ -116,6 +116,7 @@ void VectorN::getArray( double items[] ) const
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifndef FDM_UNCHECKED
 double VectorN::getItem( unsigned int index ) const
 {
     if ( index < _size )
@@ -134,6 +135,7 @@ double VectorN::getItem( unsigned int index ) const
 
     return std::numeric_limits< double >::quiet_NaN();
 }
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -147,6 +149,7 @@ void VectorN::setArray( const double items[] )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifndef FDM_UNCHECKED
 void VectorN::setItem( unsigned int index, double val )
 {
     if ( index < _size )
@@ -163,6 +166,7 @@ void VectorN::setItem( unsigned int index, double val )
         FDM_THROW( e );
     }
 }
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -53,39 +53,49 @@ public:
     VectorN( const VectorN &vect );
 
     /** @brief Destructor. */
-    virtual ~VectorN();
+    ~VectorN();
 
     /** @return TRUE if all items are valid */
-    virtual bool isValid() const;
+    bool isValid() const;
 
     /** @return vector length */
-    virtual double getLength() const;
+    double getLength() const;
 
     /** @brief This function normalizes vector. */
-    virtual void normalize();
+    void normalize();
 
     /** @brief uts vector items into given array. */
-    virtual void getArray( double items[] ) const;
+    void getArray( double items[] ) const;
 
     /**
      * @brief Gets vector item of given indicies.
      * This function is bound-checked which may affect performance.
-     * Throws an exception when index is out of range.
+     * Throws an exception when index is out of range. If FDM_UNCHECKED is
+     * defined this function is not bound-checked and is inlined.
      * @return vector item of given indicies.
      */
-    virtual double getItem( unsigned int index ) const;
+#   ifdef FDM_UNCHECKED
+    inline double getItem( unsigned int index ) const { return _items[ index ]; }
+#   else
+    double getItem( unsigned int index ) const;
+#   endif
 
     /** @brief Sets vector items from given array. */
-    virtual void setArray( const double items[] );
+    void setArray( const double items[] );
 
     /**
      * @brief Sets vector item of given indicies.
      * This function is bound-checked which may affect performance.
-     * Throws an exception when index is out of range.
+     * Throws an exception when index is out of range. If FDM_UNCHECKED is
+     * defined this function is not bound-checked and is inlined.
      */
-    virtual void setItem( unsigned int index, double val );
+#   ifdef FDM_UNCHECKED
+    inline void setItem( unsigned int index, double val ) { _items[ index ] = val; }
+#   else
+    void setItem( unsigned int index, double val );
+#   endif
 
-    virtual void setValue( double val );
+    void setValue( double val );
 
     /**
      * @brief Returns vector size (number of elements)
@@ -94,13 +104,13 @@ public:
     inline unsigned int getSize() const { return _size; }
 
     /** @brief Returns string representation of the vector. */
-    virtual std::string toString() const;
+    std::string toString() const;
 
     /** @brief Resizes vector if needed. */
-    virtual void resize( unsigned int size );
+    void resize( unsigned int size );
 
     /** @brief Sets all vector items to zero. */
-    virtual void zeroize();
+    void zeroize();
 
     /**
      * @brief Items accessor.
@@ -185,16 +195,14 @@ protected:
     double *_items;         ///< vector items
 };
 
-} // end of fdm namespace
-
-////////////////////////////////////////////////////////////////////////////////
-
 /** @brief Multiplication operator (by scalar). */
-inline fdm::VectorN operator* ( double val, const fdm::VectorN & vect )
+inline VectorN operator* ( double val, const VectorN & vect )
 {
     return ( vect * val );
 }
 
+} // end of fdm namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // FDM_VECTORN_H
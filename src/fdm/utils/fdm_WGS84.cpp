@@ -22,6 +22,8 @@
 
 #include <fdm/utils/fdm_WGS84.h>
 
+#include <limits>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace fdm;
@@ -151,7 +153,7 @@ void WGS84::wgs2geo( double x, double y, double z,
     double f  = 54.0 * _b2 * z2;
     double g  = r2 + ( 1.0 - _e2 )*z2 - _e2*e2;
     double c  = _e2*_e2 * f * r2 / ( g*g*g );
-    double s  = pow( 1.0 + c + sqrt( c*c + 2.0*c ), 1.0/3.0 );
+    double s  = cbrt( 1.0 + c + sqrt( c*c + 2.0*c ) );
     double p0 = s + 1.0/s + 1.0;
     double p  = f / ( 3.0 * p0*p0 * g*g );
     double q  = sqrt( 1.0 + 2.0*( _e2*_e2 )*p );
@@ -162,7 +164,7 @@ void WGS84::wgs2geo( double x, double y, double z,
     double z0 = _b2 * z / ( _a * v );
 
     alt = u * ( 1.0 - _b2 / ( _a * v ) );
-    lat = atan( ( z + _ep2*z0 )/r );
+    lat = atan2( z + _ep2*z0, r );
     lon = atan2( y, x );
 #   endif
 }
@@ -194,7 +196,14 @@ void WGS84::wgs2geo( const Vector3 &pos_wgs, Geo &pos_geo )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-WGS84::WGS84()
+WGS84::WGS84() :
+    _trig_lat ( std::numeric_limits< double >::quiet_NaN() ),
+    _trig_lon ( std::numeric_limits< double >::quiet_NaN() ),
+
+    _sinLat ( 0.0 ),
+    _cosLat ( 1.0 ),
+    _sinLon ( 0.0 ),
+    _cosLon ( 1.0 )
 {
     _pos_geo.lat = 0.0;
     _pos_geo.lon = 0.0;
@@ -221,18 +230,40 @@ WGS84::WGS84( const WGS84 &wgs )
     _ned2wgs = wgs._ned2wgs;
     _wgs2enu = wgs._wgs2enu;
     _wgs2ned = wgs._wgs2ned;
+
+    _trig_lat = wgs._trig_lat;
+    _trig_lon = wgs._trig_lon;
+
+    _sinLat = wgs._sinLat;
+    _cosLat = wgs._cosLat;
+    _sinLon = wgs._sinLon;
+    _cosLon = wgs._cosLon;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-WGS84::WGS84( const Geo &pos_geo )
+WGS84::WGS84( const Geo &pos_geo ) :
+    _trig_lat ( std::numeric_limits< double >::quiet_NaN() ),
+    _trig_lon ( std::numeric_limits< double >::quiet_NaN() ),
+
+    _sinLat ( 0.0 ),
+    _cosLat ( 1.0 ),
+    _sinLon ( 0.0 ),
+    _cosLon ( 1.0 )
 {
     setPos_Geo( pos_geo );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-WGS84::WGS84( const Vector3 &pos_wgs )
+WGS84::WGS84( const Vector3 &pos_wgs ) :
+    _trig_lat ( std::numeric_limits< double >::quiet_NaN() ),
+    _trig_lon ( std::numeric_limits< double >::quiet_NaN() ),
+
+    _sinLat ( 0.0 ),
+    _cosLat ( 1.0 ),
+    _sinLon ( 0.0 ),
+    _cosLon ( 1.0 )
 {
     setPos_WGS( pos_wgs );
 }
@@ -273,7 +304,15 @@ void WGS84::setPos_Geo( const Geo &pos_geo )
     _pos_geo.lon = pos_geo.lon;
     _pos_geo.alt = pos_geo.alt;
 
-    geo2wgs( _pos_geo, _pos_wgs );
+    updateTrig();
+
+    // the same as geo2wgs(), but reusing trigonometric functions
+    double n = _a / sqrt( 1.0 - _e2 * _sinLat*_sinLat );
+
+    _pos_wgs.x() = ( n + _pos_geo.alt ) * _cosLat * _cosLon;
+    _pos_wgs.y() = ( n + _pos_geo.alt ) * _cosLat * _sinLon;
+    _pos_wgs.z() = ( n * ( _b2 / _a2 ) + _pos_geo.alt ) * _sinLat;
+
     update();
 }
 
@@ -289,19 +328,42 @@ void WGS84::setPos_WGS( const Vector3 &pos_wgs )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void WGS84::updateTrig()
+{
+    if ( _pos_geo.lat != _trig_lat )
+    {
+        _sinLat = sin( _pos_geo.lat );
+        _cosLat = cos( _pos_geo.lat );
+
+        _trig_lat = _pos_geo.lat;
+    }
+
+    if ( _pos_geo.lon != _trig_lon )
+    {
+        _sinLon = sin( _pos_geo.lon );
+        _cosLon = cos( _pos_geo.lon );
+
+        _trig_lon = _pos_geo.lon;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void WGS84::update()
 {
-    double cosLat = cos( _pos_geo.lat );
-    double cosLon = cos( _pos_geo.lon );
-    double sinLat = sin( _pos_geo.lat );
-    double sinLon = sin( _pos_geo.lon );
+    updateTrig();
+
+    const double cosLat = _cosLat;
+    const double cosLon = _cosLon;
+    const double sinLat = _sinLat;
+    const double sinLon = _sinLon;
 
     double sinLat2 = sinLat*sinLat;
 
     // normal to ellipsoid
-    _norm_wgs( 0 ) = cosLat * cos( _pos_geo.lon );
-    _norm_wgs( 1 ) = cosLat * sin( _pos_geo.lon );
-    _norm_wgs( 2 ) = sin( _pos_geo.lat );
+    _norm_wgs( 0 ) = cosLat * cosLon;
+    _norm_wgs( 1 ) = cosLat * sinLon;
+    _norm_wgs( 2 ) = sinLat;
 
     // gravity formula (NIMA TR-8350.2 - Department of Defence World Geodetic System 1984, p. 4-2)
     double gamma_0 = _gamma_e * ( 1.0 + _k * sinLat2 ) / sqrt( 1.0 - _e2 * sinLat2 );
@@ -223,6 +223,21 @@ private:
     Matrix3x3 _wgs2enu;     ///< rotation matrix from WGS to ENU
     Matrix3x3 _wgs2ned;     ///< rotation matrix from WGS to NED
 
+    double _trig_lat;       ///< [rad] latitude for which trigonometric functions were calculated
+    double _trig_lon;       ///< [rad] longitude for which trigonometric functions were calculated
+
+    double _sinLat;         ///< [-] sine of latitude
+    double _cosLat;         ///< [-] cosine of latitude
+    double _sinLon;         ///< [-] sine of longitude
+    double _cosLon;         ///< [-] cosine of longitude
+
+    /**
+     * @brief Updates trigonometric functions of latitude and longitude.
+     * Trigonometric functions are calculated only when the current geodetic
+     * coordinates differ from the ones used in the previous call.
+     */
+    void updateTrig();
+
     /**
      * @brief Updates data due to position.
      * This function updates location (normal to ellipsoid vector, gravity
@@ -0,0 +1,241 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <fdm/utils/fdm_WorkerPool.h>
+
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_ThreadPlacement.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace fdm;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const unsigned int WorkerPool::_spinCount = 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int WorkerPool::getHardwareThreads()
+{
+    unsigned int threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr< WorkerPool > WorkerPool::getShared( unsigned int threads )
+{
+    static std::mutex mutex;
+    static std::weak_ptr< WorkerPool > shared;
+
+    std::lock_guard< std::mutex > lock( mutex );
+
+    std::shared_ptr< WorkerPool > pool = shared.lock();
+
+    if ( !pool || pool->getThreads() < threads )
+    {
+        pool = std::make_shared< WorkerPool >( threads );
+        shared = pool;
+    }
+
+    return pool;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+WorkerPool::WorkerPool( unsigned int threads ) :
+    _task  ( FDM_NULLPTR ),
+    _count ( 0 ),
+    _next  ( 0 ),
+    _busy  ( 0 ),
+    _runs  ( 0 ),
+    _quit  ( false )
+{
+    for ( unsigned int i = 1; i < threads; i++ )
+    {
+        _workers.push_back( std::thread( &WorkerPool::work, this ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _quit = true;
+        _runs++;
+    }
+
+    _cv_start.notify_all();
+
+    for ( unsigned int i = 0; i < _workers.size(); i++ )
+    {
+        if ( _workers[ i ].joinable() ) _workers[ i ].join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPool::run( unsigned int count, const Task &task )
+{
+    std::lock_guard< std::mutex > lock( _runMutex );
+    runLocked( count, task );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool WorkerPool::tryRun( unsigned int count, const Task &task )
+{
+    std::unique_lock< std::mutex > lock( _runMutex, std::try_to_lock );
+
+    if ( !lock.owns_lock() ) return false;
+
+    runLocked( count, task );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPool::runLocked( unsigned int count, const Task &task )
+{
+    if ( _workers.empty() || count < 2 )
+    {
+        for ( unsigned int i = 0; i < count; i++ ) task( i );
+        return;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        _task  = &task;
+        _count = count;
+        _next  = 0;
+        _busy  = _workers.size();
+
+        _exception = std::exception_ptr();
+
+        _runs++;
+    }
+
+    _cv_start.notify_all();
+
+    // calling thread is also a worker
+    try
+    {
+        execute();
+    }
+    catch ( ... )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if ( !_exception ) _exception = std::current_exception();
+    }
+
+    // barrier
+    for ( unsigned int i = 0; i < _spinCount && _busy > 0; i++ )
+    {
+        std::this_thread::yield();
+    }
+
+    if ( _busy > 0 )
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+        _cv_done.wait( lock, [ this ] { return _busy == 0; } );
+    }
+
+    _task = FDM_NULLPTR;
+
+    if ( _exception )
+    {
+        std::exception_ptr exception = _exception;
+        _exception = std::exception_ptr();
+        std::rethrow_exception( exception );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPool::execute()
+{
+    unsigned int index = _next++;
+
+    while ( index < _count )
+    {
+        (*_task)( index );
+        index = _next++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPool::work()
+{
+    if ( !ThreadPlacement::apply( ThreadPlacement::Workers ) )
+    {
+        Log::w() << "Cannot set worker thread CPU affinity." << std::endl;
+    }
+
+    unsigned int runs = 0;
+
+    while ( true )
+    {
+        // waiting for the next run
+        for ( unsigned int i = 0; i < _spinCount && _runs == runs; i++ )
+        {
+            std::this_thread::yield();
+        }
+
+        if ( _runs == runs )
+        {
+            std::unique_lock< std::mutex > lock( _mutex );
+            _cv_start.wait( lock, [ this, runs ] { return _runs != runs; } );
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+
+            if ( _quit ) break;
+
+            runs = _runs;
+        }
+
+        try
+        {
+            execute();
+        }
+        catch ( ... )
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            if ( !_exception ) _exception = std::current_exception();
+        }
+
+        // last worker done notifies calling thread
+        if ( --_busy == 0 )
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            _cv_done.notify_one();
+        }
+    }
+}
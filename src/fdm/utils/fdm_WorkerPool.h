@@ -0,0 +1,156 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef FDM_WORKERPOOL_H
+#define FDM_WORKERPOOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fdm/fdm_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace fdm
+{
+
+/**
+ * @brief Persistent worker threads pool class.
+ *
+ * Pool is intended for splitting short, frequently repeated computations
+ * (e.g. rotor blades integration within a single sub-step) among a few
+ * threads. Worker threads are started once and wait for work between runs,
+ * spinning for a short while before blocking, so dispatch latency is small
+ * compared to starting threads on every run. Calling thread takes part in
+ * the computations and each run ends with a barrier.
+ *
+ * Exception thrown by a task is rethrown in the calling thread.
+ *
+ * Single pool is shared by all users within the process (see getShared()),
+ * so the number of worker threads doesn't grow with the number of users
+ * (e.g. rotors of many concurrently running FDM instances). Runs are
+ * serialized, tryRun() doesn't wait for the pool to be released and lets
+ * the caller do the work itself instead.
+ */
+class FDMEXPORT WorkerPool
+{
+public:
+
+    typedef std::function< void ( unsigned int ) > Task;
+
+    /**
+     * @brief Returns number of hardware threads.
+     * @return number of hardware threads (at least 1)
+     */
+    static unsigned int getHardwareThreads();
+
+    /**
+     * @brief Returns pool shared within the process.
+     * Pool is created on first call and destroyed when the last user
+     * releases it. Pool having fewer threads than requested is replaced for
+     * the caller, existing users keep their pool.
+     * @param threads total number of threads including calling thread
+     * @return shared pool
+     */
+    static std::shared_ptr< WorkerPool > getShared( unsigned int threads );
+
+    /**
+     * @brief Constructor.
+     * @param threads total number of threads including calling thread
+     */
+    WorkerPool( unsigned int threads );
+
+    /** @brief Destructor. */
+    virtual ~WorkerPool();
+
+    /**
+     * @brief Runs task for every index from 0 to count - 1 and waits until
+     * all tasks have been completed.
+     * @param count number of tasks
+     * @param task task function called with task index
+     */
+    void run( unsigned int count, const Task &task );
+
+    /**
+     * @brief Runs task for every index from 0 to count - 1 unless the pool
+     * is being run by another thread.
+     * @param count number of tasks
+     * @param task task function called with task index
+     * @return true if tasks have been completed, false if pool is busy and nothing was done
+     */
+    bool tryRun( unsigned int count, const Task &task );
+
+    inline unsigned int getThreads() const { return _workers.size() + 1; }
+
+private:
+
+    static const unsigned int _spinCount;   ///< number of checks before blocking
+
+    std::vector< std::thread > _workers;    ///< worker threads
+
+    std::mutex _runMutex;                   ///< mutex serializing runs
+    std::mutex _mutex;                      ///< mutex guarding run state
+    std::condition_variable _cv_start;      ///< run start condition
+    std::condition_variable _cv_done;       ///< run done condition
+
+    const Task *_task;                      ///< current task
+    unsigned int _count;                    ///< current number of tasks
+
+    std::atomic< unsigned int > _next;      ///< next task index
+    std::atomic< unsigned int > _busy;      ///< number of busy workers
+    std::atomic< unsigned int > _runs;      ///< number of started runs
+
+    std::exception_ptr _exception;          ///< first exception thrown by a task
+
+    bool _quit;                             ///< specifies if workers should quit
+
+    /**
+     * Using this constructor is forbidden.
+     */
+    WorkerPool( const WorkerPool & );
+
+    /**
+     * @brief Runs tasks, has to be called with run mutex locked.
+     * @param count number of tasks
+     * @param task task function called with task index
+     */
+    void runLocked( unsigned int count, const Task &task );
+
+    /** @brief Executes tasks until there are no more indices left. */
+    void execute();
+
+    /** @brief Worker thread function. */
+    void work();
+};
+
+} // end of fdm namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // FDM_WORKERPOOL_H
@@ -22,16 +22,291 @@
 
 #include <fdm/xml/fdm_XmlDoc.h>
 
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <libxml/parser.h>
+#include <libxml/SAX2.h>
+
 #include <fdm/fdm_Defines.h>
 
+#ifdef _LINUX_
+#   include <unistd.h>
+#endif
+
+#ifdef WIN32
+#   include <process.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace fdm;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const UInt32 noNode = 0xFFFFFFFF;     ///< index meaning no node
+
+std::atomic< UInt32 > tempFileCounter( 0 );     ///< temporary cache files counter
+
+// identifies process, so temporary cache files of concurrent processes differ
+int getProcessId()
+{
+#   ifdef _LINUX_
+    return (int)getpid();
+#   endif
+
+#   ifdef WIN32
+    return _getpid();
+#   endif
+}
+
+/**
+ * Document nodes builder fed by libxml2 SAX2 parser callbacks. Nodes are
+ * linked by indices while the array grows and converted into pointers when
+ * parsing is done.
+ */
+struct NodesBuilder
+{
+    xmlParserCtxtPtr ctxt;                  ///< parser context
+
+    std::vector< XmlNodeData > *nodes;      ///< nodes array
+
+    std::vector< UInt32 > children;         ///< first child index of each node
+    std::vector< UInt32 > next;             ///< next sibling index of each node
+
+    std::vector< UInt32 > parents;          ///< open elements
+    std::vector< UInt32 > last;             ///< last child of each open element
+
+    UInt32 lastTop;                         ///< last top level node
+    bool rootDone;                          ///< specifies if root element was closed
+};
+
+/** Appends node and links it with its parent and previous sibling. */
+UInt32 addNode( NodesBuilder *b, XmlNodeData::Type type, const char *name, int line )
+{
+    // only root element and nodes following it are stored, same as DOM tree
+    // root element siblings
+    if ( b->parents.empty() && !( type == XmlNodeData::ElementNode || b->rootDone ) )
+    {
+        return noNode;
+    }
+
+    UInt32 index = (UInt32)b->nodes->size();
+
+    b->nodes->push_back( XmlNodeData() );
+    b->children.push_back( noNode );
+    b->next.push_back( noNode );
+
+    XmlNodeData &data = b->nodes->back();
+
+    data.type = type;
+    data.line = line;
+    data.name = name;
+
+    UInt32 &prev = b->parents.empty() ? b->lastTop : b->last.back();
+
+    if ( prev != noNode )
+    {
+        b->next[ prev ] = index;
+    }
+    else if ( !b->parents.empty() )
+    {
+        b->children[ b->parents.back() ] = index;
+    }
+
+    prev = index;
+
+    return index;
+}
+
+/** Returns open element last child if it is of the given type and name. */
+XmlNodeData* getLastChild( NodesBuilder *b, XmlNodeData::Type type, const char *name )
+{
+    if ( b->parents.empty() || b->last.back() == noNode ) return FDM_NULLPTR;
+
+    XmlNodeData *data = &(*b->nodes)[ b->last.back() ];
+
+    if ( data->type == type && data->name == name ) return data;
+
+    return FDM_NULLPTR;
+}
+
+/** SAX2 element start callback. */
+void onStartElement( void *ctx, const xmlChar *localname, const xmlChar *,
+                     const xmlChar *, int, const xmlChar **,
+                     int nb_attributes, int, const xmlChar **attributes )
+{
+    NodesBuilder *b = (NodesBuilder*)ctx;
+
+    UInt32 index = addNode( b, XmlNodeData::ElementNode, (const char*)localname,
+                            xmlSAX2GetLineNumber( b->ctxt ) );
+
+    XmlNodeData &data = (*b->nodes)[ index ];
+
+    // attributes are given as localname, prefix, URI, value and value end
+    for ( int i = 0; i < nb_attributes; i++ )
+    {
+        const xmlChar **attr = attributes + 5 * i;
+
+        data.attributes.push_back( XmlNodeData::Attribute( (const char*)attr[ 0 ],
+                                   std::string( (const char*)attr[ 3 ],
+                                                (size_t)( attr[ 4 ] - attr[ 3 ] ) ) ) );
+    }
+
+    b->parents.push_back( index );
+    b->last.push_back( noNode );
+}
+
+/** SAX2 element end callback. */
+void onEndElement( void *ctx, const xmlChar *, const xmlChar *, const xmlChar * )
+{
+    NodesBuilder *b = (NodesBuilder*)ctx;
+
+    UInt32 index = b->parents.back();
+
+    b->parents.pop_back();
+    b->last.pop_back();
+
+    if ( b->parents.empty() )
+    {
+        b->lastTop  = index;
+        b->rootDone = true;
+    }
+}
+
+/** SAX2 characters callback, text is appended to the open text node. */
+void onCharacters( void *ctx, const xmlChar *ch, int len )
+{
+    NodesBuilder *b = (NodesBuilder*)ctx;
+
+    if ( b->parents.empty() ) return;
+
+    XmlNodeData *data = getLastChild( b, XmlNodeData::TextNode, "text" );
+
+    if ( data == FDM_NULLPTR )
+    {
+        UInt32 index = addNode( b, XmlNodeData::TextNode, "text",
+                                xmlSAX2GetLineNumber( b->ctxt ) );
+
+        data = &(*b->nodes)[ index ];
+    }
+
+    data->content.append( (const char*)ch, (size_t)len );
+}
+
+/** SAX2 CDATA block callback, CDATA content is not stored. */
+void onCDataBlock( void *ctx, const xmlChar *, int )
+{
+    NodesBuilder *b = (NodesBuilder*)ctx;
+
+    // long CDATA section is reported in several blocks
+    if ( getLastChild( b, XmlNodeData::OtherNode, "" ) == FDM_NULLPTR )
+    {
+        addNode( b, XmlNodeData::OtherNode, "", 0 );
+    }
+}
+
+/** SAX2 comment callback. */
+void onComment( void *ctx, const xmlChar * )
+{
+    NodesBuilder *b = (NodesBuilder*)ctx;
+
+    addNode( b, XmlNodeData::CommentNode, "comment", xmlSAX2GetLineNumber( b->ctxt ) );
+}
+
+/** SAX2 processing instruction callback. */
+void onProcessingInstruction( void *ctx, const xmlChar *target, const xmlChar * )
+{
+    NodesBuilder *b = (NodesBuilder*)ctx;
+
+    addNode( b, XmlNodeData::OtherNode, (const char*)target,
+             xmlSAX2GetLineNumber( b->ctxt ) );
+}
+
+/** Writes integer into stream. */
+void writeUInt32( std::ostream &out, UInt32 value )
+{
+    out.write( (const char*)&value, sizeof(UInt32) );
+}
+
+/** Writes string into stream. */
+void writeString( std::ostream &out, const std::string &str )
+{
+    writeUInt32( out, (UInt32)str.size() );
+    out.write( str.c_str(), str.size() );
+}
+
+/** Reads integer from buffer. */
+bool readUInt32( const std::string &buf, size_t *pos, UInt32 *value )
+{
+    if ( *pos + sizeof(UInt32) > buf.size() ) return false;
+
+    memcpy( value, buf.c_str() + *pos, sizeof(UInt32) );
+    *pos += sizeof(UInt32);
+
+    return true;
+}
+
+/** Reads string from buffer. */
+bool readString( const std::string &buf, size_t *pos, std::string *str )
+{
+    UInt32 size = 0;
+
+    if ( !readUInt32( buf, pos, &size ) ) return false;
+    if ( *pos + size > buf.size() ) return false;
+
+    str->assign( buf.c_str() + *pos, size );
+    *pos += size;
+
+    return true;
+}
+
+/** Reads whole file into string. */
+bool readWholeFile( const char *fileName, std::string *data )
+{
+    std::ifstream ifs( fileName, std::ios_base::in | std::ios_base::binary );
+
+    if ( !ifs.is_open() ) return false;
+
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    (*data) = ss.str();
+
+    return true;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char   XmlDoc::_cacheMagic[ 8 ] = { 'F', 'D', 'M', 'X', 'M', 'L', '0', '1' };
+const UInt32 XmlDoc::_none = 0xFFFFFFFF;
+
+bool XmlDoc::_cacheEnabled = false;
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDoc::setCacheEnabled( bool cacheEnabled )
+{
+    _cacheEnabled = cacheEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool XmlDoc::getCacheEnabled()
+{
+    return _cacheEnabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 XmlDoc::XmlDoc( const char *fileName ) :
-    _doc  ( 0 ),
     _open ( false ),
     _root ( FDM_NULLPTR )
 {
@@ -43,34 +318,261 @@ XmlDoc::XmlDoc( const char *fileName ) :
 XmlDoc::~XmlDoc()
 {
     FDM_DELPTR( _root );
-
-    xmlFreeDoc( _doc );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 int XmlDoc::readFile( const char *fileName )
 {
-    _doc = xmlParseFile( fileName );
+    FDM_DELPTR( _root );
+
+    _nodes.clear();
+    _open = false;
+
+    std::string data;
+
+    if ( !readWholeFile( fileName, &data ) )
+    {
+        return FDM_FAILURE;
+    }
+
+    int result = FDM_FAILURE;
+
+    if ( _cacheEnabled )
+    {
+        std::string cacheFile = std::string( fileName ) + ".cache";
+
+        UInt64 hash = getHash( data );
+
+        result = readCache( cacheFile, hash );
+
+        if ( result != FDM_SUCCESS )
+        {
+            result = parse( data, fileName );
+
+            if ( result == FDM_SUCCESS ) writeCache( cacheFile, hash );
+        }
+    }
+    else
+    {
+        result = parse( data, fileName );
+    }
+
+    if ( result == FDM_SUCCESS )
+    {
+        _root = new XmlNode( &_nodes[ 0 ], fileName );
+        _open = true;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int XmlDoc::parse( const std::string &data, const char *fileName )
+{
+    // document is parsed with SAX2 callbacks straight into the nodes array,
+    // so no intermediate libxml2 DOM tree is built, large table text nodes
+    // in particular are copied only once
+    xmlSAXHandler sax;
+    memset( &sax, 0, sizeof(xmlSAXHandler) );
+
+    sax.initialized           = XML_SAX2_MAGIC;
+    sax.startElementNs        = onStartElement;
+    sax.endElementNs          = onEndElement;
+    sax.characters            = onCharacters;
+    sax.ignorableWhitespace   = onCharacters;
+    sax.cdataBlock            = onCDataBlock;
+    sax.comment               = onComment;
+    sax.processingInstruction = onProcessingInstruction;
+
+    Nodes nodes;
+
+    NodesBuilder builder;
+
+    builder.nodes    = &nodes;
+    builder.lastTop  = noNode;
+    builder.rootDone = false;
+    builder.ctxt     = xmlCreatePushParserCtxt( &sax, &builder, 0, 0, fileName );
+
+    if ( builder.ctxt == 0 )
+    {
+        return FDM_FAILURE;
+    }
+
+    // entities are substituted, same as DOM tree attributes values
+    xmlCtxtUseOptions( builder.ctxt, XML_PARSE_NOENT );
+
+    xmlParseChunk( builder.ctxt, data.c_str(), (int)data.size(), 1 );
+
+    bool wellFormed = builder.ctxt->wellFormed != 0;
+
+    xmlFreeParserCtxt( builder.ctxt );
+
+    if ( !wellFormed || !builder.rootDone )
+    {
+        return FDM_FAILURE;
+    }
+
+    // array does not grow anymore, so indices can be turned into pointers
+    for ( size_t i = 0; i < nodes.size(); i++ )
+    {
+        XmlNodeData &node = nodes[ i ];
+
+        node.children = ( builder.children[ i ] != noNode ) ? &nodes[ builder.children[ i ] ] : FDM_NULLPTR;
+        node.next     = ( builder.next[ i ]     != noNode ) ? &nodes[ builder.next[ i ]     ] : FDM_NULLPTR;
+    }
+
+    // swapping does not move vector items, so links remain valid
+    _nodes.swap( nodes );
+
+    return FDM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int XmlDoc::readCache( const std::string &cacheFile, UInt64 hash )
+{
+    std::string buf;
+
+    if ( !readWholeFile( cacheFile.c_str(), &buf ) )
+    {
+        return FDM_FAILURE;
+    }
 
-    if ( _doc == 0 )
+    size_t pos = sizeof(_cacheMagic) + sizeof(UInt64);
+
+    if ( buf.size() < pos
+      || 0 != memcmp( buf.c_str(), _cacheMagic, sizeof(_cacheMagic) )
+      || 0 != memcmp( buf.c_str() + sizeof(_cacheMagic), &hash, sizeof(UInt64) ) )
     {
-        xmlFreeDoc( _doc );
         return FDM_FAILURE;
     }
 
-    xmlNodePtr root = xmlDocGetRootElement( _doc );
+    UInt32 count = 0;
 
-    if ( root == 0 )
+    if ( !readUInt32( buf, &pos, &count ) || count == 0 )
     {
-        xmlFreeNode( root );
-        xmlFreeDoc( _doc );
         return FDM_FAILURE;
     }
 
-    _root = new XmlNode( root, fileName );
+    Nodes nodes( count );
+
+    for ( UInt32 i = 0; i < count; i++ )
+    {
+        XmlNodeData &node = nodes[ i ];
+
+        UInt32 type  = 0;
+        UInt32 line  = 0;
+        UInt32 child = 0;
+        UInt32 next  = 0;
+        UInt32 attrs = 0;
+
+        bool ok = readUInt32( buf, &pos, &type  )
+               && readUInt32( buf, &pos, &line  )
+               && readUInt32( buf, &pos, &child )
+               && readUInt32( buf, &pos, &next  )
+               && readString( buf, &pos, &node.name    )
+               && readString( buf, &pos, &node.content )
+               && readUInt32( buf, &pos, &attrs );
+
+        // nodes are stored in document order, so links pointing backwards
+        // are invalid and would make cycles
+        if ( !ok || type > XmlNodeData::OtherNode
+          || ( child != _none && ( child >= count || child <= i ) )
+          || ( next  != _none && ( next  >= count || next  <= i ) ) )
+        {
+            return FDM_FAILURE;
+        }
+
+        node.type     = (XmlNodeData::Type)type;
+        node.line     = (int)line;
+        node.children = ( child != _none ) ? &nodes[ child ] : FDM_NULLPTR;
+        node.next     = ( next  != _none ) ? &nodes[ next  ] : FDM_NULLPTR;
+
+        for ( UInt32 j = 0; j < attrs; j++ )
+        {
+            XmlNodeData::Attribute attr;
+
+            if ( !readString( buf, &pos, &attr.first  )
+              || !readString( buf, &pos, &attr.second ) )
+            {
+                return FDM_FAILURE;
+            }
+
+            node.attributes.push_back( attr );
+        }
+    }
+
+    if ( pos != buf.size() )
+    {
+        return FDM_FAILURE;
+    }
 
-    _open = true;
+    // swapping does not move vector items, so links remain valid
+    _nodes.swap( nodes );
 
     return FDM_SUCCESS;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDoc::writeCache( const std::string &cacheFile, UInt64 hash ) const
+{
+    // written into temporary file first and then renamed, so concurrently
+    // created documents never read a partially written cache file, temporary
+    // file name is unique among threads and processes
+    std::stringstream tempFile;
+    tempFile << cacheFile << "." << getProcessId() << "." << tempFileCounter++;
+
+    std::ofstream ofs( tempFile.str().c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+
+    if ( !ofs.is_open() ) return;
+
+    ofs.write( _cacheMagic, sizeof(_cacheMagic) );
+    ofs.write( (const char*)&hash, sizeof(UInt64) );
+
+    writeUInt32( ofs, (UInt32)_nodes.size() );
+
+    const XmlNodeData *base = &_nodes[ 0 ];
+
+    for ( Nodes::const_iterator it = _nodes.begin(); it != _nodes.end(); ++it )
+    {
+        writeUInt32( ofs, (UInt32)(*it).type );
+        writeUInt32( ofs, (UInt32)(*it).line );
+        writeUInt32( ofs, (*it).children ? (UInt32)( (*it).children - base ) : _none );
+        writeUInt32( ofs, (*it).next     ? (UInt32)( (*it).next     - base ) : _none );
+        writeString( ofs, (*it).name );
+        writeString( ofs, (*it).content );
+        writeUInt32( ofs, (UInt32)(*it).attributes.size() );
+
+        for ( XmlNodeData::Attributes::const_iterator ia = (*it).attributes.begin();
+              ia != (*it).attributes.end(); ++ia )
+        {
+            writeString( ofs, (*ia).first  );
+            writeString( ofs, (*ia).second );
+        }
+    }
+
+    ofs.close();
+
+    if ( ofs.fail() || 0 != rename( tempFile.str().c_str(), cacheFile.c_str() ) )
+    {
+        remove( tempFile.str().c_str() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UInt64 XmlDoc::getHash( const std::string &data )
+{
+    UInt64 hash = 14695981039346656037ULL;
+
+    for ( size_t i = 0; i < data.size(); i++ )
+    {
+        hash ^= (UInt8)data[ i ];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
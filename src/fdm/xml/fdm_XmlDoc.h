@@ -25,8 +25,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <string>
+#include <vector>
 
-#include <libxml/tree.h>
+#include <fdm/fdm_Types.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -37,11 +38,27 @@ namespace fdm
 
 /**
  * @brief XML Document class.
+ *
+ * Document is parsed with libxml2 SAX2 parser straight into a parser
+ * independent tree of nodes, without building libxml2 DOM tree.
+ * When the binary cache is enabled the tree is also written into a cache file
+ * next to the XML file ("file_name.cache") and read from it the next time,
+ * skipping XML parsing. The cache is keyed on the XML file content hash, so
+ * stale cache files are ignored and rewritten.
  */
 class FDMEXPORT XmlDoc
 {
 public:
 
+    /**
+     * @brief Enables or disables binary cache.
+     * @param cacheEnabled specifies if binary cache is used
+     */
+    static void setCacheEnabled( bool cacheEnabled );
+
+    /** @return true if binary cache is used */
+    static bool getCacheEnabled();
+
     /** @brief Constrcutor. */
     XmlDoc( const char *fileName = "" );
 
@@ -71,9 +88,49 @@ public:
 
 private:
 
-    xmlDocPtr _doc;     ///< XML document pointer
-    bool _open;         ///< specifies if document is open
-    XmlNode *_root;     ///< XML document root node
+    typedef std::vector< XmlNodeData > Nodes;
+
+    static const char   _cacheMagic[ 8 ];   ///< cache file magic number
+    static const UInt32 _none;              ///< index meaning no node in the cache file
+
+    static bool _cacheEnabled;              ///< specifies if binary cache is used
+
+    Nodes _nodes;           ///< document nodes, the first one is the root node
+    bool _open;             ///< specifies if document is open
+    XmlNode *_root;         ///< XML document root node
+
+    /** Using this constructor is forbidden. */
+    XmlDoc( const XmlDoc & ) {}
+
+    /**
+     * @brief Parses XML document.
+     * @param data XML document content
+     * @param fileName XML file name
+     * @return FDM_SUCCESS on success, FDM_FAILURE on failure
+     */
+    int parse( const std::string &data, const char *fileName );
+
+    /**
+     * @brief Reads nodes from the cache file.
+     * @param cacheFile cache file name
+     * @param hash XML document content hash
+     * @return FDM_SUCCESS on success, FDM_FAILURE on failure
+     */
+    int readCache( const std::string &cacheFile, UInt64 hash );
+
+    /**
+     * @brief Writes nodes into the cache file.
+     * @param cacheFile cache file name
+     * @param hash XML document content hash
+     */
+    void writeCache( const std::string &cacheFile, UInt64 hash ) const;
+
+    /**
+     * @brief Computes hash (FNV-1a) of the XML document content.
+     * @param data XML document content
+     * @return content hash
+     */
+    static UInt64 getHash( const std::string &data );
 };
 
 } // end of fdm namespace
@@ -33,7 +33,7 @@ using namespace fdm;
 ////////////////////////////////////////////////////////////////////////////////
 
 XmlNode::XmlNode() :
-    _node ( 0 )
+    _node ( FDM_NULLPTR )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -45,7 +45,7 @@ XmlNode::XmlNode( const XmlNode &node ) :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-XmlNode::XmlNode( xmlNodePtr node, const char *file ) :
+XmlNode::XmlNode( const XmlNodeData *node, const char *file ) :
     _file ( file ),
     _node ( node )
 {}
@@ -60,29 +60,13 @@ std::string XmlNode::getAttribute( const char *name ) const
 {
     if ( hasAttributes() )
     {
-        xmlAttrPtr attr = _node->properties;
-
-        while ( attr != 0 )
+        for ( XmlNodeData::Attributes::const_iterator it = _node->attributes.begin();
+              it != _node->attributes.end(); ++it )
         {
-            if ( 0 == xmlStrcmp( attr->name, (const xmlChar*)name ) )
+            if ( 0 == strcmp( (*it).first.c_str(), name ) )
             {
-                if ( attr->children != 0 )
-                {
-                    xmlChar* value = xmlNodeListGetString( attr->children->doc, attr->children, 1);
-
-                    std::string result( (const char*)value );
-
-                    xmlFree( value );
-
-                    return result;
-                }
-                else
-                {
-                    return std::string();
-                }
+                return (*it).second;
             }
-
-            attr = attr->next;
         }
     }
 
@@ -98,23 +82,15 @@ XmlNode::Attributes XmlNode::getAttributes() const
 
     if ( hasAttributes() )
     {
-        xmlAttrPtr attr = _node->properties;
-
-        while ( attr != 0 )
+        for ( XmlNodeData::Attributes::const_iterator it = _node->attributes.begin();
+              it != _node->attributes.end(); ++it )
         {
-            if ( attr->children != 0 )
+            // attributes with empty value are omitted, as they were when
+            // read straight from the libxml2 tree
+            if ( (*it).second.length() > 0 )
             {
-                xmlChar* value = xmlNodeListGetString( attr->children->doc, attr->children, 1);
-
-                std::string strName( (const char*)attr->name );
-                std::string strValue( (const char*)value );
-
-                attributes.insert( std::pair<std::string,std::string>( strName, strValue ) );
-
-                xmlFree( value );
+                attributes.insert( std::pair<std::string,std::string>( (*it).first, (*it).second ) );
             }
-
-            attr = attr->next;
         }
     }
 
@@ -129,7 +105,7 @@ XmlNode XmlNode::getFirstChild() const
 
     if ( isValid() )
     {
-        if ( _node->children != 0 )
+        if ( _node->children != FDM_NULLPTR )
         {
             result._node = _node->children;
             result._file = _file;
@@ -147,13 +123,13 @@ XmlNode XmlNode::getFirstChildElement( const char *name ) const
 
     if ( isValid() )
     {
-        xmlNodePtr child = _node->children;
+        const XmlNodeData *child = _node->children;
 
-        while ( child != 0 )
+        while ( child != FDM_NULLPTR )
         {
-            if ( child->type == XML_ELEMENT_NODE )
+            if ( child->type == XmlNodeData::ElementNode )
             {
-                if ( 0 == xmlStrcmp( child->name, (const xmlChar*)name )
+                if ( 0 == strcmp( child->name.c_str(), name )
                   || strlen( name ) == 0 )
                 {
                     result._node = child;
@@ -179,7 +155,7 @@ std::string XmlNode::getFileAndLine() const
 
     result += _file;
     result += "(";
-    result += String::toString( (int)_node->line );
+    result += String::toString( _node->line );
     result += ")";
 
     return result;
@@ -193,7 +169,7 @@ XmlNode XmlNode::getNextSibling() const
 
     if ( isValid() )
     {
-        if ( _node->next != 0 )
+        if ( _node->next != FDM_NULLPTR )
         {
             result._node = _node->next;
             result._file = _file;
@@ -211,13 +187,13 @@ XmlNode XmlNode::getNextSiblingElement( const char *name ) const
 
     if ( isValid() )
     {
-        xmlNodePtr next = _node->next;
+        const XmlNodeData *next = _node->next;
 
-        while ( next != 0 )
+        while ( next != FDM_NULLPTR )
         {
-            if ( next->type == XML_ELEMENT_NODE )
+            if ( next->type == XmlNodeData::ElementNode )
             {
-                if ( 0 == xmlStrcmp( next->name, (const xmlChar*)name )
+                if ( 0 == strcmp( next->name.c_str(), name )
                   || strlen( name ) == 0 )
                 {
                     result._node = next;
@@ -239,8 +215,8 @@ std::string XmlNode::getText() const
 {
     switch ( _node->type )
     {
-    case XML_TEXT_NODE:
-        return std::string( (const char*)_node->content );
+    case XmlNodeData::TextNode:
+        return _node->content;
         break;
 
     default:
@@ -257,16 +233,13 @@ bool XmlNode::hasAttribute( const char *name ) const
 {
     if ( hasAttributes() )
     {
-        xmlAttrPtr attr = _node->properties;
-
-        while ( attr != 0 )
+        for ( XmlNodeData::Attributes::const_iterator it = _node->attributes.begin();
+              it != _node->attributes.end(); ++it )
         {
-            if ( 0 == xmlStrcmp( attr->name, (const xmlChar*)name ) )
+            if ( 0 == strcmp( (*it).first.c_str(), name ) )
             {
                 return true;
             }
-
-            attr = attr->next;
         }
     }
 
@@ -27,8 +27,7 @@
 #include <limits>
 #include <map>
 #include <string>
-
-#include <libxml/tree.h>
+#include <vector>
 
 #include <fdm/fdm_Defines.h>
 
@@ -37,6 +36,40 @@
 namespace fdm
 {
 
+/**
+ * @brief XML node data.
+ *
+ * XML document tree is stored by XmlDoc as a contiguous array of nodes data
+ * which is independent of the XML parser, so it can also be read from the
+ * binary cache.
+ */
+struct XmlNodeData
+{
+    /** Node types. */
+    enum Type
+    {
+        ElementNode = 0,                ///< element node
+        AttributeNode,                  ///< attribute node
+        TextNode,                       ///< text node
+        CommentNode,                    ///< comment node
+        OtherNode                       ///< other node types
+    };
+
+    typedef std::pair< std::string, std::string > Attribute;
+    typedef std::vector< Attribute > Attributes;
+
+    Type type;                          ///< node type
+    int  line;                          ///< line number
+
+    std::string name;                   ///< node name
+    std::string content;                ///< text node content
+
+    Attributes attributes;              ///< element attributes
+
+    const XmlNodeData *children;        ///< first child node
+    const XmlNodeData *next;            ///< next sibling node
+};
+
 /**
  * @brief XML node class.
  */
@@ -53,7 +86,12 @@ public:
     XmlNode( const XmlNode &node );
 
 
-    XmlNode( xmlNodePtr node, const char *file );
+    /**
+     * @brief Constructor.
+     * @param node XML node data
+     * @param file XML file name
+     */
+    XmlNode( const XmlNodeData *node, const char *file );
 
     /** @brief Destructor. */
     virtual ~XmlNode();
@@ -104,7 +142,7 @@ public:
     {
         if ( isValid() )
         {
-            return (int)_node->line;
+            return _node->line;
         }
 
         return std::numeric_limits< int >::quiet_NaN();
@@ -117,7 +155,7 @@ public:
     {
         if ( isValid() )
         {
-            return std::string( (const char*)_node->name );
+            return _node->name;
         }
 
         return std::string();
@@ -149,7 +187,7 @@ public:
     {
         if ( isValid() )
         {
-            return ( _node->properties != 0 );
+            return !_node->attributes.empty();
         }
 
         return false;
@@ -162,7 +200,7 @@ public:
     {
         if ( isValid() )
         {
-            return ( _node->children != 0 );
+            return ( _node->children != FDM_NULLPTR );
         }
 
         return false;
@@ -175,7 +213,7 @@ public:
     {
         if ( isValid() )
         {
-            return ( _node->type == XML_ATTRIBUTE_NODE );
+            return ( _node->type == XmlNodeData::AttributeNode );
         }
 
         return false;
@@ -188,7 +226,7 @@ public:
     {
         if ( isValid() )
         {
-            return ( _node->type == XML_COMMENT_NODE );
+            return ( _node->type == XmlNodeData::CommentNode );
         }
 
         return false;
@@ -201,7 +239,7 @@ public:
     {
         if ( isValid() )
         {
-            return ( _node->type == XML_ELEMENT_NODE );
+            return ( _node->type == XmlNodeData::ElementNode );
         }
 
         return false;
@@ -214,7 +252,7 @@ public:
     {
         if ( isValid() )
         {
-            return ( _node->type == XML_TEXT_NODE );
+            return ( _node->type == XmlNodeData::TextNode );
         }
 
         return false;
@@ -239,8 +277,8 @@ public:
 
 private:
 
-    std::string _file;  ///< XML file name
-    xmlNodePtr  _node;  ///< XML node pointer
+    std::string _file;          ///< XML file name
+    const XmlNodeData *_node;   ///< XML node data
 };
 
 } // end of fdm namespace
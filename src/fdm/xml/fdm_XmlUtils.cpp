@@ -24,6 +24,8 @@
 
 //#include <cstdio>
 
+#include <fdm/fdm_Log.h>
+
 #include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Units.h>
 
@@ -237,6 +239,49 @@ int XmlUtils::read( const XmlNode &node, Vector3 *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+int XmlUtils::read( const XmlNode &node, std::vector< double > *data )
+{
+    if ( node.isValid() )
+    {
+        XmlNode textNode = node.getFirstChild();
+
+        double factor = String::toDouble( node.getAttribute( "factor" ), 1.0 );
+        bool has_unit = node.hasAttribute( "unit" );
+        Units::fptr converter = Units::getConverter( node.getAttribute( "unit" ).c_str() );
+
+        if ( has_unit && !converter ) return FDM_FAILURE;
+
+        if ( textNode.isValid() && textNode.isText() )
+        {
+            std::vector< double > data_temp;
+
+            std::string text = textNode.getText();
+
+            const char *ptr = text.c_str();
+            const char *end = ptr + text.size();
+
+            double val = 0.0;
+
+            while ( FDM_NULLPTR != ( ptr = String::parseDouble( ptr, end, &val ) ) )
+            {
+                if ( has_unit ) val = (*converter)( val );
+
+                data_temp.push_back( val * factor );
+            }
+
+            if ( data_temp.size() > 0 && Misc::isValid( &(data_temp[ 0 ]), data_temp.size() ) )
+            {
+                (*data) = data_temp;
+                return FDM_SUCCESS;
+            }
+        }
+    }
+
+    return FDM_FAILURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 int XmlUtils::read( const XmlNode &node, Table1 *table )
 {
     std::vector< double > keyValues;
@@ -252,43 +297,57 @@ int XmlUtils::read( const XmlNode &node, Table1 *table )
 
         if ( textNode.isValid() && textNode.isText() )
         {
-            unsigned int offset = 0;
-            unsigned int result = 0;
+            std::string text = textNode.getText();
 
-            std::string text = String::stripLeadingSpaces( textNode.getText() );
+            const char *ptr = text.c_str();
+            const char *end = ptr + text.size();
 
-            do
+            while ( true )
             {
                 double key = 0.0;
                 double val = 0.0;
 
-                unsigned int ch_read = 0;
+                ptr = String::parseDouble( ptr, end, &key );
+                if ( ptr == FDM_NULLPTR ) break;
 
-                result = sscanf( text.c_str() + offset,
-                                 "%lf %lf \n%n", &key, &val, &ch_read );
+                ptr = String::parseDouble( ptr, end, &val );
+                if ( ptr == FDM_NULLPTR ) break;
 
-                offset += ch_read;
-
-                if ( result == 2 )
+                if ( has_unit )
                 {
-                    if ( has_unit )
-                    {
-                        if ( converter )
-                            val = (*converter)( val );
-                        else
-                            return FDM_FAILURE;
-                    }
-
-                    keyValues.push_back( key );
-                    tableData.push_back( val * factor );
+                    if ( converter )
+                        val = (*converter)( val );
+                    else
+                        return FDM_FAILURE;
                 }
+
+                keyValues.push_back( key );
+                tableData.push_back( val * factor );
             }
-            while ( result == 2 );
 
             if ( keyValues.size() == tableData.size() && keyValues.size() )
             {
                 (*table) = Table1( keyValues, tableData );
 
+                // table structure is validated once here, so lookups might skip checks (FDM_UNCHECKED)
+                if ( !table->isValid() )
+                {
+                    Log::e() << "Invalid table \"" << node.getName() << "\"." << std::endl;
+                    return FDM_FAILURE;
+                }
+
+                if ( node.hasAttribute( "bake" ) )
+                {
+                    double tolerance = String::toDouble( node.getAttribute( "bake" ), 0.0 );
+
+                    if ( !table->bake( tolerance ) )
+                    {
+                        Log::w() << "Cannot bake table \"" << node.getName() << "\"." << std::endl;
+                    }
+                }
+
+                table->share();
+
                 return FDM_SUCCESS;
             }
         }
@@ -315,86 +374,88 @@ int XmlUtils::read( const XmlNode &node, Table2 *table )
 
         if ( textNode.isValid() && textNode.isText() )
         {
-            unsigned int offset = 0;
-            unsigned int result = 0;
-
             std::string text = String::stripLeadingSpaces( textNode.getText() );
 
+            const char *ptr = text.c_str();
+            const char *end = ptr + text.size();
+
             // column keys
-            std::string line = String::getFirstLine( text );
+            const char *line_end = ptr;
 
-            do
-            {
-                unsigned int charsRead = 0;
+            while ( line_end < end && *line_end != '\n' ) line_end++;
 
+            while ( true )
+            {
                 double key = 0.0;
 
-                result = sscanf( line.c_str() + offset,
-                                 "%lf%n", &key, &charsRead );
-
-                offset += charsRead;
+                const char *next = String::parseDouble( ptr, line_end, &key );
+                if ( next == FDM_NULLPTR ) break;
 
-                if ( result == 1 )
-                {
-                    colValues.push_back( key );
-                }
+                ptr = next;
+                colValues.push_back( key );
             }
-            while ( result == 1 );
 
             // table rows
-            do
-            {
-                unsigned int charsRead = 0;
+            bool complete = true;
 
+            while ( complete )
+            {
                 double key = 0.0;
 
-                result = sscanf( text.c_str() + offset,
-                                 "%lf%n", &key, &charsRead );
+                ptr = String::parseDouble( ptr, end, &key );
+                if ( ptr == FDM_NULLPTR ) break;
 
-                offset += charsRead;
+                rowValues.push_back( key );
 
-                if ( result == 1 )
+                // table data
+                for ( unsigned int i = 0; i < colValues.size() && complete; i++ )
                 {
-                    rowValues.push_back( key );
+                    double val = 0.0;
 
-                    // table data
-                    for ( unsigned int i = 0; i < colValues.size(); i++ )
-                    {
-                        double val = 0.0;
+                    ptr = String::parseDouble( ptr, end, &val );
 
-                        if ( i < colValues.size() - 1 )
-                        {
-                            result = sscanf( text.c_str() + offset,
-                                             "%lf%n", &val, &charsRead );
-                        }
-                        else
+                    if ( ptr != FDM_NULLPTR )
+                    {
+                        if ( has_unit )
                         {
-                            result = sscanf( text.c_str() + offset,
-                                             "%lf \n%n", &val, &charsRead );
+                            if ( converter )
+                                val = (*converter)( val );
+                            else
+                                return FDM_FAILURE;
                         }
 
-                        offset += charsRead;
-
-                        if ( result == 1 )
-                        {
-                            if ( has_unit )
-                            {
-                                if ( converter )
-                                    val = (*converter)( val );
-                                else
-                                    return FDM_FAILURE;
-                            }
-
-                            tableData.push_back( val * factor );
-                        }
+                        tableData.push_back( val * factor );
+                    }
+                    else
+                    {
+                        complete = false;
                     }
                 }
             }
-            while ( result == 1 );
 
             if ( rowValues.size() * colValues.size() == tableData.size() )
             {
                 (*table) = Table2( rowValues, colValues, tableData );
+
+                // table structure is validated once here, so lookups might skip checks (FDM_UNCHECKED)
+                if ( !table->isValid() )
+                {
+                    Log::e() << "Invalid table \"" << node.getName() << "\"." << std::endl;
+                    return FDM_FAILURE;
+                }
+
+                if ( node.hasAttribute( "bake" ) )
+                {
+                    double tolerance = String::toDouble( node.getAttribute( "bake" ), 0.0 );
+
+                    if ( !table->bake( tolerance ) )
+                    {
+                        Log::w() << "Cannot bake table \"" << node.getName() << "\"." << std::endl;
+                    }
+                }
+
+                table->share();
+
                 return FDM_SUCCESS;
             }
         }
@@ -24,6 +24,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
 #include <fdm/ctrl/fdm_PID.h>
 
 #include <fdm/utils/fdm_Matrix3x3.h>
@@ -116,6 +118,22 @@ public:
      */
     static int read( const XmlNode &node, Vector3 *data );
 
+    /**
+     * @brief Reads list of values from XML file.
+     * @param node XML node
+     * @param data destination
+     * @return FDM_SUCCESS on success or FDM_FAILURE on failure.
+     *
+     * @code
+     * <tag_name [factor="{ value }"] [unit="{ unit string }"]>
+     *   { value } ... { more values }
+     * </tag_name>
+     * @endcode
+     *
+     * @see fdm::Units::getConverter(const char *)
+     */
+    static int read( const XmlNode &node, std::vector< double > *data );
+
     /**
      * @brief Reads table data from XML file.
      * @param node XML node
@@ -123,13 +141,20 @@ public:
      * @return FDM_SUCCESS on success or FDM_FAILURE on failure.
      *
      * @code
-     * <tag_name [factor="{ value }] [unit="{ unit string }"]>
+     * <tag_name [factor="{ value }] [unit="{ unit string }"] [bake="{ tolerance }"]>
      *   { key } { value }
      *   ... { more entries }
      * </tag_name>
      * @endcode
      *
+     * If bake attribute is present table is resampled onto uniform grid with
+     * the given maximum error tolerance.
+     * Table data are shared with all identical tables read before, so many
+     * instances of the same aircraft keep only one copy of the data.
+     *
      * @see fdm::Units::getConverter(const char *)
+     * @see fdm::Table1::bake()
+     * @see fdm::Table1::share()
      */
     static int read( const XmlNode &node, Table1 *table );
 
@@ -140,14 +165,21 @@ public:
      * @return FDM_SUCCESS on success or FDM_FAILURE on failure.
      *
      * @code
-     * <tag_name [factor="{ value }] [unit="{ unit string }"]>
+     * <tag_name [factor="{ value }] [unit="{ unit string }"] [bake="{ tolerance }"]>
      *   { column key } ... { more column keys }
      *    { row key } { value } ... { more values }
      *   ... { more entries }
      * </tag_name>
      * @endcode
      *
+     * If bake attribute is present table is resampled onto uniform grid with
+     * the given maximum error tolerance.
+     * Table data are shared with all identical tables read before, so many
+     * instances of the same aircraft keep only one copy of the data.
+     *
      * @see fdm::Units::getConverter(const char *)
+     * @see fdm::Table2::bake()
+     * @see fdm::Table2::share()
      */
     static int read( const XmlNode &node, Table2 *table );
 
@@ -126,3 +126,18 @@ void AW101_AFCS::readSAS( const XmlNode &dataNode, PID *pid )
         XmlUtils::throwError( __FILE__, __LINE__, dataNode );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AW101_AFCS::archiveState( StateArchive *archive )
+{
+    _pid_sas_roll.archiveState( archive );
+    _pid_sas_pitch.archiveState( archive );
+    _pid_sas_yaw.archiveState( archive );
+    _pid_collective.archiveState( archive );
+
+    archive->add( &_cyclic_lat );
+    archive->add( &_cyclic_lon );
+    archive->add( &_tail_pitch );
+    archive->add( &_collective );
+}
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/ctrl/fdm_PID.h>
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Vector3.h>
 #include <fdm/xml/fdm_XmlNode.h>
 
@@ -60,6 +61,12 @@ public:
                  const Angles &angles_ned,
                  const Vector3 &omg_bas );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
     inline double getCyclicLat()  const { return _cyclic_lat; }
     inline double getCyclicLon()  const { return _cyclic_lon; }
     inline double getTailPitch()  const { return _tail_pitch; }
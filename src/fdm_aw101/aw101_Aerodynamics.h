@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/main/fdm_Aerodynamics.h>
+#include <fdm/models/fdm_RotorWake.h>
 
 #include <fdm_aw101/aw101_MainRotor.h>
 #include <fdm_aw101/aw101_TailRotor.h>
@@ -42,7 +43,7 @@ class AW101_Aircraft;   // aircraft class forward declaration
 /**
  * @brief AW101 aerodynamics class.
  */
-class AW101_Aerodynamics : public Aerodynamics
+class AW101_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -67,6 +68,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const AW101_MainRotor* getMainRotor() const { return _mainRotor; }
 
 private:
@@ -78,6 +82,8 @@ private:
     AW101_Fuselage      *_fuselage;     ///<
     AW101_StabilizerHor *_stabHor;      ///<
     AW101_StabilizerVer *_stabVer;      ///<
+
+    RotorWake *_rotorWake;              ///< main rotor wake interference model
 };
 
 } // end of fdm namespace
@@ -59,3 +59,10 @@ void AW101_Aircraft::initialize( bool engineOn )
     Aircraft::initialize( engineOn );
     /////////////////////////////////
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AW101_Aircraft::computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas )
+{
+    sumForceAndMoment( _aero, _gear, _mass, _prop, for_bas, mom_bas );
+}
@@ -40,7 +40,7 @@ namespace fdm
 /**
  * @brief AW101 aircraft class.
  */
-class AW101_Aircraft : public Aircraft
+class AW101_Aircraft final : public Aircraft
 {
 public:
 
@@ -75,6 +75,9 @@ private:
     AW101_LandingGear  *_gear;  ///< landing gear model
     AW101_Mass         *_mass;  ///< mass and inertia model
     AW101_Propulsion   *_prop;  ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
@@ -137,7 +137,7 @@ void AW101_Controls::update()
     Controls::update();
     ///////////////////
 
-    _afcs->update( _aircraft->getTimeStep(),
+    _afcs->update( getUpdateTimeStep(),
                    _inputCtrlRoll  .getValue() , 0.0,
                    _inputCtrlPitch .getValue() , 0.0,
                    _inputCtrlYaw   .getValue() , 0.0,
@@ -174,3 +174,19 @@ void AW101_Controls::update()
     _brake_l = _channelBrakeLeft  ->output;
     _brake_r = _channelBrakeRight ->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AW101_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    _afcs->archiveState( archive );
+
+    archive->add( &_cyclic_lat );
+    archive->add( &_cyclic_lon );
+    archive->add( &_collective );
+    archive->add( &_tail_pitch );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+}
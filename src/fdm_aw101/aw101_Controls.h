@@ -38,7 +38,7 @@ class AW101_Aircraft;   // aircraft class forward declaration
 /**
  * @brief AW101 controls class.
  */
-class AW101_Controls : public Controls
+class AW101_Controls final : public Controls
 {
 public:
 
@@ -60,6 +60,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getCyclicLat()  const { return _cyclic_lat; }
     inline double getCyclicLon()  const { return _cyclic_lon; }
     inline double getCollective() const { return _collective; }
@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** AW101 flight dynamics model wrapper class. */
-class AW101_FDM : public FDM
+class AW101_FDM final : public FDM
 {
 public:
 
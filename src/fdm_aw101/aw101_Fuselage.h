@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief AW101 fuselage class.
  */
-class AW101_Fuselage : public Fuselage
+class AW101_Fuselage final : public Fuselage
 {
 public:
 
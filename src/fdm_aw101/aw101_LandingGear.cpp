@@ -73,27 +73,7 @@ void AW101_LandingGear::computeForceAndMoment()
     _for_bas.zeroize();
     _mom_bas.zeroize();
 
-    for ( Wheels::iterator it = _wheels.begin(); it != _wheels.end(); ++it )
-    {
-        Wheel &wheel = (*it).second.wheel;
-
-        if ( wheel.getPosition() >= 1.0 )
-        {
-            Vector3 r_c_bas;
-            Vector3 n_c_bas;
-
-            getIsect( wheel.getRa_BAS(), wheel.getRu_BAS(), &r_c_bas, &n_c_bas );
-
-            wheel.computeForceAndMoment( _aircraft->getVel_BAS(),
-                                         _aircraft->getOmg_BAS(),
-                                         r_c_bas,
-                                         n_c_bas,
-                                         _steering, _antiskid );
-
-            _for_bas += wheel.getFor_BAS();
-            _mom_bas += wheel.getMom_BAS();
-        }
-    }
+    computeWheelsForceAndMoment( _wheels );
 
     if ( !_for_bas.isValid() || !_mom_bas.isValid() )
     {
@@ -122,23 +102,13 @@ void AW101_LandingGear::update()
     int wheels_count = 0;
     double position_sum = 0.0;
 
+    integrateWheels( _wheels );
+
     for ( Wheels::iterator it = _wheels.begin(); it != _wheels.end(); ++it )
     {
         DataRef &input = (*it).second.input;
         Wheel   &wheel = (*it).second.wheel;
 
-        Vector3 r_c_bas;
-        Vector3 n_c_bas;
-
-        getIsect( wheel.getRa_BAS(), wheel.getRu_BAS(), &r_c_bas, &n_c_bas );
-
-        wheel.integrate( _aircraft->getTimeStep(),
-                         _aircraft->getVel_BAS(),
-                         _aircraft->getOmg_BAS(),
-                         r_c_bas,
-                         n_c_bas,
-                         _steering );
-
         double brake = 0.0;
         if      ( wheel.getBrakeGroup() == Wheel::Both  ) brake = 0.5 * ( _brake_l + _brake_r );
         else if ( wheel.getBrakeGroup() == Wheel::Left  ) brake = _brake_l;
@@ -154,3 +124,12 @@ void AW101_LandingGear::update()
 
     _position = position_sum / (double)wheels_count;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AW101_LandingGear::archiveState( StateArchive *archive )
+{
+    LandingGear::archiveState( archive );
+
+    archiveWheels( archive, _wheels );
+}
@@ -53,7 +53,7 @@ class AW101_Aircraft;   // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class AW101_LandingGear : public LandingGear
+class AW101_LandingGear final : public LandingGear
 {
 public:
 
@@ -78,6 +78,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const AW101_Aircraft *_aircraft;    ///< aircraft model main object
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief AW101 main rotor base class.
  */
-class AW101_MainRotor : public MainRotor
+class AW101_MainRotor final : public MainRotor
 {
 public:
 
@@ -36,7 +36,7 @@ class AW101_Aircraft;   // aircraft class forward declaration
 /**
  * @brief AW101 mass class.
  */
-class AW101_Mass : public Mass
+class AW101_Mass final : public Mass
 {
 public:
 
@@ -104,8 +104,8 @@ void AW101_Propulsion::computeForceAndMoment()
 void AW101_Propulsion::update()
 {
     // TODO
-    _mainRotorPsi += _aircraft->getTimeStep() * _mainRotorOmega;
-    _tailRotorPsi += _aircraft->getTimeStep() * _tailRotorOmega;
+    _mainRotorPsi += getUpdateTimeStep() * _mainRotorOmega;
+    _tailRotorPsi += getUpdateTimeStep() * _tailRotorOmega;
 
     _mainRotorPsi = Angles::normalize( _mainRotorPsi );
     _tailRotorPsi = Angles::normalize( _tailRotorPsi );
@@ -114,3 +114,16 @@ void AW101_Propulsion::update()
     _mainRotorOmega = 2 * M_PI *  210.0 / 60.0;
     _tailRotorOmega = 4.0 * _mainRotorOmega;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AW101_Propulsion::archiveState( StateArchive *archive )
+{
+    Propulsion::archiveState( archive );
+
+    archive->add( &_mainRotorPsi );
+    archive->add( &_tailRotorPsi );
+
+    archive->add( &_mainRotorOmega );
+    archive->add( &_tailRotorOmega );
+}
@@ -36,7 +36,7 @@ class AW101_Aircraft;   // aircraft class forward declaration
 /**
  * @brief AW101 propulsion class.
  */
-class AW101_Propulsion : public Propulsion
+class AW101_Propulsion final : public Propulsion
 {
 public:
 
@@ -61,6 +61,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getMainRotorPsi() const { return _mainRotorPsi; }
     inline double getTailRotorPsi() const { return _tailRotorPsi; }
 
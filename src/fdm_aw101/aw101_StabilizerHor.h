@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief AW101 horizontal stabilizer class.
  */
-class AW101_StabilizerHor : public StabilizerHor
+class AW101_StabilizerHor final : public StabilizerHor
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief AW101 vertical stabilizer class.
  */
-class AW101_StabilizerVer : public StabilizerVer
+class AW101_StabilizerVer final : public StabilizerVer
 {
 public:
 
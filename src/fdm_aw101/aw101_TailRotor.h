@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief AW101 tail rotor base class.
  */
-class AW101_TailRotor : public TailRotor
+class AW101_TailRotor final : public TailRotor
 {
 public:
 
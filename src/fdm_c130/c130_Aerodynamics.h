@@ -40,7 +40,7 @@ class C130_Aircraft;    // aircraft class forward declaration
 /**
  * @brief C-130 aerodynamics class.
  */
-class C130_Aerodynamics : public Aerodynamics
+class C130_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -62,6 +62,9 @@ public:
     /** Updates aerodynamics. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     /**
      * Returns true if aircraft is stalling, otherwise returns false.
      * @return true if aircraft is stalling, false otherwise
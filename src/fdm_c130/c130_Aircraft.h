@@ -43,7 +43,7 @@ namespace fdm
  * @see NATOPS Flight Manual Navy Model C-130T Aircraft. Department of the Navy, 01‑75GAL‑1, 2006
  * @see Flight Manual C-130 USCG Series Aircraft. Lockheed Martin, T.O. 1C-130H-1, 2001
  */
-class C130_Aircraft : public Aircraft
+class C130_Aircraft final : public Aircraft
 {
 public:
 
@@ -78,6 +78,9 @@ private:
     C130_LandingGear  *_gear;   ///< landing gear model
     C130_Mass         *_mass;   ///< mass and inertia model
     C130_Propulsion   *_prop;   ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
@@ -106,3 +106,18 @@ void C130_Controls::update()
     _brake_l = _channelBrakeLeft  ->output;
     _brake_r = _channelBrakeRight ->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void C130_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    archive->add( &_ailerons );
+    archive->add( &_elevator );
+    archive->add( &_rudder );
+    archive->add( &_elevator_trim );
+    archive->add( &_flaps );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+}
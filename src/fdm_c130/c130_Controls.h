@@ -36,7 +36,7 @@ class C130_Aircraft;    // aircraft class forward declaration
 /**
  * @brief C-130 controls class.
  */
-class C130_Controls : public Controls
+class C130_Controls final : public Controls
 {
 public:
 
@@ -52,6 +52,9 @@ public:
     /** Updates controls. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getAilerons()     const { return _ailerons;      }
     inline double getElevator()     const { return _elevator;      }
     inline double getRudder()       const { return _rudder;        }
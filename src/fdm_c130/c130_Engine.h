@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief C-130 engine class.
  */
-class C130_Engine : public PistonEngine
+class C130_Engine final : public PistonEngine
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** C-130 flight dynamics model wrapper class. */
-class C130_FDM : public FDM
+class C130_FDM final : public FDM
 {
 public:
 
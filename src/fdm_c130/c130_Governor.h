@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief C-130 propeller governor class.
  */
-class C130_Governor : public Governor
+class C130_Governor final : public Governor
 {
 public:
 
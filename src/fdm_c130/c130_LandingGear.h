@@ -53,7 +53,7 @@ class C130_Aircraft;    // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class C130_LandingGear : public LandingGear
+class C130_LandingGear final : public LandingGear
 {
 public:
 
@@ -75,6 +75,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const C130_Aircraft *_aircraft;     ///< aircraft model main object
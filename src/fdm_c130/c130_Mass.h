@@ -36,7 +36,7 @@ class C130_Aircraft;    // aircraft class forward declaration
 /**
  * @brief C-130 mass class.
  */
-class C130_Mass : public Mass
+class C130_Mass final : public Mass
 {
 public:
 
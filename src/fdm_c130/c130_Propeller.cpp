@@ -68,10 +68,27 @@ void C130_Propeller::readData( XmlNode &dataNode )
 
 void C130_Propeller::update( double propellerLever, double engineTorque,
                             double airspeed, double airDensity )
+{
+    double normPitch = updateGovernor( propellerLever );
+
+    /////////////////////////////////////////////////////////////////////
+    Propeller::update( normPitch, engineTorque, airspeed, airDensity );
+    /////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double C130_Propeller::updateGovernor( double propellerLever )
 {
     _governor->update( propellerLever, _speed_rpm );
 
-    ///////////////////////////////////////////////////////////////////////////////
-    Propeller::update( _governor->getPitch(), engineTorque, airspeed, airDensity );
-    ///////////////////////////////////////////////////////////////////////////////
+    return _governor->getPitch();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void C130_Propeller::archiveState( StateArchive *archive )
+{
+    Propeller::archiveState( archive );
+    _governor->archiveState( archive );
 }
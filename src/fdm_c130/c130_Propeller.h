@@ -36,7 +36,7 @@ namespace fdm
 /**
  * @brief C-130 propeller class.
  */
-class C130_Propeller : public Propeller
+class C130_Propeller final : public Propeller
 {
 public:
 
@@ -62,6 +62,19 @@ public:
     void update( double propellerLever, double engineTorque,
                  double airspeed, double airDensity );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
+    /**
+     * Updates propeller governor.
+     * @param propellerLever <0.0;1.0> normalized propeller lever position
+     * @return <0.0;1.0> normalized propeller pitch commanded by governor
+     */
+    double updateGovernor( double propellerLever );
+
 private:
 
     C130_Governor *_governor;       ///< propeller governor model
@@ -43,6 +43,8 @@ C130_Propulsion::C130_Propulsion( const C130_Aircraft *aircraft, Input *input )
     {
         _engine    [ i ] = new C130_Engine();
         _propeller [ i ] = new C130_Propeller();
+
+        _props[ i ] = _propeller[ i ];
     }
 }
 
@@ -70,6 +72,8 @@ void C130_Propulsion::readData( XmlNode &dataNode )
         {
             _engine[ i ]->readData( nodeEngine );
             _propeller[ i ]->readData( nodePropeller );
+
+            _engine[ i ]->setTorqueDerivativeEnabled( _propeller[ i ]->isImplicit() );
         }
     }
     else
@@ -133,11 +137,13 @@ void C130_Propulsion::computeForceAndMoment()
     _for_bas.zeroize();
     _mom_bas.zeroize();
 
+    // all propellers share the same data, so thrust is computed in lockstep
+    Propeller::computeThrust( _props, _enginesCount,
+                              _aircraft->getAirspeed(),
+                              _aircraft->getEnvir()->getDensity() );
+
     for ( int i = 0; i < _enginesCount; i++ )
     {
-        _propeller[ i ]->computeThrust( _aircraft->getAirspeed(),
-                                        _aircraft->getEnvir()->getDensity() );
-
         // thrust and moment due to thrust
         Vector3 for_bas( _propeller[ i ]->getThrust(), 0.0, 0.0 );
         Vector3 mom_bas = _propeller[ i ]->getPos_BAS() % for_bas;
@@ -176,9 +182,13 @@ void C130_Propulsion::computeForceAndMoment()
 
 void C130_Propulsion::update()
 {
+    double lever  [ 4 ];
+    double torque [ 4 ];
+
     for ( int i = 0; i < _enginesCount; i++ )
     {
-        _propeller[ i ]->integrate( _aircraft->getTimeStep(), _engine[ i ]->getInertia() );
+        _propeller[ i ]->integrate( getUpdateTimeStep(), _engine[ i ]->getInertia(),
+                                    _engine[ i ]->getTorqueDerivative() );
 
         double throttle  = _inputThrottle  [ i ].getDatad();
         double mixture   = _inputMixture   [ i ].getDatad();
@@ -194,8 +204,26 @@ void C130_Propulsion::update()
                               _aircraft->getEnvir()->getDensityAltitude(),
                               fuel, starter, ignition, ignition );
 
-        _propeller[ i ]->update( propeller, _engine[ i ]->getTorque(),
-                                 _aircraft->getAirspeed(),
-                                 _aircraft->getEnvir()->getDensity() );
+        lever  [ i ] = _propeller[ i ]->updateGovernor( propeller );
+        torque [ i ] = _engine[ i ]->getTorque();
+    }
+
+    // engines are independent of each other, so propellers coefficients
+    // lookups can be done in lockstep after all engines are updated
+    Propeller::update( _props, _enginesCount, lever, torque,
+                       _aircraft->getAirspeed(),
+                       _aircraft->getEnvir()->getDensity() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void C130_Propulsion::archiveState( StateArchive *archive )
+{
+    Propulsion::archiveState( archive );
+
+    for ( int i = 0; i < _enginesCount; i++ )
+    {
+        _engine    [ i ]->archiveState( archive );
+        _propeller [ i ]->archiveState( archive );
     }
 }
@@ -39,7 +39,7 @@ class C130_Aircraft;    // aircraft class forward declaration
 /**
  * @brief C-130 propulsion class.
  */
-class C130_Propulsion : public Propulsion
+class C130_Propulsion final : public Propulsion
 {
 public:
 
@@ -64,6 +64,9 @@ public:
     /** Updates propulsion. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline int getEnginesCount() const { return _enginesCount; }
 
     inline const C130_Engine* getEngine( int i ) const { return _engine[ i ]; }
@@ -78,6 +81,8 @@ private:
     C130_Engine    *_engine    [ 4 ];   ///< engine model
     C130_Propeller *_propeller [ 4 ];   ///< propeller model
 
+    Propeller *_props [ 4 ];            ///< propeller models for lockstep evaluation
+
     DataRef _inputThrottle  [ 4 ];      ///< throttle input data reference
     DataRef _inputMixture   [ 4 ];      ///< mixture input data reference
     DataRef _inputPropeller [ 4 ];      ///< propeller input data reference
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief C-130 horizontal stabilizer class.
  */
-class C130_StabilizerHor : public StabilizerHor
+class C130_StabilizerHor final : public StabilizerHor
 {
 public:
 
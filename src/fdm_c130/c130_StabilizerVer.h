@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief C-130 vertical stabilizer class.
  */
-class C130_StabilizerVer : public StabilizerVer
+class C130_StabilizerVer final : public StabilizerVer
 {
 public:
 
@@ -36,7 +36,7 @@ namespace fdm
 /**
  * @brief C-130 tail-off aerodynamics class.
  */
-class C130_TailOff : public TailOff
+class C130_TailOff final : public TailOff
 {
 public:
 
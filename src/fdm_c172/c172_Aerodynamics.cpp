@@ -153,4 +153,15 @@ void C172_Aerodynamics::update()
     ///////////////////////
 
     _tailOff->update( _aircraft->getVel_air_BAS(),  _aircraft->getOmg_air_BAS() );
+    _stabHor->update( getUpdateTimeStep(), _aircraft->getAngleOfAttack() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void C172_Aerodynamics::archiveState( StateArchive *archive )
+{
+    Aerodynamics::archiveState( archive );
+
+    _tailOff->archiveState( archive );
+    _stabHor->archiveState( archive );
 }
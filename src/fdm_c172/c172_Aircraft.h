@@ -43,7 +43,7 @@ namespace fdm
  * @see Skyhawk Model 172S Specification & Description. Cessna Aircraft Company, 2012
  * @see Information Manual Skyhawk SP. Cessna Aircraft Company, 172SPHBUS-00, 2007
  */
-class C172_Aircraft : public Aircraft
+class C172_Aircraft final : public Aircraft
 {
 public:
 
@@ -78,6 +78,9 @@ private:
     C172_LandingGear  *_gear;   ///< landing gear model
     C172_Mass         *_mass;   ///< mass and inertia model
     C172_Propulsion   *_prop;   ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
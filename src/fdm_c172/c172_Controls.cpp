@@ -112,3 +112,19 @@ void C172_Controls::update()
 
     _nose_wheel = _channelNoseWheel->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void C172_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    archive->add( &_ailerons );
+    archive->add( &_elevator );
+    archive->add( &_rudder );
+    archive->add( &_elevator_trim );
+    archive->add( &_flaps );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+    archive->add( &_nose_wheel );
+}
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief Cessna 172 engine class.
  */
-class C172_Engine : public PistonEngine
+class C172_Engine final : public PistonEngine
 {
 public:
 
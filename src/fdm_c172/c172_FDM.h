@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** Cessna 172 flight dynamics model wrapper class. */
-class C172_FDM : public FDM
+class C172_FDM final : public FDM
 {
 public:
 
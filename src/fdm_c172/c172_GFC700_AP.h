@@ -43,7 +43,7 @@ namespace fdm
  * @see G1000 Guide for Designated Pilot Examiners and Certified Flight Instructors
  * @see GDU104X Installation Manual
  */
-class C172_GFC700_AP : public Autopilot
+class C172_GFC700_AP final : public Autopilot
 {
 public:
 
@@ -38,7 +38,7 @@ namespace fdm
  *
  * @see Bendix/King KAP 140 Autopilot System Pilot's Guide
  */
-class C172_KAP140_AP : public Autopilot
+class C172_KAP140_AP final : public Autopilot
 {
 public:
 
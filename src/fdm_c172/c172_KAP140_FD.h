@@ -38,7 +38,7 @@ class C172_KAP140_AP;
  *
  * @see Bociek S., Gruszecki J.: Uklady sterowania automatycznego samolotem, 1999, p.213. [in Polish]
  */
-class C172_KAP140_FD : public FlightDirector
+class C172_KAP140_FD final : public FlightDirector
 {
 public:
 
@@ -38,7 +38,7 @@ namespace fdm
  *
  * @see Bendix King KFC 325 Pilot's Guide
  */
-class C172_KFC325_AP : public Autopilot
+class C172_KFC325_AP final : public Autopilot
 {
 public:
 
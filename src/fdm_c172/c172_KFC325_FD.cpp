@@ -22,6 +22,8 @@
 
 #include <fdm_c172/c172_KFC325_FD.h>
 
+#include <cfloat>
+
 #include <fdm/fdm_Log.h>
 #include <fdm/utils/fdm_Misc.h>
 #include <fdm/utils/fdm_Units.h>
@@ -36,7 +36,7 @@ class C172_Aircraft;    // aircraft class forward declaration
 /**
  * @brief Cessna 172 mass class.
  */
-class C172_Mass : public Mass
+class C172_Mass final : public Mass
 {
 public:
 
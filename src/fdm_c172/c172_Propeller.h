@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief Cessna 172 propeller class.
  */
-class C172_Propeller : public Propeller
+class C172_Propeller final : public Propeller
 {
 public:
 
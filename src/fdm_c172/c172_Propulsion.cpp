@@ -61,6 +61,8 @@ void C172_Propulsion::readData( XmlNode &dataNode )
 
         _engine->readData( nodeEngine );
         _propeller->readData( nodePropeller );
+
+        _engine->setTorqueDerivativeEnabled( _propeller->isImplicit() );
     }
     else
     {
@@ -147,7 +149,8 @@ void C172_Propulsion::computeForceAndMoment()
 
 void C172_Propulsion::update()
 {
-    _propeller->integrate( _aircraft->getTimeStep(), _engine->getInertia() );
+    _propeller->integrate( getUpdateTimeStep(), _engine->getInertia(),
+                           _engine->getTorqueDerivative() );
 
     double throttle  = _inputThrottle  .getDatad();
     double mixture   = _inputMixture   .getDatad();
@@ -167,3 +170,13 @@ void C172_Propulsion::update()
                         _aircraft->getAirspeed(),
                         _aircraft->getEnvir()->getDensity() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void C172_Propulsion::archiveState( StateArchive *archive )
+{
+    Propulsion::archiveState( archive );
+
+    _engine->archiveState( archive );
+    _propeller->archiveState( archive );
+}
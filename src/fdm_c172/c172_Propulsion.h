@@ -39,7 +39,7 @@ class C172_Aircraft;    // aircraft class forward declaration
 /**
  * @brief Cessna 172 propulsion class.
  */
-class C172_Propulsion : public Propulsion
+class C172_Propulsion final : public Propulsion
 {
 public:
 
@@ -64,6 +64,9 @@ public:
     /** Updates propulsion. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const C172_Engine* getEngine() const { return _engine; }
     inline const C172_Propeller* getPropeller() const { return _propeller; }
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief Cessna 172 horizontal stabilizer class.
  */
-class C172_StabilizerHor : public StabilizerHor
+class C172_StabilizerHor final : public StabilizerHor
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief Cessna 172 vertical stabilizer class.
  */
-class C172_StabilizerVer : public StabilizerVer
+class C172_StabilizerVer final : public StabilizerVer
 {
 public:
 
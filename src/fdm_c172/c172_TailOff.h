@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief Cessna 172 tail-off aerodynamics class.
  */
-class C172_TailOff : public TailOff
+class C172_TailOff final : public TailOff
 {
 public:
 
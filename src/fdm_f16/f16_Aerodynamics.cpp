@@ -57,7 +57,9 @@ F16_Aerodynamics::F16_Aerodynamics( const F16_Aircraft *aircraft, Input *input )
     _cn_delta_h ( 0.0 ),
 
     _lef_factor ( 0.0 )
-{}
+{
+    for ( unsigned int i = 0; i < TABLES_AB_COUNT; i++ ) _ab[ i ] = 0.0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -228,6 +230,54 @@ void F16_Aerodynamics::readData( XmlNode &dataNode )
             _delta_cn_r_lef .multiplyKeys( Units::deg2rad() );
             _cn_p           .multiplyKeys( Units::deg2rad() );
             _delta_cn_p_lef .multiplyKeys( Units::deg2rad() );
+
+            // tables are added in TablesAlphaBeta order
+            const Table2 *tables_ab[] = {
+                &_cx_dh_n25,
+                &_cx_dh_n10,
+                &_cx_dh_0,
+                &_cx_dh_p10,
+                &_cx_dh_p25,
+                &_cx_lef,
+                &_cy,
+                &_cy_lef,
+                &_cy_da_20,
+                &_cy_da_20_lef,
+                &_cy_dr_30,
+                &_cz_dh_n25,
+                &_cz_dh_n10,
+                &_cz_dh_0,
+                &_cz_dh_p10,
+                &_cz_dh_p25,
+                &_cz_lef,
+                &_cl_dh_n25,
+                &_cl_dh_0,
+                &_cl_dh_p25,
+                &_cl_lef,
+                &_cl_da_20,
+                &_cl_da_20_lef,
+                &_cl_dr_30,
+                &_cm_dh_n25,
+                &_cm_dh_n10,
+                &_cm_dh_0,
+                &_cm_dh_p10,
+                &_cm_dh_p25,
+                &_cm_lef,
+                &_cn_dh_n25,
+                &_cn_dh_0,
+                &_cn_dh_p25,
+                &_cn_lef,
+                &_cn_da_20,
+                &_cn_da_20_lef,
+                &_cn_dr_30
+            };
+
+            _tables_ab.clear();
+
+            for ( unsigned int i = 0; i < TABLES_AB_COUNT; i++ )
+            {
+                _tables_ab.add( *tables_ab[ i ] );
+            }
         }
         else
         {
@@ -255,6 +305,11 @@ void F16_Aerodynamics::computeForceAndMoment()
     _alpha_deg = Units::rad2deg( _alpha );
     _beta_deg  = Units::rad2deg( _beta  );
 
+    // all angle of attack and sideslip tables are evaluated in one pass
+    _tables_ab.getValues( _alpha, _beta, _ab );
+
+    updateCoefsDueToElevator();
+
     _b_2v = 0.0;
     _c_2v = 0.0;
 
@@ -302,8 +357,6 @@ void F16_Aerodynamics::update()
     Aerodynamics::update();
     ///////////////////////
 
-    updateCoefsDueToElevator();
-
     // (NASA-TP-1538)
     _lef_factor = 1.0 - _aircraft->getCtrl()->getFlapsLENorm();
 }
@@ -313,8 +366,7 @@ void F16_Aerodynamics::update()
 double F16_Aerodynamics::getCx() const
 {
     // (NASA-TP-1538, p.37)
-    double delta_cx_lef = _cx_lef  .getValue( _alpha, _beta )
-                        - _cx_dh_0 .getValue( _alpha, _beta );
+    double delta_cx_lef = _ab[ CX_LEF ] - _ab[ CX_DH_0 ];
 
     double cx_q = _cx_q.getValue( _alpha ) + _delta_cx_q_lef.getValue( _alpha ) * _lef_factor;
 
@@ -330,13 +382,13 @@ double F16_Aerodynamics::getCx() const
 double F16_Aerodynamics::getCy() const
 {
     // (NASA-TP-1538, p.38)
-    double cy     = _cy     .getValue( _alpha, _beta );
-    double cy_lef = _cy_lef .getValue( _alpha, _beta );
+    double cy     = _ab[ CY ];
+    double cy_lef = _ab[ CY_LEF ];
 
     double delta_cy_lef       = cy_lef - cy;
-    double delta_cy_da_20     = _cy_da_20.getValue( _alpha, _beta ) - cy;
-    double delta_cy_da_20_lef = _cy_da_20_lef.getValue( _alpha, _beta ) - cy_lef - delta_cy_da_20;
-    double delta_cy_dr_30     = _cy_dr_30.getValue( _alpha, _beta ) - cy;
+    double delta_cy_da_20     = _ab[ CY_DA_20 ] - cy;
+    double delta_cy_da_20_lef = _ab[ CY_DA_20_LEF ] - cy_lef - delta_cy_da_20;
+    double delta_cy_dr_30     = _ab[ CY_DR_30 ] - cy;
 
     return cy + delta_cy_lef * _lef_factor
             + ( delta_cy_da_20 + delta_cy_da_20_lef * _lef_factor ) * _aircraft->getCtrl()->getAileronsNorm()
@@ -350,8 +402,7 @@ double F16_Aerodynamics::getCy() const
 double F16_Aerodynamics::getCz() const
 {
     // (NASA-TP-1538, p.37)
-    double delta_cz_lef = _cz_lef  .getValue( _alpha, _beta )
-                        - _cz_dh_0 .getValue( _alpha, _beta );
+    double delta_cz_lef = _ab[ CZ_LEF ] - _ab[ CZ_DH_0 ];
 
     double cz_q = _cz_q.getValue( _alpha ) + _delta_cz_q_lef.getValue( _alpha ) * _lef_factor;
 
@@ -367,15 +418,15 @@ double F16_Aerodynamics::getCz() const
 double F16_Aerodynamics::getCl() const
 {
     // (NASA-TP-1538, p.39-40)
-    double cl_dh_0  = _cl_dh_0  .getValue( _alpha, _beta );
-    double cl_lef   = _cl_lef   .getValue( _alpha, _beta );
-    double cl_da_20 = _cl_da_20 .getValue( _alpha, _beta );
+    double cl_dh_0  = _ab[ CL_DH_0 ];
+    double cl_lef   = _ab[ CL_LEF ];
+    double cl_da_20 = _ab[ CL_DA_20 ];
 
     double delta_cl_lef   = cl_lef   - cl_dh_0;
     double delta_cl_da_20 = cl_da_20 - cl_dh_0;
-    double delta_cl_da_20_lef = _cl_da_20_lef.getValue( _alpha, _beta ) - cl_lef
+    double delta_cl_da_20_lef = _ab[ CL_DA_20_LEF ] - cl_lef
             - ( cl_da_20 - cl_dh_0 );
-    double delta_cl_dr_30 = _cl_dr_30.getValue( _alpha, _beta ) - cl_dh_0;
+    double delta_cl_dr_30 = _ab[ CL_DR_30 ] - cl_dh_0;
 
     return _cl_delta_h + delta_cl_lef * _lef_factor
             + ( delta_cl_da_20 + delta_cl_da_20_lef * _lef_factor ) * _aircraft->getCtrl()->getAileronsNorm()
@@ -390,8 +441,7 @@ double F16_Aerodynamics::getCl() const
 double F16_Aerodynamics::getCm() const
 {
     // (NASA-TP-1538, p.38)
-    double delta_cm_lef = _cm_lef  .getValue( _alpha, _beta )
-                        - _cm_dh_0 .getValue( _alpha, _beta );
+    double delta_cm_lef = _ab[ CM_LEF ] - _ab[ CM_DH_0 ];
 
     double cm_q = _cm_q.getValue( _alpha ) + _delta_cm_q_lef.getValue( _alpha ) * _lef_factor;
 
@@ -409,15 +459,15 @@ double F16_Aerodynamics::getCm() const
 double F16_Aerodynamics::getCn() const
 {
     // (NASA-TP-1538, p.39)
-    double cn_dh_0  = _cn_dh_0  .getValue( _alpha, _beta );
-    double cn_lef   = _cn_lef   .getValue( _alpha, _beta );
-    double cn_da_20 = _cn_da_20 .getValue( _alpha, _beta );
+    double cn_dh_0  = _ab[ CN_DH_0 ];
+    double cn_lef   = _ab[ CN_LEF ];
+    double cn_da_20 = _ab[ CN_DA_20 ];
 
     double delta_cn_lef   = cn_lef   - cn_dh_0;
     double delta_cn_da_20 = cn_da_20 - cn_dh_0;
-    double delta_cn_da_20_lef = _cn_da_20_lef.getValue( _alpha, _beta ) - cn_lef
+    double delta_cn_da_20_lef = _ab[ CN_DA_20_LEF ] - cn_lef
             - ( cn_da_20 - cn_dh_0 );
-    double delta_cn_dr_30 = _cn_dr_30.getValue( _alpha, _beta ) - cn_dh_0;
+    double delta_cn_dr_30 = _ab[ CN_DR_30 ] - cn_dh_0;
 
     return _cn_delta_h + delta_cn_lef * _lef_factor
             + ( delta_cn_da_20 + delta_cn_da_20_lef * _lef_factor ) * _aircraft->getCtrl()->getAileronsNorm()
@@ -452,74 +502,74 @@ void F16_Aerodynamics::updateCoefsDueToElevator()
     {
         coef_2 = ( delta_h_deg + 25.0 ) / 25.0;
 
-        cl_l = _cl_dh_n25 .getValue( _alpha, _beta );
-        cl_h = _cl_dh_0   .getValue( _alpha, _beta );
+        cl_l = _ab[ CL_DH_N25 ];
+        cl_h = _ab[ CL_DH_0 ];
 
-        cn_l = _cn_dh_n25 .getValue( _alpha, _beta );
-        cn_h = _cn_dh_0   .getValue( _alpha, _beta );
+        cn_l = _ab[ CN_DH_N25 ];
+        cn_h = _ab[ CN_DH_0 ];
 
         if ( delta_h_deg < -10.0 )
         {
             coef_1 = ( delta_h_deg + 25.0 ) / 15.0;
 
-            cx_l = _cx_dh_n25 .getValue( _alpha, _beta );
-            cx_h = _cx_dh_n10 .getValue( _alpha, _beta );
+            cx_l = _ab[ CX_DH_N25 ];
+            cx_h = _ab[ CX_DH_N10 ];
 
-            cz_l = _cz_dh_n25 .getValue( _alpha, _beta );
-            cz_h = _cz_dh_n10 .getValue( _alpha, _beta );
+            cz_l = _ab[ CZ_DH_N25 ];
+            cz_h = _ab[ CZ_DH_N10 ];
 
-            cm_l = _cm_dh_n25 .getValue( _alpha, _beta );
-            cm_h = _cm_dh_n10 .getValue( _alpha, _beta );
+            cm_l = _ab[ CM_DH_N25 ];
+            cm_h = _ab[ CM_DH_N10 ];
         }
         else
         {
             coef_1 = ( delta_h_deg + 10.0 ) / 10.0;
 
-            cx_l = _cx_dh_n10 .getValue( _alpha, _beta );
-            cx_h = _cx_dh_0   .getValue( _alpha, _beta );
+            cx_l = _ab[ CX_DH_N10 ];
+            cx_h = _ab[ CX_DH_0 ];
 
-            cz_l = _cz_dh_n10 .getValue( _alpha, _beta );
-            cz_h = _cz_dh_0   .getValue( _alpha, _beta );
+            cz_l = _ab[ CZ_DH_N10 ];
+            cz_h = _ab[ CZ_DH_0 ];
 
-            cm_l = _cm_dh_n10 .getValue( _alpha, _beta );
-            cm_h = _cm_dh_0   .getValue( _alpha, _beta );
+            cm_l = _ab[ CM_DH_N10 ];
+            cm_h = _ab[ CM_DH_0 ];
         }
     }
     else
     {
         coef_2 = delta_h_deg / 25.0;
 
-        cl_l = _cl_dh_0   .getValue( _alpha, _beta );
-        cl_h = _cl_dh_p25 .getValue( _alpha, _beta );
+        cl_l = _ab[ CL_DH_0 ];
+        cl_h = _ab[ CL_DH_P25 ];
 
-        cn_l = _cn_dh_0   .getValue( _alpha, _beta );
-        cn_h = _cn_dh_p25 .getValue( _alpha, _beta );
+        cn_l = _ab[ CN_DH_0 ];
+        cn_h = _ab[ CN_DH_P25 ];
 
         if ( delta_h_deg < 10.0 )
         {
             coef_1 = delta_h_deg / 10.0;
 
-            cx_l = _cx_dh_0   .getValue( _alpha, _beta );
-            cx_h = _cx_dh_p10 .getValue( _alpha, _beta );
+            cx_l = _ab[ CX_DH_0 ];
+            cx_h = _ab[ CX_DH_P10 ];
 
-            cz_l = _cz_dh_0   .getValue( _alpha, _beta );
-            cz_h = _cz_dh_p10 .getValue( _alpha, _beta );
+            cz_l = _ab[ CZ_DH_0 ];
+            cz_h = _ab[ CZ_DH_P10 ];
 
-            cm_l = _cm_dh_0   .getValue( _alpha, _beta );
-            cm_h = _cm_dh_p10 .getValue( _alpha, _beta );
+            cm_l = _ab[ CM_DH_0 ];
+            cm_h = _ab[ CM_DH_P10 ];
         }
         else
         {
             coef_1 = ( delta_h_deg - 10.0 ) / 15.0;
 
-            cx_l = _cx_dh_p10 .getValue( _alpha, _beta );
-            cx_h = _cx_dh_p25 .getValue( _alpha, _beta );
+            cx_l = _ab[ CX_DH_P10 ];
+            cx_h = _ab[ CX_DH_P25 ];
 
-            cz_l = _cz_dh_p10 .getValue( _alpha, _beta );
-            cz_h = _cz_dh_p25 .getValue( _alpha, _beta );
+            cz_l = _ab[ CZ_DH_P10 ];
+            cz_h = _ab[ CZ_DH_P25 ];
 
-            cm_l = _cm_dh_p10 .getValue( _alpha, _beta );
-            cm_h = _cm_dh_p25 .getValue( _alpha, _beta );
+            cm_l = _ab[ CM_DH_P10 ];
+            cm_h = _ab[ CM_DH_P25 ];
         }
     }
 
@@ -533,3 +583,12 @@ void F16_Aerodynamics::updateCoefsDueToElevator()
     _cl_delta_h = cl_l + coef_2 * ( cl_h - cl_l );
     _cn_delta_h = cn_l + coef_2 * ( cn_h - cn_l );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F16_Aerodynamics::archiveState( StateArchive *archive )
+{
+    Aerodynamics::archiveState( archive );
+
+    archive->add( &_lef_factor );
+}
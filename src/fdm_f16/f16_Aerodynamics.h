@@ -28,6 +28,7 @@
 
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_Table2Pack.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -42,7 +43,7 @@ class F16_Aircraft;     // aircraft class forward declaration
  * @see Nguyen L., et al.: Simulator Study of Stall/Post-Stall Characteristics of a Fighter Airplane With Relaxed Longitudinal Static Stability, NASA-TP-1538, 1979
  * @see Gilbert W., et al.: Simulator Study of the Effectiveness of an Automatic Control System Designed to Improve the High-Angle-of-Attack Characteristics of a Fighter Airplane, NASA-TN-D-8176, 1976
  */
-class F16_Aerodynamics : public Aerodynamics
+class F16_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -64,6 +65,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     /**
      * Returns true if aircraft is stalling, otherwise returns false.
      * @return true if aircraft is stalling, false otherwise
@@ -72,6 +76,49 @@ public:
 
 private:
 
+    /** Angle of attack and sideslip tables indices. */
+    enum TablesAlphaBeta
+    {
+        CX_DH_N25 = 0,
+        CX_DH_N10,
+        CX_DH_0,
+        CX_DH_P10,
+        CX_DH_P25,
+        CX_LEF,
+        CY,
+        CY_LEF,
+        CY_DA_20,
+        CY_DA_20_LEF,
+        CY_DR_30,
+        CZ_DH_N25,
+        CZ_DH_N10,
+        CZ_DH_0,
+        CZ_DH_P10,
+        CZ_DH_P25,
+        CZ_LEF,
+        CL_DH_N25,
+        CL_DH_0,
+        CL_DH_P25,
+        CL_LEF,
+        CL_DA_20,
+        CL_DA_20_LEF,
+        CL_DR_30,
+        CM_DH_N25,
+        CM_DH_N10,
+        CM_DH_0,
+        CM_DH_P10,
+        CM_DH_P25,
+        CM_LEF,
+        CN_DH_N25,
+        CN_DH_0,
+        CN_DH_P25,
+        CN_LEF,
+        CN_DA_20,
+        CN_DA_20_LEF,
+        CN_DR_30,
+        TABLES_AB_COUNT
+    };
+
     const F16_Aircraft *_aircraft;  ///< aircraft model main object
 
     Table2 _cx_dh_n25;              ///< [-] body x-force coefficient vs angle of attack and sideslip (delta_h=-25)
@@ -172,6 +219,9 @@ private:
 
     double _lef_factor;             ///< [-] leading edge flaps factor
 
+    Table2Pack _tables_ab;          ///< angle of attack and sideslip tables packed together
+    double _ab[ TABLES_AB_COUNT ];  ///< angle of attack and sideslip tables values
+
     double getCx() const;
     double getCy() const;
     double getCz() const;
@@ -48,7 +48,7 @@ namespace fdm
  * @see Droste T., Walker J.: The General Dynamics Case Study on the F-16 Fly-by-Wire Flight Control System
  * @see Dameron G.: A Real-Time Simulator for Man-In-The-Loop Testing of Aircraft Control Systems, AD-A202-599, 1988
  */
-class F16_Aircraft : public Aircraft
+class F16_Aircraft final : public Aircraft
 {
 public:
 
@@ -83,6 +83,9 @@ private:
     F16_LandingGear  *_gear;    ///< landing gear model
     F16_Mass         *_mass;    ///< mass and inertia model
     F16_Propulsion   *_prop;    ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
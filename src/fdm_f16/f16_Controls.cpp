@@ -23,6 +23,7 @@
 #include <fdm_f16/f16_Controls.h>
 #include <fdm_f16/f16_Aircraft.h>
 
+#include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Units.h>
 #include <fdm/xml/fdm_XmlUtils.h>
 
@@ -112,6 +113,8 @@ void F16_Controls::readData( XmlNode &dataNode )
             _flcs->setElevator_max( elevator_max );
             _flcs->setRudder_max( rudder_max );
             _flcs->setFlaps_le_max( flaps_le_max );
+
+            _flcs->setCompiled( String::toBool( dataNode.getAttribute( "compiled-flcs" ), false ) );
         }
         else
         {
@@ -192,9 +195,9 @@ void F16_Controls::update()
     _nose_wheel = _channelNoseWheel->output;
 
     // 1000 Hz
-    const unsigned int steps = ceil( _aircraft->getTimeStep() / 0.001 );
+    const unsigned int steps = ceil( getUpdateTimeStep() / 0.001 );
 
-    const double timeStep = _aircraft->getTimeStep() / ( (double)steps );
+    const double timeStep = getUpdateTimeStep() / ( (double)steps );
     const double delta_angleOfAttack = _aircraft->getAngleOfAttack() - _angleOfAttack;
     const double delta_g_y = _aircraft->getGForce().y() - _g_y;
     const double delta_g_z = _aircraft->getGForce().z() - _g_z;
@@ -240,7 +243,7 @@ void F16_Controls::update()
                        _inputLGH.getDatab(),
                        _aircraft->getGear()->getOnGround() );
 
-//        _flcs->update( _aircraft->getTimeStep(),
+//        _flcs->update( getUpdateTimeStep(),
 //                       _aircraft->getAngleOfAttack(),
 //                       _aircraft->getGForce().y(), _aircraft->getGForce().z(),
 //                       _aircraft->getOmg_BAS()( _i_p ), _aircraft->getOmg_BAS()( _i_q ), _aircraft->getOmg_BAS()( _i_r ),
@@ -266,3 +269,33 @@ void F16_Controls::update()
     _statPress = _aircraft->getEnvir()->getPressure();
     _dynPress  = _aircraft->getDynPress();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F16_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    _flcs->archiveState( archive );
+
+    archive->add( &_airbrake );
+    archive->add( &_airbrake_norm );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+    archive->add( &_nose_wheel );
+
+    archive->add( &_angleOfAttack );
+    archive->add( &_g_y );
+    archive->add( &_g_z );
+    archive->add( &_rollRate );
+    archive->add( &_pitchRate );
+    archive->add( &_yawRate );
+    archive->add( &_ctrlLat );
+    archive->add( &_trimLat );
+    archive->add( &_ctrlLon );
+    archive->add( &_trimLon );
+    archive->add( &_ctrlYaw );
+    archive->add( &_trimYaw );
+    archive->add( &_statPress );
+    archive->add( &_dynPress );
+}
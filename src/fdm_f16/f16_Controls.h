@@ -38,7 +38,7 @@ class F16_Aircraft;     // aircraft class forward declaration
 /**
  * @brief F-16 controls class.
  */
-class F16_Controls : public Controls
+class F16_Controls final : public Controls
 {
 public:
 
@@ -50,6 +50,7 @@ public:
 
     /**
      * Reads data.
+     * Optional compiled-flcs="{ 0|1 }" attribute enables compiled FLCS mode.
      * @param dataNode XML node
      */
     void readData( XmlNode &dataNode );
@@ -60,6 +61,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const F16_FLCS* getFLCS() const { return _flcs; }
 
     inline double getAilerons()     const { return _flcs->getAilerons();     }
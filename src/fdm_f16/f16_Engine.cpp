@@ -26,7 +26,10 @@
 #   include <algorithm>
 #endif
 
+#include <fdm/fdm_Exception.h>
+
 #include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Units.h>
 #include <fdm/xml/fdm_XmlUtils.h>
 
@@ -39,6 +42,10 @@ using namespace fdm;
 F16_Engine::F16_Engine() :
     _state ( Stopped ),
 
+    _index_idle ( 0 ),
+    _index_mil  ( 0 ),
+    _index_ab   ( 0 ),
+
     _thrust_mil ( 0.0 ),
     _thrust_ab  ( 0.0 ),
 
@@ -73,7 +80,9 @@ F16_Engine::F16_Engine() :
     _fuelFlow ( 0.0 ),
     _thrust ( 0.0 ),
 
-    _afterburner ( false )
+    _afterburner ( false ),
+
+    _baked ( false )
 {}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +104,8 @@ void F16_Engine::readData( XmlNode &dataNode )
         _n1_max  = 0.0;
         _n2_max  = 0.0;
 
+        _baked = String::toBool( dataNode.getAttribute( "baked" ), false );
+
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_pos_bas, "position" );
 
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_thrust_mil , "thrust_mil" );
@@ -131,6 +142,25 @@ void F16_Engine::readData( XmlNode &dataNode )
 
             _n1_max = _n1_throttle.getValueMax();
             _n2_max = _n2_throttle.getValueMax();
+
+            _tf_map.clear();
+
+            if ( _baked )
+            {
+                _index_idle = _tf_map.add( _tf_idle );
+                _index_mil  = _tf_map.add( _tf_mil  );
+                _index_ab   = _tf_map.add( _tf_ab   );
+
+                if ( getThrustMapError() > 1.0e-6 )
+                {
+                    Exception e;
+
+                    e.setType( Exception::UnknownException );
+                    e.setInfo( "Engine thrust map verification failed." );
+
+                    FDM_THROW( e );
+                }
+            }
         }
         else
         {
@@ -145,6 +175,53 @@ void F16_Engine::readData( XmlNode &dataNode )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+double F16_Engine::getThrustMapError() const
+{
+    double error = 0.0;
+
+    if ( _tf_map.getSize() == 3 )
+    {
+        const Table2 *tables[ 3 ] = { &_tf_idle, &_tf_mil, &_tf_ab };
+        const unsigned int index[ 3 ] = { _index_idle, _index_mil, _index_ab };
+        const double thrust[ 3 ] = { _thrust_mil, _thrust_mil, _thrust_ab };
+
+        double tf[ 3 ];
+
+        for ( unsigned int i = 0; i < 3; i++ )
+        {
+            const Table2 *table = tables[ i ];
+
+            unsigned int rows = table->getRows();
+            unsigned int cols = table->getCols();
+
+            // keys values, midpoints between them and values outside keys range
+            for ( unsigned int r = 0; r <= 2 * rows; r++ )
+            {
+                double r_0 = table->getRowValue( ( r > 0 ) ? ( r - 1 ) / 2 : 0 );
+                double r_1 = table->getRowValue( ( r / 2 < rows ) ? r / 2 : rows - 1 );
+                double row_value = ( r == 0 ) ? r_0 - 1.0 : ( r == 2 * rows ? r_1 + 1.0 : 0.5 * ( r_0 + r_1 ) );
+
+                for ( unsigned int c = 0; c <= 2 * cols; c++ )
+                {
+                    double c_0 = table->getColValue( ( c > 0 ) ? ( c - 1 ) / 2 : 0 );
+                    double c_1 = table->getColValue( ( c / 2 < cols ) ? c / 2 : cols - 1 );
+                    double col_value = ( c == 0 ) ? c_0 - 1.0 : ( c == 2 * cols ? c_1 + 1.0 : 0.5 * ( c_0 + c_1 ) );
+
+                    _tf_map.getValues( row_value, col_value, tf );
+
+                    double delta = thrust[ i ] * fabs( tf[ index[ i ] ] - table->getValue( row_value, col_value ) );
+
+                    if ( delta > error ) error = delta;
+                }
+            }
+        }
+    }
+
+    return error;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void F16_Engine::initialize( bool engineOn )
 {
     if ( engineOn )
@@ -171,7 +248,26 @@ void F16_Engine::computeThrust( double machNumber, double airDensity )
     {
         // (NASA-TP-1538, p.218)
         // (NASA-TN-D-8176, p.152)
-        if ( _afterburner )
+        if ( _baked )
+        {
+            double tf[ 3 ];
+
+            _tf_map.getValues( machNumber, airDensity, tf );
+
+            double t_idle = _thrust_mil * tf[ _index_idle ];
+            double t_mil  = _thrust_mil * tf[ _index_mil  ];
+            double t_ab   = _thrust_ab  * tf[ _index_ab   ];
+
+            if ( _afterburner )
+            {
+                _thrust = t_mil + ( t_ab - t_mil ) * ( _pow - 0.5 ) / 0.5;
+            }
+            else
+            {
+                _thrust = t_idle + ( t_mil - t_idle ) * std::min( 0.5, _pow ) / 0.5;
+            }
+        }
+        else if ( _afterburner )
         {
             double t_mil = _thrust_mil * _tf_mil .getValue( machNumber, airDensity );
             double t_ab  = _thrust_ab  * _tf_ab  .getValue( machNumber, airDensity );
@@ -196,8 +292,16 @@ void F16_Engine::computeThrust( double machNumber, double airDensity )
 
 void F16_Engine::integrate( double timeStep )
 {
-    double pow_deriv = _thrust_tc_inv * ( _pow_command - _pow );
-    _pow = _pow + timeStep * pow_deriv;
+    if ( _baked )
+    {
+        // closed-form first order lag update
+        _pow = Misc::inertia( _pow_command, _pow, timeStep, 1.0 / _thrust_tc_inv );
+    }
+    else
+    {
+        double pow_deriv = _thrust_tc_inv * ( _pow_command - _pow );
+        _pow = _pow + timeStep * pow_deriv;
+    }
 
     double epsilon_n1 = 0.01 * ( _n1 < _n1_idle ? _n1_idle : _n1_max );
     double epsilon_n2 = 0.01 * ( _n2 < _n2_idle ? _n2_idle : _n2_max );
@@ -315,3 +419,26 @@ void F16_Engine::update( double throttle, double temperature,
         _afterburner = false;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F16_Engine::archiveState( StateArchive *archive )
+{
+    archive->addEnum( &_state );
+
+    archive->add( &_n1_setpoint );
+    archive->add( &_n2_setpoint );
+    archive->add( &_tit_setpoint );
+    archive->add( &_pow_command );
+    archive->add( &_pow );
+    archive->add( &_thrust_tc_inv );
+    archive->add( &_tit_tc_actual );
+    archive->add( &_temperature );
+
+    archive->add( &_n1 );
+    archive->add( &_n2 );
+    archive->add( &_tit );
+    archive->add( &_fuelFlow );
+    archive->add( &_thrust );
+    archive->add( &_afterburner );
+}
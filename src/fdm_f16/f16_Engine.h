@@ -24,8 +24,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_Table2Pack.h>
 #include <fdm/utils/fdm_Vector3.h>
 
 #include <fdm/xml/fdm_XmlNode.h>
@@ -43,7 +45,7 @@ namespace fdm
  *
  * XML configuration file format:
  * @code
- * <turbofan_ab>
+ * <turbofan_ab [baked="{ 0|1 }"]>
  *   <position> { [m] x-coordinate } { [m] y-coordinate } { [m] z-coordinate } </position>
  *   <thrust_mil> { [N] maximum military thrust } </thrust_mil>
  *   <thrust_ab> { [N] maximum afterburner thrust } </thrust_ab>
@@ -92,6 +94,11 @@ namespace fdm
  *   </thrust_factor_ab>
  * </turbofan_ab>
  * @endcode
+ *
+ * Optional "baked" attribute enables thrust map, with idle, military and
+ * afterburner thrust factors evaluated in a single lookup, and closed-form
+ * (exact exponential) engine power lag update. Thrust map is verified
+ * against thrust factor tables when data is read.
  */
 class F16_Engine
 {
@@ -146,6 +153,20 @@ public:
                  double machNumber, double airDensity,
                  bool fuel, bool starter );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
+    /**
+     * Returns maximum difference between thrust map and thrust factor tables.
+     * Tables are sampled at keys values and midpoints between them, as well
+     * as outside keys range.
+     * @return [N] maximum thrust difference
+     */
+    double getThrustMapError() const;
+
     /**
      * Returns engine state.
      * @return engine state
@@ -221,6 +242,12 @@ protected:
     Table2 _tf_mil;         ///< [-] military thrust factor
     Table2 _tf_ab;          ///< [-] afterburner thrust factor
 
+    Table2Pack _tf_map;     ///< [-] thrust map (idle, military and afterburner thrust factors)
+
+    unsigned int _index_idle;   ///< idle thrust factor index in thrust map results
+    unsigned int _index_mil;    ///< military thrust factor index in thrust map results
+    unsigned int _index_ab;     ///< afterburner thrust factor index in thrust map results
+
     Table1 _tc_n1;          ///<
     Table1 _tc_n2;          ///<
 
@@ -266,6 +293,8 @@ protected:
 
     bool _afterburner;      ///< specifies if afterburner is engaged
 
+    bool _baked;            ///< specifies if thrust map and closed-form power lag are enabled
+
     double getTimeConst( double delta_n, double n_max, double tc );
 };
 
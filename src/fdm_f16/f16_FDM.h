@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** F-16 flight dynamics model wrapper class. */
-class F16_FDM : public FDM
+class F16_FDM final : public FDM
 {
 public:
 
@@ -113,7 +113,9 @@ F16_FLCS::F16_FLCS() :
 
     _delta_r   ( 0.0 ),
 
-    _gun_compensation ( 0.0 )
+    _gun_compensation ( 0.0 ),
+
+    _compiled ( false )
 {
     // lef
     _alpha_lef = new LeadLag( 2.0, 7.25, 1.0, 7.25 );
@@ -151,6 +153,37 @@ F16_FLCS::F16_FLCS() :
     _u_sum_ll2   = new LeadLag( 1.5,  0.0, 1.0,  1.0 );
     _delta_r_fil = new Filter2( 1.0, 0.0, 1225.0, 1.0, 70.0, 1225.0 );
     _delta_r_lag = new Lag( 1.0 / 20.0 );
+
+    // compiled filters network, sections are added in Filters order
+    _bank.add( *_alpha_lef );
+    _bank.add( *_stick_lat );
+    _bank.add( *_p_com_lag );
+    _bank.add( *_p_com_pos );
+    _bank.add( *_p_com_neg );
+    _bank.add( *_omg_p_lag );
+    _bank.add( *_omg_p_fil );
+    _bank.add( *_delta_fl_lag );
+    _bank.add( *_delta_fr_lag );
+    _bank.add( *_stick_lon );
+    _bank.add( *_alpha_lag );
+    _bank.add( *_g_com_lag );
+    _bank.add( *_omg_q_lag );
+    _bank.add( *_omg_q_fil );
+    _bank.add( *_g_z_input );
+    _bank.add( *_sca_bias_1 );
+    _bank.add( *_sca_bias_2 );
+    _bank.add( *_sca_bias_3 );
+    _bank.add( *_u_sca_fil );
+    _bank.add( *_u_sca_fil2 );
+    _bank.add( *_actuator_l );
+    _bank.add( *_actuator_r );
+    _bank.add( *_pedals );
+    _bank.add( *_omg_r_lag );
+    _bank.add( *_omg_p_yaw );
+    _bank.add( *_u_sum_ll1 );
+    _bank.add( *_u_sum_ll2 );
+    _bank.add( *_delta_r_fil );
+    _bank.add( *_delta_r_lag );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -211,6 +244,8 @@ void F16_FLCS::update( double timeStep, double angleOfAttack,
     {
         _timeStep = timeStep;
 
+        if ( _compiled ) _bank.setTimeStep( _timeStep );
+
         // (AD-A055-417, p.20, Note A)
         // 646 psf = 30,930.6473 Pa
         if ( ( dynPress < 30930.6473 && refuel_door_open ) || lg_handle_dn || alt_flaps_ext )
@@ -245,6 +280,13 @@ void F16_FLCS::update( double timeStep, double angleOfAttack,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void F16_FLCS::setCompiled( bool compiled )
+{
+    _compiled = compiled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void F16_FLCS::setAilerons_max( double ailerons_max )
 {
     _ailerons_max = ailerons_max;
@@ -279,11 +321,11 @@ void F16_FLCS::setFlaps_le_max( double flaps_le_max )
 
 void F16_FLCS::updateLEF( double angleOfAttack, double q_p )
 {
-    _alpha_lef->update( _timeStep, Units::rad2deg( angleOfAttack ) );
+    updateFilter( _alpha_lef, ALPHA_LEF, Units::rad2deg( angleOfAttack ) );
 
     // (NASA-TP-1538, p.34)
     // delta_lef = 1.38 (2s+7.25)/(s+7.25) alpha - 9.05 q/p_s + 1.45
-    double flaps_le_deg = 1.38 * _alpha_lef->getValue()
+    double flaps_le_deg = 1.38 * getFilter( _alpha_lef, ALPHA_LEF )
             - 9.05 * q_p + 1.45;
 
     _flaps_le = Misc::satur( 0.0, _flaps_le_max, Units::deg2rad( flaps_le_deg ) );
@@ -320,25 +362,25 @@ void F16_FLCS::updateLat( double ctrlLat, double trimLat,
     // (AD-A055-417, p.20)
     double omg_p_deg = Units::rad2deg( rollRate );
 
-    _stick_lat->update( _timeStep, ctrlLat );
+    updateFilter( _stick_lat, STICK_LAT, ctrlLat );
 
-    double p_com = _stick_lat->getValue();
+    double p_com = getFilter( _stick_lat, STICK_LAT );
 
     if ( _gains == Landing ) p_com *= 0.542;
 
-    double p_loop_pos = std::max( 0.0, _p_com_pos->getValue() );
-    double p_loop_neg = std::min( 0.0, _p_com_neg->getValue() );
-    _p_com_lag->update( _timeStep, p_com - p_loop_pos - p_loop_neg );
+    double p_loop_pos = std::max( 0.0, getFilter( _p_com_pos, P_COM_POS ) );
+    double p_loop_neg = std::min( 0.0, getFilter( _p_com_neg, P_COM_NEG ) );
+    updateFilter( _p_com_lag, P_COM_LAG, p_com - p_loop_pos - p_loop_neg );
 
-    _p_com_pos->update( _timeStep, std::max( 0.0, _p_com_lag->getValue() ) );
-    _p_com_neg->update( _timeStep, std::min( 0.0, _p_com_lag->getValue() ) );
+    updateFilter( _p_com_pos, P_COM_POS, std::max( 0.0, getFilter( _p_com_lag, P_COM_LAG ) ) );
+    updateFilter( _p_com_neg, P_COM_NEG, std::min( 0.0, getFilter( _p_com_lag, P_COM_LAG ) ) );
 
-    _omg_p_lag->update( _timeStep, omg_p_deg );
-    _omg_p_fil->update( _timeStep, _omg_p_lag->getValue() );
+    updateFilter( _omg_p_lag, OMG_P_LAG, omg_p_deg );
+    updateFilter( _omg_p_fil, OMG_P_FIL, getFilter( _omg_p_lag, OMG_P_LAG ) );
 
     double roll_ap_tie_in = 0.0; // TODO
-    double roll_control = _omg_p_fil->getValue()
-            - ( _p_com_lag->getValue() + trimLat * 1.67 )
+    double roll_control = getFilter( _omg_p_fil, OMG_P_FIL )
+            - ( getFilter( _p_com_lag, P_COM_LAG ) + trimLat * 1.67 )
             - roll_ap_tie_in
             + 1.67 * _gun_compensation;
 
@@ -353,12 +395,12 @@ void F16_FLCS::updateLat( double ctrlLat, double trimLat,
 
     _delta_ac = _delta_frc - _delta_flc;
 
-    _delta_fl_lag->update( _timeStep, _delta_flc );
-    _delta_fr_lag->update( _timeStep, _delta_frc );
+    updateFilter( _delta_fl_lag, DELTA_FL_LAG, _delta_flc );
+    updateFilter( _delta_fr_lag, DELTA_FR_LAG, _delta_frc );
 
     double flaperons_delta_max = 80.0 * _timeStep;
-    _delta_fl = getSurfaceMaxRate( _delta_fl, _delta_fl_lag->getValue(), flaperons_delta_max );
-    _delta_fr = getSurfaceMaxRate( _delta_fr, _delta_fr_lag->getValue(), flaperons_delta_max );
+    _delta_fl = getSurfaceMaxRate( _delta_fl, getFilter( _delta_fl_lag, DELTA_FL_LAG ), flaperons_delta_max );
+    _delta_fr = getSurfaceMaxRate( _delta_fr, getFilter( _delta_fr_lag, DELTA_FR_LAG ), flaperons_delta_max );
 
     _delta_a = 0.5 * ( _delta_fr - _delta_fl );
 
@@ -377,13 +419,13 @@ void F16_FLCS::updateLon( double ctrlLon, double trimLon,
     double alpha_deg = Units::rad2deg( angleOfAttack );
     double omg_q_deg = Units::rad2deg( pitchRate );
 
-    _alpha_lag->update( _timeStep, Misc::satur( -5.0, 30.0, alpha_deg ) );
-    _stick_lon->update( _timeStep, ctrlLon   );
-    _g_z_input->update( _timeStep, g_z - 1.0 );
-    _omg_q_lag->update( _timeStep, omg_q_deg );
-    _omg_q_fil->update( _timeStep, _omg_q_lag->getValue() );
+    updateFilter( _alpha_lag, ALPHA_LAG, Misc::satur( -5.0, 30.0, alpha_deg ) );
+    updateFilter( _stick_lon, STICK_LON, ctrlLon   );
+    updateFilter( _g_z_input, G_Z_INPUT, g_z - 1.0 );
+    updateFilter( _omg_q_lag, OMG_Q_LAG, omg_q_deg );
+    updateFilter( _omg_q_fil, OMG_Q_FIL, getFilter( _omg_q_lag, OMG_Q_LAG ) );
 
-    double g_com = _stick_lon->getValue() + trimLon;
+    double g_com = getFilter( _stick_lon, STICK_LON ) + trimLon;
     double g_max =  8.0;
     double g_min = -4.0;
 
@@ -400,32 +442,32 @@ void F16_FLCS::updateLon( double ctrlLon, double trimLon,
         }
     }
 
-    _g_com_lag->update( _timeStep, Misc::satur( g_min, g_max, g_com ) * ( touchdown ? 1.0 : 0.5 ) );
+    updateFilter( _g_com_lag, G_COM_LAG, Misc::satur( g_min, g_max, g_com ) * ( touchdown ? 1.0 : 0.5 ) );
 
-    double q_gained = 0.7 * getGainF3( dynPress ) * _omg_q_fil->getValue();
-    double aoa_limit = std::max( 0.0, 0.5 * ( _alpha_lag->getValue() - 20.4 + q_gained ) );
+    double q_gained = 0.7 * getGainF3( dynPress ) * getFilter( _omg_q_fil, OMG_Q_FIL );
+    double aoa_limit = std::max( 0.0, 0.5 * ( getFilter( _alpha_lag, ALPHA_LAG ) - 20.4 + q_gained ) );
 
     double pitch_ap_tie_in = 0.0; // TODO
-    double g_command = aoa_limit - _g_com_lag->getValue() - pitch_ap_tie_in;
+    double g_command = aoa_limit - getFilter( _g_com_lag, G_COM_LAG ) - pitch_ap_tie_in;
 
-    _sca_bias_1->update( _timeStep, touchdown ? 0.0 : 6.0 );
-    _sca_bias_2->update( _timeStep, _gains == Landing ? 9.0 : 0.0 );
-    _sca_bias_3->update( _timeStep, _gains == Landing ? 1.0 : 0.0 );
+    updateFilter( _sca_bias_1, SCA_BIAS_1, touchdown ? 0.0 : 6.0 );
+    updateFilter( _sca_bias_2, SCA_BIAS_2, _gains == Landing ? 9.0 : 0.0 );
+    updateFilter( _sca_bias_3, SCA_BIAS_3, _gains == Landing ? 1.0 : 0.0 );
 
-    double aoa_bias = 9.0 - _sca_bias_2->getValue() + _sca_bias_1->getValue();
+    double aoa_bias = 9.0 - getFilter( _sca_bias_2, SCA_BIAS_2 ) + getFilter( _sca_bias_1, SCA_BIAS_1 );
 
-    double u_sca_1 = 0.161 * ( q_gained + _alpha_lag->getValue() - aoa_bias );
-    double u_sca_2 = ( touchdown ? 0.231 : 0.167 ) * _omg_q_fil->getValue()
-            + 0.5 * _g_z_input->getValue();
+    double u_sca_1 = 0.161 * ( q_gained + getFilter( _alpha_lag, ALPHA_LAG ) - aoa_bias );
+    double u_sca_2 = ( touchdown ? 0.231 : 0.167 ) * getFilter( _omg_q_fil, OMG_Q_FIL )
+            + 0.5 * getFilter( _g_z_input, G_Z_INPUT );
 
     double u_sca = std::max( 0.0, u_sca_1 ) //+ std::min( 0.0, u_sca_1 ) * m_sca_bias_3->getValue()
             + u_sca_2;
 
-    _u_sca_fil->update( _timeStep, u_sca );
-    _u_sca_fil2->update( _timeStep, _u_sca_fil->getValue() );
+    updateFilter( _u_sca_fil, U_SCA_FIL, u_sca );
+    updateFilter( _u_sca_fil2, U_SCA_FIL2, getFilter( _u_sca_fil, U_SCA_FIL ) );
 
-    double pitch_gained = 3.0 * getGainF3( dynPress ) * ( g_command + _u_sca_fil2->getValue() );
-    double alpha_gained = getGainF2( q_p ) * _alpha_lag->getValue();
+    double pitch_gained = 3.0 * getGainF3( dynPress ) * ( g_command + getFilter( _u_sca_fil2, U_SCA_FIL2 ) );
+    double alpha_gained = getGainF2( q_p ) * getFilter( _alpha_lag, ALPHA_LAG );
 
     double k_a = 2000.0; // open loop amplifier gain (AD-A055-417, p.22)
     double pitch_out = _pitch_int + pitch_gained;
@@ -440,12 +482,12 @@ void F16_FLCS::updateLon( double ctrlLon, double trimLon,
 
     double delta_dc = 0.5 * getGainF10( q_p ) * _delta_ac;
 
-    _actuator_l->update( _timeStep, selector_input - delta_dc );
-    _actuator_r->update( _timeStep, selector_input + delta_dc );
+    updateFilter( _actuator_l, ACTUATOR_L, selector_input - delta_dc );
+    updateFilter( _actuator_r, ACTUATOR_R, selector_input + delta_dc );
 
     double elevator_delta_max = 60.0 * _timeStep;
-    _delta_htl = getSurfaceMaxRate( _delta_htl, _actuator_l->getValue(), elevator_delta_max );
-    _delta_htr = getSurfaceMaxRate( _delta_htr, _actuator_r->getValue(), elevator_delta_max );
+    _delta_htl = getSurfaceMaxRate( _delta_htl, getFilter( _actuator_l, ACTUATOR_L ), elevator_delta_max );
+    _delta_htr = getSurfaceMaxRate( _delta_htr, getFilter( _actuator_r, ACTUATOR_R ), elevator_delta_max );
 
     _delta_htl = Misc::satur( -_elevator_max_deg, _elevator_max_deg, _delta_htl );
     _delta_htr = Misc::satur( -_elevator_max_deg, _elevator_max_deg, _delta_htr );
@@ -467,39 +509,39 @@ void F16_FLCS::updateYaw( double ctrlYaw, double trimYaw,
 {
     double omg_r_deg = Units::rad2deg( yawRate  );
 
-    _pedals->update( _timeStep, ctrlYaw );
-    _omg_r_lag->update( _timeStep, omg_r_deg );
-    _omg_p_yaw->update( _timeStep, _omg_p_lag->getValue() );
+    updateFilter( _pedals, PEDALS, ctrlYaw );
+    updateFilter( _omg_r_lag, OMG_R_LAG, omg_r_deg );
+    updateFilter( _omg_p_yaw, OMG_P_YAW, getFilter( _omg_p_lag, OMG_P_LAG ) );
 
-    double r_com = _pedals->getValue() + trimYaw;
-    double u_sum = _omg_r_lag->getValue() - ( 1.0 / 57.3 ) * _omg_p_yaw->getValue() * _alpha_lag->getValue();
+    double r_com = getFilter( _pedals, PEDALS ) + trimYaw;
+    double u_sum = getFilter( _omg_r_lag, OMG_R_LAG ) - ( 1.0 / 57.3 ) * getFilter( _omg_p_yaw, OMG_P_YAW ) * getFilter( _alpha_lag, ALPHA_LAG );
 
-    _u_sum_ll1->update( _timeStep, u_sum );
-    _u_sum_ll2->update( _timeStep, _u_sum_ll1->getValue() );
+    updateFilter( _u_sum_ll1, U_SUM_LL1, u_sum );
+    updateFilter( _u_sum_ll2, U_SUM_LL2, getFilter( _u_sum_ll1, U_SUM_LL1 ) );
 
     // Aileron Rudder Interconnect (ARI)
     double ari_gain = 0.0;
 
     // (AD-A055-417, p.20)
     // (NASA-TP-1538, p.216)
-    double alpha_abs = fabs( _alpha_lag->getValue() );
+    double alpha_abs = fabs( getFilter( _alpha_lag, ALPHA_LAG ) );
     if ( alpha_abs < 10.0 )
     {
         ari_gain = 1.0 - alpha_abs / 10.0;
     }
     double ari = //0.0375 * _alpha_lag->getValue()
-        - 0.65 * ari_gain * _alpha_lag->getValue() * getGainF7( q_p );
+        - 0.65 * ari_gain * getFilter( _alpha_lag, ALPHA_LAG ) * getGainF7( q_p );
 
     double u_gy = -g_y; // TODO
-    double r_auto = getGainF8( q_p ) * ( _u_sum_ll2->getValue() + 19.32 * u_gy ) + 0.5 * _delta_ac * ari;
+    double r_auto = getGainF8( q_p ) * ( getFilter( _u_sum_ll2, U_SUM_LL2 ) + 19.32 * u_gy ) + 0.5 * _delta_ac * ari;
 
     double delta_rc = r_com + r_auto;
 
-    _delta_r_fil->update( _timeStep, delta_rc );
-    _delta_r_lag->update( _timeStep, _delta_r_fil->getValue() );
+    updateFilter( _delta_r_fil, DELTA_R_FIL, delta_rc );
+    updateFilter( _delta_r_lag, DELTA_R_LAG, getFilter( _delta_r_fil, DELTA_R_FIL ) );
 
     double rudder_delta_max = 120.0 * _timeStep;
-    _delta_r = getSurfaceMaxRate( _delta_r, _delta_r_lag->getValue(), rudder_delta_max );
+    _delta_r = getSurfaceMaxRate( _delta_r, getFilter( _delta_r_lag, DELTA_R_LAG ), rudder_delta_max );
     _delta_r = Misc::satur( -_rudder_max_deg, _rudder_max_deg, _delta_r );
 
     _rudder = Units::deg2rad( _delta_r );
@@ -667,3 +709,76 @@ double F16_FLCS::getSurfaceMaxRate( double d_old, double d_new, double delta_max
         return d_old + Misc::sign( d_new - d_old ) * delta_max;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F16_FLCS::archiveState( StateArchive *archive )
+{
+    archive->add( &_ailerons );
+    archive->add( &_ailerons_norm );
+    archive->add( &_elevator );
+    archive->add( &_elevator_norm );
+    archive->add( &_elevons );
+    archive->add( &_rudder );
+    archive->add( &_rudder_norm );
+    archive->add( &_flaps_le );
+    archive->add( &_flaps_le_norm );
+    archive->add( &_flaps_te );
+    archive->add( &_flaps_te_norm );
+
+    archive->add( &_timeStep );
+    archive->addEnum( &_gains );
+
+    _alpha_lef->archiveState( archive );
+
+    archive->add( &_flaps_int );
+    archive->add( &_flaps_com );
+
+    _stick_lat->archiveState( archive );
+    _p_com_lag->archiveState( archive );
+    _p_com_pos->archiveState( archive );
+    _p_com_neg->archiveState( archive );
+    _omg_p_lag->archiveState( archive );
+    _omg_p_fil->archiveState( archive );
+    _delta_fl_lag->archiveState( archive );
+    _delta_fr_lag->archiveState( archive );
+
+    archive->add( &_delta_flc );
+    archive->add( &_delta_frc );
+    archive->add( &_delta_fl );
+    archive->add( &_delta_fr );
+    archive->add( &_delta_ac );
+    archive->add( &_delta_a );
+
+    _stick_lon->archiveState( archive );
+    _alpha_lag->archiveState( archive );
+    _g_com_lag->archiveState( archive );
+    _omg_q_lag->archiveState( archive );
+    _omg_q_fil->archiveState( archive );
+    _g_z_input->archiveState( archive );
+    _sca_bias_1->archiveState( archive );
+    _sca_bias_2->archiveState( archive );
+    _sca_bias_3->archiveState( archive );
+    _u_sca_fil->archiveState( archive );
+    _u_sca_fil2->archiveState( archive );
+    _actuator_l->archiveState( archive );
+    _actuator_r->archiveState( archive );
+
+    archive->add( &_pitch_int );
+    archive->add( &_delta_htl );
+    archive->add( &_delta_htr );
+    archive->add( &_delta_h );
+    archive->add( &_delta_d );
+
+    _pedals->archiveState( archive );
+    _omg_r_lag->archiveState( archive );
+    _omg_p_yaw->archiveState( archive );
+    _u_sum_ll1->archiveState( archive );
+    _u_sum_ll2->archiveState( archive );
+    _delta_r_fil->archiveState( archive );
+    _delta_r_lag->archiveState( archive );
+
+    archive->add( &_delta_r );
+
+    _bank.archiveState( archive );
+}
@@ -25,9 +25,12 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/ctrl/fdm_Filter2.h>
+#include <fdm/ctrl/fdm_FilterBank.h>
 #include <fdm/ctrl/fdm_Lag.h>
 #include <fdm/ctrl/fdm_LeadLag.h>
 
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -76,6 +79,12 @@ public:
                  bool alt_flaps_ext, bool refuel_door_open,
                  bool lg_handle_dn, bool touchdown );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
     inline double getAilerons()     const { return _ailerons;      }
     inline double getAileronsNorm() const { return _ailerons_norm; }
     inline double getElevator()     const { return _elevator;      }
@@ -88,6 +97,15 @@ public:
     inline double getFlapsTE()      const { return _flaps_te;      }
     inline double getFlapsTENorm()  const { return _flaps_te_norm; }
 
+    /**
+     * Sets compiled control law mode.
+     * In compiled mode filters coefficients are discretized once for the
+     * FLCS rate and filters are updated as sections of the filter bank.
+     * Filter objects are the reference implementation used otherwise.
+     * @param compiled specifies if compiled mode is enabled
+     */
+    void setCompiled( bool compiled );
+
     void setAilerons_max( double ailerons_max );
     void setElevator_max( double elevator_max );
     void setRudder_max( double rudder_max );
@@ -95,6 +113,41 @@ public:
 
 private:
 
+    /** Filters indices in the compiled filter bank. */
+    enum Filters
+    {
+        ALPHA_LEF = 0,
+        STICK_LAT,
+        P_COM_LAG,
+        P_COM_POS,
+        P_COM_NEG,
+        OMG_P_LAG,
+        OMG_P_FIL,
+        DELTA_FL_LAG,
+        DELTA_FR_LAG,
+        STICK_LON,
+        ALPHA_LAG,
+        G_COM_LAG,
+        OMG_Q_LAG,
+        OMG_Q_FIL,
+        G_Z_INPUT,
+        SCA_BIAS_1,
+        SCA_BIAS_2,
+        SCA_BIAS_3,
+        U_SCA_FIL,
+        U_SCA_FIL2,
+        ACTUATOR_L,
+        ACTUATOR_R,
+        PEDALS,
+        OMG_R_LAG,
+        OMG_P_YAW,
+        U_SUM_LL1,
+        U_SUM_LL2,
+        DELTA_R_FIL,
+        DELTA_R_LAG,
+        FILTERS_COUNT
+    };
+
     double _ailerons_max;               ///< [rad] ailerons deflection limit
     double _elevator_max;               ///< [rad] elevator deflection limit
     double _rudder_max;                 ///< [rad] rudder  deflection limit
@@ -187,6 +240,36 @@ private:
 
     double _gun_compensation;           ///<
 
+    FilterBank _bank;                   ///< compiled filters network
+    bool _compiled;                     ///< specifies if compiled mode is enabled
+
+    /**
+     * Updates filter due to input value.
+     * @param filter reference filter object
+     * @param id filter index in the compiled filter bank
+     * @param u input value
+     */
+    template < class TYPE >
+    inline void updateFilter( TYPE *filter, Filters id, double u )
+    {
+        if ( _compiled )
+            _bank.update( id, u );
+        else
+            filter->update( _timeStep, u );
+    }
+
+    /**
+     * Returns filter output value.
+     * @param filter reference filter object
+     * @param id filter index in the compiled filter bank
+     * @return filter output value
+     */
+    template < class TYPE >
+    inline double getFilter( const TYPE *filter, Filters id ) const
+    {
+        return _compiled ? _bank.getValue( id ) : filter->getValue();
+    }
+
     void updateLEF( double angleOfAttack, double q_p );
 
     void updateTEF( double q_p, bool alt_flaps_ext, bool lg_handle_dn );
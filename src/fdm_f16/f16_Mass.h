@@ -36,7 +36,7 @@ class F16_Aircraft;     // aircraft class forward declaration
 /**
  * @brief F-16 mass class.
  */
-class F16_Mass : public Mass
+class F16_Mass final : public Mass
 {
 public:
 
@@ -38,7 +38,7 @@ class F16_Aircraft;     // aircraft class forward declaration
 /**
  * @brief F-16 propulsion class.
  */
-class F16_Propulsion : public Propulsion
+class F16_Propulsion final : public Propulsion
 {
 public:
 
@@ -63,6 +63,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const F16_Engine* getEngine() const { return _engine; }
 
 private:
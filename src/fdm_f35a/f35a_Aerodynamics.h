@@ -40,7 +40,7 @@ class F35A_Aircraft;    // aircraft class forward declaration
 /**
  * @brief F-35A aerodynamics class.
  */
-class F35A_Aerodynamics : public Aerodynamics
+class F35A_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -62,6 +62,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     /**
      * Returns true if aircraft is stalling, otherwise returns false.
      * @return true if aircraft is stalling, false otherwise
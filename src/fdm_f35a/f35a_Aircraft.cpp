@@ -65,3 +65,10 @@ void F35A_Aircraft::initialize( bool engineOn )
     Aircraft::initialize( engineOn );
     /////////////////////////////////
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F35A_Aircraft::computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas )
+{
+    sumForceAndMoment( _aero, _gear, _mass, _prop, for_bas, mom_bas );
+}
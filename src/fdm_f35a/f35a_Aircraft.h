@@ -40,7 +40,7 @@ namespace fdm
 /**
  * @brief F-35A aircraft class.
  */
-class F35A_Aircraft : public Aircraft
+class F35A_Aircraft final : public Aircraft
 {
 public:
 
@@ -75,6 +75,9 @@ private:
     F35A_LandingGear  *_gear;  ///< landing gear model
     F35A_Mass         *_mass;  ///< mass and inertia model
     F35A_Propulsion   *_prop;  ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
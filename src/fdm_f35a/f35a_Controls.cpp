@@ -166,7 +166,7 @@ void F35A_Controls::update()
     Controls::update();
     ///////////////////
 
-    _flcs->update( _aircraft->getTimeStep(),
+    _flcs->update( getUpdateTimeStep(),
                    _channelRoll  ->output , 0.0,
                    _channelPitch ->output , 0.0,
                    _channelYaw   ->output , 0.0,
@@ -196,3 +196,22 @@ void F35A_Controls::update()
 
     _nose_wheel = _channelNoseWheel->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F35A_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    _flcs->archiveState( archive );
+
+    archive->add( &_ailerons );
+    archive->add( &_elevator );
+    archive->add( &_rudder );
+    archive->add( &_flaps_le );
+    archive->add( &_flaps_te );
+    archive->add( &_airbrake );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+    archive->add( &_nose_wheel );
+}
@@ -38,7 +38,7 @@ class F35A_Aircraft;    // aircraft class forward declaration
 /**
  * @brief F-35A controls class.
  */
-class F35A_Controls : public Controls
+class F35A_Controls final : public Controls
 {
 public:
 
@@ -60,6 +60,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const F35A_FLCS* getFLCS() const { return _flcs; }
 
     inline double getAilerons()  const { return _ailerons;   }
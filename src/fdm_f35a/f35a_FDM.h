@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** F-35A flight dynamics model wrapper class. */
-class F35A_FDM : public FDM
+class F35A_FDM final : public FDM
 {
 public:
 
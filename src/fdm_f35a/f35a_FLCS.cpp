@@ -22,6 +22,7 @@
 
 #include <fdm_f35a/f35a_FLCS.h>
 
+#include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Units.h>
 
 #include <fdm/xml/fdm_XmlUtils.h>
@@ -43,6 +44,8 @@ F35A_FLCS::F35A_FLCS() :
     _pid_pitch_2 ( 0.0, 0.0, 0.0, -1.0, 1.0 ),
     _pid_yaw     ( 0.0, 0.0, 0.0, -1.0, 1.0 ),
 
+    _compiled ( false ),
+
     _timeStep ( 0.0 ),
 
     _max_rate_ailerons ( 0.0 ),
@@ -82,6 +85,8 @@ void F35A_FLCS::readData( XmlNode &dataNode )
     {
         int result = FDM_SUCCESS;
 
+        _compiled = String::toBool( dataNode.getAttribute( "compiled" ), false );
+
         // maximum controls rates
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_max_rate_ailerons , "max_rate_ailerons" );
         if ( result == FDM_SUCCESS ) result = XmlUtils::read( dataNode, &_max_rate_elevator , "max_rate_elevator" );
@@ -177,6 +182,15 @@ void F35A_FLCS::readData( XmlNode &dataNode )
         if ( result == FDM_SUCCESS ) _lef_aoa_flaps.multiplyKeys( Units::deg2rad() );
 
         if ( result != FDM_SUCCESS ) XmlUtils::throwError( __FILE__, __LINE__, dataNode );
+
+        // compiled input filters, sections are added in Filters order
+        _bank.clear();
+        _bank.add( _lag_ctrl_roll  );
+        _bank.add( _lag_rate_roll  );
+        _bank.add( _lag_ctrl_pitch );
+        _bank.add( _lag_rate_pitch );
+        _bank.add( _lag_ctrl_yaw   );
+        _bank.add( _lag_rate_yaw   );
     }
     else
     {
@@ -201,9 +215,11 @@ void F35A_FLCS::update( double timeStep,
     {
         _timeStep = timeStep;
 
-        updateCtrlRoll  ( timeStep, ctrlLat, trimLat, omg_bas );
-        updateCtrlPitch ( timeStep, ctrlLon, trimLon, omg_bas, gforce_bas, grav_bas, statPress, dynPress, angleOfAttack );
-        updateCtrlYaw   ( timeStep, ctrlYaw, trimYaw, omg_bas );
+        updateFilters( timeStep, ctrlLat, ctrlLon, ctrlYaw, omg_bas );
+
+        updateCtrlRoll  ( timeStep, trimLat );
+        updateCtrlPitch ( timeStep, trimLon, gforce_bas, grav_bas, statPress, dynPress, angleOfAttack );
+        updateCtrlYaw   ( timeStep, trimYaw );
 
         updateFlapsLE( timeStep, angleOfAttack );
         updateFlapsTE( timeStep, lg_handle_dn  );
@@ -212,15 +228,42 @@ void F35A_FLCS::update( double timeStep,
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void F35A_FLCS::updateCtrlRoll( double timeStep,
-                                double ctrlLat, double trimLat,
-                                const Vector3 &omg_bas )
+void F35A_FLCS::updateFilters( double timeStep,
+                               double ctrlLat, double ctrlLon, double ctrlYaw,
+                               const Vector3 &omg_bas )
 {
-    _lag_ctrl_roll.update( timeStep, ctrlLat );
-    _lag_rate_roll.update( timeStep, omg_bas.p() );
+    if ( _compiled )
+    {
+        double u[ FILTERS_COUNT ];
+
+        u[ CTRL_ROLL  ] = ctrlLat;
+        u[ RATE_ROLL  ] = omg_bas.p();
+        u[ CTRL_PITCH ] = ctrlLon;
+        u[ RATE_PITCH ] = omg_bas.q();
+        u[ CTRL_YAW   ] = ctrlYaw;
+        u[ RATE_YAW   ] = omg_bas.r();
+
+        _bank.setTimeStep( timeStep );
+        _bank.update( u );
+    }
+    else
+    {
+        _lag_ctrl_roll  .update( timeStep, ctrlLat     );
+        _lag_rate_roll  .update( timeStep, omg_bas.p() );
+        _lag_ctrl_pitch .update( timeStep, ctrlLon     );
+        _lag_rate_pitch .update( timeStep, omg_bas.q() );
+        _lag_ctrl_yaw   .update( timeStep, ctrlYaw     );
+        _lag_rate_yaw   .update( timeStep, omg_bas.r() );
+    }
+}
 
-    double ctrl_filtered = _lag_ctrl_roll.getValue();
-    double rate_filtered = _lag_rate_roll.getValue();
+////////////////////////////////////////////////////////////////////////////////
+
+void F35A_FLCS::updateCtrlRoll( double timeStep,
+                                double trimLat )
+{
+    double ctrl_filtered = getFilter( _lag_ctrl_roll, CTRL_ROLL );
+    double rate_filtered = getFilter( _lag_rate_roll, RATE_ROLL );
 
     double command = _ctrl_input_roll.getValue( ctrl_filtered );
 
@@ -237,8 +280,7 @@ void F35A_FLCS::updateCtrlRoll( double timeStep,
 ////////////////////////////////////////////////////////////////////////////////
 
 void F35A_FLCS::updateCtrlPitch( double timeStep,
-                                 double ctrlLon, double trimLon,
-                                 const Vector3 &omg_bas,
+                                 double trimLon,
                                  const Vector3 &gforce_bas,
                                  const Vector3 &grav_bas,
                                  double statPress, double dynPress,
@@ -246,11 +288,8 @@ void F35A_FLCS::updateCtrlPitch( double timeStep,
 {
     // NASA-TP-1689, p.49
 
-    _lag_ctrl_pitch.update( timeStep, ctrlLon );
-    _lag_rate_pitch.update( timeStep, omg_bas.q() );
-
-    double ctrl_filtered = _lag_ctrl_pitch.getValue();
-    double rate_filtered = _lag_rate_pitch.getValue();
+    double ctrl_filtered = getFilter( _lag_ctrl_pitch, CTRL_PITCH );
+    double rate_filtered = getFilter( _lag_rate_pitch, RATE_PITCH );
 
     double command = _ctrl_input_pitch.getValue( ctrl_filtered );
 
@@ -275,14 +314,10 @@ void F35A_FLCS::updateCtrlPitch( double timeStep,
 ////////////////////////////////////////////////////////////////////////////////
 
 void F35A_FLCS::updateCtrlYaw( double timeStep,
-                               double ctrlYaw, double trimYaw,
-                               const Vector3 &omg_bas )
+                               double trimYaw )
 {
-    _lag_ctrl_yaw.update( timeStep, ctrlYaw );
-    _lag_rate_yaw.update( timeStep, omg_bas.r() );
-
-    double ctrl_filtered = _lag_ctrl_yaw.getValue();
-    double rate_filtered = _lag_rate_yaw.getValue();
+    double ctrl_filtered = getFilter( _lag_ctrl_yaw, CTRL_YAW );
+    double rate_filtered = getFilter( _lag_rate_yaw, RATE_YAW );
 
     double error = -_yaw_rate_gain * rate_filtered;
 
@@ -314,3 +349,30 @@ void F35A_FLCS::updateFlapsTE( double timeStep, bool lg_handle_dn )
     _norm_flaps_te = Misc::rate( timeStep, _max_rate_flaps_te, _norm_flaps_te, setpoint );
     _norm_flaps_te = Misc::satur(  0.0, 1.0, _norm_flaps_te );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void F35A_FLCS::archiveState( StateArchive *archive )
+{
+    _lag_ctrl_roll.archiveState( archive );
+    _lag_ctrl_pitch.archiveState( archive );
+    _lag_ctrl_yaw.archiveState( archive );
+    _lag_rate_roll.archiveState( archive );
+    _lag_rate_pitch.archiveState( archive );
+    _lag_rate_yaw.archiveState( archive );
+
+    _pid_roll.archiveState( archive );
+    _pid_pitch_1.archiveState( archive );
+    _pid_pitch_2.archiveState( archive );
+    _pid_yaw.archiveState( archive );
+
+    _bank.archiveState( archive );
+
+    archive->add( &_timeStep );
+
+    archive->add( &_norm_ailerons );
+    archive->add( &_norm_elevator );
+    archive->add( &_norm_rudder );
+    archive->add( &_norm_flaps_le );
+    archive->add( &_norm_flaps_te );
+}
@@ -24,9 +24,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/ctrl/fdm_FilterBank.h>
 #include <fdm/ctrl/fdm_Lag.h>
 #include <fdm/ctrl/fdm_PID.h>
 
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Vector3.h>
 
@@ -54,6 +56,10 @@ public:
 
     /**
      * Reads data.
+     * Optional compiled="{ 0|1 }" attribute enables compiled mode, in which
+     * input filters coefficients are discretized once for the FLCS rate and
+     * all filters are updated in one pass. Lag objects are the reference
+     * implementation used otherwise.
      * @param dataNode XML node
      */
     void readData( XmlNode &dataNode );
@@ -70,6 +76,12 @@ public:
                  double statPress, double dynPress,
                  bool lg_handle_dn );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
     inline double getNormAilerons () const { return _norm_ailerons; }
     inline double getNormElevator () const { return _norm_elevator; }
     inline double getNormRudder   () const { return _norm_rudder;   }
@@ -78,6 +90,18 @@ public:
 
 private:
 
+    /** Filters indices in the compiled filter bank. */
+    enum Filters
+    {
+        CTRL_ROLL = 0,
+        RATE_ROLL,
+        CTRL_PITCH,
+        RATE_PITCH,
+        CTRL_YAW,
+        RATE_YAW,
+        FILTERS_COUNT
+    };
+
     Table1 _ctrl_input_roll;            ///<
     Table1 _ctrl_input_pitch;           ///<
 
@@ -98,6 +122,9 @@ private:
     PID _pid_pitch_2;                   ///<
     PID _pid_yaw;                       ///<
 
+    FilterBank _bank;                   ///< compiled input filters
+    bool _compiled;                     ///< specifies if compiled mode is enabled
+
     double _timeStep;                   ///< [s] time step
 
     double _max_rate_ailerons;          ///< [1/s]
@@ -119,21 +146,33 @@ private:
     double _norm_flaps_le;              ///< [-]
     double _norm_flaps_te;              ///< [-]
 
+    void updateFilters( double timeStep,
+                        double ctrlLat, double ctrlLon, double ctrlYaw,
+                        const Vector3 &omg_bas );
+
     void updateCtrlRoll( double timeStep,
-                         double ctrlLat, double trimLat,
-                         const Vector3 &omg_bas );
+                         double trimLat );
 
     void updateCtrlPitch( double timeStep,
-                          double ctrlLon, double trimLon,
-                          const Vector3 &omg_bas,
+                          double trimLon,
                           const Vector3 &gforce_bas,
                           const Vector3 &grav_bas,
                           double statPress, double dynPress,
                           double angleOfAttack );
 
     void updateCtrlYaw( double timeStep,
-                        double ctrlYaw, double trimYaw,
-                        const Vector3 &omg_bas );
+                        double trimYaw );
+
+    /**
+     * Returns filter output value.
+     * @param lag reference lag object
+     * @param id filter index in the compiled filter bank
+     * @return filter output value
+     */
+    inline double getFilter( const Lag &lag, Filters id ) const
+    {
+        return _compiled ? _bank.getValue( id ) : lag.getValue();
+    }
 
     void updateFlapsLE( double timeStep, double angleOfAttack );
     void updateFlapsTE( double timeStep, bool lg_handle_dn );
@@ -53,7 +53,7 @@ class F35A_Aircraft;    // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class F35A_LandingGear : public LandingGear
+class F35A_LandingGear final : public LandingGear
 {
 public:
 
@@ -75,6 +75,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const F35A_Aircraft *_aircraft; ///< aircraft model main object
@@ -36,7 +36,7 @@ class F35A_Aircraft;    // aircraft class forward declaration
 /**
  * @brief F-35A mass class.
  */
-class F35A_Mass : public Mass
+class F35A_Mass final : public Mass
 {
 public:
 
@@ -38,7 +38,7 @@ class F35A_Aircraft;    // aircraft class forward declaration
 /**
  * @brief F-35A propulsion class.
  */
-class F35A_Propulsion : public Propulsion
+class F35A_Propulsion final : public Propulsion
 {
 public:
 
@@ -63,6 +63,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const F35A_Engine* getEngine() const { return _engine; }
 
 private:
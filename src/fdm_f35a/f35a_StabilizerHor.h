@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief F-35A horizontal stabilizer class.
  */
-class F35A_StabilizerHor : public StabilizerHor
+class F35A_StabilizerHor final : public StabilizerHor
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief F-35A vertical stabilizer class.
  */
-class F35A_StabilizerVer : public StabilizerVer
+class F35A_StabilizerVer final : public StabilizerVer
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief F-35A tail-off aerodynamics class.
  */
-class F35A_TailOff : public TailOff
+class F35A_TailOff final : public TailOff
 {
 public:
 
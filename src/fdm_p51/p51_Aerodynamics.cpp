@@ -156,4 +156,15 @@ void P51_Aerodynamics::update()
     ///////////////////////
 
     _tailOff->update( _aircraft->getVel_air_BAS(),  _aircraft->getOmg_air_BAS() );
+    _stabHor->update( getUpdateTimeStep(), _aircraft->getAngleOfAttack() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void P51_Aerodynamics::archiveState( StateArchive *archive )
+{
+    Aerodynamics::archiveState( archive );
+
+    _tailOff->archiveState( archive );
+    _stabHor->archiveState( archive );
 }
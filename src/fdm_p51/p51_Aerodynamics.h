@@ -40,7 +40,7 @@ class P51_Aircraft;    // aircraft class forward declaration
 /**
  * @brief P-51 aerodynamics class.
  */
-class P51_Aerodynamics : public Aerodynamics
+class P51_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -62,6 +62,9 @@ public:
     /** Updates aerodynamics. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     /**
      * Returns true if aircraft is stalling, otherwise returns false.
      * @return true if aircraft is stalling, false otherwise
@@ -42,7 +42,7 @@ namespace fdm
  *
  * @see Erection and Maintenance Instructions for Army Models P-51 (...). North American Aviation, AN 01-60JE-2, 1944
  */
-class P51_Aircraft : public Aircraft
+class P51_Aircraft final : public Aircraft
 {
 public:
 
@@ -77,6 +77,9 @@ private:
     P51_LandingGear  *_gear;    ///< landing gear model
     P51_Mass         *_mass;    ///< mass and inertia model
     P51_Propulsion   *_prop;    ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
@@ -36,7 +36,7 @@ class P51_Aircraft;    // aircraft class forward declaration
 /**
  * @brief P-51 controls class.
  */
-class P51_Controls : public Controls
+class P51_Controls final : public Controls
 {
 public:
 
@@ -52,6 +52,9 @@ public:
     /** Updates controls. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getAilerons()     const { return _ailerons;      }
     inline double getElevator()     const { return _elevator;      }
     inline double getRudder()       const { return _rudder;        }
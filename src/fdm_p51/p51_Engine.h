@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief P-51 engine class.
  */
-class P51_Engine : public PistonEngine
+class P51_Engine final : public PistonEngine
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** P-51 flight dynamics model wrapper class. */
-class P51_FDM : public FDM
+class P51_FDM final : public FDM
 {
 public:
 
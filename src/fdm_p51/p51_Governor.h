@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief P-51 propeller governor class.
  */
-class P51_Governor : public Governor
+class P51_Governor final : public Governor
 {
 public:
 
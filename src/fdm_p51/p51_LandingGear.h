@@ -53,7 +53,7 @@ class P51_Aircraft;    // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class P51_LandingGear : public LandingGear
+class P51_LandingGear final : public LandingGear
 {
 public:
 
@@ -75,6 +75,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const P51_Aircraft *_aircraft;      ///< aircraft model main object
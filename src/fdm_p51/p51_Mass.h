@@ -36,7 +36,7 @@ class P51_Aircraft;    // aircraft class forward declaration
 /**
  * @brief P-51 mass class.
  */
-class P51_Mass : public Mass
+class P51_Mass final : public Mass
 {
 public:
 
@@ -75,3 +75,11 @@ void P51_Propeller::update( double propellerLever, double engineTorque,
     Propeller::update( _governor->getPitch(), engineTorque, airspeed, airDensity );
     ///////////////////////////////////////////////////////////////////////////////
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void P51_Propeller::archiveState( StateArchive *archive )
+{
+    Propeller::archiveState( archive );
+    _governor->archiveState( archive );
+}
@@ -36,7 +36,7 @@ namespace fdm
 /**
  * @brief P-51 propeller class.
  */
-class P51_Propeller : public Propeller
+class P51_Propeller final : public Propeller
 {
 public:
 
@@ -62,6 +62,12 @@ public:
     void update( double propellerLever, double engineTorque,
                  double airspeed, double airDensity );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 private:
 
     P51_Governor *_governor;        ///< propeller governor model
@@ -61,6 +61,8 @@ void P51_Propulsion::readData( XmlNode &dataNode )
 
         _engine->readData( nodeEngine );
         _propeller->readData( nodePropeller );
+
+        _engine->setTorqueDerivativeEnabled( _propeller->isImplicit() );
     }
     else
     {
@@ -155,7 +157,8 @@ void P51_Propulsion::update()
     bool ignition = _inputIgnition .getDatab();
     bool starter  = _inputStarter  .getDatab();
 
-    _propeller->integrate( _aircraft->getTimeStep(), _engine->getInertia() );
+    _propeller->integrate( getUpdateTimeStep(), _engine->getInertia(),
+                           _engine->getTorqueDerivative() );
 
     _engine->update( throttle, mixture, _propeller->getEngineRPM(),
                      _aircraft->getEnvir()->getPressure(),
@@ -167,3 +170,13 @@ void P51_Propulsion::update()
                         _aircraft->getAirspeed(),
                         _aircraft->getEnvir()->getDensity() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void P51_Propulsion::archiveState( StateArchive *archive )
+{
+    Propulsion::archiveState( archive );
+
+    _engine->archiveState( archive );
+    _propeller->archiveState( archive );
+}
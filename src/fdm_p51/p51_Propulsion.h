@@ -39,7 +39,7 @@ class P51_Aircraft;    // aircraft class forward declaration
 /**
  * @brief P-51 propulsion class.
  */
-class P51_Propulsion : public Propulsion
+class P51_Propulsion final : public Propulsion
 {
 public:
 
@@ -64,6 +64,9 @@ public:
     /** Updates propulsion. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const P51_Engine* getEngine() const { return _engine; }
     inline const P51_Propeller* getPropeller() const { return _propeller; }
 
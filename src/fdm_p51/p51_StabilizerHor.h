@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief P-51 horizontal stabilizer class.
  */
-class P51_StabilizerHor : public StabilizerHor
+class P51_StabilizerHor final : public StabilizerHor
 {
 public:
 
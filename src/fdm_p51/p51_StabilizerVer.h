@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief P-51 vertical stabilizer class.
  */
-class P51_StabilizerVer : public StabilizerVer
+class P51_StabilizerVer final : public StabilizerVer
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief P-51 tail-off aerodynamics class.
  */
-class P51_TailOff : public TailOff
+class P51_TailOff final : public TailOff
 {
 public:
 
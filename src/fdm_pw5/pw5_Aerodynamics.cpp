@@ -140,4 +140,15 @@ void PW5_Aerodynamics::update()
     ///////////////////////
 
     _tailOff->update( _aircraft->getVel_air_BAS(),  _aircraft->getOmg_air_BAS() );
+    _stabHor->update( getUpdateTimeStep(), _aircraft->getAngleOfAttack() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PW5_Aerodynamics::archiveState( StateArchive *archive )
+{
+    Aerodynamics::archiveState( archive );
+
+    _tailOff->archiveState( archive );
+    _stabHor->archiveState( archive );
 }
@@ -40,7 +40,7 @@ class PW5_Aircraft;    // aircraft class forward declaration
 /**
  * @brief PW-5 aerodynamics class.
  */
-class PW5_Aerodynamics : public Aerodynamics
+class PW5_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -62,6 +62,9 @@ public:
     /** Updates aerodynamics. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     /**
      * Returns true if aircraft is stalling, otherwise returns false.
      * @return true if aircraft is stalling, false otherwise
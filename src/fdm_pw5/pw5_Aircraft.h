@@ -45,7 +45,7 @@ namespace fdm
  * @see PW-5 Sailplane Flight Manual, PW-5/IWL/I/97, 1997
  * @see Skrzydla w miniaturze nr 17: PW-5 Smyk, BM-2, Tipsy Junior
  */
-class PW5_Aircraft : public Aircraft
+class PW5_Aircraft final : public Aircraft
 {
 public:
 
@@ -80,6 +80,9 @@ private:
     PW5_LandingGear  *_gear;    ///< landing gear model
     PW5_Mass         *_mass;    ///< mass and inertia model
     PW5_Propulsion   *_prop;    ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
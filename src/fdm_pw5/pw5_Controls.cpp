@@ -101,3 +101,17 @@ void PW5_Controls::update()
 
     _wheelBrake = _channelWheelBrake->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PW5_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    archive->add( &_ailerons );
+    archive->add( &_elevator );
+    archive->add( &_rudder );
+    archive->add( &_elevator_trim );
+    archive->add( &_airbrake );
+    archive->add( &_wheelBrake );
+}
@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** PW-5 flight dynamics model wrapper class. */
-class PW5_FDM : public FDM
+class PW5_FDM final : public FDM
 {
 public:
 
@@ -76,32 +76,15 @@ void PW5_LandingGear::computeForceAndMoment()
     _for_bas.zeroize();
     _mom_bas.zeroize();
 
-    for ( Wheels::iterator it = _wheels.begin(); it != _wheels.end(); ++it )
-    {
-        Wheel &wheel = (*it).second.wheel;
-
-        if ( wheel.getPosition() >= 1.0 )
-        {
-            Vector3 r_c_bas;
-            Vector3 n_c_bas;
-
-            getIsect( wheel.getRa_BAS(), wheel.getRu_BAS(), &r_c_bas, &n_c_bas );
-
-            wheel.computeForceAndMoment( _aircraft->getVel_BAS(),
-                                         _aircraft->getOmg_BAS(),
-                                         r_c_bas,
-                                         n_c_bas,
-                                         _steering, _antiskid );
-
-            _for_bas += wheel.getFor_BAS();
-            _mom_bas += wheel.getMom_BAS();
-        }
-    }
+    computeWheelsForceAndMoment( _wheels );
 
     for ( WingRunners::iterator it = _runners.begin(); it != _runners.end(); ++it )
     {
         WingRunner &runner = (*it);
 
+        // released wing runner is never active again
+        if ( !runner.isActive() ) continue;
+
         Vector3 r_c_bas;
         Vector3 n_c_bas;
 
@@ -142,23 +125,13 @@ void PW5_LandingGear::update()
     _antiskid = false;
     _steering = false;
 
+    integrateWheels( _wheels );
+
     for ( Wheels::iterator it = _wheels.begin(); it != _wheels.end(); ++it )
     {
         DataRef &input = (*it).second.input;
         Wheel   &wheel = (*it).second.wheel;
 
-        Vector3 r_c_bas;
-        Vector3 n_c_bas;
-
-        getIsect( wheel.getRa_BAS(), wheel.getRu_BAS(), &r_c_bas, &n_c_bas );
-
-        wheel.integrate( _aircraft->getTimeStep(),
-                         _aircraft->getVel_BAS(),
-                         _aircraft->getOmg_BAS(),
-                         r_c_bas,
-                         n_c_bas,
-                         _steering );
-
         double brake = 0.0;
         if      ( wheel.getBrakeGroup() == Wheel::Both  ) brake = 0.5 * ( _brake_l + _brake_r );
         else if ( wheel.getBrakeGroup() == Wheel::Left  ) brake = _brake_l;
@@ -169,6 +142,20 @@ void PW5_LandingGear::update()
 
     for ( WingRunners::iterator it = _runners.begin(); it != _runners.end(); ++it )
     {
-        (*it).update( _aircraft->getTimeStep(), _aircraft->getVel_BAS(), _onGround );
+        (*it).update( getUpdateTimeStep(), _aircraft->getVel_BAS(), _onGround );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PW5_LandingGear::archiveState( StateArchive *archive )
+{
+    LandingGear::archiveState( archive );
+
+    archiveWheels( archive, _wheels );
+
+    for ( WingRunners::iterator it = _runners.begin(); it != _runners.end(); ++it )
+    {
+        (*it).archiveState( archive );
     }
 }
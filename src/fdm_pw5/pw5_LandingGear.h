@@ -62,7 +62,7 @@ class PW5_Aircraft;    // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class PW5_LandingGear : public LandingGear
+class PW5_LandingGear final : public LandingGear
 {
 public:
 
@@ -86,6 +86,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const PW5_Aircraft *_aircraft;      ///< aircraft model main object
@@ -36,7 +36,7 @@ class PW5_Aircraft;    // aircraft class forward declaration
 /**
  * @brief PW-5 mass class.
  */
-class PW5_Mass : public Mass
+class PW5_Mass final : public Mass
 {
 public:
 
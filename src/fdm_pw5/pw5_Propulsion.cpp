@@ -71,8 +71,16 @@ void PW5_Propulsion::computeForceAndMoment()
     _for_bas.zeroize();
     _mom_bas.zeroize();
 
+#   ifdef FDM_IMPLICIT_CONTACT
+    _winchLauncher->setImplicitCable( _aircraft->getMass()->getMass(),
+                                      _aircraft->getTimeStep(),
+                                      _aircraft->getGrav_BAS() );
+#   endif
+
     _winchLauncher->computeForceAndMoment( _aircraft->getWGS2BAS(),
-                                           _aircraft->getPos_WGS() );
+                                           _aircraft->getPos_WGS(),
+                                           _aircraft->getVel_BAS(),
+                                           _aircraft->getOmg_BAS() );
 
     _for_bas += _winchLauncher->getFor_BAS();
     _mom_bas += _winchLauncher->getMom_BAS();
@@ -82,9 +90,27 @@ void PW5_Propulsion::computeForceAndMoment()
 
 void PW5_Propulsion::update()
 {
-    _winchLauncher->update( _aircraft->getTimeStep(),
+    _winchLauncher->update( getUpdateTimeStep(),
                             _aircraft->getBAS2WGS(),
                             _aircraft->getWGS2NED(),
                             _aircraft->getPos_WGS(),
                             _aircraft->getAltitude_AGL() );
+
+    // winch launcher is never reattached, glider has no other propulsion
+    if ( !_winchLauncher->isActive() )
+    {
+        _for_bas.zeroize();
+        _mom_bas.zeroize();
+
+        retire();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void PW5_Propulsion::archiveState( StateArchive *archive )
+{
+    Propulsion::archiveState( archive );
+
+    _winchLauncher->archiveState( archive );
 }
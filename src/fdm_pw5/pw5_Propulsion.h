@@ -38,7 +38,7 @@ class PW5_Aircraft;    // aircraft class forward declaration
 /**
  * @brief PW-5 propulsion class.
  */
-class PW5_Propulsion : public Propulsion
+class PW5_Propulsion final : public Propulsion
 {
 public:
 
@@ -60,6 +60,9 @@ public:
     /** Updates propulsion. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const PW5_Aircraft *_aircraft;  ///< aircraft model main object
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief PW-5 horizontal stabilizer class.
  */
-class PW5_StabilizerHor : public StabilizerHor
+class PW5_StabilizerHor final : public StabilizerHor
 {
 public:
 
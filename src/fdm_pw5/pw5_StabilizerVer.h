@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief PW-5 vertical stabilizer class.
  */
-class PW5_StabilizerVer : public StabilizerVer
+class PW5_StabilizerVer final : public StabilizerVer
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief PW-5 tail-off aerodynamics class.
  */
-class PW5_TailOff : public TailOff
+class PW5_TailOff final : public TailOff
 {
 public:
 
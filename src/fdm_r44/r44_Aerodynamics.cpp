@@ -39,13 +39,17 @@ R44_Aerodynamics::R44_Aerodynamics( const R44_Aircraft *aircraft, Input *input )
     _tailRotor ( FDM_NULLPTR ),
     _fuselage  ( FDM_NULLPTR ),
     _stabHor   ( FDM_NULLPTR ),
-    _stabVer   ( FDM_NULLPTR )
+    _stabVer   ( FDM_NULLPTR ),
+
+    _rotorWake ( FDM_NULLPTR )
 {
     _mainRotor = new R44_MainRotor();
     _tailRotor = new R44_TailRotor();
     _fuselage  = new R44_Fuselage();
     _stabHor   = new R44_StabilizerHor();
     _stabVer   = new R44_StabilizerVer();
+
+    _rotorWake = new RotorWake();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +61,8 @@ R44_Aerodynamics::~R44_Aerodynamics()
     FDM_DELPTR( _fuselage );
     FDM_DELPTR( _stabHor );
     FDM_DELPTR( _stabVer );
+
+    FDM_DELPTR( _rotorWake );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +82,11 @@ void R44_Aerodynamics::readData( XmlNode &dataNode )
         _fuselage->readData( nodeFuselage );
         _stabHor->readData( nodeStabHor );
         _stabVer->readData( nodeStabVer );
+
+        // rotor wake interference is optional
+        XmlNode nodeRotorWake = dataNode.getFirstChildElement( "rotor_wake" );
+
+        if ( nodeRotorWake.isValid() ) _rotorWake->readData( nodeRotorWake );
     }
     else
     {
@@ -107,21 +118,33 @@ void R44_Aerodynamics::computeForceAndMoment()
                                        _aircraft->getGrav_BAS(),
                                        _aircraft->getEnvir()->getDensity() );
 
-    _tailRotor->computeForceAndMoment( _aircraft->getVel_air_BAS(),
+    // wake geometry is computed once and shared by all the components
+    _rotorWake->update( _mainRotor,
+                        _aircraft->getVel_air_BAS(),
+                        _aircraft->getOmg_air_BAS() );
+
+    _tailRotor->computeForceAndMoment( _rotorWake->getVel_air_BAS( _aircraft->getVel_air_BAS(),
+                                                                   _tailRotor->getR_hub_BAS() ),
                                        _aircraft->getOmg_air_BAS(),
                                        _aircraft->getEnvir()->getDensity() );
 
+    // legacy fuselage inputs are kept unless rotor wake model is enabled
+    double vel_i_fus = _rotorWake->isEnabled() ? _rotorWake->getVel_i()
+                                               : _mainRotor->getBeta1c();
+
     _fuselage->computeForceAndMoment( _aircraft->getVel_air_BAS(),
                                       _aircraft->getOmg_air_BAS(),
                                       _aircraft->getEnvir()->getDensity(),
-                                      _mainRotor->getBeta1c(),
+                                      vel_i_fus,
                                       _mainRotor->getWakeSkew() );
 
-    _stabHor->computeForceAndMoment( _aircraft->getVel_air_BAS(),
+    _stabHor->computeForceAndMoment( _rotorWake->getVel_air_BAS( _aircraft->getVel_air_BAS(),
+                                                                 _stabHor->getR_ac_BAS() ),
                                      _aircraft->getOmg_air_BAS(),
                                      _aircraft->getEnvir()->getDensity() );
 
-    _stabVer->computeForceAndMoment( _aircraft->getVel_air_BAS(),
+    _stabVer->computeForceAndMoment( _rotorWake->getVel_air_BAS( _aircraft->getVel_air_BAS(),
+                                                                 _stabVer->getR_ac_BAS() ),
                                      _aircraft->getOmg_air_BAS(),
                                      _aircraft->getEnvir()->getDensity() );
 
@@ -157,7 +180,8 @@ void R44_Aerodynamics::update()
     Aerodynamics::update();
     ///////////////////////
 
-    _mainRotor->update( _aircraft->getProp()->getMainRotorOmega(),
+    _mainRotor->update( getUpdateTimeStep(),
+                        _aircraft->getProp()->getMainRotorOmega(),
                         _aircraft->getProp()->getMainRotorPsi(),
                         _aircraft->getCtrl()->getCollective(),
                         _aircraft->getCtrl()->getCyclicLat(),
@@ -166,3 +190,14 @@ void R44_Aerodynamics::update()
     _tailRotor->update( _aircraft->getProp()->getTailRotorOmega(),
                         _aircraft->getCtrl()->getTailPitch() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void R44_Aerodynamics::archiveState( StateArchive *archive )
+{
+    Aerodynamics::archiveState( archive );
+
+    _mainRotor->archiveState( archive );
+    _tailRotor->archiveState( archive );
+    _rotorWake->archiveState( archive );
+}
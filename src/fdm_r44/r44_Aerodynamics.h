@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/main/fdm_Aerodynamics.h>
+#include <fdm/models/fdm_RotorWake.h>
 
 #include <fdm_r44/r44_MainRotor.h>
 #include <fdm_r44/r44_TailRotor.h>
@@ -42,7 +43,7 @@ class R44_Aircraft;     // aircraft class forward declaration
 /**
  * @brief R44 aerodynamics class.
  */
-class R44_Aerodynamics : public Aerodynamics
+class R44_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -67,6 +68,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const R44_MainRotor* getMainRotor() const { return _mainRotor; }
 
 private:
@@ -78,6 +82,8 @@ private:
     R44_Fuselage      *_fuselage;       ///<
     R44_StabilizerHor *_stabHor;        ///<
     R44_StabilizerVer *_stabVer;        ///<
+
+    RotorWake *_rotorWake;              ///< main rotor wake interference model
 };
 
 } // end of fdm namespace
@@ -40,7 +40,7 @@ namespace fdm
 /**
  * @brief R44 aircraft class.
  */
-class R44_Aircraft : public Aircraft
+class R44_Aircraft final : public Aircraft
 {
 public:
 
@@ -75,6 +75,9 @@ private:
     R44_LandingGear  *_gear;    ///< landing gear model
     R44_Mass         *_mass;    ///< mass and inertia model
     R44_Propulsion   *_prop;    ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
@@ -88,3 +88,15 @@ void R44_Controls::update()
     _collective = _channelCollective->output;
     _tail_pitch = _channelTailPitch->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void R44_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    archive->add( &_cyclic_lat );
+    archive->add( &_cyclic_lon );
+    archive->add( &_collective );
+    archive->add( &_tail_pitch );
+}
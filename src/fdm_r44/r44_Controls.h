@@ -36,7 +36,7 @@ class R44_Aircraft;     // aircraft class forward declaration
 /**
  * @brief R44 controls class.
  */
-class R44_Controls : public Controls
+class R44_Controls final : public Controls
 {
 public:
 
@@ -52,6 +52,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getCyclicLat()  const { return _cyclic_lat; }
     inline double getCyclicLon()  const { return _cyclic_lon; }
     inline double getCollective() const { return _collective; }
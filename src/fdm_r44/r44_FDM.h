@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** R44 flight dynamics model wrapper class. */
-class R44_FDM : public FDM
+class R44_FDM final : public FDM
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief R44 fuselage class.
  */
-class R44_Fuselage : public Fuselage
+class R44_Fuselage final : public Fuselage
 {
 public:
 
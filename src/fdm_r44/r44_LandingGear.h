@@ -53,7 +53,7 @@ class R44_Aircraft;     // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class R44_LandingGear : public LandingGear
+class R44_LandingGear final : public LandingGear
 {
 public:
 
@@ -75,6 +75,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const R44_Aircraft *_aircraft;      ///< aircraft model main object
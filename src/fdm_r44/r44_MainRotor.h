@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief R44 main rotor base class.
  */
-class R44_MainRotor : public MainRotor
+class R44_MainRotor final : public MainRotor
 {
 public:
 
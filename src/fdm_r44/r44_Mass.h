@@ -36,7 +36,7 @@ class R44_Aircraft;     // aircraft class forward declaration
 /**
  * @brief R44 mass class.
  */
-class R44_Mass : public Mass
+class R44_Mass final : public Mass
 {
 public:
 
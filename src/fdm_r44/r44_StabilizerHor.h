@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief R44 horizontal stabilizer class.
  */
-class R44_StabilizerHor : public StabilizerHor
+class R44_StabilizerHor final : public StabilizerHor
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief R44 vertical stabilizer class.
  */
-class R44_StabilizerVer : public StabilizerVer
+class R44_StabilizerVer final : public StabilizerVer
 {
 public:
 
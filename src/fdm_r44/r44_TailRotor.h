@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief R44 tail rotor base class.
  */
-class R44_TailRotor : public TailRotor
+class R44_TailRotor final : public TailRotor
 {
 public:
 
@@ -39,13 +39,17 @@ UH60_Aerodynamics::UH60_Aerodynamics( const UH60_Aircraft *aircraft, Input *inpu
     _tailRotor ( FDM_NULLPTR ),
     _fuselage  ( FDM_NULLPTR ),
     _stabHor   ( FDM_NULLPTR ),
-    _stabVer   ( FDM_NULLPTR )
+    _stabVer   ( FDM_NULLPTR ),
+
+    _rotorWake ( FDM_NULLPTR )
 {
     _mainRotor = new UH60_MainRotor();
     _tailRotor = new UH60_TailRotor();
     _fuselage  = new UH60_Fuselage();
     _stabHor   = new UH60_StabilizerHor();
     _stabVer   = new UH60_StabilizerVer();
+
+    _rotorWake = new RotorWake();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -57,6 +61,8 @@ UH60_Aerodynamics::~UH60_Aerodynamics()
     FDM_DELPTR( _fuselage );
     FDM_DELPTR( _stabHor );
     FDM_DELPTR( _stabVer );
+
+    FDM_DELPTR( _rotorWake );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +82,11 @@ void UH60_Aerodynamics::readData( XmlNode &dataNode )
         _fuselage->readData( nodeFuselage );
         _stabHor->readData( nodeStabHor );
         _stabVer->readData( nodeStabVer );
+
+        // rotor wake interference is optional
+        XmlNode nodeRotorWake = dataNode.getFirstChildElement( "rotor_wake" );
+
+        if ( nodeRotorWake.isValid() ) _rotorWake->readData( nodeRotorWake );
     }
     else
     {
@@ -107,25 +118,43 @@ void UH60_Aerodynamics::computeForceAndMoment()
                                        _aircraft->getGrav_BAS(),
                                        _aircraft->getEnvir()->getDensity() );
 
-    _tailRotor->computeForceAndMoment( _aircraft->getVel_air_BAS(),
+    // wake geometry is computed once and shared by all the components
+    _rotorWake->update( _mainRotor,
+                        _aircraft->getVel_air_BAS(),
+                        _aircraft->getOmg_air_BAS() );
+
+    _tailRotor->computeForceAndMoment( _rotorWake->getVel_air_BAS( _aircraft->getVel_air_BAS(),
+                                                                   _tailRotor->getR_hub_BAS() ),
                                        _aircraft->getOmg_air_BAS(),
                                        _aircraft->getEnvir()->getDensity() );
 
+    // rotor downwash ratio, NASA-CR-166309, p.5.2-5 (PDF p.90)
+    double dwshmr = 0.0;
+
+    if ( _rotorWake->isEnabled() )
+    {
+        double omegaR = _aircraft->getProp()->getMainRotorOmega() * _mainRotor->getRadius();
+
+        if ( omegaR > 1.0e-6 ) dwshmr = _rotorWake->getVel_i() / omegaR;
+    }
+
     _fuselage->computeForceAndMoment( _aircraft->getVel_air_BAS(),
                                       _aircraft->getOmg_air_BAS(),
                                       _aircraft->getEnvir()->getDensity(),
                                       _mainRotor->getBeta1c(),
                                       _mainRotor->getWakeSkew(),
-                                      0.0,
+                                      dwshmr,
                                       _aircraft->getProp()->getMainRotorOmega(),
                                       _mainRotor->getRadius() );
 
-    _stabHor->computeForceAndMoment( _aircraft->getVel_air_BAS(),
+    _stabHor->computeForceAndMoment( _rotorWake->getVel_air_BAS( _aircraft->getVel_air_BAS(),
+                                                                 _stabHor->getR_ac_BAS() ),
                                      _aircraft->getOmg_air_BAS(),
                                      _aircraft->getEnvir()->getDensity(),
                                      _aircraft->getCtrl()->getElevator() );
 
-    _stabVer->computeForceAndMoment( _aircraft->getVel_air_BAS(),
+    _stabVer->computeForceAndMoment( _rotorWake->getVel_air_BAS( _aircraft->getVel_air_BAS(),
+                                                                 _stabVer->getR_ac_BAS() ),
                                      _aircraft->getOmg_air_BAS(),
                                      _aircraft->getEnvir()->getDensity() );
 
@@ -161,7 +190,8 @@ void UH60_Aerodynamics::update()
     Aerodynamics::update();
     ///////////////////////
 
-    _mainRotor->update( _aircraft->getProp()->getMainRotorOmega(),
+    _mainRotor->update( getUpdateTimeStep(),
+                        _aircraft->getProp()->getMainRotorOmega(),
                         _aircraft->getProp()->getMainRotorPsi(),
                         _aircraft->getCtrl()->getCollective(),
                         _aircraft->getCtrl()->getCyclicLat(),
@@ -170,3 +200,14 @@ void UH60_Aerodynamics::update()
     _tailRotor->update( _aircraft->getProp()->getTailRotorOmega(),
                         _aircraft->getCtrl()->getTailPitch() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UH60_Aerodynamics::archiveState( StateArchive *archive )
+{
+    Aerodynamics::archiveState( archive );
+
+    _mainRotor->archiveState( archive );
+    _tailRotor->archiveState( archive );
+    _rotorWake->archiveState( archive );
+}
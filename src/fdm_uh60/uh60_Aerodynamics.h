@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <fdm/main/fdm_Aerodynamics.h>
+#include <fdm/models/fdm_RotorWake.h>
 
 #include <fdm_uh60/uh60_MainRotor.h>
 #include <fdm_uh60/uh60_TailRotor.h>
@@ -45,7 +46,7 @@ class UH60_Aircraft;    // aircraft class forward declaration
  * @see Howlett J.: UH-60A Black Hawk Engineering Simulation Program. NASA, CR-166309, 1981
  * @see Hilbert K.: A Mathematical Model of the UH-60 Helicopter. NASA, TM-85890, 1984
  */
-class UH60_Aerodynamics : public Aerodynamics
+class UH60_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -70,6 +71,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const UH60_MainRotor* getMainRotor() const { return _mainRotor; }
 
 private:
@@ -81,6 +85,8 @@ private:
     UH60_Fuselage      *_fuselage;      ///<
     UH60_StabilizerHor *_stabHor;       ///<
     UH60_StabilizerVer *_stabVer;       ///<
+
+    RotorWake *_rotorWake;              ///< main rotor wake interference model
 };
 
 } // end of fdm namespace
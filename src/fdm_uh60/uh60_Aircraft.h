@@ -45,7 +45,7 @@ namespace fdm
  * @see Howlett J.: UH-60A Black Hawk Engineering Simulation Program. NASA, CR-166309, 1981
  * @see Hilbert K.: A Mathematical Model of the UH-60 Helicopter. NASA, TM-85890, 1984
  */
-class UH60_Aircraft : public Aircraft
+class UH60_Aircraft final : public Aircraft
 {
 public:
 
@@ -80,6 +80,9 @@ private:
     UH60_LandingGear  *_gear;   ///< landing gear model
     UH60_Mass         *_mass;   ///< mass and inertia model
     UH60_Propulsion   *_prop;   ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
@@ -111,3 +111,18 @@ void UH60_Controls::update()
     _brake_l = _channelBrakeLeft  ->output;
     _brake_r = _channelBrakeRight ->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UH60_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    archive->add( &_cyclic_lat );
+    archive->add( &_cyclic_lon );
+    archive->add( &_collective );
+    archive->add( &_tail_pitch );
+    archive->add( &_elevator );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+}
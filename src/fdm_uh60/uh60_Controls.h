@@ -38,7 +38,7 @@ class UH60_Aircraft;    // aircraft class forward declaration
 /**
  * @brief UH-60 controls class.
  */
-class UH60_Controls : public Controls
+class UH60_Controls final : public Controls
 {
 public:
 
@@ -54,6 +54,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getCyclicLat()  const { return _cyclic_lat; }
     inline double getCyclicLon()  const { return _cyclic_lon; }
     inline double getCollective() const { return _collective; }
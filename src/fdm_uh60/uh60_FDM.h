@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** UH-60 flight dynamics model wrapper class. */
-class UH60_FDM : public FDM
+class UH60_FDM final : public FDM
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief UH-60 fuselage class.
  */
-class UH60_Fuselage : public Fuselage
+class UH60_Fuselage final : public Fuselage
 {
 public:
 
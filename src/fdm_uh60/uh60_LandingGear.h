@@ -53,7 +53,7 @@ class UH60_Aircraft;    // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class UH60_LandingGear : public LandingGear
+class UH60_LandingGear final : public LandingGear
 {
 public:
 
@@ -75,6 +75,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const UH60_Aircraft *_aircraft;     ///< aircraft model main object
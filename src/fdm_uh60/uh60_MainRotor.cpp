@@ -43,17 +43,16 @@ UH60_MainRotor::~UH60_MainRotor()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void UH60_MainRotor::update( double omega,
+void UH60_MainRotor::update( double timeStep,
+                             double omega,
                              double azimuth,
                              double collective,
                              double cyclicLat,
                              double cyclicLon )
 {
-    //////////////////////////////////////////////////////////////////////
-    MainRotor::update( omega, azimuth, collective, cyclicLat, cyclicLon );
-    //////////////////////////////////////////////////////////////////////
-
-    double timeStep = 0.0; // TODO
+    ////////////////////////////////////////////////////////////////////////////////
+    MainRotor::update( timeStep, omega, azimuth, collective, cyclicLat, cyclicLon );
+    ////////////////////////////////////////////////////////////////////////////////
 
     // NASA-CR-166309, p.5.1-49 (PDF p.69)
     const double k_ct  = 1.0;
@@ -75,3 +74,11 @@ void UH60_MainRotor::update( double omega,
     _downwashLag->setTimeConst( t_dwo / mu_tot );
     _downwashLag->update( timeStep, k_ct * _ct / ( 2.0 * mu_tot ) );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UH60_MainRotor::archiveState( StateArchive *archive )
+{
+    MainRotor::archiveState( archive );
+    _downwashLag->archiveState( archive );
+}
@@ -36,7 +36,7 @@ namespace fdm
 /**
  * @brief UH-60 main rotor base class.
  */
-class UH60_MainRotor : public MainRotor
+class UH60_MainRotor final : public MainRotor
 {
 public:
 
@@ -48,18 +48,26 @@ public:
 
     /**
      * @brief Updates main rotor model.
+     * @param timeStep   [s]     time step
      * @param omega      [rad/s] rotor revolution speed
      * @param azimuth    [rad]   rotor azimuth
      * @param collective [rad]   collective pitch angle
      * @param cyclicLat  [rad]   cyclic lateral pitch angle
      * @param cyclicLon  [rad]   cyclic longitudinal pitch angle
      */
-    void update( double omega,
+    void update( double timeStep,
+                 double omega,
                  double azimuth,
                  double collective,
                  double cyclicLat,
                  double cyclicLon );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 private:
 
     Lag *_downwashLag;
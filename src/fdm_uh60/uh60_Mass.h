@@ -36,7 +36,7 @@ class UH60_Aircraft;    // aircraft class forward declaration
 /**
  * @brief UH-60 mass class.
  */
-class UH60_Mass : public Mass
+class UH60_Mass final : public Mass
 {
 public:
 
@@ -36,7 +36,7 @@ class UH60_Aircraft;    // aircraft class forward declaration
 /**
  * @brief UH-60 propulsion class.
  */
-class UH60_Propulsion : public Propulsion
+class UH60_Propulsion final : public Propulsion
 {
 public:
 
@@ -61,6 +61,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getMainRotorPsi() const { return _mainRotorPsi; }
     inline double getTailRotorPsi() const { return _tailRotorPsi; }
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief UH-60 horizontal stabilizer class.
  */
-class UH60_StabilizerHor : public StabilizerHor
+class UH60_StabilizerHor final : public StabilizerHor
 {
 public:
 
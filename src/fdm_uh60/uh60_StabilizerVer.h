@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief UH-60 vertical stabilizer class.
  */
-class UH60_StabilizerVer : public StabilizerVer
+class UH60_StabilizerVer final : public StabilizerVer
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief UH-60 tail rotor base class.
  */
-class UH60_TailRotor : public TailRotor
+class UH60_TailRotor final : public TailRotor
 {
 public:
 
@@ -40,7 +40,7 @@ class XF_Aircraft;     // aircraft class forward declaration
 /**
  * @brief X/F aerodynamics class.
  */
-class XF_Aerodynamics : public Aerodynamics
+class XF_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -62,6 +62,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     /**
      * Returns true if aircraft is stalling, otherwise returns false.
      * @return true if aircraft is stalling, false otherwise
@@ -40,7 +40,7 @@ namespace fdm
 /**
  * @brief X/F aircraft class.
  */
-class XF_Aircraft : public Aircraft
+class XF_Aircraft final : public Aircraft
 {
 public:
 
@@ -75,6 +75,9 @@ private:
     XF_LandingGear  *_gear;    ///< landing gear model
     XF_Mass         *_mass;    ///< mass and inertia model
     XF_Propulsion   *_prop;    ///< propulsion model
+
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
 };
 
 } // end of fdm namespace
@@ -151,7 +151,7 @@ void XF_Controls::update()
     Controls::update();
     ///////////////////
 
-    _flcs->update( _aircraft->getTimeStep() );
+    _flcs->update( getUpdateTimeStep() );
 
     _ailerons = _ailerons_max * _channelRoll->output;
     _elevator = _elevator_max * _channelPitch->output;
@@ -167,3 +167,22 @@ void XF_Controls::update()
 
     _nose_wheel = _channelNoseWheel->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XF_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    _flcs->archiveState( archive );
+
+    archive->add( &_ailerons );
+    archive->add( &_elevator );
+    archive->add( &_rudder );
+    archive->add( &_flaps_le );
+    archive->add( &_flaps_te );
+    archive->add( &_airbrake );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+    archive->add( &_nose_wheel );
+}
@@ -38,7 +38,7 @@ class XF_Aircraft;     // aircraft class forward declaration
 /**
  * @brief X/F controls class.
  */
-class XF_Controls : public Controls
+class XF_Controls final : public Controls
 {
 public:
 
@@ -60,6 +60,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives controls internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const XF_FLCS* getFLCS() const { return _flcs; }
 
     inline double getAilerons()  const { return _ailerons;   }
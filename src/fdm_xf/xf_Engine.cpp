@@ -315,3 +315,26 @@ void XF_Engine::update( double throttle, double temperature,
         _afterburner = false;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XF_Engine::archiveState( StateArchive *archive )
+{
+    archive->addEnum( &_state );
+
+    archive->add( &_n1_setpoint );
+    archive->add( &_n2_setpoint );
+    archive->add( &_tit_setpoint );
+    archive->add( &_pow_command );
+    archive->add( &_pow );
+    archive->add( &_thrust_tc_inv );
+    archive->add( &_tit_tc_actual );
+    archive->add( &_temperature );
+
+    archive->add( &_n1 );
+    archive->add( &_n2 );
+    archive->add( &_tit );
+    archive->add( &_fuelFlow );
+    archive->add( &_thrust );
+    archive->add( &_afterburner );
+}
@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fdm/utils/fdm_StateArchive.h>
 #include <fdm/utils/fdm_Table1.h>
 #include <fdm/utils/fdm_Table2.h>
 #include <fdm/utils/fdm_Vector3.h>
@@ -143,6 +144,12 @@ public:
                  double machNumber, double airDensity,
                  bool fuel, bool starter );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
     /**
      * Returns engine state.
      * @return engine state
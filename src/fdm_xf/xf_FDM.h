@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** X/F flight dynamics model wrapper class. */
-class XF_FDM : public FDM
+class XF_FDM final : public FDM
 {
 public:
 
@@ -45,3 +45,10 @@ void XF_FLCS::update( double timeStep )
         _timeStep = timeStep;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XF_FLCS::archiveState( StateArchive *archive )
+{
+    archive->add( &_timeStep );
+}
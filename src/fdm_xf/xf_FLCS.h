@@ -28,6 +28,8 @@
 #include <fdm/ctrl/fdm_Lag.h>
 #include <fdm/ctrl/fdm_LeadLag.h>
 
+#include <fdm/utils/fdm_StateArchive.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace fdm
@@ -49,6 +51,12 @@ public:
     /** Updates model. */
     void update( double timeStep );
 
+    /**
+     * Archives internal states.
+     * @param archive state archive
+     */
+    void archiveState( StateArchive *archive );
+
 private:
 
     double _timeStep;                   ///< [s] time step
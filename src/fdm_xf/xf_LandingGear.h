@@ -53,7 +53,7 @@ class XF_Aircraft;     // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class XF_LandingGear : public LandingGear
+class XF_LandingGear final : public LandingGear
 {
 public:
 
@@ -75,6 +75,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const XF_Aircraft *_aircraft;  ///< aircraft model main object
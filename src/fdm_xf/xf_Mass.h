@@ -36,7 +36,7 @@ class XF_Aircraft;     // aircraft class forward declaration
 /**
  * @brief X/F mass class.
  */
-class XF_Mass : public Mass
+class XF_Mass final : public Mass
 {
 public:
 
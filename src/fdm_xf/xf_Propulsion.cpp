@@ -127,9 +127,18 @@ void XF_Propulsion::update()
     bool fuel    = _inputFuel    .getDatab();
     bool starter = _inputStarter .getDatab();
 
-    _engine->integrate( _aircraft->getTimeStep() );
+    _engine->integrate( getUpdateTimeStep() );
     _engine->update( throttle, Units::k2c( _aircraft->getEnvir()->getTemperature() ),
                      _aircraft->getMachNumber(),
                      _aircraft->getEnvir()->getDensity(),
                      fuel, starter );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XF_Propulsion::archiveState( StateArchive *archive )
+{
+    Propulsion::archiveState( archive );
+
+    _engine->archiveState( archive );
+}
@@ -38,7 +38,7 @@ class XF_Aircraft;     // aircraft class forward declaration
 /**
  * @brief X/F propulsion class.
  */
-class XF_Propulsion : public Propulsion
+class XF_Propulsion final : public Propulsion
 {
 public:
 
@@ -63,6 +63,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const XF_Engine* getEngine() const { return _engine; }
 
 private:
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/F horizontal stabilizer class.
  */
-class XF_StabilizerHor : public StabilizerHor
+class XF_StabilizerHor final : public StabilizerHor
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/F vertical stabilizer class.
  */
-class XF_StabilizerVer : public StabilizerVer
+class XF_StabilizerVer final : public StabilizerVer
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/F tail-off aerodynamics class.
  */
-class XF_TailOff : public TailOff
+class XF_TailOff final : public TailOff
 {
 public:
 
@@ -114,3 +114,15 @@ void XH_AFCS::readSAS( const XmlNode &dataNode, PID *pid )
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void XH_AFCS::archiveState( StateArchive *archive )
+{
+    _pid_sas_roll.archiveState( archive );
+    _pid_sas_pitch.archiveState( archive );
+    _pid_sas_yaw.archiveState( archive );
+
+    archive->add( &_cyclic_lat );
+    archive->add( &_cyclic_lon );
+    archive->add( &_tail_pitch );
+}
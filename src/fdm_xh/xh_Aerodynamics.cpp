@@ -188,7 +188,7 @@ void XH_Aerodynamics::update()
     Aerodynamics::update();
     ///////////////////////
 
-    _mainRotor->update( _aircraft->getTimeStep(),
+    _mainRotor->update( getUpdateTimeStep(),
                         _aircraft->getVel_air_BAS(),
                         _aircraft->getOmg_air_BAS(),
                         _aircraft->getOmg_BAS(),
@@ -205,3 +205,13 @@ void XH_Aerodynamics::update()
     _tailRotor->update( _aircraft->getProp()->getTailRotorOmega(),
                         _aircraft->getCtrl()->getTailPitch() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XH_Aerodynamics::archiveState( StateArchive *archive )
+{
+    Aerodynamics::archiveState( archive );
+
+    _mainRotor->archiveState( archive );
+    _tailRotor->archiveState( archive );
+}
@@ -42,7 +42,7 @@ class XH_Aircraft;      // aircraft class forward declaration
 /**
  * @brief X/H aerodynamics class.
  */
-class XH_Aerodynamics : public Aerodynamics
+class XH_Aerodynamics final : public Aerodynamics
 {
 public:
 
@@ -67,6 +67,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives aerodynamics internal states. */
+    void archiveState( StateArchive *archive );
+
     inline const XH_MainRotor* getMainRotor() const { return _mainRotor; }
 
 private:
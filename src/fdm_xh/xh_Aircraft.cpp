@@ -78,6 +78,13 @@ void XH_Aircraft::computeStateDeriv( const StateVector &stateVect,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void XH_Aircraft::computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas )
+{
+    sumForceAndMoment( _aero, _gear, _mass, _prop, for_bas, mom_bas );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void XH_Aircraft::updateVariables( const StateVector &stateVect,
                                    const StateVector &derivVect )
 {
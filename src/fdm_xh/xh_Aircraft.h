@@ -40,7 +40,7 @@ namespace fdm
 /**
  * @brief X/H aircraft class.
  */
-class XH_Aircraft : public Aircraft
+class XH_Aircraft final : public Aircraft
 {
 public:
 
@@ -70,14 +70,15 @@ public:
 
 private:
 
-    friend class Aircraft::Integrator;
-
     XH_Aerodynamics *_aero;   ///< aerodynamics model
     XH_Controls     *_ctrl;   ///< controls model
     XH_LandingGear  *_gear;   ///< landing gear model
     XH_Mass         *_mass;   ///< mass and inertia model
     XH_Propulsion   *_prop;   ///< propulsion model
 
+    /** @see Aircraft::computeForceAndMoment() */
+    void computeForceAndMoment( Vector3 *for_bas, Vector3 *mom_bas );
+
     /**
      * Computes state vector derivatives due to given state vector.
      * @param stateVect state vector
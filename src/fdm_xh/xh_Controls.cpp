@@ -141,7 +141,7 @@ void XH_Controls::update()
     Controls::update();
     ///////////////////
 
-    _afcs->update( _aircraft->getTimeStep(),
+    _afcs->update( getUpdateTimeStep(),
                    _inputCtrlRoll  .getValue() , 0.0,
                    _inputCtrlPitch .getValue() , 0.0,
                    _inputCtrlYaw   .getValue() , 0.0,
@@ -169,3 +169,20 @@ void XH_Controls::update()
     _brake_l = _channelBrakeLeft  ->output;
     _brake_r = _channelBrakeRight ->output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XH_Controls::archiveState( StateArchive *archive )
+{
+    Controls::archiveState( archive );
+
+    _afcs->archiveState( archive );
+
+    archive->add( &_cyclic_lat );
+    archive->add( &_cyclic_lon );
+    archive->add( &_collective );
+    archive->add( &_tail_pitch );
+    archive->add( &_elevator );
+    archive->add( &_brake_l );
+    archive->add( &_brake_r );
+}
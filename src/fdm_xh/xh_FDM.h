@@ -34,7 +34,7 @@ namespace fdm
 {
 
 /** X/H flight dynamics model wrapper class. */
-class XH_FDM : public FDM
+class XH_FDM final : public FDM
 {
 public:
 
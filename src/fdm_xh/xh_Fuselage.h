@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/H fuselage class.
  */
-class XH_Fuselage : public Fuselage
+class XH_Fuselage final : public Fuselage
 {
 public:
 
@@ -120,7 +120,7 @@ void XH_LandingGear::update()
 
         getIsect( wheel.getRa_BAS(), wheel.getRu_BAS(), &r_c_bas, &n_c_bas );
 
-        wheel.integrate( _aircraft->getTimeStep(),
+        wheel.integrate( getUpdateTimeStep(),
                          _aircraft->getVel_BAS(),
                          _aircraft->getOmg_BAS(),
                          r_c_bas,
@@ -135,3 +135,12 @@ void XH_LandingGear::update()
         wheel.update( input.isValid() ? input.getValue() : 1.0, _ctrlAngle, brake );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XH_LandingGear::archiveState( StateArchive *archive )
+{
+    LandingGear::archiveState( archive );
+
+    archiveWheels( archive, _wheels );
+}
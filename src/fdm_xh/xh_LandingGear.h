@@ -53,7 +53,7 @@ class XH_Aircraft;      // aircraft class forward declaration
  * </landing_gear>
  * @endcode
  */
-class XH_LandingGear : public LandingGear
+class XH_LandingGear final : public LandingGear
 {
 public:
 
@@ -75,6 +75,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives landing gear internal states. */
+    void archiveState( StateArchive *archive );
+
 private:
 
     const XH_Aircraft *_aircraft;     ///< aircraft model main object
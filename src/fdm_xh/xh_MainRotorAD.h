@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/H main rotor class.
  */
-class XH_MainRotorAD : public MainRotor
+class XH_MainRotorAD final : public MainRotor
 {
 public:
 
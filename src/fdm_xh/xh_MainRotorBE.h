@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/H main rotor class.
  */
-class XH_MainRotor : public MainRotorBE
+class XH_MainRotor final : public MainRotorBE
 {
 public:
 
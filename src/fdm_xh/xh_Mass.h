@@ -36,7 +36,7 @@ class XH_Aircraft;      // aircraft class forward declaration
 /**
  * @brief X/H mass class.
  */
-class XH_Mass : public Mass
+class XH_Mass final : public Mass
 {
 public:
 
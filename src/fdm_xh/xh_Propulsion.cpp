@@ -104,8 +104,8 @@ void XH_Propulsion::computeForceAndMoment()
 void XH_Propulsion::update()
 {
     // TODO
-    _mainRotorPsi += _aircraft->getTimeStep() * _mainRotorOmega;
-    _tailRotorPsi += _aircraft->getTimeStep() * _tailRotorOmega;
+    _mainRotorPsi += getUpdateTimeStep() * _mainRotorOmega;
+    _tailRotorPsi += getUpdateTimeStep() * _tailRotorOmega;
 
     _mainRotorPsi = Angles::normalize( _mainRotorPsi );
     _tailRotorPsi = Angles::normalize( _tailRotorPsi );
@@ -125,3 +125,16 @@ void XH_Propulsion::update()
         _tailRotorOmega = 0.0;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XH_Propulsion::archiveState( StateArchive *archive )
+{
+    Propulsion::archiveState( archive );
+
+    archive->add( &_mainRotorPsi );
+    archive->add( &_tailRotorPsi );
+
+    archive->add( &_mainRotorOmega );
+    archive->add( &_tailRotorOmega );
+}
@@ -36,7 +36,7 @@ class XH_Aircraft;      // aircraft class forward declaration
 /**
  * @brief X/H propulsion class.
  */
-class XH_Propulsion : public Propulsion
+class XH_Propulsion final : public Propulsion
 {
 public:
 
@@ -61,6 +61,9 @@ public:
     /** Updates model. */
     void update();
 
+    /** Archives propulsion internal states. */
+    void archiveState( StateArchive *archive );
+
     inline double getMainRotorPsi() const { return _mainRotorPsi; }
     inline double getTailRotorPsi() const { return _tailRotorPsi; }
 
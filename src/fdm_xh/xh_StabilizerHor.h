@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/H horizontal stabilizer class.
  */
-class XH_StabilizerHor : public StabilizerHor
+class XH_StabilizerHor final : public StabilizerHor
 {
 public:
 
@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/H vertical stabilizer class.
  */
-class XH_StabilizerVer : public StabilizerVer
+class XH_StabilizerVer final : public StabilizerVer
 {
 public:
 
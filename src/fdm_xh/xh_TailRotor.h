@@ -34,7 +34,7 @@ namespace fdm
 /**
  * @brief X/H tail rotor class.
  */
-class XH_TailRotor : public TailRotor
+class XH_TailRotor final : public TailRotor
 {
 public:
 
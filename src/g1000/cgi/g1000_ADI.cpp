@@ -22,6 +22,7 @@
 
 #include <g1000/cgi/g1000_ADI.h>
 
+#include <cfloat>
 #include <sstream>
 
 #include <osg/Geode>
@@ -71,7 +72,13 @@ const int ADI::_depth_sorted_bin_pitch_scale = 100;
 ////////////////////////////////////////////////////////////////////////////////
 
 ADI::ADI( IFD *ifd ) :
-    Module( ifd )
+    Module( ifd ),
+    _roll      ( DBL_MAX ),
+    _pitch     ( DBL_MAX ),
+    _slipSkid  ( DBL_MAX ),
+    _fdRoll    ( DBL_MAX ),
+    _fdPitch   ( DBL_MAX ),
+    _fdVisible ( DBL_MAX )
 {
     _pat = new osg::PositionAttitudeTransform();
     _root->addChild( _pat.get() );
@@ -122,6 +129,18 @@ void ADI::update()
 
     double ahrs_slipSkid = _ifd->grs()->getSlipSkid();
 
+    bool changed = false;
+
+    changed = isChanged( &_roll      , ahrs_roll              , G1000_RES_ANGLE ) || changed;
+    changed = isChanged( &_pitch     , ahrs_pitch             , G1000_RES_ANGLE ) || changed;
+    changed = isChanged( &_slipSkid  , ahrs_slipSkid          , 1.0e-2 * _max_slip_skid ) || changed;
+    changed = isChanged( &_fdRoll    , fd_roll                , G1000_RES_ANGLE ) || changed;
+    changed = isChanged( &_fdPitch   , fd_pitch               , G1000_RES_ANGLE ) || changed;
+    changed = isChanged( &_fdVisible , fd_visible ? 1.0 : 0.0 , 0.5 ) || changed;
+
+    _dirty = changed;
+    if ( !changed ) return;
+
     double pitch = Misc::satur( -M_PI_2 , M_PI_2 , ahrs_pitch );
     double roll  = Misc::satur( -M_PI   , M_PI   , ahrs_roll  );
 
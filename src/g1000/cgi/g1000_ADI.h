@@ -87,6 +87,13 @@ private:
 
     osg::ref_ptr<osg::Switch> _switchFlightDir;
 
+    double _roll;         ///< [rad] displayed roll angle
+    double _pitch;        ///< [rad] displayed pitch angle
+    double _slipSkid;     ///< displayed slip/skid
+    double _fdRoll;       ///< [rad] displayed flight director roll
+    double _fdPitch;      ///< [rad] displayed flight director pitch
+    double _fdVisible;    ///< displayed flight director visibility
+
     void createAircraftSymbol();
     void createFlightDirector();
     void createHorizonLine();
@@ -49,7 +49,7 @@ AFCS::~AFCS() {}
 
 void AFCS::update()
 {
-
+    _dirty = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,8 @@
 
 #include <g1000/cgi/g1000_ALT.h>
 
+#include <cfloat>
+#include <climits>
 #include <sstream>
 
 #include <osg/Geode>
@@ -60,7 +62,13 @@ const int ALT::_depth_sorted_bin_disk = 100;
 ////////////////////////////////////////////////////////////////////////////////
 
 ALT::ALT( IFD *ifd ) :
-    Module( ifd )
+    Module( ifd ),
+    _altitude    ( DBL_MAX ),
+    _pressure    ( DBL_MAX ),
+    _selAltitude ( DBL_MAX ),
+    _textAlt_100Value ( INT_MIN ),
+    _textPressValue   ( INT_MIN ),
+    _textSelectValue  ( INT_MIN )
 {
     _pat = new osg::PositionAttitudeTransform();
     _root->addChild( _pat.get() );
@@ -99,36 +107,56 @@ void ALT::update()
     double pressure_in = Units::pa2inhg( _ifd->input().ref_pressure );
     double sel_altitude_ft = Units::m2ft( _ifd->input().sel_altitude );
 
+    bool changed = false;
+
+    changed = isChanged( &_altitude    , altitude_ft     , G1000_RES_ALTITUDE ) || changed;
+    changed = isChanged( &_pressure    , pressure_in     , G1000_RES_PRESSURE ) || changed;
+    changed = isChanged( &_selAltitude , sel_altitude_ft , G1000_RES_ALTITUDE ) || changed;
+
+    _dirty = changed;
+    if ( !changed ) return;
+
     double dy_bug = Misc::satur( -33.0, 33.0, -_alt2pt * ( altitude_ft - sel_altitude_ft ) );
 
     _patScale->setPosition( osg::Vec3( 0.0, -_alt2pt * altitude_ft, 0.0 ) );
     _patBug->setPosition( osg::Vec3( 0.0, dy_bug, 0.0 ) );
 
     int alt_100 = floor( altitude_ft / 100.0 );
+    bool alt_low = fabs( altitude_ft ) < 100.0;
 
-    char alt_str[16] = { "" };
-    if ( fabs( altitude_ft ) < 100.0 )
-    {
-        if ( altitude_ft < 0.0 )
-            sprintf( alt_str, "-" );
-    }
-    else
+    // below 100 ft only the sign is shown
+    if ( isChanged( &_textAlt_100Value, 2 * alt_100 + ( alt_low ? 1 : 0 ) ) )
     {
-        sprintf( alt_str, "%d", alt_100 );
-    }
+        char alt_str[16] = { "" };
+        if ( alt_low )
+        {
+            if ( altitude_ft < 0.0 )
+                sprintf( alt_str, "-" );
+        }
+        else
+        {
+            sprintf( alt_str, "%d", alt_100 );
+        }
 
-    _textAlt_100->setText( alt_str );
+        _textAlt_100->setText( alt_str );
+    }
 
     double a = 0.5 * osg::DegreesToRadians( 3.6 ) * ( altitude_ft - 100.0 * alt_100 );
     _patDisk->setAttitude( osg::Quat( a, osg::X_AXIS ) );
 
-    char press_str[16] = { "" };
-    sprintf( press_str, "%.2f IN", pressure_in );
-    _textPress->setText( press_str );
+    if ( isChanged( &_textPressValue, (int)floor( 100.0 * pressure_in + 0.5 ) ) )
+    {
+        char press_str[16] = { "" };
+        sprintf( press_str, "%.2f IN", 0.01 * _textPressValue );
+        _textPress->setText( press_str );
+    }
 
-    char sel_alt_str[16] = { "" };
-    sprintf( sel_alt_str, "%.0f", sel_altitude_ft );
-    _textSelect->setText( sel_alt_str );
+    if ( isChanged( &_textSelectValue, (int)floor( sel_altitude_ft + 0.5 ) ) )
+    {
+        char sel_alt_str[16] = { "" };
+        sprintf( sel_alt_str, "%d", _textSelectValue );
+        _textSelect->setText( sel_alt_str );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +78,14 @@ private:
     osg::ref_ptr<osgText::Text> _textPress;
     osg::ref_ptr<osgText::Text> _textSelect;
 
+    double _altitude;       ///< [ft] displayed altitude
+    double _pressure;       ///< [inHg] displayed reference pressure
+    double _selAltitude;    ///< [ft] displayed selected altitude
+
+    int _textAlt_100Value;  ///< altitude hundreds text value
+    int _textPressValue;    ///< [0.01 inHg] reference pressure text value
+    int _textSelectValue;   ///< [ft] selected altitude text value
+
     void createAltitudeBug();
     void createBack();
     void createBox();
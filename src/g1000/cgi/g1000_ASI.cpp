@@ -26,6 +26,8 @@
 #   include <algorithm>
 #endif
 
+#include <cfloat>
+#include <climits>
 #include <sstream>
 
 #include <osg/Geode>
@@ -74,7 +76,13 @@ const int ASI::_depth_sorted_bin_disk = 100;
 ////////////////////////////////////////////////////////////////////////////////
 
 ASI::ASI( IFD *ifd, XmlNode &node ) :
-    Module( ifd )
+    Module( ifd ),
+    _ias         ( DBL_MAX ),
+    _tas         ( DBL_MAX ),
+    _selAirspeed ( DBL_MAX ),
+    _textIAS_10Value ( INT_MIN ),
+    _textTASValue    ( INT_MIN ),
+    _textSelectValue ( INT_MIN )
 {
     _pat = new osg::PositionAttitudeTransform();
     _root->addChild( _pat.get() );
@@ -145,6 +153,16 @@ void ASI::update()
     double ias_kts = Units::mps2kts( _ifd->gdc()->getIAS() );
     double tas_kts = Units::mps2kts( _ifd->gdc()->getTAS() );
     double sel_kts = Units::mps2kts( _ifd->input().sel_airspeed );
+
+    bool changed = false;
+
+    changed = isChanged( &_ias         , ias_kts , G1000_RES_AIRSPEED ) || changed;
+    changed = isChanged( &_tas         , tas_kts , G1000_RES_AIRSPEED ) || changed;
+    changed = isChanged( &_selAirspeed , sel_kts , G1000_RES_AIRSPEED ) || changed;
+
+    _dirty = changed;
+    if ( !changed ) return;
+
     double ias_min = std::max( _ias_min, ias_kts );
     double sel_min = std::max( _ias_min, sel_kts );
 
@@ -153,20 +171,16 @@ void ASI::update()
     _patScale->setPosition( osg::Vec3( 0.0, -_ias2pt * ias_min, 0.0 ) );
     _patBug->setPosition( osg::Vec3( 0.0, dy_bug, 0.0 ) );
 
-    char ias_str[16] = { "" };
-    char tas_str[16] = { "" };
-
-    int ias_10 = floor( ias_kts / 10.0 );
+    int ias_10 = -1;
+    int tas = -1;
 
     if ( ias_kts > _ias_min )
     {
         _switchIAS->setValue( 0, true );
         _switchIAS->setValue( 1, false );
 
-        int tas = floor( tas_kts + 0.5 );
-
-        sprintf( ias_str, "%d", ias_10 );
-        sprintf( tas_str, "%dKT", tas );
+        ias_10 = floor( ias_kts / 10.0 );
+        tas = floor( tas_kts + 0.5 );
 
         double a = osg::DegreesToRadians( 36.0 ) * ( ias_kts - 10.0 * ias_10 );
         _patDisk->setAttitude( osg::Quat( a, osg::X_AXIS ) );
@@ -177,8 +191,19 @@ void ASI::update()
         _switchIAS->setValue( 1, true );
     }
 
-    _textIAS_10->setText( ias_str );
-    _textTAS->setText( tas_str );
+    if ( isChanged( &_textIAS_10Value, ias_10 ) )
+    {
+        char ias_str[16] = { "" };
+        if ( ias_10 >= 0 ) sprintf( ias_str, "%d", ias_10 );
+        _textIAS_10->setText( ias_str );
+    }
+
+    if ( isChanged( &_textTASValue, tas ) )
+    {
+        char tas_str[16] = { "" };
+        if ( tas >= 0 ) sprintf( tas_str, "%dKT", tas );
+        _textTAS->setText( tas_str );
+    }
 
     if ( _groupRed.valid() )
     {
@@ -194,9 +219,12 @@ void ASI::update()
         }
     }
 
-    char sel_ias_str[16] = { "" };
-    sprintf( sel_ias_str, "%.0f", sel_kts );
-    _textSelect->setText( sel_ias_str );
+    if ( isChanged( &_textSelectValue, (int)floor( sel_kts + 0.5 ) ) )
+    {
+        char sel_ias_str[16] = { "" };
+        sprintf( sel_ias_str, "%d", _textSelectValue );
+        _textSelect->setText( sel_ias_str );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
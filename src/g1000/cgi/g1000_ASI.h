@@ -97,6 +97,14 @@ private:
     osg::ref_ptr<osgText::Text> _textTAS;
     osg::ref_ptr<osgText::Text> _textSelect;
 
+    double _ias;            ///< [kts] displayed indicated airspeed
+    double _tas;            ///< [kts] displayed true airspeed
+    double _selAirspeed;    ///< [kts] displayed selected airspeed
+
+    int _textIAS_10Value;   ///< [10 kts] indicated airspeed tens text value, negative if blank
+    int _textTASValue;      ///< [kts] true airspeed text value, negative if blank
+    int _textSelectValue;   ///< [kts] selected airspeed text value
+
     void createAirspeedBug();
     void createBack();
     void createBar( double x, double z, double min, double max, osg::Vec3 color );
@@ -0,0 +1,66 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef G1000_EFIS_H
+#define G1000_EFIS_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <g1000/cgi/g1000_GDU.h>
+
+#include <g1000/cgi/g1000_ADI.h>
+#include <g1000/cgi/g1000_HSI.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace g1000
+{
+
+/**
+ * @brief EFIS (Electronic Flight Instrument System) display class.
+ *
+ * Reduced display made of the PFD attitude director indicator and
+ * horizontal situation indicator only.
+ */
+class EFIS : public GDU
+{
+public:
+
+    /** Constructor. */
+    EFIS( IFD *ifd );
+
+    /** Destructor. */
+    virtual ~EFIS();
+
+    /** Updates EFIS. */
+    void update();
+
+private:
+
+    ADI *_adi;              ///< attitude director indicator
+    HSI *_hsi;              ///< horizontal situation indicator
+};
+
+} // end of g1000 namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // G1000_EFIS_H
@@ -22,6 +22,8 @@
 
 #include <g1000/cgi/g1000_Fonts.h>
 
+#include <mutex>
+
 #include <osgDB/ReadFile>
 
 #include <g1000/g1000_Log.h>
@@ -33,8 +35,19 @@ using namespace g1000;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+std::mutex fontsMutex;      ///< fonts list mutex, displays might be created by different threads
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 osgText::Font* Fonts::get( const char *fontFile )
 {
+    std::lock_guard< std::mutex > lock( fontsMutex );
+
     for ( unsigned int i = 0; i < instance()->_fileNames.size(); i++ )
     {
         if ( fontFile == instance()->_fileNames.at( i ) )
@@ -47,6 +60,10 @@ osgText::Font* Fonts::get( const char *fontFile )
 
     if ( font.valid() )
     {
+        // all texts of all displays share glyphs rasterized once into the
+        // same large texture instead of many small ones
+        font->setTextureSizeHint( G1000_FONT_TEXTURE_SIZE, G1000_FONT_TEXTURE_SIZE );
+
         instance()->_fonts.push_back( font.get() );
         instance()->_fileNames.push_back( fontFile );
 
@@ -64,6 +81,8 @@ osgText::Font* Fonts::get( const char *fontFile )
 
 void Fonts::reset()
 {
+    std::lock_guard< std::mutex > lock( fontsMutex );
+
     instance()->_fileNames.clear();
     instance()->_fonts.clear();
 }
@@ -29,7 +29,8 @@ using namespace g1000;
 ////////////////////////////////////////////////////////////////////////////////
 
 GDU::GDU( IFD *ifd ) :
-    _ifd ( ifd )
+    _ifd ( ifd ),
+    _dirty ( true )
 {
     _root = new osg::Group();
 
@@ -51,11 +51,16 @@ public:
 
     inline osg::Group* getRoot() { return _root.get(); }
 
+    /** Returns true if display has changed on the last update and needs to be redrawn. */
+    inline bool isDirty() const { return _dirty; }
+
 protected:
 
     const IFD *_ifd;                    ///< IFD object
 
     osg::ref_ptr<osg::Group> _root;     ///< OSG GDU root node
+
+    bool _dirty;                        ///< specifies if display has changed on the last update
 };
 
 } // end of g1000 namespace
@@ -22,6 +22,8 @@
 
 #include <g1000/cgi/g1000_HSI.h>
 
+#include <cfloat>
+#include <climits>
 #include <sstream>
 
 #include <osg/Geode>
@@ -53,7 +55,13 @@ const double HSI::_z_heading_bug     = -70.0;
 ////////////////////////////////////////////////////////////////////////////////
 
 HSI::HSI( IFD *ifd ) :
-    Module( ifd )
+    Module( ifd ),
+    _heading    ( DBL_MAX ),
+    _selHeading ( DBL_MAX ),
+    _selCourse  ( DBL_MAX ),
+    _headingTextValue ( INT_MIN ),
+    _textCRSValue     ( INT_MIN ),
+    _textHDGValue     ( INT_MIN )
 {
     _pat = new osg::PositionAttitudeTransform();
     _root->addChild( _pat.get() );
@@ -90,33 +98,51 @@ void HSI::update()
     double sel_heading = _ifd->input().sel_heading;
     double sel_course  = _ifd->input().sel_course;
 
+    bool changed = false;
+
+    changed = isChanged( &_heading    , ahrs_heading , G1000_RES_ANGLE ) || changed;
+    changed = isChanged( &_selHeading , sel_heading  , G1000_RES_ANGLE ) || changed;
+    changed = isChanged( &_selCourse  , sel_course   , G1000_RES_ANGLE ) || changed;
+
+    _dirty = changed;
+    if ( !changed ) return;
+
     _patHDG->setAttitude( osg::Quat( ahrs_heading, osg::Z_AXIS ) );
     _patBug->setAttitude( osg::Quat( ahrs_heading - sel_heading , osg::Z_AXIS ) );
     _patCRS->setAttitude( osg::Quat( ahrs_heading - sel_course  , osg::Z_AXIS ) );
 
-    char heading_str[16] = { "" };
     double heading_deg = floor( osg::RadiansToDegrees( ahrs_heading ) + 0.5 );
     while ( heading_deg <   0.0 ) heading_deg += 360.0;
     while ( heading_deg > 360.0 ) heading_deg -= 360.0;
 
-    sprintf( heading_str, "%03d°", (int)( floor( heading_deg + 0.5 ) ) );
-    _headingText->setText( osgText::String( heading_str, osgText::String::ENCODING_UTF8 ) );
+    if ( isChanged( &_headingTextValue, (int)( floor( heading_deg + 0.5 ) ) ) )
+    {
+        char heading_str[16] = { "" };
+        sprintf( heading_str, "%03d°", _headingTextValue );
+        _headingText->setText( osgText::String( heading_str, osgText::String::ENCODING_UTF8 ) );
+    }
 
-    char crs_str[16] = { "" };
     double crs_deg = osg::RadiansToDegrees( sel_course );
     while ( crs_deg <   0.0 ) crs_deg += 360.0;
     while ( crs_deg > 360.0 ) crs_deg -= 360.0;
 
-    sprintf( crs_str, "%03d°", (int)( floor( crs_deg + 0.5 ) ) );
-    _textCRS->setText( osgText::String( crs_str, osgText::String::ENCODING_UTF8 ) );
+    if ( isChanged( &_textCRSValue, (int)( floor( crs_deg + 0.5 ) ) ) )
+    {
+        char crs_str[16] = { "" };
+        sprintf( crs_str, "%03d°", _textCRSValue );
+        _textCRS->setText( osgText::String( crs_str, osgText::String::ENCODING_UTF8 ) );
+    }
 
-    char hdg_str[16] = { "" };
     double hdg_deg = osg::RadiansToDegrees( sel_heading );
     while ( hdg_deg <   0.0 ) hdg_deg += 360.0;
     while ( hdg_deg > 360.0 ) hdg_deg -= 360.0;
 
-    sprintf( hdg_str, "%03d°", (int)( floor( hdg_deg + 0.5 ) ) );
-    _textHDG->setText( osgText::String( hdg_str, osgText::String::ENCODING_UTF8 ) );
+    if ( isChanged( &_textHDGValue, (int)( floor( hdg_deg + 0.5 ) ) ) )
+    {
+        char hdg_str[16] = { "" };
+        sprintf( hdg_str, "%03d°", _textHDGValue );
+        _textHDG->setText( osgText::String( hdg_str, osgText::String::ENCODING_UTF8 ) );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
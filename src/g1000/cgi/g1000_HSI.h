@@ -75,6 +75,14 @@ private:
     osg::ref_ptr<osgText::Text> _textCRS;
     osg::ref_ptr<osgText::Text> _textHDG;
 
+    double _heading;       ///< [rad] displayed heading
+    double _selHeading;    ///< [rad] displayed selected heading
+    double _selCourse;     ///< [rad] displayed selected course
+
+    int _headingTextValue; ///< [deg] heading text value
+    int _textCRSValue;     ///< [deg] selected course text value
+    int _textHDGValue;     ///< [deg] selected heading text value
+
     void createAircraftSymbol();
     void createBoxCRS();
     void createBoxHDG();
@@ -22,6 +22,8 @@
 
 #include <g1000/cgi/g1000_Models.h>
 
+#include <mutex>
+
 #include <osgDB/ReadFile>
 
 #include <g1000/g1000_Log.h>
@@ -33,8 +35,19 @@ using namespace g1000;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+std::mutex modelsMutex;     ///< models list mutex, displays might be created by different threads
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 osg::Node* Models::get( const char *objectFile )
 {
+    std::lock_guard< std::mutex > lock( modelsMutex );
+
     for ( unsigned int i = 0; i < instance()->_fileNames.size(); i++ )
     {
         if ( objectFile == instance()->_fileNames.at( i ) )
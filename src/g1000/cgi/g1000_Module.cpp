@@ -22,6 +22,8 @@
 
 #include <g1000/cgi/g1000_Module.h>
 
+#include <cmath>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace g1000;
@@ -29,7 +31,8 @@ using namespace g1000;
 ////////////////////////////////////////////////////////////////////////////////
 
 Module::Module( IFD *ifd ) :
-    _ifd ( ifd )
+    _ifd ( ifd ),
+    _dirty ( true )
 {
     _root = new osg::Group();
 }
@@ -37,3 +40,29 @@ Module::Module( IFD *ifd ) :
 ////////////////////////////////////////////////////////////////////////////////
 
 Module::~Module() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Module::isChanged( double *value, double newValue, double resolution )
+{
+    if ( fabs( newValue - (*value) ) > resolution )
+    {
+        (*value) = newValue;
+        return true;
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Module::isChanged( int *value, int newValue )
+{
+    if ( newValue != (*value) )
+    {
+        (*value) = newValue;
+        return true;
+    }
+
+    return false;
+}
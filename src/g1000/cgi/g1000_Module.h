@@ -53,11 +53,35 @@ public:
     /** Returns module OSG root node.  */
     inline osg::Group* getNode() { return _root.get(); }
 
+    /** Returns true if module has changed on the last update. */
+    inline bool isDirty() const { return _dirty; }
+
 protected:
 
     const IFD *_ifd;                    ///< IFD object
 
     osg::ref_ptr<osg::Group> _root;     ///< OSG module root node
+
+    bool _dirty;                        ///< specifies if module has changed on the last update
+
+    /**
+     * Stores new value if it differs from the displayed one more than
+     * the display resolution.
+     * @param value displayed value
+     * @param newValue new value
+     * @param resolution display resolution
+     * @return true if value has changed
+     */
+    static bool isChanged( double *value, double newValue, double resolution );
+
+    /**
+     * Stores new displayed (quantized) value if it differs from the displayed
+     * one, so text is formatted and laid out only when it changes.
+     * @param value displayed value
+     * @param newValue new value
+     * @return true if value has changed
+     */
+    static bool isChanged( int *value, int newValue );
 };
 
 } // end of g1000 namespace
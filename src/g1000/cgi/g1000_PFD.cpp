@@ -116,6 +116,8 @@ PFD::~PFD()
 
 void PFD::update()
 {
+    if ( !_adi ) return;
+
     _adi  ->update();
     _afcs ->update();
     _alt  ->update();
@@ -123,6 +125,16 @@ void PFD::update()
     _hsi  ->update();
     _vsi  ->update();
     _wypt ->update();
+
+    // instruments skip scene graph updates when their inputs have not
+    // changed, display is redrawn only if any of them has changed
+    _dirty = _adi  ->isDirty()
+          || _afcs ->isDirty()
+          || _alt  ->isDirty()
+          || _asi  ->isDirty()
+          || _hsi  ->isDirty()
+          || _vsi  ->isDirty()
+          || _wypt ->isDirty();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
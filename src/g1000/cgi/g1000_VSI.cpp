@@ -22,6 +22,8 @@
 
 #include <g1000/cgi/g1000_VSI.h>
 
+#include <cfloat>
+#include <climits>
 #include <sstream>
 
 #include <osg/Geode>
@@ -58,7 +60,11 @@ const double VSI::_vs2pt = 0.014;
 ////////////////////////////////////////////////////////////////////////////////
 
 VSI::VSI( IFD *ifd ) :
-    Module( ifd )
+    Module( ifd ),
+    _climbRate    ( DBL_MAX ),
+    _selClimbRate ( DBL_MAX ),
+    _textVSValue     ( INT_MIN ),
+    _textSelectValue ( INT_MIN )
 {
     _pat = new osg::PositionAttitudeTransform();
     _root->addChild( _pat.get() );
@@ -89,15 +95,27 @@ void VSI::update()
     double vs_fpm = Units::mps2fpm( _ifd->gdc()->getClimbRate() );
     double select_fpm = Units::mps2fpm( _ifd->input().sel_climbRate );
 
-    char vs_str[16] = { "" };
+    bool changed = false;
+
+    changed = isChanged( &_climbRate    , vs_fpm     , G1000_RES_CLIMBRATE ) || changed;
+    changed = isChanged( &_selClimbRate , select_fpm , G1000_RES_CLIMBRATE ) || changed;
+
+    _dirty = changed;
+    if ( !changed ) return;
+
     int vs_int = 50 * floor( fabs( vs_fpm / 50.0 ) + 0.5 );
 
     //if ( vs_fpm < -2000.0 ) vs_int = -vs_int;
 
-    if ( vs_int != 0 )
-        sprintf( vs_str, "%d", vs_int );
+    if ( isChanged( &_textVSValue, vs_int ) )
+    {
+        char vs_str[16] = { "" };
 
-    _textVS->setText( vs_str );
+        if ( vs_int != 0 )
+            sprintf( vs_str, "%d", vs_int );
+
+        _textVS->setText( vs_str );
+    }
 
     //if ( climbRate_fpm < -2000.0 ) climbRate_fpm = -2000.0;
     //if ( climbRate_fpm >  2000.0 ) climbRate_fpm =  2000.0;
@@ -107,11 +125,13 @@ void VSI::update()
     _patPointer->setPosition( osg::Vec3( 0.0, dy_ptr, 0.0 ) );
     _patBug->setPosition( osg::Vec3( 0.0, dy_sel, 0.0 ) );
 
-    char sel_str[16] = { "" };
-    sprintf( sel_str, "%d", (int)select_fpm );
-
-    _textSelect->setText( sel_str );
+    if ( isChanged( &_textSelectValue, (int)select_fpm ) )
+    {
+        char sel_str[16] = { "" };
+        sprintf( sel_str, "%d", _textSelectValue );
 
+        _textSelect->setText( sel_str );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +74,12 @@ private:
     osg::ref_ptr<osgText::Text> _textVS;
     osg::ref_ptr<osgText::Text> _textSelect;
 
+    double _climbRate;       ///< [ft/min] displayed climb rate
+    double _selClimbRate;    ///< [ft/min] displayed selected climb rate
+
+    int _textVSValue;        ///< [ft/min] climb rate text value, 0 if blank
+    int _textSelectValue;    ///< [ft/min] selected climb rate text value
+
     void createBack();
     void createBoxSelect();
     void createBug();
@@ -49,7 +49,7 @@ WYPT::~WYPT() {}
 
 void WYPT::update()
 {
-
+    _dirty = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -16,6 +16,7 @@ HEADERS += \
     $$PWD/cgi/g1000_ASI.h \
     $$PWD/cgi/g1000_Colors.h \
     $$PWD/cgi/g1000_COM.h \
+    $$PWD/cgi/g1000_EFIS.h \
     $$PWD/cgi/g1000_Fonts.h \
     $$PWD/cgi/g1000_GDU.h \
     $$PWD/cgi/g1000_HSI.h \
@@ -33,6 +34,7 @@ SOURCES += \
     $$PWD/cgi/g1000_ASI.cpp \
     $$PWD/cgi/g1000_Colors.cpp \
     $$PWD/cgi/g1000_COM.cpp \
+    $$PWD/cgi/g1000_EFIS.cpp \
     $$PWD/cgi/g1000_Fonts.cpp \
     $$PWD/cgi/g1000_GDU.cpp \
     $$PWD/cgi/g1000_HSI.cpp \
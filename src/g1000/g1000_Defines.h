@@ -32,6 +32,27 @@
 
 #define G1000_GDU_FOV_V 30.0
 
+#define G1000_FONT_TEXTURE_SIZE 1024    ///< [px] shared glyph texture size
+
+////////////////////////////////////////////////////////////////////////////////
+
+// display resolution, smaller changes of instruments inputs are not displayed
+#define G1000_RES_ANGLE     1.0e-3  ///< [rad]
+#define G1000_RES_ALTITUDE  0.5     ///< [ft]
+#define G1000_RES_AIRSPEED  0.05    ///< [kts]
+#define G1000_RES_CLIMBRATE 1.0     ///< [ft/min]
+#define G1000_RES_PRESSURE  0.001   ///< [inHg]
+
+////////////////////////////////////////////////////////////////////////////////
+
+// LRUs update periods, zero means updating on every IFD update
+#define G1000_PERIOD_GIA 0.0    ///< [s] GIA 63  Integrated Avionics Unit
+#define G1000_PERIOD_GDC 0.05   ///< [s] GDC 74A Air Data Computer
+#define G1000_PERIOD_GEA 0.2    ///< [s] GEA 71  Engine/Airframe Unit
+#define G1000_PERIOD_GRS 0.0    ///< [s] GRS 77  Attitude and Heading Reference System
+#define G1000_PERIOD_GMU 0.1    ///< [s] GMU 44  Magnetometer
+#define G1000_PERIOD_GTX 1.0    ///< [s] GTX 33  Transponder
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifndef NULLPTR
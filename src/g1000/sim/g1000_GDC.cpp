@@ -50,10 +50,8 @@ GDC::~GDC() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GDC::update()
+void GDC::update( double timeStep )
 {
-    double timeStep = _ifd->timeStep();
-
     double airspeed_u_bas = _ifd->input().airspeed_u_bas;
 
     double air_pressure = _ifd->input().air_pressure;
@@ -46,8 +46,11 @@ public:
     /** Destructor. */
     virtual ~GDC();
 
-    /** Updates Air Data Computer. */
-    void update();
+    /**
+     * Updates Air Data Computer.
+     * @param timeStep [s] time elapsed since the last update
+     */
+    void update( double timeStep );
 
     inline double getAltitude()  const { return _altitude;  }
     inline double getClimbRate() const { return _climbRate; }
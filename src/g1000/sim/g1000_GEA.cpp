@@ -39,7 +39,7 @@ GEA::~GEA() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GEA::update()
+void GEA::update( double /*timeStep*/ )
 {
 
 }
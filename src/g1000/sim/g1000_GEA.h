@@ -46,8 +46,11 @@ public:
     /** Destructor. */
     virtual ~GEA();
 
-    /** Updates Engine/Airframe Unit. */
-    void update();
+    /**
+     * Updates Engine/Airframe Unit.
+     * @param timeStep [s] time elapsed since the last update
+     */
+    void update( double timeStep );
 
 private:
 
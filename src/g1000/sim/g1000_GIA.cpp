@@ -40,7 +40,7 @@ GIA::~GIA() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GIA::update()
+void GIA::update( double /*timeStep*/ )
 {
 
 }
@@ -46,8 +46,11 @@ public:
     /** Destructor. */
     virtual ~GIA();
 
-    /** Updates Integrated Avionics Unit. */
-    void update();
+    /**
+     * Updates Integrated Avionics Unit.
+     * @param timeStep [s] time elapsed since the last update
+     */
+    void update( double timeStep );
 
 private:
 
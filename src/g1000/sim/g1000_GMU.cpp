@@ -39,7 +39,7 @@ GMU::~GMU() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GMU::update()
+void GMU::update( double /*timeStep*/ )
 {
 
 }
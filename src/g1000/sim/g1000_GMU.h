@@ -46,8 +46,11 @@ public:
     /** Destructor. */
     virtual ~GMU();
 
-    /** Updates Magnetometer Unit. */
-    void update();
+    /**
+     * Updates Magnetometer Unit.
+     * @param timeStep [s] time elapsed since the last update
+     */
+    void update( double timeStep );
 
 private:
 
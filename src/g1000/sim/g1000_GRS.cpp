@@ -47,7 +47,7 @@ GRS::~GRS() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GRS::update()
+void GRS::update( double /*timeStep*/ )
 {
     double roll    = _ifd->input().roll;
     double pitch   = _ifd->input().pitch;
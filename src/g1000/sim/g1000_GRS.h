@@ -46,8 +46,11 @@ public:
     /** Destructor. */
     virtual ~GRS();
 
-    /** Updates AHRS. */
-    void update();
+    /**
+     * Updates AHRS.
+     * @param timeStep [s] time elapsed since the last update
+     */
+    void update( double timeStep );
 
     inline double getRoll()    const { return _roll;    }
     inline double getPitch()   const { return _pitch;   }
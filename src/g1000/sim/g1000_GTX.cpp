@@ -39,7 +39,7 @@ GTX::~GTX() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GTX::update()
+void GTX::update( double /*timeStep*/ )
 {
 
 }
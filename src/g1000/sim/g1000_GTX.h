@@ -46,8 +46,11 @@ public:
     /** Destructor. */
     virtual ~GTX();
 
-    /** Updates Transponder. */
-    void update();
+    /**
+     * Updates Transponder.
+     * @param timeStep [s] time elapsed since the last update
+     */
+    void update( double timeStep );
 
 private:
 
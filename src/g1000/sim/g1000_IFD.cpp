@@ -22,7 +22,7 @@
 
 #include <g1000/sim/g1000_IFD.h>
 
-#include <cstring>
+#include <fdm/utils/fdm_Profiler.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -30,9 +30,27 @@ using namespace g1000;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const Input inputDefault = Input();     ///< zero input used before the first update
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 IFD::IFD() :
     _timeStep ( 0.0 ),
 
+    _input ( &inputDefault ),
+
+    _sched_gia ( G1000_PERIOD_GIA ),
+    _sched_gdc ( G1000_PERIOD_GDC ),
+    _sched_gea ( G1000_PERIOD_GEA ),
+    _sched_grs ( G1000_PERIOD_GRS ),
+    _sched_gmu ( G1000_PERIOD_GMU ),
+    _sched_gtx ( G1000_PERIOD_GTX ),
+
     _gia_1 ( NULLPTR ),
     _gia_2 ( NULLPTR ),
 
@@ -42,8 +60,6 @@ IFD::IFD() :
     _gmu ( NULLPTR ),
     _gtx ( NULLPTR )
 {
-    memset( &_input, 0, sizeof(Input) );
-
     _gia_1 = new GIA( this, 0 );
     _gia_2 = new GIA( this, 1 );
 
@@ -72,16 +88,40 @@ IFD::~IFD()
 
 void IFD::update( double timeStep, const Input &input )
 {
+    FDM_PROFILE_FUNCTION();
+
     _timeStep = timeStep;
 
-    memcpy( &_input, &input, sizeof(Input) );
+    _input = &input;
+
+    double dt = 0.0;
+
+    if ( isDue( &_sched_gia, &dt ) )
+    {
+        _gia_1->update( dt );
+        _gia_2->update( dt );
+    }
+
+    if ( isDue( &_sched_gdc, &dt ) ) _gdc->update( dt );
+    if ( isDue( &_sched_gea, &dt ) ) _gea->update( dt );
+    if ( isDue( &_sched_grs, &dt ) ) _grs->update( dt );
+    if ( isDue( &_sched_gmu, &dt ) ) _gmu->update( dt );
+    if ( isDue( &_sched_gtx, &dt ) ) _gtx->update( dt );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool IFD::isDue( Schedule *schedule, double *timeStep )
+{
+    schedule->elapsed += _timeStep;
+
+    if ( schedule->elapsed >= schedule->period )
+    {
+        *timeStep = schedule->elapsed;
+        schedule->elapsed = 0.0;
 
-    _gia_1->update();
-    _gia_2->update();
+        return true;
+    }
 
-    _gdc->update();
-    _gea->update();
-    _grs->update();
-    _gmu->update();
-    _gtx->update();
+    return false;
 }
@@ -51,10 +51,15 @@ public:
     /** Destructor. */
     virtual ~IFD();
 
-    /** Updates Integrated Flight Deck simulation. */
+    /**
+     * Updates Integrated Flight Deck simulation. LRUs are updated at their
+     * own rates, see G1000_PERIOD_* definitions.
+     * @param timeStep [s] time step
+     * @param input input data snapshot, has to remain valid until the next update
+     */
     void update( double timeStep, const Input &input );
 
-    inline const Input& input() const { return _input; }
+    inline const Input& input() const { return *_input; }
 
     inline double timeStep() const { return _timeStep; }
 
@@ -69,9 +74,25 @@ public:
 
 private:
 
+    /** LRU update schedule. */
+    struct Schedule
+    {
+        double period;      ///< [s] update period
+        double elapsed;     ///< [s] time elapsed since the last update
+
+        Schedule( double p ) : period ( p ), elapsed ( 0.0 ) {}
+    };
+
     double _timeStep;   ///< [s] time step
 
-    Input _input;       ///< input data
+    const Input *_input;    ///< input data snapshot
+
+    Schedule _sched_gia;    ///< GIA units update schedule
+    Schedule _sched_gdc;    ///< GDC update schedule
+    Schedule _sched_gea;    ///< GEA update schedule
+    Schedule _sched_grs;    ///< GRS update schedule
+    Schedule _sched_gmu;    ///< GMU update schedule
+    Schedule _sched_gtx;    ///< GTX update schedule
 
     GIA *_gia_1;        ///< GIA 63  Integrated Avionics Unit No. 1
     GIA *_gia_2;        ///< GIA 63  Integrated Avionics Unit No. 2
@@ -81,6 +102,14 @@ private:
     GRS *_grs;          ///< GRS 77  Attitude and Heading Reference System
     GMU *_gmu;          ///< GMU 44  Magnetometer
     GTX *_gtx;          ///< GTX 33  Transponder
+
+    /**
+     * Accumulates time step and checks if unit is due to be updated.
+     * @param schedule unit update schedule
+     * @param timeStep [s] on return, time elapsed since the unit last update
+     * @return true if unit is due to be updated
+     */
+    bool isDue( Schedule *schedule, double *timeStep );
 };
 
 } // end of g1000 namespace
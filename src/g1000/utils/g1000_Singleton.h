@@ -39,28 +39,16 @@ class Singleton
 {
 public:
 
-    /** */
+    /** Returns instance, initialization is thread-safe. */
     static TYPE* instance()
     {
-        if ( !_instance )
-        {
-            _instance = new TYPE();
-        }
-
-        return _instance;
+        static TYPE *instance = new TYPE();
+        return instance;
     }
-
-private:
-
-    static TYPE *_instance;    ///<
 };
 
 } // end of g1000 namespace
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template < class TYPE > TYPE* g1000::Singleton< TYPE >::_instance = NULLPTR;
-
-////////////////////////////////////////////////////////////////////////////////
-
 #endif // G1000_SINGLETON_H
@@ -32,8 +32,252 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Aircrafts::Aircrafts()
+namespace
 {
+
+void writeAxis( QDataStream &stream, const Aircrafts::Axis &axis )
+{
+    stream << axis.curvature << axis.deadzone << axis.scale;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void readAxis( QDataStream &stream, Aircrafts::Axis &axis )
+{
+    stream >> axis.curvature >> axis.deadzone >> axis.scale;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void writeMass( QDataStream &stream, const Aircrafts::Masses::Mass &mass )
+{
+    stream << mass.enabled << mass.name << mass.max << mass.def;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void readMass( QDataStream &stream, Aircrafts::Masses::Mass &mass )
+{
+    stream >> mass.enabled >> mass.name >> mass.max >> mass.def;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Writes aircraft details, all but the catalog index data. */
+void writeAircraft( QDataStream &stream, const Aircrafts::Aircraft &aircraft )
+{
+    stream << aircraft.distance_def << aircraft.distance_min;
+    stream << aircraft.offset_x << aircraft.offset_y << aircraft.offset_z;
+    stream << aircraft.vfe << aircraft.vne;
+
+    writeAxis( stream, aircraft.axes.roll  );
+    writeAxis( stream, aircraft.axes.pitch );
+    writeAxis( stream, aircraft.axes.yaw   );
+
+    const Aircrafts::Controls &controls = aircraft.controls;
+
+    stream << controls.collective << controls.landingGear << controls.flaps;
+    stream << (qint32)controls.throttle << (qint32)controls.propeller << (qint32)controls.mixture;
+    stream << controls.airbrake << controls.spoilers;
+    stream << controls.notches;
+
+    const Aircrafts::Propulsion &propulsion = aircraft.propulsion;
+
+    stream << (qint32)propulsion.engines;
+    stream << propulsion.ab  << propulsion.rpm << propulsion.prop << propulsion.ng
+           << propulsion.n1  << propulsion.n2  << propulsion.trq  << propulsion.epr
+           << propulsion.map << propulsion.egt << propulsion.cht  << propulsion.tit
+           << propulsion.tot << propulsion.itt;
+
+    const Aircrafts::Masses &masses = aircraft.masses;
+
+    stream << masses.empty << masses.mtow;
+
+    writeMass( stream, masses.pilot_1 );
+    writeMass( stream, masses.pilot_2 );
+    writeMass( stream, masses.fuel_tank_1 );
+    writeMass( stream, masses.fuel_tank_2 );
+    writeMass( stream, masses.fuel_tank_3 );
+    writeMass( stream, masses.fuel_tank_4 );
+    writeMass( stream, masses.fuel_tank_5 );
+    writeMass( stream, masses.fuel_tank_6 );
+    writeMass( stream, masses.fuel_tank_7 );
+    writeMass( stream, masses.fuel_tank_8 );
+    writeMass( stream, masses.cabin );
+    writeMass( stream, masses.trunk );
+    writeMass( stream, masses.slung );
+
+    stream << aircraft.mainRotorCoef << aircraft.tailRotorCoef;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Reads aircraft details, all but the catalog index data. */
+void readAircraft( QDataStream &stream, Aircrafts::Aircraft &aircraft )
+{
+    stream >> aircraft.distance_def >> aircraft.distance_min;
+    stream >> aircraft.offset_x >> aircraft.offset_y >> aircraft.offset_z;
+    stream >> aircraft.vfe >> aircraft.vne;
+
+    readAxis( stream, aircraft.axes.roll  );
+    readAxis( stream, aircraft.axes.pitch );
+    readAxis( stream, aircraft.axes.yaw   );
+
+    Aircrafts::Controls &controls = aircraft.controls;
+
+    qint32 throttle  = 0;
+    qint32 propeller = 0;
+    qint32 mixture   = 0;
+
+    stream >> controls.collective >> controls.landingGear >> controls.flaps;
+    stream >> throttle >> propeller >> mixture;
+    stream >> controls.airbrake >> controls.spoilers;
+    stream >> controls.notches;
+
+    controls.throttle  = throttle;
+    controls.propeller = propeller;
+    controls.mixture   = mixture;
+
+    Aircrafts::Propulsion &propulsion = aircraft.propulsion;
+
+    qint32 engines = 0;
+
+    stream >> engines;
+    stream >> propulsion.ab  >> propulsion.rpm >> propulsion.prop >> propulsion.ng
+           >> propulsion.n1  >> propulsion.n2  >> propulsion.trq  >> propulsion.epr
+           >> propulsion.map >> propulsion.egt >> propulsion.cht  >> propulsion.tit
+           >> propulsion.tot >> propulsion.itt;
+
+    propulsion.engines = engines;
+
+    Aircrafts::Masses &masses = aircraft.masses;
+
+    stream >> masses.empty >> masses.mtow;
+
+    readMass( stream, masses.pilot_1 );
+    readMass( stream, masses.pilot_2 );
+    readMass( stream, masses.fuel_tank_1 );
+    readMass( stream, masses.fuel_tank_2 );
+    readMass( stream, masses.fuel_tank_3 );
+    readMass( stream, masses.fuel_tank_4 );
+    readMass( stream, masses.fuel_tank_5 );
+    readMass( stream, masses.fuel_tank_6 );
+    readMass( stream, masses.fuel_tank_7 );
+    readMass( stream, masses.fuel_tank_8 );
+    readMass( stream, masses.cabin );
+    readMass( stream, masses.trunk );
+    readMass( stream, masses.slung );
+
+    stream >> aircraft.mainRotorCoef >> aircraft.tailRotorCoef;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+Aircrafts::Aircrafts() :
+    _cache ( NULLPTR )
+{
+    _cache = new CatalogCache( Path::get( "gui/aircrafts.xml" ).c_str() );
+
+    if ( !readCache() )
+    {
+        readFile();
+        writeCache();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Aircrafts::~Aircrafts()
+{
+    DELPTR( _cache );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Aircrafts::Aircraft Aircrafts::getAircraft( int index )
+{
+    if ( _details.at( index ) >= 0 && !readDetails( index ) )
+    {
+        // broken cache, whole catalog is parsed again
+        _cache->close();
+        readFile();
+    }
+
+    return _aircrafts.at( index );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Aircrafts::readCache()
+{
+    QByteArray index;
+
+    if ( !_cache->open( &index ) ) return false;
+
+    QDataStream stream( index );
+    CatalogCache::setup( &stream );
+
+    qint32 count = 0;
+
+    stream >> count;
+
+    for ( int i = 0; i < count && stream.status() == QDataStream::Ok; i++ )
+    {
+        Aircraft aircraft;
+
+        qint32 type   = 0;
+        qint64 offset = 0;
+
+        stream >> aircraft.name >> type >> aircraft.file >> offset;
+
+        aircraft.type = type;
+
+        _aircrafts.push_back( aircraft );
+        _details.push_back( offset );
+    }
+
+    if ( stream.status() != QDataStream::Ok )
+    {
+        _aircrafts.clear();
+        _details.clear();
+
+        _cache->close();
+
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Aircrafts::readDetails( int index )
+{
+    QDataStream *stream = _cache->seek( _details.at( index ) );
+
+    if ( stream )
+    {
+        readAircraft( *stream, _aircrafts[ index ] );
+
+        if ( stream->status() == QDataStream::Ok )
+        {
+            _details[ index ] = -1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Aircrafts::readFile()
+{
+    _aircrafts.clear();
+    _details.clear();
+
     QFile file( Path::get( "gui/aircrafts.xml" ).c_str() );
 
     if ( file.open(QFile::ReadOnly | QFile::Text) )
@@ -55,11 +299,39 @@ Aircrafts::Aircrafts()
             }
         }
     }
+
+    // parsed aircrafts details are already read
+    _details.fill( -1, _aircrafts.size() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Aircrafts::~Aircrafts() {}
+void Aircrafts::writeCache()
+{
+    QByteArray index;
+    QByteArray details;
+
+    QDataStream streamIndex( &index, QIODevice::WriteOnly );
+    QDataStream streamDetails( &details, QIODevice::WriteOnly );
+
+    CatalogCache::setup( &streamIndex );
+    CatalogCache::setup( &streamDetails );
+
+    streamIndex << (qint32)_aircrafts.size();
+
+    for ( int i = 0; i < _aircrafts.size(); i++ )
+    {
+        const Aircraft &aircraft = _aircrafts.at( i );
+
+        streamIndex << aircraft.name << (qint32)aircraft.type << aircraft.file
+                    << (qint64)streamDetails.device()->pos();
+
+        writeAircraft( streamDetails, aircraft );
+    }
+
+    // data directory might be read-only, catalog is parsed every time then
+    _cache->write( index, details );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
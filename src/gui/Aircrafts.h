@@ -30,10 +30,20 @@
 
 #include <sim/Singleton.h>
 
+#include <gui/CatalogCache.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
  * @brief Aircrafts class.
+ *
+ * Aircrafts catalog is read from the binary cache, if it is up to date, and
+ * only catalog index (names, types and files) is read at startup. Aircraft
+ * details are read from the cache lazily, when the aircraft is requested
+ * for the first time. Catalog XML file is parsed only if there is no valid
+ * cache, which is then written.
+ *
+ * @see CatalogCache
  */
 class Aircrafts : public Singleton< Aircrafts >
 {
@@ -154,9 +164,16 @@ public:
     /** @brief Destructor. */
     virtual ~Aircrafts();
 
-    inline Aircraft getAircraft( int index ) const
+    /**
+     * @brief Returns aircraft data, reads aircraft details if necessary.
+     * @param index aircraft index
+     * @return aircraft data
+     */
+    Aircraft getAircraft( int index );
+
+    inline QString getName( int index ) const
     {
-        return _aircrafts.at( index );
+        return _aircrafts.at( index ).name;
     }
 
     inline int getCount() const { return _aircrafts.size(); }
@@ -164,6 +181,9 @@ public:
 private:
 
     QVector< Aircraft > _aircrafts;     ///<
+    QVector< qint64 > _details;         ///< aircrafts details offsets in the cache, negative if already read
+
+    CatalogCache *_cache;               ///< catalog binary cache
 
     /**
      * You should use static function instance() due to get refernce
@@ -174,6 +194,11 @@ private:
     /** Using this constructor is forbidden. */
     Aircrafts( const Aircrafts & ) {}
 
+    bool readCache();
+    bool readDetails( int index );
+    void readFile();
+    void writeCache();
+
     void parseAircraft( const QDomElement &node );
     void parseAircraftAxes( const QDomElement &node, Axes &axes );
     void parseAircraftAxis( const QDomElement &node, Axis &axis );
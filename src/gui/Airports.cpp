@@ -32,8 +32,146 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Airports::Airports()
+namespace
 {
+
+void writeLocation( QDataStream &stream, const Airports::Location &location )
+{
+    stream << location.name;
+    stream << location.lat << location.lon << location.alt << location.hdg;
+    stream << location.elev << location.slope;
+    stream << location.runway;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void readLocation( QDataStream &stream, Airports::Location &location )
+{
+    stream >> location.name;
+    stream >> location.lat >> location.lon >> location.alt >> location.hdg;
+    stream >> location.elev >> location.slope;
+    stream >> location.runway;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+Airports::Airports() :
+    _cache ( NULLPTR )
+{
+    _cache = new CatalogCache( Path::get( "gui/airports.xml" ).c_str() );
+
+    if ( !readCache() )
+    {
+        readFile();
+        writeCache();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Airports::~Airports()
+{
+    DELPTR( _cache );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Airports::Airport Airports::getAirport( int index )
+{
+    if ( _details.at( index ) >= 0 && !readDetails( index ) )
+    {
+        // broken cache, whole catalog is parsed again
+        _cache->close();
+        readFile();
+    }
+
+    return _airports.at( index );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Airports::readCache()
+{
+    QByteArray index;
+
+    if ( !_cache->open( &index ) ) return false;
+
+    QDataStream stream( index );
+    CatalogCache::setup( &stream );
+
+    readLocation( stream, _default );
+
+    qint32 count = 0;
+
+    stream >> count;
+
+    for ( int i = 0; i < count && stream.status() == QDataStream::Ok; i++ )
+    {
+        Airport airport;
+
+        qint64 offset = 0;
+
+        stream >> airport.name >> offset;
+
+        _airports.push_back( airport );
+        _details.push_back( offset );
+    }
+
+    if ( stream.status() != QDataStream::Ok )
+    {
+        _airports.clear();
+        _details.clear();
+
+        _cache->close();
+
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Airports::readDetails( int index )
+{
+    QDataStream *stream = _cache->seek( _details.at( index ) );
+
+    if ( stream )
+    {
+        Airport &airport = _airports[ index ];
+
+        qint32 count = 0;
+
+        (*stream) >> count;
+
+        airport.locations.clear();
+
+        for ( int i = 0; i < count && stream->status() == QDataStream::Ok; i++ )
+        {
+            Location location;
+            readLocation( *stream, location );
+            airport.locations.push_back( location );
+        }
+
+        if ( stream->status() == QDataStream::Ok )
+        {
+            _details[ index ] = -1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Airports::readFile()
+{
+    _airports.clear();
+    _details.clear();
+
     _default.name   = "";
     _default.lat    = 0.0;
     _default.lon    = 0.0;
@@ -64,11 +202,45 @@ Airports::Airports()
             }
         }
     }
+
+    // parsed airports locations are already read
+    _details.fill( -1, _airports.size() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Airports::~Airports() {}
+void Airports::writeCache()
+{
+    QByteArray index;
+    QByteArray details;
+
+    QDataStream streamIndex( &index, QIODevice::WriteOnly );
+    QDataStream streamDetails( &details, QIODevice::WriteOnly );
+
+    CatalogCache::setup( &streamIndex );
+    CatalogCache::setup( &streamDetails );
+
+    writeLocation( streamIndex, _default );
+
+    streamIndex << (qint32)_airports.size();
+
+    for ( int i = 0; i < _airports.size(); i++ )
+    {
+        const Airport &airport = _airports.at( i );
+
+        streamIndex << airport.name << (qint64)streamDetails.device()->pos();
+
+        streamDetails << (qint32)airport.locations.size();
+
+        for ( int j = 0; j < airport.locations.size(); j++ )
+        {
+            writeLocation( streamDetails, airport.locations.at( j ) );
+        }
+    }
+
+    // data directory might be read-only, catalog is parsed every time then
+    _cache->write( index, details );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -29,10 +29,19 @@
 
 #include <sim/Singleton.h>
 
+#include <gui/CatalogCache.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
  * @brief Airports class.
+ *
+ * Airports catalog is read from the binary cache, if it is up to date, and
+ * only airports names and the default location are read at startup. Airport
+ * locations are read from the cache lazily, when the airport is requested
+ * for the first time.
+ *
+ * @see CatalogCache
  */
 class Airports : public Singleton< Airports >
 {
@@ -66,9 +75,16 @@ public:
     /** @brief Destructor. */
     virtual ~Airports();
 
-    inline Airport getAirport( int index ) const
+    /**
+     * @brief Returns airport data, reads airport locations if necessary.
+     * @param index airport index
+     * @return airport data
+     */
+    Airport getAirport( int index );
+
+    inline QString getName( int index ) const
     {
-        return _airports.at( index );
+        return _airports.at( index ).name;
     }
 
     inline int getCount() const { return _airports.size(); }
@@ -79,8 +95,12 @@ private:
 
     QVector< Airport > _airports;       ///< airports
 
+    QVector< qint64 > _details;         ///< airports locations offsets in the cache, negative if already read
+
     Location _default;                  ///< default location
 
+    CatalogCache *_cache;               ///< catalog binary cache
+
     /**
      * You should use static function instance() due to get refernce
      * to Airports class instance.
@@ -90,6 +110,11 @@ private:
     /** Using this constructor is forbidden. */
     Airports( const Airports & ) {}
 
+    bool readCache();
+    bool readDetails( int index );
+    void readFile();
+    void writeCache();
+
     void parseAirport( QDomElement &node );
     void parseLocation( QDomElement &node, Airport &airport );
 };
@@ -0,0 +1,148 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <gui/CatalogCache.h>
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <gui/gui_Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+const quint32 CatalogCache::_magic   = 0x4d434154; // "MCAT"
+const quint32 CatalogCache::_version = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+
+CatalogCache::CatalogCache( const QString &xmlFile ) :
+    _xmlFile ( xmlFile ),
+    _file ( xmlFile + ".cache" ),
+    _base ( 0 ),
+    _xmlTime ( 0 ),
+    _xmlSize ( 0 )
+{
+    QFileInfo info( _xmlFile );
+
+    _xmlTime = info.lastModified().toMSecsSinceEpoch();
+    _xmlSize = info.size();
+
+    setup( &_stream );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+CatalogCache::~CatalogCache()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CatalogCache::open( QByteArray *index )
+{
+    close();
+
+    if ( !_file.open( QFile::ReadOnly ) ) return false;
+
+    _stream.setDevice( &_file );
+
+    quint32 magic   = 0;
+    quint32 version = 0;
+    qint64  xmlTime = 0;
+    qint64  xmlSize = 0;
+
+    _stream >> magic >> version >> xmlTime >> xmlSize;
+
+    if ( _stream.status() == QDataStream::Ok
+      && magic   == _magic
+      && version == _version
+      && xmlTime == _xmlTime
+      && xmlSize == _xmlSize )
+    {
+        _stream >> (*index);
+
+        if ( _stream.status() == QDataStream::Ok )
+        {
+            _base = _file.pos();
+            return true;
+        }
+    }
+
+    close();
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QDataStream* CatalogCache::seek( qint64 offset )
+{
+    if ( !_file.isOpen() || !_file.seek( _base + offset ) ) return NULLPTR;
+
+    _stream.resetStatus();
+
+    return &_stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CatalogCache::write( const QByteArray &index, const QByteArray &details )
+{
+    close();
+
+    // other instances never read a partially written cache file
+    QSaveFile file( _file.fileName() );
+
+    if ( !file.open( QFile::WriteOnly ) ) return false;
+
+    QDataStream stream( &file );
+    setup( &stream );
+
+    stream << _magic << _version << _xmlTime << _xmlSize;
+    stream << index;
+
+    file.write( details );
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CatalogCache::close()
+{
+    _stream.setDevice( NULLPTR );
+
+    if ( _file.isOpen() ) _file.close();
+
+    _base = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CatalogCache::setup( QDataStream *stream )
+{
+    stream->setVersion( QDataStream::Qt_5_0 );
+    stream->setByteOrder( QDataStream::LittleEndian );
+    stream->setFloatingPointPrecision( QDataStream::DoublePrecision );
+}
@@ -0,0 +1,110 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CATALOGCACHE_H
+#define CATALOGCACHE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QString>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief GUI catalog binary cache class.
+ *
+ * Catalog cache is stored next to the XML file ("file_name.cache") and
+ * consists of a header, catalog index and entries details. Header holds
+ * the XML file modification time and size, so cache is considered stale
+ * and is rewritten as soon as the XML file changes. Index is read at once,
+ * while cache file is kept open so entries details can be read lazily,
+ * each one only when it is needed. Details offsets are relative to the end
+ * of the index.
+ */
+class CatalogCache
+{
+public:
+
+    static const quint32 _magic;        ///< cache file magic number
+    static const quint32 _version;      ///< cache file format version
+
+    /**
+     * @brief Constructor.
+     * @param xmlFile catalog XML file path
+     */
+    CatalogCache( const QString &xmlFile );
+
+    /** @brief Destructor. */
+    virtual ~CatalogCache();
+
+    /**
+     * @brief Opens cache file and reads catalog index.
+     * @param index catalog index
+     * @return true if cache file is up to date with the XML file, false otherwise
+     */
+    bool open( QByteArray *index );
+
+    /**
+     * @brief Returns stream positioned at the entry details.
+     * @param offset entry details offset
+     * @return stream or null pointer if cache file is not open
+     */
+    QDataStream* seek( qint64 offset );
+
+    /**
+     * @brief Writes cache file. Open cache file is closed.
+     * @param index catalog index
+     * @param details entries details
+     * @return true on success, false on failure
+     */
+    bool write( const QByteArray &index, const QByteArray &details );
+
+    /** @brief Closes cache file. */
+    void close();
+
+    /**
+     * @brief Sets stream common properties.
+     * @param stream stream
+     */
+    static void setup( QDataStream *stream );
+
+private:
+
+    QString _xmlFile;           ///< catalog XML file path
+    QFile   _file;              ///< cache file
+
+    QDataStream _stream;        ///< cache file stream
+
+    qint64 _base;               ///< details base position
+
+    qint64 _xmlTime;            ///< [ms] XML file modification time
+    qint64 _xmlSize;            ///< XML file size
+
+    /** Using this constructor is forbidden. */
+    CatalogCache( const CatalogCache & ) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CATALOGCACHE_H
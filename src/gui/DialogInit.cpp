@@ -56,12 +56,12 @@ DialogInit::DialogInit( QWidget *parent ) :
 
     for ( int i = 0; i < Aircrafts::instance()->getCount(); i++ )
     {
-        _ui->comboAircrafts->addItem( QIcon(), Aircrafts::instance()->getAircraft( i ).name );
+        _ui->comboAircrafts->addItem( QIcon(), Aircrafts::instance()->getName( i ) );
     }
 
     for ( int i = 0; i < Airports::instance()->getCount(); i++ )
     {
-        _ui->comboAirports->addItem( QIcon(), Airports::instance()->getAirport( i ).name );
+        _ui->comboAirports->addItem( QIcon(), Airports::instance()->getName( i ) );
     }
 
     _ui->comboAirports->setCurrentIndex( -1 );
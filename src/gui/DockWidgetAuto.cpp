@@ -194,7 +194,7 @@ void DockWidgetAuto::updateIdle()
 
 void DockWidgetAuto::updateWork()
 {
-    _ap->update( GUI_TIME_STEP, _ui->pushButtonDN->isDown(), _ui->pushButtonUP->isDown() );
+    _ap->setButtons( _ui->pushButtonDN->isDown(), _ui->pushButtonUP->isDown() );
 
     _ui->spinBoxALT_VS->setReadOnly( _ap->isInited() );
 
@@ -29,6 +29,26 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const double resAltitude = 0.1;     ///< [m]     displayed altitudes resolution
+const double resSpeed    = 0.01;    ///< [m/s]   displayed speeds resolution
+const double resMachNo   = 0.001;   ///< [-]     displayed Mach number resolution
+const double resAngle    = 1.0e-4;  ///< [rad]   displayed angles resolution
+const double resRate     = 1.0e-4;  ///< [rad/s] displayed angular rates resolution
+const double resGForce   = 0.001;   ///< [-]     displayed G-Force resolution
+
+/** Returns true if value differs from the displayed one more than resolution. */
+inline bool isChanged( double value, double displayed, double resolution )
+{
+    return fabs( value - displayed ) > resolution;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 DockWidgetData::DockWidgetData( QWidget *parent ) :
     QDockWidget ( parent ),
     _ui ( new Ui::DockWidgetData )
@@ -57,6 +77,7 @@ void DockWidgetData::reset()
     _altitude_agl = 0.0;
 
     _airspeed   = 0.0;
+    _ias        = 0.0;
     _climbRate  = 0.0;
     _machNumber = 0.0;
 
@@ -85,6 +106,7 @@ void DockWidgetData::reset()
     setAltitudeASL( _altitude_asl );
     setAltitudeAGL( _altitude_agl );
     setAirspeed( _airspeed );
+    setIAS( _ias );
     setClimbRate( _climbRate );
     setMachNumber( _machNumber );
     setRollAngle( _rollAngle );
@@ -102,6 +124,43 @@ void DockWidgetData::reset()
     setGy( _Gy );
     setGz( _Gz );
     _ui->spinMaxGz->setValue( _ui->comboMaxGz->convert( _maxGz ) );
+
+    _timer.invalidate();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DockWidgetData::setSnapshot( const Snapshot &snapshot )
+{
+    if ( _timer.isValid() && _timer.elapsed() < 1000.0 * GUI_DOCK_TIME_STEP ) return;
+
+    _timer.start();
+
+    if ( isChanged( snapshot.altitude_asl , _altitude_asl , resAltitude ) ) setAltitudeASL ( snapshot.altitude_asl );
+    if ( isChanged( snapshot.altitude_agl , _altitude_agl , resAltitude ) ) setAltitudeAGL ( snapshot.altitude_agl );
+
+    if ( isChanged( snapshot.airspeed   , _airspeed   , resSpeed  ) ) setAirspeed   ( snapshot.airspeed   );
+    if ( isChanged( snapshot.ias        , _ias        , resSpeed  ) ) setIAS        ( snapshot.ias        );
+    if ( isChanged( snapshot.climbRate  , _climbRate  , resSpeed  ) ) setClimbRate  ( snapshot.climbRate  );
+    if ( isChanged( snapshot.machNumber , _machNumber , resMachNo ) ) setMachNumber ( snapshot.machNumber );
+
+    if ( isChanged( snapshot.rollAngle  , _rollAngle  , resAngle ) ) setRollAngle  ( snapshot.rollAngle  );
+    if ( isChanged( snapshot.pitchAngle , _pitchAngle , resAngle ) ) setPitchAngle ( snapshot.pitchAngle );
+    if ( isChanged( snapshot.heading    , _heading    , resAngle ) ) setHeading    ( snapshot.heading    );
+
+    if ( isChanged( snapshot.angleOfAttack , _angleOfAttack , resAngle ) ) setAngleOfAttack ( snapshot.angleOfAttack );
+    if ( isChanged( snapshot.sideslipAngle , _sideslipAngle , resAngle ) ) setSideslipAngle ( snapshot.sideslipAngle );
+    if ( isChanged( snapshot.climbAngle    , _climbAngle    , resAngle ) ) setClimbAngle    ( snapshot.climbAngle    );
+    if ( isChanged( snapshot.trackAngle    , _trackAngle    , resAngle ) ) setTrackAngle    ( snapshot.trackAngle    );
+
+    if ( isChanged( snapshot.rollRate  , _rollRate  , resRate ) ) setRollRate  ( snapshot.rollRate  );
+    if ( isChanged( snapshot.pitchRate , _pitchRate , resRate ) ) setPitchRate ( snapshot.pitchRate );
+    if ( isChanged( snapshot.yawRate   , _yawRate   , resRate ) ) setYawRate   ( snapshot.yawRate   );
+    if ( isChanged( snapshot.turnRate  , _turnRate  , resRate ) ) setTurnRate  ( snapshot.turnRate  );
+
+    if ( isChanged( snapshot.Gx , _Gx , resGForce ) ) setGx( snapshot.Gx );
+    if ( isChanged( snapshot.Gy , _Gy , resGForce ) ) setGy( snapshot.Gy );
+    if ( isChanged( snapshot.Gz , _Gz , resGForce ) ) setGz( snapshot.Gz );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <QDockWidget>
+#include <QElapsedTimer>
 #include <QSettings>
 
 #include <Defines.h>
@@ -47,6 +48,36 @@ class DockWidgetData : public QDockWidget
 
 public:
 
+    /** Flight data snapshot. */
+    struct Snapshot
+    {
+        double altitude_asl;        ///< [m] altitude above sea level
+        double altitude_agl;        ///< [m] altitude above ground level
+
+        double airspeed;            ///< [m/s] airspeed
+        double ias;                 ///< [m/s] indicated airspeed
+        double climbRate;           ///< [m/s] climb rate
+        double machNumber;          ///< [-] Mach number
+
+        double rollAngle;           ///< [rad] roll angle
+        double pitchAngle;          ///< [rad] pitch angle
+        double heading;             ///< [rad] true heading
+
+        double angleOfAttack;       ///< [rad] angle of attack
+        double sideslipAngle;       ///< [rad] angle of sideslip
+        double climbAngle;          ///< [rad] climb angle
+        double trackAngle;          ///< [rad] track angle
+
+        double rollRate;            ///< [rad/s] roll rate
+        double pitchRate;           ///< [rad/s] pitch rate
+        double yawRate;             ///< [rad/s] yaw rate
+        double turnRate;            ///< [rad/s] turn rate
+
+        double Gx;                  ///< [-] X component of G-Force vector expressed in BAS
+        double Gy;                  ///< [-] Y component of G-Force vector expressed in BAS
+        double Gz;                  ///< [-] Z component of G-Force vector expressed in BAS
+    };
+
     /** @brief Constructor. */
     explicit DockWidgetData( QWidget *parent = NULLPTR );
 
@@ -56,6 +87,14 @@ public:
     /** */
     void reset();
 
+    /**
+     * @brief Updates all fields at once.
+     * Updates are throttled to GUI_DOCK_TIME_STEP and only fields which have
+     * changed more than their display resolution are refreshed.
+     * @param snapshot flight data snapshot
+     */
+    void setSnapshot( const Snapshot &snapshot );
+
     void setAltitudeASL( double altitude_asl );
     void setAltitudeAGL( double altitude_agl );
 
@@ -124,6 +163,8 @@ private:
     double _minGz;                  ///< [-]
     double _maxGz;                  ///< [-]
 
+    QElapsedTimer _timer;           ///< time since the last batched update
+
     void settingsRead();
     void settingsRead_Highlight( QSettings &settings );
     void settingsRead_UnitCombos( QSettings &settings );
@@ -23,6 +23,8 @@
 #include <gui/DockWidgetEFIS.h>
 #include <ui_DockWidgetEFIS.h>
 
+#include <gui/gui_Defines.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 DockWidgetEFIS::DockWidgetEFIS( QWidget *parent ) :
@@ -30,6 +32,12 @@ DockWidgetEFIS::DockWidgetEFIS( QWidget *parent ) :
     _ui ( new Ui::DockWidgetEFIS ),
     _graphicsEADI ( NULLPTR ),
     _graphicsEHSI ( NULLPTR )
+#   ifdef SIM_EFIS_OSG
+    ,
+    _widgetCGI ( NULLPTR ),
+    _efis ( NULLPTR ),
+    _timerId ( 0 )
+#   endif
 {
     _ui->setupUi( this );
 
@@ -42,17 +50,47 @@ DockWidgetEFIS::DockWidgetEFIS( QWidget *parent ) :
     _graphicsEHSI->setBearing( 0.0f, false );
     _graphicsEHSI->setDeviation( 0.0f, GraphicsEHSI::NONE );
     _graphicsEHSI->setDistance( 0.0f, false );
+
+#   ifdef SIM_EFIS_OSG
+    // hidden QGraphicsView instruments skip their updates
+    _ui->widgetEADI->setVisible( false );
+    _ui->widgetEHSI->setVisible( false );
+
+    _widgetCGI = new WidgetCGI( _ui->dockWidgetContents );
+    _widgetCGI->setSizePolicy( QSizePolicy::MinimumExpanding, QSizePolicy::MinimumExpanding );
+    _ui->gridLayout->addWidget( _widgetCGI, 0, 0, 1, 2 );
+#   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 DockWidgetEFIS::~DockWidgetEFIS()
 {
+#   ifdef SIM_EFIS_OSG
+    if ( _timerId ) killTimer( _timerId );
+
+    DELPTR( _efis );
+#   endif
+
     DELPTR( _ui );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void DockWidgetEFIS::init( g1000::IFD *ifd )
+{
+#   ifdef SIM_EFIS_OSG
+    if ( _efis ) return;
+
+    _efis = new g1000::EFIS( ifd );
+    _widgetCGI->setSceneData( _efis->getRoot() );
+
+    _timerId = startTimer( 1000.0 * GUI_EFIS_TIME_STEP );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void DockWidgetEFIS::closeEvent( QCloseEvent *event )
 {
     /////////////////////////////////
@@ -61,3 +99,24 @@ void DockWidgetEFIS::closeEvent( QCloseEvent *event )
 
     emit closed();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef SIM_EFIS_OSG
+void DockWidgetEFIS::timerEvent( QTimerEvent *event )
+{
+    /////////////////////////////////
+    QDockWidget::timerEvent( event );
+    /////////////////////////////////
+
+    if ( isVisible() )
+    {
+        _efis->update();
+
+        if ( _efis->isDirty() )
+        {
+            _widgetCGI->update();
+        }
+    }
+}
+#endif
@@ -28,9 +28,16 @@
 
 #include <Defines.h>
 
+#include <g1000/sim/g1000_IFD.h>
+
 #include <gui/GraphicsEADI.h>
 #include <gui/GraphicsEHSI.h>
 
+#ifdef SIM_EFIS_OSG
+#   include <g1000/cgi/g1000_EFIS.h>
+#   include <gui/WidgetCGI.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace Ui
@@ -42,6 +49,10 @@ namespace Ui
 
 /**
  * @brief EFIS dock widget class.
+ *
+ * If SIM_EFIS_OSG is defined EADI and EHSI are replaced with G1000 ADI and
+ * HSI rendered with OSG and fed from the IFD, otherwise QGraphicsView based
+ * instruments fed by the setters are used.
  */
 class DockWidgetEFIS : public QDockWidget
 {
@@ -55,6 +66,12 @@ public:
     /** @brief Destructor. */
     virtual ~DockWidgetEFIS();
 
+    /**
+     * @brief Initializes OSG rendered EFIS, does nothing otherwise.
+     * @param ifd G1000 IFD object
+     */
+    void init( g1000::IFD *ifd );
+
     /** */
     inline void setFlightMode( GraphicsEADI::FlightMode flightMode )
     {
@@ -238,12 +255,24 @@ protected:
 
     void closeEvent( QCloseEvent *event );
 
+#   ifdef SIM_EFIS_OSG
+    /** */
+    void timerEvent( QTimerEvent *event );
+#   endif
+
 private:
 
     Ui::DockWidgetEFIS *_ui;        ///<
 
     GraphicsEADI *_graphicsEADI;    ///<
     GraphicsEHSI *_graphicsEHSI;    ///<
+
+#   ifdef SIM_EFIS_OSG
+    WidgetCGI *_widgetCGI;          ///< OSG EFIS view
+    g1000::EFIS *_efis;             ///< OSG EFIS display
+
+    int _timerId;                   ///<
+#   endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
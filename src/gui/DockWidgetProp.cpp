@@ -23,14 +23,55 @@
 #include <gui/DockWidgetProp.h>
 #include <ui_DockWidgetProp.h>
 
+#include <cmath>
+
 #include <gui/Aircrafts.h>
 #include <gui/gui_Defines.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const float resSpeed = 0.01f;       ///< [rad/s] displayed rotational speeds resolution
+const float resNorm  = 1.0e-4f;     ///< [-]     displayed normalized values resolution
+const float resEPR   = 0.001f;      ///< [-]     displayed EPR resolution
+const float resMAP   = 10.0f;       ///< [Pa]    displayed manifold pressure resolution
+const float resTemp  = 0.1f;        ///< [K]     displayed temperatures resolution
+const float resFF    = 1.0e-5f;     ///< [kg/s]  displayed fuel flow resolution
+
+/** Stores value if it differs from the displayed one more than resolution. */
+inline bool isChanged( float *displayed, float value, float resolution, bool force )
+{
+    if ( force || fabs( value - (*displayed) ) > resolution )
+    {
+        (*displayed) = value;
+        return true;
+    }
+
+    return false;
+}
+
+/** Stores value if it differs from the displayed one. */
+inline bool isChanged( bool *displayed, bool value, bool force )
+{
+    if ( force || value != (*displayed) )
+    {
+        (*displayed) = value;
+        return true;
+    }
+
+    return false;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 DockWidgetProp::DockWidgetProp( QWidget *parent ) :
     QDockWidget ( parent ),
-    _ui ( new Ui::DockWidgetProp )
+    _ui ( new Ui::DockWidgetProp ),
+    _displayedValid ( false )
 {
     _ui->setupUi( this );
 
@@ -123,6 +164,15 @@ DockWidgetProp::DockWidgetProp( QWidget *parent ) :
     _spinITT  [ 3 ] = _ui->spinITT_4;
     _spinFF   [ 3 ] = _ui->spinFF_4;
 
+    // units change forces refreshing values which otherwise might remain
+    // below change thresholds
+    QList< QComboBox* > combos = findChildren< QComboBox* >();
+
+    for ( int i = 0; i < combos.size(); i++ )
+    {
+        connect( combos.at( i ), SIGNAL(currentIndexChanged(int)), this, SLOT(comboUnits_currentIndexChanged(int)) );
+    }
+
     settingsRead();
 }
 
@@ -413,6 +463,43 @@ void DockWidgetProp::setFF( unsigned int index, float val )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void DockWidgetProp::setSnapshot( const Snapshot &snapshot )
+{
+    if ( _timer.isValid() && _timer.elapsed() < 1000.0 * GUI_DOCK_TIME_STEP ) return;
+
+    _timer.start();
+
+    for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        const Engine &e = snapshot.engine[ i ];
+        Engine &d = _displayed.engine[ i ];
+
+        bool all = !_displayedValid;
+
+        if ( isChanged( &d.state       , e.state       , all ) ) setState ( i, d.state       );
+        if ( isChanged( &d.afterburner , e.afterburner , all ) ) setAB    ( i, d.afterburner );
+
+        if ( isChanged( &d.rpm  , e.rpm  , resSpeed , all ) ) setRPM  ( i, d.rpm  );
+        if ( isChanged( &d.prop , e.prop , resSpeed , all ) ) setPROP ( i, d.prop );
+        if ( isChanged( &d.ng   , e.ng   , resNorm  , all ) ) setNG   ( i, d.ng   );
+        if ( isChanged( &d.n1   , e.n1   , resNorm  , all ) ) setN1   ( i, d.n1   );
+        if ( isChanged( &d.n2   , e.n2   , resNorm  , all ) ) setN2   ( i, d.n2   );
+        if ( isChanged( &d.trq  , e.trq  , resNorm  , all ) ) setTRQ  ( i, d.trq  );
+        if ( isChanged( &d.epr  , e.epr  , resEPR   , all ) ) setEPR  ( i, d.epr  );
+        if ( isChanged( &d.map  , e.map  , resMAP   , all ) ) setMAP  ( i, d.map  );
+        if ( isChanged( &d.egt  , e.egt  , resTemp  , all ) ) setEGT  ( i, d.egt  );
+        if ( isChanged( &d.cht  , e.cht  , resTemp  , all ) ) setCHT  ( i, d.cht  );
+        if ( isChanged( &d.tit  , e.tit  , resTemp  , all ) ) setTIT  ( i, d.tit  );
+        if ( isChanged( &d.tot  , e.tot  , resTemp  , all ) ) setTOT  ( i, d.tot  );
+        if ( isChanged( &d.itt  , e.itt  , resTemp  , all ) ) setITT  ( i, d.itt  );
+        if ( isChanged( &d.ff   , e.ff   , resFF    , all ) ) setFF   ( i, d.ff   );
+    }
+
+    _displayedValid = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void DockWidgetProp::closeEvent( QCloseEvent *event )
 {
     /////////////////////////////////
@@ -495,3 +582,11 @@ void DockWidgetProp::settingsSave_UnitCombos( QSettings &settings )
 
     settings.endGroup();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DockWidgetProp::comboUnits_currentIndexChanged( int )
+{
+    _displayedValid = false;
+    _timer.invalidate();
+}
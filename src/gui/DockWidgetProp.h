@@ -26,6 +26,7 @@
 
 #include <QDockWidget>
 #include <QDoubleSpinBox>
+#include <QElapsedTimer>
 #include <QLabel>
 #include <QPushButton>
 #include <QSettings>
@@ -52,6 +53,34 @@ class DockWidgetProp : public QDockWidget
 
 public:
 
+    /** Engine data snapshot, units as expected by the setters. */
+    struct Engine
+    {
+        bool state;                 ///< specifies if engine is working
+        bool afterburner;           ///< specifies if afterburner is engaged
+
+        float rpm;                  ///< [rad/s] engine rotational speed
+        float prop;                 ///< [rad/s] propeller rotational speed
+        float ng;                   ///< [-] gas generator speed
+        float n1;                   ///< [-] low pressure spool speed
+        float n2;                   ///< [-] high pressure spool speed
+        float trq;                  ///< [-] torque
+        float epr;                  ///< [-] engine pressure ratio
+        float map;                  ///< [Pa] manifold absolute pressure
+        float egt;                  ///< [K] exhaust gas temperature
+        float cht;                  ///< [K] cylinder head temperature
+        float tit;                  ///< [K] turbine inlet temperature
+        float tot;                  ///< [K] turbine outlet temperature
+        float itt;                  ///< [K] interstage turbine temperature
+        float ff;                   ///< [kg/s] fuel flow
+    };
+
+    /** Propulsion data snapshot. */
+    struct Snapshot
+    {
+        Engine engine[ FDM_MAX_ENGINES ];
+    };
+
     /** @brief Constructor. */
     explicit DockWidgetProp( QWidget *parent = NULLPTR );
 
@@ -83,6 +112,14 @@ public:
     void setITT  ( unsigned int index, float val );
     void setFF   ( unsigned int index, float val );
 
+    /**
+     * @brief Updates all engines at once.
+     * Updates are throttled to GUI_DOCK_TIME_STEP and only fields which have
+     * changed more than their display resolution are refreshed.
+     * @param snapshot propulsion data snapshot
+     */
+    void setSnapshot( const Snapshot &snapshot );
+
 signals:
 
     void closed();
@@ -118,11 +155,20 @@ private:
     QDoubleSpinBox *_spinITT  [ FDM_MAX_ENGINES ];
     QDoubleSpinBox *_spinFF   [ FDM_MAX_ENGINES ];
 
+    Snapshot _displayed;            ///< displayed values
+    bool _displayedValid;           ///< specifies if displayed values are up to date
+
+    QElapsedTimer _timer;           ///< time since the last batched update
+
     void settingsRead();
     void settingsRead_UnitCombos( QSettings &settings );
 
     void settingsSave();
     void settingsSave_UnitCombos( QSettings &settings );
+
+private slots:
+
+    void comboUnits_currentIndexChanged( int /*index*/ );
 };
 
 ////////////////////////////////////////////////////////////////////////////////
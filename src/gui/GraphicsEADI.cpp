@@ -33,6 +33,32 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const float resAngle     = 0.05f;   ///< [deg] displayed angles resolution
+const float resNorm      = 0.002f;  ///< [-] displayed normalized values resolution
+const float resAltitude  = 0.5f;    ///< displayed altitude resolution
+const float resAirspeed  = 0.05f;   ///< displayed airspeed resolution
+const float resMachNo    = 0.001f;  ///< displayed Mach number resolution
+const float resClimbRate = 0.003f;  ///< displayed climb rate resolution
+
+/** Sets value if it differs from the current one more than resolution. */
+inline bool setValue( float *value, float newValue, float resolution )
+{
+    if ( fabs( newValue - (*value) ) > resolution )
+    {
+        (*value) = newValue;
+        return true;
+    }
+
+    return false;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 GraphicsEADI::GraphicsEADI( QWidget *parent ) :
     QGraphicsView ( parent ),
 
@@ -64,6 +90,8 @@ GraphicsEADI::GraphicsEADI( QWidget *parent ) :
     _lnav ( LNAV_OFF ),
     _vnav ( VNAV_OFF ),
 
+    _dirty ( true ),
+
     _scaleX ( 1.0f ),
     _scaleY ( 1.0f ),
 
@@ -176,19 +204,19 @@ void GraphicsEADI::init()
     _vsi->init( _scaleX, _scaleY );
 
     _itemBack = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_back.svg" );
-    _itemBack->setCacheMode( QGraphicsItem::NoCache );
+    _itemBack->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemBack->setZValue( _backZ );
     _itemBack->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _scene->addItem( _itemBack );
 
     _itemMask = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_mask.svg" );
-    _itemMask->setCacheMode( QGraphicsItem::NoCache );
+    _itemMask->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemMask->setZValue( _maskZ );
     _itemMask->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _scene->addItem( _itemMask );
 
     _itemFMA = new QGraphicsTextItem( QString( "  CMD  " ) );
-    _itemFMA->setCacheMode( QGraphicsItem::NoCache );
+    _itemFMA->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemFMA->setZValue( _textZ );
     _itemFMA->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemFMA->setDefaultTextColor( Colors::_lime );
@@ -199,7 +227,7 @@ void GraphicsEADI::init()
     _scene->addItem( _itemFMA );
 
     _itemSPD = new QGraphicsTextItem( QString( "FMC SPD" ) );
-    _itemSPD->setCacheMode( QGraphicsItem::NoCache );
+    _itemSPD->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemSPD->setZValue( _textZ );
     _itemSPD->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemSPD->setDefaultTextColor( Colors::_lime );
@@ -210,7 +238,7 @@ void GraphicsEADI::init()
     _scene->addItem( _itemSPD );
 
     _itemLNAV = new QGraphicsTextItem( QString( "HDG SEL" ) );
-    _itemLNAV->setCacheMode( QGraphicsItem::NoCache );
+    _itemLNAV->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLNAV->setZValue( _textZ );
     _itemLNAV->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemLNAV->setDefaultTextColor( Colors::_lime );
@@ -221,7 +249,7 @@ void GraphicsEADI::init()
     _scene->addItem( _itemLNAV );
 
     _itemVNAV = new QGraphicsTextItem( QString( "ALT SEL" ) );
-    _itemVNAV->setCacheMode( QGraphicsItem::NoCache );
+    _itemVNAV->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemVNAV->setZValue( _textZ );
     _itemVNAV->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemVNAV->setDefaultTextColor( Colors::_lime );
@@ -232,7 +260,7 @@ void GraphicsEADI::init()
     _scene->addItem( _itemVNAV );
 
     _itemLNAV_ARM = new QGraphicsTextItem( QString( "VOR/LOC" ) );
-    _itemLNAV_ARM->setCacheMode( QGraphicsItem::NoCache );
+    _itemLNAV_ARM->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLNAV_ARM->setZValue( _textZ );
     _itemLNAV_ARM->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemLNAV_ARM->setDefaultTextColor( Colors::_white );
@@ -243,7 +271,7 @@ void GraphicsEADI::init()
     _scene->addItem( _itemLNAV_ARM );
 
     _itemVNAV_ARM = new QGraphicsTextItem( QString( "GS PATH" ) );
-    _itemVNAV_ARM->setCacheMode( QGraphicsItem::NoCache );
+    _itemVNAV_ARM->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemVNAV_ARM->setZValue( _textZ );
     _itemVNAV_ARM->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemVNAV_ARM->setDefaultTextColor( Colors::_white );
@@ -271,6 +299,8 @@ void GraphicsEADI::reset()
 
     _itemLNAV_ARM = NULLPTR;
     _itemVNAV_ARM = NULLPTR;
+
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -280,12 +310,31 @@ void GraphicsEADI::updateView()
     _scaleX = (float)width()  / (float)_originalWidth;
     _scaleY = (float)height() / (float)_originalHeight;
 
-    _adi->update( _scaleX, _scaleY );
-    _alt->update( _scaleX, _scaleY );
-    _vsi->update( _scaleX, _scaleY );
-    _asi->update( _scaleX, _scaleY );
-    _hdg->update( _scaleX, _scaleY );
+    // instruments update their items only if displayed values have changed
+    bool changed = _dirty;
+
+    changed = _adi->update( _scaleX, _scaleY ) || changed;
+    changed = _alt->update( _scaleX, _scaleY ) || changed;
+    changed = _vsi->update( _scaleX, _scaleY ) || changed;
+    changed = _asi->update( _scaleX, _scaleY ) || changed;
+    changed = _hdg->update( _scaleX, _scaleY ) || changed;
 
+    if ( !changed ) return;
+
+    if ( _dirty )
+    {
+        updateModes();
+        _dirty = false;
+    }
+
+    // items schedule repaint of their own regions only
+    centerOn( width() / 2.0f , height() / 2.0f );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void GraphicsEADI::updateModes()
+{
     switch ( _flightMode )
     {
         case FM_FD:  _itemFMA->setPlainText( "  FD   " ); break;
@@ -321,10 +370,6 @@ void GraphicsEADI::updateView()
         case VNAV_GS_ARM:  _itemVNAV->setPlainText( "GS PATH" ); _itemVNAV_ARM->setPlainText( "GS PATH" ); break;
         default:           _itemVNAV->setPlainText( "       " ); _itemVNAV_ARM->setPlainText( "       " ); break;
     }
-
-    _scene->update();
-
-    centerOn( width() / 2.0f , height() / 2.0f );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -386,6 +431,8 @@ GraphicsEADI::ADI::ADI( QGraphicsScene *scene ) :
     _scaleX ( 1.0f ),
     _scaleY ( 1.0f ),
 
+    _dirty ( true ),
+
     _originalPixPerDeg (   3.0f ),
     _deltaLaddBack_max (  52.5f ),
     _deltaLaddBack_min ( -52.5f ),
@@ -462,21 +509,21 @@ void GraphicsEADI::ADI::init( float scaleX, float scaleY )
     _scene->addItem( _itemSlip );
 
     _itemTurn = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_adi_turn.svg" );
-    _itemTurn->setCacheMode( QGraphicsItem::NoCache );
+    _itemTurn->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemTurn->setZValue( _turnZ );
     _itemTurn->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemTurn->moveBy( _scaleX * _originalTurnPos.x(), _scaleY * _originalTurnPos.y() );
     _scene->addItem( _itemTurn );
 
     _itemDotH = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_adi_doth.svg" );
-    _itemDotH->setCacheMode( QGraphicsItem::NoCache );
+    _itemDotH->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemDotH->setZValue( _dotsZ - 1 );
     _itemDotH->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemDotH->moveBy( _scaleX * _originalDotHPos.x(), _scaleY * _originalDotHPos.y() );
     _scene->addItem( _itemDotH );
 
     _itemDotV = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_adi_dotv.svg" );
-    _itemDotV->setCacheMode( QGraphicsItem::NoCache );
+    _itemDotV->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemDotV->setZValue( _dotsZ - 1 );
     _itemDotV->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemDotV->moveBy( _scaleX * _originalDotVPos.x(), _scaleY * _originalDotVPos.y() );
@@ -491,28 +538,28 @@ void GraphicsEADI::ADI::init( float scaleX, float scaleY )
     _scene->addItem( _itemFD );
 
     _itemStall = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_adi_stall.svg" );
-    _itemStall->setCacheMode( QGraphicsItem::NoCache );
+    _itemStall->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemStall->setZValue( _stallZ );
     _itemStall->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemStall->moveBy( _scaleX * _originalStallPos.x(), _scaleY * _originalStallPos.y() );
     _scene->addItem( _itemStall );
 
     _itemScaleH = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_adi_scaleh.svg" );
-    _itemScaleH->setCacheMode( QGraphicsItem::NoCache );
+    _itemScaleH->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemScaleH->setZValue( _scalesZ );
     _itemScaleH->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemScaleH->moveBy( _scaleX * _originalScaleHPos.x(), _scaleY * _originalScaleHPos.y() );
     _scene->addItem( _itemScaleH );
 
     _itemScaleV = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_adi_scalev.svg" );
-    _itemScaleV->setCacheMode( QGraphicsItem::NoCache );
+    _itemScaleV->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemScaleV->setZValue( _scalesZ );
     _itemScaleV->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemScaleV->moveBy( _scaleX * _originalScaleVPos.x(), _scaleY * _originalScaleVPos.y() );
     _scene->addItem( _itemScaleV );
 
     _itemMask = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_adi_mask.svg" );
-    _itemMask->setCacheMode( QGraphicsItem::NoCache );
+    _itemMask->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemMask->setZValue( _maskZ );
     _itemMask->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _scene->addItem( _itemMask );
@@ -522,8 +569,10 @@ void GraphicsEADI::ADI::init( float scaleX, float scaleY )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GraphicsEADI::ADI::update( float scaleX, float scaleY )
+bool GraphicsEADI::ADI::update( float scaleX, float scaleY )
 {
+    if ( !_dirty && scaleX == _scaleX && scaleY == _scaleY ) return false;
+
     _scaleX = scaleX;
     _scaleY = scaleY;
 
@@ -558,63 +607,72 @@ void GraphicsEADI::ADI::update( float scaleX, float scaleY )
     _dotVDeltaY_old     = _dotVDeltaY_new;
     _fdDeltaX_old       = _fdDeltaX_new;
     _fdDeltaY_old       = _fdDeltaY_new;
+
+    _dirty = false;
+
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ADI::setRoll( float roll )
 {
-    _roll = roll;
+    if      ( roll < -180.0f ) roll = -180.0f;
+    else if ( roll >  180.0f ) roll =  180.0f;
 
-    if      ( _roll < -180.0f ) _roll = -180.0f;
-    else if ( _roll >  180.0f ) _roll =  180.0f;
+    if ( setValue( &_roll, roll, resAngle ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ADI::setPitch( float pitch )
 {
-    _pitch = pitch;
+    if      ( pitch < -90.0f ) pitch = -90.0f;
+    else if ( pitch >  90.0f ) pitch =  90.0f;
 
-    if      ( _pitch < -90.0f ) _pitch = -90.0f;
-    else if ( _pitch >  90.0f ) _pitch =  90.0f;
+    if ( setValue( &_pitch, pitch, resAngle ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ADI::setSlipSkid( float slipSkid )
 {
-    _slipSkid = slipSkid;
+    if      ( slipSkid < -1.0f ) slipSkid = -1.0f;
+    else if ( slipSkid >  1.0f ) slipSkid =  1.0f;
 
-    if      ( _slipSkid < -1.0f ) _slipSkid = -1.0f;
-    else if ( _slipSkid >  1.0f ) _slipSkid =  1.0f;
+    if ( setValue( &_slipSkid, slipSkid, resNorm ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ADI::setTurnRate( float turnRate )
 {
-    _turnRate = turnRate;
+    if      ( turnRate < -1.0f ) turnRate = -1.0f;
+    else if ( turnRate >  1.0f ) turnRate =  1.0f;
 
-    if      ( _turnRate < -1.0f ) _turnRate = -1.0f;
-    else if ( _turnRate >  1.0f ) _turnRate =  1.0f;
+    if ( setValue( &_turnRate, turnRate, resNorm ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ADI::setDots( float dotH, float dotV, bool visibleH, bool visibleV )
 {
-    _dotH = dotH;
-    _dotV = dotV;
+    if      ( dotH < -1.0f ) dotH = -1.0f;
+    else if ( dotH >  1.0f ) dotH =  1.0f;
+
+    if      ( dotV < -1.0f ) dotV = -1.0f;
+    else if ( dotV >  1.0f ) dotV =  1.0f;
 
-    if      ( _dotH < -1.0f ) _dotH = -1.0f;
-    else if ( _dotH >  1.0f ) _dotH =  1.0f;
+    if ( setValue( &_dotH, dotH, resNorm ) ) _dirty = true;
+    if ( setValue( &_dotV, dotV, resNorm ) ) _dirty = true;
 
-    if      ( _dotV < -1.0f ) _dotV = -1.0f;
-    else if ( _dotV >  1.0f ) _dotV =  1.0f;
+    if ( _dotVisibleH != visibleH || _dotVisibleV != visibleV )
+    {
+        _dotVisibleH = visibleH;
+        _dotVisibleV = visibleV;
 
-    _dotVisibleH = visibleH;
-    _dotVisibleV = visibleV;
+        _dirty = true;
+    }
 }
 
 
@@ -622,23 +680,31 @@ void GraphicsEADI::ADI::setDots( float dotH, float dotV, bool visibleH, bool vis
 
 void GraphicsEADI::ADI::setFD( float roll, float pitch, bool visible )
 {
-    _fdRoll  = roll;
-    _fdPitch = pitch;
+    if      ( roll < -180.0f ) roll = -180.0f;
+    else if ( roll >  180.0f ) roll =  180.0f;
 
-    if      ( _fdRoll < -180.0f ) _fdRoll = -180.0f;
-    else if ( _fdRoll >  180.0f ) _fdRoll =  180.0f;
+    if      ( pitch < -90.0f ) pitch = -90.0f;
+    else if ( pitch >  90.0f ) pitch =  90.0f;
 
-    if      ( _fdPitch < -90.0f ) _fdPitch = -90.0f;
-    else if ( _fdPitch >  90.0f ) _fdPitch =  90.0f;
+    if ( setValue( &_fdRoll  , roll  , resAngle ) ) _dirty = true;
+    if ( setValue( &_fdPitch , pitch , resAngle ) ) _dirty = true;
 
-    _fdVisible = visible;
+    if ( _fdVisible != visible )
+    {
+        _fdVisible = visible;
+        _dirty = true;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ADI::setStall( bool stall )
 {
-    _stall = stall;
+    if ( _stall != stall )
+    {
+        _stall = stall;
+        _dirty = true;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -694,6 +760,8 @@ void GraphicsEADI::ADI::reset()
     _fdDeltaX_old       = 0.0f;
     _fdDeltaY_new       = 0.0f;
     _fdDeltaY_old       = 0.0f;
+
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -882,6 +950,8 @@ GraphicsEADI::ALT::ALT( QGraphicsScene *scene ) :
     _scaleX ( 1.0f ),
     _scaleY ( 1.0f ),
 
+    _dirty ( true ),
+
     _originalPixPerAlt   ( 0.150f ),
     _originalScaleHeight ( 300.0f ),
     _originalLabelsX     ( 253.0f ),
@@ -919,28 +989,28 @@ void GraphicsEADI::ALT::init( float scaleX, float scaleY )
     reset();
 
     _itemBack = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_alt_back.svg" );
-    _itemBack->setCacheMode( QGraphicsItem::NoCache );
+    _itemBack->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemBack->setZValue( _backZ );
     _itemBack->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemBack->moveBy( _scaleX * _originalBackPos.x(), _scaleY * _originalBackPos.y() );
     _scene->addItem( _itemBack );
 
     _itemScale1 = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_alt_scale.svg" );
-    _itemScale1->setCacheMode( QGraphicsItem::NoCache );
+    _itemScale1->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemScale1->setZValue( _scaleZ );
     _itemScale1->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemScale1->moveBy( _scaleX * _originalScale1Pos.x(), _scaleY * _originalScale1Pos.y() );
     _scene->addItem( _itemScale1 );
 
     _itemScale2 = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_alt_scale.svg" );
-    _itemScale2->setCacheMode( QGraphicsItem::NoCache );
+    _itemScale2->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemScale2->setZValue( _scaleZ );
     _itemScale2->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemScale2->moveBy( _scaleX * _originalScale2Pos.x(), _scaleY * _originalScale2Pos.y() );
     _scene->addItem( _itemScale2 );
 
     _itemLabel1 = new QGraphicsTextItem( QString( "99999" ) );
-    _itemLabel1->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel1->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel1->setZValue( _labelsZ );
     _itemLabel1->setDefaultTextColor( Colors::_white );
     _itemLabel1->setFont( Fonts::small() );
@@ -950,7 +1020,7 @@ void GraphicsEADI::ALT::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel1 );
 
     _itemLabel2 = new QGraphicsTextItem( QString( "99999" ) );
-    _itemLabel2->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel2->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel2->setZValue( _labelsZ );
     _itemLabel2->setDefaultTextColor( Colors::_white );
     _itemLabel2->setFont( Fonts::small() );
@@ -960,7 +1030,7 @@ void GraphicsEADI::ALT::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel2 );
 
     _itemLabel3 = new QGraphicsTextItem( QString( "99999" ) );
-    _itemLabel3->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel3->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel3->setZValue( _labelsZ );
     _itemLabel3->setDefaultTextColor( Colors::_white );
     _itemLabel3->setFont( Fonts::small() );
@@ -970,28 +1040,28 @@ void GraphicsEADI::ALT::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel3 );
 
     _itemGround = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_alt_ground.svg" );
-    _itemGround->setCacheMode( QGraphicsItem::NoCache );
+    _itemGround->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemGround->setZValue( _groundZ );
     _itemGround->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemGround->moveBy( _scaleX * _originalGroundPos.x(), _scaleY * _originalGroundPos.y() );
     _scene->addItem( _itemGround );
 
     _itemBugAlt = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_alt_bug.svg" );
-    _itemBugAlt->setCacheMode( QGraphicsItem::NoCache );
+    _itemBugAlt->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemBugAlt->setZValue( _altBugZ );
     _itemBugAlt->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemBugAlt->moveBy( _scaleX * _originalFramePos.x(), _scaleY * _originalFramePos.y() );
     _scene->addItem( _itemBugAlt );
 
     _itemFrame = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_alt_frame.svg" );
-    _itemFrame->setCacheMode( QGraphicsItem::NoCache );
+    _itemFrame->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemFrame->setZValue( _frameZ );
     _itemFrame->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemFrame->moveBy( _scaleX * _originalFramePos.x(), _scaleY * _originalFramePos.y() );
     _scene->addItem( _itemFrame );
 
     _itemAltitude = new QGraphicsTextItem( QString( "    0" ) );
-    _itemAltitude->setCacheMode( QGraphicsItem::NoCache );
+    _itemAltitude->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemAltitude->setZValue( _frameTextZ );
     _itemAltitude->setDefaultTextColor( Colors::_white );
     _itemAltitude->setFont( Fonts::medium() );
@@ -1001,7 +1071,7 @@ void GraphicsEADI::ALT::init( float scaleX, float scaleY )
     _scene->addItem( _itemAltitude );
 
     _itemPressure = new QGraphicsTextItem( QString( "  STD  " ) );
-    _itemPressure->setCacheMode( QGraphicsItem::NoCache );
+    _itemPressure->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemPressure->setZValue( _frameTextZ );
     _itemPressure->setDefaultTextColor( Colors::_lime );
     _itemPressure->setFont( Fonts::medium() );
@@ -1011,7 +1081,7 @@ void GraphicsEADI::ALT::init( float scaleX, float scaleY )
     _scene->addItem( _itemPressure );
 
     _itemSetpoint = new QGraphicsTextItem( QString( "    0" ) );
-    _itemSetpoint->setCacheMode( QGraphicsItem::NoCache );
+    _itemSetpoint->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemSetpoint->setZValue( _frameTextZ );
     _itemSetpoint->setDefaultTextColor( Colors::_magenta );
     _itemSetpoint->setFont( Fonts::medium() );
@@ -1025,8 +1095,10 @@ void GraphicsEADI::ALT::init( float scaleX, float scaleY )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GraphicsEADI::ALT::update( float scaleX, float scaleY )
+bool GraphicsEADI::ALT::update( float scaleX, float scaleY )
 {
+    if ( !_dirty && scaleX == _scaleX && scaleY == _scaleY ) return false;
+
     _scaleX = scaleX;
     _scaleY = scaleY;
 
@@ -1037,26 +1109,30 @@ void GraphicsEADI::ALT::update( float scaleX, float scaleY )
     _groundDeltaY_old = _groundDeltaY_new;
     _labelsDeltaY_old = _labelsDeltaY_new;
     _bugDeltaY_old    = _bugDeltaY_new;
+
+    _dirty = false;
+
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ALT::setAltitude( float altitude )
 {
-    _altitude = altitude;
+    if      ( altitude <     0.0f ) altitude =     0.0f;
+    else if ( altitude > 99999.0f ) altitude = 99999.0f;
 
-    if      ( _altitude <     0.0f ) _altitude =     0.0f;
-    else if ( _altitude > 99999.0f ) _altitude = 99999.0f;
+    if ( setValue( &_altitude, altitude, resAltitude ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ALT::setAltitudeSel( double altitude )
 {
-    _altitude_sel = altitude;
+    if      ( altitude <     0.0f ) altitude =     0.0f;
+    else if ( altitude > 99999.0f ) altitude = 99999.0f;
 
-    if      ( _altitude_sel <     0.0f ) _altitude_sel =     0.0f;
-    else if ( _altitude_sel > 99999.0f ) _altitude_sel = 99999.0f;
+    if ( setValue( &_altitude_sel, altitude, resAltitude ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1089,6 +1165,8 @@ void GraphicsEADI::ALT::reset()
     _labelsDeltaY_old = 0.0f;
     _bugDeltaY_new    = 0.0f;
     _bugDeltaY_old    = 0.0f;
+
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1251,6 +1329,8 @@ GraphicsEADI::ASI::ASI( QGraphicsScene *scene ) :
     _scaleX ( 1.0f ),
     _scaleY ( 1.0f ),
 
+    _dirty ( true ),
+
     _originalPixPerSpd   (   1.5f ),
     _originalScaleHeight ( 300.0f ),
     _originalLabelsX     (  40.0f ),
@@ -1294,28 +1374,28 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     reset();
 
     _itemBack = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_asi_back.svg" );
-    _itemBack->setCacheMode( QGraphicsItem::NoCache );
+    _itemBack->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemBack->setZValue( _backZ );
     _itemBack->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemBack->moveBy( _scaleX * _originalBackPos.x(), _scaleY * _originalBackPos.y() );
     _scene->addItem( _itemBack );
 
     _itemScale1 = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_asi_scale.svg" );
-    _itemScale1->setCacheMode( QGraphicsItem::NoCache );
+    _itemScale1->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemScale1->setZValue( _scaleZ );
     _itemScale1->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemScale1->moveBy( _scaleX * _originalScale1Pos.x(), _scaleY * _originalScale1Pos.y() );
     _scene->addItem( _itemScale1 );
 
     _itemScale2 = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_asi_scale.svg" );
-    _itemScale2->setCacheMode( QGraphicsItem::NoCache );
+    _itemScale2->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemScale2->setZValue( _scaleZ );
     _itemScale2->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemScale2->moveBy( _scaleX * _originalScale2Pos.x(), _scaleY * _originalScale2Pos.y() );
     _scene->addItem( _itemScale2 );
 
     _itemLabel1 = new QGraphicsTextItem( QString( "999" ) );
-    _itemLabel1->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel1->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel1->setZValue( _labelsZ );
     _itemLabel1->setDefaultTextColor( Colors::_white );
     _itemLabel1->setFont( Fonts::small() );
@@ -1325,7 +1405,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel1 );
 
     _itemLabel2 = new QGraphicsTextItem( QString( "999" ) );
-    _itemLabel2->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel2->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel2->setZValue( _labelsZ );
     _itemLabel2->setDefaultTextColor( Colors::_white );
     _itemLabel2->setFont( Fonts::small() );
@@ -1335,7 +1415,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel2 );
 
     _itemLabel3 = new QGraphicsTextItem( QString( "999" ) );
-    _itemLabel3->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel3->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel3->setZValue( _labelsZ );
     _itemLabel3->setDefaultTextColor( Colors::_white );
     _itemLabel3->setFont( Fonts::small() );
@@ -1345,7 +1425,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel3 );
 
     _itemLabel4 = new QGraphicsTextItem( QString( "999" ) );
-    _itemLabel4->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel4->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel4->setZValue( _labelsZ );
     _itemLabel4->setDefaultTextColor( Colors::_white );
     _itemLabel4->setFont( Fonts::small() );
@@ -1355,7 +1435,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel4 );
 
     _itemLabel5 = new QGraphicsTextItem( QString( "999" ) );
-    _itemLabel5->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel5->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel5->setZValue( _labelsZ );
     _itemLabel5->setDefaultTextColor( Colors::_white );
     _itemLabel5->setFont( Fonts::small() );
@@ -1365,7 +1445,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel5 );
 
     _itemLabel6 = new QGraphicsTextItem( QString( "999" ) );
-    _itemLabel6->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel6->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel6->setZValue( _labelsZ );
     _itemLabel6->setDefaultTextColor( Colors::_white );
     _itemLabel6->setFont( Fonts::small() );
@@ -1375,7 +1455,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel6 );
 
     _itemLabel7 = new QGraphicsTextItem( QString( "999" ) );
-    _itemLabel7->setCacheMode( QGraphicsItem::NoCache );
+    _itemLabel7->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemLabel7->setZValue( _labelsZ );
     _itemLabel7->setDefaultTextColor( Colors::_white );
     _itemLabel7->setFont( Fonts::small() );
@@ -1385,14 +1465,14 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemLabel7 );
 
     _itemBugIAS = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_asi_bug.svg" );
-    _itemBugIAS->setCacheMode( QGraphicsItem::NoCache );
+    _itemBugIAS->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemBugIAS->setZValue( _iasBugZ );
     _itemBugIAS->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemBugIAS->moveBy( _scaleX * _originalFramePos.x(), _scaleY * _originalFramePos.y() );
     _scene->addItem( _itemBugIAS );
 
     _itemFrame = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_asi_frame.svg" );
-    _itemFrame->setCacheMode( QGraphicsItem::NoCache );
+    _itemFrame->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemFrame->setZValue( _frameZ );
     _itemFrame->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemFrame->moveBy( _scaleX * _originalFramePos.x(), _scaleY * _originalFramePos.y() );
@@ -1406,14 +1486,14 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _itemVfe->setZValue( _iasVfeZ );
 
     _itemVne = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_asi_vne.svg" );
-    _itemVne->setCacheMode( QGraphicsItem::NoCache );
+    _itemVne->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemVne->setZValue( _iasVneZ );
     _itemVne->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemVne->moveBy( _scaleX * _originalScale1Pos.x(), _scaleY * _originalScale1Pos.y() );
     _scene->addItem( _itemVne );
 
     _itemAirspeed = new QGraphicsTextItem( QString( "000" ) );
-    _itemAirspeed->setCacheMode( QGraphicsItem::NoCache );
+    _itemAirspeed->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemAirspeed->setZValue( _frameTextZ );
     _itemAirspeed->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemAirspeed->setDefaultTextColor( Colors::_white );
@@ -1424,7 +1504,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemAirspeed );
 
     _itemMachNo = new QGraphicsTextItem( QString( ".000" ) );
-    _itemMachNo->setCacheMode( QGraphicsItem::NoCache );
+    _itemMachNo->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemMachNo->setZValue( _frameTextZ );
     _itemMachNo->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemMachNo->setDefaultTextColor( Colors::_white );
@@ -1435,7 +1515,7 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
     _scene->addItem( _itemMachNo );
 
     _itemSetpoint = new QGraphicsTextItem( QString( "000" ) );
-    _itemSetpoint->setCacheMode( QGraphicsItem::NoCache );
+    _itemSetpoint->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemSetpoint->setZValue( _frameTextZ );
     _itemSetpoint->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemSetpoint->setDefaultTextColor( Colors::_magenta );
@@ -1450,8 +1530,10 @@ void GraphicsEADI::ASI::init( float scaleX, float scaleY )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GraphicsEADI::ASI::update( float scaleX, float scaleY )
+bool GraphicsEADI::ASI::update( float scaleX, float scaleY )
 {
+    if ( !_dirty && scaleX == _scaleX && scaleY == _scaleY ) return false;
+
     _scaleX = scaleX;
     _scaleY = scaleY;
 
@@ -1462,56 +1544,60 @@ void GraphicsEADI::ASI::update( float scaleX, float scaleY )
     _labelsDeltaY_old = _labelsDeltaY_new;
     _bugDeltaY_old    = _bugDeltaY_new;
     _vneDeltaY_old    = _vneDeltaY_new;
+
+    _dirty = false;
+
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ASI::setAirspeed( float airspeed )
 {
-    _airspeed = airspeed;
+    if      ( airspeed <    0.0f ) airspeed =    0.0f;
+    else if ( airspeed > 9999.0f ) airspeed = 9999.0f;
 
-    if      ( _airspeed <    0.0f ) _airspeed =    0.0f;
-    else if ( _airspeed > 9999.0f ) _airspeed = 9999.0f;
+    if ( setValue( &_airspeed, airspeed, resAirspeed ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ASI::setMachNo( float machNo )
 {
-    _machNo = machNo;
+    if      ( machNo <  0.0f ) machNo =  0.0f;
+    else if ( machNo > 99.9f ) machNo = 99.9f;
 
-    if      ( _machNo <  0.0f ) _machNo =  0.0f;
-    else if ( _machNo > 99.9f ) _machNo = 99.9f;
+    if ( setValue( &_machNo, machNo, resMachNo ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ASI::setAirspeedSel( double airspeed )
 {
-    _airspeed_sel = airspeed;
+    if      ( airspeed < 0.0f    ) airspeed = 0.0;
+    else if ( airspeed > 9999.0f ) airspeed = 9999.0f;
 
-    if      ( _airspeed_sel < 0.0f    ) _airspeed_sel = 0.0;
-    else if ( _airspeed_sel > 9999.0f ) _airspeed_sel = 9999.0f;
+    if ( setValue( &_airspeed_sel, airspeed, resAirspeed ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ASI::setVfe( double vfe )
 {
-    _vfe = vfe;
+    if      ( vfe < 0.0f    ) vfe = 0.0;
+    else if ( vfe > 9999.0f ) vfe = 9999.0f;
 
-    if      ( _vfe < 0.0f    ) _vfe = 0.0;
-    else if ( _vfe > 9999.0f ) _vfe = 9999.0f;
+    if ( setValue( &_vfe, vfe, resAirspeed ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::ASI::setVne( double vne )
 {
-    _vne = vne;
+    if      ( vne < 0.0f    ) vne = 0.0;
+    else if ( vne > 9999.0f ) vne = 9999.0f;
 
-    if      ( _vne < 0.0f    ) _vne = 0.0;
-    else if ( _vne > 9999.0f ) _vne = 9999.0f;
+    if ( setValue( &_vne, vne, resAirspeed ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1554,6 +1640,8 @@ void GraphicsEADI::ASI::reset()
     _bugDeltaY_old    = 0.0f;
     _vneDeltaY_new    = 0.0f;
     _vneDeltaY_old    = 0.0f;
+
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1774,6 +1862,8 @@ GraphicsEADI::HDG::HDG( QGraphicsScene *scene ) :
     _scaleX ( 1.0f ),
     _scaleY ( 1.0f ),
 
+    _dirty ( true ),
+
     _originalHsiCtr       ( 150.0f , 345.0f ),
     _originalBackPos      (   0.0f,  210.0f ),
     _originalFacePos      (  38.0f , 233.0f ),
@@ -1799,7 +1889,7 @@ void GraphicsEADI::HDG::init( float scaleX, float scaleY )
     reset();
 
     _itemBack = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_hsi_back.svg" );
-    _itemBack->setCacheMode( QGraphicsItem::NoCache );
+    _itemBack->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemBack->setZValue( _backZ );
     _itemBack->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemBack->moveBy( _scaleX * _originalBackPos.x(), _scaleY * _originalBackPos.y() );
@@ -1822,14 +1912,14 @@ void GraphicsEADI::HDG::init( float scaleX, float scaleY )
     _scene->addItem( _itemHdgBug );
 
     _itemMarks = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_hsi_marks.svg" );
-    _itemMarks->setCacheMode( QGraphicsItem::NoCache );
+    _itemMarks->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemMarks->setZValue( _marksZ );
     _itemMarks->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemMarks->moveBy( _scaleX * _originalMarksPos.x(), _scaleY * _originalMarksPos.y() );
     _scene->addItem( _itemMarks );
 
     _itemFrameText = new QGraphicsTextItem( QString( "000" ) );
-    _itemFrameText->setCacheMode( QGraphicsItem::NoCache );
+    _itemFrameText->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemFrameText->setZValue( _frameTextZ );
     _itemFrameText->setTextInteractionFlags( Qt::NoTextInteraction );
     _itemFrameText->setDefaultTextColor( Colors::_white );
@@ -1844,32 +1934,38 @@ void GraphicsEADI::HDG::init( float scaleX, float scaleY )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GraphicsEADI::HDG::update( float scaleX, float scaleY )
+bool GraphicsEADI::HDG::update( float scaleX, float scaleY )
 {
+    if ( !_dirty && scaleX == _scaleX && scaleY == _scaleY ) return false;
+
     _scaleX = scaleX;
     _scaleY = scaleY;
 
     updateHeading();
+
+    _dirty = false;
+
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::HDG::setHeading( float heading )
 {
-    _heading = heading;
+    while ( heading < 0.0f ) heading += 360.0f;
+    while ( heading > 360.0f ) heading -= 360.0f;
 
-    while ( _heading < 0.0f ) _heading += 360.0f;
-    while ( _heading > 360.0f ) _heading -= 360.0f;
+    if ( setValue( &_heading, heading, resAngle ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::HDG::setHeadingSel( float heading )
 {
-    _heading_sel = heading;
+    while ( heading <   0.0f ) heading += 360.0f;
+    while ( heading > 360.0f ) heading -= 360.0f;
 
-    while ( _heading_sel <   0.0f ) _heading_sel += 360.0f;
-    while ( _heading_sel > 360.0f ) _heading_sel -= 360.0f;
+    if ( setValue( &_heading_sel, heading, resAngle ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1884,6 +1980,8 @@ void GraphicsEADI::HDG::reset()
 
     _heading = 0.0f;
     _heading_sel = 0.0f;
+
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1911,6 +2009,8 @@ GraphicsEADI::VSI::VSI( QGraphicsScene *scene ) :
     _scaleX ( 1.0f ),
     _scaleY ( 1.0f ),
 
+    _dirty ( true ),
+
     _originalMarkerWidth (  4.0f ),
     _originalPixPerSpd1  ( 30.0f ),
     _originalPixPerSpd2  ( 20.0f ),
@@ -1938,7 +2038,7 @@ void GraphicsEADI::VSI::init( float scaleX, float scaleY )
     reset();
 
     _itemScale = new QGraphicsSvgItem( ":/gui/images/efis/eadi/eadi_vsi_scale.svg" );
-    _itemScale->setCacheMode( QGraphicsItem::NoCache );
+    _itemScale->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemScale->setZValue( _scaleZ );
     _itemScale->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _itemScale->moveBy( _scaleX * _originalScalePos.x(), _scaleY * _originalScalePos.y() );
@@ -1956,22 +2056,28 @@ void GraphicsEADI::VSI::init( float scaleX, float scaleY )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void GraphicsEADI::VSI::update( float scaleX, float scaleY )
+bool GraphicsEADI::VSI::update( float scaleX, float scaleY )
 {
+    if ( !_dirty && scaleX == _scaleX && scaleY == _scaleY ) return false;
+
     _scaleX = scaleX;
     _scaleY = scaleY;
 
     updateVSI();
+
+    _dirty = false;
+
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEADI::VSI::setClimbRate( float climbRate )
 {
-    _climbRate = climbRate;
+    if      ( climbRate >  6.8f ) climbRate =  6.8f;
+    else if ( climbRate < -6.8f ) climbRate = -6.8f;
 
-    if      ( _climbRate >  6.8f ) _climbRate =  6.8f;
-    else if ( _climbRate < -6.8f ) _climbRate = -6.8f;
+    if ( setValue( &_climbRate, climbRate, resClimbRate ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1980,6 +2086,8 @@ void GraphicsEADI::VSI::reset()
 {
     _itemScale = NULLPTR;
     _climbRate = 0.0;
+
+    _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,10 @@
 
 /**
  * @brief This class provides EADI widget.
+ *
+ * Instruments items are updated only if displayed values have changed more
+ * than the display resolution. Static artwork, tapes and text items are
+ * cached in device coordinates, rotating items are drawn directly.
  */
 class GraphicsEADI : public QGraphicsView
 {
@@ -59,24 +63,28 @@ public:
     /** */
     inline void setFlightMode( FlightMode flightMode )
     {
+        if ( _flightMode != flightMode ) _dirty = true;
         _flightMode = flightMode;
     }
 
     /** */
     inline void setSpeedMode( SpeedMode speedMode )
     {
+        if ( _speedMode != speedMode ) _dirty = true;
         _speedMode = speedMode;
     }
 
     /** */
     inline void setLNAV( LNAV lnav )
     {
+        if ( _lnav != lnav ) _dirty = true;
         _lnav = lnav;
     }
 
     /** */
     inline void setVNAV( VNAV vnav )
     {
+        if ( _vnav != vnav ) _dirty = true;
         _vnav = vnav;
     }
 
@@ -235,6 +243,8 @@ private:
     LNAV _lnav;                             ///<
     VNAV _vnav;                             ///<
 
+    bool _dirty;                            ///< specifies if modes have changed or items have been recreated
+
     float _scaleX;                          ///<
     float _scaleY;                          ///<
 
@@ -260,6 +270,8 @@ private:
 
     void updateView();
 
+    void updateModes();
+
     /** Attitude Director Indicator */
     class ADI
     {
@@ -267,7 +279,7 @@ private:
         ADI( QGraphicsScene *scene );
 
         void init( float scaleX, float scaleY );
-        void update( float scaleX, float scaleY );
+        bool update( float scaleX, float scaleY );
 
         void setRoll( float roll );
         void setPitch( float pitch );
@@ -335,6 +347,8 @@ private:
         float _scaleX;                      ///<
         float _scaleY;                      ///<
 
+        bool _dirty;                        ///< specifies if any displayed value has changed
+
         const float _originalPixPerDeg;     ///< [px/deg] pixels to move pitch ladder due to 1 deg pitch
         const float _deltaLaddBack_max;     ///< [px] max pitch ladder background deflection
         const float _deltaLaddBack_min;     ///< [px] min pitch ladder background deflection
@@ -385,7 +399,7 @@ private:
         ALT( QGraphicsScene *scene );
 
         void init( float scaleX, float scaleY );
-        void update( float scaleX, float scaleY );
+        bool update( float scaleX, float scaleY );
 
         void setAltitude( float altitude );
         void setAltitudeSel( double altitude );
@@ -424,6 +438,8 @@ private:
         float _scaleX;                      ///<
         float _scaleY;                      ///<
 
+        bool _dirty;                        ///< specifies if any displayed value has changed
+
         const float _originalPixPerAlt;     ///< [px/altitude unit]
         const float _originalScaleHeight;   ///< [px]
         const float _originalLabelsX;       ///< [px]
@@ -463,7 +479,7 @@ private:
         ASI( QGraphicsScene *scene );
 
         void init( float scaleX, float scaleY );
-        void update( float scaleX, float scaleY );
+        bool update( float scaleX, float scaleY );
 
         void setAirspeed( float airspeed );
         void setMachNo( float machNo );
@@ -516,6 +532,8 @@ private:
         float _scaleX;                      ///<
         float _scaleY;                      ///<
 
+        bool _dirty;                        ///< specifies if any displayed value has changed
+
         const float _originalPixPerSpd;     ///< [px/airspeed unit]
         const float _originalScaleHeight;   ///< [px]
         const float _originalLabelsX;       ///< [px]
@@ -563,7 +581,7 @@ private:
         HDG( QGraphicsScene *scene );
 
         void init( float scaleX, float scaleY );
-        void update( float scaleX, float scaleY );
+        bool update( float scaleX, float scaleY );
 
         void setHeading( float heading );
         void setHeadingSel( float heading );
@@ -584,6 +602,8 @@ private:
         float _scaleX;                      ///<
         float _scaleY;                      ///<
 
+        bool _dirty;                        ///< specifies if any displayed value has changed
+
         QPointF _originalHsiCtr;            ///<
         QPointF _originalBackPos;           ///<
         QPointF _originalFacePos;           ///<
@@ -609,7 +629,7 @@ private:
         VSI( QGraphicsScene *scene );
 
         void init( float scaleX, float scaleY );
-        void update( float scaleX, float scaleY );
+        bool update( float scaleX, float scaleY );
 
         void setClimbRate( float climbRate );
 
@@ -625,6 +645,8 @@ private:
         float _scaleX;                      ///<
         float _scaleY;                      ///<
 
+        bool _dirty;                        ///< specifies if any displayed value has changed
+
         const float _originalMarkerWidth;
         const float _originalPixPerSpd1;    ///< [px/vertical speed unit] up to 100 vsu
         const float _originalPixPerSpd2;    ///< [px/vertical speed unit] from 100 to 200 vsu
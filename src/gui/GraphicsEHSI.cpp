@@ -34,6 +34,29 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const float resAngle     = 0.05f;   ///< [deg] displayed angles resolution
+const float resDeviation = 0.002f;  ///< [-] displayed deviation resolution
+const float resDistance  = 0.05f;   ///< [nm] displayed distance resolution
+
+/** Sets value if it differs from the current one more than resolution. */
+inline bool setValue( float *value, float newValue, float resolution )
+{
+    if ( fabs( newValue - (*value) ) > resolution )
+    {
+        (*value) = newValue;
+        return true;
+    }
+
+    return false;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 GraphicsEHSI::GraphicsEHSI( QWidget *parent ) :
     QGraphicsView ( parent ),
 
@@ -76,6 +99,8 @@ GraphicsEHSI::GraphicsEHSI( QWidget *parent ) :
     _devBarDeltaY_new ( 0.0f ),
     _devBarDeltaY_old ( 0.0f ),
 
+    _dirty ( true ),
+
     _scaleX ( 1.0f ),
     _scaleY ( 1.0f ),
 
@@ -148,60 +173,75 @@ void GraphicsEHSI::reinit()
 
 void GraphicsEHSI::setHeading( float heading )
 {
-    _heading = heading;
+    while ( heading <   0.0f ) heading += 360.0f;
+    while ( heading > 360.0f ) heading -= 360.0f;
 
-    while ( _heading <   0.0f ) _heading += 360.0f;
-    while ( _heading > 360.0f ) _heading -= 360.0f;
+    if ( setValue( &_heading, heading, resAngle ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEHSI::setCourse( float course )
 {
-    _course = course;
+    while ( course <   0.0f ) course += 360.0f;
+    while ( course > 360.0f ) course -= 360.0f;
 
-    while ( _course <   0.0f ) _course += 360.0f;
-    while ( _course > 360.0f ) _course -= 360.0f;
+    if ( setValue( &_course, course, resAngle ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEHSI::setBearing( float bearing, bool visible )
 {
-    _bearing        = bearing;
-    _bearingVisible = visible;
+    while ( bearing <   0.0f ) bearing += 360.0f;
+    while ( bearing > 360.0f ) bearing -= 360.0f;
+
+    if ( setValue( &_bearing, bearing, resAngle ) ) _dirty = true;
 
-    while ( _bearing <   0.0f ) _bearing += 360.0f;
-    while ( _bearing > 360.0f ) _bearing -= 360.0f;
+    if ( _bearingVisible != visible )
+    {
+        _bearingVisible = visible;
+        _dirty = true;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEHSI::setDeviation( float deviation, CDI cdi )
 {
-    _deviation = deviation;
-    _cdi = cdi;
+    if ( deviation < -1.0f ) deviation = -1.0f;
+    if ( deviation >  1.0f ) deviation =  1.0f;
+
+    if ( setValue( &_deviation, deviation, resDeviation ) ) _dirty = true;
 
-    if ( _deviation < -1.0f ) _deviation = -1.0f;
-    if ( _deviation >  1.0f ) _deviation =  1.0f;
+    if ( _cdi != cdi )
+    {
+        _cdi = cdi;
+        _dirty = true;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEHSI::setDistance( float distance, bool visible )
 {
-    _distance        = fabs( distance );
-    _distanceVisible = visible;
+    if ( setValue( &_distance, fabs( distance ), resDistance ) ) _dirty = true;
+
+    if ( _distanceVisible != visible )
+    {
+        _distanceVisible = visible;
+        _dirty = true;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void GraphicsEHSI::setHeadingSel( float heading )
 {
-    _heading_sel = heading;
+    while ( heading <   0.0f ) heading += 360.0f;
+    while ( heading > 360.0f ) heading -= 360.0f;
 
-    while ( _heading_sel <   0.0f ) _heading_sel += 360.0f;
-    while ( _heading_sel > 360.0f ) _heading_sel -= 360.0f;
+    if ( setValue( &_heading_sel, heading, resAngle ) ) _dirty = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -223,7 +263,7 @@ void GraphicsEHSI::timerEvent( QTimerEvent *event )
     QGraphicsView::timerEvent( event );
     ///////////////////////////////////
 
-    if ( isVisible() )
+    if ( isVisible() && _dirty )
     {
         updateView();
 
@@ -242,19 +282,19 @@ void GraphicsEHSI::init()
     reset();
 
     _itemBack = new QGraphicsSvgItem( ":/gui/images/efis/ehsi/ehsi_back.svg" );
-    _itemBack->setCacheMode( QGraphicsItem::NoCache );
+    _itemBack->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemBack->setZValue( _backZ );
     _itemBack->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _scene->addItem( _itemBack );
 
     _itemMask = new QGraphicsSvgItem( ":/gui/images/efis/ehsi/ehsi_mask.svg" );
-    _itemMask->setCacheMode( QGraphicsItem::NoCache );
+    _itemMask->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemMask->setZValue( _maskZ );
     _itemMask->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _scene->addItem( _itemMask );
 
     _itemMark = new QGraphicsSvgItem( ":/gui/images/efis/ehsi/ehsi_mark.svg" );
-    _itemMark->setCacheMode( QGraphicsItem::NoCache );
+    _itemMark->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemMark->setZValue( _markZ );
     _itemMark->setTransform( QTransform::fromScale( _scaleX, _scaleY ), true );
     _scene->addItem( _itemMark );
@@ -318,7 +358,7 @@ void GraphicsEHSI::init()
     _itemCrsText = 0;
 
     _itemCrsText = new QGraphicsTextItem( QString( "CRS 999" ) );
-    _itemCrsText->setCacheMode( QGraphicsItem::NoCache );
+    _itemCrsText->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemCrsText->setZValue( _crsTextZ );
     _itemCrsText->setDefaultTextColor( Colors::_lime );
     _itemCrsText->setFont( Fonts::medium() );
@@ -328,7 +368,7 @@ void GraphicsEHSI::init()
     _scene->addItem( _itemCrsText );
 
     _itemHdgText = new QGraphicsTextItem( QString( "HDG 999" ) );
-    _itemHdgText->setCacheMode( QGraphicsItem::NoCache );
+    _itemHdgText->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemHdgText->setZValue( _hdgTextZ );
     _itemHdgText->setDefaultTextColor( Colors::_magenta );
     _itemHdgText->setFont( Fonts::medium() );
@@ -338,7 +378,7 @@ void GraphicsEHSI::init()
     _scene->addItem( _itemHdgText );
 
     _itemDmeText = new QGraphicsTextItem( QString( "99.9 NM" ) );
-    _itemDmeText->setCacheMode( QGraphicsItem::NoCache );
+    _itemDmeText->setCacheMode( QGraphicsItem::DeviceCoordinateCache );
     _itemDmeText->setZValue( _dmeTextZ );
     _itemDmeText->setDefaultTextColor( Colors::_white );
     _itemDmeText->setFont( Fonts::medium() );
@@ -480,7 +520,8 @@ void GraphicsEHSI::updateView()
         _itemDmeText->setVisible( false );
     }
 
-    _scene->update();
-
+    // items schedule repaint of their own regions only
     centerOn( width() / 2.0f , height() / 2.0f );
+
+    _dirty = false;
 }
@@ -33,6 +33,10 @@
 
 /**
  * @brief This class provides EHSI widget.
+ *
+ * View is updated only if any displayed value has changed more than
+ * the display resolution. Static artwork and text items are cached
+ * in device coordinates, rotating items are drawn directly.
  */
 class GraphicsEHSI : public QGraphicsView
 {
@@ -119,6 +123,8 @@ private:
     float _devBarDeltaY_new;            ///<
     float _devBarDeltaY_old;            ///<
 
+    bool _dirty;                        ///< specifies if any displayed value has changed
+
     float _scaleX;                      ///<
     float _scaleY;                      ///<
 
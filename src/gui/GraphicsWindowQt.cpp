@@ -22,6 +22,8 @@
 
 #include <gui/GraphicsWindowQt.h>
 
+#include <QOpenGLContext>
+
 #include <gui/KeyMap.h>
 
 #include <sim/Log.h>
@@ -30,6 +32,7 @@
 
 GraphicsWindowQt::GraphicsWindowQt( osg::GraphicsContext::Traits *traits ) :
     _widget ( NULLPTR ),
+    _contextThread ( NULLPTR ),
     _realized ( false )
 {
     _traits = traits;
@@ -318,6 +321,30 @@ bool GraphicsWindowQt::makeCurrentImplementation()
         _widget->processDeferredEvents();
     }
 
+#   if QT_VERSION >= 0x050000
+    // context can be made current only in the thread it lives in and it can
+    // be moved only by that thread, so graphics thread waits for GUI thread
+    if ( _realized && _widget->context()->contextHandle()->thread() != QThread::currentThread() )
+    {
+        QMutexLocker lock( &_contextMutex );
+
+        _contextThread = QThread::currentThread();
+        _contextCondition.wakeAll();
+
+        while ( _widget->context()->contextHandle()->thread() != QThread::currentThread() )
+        {
+            if ( !_contextCondition.wait( &_contextMutex, 5000 ) )
+            {
+                Log::e() << "Window context has not been moved to the graphics thread." << std::endl;
+                _contextThread = NULLPTR;
+                return false;
+            }
+        }
+
+        _contextThread = NULLPTR;
+    }
+#   endif
+
     _widget->makeCurrent();
 
     return true;
@@ -367,6 +394,31 @@ void GraphicsWindowQt::runOperations()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+bool GraphicsWindowQt::moveContextToGraphicsThread()
+{
+#   if QT_VERSION >= 0x050000
+    QMutexLocker lock( &_contextMutex );
+
+    while ( !_contextThread )
+    {
+        if ( !_contextCondition.wait( &_contextMutex, 5000 ) )
+        {
+            Log::e() << "Graphics thread has not requested window context." << std::endl;
+            return false;
+        }
+    }
+
+    _widget->doneCurrent();
+    _widget->context()->moveToThread( _contextThread );
+
+    _contextCondition.wakeAll();
+#   endif
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void GraphicsWindowQt::requestWarpPointer( float x, float y )
 {
     if ( _widget )
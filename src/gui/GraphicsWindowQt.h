@@ -34,6 +34,8 @@
 #include <QMutex>
 #include <QQueue>
 #include <QSet>
+#include <QThread>
+#include <QWaitCondition>
 
 #include <Defines.h>
 
@@ -86,6 +88,14 @@ public:
 
     virtual void requestWarpPointer( float x, float y );
 
+    /**
+     * @brief Moves OpenGL context to the graphics thread.
+     * Must be called from the GUI thread after viewer threads are started,
+     * when viewer runs multi-threaded (graphics thread owns the context).
+     * @return true on success, false on failure
+     */
+    bool moveContextToGraphicsThread();
+
     inline       GLWidget* getGLWidget()       { return _widget; }
     inline const GLWidget* getGLWidget() const { return _widget; }
 
@@ -150,6 +160,10 @@ private:
     GLWidget *_widget;          ///<
     QCursor _currentCursor;     ///<
 
+    QMutex _contextMutex;               ///< context thread handoff mutex
+    QWaitCondition _contextCondition;   ///< context thread handoff condition
+    QThread *_contextThread;            ///< thread waiting for the context
+
     bool _ownsWidget;           ///<
     bool _realized;             ///<
 };
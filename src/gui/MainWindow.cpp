@@ -35,14 +35,19 @@
 
 #include <cgi/cgi_Manager.h>
 
+#include <fdm/main/fdm_Recorder.h>
 #include <fdm/utils/fdm_Units.h>
 
 #include <hid/hid_Manager.h>
 #include <gui/gui_Defines.h>
 
 #include <gui/KeyMap.h>
+#include <gui/RenderBenchmark.h>
 #include <gui/ScreenSaver.h>
 
+#include <sim/IdleMode.h>
+#include <sim/Path.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 QString getTempFile()
@@ -57,7 +62,7 @@ QString getTempFile()
     result = QDir::homePath() + "/";
 #   endif
 
-    result += "fdm_temp_rec.csv";
+    result += "fdm_temp_rec.rec";
 
     return result;
 }
@@ -113,6 +118,10 @@ MainWindow::MainWindow( QWidget *parent ) :
 
     _timerId ( 0 ),
 
+#   ifdef SIM_LOW_POWER_IDLE
+    _idle ( false ),
+#   endif
+
     _typeIndex ( 0 ),
 
     _stateInp ( fdm::DataInp::Idle ),
@@ -224,6 +233,7 @@ void MainWindow::setup( Autopilot *ap, g1000::IFD *ifd )
     _ifd = ifd;
 
     _dockAuto->setAutopilot( _ap );
+    _dockEFIS->init( _ifd );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -243,6 +253,11 @@ void MainWindow::init()
 
     updateOutputData();
 
+#   ifdef SIM_RENDER_BENCHMARK
+    RenderBenchmark::instance()->readFile( Path::get( SIM_RENDER_BENCHMARK_FILE ).c_str(),
+                                           SIM_RENDER_BENCHMARK_RESULTS );
+#   endif
+
     _timerId = startTimer( 1000.0 * GUI_TIME_STEP );
 }
 
@@ -314,6 +329,10 @@ void MainWindow::timerEvent( QTimerEvent *event )
     QMainWindow::timerEvent( event );
     /////////////////////////////////
 
+#   ifdef SIM_LOW_POWER_IDLE
+    IdleMode::updateTimer( this, &_timerId, &_idle, GUI_TIME_STEP, SIM_IDLE_TIME_STEP );
+#   endif
+
     _stateOut = Data::get()->stateOut;
 
     if ( _stateOut == fdm::DataOut::Stopped )
@@ -342,6 +361,10 @@ void MainWindow::timerEvent( QTimerEvent *event )
     updateStatusBar();
 
     updateOutputData();
+
+#   ifdef SIM_RENDER_BENCHMARK
+    updateBenchmark();
+#   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -349,7 +372,7 @@ void MainWindow::timerEvent( QTimerEvent *event )
 void MainWindow::flightRecordOpen()
 {
     QString caption = tr( "Open flight..." );
-    QString filter = tr( "CSV (*.csv)" );
+    QString filter = tr( "Flight recording (*.rec);;CSV (*.csv)" );
 
     QString fileName = QFileDialog::getOpenFileName( this, caption, QDir::homePath(),
                                                      filter, &filter );
@@ -366,19 +389,34 @@ void MainWindow::flightRecordOpen()
 void MainWindow::flightRecordSave()
 {
     QString caption = tr( "Save flight as..." );
-    QString filter = tr( "CSV (*.csv)" );
+    QString filterRec = tr( "Flight recording (*.rec)" );
+    QString filterCsv = tr( "CSV (*.csv)" );
+    QString filter = filterRec + ";;" + filterCsv;
+    QString selected = filterRec;
 
     QString fileName = QFileDialog::getSaveFileName( this, caption, QDir::homePath(),
-                                                     filter, &filter );
+                                                     filter, &selected );
 
     if ( fileName.length() > 0 )
     {
-        if ( !fileName.endsWith( ".csv" ) )
+        bool csv = fileName.endsWith( ".csv" ) || ( selected == filterCsv && !fileName.endsWith( ".rec" ) );
+
+        if ( csv && !fileName.endsWith( ".csv" ) ) fileName += ".csv";
+        if ( !csv && !fileName.endsWith( ".rec" ) ) fileName += ".rec";
+
+        bool result = false;
+
+        if ( csv )
         {
-            fileName += ".csv";
+            result = FDM_SUCCESS == fdm::Recorder::exportText( _tmp_file.toLocal8Bit().data(),
+                                                               fileName.toLocal8Bit().data() );
+        }
+        else
+        {
+            result = QFile::copy( _tmp_file, fileName );
         }
 
-        if ( !QFile::copy( _tmp_file, fileName ) )
+        if ( !result )
         {
             QString title = windowTitle();
             QString text = tr( "Error while saving file!" );
@@ -746,16 +784,16 @@ void MainWindow::updateDockCtrl()
 {
     if ( _dockCtrl->isVisible() )
     {
-        _dockCtrl->setCollective( hid::Manager::instance()->getCollective() );
+        _dockCtrl->setCollective( Data::get()->hid.collective );
 
-        _dockCtrl->setCtrlStick( hid::Manager::instance()->getCtrlRoll(),
-                                 hid::Manager::instance()->getCtrlPitch() );
+        _dockCtrl->setCtrlStick( Data::get()->hid.ctrl_roll,
+                                 Data::get()->hid.ctrl_pitch );
 
-        _dockCtrl->setTrimStick( hid::Manager::instance()->getTrimRoll(),
-                                 hid::Manager::instance()->getTrimPitch() );
+        _dockCtrl->setTrimStick( Data::get()->hid.trim_roll,
+                                 Data::get()->hid.trim_pitch );
 
-        _dockCtrl->setCtrlPedals( hid::Manager::instance()->getCtrlYaw() );
-        _dockCtrl->setTrimPedals( hid::Manager::instance()->getTrimYaw() );
+        _dockCtrl->setCtrlPedals( Data::get()->hid.ctrl_yaw );
+        _dockCtrl->setTrimPedals( Data::get()->hid.trim_yaw );
 
         _dockCtrl->setBrakes( Data::get()->controls.brake_l,
                               Data::get()->controls.brake_r );
@@ -795,31 +833,35 @@ void MainWindow::updateDockData()
         }
         else
         {
-            _dockData->setAltitudeASL( Data::get()->ownship.altitude_asl );
-            _dockData->setAltitudeAGL( Data::get()->ownship.altitude_agl );
-
-            _dockData->setAirspeed( Data::get()->ownship.airspeed );
-            _dockData->setIAS( Data::get()->ownship.ias );
-            _dockData->setClimbRate( Data::get()->ownship.climbRate );
-            _dockData->setMachNumber( Data::get()->ownship.machNumber );
-
-            _dockData->setRollAngle( Data::get()->ownship.roll );
-            _dockData->setPitchAngle( Data::get()->ownship.pitch );
-            _dockData->setHeading( Data::get()->ownship.heading );
-
-            _dockData->setAngleOfAttack( Data::get()->ownship.angleOfAttack );
-            _dockData->setSideslipAngle( Data::get()->ownship.sideslipAngle );
-            _dockData->setClimbAngle( Data::get()->ownship.climbAngle );
-            _dockData->setTrackAngle( Data::get()->ownship.trackAngle );
-
-            _dockData->setRollRate( Data::get()->ownship.rollRate );
-            _dockData->setPitchRate( Data::get()->ownship.pitchRate );
-            _dockData->setYawRate( Data::get()->ownship.yawRate );
-            _dockData->setTurnRate( Data::get()->ownship.turnRate );
-
-            _dockData->setGx( Data::get()->ownship.g_force_x );
-            _dockData->setGy( Data::get()->ownship.g_force_y );
-            _dockData->setGz( Data::get()->ownship.g_force_z );
+            DockWidgetData::Snapshot snapshot;
+
+            snapshot.altitude_asl = Data::get()->ownship.altitude_asl;
+            snapshot.altitude_agl = Data::get()->ownship.altitude_agl;
+
+            snapshot.airspeed   = Data::get()->ownship.airspeed;
+            snapshot.ias        = Data::get()->ownship.ias;
+            snapshot.climbRate  = Data::get()->ownship.climbRate;
+            snapshot.machNumber = Data::get()->ownship.machNumber;
+
+            snapshot.rollAngle  = Data::get()->ownship.roll;
+            snapshot.pitchAngle = Data::get()->ownship.pitch;
+            snapshot.heading    = Data::get()->ownship.heading;
+
+            snapshot.angleOfAttack = Data::get()->ownship.angleOfAttack;
+            snapshot.sideslipAngle = Data::get()->ownship.sideslipAngle;
+            snapshot.climbAngle    = Data::get()->ownship.climbAngle;
+            snapshot.trackAngle    = Data::get()->ownship.trackAngle;
+
+            snapshot.rollRate  = Data::get()->ownship.rollRate;
+            snapshot.pitchRate = Data::get()->ownship.pitchRate;
+            snapshot.yawRate   = Data::get()->ownship.yawRate;
+            snapshot.turnRate  = Data::get()->ownship.turnRate;
+
+            snapshot.Gx = Data::get()->ownship.g_force_x;
+            snapshot.Gy = Data::get()->ownship.g_force_y;
+            snapshot.Gz = Data::get()->ownship.g_force_z;
+
+            _dockData->setSnapshot( snapshot );
         }
     }
 }
@@ -934,25 +976,32 @@ void MainWindow::updateDockProp()
 {
     if ( _dockProp->isVisible() )
     {
+        DockWidgetProp::Snapshot snapshot;
+
         for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
         {
-            _dockProp->setState ( i, Data::get()->propulsion.engine[ i ].state );
-            _dockProp->setAB    ( i, Data::get()->propulsion.engine[ i ].afterburner );
-            _dockProp->setRPM   ( i, M_PI * Data::get()->propulsion.engine[ i ].rpm  / 30.0f );
-            _dockProp->setPROP  ( i, M_PI * Data::get()->propulsion.engine[ i ].prop / 30.0f );
-            _dockProp->setNG    ( i, Data::get()->propulsion.engine[ i ].ng  / 100.0f );
-            _dockProp->setN1    ( i, Data::get()->propulsion.engine[ i ].n1  / 100.0f );
-            _dockProp->setN2    ( i, Data::get()->propulsion.engine[ i ].n2  / 100.0f );
-            _dockProp->setTRQ   ( i, Data::get()->propulsion.engine[ i ].trq / 100.0f );
-            _dockProp->setEPR   ( i, Data::get()->propulsion.engine[ i ].epr );
-            _dockProp->setMAP   ( i, Data::get()->propulsion.engine[ i ].map );
-            _dockProp->setEGT   ( i, fdm::Units::c2k( Data::get()->propulsion.engine[ i ].egt ) );
-            _dockProp->setCHT   ( i, fdm::Units::c2k( Data::get()->propulsion.engine[ i ].cht ) );
-            _dockProp->setTIT   ( i, fdm::Units::c2k( Data::get()->propulsion.engine[ i ].tit ) );
-            _dockProp->setTOT   ( i, fdm::Units::c2k( Data::get()->propulsion.engine[ i ].egt ) );
-            _dockProp->setITT   ( i, fdm::Units::c2k( Data::get()->propulsion.engine[ i ].itt ) );
-            _dockProp->setFF    ( i, Data::get()->propulsion.engine[ i ].fuelFlow );
+            DockWidgetProp::Engine &engine = snapshot.engine[ i ];
+
+            engine.state       = Data::get()->propulsion.engine[ i ].state;
+            engine.afterburner = Data::get()->propulsion.engine[ i ].afterburner;
+
+            engine.rpm  = M_PI * Data::get()->propulsion.engine[ i ].rpm  / 30.0f;
+            engine.prop = M_PI * Data::get()->propulsion.engine[ i ].prop / 30.0f;
+            engine.ng   = Data::get()->propulsion.engine[ i ].ng  / 100.0f;
+            engine.n1   = Data::get()->propulsion.engine[ i ].n1  / 100.0f;
+            engine.n2   = Data::get()->propulsion.engine[ i ].n2  / 100.0f;
+            engine.trq  = Data::get()->propulsion.engine[ i ].trq / 100.0f;
+            engine.epr  = Data::get()->propulsion.engine[ i ].epr;
+            engine.map  = Data::get()->propulsion.engine[ i ].map;
+            engine.egt  = fdm::Units::c2k( Data::get()->propulsion.engine[ i ].egt );
+            engine.cht  = fdm::Units::c2k( Data::get()->propulsion.engine[ i ].cht );
+            engine.tit  = fdm::Units::c2k( Data::get()->propulsion.engine[ i ].tit );
+            engine.tot  = fdm::Units::c2k( Data::get()->propulsion.engine[ i ].egt );
+            engine.itt  = fdm::Units::c2k( Data::get()->propulsion.engine[ i ].itt );
+            engine.ff   = Data::get()->propulsion.engine[ i ].fuelFlow;
         }
+
+        _dockProp->setSnapshot( snapshot );
     }
 }
 
@@ -1043,6 +1092,15 @@ void MainWindow::updateStatusBar()
     QString text = "";
 
     text += tr( "Time Coef: " ) + QString::number( _timeCoef, 'd', 1 );
+
+    double timeCoefMax = Data::get()->timeCoefMax;
+
+    if ( _stateOut == fdm::DataOut::Working
+      && timeCoefMax > 0.0 && timeCoefMax < _timeCoef )
+    {
+        text += tr( " (max: " ) + QString::number( timeCoefMax, 'd', 1 ) + ")";
+    }
+
     text += "   ";
     text += tr( "Frame Rate: " ) + QString::number( frameRate, 'd', 2 );
 
@@ -1053,7 +1111,7 @@ void MainWindow::updateStatusBar()
 
 void MainWindow::updateOutputData()
 {
-    Aircrafts::Aircraft aircraft = Aircrafts::instance()->getAircraft( _dialogInit->getTypeIndex() );
+    Aircrafts::Aircraft aircraft = getCurrentAircraft();
 
     // CGI - airport
     Data::get()->cgi.airport.lightsHELI = _ui->actionAirportLightsHELI->isChecked();
@@ -1160,11 +1218,17 @@ void MainWindow::updateOutputData()
     {
         Data::get()->recording.mode = fdm::DataInp::Recording::Replay;
         strncpy( Data::get()->recording.file, _rec_file.toLocal8Bit().data(), 4095 );
+#       ifdef SIM_REPLAY_DIRECT
+        Data::get()->recording.rate   = SIM_REPLAY_RATE;
+        Data::get()->recording.direct = true;
+#       endif
     }
     else
     {
         Data::get()->recording.mode = fdm::DataInp::Recording::Record;
         strncpy( Data::get()->recording.file, _tmp_file.toLocal8Bit().data(), 4095 );
+        Data::get()->recording.rate   = 0.0;
+        Data::get()->recording.direct = false;
     }
 
     Data::get()->sfx.volume = (double)_dialogConf->getSoundVolume() / 100.0;
@@ -1186,6 +1250,51 @@ void MainWindow::updateOutputData()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifdef SIM_RENDER_BENCHMARK
+void MainWindow::updateBenchmark()
+{
+    RenderBenchmark *benchmark = RenderBenchmark::instance();
+
+    if ( !benchmark->isRunning() ) return;
+
+    const RenderBenchmark::Scene &scene = benchmark->getScene();
+
+    // state changes are published with the next output data update
+    if ( _stateInp == fdm::DataInp::Idle && _stateOut == fdm::DataOut::Idle )
+    {
+        if ( _typeIndex != scene.typeIndex )
+        {
+            // aircraft type has to be published before initialization
+            setAircraftType( scene.typeIndex );
+        }
+        else
+        {
+            _rec_file = scene.recording;
+            setStateInit();
+        }
+    }
+    else if ( _stateInp == fdm::DataInp::Init && _stateOut == fdm::DataOut::Ready )
+    {
+        setStateWork();
+    }
+    else if ( _stateInp == fdm::DataInp::Work && benchmark->isSceneDone() )
+    {
+        setStateStop();
+    }
+    else if ( _stateInp == fdm::DataInp::Stop && _stateOut == fdm::DataOut::Stopped )
+    {
+        benchmark->nextScene();
+        setStateIdle();
+    }
+
+    // scene conditions override dialogs and elapsed time
+    Data::get()->cgi.environment = scene.environment;
+    Data::get()->dateTime = scene.dateTime;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 void MainWindow::on_actionDialogConf_triggered()
 {
     _dialogConf->readData();
@@ -158,6 +158,10 @@ private:
 
     int _timerId;                       ///< timer ID
 
+#   ifdef SIM_LOW_POWER_IDLE
+    bool _idle;                         ///< specifies if timer ticks with idle period
+#   endif
+
     int _typeIndex;                     ///< aircraft type index
 
     fdm::DataInp::StateInp _stateInp;   ///< simulation input state
@@ -206,6 +210,15 @@ private:
 
     void updateOutputData();
 
+#   ifdef SIM_RENDER_BENCHMARK
+    /**
+     * @brief Runs render benchmark scenes.
+     * Scenes are flown one after another through the regular simulation
+     * states, scene conditions override the output data.
+     */
+    void updateBenchmark();
+#   endif
+
 private slots:
 
     void on_actionDialogConf_triggered();
@@ -0,0 +1,412 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <gui/RenderBenchmark.h>
+
+#include <fstream>
+#include <iomanip>
+
+#include <QDateTime>
+#include <QDomDocument>
+#include <QFile>
+
+#include <cgi/cgi_Defines.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+const double percents[] = { 50.0, 95.0, 99.0 };     ///< [%] reported percentiles
+
+/** Returns true if camera renders OTW scene (including channels). */
+bool isCameraOTW( const osg::Camera *camera )
+{
+    const std::string &name = camera->getName();
+
+    return 0 == name.compare( "OTW" ) || 0 == name.compare( 0, 4, "OTW_" );
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+RenderBenchmark::RenderBenchmark() :
+    _cpu   ( 1.0e-6, 1.0 ),
+    _gpu   ( 1.0e-6, 1.0 ),
+    _draws ( 1.0, 1.0e6 ),
+
+    _index ( 0 ),
+    _frames ( 0 ),
+    _frameNumber ( 0 ),
+
+    _collecting ( false ),
+    _sceneDone ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RenderBenchmark::~RenderBenchmark() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::readFile( const char *file, const char *results )
+{
+    _scenes.clear();
+    _results.clear();
+
+    _resultsFile = results;
+
+    QFile qfile( file );
+
+    if ( qfile.open( QFile::ReadOnly | QFile::Text ) )
+    {
+        QDomDocument doc;
+
+        doc.setContent( &qfile, false );
+
+        QDomElement rootNode = doc.documentElement();
+
+        if ( rootNode.tagName() == "render_benchmark" )
+        {
+            QDomElement sceneNode = rootNode.firstChildElement( "scene" );
+
+            while ( !sceneNode.isNull() )
+            {
+                parseScene( sceneNode );
+                sceneNode = sceneNode.nextSiblingElement( "scene" );
+            }
+        }
+    }
+    else
+    {
+        Log::e() << "Cannot open render benchmark file \"" << file << "\"." << std::endl;
+    }
+
+    _index = 0;
+    _frames = 0;
+    _frameNumber = 0;
+    _sceneDone = false;
+
+    Log::i() << "Render benchmark started with " << _scenes.size() << " scene(s)." << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::nextScene()
+{
+    if ( !isRunning() ) return;
+
+    Result result;
+
+    result.name   = getScene().name;
+    result.frames = (unsigned int)_cpu.getCount();
+
+    double values[ 3 ];
+
+    _cpu.getPercentiles( percents, values, 3 );
+
+    result.cpu_p50 = values[ 0 ];
+    result.cpu_p95 = values[ 1 ];
+    result.cpu_p99 = values[ 2 ];
+    result.cpu_max = _cpu.getMax();
+
+    _gpu.getPercentiles( percents, values, 3 );
+
+    result.gpu_p50 = values[ 0 ];
+    result.gpu_p95 = values[ 1 ];
+    result.gpu_p99 = values[ 2 ];
+    result.gpu_max = _gpu.getMax();
+
+    result.draws_avg = _draws.getMean();
+    result.draws_max = _draws.getMax();
+
+    _results.push_back( result );
+
+    Log::i() << "Render benchmark scene \"" << result.name.toStdString() << "\" finished with "
+             << result.frames << " frame(s) measured." << std::endl;
+
+    _cpu.reset();
+    _gpu.reset();
+    _draws.reset();
+
+    // frames without statistics yet belong to the finished scene
+    _pending.clear();
+
+    _index++;
+    _frames = 0;
+    _frameNumber = 0;
+    _sceneDone = false;
+
+    if ( !isRunning() )
+    {
+        writeResults();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::update( osgViewer::Viewer *viewer )
+{
+    if ( !isRunning() ) return;
+
+    if ( !_collecting )
+    {
+        collect( viewer );
+        _collecting = true;
+    }
+
+    readStats( viewer );
+
+    if ( _sceneDone || Data::get()->stateOut != fdm::DataOut::Working ) return;
+
+    // viewer frame number of the upcoming frame() call
+    unsigned int frameNumber = viewer->getFrameStamp()->getFrameNumber() + 1;
+
+    if ( _frameNumber > 0 )
+    {
+        // the next frame is not requested until the simulated one is rendered,
+        // otherwise the late latch might render the next frame pose
+        if ( frameNumber <= _frameNumber ) return;
+
+        // replay time of the rendered frame since the scene start
+        double time = _frames * SIM_RENDER_BENCHMARK_FRAME_STEPS * FDM_TIME_STEP;
+
+        _frames++;
+
+        if ( time >= getScene().warmup )
+        {
+            _pending.push_back( _frameNumber );
+        }
+
+        _sceneDone = time >= getScene().warmup + getScene().duration;
+        _frameNumber = 0;
+
+        if ( !_sceneDone )
+        {
+            Data::get()->benchmark.frameInp++;
+        }
+    }
+    else if ( Data::get()->benchmark.frameOut == Data::get()->benchmark.frameInp )
+    {
+        // requested frame has been simulated and its output data fetched
+        _frameNumber = frameNumber;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::collect( osgViewer::Viewer *viewer )
+{
+    viewer->getViewerStats()->collectStats( "update", true );
+
+    osgViewer::ViewerBase::Cameras cameras;
+    viewer->getCameras( cameras );
+
+    for ( osgViewer::ViewerBase::Cameras::iterator it = cameras.begin(); it != cameras.end(); ++it )
+    {
+        if ( isCameraOTW( *it ) )
+        {
+            if ( !(*it)->getStats() )
+            {
+                (*it)->setStats( new osg::Stats( "Camera" ) );
+            }
+
+            (*it)->getStats()->collectStats( "rendering" , true );
+            (*it)->getStats()->collectStats( "gpu"       , true );
+            (*it)->getStats()->collectStats( "scene"     , true );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::readStats( osgViewer::Viewer *viewer )
+{
+    const osg::Stats *viewerStats = viewer->getViewerStats();
+
+    unsigned int latest = viewerStats->getLatestFrameNumber();
+
+    osgViewer::ViewerBase::Cameras cameras;
+    viewer->getCameras( cameras );
+
+    Frames::iterator it = _pending.begin();
+
+    while ( it != _pending.end() )
+    {
+        unsigned int f = *it;
+
+        // frame might be still drawn by the graphics thread
+        if ( f >= latest ) break;
+
+        double cpu   = 0.0;
+        double gpu   = 0.0;
+        double draws = 0.0;
+        double temp  = 0.0;
+
+        bool valid = true;
+
+        if ( viewerStats->getAttribute( f, "Update traversal time taken", temp ) ) cpu += temp;
+
+        for ( osgViewer::ViewerBase::Cameras::iterator c = cameras.begin(); c != cameras.end(); ++c )
+        {
+            const osg::Stats *stats = (*c)->getStats();
+
+            if ( stats && isCameraOTW( *c ) )
+            {
+                // channels are summed up
+                if ( stats->getAttribute( f, "Cull traversal time taken"   , temp ) ) cpu   += temp;
+                if ( stats->getAttribute( f, "Draw traversal time taken"   , temp ) ) cpu   += temp;
+                if ( stats->getAttribute( f, "Visible number of drawables" , temp ) ) draws += temp;
+
+                if ( stats->getAttribute( f, "GPU draw time taken", temp ) )
+                    gpu += temp;
+                else
+                    valid = false;
+            }
+        }
+
+        // timer queries results are available a few frames later
+        if ( !valid && f + CGI_FRAME_STATS_GPU_LAG > latest ) break;
+
+        _cpu.add( cpu );
+        _draws.add( draws );
+
+        if ( valid ) _gpu.add( gpu );
+
+        it = _pending.erase( it );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::parseScene( const QDomElement &node )
+{
+    Scene scene;
+
+    scene.name = node.attributeNode( "name" ).value();
+
+    QDomElement recordingNode  = node.firstChildElement( "recording"  );
+    QDomElement aircraftNode   = node.firstChildElement( "aircraft"   );
+    QDomElement dateTimeNode   = node.firstChildElement( "date_time"  );
+    QDomElement visibilityNode = node.firstChildElement( "visibility" );
+    QDomElement cloudsNode     = node.firstChildElement( "clouds"     );
+    QDomElement warmupNode     = node.firstChildElement( "warmup"     );
+    QDomElement durationNode   = node.firstChildElement( "duration"   );
+
+    QDateTime dateTime = QDateTime::fromString( dateTimeNode.text(), Qt::ISODate );
+
+    if ( recordingNode.isNull() || aircraftNode.isNull() || !dateTime.isValid()
+      || visibilityNode.isNull() || durationNode.isNull() )
+    {
+        Log::w() << "Render benchmark scene \"" << scene.name.toStdString() << "\" is incomplete." << std::endl;
+        return;
+    }
+
+    scene.recording = recordingNode.text();
+    scene.typeIndex = aircraftNode.text().toInt();
+
+    scene.dateTime.year   = (unsigned short)dateTime.date().year();
+    scene.dateTime.month  = (unsigned short)dateTime.date().month();
+    scene.dateTime.day    = (unsigned short)dateTime.date().day();
+    scene.dateTime.hour   = (unsigned short)dateTime.time().hour();
+    scene.dateTime.minute = (unsigned short)dateTime.time().minute();
+    scene.dateTime.second = (unsigned short)dateTime.time().second();
+
+    scene.environment.visibility = visibilityNode.text().toDouble();
+
+    parseClouds( cloudsNode, scene.environment.clouds );
+
+    scene.warmup   = warmupNode.isNull() ? 0.0 : warmupNode.text().toDouble();
+    scene.duration = durationNode.text().toDouble();
+
+    _scenes.push_back( scene );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::parseClouds( const QDomElement &node, Data::CGI::Environment::Clouds &clouds )
+{
+    QString type = node.attributeNode( "type" ).value();
+
+    if ( type == "block" )
+    {
+        clouds.type = Data::CGI::Environment::Clouds::Block;
+
+        clouds.data.block.count     = (short)node.attributeNode( "count" ).value().toInt();
+        clouds.data.block.base_asl  = node.attributeNode( "base_asl"  ).value().toDouble();
+        clouds.data.block.thickness = node.attributeNode( "thickness" ).value().toDouble();
+    }
+    else if ( type == "layer" )
+    {
+        clouds.type = Data::CGI::Environment::Clouds::Layer;
+
+        clouds.data.layer.cover    = (Data::CGI::Environment::Clouds::Data::Layer::Cover)node.attributeNode( "cover" ).value().toInt();
+        clouds.data.layer.base_asl = node.attributeNode( "base_asl" ).value().toDouble();
+    }
+    else
+    {
+        clouds.type = Data::CGI::Environment::Clouds::None;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RenderBenchmark::writeResults()
+{
+    std::fstream out( _resultsFile.c_str(), std::ios_base::out );
+
+    if ( !out.is_open() )
+    {
+        Log::e() << "Cannot open render benchmark results file \"" << _resultsFile << "\"." << std::endl;
+        return;
+    }
+
+    out << "scene,frames"
+        << ",cpu_p50_ms,cpu_p95_ms,cpu_p99_ms,cpu_max_ms"
+        << ",gpu_p50_ms,gpu_p95_ms,gpu_p99_ms,gpu_max_ms"
+        << ",draws_avg,draws_max" << std::endl;
+
+    for ( Results::const_iterator it = _results.begin(); it != _results.end(); ++it )
+    {
+        out << std::setprecision( 6 )
+            << it->name.toStdString() << ","
+            << it->frames << ","
+            << 1.0e3 * it->cpu_p50 << ","
+            << 1.0e3 * it->cpu_p95 << ","
+            << 1.0e3 * it->cpu_p99 << ","
+            << 1.0e3 * it->cpu_max << ","
+            << 1.0e3 * it->gpu_p50 << ","
+            << 1.0e3 * it->gpu_p95 << ","
+            << 1.0e3 * it->gpu_p99 << ","
+            << 1.0e3 * it->gpu_max << ","
+            << it->draws_avg << ","
+            << it->draws_max
+            << "\n";
+    }
+
+    out.close();
+
+    Log::i() << "Render benchmark results written to \"" << _resultsFile << "\"." << std::endl;
+}
@@ -0,0 +1,186 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef RENDERBENCHMARK_H
+#define RENDERBENCHMARK_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <QDomElement>
+#include <QString>
+
+#include <osgViewer/Viewer>
+
+#include <fdm/utils/fdm_Histogram.h>
+
+#include <Data.h>
+
+#include <sim/Singleton.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Render benchmark class.
+ *
+ * Benchmark replays recorded flights through the whole CGI with fixed
+ * conditions. Simulation is stepped by rendered frames (see Simulation),
+ * every measured frame is rendered only after the frame requested before has
+ * been simulated and the next one is requested only after it has been
+ * rendered, so each run renders exactly the same frames regardless of
+ * rendering performance.
+ *
+ * Scenes are read from XML file, every scene gives recording file, aircraft
+ * type index, date and time, clouds, visibility, warm-up and measured replay
+ * times. Frame CPU time (update, OTW cull and draw), OTW GPU time and number
+ * of OTW drawables drawn (draw calls) are collected for every measured frame,
+ * their percentiles are written into CSV file after the last scene.
+ *
+ * Used only if SIM_RENDER_BENCHMARK is defined.
+ *
+ * @see Simulation
+ */
+class RenderBenchmark : public Singleton< RenderBenchmark >
+{
+    friend class Singleton< RenderBenchmark >;
+
+public:
+
+    /** Scene data. */
+    struct Scene
+    {
+        QString name;                           ///< scene name
+        QString recording;                      ///< recording file path
+
+        int typeIndex;                          ///< aircraft type index
+
+        Data::DateTime dateTime;                ///< date and time
+        Data::CGI::Environment environment;     ///< clouds and visibility
+
+        double warmup;                          ///< [s] replay time before measurement
+        double duration;                        ///< [s] measured replay time
+    };
+
+    /** Scene result. */
+    struct Result
+    {
+        QString name;                           ///< scene name
+
+        unsigned int frames;                    ///< number of measured frames
+
+        double cpu_p50;                         ///< [s] frame CPU time median
+        double cpu_p95;                         ///< [s] frame CPU time 95th percentile
+        double cpu_p99;                         ///< [s] frame CPU time 99th percentile
+        double cpu_max;                         ///< [s] frame CPU time maximum
+
+        double gpu_p50;                         ///< [s] frame GPU time median
+        double gpu_p95;                         ///< [s] frame GPU time 95th percentile
+        double gpu_p99;                         ///< [s] frame GPU time 99th percentile
+        double gpu_max;                         ///< [s] frame GPU time maximum
+
+        double draws_avg;                       ///< averaged number of draw calls
+        double draws_max;                       ///< maximum number of draw calls
+    };
+
+    typedef std::vector< Scene  > Scenes;
+    typedef std::vector< Result > Results;
+
+    /** @brief Destructor. */
+    virtual ~RenderBenchmark();
+
+    /**
+     * @brief Reads scenes file and starts benchmark.
+     * @param file scenes file path
+     * @param results results file path
+     */
+    void readFile( const char *file, const char *results );
+
+    /**
+     * @brief Finishes current scene and starts the next one.
+     * Results are written after the last scene.
+     */
+    void nextScene();
+
+    /**
+     * @brief Updates benchmark.
+     * Should be called once per OTW widget timer event.
+     * @param viewer OTW viewer
+     */
+    void update( osgViewer::Viewer *viewer );
+
+    /** @return true if current scene measurement is done */
+    inline bool isSceneDone() const { return _sceneDone; }
+
+    /** @return true if there are scenes left */
+    inline bool isRunning() const { return _index < _scenes.size(); }
+
+    /** @return current scene (valid only if benchmark is running) */
+    inline const Scene& getScene() const { return _scenes.at( _index ); }
+
+private:
+
+    typedef std::vector< unsigned int > Frames;
+
+    Scenes  _scenes;                ///< scenes
+    Results _results;               ///< finished scenes results
+
+    std::string _resultsFile;       ///< results file path
+
+    fdm::Histogram _cpu;            ///< frame CPU time histogram
+    fdm::Histogram _gpu;            ///< frame GPU time histogram
+    fdm::Histogram _draws;          ///< number of draw calls histogram
+
+    Frames _pending;                ///< rendered frames waiting for statistics
+
+    unsigned int _index;            ///< current scene index
+    unsigned int _frames;           ///< number of frames of the current scene rendered
+    unsigned int _frameNumber;      ///< viewer frame number which renders the most recent simulated frame (0 if none)
+
+    bool _collecting;               ///< specifies if viewer statistics collecting is enabled
+    bool _sceneDone;                ///< specifies if current scene measurement is done
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to RenderBenchmark class instance.
+     */
+    RenderBenchmark();
+
+    /** Using this constructor is forbidden. */
+    RenderBenchmark( const RenderBenchmark & ) : Singleton< RenderBenchmark >() {}
+
+    /** Enables collecting viewer and OTW cameras statistics. */
+    void collect( osgViewer::Viewer *viewer );
+
+    /** Reads statistics of the pending frames available from the viewer. */
+    void readStats( osgViewer::Viewer *viewer );
+
+    void parseScene( const QDomElement &node );
+    void parseClouds( const QDomElement &node, Data::CGI::Environment::Clouds &clouds );
+
+    /** Writes results into results file. */
+    void writeResults();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // RENDERBENCHMARK_H
@@ -74,6 +74,8 @@ WidgetCGI::WidgetCGI( QWidget *parent ) :
         _initialized = true;
     });
 #   else
+    setThreadingModel( osgViewer::ViewerBase::SIM_OSG_THREADING_MODEL );
+
     QWidget *widget = addViewWidget();
 
     _layout = new QGridLayout( this );
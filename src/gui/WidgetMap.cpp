@@ -33,6 +33,7 @@
 #include <osgViewer/ViewerEventHandlers>
 
 #include <cgi/cgi_Defines.h>
+#include <cgi/cgi_FrameStats.h>
 #include <cgi/cgi_Manager.h>
 #include <cgi/cgi_Mercator.h>
 
@@ -279,6 +280,8 @@ void WidgetMap::timerEvent( QTimerEvent *event )
 
     cgi::Manager::instance()->updateMap();
 
+    cgi::FrameStats::instance()->update( getOsgViewer() );
+
     updateMouseGeoPositionStr( _manipulator->getMouseLat(),
                                _manipulator->getMouseLon() );
 
@@ -310,6 +313,8 @@ void WidgetMap::createCameraMap()
 {
     osg::ref_ptr<osg::Camera> cameraMap = getOsgViewer()->getCamera();
 
+    cameraMap->setName( "Map" );
+
 #   ifndef USE_OSGQOPENGL
     cameraMap->setGraphicsContext( _gwin );
 #   endif
@@ -332,6 +337,8 @@ void WidgetMap::createCameraMap()
         cameraMap->setProjectionMatrixAsOrtho2D( -CGI_MAP_Y_2 * w2h, CGI_MAP_Y_2 * w2h, -CGI_MAP_Y_2, CGI_MAP_Y_2 );
         cameraMap->setViewMatrix( osg::Matrix::identity() );
     }
+
+    cgi::FrameStats::collect( cameraMap.get() );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,6 +24,16 @@
 
 #include <QDebug>
 
+#include <fdm/utils/fdm_Time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+double WidgetOSG::_firstFrameTime = 0.0;
+
+#if defined(SIM_OSG_SHARED_CONTEXT) && !defined(USE_OSGQOPENGL)
+osg::observer_ptr<GraphicsWindowQt> WidgetOSG::_sharedContext;
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 WidgetOSG::WidgetOSG( QWidget *parent ) :
@@ -88,7 +98,23 @@ void WidgetOSG::paintEvent( QPaintEvent *event )
     QWidget::paintEvent( event );
     /////////////////////////////
 
+    // multi-threaded viewer, graphics thread has to own the context before
+    // the first frame, otherwise GUI thread waits for it forever
+    if ( !isRealized() && getThreadingModel() != osgViewer::ViewerBase::SingleThreaded )
+    {
+        realize();
+        startThreading();
+
+        if ( _gwin.valid() && !_gwin->moveContextToGraphicsThread() )
+        {
+            stopThreading();
+            setThreadingModel( osgViewer::ViewerBase::SingleThreaded );
+        }
+    }
+
     frame();
+
+    if ( _firstFrameTime == 0.0 ) _firstFrameTime = fdm::Time::get();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -111,9 +137,33 @@ osg::ref_ptr<GraphicsWindowQt> WidgetOSG::createGraphicsWindow( int x, int y, in
     traits->samples          = 4;
     traits->vsync            = true;
 
+#   ifdef SIM_OSG_SHARED_CONTEXT
+    if ( _sharedContext.valid() )
+    {
+        traits->sharedContext = _sharedContext.get();
+        traits->vsync         = false;
+    }
+#   endif
+
     osg::ref_ptr<GraphicsWindowQt> graphicsWindow = new GraphicsWindowQt( traits.get() );
 
+#   ifdef SIM_OSG_SHARED_CONTEXT
+    if ( !_sharedContext.valid() )
+    {
+        _sharedContext = graphicsWindow.get();
+    }
+#   endif
+
     return graphicsWindow;
 }
+#else
+void WidgetOSG::paintGL()
+{
+    ////////////////////////////
+    osgQOpenGLWidget::paintGL();
+    ////////////////////////////
+
+    if ( _firstFrameTime == 0.0 ) _firstFrameTime = fdm::Time::get();
+}
 #endif
 
@@ -28,6 +28,8 @@
 #include <QGridLayout>
 #include <QWidget>
 
+#include <osg/observer_ptr>
+
 #include <osgViewer/Viewer>
 #include <osgGA/GUIEventHandler>
 
@@ -43,6 +45,14 @@
 
 /**
  * @brief OSG common widget class.
+ *
+ * When SIM_OSG_SHARED_CONTEXT is defined all OSG widgets share the graphics
+ * context of the first created one, so textures, fonts and buffer objects are
+ * uploaded once and not per widget. Widgets are then drawn single-threaded by
+ * the GUI thread and only the first widget waits for vertical sync, so
+ * widgets drawn in the same GUI loop iteration do not wait for vertical sync
+ * each in turn. Per-context GL objects which are not shared between contexts
+ * (e.g. frame buffer objects) have to be used by a single widget only.
  */
 #ifdef USE_OSGQOPENGL
 class WidgetOSG : public osgQOpenGLWidget
@@ -54,6 +64,12 @@ class WidgetOSG : public QWidget, public osgViewer::Viewer
 
 public:
 
+    /**
+     * @brief Returns time of the first frame drawn by any OSG widget.
+     * @return [s] monotonic clock time, 0.0 if no frame has been drawn yet
+     */
+    inline static double getFirstFrameTime() { return _firstFrameTime; }
+
     /** @brief Constructor. */
     WidgetOSG( QWidget *parent = NULLPTR );
 
@@ -66,6 +82,12 @@ public:
 
 protected:
 
+    static double _firstFrameTime;          ///< [s] monotonic clock time of the first frame
+
+#   if defined(SIM_OSG_SHARED_CONTEXT) && !defined(USE_OSGQOPENGL)
+    static osg::observer_ptr<GraphicsWindowQt> _sharedContext;  ///< graphics window all widgets share context with
+#   endif
+
 #   ifndef USE_OSGQOPENGL
     QGridLayout *_layout;                   ///<
 
@@ -80,6 +102,9 @@ protected:
 
     /** */
     virtual osg::ref_ptr<GraphicsWindowQt> createGraphicsWindow( int x, int y, int w, int h );
+#   else
+    /** */
+    virtual void paintGL();
 #   endif
 };
 
@@ -28,10 +28,49 @@
 #include <osgViewer/ViewerEventHandlers>
 
 #include <cgi/cgi_Defines.h>
+#include <cgi/cgi_FrameStats.h>
 #include <cgi/cgi_Manager.h>
 #include <cgi/cgi_WGS84.h>
 
+#include <fdm/utils/fdm_Time.h>
+
 #include <gui/gui_Defines.h>
+#include <gui/RenderBenchmark.h>
+
+#include <sim/IdleMode.h>
+
+#ifdef SIM_CLUSTER_SYNC
+#   include <sim/ClusterSync.h>
+#endif
+
+#ifdef SIM_HEAD_TRACKING
+#   include <sim/HeadTracker.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(SIM_CLUSTER_SYNC) && !defined(USE_OSGQOPENGL)
+namespace
+{
+
+/** Buffers swap callback aligning swaps across cluster nodes. */
+class ClusterSwapCallback : public osg::GraphicsContext::SwapCallback
+{
+public:
+
+    virtual void swapBuffersImplementation( osg::GraphicsContext *gc )
+    {
+        // frame is finished before reporting readiness, so swap is not delayed by queued commands
+        glFinish();
+
+        ClusterSync::instance()->barrier();
+
+        gc->swapBuffersImplementation();
+    }
+};
+
+} // end of anonymous namespace
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -44,6 +83,14 @@ WidgetOTW::WidgetOTW( QWidget *parent ) :
     WidgetOSG ( parent ),
     _timerId ( 0 ),
     _camManipulatorInited ( false )
+#   ifdef SIM_LOW_POWER_IDLE
+    ,
+    _redrawTime ( 0.0 )
+#   endif
+#   if defined(CGI_DYNAMIC_RESOLUTION) && !defined(USE_OSGQOPENGL)
+    ,
+    _dynamicResolution ( NULLPTR )
+#   endif
 {
     _keyHandler = new KeyHandler( this );
 
@@ -81,6 +128,9 @@ WidgetOTW::WidgetOTW( QWidget *parent ) :
 
         getOsgViewer()->setKeyEventSetsDone( 0 );
 
+        // paged terrain tiles memory bound
+        getOsgViewer()->getDatabasePager()->setTargetMaximumNumberOfPageLOD( CGI_TERRAIN_MAX_PAGED_LOD );
+
         ///////////////////////////////////////////////////////////////////////
         getOsgViewer()->setSceneData( cgi::Manager::instance()->getNodeOTW() );
         ///////////////////////////////////////////////////////////////////////
@@ -92,6 +142,8 @@ WidgetOTW::WidgetOTW( QWidget *parent ) :
         setCameraManipulatorPilot();
     });
 #   else
+    setThreadingModel( osgViewer::ViewerBase::SIM_OSG_THREADING_MODEL );
+
     QWidget *widget = addViewWidget();
 
     _layout = new QGridLayout( this );
@@ -102,6 +154,9 @@ WidgetOTW::WidgetOTW( QWidget *parent ) :
 
     getEventHandlers().push_front( _keyHandler.get() );
 
+    // paged terrain tiles memory bound
+    getDatabasePager()->setTargetMaximumNumberOfPageLOD( CGI_TERRAIN_MAX_PAGED_LOD );
+
     setCameraManipulatorPilot();
 #   endif
 }
@@ -111,6 +166,10 @@ WidgetOTW::WidgetOTW( QWidget *parent ) :
 WidgetOTW::~WidgetOTW()
 {
     if ( _timerId ) killTimer( _timerId );
+
+#   if defined(CGI_DYNAMIC_RESOLUTION) && !defined(USE_OSGQOPENGL)
+    DELPTR( _dynamicResolution );
+#   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -213,12 +272,46 @@ void WidgetOTW::setDistanceDef( double distance_def )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifndef USE_OSGQOPENGL
+void WidgetOTW::renderingTraversals()
+{
+    if ( _initialized )
+    {
+        cgi::Manager::instance()->latchOTW();
+
+        // view matrix set by the update traversal is replaced with the latched one
+        if ( getCameraManipulator() )
+        {
+            getCamera()->setViewMatrix( getCameraManipulator()->getInverseMatrix() );
+            updateSlaves();
+        }
+    }
+
+    ////////////////////////////////////////////
+    osgViewer::Viewer::renderingTraversals();
+    ////////////////////////////////////////////
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 void WidgetOTW::timerEvent( QTimerEvent *event )
 {
     /////////////////////////////
     QWidget::timerEvent( event );
     /////////////////////////////
 
+#   ifdef SIM_LOW_POWER_IDLE
+    // frozen view is neither updated nor redrawn, devices keys are still passed on
+    if ( IdleMode::isActive() && !isRedrawNeeded() )
+    {
+        _keyHandler->update();
+        return;
+    }
+
+    _redrawTime = fdm::Time::get();
+#   endif
+
     update();
 
     if ( !_camManipulatorInited )
@@ -237,11 +330,49 @@ void WidgetOTW::timerEvent( QTimerEvent *event )
     cgi::Manager::instance()->updateHUD();
     cgi::Manager::instance()->updateOTW();
 
+    cgi::FrameStats::instance()->update( getOsgViewer() );
+
+#   ifdef SIM_RENDER_BENCHMARK
+    RenderBenchmark::instance()->update( getOsgViewer() );
+#   endif
+
+#   if defined(CGI_DYNAMIC_RESOLUTION) && !defined(USE_OSGQOPENGL)
+    _dynamicResolution->update();
+#   endif
+
     _keyHandler->update();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifdef SIM_LOW_POWER_IDLE
+bool WidgetOTW::isRedrawNeeded()
+{
+    // user input is queued by the graphics window until the next frame
+    osgViewer::GraphicsWindow *gwin =
+            dynamic_cast<osgViewer::GraphicsWindow*>( getOsgViewer()->getCamera()->getGraphicsContext() );
+
+    if ( gwin && !gwin->getEventQueue()->empty() )
+    {
+        return true;
+    }
+
+#   ifdef SIM_HEAD_TRACKING
+    // head tracked view is never frozen
+    HeadTracker::Pose head;
+
+    if ( HeadTracker::instance()->getPose( fdm::Time::get(), &head ) )
+    {
+        return true;
+    }
+#   endif
+
+    return fdm::Time::get() - _redrawTime >= SIM_IDLE_REDRAW;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 #ifndef USE_OSGQOPENGL
 QWidget* WidgetOTW::addViewWidget()
 {
@@ -256,6 +387,13 @@ QWidget* WidgetOTW::addViewWidget()
 
     assignSceneDataToCameras();
 
+#   ifdef SIM_CLUSTER_SYNC
+    if ( ClusterSync::instance()->isOpen() )
+    {
+        _gwin->setSwapCallback( new ClusterSwapCallback() );
+    }
+#   endif
+
     return _gwin->getGLWidget();
 }
 #endif
@@ -264,6 +402,12 @@ QWidget* WidgetOTW::addViewWidget()
 
 void WidgetOTW::createCameraOTW()
 {
+    getOsgViewer()->getCamera()->setName( "OTW" );
+    cgi::FrameStats::collect( getOsgViewer() );
+
+#   if !defined(USE_OSGQOPENGL) && ( CGI_OTW_CHANNELS > 1 )
+    createChannelsOTW();
+#   else
     osg::ref_ptr<osg::Camera> cameraOTW = getOsgViewer()->getCamera();
 
 #   ifndef USE_OSGQOPENGL
@@ -280,6 +424,15 @@ void WidgetOTW::createCameraOTW()
     cameraOTW->setViewport( new osg::Viewport( 0, 0, traits->width, traits->height ) );
     cameraOTW->setProjectionMatrixAsPerspective( CGI_FOV_Y, w2h, _zNear, _zFar );
     cameraOTW->setNearFarRatio( _zNear / _zFar );
+
+    cgi::FrameStats::collect( cameraOTW.get() );
+
+#   if defined(CGI_DYNAMIC_RESOLUTION) && !defined(USE_OSGQOPENGL)
+    // scene is rendered offscreen and upscaled to the window
+    _dynamicResolution = new cgi::DynamicResolution( cameraOTW.get() );
+    getOsgViewer()->addSlave( _dynamicResolution->getCamera(), false );
+#   endif
+#   endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -288,27 +441,129 @@ void WidgetOTW::createCameraHUD()
 {
     osg::ref_ptr<osg::Camera> cameraHUD = new osg::Camera();
 
-#   ifndef USE_OSGQOPENGL
-    cameraHUD->setGraphicsContext( _gwin );
-#   endif
+    cameraHUD->setName( "HUD" );
 
+#   ifdef USE_OSGQOPENGL
     osg::GraphicsContext* context = getOsgViewer()->getCamera()->getGraphicsContext();
+#   else
+    osg::GraphicsContext* context = _gwin.get();
+#   endif
 
     cameraHUD->setGraphicsContext( context );
 
     const osg::GraphicsContext::Traits *traits = context->getTraits();
 
-    double w2h = (double)(traits->width) / (double)(traits->height);
+#   if !defined(USE_OSGQOPENGL) && ( CGI_OTW_CHANNELS > 1 ) && !defined(CGI_OTW_CHANNELS_FLAT)
+    // wraparound channels, HUD is displayed on the forward channel only
+    osg::ref_ptr<osg::Viewport> viewport = getChannelViewport( CGI_OTW_CHANNELS / 2 );
+#   else
+    osg::ref_ptr<osg::Viewport> viewport = new osg::Viewport( 0, 0, traits->width, traits->height );
+#   endif
+
+    double w2h = viewport->width() / viewport->height();
 
     cameraHUD->setProjectionMatrixAsOrtho2D( -CGI_HUD_Y_2 * w2h, CGI_HUD_Y_2 * w2h, -CGI_HUD_Y_2, CGI_HUD_Y_2 );
     cameraHUD->setReferenceFrame( osg::Transform::ABSOLUTE_RF );
     cameraHUD->setViewMatrix( osg::Matrix::identity() );
     cameraHUD->setClearMask( GL_DEPTH_BUFFER_BIT );
-    cameraHUD->setRenderOrder( osg::Camera::POST_RENDER );
+    cameraHUD->setRenderOrder( osg::Camera::POST_RENDER, 1 );
     cameraHUD->setAllowEventFocus( false );
     cameraHUD->setProjectionResizePolicy( osg::Camera::HORIZONTAL );
     cameraHUD->addChild( cgi::Manager::instance()->getNodeHUD() );
-    cameraHUD->setViewport( new osg::Viewport( 0, 0, traits->width, traits->height ) );
+    cameraHUD->addChild( cgi::FrameStats::instance()->getNode() );
+    cameraHUD->setViewport( viewport.get() );
 
     getOsgViewer()->addSlave( cameraHUD, false );
+
+    cgi::FrameStats::collect( cameraHUD.get() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(USE_OSGQOPENGL) && ( CGI_OTW_CHANNELS > 1 )
+void WidgetOTW::createChannelsOTW()
+{
+    osg::ref_ptr<osg::Camera> cameraOTW = getOsgViewer()->getCamera();
+
+    // master camera only drives the channels, it has no context of its own
+    // so scene graph is updated once and shared by all the channels
+    cameraOTW->setGraphicsContext( NULLPTR );
+
+    const osg::GraphicsContext::Traits *traits = _gwin->getTraits();
+
+    double w2h = (double)(traits->width) / (double)(traits->height);
+
+#   ifdef CGI_OTW_CHANNELS_FLAT
+    // master frustum covers the whole window, channels take its slices
+    cameraOTW->setProjectionMatrixAsPerspective( CGI_FOV_Y, w2h, _zNear, _zFar );
+#   else
+    // master frustum is the one of the forward channel
+    double w2h_channel = w2h / (double)CGI_OTW_CHANNELS;
+
+    double yaw = osg::DegreesToRadians( CGI_OTW_CHANNELS_YAW );
+
+    if ( yaw <= 0.0 )
+    {
+        yaw = 2.0 * atan( w2h_channel * tan( osg::DegreesToRadians( 0.5 * CGI_FOV_Y ) ) );
+    }
+
+    cameraOTW->setProjectionMatrixAsPerspective( CGI_FOV_Y, w2h_channel, _zNear, _zFar );
+#   endif
+
+    cameraOTW->setNearFarRatio( _zNear / _zFar );
+
+    GLenum buffer = traits->doubleBuffer ? GL_BACK : GL_FRONT;
+
+    for ( int i = 0; i < CGI_OTW_CHANNELS; i++ )
+    {
+        osg::ref_ptr<osg::Camera> channel = new osg::Camera();
+
+        channel->setName( "OTW_" + std::to_string( i ) );
+        channel->setGraphicsContext( _gwin );
+        channel->setViewport( getChannelViewport( i ) );
+        channel->setDrawBuffer( buffer );
+        channel->setReadBuffer( buffer );
+#       ifndef SIM_TEST_WORLD
+        channel->setClearColor( osg::Vec4( 0.0, 0.0, 0.0, 1.0 ) );
+#       endif
+        channel->setNearFarRatio( _zNear / _zFar );
+
+#       ifdef CGI_OTW_CHANNELS_FLAT
+        // asymmetric frustum, slice of the master one
+        double offset = (double)i - 0.5 * (double)( CGI_OTW_CHANNELS - 1 );
+
+        osg::Matrixd projOffset = osg::Matrixd::scale( CGI_OTW_CHANNELS, 1.0, 1.0 )
+                                * osg::Matrixd::translate( -2.0 * offset, 0.0, 0.0 );
+
+        getOsgViewer()->addSlave( channel.get(), projOffset, osg::Matrixd::identity() );
+#       else
+        // symmetric frustum rotated about up axis, positive to the right
+        double offset = (double)( i - CGI_OTW_CHANNELS / 2 );
+
+        osg::Matrixd viewOffset = osg::Matrixd::rotate( offset * yaw, osg::Y_AXIS );
+
+        getOsgViewer()->addSlave( channel.get(), osg::Matrixd::identity(), viewOffset );
+#       endif
+
+        cgi::FrameStats::collect( channel.get() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+osg::Viewport* WidgetOTW::getChannelViewport( int index )
+{
+    const osg::GraphicsContext::Traits *traits = _gwin->getTraits();
+
+    int w = traits->width / CGI_OTW_CHANNELS;
+    int x = index * w;
+
+    // last channel takes the remainder
+    if ( index == CGI_OTW_CHANNELS - 1 )
+    {
+        w = traits->width - x;
+    }
+
+    return new osg::Viewport( x, 0, w, traits->height );
 }
+#endif
@@ -24,6 +24,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cgi/cgi_Defines.h>
+
+#include <cgi/cgi_DynamicResolution.h>
+
 #include <gui/WidgetOSG.h>
 
 #include <gui/KeyHandler.h>
@@ -33,6 +37,9 @@
 
 /**
  * @brief Out-the-Window widget class.
+ *
+ * If SIM_LOW_POWER_IDLE is defined, view is not redrawn every tick while
+ * simulation is idle or paused, but only when it might have changed.
  */
 class WidgetOTW : public WidgetOSG
 {
@@ -73,6 +80,14 @@ public:
     /** */
     void setDistanceMin( double distance_min );
 
+#   ifndef USE_OSGQOPENGL
+    /**
+     * @brief Late-latches ownship pose and view matrix before cull and draw.
+     * @see cgi::Manager::latchOTW()
+     */
+    virtual void renderingTraversals();
+#   endif
+
 protected:
 
     /** */
@@ -86,15 +101,47 @@ private:
 
     bool _camManipulatorInited;
 
+#   ifdef SIM_LOW_POWER_IDLE
+    double _redrawTime;             ///< [s] monotonic clock time of the last redraw
+#   endif
+
+#   if defined(CGI_DYNAMIC_RESOLUTION) && !defined(USE_OSGQOPENGL)
+    cgi::DynamicResolution *_dynamicResolution;     ///< OTW dynamic resolution scaling
+#   endif
+
 #   ifndef USE_OSGQOPENGL
     /** */
     QWidget* addViewWidget();
 #   endif
 
+#   ifdef SIM_LOW_POWER_IDLE
+    /**
+     * @brief Checks if frozen view has to be redrawn, which is when user input
+     * is pending or SIM_IDLE_REDRAW has elapsed since the last redraw.
+     */
+    bool isRedrawNeeded();
+#   endif
+
     void createCameraOTW();
 
     /** */
     void createCameraHUD();
+
+#   if !defined(USE_OSGQOPENGL) && ( CGI_OTW_CHANNELS > 1 )
+    /**
+     * @brief Creates OTW channels as slave cameras sharing master scene data.
+     * Wraparound channels are yawed by CGI_OTW_CHANNELS_YAW (adjacent if 0),
+     * with CGI_OTW_CHANNELS_FLAT channels split one flat screen using
+     * asymmetric frusta instead.
+     */
+    void createChannelsOTW();
+
+    /**
+     * @brief Returns channel viewport.
+     * @param index channel index (from left)
+     */
+    osg::Viewport* getChannelViewport( int index );
+#   endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
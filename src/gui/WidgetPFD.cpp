@@ -27,6 +27,7 @@
 
 #include <gui/gui_Defines.h>
 
+#include <sim/IdleMode.h>
 #include <sim/Path.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +36,9 @@ WidgetPFD::WidgetPFD( QWidget *parent ) :
     QWidget ( parent ),
     _ui ( new Ui::WidgetPFD ),
     _pfd ( NULLPTR ),
+#   ifdef SIM_LOW_POWER_IDLE
+    _idle ( false ),
+#   endif
     _timerId ( 0 )
 {
     _ui->setupUi( this );
@@ -84,8 +88,16 @@ void WidgetPFD::timerEvent( QTimerEvent *event )
     QWidget::timerEvent( event );
     /////////////////////////////
 
+#   ifdef SIM_LOW_POWER_IDLE
+    IdleMode::updateTimer( this, &_timerId, &_idle, GUI_TIME_STEP, SIM_IDLE_TIME_STEP );
+#   endif
+
     _pfd->update();
-    _ui->widgetPFD->update();
+
+    if ( _pfd->isDirty() )
+    {
+        _ui->widgetPFD->update();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
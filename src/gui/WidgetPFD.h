@@ -70,6 +70,10 @@ private:
 
     g1000::PFD *_pfd;
 
+#   ifdef SIM_LOW_POWER_IDLE
+    bool _idle;                 ///< specifies if timer ticks with idle period
+#   endif
+
     int _timerId;
 
     void settingsRead();
@@ -1,6 +1,7 @@
 HEADERS += \
     $$PWD/Aircrafts.h \
     $$PWD/Airports.h \
+    $$PWD/CatalogCache.h \
     $$PWD/Colors.h \
     $$PWD/ComboUnits.h \
     $$PWD/ComboUnitsAngle.h \
@@ -38,6 +39,7 @@ HEADERS += \
     $$PWD/MainWindow.h \
     $$PWD/PageControls.h \
     $$PWD/PageGeneral.h \
+    $$PWD/RenderBenchmark.h \
     $$PWD/ScreenSaver.h \
     $$PWD/SpinBoxHighlight.h \
     $$PWD/WidgetCGI.h \
@@ -51,6 +53,7 @@ HEADERS += \
 SOURCES += \
     $$PWD/Aircrafts.cpp \
     $$PWD/Airports.cpp \
+    $$PWD/CatalogCache.cpp \
     $$PWD/Colors.cpp \
     $$PWD/ComboUnits.cpp \
     $$PWD/ComboUnitsAngle.cpp \
@@ -87,6 +90,7 @@ SOURCES += \
     $$PWD/MainWindow.cpp \
     $$PWD/PageControls.cpp \
     $$PWD/PageGeneral.cpp \
+    $$PWD/RenderBenchmark.cpp \
     $$PWD/ScreenSaver.cpp \
     $$PWD/SpinBoxHighlight.cpp \
     $$PWD/WidgetCGI.cpp \
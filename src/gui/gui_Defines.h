@@ -29,6 +29,12 @@
 
 #define GUI_TIME_STEP 0.040 /*  25 Hz */
 
+#ifndef GUI_DOCK_TIME_STEP
+#   define GUI_DOCK_TIME_STEP 0.100 /* 10 Hz, data and propulsion docks refresh */
+#endif
+
+#define GUI_EFIS_TIME_STEP 0.016 /* ~60 Hz, OSG EFIS only */
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #endif // GUI_DEFINES_H
@@ -24,12 +24,18 @@
 
 #include <cmath>
 
+#include <Defines.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace hid;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const int AxisTune::_size = 257;
+
+////////////////////////////////////////////////////////////////////////////////
+
 double AxisTune::getAxisTune( double raw, double deadzone, double curvature, double scale )
 {
     double result = 0.0;
@@ -50,3 +56,85 @@ double AxisTune::getAxisTune( double raw, double deadzone, double curvature, dou
 
     return result * scale;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+AxisTune::AxisTune() :
+    _table ( NULLPTR ),
+
+    _deadzone  ( 0.0 ),
+    _curvature ( 0.0 ),
+    _scale     ( 1.0 )
+{
+    _table = new double [ _size ];
+
+    updateTable();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+AxisTune::~AxisTune()
+{
+    DELTAB( _table );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double AxisTune::getValue( double raw ) const
+{
+    // deadzone is removed analytically, as table would not capture the kink
+    double input = 0.0;
+
+    if ( raw < -_deadzone || _deadzone < raw )
+    {
+        if ( raw < 0.0 )
+        {
+            input = ( raw + _deadzone ) / ( 1.0 - _deadzone );
+        }
+        else
+        {
+            input = ( raw - _deadzone ) / ( 1.0 - _deadzone );
+        }
+    }
+    else
+    {
+        return 0.0;
+    }
+
+    double x = 0.5 * ( input + 1.0 ) * ( _size - 1 );
+
+    if ( x <= 0.0           ) return _table[ 0 ];
+    if ( x >= ( _size - 1 ) ) return _table[ _size - 1 ];
+
+    int i = static_cast< int >( x );
+
+    double w = x - i;
+
+    return ( 1.0 - w ) * _table[ i ] + w * _table[ i + 1 ];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AxisTune::setTuning( double deadzone, double curvature, double scale )
+{
+    if ( deadzone != _deadzone || curvature != _curvature || scale != _scale )
+    {
+        _deadzone  = deadzone;
+        _curvature = curvature;
+        _scale     = scale;
+
+        updateTable();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AxisTune::updateTable()
+{
+    for ( int i = 0; i < _size; i++ )
+    {
+        double input = 2.0 * i / (double)( _size - 1 ) - 1.0;
+
+        _table[ i ] = getAxisTune( input, 0.0, _curvature, _scale );
+    }
+}
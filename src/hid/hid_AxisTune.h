@@ -27,11 +27,20 @@
 namespace hid
 {
 
-/** */
+/**
+ * @brief Axis response curve class.
+ *
+ * Besides static function computing tuned value directly, object keeps
+ * response curve precomputed for the given tuning, so evaluating it costs
+ * only a table lookup and linear interpolation. Table is rebuilt only when
+ * tuning changes.
+ */
 class AxisTune
 {
 public:
 
+    static const int _size;     ///< number of response table points
+
     /**
      * @brief getAxisTune
      * @param raw
@@ -40,6 +49,40 @@ public:
      * @return
      */
     static double getAxisTune( double raw, double deadzone, double curvature, double scale );
+
+    /** @brief Constructor. */
+    AxisTune();
+
+    /** @brief Destructor. */
+    virtual ~AxisTune();
+
+    /**
+     * @brief Returns tuned axis value from the precomputed response curve.
+     * @param raw -1.0 ... 1.0 raw axis value
+     * @return tuned axis value
+     */
+    double getValue( double raw ) const;
+
+    /**
+     * @brief Sets axis tuning, response curve is rebuilt only if it differs from the current one.
+     * @param deadzone deadzone expressed as fraction of input
+     * @param curvature curvature
+     * @param scale scale
+     */
+    void setTuning( double deadzone, double curvature, double scale );
+
+private:
+
+    double *_table;             ///< response curve of the input with deadzone removed
+
+    double _deadzone;           ///< current deadzone
+    double _curvature;          ///< current curvature
+    double _scale;              ///< current scale
+
+    /** Using this constructor is forbidden. */
+    AxisTune( const AxisTune & ) {}
+
+    void updateTable();
 };
 
 } // end of hid namepsace
@@ -22,9 +22,11 @@
 
 #include <hid/hid_Joysticks.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 
 #include <sim/Log.h>
@@ -61,6 +63,123 @@ const std::string Joysticks::_axisNames[] = { "X", "Y", "Z",
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifdef HID_LINUX_JOYSTICK
+namespace
+{
+
+/**
+ * @brief Returns axis index for the given absolute axis event code.
+ * @param code absolute axis event code (ABS_X, ABS_Y, etc.)
+ * @return axis index or -1 if axis is not supported
+ */
+int getAxisIndex( int code )
+{
+    switch ( code )
+    {
+        case ABS_X:  return Joysticks::AxisX;
+        case ABS_Y:  return Joysticks::AxisY;
+        case ABS_Z:  return Joysticks::AxisZ;
+        case ABS_RX: return Joysticks::AxisRX;
+        case ABS_RY: return Joysticks::AxisRY;
+        case ABS_RZ: return Joysticks::AxisRZ;
+
+        case ABS_THROTTLE: return Joysticks::Throttle;
+        case ABS_RUDDER:   return Joysticks::Rudder;
+        case ABS_WHEEL:    return Joysticks::Wheel;
+        case ABS_GAS:      return Joysticks::Gas;
+        case ABS_BRAKE:    return Joysticks::Brake;
+
+        case ABS_HAT0X: return Joysticks::Hat0X;
+        case ABS_HAT0Y: return Joysticks::Hat0Y;
+        case ABS_HAT1X: return Joysticks::Hat1X;
+        case ABS_HAT1Y: return Joysticks::Hat1Y;
+        case ABS_HAT2X: return Joysticks::Hat2X;
+        case ABS_HAT2Y: return Joysticks::Hat2Y;
+        case ABS_HAT3X: return Joysticks::Hat3X;
+        case ABS_HAT3Y: return Joysticks::Hat3Y;
+
+        case ABS_PRESSURE:   return Joysticks::Pressure;
+        case ABS_DISTANCE:   return Joysticks::Distance;
+        case ABS_TILT_X:     return Joysticks::TiltX;
+        case ABS_TILT_Y:     return Joysticks::TiltY;
+        case ABS_TOOL_WIDTH: return Joysticks::ToolWidth;
+    }
+
+    return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Sets POVs availability based on hats axes.
+ * @param data joystick data
+ */
+void initPOVs( Joysticks::Data *data )
+{
+    for ( short i_pov = 0; i_pov < HID_MAX_POVS; i_pov++ )
+    {
+        if ( data->hasAxis[ Joysticks::Hat0X + 2 * i_pov ]
+          || data->hasAxis[ Joysticks::Hat0Y + 2 * i_pov ] )
+        {
+            data->hasPOV[ i_pov ] = true;
+            data->povsCount++;
+        }
+    }
+}
+
+#ifdef HID_LINUX_EVDEV
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool testBit( const unsigned char *bits, int bit )
+{
+    return ( bits[ bit / 8 ] & ( 1 << ( bit % 8 ) ) ) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Returns normalized axis position.
+ * Device flat zone around center is removed and the rest of the range is
+ * rescaled, so output still spans the full range.
+ * @param info axis info
+ * @param value raw axis value
+ * @return -1.0 ... 1.0 normalized axis position
+ */
+float getAxisValue( const input_absinfo &info, int value )
+{
+    double range = info.maximum - info.minimum;
+
+    if ( range <= 0.0 )
+    {
+        return 0.0f;
+    }
+
+    double norm = 2.0 * ( value - info.minimum ) / range - 1.0;
+    double flat = 2.0 * info.flat / range;
+
+    if ( flat > 0.0 && flat < 1.0 )
+    {
+        if ( fabs( norm ) < flat )
+        {
+            norm = 0.0;
+        }
+        else
+        {
+            norm = ( norm < 0.0 ? -1.0 : 1.0 ) * ( fabs( norm ) - flat ) / ( 1.0 - flat );
+        }
+    }
+
+    return static_cast< float >( std::max( -1.0, std::min( 1.0, norm ) ) );
+}
+
+#endif // HID_LINUX_EVDEV
+
+} // end of anonymous namespace
+#endif // HID_LINUX_JOYSTICK
+
+////////////////////////////////////////////////////////////////////////////////
+
 Joysticks::Joysticks() :
     _count ( 0 )
 {
@@ -103,6 +222,10 @@ Joysticks::Joysticks() :
 #       endif
 #   endif
 
+#   ifdef HID_LINUX_JOYSTICK
+    _quit.store( false );
+#   endif
+
     for ( int i = 0; i < HID_MAX_JOYS; i++ )
     {
         _data[ i ].name = "";
@@ -125,7 +248,17 @@ Joysticks::Joysticks() :
             _data[ i ].hasPOV[ i_pov ] = false;
         }
 
+        _data[ i ].time = 0;
+
         _fd[ i ] = 0;
+
+        State &state = _states.joys[ i ];
+
+        for ( int a = 0; a < HID_MAX_AXES; a++ ) state.axis[ a ] = 0.0f;
+        for ( int b = 0; b < HID_MAX_BUTT; b++ ) state.butt[ b ] = false;
+        for ( int p = 0; p < HID_MAX_POVS; p++ ) state.povs[ p ] = -1;
+
+        state.time = 0;
 #       endif
 
 #       ifdef HID_WINMM_JOYSTICK
@@ -136,199 +269,38 @@ Joysticks::Joysticks() :
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Joysticks::~Joysticks() {}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void Joysticks::init()
+Joysticks::~Joysticks()
 {
 #   ifdef HID_LINUX_JOYSTICK
-    for ( int i = 0; i < HID_MAX_JOYS; i++ )
-    {
-        char tempDev[ 255 ];
-
-        sprintf( tempDev, "/dev/input/js%d", i );
+    _quit.store( true );
 
-        int joyFD = open( tempDev, O_NONBLOCK );
-
-        if ( joyFD > 0 )
-        {
-            _fd[ _count ] = joyFD;
-
-            char tempAxisCount = 0;
-            char tempButtCount = 0;
-            char tempName[ 512 ] = "";
-            char tempAxesMap[ HID_MAX_AXES + 2*HID_MAX_POVS ] = { 0 };
-
-            ioctl( _fd[ _count ], JSIOCGAXES     , &tempAxisCount );
-            ioctl( _fd[ _count ], JSIOCGBUTTONS  , &tempButtCount );
-            ioctl( _fd[ _count ], JSIOCGNAME(64) , tempName );
-            ioctl( _fd[ _count ], JSIOCGAXMAP    , tempAxesMap );
-
-            _data[ _count ].name = tempName;
-
-            _data[ _count ].axisCount = std::min( (int)tempAxisCount, HID_MAX_AXES );
-            _data[ _count ].buttCount = std::min( (int)tempButtCount, HID_MAX_BUTT );
-            _data[ _count ].povsCount = 0;
-
-            _data[ _count ].active = true;
-
-            for ( int j = 0; j < HID_MAX_AXES + 2 * HID_MAX_POVS; j++ )
-            {
-                switch ( tempAxesMap[ j ] )
-                {
-                case ABS_X:
-                    _data[ _count ].hasAxis[ AxisX ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisX;
-                    break;
-
-                case ABS_Y:
-                    _data[ _count ].hasAxis[ AxisY ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisY;
-                    break;
-
-                case ABS_Z:
-                    _data[ _count ].hasAxis[ AxisZ ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisZ;
-                    break;
-
-                case ABS_RX:
-                    _data[ _count ].hasAxis[ AxisRX ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisRX;
-                    break;
-
-                case ABS_RY:
-                    _data[ _count ].hasAxis[ AxisRY ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisRY;
-                    break;
-
-                case ABS_RZ:
-                    _data[ _count ].hasAxis[ AxisRZ ] = true;
-                    _data[ _count ].axesMap[ j ] = AxisRZ;
-                    break;
-
-                case ABS_THROTTLE:
-                    _data[ _count ].hasAxis[ Throttle ] = true;
-                    _data[ _count ].axesMap[ j ] = Throttle;
-                    break;
-
-                case ABS_RUDDER:
-                    _data[ _count ].hasAxis[ Rudder ] = true;
-                    _data[ _count ].axesMap[ j ] = Rudder;
-                    break;
-
-                case ABS_WHEEL:
-                    _data[ _count ].hasAxis[ Wheel ] = true;
-                    _data[ _count ].axesMap[ j ] = Wheel;
-                    break;
-
-                case ABS_GAS:
-                    _data[ _count ].hasAxis[ Gas ] = true;
-                    _data[ _count ].axesMap[ j ] = Gas;
-                    break;
-
-                case ABS_BRAKE:
-                    _data[ _count ].hasAxis[ Brake ] = true;
-                    _data[ _count ].axesMap[ j ] = Brake;
-                    break;
-
-                case ABS_HAT0X:
-                    _data[ _count ].hasAxis[ Hat0X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat0X;
-                    break;
-
-                case ABS_HAT0Y:
-                    _data[ _count ].hasAxis[ Hat0Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat0Y;
-                    break;
-
-                case ABS_HAT1X:
-                    _data[ _count ].hasAxis[ Hat1X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat1X;
-                    break;
-
-                case ABS_HAT1Y:
-                    _data[ _count ].hasAxis[ Hat1Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat1Y;
-                    break;
-
-                case ABS_HAT2X:
-                    _data[ _count ].hasAxis[ Hat2X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat2X;
-                    break;
-
-                case ABS_HAT2Y:
-                    _data[ _count ].hasAxis[ Hat2Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat2Y;
-                    break;
-
-                case ABS_HAT3X:
-                    _data[ _count ].hasAxis[ Hat3X ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat3X;
-                    break;
-
-                case ABS_HAT3Y:
-                    _data[ _count ].hasAxis[ Hat3Y ] = true;
-                    _data[ _count ].axesMap[ j ] = Hat3Y;
-                    break;
-
-                case ABS_PRESSURE:
-                    _data[ _count ].hasAxis[ Pressure ] = true;
-                    _data[ _count ].axesMap[ j ] = Pressure;
-                    break;
-
-                case ABS_DISTANCE:
-                    _data[ _count ].hasAxis[ Distance ] = true;
-                    _data[ _count ].axesMap[ j ] = Distance;
-                    break;
-
-                case ABS_TILT_X:
-                    _data[ _count ].hasAxis[ TiltX ] = true;
-                    _data[ _count ].axesMap[ j ] = TiltX;
-                    break;
-
-                case ABS_TILT_Y:
-                    _data[ _count ].hasAxis[ TiltY ] = true;
-                    _data[ _count ].axesMap[ j ] = TiltY;
-                    break;
-
-                case ABS_TOOL_WIDTH:
-                    _data[ _count ].hasAxis[ ToolWidth ] = true;
-                    _data[ _count ].axesMap[ j ] = ToolWidth;
-                    break;
-                }
-            }
-
-            if ( _data[ _count ].hasAxis[ Hat0X ]
-              || _data[ _count ].hasAxis[ Hat0Y ] )
-            {
-                _data[ _count ].hasPOV[ 0 ] = true;
-                _data[ _count ].povsCount++;
-            }
+    if ( _thread.joinable() )
+    {
+        _thread.join();
+    }
 
-            if ( _data[ _count ].hasAxis[ Hat1X ]
-              || _data[ _count ].hasAxis[ Hat1Y ] )
-            {
-                _data[ _count ].hasPOV[ 1 ] = true;
-                _data[ _count ].povsCount++;
-            }
+    for ( short i = 0; i < _count; i++ )
+    {
+        close( _fd[ i ] );
+    }
+#   endif
+}
 
-            if ( _data[ _count ].hasAxis[ Hat2X ]
-              || _data[ _count ].hasAxis[ Hat2Y ] )
-            {
-                _data[ _count ].hasPOV[ 2 ] = true;
-                _data[ _count ].povsCount++;
-            }
+////////////////////////////////////////////////////////////////////////////////
 
-            if ( _data[ _count ].hasAxis[ Hat3X ]
-              || _data[ _count ].hasAxis[ Hat3Y ] )
-            {
-                _data[ _count ].hasPOV[ 3 ] = true;
-                _data[ _count ].povsCount++;
-            }
+void Joysticks::init()
+{
+#   ifdef HID_LINUX_JOYSTICK
+#   ifdef HID_LINUX_EVDEV
+    initEvdev();
+#   else
+    initJoydev();
+#   endif
 
-            _count++;
-        }
+    if ( _count > 0 && !_thread.joinable() )
+    {
+        _statesBuffer.publish( _states );
+        _thread = std::thread( &Joysticks::work, this );
     }
 #   endif
 
@@ -386,95 +358,189 @@ void Joysticks::init()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Joysticks::update()
+#if defined(HID_LINUX_JOYSTICK) && !defined(HID_LINUX_EVDEV)
+void Joysticks::initJoydev()
 {
-#   ifdef HID_LINUX_JOYSTICK
-    for( short i = 0; i < _count && i < HID_MAX_JOYS; i++ )
+    for ( int i = 0; i < HID_MAX_JOYS; i++ )
     {
-        while( read( _fd[ i ], &_event, sizeof(js_event) ) > 0 )
+        char tempDev[ 255 ];
+
+        sprintf( tempDev, "/dev/input/js%d", i );
+
+        int joyFD = open( tempDev, O_NONBLOCK );
+
+        if ( joyFD > 0 )
         {
-            // buttons
-            if ( _event.type == JS_EVENT_BUTTON )
+            _fd[ _count ] = joyFD;
+
+            char tempAxisCount = 0;
+            char tempButtCount = 0;
+            char tempName[ 512 ] = "";
+            char tempAxesMap[ HID_MAX_AXES + 2*HID_MAX_POVS ] = { 0 };
+
+            ioctl( _fd[ _count ], JSIOCGAXES     , &tempAxisCount );
+            ioctl( _fd[ _count ], JSIOCGBUTTONS  , &tempButtCount );
+            ioctl( _fd[ _count ], JSIOCGNAME(64) , tempName );
+            ioctl( _fd[ _count ], JSIOCGAXMAP    , tempAxesMap );
+
+            _data[ _count ].name = tempName;
+
+            _data[ _count ].axisCount = std::min( (int)tempAxisCount, HID_MAX_AXES );
+            _data[ _count ].buttCount = std::min( (int)tempButtCount, HID_MAX_BUTT );
+            _data[ _count ].povsCount = 0;
+
+            _data[ _count ].active = true;
+
+            for ( int j = 0; j < HID_MAX_AXES + 2 * HID_MAX_POVS; j++ )
             {
-                if ( _event.number < HID_MAX_BUTT )
+                int axis = getAxisIndex( tempAxesMap[ j ] );
+
+                if ( axis >= 0 )
                 {
-                    _data[ i ].butt[ _event.number ] = ( _event.value ) ? 1 : 0;
+                    _data[ _count ].hasAxis[ axis ] = true;
+                    _data[ _count ].axesMap[ j ] = static_cast< Axes >( axis );
                 }
             }
 
-            // axes
-            if ( _event.type == JS_EVENT_AXIS )
-            {
-                float value = _event.value / (double)HID_AXIS_RANGE;
+            initPOVs( &_data[ _count ] );
 
-                switch ( _data[ i ].axesMap[ _event.number ] )
-                {
-                    case AxisX:  _data[ i ].axis[ AxisX  ] = value; break;
-                    case AxisY:  _data[ i ].axis[ AxisY  ] = value; break;
-                    case AxisZ:  _data[ i ].axis[ AxisZ  ] = value; break;
-                    case AxisRX: _data[ i ].axis[ AxisRX ] = value; break;
-                    case AxisRY: _data[ i ].axis[ AxisRY ] = value; break;
-                    case AxisRZ: _data[ i ].axis[ AxisRZ ] = value; break;
-
-                    case Throttle: _data[ i ].axis[ Throttle ] = value; break;
-                    case Rudder:   _data[ i ].axis[ Rudder   ] = value; break;
-                    case Gas:      _data[ i ].axis[ Gas      ] = value; break;
-                    case Wheel:    _data[ i ].axis[ Wheel    ] = value; break;
-                    case Brake:    _data[ i ].axis[ Brake    ] = value; break;
-
-                    case Hat0X: _data[ i ].axis[ Hat0X ] = value; break;
-                    case Hat0Y: _data[ i ].axis[ Hat0Y ] = value; break;
-                    case Hat1X: _data[ i ].axis[ Hat1X ] = value; break;
-                    case Hat1Y: _data[ i ].axis[ Hat1Y ] = value; break;
-                    case Hat2X: _data[ i ].axis[ Hat2X ] = value; break;
-                    case Hat2Y: _data[ i ].axis[ Hat2Y ] = value; break;
-                    case Hat3X: _data[ i ].axis[ Hat3X ] = value; break;
-                    case Hat3Y: _data[ i ].axis[ Hat3Y ] = value; break;
-
-                    case Pressure:  _data[ i ].axis[ Pressure  ] = value; break;
-                    case Distance:  _data[ i ].axis[ Distance  ] = value; break;
-                    case TiltX:     _data[ i ].axis[ TiltX     ] = value; break;
-                    case TiltY:     _data[ i ].axis[ TiltY     ] = value; break;
-                    case ToolWidth: _data[ i ].axis[ ToolWidth ] = value; break;
-                }
+            _count++;
+        }
+    }
+}
+#endif
 
-                for ( short i_pov = 0; i_pov < HID_MAX_POVS; i_pov++ )
-                {
-                    _data[ i ].povs[ i_pov ] = -1;
+////////////////////////////////////////////////////////////////////////////////
 
-                    if ( _data[ i ].hasPOV[ i_pov ] )
-                    {
-                        if ( 0 )
-                        {
-                            // multidirectional POV
-                            short angle_deg = 360 * _data[ i ].axis[ Hat0X + i_pov ];
+#ifdef HID_LINUX_EVDEV
+void Joysticks::initEvdev()
+{
+    for ( int i = 0; i < HID_EVDEV_NODES && _count < HID_MAX_JOYS; i++ )
+    {
+        char tempDev[ 255 ];
 
-                            while ( angle_deg <   0 ) angle_deg += 360;
-                            while ( angle_deg > 360 ) angle_deg -= 360;
+        sprintf( tempDev, "/dev/input/event%d", i );
 
-                            _data[ i ].povs[ i_pov ] = angle_deg;
-                        }
-                        else
-                        {
-                            // default model
-                            if ( _data[ i ].axis[ Hat0X + i_pov ] != 0.0f
-                              || _data[ i ].axis[ Hat0Y + i_pov ] != 0.0f )
-                            {
-                                float angle_rad = atan2( _data[ i ].axis[ Hat0X + i_pov ],
-                                                        -_data[ i ].axis[ Hat0Y + i_pov ] );
+        // read-write access is needed for force feedback
+        int joyFD = open( tempDev, O_RDWR | O_NONBLOCK );
 
-                                short angle_deg = 180 * angle_rad / M_PI;
+        if ( joyFD < 0 ) joyFD = open( tempDev, O_RDONLY | O_NONBLOCK );
 
-                                while ( angle_deg <   0 ) angle_deg += 360;
-                                while ( angle_deg > 360 ) angle_deg -= 360;
+        if ( joyFD < 0 ) continue;
 
-                                _data[ i ].povs[ i_pov ] = angle_deg;
-                            }
-                        }
-                    }
-                }
+        unsigned char evBits  [ EV_CNT  / 8 + 1 ] = { 0 };
+        unsigned char absBits [ ABS_CNT / 8 + 1 ] = { 0 };
+        unsigned char keyBits [ KEY_CNT / 8 + 1 ] = { 0 };
+        unsigned char ffBits  [ FF_CNT  / 8 + 1 ] = { 0 };
+
+        ioctl( joyFD, EVIOCGBIT( 0      , sizeof(evBits)  ), evBits  );
+        ioctl( joyFD, EVIOCGBIT( EV_ABS , sizeof(absBits) ), absBits );
+        ioctl( joyFD, EVIOCGBIT( EV_KEY , sizeof(keyBits) ), keyBits );
+        ioctl( joyFD, EVIOCGBIT( EV_FF  , sizeof(ffBits)  ), ffBits  );
+
+        // joystick like devices only, following joydev rules: buttons from
+        // the joystick, gamepad or wheel ranges, or throttle and rudder axes
+        bool joystick = false;
+
+        for ( int code = BTN_JOYSTICK; code < BTN_DIGI && !joystick; code++ )
+        {
+            if ( testBit( keyBits, code ) ) joystick = true;
+        }
+
+        if ( testBit( absBits, ABS_THROTTLE ) || testBit( absBits, ABS_RUDDER ) )
+        {
+            joystick = true;
+        }
+
+        if ( !testBit( evBits, EV_ABS ) || testBit( keyBits, BTN_TOUCH ) || !joystick )
+        {
+            close( joyFD );
+            continue;
+        }
+
+        Evdev &evdev = _evdev[ _count ];
+        Data  &data  = _data[ _count ];
+
+        _fd[ _count ] = joyFD;
+
+        char tempName[ 512 ] = "";
+
+        ioctl( joyFD, EVIOCGNAME( sizeof(tempName) ), tempName );
+
+        data.name = tempName;
+        data.axisCount = 0;
+        data.buttCount = 0;
+        data.povsCount = 0;
+        data.active = true;
+
+        for ( int code = 0; code < ABS_CNT; code++ )
+        {
+            evdev.axes[ code ] = -1;
+
+            int axis = getAxisIndex( code );
+
+            if ( axis >= 0 && testBit( absBits, code ) )
+            {
+                ioctl( joyFD, EVIOCGABS( code ), &evdev.absinfo[ axis ] );
+
+                evdev.axes[ code ] = axis;
+
+                data.hasAxis[ axis ] = true;
+                data.axisCount++;
+
+                _states.joys[ _count ].axis[ axis ] = getAxisValue( evdev.absinfo[ axis ],
+                                                                    evdev.absinfo[ axis ].value );
             }
         }
+
+        // buttons are numbered the same way as joydev does
+        for ( int code = 0; code < KEY_CNT; code++ )
+        {
+            evdev.butt[ code ] = -1;
+        }
+
+        for ( int code = BTN_JOYSTICK; code < KEY_CNT && data.buttCount < HID_MAX_BUTT; code++ )
+        {
+            if ( testBit( keyBits, code ) ) evdev.butt[ code ] = data.buttCount++;
+        }
+
+        for ( int code = BTN_MISC; code < BTN_JOYSTICK && data.buttCount < HID_MAX_BUTT; code++ )
+        {
+            if ( testBit( keyBits, code ) ) evdev.butt[ code ] = data.buttCount++;
+        }
+
+        initPOVs( &data );
+        updatePOVs( _count );
+
+        evdev.effect = -1;
+        evdev.ff = testBit( evBits, EV_FF ) && testBit( ffBits, FF_CONSTANT );
+
+        _count++;
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Joysticks::update()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+
+#   ifdef HID_LINUX_JOYSTICK
+    if ( _statesBuffer.fetch() )
+    {
+        const States &states = _statesBuffer.getFrontBuffer();
+
+        for ( short i = 0; i < _count; i++ )
+        {
+            const State &state = states.joys[ i ];
+
+            for ( int a = 0; a < HID_MAX_AXES; a++ ) _data[ i ].axis[ a ] = state.axis[ a ];
+            for ( int b = 0; b < HID_MAX_BUTT; b++ ) _data[ i ].butt[ b ] = state.butt[ b ];
+            for ( int p = 0; p < HID_MAX_POVS; p++ ) _data[ i ].povs[ p ] = state.povs[ p ];
+
+            _data[ i ].time = state.time;
+        }
     }
 #   endif
 
@@ -519,6 +585,271 @@ void Joysticks::update()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#if defined(HID_LINUX_JOYSTICK) && !defined(HID_LINUX_EVDEV)
+void Joysticks::processEvent( short joyNum, const js_event &event )
+{
+    State &state = _states.joys[ joyNum ];
+
+    state.time = event.time;
+
+    // buttons
+    if ( event.type == JS_EVENT_BUTTON )
+    {
+        if ( event.number < HID_MAX_BUTT )
+        {
+            state.butt[ event.number ] = ( event.value ) ? 1 : 0;
+        }
+    }
+
+    // axes
+    if ( event.type == JS_EVENT_AXIS )
+    {
+        float value = event.value / (double)HID_AXIS_RANGE;
+
+        switch ( _data[ joyNum ].axesMap[ event.number ] )
+        {
+            case AxisX:  state.axis[ AxisX  ] = value; break;
+            case AxisY:  state.axis[ AxisY  ] = value; break;
+            case AxisZ:  state.axis[ AxisZ  ] = value; break;
+            case AxisRX: state.axis[ AxisRX ] = value; break;
+            case AxisRY: state.axis[ AxisRY ] = value; break;
+            case AxisRZ: state.axis[ AxisRZ ] = value; break;
+
+            case Throttle: state.axis[ Throttle ] = value; break;
+            case Rudder:   state.axis[ Rudder   ] = value; break;
+            case Gas:      state.axis[ Gas      ] = value; break;
+            case Wheel:    state.axis[ Wheel    ] = value; break;
+            case Brake:    state.axis[ Brake    ] = value; break;
+
+            case Hat0X: state.axis[ Hat0X ] = value; break;
+            case Hat0Y: state.axis[ Hat0Y ] = value; break;
+            case Hat1X: state.axis[ Hat1X ] = value; break;
+            case Hat1Y: state.axis[ Hat1Y ] = value; break;
+            case Hat2X: state.axis[ Hat2X ] = value; break;
+            case Hat2Y: state.axis[ Hat2Y ] = value; break;
+            case Hat3X: state.axis[ Hat3X ] = value; break;
+            case Hat3Y: state.axis[ Hat3Y ] = value; break;
+
+            case Pressure:  state.axis[ Pressure  ] = value; break;
+            case Distance:  state.axis[ Distance  ] = value; break;
+            case TiltX:     state.axis[ TiltX     ] = value; break;
+            case TiltY:     state.axis[ TiltY     ] = value; break;
+            case ToolWidth: state.axis[ ToolWidth ] = value; break;
+        }
+
+        updatePOVs( joyNum );
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HID_LINUX_EVDEV
+bool Joysticks::processEvent( short joyNum, const input_event &event )
+{
+    State &state = _states.joys[ joyNum ];
+
+    const Evdev &evdev = _evdev[ joyNum ];
+
+    state.time = 1000 * event.time.tv_sec + event.time.tv_usec / 1000;
+
+    // buttons
+    if ( event.type == EV_KEY && event.code < KEY_CNT )
+    {
+        if ( evdev.butt[ event.code ] >= 0 )
+        {
+            state.butt[ evdev.butt[ event.code ] ] = event.value != 0;
+        }
+    }
+
+    // axes
+    if ( event.type == EV_ABS && event.code < ABS_CNT )
+    {
+        short axis = evdev.axes[ event.code ];
+
+        if ( axis >= 0 )
+        {
+            state.axis[ axis ] = getAxisValue( evdev.absinfo[ axis ], event.value );
+
+            if ( axis >= Hat0X && axis <= Hat3Y )
+            {
+                updatePOVs( joyNum );
+            }
+        }
+    }
+
+    // device frame is complete
+    return event.type == EV_SYN && event.code == SYN_REPORT;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HID_LINUX_JOYSTICK
+void Joysticks::updatePOVs( short joyNum )
+{
+    State &state = _states.joys[ joyNum ];
+
+    for ( short i_pov = 0; i_pov < HID_MAX_POVS; i_pov++ )
+    {
+        state.povs[ i_pov ] = -1;
+
+        if ( _data[ joyNum ].hasPOV[ i_pov ] )
+        {
+            if ( 0 )
+            {
+                // multidirectional POV
+                short angle_deg = 360 * state.axis[ Hat0X + i_pov ];
+
+                while ( angle_deg <   0 ) angle_deg += 360;
+                while ( angle_deg > 360 ) angle_deg -= 360;
+
+                state.povs[ i_pov ] = angle_deg;
+            }
+            else
+            {
+                // default model
+                if ( state.axis[ Hat0X + i_pov ] != 0.0f
+                  || state.axis[ Hat0Y + i_pov ] != 0.0f )
+                {
+                    float angle_rad = atan2( state.axis[ Hat0X + i_pov ],
+                                            -state.axis[ Hat0Y + i_pov ] );
+
+                    short angle_deg = 180 * angle_rad / M_PI;
+
+                    while ( angle_deg <   0 ) angle_deg += 360;
+                    while ( angle_deg > 360 ) angle_deg -= 360;
+
+                    state.povs[ i_pov ] = angle_deg;
+                }
+            }
+        }
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HID_LINUX_JOYSTICK
+void Joysticks::work()
+{
+    pollfd fds[ HID_MAX_JOYS ];
+
+    for ( short i = 0; i < _count; i++ )
+    {
+        fds[ i ].fd      = _fd[ i ];
+        fds[ i ].events  = POLLIN;
+        fds[ i ].revents = 0;
+    }
+
+    // timeout only lets the thread check if it should quit
+    while ( !_quit.load() )
+    {
+        if ( poll( fds, _count, HID_POLL_TIMEOUT ) > 0 )
+        {
+            for ( short i = 0; i < _count; i++ )
+            {
+                if ( fds[ i ].revents & POLLIN )
+                {
+#                   ifdef HID_LINUX_EVDEV
+                    input_event event;
+
+                    while ( read( fds[ i ].fd, &event, sizeof(input_event) ) > 0 )
+                    {
+                        // state is published at device native rate,
+                        // once per complete device frame
+                        if ( processEvent( i, event ) )
+                        {
+                            _statesBuffer.publish( _states );
+                        }
+                    }
+#                   else
+                    js_event event;
+
+                    while ( read( fds[ i ].fd, &event, sizeof(js_event) ) > 0 )
+                    {
+                        processEvent( i, event );
+                    }
+#                   endif
+                }
+
+                // disconnected device is no longer polled
+                if ( fds[ i ].revents & ( POLLERR | POLLHUP | POLLNVAL ) )
+                {
+                    fds[ i ].fd = -1;
+                }
+            }
+
+#           ifndef HID_LINUX_EVDEV
+            // state is published once all pending events are processed
+            _statesBuffer.publish( _states );
+#           endif
+        }
+    }
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HID_LINUX_EVDEV
+bool Joysticks::setForce( short joyNum, float level, float direction )
+{
+    if ( joyNum < 0 || joyNum >= _count || !_evdev[ joyNum ].ff )
+    {
+        return false;
+    }
+
+    std::lock_guard< std::mutex > lock( _forceMutex );
+
+    Evdev &evdev = _evdev[ joyNum ];
+
+    while ( direction <    0.0f ) direction += 360.0f;
+    while ( direction >= 360.0f ) direction -= 360.0f;
+
+    ff_effect effect;
+
+    memset( &effect, 0, sizeof(ff_effect) );
+
+    effect.type = FF_CONSTANT;
+    effect.id   = evdev.effect;
+
+    effect.direction = static_cast< unsigned short >( 65536.0f * direction / 360.0f );
+
+    effect.u.constant.level = static_cast< short >( 32767.0f * std::max( -1.0f, std::min( 1.0f, level ) ) );
+
+    // zero length effect is played until stopped
+    effect.replay.length = 0;
+
+    if ( ioctl( _fd[ joyNum ], EVIOCSFF, &effect ) < 0 )
+    {
+        return false;
+    }
+
+    // updating uploaded effect does not need to be played again
+    if ( evdev.effect < 0 )
+    {
+        evdev.effect = effect.id;
+
+        input_event play;
+
+        memset( &play, 0, sizeof(input_event) );
+
+        play.type  = EV_FF;
+        play.code  = effect.id;
+        play.value = 1;
+
+        if ( write( _fd[ joyNum ], &play, sizeof(input_event) ) != sizeof(input_event) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
 Joysticks::Data Joysticks::getData( short joyNum ) const
 {
     if ( joyNum < 0 && joyNum >= HID_MAX_JOYS )
@@ -530,5 +861,7 @@ Joysticks::Data Joysticks::getData( short joyNum ) const
 #       endif
     }
 
+    std::lock_guard< std::mutex > lock( _mutex );
+
     return _data[ joyNum ];
 }
@@ -34,12 +34,19 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <mutex>
 #include <string>
 
 #ifdef HID_LINUX_JOYSTICK
+#   include <atomic>
+#   include <thread>
 #   include <fcntl.h>
+#   include <poll.h>
 #   include <unistd.h>
 #   include <linux/joystick.h>
+#   ifdef HID_LINUX_EVDEV
+#       include <linux/input.h>
+#   endif
 #endif
 
 #ifdef HID_WINMM_JOYSTICK
@@ -48,6 +55,10 @@
 
 #include <sim/Singleton.h>
 
+#ifdef HID_LINUX_JOYSTICK
+#   include <sim/TripleBuffer.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef HID_LINUX_JOYSTICK
@@ -56,6 +67,8 @@
 #   define HID_MAX_AXES 24
 #   define HID_MAX_BUTT 32
 #   define HID_AXIS_RANGE 32767.0f
+#   define HID_POLL_TIMEOUT 100
+#   define HID_EVDEV_NODES 64
 #endif
 
 #ifdef HID_WINMM_JOYSTICK
@@ -78,7 +91,21 @@ namespace hid
 /**
  * @brief This class handles joystick like input devices.
  *
+ * Devices are updated by the simulation thread, while GUI reads data due to
+ * configure assignments, hence data access is guarded by mutex.
+ *
+ * On Linux device events are read by the input thread which blocks on poll()
+ * and publishes devices state through lock-free triple buffer as soon as
+ * events arrive, so update() only fetches the most recent state and input
+ * latency does not depend on the time step of the calling thread.
+ *
+ * If HID_LINUX_EVDEV is defined, event devices are used instead of legacy
+ * joystick devices. Axes are then read at native resolution, normalized
+ * with device flat zone removed in the input thread and published once per
+ * complete device frame. Constant force feedback is also available.
+ *
  * @see https://www.kernel.org/doc/html/v4.14/input/joydev/index.html
+ * @see https://www.kernel.org/doc/html/v4.14/input/ff.html
  * @see https://docs.microsoft.com/en-us/windows/desktop/multimedia/joysticks
  */
 class Joysticks : public Singleton< Joysticks >
@@ -144,6 +171,8 @@ public:
         bool hasAxis[ HID_MAX_AXES ];   ///< specifies if joystick has an axis
 
 #       ifdef HID_LINUX_JOYSTICK
+        unsigned int time;              ///< [ms] most recent event time stamp
+
         bool hasPOV[ HID_MAX_POVS ];    ///< specifies if joystick has a POV
 
         Axes axesMap[ HID_MAX_AXES + 2*HID_MAX_POVS ];  ///< axes map
@@ -187,15 +216,79 @@ public:
      */
     Joysticks::Data getData( short joyNum ) const;
 
+#   ifdef HID_LINUX_EVDEV
+    /**
+     * @brief Sets constant force feedback effect.
+     * Might be called from any thread.
+     * @param joyNum joystick index number
+     * @param level -1.0 ... 1.0 normalized force level
+     * @param direction [deg] force direction (0: down, 90: left, 180: up, 270: right)
+     * @return true on success, false on failure or if device has no force feedback
+     */
+    bool setForce( short joyNum, float level, float direction );
+#   endif
+
 private:
 
     short _count;                               ///< number of active joysticks
 
     Joysticks::Data _data[ HID_MAX_JOYS ];      ///< joysticks data
 
+    mutable std::mutex _mutex;                  ///< mutex guarding joysticks data
+
 #   ifdef HID_LINUX_JOYSTICK
+    /** Joystick input state. */
+    struct State
+    {
+        float axis[ HID_MAX_AXES ];     ///< -1.0 ... 1.0 normalized axis position
+        bool  butt[ HID_MAX_BUTT ];     ///< false: released, true: pressed
+        short povs[ HID_MAX_POVS ];     ///< [deg] POVs
+
+        unsigned int time;              ///< [ms] most recent event time stamp
+    };
+
+    /** All joysticks input state. */
+    struct States
+    {
+        State joys[ HID_MAX_JOYS ];     ///< joysticks input state
+    };
+
     int _fd[ HID_MAX_JOYS ];                    ///<
-    js_event _event;                            ///< joystick event
+
+    States _states;                             ///< input state (owned by input thread)
+
+    TripleBuffer< States > _statesBuffer;       ///< input state channel
+
+    std::thread _thread;                        ///< input thread
+    std::atomic< bool > _quit;                  ///< specifies if input thread should quit
+
+#   ifdef HID_LINUX_EVDEV
+    /** Event device data. */
+    struct Evdev
+    {
+        input_absinfo absinfo[ HID_MAX_AXES ];  ///< axes info
+        short axes[ ABS_CNT ];                  ///< absolute axes codes to axes map, -1 if not mapped
+        short butt[ KEY_CNT ];                  ///< key codes to buttons map, -1 if not mapped
+        short effect;                           ///< force feedback effect id, -1 if not uploaded
+        bool ff;                                ///< specifies if device supports constant force
+    };
+
+    Evdev _evdev[ HID_MAX_JOYS ];               ///< event devices data
+
+    std::mutex _forceMutex;                     ///< mutex guarding force feedback effects
+
+    void initEvdev();
+
+    bool processEvent( short joyNum, const input_event &event );
+#   else
+    void initJoydev();
+
+    void processEvent( short joyNum, const js_event &event );
+#   endif
+
+    void updatePOVs( short joyNum );
+
+    void work();
 #   endif
 
 #   ifdef HID_WINMM_JOYSTICK
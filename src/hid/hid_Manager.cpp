@@ -27,6 +27,9 @@
 
 #include <hid/hid_Joysticks.h>
 
+#include <fdm/utils/fdm_Metrics.h>
+#include <fdm/utils/fdm_Profiler.h>
+
 #include <sim/Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -280,6 +283,11 @@ void Manager::reset( bool onGround )
 
 void Manager::update( double timeStep )
 {
+    FDM_PROFILE_FUNCTION();
+    FDM_METRICS_ZONE( "hid.update" );
+
+    std::lock_guard< std::mutex > lock( _mutex );
+
     _timeStep = timeStep;
 
     Joysticks::instance()->update();
@@ -292,6 +300,8 @@ void Manager::update( double timeStep )
 
 void Manager::setAssingment( Assignment::Action action, const Assignment &assignment )
 {
+    std::lock_guard< std::mutex > lock( _mutex );
+
     _assignments[ action ] = assignment;
 }
 
@@ -299,6 +309,8 @@ void Manager::setAssingment( Assignment::Action action, const Assignment &assign
 
 void Manager::setKeysState( bool keysState[] )
 {
+    std::lock_guard< std::mutex > lock( _mutex );
+
     for ( unsigned int i = 0; i < HID_MAX_KEYS; i++ )
     {
         _keysState[ i ] = keysState[ i ];
@@ -309,6 +321,8 @@ void Manager::setKeysState( bool keysState[] )
 
 void Manager::setNotches( const std::vector< double > &notches )
 {
+    std::lock_guard< std::mutex > lock( _mutex );
+
     _notches.clear();
     _notches = notches;
 }
@@ -24,6 +24,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,9 @@ namespace hid
 
 /**
  * @brief HID manager class.
+ *
+ * Manager is updated by the simulation thread. Assignments, keys state and
+ * flaps notches might be set from GUI thread, they are guarded by mutex.
  */
 class Manager : public Singleton< Manager >
 {
@@ -185,6 +189,8 @@ private:
 
     std::vector< double > _notches;             ///< flaps notches
 
+    std::mutex _mutex;                          ///< mutex guarding assignments, keys state and notches
+
     /** */
     void getAxisValue( const Assignment &assignment, double *value, int absolute = 0 );
 
@@ -33,6 +33,29 @@
 
 #include <Manager.h>
 
+#ifdef FDM_PROFILER
+#   include <QDir>
+#   include <fdm/utils/fdm_Profiler.h>
+#endif
+
+#ifdef SIM_THREAD_PLACEMENT
+#   include <fdm/utils/fdm_ThreadPlacement.h>
+#endif
+
+#ifdef FDM_METRICS
+#   include <sim/MetricsExporter.h>
+#endif
+
+#ifdef SIM_CLUSTER_SYNC
+#   include <sim/ClusterSync.h>
+#endif
+
+#ifdef SIM_HEAD_TRACKING
+#   include <sim/HeadTracker.h>
+#endif
+
+#include <fdm/utils/fdm_MemoryStats.h>
+
 #include <sim/Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -77,15 +100,103 @@ int main( int argc, char *argv[] )
     app->setOrganizationDomain ( SIM_ORG_DOMAIN );
     app->setOrganizationName   ( SIM_ORG_NAME   );
 
+#   ifdef SIM_THREAD_PLACEMENT
+    // has to be configured before any thread (including fleet workers) starts
+    fdm::ThreadPlacement::Config placement;
+
+    placement.cores[ fdm::ThreadPlacement::Simulation ] = SIM_PLACEMENT_SIM_CORES;
+    placement.cores[ fdm::ThreadPlacement::Render     ] = SIM_PLACEMENT_RENDER_CORES;
+    placement.cores[ fdm::ThreadPlacement::Sound      ] = SIM_PLACEMENT_SFX_CORES;
+    placement.cores[ fdm::ThreadPlacement::Workers    ] = SIM_PLACEMENT_WORKER_CORES;
+
+    placement.node          = SIM_PLACEMENT_NUMA_NODE;
+    placement.avoidSiblings = SIM_PLACEMENT_AVOID_SIBLINGS;
+    placement.isolateRender = SIM_PLACEMENT_ISOLATE_RENDER;
+
+    fdm::ThreadPlacement::configure( placement );
+
+    const char *roleNames[] = { "simulation", "render", "sound", "workers" };
+
+    for ( int i = 0; i < fdm::ThreadPlacement::RolesCount; i++ )
+    {
+        fdm::ThreadPlacement::CPUs cpus = fdm::ThreadPlacement::getCPUs( (fdm::ThreadPlacement::Role)i );
+
+        Log::i() << "Thread placement " << roleNames[ i ] << ":";
+        for ( unsigned int j = 0; j < cpus.size(); j++ ) Log::out() << " " << cpus[ j ];
+        Log::out() << ( cpus.empty() ? " not pinned" : "" ) << std::endl;
+    }
+#   endif
+
+    // FDM and other time critical threads log without blocking on output
+    Log::startAsync();
+
+#   ifdef FDM_METRICS
+    MetricsExporter *metrics = new MetricsExporter();
+
+    if ( !metrics->open( SIM_METRICS_ADDRESS, SIM_METRICS_PORT,
+                         SIM_METRICS_INTERVAL, SIM_METRICS_PREFIX ) )
+    {
+        Log::w() << "Cannot open metrics exporter." << std::endl;
+    }
+#   endif
+
+#   ifdef SIM_CLUSTER_SYNC
+    if ( !ClusterSync::instance()->open( SIM_CLUSTER_MASTER != 0, SIM_CLUSTER_ADDRESS, SIM_CLUSTER_PORT,
+                                         SIM_CLUSTER_SLAVES, SIM_CLUSTER_FRAME_TIMEOUT,
+                                         SIM_CLUSTER_SWAP_TIMEOUT ) )
+    {
+        Log::w() << "Cannot open cluster synchronization." << std::endl;
+    }
+#   endif
+
+#   ifdef SIM_HEAD_TRACKING
+    if ( !HeadTracker::instance()->open( SIM_HEAD_TRACKING_PORT, SIM_HEAD_TRACKING_LEAD,
+                                         SIM_HEAD_TRACKING_HORIZON, SIM_HEAD_TRACKING_TIMEOUT ) )
+    {
+        Log::w() << "Cannot open head tracker." << std::endl;
+    }
+#   endif
+
     Manager *mgr = new Manager();
 
     mgr->init();
 
     int result = app->exec();
 
+    Log::i() << "Memory usage:" << std::endl;
+    fdm::MemoryStats::dump( Log::out() );
+
     delete mgr; mgr = NULLPTR;
     delete app; app = NULLPTR;
 
+#   ifdef FDM_METRICS
+    delete metrics; metrics = NULLPTR;
+#   endif
+
+#   ifdef SIM_HEAD_TRACKING
+    HeadTracker::instance()->close();
+#   endif
+
+#   ifdef SIM_CLUSTER_SYNC
+    if ( ClusterSync::instance()->getLateSwaps() > 0 )
+    {
+        Log::i() << "Cluster late swaps: " << ClusterSync::instance()->getLateSwaps() << std::endl;
+    }
+
+    ClusterSync::instance()->close();
+#   endif
+
+    Log::stopAsync();
+
+#   ifdef FDM_PROFILER
+#   ifdef _LINUX_
+    fdm::Profiler::writeTrace( "/tmp/mscsim_trace.json" );
+#   endif
+#   ifdef WIN32
+    fdm::Profiler::writeTrace( ( QDir::homePath() + "/mscsim_trace.json" ).toLocal8Bit().data() );
+#   endif
+#   endif
+
 #   ifndef SIM_TEST
     std::cerr.rdbuf( strbuf );
     if ( out.is_open() )
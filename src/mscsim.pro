@@ -33,7 +33,30 @@ win32: QMAKE_LFLAGS += /INCREMENTAL:NO
 DEFINES += QT_DEPRECATED_WARNINGS
 
 DEFINES += \
+#    CGI_DYNAMIC_RESOLUTION \
+#    CGI_FRAME_STATS \
+#    CGI_MODELS_OSGB_CACHE \
+#    CGI_OTW_CHANNELS=3 \
+#    CGI_OTW_CHANNELS_FLAT \
+#    CGI_SHADOW_QUALITY=2 \
+#    HID_LINUX_EVDEV \
+#    SFX_ENGINE_SYNTH \
+#    SIM_CLUSTER_SYNC \
+#    SIM_DATAOUT_STREAM \
+#    SIM_EFIS_OSG \
+#    SIM_EVENT_SCRIPT \
+#    SIM_HEAD_TRACKING \
+#    SIM_LOW_POWER_IDLE \
 #    SIM_OSG_DEBUG_INFO \
+#    SIM_OSG_SHARED_CONTEXT \
+#    SIM_OSG_THREADING_MODEL=DrawThreadPerContext \
+#    SIM_REALTIME_SCHEDULER \
+#    SIM_REMOTE_FDM \
+#    SIM_RENDER_BENCHMARK \
+#    SIM_REPLAY_DIRECT \
+#    SIM_SHARED_DATAOUT \
+#    SIM_THREAD_PLACEMENT \
+#    SIM_WINGMEN=3 \
     SIM_INTERSECTIONS \
     SIM_SKYDOME_SCALING \
     SIM_USE_THREADS \
@@ -42,6 +65,12 @@ DEFINES += \
 DEFINES += FDM_TEST
 DEFINES += SIM_TEST
 #DEFINES += SIM_TEST_WORLD
+#DEFINES += FDM_ALLOC_TRACKING
+#DEFINES += FDM_IMPLICIT_CONTACT
+#DEFINES += FDM_METRICS
+#DEFINES += FDM_PROFILER
+#DEFINES += FDM_LOCKSTEP
+#DEFINES += FDM_UNCHECKED
 
 greaterThan(QT_MAJOR_VERSION, 4):win32: DEFINES += USE_QT5
 
@@ -82,7 +111,8 @@ win32: LIBS += \
     -llibxml2 \
     -lopenal32 \
     -lopengl32 \
-    -lwinmm
+    -lwinmm \
+    -lws2_32
 
 win32: CONFIG(release, debug|release): LIBS += \
     -lOpenThreads \
@@ -90,6 +120,7 @@ win32: CONFIG(release, debug|release): LIBS += \
     -losgDB \
     -losgGA \
     -losgParticle \
+    -losgShadow \
     -losgSim \
     -losgText \
     -losgUtil \
@@ -102,6 +133,7 @@ win32: CONFIG(debug, debug|release): LIBS += \
     -losgDBd \
     -losgGAd \
     -losgParticled \
+    -losgShadowd \
     -losgSimd \
     -losgTextd \
     -losgUtild \
@@ -115,12 +147,14 @@ unix: LIBS += \
     -lopenal \
     -lX11 \
     -lXss \
+    -lrt \
     -lxml2 \
     -lOpenThreads \
     -losg \
     -losgDB \
     -losgGA \
     -losgParticle \
+    -losgShadow \
     -losgSim \
     -losgText \
     -losgUtil \
@@ -131,6 +165,7 @@ unix: LIBS += \
 
 HEADERS += \
     $$PWD/Autopilot.h \
+    $$PWD/ControlInput.h \
     $$PWD/Data.h \
     $$PWD/Defines.h \
     $$PWD/Manager.h \
@@ -139,6 +174,7 @@ HEADERS += \
 SOURCES += \
     $$PWD/main.cpp \
     $$PWD/Autopilot.cpp \
+    $$PWD/ControlInput.cpp \
     $$PWD/Manager.cpp \
     $$PWD/Simulation.cpp
 
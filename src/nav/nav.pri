@@ -1,9 +1,11 @@
 HEADERS += \
     $$PWD/nav_DataBase.h \
     $$PWD/nav_Frequency.h \
+    $$PWD/nav_LineOfSight.h \
     $$PWD/nav_Manager.h
 
 SOURCES += \
     $$PWD/nav_DataBase.cpp \
     $$PWD/nav_Frequency.cpp \
+    $$PWD/nav_LineOfSight.cpp \
     $$PWD/nav_Manager.cpp
@@ -23,11 +23,16 @@
 #include <nav/nav_DataBase.h>
 
 #include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
 
 #include <QDomElement>
 #include <QFile>
 
+#include <fdm/utils/fdm_MemoryStats.h>
 #include <fdm/utils/fdm_String.h>
 #include <fdm/utils/fdm_Units.h>
 #include <fdm/utils/fdm_WGS84.h>
@@ -42,6 +47,97 @@ using namespace nav;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+const char cacheMagic[ 8 ] = { 'N', 'A', 'V', 'D', 'B', 'I', 'N', '1' };
+
+/** Binary cache header, plain data which might be copied with memcpy. */
+struct CacheHeader
+{
+    char magic[ 8 ];            ///< file magic
+    fdm::UInt64 key;            ///< data files key
+    fdm::UInt32 count_apt;      ///< number of airports records
+    fdm::UInt32 count_ils;      ///< number of ILS records
+    fdm::UInt32 count_nav;      ///< number of navaids records
+    fdm::UInt32 count_rwy;      ///< number of runways records
+    fdm::UInt32 size_str;       ///< [B] strings table size
+    fdm::UInt32 padding;        ///< unused
+};
+
+/** Airport record, strings are offsets into the strings table. */
+struct RecordAPT
+{
+    fdm::UInt32 ident;          ///< ident offset
+    fdm::UInt32 name;           ///< name offset
+    fdm::UInt32 icao;           ///< ICAO code offset
+    fdm::UInt32 padding;        ///< unused
+    double lat;                 ///< [rad] latitude
+    double lon;                 ///< [rad] longitude
+};
+
+/** ILS component record. */
+struct RecordILS
+{
+    fdm::UInt32 type;           ///< type
+    fdm::UInt32 freq;           ///< [kHz] frequency
+    double lat;                 ///< [rad] latitude
+    double lon;                 ///< [rad] longitude
+    double elev;                ///< [m] elevation
+    double true_bearing;        ///< [rad] true bearing
+    double glide_slope;         ///< [rad] glide slope angle
+    double pos_wgs[ 3 ];        ///< [m] position expressed in WGS
+};
+
+/** Navaid record. */
+struct RecordNAV
+{
+    fdm::UInt32 type;           ///< type
+    fdm::UInt32 freq;           ///< [kHz] frequency
+    double lat;                 ///< [rad] latitude
+    double lon;                 ///< [rad] longitude
+    double elev;                ///< [m] elevation
+    double pos_wgs[ 3 ];        ///< [m] position expressed in WGS
+};
+
+/** Adds string to the strings table and returns its offset. */
+fdm::UInt32 addString( std::string *table, const std::string &str )
+{
+    fdm::UInt32 offset = table->size();
+
+    table->append( str.c_str(), str.size() + 1 );
+
+    return offset;
+}
+
+/** Reads records array, returns false on failure. */
+template < class TYPE >
+bool readRecords( std::ifstream *ifs, std::vector< TYPE > *records, fdm::UInt32 count )
+{
+    records->resize( count );
+
+    if ( count > 0 )
+    {
+        ifs->read( (char*)&(*records)[ 0 ], count * sizeof(TYPE) );
+    }
+
+    return !ifs->fail();
+}
+
+/** Writes records array. */
+template < class TYPE >
+void writeRecords( std::ofstream *ofs, const std::vector< TYPE > &records )
+{
+    if ( records.size() > 0 )
+    {
+        ofs->write( (const char*)&records[ 0 ], records.size() * sizeof(TYPE) );
+    }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 double DataBase::getTrueBearing( const char *str_bear, const char *str_magvar )
 {
     double bear = fdm::Units::deg2rad( fdm::String::toDouble( str_bear ) );
@@ -86,73 +182,70 @@ double DataBase::getTrueBearing( const char *str_bear, const char *str_magvar )
 
 DataBase::DataBase()
 {
-    QFile file( Path::get( "nav/nav_db.xml" ).c_str() );
+    std::string dbFile = Path::get( "nav/nav_db.xml" );
+    std::string cacheFile = dbFile + ".cache";
 
-    if ( file.open(QFile::ReadOnly | QFile::Text) )
-    {
-        QDomDocument doc;
+    Files files;
 
-        doc.setContent( &file, false );
+    readFiles( dbFile.c_str(), &files );
 
-        QDomElement rootNode = doc.documentElement();
+    fdm::UInt64 key = getKey( files );
 
-        if ( rootNode.tagName() == "nav_db" )
-        {
-            QDomElement nodeAPT = rootNode.firstChildElement( "apt" );
-            QDomElement nodeILS = rootNode.firstChildElement( "ils" );
-            QDomElement nodeNAV = rootNode.firstChildElement( "nav" );
-            QDomElement nodeRWY = rootNode.firstChildElement( "rwy" );
+    if ( !readCache( cacheFile.c_str(), key ) )
+    {
+        _list_apt.clear();
+        _list_ils.clear();
+        _list_nav.clear();
+        _list_rwy.clear();
 
-            if ( !nodeAPT.isNull() )
-            {
-                QDomElement fileNode = nodeAPT.firstChildElement( "file" );
+        for ( unsigned int i = 0; i < files.apt.size(); i++ ) parseAPT( files.apt[ i ].c_str() );
+        for ( unsigned int i = 0; i < files.ils.size(); i++ ) parseILS( files.ils[ i ].c_str() );
+        for ( unsigned int i = 0; i < files.nav.size(); i++ ) parseNAV( files.nav[ i ].c_str() );
+        for ( unsigned int i = 0; i < files.rwy.size(); i++ ) parseRWY( files.rwy[ i ].c_str() );
 
-                while ( !fileNode.isNull() )
-                {
-                    parseAPT( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
+        writeCache( cacheFile.c_str(), key );
+    }
 
-            if ( !nodeILS.isNull() )
-            {
-                QDomElement fileNode = nodeILS.firstChildElement( "file" );
+    createIndices();
 
-                while ( !fileNode.isNull() )
-                {
-                    parseILS( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
+    _bytes = getDataSize();
+    fdm::MemoryStats::allocate( fdm::MemoryStats::add( "nav.database" ), _bytes );
+}
 
-            if ( !nodeNAV.isNull() )
-            {
-                QDomElement fileNode = nodeNAV.firstChildElement( "file" );
+////////////////////////////////////////////////////////////////////////////////
 
-                while ( !fileNode.isNull() )
-                {
-                    parseNAV( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
+DataBase::~DataBase()
+{
+    fdm::MemoryStats::release( fdm::MemoryStats::add( "nav.database" ), _bytes );
+}
 
-            if ( !nodeRWY.isNull() )
-            {
-                QDomElement fileNode = nodeRWY.firstChildElement( "file" );
+////////////////////////////////////////////////////////////////////////////////
 
-                while ( !fileNode.isNull() )
-                {
-                    parseRWY( fileNode.text().toStdString().c_str() );
-                    fileNode = fileNode.nextSiblingElement( "file" );
-                }
-            }
-        }
+const DataBase::Indices& DataBase::getIndicesILS( int freq ) const
+{
+    IndexFreq::const_iterator it = _index_ils.find( freq );
+
+    if ( it != _index_ils.end() )
+    {
+        return it->second;
     }
+
+    return _indices_none;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-DataBase::~DataBase() {}
+const DataBase::Indices& DataBase::getIndicesNAV( int freq ) const
+{
+    IndexFreq::const_iterator it = _index_nav.find( freq );
+
+    if ( it != _index_nav.end() )
+    {
+        return it->second;
+    }
+
+    return _indices_none;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -164,6 +257,9 @@ void DataBase::parseAPT( const char *path )
     {
         std::string line;
 
+        // tokens refer to the line, so the vector is reused without copying
+        fdm::String::Views cols;
+
         int i_line = 0;
 
         while ( !file.eof() )
@@ -172,17 +268,15 @@ void DataBase::parseAPT( const char *path )
 
             if ( i_line > 0 )
             {
-                std::vector< std::string > cols = fdm::String::split( line, "\t" );
-
-                line.clear();
+                fdm::String::split( line, '\t', &cols );
 
                 if ( cols.size() == 23 )
                 {
                     APT apt;
 
-                    apt.ident = cols.at( 0 );
-                    apt.name  = cols.at( 1 );
-                    apt.icao  = cols.at( 3 );
+                    apt.ident = cols.at( 0 ).str();
+                    apt.name  = cols.at( 1 ).str();
+                    apt.icao  = cols.at( 3 ).str();
 
                     apt.lat = fdm::Units::deg2rad( fdm::String::toDouble( cols.at(  8 ) ) );
                     apt.lon = fdm::Units::deg2rad( fdm::String::toDouble( cols.at( 10 ) ) );
@@ -206,6 +300,9 @@ void DataBase::parseILS( const char *path )
     {
         std::string line;
 
+        // tokens refer to the line, so the vector is reused without copying
+        fdm::String::Views cols;
+
         int i_line = 0;
 
         while ( !file.eof() )
@@ -214,9 +311,7 @@ void DataBase::parseILS( const char *path )
 
             if ( i_line > 0 )
             {
-                std::vector< std::string > cols = fdm::String::split( line, "\t" );
-
-                line.clear();
+                fdm::String::split( line, '\t', &cols );
 
                 if ( cols.size() == 29 )
                 {
@@ -224,7 +319,7 @@ void DataBase::parseILS( const char *path )
                     {
                         ILS ils;
 
-                        switch( toupper( cols.at( 2 ).c_str()[ 0 ] ) )
+                        switch( toupper( cols.at( 2 )[ 0 ] ) )
                         {
                             default:  ils.type = ILS::NONE; break;
                             case 'D': ils.type = ILS::DME;  break;
@@ -243,14 +338,14 @@ void DataBase::parseILS( const char *path )
 
                             ils.elev = fdm::Units::ft2m( fdm::String::toDouble( cols.at( 10 ) ) );
 
-                            ils.true_bearing = ils.type == ILS::LOC ? getTrueBearing( cols.at( 24 ).c_str(), cols.at( 22 ).c_str() ) : 0.0;
+                            ils.true_bearing = ils.type == ILS::LOC ? getTrueBearing( cols.at( 24 ).str().c_str(), cols.at( 22 ).str().c_str() ) : 0.0;
                             ils.glide_slope  = ils.type == ILS::GS  ? fdm::Units::deg2rad( fdm::String::toDouble( cols.at( 7 ) ) ) : 0.0;
 
                             ils.freq = fdm::String::toDouble( cols.at( 5 ) );
 
                             if ( ils.type == ILS::DME && cols.at( 6 ).length() > 0 )
                             {
-                                ils.freq = Frequency::getFreqDME( cols.at( 6 ).c_str() );
+                                ils.freq = Frequency::getFreqDME( cols.at( 6 ).str().c_str() );
                             }
 
                             fdm::WGS84::Geo position_geo;
@@ -282,6 +377,9 @@ void DataBase::parseNAV( const char *path )
     {
         std::string line;
 
+        // tokens refer to the line, so the vector is reused without copying
+        fdm::String::Views cols;
+
         int i_line = 0;
 
         while ( !file.eof() )
@@ -290,9 +388,7 @@ void DataBase::parseNAV( const char *path )
 
             if ( i_line > 0 )
             {
-                std::vector< std::string > cols = fdm::String::split( line, "\t" );
-
-                line.clear();
+                fdm::String::split( line, '\t', &cols );
 
                 if ( cols.size() == 32 )
                 {
@@ -348,6 +444,9 @@ void DataBase::parseRWY( const char *path )
     {
         std::string line;
 
+        // tokens refer to the line, so the vector is reused without copying
+        fdm::String::Views cols;
+
         int i_line = 0;
 
         while ( !file.eof() )
@@ -356,9 +455,7 @@ void DataBase::parseRWY( const char *path )
 
             if ( i_line > 0 )
             {
-                std::vector< std::string > cols = fdm::String::split( line, "\t" );
-
-                line.clear();
+                fdm::String::split( line, '\t', &cols );
 
                 if ( cols.size() == 51 )
                 {
@@ -385,3 +482,354 @@ void DataBase::parseRWY( const char *path )
         }
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataBase::readFiles( const char *dbFile, Files *files )
+{
+    QFile file( dbFile );
+
+    if ( file.open(QFile::ReadOnly | QFile::Text) )
+    {
+        QDomDocument doc;
+
+        doc.setContent( &file, false );
+
+        QDomElement rootNode = doc.documentElement();
+
+        if ( rootNode.tagName() == "nav_db" )
+        {
+            const char *tags[] = { "apt", "ils", "nav", "rwy" };
+
+            std::vector< std::string > *lists[] =
+            {
+                &files->apt,
+                &files->ils,
+                &files->nav,
+                &files->rwy
+            };
+
+            for ( int i = 0; i < 4; i++ )
+            {
+                QDomElement node = rootNode.firstChildElement( tags[ i ] );
+
+                if ( !node.isNull() )
+                {
+                    QDomElement fileNode = node.firstChildElement( "file" );
+
+                    while ( !fileNode.isNull() )
+                    {
+                        lists[ i ]->push_back( fileNode.text().toStdString() );
+                        fileNode = fileNode.nextSiblingElement( "file" );
+                    }
+                }
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::UInt64 DataBase::getKey( const Files &files )
+{
+    std::stringstream ss;
+
+    const std::vector< std::string > *lists[] =
+    {
+        &files.apt,
+        &files.ils,
+        &files.nav,
+        &files.rwy
+    };
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        ss << "[" << i << "]";
+
+        for ( unsigned int j = 0; j < lists[ i ]->size(); j++ )
+        {
+            std::string path = Path::get( lists[ i ]->at( j ) );
+
+            struct stat info;
+
+            if ( 0 == stat( path.c_str(), &info ) )
+            {
+                ss << path << ";" << info.st_size << ";" << info.st_mtime << ";";
+            }
+            else
+            {
+                ss << path << ";-;";
+            }
+        }
+    }
+
+    // hash (FNV-1a) of the files description
+    std::string data = ss.str();
+
+    fdm::UInt64 hash = 14695981039346656037ULL;
+
+    for ( size_t i = 0; i < data.size(); i++ )
+    {
+        hash ^= (fdm::UInt8)data[ i ];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool DataBase::readCache( const char *cacheFile, fdm::UInt64 key )
+{
+    std::ifstream ifs( cacheFile, std::ios_base::in | std::ios_base::binary );
+
+    if ( !ifs.is_open() ) return false;
+
+    CacheHeader header;
+
+    ifs.read( (char*)&header, sizeof(CacheHeader) );
+
+    if ( ifs.fail()
+      || 0 != memcmp( header.magic, cacheMagic, sizeof(cacheMagic) )
+      || header.key != key )
+    {
+        return false;
+    }
+
+    std::vector< RecordAPT > records_apt;
+    std::vector< RecordILS > records_ils;
+    std::vector< RecordNAV > records_nav;
+    std::vector< RWY >       records_rwy;
+    std::vector< char >      strings;
+
+    if ( !readRecords( &ifs, &records_apt, header.count_apt )
+      || !readRecords( &ifs, &records_ils, header.count_ils )
+      || !readRecords( &ifs, &records_nav, header.count_nav )
+      || !readRecords( &ifs, &records_rwy, header.count_rwy )
+      || !readRecords( &ifs, &strings, header.size_str ) )
+    {
+        return false;
+    }
+
+    // strings table has to be null terminated
+    if ( strings.size() > 0 && strings.back() != '\0' ) return false;
+
+    _list_apt.resize( records_apt.size() );
+    _list_ils.resize( records_ils.size() );
+    _list_nav.resize( records_nav.size() );
+
+    for ( unsigned int i = 0; i < records_apt.size(); i++ )
+    {
+        const RecordAPT &r = records_apt[ i ];
+
+        if ( r.ident >= strings.size()
+          || r.name  >= strings.size()
+          || r.icao  >= strings.size() )
+        {
+            return false;
+        }
+
+        APT &apt = _list_apt[ i ];
+
+        apt.ident = &strings[ r.ident ];
+        apt.name  = &strings[ r.name  ];
+        apt.icao  = &strings[ r.icao  ];
+
+        apt.lat = r.lat;
+        apt.lon = r.lon;
+    }
+
+    for ( unsigned int i = 0; i < records_ils.size(); i++ )
+    {
+        const RecordILS &r = records_ils[ i ];
+
+        ILS &ils = _list_ils[ i ];
+
+        ils.type = (ILS::Type)r.type;
+
+        ils.lat  = r.lat;
+        ils.lon  = r.lon;
+        ils.elev = r.elev;
+
+        ils.true_bearing = r.true_bearing;
+        ils.glide_slope  = r.glide_slope;
+
+        ils.freq = r.freq;
+
+        ils.pos_wgs.set( r.pos_wgs[ 0 ], r.pos_wgs[ 1 ], r.pos_wgs[ 2 ] );
+    }
+
+    for ( unsigned int i = 0; i < records_nav.size(); i++ )
+    {
+        const RecordNAV &r = records_nav[ i ];
+
+        NAV &nav = _list_nav[ i ];
+
+        nav.type = (NAV::Type)r.type;
+
+        nav.lat  = r.lat;
+        nav.lon  = r.lon;
+        nav.elev = r.elev;
+
+        nav.freq = r.freq;
+
+        nav.pos_wgs.set( r.pos_wgs[ 0 ], r.pos_wgs[ 1 ], r.pos_wgs[ 2 ] );
+    }
+
+    _list_rwy = records_rwy;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataBase::writeCache( const char *cacheFile, fdm::UInt64 key )
+{
+    std::string strings;
+
+    std::vector< RecordAPT > records_apt( _list_apt.size() );
+    std::vector< RecordILS > records_ils( _list_ils.size() );
+    std::vector< RecordNAV > records_nav( _list_nav.size() );
+
+    for ( unsigned int i = 0; i < _list_apt.size(); i++ )
+    {
+        RecordAPT &r = records_apt[ i ];
+
+        r.ident   = addString( &strings, _list_apt[ i ].ident );
+        r.name    = addString( &strings, _list_apt[ i ].name  );
+        r.icao    = addString( &strings, _list_apt[ i ].icao  );
+        r.padding = 0;
+
+        r.lat = _list_apt[ i ].lat;
+        r.lon = _list_apt[ i ].lon;
+    }
+
+    for ( unsigned int i = 0; i < _list_ils.size(); i++ )
+    {
+        RecordILS &r = records_ils[ i ];
+        const ILS &ils = _list_ils[ i ];
+
+        r.type = ils.type;
+        r.freq = ils.freq;
+
+        r.lat  = ils.lat;
+        r.lon  = ils.lon;
+        r.elev = ils.elev;
+
+        r.true_bearing = ils.true_bearing;
+        r.glide_slope  = ils.glide_slope;
+
+        r.pos_wgs[ 0 ] = ils.pos_wgs.x();
+        r.pos_wgs[ 1 ] = ils.pos_wgs.y();
+        r.pos_wgs[ 2 ] = ils.pos_wgs.z();
+    }
+
+    for ( unsigned int i = 0; i < _list_nav.size(); i++ )
+    {
+        RecordNAV &r = records_nav[ i ];
+        const NAV &nav = _list_nav[ i ];
+
+        r.type = nav.type;
+        r.freq = nav.freq;
+
+        r.lat  = nav.lat;
+        r.lon  = nav.lon;
+        r.elev = nav.elev;
+
+        r.pos_wgs[ 0 ] = nav.pos_wgs.x();
+        r.pos_wgs[ 1 ] = nav.pos_wgs.y();
+        r.pos_wgs[ 2 ] = nav.pos_wgs.z();
+    }
+
+    CacheHeader header;
+
+    memset( &header, 0, sizeof(CacheHeader) );
+    memcpy( header.magic, cacheMagic, sizeof(cacheMagic) );
+
+    header.key       = key;
+    header.count_apt = records_apt.size();
+    header.count_ils = records_ils.size();
+    header.count_nav = records_nav.size();
+    header.count_rwy = _list_rwy.size();
+    header.size_str  = strings.size();
+
+    // written into temporary file first and then renamed, so other instances
+    // never read a partially written cache file
+    std::stringstream tempFile;
+    tempFile << cacheFile << "." << (const void*)this;
+
+    std::ofstream ofs( tempFile.str().c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+
+    // data directory might be read-only, text files are parsed every time then
+    if ( !ofs.is_open() ) return;
+
+    ofs.write( (const char*)&header, sizeof(CacheHeader) );
+
+    writeRecords( &ofs, records_apt );
+    writeRecords( &ofs, records_ils );
+    writeRecords( &ofs, records_nav );
+    writeRecords( &ofs, _list_rwy );
+
+    ofs.write( strings.c_str(), strings.size() );
+
+    ofs.close();
+
+    if ( ofs.fail() || 0 != rename( tempFile.str().c_str(), cacheFile ) )
+    {
+        remove( tempFile.str().c_str() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::UInt64 DataBase::getDataSize() const
+{
+    fdm::UInt64 bytes = 0;
+
+    bytes += _list_apt.capacity() * sizeof(APT);
+    bytes += _list_ils.capacity() * sizeof(ILS);
+    bytes += _list_nav.capacity() * sizeof(NAV);
+    bytes += _list_rwy.capacity() * sizeof(RWY);
+
+    // short strings are stored within the string object itself
+    const size_t sso = std::string().capacity();
+
+    for ( ListAPT::const_iterator it = _list_apt.begin(); it != _list_apt.end(); ++it )
+    {
+        if ( it->ident.capacity() > sso ) bytes += it->ident.capacity() + 1;
+        if ( it->name.capacity()  > sso ) bytes += it->name.capacity()  + 1;
+        if ( it->icao.capacity()  > sso ) bytes += it->icao.capacity()  + 1;
+    }
+
+    const IndexFreq *indices[] = { &_index_ils, &_index_nav };
+
+    for ( unsigned int i = 0; i < 2; i++ )
+    {
+        for ( IndexFreq::const_iterator it = indices[ i ]->begin(); it != indices[ i ]->end(); ++it )
+        {
+            // tree node overhead is approximated by four pointers
+            bytes += sizeof(IndexFreq::value_type) + 4 * sizeof(void*);
+            bytes += it->second.capacity() * sizeof(unsigned int);
+        }
+    }
+
+    return bytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataBase::createIndices()
+{
+    _index_ils.clear();
+    _index_nav.clear();
+
+    for ( unsigned int i = 0; i < _list_ils.size(); i++ )
+    {
+        _index_ils[ _list_ils[ i ].freq ].push_back( i );
+    }
+
+    for ( unsigned int i = 0; i < _list_nav.size(); i++ )
+    {
+        _index_nav[ _list_nav[ i ].freq ].push_back( i );
+    }
+}
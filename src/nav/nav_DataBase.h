@@ -24,9 +24,12 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <map>
 #include <string>
 #include <vector>
 
+#include <fdm/fdm_Types.h>
+
 #include <fdm/utils/fdm_Vector3.h>
 
 #include <sim/Singleton.h>
@@ -38,6 +41,12 @@ namespace nav
 
 /**
  * @brief Navigation data base class.
+ *
+ * Text data files are parsed only if the binary cache written next to the
+ * data base file is missing or stale, i.e. any data file has been changed
+ * since the cache was written.
+ *
+ * Estimated data size is accounted as "nav.database" memory subsystem.
  */
 class DataBase : public Singleton< DataBase >
 {
@@ -136,6 +145,9 @@ public:
     typedef std::vector< NAV > ListNAV;
     typedef std::vector< RWY > ListRWY;
 
+    typedef std::vector< unsigned int > Indices;    ///< list items indices
+    typedef std::map< int, Indices > IndexFreq;     ///< list items indices by frequency
+
     static double getTrueBearing( const char *str_bear, const char *str_magvar );
 
     /** @brief Destructor. */
@@ -146,13 +158,43 @@ public:
     const ListNAV& getListNAV() const { return _list_nav; }
     const ListRWY& getListRWY() const { return _list_rwy; }
 
+    /**
+     * @brief Returns indices of ILS list items on the given frequency.
+     * @param freq [kHz] frequency
+     * @return ILS list items indices
+     */
+    const Indices& getIndicesILS( int freq ) const;
+
+    /**
+     * @brief Returns indices of NAV list items on the given frequency.
+     * @param freq [kHz] frequency
+     * @return NAV list items indices
+     */
+    const Indices& getIndicesNAV( int freq ) const;
+
 private:
 
+    /** Data files lists. */
+    struct Files
+    {
+        std::vector< std::string > apt;     ///< airports data files
+        std::vector< std::string > ils;     ///< ILS data files
+        std::vector< std::string > nav;     ///< navaids data files
+        std::vector< std::string > rwy;     ///< runways data files
+    };
+
     ListAPT _list_apt;          ///<
     ListILS _list_ils;          ///<
     ListNAV _list_nav;          ///<
     ListRWY _list_rwy;          ///<
 
+    IndexFreq _index_ils;       ///< ILS list items indices by frequency
+    IndexFreq _index_nav;       ///< NAV list items indices by frequency
+
+    Indices _indices_none;      ///< empty indices list
+
+    fdm::UInt64 _bytes;         ///< [B] accounted data size
+
     /**
      * You should use static function instance() due to get refernce
      * to DataBase class instance.
@@ -166,6 +208,24 @@ private:
     void parseILS( const char *path );
     void parseNAV( const char *path );
     void parseRWY( const char *path );
+
+    void readFiles( const char *dbFile, Files *files );
+
+    /**
+     * @brief Returns key identifying data files contents.
+     * Key is computed from files paths, sizes and modification times.
+     * @param files data files lists
+     * @return data files key
+     */
+    fdm::UInt64 getKey( const Files &files );
+
+    bool readCache( const char *cacheFile, fdm::UInt64 key );
+    void writeCache( const char *cacheFile, fdm::UInt64 key );
+
+    /** Returns estimated data size. */
+    fdm::UInt64 getDataSize() const;
+
+    void createIndices();
 };
 
 } // end of nav namepsace
@@ -0,0 +1,106 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <nav/nav_LineOfSight.h>
+
+#ifdef SIM_INTERSECTIONS
+#   include <cgi/cgi_Intersections.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace nav;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const double LineOfSight::_antenna_agl = 10.0;
+const double LineOfSight::_margin      = 50.0;
+const double LineOfSight::_update_dist = 300.0;
+
+////////////////////////////////////////////////////////////////////////////////
+
+LineOfSight::LineOfSight() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool LineOfSight::isVisible( const void *station,
+                             const fdm::Vector3 &station_wgs,
+                             const fdm::Vector3 &aircraft_wgs )
+{
+    Entries::iterator it = _entries.find( station );
+
+    if ( it == _entries.end() )
+    {
+        Entry entry;
+
+        entry.aircraft_wgs = aircraft_wgs;
+        entry.visible = checkVisible( station_wgs, aircraft_wgs );
+
+        it = _entries.insert( Entries::value_type( station, entry ) ).first;
+    }
+    else if ( fdm::Vector3( aircraft_wgs - it->second.aircraft_wgs ).getLength2()
+              > _update_dist * _update_dist )
+    {
+        it->second.aircraft_wgs = aircraft_wgs;
+        it->second.visible = checkVisible( station_wgs, aircraft_wgs );
+    }
+
+    return it->second.visible;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool LineOfSight::checkVisible( const fdm::Vector3 &station_wgs,
+                                const fdm::Vector3 &aircraft_wgs )
+{
+#   ifdef SIM_INTERSECTIONS
+    // antenna raised along geocentric vertical, which is close enough to
+    // the geodetic one for a few metres offset
+    fdm::Vector3 antenna_wgs = station_wgs + station_wgs.getNormalized() * _antenna_agl;
+
+    fdm::Vector3 dir_wgs = aircraft_wgs - antenna_wgs;
+
+    double length = dir_wgs.getLength();
+
+    // obstacles close to both ends (antenna mast, ownship on ground)
+    // are not considered masking
+    if ( length > 2.0 * _margin )
+    {
+        dir_wgs *= 1.0 / length;
+
+        fdm::Vector3 b_wgs = antenna_wgs  + dir_wgs * _margin;
+        fdm::Vector3 e_wgs = aircraft_wgs - dir_wgs * _margin;
+
+        osg::Vec3d b( b_wgs.x(), b_wgs.y(), b_wgs.z() );
+        osg::Vec3d e( e_wgs.x(), e_wgs.y(), e_wgs.z() );
+        osg::Vec3d r;
+        osg::Vec3d n;
+
+        return !cgi::Intersections::instance()->findFirst( b, e, r, n );
+    }
+#   else
+    (void)station_wgs;
+    (void)aircraft_wgs;
+#   endif
+
+    return true;
+}
@@ -0,0 +1,90 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef NAV_LINEOFSIGHT_H
+#define NAV_LINEOFSIGHT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace nav
+{
+
+/**
+ * @brief Navaid terrain line-of-sight class.
+ *
+ * Checks if straight line between station antenna and ownship is clear of
+ * scenery. Results are cached per station and recomputed only when ownship
+ * moves farther than given distance from the position of the last check, so
+ * most calls only look up the cache.
+ */
+class LineOfSight
+{
+public:
+
+    static const double _antenna_agl;   ///< [m] station antenna height above ground level
+    static const double _margin;        ///< [m] distance from both ends of the line within which obstacles are ignored
+    static const double _update_dist;   ///< [m] ownship displacement after which line-of-sight is recomputed
+
+    /** @brief Constructor. */
+    LineOfSight();
+
+    /**
+     * @brief Checks if station is visible from ownship.
+     * @param station station identifier (e.g. data base record address)
+     * @param station_wgs [m] station position expressed in WGS
+     * @param aircraft_wgs [m] ownship position expressed in WGS
+     * @return true if station is not masked by terrain, false otherwise
+     */
+    bool isVisible( const void *station,
+                    const fdm::Vector3 &station_wgs,
+                    const fdm::Vector3 &aircraft_wgs );
+
+    /** @brief Clears cached results. */
+    inline void reset() { _entries.clear(); }
+
+private:
+
+    /** Cached line-of-sight result. */
+    struct Entry
+    {
+        fdm::Vector3 aircraft_wgs;  ///< [m] ownship position at the last check expressed in WGS
+        bool visible;               ///< specifies if station was visible at the last check
+    };
+
+    typedef std::map< const void*, Entry > Entries;
+
+    Entries _entries;               ///< cached results
+
+    static bool checkVisible( const fdm::Vector3 &station_wgs,
+                              const fdm::Vector3 &aircraft_wgs );
+};
+
+} // end of nav namepsace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // NAV_LINEOFSIGHT_H
@@ -22,6 +22,8 @@
 
 #include <nav/nav_Manager.h>
 
+#include <algorithm>
+
 #include <fdm/utils/fdm_Units.h>
 
 #include <Data.h>
@@ -45,6 +47,8 @@ const double Manager::_ils_lc_max = fdm::Units::deg2rad( 2.5 );
 
 const double Manager::_vor_max = fdm::Units::deg2rad( 10.0 );
 
+const double Manager::_tile_size = fdm::Units::deg2rad( 0.25 );
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Manager::Manager() :
@@ -54,6 +58,13 @@ Manager::Manager() :
     _vor     ( NULLPTR ),
     _ndb     ( NULLPTR ),
 
+    _tile_lat ( 0 ),
+    _tile_lon ( 0 ),
+    _tile_valid ( false ),
+
+    _rwy_loc ( NULLPTR ),
+    _rwy_gs  ( NULLPTR ),
+
     _course  ( 0.0 ),
 
     _adf_freq ( 190 ),
@@ -94,6 +105,7 @@ void Manager::update()
     while ( _course < 0.0        ) _course += 2.0 * M_PI;
     while ( _course > 2.0 * M_PI ) _course -= 2.0 * M_PI;
 
+    updateNearby();
     updateNavaids();
 
     Data::get()->navigation.adf_visible = _adf_visible;
@@ -141,6 +153,136 @@ double Manager::getDistance( const fdm::Vector3 &pos_wgs )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+const DataBase::Indices& Manager::getNearby( const DataBase::IndexFreq &nearby, int freq ) const
+{
+    DataBase::IndexFreq::const_iterator it = nearby.find( freq );
+
+    if ( it != nearby.end() )
+    {
+        return it->second;
+    }
+
+    return _nearby_none;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const DataBase::ILS* Manager::findILS( DataBase::ILS::Type type, int freq )
+{
+    const DataBase::ILS *result = NULLPTR;
+
+    double dist_min = _range_ils;
+
+    const DataBase::Indices &indices = getNearby( _nearby_ils, freq );
+
+    for ( unsigned int i = 0; i < indices.size(); i++ )
+    {
+        const DataBase::ILS &ils = DataBase::instance()->getListILS()[ indices[ i ] ];
+
+        if ( ils.type == type )
+        {
+            double dist = getDistance( ils.pos_wgs );
+
+            if ( dist < dist_min )
+            {
+                dist_min = dist;
+                result = &ils;
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const DataBase::NAV* Manager::findNAV( bool ndb, int freq, double range )
+{
+    const DataBase::NAV *result = NULLPTR;
+
+    double dist_min = range;
+
+    const DataBase::Indices &indices = getNearby( _nearby_nav, freq );
+
+    for ( unsigned int i = 0; i < indices.size(); i++ )
+    {
+        const DataBase::NAV &nav = DataBase::instance()->getListNAV()[ indices[ i ] ];
+
+        bool type_ok = ndb
+            ? ( nav.type == DataBase::NAV::NDB || nav.type == DataBase::NAV::NDB_DME )
+            : ( nav.type == DataBase::NAV::VOR || nav.type == DataBase::NAV::VOR_DME || nav.type == DataBase::NAV::VORTAC );
+
+        if ( type_ok )
+        {
+            double dist = getDistance( nav.pos_wgs );
+
+            if ( dist < dist_min )
+            {
+                dist_min = dist;
+                result = &nav;
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::updateNearby()
+{
+    fdm::WGS84::Geo pos_geo = _aircraft_wgs.getPos_Geo();
+
+    int tile_lat = static_cast< int >( floor( pos_geo.lat / _tile_size ) );
+    int tile_lon = static_cast< int >( floor( pos_geo.lon / _tile_size ) );
+
+    if ( _tile_valid && tile_lat == _tile_lat && tile_lon == _tile_lon )
+    {
+        return;
+    }
+
+    _tile_lat = tile_lat;
+    _tile_lon = tile_lon;
+    _tile_valid = true;
+
+    fdm::Vector3 center_wgs = fdm::WGS84::geo2wgs( ( tile_lat + 0.5 ) * _tile_size,
+                                                   ( tile_lon + 0.5 ) * _tile_size,
+                                                   0.0 ).getNormalized();
+
+    // half of the tile diagonal as longitude spacing never exceeds latitude one
+    double margin = M_SQRT1_2 * _tile_size;
+
+    double range_nav = std::max( _range_ndb, _range_vor );
+
+    // comparing cosines of angular distances avoids acos for every station
+    double cos_ils = cos( std::min( M_PI, _range_ils / fdm::WGS84::_r1 + margin ) );
+    double cos_nav = cos( std::min( M_PI,  range_nav / fdm::WGS84::_r1 + margin ) );
+
+    _nearby_ils.clear();
+    _nearby_nav.clear();
+
+    const DataBase::ListILS &list_ils = DataBase::instance()->getListILS();
+    const DataBase::ListNAV &list_nav = DataBase::instance()->getListNAV();
+
+    for ( unsigned int i = 0; i < list_ils.size(); i++ )
+    {
+        if ( list_ils[ i ].pos_wgs.getNormalized() * center_wgs > cos_ils )
+        {
+            _nearby_ils[ list_ils[ i ].freq ].push_back( i );
+        }
+    }
+
+    for ( unsigned int i = 0; i < list_nav.size(); i++ )
+    {
+        if ( list_nav[ i ].pos_wgs.getNormalized() * center_wgs > cos_nav )
+        {
+            _nearby_nav[ list_nav[ i ].freq ].push_back( i );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Manager::updateNavaids()
 {
     _adf_visible = false;
@@ -203,92 +345,20 @@ void Manager::updateNavaidsActive()
             _ndb = NULLPTR;
     }
 
-    if ( !_ils_loc )
-    {
-        for ( DataBase::ListILS::const_iterator it = DataBase::instance()->getListILS().begin();
-              it != DataBase::instance()->getListILS().end();
-              ++it )
-        {
-            if ( (*it).type == DataBase::ILS::LOC
-              && (*it).freq == _nav_freq
-              && getDistance( (*it).pos_wgs ) < _range_ils )
-            {
-                _ils_loc = &(*it);
-                break;
-            }
-        }
-    }
-
-    if ( !_ils_dme )
-    {
-        for ( DataBase::ListILS::const_iterator it = DataBase::instance()->getListILS().begin();
-              it != DataBase::instance()->getListILS().end();
-              ++it )
-        {
-            if ( (*it).type == DataBase::ILS::DME
-              && (*it).freq == Frequency::getFreqDME( _nav_freq )
-              && getDistance( (*it).pos_wgs ) < _range_ils )
-            {
-                _ils_dme = &(*it);
-                break;
-            }
-        }
-    }
-
-    if ( !_ils_gs )
-    {
-        for ( DataBase::ListILS::const_iterator it = DataBase::instance()->getListILS().begin();
-              it != DataBase::instance()->getListILS().end();
-              ++it )
-        {
-            if ( (*it).type == DataBase::ILS::GS
-              && (*it).freq == Frequency::getFreqGS( _nav_freq )
-              && getDistance( (*it).pos_wgs ) < _range_ils )
-            {
-                _ils_gs = &(*it);
-                break;
-            }
-        }
-    }
+    // stations are looked up only among the ones on the tuned frequency
+    if ( !_ils_loc ) _ils_loc = findILS( DataBase::ILS::LOC , _nav_freq );
+    if ( !_ils_dme ) _ils_dme = findILS( DataBase::ILS::DME , Frequency::getFreqDME( _nav_freq ) );
+    if ( !_ils_gs  ) _ils_gs  = findILS( DataBase::ILS::GS  , Frequency::getFreqGS( _nav_freq ) );
 
-    if ( !_vor )
-    {
-        for ( DataBase::ListNAV::const_iterator it = DataBase::instance()->getListNAV().begin();
-              it != DataBase::instance()->getListNAV().end();
-              ++it )
-        {
-            if ( ( (*it).type == DataBase::NAV::VOR || (*it).type == DataBase::NAV::VOR_DME || (*it).type == DataBase::NAV::VORTAC )
-              && (*it).freq == _nav_freq
-              && getDistance( (*it).pos_wgs ) < _range_vor )
-            {
-                _vor = &(*it);
-                break;
-            }
-        }
-    }
-
-    if ( !_ndb )
-    {
-        for ( DataBase::ListNAV::const_iterator it = DataBase::instance()->getListNAV().begin();
-              it != DataBase::instance()->getListNAV().end();
-              ++it )
-        {
-            if ( ( (*it).type == DataBase::NAV::NDB || (*it).type == DataBase::NAV::NDB_DME )
-              && (*it).freq == _adf_freq
-              && getDistance( (*it).pos_wgs ) < _range_ndb )
-            {
-                _ndb = &(*it);
-                break;
-            }
-        }
-    }
+    if ( !_vor ) _vor = findNAV( false , _nav_freq, _range_vor );
+    if ( !_ndb ) _ndb = findNAV( true  , _adf_freq, _range_ndb );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Manager::updateADF()
 {
-    if ( _ndb )
+    if ( _ndb && isVisible( _ndb ) )
     {
         _adf_visible = true;
         _adf_bearing = getAzimuth( _ndb->pos_wgs );
@@ -299,7 +369,7 @@ void Manager::updateADF()
 
 void Manager::updateILS()
 {
-    if ( _ils_loc )
+    if ( _ils_loc && isVisible( _ils_loc ) )
     {
         double azim = getAzimuth( _ils_loc->pos_wgs );
 
@@ -319,16 +389,32 @@ void Manager::updateILS()
             _ils_lc_deviation = _nav_deviation;
             _ils_lc_norm = _nav_norm;
 
-            if ( _ils_dme )
+            if ( _ils_dme && isVisible( _ils_dme ) )
             {
                 _dme_visible = true;
                 _dme_distance = getDistance( _ils_dme->pos_wgs );
             }
 
-            if ( _ils_gs )
+            if ( _ils_gs && isVisible( _ils_gs ) )
             {
-                fdm::Vector3 pos_ned_gs = _aircraft_wgs.getWGS2NED() * ( _ils_gs->pos_wgs - _aircraft_wgs.getPos_WGS() );
-                fdm::Vector3 pos_rwy_gs = fdm::Matrix3x3( fdm::Angles( 0.0, 0.0, _ils_loc->true_bearing ) ) * pos_ned_gs;
+                // runway axes are fixed at glide slope station, so they are
+                // computed only once the tuned localizer or glide slope changes
+                if ( _rwy_loc != _ils_loc || _rwy_gs != _ils_gs )
+                {
+                    fdm::WGS84::Geo gs_geo;
+
+                    gs_geo.lat = _ils_gs->lat;
+                    gs_geo.lon = _ils_gs->lon;
+                    gs_geo.alt = _ils_gs->elev;
+
+                    _wgs2rwy = fdm::Matrix3x3( fdm::Angles( 0.0, 0.0, _ils_loc->true_bearing ) )
+                             * fdm::WGS84( gs_geo ).getWGS2NED();
+
+                    _rwy_loc = _ils_loc;
+                    _rwy_gs  = _ils_gs;
+                }
+
+                fdm::Vector3 pos_rwy_gs = _wgs2rwy * ( _ils_gs->pos_wgs - _aircraft_wgs.getPos_WGS() );
 
                 double elev = atan2( -pos_rwy_gs.z(), pos_rwy_gs.x() );
 
@@ -352,7 +438,7 @@ void Manager::updateILS()
 
 void Manager::updateNAV()
 {
-    if ( _vor )
+    if ( _vor && isVisible( _vor ) )
     {
         _nav_visible = true;
 
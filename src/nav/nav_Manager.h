@@ -29,6 +29,7 @@
 #include <Data.h>
 
 #include <nav/nav_DataBase.h>
+#include <nav/nav_LineOfSight.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -55,6 +56,8 @@ public:
 
     static const double _vor_max;       ///< [rad] VOR full deflection
 
+    static const double _tile_size;     ///< [rad] nearby stations working set tile size
+
     /** @brief Constructor. */
     Manager();
 
@@ -78,6 +81,20 @@ private:
     const DataBase::NAV *_vor;      ///<
     const DataBase::NAV *_ndb;      ///<
 
+    DataBase::IndexFreq _nearby_ils;    ///< nearby ILS components indices by frequency
+    DataBase::IndexFreq _nearby_nav;    ///< nearby VORs and NDBs indices by frequency
+    DataBase::Indices _nearby_none;     ///< empty indices list
+
+    int _tile_lat;                  ///< working set tile latitude index
+    int _tile_lon;                  ///< working set tile longitude index
+    bool _tile_valid;               ///< specifies if working set has been built
+
+    const DataBase::ILS *_rwy_loc;  ///< localizer for which runway axes are cached
+    const DataBase::ILS *_rwy_gs;   ///< glide slope for which runway axes are cached
+    fdm::Matrix3x3 _wgs2rwy;        ///< WGS to runway axes at glide slope station
+
+    LineOfSight _los;               ///< terrain line-of-sight
+
     fdm::WGS84 _aircraft_wgs;       ///<
 
     double _course;                 ///< [rad]
@@ -109,6 +126,49 @@ private:
     double getAzimuth( const fdm::Vector3 &pos_wgs );
     double getDistance( const fdm::Vector3 &pos_wgs );
 
+    /**
+     * @brief Returns nearby stations indices on the given frequency.
+     * @param nearby nearby stations working set
+     * @param freq [kHz] frequency
+     * @return stations indices
+     */
+    const DataBase::Indices& getNearby( const DataBase::IndexFreq &nearby, int freq ) const;
+
+    /**
+     * @brief Returns the nearest ILS component in range.
+     * @param type ILS component type
+     * @param freq [kHz] frequency
+     * @return ILS component or null if none in range
+     */
+    const DataBase::ILS* findILS( DataBase::ILS::Type type, int freq );
+
+    /**
+     * @brief Returns the nearest VOR or NDB in range.
+     * @param ndb true for NDB, false for VOR
+     * @param freq [kHz] frequency
+     * @param range [m] range
+     * @return navaid or null if none in range
+     */
+    const DataBase::NAV* findNAV( bool ndb, int freq, double range );
+
+    /**
+     * @brief Checks if station is not masked by terrain.
+     * @param station station
+     * @return true if station is visible from ownship
+     */
+    template < class T >
+    inline bool isVisible( const T *station )
+    {
+        return _los.isVisible( station, station->pos_wgs, _aircraft_wgs.getPos_WGS() );
+    }
+
+    /**
+     * @brief Rebuilds nearby stations working set.
+     * Working set is rebuilt only when ownship enters another tile and
+     * contains all the stations which might be in range anywhere within it.
+     */
+    void updateNearby();
+
     void updateNavaids();
     void updateNavaidsActive();
 
@@ -0,0 +1,238 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <clocale>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <fdm/fdm_Defines.h>
+#include <fdm/fdm_Log.h>
+
+#include <fdm/utils/fdm_Time.h>
+
+#ifdef FDM_METRICS
+#   include <sim/MetricsExporter.h>
+#endif
+
+#include <sim/RealTimeScheduler.h>
+#include <sim/RemoteProtocol.h>
+#include <sim/RemoteServer.h>
+#include <sim/UdpSocket.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define SERVER_DEFAULT_ADDRESS "127.0.0.1"
+#define SERVER_DEFAULT_NETWORK "127.0.0.0/8"
+#define SERVER_DEFAULT_PORT 47702
+#define SERVER_STATS_INTERVAL 10.0
+
+#define SERVER_METRICS_PORT 8125
+#define SERVER_METRICS_INTERVAL 10.0
+#define SERVER_METRICS_PREFIX "mscsim_server"
+
+////////////////////////////////////////////////////////////////////////////////
+
+static volatile sig_atomic_t interrupted = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Handles interruption signal. */
+void handleSignal( int )
+{
+    interrupted = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Parses network given as address and prefix length (e.g. 192.168.1.0/24).
+ * @return true on success, false on failure
+ */
+bool parseNetwork( const char *str, fdm::UInt32 *network, fdm::UInt32 *netmask )
+{
+    std::string network_str( str );
+    int prefix = 32;
+
+    size_t separator = network_str.find( '/' );
+
+    if ( separator != std::string::npos )
+    {
+        const char *prefix_str = str + separator + 1;
+        char *end = 0;
+
+        prefix = (int)strtol( prefix_str, &end, 10 );
+
+        if ( end == prefix_str || *end != '\0' || prefix < 0 || prefix > 32 ) return false;
+
+        network_str = network_str.substr( 0, separator );
+    }
+
+    if ( !UdpSocket::resolve( network_str.c_str(), network ) ) return false;
+
+    (*netmask) = prefix > 0 ? 0xffffffffU << ( 32 - prefix ) : 0;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Prints usage information. */
+void printUsage()
+{
+    std::cerr << "Usage: mscsim_server [-a address] [-w network/prefix] [-p port] [-n max_clients] [-j threads] [-r redundancy] [-c cpu] [-f priority]" << std::endl;
+    std::cerr << "       -a  local interface address the server is bound to, 0.0.0.0 means all interfaces (default " << SERVER_DEFAULT_ADDRESS << ")" << std::endl;
+    std::cerr << "       -w  network clients are accepted from (default " << SERVER_DEFAULT_NETWORK << ")" << std::endl;
+    std::cerr << "       -p  server port (default " << SERVER_DEFAULT_PORT << ")" << std::endl;
+    std::cerr << "       -n  maximum number of clients (default " << RemoteProtocol::_maxEntities << ")" << std::endl;
+    std::cerr << "       -j  number of stepping threads, 0 means number of hardware threads (default 0)" << std::endl;
+    std::cerr << "       -r  number of copies of every datagram sent (default 2)" << std::endl;
+    std::cerr << "       -c  CPU index the server thread is pinned to (default none)" << std::endl;
+    std::cerr << "       -f  SCHED_FIFO priority of the server thread (default unchanged)" << std::endl;
+#   ifdef FDM_METRICS
+    std::cerr << "       -m  StatsD server address metrics are exported to (default none), port " << SERVER_METRICS_PORT << std::endl;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main( int argc, char *argv[] )
+{
+    setlocale( LC_ALL, "C" );
+
+    const char *address = SERVER_DEFAULT_ADDRESS;
+    const char *network = SERVER_DEFAULT_NETWORK;
+
+    unsigned short port = SERVER_DEFAULT_PORT;
+
+    unsigned int maxClients = RemoteProtocol::_maxEntities;
+    unsigned int threads    = 0;
+    unsigned int redundancy = 2;
+
+    int cpu = -1;
+    int priority = 0;
+
+    const char *metricsAddress = 0;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        if ( 0 == strcmp( argv[ i ], "-a" ) && i + 1 < argc )
+            address = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-w" ) && i + 1 < argc )
+            network = argv[ ++i ];
+        else if ( 0 == strcmp( argv[ i ], "-p" ) && i + 1 < argc )
+            port = (unsigned short)atoi( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-n" ) && i + 1 < argc )
+            maxClients = atoi( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-j" ) && i + 1 < argc )
+            threads = atoi( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-r" ) && i + 1 < argc )
+            redundancy = atoi( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-c" ) && i + 1 < argc )
+            cpu = atoi( argv[ ++i ] );
+        else if ( 0 == strcmp( argv[ i ], "-f" ) && i + 1 < argc )
+            priority = atoi( argv[ ++i ] );
+#       ifdef FDM_METRICS
+        else if ( 0 == strcmp( argv[ i ], "-m" ) && i + 1 < argc )
+            metricsAddress = argv[ ++i ];
+#       endif
+        else
+        {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    signal( SIGINT  , handleSignal );
+    signal( SIGTERM , handleSignal );
+
+    fdm::UInt32 localAddress = 0;
+    fdm::UInt32 allowedNetwork = 0;
+    fdm::UInt32 allowedNetmask = 0;
+
+    if ( !UdpSocket::resolve( address, &localAddress )
+      || !parseNetwork( network, &allowedNetwork, &allowedNetmask ) )
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    RemoteServer server( maxClients, threads, redundancy );
+
+    server.setAllowedNetwork( allowedNetwork, allowedNetmask );
+
+    if ( !server.open( localAddress, port ) )
+    {
+        fdm::Log::e() << "Cannot open server socket on " << address << ":" << port << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+#   ifdef FDM_METRICS
+    MetricsExporter metrics;
+
+    if ( metricsAddress && !metrics.open( metricsAddress, SERVER_METRICS_PORT,
+                                          SERVER_METRICS_INTERVAL, SERVER_METRICS_PREFIX ) )
+    {
+        fdm::Log::e() << "Cannot open metrics exporter to " << metricsAddress << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+#   else
+    (void)metricsAddress;
+#   endif
+
+    RealTimeScheduler scheduler( FDM_TIME_STEP, priority, cpu );
+
+    if ( !scheduler.start() )
+    {
+        fdm::Log::e() << "Real-time scheduler is not available." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    fdm::Log::i() << "FDM server listening on " << address << ":" << port
+                  << " for clients from " << network << " with "
+                  << server.getThreads() << " stepping thread(s)." << std::endl;
+
+    double statsTime = fdm::Time::get();
+
+    while ( !interrupted )
+    {
+        server.step( scheduler.wait() );
+
+        double time = fdm::Time::get();
+
+        if ( time - statsTime > SERVER_STATS_INTERVAL )
+        {
+            statsTime = time;
+
+            fdm::Log::i() << "Clients: " << server.getClientsCount()
+                          << ", overruns: " << scheduler.getOverruns() << std::endl;
+        }
+    }
+
+    server.close();
+
+    fdm::Log::i() << "FDM server stopped with " << scheduler.getOverruns() << " overrun(s)." << std::endl;
+
+    return EXIT_SUCCESS;
+}
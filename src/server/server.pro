@@ -0,0 +1,91 @@
+QT -= core gui
+
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+TEMPLATE = app
+
+################################################################################
+
+DESTDIR = $$PWD/../../bin
+TARGET = mscsim_server
+
+################################################################################
+
+CONFIG += c++11
+
+################################################################################
+
+unix: CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O2
+win32: CONFIG(release, debug|release): QMAKE_CXXFLAGS += -O2
+
+################################################################################
+
+DEFINES += SIM_TEST
+#DEFINES += FDM_IMPLICIT_CONTACT
+#DEFINES += FDM_METRICS
+#DEFINES += FDM_LOCKSTEP
+#DEFINES += FDM_UNCHECKED
+
+win32: DEFINES += \
+    NOMINMAX \
+    WIN32 \
+    _CRT_SECURE_NO_DEPRECATE \
+    _SCL_SECURE_NO_WARNINGS \
+    _USE_MATH_DEFINES
+
+unix: DEFINES += _LINUX_
+
+################################################################################
+
+INCLUDEPATH += ./ ../
+
+win32: INCLUDEPATH += \
+    $(OSG_ROOT)/include/libxml2
+
+unix: INCLUDEPATH += \
+    /usr/include/libxml2
+
+################################################################################
+
+win32: LIBS += \
+    -L$(OSG_ROOT)/lib \
+    -llibxml2 \
+    -lws2_32
+
+unix: LIBS += \
+    -L/lib \
+    -L/usr/lib \
+    -lpthread \
+    -lxml2
+
+################################################################################
+
+HEADERS += \
+    $$PWD/../sim/MetricsExporter.h \
+    $$PWD/../sim/RealTimeScheduler.h \
+    $$PWD/../sim/RemoteProtocol.h \
+    $$PWD/../sim/RemoteServer.h \
+    $$PWD/../sim/UdpSocket.h
+
+SOURCES += \
+    $$PWD/main.cpp \
+    $$PWD/../sim/MetricsExporter.cpp \
+    $$PWD/../sim/RealTimeScheduler.cpp \
+    $$PWD/../sim/RemoteProtocol.cpp \
+    $$PWD/../sim/RemoteServer.cpp \
+    $$PWD/../sim/UdpSocket.cpp
+
+################################################################################
+
+include(../fdm/fdm.pri)
+include(../fdm_aw101/fdm_aw101.pri)
+include(../fdm_c130/fdm_c130.pri)
+include(../fdm_c172/fdm_c172.pri)
+include(../fdm_f16/fdm_f16.pri)
+include(../fdm_f35a/fdm_f35a.pri)
+include(../fdm_p51/fdm_p51.pri)
+include(../fdm_pw5/fdm_pw5.pri)
+include(../fdm_r44/fdm_r44.pri)
+include(../fdm_uh60/fdm_uh60.pri)
@@ -1,9 +1,13 @@
 HEADERS += \
+    $$PWD/sfx_EngineSynth.h \
     $$PWD/sfx_Manager.h \
     $$PWD/sfx_Sample.h \
+    $$PWD/sfx_SourcePool.h \
     $$PWD/sfx_Thread.h
 
 SOURCES += \
+    $$PWD/sfx_EngineSynth.cpp \
     $$PWD/sfx_Manager.cpp \
     $$PWD/sfx_Sample.cpp \
+    $$PWD/sfx_SourcePool.cpp \
     $$PWD/sfx_Thread.cpp
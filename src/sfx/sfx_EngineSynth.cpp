@@ -0,0 +1,255 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sfx/sfx_EngineSynth.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_Simd.h>
+
+#include <Defines.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sfx;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const int EngineSynth::_freq       = 22050;
+const int EngineSynth::_block_size = 512;
+const int EngineSynth::_blocks     = 4;
+const int EngineSynth::_harmonics  = 8;
+
+////////////////////////////////////////////////////////////////////////////////
+
+EngineSynth::EngineSynth( SourcePool *pool, const Params &params ) :
+    _pool ( pool ),
+    _params ( params ),
+
+    _source ( 0 ),
+    _buffers ( NULLPTR ),
+
+    _cos_w ( NULLPTR ),
+    _sin_w ( NULLPTR ),
+    _amp   ( NULLPTR ),
+    _re    ( NULLPTR ),
+    _im    ( NULLPTR ),
+
+    _pcm ( NULLPTR ),
+
+    _noise_lp  ( 0.0 ),
+    _rumble_lp ( 0.0 )
+{
+    _buffers = new ALuint [ _blocks ];
+
+    alGenBuffers( _blocks, _buffers );
+
+    _cos_w = new double [ _harmonics ];
+    _sin_w = new double [ _harmonics ];
+    _amp   = new double [ _harmonics ];
+    _re    = new double [ _harmonics ];
+    _im    = new double [ _harmonics ];
+
+    for ( int i = 0; i < _harmonics; i++ )
+    {
+        _cos_w [ i ] = 1.0;
+        _sin_w [ i ] = 0.0;
+        _amp   [ i ] = 0.0;
+        _re    [ i ] = 1.0;
+        _im    [ i ] = 0.0;
+    }
+
+    _pcm = new short [ _block_size ];
+
+    memset( &_curr, 0, sizeof(Targets) );
+    memset( &_prev, 0, sizeof(Targets) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+EngineSynth::~EngineSynth()
+{
+    stop();
+
+    alDeleteBuffers( _blocks, _buffers );
+
+    DELTAB( _buffers );
+
+    DELTAB( _cos_w );
+    DELTAB( _sin_w );
+    DELTAB( _amp   );
+    DELTAB( _re    );
+    DELTAB( _im    );
+
+    DELTAB( _pcm );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EngineSynth::update( double rpm, double load, double afterburner, double volume )
+{
+    setTargets( rpm, load, afterburner, volume );
+
+    if ( _source == 0 )
+    {
+        _source = _pool->acquire();
+
+        if ( _source == 0 ) return;
+
+        // first block starts from current state, no ramp from silence
+        _prev = _curr;
+    }
+    else
+    {
+        ALint processed = 0;
+
+        alGetSourcei( _source, AL_BUFFERS_PROCESSED, &processed );
+
+        while ( processed-- > 0 )
+        {
+            ALuint buffer = 0;
+
+            alSourceUnqueueBuffers( _source, 1, &buffer );
+
+            generate( buffer );
+
+            alSourceQueueBuffers( _source, 1, &buffer );
+        }
+    }
+
+    ALint state;
+
+    alGetSourcei( _source, AL_SOURCE_STATE, &state );
+
+    if ( state != AL_PLAYING )
+    {
+        // initial start or underrun, all blocks are queued anew
+        alSourceStop( _source );
+        alSourcei( _source, AL_BUFFER, 0 );
+
+        for ( int i = 0; i < _blocks; i++ )
+        {
+            generate( _buffers[ i ] );
+            alSourceQueueBuffers( _source, 1, &_buffers[ i ] );
+        }
+
+        alSourcePlay( _source );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EngineSynth::stop()
+{
+    if ( _source != 0 )
+    {
+        _pool->release( _source );
+        _source = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EngineSynth::generate( ALuint buffer )
+{
+    // harmonics above Nyquist frequency are muted instead of aliased
+    double amp_sum = 0.0;
+    double amp = 1.0;
+
+    for ( int i = 0; i < _harmonics; i++ )
+    {
+        double w = ( i + 1 ) * _curr.w;
+
+        _cos_w [ i ] = cos( w );
+        _sin_w [ i ] = sin( w );
+        _amp   [ i ] = ( w < M_PI ) ? amp : 0.0;
+
+        amp_sum += _amp[ i ];
+        amp *= _params.rolloff;
+
+        // phasors magnitude drift is removed once per block
+        double m = sqrt( _re[ i ] * _re[ i ] + _im[ i ] * _im[ i ] );
+
+        if ( m > 0.0 )
+        {
+            _re[ i ] /= m;
+            _im[ i ] /= m;
+        }
+        else
+        {
+            _re[ i ] = 1.0;
+            _im[ i ] = 0.0;
+        }
+    }
+
+    if ( amp_sum > 0.0 )
+    {
+        for ( int i = 0; i < _harmonics; i++ ) _amp[ i ] /= amp_sum;
+    }
+
+    const double rumble_coef = 1.0 - exp( -2.0 * M_PI * 60.0 / _freq );
+
+    for ( int i = 0; i < _block_size; i++ )
+    {
+        double t = (double)i / (double)_block_size;
+
+        double tone   = _prev.tone   + t * ( _curr.tone   - _prev.tone   );
+        double noise  = _prev.noise  + t * ( _curr.noise  - _prev.noise  );
+        double rumble = _prev.rumble + t * ( _curr.rumble - _prev.rumble );
+        double cutoff = _prev.cutoff + t * ( _curr.cutoff - _prev.cutoff );
+
+        double white = 2.0 * _random.getUniform() - 1.0;
+
+        _noise_lp  += cutoff      * ( white - _noise_lp  );
+        _rumble_lp += rumble_coef * ( white - _rumble_lp );
+
+        double y = tone * fdm::Simd::updateOscillators( _harmonics, _cos_w, _sin_w, _amp, _re, _im )
+                 + noise  * _noise_lp
+                 + rumble * _rumble_lp * 8.0; // low-passed noise is much quieter than white
+
+        _pcm[ i ] = (short)( 32767.0 * fdm::Misc::satur( -1.0, 1.0, y ) );
+    }
+
+    alBufferData( buffer, AL_FORMAT_MONO16, _pcm, _block_size * sizeof(short), _freq );
+
+    _prev = _curr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EngineSynth::setTargets( double rpm, double load, double afterburner, double volume )
+{
+    double speed = fdm::Misc::satur( 0.0, 1.0, rpm / _params.rpm_max );
+    double gain  = volume * speed * ( 0.6 + 0.4 * load );
+
+    double f0 = _params.order * std::max( 0.0, rpm ) / 60.0;
+    double fc = 200.0 + 4000.0 * speed;
+
+    _curr.w      = 2.0 * M_PI * f0 / _freq;
+    _curr.tone   = gain * _params.tone;
+    _curr.noise  = gain * _params.noise * ( 0.5 + 0.5 * load );
+    _curr.rumble = volume * afterburner * _params.rumble;
+    _curr.cutoff = 1.0 - exp( -2.0 * M_PI * fc / _freq );
+}
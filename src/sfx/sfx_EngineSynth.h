@@ -0,0 +1,135 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef SFX_ENGINESYNTH_H
+#define SFX_ENGINESYNTH_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <AL/al.h>
+#include <AL/alc.h>
+
+#include <fdm/utils/fdm_Random.h>
+
+#include <sfx/sfx_SourcePool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sfx
+{
+
+/**
+ * @brief Procedural engine sound synthesizer class.
+ *
+ * Engine sound is made of harmonics of the engine firing (or blade passing)
+ * frequency and of broadband noise, both keyed on engine rpm and load, and
+ * of afterburner rumble. Sound is generated in fixed size blocks queued on
+ * a pooled source, parameters are ramped within each block.
+ */
+class EngineSynth
+{
+public:
+
+    /** Engine sound parameters. */
+    struct Params
+    {
+        double order;               ///< [-] fundamental frequency to shaft rotation frequency ratio
+        double rpm_max;             ///< [rpm] maximum shaft rotation speed
+        double rolloff;             ///< [-] amplitude ratio of subsequent harmonics
+        double tone;                ///< [-] harmonics level
+        double noise;               ///< [-] broadband noise level
+        double rumble;              ///< [-] afterburner rumble level
+    };
+
+    static const int _freq;         ///< [Hz] sampling frequency
+    static const int _block_size;   ///< [-] number of frames in block
+    static const int _blocks;       ///< [-] number of queued blocks
+    static const int _harmonics;    ///< [-] number of harmonics
+
+    /**
+     * @brief Constructor.
+     * @param pool sources pool
+     * @param params engine sound parameters
+     */
+    EngineSynth( SourcePool *pool, const Params &params );
+
+    /** @brief Destructor. */
+    virtual ~EngineSynth();
+
+    /**
+     * @brief Generates due sound blocks.
+     * @param rpm [rpm] shaft rotation speed
+     * @param load [0.0,1.0] engine load
+     * @param afterburner [0.0,1.0] afterburner level
+     * @param volume [0.0,1.0] sound volume
+     */
+    void update( double rpm, double load, double afterburner, double volume );
+
+    /** @brief Stops sound and returns source to the pool. */
+    void stop();
+
+private:
+
+    /** Generation targets, blocks ramp from previous to current ones. */
+    struct Targets
+    {
+        double w;                   ///< [rad] fundamental angle step
+        double tone;                ///< [-] harmonics gain
+        double noise;               ///< [-] noise gain
+        double rumble;              ///< [-] rumble gain
+        double cutoff;              ///< [-] noise low-pass filter coefficient
+    };
+
+    SourcePool *_pool;              ///< sources pool
+    Params _params;                 ///< engine sound parameters
+
+    fdm::Random _random;            ///< noise generator
+
+    ALuint _source;                 ///< source name, 0 if not playing
+    ALuint *_buffers;               ///< blocks buffers
+
+    double *_cos_w;                 ///< harmonics angle steps cosines
+    double *_sin_w;                 ///< harmonics angle steps sines
+    double *_amp;                   ///< harmonics amplitudes
+    double *_re;                    ///< harmonics phasors real parts
+    double *_im;                    ///< harmonics phasors imaginary parts
+
+    short *_pcm;                    ///< block PCM data
+
+    Targets _curr;                  ///< current targets
+    Targets _prev;                  ///< targets of the previous block
+
+    double _noise_lp;               ///< noise low-pass filter state
+    double _rumble_lp;              ///< rumble low-pass filter state
+
+    /** Using this constructor is forbidden. */
+    EngineSynth( const EngineSynth & );
+
+    void generate( ALuint buffer );
+
+    void setTargets( double rpm, double load, double afterburner, double volume );
+};
+
+} // end of sfx namepsace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SFX_ENGINESYNTH_H
@@ -33,10 +33,25 @@ using namespace sfx;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+// order, rpm_max, rolloff, tone, noise, rumble
+const EngineSynth::Params synth_c130 = { 4.0,  2000.0, 0.75, 0.60, 0.40, 0.0 };
+const EngineSynth::Params synth_c172 = { 2.0,  2700.0, 0.70, 0.70, 0.30, 0.0 };
+const EngineSynth::Params synth_jet  = { 8.0, 14000.0, 0.50, 0.25, 0.80, 1.0 };
+const EngineSynth::Params synth_p51  = { 6.0,  3000.0, 0.70, 0.70, 0.30, 0.0 };
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 Manager::Manager() :
     _device  ( NULLPTR ),
     _context ( NULLPTR ),
 
+    _pool ( NULLPTR ),
+
     _explosion ( NULLPTR ),
     _touchdown ( NULLPTR ),
 
@@ -64,6 +79,10 @@ Manager::Manager() :
     _prop_xh    ( NULLPTR ),
 #   endif
 
+    _synth ( NULLPTR ),
+
+    _aircraftType ( 0 ),
+
     _volume ( 1.0 ),
 
     _afterburner ( 0.0 ),
@@ -93,32 +112,17 @@ Manager::Manager() :
         Log::e() << "Cannot open audio device." << std::endl;
     }
 
-    _explosion = new Sample( Path::get( "sfx/explosion.wav" ).c_str() );
-    _touchdown = new Sample( Path::get( "sfx/touchdown.wav" ).c_str() );
-
-    _warning = new Sample( Path::get( "sfx/warning.wav" ).c_str(), true );
+    _pool = new SourcePool();
 
-    _run_noise = new Sample( Path::get( "sfx/run_noise.wav" ).c_str(), true );
+    _explosion = new Sample( Path::get( "sfx/explosion.wav" ).c_str(), _pool );
+    _touchdown = new Sample( Path::get( "sfx/touchdown.wav" ).c_str(), _pool );
 
-    _gear_lock = new Sample( Path::get( "sfx/gear_lock.wav" ).c_str() );
-    _gear_move = new Sample( Path::get( "sfx/gear_move.wav" ).c_str(), true );
+    _warning = new Sample( Path::get( "sfx/warning.wav" ).c_str(), _pool, true );
 
-    _prop_aw101 = new Sample( Path::get( "sfx/prop_uh60.wav"  ).c_str(), true );
-    _prop_c130  = new Sample( Path::get( "sfx/prop_c130.wav"  ).c_str(), true );
-    _prop_c172  = new Sample( Path::get( "sfx/prop_c172.wav"  ).c_str(), true );
-    _prop_f16   = new Sample( Path::get( "sfx/prop_f16.wav"   ).c_str(), true );
-    _prop_f16ab = new Sample( Path::get( "sfx/prop_f16ab.wav" ).c_str(), true );
-    _prop_f35   = new Sample( Path::get( "sfx/prop_f16.wav"   ).c_str(), true );
-    _prop_f35ab = new Sample( Path::get( "sfx/prop_f16ab.wav" ).c_str(), true );
-    _prop_p51   = new Sample( Path::get( "sfx/prop_p51.wav"   ).c_str(), true );
-    _prop_r44   = new Sample( Path::get( "sfx/prop_r44.wav"   ).c_str(), true );
-    _prop_uh60  = new Sample( Path::get( "sfx/prop_uh60.wav"  ).c_str(), true );
+    _run_noise = new Sample( Path::get( "sfx/run_noise.wav" ).c_str(), _pool, true );
 
-#   ifdef FDM_TEST
-    _prop_xf   = new Sample( Path::get( "sfx/prop_f16.wav"   ).c_str(), true );
-    _prop_xfab = new Sample( Path::get( "sfx/prop_f16ab.wav" ).c_str(), true );
-    _prop_xh   = new Sample( Path::get( "sfx/prop_uh60.wav"  ).c_str(), true );
-#   endif
+    _gear_lock = new Sample( Path::get( "sfx/gear_lock.wav" ).c_str(), _pool );
+    _gear_move = new Sample( Path::get( "sfx/gear_move.wav" ).c_str(), _pool, true );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -135,22 +139,9 @@ Manager::~Manager()
     DELPTR( _gear_lock );
     DELPTR( _gear_move );
 
-    DELPTR( _prop_aw101 );
-    DELPTR( _prop_c130  );
-    DELPTR( _prop_c172  );
-    DELPTR( _prop_f16   );
-    DELPTR( _prop_f16ab );
-    DELPTR( _prop_f35   );
-    DELPTR( _prop_f35ab );
-    DELPTR( _prop_p51   );
-    DELPTR( _prop_r44   );
-    DELPTR( _prop_uh60  );
+    freeAircraft();
 
-#   ifdef FDM_TEST
-    DELPTR( _prop_xf   );
-    DELPTR( _prop_xfab );
-    DELPTR( _prop_xh   );
-#   endif
+    DELPTR( _pool );
 
     alcMakeContextCurrent( NULL );
     alcDestroyContext( _context );
@@ -159,32 +150,40 @@ Manager::~Manager()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::update( const Data::DataBuf *data )
+void Manager::update( const State *state )
 {
-    _volume = data->sfx.volume;
+    // source changes of the whole update are committed at once
+    if ( _context ) alcSuspendContext( _context );
+
+    _volume = state->volume;
 
-    if ( data->stateInp == fdm::DataInp::Work )
+    if ( state->stateInp == fdm::DataInp::Work )
     {
         // init
-        if ( _prev_state != data->stateInp )
+        if ( _prev_state != state->stateInp )
+        {
+            init( state );
+        }
+
+        if ( _aircraftType != state->aircraftType )
         {
-            init( data );
+            loadAircraft( state->aircraftType );
         }
 
-        switch ( data->aircraftType )
+        switch ( state->aircraftType )
         {
-            case fdm::DataInp::AW101: updateAircraft_AW101 ( data ); break;
-            case fdm::DataInp::C130:  updateAircraft_C130  ( data ); break;
-            case fdm::DataInp::C172:  updateAircraft_C172  ( data ); break;
-            case fdm::DataInp::F16:   updateAircraft_F16   ( data ); break;
-            case fdm::DataInp::F35A:  updateAircraft_F35A  ( data ); break;
-            case fdm::DataInp::P51:   updateAircraft_P51   ( data ); break;
-            case fdm::DataInp::PW5:   updateAircraft_PW5   ( data ); break;
-            case fdm::DataInp::R44:   updateAircraft_R44   ( data ); break;
-            case fdm::DataInp::UH60:  updateAircraft_UH60  ( data ); break;
+            case fdm::DataInp::AW101: updateAircraft_AW101 ( state ); break;
+            case fdm::DataInp::C130:  updateAircraft_C130  ( state ); break;
+            case fdm::DataInp::C172:  updateAircraft_C172  ( state ); break;
+            case fdm::DataInp::F16:   updateAircraft_F16   ( state ); break;
+            case fdm::DataInp::F35A:  updateAircraft_F35A  ( state ); break;
+            case fdm::DataInp::P51:   updateAircraft_P51   ( state ); break;
+            case fdm::DataInp::PW5:   updateAircraft_PW5   ( state ); break;
+            case fdm::DataInp::R44:   updateAircraft_R44   ( state ); break;
+            case fdm::DataInp::UH60:  updateAircraft_UH60  ( state ); break;
 #           ifdef FDM_TEST
-            case fdm::DataInp::XF: updateAircraft_XF( data ); break;
-            case fdm::DataInp::XH: updateAircraft_XH( data ); break;
+            case fdm::DataInp::XF: updateAircraft_XF( state ); break;
+            case fdm::DataInp::XH: updateAircraft_XH( state ); break;
 #           endif
             default: break;
         }
@@ -192,29 +191,38 @@ void Manager::update( const Data::DataBuf *data )
     else
     {
         stop();
+
+        // paused aircraft keeps its samples, new flight might be of other type
+        if ( state->stateInp != fdm::DataInp::Pause && _aircraftType != 0 )
+        {
+            freeAircraft();
+        }
     }
 
-    if ( data->ownship.crash && !_prev_crash )
+    if ( state->crash && !_prev_crash )
     {
         _explosion->play();
         _explosion->setVolume( _volume );
     }
 
+    updateSamples();
+
+    _prev_state  = state->stateInp;
+    _prev_gear   = state->norm_landingGear;
+    _prev_ground = state->onGround;
+    _prev_crash  = state->crash;
 
-    _prev_state  = data->stateInp;
-    _prev_gear   = data->ownship.norm_landingGear;
-    _prev_ground = data->ownship.onGround;
-    _prev_crash  = data->ownship.crash;
+    if ( _context ) alcProcessContext( _context );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::init( const Data::DataBuf *data )
+void Manager::init( const State *state )
 {
     _afterburner = 0.0;
 
-    _prev_gear   = data->ownship.norm_landingGear;
-    _prev_ground = data->ownship.onGround;
+    _prev_gear   = state->norm_landingGear;
+    _prev_ground = state->onGround;
     _prev_crash  = false;
 }
 
@@ -228,32 +236,152 @@ void Manager::stop()
 
     _gear_move->stop();
 
-    _prop_aw101 ->stop();
-    _prop_c130  ->stop();
-    _prop_c172  ->stop();
-    _prop_f16   ->stop();
-    _prop_f16ab ->stop();
-    _prop_f35   ->stop();
-    _prop_f35ab ->stop();
-    _prop_p51   ->stop();
-    _prop_r44   ->stop();
-    _prop_uh60  ->stop();
+    if ( _synth ) _synth->stop();
+
+    Sample* samples[] =
+    {
+        _prop_aw101, _prop_c130, _prop_c172, _prop_f16, _prop_f16ab,
+        _prop_f35, _prop_f35ab, _prop_p51, _prop_r44, _prop_uh60,
+
+#       ifdef FDM_TEST
+        _prop_xf, _prop_xfab, _prop_xh,
+#       endif
+    };
+
+    for ( unsigned int i = 0; i < sizeof(samples) / sizeof(Sample*); i++ )
+    {
+        if ( samples[ i ] ) samples[ i ]->stop();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::loadAircraft( int aircraftType )
+{
+    freeAircraft();
+
+    switch ( aircraftType )
+    {
+    case fdm::DataInp::AW101:
+        _prop_aw101 = new Sample( Path::get( "sfx/prop_uh60.wav" ).c_str(), _pool, true );
+        break;
+
+#   ifdef SFX_ENGINE_SYNTH
+    case fdm::DataInp::C130: _synth = new EngineSynth( _pool, synth_c130 ); break;
+    case fdm::DataInp::C172: _synth = new EngineSynth( _pool, synth_c172 ); break;
+    case fdm::DataInp::F16:  _synth = new EngineSynth( _pool, synth_jet  ); break;
+    case fdm::DataInp::F35A: _synth = new EngineSynth( _pool, synth_jet  ); break;
+    case fdm::DataInp::P51:  _synth = new EngineSynth( _pool, synth_p51  ); break;
+#   else
+    case fdm::DataInp::C130:
+        _prop_c130 = new Sample( Path::get( "sfx/prop_c130.wav" ).c_str(), _pool, true );
+        break;
+
+    case fdm::DataInp::C172:
+        _prop_c172 = new Sample( Path::get( "sfx/prop_c172.wav" ).c_str(), _pool, true );
+        break;
+
+    case fdm::DataInp::F16:
+        _prop_f16   = new Sample( Path::get( "sfx/prop_f16.wav"   ).c_str(), _pool, true );
+        _prop_f16ab = new Sample( Path::get( "sfx/prop_f16ab.wav" ).c_str(), _pool, true );
+        break;
+
+    case fdm::DataInp::F35A:
+        _prop_f35   = new Sample( Path::get( "sfx/prop_f16.wav"   ).c_str(), _pool, true );
+        _prop_f35ab = new Sample( Path::get( "sfx/prop_f16ab.wav" ).c_str(), _pool, true );
+        break;
+
+    case fdm::DataInp::P51:
+        _prop_p51 = new Sample( Path::get( "sfx/prop_p51.wav" ).c_str(), _pool, true );
+        break;
+#   endif
+
+    case fdm::DataInp::R44:
+        _prop_r44 = new Sample( Path::get( "sfx/prop_r44.wav" ).c_str(), _pool, true );
+        break;
+
+    case fdm::DataInp::UH60:
+        _prop_uh60 = new Sample( Path::get( "sfx/prop_uh60.wav" ).c_str(), _pool, true );
+        break;
 
 #   ifdef FDM_TEST
-    _prop_xf   ->stop();
-    _prop_xfab ->stop();
-    _prop_xh   ->stop();
+#   ifdef SFX_ENGINE_SYNTH
+    case fdm::DataInp::XF: _synth = new EngineSynth( _pool, synth_jet ); break;
+#   else
+    case fdm::DataInp::XF:
+        _prop_xf   = new Sample( Path::get( "sfx/prop_f16.wav"   ).c_str(), _pool, true );
+        _prop_xfab = new Sample( Path::get( "sfx/prop_f16ab.wav" ).c_str(), _pool, true );
+        break;
 #   endif
+
+    case fdm::DataInp::XH:
+        _prop_xh = new Sample( Path::get( "sfx/prop_uh60.wav" ).c_str(), _pool, true );
+        break;
+#   endif
+
+    default:
+        break;
+    }
+
+    _aircraftType = aircraftType;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateLandingGear( const Data::DataBuf *data )
+void Manager::freeAircraft()
 {
-    if ( _prev_gear != data->ownship.norm_landingGear )
+    DELPTR( _synth );
+
+    DELPTR( _prop_aw101 );
+    DELPTR( _prop_c130  );
+    DELPTR( _prop_c172  );
+    DELPTR( _prop_f16   );
+    DELPTR( _prop_f16ab );
+    DELPTR( _prop_f35   );
+    DELPTR( _prop_f35ab );
+    DELPTR( _prop_p51   );
+    DELPTR( _prop_r44   );
+    DELPTR( _prop_uh60  );
+
+#   ifdef FDM_TEST
+    DELPTR( _prop_xf   );
+    DELPTR( _prop_xfab );
+    DELPTR( _prop_xh   );
+#   endif
+
+    _aircraftType = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::updateSamples()
+{
+    Sample* samples[] =
+    {
+        _explosion, _touchdown, _warning, _run_noise, _gear_lock, _gear_move,
+
+        _prop_aw101, _prop_c130, _prop_c172, _prop_f16, _prop_f16ab,
+        _prop_f35, _prop_f35ab, _prop_p51, _prop_r44, _prop_uh60,
+
+#       ifdef FDM_TEST
+        _prop_xf, _prop_xfab, _prop_xh,
+#       endif
+    };
+
+    for ( unsigned int i = 0; i < sizeof(samples) / sizeof(Sample*); i++ )
     {
-        if ( data->ownship.norm_landingGear < 0.001
-          || data->ownship.norm_landingGear > 0.999 )
+        if ( samples[ i ] ) samples[ i ]->update();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Manager::updateLandingGear( const State *state )
+{
+    if ( _prev_gear != state->norm_landingGear )
+    {
+        if ( state->norm_landingGear < 0.001
+          || state->norm_landingGear > 0.999 )
         {
             _gear_lock->play();
             _gear_lock->setVolume( _volume );
@@ -270,19 +398,19 @@ void Manager::updateLandingGear( const Data::DataBuf *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateTouchdown(  const Data::DataBuf *data , double vel_max )
+void Manager::updateTouchdown(  const State *state , double vel_max )
 {
     // touchdown
-    if ( data->ownship.onGround && !_prev_ground )
+    if ( state->onGround && !_prev_ground )
     {
         _touchdown->play();
         _touchdown->setVolume( _volume );
     }
 
     // run noise
-    if ( data->ownship.onGround )
+    if ( state->onGround )
     {
-        double vel =  data->ownship.groundSpeed;
+        double vel =  state->groundSpeed;
         double coef = fdm::Misc::satur( 0.0, 1.0, vel / vel_max );
         _run_noise->play();
         _run_noise->setVolume( _volume * coef );
@@ -296,9 +424,9 @@ void Manager::updateTouchdown(  const Data::DataBuf *data , double vel_max )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateWarning( const Data::DataBuf *data )
+void Manager::updateWarning( const State *state )
 {
-    if ( data->ownship.stall )
+    if ( state->stall )
     {
         _warning->play();
         _warning->setVolume( _volume );
@@ -311,13 +439,13 @@ void Manager::updateWarning( const Data::DataBuf *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_AW101( const Data::DataBuf *data )
+void Manager::updateAircraft_AW101( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateLandingGear( data );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateLandingGear( state );
+    updateWarning( state );
 
-    if ( data->ownship.mainRotor.omega > 0.0 )
+    if ( state->mainRotor_omega > 0.0 )
     {
         _prop_aw101->play();
     }
@@ -331,13 +459,20 @@ void Manager::updateAircraft_AW101( const Data::DataBuf *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_C130( const Data::DataBuf *data )
+void Manager::updateAircraft_C130( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateLandingGear( data );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateLandingGear( state );
+    updateWarning( state );
+
+    double rpm = state->engine[ 0 ].rpm;
+
+    if ( _synth )
+    {
+        _synth->update( rpm, state->engine[ 0 ].throttle, 0.0, _volume );
+        return;
+    }
 
-    double rpm = data->propulsion.engine[ 0 ].rpm;
     double coef = fdm::Misc::satur( 0.0, 1.0, rpm / 2000.0 );
 
     _prop_c130->play();
@@ -347,12 +482,19 @@ void Manager::updateAircraft_C130( const Data::DataBuf *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_C172( const Data::DataBuf *data )
+void Manager::updateAircraft_C172( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateWarning( state );
+
+    double rpm = state->engine[ 0 ].rpm;
+
+    if ( _synth )
+    {
+        _synth->update( rpm, state->engine[ 0 ].throttle, 0.0, _volume );
+        return;
+    }
 
-    double rpm = data->propulsion.engine[ 0 ].rpm;
     double coef = fdm::Misc::satur( 0.0, 1.0, rpm / 2000.0 );
 
     _prop_c172->play();
@@ -362,57 +504,76 @@ void Manager::updateAircraft_C172( const Data::DataBuf *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_F16( const Data::DataBuf *data )
+void Manager::updateAircraft_F16( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateLandingGear( data );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateLandingGear( state );
+    updateWarning( state );
 
-    bool afterburner = data->propulsion.engine[ 0 ].afterburner;
-    double n2 = data->propulsion.engine[ 0 ].n2;
+    bool afterburner = state->engine[ 0 ].afterburner;
+    double n2 = state->engine[ 0 ].n2;
     double coef = fdm::Misc::satur( 0.0, 1.0, n2 / 95.0 );
 
+    _afterburner = fdm::Misc::inertia( afterburner ? 1.0 : 0.0, _afterburner, 0.01, 0.5 );
+
+    if ( _synth )
+    {
+        _synth->update( coef * synth_jet.rpm_max, state->engine[ 0 ].throttle, _afterburner, _volume );
+        return;
+    }
+
     _prop_f16->play();
     _prop_f16->setVolume( _volume * coef );
     _prop_f16->setPitch( coef );
 
-    _afterburner = fdm::Misc::inertia( afterburner ? 1.0 : 0.0, _afterburner, 0.01, 0.5 );
-
     _prop_f16ab->play();
     _prop_f16ab->setVolume( _volume * _afterburner );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_F35A( const Data::DataBuf *data )
+void Manager::updateAircraft_F35A( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateLandingGear( data );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateLandingGear( state );
+    updateWarning( state );
 
-    bool afterburner = data->propulsion.engine[ 0 ].afterburner;
-    double n2 = data->propulsion.engine[ 0 ].n2;
+    bool afterburner = state->engine[ 0 ].afterburner;
+    double n2 = state->engine[ 0 ].n2;
     double coef = fdm::Misc::satur( 0.0, 1.0, n2 / 95.0 );
 
+    _afterburner = fdm::Misc::inertia( afterburner ? 1.0 : 0.0, _afterburner, 0.01, 0.5 );
+
+    if ( _synth )
+    {
+        _synth->update( coef * synth_jet.rpm_max, state->engine[ 0 ].throttle, _afterburner, _volume );
+        return;
+    }
+
     _prop_f35->play();
     _prop_f35->setVolume( _volume * coef );
     _prop_f35->setPitch( coef );
 
-    _afterburner = fdm::Misc::inertia( afterburner ? 1.0 : 0.0, _afterburner, 0.01, 0.5 );
-
     _prop_f35ab->play();
     _prop_f35ab->setVolume( _volume * _afterburner );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_P51( const Data::DataBuf *data )
+void Manager::updateAircraft_P51( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateLandingGear( data );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateLandingGear( state );
+    updateWarning( state );
+
+    double rpm = state->engine[ 0 ].rpm;
+
+    if ( _synth )
+    {
+        _synth->update( rpm, state->engine[ 0 ].throttle, 0.0, _volume );
+        return;
+    }
 
-    double rpm = data->propulsion.engine[ 0 ].rpm;
     double coef = fdm::Misc::satur( 0.0, 1.0, rpm / 4000.0 );
 
     _prop_p51->play();
@@ -422,19 +583,19 @@ void Manager::updateAircraft_P51( const Data::DataBuf *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_PW5( const Data::DataBuf *data )
+void Manager::updateAircraft_PW5( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateWarning( state );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_R44( const Data::DataBuf *data )
+void Manager::updateAircraft_R44( const State *state )
 {
-    updateWarning( data );
+    updateWarning( state );
 
-    if ( data->ownship.mainRotor.omega > 0.0 )
+    if ( state->mainRotor_omega > 0.0 )
     {
         _prop_r44->play();
     }
@@ -448,12 +609,12 @@ void Manager::updateAircraft_R44( const Data::DataBuf *data )
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_UH60( const Data::DataBuf *data )
+void Manager::updateAircraft_UH60( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateWarning( state );
 
-    if ( data->ownship.mainRotor.omega > 0.0 )
+    if ( state->mainRotor_omega > 0.0 )
     {
         _prop_uh60->play();
     }
@@ -468,34 +629,40 @@ void Manager::updateAircraft_UH60( const Data::DataBuf *data )
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef FDM_TEST
-void Manager::updateAircraft_XF( const Data::DataBuf *data )
+void Manager::updateAircraft_XF( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateLandingGear( data );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateLandingGear( state );
+    updateWarning( state );
 
-    bool afterburner = data->propulsion.engine[ 0 ].afterburner;
-    double n2 = data->propulsion.engine[ 0 ].n2;
+    bool afterburner = state->engine[ 0 ].afterburner;
+    double n2 = state->engine[ 0 ].n2;
     double coef = fdm::Misc::satur( 0.0, 1.0, n2 / 95.0 );
 
+    _afterburner = fdm::Misc::inertia( afterburner ? 1.0 : 0.0, _afterburner, 0.01, 0.5 );
+
+    if ( _synth )
+    {
+        _synth->update( coef * synth_jet.rpm_max, state->engine[ 0 ].throttle, _afterburner, _volume );
+        return;
+    }
+
     _prop_xf->play();
     _prop_xf->setVolume( _volume * coef );
     _prop_xf->setPitch( coef );
 
-    _afterburner = fdm::Misc::inertia( afterburner ? 1.0 : 0.0, _afterburner, 0.01, 0.5 );
-
     _prop_xfab->play();
     _prop_xfab->setVolume( _volume * _afterburner );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Manager::updateAircraft_XH( const Data::DataBuf *data )
+void Manager::updateAircraft_XH( const State *state )
 {
-    updateTouchdown( data, 30.0 );
-    updateWarning( data );
+    updateTouchdown( state, 30.0 );
+    updateWarning( state );
 
-    if ( data->ownship.mainRotor.omega > 0.0 )
+    if ( state->mainRotor_omega > 0.0 )
     {
         _prop_xh->play();
     }
@@ -30,7 +30,9 @@
 #include <Data.h>
 #include <Defines.h>
 
+#include <sfx/sfx_EngineSynth.h>
 #include <sfx/sfx_Sample.h>
+#include <sfx/sfx_SourcePool.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -39,25 +41,66 @@ namespace sfx
 
 /**
  * @brief SFX manager class.
+ *
+ * Common samples are loaded at construction, aircraft samples are loaded
+ * only for the currently flown aircraft type. All samples share sources
+ * from a single pool. If SFX_ENGINE_SYNTH is defined, engine sound of
+ * piston, turboprop and jet aircraft is synthesized instead of played from
+ * samples.
+ *
+ * @see EngineSynth
  */
 class Manager
 {
 public:
 
+    /** Audio state snapshot, only data needed by SFX. */
+    struct State
+    {
+        /** Engine data. */
+        struct Engine
+        {
+            double rpm;                     ///< [rpm] engine rpm
+            double n2;                      ///< [%] high pressure engine spool rotational speed
+            double throttle;                ///< [0.0,1.0] throttle
+            bool afterburner;               ///< specifies if afterburner is enabled
+        };
+
+        Engine engine[ FDM_MAX_ENGINES ];   ///< engines data
+
+        double volume;                      ///< sound volume
+
+        double groundSpeed;                 ///< [m/s] ground speed (horizontal velocity)
+        double norm_landingGear;            ///< [0.0,1.0] landing gear normalized position
+        double mainRotor_omega;             ///< [rad/s] main rotor rotation speed
+
+        fdm::DataInp::AircraftType aircraftType;    ///< input aircraft type
+        fdm::DataInp::StateInp stateInp;            ///< simulation input state
+
+        bool onGround;                      ///< specifies if aircraft is on ground
+        bool stall;                         ///< specifies if aircraft is stalling
+        bool crash;                         ///< specifies if aircraft crashed
+    };
+
     /** @brief Constructor. */
     Manager();
 
     /** @brief Destructor. */
     virtual ~Manager();
 
-    /** @brief Updates SFX. */
-    void update( const Data::DataBuf *data );
+    /**
+     * @brief Updates SFX.
+     * @param state audio state snapshot
+     */
+    void update( const State *state );
 
 private:
 
     ALCdevice  *_device;        ///<
     ALCcontext *_context;       ///<
 
+    SourcePool *_pool;          ///< sources pool
+
     Sample *_explosion;         ///<
     Sample *_touchdown;         ///<
 
@@ -85,6 +128,10 @@ private:
     Sample *_prop_xh;           ///<
 #   endif
 
+    EngineSynth *_synth;        ///< engine sound synthesizer, null if engine sound is sampled
+
+    int _aircraftType;          ///< type of aircraft which samples are loaded, 0 if none
+
     double _volume;             ///<
 
     double _afterburner;        ///<
@@ -96,26 +143,31 @@ private:
     bool _prev_ground;          ///<
     bool _prev_crash;           ///<
 
-    void init( const Data::DataBuf *data );
+    void init( const State *state );
     void stop();
 
-    void updateLandingGear( const Data::DataBuf *data );
-    void updateTouchdown( const Data::DataBuf *data, double vel_max );
-    void updateWarning( const Data::DataBuf *data );
+    void loadAircraft( int aircraftType );
+    void freeAircraft();
+
+    void updateSamples();
+
+    void updateLandingGear( const State *state );
+    void updateTouchdown( const State *state, double vel_max );
+    void updateWarning( const State *state );
 
-    void updateAircraft_AW101 ( const Data::DataBuf *data );
-    void updateAircraft_C130  ( const Data::DataBuf *data );
-    void updateAircraft_C172  ( const Data::DataBuf *data );
-    void updateAircraft_F16   ( const Data::DataBuf *data );
-    void updateAircraft_F35A  ( const Data::DataBuf *data );
-    void updateAircraft_P51   ( const Data::DataBuf *data );
-    void updateAircraft_PW5   ( const Data::DataBuf *data );
-    void updateAircraft_R44   ( const Data::DataBuf *data );
-    void updateAircraft_UH60  ( const Data::DataBuf *data );
+    void updateAircraft_AW101 ( const State *state );
+    void updateAircraft_C130  ( const State *state );
+    void updateAircraft_C172  ( const State *state );
+    void updateAircraft_F16   ( const State *state );
+    void updateAircraft_F35A  ( const State *state );
+    void updateAircraft_P51   ( const State *state );
+    void updateAircraft_PW5   ( const State *state );
+    void updateAircraft_R44   ( const State *state );
+    void updateAircraft_UH60  ( const State *state );
 
 #   ifdef FDM_TEST
-    void updateAircraft_XF( const Data::DataBuf *data );
-    void updateAircraft_XH( const Data::DataBuf *data );
+    void updateAircraft_XF( const State *state );
+    void updateAircraft_XH( const State *state );
 #   endif
 };
 
@@ -22,137 +22,274 @@
 
 #include <sfx/sfx_Sample.h>
 
-#ifdef _MSC_VER
-#   include <algorithm>
-#endif
-
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 #include <AL/alut.h>
 
 #include <Defines.h>
 
+#include <fdm/utils/fdm_MemoryStats.h>
+
 #include <sim/Log.h>
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+
+unsigned int readUInt( std::istream &stream, int bytes )
+{
+    unsigned char data[ 4 ] = { 0, 0, 0, 0 };
+
+    stream.read( (char*)data, bytes );
+
+    // WAV files are little-endian
+    return data[ 0 ] | ( data[ 1 ] << 8 ) | ( data[ 2 ] << 16 ) | ( data[ 3 ] << 24 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool isChanged( double value, double prev, double min_delta )
+{
+    if ( value == prev ) return false;
+
+    // range limits are always applied, so sound can be fully muted
+    return fabs( value - prev ) >= min_delta || value <= 0.0 || value >= 1.0;
+}
+
+int getMemoryId()
+{
+    static const int id = fdm::MemoryStats::add( "sfx.samples" );
+    return id;
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
 using namespace sfx;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Sample::Sample( const char *file, bool looping )
+const int    Sample::_stream_chunks     = 4;
+const double Sample::_stream_chunk_time = 0.25;
+const int    Sample::_stream_min_size   = 256 * 1024;
+const double Sample::_min_delta         = 1.0e-3;
+
+////////////////////////////////////////////////////////////////////////////////
+
+Sample::Sample( const char *file, SourcePool *pool, bool looping ) :
+    _pool ( pool ),
+
+    _source  ( 0 ),
+    _buffer  ( 0 ),
+    _buffers ( NULLPTR ),
+
+    _stream_pos ( 0 ),
+    _chunk      ( NULLPTR ),
+    _chunk_size ( 0 ),
+
+    _bytes ( 0 ),
+
+    _pitch ( 1.0 ),
+    _gain  ( 1.0 ),
+
+    _looping   ( looping ),
+    _streaming ( false ),
+    _playing   ( false )
 {
-    bool error = false;
+    memset( &_format, 0, sizeof(Format) );
 
-    // source generation
-    if ( !error )
+    // long loops are streamed, decoding them in whole would only waste memory
+    if ( _looping && openStream( file ) )
     {
-        alGenSources( (ALuint)1, &_source );
-        error = checkForErrors();
+        _streaming = _format.dataSize >= _stream_min_size;
     }
 
-    if ( !error )
+    if ( _streaming )
     {
-        alSourcef( _source, AL_PITCH, 1);
-        error = checkForErrors();
-    }
+        int frames = std::max( 1, (int)( _stream_chunk_time * _format.freq ) );
 
-    if ( !error )
-    {
-        alSourcef( _source, AL_GAIN, 1);
-        error = checkForErrors();
-    }
+        _chunk_size = frames * _format.blockAlign;
+        _chunk = new char [ _chunk_size ];
 
-    if ( !error )
-    {
-        alSource3f( _source, AL_POSITION, 0, 0, 0);
-        error = checkForErrors();
-    }
+        _buffers = new ALuint [ _stream_chunks ];
 
-    if ( !error )
-    {
-        alSource3f( _source, AL_VELOCITY, 0, 0, 0);
-        error = checkForErrors();
-    }
+        alGenBuffers( _stream_chunks, _buffers );
+        checkForErrors();
 
-    if ( !error )
-    {
-        alSourcei( _source, AL_LOOPING, AL_FALSE );
-        error = checkForErrors();
+        // chunk data and queued buffers
+        _bytes = (size_t)_chunk_size * ( _stream_chunks + 1 );
     }
-
-    // buffer generation
-    if ( !error )
+    else
     {
-        alGenBuffers( (ALuint)1, &_buffer );
-        error = checkForErrors();
-    }
+        _stream.close();
 
-    if ( !error )
-    {
-        error = loadFile( file );
-    }
+        bool error = false;
 
-    // binding source to buffer
-    if ( !error )
-    {
-        alSourcei( _source, AL_BUFFER, _buffer );
-        error = checkForErrors();
+        if ( !error )
+        {
+            alGenBuffers( (ALuint)1, &_buffer );
+            error = checkForErrors();
+        }
+
+        if ( !error )
+        {
+            error = loadFile( file );
+        }
     }
 
-    setLooping( looping );
+    fdm::MemoryStats::allocate( getMemoryId(), _bytes );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Sample::~Sample()
 {
-    alDeleteSources( 1, &_source );
-    alDeleteBuffers( 1, &_buffer );
+    releaseSource();
+
+    fdm::MemoryStats::release( getMemoryId(), _bytes );
+
+    if ( _buffers )
+    {
+        alDeleteBuffers( _stream_chunks, _buffers );
+    }
+    else
+    {
+        alDeleteBuffers( 1, &_buffer );
+    }
+
+    DELTAB( _buffers );
+    DELTAB( _chunk );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Sample::play()
 {
+    // looping source plays until stopped, stream underrun is handled by update()
+    if ( _playing && _looping ) return;
+
+    if ( _source == 0 && !acquireSource() )
+    {
+        // all sources are busy, next call will try again
+        return;
+    }
+
     ALint state;
 
     alGetSourcei( _source, AL_SOURCE_STATE, &state );
 
     if ( state != AL_PLAYING )
     {
+        if ( _streaming ) queueStream();
+
         alSourcePlay( _source );
     }
+
+    _playing = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Sample::stop()
 {
-    alSourceStop( _source );
+    releaseSource();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sample::update()
+{
+    if ( _source == 0 ) return;
+
+    // static looping source cannot stop by itself
+    if ( !_streaming && _looping && _playing ) return;
+
+    ALint state;
+
+    alGetSourcei( _source, AL_SOURCE_STATE, &state );
+
+    if ( _streaming )
+    {
+        ALint processed = 0;
+
+        alGetSourcei( _source, AL_BUFFERS_PROCESSED, &processed );
+
+        while ( processed-- > 0 )
+        {
+            ALuint buffer = 0;
+
+            alSourceUnqueueBuffers( _source, 1, &buffer );
+
+            if ( fillBuffer( buffer ) )
+            {
+                alSourceQueueBuffers( _source, 1, &buffer );
+            }
+        }
+
+        if ( state == AL_STOPPED )
+        {
+            if ( _looping )
+            {
+                // stream ran dry, e.g. after thread stall
+                queueStream();
+                alSourcePlay( _source );
+            }
+            else
+            {
+                releaseSource();
+            }
+        }
+    }
+    else if ( state == AL_STOPPED )
+    {
+        releaseSource();
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Sample::setLooping( bool looping )
 {
-    alSourcei( _source, AL_LOOPING, ( looping ? AL_TRUE : AL_FALSE ) );
+    if ( looping == _looping ) return;
+
+    _looping = looping;
+
+    // streamed sample loops by rewinding the stream
+    if ( _source != 0 && !_streaming )
+    {
+        alSourcei( _source, AL_LOOPING, ( _looping ? AL_TRUE : AL_FALSE ) );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Sample::setPitch( double pitch )
 {
-    alSourcef( _source, AL_PITCH, std::max( 0.0, std::min( 1.0, pitch ) ) );
+    pitch = std::max( 0.0, std::min( 1.0, pitch ) );
+
+    if ( !isChanged( pitch, _pitch, _min_delta ) ) return;
+
+    _pitch = pitch;
+
+    if ( _source != 0 ) alSourcef( _source, AL_PITCH, _pitch );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Sample::setVolume( double vol )
 {
-    alSourcef( _source, AL_GAIN, std::max( 0.0, std::min( 1.0, vol ) ) );
-}
+    vol = std::max( 0.0, std::min( 1.0, vol ) );
 
+    if ( !isChanged( vol, _gain, _min_delta ) ) return;
+
+    _gain = vol;
+
+    if ( _source != 0 ) alSourcef( _source, AL_GAIN, _gain );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -227,7 +364,186 @@ bool Sample::loadFile( const char *file )
     {
         alBufferData( _buffer, format, data, size, freq );
         error = checkForErrors();
+
+        if ( !error ) _bytes = size;
     }
 
+    if ( data ) alutUnloadWAV( format, data, size, freq );
+
     return error;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Sample::openStream( const char *file )
+{
+    _stream.open( file, std::ios_base::in | std::ios_base::binary );
+
+    if ( _stream.is_open() && readFormat( _stream, &_format ) )
+    {
+        _stream_pos = 0;
+        _stream.seekg( _format.dataBegin );
+
+        return true;
+    }
+
+    _stream.close();
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Sample::readFormat( std::istream &stream, Format *format )
+{
+    char id[ 4 ];
+
+    stream.read( id, 4 );
+    readUInt( stream, 4 );
+
+    if ( !stream.good() || strncmp( id, "RIFF", 4 ) != 0 ) return false;
+
+    stream.read( id, 4 );
+
+    if ( !stream.good() || strncmp( id, "WAVE", 4 ) != 0 ) return false;
+
+    bool fmt = false;
+
+    while ( stream.good() )
+    {
+        stream.read( id, 4 );
+        std::streamoff size = readUInt( stream, 4 );
+
+        if ( !stream.good() ) break;
+
+        std::streamoff next = (std::streamoff)stream.tellg() + size + ( size & 1 );
+
+        if ( strncmp( id, "fmt ", 4 ) == 0 )
+        {
+            unsigned int code     = readUInt( stream, 2 );
+            unsigned int channels = readUInt( stream, 2 );
+            unsigned int freq     = readUInt( stream, 4 );
+            readUInt( stream, 4 ); // byte rate
+            unsigned int align    = readUInt( stream, 2 );
+            unsigned int bits     = readUInt( stream, 2 );
+
+            // only uncompressed PCM can be streamed
+            if ( code != 1 || align == 0 ) return false;
+
+            if      ( channels == 1 && bits ==  8 ) format->format = AL_FORMAT_MONO8;
+            else if ( channels == 1 && bits == 16 ) format->format = AL_FORMAT_MONO16;
+            else if ( channels == 2 && bits ==  8 ) format->format = AL_FORMAT_STEREO8;
+            else if ( channels == 2 && bits == 16 ) format->format = AL_FORMAT_STEREO16;
+            else return false;
+
+            format->freq = freq;
+            format->blockAlign = align;
+
+            fmt = true;
+        }
+        else if ( strncmp( id, "data", 4 ) == 0 )
+        {
+            format->dataBegin = stream.tellg();
+            format->dataSize  = size - size % std::max( 1, format->blockAlign );
+
+            return fmt && format->dataSize > 0;
+        }
+
+        stream.seekg( next );
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Sample::fillBuffer( ALuint buffer )
+{
+    int size = 0;
+
+    while ( size < _chunk_size )
+    {
+        if ( _stream_pos >= _format.dataSize )
+        {
+            if ( !_looping ) break;
+
+            _stream_pos = 0;
+            _stream.clear();
+            _stream.seekg( _format.dataBegin );
+        }
+
+        std::streamoff left = _format.dataSize - _stream_pos;
+        std::streamoff count = std::min( (std::streamoff)( _chunk_size - size ), left );
+
+        _stream.read( _chunk + size, count );
+
+        int read = (int)_stream.gcount();
+
+        if ( read <= 0 )
+        {
+            // truncated file, next read starts over
+            _stream_pos = _format.dataSize;
+            break;
+        }
+
+        size += read;
+        _stream_pos += read;
+    }
+
+    if ( size > 0 )
+    {
+        alBufferData( buffer, _format.format, _chunk, size, _format.freq );
+        return !checkForErrors();
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sample::queueStream()
+{
+    // detaching buffers left from previous playback
+    alSourcei( _source, AL_BUFFER, 0 );
+
+    for ( int i = 0; i < _stream_chunks; i++ )
+    {
+        if ( fillBuffer( _buffers[ i ] ) )
+        {
+            alSourceQueueBuffers( _source, 1, &_buffers[ i ] );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool Sample::acquireSource()
+{
+    _source = _pool->acquire();
+
+    if ( _source == 0 ) return false;
+
+    if ( !_streaming )
+    {
+        alSourcei( _source, AL_BUFFER, _buffer );
+        alSourcei( _source, AL_LOOPING, ( _looping ? AL_TRUE : AL_FALSE ) );
+    }
+
+    alSourcef( _source, AL_PITCH, _pitch );
+    alSourcef( _source, AL_GAIN,  _gain  );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Sample::releaseSource()
+{
+    if ( _source != 0 )
+    {
+        _pool->release( _source );
+        _source = 0;
+    }
+
+    _playing = false;
+}
@@ -24,23 +24,45 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <fstream>
 #include <string>
 
 #include <AL/al.h>
 #include <AL/alc.h>
 
+#include <sfx/sfx_SourcePool.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace sfx
 {
 
-/** */
+/**
+ * @brief SFX sample class.
+ *
+ * Sample borrows source from the pool only while it is playing. Long looping
+ * samples are not decoded in whole, they are streamed from file in chunks
+ * queued on the source.
+ *
+ * Last applied source parameters are cached, so OpenAL is called only
+ * when they change.
+ */
 class Sample
 {
 public:
 
-    /** @brief Constructor. */
-    Sample( const char *file, bool looping = false );
+    static const int    _stream_chunks;     ///< number of queued stream buffers
+    static const double _stream_chunk_time; ///< [s] stream chunk duration
+    static const int    _stream_min_size;   ///< [B] minimum size of looping sample data to be streamed
+    static const double _min_delta;         ///< [-] minimum pitch or gain change applied to source
+
+    /**
+     * @brief Constructor.
+     * @param file WAV file path
+     * @param pool sources pool
+     * @param looping specifies if sample is looping
+     */
+    Sample( const char *file, SourcePool *pool, bool looping = false );
 
     /** @brief Destructor. */
     virtual ~Sample();
@@ -49,18 +71,66 @@ public:
 
     void stop();
 
+    /**
+     * @brief Refills stream buffers and returns source of finished sample.
+     * Should be called every SFX update.
+     */
+    void update();
+
     void setLooping( bool looping );
     void setPitch( double pitch );
     void setVolume( double vol );
 
+    inline bool isStreaming() const { return _streaming; }
+
 private:
 
-    ALuint _source;         ///<
-    ALuint _buffer;         ///<
+    /** WAV file data format. */
+    struct Format
+    {
+        ALenum format;                      ///< OpenAL buffer format
+        ALsizei freq;                       ///< [Hz] sampling frequency
+        int blockAlign;                     ///< [B] size of sample frame
+        std::streamoff dataBegin;           ///< [B] data chunk offset
+        std::streamoff dataSize;            ///< [B] data chunk size
+    };
+
+    SourcePool *_pool;                      ///< sources pool
+
+    ALuint _source;                         ///< source name, 0 if not playing
+    ALuint _buffer;                         ///< static buffer
+    ALuint *_buffers;                       ///< stream buffers
+
+    std::ifstream _stream;                  ///< stream file
+    Format _format;                         ///< stream data format
+    std::streamoff _stream_pos;             ///< [B] stream position within data chunk
+    char *_chunk;                           ///< stream chunk data
+    int _chunk_size;                        ///< [B] stream chunk size
+
+    size_t _bytes;                          ///< [B] accounted buffers size
+
+    double _pitch;                          ///< [-] last applied pitch
+    double _gain;                           ///< [-] last applied gain
+
+    bool _looping;                          ///< specifies if sample is looping
+    bool _streaming;                        ///< specifies if sample is streamed
+    bool _playing;                          ///< specifies if source has been started
 
     bool checkForErrors();
 
     bool loadFile( const char *file );
+
+    bool openStream( const char *file );
+
+    bool readFormat( std::istream &stream, Format *format );
+
+    bool fillBuffer( ALuint buffer );
+
+    void queueStream();
+
+    bool acquireSource();
+
+    void releaseSource();
 };
 
 } // end of sfx namepsace
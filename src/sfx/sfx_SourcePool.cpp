@@ -0,0 +1,108 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sfx/sfx_SourcePool.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace sfx;
+
+////////////////////////////////////////////////////////////////////////////////
+
+const int SourcePool::_size = 16;
+
+////////////////////////////////////////////////////////////////////////////////
+
+SourcePool::SourcePool()
+{
+    ALuint sources[ _size ];
+
+    alGetError();
+    alGenSources( _size, sources );
+
+    if ( alGetError() == AL_NO_ERROR )
+    {
+        for ( int i = 0; i < _size; i++ )
+        {
+            _sources.push_back( sources[ i ] );
+        }
+
+        // released sources go back to the end, acquire takes from the end
+        _free = _sources;
+    }
+    else
+    {
+        Log::e() << "Cannot generate SFX sources." << std::endl;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SourcePool::~SourcePool()
+{
+    for ( unsigned int i = 0; i < _sources.size(); i++ )
+    {
+        alSourceStop( _sources[ i ] );
+        alSourcei( _sources[ i ], AL_BUFFER, 0 );
+    }
+
+    if ( _sources.size() > 0 )
+    {
+        alDeleteSources( (ALsizei)_sources.size(), &_sources[ 0 ] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ALuint SourcePool::acquire()
+{
+    if ( _free.size() > 0 )
+    {
+        ALuint source = _free.back();
+        _free.pop_back();
+
+        alSourcef  ( source, AL_PITCH, 1.0f );
+        alSourcef  ( source, AL_GAIN,  1.0f );
+        alSource3f ( source, AL_POSITION, 0.0f, 0.0f, 0.0f );
+        alSource3f ( source, AL_VELOCITY, 0.0f, 0.0f, 0.0f );
+        alSourcei  ( source, AL_LOOPING, AL_FALSE );
+
+        return source;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SourcePool::release( ALuint source )
+{
+    if ( source != 0 )
+    {
+        alSourceStop( source );
+        alSourcei( source, AL_BUFFER, 0 );
+
+        _free.push_back( source );
+    }
+}
@@ -0,0 +1,78 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef SFX_SOURCEPOOL_H
+#define SFX_SOURCEPOOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <AL/al.h>
+#include <AL/alc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace sfx
+{
+
+/**
+ * @brief OpenAL sources pool class.
+ *
+ * Sources are generated once and lent to samples only while they are
+ * playing, so number of sources does not grow with number of loaded samples.
+ */
+class SourcePool
+{
+public:
+
+    static const int _size;     ///< number of pooled sources
+
+    /** @brief Constructor. */
+    SourcePool();
+
+    /** @brief Destructor. */
+    virtual ~SourcePool();
+
+    /**
+     * @brief Acquires free source.
+     * @return source name or 0 if no source is available
+     */
+    ALuint acquire();
+
+    /**
+     * @brief Returns source to the pool.
+     * Source is stopped and detached from its buffers.
+     * @param source source name
+     */
+    void release( ALuint source );
+
+private:
+
+    std::vector< ALuint > _sources;     ///< all pooled sources
+    std::vector< ALuint > _free;        ///< sources available to acquire
+};
+
+} // end of sfx namepsace
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SFX_SOURCEPOOL_H
@@ -22,6 +22,12 @@
 
 #include <sfx/sfx_Thread.h>
 
+#include <fdm/utils/fdm_Metrics.h>
+#include <fdm/utils/fdm_ThreadPlacement.h>
+
+#include <sim/IdleMode.h>
+#include <sim/Log.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace sfx;
@@ -33,7 +39,7 @@ Thread::Thread() :
     _timer ( NULLPTR ),
     _sfx ( NULLPTR )
 {
-    memset( &_data, 0, sizeof(Data::DataBuf) );
+    memset( &_state, 0, sizeof(Manager::State) );
     moveToThread( this );
 }
 
@@ -57,6 +63,11 @@ void Thread::init()
 
 void Thread::run()
 {
+    if ( !fdm::ThreadPlacement::apply( fdm::ThreadPlacement::Sound ) )
+    {
+        Log::w() << "Cannot set sound thread CPU affinity." << std::endl;
+    }
+
     _timer = new QTimer();
 
     connect( _timer, SIGNAL(timeout()), this, SLOT(update()) );
@@ -74,18 +85,59 @@ void Thread::run()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Thread::onDataInpUpdated( const Data::DataBuf *data )
+void Thread::setData( const Data::DataBuf *data )
 {
-    memcpy( &_data, data, sizeof(Data::DataBuf) );
+    Manager::State &state = _stateBuffer.getBackBuffer();
+
+    for ( unsigned int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        state.engine[ i ].rpm         = data->propulsion.engine[ i ].rpm;
+        state.engine[ i ].n2          = data->propulsion.engine[ i ].n2;
+        state.engine[ i ].throttle    = data->propulsion.engine[ i ].throttle;
+        state.engine[ i ].afterburner = data->propulsion.engine[ i ].afterburner;
+    }
+
+    state.volume = data->sfx.volume;
+
+    state.groundSpeed      = data->ownship.groundSpeed;
+    state.norm_landingGear = data->ownship.norm_landingGear;
+    state.mainRotor_omega  = data->ownship.mainRotor.omega;
+
+    state.aircraftType = data->aircraftType;
+    state.stateInp     = data->stateInp;
+
+    state.onGround = data->ownship.onGround;
+    state.stall    = data->ownship.stall;
+    state.crash    = data->ownship.crash;
+
+    ///////////////////////
+    _stateBuffer.publish();
+    ///////////////////////
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void Thread::update()
 {
+    FDM_METRICS_ZONE( "sfx.update" );
+
+#   ifdef SIM_LOW_POWER_IDLE
+    int interval = 1000.0 * ( IdleMode::isActive() ? SIM_IDLE_TIME_STEP : FDM_TIME_STEP );
+
+    if ( _timer->interval() != interval )
+    {
+        _timer->setInterval( interval );
+    }
+#   endif
+
+    if ( _stateBuffer.fetch() )
+    {
+        _state = _stateBuffer.getFrontBuffer();
+    }
+
     if ( _sfx )
     {
-        _sfx->update( &_data );
+        _sfx->update( &_state );
     }
     else
     {
@@ -31,12 +31,19 @@
 
 #include <sfx/sfx_Manager.h>
 
+#include <sim/TripleBuffer.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace sfx
 {
 
-/** */
+/**
+ * @brief SFX thread class.
+ *
+ * SFX thread gets compact audio state snapshots through lock-free triple
+ * buffer, so it never reads shared data buffer owned by the GUI thread.
+ */
 class Thread : public QThread
 {
     Q_OBJECT
@@ -55,14 +62,18 @@ public:
     /** */
     void run();
 
-public slots:
-
-    /** */
-    void onDataInpUpdated( const Data::DataBuf *data );
+    /**
+     * @brief Publishes audio state snapshot for SFX thread.
+     * Might be called only from the thread which owns Data::DataBuf.
+     * @param data data
+     */
+    void setData( const Data::DataBuf *data );
 
 private:
 
-    Data::DataBuf _data;        ///
+    TripleBuffer< Manager::State > _stateBuffer;    ///< audio state channel
+
+    Manager::State _state;      ///< most recent audio state
 
     QTimer *_timer;             ///<
     sfx::Manager *_sfx;         ///< SFX
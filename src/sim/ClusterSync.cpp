@@ -0,0 +1,319 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/ClusterSync.h>
+
+#include <chrono>
+#include <cstring>
+
+#include <fdm/utils/fdm_Time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Writes datagram header. */
+void writeHeader( char *buffer, fdm::UInt32 type, fdm::UInt32 number )
+{
+    memcpy( buffer     , &ClusterSync::_magic , 4 );
+    memcpy( buffer + 4 , &type                , 4 );
+    memcpy( buffer + 8 , &number              , 4 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Writes frame data into (reads frame data from) datagram payload. */
+void copyFrame( char *payload, ClusterSync::Frame *frame, bool write )
+{
+    double *values[ 15 ] =
+    {
+        &frame->simTime, &frame->timeCoef,
+        &frame->pos_wgs[ 0 ], &frame->pos_wgs[ 1 ], &frame->pos_wgs[ 2 ],
+        &frame->att_wgs[ 0 ], &frame->att_wgs[ 1 ], &frame->att_wgs[ 2 ], &frame->att_wgs[ 3 ],
+        &frame->vel_bas[ 0 ], &frame->vel_bas[ 1 ], &frame->vel_bas[ 2 ],
+        &frame->omg_bas[ 0 ], &frame->omg_bas[ 1 ], &frame->omg_bas[ 2 ]
+    };
+
+    for ( int i = 0; i < 15; i++ )
+    {
+        if ( write )
+            memcpy( payload + 8 * i, values[ i ], 8 );
+        else
+            memcpy( values[ i ], payload + 8 * i, 8 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::chrono::microseconds toDuration( double time )
+{
+    return std::chrono::microseconds( (long long)( 1.0e6 * time ) );
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+const fdm::UInt32 ClusterSync::_magic = 0x4353434D; // "MSCS"
+
+////////////////////////////////////////////////////////////////////////////////
+
+ClusterSync::ClusterSync() :
+    _group ( 0 ),
+    _masterAddress ( 0 ),
+    _port ( 0 ),
+    _masterPort ( 0 ),
+    _number ( 0 ),
+    _readyNumber ( 0 ),
+    _swapNumber ( 0 ),
+    _readyCount ( 0 ),
+    _slaves ( 0 ),
+    _frameTimeout ( 0.0 ),
+    _swapTimeout ( 0.0 ),
+    _quit ( false ),
+    _lateSwaps ( 0 ),
+    _master ( false ),
+    _open ( false )
+{
+    memset( &_frame, 0, sizeof(Frame) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ClusterSync::~ClusterSync()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ClusterSync::open( bool master, const char *address, unsigned short port,
+                        unsigned int slaves, double frameTimeout, double swapTimeout )
+{
+    close();
+
+    if ( !UdpSocket::resolve( address, &_group ) ) return false;
+
+    // slaves listen on the group port, master replies come to its own port
+    if ( !_socket.open( master ? 0 : port ) ) return false;
+
+    if ( !master && !_socket.join( _group ) )
+    {
+        _socket.close();
+        return false;
+    }
+
+    memset( &_frame, 0, sizeof(Frame) );
+
+    _port = port;
+
+    _masterAddress = 0;
+    _masterPort    = 0;
+
+    _number      = 0;
+    _readyNumber = 0;
+    _swapNumber  = 0;
+    _readyCount  = 0;
+
+    _slaves = slaves;
+
+    _frameTimeout = frameTimeout;
+    _swapTimeout  = swapTimeout;
+
+    _master = master;
+
+    _quit = false;
+    _open = true;
+
+    _thread = std::thread( &ClusterSync::work, this );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterSync::close()
+{
+    if ( _open )
+    {
+        _quit = true;
+
+        if ( _thread.joinable() ) _thread.join();
+
+        _socket.close();
+        _open = false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterSync::publish( Frame *frame )
+{
+    if ( !_open || !_master ) return;
+
+    frame->number = ++_number;
+
+    char buffer[ _frameSize ];
+
+    writeHeader( buffer, FrameData, frame->number );
+    copyFrame( buffer + _headerSize, frame, true );
+
+    _socket.send( buffer, _frameSize, _group, _port );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ClusterSync::latch( Frame *frame )
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    if ( _open && !_master )
+    {
+        _cv.wait_for( lock, toDuration( _frameTimeout ),
+                      [ this ] { return _frame.number > _number; } );
+    }
+
+    // master restart resets frame numbers
+    bool fresh = _frame.number != _number;
+
+    _number = _frame.number;
+    (*frame) = _frame;
+
+    return fresh;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterSync::barrier()
+{
+    if ( !_open || _number == 0 ) return;
+
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    fdm::UInt32 number = _number;
+
+    bool ready = false;
+
+    if ( _master )
+    {
+        ready = _slaves == 0 || _cv.wait_for( lock, toDuration( _swapTimeout ), [ this, number ]
+        {
+            return _readyNumber == number && _readyCount >= _slaves;
+        });
+
+        send( Swap, number );
+    }
+    else
+    {
+        // frame dead reckoned without master frame has been already reported
+        if ( _readyNumber == number ) return;
+
+        _readyNumber = number;
+
+        send( Ready, number );
+
+        ready = _cv.wait_for( lock, toDuration( _swapTimeout ), [ this, number ]
+        {
+            return _swapNumber == number;
+        });
+    }
+
+    if ( !ready ) _lateSwaps++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterSync::send( Type type, fdm::UInt32 number )
+{
+    char buffer[ _headerSize ];
+
+    writeHeader( buffer, type, number );
+
+    if ( _master )
+        _socket.send( buffer, _headerSize, _group, _port );
+    else if ( _masterPort != 0 )
+        _socket.send( buffer, _headerSize, _masterAddress, _masterPort );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterSync::work()
+{
+    char buffer[ 2 * _frameSize ];
+
+    while ( !_quit )
+    {
+        if ( !_socket.wait( 0.1 ) ) continue;
+
+        int size = 0;
+
+        fdm::UInt32 address = 0;
+        unsigned short port = 0;
+
+        while ( ( size = _socket.receive( buffer, sizeof(buffer), &address, &port ) ) >= (int)_headerSize )
+        {
+            fdm::UInt32 magic  = 0;
+            fdm::UInt32 type   = 0;
+            fdm::UInt32 number = 0;
+
+            memcpy( &magic  , buffer     , 4 );
+            memcpy( &type   , buffer + 4 , 4 );
+            memcpy( &number , buffer + 8 , 4 );
+
+            if ( magic != _magic ) continue;
+
+            std::lock_guard< std::mutex > lock( _mutex );
+
+            if ( _master && type == Ready )
+            {
+                if ( number != _readyNumber )
+                {
+                    _readyNumber = number;
+                    _readyCount  = 0;
+                }
+
+                _readyCount++;
+            }
+            else if ( !_master && type == FrameData && size == (int)_frameSize )
+            {
+                copyFrame( buffer + _headerSize, &_frame, false );
+
+                _frame.number = number;
+                _frame.time   = fdm::Time::get();
+
+                _masterAddress = address;
+                _masterPort    = port;
+            }
+            else if ( !_master && type == Swap )
+            {
+                _swapNumber = number;
+            }
+            else
+            {
+                continue;
+            }
+
+            _cv.notify_all();
+        }
+    }
+}
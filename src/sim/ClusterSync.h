@@ -0,0 +1,201 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef CLUSTERSYNC_H
+#define CLUSTERSYNC_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <sim/Singleton.h>
+#include <sim/UdpSocket.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Multi-node image generators frame synchronization class.
+ *
+ * Cluster consists of single master node and any number of slave nodes,
+ * each rendering its own OTW channel. Every rendered frame master multicasts
+ * frame number, simulation time and ownship pose it has just latched.
+ * Slaves render frames driven by the master: slave latch waits for the next
+ * master frame and renders its exact pose. When master frames are missing
+ * the most recent one is dead reckoned by its age, so view does not freeze.
+ *
+ * Buffers swaps are aligned with network swap barrier. Every slave reports
+ * its frame is ready to be swapped, master waits until all slaves are ready
+ * and multicasts swap command, then all nodes swap at once. Barrier waiting
+ * time is limited, so a lost datagram or a dead node costs a single late
+ * swap rather than stalls the cluster. Render thread finishes drawing before
+ * reporting readiness, so swaps are aligned within network latency. With
+ * vertical synchronization enabled displays refresh should be genlocked,
+ * otherwise swaps are still delayed up to the refresh period.
+ *
+ * Datagram format (host byte order):
+ * @code
+ * UInt32 magic, UInt32 type, UInt32 frame number,
+ * [ 15 doubles: FDM frame time stamp, time coefficient,
+ *   position (WGS), attitude (quaternion e0, ex, ey, ez),
+ *   velocity (BAS), angular velocity (BAS) ] ... frame datagrams only
+ * @endcode
+ *
+ * Master sends frames and swap commands to the multicast group, slaves
+ * join the group and report readiness to the master frames source address.
+ */
+class ClusterSync : public Singleton< ClusterSync >
+{
+    friend class Singleton< ClusterSync >;
+
+public:
+
+    static const fdm::UInt32 _magic;        ///< datagrams magic number
+
+    /** Master frame. */
+    struct Frame
+    {
+        fdm::UInt32 number;     ///< frame number, 0 means no frame
+
+        double time;            ///< [s] frame time (fdm::Time::get()), on slaves arrival time
+        double simTime;         ///< [s] FDM frame time stamp (master clock)
+        double timeCoef;        ///< [-] time coefficient
+
+        double pos_wgs[ 3 ];    ///< [m] ownship position expressed in WGS
+        double att_wgs[ 4 ];    ///< ownship attitude expressed as quaternion (e0, ex, ey, ez) of rotation from WGS to BAS
+        double vel_bas[ 3 ];    ///< [m/s] ownship velocity expressed in BAS
+        double omg_bas[ 3 ];    ///< [rad/s] ownship angular velocity expressed in BAS
+    };
+
+    /** @brief Destructor. */
+    virtual ~ClusterSync();
+
+    /**
+     * @brief Opens socket and starts receiver thread.
+     * @param master specifies if node is master
+     * @param address multicast group address
+     * @param port multicast group port
+     * @param slaves number of slaves the master waits for
+     * @param frameTimeout [s] maximum time slave waits for master frame
+     * @param swapTimeout [s] maximum swap barrier waiting time
+     * @return true on success, false on failure
+     */
+    bool open( bool master, const char *address, unsigned short port,
+               unsigned int slaves, double frameTimeout, double swapTimeout );
+
+    /** @brief Stops receiver thread and closes socket. */
+    void close();
+
+    /**
+     * @brief Sends frame to slaves, frame number is assigned.
+     * Might be called by the master render thread only.
+     * @param frame latched frame
+     */
+    void publish( Frame *frame );
+
+    /**
+     * @brief Waits for the next master frame.
+     * Might be called by the slave render thread only.
+     * @param frame the most recent master frame
+     * @return true if frame has not been latched before, false otherwise
+     */
+    bool latch( Frame *frame );
+
+    /**
+     * @brief Waits until all nodes are ready to swap the latched frame.
+     * Might be called by the render thread only, right before buffers swap.
+     */
+    void barrier();
+
+    /** @return number of late swaps (barrier timeouts) */
+    inline fdm::UInt32 getLateSwaps() const { return _lateSwaps; }
+
+    /** @return true if node is master */
+    inline bool isMaster() const { return _master; }
+
+    /** @return true if cluster synchronization is open */
+    inline bool isOpen() const { return _open; }
+
+private:
+
+    /** Datagram types. */
+    enum Type
+    {
+        FrameData = 1,          ///< master frame
+        Ready,                  ///< slave is ready to swap
+        Swap                    ///< swap command
+    };
+
+    static const unsigned int _headerSize = 12;                     ///< datagram header size
+    static const unsigned int _frameSize  = _headerSize + 15 * 8;   ///< frame datagram size
+
+    UdpSocket _socket;                      ///< socket
+
+    std::mutex _mutex;                      ///< state mutex
+    std::condition_variable _cv;            ///< state change condition
+
+    Frame _frame;                           ///< the most recent master frame (slave)
+
+    fdm::UInt32 _group;                     ///< multicast group address
+    fdm::UInt32 _masterAddress;             ///< master address (slave)
+
+    unsigned short _port;                   ///< multicast group port
+    unsigned short _masterPort;             ///< master port (slave)
+
+    fdm::UInt32 _number;                    ///< latched frame number
+    fdm::UInt32 _readyNumber;               ///< frame number slaves reported ready for (master), readiness reported for (slave)
+    fdm::UInt32 _swapNumber;                ///< frame number swap has been commanded for (slave)
+
+    unsigned int _readyCount;               ///< number of slaves ready to swap (master)
+    unsigned int _slaves;                   ///< number of slaves (master)
+
+    double _frameTimeout;                   ///< [s] maximum time slave waits for master frame
+    double _swapTimeout;                    ///< [s] maximum swap barrier waiting time
+
+    std::thread _thread;                    ///< receiver thread
+
+    std::atomic< bool > _quit;              ///< specifies if receiver thread should quit
+    std::atomic< fdm::UInt32 > _lateSwaps;  ///< number of late swaps
+
+    bool _master;                           ///< specifies if node is master
+    bool _open;                             ///< specifies if cluster synchronization is open
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to ClusterSync class instance.
+     */
+    ClusterSync();
+
+    /** Using this constructor is forbidden. */
+    ClusterSync( const ClusterSync & ) {}
+
+    /** Sends header only datagram (master: to group, slave: to master). */
+    void send( Type type, fdm::UInt32 number );
+
+    /** Receiver thread loop. */
+    void work();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // CLUSTERSYNC_H
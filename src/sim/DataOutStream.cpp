@@ -0,0 +1,514 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/DataOutStream.h>
+
+#include <cstring>
+
+#ifdef _LINUX_
+#   include <arpa/inet.h>
+#   include <fcntl.h>
+#   include <netinet/in.h>
+#   include <sys/socket.h>
+#   include <unistd.h>
+#endif
+
+#ifdef WIN32
+#   include <winsock2.h>
+#endif
+
+#include <fdm/utils/fdm_Time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char *DataOutStream::_magic = "MSDS";
+const fdm::UInt8 DataOutStream::_version = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void writeUInt( char *buffer, fdm::UInt64 value, unsigned int bytes )
+{
+    for ( unsigned int i = 0; i < bytes; i++ )
+    {
+        buffer[ i ] = (char)( ( value >> ( 8 * i ) ) & 0xff );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static fdm::UInt64 readUInt( const char *buffer, unsigned int bytes )
+{
+    fdm::UInt64 value = 0;
+
+    for ( unsigned int i = 0; i < bytes; i++ )
+    {
+        value |= (fdm::UInt64)( (fdm::UInt8)buffer[ i ] ) << ( 8 * i );
+    }
+
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static unsigned int getChannelsCount( fdm::UInt8 subsystems )
+{
+    unsigned int count = 2 + DataOutStream::_flightChannels;
+
+    if ( subsystems & DataOutStream::Controls    ) count += sizeof(fdm::DataOut::Controls)    / sizeof(double);
+    if ( subsystems & DataOutStream::Engines     ) count += DataOutStream::_engineChannels * FDM_MAX_ENGINES;
+    if ( subsystems & DataOutStream::Environment ) count += sizeof(fdm::DataOut::Environment) / sizeof(double);
+    if ( subsystems & DataOutStream::Rotor       ) count += sizeof(fdm::DataOut::Rotor)       / sizeof(double);
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int DataOutStream::decode( const char *buffer, unsigned int size,
+                           Frame *frames, unsigned int max_frames,
+                           Header *header )
+{
+    if ( size < _headerSize || 0 != memcmp( buffer, _magic, 4 ) ) return -1;
+
+    Header temp;
+
+    temp.version    = (fdm::UInt8)buffer[ 4 ];
+    temp.subsystems = (fdm::UInt8)buffer[ 5 ];
+    temp.frames     = (fdm::UInt16)readUInt( buffer +  6, 2 );
+    temp.sequence   = (fdm::UInt32)readUInt( buffer +  8, 4 );
+    temp.frame      = (fdm::UInt32)readUInt( buffer + 12, 4 );
+
+    if ( temp.version != _version ) return -1;
+
+    if ( header ) *header = temp;
+
+    const unsigned int count = getChannelsCount( temp.subsystems );
+    const unsigned int mask_size = ( count + 7 ) / 8;
+
+    fdm::UInt64 channels[ _maxChannels ];
+    memset( channels, 0, sizeof(channels) );
+
+    unsigned int pos = _headerSize;
+    unsigned int decoded = 0;
+
+    for ( unsigned int f = 0; f < temp.frames && decoded < max_frames; f++ )
+    {
+        if ( pos + mask_size > size ) return -1;
+
+        const char *mask = buffer + pos;
+        pos += mask_size;
+
+        for ( unsigned int i = 0; i < count; i++ )
+        {
+            if ( mask[ i / 8 ] & ( 1 << ( i % 8 ) ) )
+            {
+                if ( pos >= size ) return -1;
+
+                unsigned int bytes = (fdm::UInt8)buffer[ pos++ ];
+
+                if ( bytes < 1 || bytes > 8 || pos + bytes > size ) return -1;
+
+                channels[ i ] ^= readUInt( buffer + pos, bytes );
+                pos += bytes;
+            }
+        }
+
+        Frame *frame = &frames[ decoded++ ];
+
+        memset( &frame->dataOut, 0, sizeof(fdm::DataOut) );
+
+        frame->number = temp.frame + f;
+        setChannels( channels, temp.subsystems, &frame->dataOut, &frame->time );
+    }
+
+    return (int)decoded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataOutStream::DataOutStream() :
+#   ifdef WIN32
+    _socket ( (fdm::UInt64)INVALID_SOCKET ),
+#   else
+    _socket ( -1 ),
+#   endif
+    _address ( 0 ),
+    _port ( 0 ),
+    _subsystems ( Controls | Engines | Rotor ),
+    _frameInterval ( 0.0 ),
+    _sendInterval ( 0.0 ),
+    _frameTime ( 0.0 ),
+    _sendTime ( 0.0 ),
+    _sequence ( 0 ),
+    _frame ( 0 ),
+    _dropped ( 0 ),
+    _size ( 0 ),
+    _frames ( 0 ),
+    _open ( false )
+{
+    memset( _buffer, 0, sizeof(_buffer) );
+    memset( _previous, 0, sizeof(_previous) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataOutStream::~DataOutStream()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool DataOutStream::open( const char *address, unsigned short port, int ttl )
+{
+    close();
+
+    fdm::UInt32 addr = inet_addr( address );
+
+    if ( addr == INADDR_NONE ) return false;
+
+#   ifdef _LINUX_
+    _socket = socket( AF_INET, SOCK_DGRAM, 0 );
+
+    if ( _socket < 0 ) return false;
+
+    unsigned char ttl_val = (unsigned char)ttl;
+
+    if ( 0 != setsockopt( _socket, IPPROTO_IP, IP_MULTICAST_TTL, &ttl_val, sizeof(ttl_val) )
+      || 0 != fcntl( _socket, F_SETFL, fcntl( _socket, F_GETFL, 0 ) | O_NONBLOCK ) )
+    {
+        ::close( _socket );
+        _socket = -1;
+        return false;
+    }
+#   endif
+
+#   ifdef WIN32
+    WSADATA wsaData;
+
+    if ( 0 != WSAStartup( MAKEWORD( 2, 2 ), &wsaData ) ) return false;
+
+    SOCKET sock = socket( AF_INET, SOCK_DGRAM, 0 );
+
+    u_long nonblocking = 1;
+    DWORD ttl_val = (DWORD)ttl;
+
+    if ( sock == INVALID_SOCKET
+      || 0 != setsockopt( sock, IPPROTO_IP, IP_MULTICAST_TTL, (const char*)&ttl_val, sizeof(ttl_val) )
+      || 0 != ioctlsocket( sock, FIONBIO, &nonblocking ) )
+    {
+        if ( sock != INVALID_SOCKET ) closesocket( sock );
+        WSACleanup();
+        return false;
+    }
+
+    _socket = (fdm::UInt64)sock;
+#   endif
+
+    _address = addr;
+    _port = htons( port );
+
+    _frameTime = _sendTime = fdm::Time::get();
+
+    _size   = 0;
+    _frames = 0;
+
+    _open = true;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataOutStream::close()
+{
+    if ( !_open ) return;
+
+    flush();
+
+#   ifdef _LINUX_
+    ::close( _socket );
+    _socket = -1;
+#   endif
+
+#   ifdef WIN32
+    closesocket( (SOCKET)_socket );
+    _socket = (fdm::UInt64)INVALID_SOCKET;
+    WSACleanup();
+#   endif
+
+    _open = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataOutStream::update( const fdm::DataOut &dataOut )
+{
+    if ( !_open ) return;
+
+    double time = fdm::Time::get();
+
+    if ( _frameInterval > 0.0 )
+    {
+        if ( time - _frameTime < _frameInterval ) return;
+
+        // keeping nominal rate unless publisher falls behind
+        _frameTime += _frameInterval;
+        if ( time - _frameTime > _frameInterval ) _frameTime = time;
+    }
+
+    fdm::UInt64 channels[ _maxChannels ];
+
+    const unsigned int count = getChannels( channels, _subsystems, dataOut, time );
+
+    if ( _frames > 0 )
+    {
+        char frame[ _maxFrameSize ];
+
+        unsigned int size = encode( frame, channels, _previous, count );
+
+        if ( _size + size <= _maxDatagramSize )
+        {
+            memcpy( _buffer + _size, frame, size );
+            _size += size;
+        }
+        else
+        {
+            flush();
+        }
+    }
+
+    if ( _frames == 0 )
+    {
+        // first frame in datagram is coded against zero frame
+        memset( _previous, 0, sizeof(_previous) );
+        _size = _headerSize + encode( _buffer + _headerSize, channels, _previous, count );
+    }
+
+    memcpy( _previous, channels, count * sizeof(fdm::UInt64) );
+
+    _frames++;
+    _frame++;
+
+    if ( _sendInterval > 0.0 )
+    {
+        if ( time - _sendTime < _sendInterval ) return;
+
+        _sendTime += _sendInterval;
+        if ( time - _sendTime > _sendInterval ) _sendTime = time;
+    }
+
+    flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataOutStream::flush()
+{
+    if ( !_open || _frames == 0 ) return;
+
+    memcpy( _buffer, _magic, 4 );
+    _buffer[ 4 ] = (char)_version;
+    _buffer[ 5 ] = (char)_subsystems;
+    writeUInt( _buffer +  6, _frames, 2 );
+    writeUInt( _buffer +  8, _sequence, 4 );
+    writeUInt( _buffer + 12, _frame - _frames, 4 );
+
+    struct sockaddr_in dest;
+
+    memset( &dest, 0, sizeof(dest) );
+    dest.sin_family      = AF_INET;
+    dest.sin_addr.s_addr = _address;
+    dest.sin_port        = _port;
+
+#   ifdef _LINUX_
+    ssize_t sent = sendto( _socket, _buffer, _size, 0, (struct sockaddr*)&dest, sizeof(dest) );
+#   endif
+
+#   ifdef WIN32
+    int sent = sendto( (SOCKET)_socket, _buffer, (int)_size, 0, (struct sockaddr*)&dest, sizeof(dest) );
+#   endif
+
+    // sequence number is incremented anyway, so receivers can detect drops
+    if ( sent != (int)_size ) _dropped++;
+
+    _sequence++;
+
+    _size   = 0;
+    _frames = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataOutStream::setRate( double frameRate, double sendRate )
+{
+    _frameInterval = frameRate > 0.0 ? 1.0 / frameRate : 0.0;
+    _sendInterval  = sendRate  > 0.0 ? 1.0 / sendRate  : 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataOutStream::setSubsystems( fdm::UInt8 subsystems )
+{
+    flush();
+    _subsystems = subsystems;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int DataOutStream::encode( char *buffer, const fdm::UInt64 *channels,
+                                    const fdm::UInt64 *previous, unsigned int count )
+{
+    const unsigned int mask_size = ( count + 7 ) / 8;
+
+    char *mask = buffer;
+    memset( mask, 0, mask_size );
+
+    unsigned int size = mask_size;
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        fdm::UInt64 delta = channels[ i ] ^ previous[ i ];
+
+        if ( delta )
+        {
+            // high order bytes of the difference are mostly zero
+            unsigned int bytes = 8;
+            while ( !( delta >> ( 8 * ( bytes - 1 ) ) ) ) bytes--;
+
+            mask[ i / 8 ] |= (char)( 1 << ( i % 8 ) );
+
+            buffer[ size++ ] = (char)bytes;
+            writeUInt( buffer + size, delta, bytes );
+            size += bytes;
+        }
+    }
+
+    return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int DataOutStream::getChannels( fdm::UInt64 *channels, fdm::UInt8 subsystems,
+                                         const fdm::DataOut &dataOut, double time )
+{
+    unsigned int count = 0;
+
+    fdm::UInt64 flags = (fdm::UInt64)( dataOut.stateOut & 0x07 )
+                      | (fdm::UInt64)( dataOut.crash    & 0x03 ) << 3;
+
+    if ( dataOut.flight.onGround ) flags |= 1 << 5;
+    if ( dataOut.flight.stall    ) flags |= 1 << 6;
+
+    for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        if ( dataOut.engine[ i ].state       ) flags |= 1 << ( 8 + 2 * i );
+        if ( dataOut.engine[ i ].afterburner ) flags |= 1 << ( 9 + 2 * i );
+    }
+
+    memcpy( &channels[ count++ ], &time, sizeof(double) );
+    channels[ count++ ] = flags;
+
+    memcpy( &channels[ count ], &dataOut.flight, _flightChannels * sizeof(double) );
+    count += _flightChannels;
+
+    if ( subsystems & Controls )
+    {
+        memcpy( &channels[ count ], &dataOut.controls, sizeof(fdm::DataOut::Controls) );
+        count += sizeof(fdm::DataOut::Controls) / sizeof(double);
+    }
+
+    if ( subsystems & Engines )
+    {
+        for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+        {
+            memcpy( &channels[ count ], &dataOut.engine[ i ].rpm, _engineChannels * sizeof(double) );
+            count += _engineChannels;
+        }
+    }
+
+    if ( subsystems & Environment )
+    {
+        memcpy( &channels[ count ], &dataOut.environment, sizeof(fdm::DataOut::Environment) );
+        count += sizeof(fdm::DataOut::Environment) / sizeof(double);
+    }
+
+    if ( subsystems & Rotor )
+    {
+        memcpy( &channels[ count ], &dataOut.rotor, sizeof(fdm::DataOut::Rotor) );
+        count += sizeof(fdm::DataOut::Rotor) / sizeof(double);
+    }
+
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataOutStream::setChannels( const fdm::UInt64 *channels, fdm::UInt8 subsystems,
+                                 fdm::DataOut *dataOut, double *time )
+{
+    unsigned int count = 0;
+
+    memcpy( time, &channels[ count++ ], sizeof(double) );
+    fdm::UInt64 flags = channels[ count++ ];
+
+    dataOut->stateOut = (fdm::DataOut::StateOut)( flags & 0x07 );
+    dataOut->crash    = (fdm::DataOut::Crash)( ( flags >> 3 ) & 0x03 );
+
+    dataOut->flight.onGround = ( flags >> 5 ) & 1;
+    dataOut->flight.stall    = ( flags >> 6 ) & 1;
+
+    for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        dataOut->engine[ i ].state       = ( flags >> ( 8 + 2 * i ) ) & 1;
+        dataOut->engine[ i ].afterburner = ( flags >> ( 9 + 2 * i ) ) & 1;
+    }
+
+    memcpy( &dataOut->flight, &channels[ count ], _flightChannels * sizeof(double) );
+    count += _flightChannels;
+
+    if ( subsystems & Controls )
+    {
+        memcpy( &dataOut->controls, &channels[ count ], sizeof(fdm::DataOut::Controls) );
+        count += sizeof(fdm::DataOut::Controls) / sizeof(double);
+    }
+
+    if ( subsystems & Engines )
+    {
+        for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+        {
+            memcpy( &dataOut->engine[ i ].rpm, &channels[ count ], _engineChannels * sizeof(double) );
+            count += _engineChannels;
+        }
+    }
+
+    if ( subsystems & Environment )
+    {
+        memcpy( &dataOut->environment, &channels[ count ], sizeof(fdm::DataOut::Environment) );
+        count += sizeof(fdm::DataOut::Environment) / sizeof(double);
+    }
+
+    if ( subsystems & Rotor )
+    {
+        memcpy( &dataOut->rotor, &channels[ count ], sizeof(fdm::DataOut::Rotor) );
+    }
+}
@@ -0,0 +1,232 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef DATAOUTSTREAM_H
+#define DATAOUTSTREAM_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+#include <fdm/fdm_DataOut.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Flight dynamics model output data UDP stream.
+ *
+ * Publisher samples output data at configured frame rate and sends frames
+ * to UDP (multicast) group at configured datagram rate, so when FDM runs
+ * faster than the network rate several frames are batched into a single
+ * datagram. Flight data is always streamed, other subsystems are selected
+ * with subsystems mask.
+ *
+ * Every frame is a set of 64-bit channels. Frames are delta coded: channel
+ * bit patterns are XORed with the previous frame in the datagram, so only
+ * changed channels are sent and high order zero bytes of the difference
+ * are dropped. Encoding is lossless. First frame of each datagram is
+ * coded against zero frame, therefore every datagram can be decoded on
+ * its own and losing a datagram does not affect the following ones.
+ *
+ * Datagram layout (little-endian):
+ * - header: magic "MSDS", version, subsystems mask, frames count,
+ *   datagram sequence number and the first frame number,
+ * - frames: changed channels bit mask followed by, for every changed
+ *   channel, number of bytes and the low order bytes of the difference.
+ *
+ * Sockets are non-blocking, datagrams which cannot be sent immediately are
+ * dropped and counted, so the publisher never blocks the FDM thread.
+ */
+class DataOutStream
+{
+public:
+
+    static const char *_magic;                  ///< datagram magic string (4 characters)
+    static const fdm::UInt8 _version;           ///< datagram layout version
+
+    /** Optional subsystems. */
+    enum Subsystems
+    {
+        Controls    = 0x01,                     ///< controls data
+        Engines     = 0x02,                     ///< engines data
+        Environment = 0x04,                     ///< environment data
+        Rotor       = 0x08                      ///< rotor data
+    };
+
+    static const unsigned int _headerSize = 16; ///< datagram header size
+
+    /** Number of flight data channels (all double members before flags). */
+    static const unsigned int _flightChannels = offsetof(fdm::DataOut::Flight, onGround) / sizeof(double);
+
+    /** Number of engine channels (double members from rpm to fuel flow). */
+    static const unsigned int _engineChannels = ( offsetof(fdm::DataOut::Engine, fuelFlow)
+                                                - offsetof(fdm::DataOut::Engine, rpm) ) / sizeof(double) + 1;
+
+    /** Maximum number of channels (time, flags and all subsystems). */
+    static const unsigned int _maxChannels = 2 + _flightChannels
+            + sizeof(fdm::DataOut::Controls)    / sizeof(double)
+            + sizeof(fdm::DataOut::Environment) / sizeof(double)
+            + sizeof(fdm::DataOut::Rotor)       / sizeof(double)
+            + _engineChannels * FDM_MAX_ENGINES;
+
+    static const unsigned int _maskSize = ( _maxChannels + 7 ) / 8;     ///< maximum changed channels mask size
+    static const unsigned int _maxFrameSize = _maskSize + 9 * _maxChannels;  ///< maximum encoded frame size
+    static const unsigned int _maxDatagramSize = 1472;  ///< maximum datagram size (Ethernet MTU minus IP and UDP headers)
+
+    /** Datagram header. */
+    struct Header
+    {
+        fdm::UInt8  version;                    ///< layout version
+        fdm::UInt8  subsystems;                 ///< subsystems mask
+        fdm::UInt16 frames;                     ///< number of frames
+        fdm::UInt32 sequence;                   ///< datagram sequence number
+        fdm::UInt32 frame;                      ///< first frame number
+    };
+
+    /** Decoded frame. */
+    struct Frame
+    {
+        fdm::UInt32 number;                     ///< frame number
+        double time;                            ///< [s] publisher monotonic clock time of the frame
+        fdm::DataOut dataOut;                   ///< output data, only streamed subsystems are set
+    };
+
+    /**
+     * @brief Decodes datagram.
+     * @param buffer datagram data
+     * @param size datagram size
+     * @param frames decoded frames array
+     * @param max_frames frames array size
+     * @param header decoded header, might be null if not required
+     * @return number of decoded frames or -1 if datagram is malformed
+     */
+    static int decode( const char *buffer, unsigned int size,
+                       Frame *frames, unsigned int max_frames,
+                       Header *header = 0 );
+
+    /** @brief Constructor. */
+    DataOutStream();
+
+    /** @brief Destructor. */
+    virtual ~DataOutStream();
+
+    /**
+     * @brief Opens publisher socket.
+     * @param address destination (multicast group) IPv4 address
+     * @param port destination port
+     * @param ttl multicast time-to-live
+     * @return true on success, false on failure
+     */
+    bool open( const char *address, unsigned short port, int ttl = 1 );
+
+    /** @brief Sends pending frames and closes socket. */
+    void close();
+
+    /**
+     * @brief Samples output data and sends datagram if it is due.
+     * Should be called after every FDM step.
+     * @param dataOut output data
+     */
+    void update( const fdm::DataOut &dataOut );
+
+    /** @brief Sends pending frames. */
+    void flush();
+
+    /**
+     * @brief Sets frame and datagram rates.
+     * @param frameRate [Hz] frames sampling rate, non-positive means every update
+     * @param sendRate [Hz] datagrams rate, non-positive means every frame
+     */
+    void setRate( double frameRate, double sendRate );
+
+    /**
+     * @brief Sets streamed subsystems.
+     * Pending frames are sent before changing subsystems.
+     * @param subsystems subsystems mask
+     */
+    void setSubsystems( fdm::UInt8 subsystems );
+
+    /** @return number of sent datagrams */
+    inline fdm::UInt32 getSequence() const { return _sequence; }
+
+    /** @return number of datagrams dropped because they could not be sent */
+    inline fdm::UInt32 getDropped() const { return _dropped; }
+
+    /** @return true if socket is open */
+    inline bool isOpen() const { return _open; }
+
+private:
+
+#   ifdef WIN32
+    fdm::UInt64 _socket;                        ///< socket handle
+#   else
+    int _socket;                                ///< socket descriptor
+#   endif
+
+    fdm::UInt32 _address;                       ///< destination address (network byte order)
+    fdm::UInt16 _port;                          ///< destination port (network byte order)
+
+    fdm::UInt8 _subsystems;                     ///< subsystems mask
+
+    double _frameInterval;                      ///< [s] frames sampling interval
+    double _sendInterval;                       ///< [s] datagrams interval
+
+    double _frameTime;                          ///< [s] last frame time
+    double _sendTime;                           ///< [s] last datagram time
+
+    fdm::UInt32 _sequence;                      ///< datagram sequence number
+    fdm::UInt32 _frame;                         ///< frame number
+    fdm::UInt32 _dropped;                       ///< number of dropped datagrams
+
+    char _buffer[ _maxDatagramSize ];           ///< datagram buffer
+    unsigned int _size;                         ///< datagram size
+    unsigned int _frames;                       ///< number of frames in datagram
+
+    fdm::UInt64 _previous[ _maxChannels ];      ///< previous frame channels
+
+    bool _open;                                 ///< specifies if socket is open
+
+    /**
+     * @brief Encodes frame as a difference to the previous one.
+     * @return encoded frame size
+     */
+    static unsigned int encode( char *buffer, const fdm::UInt64 *channels,
+                                const fdm::UInt64 *previous, unsigned int count );
+
+    /**
+     * @brief Gets channels from output data.
+     * @return number of channels
+     */
+    static unsigned int getChannels( fdm::UInt64 *channels, fdm::UInt8 subsystems,
+                                     const fdm::DataOut &dataOut, double time );
+
+    /** @brief Sets output data from channels. */
+    static void setChannels( const fdm::UInt64 *channels, fdm::UInt8 subsystems,
+                             fdm::DataOut *dataOut, double *time );
+
+    /** Using this constructor is forbidden. */
+    DataOutStream( const DataOutStream & ) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // DATAOUTSTREAM_H
@@ -0,0 +1,211 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/HeadTracker.h>
+
+#include <cmath>
+#include <cstring>
+
+#include <fdm/utils/fdm_Misc.h>
+#include <fdm/utils/fdm_Time.h>
+#include <fdm/utils/fdm_Units.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Decodes OpenTrack datagram into head pose expressed in BAS. */
+void decode( const char *datagram, HeadTracker::Pose *pose )
+{
+    double values[ 6 ];
+
+    memcpy( values, datagram, sizeof(values) );
+
+    pose->x = -0.01 * values[ 2 ];
+    pose->y =  0.01 * values[ 0 ];
+    pose->z = -0.01 * values[ 1 ];
+
+    pose->psi = fdm::Units::deg2rad( values[ 3 ] );
+    pose->tht = fdm::Units::deg2rad( values[ 4 ] );
+    pose->phi = fdm::Units::deg2rad( values[ 5 ] );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Returns filtered time derivative, angles are differentiated modulo full angle. */
+double getRate( double value, double value_prev, double rate, double dt,
+                double tc, bool angle )
+{
+    double delta = value - value_prev;
+
+    if ( angle ) delta = remainder( delta, 2.0 * M_PI );
+
+    return fdm::Misc::inertia( delta / dt, rate, dt, tc );
+}
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+const double HeadTracker::_rateTimeConst = 0.02;
+
+////////////////////////////////////////////////////////////////////////////////
+
+HeadTracker::HeadTracker() :
+    _lead ( 0.0 ),
+    _horizon ( 0.0 ),
+    _timeout ( 0.0 ),
+    _quit ( false ),
+    _received ( 0 ),
+    _open ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+HeadTracker::~HeadTracker()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool HeadTracker::open( unsigned short port, double lead, double horizon, double timeout )
+{
+    close();
+
+    if ( !_socket.open( port ) ) return false;
+
+    _lead    = lead;
+    _horizon = horizon > 0.0 ? horizon : 0.0;
+    _timeout = timeout;
+
+    _quit = false;
+    _open = true;
+
+    _thread = std::thread( &HeadTracker::work, this );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HeadTracker::close()
+{
+    if ( _open )
+    {
+        _quit = true;
+
+        if ( _thread.joinable() ) _thread.join();
+
+        _socket.close();
+        _open = false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool HeadTracker::getPose( double time, Pose *pose )
+{
+    _samples.fetch();
+
+    const Sample &sample = _samples.getFrontBuffer();
+
+    if ( !sample.valid || time - sample.time > _timeout ) return false;
+
+    // prediction covers sample age and rendering latency
+    double dt = time - sample.time + _lead;
+
+    if ( dt < 0.0      ) dt = 0.0;
+    if ( dt > _horizon ) dt = _horizon;
+
+    pose->x   = sample.pose.x   + dt * sample.rate.x;
+    pose->y   = sample.pose.y   + dt * sample.rate.y;
+    pose->z   = sample.pose.z   + dt * sample.rate.z;
+    pose->phi = sample.pose.phi + dt * sample.rate.phi;
+    pose->tht = sample.pose.tht + dt * sample.rate.tht;
+    pose->psi = sample.pose.psi + dt * sample.rate.psi;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HeadTracker::work()
+{
+    char buffer[ 2 * _datagramSize ];
+
+    Sample sample;
+
+    memset( &sample, 0, sizeof(Sample) );
+
+    while ( !_quit )
+    {
+        if ( !_socket.wait( 0.1 ) ) continue;
+
+        Pose pose;
+
+        bool received = false;
+
+        // only the most recent of queued datagrams matters
+        int size = 0;
+
+        while ( ( size = _socket.receive( buffer, sizeof(buffer) ) ) >= 0 )
+        {
+            if ( size == (int)_datagramSize )
+            {
+                decode( buffer, &pose );
+                received = true;
+            }
+        }
+
+        if ( !received ) continue;
+
+        double time = fdm::Time::get();
+        double dt = time - sample.time;
+
+        if ( sample.valid && dt > 0.0 && dt < _timeout )
+        {
+            const double tc = _rateTimeConst;
+
+            sample.rate.x   = getRate( pose.x   , sample.pose.x   , sample.rate.x   , dt, tc, false );
+            sample.rate.y   = getRate( pose.y   , sample.pose.y   , sample.rate.y   , dt, tc, false );
+            sample.rate.z   = getRate( pose.z   , sample.pose.z   , sample.rate.z   , dt, tc, false );
+            sample.rate.phi = getRate( pose.phi , sample.pose.phi , sample.rate.phi , dt, tc, true  );
+            sample.rate.tht = getRate( pose.tht , sample.pose.tht , sample.rate.tht , dt, tc, true  );
+            sample.rate.psi = getRate( pose.psi , sample.pose.psi , sample.rate.psi , dt, tc, true  );
+        }
+        else
+        {
+            // velocities are not estimated across tracking gaps
+            memset( &sample.rate, 0, sizeof(Pose) );
+        }
+
+        sample.pose  = pose;
+        sample.time  = time;
+        sample.valid = true;
+
+        _samples.publish( sample );
+
+        _received++;
+    }
+}
@@ -0,0 +1,145 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef HEADTRACKER_H
+#define HEADTRACKER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <thread>
+
+#include <sim/Singleton.h>
+#include <sim/TripleBuffer.h>
+#include <sim/UdpSocket.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Head tracking input class.
+ *
+ * Head tracker thread receives head poses sent by OpenTrack ("UDP over
+ * network" output: six doubles, X, Y and Z position [cm] and yaw, pitch and
+ * roll [deg]), timestamps them on arrival and estimates head velocities.
+ * Samples are published through lock-free triple buffer, so the render
+ * thread latches the most recent head pose right before drawing, without
+ * passing through the GUI timer. Pose is extrapolated with estimated
+ * velocities to the expected display time, which compensates tracker
+ * sample age and rendering latency.
+ *
+ * OpenTrack axes are expected to be: X right, Y up, Z backward, yaw positive
+ * right, pitch positive up and roll positive right (axes might be inverted
+ * in OpenTrack output settings).
+ */
+class HeadTracker : public Singleton< HeadTracker >
+{
+    friend class Singleton< HeadTracker >;
+
+public:
+
+    static const unsigned int _datagramSize = 48;   ///< OpenTrack datagram size
+
+    /** Head pose. */
+    struct Pose
+    {
+        double x;               ///< [m] head x-offset expressed in BAS
+        double y;               ///< [m] head y-offset expressed in BAS
+        double z;               ///< [m] head z-offset expressed in BAS
+        double phi;             ///< [rad] head roll angle
+        double tht;             ///< [rad] head pitch angle
+        double psi;             ///< [rad] head yaw angle
+    };
+
+    /** @brief Destructor. */
+    virtual ~HeadTracker();
+
+    /**
+     * @brief Opens socket and starts head tracker thread.
+     * @param port local port
+     * @param lead [s] rendering latency compensated by prediction
+     * @param horizon [s] maximum prediction horizon
+     * @param timeout [s] time without samples after which tracking is lost
+     * @return true on success, false on failure
+     */
+    bool open( unsigned short port, double lead, double horizon, double timeout );
+
+    /** @brief Stops head tracker thread and closes socket. */
+    void close();
+
+    /**
+     * @brief Returns head pose predicted for the given time.
+     * Might be called by the render thread only.
+     * @param time [s] time as returned by fdm::Time::get()
+     * @param pose predicted head pose
+     * @return true if head is tracked, false otherwise
+     */
+    bool getPose( double time, Pose *pose );
+
+    /** @return number of received samples */
+    inline fdm::UInt32 getReceived() const { return _received; }
+
+    /** @return true if head tracker is open */
+    inline bool isOpen() const { return _open; }
+
+private:
+
+    /** Head pose sample. */
+    struct Sample
+    {
+        Pose pose;              ///< head pose
+        Pose rate;              ///< head pose time derivative
+        double time;            ///< [s] sample arrival time
+        bool valid;             ///< specifies if sample is valid
+    };
+
+    static const double _rateTimeConst;     ///< [s] velocities filter time constant
+
+    UdpSocket _socket;                      ///< socket
+
+    TripleBuffer< Sample > _samples;        ///< samples published to the render thread
+
+    double _lead;                           ///< [s] rendering latency compensated by prediction
+    double _horizon;                        ///< [s] maximum prediction horizon
+    double _timeout;                        ///< [s] time without samples after which tracking is lost
+
+    std::thread _thread;                    ///< head tracker thread
+
+    std::atomic< bool > _quit;              ///< specifies if head tracker thread should quit
+    std::atomic< fdm::UInt32 > _received;   ///< number of received samples
+
+    bool _open;                             ///< specifies if head tracker is open
+
+    /**
+     * You should use static function instance() due to get refernce
+     * to HeadTracker class instance.
+     */
+    HeadTracker();
+
+    /** Using this constructor is forbidden. */
+    HeadTracker( const HeadTracker & ) {}
+
+    /** Head tracker thread loop. */
+    void work();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // HEADTRACKER_H
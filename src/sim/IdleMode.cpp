@@ -0,0 +1,92 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/IdleMode.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+std::atomic< bool > active( false );    ///< specifies if idle mode is active
+
+std::mutex mutex;                       ///< waiting threads mutex
+std::condition_variable leave;          ///< idle mode leave condition
+
+} // end of anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool IdleMode::isActive()
+{
+    return active.load( std::memory_order_relaxed );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IdleMode::update( fdm::DataInp::StateInp stateInp,
+                       fdm::DataOut::StateOut stateOut )
+{
+    bool idle = ( stateInp == fdm::DataInp::Idle  && stateOut == fdm::DataOut::Idle   )
+             || ( stateInp == fdm::DataInp::Pause && stateOut == fdm::DataOut::Paused );
+
+    if ( active.exchange( idle ) && !idle )
+    {
+        // locking before notifying, so waiting thread cannot miss the change
+        std::lock_guard< std::mutex > lock( mutex );
+        leave.notify_all();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IdleMode::updateTimer( QObject *object, int *timerId, bool *idle,
+                            double timeStep, double timeStepIdle )
+{
+    bool idle_new = isActive();
+
+    if ( (*idle) != idle_new )
+    {
+        if ( (*timerId) ) object->killTimer( *timerId );
+
+        (*timerId) = object->startTimer( 1000.0 * ( idle_new ? timeStepIdle : timeStep ) );
+        (*idle) = idle_new;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool IdleMode::wait( double timeout )
+{
+    if ( !isActive() ) return false;
+
+    std::unique_lock< std::mutex > lock( mutex );
+    leave.wait_for( lock, std::chrono::duration< double >( timeout ),
+                    [](){ return !active.load(); } );
+
+    return true;
+}
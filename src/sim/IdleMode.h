@@ -0,0 +1,81 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef IDLEMODE_H
+#define IDLEMODE_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <QObject>
+
+#include <fdm/fdm_DataInp.h>
+#include <fdm/fdm_DataOut.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Low-power idle mode class.
+ *
+ * Idle mode is active while simulation is idle or paused and no input state
+ * change is requested. Loops which would otherwise spin at full rate then
+ * slow down: simulation thread blocks until input state changes (or until
+ * the given timeout elapses, so devices are still polled), GUI, CGI and
+ * sound timers tick with idle period and frozen views are drawn only when
+ * changed. Mode is updated by the thread publishing simulation input data,
+ * other methods might be called from any thread.
+ */
+class IdleMode
+{
+public:
+
+    /** @return true if idle mode is active */
+    static bool isActive();
+
+    /**
+     * @brief Updates idle mode, wakes up waiting threads when mode is left.
+     * @param stateInp simulation input state
+     * @param stateOut simulation output state
+     */
+    static void update( fdm::DataInp::StateInp stateInp,
+                        fdm::DataOut::StateOut stateOut );
+
+    /**
+     * @brief Restarts object's timer if its period has to change with mode.
+     * @param object timer owner
+     * @param timerId timer ID, updated when timer is restarted
+     * @param idle specifies if timer ticks with idle period, updated when timer is restarted
+     * @param timeStep [s] nominal timer period
+     * @param timeStepIdle [s] idle timer period
+     */
+    static void updateTimer( QObject *object, int *timerId, bool *idle,
+                             double timeStep, double timeStepIdle );
+
+    /**
+     * @brief Blocks calling thread while idle mode is active.
+     * @param timeout [s] maximum waiting time
+     * @return true if thread has been blocked, false if mode is not active
+     */
+    static bool wait( double timeout );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // IDLEMODE_H
@@ -0,0 +1,226 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#include <sim/MetricsExporter.h>
+
+#include <chrono>
+#include <cstdio>
+
+#include <fdm/utils/fdm_Time.h>
+
+#ifdef _LINUX_
+#   include <unistd.h>
+#endif
+
+#ifdef WIN32
+#   include <winsock2.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+MetricsExporter::MetricsExporter() :
+    _address ( 0 ),
+    _port ( 0 ),
+    _interval ( 1.0 ),
+    _quit ( false ),
+    _sent ( 0 ),
+    _open ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MetricsExporter::~MetricsExporter()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool MetricsExporter::open( const char *address, unsigned short port,
+                            double interval, const char *prefix )
+{
+    close();
+
+    if ( !UdpSocket::resolve( address, &_address ) || !_socket.open() )
+    {
+        return false;
+    }
+
+    _port = port;
+    _interval = interval > 0.0 ? interval : 1.0;
+
+    _prefix = prefix;
+
+    char host[ 256 ] = { '\0' };
+
+    if ( 0 == gethostname( host, sizeof(host) - 1 ) && host[ 0 ] != '\0' )
+    {
+        // dots would split host name into StatsD name levels
+        for ( char *c = host; *c != '\0'; c++ )
+        {
+            if ( *c == '.' || *c == ':' || *c == '|' ) *c = '_';
+        }
+
+        if ( !_prefix.empty() ) _prefix += ".";
+        _prefix += host;
+    }
+
+    _datagram.reserve( _maxDatagramSize );
+
+    _quit = false;
+    _open = true;
+
+    fdm::Metrics::setEnabled( true );
+
+    _thread = std::thread( &MetricsExporter::work, this );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsExporter::close()
+{
+    if ( _open )
+    {
+        _quit = true;
+
+        if ( _thread.joinable() ) _thread.join();
+
+        fdm::Metrics::setEnabled( false );
+
+        _socket.close();
+        _open = false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsExporter::work()
+{
+    double time_0 = fdm::Time::get();
+
+    while ( !_quit )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+        double time = fdm::Time::get();
+
+        if ( time - time_0 >= _interval )
+        {
+            time_0 = time;
+            publish();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsExporter::publish()
+{
+    fdm::UInt64 dropped = fdm::Metrics::snapshot( &_values );
+
+    _datagram.clear();
+
+    for ( fdm::Metrics::Values::const_iterator it = _values.begin(); it != _values.end(); ++it )
+    {
+        switch ( (*it).type )
+        {
+        case fdm::Metrics::Gauge:
+            addLine( (*it).name, "", (*it).value, "g" );
+            break;
+
+        case fdm::Metrics::Counter:
+            addLine( (*it).name, "", (*it).value, "c" );
+            break;
+
+        case fdm::Metrics::Timer:
+            // percentiles of the interval without samples are not sent
+            if ( (*it).value > 0.0 )
+            {
+                addLine( (*it).name, ".p50"  , 1000.0 * (*it).p50  , "g" );
+                addLine( (*it).name, ".p99"  , 1000.0 * (*it).p99  , "g" );
+                addLine( (*it).name, ".p999" , 1000.0 * (*it).p999 , "g" );
+                addLine( (*it).name, ".max"  , 1000.0 * (*it).max  , "g" );
+            }
+            addLine( (*it).name, ".count", (*it).value, "c" );
+            break;
+        }
+    }
+
+    addLine( "metrics.dropped", "", (double)dropped, "c" );
+
+    fdm::MemoryStats::snapshot( &_memory );
+
+    for ( fdm::MemoryStats::Values::const_iterator it = _memory.begin(); it != _memory.end(); ++it )
+    {
+        _name = "memory.";
+        _name += (*it).name;
+
+        addLine( _name.c_str(), ""      , (double)(*it).bytes , "g" );
+        addLine( _name.c_str(), ".peak" , (double)(*it).peak  , "g" );
+
+        if ( (*it).budget > 0 )
+        {
+            addLine( _name.c_str(), ".budget", (double)(*it).budget, "g" );
+        }
+    }
+
+    flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsExporter::addLine( const char *name, const char *suffix, double value, const char *type )
+{
+    char line[ 256 ] = { '\0' };
+
+    int size = snprintf( line, sizeof(line), "%s%s%s%s:%.6g|%s\n",
+                         _prefix.c_str(), _prefix.empty() ? "" : ".",
+                         name, suffix, value, type );
+
+    if ( size <= 0 || size >= (int)sizeof(line) )
+    {
+        return;
+    }
+
+    if ( _datagram.size() + size > _maxDatagramSize )
+    {
+        flush();
+    }
+
+    _datagram += line;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsExporter::flush()
+{
+    if ( !_datagram.empty() )
+    {
+        if ( _socket.send( _datagram.c_str(), _datagram.size(), _address, _port ) )
+        {
+            _sent++;
+        }
+
+        _datagram.clear();
+    }
+}
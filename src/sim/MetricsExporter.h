@@ -0,0 +1,136 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <fdm/utils/fdm_MemoryStats.h>
+#include <fdm/utils/fdm_Metrics.h>
+
+#include <sim/UdpSocket.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Live metrics StatsD exporter.
+ *
+ * Exporter thread takes fdm::Metrics snapshot at the given interval and sends
+ * it as StatsD lines over UDP, so hot threads only record values lock-free
+ * and all formatting and I/O is done by the exporter. Metrics names are
+ * prefixed with the given prefix and the host name, so metrics of many
+ * stations can be aggregated by a single StatsD server:
+ * - gauges are sent as "<prefix>.<host>.<name>:<value>|g",
+ * - counters increments as "<prefix>.<host>.<name>:<value>|c",
+ * - timers as gauges of percentiles and maximum [ms] named with ".p50",
+ *   ".p99", ".p999" and ".max" suffixes and as samples count counter
+ *   named with ".count" suffix.
+ *
+ * Number of timer samples dropped because of full buffers is sent as
+ * "metrics.dropped" counter.
+ *
+ * Memory subsystems accounted bytes [B] are sent as "memory.<subsystem>"
+ * gauges, along with peaks and budgets (if set) with ".peak" and ".budget"
+ * suffixes.
+ *
+ * @see fdm::MemoryStats
+ * @see fdm::Metrics
+ */
+class MetricsExporter
+{
+public:
+
+    static const unsigned int _maxDatagramSize = 1432;  ///< maximum datagram size (fits Ethernet MTU with IP and UDP headers and IP options)
+
+    /** @brief Constructor. */
+    MetricsExporter();
+
+    /** @brief Destructor. */
+    virtual ~MetricsExporter();
+
+    /**
+     * @brief Opens socket, enables metrics collection and starts exporter thread.
+     * @param address StatsD server IPv4 address
+     * @param port StatsD server port
+     * @param interval [s] export interval
+     * @param prefix metrics names prefix
+     * @return true on success, false on failure
+     */
+    bool open( const char *address, unsigned short port,
+               double interval, const char *prefix );
+
+    /** @brief Stops exporter thread, disables metrics collection and closes socket. */
+    void close();
+
+    /** @return number of sent datagrams */
+    inline fdm::UInt32 getSent() const { return _sent; }
+
+    /** @return true if exporter is open */
+    inline bool isOpen() const { return _open; }
+
+private:
+
+    UdpSocket _socket;                  ///< socket
+
+    fdm::UInt32 _address;               ///< StatsD server address
+    unsigned short _port;               ///< StatsD server port
+
+    double _interval;                   ///< [s] export interval
+
+    std::string _prefix;                ///< metrics names prefix (including host name)
+    std::string _datagram;              ///< datagram being composed
+
+    fdm::Metrics::Values _values;       ///< metrics snapshot
+    fdm::MemoryStats::Values _memory;   ///< memory subsystems snapshot
+
+    std::string _name;                  ///< memory subsystem metric name being composed
+
+    std::thread _thread;                ///< exporter thread
+
+    std::atomic< bool > _quit;          ///< specifies if exporter thread should quit
+    std::atomic< fdm::UInt32 > _sent;   ///< number of sent datagrams
+
+    bool _open;                         ///< specifies if exporter is open
+
+    /** Using this constructor is forbidden. */
+    MetricsExporter( const MetricsExporter & ) {}
+
+    /** Exporter thread loop. */
+    void work();
+
+    /** Takes metrics snapshot and sends it. */
+    void publish();
+
+    /** Appends line to the datagram, sends datagram if line does not fit. */
+    void addLine( const char *name, const char *suffix, double value, const char *type );
+
+    /** Sends datagram. */
+    void flush();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // METRICSEXPORTER_H
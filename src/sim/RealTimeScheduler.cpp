@@ -0,0 +1,265 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/RealTimeScheduler.h>
+
+#ifdef _LINUX_
+#   include <errno.h>
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef WIN32
+#   ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#       define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#   endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+RealTimeScheduler::RealTimeScheduler( double period, int priority, int cpu ) :
+    _period ( period ),
+    _priority ( priority ),
+    _cpu ( cpu ),
+
+    _overruns ( 0 ),
+
+    _started ( false )
+{
+#   ifdef _LINUX_
+    _deadline.tv_sec  = 0;
+    _deadline.tv_nsec = 0;
+    _period_ns = (long long)( 1.0e9 * _period + 0.5 );
+#   endif
+
+#   ifdef WIN32
+    _timer = NULL;
+    _frequency.QuadPart = 0;
+    _deadline = 0;
+    _period_ticks = 0;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RealTimeScheduler::~RealTimeScheduler()
+{
+#   ifdef WIN32
+    if ( _timer ) CloseHandle( _timer );
+    if ( _started ) timeEndPeriod( 1 );
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RealTimeScheduler::start()
+{
+    if ( _period <= 0.0 ) return false;
+
+#   ifdef _LINUX_
+    if ( 0 != clock_gettime( CLOCK_MONOTONIC, &_deadline ) )
+    {
+        return false;
+    }
+
+    setupThread();
+
+    _started = true;
+#   endif
+
+#   ifdef WIN32
+    if ( !QueryPerformanceFrequency( &_frequency ) )
+    {
+        return false;
+    }
+
+    _period_ticks = (LONGLONG)( _period * _frequency.QuadPart + 0.5 );
+
+    _timer = CreateWaitableTimerExW( NULL, NULL,
+                                     CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+                                     TIMER_ALL_ACCESS );
+
+    // high resolution timers are available since Windows 10 1803
+    if ( !_timer )
+    {
+        _timer = CreateWaitableTimerExW( NULL, NULL, 0, TIMER_ALL_ACCESS );
+    }
+
+    if ( !_timer )
+    {
+        return false;
+    }
+
+    timeBeginPeriod( 1 );
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter( &now );
+    _deadline = now.QuadPart;
+
+    setupThread();
+
+    _started = true;
+#   endif
+
+    return _started;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RealTimeScheduler::resync()
+{
+    if ( !_started ) return;
+
+#   ifdef _LINUX_
+    clock_gettime( CLOCK_MONOTONIC, &_deadline );
+#   endif
+
+#   ifdef WIN32
+    LARGE_INTEGER now;
+    QueryPerformanceCounter( &now );
+    _deadline = now.QuadPart;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double RealTimeScheduler::wait()
+{
+    if ( !_started ) return 0.0;
+
+    long long periods = 1;
+
+#   ifdef _LINUX_
+    const long long ns_per_s = 1000000000LL;
+
+    long long deadline_ns = _deadline.tv_sec * ns_per_s + _deadline.tv_nsec;
+    deadline_ns += _period_ns;
+
+    timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    long long now_ns = now.tv_sec * ns_per_s + now.tv_nsec;
+
+    if ( now_ns - deadline_ns >= _period_ns )
+    {
+        // missed whole period(s), shifting schedule instead of catching up
+        long long missed = ( now_ns - deadline_ns ) / _period_ns;
+        deadline_ns += missed * _period_ns;
+        periods += missed;
+        _overruns++;
+    }
+
+    _deadline.tv_sec  = deadline_ns / ns_per_s;
+    _deadline.tv_nsec = deadline_ns % ns_per_s;
+
+    while ( EINTR == clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &_deadline, NULL ) ) {}
+#   endif
+
+#   ifdef WIN32
+    _deadline += _period_ticks;
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter( &now );
+
+    if ( now.QuadPart - _deadline >= _period_ticks )
+    {
+        // missed whole period(s), shifting schedule instead of catching up
+        LONGLONG missed = ( now.QuadPart - _deadline ) / _period_ticks;
+        _deadline += missed * _period_ticks;
+        periods += missed;
+        _overruns++;
+    }
+
+    if ( _deadline > now.QuadPart )
+    {
+        // waitable timers take absolute time in system time units, so
+        // remaining time to the deadline is given as a relative (negative)
+        // due time in 100 ns intervals
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -( ( _deadline - now.QuadPart ) * 10000000LL ) / _frequency.QuadPart;
+
+        if ( SetWaitableTimer( _timer, &dueTime, 0, NULL, NULL, FALSE ) )
+        {
+            WaitForSingleObject( _timer, INFINITE );
+        }
+    }
+#   endif
+
+    return periods * _period;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RealTimeScheduler::setupThread()
+{
+#   ifdef _LINUX_
+    if ( _priority > 0 )
+    {
+        sched_param param;
+        param.sched_priority = _priority;
+
+        int result = pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+
+        if ( result != 0 )
+        {
+            Log::w() << "Setting SCHED_FIFO priority " << _priority
+                     << " failed with error " << result << "." << std::endl;
+        }
+    }
+
+    if ( _cpu >= 0 )
+    {
+        cpu_set_t cpuset;
+        CPU_ZERO( &cpuset );
+        CPU_SET( _cpu, &cpuset );
+
+        int result = pthread_setaffinity_np( pthread_self(), sizeof(cpu_set_t), &cpuset );
+
+        if ( result != 0 )
+        {
+            Log::w() << "Pinning thread to CPU " << _cpu
+                     << " failed with error " << result << "." << std::endl;
+        }
+    }
+#   endif
+
+#   ifdef WIN32
+    if ( _priority > 0 )
+    {
+        if ( !SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL ) )
+        {
+            Log::w() << "Setting time critical thread priority failed." << std::endl;
+        }
+    }
+
+    if ( _cpu >= 0 )
+    {
+        if ( 0 == SetThreadAffinityMask( GetCurrentThread(), (DWORD_PTR)1 << _cpu ) )
+        {
+            Log::w() << "Pinning thread to CPU " << _cpu << " failed." << std::endl;
+        }
+    }
+#   endif
+}
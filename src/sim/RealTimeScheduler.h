@@ -0,0 +1,120 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef REALTIMESCHEDULER_H
+#define REALTIMESCHEDULER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef _LINUX_
+#   include <time.h>
+#endif
+
+#ifdef WIN32
+#   include <windows.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Absolute deadline periodic scheduler.
+ *
+ * Calling thread is put to sleep until the next absolute deadline, which is
+ * advanced by exactly one period each cycle, so wake-up error does not
+ * accumulate. On Linux clock_nanosleep() with TIMER_ABSTIME on monotonic clock
+ * is used, on Windows high resolution waitable timer. Calling thread might be
+ * optionally given SCHED_FIFO (time critical) priority and pinned to a single
+ * CPU. Methods might be called only from the scheduled thread.
+ */
+class RealTimeScheduler
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param period [s] scheduling period
+     * @param priority real-time priority, 0 leaves thread priority unchanged
+     * @param cpu CPU index the thread is pinned to, negative means no pinning
+     */
+    RealTimeScheduler( double period, int priority = 0, int cpu = -1 );
+
+    /** @brief Destructor. */
+    virtual ~RealTimeScheduler();
+
+    /**
+     * @brief Sets up calling thread and starts scheduling.
+     * Failing to set priority or affinity is reported but is not an error.
+     * @return true on success, false if scheduling is not available
+     */
+    bool start();
+
+    /**
+     * @brief Restarts schedule from the current time, so time the thread has
+     * spent outside of wait() is not counted as overrun.
+     */
+    void resync();
+
+    /**
+     * @brief Sleeps until the next deadline.
+     * If deadline has been already missed by a whole period or more schedule
+     * is shifted instead of issuing burst of late cycles.
+     * @return [s] time elapsed between previous and current deadlines
+     */
+    double wait();
+
+    /** @return number of deadlines missed by a whole period or more */
+    inline unsigned int getOverruns() const { return _overruns; }
+
+    /** @return [s] scheduling period */
+    inline double getPeriod() const { return _period; }
+
+private:
+
+    const double _period;           ///< [s] scheduling period
+    const int _priority;            ///< real-time priority
+    const int _cpu;                 ///< CPU index
+
+    unsigned int _overruns;         ///< number of overruns
+
+#   ifdef _LINUX_
+    timespec _deadline;             ///< next deadline
+    long long _period_ns;           ///< [ns] scheduling period
+#   endif
+
+#   ifdef WIN32
+    HANDLE _timer;                  ///< waitable timer handle
+    LARGE_INTEGER _frequency;       ///< performance counter frequency
+    LONGLONG _deadline;             ///< next deadline (performance counter)
+    LONGLONG _period_ticks;         ///< scheduling period (performance counter)
+#   endif
+
+    bool _started;                  ///< specifies if scheduling has started
+
+    /** Sets real-time priority and CPU affinity of the calling thread. */
+    void setupThread();
+
+    /** Using this constructor is forbidden. */
+    RealTimeScheduler( const RealTimeScheduler & ) : _period( 0.0 ), _priority( 0 ), _cpu( -1 ) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // REALTIMESCHEDULER_H
@@ -0,0 +1,200 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/RemoteClient.h>
+
+#include <cstring>
+
+#include <fdm/utils/fdm_Time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+RemoteClient::RemoteClient() :
+    _address ( 0 ),
+    _port ( 0 ),
+    _redundancy ( 1 ),
+    _timeout ( 1.0 ),
+    _clientId ( 0 ),
+    _sequence ( 0 ),
+    _outputSequence ( 0 ),
+    _entitiesSequence ( 0 ),
+    _outputReceived ( false ),
+    _entitiesReceived ( false ),
+    _receiveTime ( 0.0 ),
+    _roundTrip ( 0.0 ),
+    _roundTripMean ( 0.0 ),
+    _roundTripMax ( 0.0 ),
+    _lost ( 0 ),
+    _entitiesCount ( 0 )
+{
+    memset( _entities, 0, sizeof(_entities) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RemoteClient::~RemoteClient()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteClient::open( const char *address, unsigned short port,
+                         unsigned int redundancy, double timeout )
+{
+    close();
+
+    if ( !UdpSocket::resolve( address, &_address ) ) return false;
+
+    _port = port;
+
+    _redundancy = redundancy > 0 ? redundancy : 1;
+    _timeout = timeout;
+
+    _clientId = 0;
+    _outputReceived = false;
+    _entitiesReceived = false;
+    _entitiesCount = 0;
+
+    return _socket.open();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteClient::close()
+{
+    _socket.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteClient::send( const fdm::DataInp &dataInp )
+{
+    RemoteProtocol::Header header;
+
+    header.type     = RemoteProtocol::Input;
+    header.sequence = ++_sequence;
+    header.clientId = _clientId;
+    header.sendTime = fdm::Time::get();
+    header.echoTime = 0.0;
+    header.holdTime = 0.0;
+
+    char buffer[ RemoteProtocol::_maxDatagramSize ];
+
+    unsigned int size = RemoteProtocol::encodeInput( buffer, header, dataInp );
+
+    if ( size > 0 )
+    {
+        for ( unsigned int i = 0; i < _redundancy; i++ )
+        {
+            _socket.send( buffer, size, _address, _port );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteClient::receive( fdm::DataOut *dataOut )
+{
+    bool updated = false;
+
+    char buffer[ RemoteProtocol::_maxDatagramSize ];
+
+    fdm::UInt32 address = 0;
+    unsigned short port = 0;
+
+    int size = 0;
+
+    while ( ( size = _socket.receive( buffer, sizeof(buffer), &address, &port ) ) >= 0 )
+    {
+        RemoteProtocol::Header header;
+
+        if ( address != _address || port != _port ) continue;
+        if ( !RemoteProtocol::decodeHeader( buffer, size, &header ) ) continue;
+
+        double time = fdm::Time::get();
+
+        if ( header.type == RemoteProtocol::Output )
+        {
+            if ( _outputReceived && !RemoteProtocol::isNewer( header.sequence, _outputSequence ) ) continue;
+            if ( !RemoteProtocol::decodeOutput( buffer, size, dataOut ) ) continue;
+
+            if ( _outputReceived ) _lost += header.sequence - _outputSequence - 1;
+
+            _outputSequence = header.sequence;
+            _outputReceived = true;
+            _receiveTime = time;
+            _clientId = header.clientId;
+
+            updateRoundTrip( header, time );
+
+            updated = true;
+        }
+        else if ( header.type == RemoteProtocol::Entities )
+        {
+            if ( _entitiesReceived && !RemoteProtocol::isNewer( header.sequence, _entitiesSequence ) ) continue;
+
+            int count = RemoteProtocol::decodeEntities( buffer, size, _entities );
+
+            if ( count < 0 )
+            {
+                _entitiesCount = 0;
+                continue;
+            }
+
+            _entitiesCount = count;
+            _entitiesSequence = header.sequence;
+            _entitiesReceived = true;
+        }
+    }
+
+    if ( !isConnected() ) _entitiesCount = 0;
+
+    return updated;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteClient::isConnected() const
+{
+    return _outputReceived && fdm::Time::get() - _receiveTime < _timeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteClient::updateRoundTrip( const RemoteProtocol::Header &header, double time )
+{
+    if ( header.echoTime > 0.0 )
+    {
+        _roundTrip = time - header.echoTime - header.holdTime;
+
+        if ( _roundTrip < 0.0 ) _roundTrip = 0.0;
+
+        // smoothing factor as in TCP round trip time estimator (RFC 6298)
+        if ( _roundTripMean > 0.0 )
+            _roundTripMean += 0.125 * ( _roundTrip - _roundTripMean );
+        else
+            _roundTripMean = _roundTrip;
+
+        if ( _roundTrip > _roundTripMax ) _roundTripMax = _roundTrip;
+    }
+}
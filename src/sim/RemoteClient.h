@@ -0,0 +1,136 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef REMOTECLIENT_H
+#define REMOTECLIENT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <sim/RemoteProtocol.h>
+#include <sim/UdpSocket.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Remote flight dynamics model client.
+ *
+ * Network adapter used by thin-client cockpits instead of the local FDM.
+ * Input data is sent to the FDM server every step and output data of the
+ * client aircraft is received back. Server is considered connected as long
+ * as output data keeps arriving within the timeout.
+ *
+ * @see RemoteProtocol
+ */
+class RemoteClient
+{
+public:
+
+    /** @brief Constructor. */
+    RemoteClient();
+
+    /** @brief Destructor. */
+    virtual ~RemoteClient();
+
+    /**
+     * @brief Opens client socket.
+     * @param address server IPv4 address
+     * @param port server port
+     * @param redundancy number of copies of every datagram sent
+     * @param timeout [s] time without output data after which server is considered disconnected
+     * @return true on success, false on failure
+     */
+    bool open( const char *address, unsigned short port,
+               unsigned int redundancy = 2, double timeout = 1.0 );
+
+    /** @brief Closes client socket. */
+    void close();
+
+    /**
+     * @brief Sends input data to the server.
+     * @param dataInp input data
+     */
+    void send( const fdm::DataInp &dataInp );
+
+    /**
+     * @brief Receives all pending datagrams.
+     * @param dataOut most recent output data, unchanged if no new data has been received
+     * @return true if new output data has been received, false otherwise
+     */
+    bool receive( fdm::DataOut *dataOut );
+
+    /** @return true if server is connected, false otherwise */
+    bool isConnected() const;
+
+    inline const RemoteProtocol::Entity* getEntities() const { return _entities; }
+    inline unsigned int getEntitiesCount() const { return _entitiesCount; }
+
+    /** @return client id assigned by server, 0 if not connected yet */
+    inline fdm::UInt32 getClientId() const { return _clientId; }
+
+    /** @return [s] the most recent round trip time */
+    inline double getRoundTrip() const { return _roundTrip; }
+
+    /** @return [s] smoothed round trip time */
+    inline double getRoundTripMean() const { return _roundTripMean; }
+
+    /** @return [s] maximum round trip time */
+    inline double getRoundTripMax() const { return _roundTripMax; }
+
+    /** @return number of output datagrams lost (all copies) */
+    inline unsigned int getLost() const { return _lost; }
+
+private:
+
+    UdpSocket _socket;              ///< client socket
+
+    fdm::UInt32 _address;           ///< server address
+    unsigned short _port;           ///< server port
+
+    unsigned int _redundancy;       ///< number of copies of every datagram sent
+    double _timeout;                ///< [s] connection timeout
+
+    fdm::UInt32 _clientId;          ///< client id assigned by server
+    fdm::UInt32 _sequence;          ///< input datagrams sequence number
+
+    fdm::UInt32 _outputSequence;    ///< the most recent output datagram sequence number
+    fdm::UInt32 _entitiesSequence;  ///< the most recent entities datagram sequence number
+
+    bool _outputReceived;           ///< specifies if any output datagram has been received
+    bool _entitiesReceived;         ///< specifies if any entities datagram has been received
+
+    double _receiveTime;            ///< [s] the most recent output datagram receive time
+
+    double _roundTrip;              ///< [s] the most recent round trip time
+    double _roundTripMean;          ///< [s] smoothed round trip time
+    double _roundTripMax;           ///< [s] maximum round trip time
+
+    unsigned int _lost;             ///< number of lost output datagrams
+
+    RemoteProtocol::Entity _entities[ RemoteProtocol::_maxEntities ];   ///< the other aircraft
+    unsigned int _entitiesCount;    ///< number of the other aircraft
+
+    /** Updates round trip time statistics. */
+    void updateRoundTrip( const RemoteProtocol::Header &header, double time );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // REMOTECLIENT_H
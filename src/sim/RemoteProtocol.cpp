@@ -0,0 +1,300 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/RemoteProtocol.h>
+
+#include <cstddef>
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char *RemoteProtocol::_magic = "MSRF";
+const fdm::UInt8 RemoteProtocol::_version = 2;
+
+////////////////////////////////////////////////////////////////////////////////
+
+// wind field file and recording data refer to files on the server host, so
+// they are not sent at all and server keeps its own values, the structure is
+// split into three raw parts around them
+static const size_t windFieldOffset = offsetof(fdm::DataInp, environment)
+                                    + offsetof(fdm::DataInp::Environment, windField);
+static const size_t windFieldSize = sizeof(((fdm::DataInp::Environment*)0)->windField);
+
+static const size_t recordingOffset = offsetof(fdm::DataInp, recording);
+static const size_t recordingSize = sizeof(fdm::DataInp::Recording);
+
+static const size_t inputParts[ 3 ][ 2 ] =
+{
+    { 0,                               windFieldOffset                        },
+    { windFieldOffset + windFieldSize, recordingOffset - windFieldOffset - windFieldSize },
+    { recordingOffset + recordingSize, sizeof(fdm::DataInp) - recordingOffset - recordingSize }
+};
+
+static const size_t inputSize = inputParts[ 0 ][ 1 ] + inputParts[ 1 ][ 1 ] + inputParts[ 2 ][ 1 ];
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void writeUInt( char *buffer, fdm::UInt64 value, unsigned int bytes )
+{
+    for ( unsigned int i = 0; i < bytes; i++ )
+    {
+        buffer[ i ] = (char)( ( value >> ( 8 * i ) ) & 0xff );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static fdm::UInt64 readUInt( const char *buffer, unsigned int bytes )
+{
+    fdm::UInt64 value = 0;
+
+    for ( unsigned int i = 0; i < bytes; i++ )
+    {
+        value |= (fdm::UInt64)( (fdm::UInt8)buffer[ i ] ) << ( 8 * i );
+    }
+
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void writeDouble( char *buffer, double value )
+{
+    fdm::UInt64 bits = 0;
+    memcpy( &bits, &value, sizeof(double) );
+    writeUInt( buffer, bits, 8 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static double readDouble( const char *buffer )
+{
+    fdm::UInt64 bits = readUInt( buffer, 8 );
+    double value = 0.0;
+    memcpy( &value, &bits, sizeof(double) );
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool isBool( const char *data, size_t offset )
+{
+    return (fdm::UInt8)data[ offset ] <= 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template < typename TYPE >
+static int readEnum( const char *data, size_t offset )
+{
+    static_assert( sizeof(TYPE) == sizeof(int), "Enumeration has to be of int size." );
+
+    int value = 0;
+    memcpy( &value, data + offset, sizeof(int) );
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// raw input data are checked before they are interpreted, as loading bool
+// of value other than 0 or 1, or enumeration out of its range, is undefined
+static bool isValidInput( const char *data )
+{
+    typedef fdm::DataInp Inp;
+
+    int aircraftType = readEnum< Inp::AircraftType >( data, offsetof(Inp, aircraftType) );
+    int stateInp     = readEnum< Inp::StateInp     >( data, offsetof(Inp, stateInp) );
+
+    int turbulence = readEnum< Inp::Environment::Turbulence >( data, offsetof(Inp, environment)
+                                                                   + offsetof(Inp::Environment, turbulence) );
+    int windShear  = readEnum< Inp::Environment::WindShear  >( data, offsetof(Inp, environment)
+                                                                   + offsetof(Inp::Environment, windShear) );
+
+    if ( ( aircraftType < Inp::AW101 || aircraftType > Inp::UH60 )
+#       ifdef FDM_TEST
+      && aircraftType != Inp::XF && aircraftType != Inp::XH
+#       endif
+       )
+    {
+        return false;
+    }
+
+    if ( stateInp   < Inp::Idle                        || stateInp   > Inp::Stop                        ) return false;
+    if ( turbulence < Inp::Environment::TurbulenceNone || turbulence > Inp::Environment::TurbulenceExtreme ) return false;
+    if ( windShear  < Inp::Environment::WindShearNone  || windShear  > Inp::Environment::WindShearModel4  ) return false;
+
+    bool valid = isBool( data, offsetof(Inp, initial) + offsetof(Inp::Initial, engineOn) )
+              && isBool( data, offsetof(Inp, environment) + offsetof(Inp::Environment, atmosphereTable) )
+              && isBool( data, offsetof(Inp, controls) + offsetof(Inp::Controls, lgh) )
+              && isBool( data, offsetof(Inp, controls) + offsetof(Inp::Controls, nws) )
+              && isBool( data, offsetof(Inp, controls) + offsetof(Inp::Controls, abs) )
+              && isBool( data, offsetof(Inp, freezePosition) )
+              && isBool( data, offsetof(Inp, freezeAttitude) )
+              && isBool( data, offsetof(Inp, freezeVelocity) );
+
+    for ( unsigned int i = 0; i < FDM_MAX_ENGINES && valid; i++ )
+    {
+        size_t offset = offsetof(Inp, engine) + i * sizeof(Inp::Engine);
+
+        valid = isBool( data, offset + offsetof(Inp::Engine, fuel) )
+             && isBool( data, offset + offsetof(Inp::Engine, ignition) )
+             && isBool( data, offset + offsetof(Inp::Engine, starter) );
+    }
+
+    return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteProtocol::decodeHeader( const char *buffer, unsigned int size, Header *header )
+{
+    if ( size < _headerSize || 0 != memcmp( buffer, _magic, 4 ) ) return false;
+
+    if ( (fdm::UInt8)buffer[ 4 ] != _version ) return false;
+
+    header->type     = (fdm::UInt8)buffer[ 5 ];
+    header->sequence = (fdm::UInt32)readUInt( buffer +  8, 4 );
+    header->clientId = (fdm::UInt32)readUInt( buffer + 12, 4 );
+    header->sendTime = readDouble( buffer + 16 );
+    header->echoTime = readDouble( buffer + 24 );
+    header->holdTime = readDouble( buffer + 32 );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int RemoteProtocol::encodeInput( char *buffer, const Header &header,
+                                          const fdm::DataInp &dataInp )
+{
+    if ( _headerSize + inputSize > _maxDatagramSize ) return 0;
+
+    encodeHeader( buffer, header );
+
+    unsigned int pos = _headerSize;
+
+    const char *data = (const char*)&dataInp;
+
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        memcpy( buffer + pos, data + inputParts[ i ][ 0 ], inputParts[ i ][ 1 ] );
+        pos += (unsigned int)inputParts[ i ][ 1 ];
+    }
+
+    return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteProtocol::decodeInput( const char *buffer, unsigned int size,
+                                  fdm::DataInp *dataInp )
+{
+    if ( size != _headerSize + inputSize ) return false;
+
+    // decoded into copy first, so fields not sent keep their values and
+    // invalid datagram leaves input data untouched
+    char data[ sizeof(fdm::DataInp) ];
+    memcpy( data, dataInp, sizeof(fdm::DataInp) );
+
+    unsigned int pos = _headerSize;
+
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        memcpy( data + inputParts[ i ][ 0 ], buffer + pos, inputParts[ i ][ 1 ] );
+        pos += (unsigned int)inputParts[ i ][ 1 ];
+    }
+
+    if ( !isValidInput( data ) ) return false;
+
+    memcpy( dataInp, data, sizeof(fdm::DataInp) );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int RemoteProtocol::encodeOutput( char *buffer, const Header &header,
+                                           const fdm::DataOut &dataOut )
+{
+    encodeHeader( buffer, header );
+    memcpy( buffer + _headerSize, &dataOut, sizeof(fdm::DataOut) );
+
+    return _headerSize + sizeof(fdm::DataOut);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteProtocol::decodeOutput( const char *buffer, unsigned int size,
+                                   fdm::DataOut *dataOut )
+{
+    if ( size != _headerSize + sizeof(fdm::DataOut) ) return false;
+
+    memcpy( dataOut, buffer + _headerSize, sizeof(fdm::DataOut) );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned int RemoteProtocol::encodeEntities( char *buffer, const Header &header,
+                                             const Entity *entities, unsigned int count )
+{
+    if ( count > _maxEntities ) count = _maxEntities;
+
+    encodeHeader( buffer, header );
+    buffer[ _headerSize ] = (char)count;
+
+    memcpy( buffer + _headerSize + 1, entities, count * sizeof(Entity) );
+
+    return _headerSize + 1 + count * sizeof(Entity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int RemoteProtocol::decodeEntities( const char *buffer, unsigned int size,
+                                    Entity *entities )
+{
+    if ( size < _headerSize + 1 ) return -1;
+
+    unsigned int count = (fdm::UInt8)buffer[ _headerSize ];
+
+    if ( count > _maxEntities || size != _headerSize + 1 + count * sizeof(Entity) ) return -1;
+
+    memcpy( entities, buffer + _headerSize + 1, count * sizeof(Entity) );
+
+    return (int)count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteProtocol::encodeHeader( char *buffer, const Header &header )
+{
+    memcpy( buffer, _magic, 4 );
+    buffer[ 4 ] = (char)_version;
+    buffer[ 5 ] = (char)header.type;
+    writeUInt( buffer +  6, 0, 2 );
+    writeUInt( buffer +  8, header.sequence, 4 );
+    writeUInt( buffer + 12, header.clientId, 4 );
+    writeDouble( buffer + 16, header.sendTime );
+    writeDouble( buffer + 24, header.echoTime );
+    writeDouble( buffer + 32, header.holdTime );
+}
@@ -0,0 +1,193 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef REMOTEPROTOCOL_H
+#define REMOTEPROTOCOL_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_DataInp.h>
+#include <fdm/fdm_DataOut.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Remote flight dynamics model protocol.
+ *
+ * Cockpit clients send input data to the FDM server, which sends back output
+ * data of the client aircraft and, at lower rate, positions of all the other
+ * aircraft. Every datagram holds complete state, so there are no
+ * retransmissions: lost datagram is superseded by the next one. Redundancy is
+ * achieved by sending every datagram several times, receivers drop
+ * duplicated and out of order datagrams by sequence number.
+ *
+ * Round trip time is measured NTP-like: output datagram echoes the send time
+ * of the most recent input datagram and the time it has been held by the
+ * server, so only sender's own clock is used.
+ *
+ * Header layout (little-endian): magic "MSRF", version, type, reserved
+ * 2 bytes, sequence number, client id, send time, echoed time and hold time.
+ * Payloads are raw structures (like shared memory segment), so both ends
+ * have to be built from the same sources for the same ABI. Input data wind
+ * field file and recording data are not sent, as they refer to files on the
+ * server host, server keeps its own values. Input data enumerations and
+ * booleans are validated before they are decoded.
+ */
+class RemoteProtocol
+{
+public:
+
+    static const char *_magic;                  ///< datagram magic string (4 characters)
+    static const fdm::UInt8 _version;           ///< datagram layout version
+
+    static const unsigned int _headerSize = 40;         ///< datagram header size
+    static const unsigned int _maxDatagramSize = 1472;  ///< maximum datagram size (Ethernet MTU minus IP and UDP headers)
+    static const unsigned int _maxEntities = 16;        ///< maximum number of entities in a single datagram
+
+    /** Datagram types. */
+    enum Type
+    {
+        Input    = 1,                           ///< client input data
+        Output   = 2,                           ///< server output data of the client aircraft
+        Entities = 3                            ///< server positions of the other aircraft
+    };
+
+    /** Datagram header. */
+    struct Header
+    {
+        fdm::UInt8  type;                       ///< datagram type
+        fdm::UInt32 sequence;                   ///< datagram sequence number (per type)
+        fdm::UInt32 clientId;                   ///< client id assigned by server (0 in input datagrams)
+        double sendTime;                        ///< [s] sender monotonic clock time
+        double echoTime;                        ///< [s] send time of the most recent datagram received from the peer
+        double holdTime;                        ///< [s] time elapsed since the most recent datagram has been received
+    };
+
+    /** Other aircraft position and attitude. */
+    struct Entity
+    {
+        fdm::UInt32 id;                         ///< client id
+
+        double pos_x_wgs;                       ///< [m] x coordinate expressed in WGS
+        double pos_y_wgs;                       ///< [m] y coordinate expressed in WGS
+        double pos_z_wgs;                       ///< [m] z coordinate expressed in WGS
+
+        double att_e0_wgs;                      ///< [-] attitude quaternion e0 component
+        double att_ex_wgs;                      ///< [-] attitude quaternion ex component
+        double att_ey_wgs;                      ///< [-] attitude quaternion ey component
+        double att_ez_wgs;                      ///< [-] attitude quaternion ez component
+    };
+
+    /**
+     * @brief Checks if sequence number is newer than the previous one.
+     * Serial number arithmetic is used, so wrapping around is handled.
+     * @param sequence sequence number
+     * @param previous previous sequence number
+     * @return true if sequence number is newer, false otherwise
+     */
+    inline static bool isNewer( fdm::UInt32 sequence, fdm::UInt32 previous )
+    {
+        fdm::UInt32 difference = sequence - previous;
+        return difference != 0 && difference < 0x80000000U;
+    }
+
+    /**
+     * @brief Decodes datagram header.
+     * @param buffer datagram data
+     * @param size datagram size
+     * @param header decoded header
+     * @return true on success, false if datagram is malformed
+     */
+    static bool decodeHeader( const char *buffer, unsigned int size, Header *header );
+
+    /**
+     * @brief Encodes input datagram.
+     * @param buffer datagram buffer (at least _maxDatagramSize bytes)
+     * @param header datagram header
+     * @param dataInp input data
+     * @return datagram size or 0 if data does not fit into datagram
+     */
+    static unsigned int encodeInput( char *buffer, const Header &header,
+                                     const fdm::DataInp &dataInp );
+
+    /**
+     * @brief Decodes input datagram payload.
+     * Wind field file and recording data are left unchanged, as well as
+     * the whole input data if datagram is malformed.
+     * @param buffer datagram data
+     * @param size datagram size
+     * @param dataInp decoded input data
+     * @return true on success, false if datagram is malformed or data are invalid
+     */
+    static bool decodeInput( const char *buffer, unsigned int size,
+                             fdm::DataInp *dataInp );
+
+    /**
+     * @brief Encodes output datagram.
+     * @param buffer datagram buffer (at least _maxDatagramSize bytes)
+     * @param header datagram header
+     * @param dataOut output data
+     * @return datagram size
+     */
+    static unsigned int encodeOutput( char *buffer, const Header &header,
+                                      const fdm::DataOut &dataOut );
+
+    /**
+     * @brief Decodes output datagram payload.
+     * @param buffer datagram data
+     * @param size datagram size
+     * @param dataOut decoded output data
+     * @return true on success, false if datagram is malformed
+     */
+    static bool decodeOutput( const char *buffer, unsigned int size,
+                              fdm::DataOut *dataOut );
+
+    /**
+     * @brief Encodes entities datagram.
+     * @param buffer datagram buffer (at least _maxDatagramSize bytes)
+     * @param header datagram header
+     * @param entities entities array
+     * @param count number of entities, at most _maxEntities are encoded
+     * @return datagram size
+     */
+    static unsigned int encodeEntities( char *buffer, const Header &header,
+                                        const Entity *entities, unsigned int count );
+
+    /**
+     * @brief Decodes entities datagram payload.
+     * @param buffer datagram data
+     * @param size datagram size
+     * @param entities decoded entities array (at least _maxEntities items)
+     * @return number of entities or -1 if datagram is malformed
+     */
+    static int decodeEntities( const char *buffer, unsigned int size,
+                               Entity *entities );
+
+private:
+
+    /** Writes datagram header. */
+    static void encodeHeader( char *buffer, const Header &header );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // REMOTEPROTOCOL_H
@@ -0,0 +1,290 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/RemoteServer.h>
+
+#include <cstring>
+
+#include <fdm/utils/fdm_Time.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+RemoteServer::RemoteServer( unsigned int maxClients, unsigned int threads,
+                            unsigned int redundancy, double timeout,
+                            unsigned int entitiesInterval ) :
+    _fleet ( FDM_NULLPTR ),
+    _allowedNetwork ( 0x7f000000 ),
+    _allowedNetmask ( 0xff000000 ),
+    _maxClients ( maxClients ),
+    _redundancy ( redundancy > 0 ? redundancy : 1 ),
+    _timeout ( timeout ),
+    _entitiesInterval ( entitiesInterval > 0 ? entitiesInterval : 1 ),
+    _entitiesCounter ( 0 ),
+    _entitiesSequence ( 0 ),
+    _nextId ( 1 )
+{
+    if ( _maxClients > RemoteProtocol::_maxEntities ) _maxClients = RemoteProtocol::_maxEntities;
+
+    _fleet = new fdm::Fleet( threads );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RemoteServer::~RemoteServer()
+{
+    close();
+    FDM_DELPTR( _fleet );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteServer::open( fdm::UInt32 address, unsigned short port )
+{
+    return _socket.open( port, address );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteServer::setAllowedNetwork( fdm::UInt32 network, fdm::UInt32 netmask )
+{
+    _allowedNetwork = network & netmask;
+    _allowedNetmask = netmask;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteServer::close()
+{
+    _socket.close();
+
+    for ( unsigned int i = 0; i < _clients.size(); i++ )
+    {
+        _fleet->removeMember( _clients[ i ].id );
+    }
+
+    _clients.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteServer::step( double timeStep )
+{
+    receive();
+    removeTimedOut();
+
+    _fleet->step( timeStep );
+
+    send();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteServer::receive()
+{
+    char buffer[ RemoteProtocol::_maxDatagramSize ];
+
+    fdm::UInt32 address = 0;
+    unsigned short port = 0;
+
+    int size = 0;
+
+    while ( ( size = _socket.receive( buffer, sizeof(buffer), &address, &port ) ) >= 0 )
+    {
+        // datagrams from outside of the allowed network are dropped before
+        // they could add a client
+        if ( ( address & _allowedNetmask ) != _allowedNetwork ) continue;
+
+        RemoteProtocol::Header header;
+
+        if ( !RemoteProtocol::decodeHeader( buffer, size, &header ) ) continue;
+        if ( header.type != RemoteProtocol::Input ) continue;
+
+        int index = getClient( address, port );
+
+        if ( index < 0 ) continue;
+
+        Client &client = _clients[ index ];
+
+        // first datagram of the new client is always accepted
+        if ( client.receiveTime > 0.0 && !RemoteProtocol::isNewer( header.sequence, client.inputSequence ) ) continue;
+
+        fdm::Fleet::Member &member = _fleet->getMember( _fleet->getIndex( client.id ) );
+
+        // wind field file and recording data are not decoded, so they keep
+        // server values and client cannot access files on the server host
+        if ( !RemoteProtocol::decodeInput( buffer, size, &member.dataInp ) ) continue;
+
+        client.inputSequence = header.sequence;
+        client.sendTime      = header.sendTime;
+        client.receiveTime   = fdm::Time::get();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteServer::send()
+{
+    char buffer[ RemoteProtocol::_maxDatagramSize ];
+
+    double time = fdm::Time::get();
+
+    for ( unsigned int i = 0; i < _clients.size(); i++ )
+    {
+        Client &client = _clients[ i ];
+
+        const fdm::Fleet::Member &member = _fleet->getMember( _fleet->getIndex( client.id ) );
+
+        RemoteProtocol::Header header;
+
+        header.type     = RemoteProtocol::Output;
+        header.sequence = ++client.outputSequence;
+        header.clientId = client.id;
+        header.sendTime = time;
+        header.echoTime = client.sendTime;
+        header.holdTime = time - client.receiveTime;
+
+        unsigned int size = RemoteProtocol::encodeOutput( buffer, header, member.dataOut );
+
+        sendTo( client, buffer, size );
+    }
+
+    if ( ++_entitiesCounter < _entitiesInterval ) return;
+
+    _entitiesCounter = 0;
+
+    RemoteProtocol::Entity entities[ RemoteProtocol::_maxEntities ];
+    unsigned int count = 0;
+
+    for ( unsigned int i = 0; i < _clients.size() && count < RemoteProtocol::_maxEntities; i++ )
+    {
+        const fdm::Fleet::Member &member = _fleet->getMember( _fleet->getIndex( _clients[ i ].id ) );
+
+        if ( member.dataOut.stateOut != fdm::DataOut::Working
+          && member.dataOut.stateOut != fdm::DataOut::Paused )
+        {
+            continue;
+        }
+
+        RemoteProtocol::Entity &entity = entities[ count++ ];
+
+        entity.id = member.id;
+
+        entity.pos_x_wgs = member.dataOut.flight.pos_x_wgs;
+        entity.pos_y_wgs = member.dataOut.flight.pos_y_wgs;
+        entity.pos_z_wgs = member.dataOut.flight.pos_z_wgs;
+
+        entity.att_e0_wgs = member.dataOut.flight.att_e0_wgs;
+        entity.att_ex_wgs = member.dataOut.flight.att_ex_wgs;
+        entity.att_ey_wgs = member.dataOut.flight.att_ey_wgs;
+        entity.att_ez_wgs = member.dataOut.flight.att_ez_wgs;
+    }
+
+    RemoteProtocol::Header header;
+
+    header.type     = RemoteProtocol::Entities;
+    header.sequence = ++_entitiesSequence;
+    header.clientId = 0;
+    header.sendTime = time;
+    header.echoTime = 0.0;
+    header.holdTime = 0.0;
+
+    // the same list is sent to all clients, every client skips itself
+    unsigned int size = RemoteProtocol::encodeEntities( buffer, header, entities, count );
+
+    for ( unsigned int i = 0; i < _clients.size(); i++ )
+    {
+        sendTo( _clients[ i ], buffer, size );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteServer::removeTimedOut()
+{
+    double time = fdm::Time::get();
+
+    std::vector< Client >::iterator it = _clients.begin();
+
+    while ( it != _clients.end() )
+    {
+        if ( time - it->receiveTime > _timeout )
+        {
+            Log::i() << "Remote client " << it->id << " timed out." << std::endl;
+
+            _fleet->removeMember( it->id );
+            it = _clients.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int RemoteServer::getClient( fdm::UInt32 address, unsigned short port )
+{
+    for ( unsigned int i = 0; i < _clients.size(); i++ )
+    {
+        if ( _clients[ i ].address == address && _clients[ i ].port == port )
+        {
+            return i;
+        }
+    }
+
+    if ( _clients.size() >= _maxClients ) return -1;
+
+    Client client;
+
+    client.id             = _nextId++;
+    client.address        = address;
+    client.port           = port;
+    client.inputSequence  = 0;
+    client.outputSequence = 0;
+    client.sendTime       = 0.0;
+    client.receiveTime    = 0.0;
+
+    if ( FDM_SUCCESS != _fleet->addMember( client.id ) ) return -1;
+
+    _clients.push_back( client );
+
+    Log::i() << "Remote client " << client.id << " connected from "
+             << ( ( address >> 24 ) & 0xff ) << "."
+             << ( ( address >> 16 ) & 0xff ) << "."
+             << ( ( address >>  8 ) & 0xff ) << "."
+             << ( ( address       ) & 0xff ) << ":" << port << "." << std::endl;
+
+    return _clients.size() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteServer::sendTo( const Client &client, const char *buffer, unsigned int size )
+{
+    for ( unsigned int i = 0; i < _redundancy; i++ )
+    {
+        _socket.send( buffer, size, client.address, client.port );
+    }
+}
@@ -0,0 +1,154 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef REMOTESERVER_H
+#define REMOTESERVER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <fdm/fdm_Fleet.h>
+
+#include <sim/RemoteProtocol.h>
+#include <sim/UdpSocket.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Remote flight dynamics model server.
+ *
+ * Server simulates aircraft of several cockpit clients on a single host.
+ * Every client (identified by its address and port) gets its own fleet
+ * member when its first input datagram arrives, and loses it when no input
+ * has been received within the timeout. Members are stepped concurrently,
+ * all with the same time step, so time coefficient is not supported.
+ *
+ * Server socket is bound to the given local address and datagrams are
+ * accepted only from the allowed network, by default only from the local
+ * host (see setAllowedNetwork()).
+ *
+ * @see RemoteProtocol
+ */
+class RemoteServer
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param maxClients maximum number of clients (at most RemoteProtocol::_maxEntities)
+     * @param threads total number of stepping threads, 0 means number of hardware threads
+     * @param redundancy number of copies of every datagram sent
+     * @param timeout [s] time without input data after which client is removed
+     * @param entitiesInterval number of steps between entities datagrams
+     */
+    RemoteServer( unsigned int maxClients, unsigned int threads = 0,
+                  unsigned int redundancy = 2, double timeout = 1.0,
+                  unsigned int entitiesInterval = 5 );
+
+    /** @brief Destructor. */
+    virtual ~RemoteServer();
+
+    /**
+     * @brief Opens server socket.
+     * @param address local interface address
+     * @param port local port
+     * @return true on success, false on failure
+     */
+    bool open( fdm::UInt32 address, unsigned short port );
+
+    /**
+     * @brief Sets network clients are accepted from.
+     * @param network network address
+     * @param netmask network mask
+     */
+    void setAllowedNetwork( fdm::UInt32 network, fdm::UInt32 netmask );
+
+    /** @brief Closes server socket. */
+    void close();
+
+    /**
+     * @brief Receives input data, steps all clients aircraft and sends output data.
+     * @param timeStep [s] simulation time step
+     */
+    void step( double timeStep );
+
+    inline unsigned int getClientsCount() const { return _clients.size(); }
+
+    inline unsigned int getThreads() const { return _fleet->getThreads(); }
+
+private:
+
+    /** Connected client. */
+    struct Client
+    {
+        fdm::UInt32 id;                 ///< client id (fleet member id)
+        fdm::UInt32 address;            ///< client address
+        unsigned short port;            ///< client port
+
+        fdm::UInt32 inputSequence;      ///< the most recent input datagram sequence number
+        fdm::UInt32 outputSequence;     ///< output datagrams sequence number
+
+        double sendTime;                ///< [s] client send time of the most recent input datagram
+        double receiveTime;             ///< [s] receive time of the most recent input datagram
+    };
+
+    UdpSocket _socket;                  ///< server socket
+
+    fdm::Fleet *_fleet;                 ///< clients aircraft
+
+    std::vector< Client > _clients;     ///< connected clients
+
+    fdm::UInt32 _allowedNetwork;        ///< network clients are accepted from
+    fdm::UInt32 _allowedNetmask;        ///< allowed network mask
+
+    unsigned int _maxClients;           ///< maximum number of clients
+    unsigned int _redundancy;           ///< number of copies of every datagram sent
+    double _timeout;                    ///< [s] client timeout
+
+    unsigned int _entitiesInterval;     ///< number of steps between entities datagrams
+    unsigned int _entitiesCounter;      ///< number of steps since the last entities datagram
+    fdm::UInt32 _entitiesSequence;      ///< entities datagrams sequence number
+
+    fdm::UInt32 _nextId;                ///< next client id
+
+    /** Receives all pending input datagrams. */
+    void receive();
+
+    /** Sends output datagrams (and entities datagrams when due) to all clients. */
+    void send();
+
+    /** Removes clients which have not sent input data within the timeout. */
+    void removeTimedOut();
+
+    /**
+     * @brief Returns client of the given address and port, adds new one if there is no such client.
+     * @return client index or -1 if there is no such client and no more clients are allowed
+     */
+    int getClient( fdm::UInt32 address, unsigned short port );
+
+    /** Sends datagram to client (all copies). */
+    void sendTo( const Client &client, const char *buffer, unsigned int size );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // REMOTESERVER_H
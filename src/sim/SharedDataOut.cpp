@@ -0,0 +1,242 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/SharedDataOut.h>
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _LINUX_
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include <fdm/utils/fdm_Time.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char *SharedDataOut::_magic = "MSCSIMDO";
+const fdm::UInt32 SharedDataOut::_version = 2;
+
+const unsigned int SharedDataOut::_maxRetries = 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedDataOut::SharedDataOut() :
+    _segment ( 0 ),
+    _owner ( false )
+{
+#   ifdef _LINUX_
+    _name[ 0 ] = '\0';
+#   endif
+
+#   ifdef WIN32
+    _mapping = NULL;
+#   endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+SharedDataOut::~SharedDataOut()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedDataOut::create( const char *name )
+{
+    close();
+
+#   ifdef _LINUX_
+    // POSIX shared memory object names start with slash
+    snprintf( _name, sizeof(_name), "/%s", name );
+
+    int fd = shm_open( _name, O_CREAT | O_RDWR, 0644 );
+
+    if ( fd < 0 ) return false;
+
+    if ( 0 == ftruncate( fd, sizeof(Segment) ) )
+    {
+        void *data = mmap( 0, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+
+        if ( data != MAP_FAILED ) _segment = (Segment*)data;
+    }
+
+    ::close( fd );
+
+    if ( !_segment ) shm_unlink( _name );
+#   endif
+
+#   ifdef WIN32
+    _mapping = CreateFileMappingA( INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                   0, sizeof(Segment), name );
+
+    if ( _mapping )
+    {
+        _segment = (Segment*)MapViewOfFile( _mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Segment) );
+    }
+#   endif
+
+    if ( !_segment )
+    {
+        close();
+        return false;
+    }
+
+    _owner = true;
+
+    memset( (void*)&_segment->data, 0, sizeof(fdm::DataOut) );
+
+    _segment->header.version  = _version;
+    _segment->header.dataSize = sizeof(fdm::DataOut);
+    _segment->header.frame    = 0;
+    _segment->header.time     = 0.0;
+    _segment->header.sequence.store( 0, std::memory_order_relaxed );
+
+    // magic is written last, so readers never see partially initialized header
+    std::atomic_thread_fence( std::memory_order_release );
+    memcpy( _segment->header.magic, _magic, 8 );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedDataOut::open( const char *name )
+{
+    close();
+
+#   ifdef _LINUX_
+    snprintf( _name, sizeof(_name), "/%s", name );
+
+    int fd = shm_open( _name, O_RDONLY, 0 );
+
+    if ( fd < 0 ) return false;
+
+    struct stat st;
+
+    if ( 0 == fstat( fd, &st ) && st.st_size >= (off_t)sizeof(Segment) )
+    {
+        void *data = mmap( 0, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0 );
+
+        if ( data != MAP_FAILED ) _segment = (Segment*)data;
+    }
+
+    ::close( fd );
+#   endif
+
+#   ifdef WIN32
+    _mapping = OpenFileMappingA( FILE_MAP_READ, FALSE, name );
+
+    if ( _mapping )
+    {
+        _segment = (Segment*)MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, sizeof(Segment) );
+    }
+#   endif
+
+    if ( !_segment ) return false;
+
+    const Header &header = _segment->header;
+
+    if ( 0 != memcmp( header.magic, _magic, 8 )
+      || header.version  != _version
+      || header.dataSize != sizeof(fdm::DataOut) )
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedDataOut::close()
+{
+#   ifdef _LINUX_
+    if ( _segment ) munmap( (void*)_segment, sizeof(Segment) );
+    if ( _owner ) shm_unlink( _name );
+#   endif
+
+#   ifdef WIN32
+    if ( _segment ) UnmapViewOfFile( (void*)_segment );
+    if ( _mapping ) CloseHandle( _mapping );
+    _mapping = NULL;
+#   endif
+
+    _segment = 0;
+    _owner = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SharedDataOut::publish( const fdm::DataOut &dataOut )
+{
+    if ( !_segment || !_owner ) return;
+
+    Header &header = _segment->header;
+
+    fdm::UInt64 sequence = header.sequence.load( std::memory_order_relaxed );
+
+    header.sequence.store( sequence + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    memcpy( (void*)&_segment->data, &dataOut, sizeof(fdm::DataOut) );
+
+    header.frame++;
+    header.time = fdm::Time::get();
+
+    header.sequence.store( sequence + 2, std::memory_order_release );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool SharedDataOut::read( fdm::DataOut *dataOut, fdm::UInt64 *frame ) const
+{
+    if ( !_segment ) return false;
+
+    const Header &header = _segment->header;
+
+    for ( unsigned int i = 0; i < _maxRetries; i++ )
+    {
+        fdm::UInt64 sequence_0 = header.sequence.load( std::memory_order_acquire );
+
+        // frame is being written
+        if ( sequence_0 & 1 ) continue;
+
+        memcpy( dataOut, (const void*)&_segment->data, sizeof(fdm::DataOut) );
+        fdm::UInt64 frame_0 = header.frame;
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+
+        if ( sequence_0 == header.sequence.load( std::memory_order_relaxed ) )
+        {
+            if ( frame ) *frame = frame_0;
+            return true;
+        }
+    }
+
+    return false;
+}
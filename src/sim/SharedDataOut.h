@@ -0,0 +1,140 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef SHAREDDATAOUT_H
+#define SHAREDDATAOUT_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+
+#ifdef WIN32
+#   include <windows.h>
+#endif
+
+#include <fdm/fdm_DataOut.h>
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Flight dynamics model output data shared memory segment.
+ *
+ * Publisher creates named shared memory segment and writes every FDM frame
+ * into it, external processes on the same machine map it read-only. Frames
+ * are guarded by a sequence lock: sequence number is odd while frame is
+ * being written, so reader copies the frame and retries if the sequence
+ * number has changed meanwhile. Neither side ever blocks the other and the
+ * publisher is not affected by the number of readers.
+ *
+ * Segment starts with a header holding magic string, layout version and
+ * data size, so readers built against different fdm::DataOut layout refuse
+ * to open it. Segment has to be opened by reader after it has been created.
+ */
+class SharedDataOut
+{
+public:
+
+    static const char *_magic;              ///< segment magic string (8 characters)
+    static const fdm::UInt32 _version;      ///< segment layout version
+
+    /** Segment header. */
+    struct Header
+    {
+        char magic[ 8 ];                    ///< magic string
+        fdm::UInt32 version;                ///< layout version
+        fdm::UInt32 dataSize;               ///< size of the data
+        std::atomic< fdm::UInt64 > sequence;    ///< sequence lock counter, odd while writing
+        fdm::UInt64 frame;                  ///< frame number
+        double time;                        ///< [s] publisher monotonic clock time of the frame
+    };
+
+    /** Segment layout. */
+    struct Segment
+    {
+        Header header;                      ///< header
+        fdm::DataOut data;                  ///< output data
+    };
+
+    /** @brief Constructor. */
+    SharedDataOut();
+
+    /** @brief Destructor. */
+    virtual ~SharedDataOut();
+
+    /**
+     * @brief Creates segment for publishing.
+     * @param name segment name
+     * @return true on success, false on failure
+     */
+    bool create( const char *name );
+
+    /**
+     * @brief Opens existing segment for reading.
+     * @param name segment name
+     * @return true on success, false on failure or if segment layout differs
+     */
+    bool open( const char *name );
+
+    /** @brief Closes segment, segment created by publisher is removed. */
+    void close();
+
+    /**
+     * @brief Publishes frame.
+     * Might be called only by the publisher.
+     * @param dataOut output data
+     */
+    void publish( const fdm::DataOut &dataOut );
+
+    /**
+     * @brief Reads the most recent frame.
+     * @param dataOut output data
+     * @param frame frame number, might be null if not required
+     * @return true on success, false if consistent frame could not be read
+     */
+    bool read( fdm::DataOut *dataOut, fdm::UInt64 *frame = 0 ) const;
+
+    /** @return true if segment is open */
+    inline bool isOpen() const { return _segment != 0; }
+
+private:
+
+    static const unsigned int _maxRetries;  ///< maximum number of read retries
+
+    Segment *_segment;                      ///< mapped segment
+
+    bool _owner;                            ///< specifies if segment has been created by this object
+
+#   ifdef _LINUX_
+    char _name[ 256 ];                      ///< segment name
+#   endif
+
+#   ifdef WIN32
+    HANDLE _mapping;                        ///< file mapping handle
+#   endif
+
+    /** Using this constructor is forbidden. */
+    SharedDataOut( const SharedDataOut & ) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // SHAREDDATAOUT_H
@@ -0,0 +1,287 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/TaskGraph.h>
+
+#include <fdm/utils/fdm_Time.h>
+
+#include <sim/Log.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+TaskGraph::TaskGraph( unsigned int threads ) :
+    _threads ( threads ),
+    _left ( 0 ),
+    _started ( false ),
+    _quit ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TaskGraph::~TaskGraph()
+{
+    {
+        std::unique_lock< std::mutex > lock( _mutex );
+
+        _quit = true;
+        _cv.notify_all();
+    }
+
+    for ( unsigned int i = 0; i < _workers.size(); i++ )
+    {
+        _workers[ i ].join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int TaskGraph::add( const char *name, const Function &function,
+                    const std::vector< int > &deps, bool mainThread )
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    int id = (int)_tasks.size();
+
+    Task task;
+
+    task.name       = name;
+    task.function   = function;
+    task.pending    = 0;
+    task.time_beg   = 0.0;
+    task.time_end   = 0.0;
+    task.mainThread = mainThread;
+    task.done       = false;
+
+    for ( unsigned int i = 0; i < deps.size(); i++ )
+    {
+        // dependencies are always added earlier, so graph has no cycles
+        if ( deps[ i ] >= 0 && deps[ i ] < id )
+        {
+            _tasks[ deps[ i ] ].next.push_back( id );
+            task.pending++;
+        }
+    }
+
+    _tasks.push_back( task );
+    _left++;
+
+    return id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TaskGraph::start()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    if ( _started ) return;
+
+    _started = true;
+
+    for ( unsigned int i = 0; i < _tasks.size(); i++ )
+    {
+        if ( _tasks[ i ].pending == 0 )
+        {
+            if ( _tasks[ i ].mainThread )
+                _readyMain.push_back( i );
+            else
+                _ready.push_back( i );
+        }
+    }
+
+    // without workers all tasks run in the owner thread
+    if ( _threads == 0 )
+    {
+        for ( unsigned int i = 0; i < _tasks.size(); i++ ) _tasks[ i ].mainThread = true;
+
+        _readyMain.insert( _readyMain.end(), _ready.begin(), _ready.end() );
+        _ready.clear();
+    }
+
+    for ( unsigned int i = 0; i < _threads; i++ )
+    {
+        _workers.push_back( std::thread( &TaskGraph::work, this ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TaskGraph::poll()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    while ( !_readyMain.empty() )
+    {
+        int id = _readyMain.front();
+        _readyMain.pop_front();
+
+        execute( id, lock );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TaskGraph::wait( int id )
+{
+    start();
+
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    while ( !_tasks[ id ].done )
+    {
+        if ( !_readyMain.empty() )
+        {
+            int next = _readyMain.front();
+            _readyMain.pop_front();
+
+            execute( next, lock );
+        }
+        else
+        {
+            _cv.wait( lock );
+        }
+    }
+
+    if ( _tasks[ id ].exception )
+    {
+        std::rethrow_exception( _tasks[ id ].exception );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TaskGraph::waitAll()
+{
+    for ( unsigned int i = 0; i < _tasks.size(); i++ )
+    {
+        wait( i );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TaskGraph::isDone( int id )
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    return _tasks[ id ].done;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TaskGraph::report( double start )
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    for ( unsigned int i = 0; i < _tasks.size(); i++ )
+    {
+        const Task &task = _tasks[ i ];
+
+        if ( task.done )
+        {
+            Log::i() << "Task \"" << task.name << "\""
+                     << " started: " << task.time_beg - start << " s,"
+                     << " duration: " << task.time_end - task.time_beg << " s"
+                     << ( task.exception ? " (failed)" : "" ) << std::endl;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TaskGraph::execute( int id, std::unique_lock< std::mutex > &lock )
+{
+    Task &task = _tasks[ id ];
+
+    task.time_beg = fdm::Time::get();
+
+    // task depending on failed one is not executed, it fails as well
+    if ( !task.exception )
+    {
+        Function function = task.function;
+        std::exception_ptr exception;
+
+        lock.unlock();
+
+        try
+        {
+            function();
+        }
+        catch ( ... )
+        {
+            exception = std::current_exception();
+        }
+
+        lock.lock();
+
+        _tasks[ id ].exception = exception;
+    }
+
+    // tasks vector is not resized after start, so reference is still valid
+    task.time_end = fdm::Time::get();
+    task.done = true;
+
+    for ( unsigned int i = 0; i < task.next.size(); i++ )
+    {
+        Task &next = _tasks[ task.next[ i ] ];
+
+        if ( task.exception && !next.exception ) next.exception = task.exception;
+
+        if ( --next.pending == 0 )
+        {
+            if ( next.mainThread )
+                _readyMain.push_back( task.next[ i ] );
+            else
+                _ready.push_back( task.next[ i ] );
+        }
+    }
+
+    _left--;
+
+    _cv.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TaskGraph::work()
+{
+    std::unique_lock< std::mutex > lock( _mutex );
+
+    while ( !_quit )
+    {
+        if ( !_ready.empty() )
+        {
+            int id = _ready.front();
+            _ready.pop_front();
+
+            execute( id, lock );
+        }
+        else if ( _left == 0 )
+        {
+            break;
+        }
+        else
+        {
+            _cv.wait( lock );
+        }
+    }
+}
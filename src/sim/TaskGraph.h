@@ -0,0 +1,159 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief One-shot tasks dependency graph class.
+ *
+ * Tasks are added with their dependencies declared, then graph is started
+ * and every task runs as soon as all of its dependencies are done. Tasks
+ * which have to run in the thread owning the graph (e.g. creating GUI or
+ * OpenGL objects) are marked as main thread tasks, they are executed only
+ * within wait() and poll() calls. Other tasks are executed by worker threads.
+ *
+ * Exception thrown by a task is rethrown by wait() of that task or of any
+ * task which depends on it. Tasks might be added only before start().
+ */
+class TaskGraph
+{
+public:
+
+    typedef std::function< void () > Function;
+
+    /**
+     * @brief Constructor.
+     * @param threads number of worker threads
+     */
+    TaskGraph( unsigned int threads );
+
+    /** @brief Destructor, waits for running tasks, tasks not started yet are dropped. */
+    virtual ~TaskGraph();
+
+    /**
+     * @brief Adds task.
+     * @param name task name
+     * @param function task function
+     * @param deps identifiers of tasks which have to be done first
+     * @param mainThread specifies if task has to run in the graph owner thread
+     * @return task identifier
+     */
+    int add( const char *name, const Function &function,
+             const std::vector< int > &deps = std::vector< int >(),
+             bool mainThread = false );
+
+    /** @brief Starts worker threads. */
+    void start();
+
+    /**
+     * @brief Executes ready main thread tasks without waiting.
+     * Might be called only from the graph owner thread.
+     */
+    void poll();
+
+    /**
+     * @brief Waits until task is done, executing main thread tasks meanwhile.
+     * Might be called only from the graph owner thread.
+     * @param id task identifier
+     */
+    void wait( int id );
+
+    /**
+     * @brief Waits until all tasks are done.
+     * Might be called only from the graph owner thread.
+     */
+    void waitAll();
+
+    /**
+     * @param id task identifier
+     * @return true if task is done, false otherwise
+     */
+    bool isDone( int id );
+
+    /**
+     * @brief Logs tasks execution times.
+     * @param start [s] reference monotonic clock time
+     */
+    void report( double start );
+
+private:
+
+    /** Task data. */
+    struct Task
+    {
+        std::string name;               ///< task name
+        Function function;              ///< task function
+        std::vector< int > next;        ///< dependent tasks
+        std::exception_ptr exception;   ///< exception thrown by the task or its dependency
+        unsigned int pending;           ///< number of dependencies not done yet
+        double time_beg;                ///< [s] monotonic clock time when task started
+        double time_end;                ///< [s] monotonic clock time when task was done
+        bool mainThread;                ///< specifies if task has to run in the graph owner thread
+        bool done;                      ///< specifies if task is done
+    };
+
+    unsigned int _threads;              ///< number of worker threads
+
+    std::vector< Task > _tasks;         ///< all tasks
+    std::deque< int > _ready;           ///< ready worker tasks
+    std::deque< int > _readyMain;       ///< ready main thread tasks
+
+    std::vector< std::thread > _workers;///< worker threads
+
+    std::mutex _mutex;                  ///< mutex guarding tasks state
+    std::condition_variable _cv;        ///< tasks state change condition
+
+    unsigned int _left;                 ///< number of tasks not done yet
+
+    bool _started;                      ///< specifies if graph is started
+    bool _quit;                         ///< specifies if workers should quit
+
+    /** Using this constructor is forbidden. */
+    TaskGraph( const TaskGraph & );
+
+    /**
+     * @brief Executes task and marks it as done.
+     * @param id task identifier
+     * @param lock locked tasks state lock, unlocked while task is running
+     */
+    void execute( int id, std::unique_lock< std::mutex > &lock );
+
+    /** @brief Worker thread function. */
+    void work();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // TASKGRAPH_H
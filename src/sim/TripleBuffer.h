@@ -0,0 +1,122 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Lock-free single producer single consumer triple buffer.
+ *
+ * Producer writes into its own back buffer and publishes it by atomically
+ * swapping it with the middle buffer. Consumer atomically swaps its front
+ * buffer with the middle one only if newer data has been published. Neither
+ * side ever blocks and the consumer always sees complete snapshot: the most
+ * recent published one.
+ */
+template < class TYPE >
+class TripleBuffer
+{
+public:
+
+    /** @brief Constructor, buffers are value-initialized. */
+    TripleBuffer() :
+        _buffers (),
+        _middle ( 1 ),
+        _back  ( 0 ),
+        _front ( 2 )
+    {}
+
+    /**
+     * @brief Returns producer back buffer to be filled before publishing.
+     * Might be called by producer thread only.
+     * @return back buffer
+     */
+    inline TYPE& getBackBuffer() { return _buffers[ _back ]; }
+
+    /**
+     * @brief Publishes back buffer.
+     * Might be called by producer thread only.
+     */
+    inline void publish()
+    {
+        _back = _middle.exchange( _back | _fresh, std::memory_order_acq_rel ) & _index;
+    }
+
+    /**
+     * @brief Publishes a copy of the given data.
+     * Might be called by producer thread only.
+     * @param data data to be published
+     */
+    inline void publish( const TYPE &data )
+    {
+        getBackBuffer() = data;
+        publish();
+    }
+
+    /**
+     * @brief Fetches most recently published buffer if there is newer one.
+     * Might be called by consumer thread only.
+     * @return true if new data has been fetched, false otherwise
+     */
+    inline bool fetch()
+    {
+        if ( ( _middle.load( std::memory_order_relaxed ) & _fresh ) == 0 )
+        {
+            return false;
+        }
+
+        _front = _middle.exchange( _front, std::memory_order_acq_rel ) & _index;
+
+        return true;
+    }
+
+    /**
+     * @brief Returns consumer front buffer.
+     * Might be called by consumer thread only.
+     * @return front buffer
+     */
+    inline const TYPE& getFrontBuffer() const { return _buffers[ _front ]; }
+
+private:
+
+    static const unsigned int _index = 0x3;     ///< buffer index mask
+    static const unsigned int _fresh = 0x4;     ///< fresh data flag
+
+    TYPE _buffers[ 3 ];                         ///< buffers
+
+    std::atomic< unsigned int > _middle;        ///< middle buffer index and fresh data flag
+
+    unsigned int _back;                         ///< producer back buffer index
+    unsigned int _front;                        ///< consumer front buffer index
+
+    /** Using this constructor is forbidden. */
+    TripleBuffer( const TripleBuffer & ) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,246 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+
+#include <sim/UdpSocket.h>
+
+#include <cstring>
+
+#ifdef _LINUX_
+#   include <arpa/inet.h>
+#   include <fcntl.h>
+#   include <netinet/in.h>
+#   include <sys/select.h>
+#   include <sys/socket.h>
+#   include <unistd.h>
+#endif
+
+#ifdef WIN32
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool UdpSocket::resolve( const char *address, fdm::UInt32 *result )
+{
+    fdm::UInt32 addr = inet_addr( address );
+
+    if ( addr == INADDR_NONE ) return false;
+
+    (*result) = ntohl( addr );
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UdpSocket::UdpSocket() :
+#   ifdef WIN32
+    _socket ( (fdm::UInt64)INVALID_SOCKET ),
+#   else
+    _socket ( (fdm::UInt64)-1 ),
+#   endif
+    _open ( false )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+UdpSocket::~UdpSocket()
+{
+    close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool UdpSocket::open( unsigned short port, fdm::UInt32 address )
+{
+    close();
+
+    struct sockaddr_in local;
+
+    memset( &local, 0, sizeof(local) );
+    local.sin_family      = AF_INET;
+    local.sin_addr.s_addr = htonl( address != 0 ? address : INADDR_ANY );
+    local.sin_port        = htons( port );
+
+#   ifdef _LINUX_
+    int sock = socket( AF_INET, SOCK_DGRAM, 0 );
+
+    if ( sock < 0 ) return false;
+
+    if ( 0 != bind( sock, (struct sockaddr*)&local, sizeof(local) )
+      || 0 != fcntl( sock, F_SETFL, fcntl( sock, F_GETFL, 0 ) | O_NONBLOCK ) )
+    {
+        ::close( sock );
+        return false;
+    }
+#   endif
+
+#   ifdef WIN32
+    WSADATA wsaData;
+
+    if ( 0 != WSAStartup( MAKEWORD( 2, 2 ), &wsaData ) ) return false;
+
+    SOCKET sock = socket( AF_INET, SOCK_DGRAM, 0 );
+
+    u_long nonblocking = 1;
+
+    if ( sock == INVALID_SOCKET
+      || 0 != bind( sock, (struct sockaddr*)&local, sizeof(local) )
+      || 0 != ioctlsocket( sock, FIONBIO, &nonblocking ) )
+    {
+        if ( sock != INVALID_SOCKET ) closesocket( sock );
+        WSACleanup();
+        return false;
+    }
+#   endif
+
+    _socket = (fdm::UInt64)sock;
+    _open = true;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UdpSocket::close()
+{
+    if ( !_open ) return;
+
+#   ifdef _LINUX_
+    ::close( (int)_socket );
+    _socket = (fdm::UInt64)-1;
+#   endif
+
+#   ifdef WIN32
+    closesocket( (SOCKET)_socket );
+    _socket = (fdm::UInt64)INVALID_SOCKET;
+    WSACleanup();
+#   endif
+
+    _open = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool UdpSocket::join( fdm::UInt32 group )
+{
+    if ( !_open ) return false;
+
+    struct ip_mreq mreq;
+
+    memset( &mreq, 0, sizeof(mreq) );
+    mreq.imr_multiaddr.s_addr = htonl( group );
+    mreq.imr_interface.s_addr = htonl( INADDR_ANY );
+
+#   ifdef _LINUX_
+    int result = setsockopt( (int)_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq) );
+#   endif
+
+#   ifdef WIN32
+    int result = setsockopt( (SOCKET)_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&mreq, sizeof(mreq) );
+#   endif
+
+    return result == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool UdpSocket::send( const char *data, unsigned int size,
+                      fdm::UInt32 address, unsigned short port )
+{
+    if ( !_open ) return false;
+
+    struct sockaddr_in dest;
+
+    memset( &dest, 0, sizeof(dest) );
+    dest.sin_family      = AF_INET;
+    dest.sin_addr.s_addr = htonl( address );
+    dest.sin_port        = htons( port );
+
+#   ifdef _LINUX_
+    ssize_t sent = sendto( (int)_socket, data, size, 0, (struct sockaddr*)&dest, sizeof(dest) );
+#   endif
+
+#   ifdef WIN32
+    int sent = sendto( (SOCKET)_socket, data, (int)size, 0, (struct sockaddr*)&dest, sizeof(dest) );
+#   endif
+
+    return sent == (int)size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int UdpSocket::receive( char *buffer, unsigned int size,
+                        fdm::UInt32 *address, unsigned short *port )
+{
+    if ( !_open ) return -1;
+
+    struct sockaddr_in source;
+
+    memset( &source, 0, sizeof(source) );
+
+#   ifdef _LINUX_
+    socklen_t length = sizeof(source);
+    ssize_t received = recvfrom( (int)_socket, buffer, size, 0, (struct sockaddr*)&source, &length );
+#   endif
+
+#   ifdef WIN32
+    int length = sizeof(source);
+    int received = recvfrom( (SOCKET)_socket, buffer, (int)size, 0, (struct sockaddr*)&source, &length );
+#   endif
+
+    if ( received < 0 ) return -1;
+
+    if ( address ) (*address) = ntohl( source.sin_addr.s_addr );
+    if ( port    ) (*port)    = ntohs( source.sin_port );
+
+    return (int)received;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool UdpSocket::wait( double timeout )
+{
+    if ( !_open ) return false;
+
+    struct timeval tv;
+
+    tv.tv_sec  = (long)timeout;
+    tv.tv_usec = (long)( 1.0e6 * ( timeout - (double)tv.tv_sec ) );
+
+    fd_set fds;
+
+    FD_ZERO( &fds );
+
+#   ifdef _LINUX_
+    FD_SET( (int)_socket, &fds );
+    int result = select( (int)_socket + 1, &fds, 0, 0, &tv );
+#   endif
+
+#   ifdef WIN32
+    FD_SET( (SOCKET)_socket, &fds );
+    int result = select( 0, &fds, 0, 0, &tv );
+#   endif
+
+    return result > 0;
+}
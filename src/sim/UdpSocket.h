@@ -0,0 +1,115 @@
+/****************************************************************************//*
+ * Copyright (C) 2021 Marek M. Cel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ ******************************************************************************/
+#ifndef UDPSOCKET_H
+#define UDPSOCKET_H
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <fdm/fdm_Types.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Non-blocking UDP socket.
+ *
+ * Addresses and ports are given in host byte order. Sending and receiving
+ * never block, datagrams which cannot be sent immediately are dropped.
+ * Datagrams might be sent to multicast groups directly, receiving them
+ * requires joining the group.
+ */
+class UdpSocket
+{
+public:
+
+    /**
+     * @brief Resolves dotted IPv4 address.
+     * @param address dotted IPv4 address
+     * @param result resolved address
+     * @return true on success, false on failure
+     */
+    static bool resolve( const char *address, fdm::UInt32 *result );
+
+    /** @brief Constructor. */
+    UdpSocket();
+
+    /** @brief Destructor. */
+    virtual ~UdpSocket();
+
+    /**
+     * @brief Opens socket bound to the given port and local address.
+     * @param port local port, 0 means ephemeral port
+     * @param address local interface address, 0 means all interfaces
+     * @return true on success, false on failure
+     */
+    bool open( unsigned short port = 0, fdm::UInt32 address = 0 );
+
+    /** @brief Closes socket. */
+    void close();
+
+    /**
+     * @brief Joins multicast group on the default interface.
+     * @param group multicast group address
+     * @return true on success, false on failure
+     */
+    bool join( fdm::UInt32 group );
+
+    /**
+     * @brief Sends datagram.
+     * @param data datagram data
+     * @param size datagram size
+     * @param address destination address
+     * @param port destination port
+     * @return true if datagram has been sent, false otherwise
+     */
+    bool send( const char *data, unsigned int size,
+               fdm::UInt32 address, unsigned short port );
+
+    /**
+     * @brief Receives pending datagram.
+     * @param buffer datagram buffer
+     * @param size datagram buffer size
+     * @param address source address, might be null if not required
+     * @param port source port, might be null if not required
+     * @return datagram size or -1 if there is no pending datagram
+     */
+    int receive( char *buffer, unsigned int size,
+                 fdm::UInt32 *address = 0, unsigned short *port = 0 );
+
+    /**
+     * @brief Waits until datagram is pending.
+     * @param timeout [s] maximum waiting time
+     * @return true if there is pending datagram, false otherwise
+     */
+    bool wait( double timeout );
+
+    inline bool isOpen() const { return _open; }
+
+private:
+
+    fdm::UInt64 _socket;            ///< socket descriptor (SOCKET on Windows)
+
+    bool _open;                     ///< specifies if socket is open
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // UDPSOCKET_H
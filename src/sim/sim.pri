@@ -1,4 +1,31 @@
 HEADERS += \
+    $$PWD/ClusterSync.h \
+    $$PWD/DataOutStream.h \
+    $$PWD/HeadTracker.h \
+    $$PWD/IdleMode.h \
     $$PWD/Log.h \
+    $$PWD/MetricsExporter.h \
     $$PWD/Path.h \
-    $$PWD/Singleton.h
+    $$PWD/RealTimeScheduler.h \
+    $$PWD/RemoteClient.h \
+    $$PWD/RemoteProtocol.h \
+    $$PWD/RemoteServer.h \
+    $$PWD/SharedDataOut.h \
+    $$PWD/Singleton.h \
+    $$PWD/TaskGraph.h \
+    $$PWD/TripleBuffer.h \
+    $$PWD/UdpSocket.h
+
+SOURCES += \
+    $$PWD/ClusterSync.cpp \
+    $$PWD/DataOutStream.cpp \
+    $$PWD/HeadTracker.cpp \
+    $$PWD/IdleMode.cpp \
+    $$PWD/MetricsExporter.cpp \
+    $$PWD/RealTimeScheduler.cpp \
+    $$PWD/RemoteClient.cpp \
+    $$PWD/RemoteProtocol.cpp \
+    $$PWD/RemoteServer.cpp \
+    $$PWD/SharedDataOut.cpp \
+    $$PWD/TaskGraph.cpp \
+    $$PWD/UdpSocket.cpp
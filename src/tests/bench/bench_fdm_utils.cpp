@@ -0,0 +1,573 @@
+#include <cmath>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/models/fdm_Atmosphere.h>
+
+#include <fdm/utils/fdm_GaussJordan.h>
+#include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_Quaternion.h>
+#include <fdm/utils/fdm_Random.h>
+#include <fdm/utils/fdm_Table1.h>
+#include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_Vector3.h>
+#include <fdm/utils/fdm_VectorN.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+// number of operations per benchmark iteration
+#define OPERATIONS 1000
+
+// access patterns
+#define COHERENT 0
+#define RANDOM   1
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class UtilsBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    UtilsBenchmark();
+
+private:
+
+    fdm::Random _random;
+
+    std::vector< double > getKeys( double min, double max, int pattern );
+
+    fdm::Table1 createTable1( int size );
+    fdm::Table2 createTable2( int size );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkTable1_data();
+    void benchmarkTable1();
+
+    void benchmarkTable1Cursor_data();
+    void benchmarkTable1Cursor();
+
+    void benchmarkTable2_data();
+    void benchmarkTable2();
+
+    void benchmarkMatrix3x3Multiply();
+    void benchmarkMatrix3x3Vector();
+    void benchmarkMatrix3x3FromQuaternion();
+
+    void benchmarkQuaternionMultiply();
+    void benchmarkQuaternionDerivative();
+    void benchmarkQuaternionFromAngles();
+
+    void benchmarkVectorN_data();
+    void benchmarkVectorN();
+
+    void benchmarkWGS84Geo2Wgs();
+    void benchmarkWGS84Wgs2Geo();
+
+    void benchmarkAtmosphere_data();
+    void benchmarkAtmosphere();
+
+    void benchmarkGaussJordan6();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+UtilsBenchmark::UtilsBenchmark() :
+    _random( 1 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector< double > UtilsBenchmark::getKeys( double min, double max, int pattern )
+{
+    std::vector< double > keys;
+
+    for ( unsigned int i = 0; i < OPERATIONS; i++ )
+    {
+        if ( pattern == COHERENT )
+        {
+            // slow sweep back and forth, as angle of attack during flight
+            double phase = 2.0 * M_PI * i / (double)OPERATIONS;
+            keys.push_back( min + 0.5 * ( max - min ) * ( 1.0 - cos( phase ) ) );
+        }
+        else
+        {
+            keys.push_back( _random.getRandom( min, max ) );
+        }
+    }
+
+    return keys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Table1 UtilsBenchmark::createTable1( int size )
+{
+    std::vector< double > key_values;
+    std::vector< double > table_data;
+
+    for ( int i = 0; i < size; i++ )
+    {
+        double x = -1.0 + 2.0 * i / (double)( size - 1 );
+
+        key_values.push_back( x );
+        table_data.push_back( sin( 3.0 * x ) + 0.1 * x * x );
+    }
+
+    return fdm::Table1( key_values, table_data );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Table2 UtilsBenchmark::createTable2( int size )
+{
+    std::vector< double > row_values;
+    std::vector< double > col_values;
+    std::vector< double > table_data;
+
+    for ( int i = 0; i < size; i++ )
+    {
+        double x = -1.0 + 2.0 * i / (double)( size - 1 );
+
+        row_values.push_back( x );
+        col_values.push_back( x );
+    }
+
+    for ( int r = 0; r < size; r++ )
+    {
+        for ( int c = 0; c < size; c++ )
+        {
+            table_data.push_back( sin( 3.0 * row_values[ r ] ) * col_values[ c ] );
+        }
+    }
+
+    return fdm::Table2( row_values, col_values, table_data );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkTable1_data()
+{
+    QTest::addColumn< int >( "size" );
+    QTest::addColumn< int >( "pattern" );
+    QTest::addColumn< int >( "baked" );
+
+    QTest::newRow( "8 coherent"          ) <<   8 << COHERENT << 0;
+    QTest::newRow( "8 random"            ) <<   8 << RANDOM   << 0;
+    QTest::newRow( "20 coherent"         ) <<  20 << COHERENT << 0;
+    QTest::newRow( "20 random"           ) <<  20 << RANDOM   << 0;
+    QTest::newRow( "64 coherent"         ) <<  64 << COHERENT << 0;
+    QTest::newRow( "64 random"           ) <<  64 << RANDOM   << 0;
+    QTest::newRow( "256 coherent"        ) << 256 << COHERENT << 0;
+    QTest::newRow( "256 random"          ) << 256 << RANDOM   << 0;
+    QTest::newRow( "20 random baked"     ) <<  20 << RANDOM   << 1;
+    QTest::newRow( "256 random baked"    ) << 256 << RANDOM   << 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkTable1()
+{
+    QFETCH( int, size );
+    QFETCH( int, pattern );
+    QFETCH( int, baked );
+
+    fdm::Table1 table = createTable1( size );
+
+    if ( baked ) QVERIFY( table.bake( 1.0e-3 ) );
+
+    std::vector< double > keys = getKeys( -1.0, 1.0, pattern );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < keys.size(); i++ )
+        {
+            sum += table.getValue( keys[ i ] );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkTable1Cursor_data()
+{
+    QTest::addColumn< int >( "size" );
+    QTest::addColumn< int >( "pattern" );
+
+    QTest::newRow( "20 coherent"  ) <<  20 << COHERENT;
+    QTest::newRow( "20 random"    ) <<  20 << RANDOM;
+    QTest::newRow( "256 coherent" ) << 256 << COHERENT;
+    QTest::newRow( "256 random"   ) << 256 << RANDOM;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkTable1Cursor()
+{
+    QFETCH( int, size );
+    QFETCH( int, pattern );
+
+    fdm::Table1 table = createTable1( size );
+
+    std::vector< double > keys = getKeys( -1.0, 1.0, pattern );
+
+    double sum = 0.0;
+    unsigned int cursor = 0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < keys.size(); i++ )
+        {
+            sum += table.getValue( keys[ i ], cursor );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkTable2_data()
+{
+    QTest::addColumn< int >( "size" );
+    QTest::addColumn< int >( "pattern" );
+    QTest::addColumn< int >( "baked" );
+
+    QTest::newRow( "8 coherent"       ) <<  8 << COHERENT << 0;
+    QTest::newRow( "8 random"         ) <<  8 << RANDOM   << 0;
+    QTest::newRow( "20 coherent"      ) << 20 << COHERENT << 0;
+    QTest::newRow( "20 random"        ) << 20 << RANDOM   << 0;
+    QTest::newRow( "64 coherent"      ) << 64 << COHERENT << 0;
+    QTest::newRow( "64 random"        ) << 64 << RANDOM   << 0;
+    QTest::newRow( "20 random baked"  ) << 20 << RANDOM   << 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkTable2()
+{
+    QFETCH( int, size );
+    QFETCH( int, pattern );
+    QFETCH( int, baked );
+
+    fdm::Table2 table = createTable2( size );
+
+    if ( baked ) QVERIFY( table.bake( 1.0e-2 ) );
+
+    std::vector< double > rows = getKeys( -1.0, 1.0, pattern );
+    std::vector< double > cols = getKeys( -1.0, 1.0, pattern );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < rows.size(); i++ )
+        {
+            sum += table.getValue( rows[ i ], cols[ OPERATIONS - 1 - i ] );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkMatrix3x3Multiply()
+{
+    fdm::Matrix3x3 m1( fdm::Angles( 0.1, 0.2, 0.3 ) );
+    fdm::Matrix3x3 m2( fdm::Angles( 0.3, 0.2, 0.1 ) );
+    fdm::Matrix3x3 m = m1;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < OPERATIONS; i++ )
+        {
+            m = m * m2;
+        }
+    }
+
+    QVERIFY( m(0,0) == m(0,0) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkMatrix3x3Vector()
+{
+    fdm::Matrix3x3 m( fdm::Angles( 0.1, 0.2, 0.3 ) );
+    fdm::Vector3 v( 1.0, 2.0, 3.0 );
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < OPERATIONS; i++ )
+        {
+            v = m * v;
+        }
+    }
+
+    QVERIFY( v.x() == v.x() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkMatrix3x3FromQuaternion()
+{
+    fdm::Quaternion q( fdm::Angles( 0.1, 0.2, 0.3 ) );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < OPERATIONS; i++ )
+        {
+            fdm::Matrix3x3 m( q );
+            sum += m(0,1);
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkQuaternionMultiply()
+{
+    fdm::Quaternion q1( fdm::Angles( 0.1, 0.2, 0.3 ) );
+    fdm::Quaternion q2( fdm::Angles( 0.001, 0.002, 0.003 ) );
+    fdm::Quaternion q = q1;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < OPERATIONS; i++ )
+        {
+            q = q * q2;
+        }
+    }
+
+    QVERIFY( q.e0() == q.e0() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkQuaternionDerivative()
+{
+    fdm::Quaternion q( fdm::Angles( 0.1, 0.2, 0.3 ) );
+    fdm::Vector3 omega( 0.1, 0.2, 0.3 );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < OPERATIONS; i++ )
+        {
+            sum += q.getDerivative( omega, 0.02 ).e0();
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkQuaternionFromAngles()
+{
+    std::vector< double > angles = getKeys( -M_PI, M_PI, RANDOM );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < angles.size(); i++ )
+        {
+            fdm::Quaternion q( fdm::Angles( angles[ i ], 0.5 * angles[ i ], angles[ i ] ) );
+            sum += q.ex();
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkVectorN_data()
+{
+    QTest::addColumn< int >( "size" );
+
+    QTest::newRow( "13"  ) <<  13;
+    QTest::newRow( "64"  ) <<  64;
+    QTest::newRow( "256" ) << 256;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkVectorN()
+{
+    QFETCH( int, size );
+
+    fdm::VectorN x( size );
+    fdm::VectorN k( size );
+
+    for ( int i = 0; i < size; i++ )
+    {
+        x( i ) = 1.0;
+        k( i ) = 0.001 * i;
+    }
+
+    // as in a single Runge-Kutta stage
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < OPERATIONS; i++ )
+        {
+            x = x + k * 0.01;
+        }
+    }
+
+    QVERIFY( x( 0 ) == x( 0 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkWGS84Geo2Wgs()
+{
+    std::vector< double > lats = getKeys( -1.5, 1.5, RANDOM );
+    std::vector< double > lons = getKeys( -3.1, 3.1, RANDOM );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < lats.size(); i++ )
+        {
+            sum += fdm::WGS84::geo2wgs( lats[ i ], lons[ i ], 1000.0 ).x();
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkWGS84Wgs2Geo()
+{
+    std::vector< double > lats = getKeys( -1.5, 1.5, RANDOM );
+    std::vector< double > lons = getKeys( -3.1, 3.1, RANDOM );
+
+    std::vector< fdm::Vector3 > pos_wgs;
+
+    for ( unsigned int i = 0; i < lats.size(); i++ )
+    {
+        pos_wgs.push_back( fdm::WGS84::geo2wgs( lats[ i ], lons[ i ], 1000.0 ) );
+    }
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < pos_wgs.size(); i++ )
+        {
+            sum += fdm::WGS84::wgs2geo( pos_wgs[ i ] ).alt;
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkAtmosphere_data()
+{
+    QTest::addColumn< int >( "tableMode" );
+
+    QTest::newRow( "computed" ) << 0;
+    QTest::newRow( "table"    ) << 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkAtmosphere()
+{
+    QFETCH( int, tableMode );
+
+    fdm::Atmosphere atmosphere;
+
+    atmosphere.setTableMode( tableMode != 0 );
+
+    std::vector< double > altitudes = getKeys( 0.0, 15000.0, COHERENT );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < altitudes.size(); i++ )
+        {
+            atmosphere.update( altitudes[ i ] );
+            sum += atmosphere.getDensity();
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void UtilsBenchmark::benchmarkGaussJordan6()
+{
+    fdm::Matrix< 6,6 > mtr;
+    fdm::Vector< 6 > rhs;
+    fdm::Vector< 6 > x;
+
+    // mass matrix like system
+    for ( unsigned int r = 0; r < 6; r++ )
+    {
+        for ( unsigned int c = 0; c < 6; c++ )
+        {
+            mtr( r, c ) = ( r == c ) ? 10.0 + r : 0.1 * ( r + c );
+        }
+
+        rhs( r ) = 1.0 + r;
+    }
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < OPERATIONS; i++ )
+        {
+            fdm::GaussJordan< 6 >::solve( mtr, rhs, &x );
+            sum += x( 0 );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(UtilsBenchmark)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "bench_fdm_utils.moc"
@@ -0,0 +1,200 @@
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fdm/fdm_CApi.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+#define INIT_STEPS 10000
+#define WARM_STEPS 200
+#define TEST_STEPS 300
+
+#define CHECK( cond ) \
+{ \
+    if ( !( cond ) ) \
+    { \
+        printf( "FAIL: %s(%d) %s\n", __FILE__, __LINE__, #cond ); \
+        return 1; \
+    } \
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static fdm_DataInp dataInp;
+static fdm_DataOut dataOut;
+
+////////////////////////////////////////////////////////////////////////////////
+
+static void initDataInp( fdm_AircraftType aircraftType )
+{
+    int i;
+
+    memset( &dataInp, 0, sizeof(fdm_DataInp) );
+    memset( &dataOut, 0, sizeof(fdm_DataOut) );
+
+    dataInp.aircraftType = aircraftType;
+
+    dataInp.initial.latitude     = 0.0;
+    dataInp.initial.longitude    = 0.0;
+    dataInp.initial.altitude_agl = 300.0;
+    dataInp.initial.heading      = 0.0;
+    dataInp.initial.airspeed     = 40.0;
+    dataInp.initial.engineOn     = true;
+
+    dataInp.environment.temperature_0  = 288.15;
+    dataInp.environment.pressure_0     = 101325.0;
+    dataInp.environment.wind_direction = 0.5;
+    dataInp.environment.wind_speed     = 5.0;
+    dataInp.environment.turbulence     = FDM_TURBULENCE_MODERATE;
+    dataInp.environment.seed           = 1;
+
+    // sea level ground at the equator and the prime meridian
+    dataInp.ground.elevation = 0.0;
+    dataInp.ground.r_x_wgs = 6378137.0;
+    dataInp.ground.n_x_wgs = 1.0;
+
+    dataInp.controls.lgh = true;
+
+    for ( i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        dataInp.engine[ i ].throttle  = 0.8;
+        dataInp.engine[ i ].mixture   = 1.0;
+        dataInp.engine[ i ].propeller = 1.0;
+        dataInp.engine[ i ].fuel      = true;
+        dataInp.engine[ i ].ignition  = true;
+    }
+
+    dataInp.masses.pilot [ 0 ] = 80.0;
+    dataInp.masses.tank  [ 0 ] = 100.0;
+    dataInp.masses.tank  [ 1 ] = 100.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static int run( fdm_Handle *fdm, fdm_DataOut_Flight *flight )
+{
+    int i;
+
+    for ( i = 0; i < TEST_STEPS; i++ )
+    {
+        // exciting controls, so outputs depend on inputs set between steps
+        dataInp.controls.roll  = 0.2 * sin( 0.05 * i );
+        dataInp.controls.pitch = 0.1 * sin( 0.03 * i );
+
+        CHECK( fdm_step( fdm, TIME_STEP, 1 ) == FDM_CAPI_SUCCESS );
+    }
+
+    *flight = dataOut.flight;
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static int testInterface( void )
+{
+    CHECK( fdm_getVersion() == FDM_CAPI_VERSION );
+
+    CHECK( fdm_getDataInpSize() == sizeof(fdm_DataInp) );
+    CHECK( fdm_getDataOutSize() == sizeof(fdm_DataOut) );
+
+    CHECK( fdm_create( NULL, &dataOut ) == NULL );
+    CHECK( fdm_create( &dataInp, NULL ) == NULL );
+
+    CHECK( fdm_step( NULL, TIME_STEP, 1 ) == FDM_CAPI_FAILURE );
+    CHECK( fdm_getStateSize( NULL ) == 0 );
+
+    // null handle is accepted
+    fdm_destroy( NULL );
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static int testManager( fdm_AircraftType aircraftType )
+{
+    fdm_Handle *fdm = NULL;
+    fdm_DataOut_Flight flight_1;
+    fdm_DataOut_Flight flight_2;
+    unsigned int size = 0;
+    double *state = NULL;
+    int result = 0;
+    int i;
+
+    initDataInp( aircraftType );
+
+    fdm = fdm_create( &dataInp, &dataOut );
+    CHECK( fdm != NULL );
+
+    fdm_setVerbose( fdm, 0 );
+    fdm_setBackgroundBuild( fdm, 0 );
+
+    // no flight dynamics model before initialization
+    CHECK( fdm_getStateSize( fdm ) == 0 );
+
+    dataInp.stateInp = FDM_STATE_INP_INIT;
+
+    for ( i = 0; i < INIT_STEPS && dataOut.stateOut != FDM_STATE_OUT_READY; i++ )
+    {
+        CHECK( fdm_step( fdm, TIME_STEP, 1 ) == FDM_CAPI_SUCCESS );
+    }
+
+    CHECK( dataOut.stateOut == FDM_STATE_OUT_READY );
+
+    dataInp.stateInp = FDM_STATE_INP_WORK;
+
+    CHECK( fdm_step( fdm, TIME_STEP, WARM_STEPS ) == FDM_CAPI_SUCCESS );
+    CHECK( dataOut.stateOut == FDM_STATE_OUT_WORKING );
+    CHECK( dataOut.crash == FDM_CRASH_NONE );
+    CHECK( dataOut.lockstep.frame > 0 );
+
+    size = fdm_getStateSize( fdm );
+    CHECK( size > 0 );
+
+    state = (double*)malloc( sizeof(double) * size );
+    CHECK( state != NULL );
+
+    CHECK( fdm_saveState( fdm, NULL ) == FDM_CAPI_FAILURE );
+
+    if ( fdm_saveState( fdm, state ) != FDM_CAPI_SUCCESS
+      || run( fdm, &flight_1 ) != 0
+      || fdm_restoreState( fdm, state ) != FDM_CAPI_SUCCESS
+      || run( fdm, &flight_2 ) != 0 )
+    {
+        printf( "FAIL: %s(%d) save, step, restore, step\n", __FILE__, __LINE__ );
+        result = 1;
+    }
+    // the same steps after restoring have to give bit-exact results
+    else if ( memcmp( &flight_1, &flight_2, offsetof(fdm_DataOut_Flight, onGround) ) != 0 )
+    {
+        printf( "FAIL: %s(%d) flight data after restoring state\n", __FILE__, __LINE__ );
+        result = 1;
+    }
+
+    free( state );
+
+    dataInp.stateInp = FDM_STATE_INP_STOP;
+    fdm_step( fdm, TIME_STEP, 1 );
+
+    fdm_destroy( fdm );
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main( void )
+{
+    if ( testInterface() != 0 ) return EXIT_FAILURE;
+
+    if ( testManager( FDM_AIRCRAFT_C172 ) != 0 ) return EXIT_FAILURE;
+
+    printf( "PASS: test_fdm_capi\n" );
+
+    return EXIT_SUCCESS;
+}
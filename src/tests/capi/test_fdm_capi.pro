@@ -0,0 +1,53 @@
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG -= qt
+
+TEMPLATE = app
+
+################################################################################
+
+TARGET = test_fdm_capi
+
+################################################################################
+
+QMAKE_CFLAGS += -std=c99 -pedantic
+
+################################################################################
+
+INCLUDEPATH += . ../..
+
+win32: INCLUDEPATH += \
+    $(OSG_ROOT)/include/ \
+    $(OSG_ROOT)/include/libxml2
+
+unix: INCLUDEPATH += \
+    /usr/include/libxml2
+
+################################################################################
+
+win32: LIBS += \
+    -L$(OSG_ROOT)/lib \
+    -llibxml2
+
+unix: LIBS += \
+    -L/lib \
+    -L/usr/lib \
+    -lxml2
+
+################################################################################
+
+include(../../fdm/fdm.pri)
+include(../../fdm_aw101/fdm_aw101.pri)
+include(../../fdm_c130/fdm_c130.pri)
+include(../../fdm_c172/fdm_c172.pri)
+include(../../fdm_f16/fdm_f16.pri)
+include(../../fdm_f35a/fdm_f35a.pri)
+include(../../fdm_p51/fdm_p51.pri)
+include(../../fdm_pw5/fdm_pw5.pri)
+include(../../fdm_r44/fdm_r44.pri)
+include(../../fdm_uh60/fdm_uh60.pri)
+
+################################################################################
+
+SOURCES += \
+    test_fdm_capi.c
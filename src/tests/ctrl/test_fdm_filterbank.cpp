@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/ctrl/fdm_Filter2.h>
+#include <fdm/ctrl/fdm_FilterBank.h>
+#include <fdm/ctrl/fdm_HPF.h>
+#include <fdm/ctrl/fdm_Lag.h>
+#include <fdm/ctrl/fdm_Lag2.h>
+#include <fdm/ctrl/fdm_Lead.h>
+#include <fdm/ctrl/fdm_LeadLag.h>
+#include <fdm/ctrl/fdm_LPF.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class FilterBankTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    FilterBankTest();
+
+private:
+
+    std::vector< double > readData( const char *path );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void test_update();
+    void test_updateAll();
+    void test_types();
+    void test_data();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+FilterBankTest::FilterBankTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector< double > FilterBankTest::readData( const char *path )
+{
+    std::vector< double > data;
+
+    FILE *file = fopen( path, "r" );
+
+    if ( file )
+    {
+        char buffer[4];
+
+        while ( fread( buffer, 1, 4, file ) == 4 )
+        {
+            float *y = (float*)(buffer);
+            data.push_back( *y );
+        }
+
+        fclose( file );
+    }
+
+    return data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::test_update()
+{
+    fdm::Lag     lag( 0.1 );
+    fdm::LeadLag leadLag( 3.0, 12.0, 1.0, 12.0 );
+    fdm::Filter2 filter2( 4.0, 64.0, 6400.0, 1.0, 80.0, 6400.0 );
+
+    fdm::FilterBank bank;
+
+    QVERIFY( bank.add( lag     ) == 0 );
+    QVERIFY( bank.add( leadLag ) == 1 );
+    QVERIFY( bank.add( filter2 ) == 2 );
+    QVERIFY( bank.getSize() == 3 );
+
+    bank.setTimeStep( TIME_STEP );
+
+    double t = 0.0;
+
+    for ( unsigned int i = 0; i < 1000; i++ )
+    {
+        double u = ( t < 0.99 ) ? 0.0 : sin( 5.0 * t );
+
+        // chained sections
+        lag.update( TIME_STEP, u );
+        leadLag.update( TIME_STEP, lag.getValue() );
+        filter2.update( TIME_STEP, leadLag.getValue() );
+
+        bank.update( 0, u );
+        bank.update( 1, bank.getValue( 0 ) );
+        bank.update( 2, bank.getValue( 1 ) );
+
+        QVERIFY2( fabs( lag     .getValue() - bank.getValue( 0 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( leadLag .getValue() - bank.getValue( 1 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( filter2 .getValue() - bank.getValue( 2 ) ) < 1.0e-9, "Failure" );
+
+        t += TIME_STEP;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::test_updateAll()
+{
+    std::vector< fdm::Lag > lags;
+
+    lags.push_back( fdm::Lag( 0.05 ) );
+    lags.push_back( fdm::Lag( 0.1, 1.0 ) );
+    lags.push_back( fdm::Lag( 1.0 ) );
+
+    fdm::FilterBank bank;
+
+    for ( unsigned int i = 0; i < lags.size(); i++ )
+    {
+        bank.add( lags[ i ] );
+    }
+
+    // holding value until time step is set
+    double u[] = { 1.0, 2.0, 3.0 };
+    bank.update( u );
+    QVERIFY2( fabs( bank.getValue( 1 ) - 1.0 ) < 1.0e-9, "Failure" );
+
+    bank.setTimeStep( TIME_STEP );
+    QVERIFY2( fabs( bank.getTimeStep() - TIME_STEP ) < 1.0e-12, "Failure" );
+
+    for ( unsigned int n = 0; n < 500; n++ )
+    {
+        for ( unsigned int i = 0; i < lags.size(); i++ )
+        {
+            u[ i ] = cos( 0.1 * n + i );
+            lags[ i ].update( TIME_STEP, u[ i ] );
+        }
+
+        bank.update( u );
+
+        for ( unsigned int i = 0; i < lags.size(); i++ )
+        {
+            QVERIFY2( fabs( lags[ i ].getValue() - bank.getValue( i ) ) < 1.0e-9, "Failure" );
+        }
+    }
+
+    bank.clear();
+    QVERIFY( bank.getSize() == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::test_types()
+{
+    fdm::Lag     lag( 0.5 );
+    fdm::Lag2    lag2( 0.5, 2.0 );
+    fdm::Lead    lead( 0.3 );
+    fdm::HPF     hpf( 2.0 );
+    fdm::LPF     lpf( 0.5 );
+    fdm::LeadLag leadLag( 1.0, 0.5, 1.0, 2.0 );
+    fdm::Filter2 filter2( 2.0, 2.0, 2.0, 1.0, 2.0, 4.0 );
+
+    fdm::FilterBank bank;
+
+    bank.add( lag );
+    bank.add( lag2 );
+    bank.add( lead );
+    bank.add( hpf );
+    bank.add( lpf );
+    bank.add( leadLag );
+    bank.add( filter2 );
+
+    QVERIFY( bank.getSize() == 7 );
+
+    bank.setTimeStep( TIME_STEP );
+
+    double u[ 7 ];
+
+    for ( unsigned int n = 0; n < 1000; n++ )
+    {
+        double t = n * TIME_STEP;
+        double u_t = sin( 3.0 * t ) + ( ( t < 0.99 ) ? 0.0 : 1.0 );
+
+        for ( unsigned int i = 0; i < 7; i++ ) u[ i ] = u_t;
+
+        lag     .update( TIME_STEP, u_t );
+        lag2    .update( TIME_STEP, u_t );
+        lead    .update( TIME_STEP, u_t );
+        hpf     .update( TIME_STEP, u_t );
+        lpf     .update( TIME_STEP, u_t );
+        leadLag .update( TIME_STEP, u_t );
+        filter2 .update( TIME_STEP, u_t );
+
+        bank.update( u );
+
+        QVERIFY2( fabs( lag     .getValue() - bank.getValue( 0 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( lag2    .getValue() - bank.getValue( 1 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( lead    .getValue() - bank.getValue( 2 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( hpf     .getValue() - bank.getValue( 3 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( lpf     .getValue() - bank.getValue( 4 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( leadLag .getValue() - bank.getValue( 5 ) ) < 1.0e-9, "Failure" );
+        QVERIFY2( fabs( filter2 .getValue() - bank.getValue( 6 ) ) < 1.0e-9, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FilterBankTest::test_data()
+{
+    // step responses stored in data files, the same parameters as in the
+    // particular elements tests
+    std::vector< double > y_lag      = readData( "../ctrl/data/test_fdm_lag.bin"      );
+    std::vector< double > y_lag2     = readData( "../ctrl/data/test_fdm_lag2.bin"     );
+    std::vector< double > y_lpf      = readData( "../ctrl/data/test_fdm_lpf.bin"      );
+    std::vector< double > y_lead_lag = readData( "../ctrl/data/test_fdm_lead_lag.bin" );
+    std::vector< double > y_filter2  = readData( "../ctrl/data/test_fdm_filter2.bin"  );
+
+    QVERIFY2( y_lag      .size() > 0, "Cannot open file" );
+    QVERIFY2( y_lag2     .size() > 0, "Cannot open file" );
+    QVERIFY2( y_lpf      .size() > 0, "Cannot open file" );
+    QVERIFY2( y_lead_lag .size() > 0, "Cannot open file" );
+    QVERIFY2( y_filter2  .size() > 0, "Cannot open file" );
+
+    const unsigned int steps = 10;
+    const double dt = 0.1 / (double)steps;
+
+    // lags data are sampled at the end of the major time step
+    fdm::FilterBank bank_1;
+
+    unsigned int i_lag  = bank_1.addLag( 2.0 );
+    unsigned int i_lag2 = bank_1.addLag2( 2.0, 3.0 );
+
+    bank_1.setTimeStep( dt );
+
+    double u_1[ 2 ];
+    double t = 0.0;
+
+    for ( unsigned int i = 0; i < std::min( y_lag.size(), y_lag2.size() ); i++ )
+    {
+        u_1[ 0 ] = u_1[ 1 ] = ( t < 0.99 ) ? 0.0 : 1.0;
+
+        for ( unsigned int j = 0; j < steps; j++ )
+        {
+            bank_1.update( u_1 );
+        }
+
+        QVERIFY2( fabs( bank_1.getValue( i_lag  ) - y_lag  [ i ] ) < 1.0e-3, "Failure" );
+        QVERIFY2( fabs( bank_1.getValue( i_lag2 ) - y_lag2 [ i ] ) < 1.0e-3, "Failure" );
+
+        t += 0.1;
+    }
+
+    // the other data are sampled at the beginning of the major time step
+    fdm::FilterBank bank_2;
+
+    unsigned int i_lpf      = bank_2.addLag( 1.0 / 0.5 );
+    unsigned int i_lead_lag = bank_2.addLeadLag( 1.0, 0.0, 1.0, 1.0 );
+    unsigned int i_filter2  = bank_2.addFilter2( 2.0, 2.0, 2.0, 1.0, 2.0, 4.0 );
+
+    bank_2.setTimeStep( dt );
+
+    double u_2[ 3 ];
+    unsigned int index = 0;
+    unsigned int size = std::min( y_lpf.size(), std::min( y_lead_lag.size(), y_filter2.size() ) );
+
+    t = 0.0;
+
+    for ( unsigned int i = 0; i < steps * size; i++ )
+    {
+        u_2[ 0 ] = u_2[ 1 ] = u_2[ 2 ] = ( t < 0.99 ) ? 0.0 : 1.0;
+
+        bank_2.update( u_2 );
+
+        if ( i % steps == 0 )
+        {
+            if ( index > 0 )
+            {
+                QVERIFY2( fabs( bank_2.getValue( i_lpf      ) - y_lpf      [ index - 1 ] ) < 1.0e-2, "Failure" );
+                QVERIFY2( fabs( bank_2.getValue( i_lead_lag ) - y_lead_lag [ index - 1 ] ) < 1.0e-1, "Failure" );
+                QVERIFY2( fabs( bank_2.getValue( i_filter2  ) - y_filter2  [ index - 1 ] ) < 1.0e-1, "Failure" );
+            }
+
+            index++;
+        }
+
+        t += dt;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(FilterBankTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_filterbank.moc"
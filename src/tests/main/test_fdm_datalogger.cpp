@@ -0,0 +1,185 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <fdm/main/fdm_DataLogger.h>
+#include <fdm/main/fdm_Recorder.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+#define STEPS 1000
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class DataLoggerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    DataLoggerTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void subscribe();
+    void decimation();
+    void text();
+
+private:
+
+    fdm::DataNode _root;
+
+    static int countLines( const char *file, std::string *header, std::string *last );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataLoggerTest::DataLoggerTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLoggerTest::initTestCase()
+{
+    _root.addNode( "input.controls.roll", fdm::DataNode::Double );
+    _root.addNode( "input.controls.lgh" , fdm::DataNode::Bool   );
+    _root.addNode( "output.counter"     , fdm::DataNode::Int    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLoggerTest::cleanupTestCase()
+{
+    remove( "test_fdm_datalogger_1.rec" );
+    remove( "test_fdm_datalogger_10.rec" );
+    remove( "test_fdm_datalogger_1.csv" );
+    remove( "test_fdm_datalogger_10.csv" );
+    remove( "test_fdm_datalogger.csv" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLoggerTest::subscribe()
+{
+    fdm::DataLogger logger( &_root );
+
+    QVERIFY2( FDM_SUCCESS == logger.subscribe( "input.controls.roll" ), "Failure" );
+    QVERIFY2( FDM_FAILURE == logger.subscribe( "input.controls.none" ), "Failure" );
+    QVERIFY2( FDM_FAILURE == logger.subscribe( "input.controls" ), "Failure" );
+    QVERIFY2( FDM_FAILURE == logger.subscribe( "input.controls.roll", 0 ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLoggerTest::decimation()
+{
+    fdm::DataLogger logger( &_root );
+
+    logger.subscribe( "input.controls.roll" );
+    logger.subscribe( "input.controls.lgh" );
+    logger.subscribe( "output.counter", 10 );
+
+    QVERIFY2( FDM_SUCCESS == logger.open( "test_fdm_datalogger.rec" ), "Failure" );
+    QVERIFY2( FDM_FAILURE == logger.subscribe( "output.counter" ), "Failure" );
+
+    fdm::DataNode *roll    = _root.getNode( "input.controls.roll" );
+    fdm::DataNode *lgh     = _root.getNode( "input.controls.lgh" );
+    fdm::DataNode *counter = _root.getNode( "output.counter" );
+
+    for ( int i = 0; i < STEPS; i++ )
+    {
+        roll->setDatad( 0.001 * i );
+        lgh->setDatab( i % 2 == 0 );
+        counter->setDatai( i );
+
+        logger.step( TIME_STEP );
+    }
+
+    logger.close();
+
+    QVERIFY2( logger.getDropped() == 0, "Failure" );
+
+    std::string header;
+    std::string last;
+
+    QVERIFY2( FDM_SUCCESS == fdm::Recorder::exportText( "test_fdm_datalogger_1.rec", "test_fdm_datalogger_1.csv" ), "Failure" );
+    QVERIFY2( STEPS == countLines( "test_fdm_datalogger_1.csv", &header, &last ), "Failure" );
+    QVERIFY2( header == "\"time\";\"input.controls.roll\";\"input.controls.lgh\"", "Failure" );
+
+    QVERIFY2( FDM_SUCCESS == fdm::Recorder::exportText( "test_fdm_datalogger_10.rec", "test_fdm_datalogger_10.csv" ), "Failure" );
+    QVERIFY2( STEPS / 10 == countLines( "test_fdm_datalogger_10.csv", &header, &last ), "Failure" );
+    QVERIFY2( header == "\"time\";\"output.counter\"", "Failure" );
+
+    double time = 0.0;
+    double value = 0.0;
+    char separator;
+
+    std::istringstream stream( last );
+    stream >> time >> separator >> value;
+
+    QVERIFY2( fabs( time - 9.9 ) < 1.0e-6, "Failure" );
+    QVERIFY2( fabs( value - 990.0 ) < 1.0e-6, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataLoggerTest::text()
+{
+    fdm::DataLogger logger( &_root );
+
+    logger.subscribe( "input.controls.roll", 5 );
+
+    QVERIFY2( FDM_SUCCESS == logger.open( "test_fdm_datalogger.csv" ), "Failure" );
+
+    for ( int i = 0; i < STEPS; i++ ) logger.step( TIME_STEP );
+
+    logger.close();
+
+    std::string header;
+    std::string last;
+
+    QVERIFY2( STEPS / 5 == countLines( "test_fdm_datalogger.csv", &header, &last ), "Failure" );
+    QVERIFY2( header == "\"time\";\"input.controls.roll\"", "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int DataLoggerTest::countLines( const char *file, std::string *header, std::string *last )
+{
+    std::ifstream stream( file );
+    std::string line;
+
+    std::getline( stream, *header );
+
+    int lines = 0;
+
+    while ( std::getline( stream, line ) )
+    {
+        (*last) = line;
+        lines++;
+    }
+
+    return lines;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(DataLoggerTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_datalogger.moc"
@@ -0,0 +1,226 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <fdm/main/fdm_EventScript.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+
+#define SCRIPT_FILE "test_fdm_eventscript.xml"
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class EventScriptTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    EventScriptTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void readFile();
+    void time();
+    void condition();
+    void delay();
+    void persistence();
+    void reset();
+
+private:
+
+    fdm::EventScript _script;
+
+    fdm::DataOut _dataOut;
+    fdm::DataInp _dataInp;
+
+    void run( double time );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+EventScriptTest::EventScriptTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::initTestCase()
+{
+    FILE *file = fopen( SCRIPT_FILE, "w" );
+
+    if ( file )
+    {
+        fprintf( file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+        fprintf( file, "<event_script>\n" );
+        fprintf( file, "  <event name=\"wind\">\n" );
+        fprintf( file, "    <condition variable=\"time\" op=\"ge\">1.0</condition>\n" );
+        fprintf( file, "    <set input=\"wind_speed\">5.0</set>\n" );
+        fprintf( file, "  </event>\n" );
+        fprintf( file, "  <event name=\"flaps\">\n" );
+        fprintf( file, "    <condition variable=\"altitude_agl\" op=\"gt\" unit=\"ft\">1000.0</condition>\n" );
+        fprintf( file, "    <condition variable=\"onGround\" op=\"eq\">0</condition>\n" );
+        fprintf( file, "    <delay>0.5</delay>\n" );
+        fprintf( file, "    <set input=\"flaps\">0.0</set>\n" );
+        fprintf( file, "    <set input=\"engine_0_fuel\">0</set>\n" );
+        fprintf( file, "  </event>\n" );
+        fprintf( file, "</event_script>\n" );
+
+        fclose( file );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::cleanupTestCase()
+{
+    remove( SCRIPT_FILE );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::readFile()
+{
+    _script.readFile( SCRIPT_FILE );
+
+    QVERIFY2( _script.getEventsCount() == 2, "Failure" );
+    QVERIFY2( _script.getName( 0 ) == "wind", "Failure" );
+    QVERIFY2( _script.getName( 1 ) == "flaps", "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::time()
+{
+    _script.reset();
+
+    memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+    memset( &_dataInp, 0, sizeof(fdm::DataInp) );
+
+    run( 0.9 );
+    QVERIFY2( !_script.isFired( 0 ), "Failure" );
+    QVERIFY2( _dataInp.environment.wind_speed == 0.0, "Failure" );
+
+    run( 0.2 );
+    QVERIFY2( _script.isFired( 0 ), "Failure" );
+    QVERIFY2( fabs( _script.getFiredTime( 0 ) - 1.0 ) < TIME_STEP + 1.0e-9, "Failure" );
+    QVERIFY2( _dataInp.environment.wind_speed == 5.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::condition()
+{
+    _script.reset();
+
+    memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+    memset( &_dataInp, 0, sizeof(fdm::DataInp) );
+
+    _dataInp.controls.flaps = 1.0;
+    _dataInp.engine[ 0 ].fuel = true;
+
+    // 1000 ft AGL is 304.8 m
+    _dataOut.flight.altitude_agl = 300.0;
+    run( 2.0 );
+    QVERIFY2( !_script.isFired( 1 ), "Failure" );
+
+    // on ground
+    _dataOut.flight.altitude_agl = 400.0;
+    _dataOut.flight.onGround = true;
+    run( 2.0 );
+    QVERIFY2( !_script.isFired( 1 ), "Failure" );
+
+    _dataOut.flight.onGround = false;
+    run( 1.0 );
+    QVERIFY2( _script.isFired( 1 ), "Failure" );
+    QVERIFY2( _dataInp.controls.flaps == 0.0, "Failure" );
+    QVERIFY2( !_dataInp.engine[ 0 ].fuel, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::delay()
+{
+    _script.reset();
+
+    memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+    memset( &_dataInp, 0, sizeof(fdm::DataInp) );
+
+    _dataOut.flight.altitude_agl = 400.0;
+
+    run( 0.4 );
+    QVERIFY2( !_script.isFired( 1 ), "Failure" );
+
+    // interruption restarts delay
+    _dataOut.flight.altitude_agl = 300.0;
+    run( 0.1 );
+    _dataOut.flight.altitude_agl = 400.0;
+    run( 0.4 );
+    QVERIFY2( !_script.isFired( 1 ), "Failure" );
+
+    run( 0.2 );
+    QVERIFY2( _script.isFired( 1 ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::persistence()
+{
+    // conditions no longer hold, input data is rebuilt every frame
+    _dataOut.flight.altitude_agl = 0.0;
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        _dataInp.controls.flaps = 1.0;
+        _script.update( TIME_STEP, _dataOut, &_dataInp );
+        QVERIFY2( _dataInp.controls.flaps == 0.0, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::reset()
+{
+    _script.reset();
+
+    QVERIFY2( _script.getTime() == 0.0, "Failure" );
+
+    for ( unsigned int i = 0; i < _script.getEventsCount(); i++ )
+    {
+        QVERIFY2( !_script.isFired( i ), "Failure" );
+    }
+
+    _dataInp.controls.flaps = 1.0;
+    _script.update( TIME_STEP, _dataOut, &_dataInp );
+    QVERIFY2( _dataInp.controls.flaps == 1.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void EventScriptTest::run( double time )
+{
+    int steps = static_cast<int>( floor( time / TIME_STEP + 0.5 ) );
+
+    for ( int i = 0; i < steps; i++ )
+    {
+        _script.update( TIME_STEP, _dataOut, &_dataInp );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(EventScriptTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_eventscript.moc"
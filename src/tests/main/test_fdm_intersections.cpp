@@ -0,0 +1,173 @@
+#include <QString>
+#include <QtTest>
+
+#include <fdm/main/fdm_CollisionGeometry.h>
+#include <fdm/main/fdm_Intersections.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define LAT_0 0.9
+#define LON_0 0.3
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class IntersectionsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    IntersectionsTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getIntersections();
+    void movingDeck();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+IntersectionsTest::IntersectionsTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IntersectionsTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IntersectionsTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IntersectionsTest::getIntersections()
+{
+    fdm::Intersections isect;
+
+    isect.update( LAT_0, LON_0 );
+
+    const unsigned int count = 4;
+
+    // crossing the ground, above the ground, crossing the ground, below the ground
+    double alt_b[] = {  2.0, 5.0,  1.0, -1.0 };
+    double alt_e[] = { -1.0, 1.0, -3.0, -2.0 };
+
+    fdm::Vector3 b[ count ];
+    fdm::Vector3 e[ count ];
+    fdm::Vector3 r[ count ];
+    fdm::Vector3 n[ count ];
+
+    char hit[ count ];
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        double lat = LAT_0 + 1.0e-6 * i;
+        double lon = LON_0 - 1.0e-6 * i;
+
+        b[ i ] = fdm::WGS84::geo2wgs( lat, lon, alt_b[ i ] );
+        e[ i ] = fdm::WGS84::geo2wgs( lat, lon, alt_e[ i ] );
+    }
+
+    unsigned int hits = isect.getIntersections( count, b, e, r, n, hit, true );
+
+    QVERIFY( hits == 2 );
+
+    // batched query results are the same as single queries
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        fdm::Vector3 r_1;
+        fdm::Vector3 n_1;
+
+        bool hit_1 = FDM_SUCCESS == isect.getIntersection( b[ i ], e[ i ], &r_1, &n_1, true );
+
+        QVERIFY( hit_1 == ( hit[ i ] != 0 ) );
+
+        if ( hit_1 )
+        {
+            QVERIFY( fdm::Vector3( r[ i ] - r_1 ).getLength() < 1.0e-6 );
+            QVERIFY( fdm::Vector3( n[ i ] - n_1 ).getLength() < 1.0e-9 );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void IntersectionsTest::movingDeck()
+{
+    // 100 m x 50 m deck 20 m above sea level steaming north at 15 m/s
+    std::vector< fdm::Vector3 > vertices;
+    std::vector< fdm::UInt32 > indices;
+
+    vertices.push_back( fdm::Vector3( -50.0, -25.0, 0.0 ) );
+    vertices.push_back( fdm::Vector3(  50.0, -25.0, 0.0 ) );
+    vertices.push_back( fdm::Vector3(  50.0,  25.0, 0.0 ) );
+    vertices.push_back( fdm::Vector3( -50.0,  25.0, 0.0 ) );
+
+    indices.push_back( 0 ); indices.push_back( 1 ); indices.push_back( 2 );
+    indices.push_back( 0 ); indices.push_back( 2 ); indices.push_back( 3 );
+
+    QVERIFY( fdm::CollisionGeometry::addMesh( vertices, indices, LAT_0, LON_0, 20.0, 0.0, 15.0 ) );
+
+    fdm::Intersections isect;
+
+    // 10 s later deck origin is 150 m north
+    for ( int i = 0; i < 1000; i++ )
+    {
+        isect.update( LAT_0, LON_0 );
+        isect.step( 0.01 );
+    }
+
+    // ground plane below deck origin at time 0 is sea level again
+    isect.update( LAT_0, LON_0 );
+
+    fdm::WGS84::Geo pos_0 = { LAT_0, LON_0, 0.0 };
+    fdm::WGS84::Geo pos_1 = fdm::WGS84::getGeoOffset( pos_0, 0.0, 150.0, 0.0 );
+
+    fdm::Vector3 b[ 2 ];
+    fdm::Vector3 e[ 2 ];
+    fdm::Vector3 r[ 2 ];
+    fdm::Vector3 n[ 2 ];
+    fdm::Vector3 v[ 2 ];
+
+    char hit[ 2 ];
+
+    b[ 0 ] = fdm::WGS84::geo2wgs( pos_0.lat, pos_0.lon, 25.0 );
+    e[ 0 ] = fdm::WGS84::geo2wgs( pos_0.lat, pos_0.lon, 15.0 );
+    b[ 1 ] = fdm::WGS84::geo2wgs( pos_1.lat, pos_1.lon, 25.0 );
+    e[ 1 ] = fdm::WGS84::geo2wgs( pos_1.lat, pos_1.lon, 15.0 );
+
+    // repeated queries are resolved by cached contacts
+    for ( int j = 0; j < 3; j++ )
+    {
+        unsigned int hits = isect.getIntersections( 2, b, e, r, n, hit, true, v );
+
+        QVERIFY( hits == 1 );
+        QVERIFY( hit[ 0 ] == 0 );
+        QVERIFY( hit[ 1 ] != 0 );
+
+        QVERIFY( fabs( fdm::WGS84::wgs2geo( r[ 1 ] ).alt - 20.0 ) < 1.0e-3 );
+
+        fdm::Vector3 v_ned = fdm::WGS84( pos_1 ).getWGS2NED() * v[ 1 ];
+
+        QVERIFY( fabs( v_ned.x() - 15.0 ) < 1.0e-3 );
+        QVERIFY( fabs( v_ned.y() ) < 1.0e-3 );
+        QVERIFY( v[ 0 ].getLength() < 1.0e-9 );
+    }
+
+    fdm::CollisionGeometry::clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(IntersectionsTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_intersections.moc"
@@ -0,0 +1,331 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <fdm/main/fdm_Recorder.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+#define STEPS 1000
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class RecorderTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    RecorderTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void recordReplayBin();
+    void seekReplay();
+    void scrubReplay();
+    void exportText();
+    void recordReplayCompressed();
+    void seekShortReplay();
+
+private:
+
+    std::string _binFile;
+    std::string _oneFile;
+    std::string _csvFile;
+    std::string _zipFile;
+
+    void record( const char *file, double timeStep = 0.1, bool compressed = false );
+
+    static double getValue( double t ) { return sin( t ); }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+RecorderTest::RecorderTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::initTestCase()
+{
+    _binFile = "test_fdm_recorder.rec";
+    _csvFile = "test_fdm_recorder.csv";
+    _zipFile = "test_fdm_recorder_z.rec";
+    _oneFile = "test_fdm_recorder_1.rec";
+
+    record( _binFile.c_str() );
+    record( _oneFile.c_str(), 2.0 * STEPS * TIME_STEP );
+    record( _zipFile.c_str(), 0.0, true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::cleanupTestCase()
+{
+    remove( _binFile.c_str() );
+    remove( _csvFile.c_str() );
+    remove( _zipFile.c_str() );
+    remove( _oneFile.c_str() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::recordReplayBin()
+{
+    double value = 0.0;
+    bool flag = false;
+
+    fdm::Recorder recorder( 0.1 );
+
+    recorder.addVariable( new fdm::Recorder::Variable< double >( "value", &value, 6 ) );
+    recorder.addVariable( new fdm::Recorder::Variable< bool >( "flag", &flag ) );
+
+    recorder.initialize( fdm::DataInp::Recording::Replay, _binFile.c_str() );
+
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+
+    double time = 0.0;
+
+    for ( int i = 0; i < STEPS - 20 && recorder.isReplaying(); i++ )
+    {
+        recorder.step( TIME_STEP );
+
+        // linear interpolation between 0.1 s records
+        QVERIFY2( fabs( value - getValue( time ) ) < 2.0e-3, "Failure" );
+
+        time += TIME_STEP;
+    }
+
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::seekReplay()
+{
+    double value = 0.0;
+    bool flag = false;
+
+    fdm::Recorder recorder( 0.1 );
+
+    recorder.addVariable( new fdm::Recorder::Variable< double >( "value", &value, 6 ) );
+    recorder.addVariable( new fdm::Recorder::Variable< bool >( "flag", &flag ) );
+
+    recorder.initialize( fdm::DataInp::Recording::Replay, _binFile.c_str() );
+
+    QVERIFY2( recorder.getEndTime() > 9.8, "Failure" );
+
+    // forward
+    QVERIFY2( recorder.seek( 7.33 ), "Failure" );
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+    QVERIFY2( fabs( value - getValue( 7.33 ) ) < 2.0e-3, "Failure" );
+
+    // backward
+    QVERIFY2( recorder.seek( 2.05 ), "Failure" );
+    QVERIFY2( fabs( value - getValue( 2.05 ) ) < 2.0e-3, "Failure" );
+
+    // replay continues from seek time
+    double time = recorder.getTime();
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        recorder.step( TIME_STEP );
+        QVERIFY2( fabs( value - getValue( time ) ) < 2.0e-3, "Failure" );
+        time += TIME_STEP;
+    }
+
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::scrubReplay()
+{
+    double value = 0.0;
+    bool flag = false;
+
+    fdm::Recorder recorder( 0.1 );
+
+    recorder.addVariable( new fdm::Recorder::Variable< double >( "value", &value, 6 ) );
+    recorder.addVariable( new fdm::Recorder::Variable< bool >( "flag", &flag ) );
+
+    recorder.initialize( fdm::DataInp::Recording::Replay, _binFile.c_str() );
+    recorder.seek( 6.0 );
+
+    // backwards at double speed
+    recorder.setRate( -2.0 );
+
+    double time = recorder.getTime();
+
+    for ( int i = 0; i < 200; i++ )
+    {
+        recorder.step( TIME_STEP );
+        QVERIFY2( fabs( value - getValue( time ) ) < 2.0e-3, "Failure" );
+        time -= 2.0 * TIME_STEP;
+    }
+
+    // fast forward
+    recorder.setRate( 5.0 );
+
+    time = recorder.getTime();
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        recorder.step( TIME_STEP );
+        QVERIFY2( fabs( value - getValue( time ) ) < 2.0e-3, "Failure" );
+        time += 5.0 * TIME_STEP;
+    }
+
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::exportText()
+{
+    QVERIFY2( !fdm::Recorder::isTextFile( _binFile.c_str() ), "Failure" );
+    QVERIFY2(  fdm::Recorder::isTextFile( _csvFile.c_str() ), "Failure" );
+
+    QVERIFY2( FDM_SUCCESS == fdm::Recorder::exportText( _binFile.c_str(), _csvFile.c_str() ), "Failure" );
+
+    std::ifstream csv( _csvFile.c_str() );
+    std::string line;
+
+    std::getline( csv, line );
+    QVERIFY2( line == "\"time\";\"value\";\"flag\"", "Failure" );
+
+    int lines = 0;
+    while ( std::getline( csv, line ) ) lines++;
+
+    QVERIFY2( lines > 90 && lines < 110, "Failure" );
+
+    // text replay of exported file
+    double value = 0.0;
+    bool flag = false;
+
+    fdm::Recorder recorder( 0.1 );
+
+    recorder.addVariable( new fdm::Recorder::Variable< double >( "value", &value, 6 ) );
+    recorder.addVariable( new fdm::Recorder::Variable< bool >( "flag", &flag ) );
+
+    recorder.initialize( fdm::DataInp::Recording::Replay, _csvFile.c_str() );
+
+    for ( int i = 0; i <= 100; i++ ) recorder.step( TIME_STEP );
+
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+    QVERIFY2( fabs( value - getValue( 1.0 ) ) < 2.0e-3, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::recordReplayCompressed()
+{
+    std::ifstream bin( _binFile.c_str(), std::ios_base::binary | std::ios_base::ate );
+    std::ifstream zip( _zipFile.c_str(), std::ios_base::binary | std::ios_base::ate );
+
+    // compressed file has ten times more frames
+    QVERIFY2( zip.tellg() > 0, "Failure" );
+    QVERIFY2( zip.tellg() < bin.tellg(), "Failure" );
+
+    double value = 0.0;
+    bool flag = false;
+
+    fdm::Recorder recorder( 0.1 );
+
+    recorder.addVariable( new fdm::Recorder::Variable< double >( "value", &value, 6 ) );
+    recorder.addVariable( new fdm::Recorder::Variable< bool >( "flag", &flag ) );
+
+    recorder.initialize( fdm::DataInp::Recording::Replay, _zipFile.c_str() );
+
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+    QVERIFY2( recorder.getEndTime() > 9.98, "Failure" );
+
+    double time = 0.0;
+
+    for ( int i = 0; i < STEPS - 2 && recorder.isReplaying(); i++ )
+    {
+        recorder.step( TIME_STEP );
+        QVERIFY2( fabs( value - getValue( time ) ) < 1.0e-5, "Failure" );
+        time += TIME_STEP;
+    }
+
+    QVERIFY2( recorder.isReplaying(), "Failure" );
+
+    // seeking across blocks
+    QVERIFY2( recorder.seek( 3.37 ), "Failure" );
+    QVERIFY2( fabs( value - getValue( 3.37 ) ) < 1.0e-5, "Failure" );
+
+    QVERIFY2( FDM_SUCCESS == fdm::Recorder::exportText( _zipFile.c_str(), _csvFile.c_str() ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::seekShortReplay()
+{
+    double value = 0.0;
+    bool flag = false;
+
+    fdm::Recorder recorder( 0.1 );
+
+    recorder.addVariable( new fdm::Recorder::Variable< double >( "value", &value, 6 ) );
+    recorder.addVariable( new fdm::Recorder::Variable< bool >( "flag", &flag ) );
+
+    // single frame recording
+    recorder.initialize( fdm::DataInp::Recording::Replay, _oneFile.c_str() );
+
+    QVERIFY2( !recorder.seek( 1.0 ), "Failure" );
+
+    for ( int i = 0; i < 10; i++ )
+    {
+        recorder.step( TIME_STEP );
+    }
+
+    QVERIFY2( fabs( value - getValue( 0.0 ) ) < 2.0e-3, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RecorderTest::record( const char *file, double timeStep, bool compressed )
+{
+    double value = 0.0;
+    bool flag = false;
+
+    fdm::Recorder recorder( timeStep, compressed );
+
+    recorder.addVariable( new fdm::Recorder::Variable< double >( "value", &value, 6 ) );
+    recorder.addVariable( new fdm::Recorder::Variable< bool >( "flag", &flag ) );
+
+    recorder.initialize( fdm::DataInp::Recording::Record, file );
+
+    double time = 0.0;
+
+    for ( int i = 0; i < STEPS; i++ )
+    {
+        value = getValue( time );
+        flag = value > 0.0;
+
+        recorder.step( TIME_STEP );
+        time += TIME_STEP;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(RecorderTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_recorder.moc"
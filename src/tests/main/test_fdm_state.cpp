@@ -0,0 +1,248 @@
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/fdm_Manager.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TIME_STEP 0.01
+#define INIT_STEPS 10000
+#define WARM_STEPS 200
+#define TEST_STEPS 300
+#define SNAP_STEPS 50
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class StateTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    typedef std::vector< double > State;
+
+    StateTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void stateAW101();
+    void stateC130();
+    void stateC172();
+    void stateF16();
+    void stateF35A();
+    void stateP51();
+    void statePW5();
+    void stateR44();
+    void stateUH60();
+#   ifdef FDM_TEST
+    void stateXF();
+    void stateXH();
+#   endif
+
+private:
+
+    fdm::DataInp _dataInp;
+    fdm::DataOut _dataOut;
+
+    void checkState( fdm::DataInp::AircraftType aircraftType );
+
+    void initDataInp( fdm::DataInp::AircraftType aircraftType );
+
+    void run( fdm::Manager *manager, std::vector< State > *snaps,
+              std::vector< fdm::DataOut::Flight > *flight );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+StateTest::StateTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateTest::stateAW101() { checkState( fdm::DataInp::AW101 ); }
+void StateTest::stateC130()  { checkState( fdm::DataInp::C130  ); }
+void StateTest::stateC172()  { checkState( fdm::DataInp::C172  ); }
+void StateTest::stateF16()   { checkState( fdm::DataInp::F16   ); }
+void StateTest::stateF35A()  { checkState( fdm::DataInp::F35A  ); }
+void StateTest::stateP51()   { checkState( fdm::DataInp::P51   ); }
+void StateTest::statePW5()   { checkState( fdm::DataInp::PW5   ); }
+void StateTest::stateR44()   { checkState( fdm::DataInp::R44   ); }
+void StateTest::stateUH60()  { checkState( fdm::DataInp::UH60  ); }
+#ifdef FDM_TEST
+void StateTest::stateXF()    { checkState( fdm::DataInp::XF    ); }
+void StateTest::stateXH()    { checkState( fdm::DataInp::XH    ); }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateTest::checkState( fdm::DataInp::AircraftType aircraftType )
+{
+    initDataInp( aircraftType );
+
+    fdm::Manager manager( &_dataInp, &_dataOut );
+    manager.setVerbose( false );
+    manager.setBackgroundBuild( false );
+
+    _dataInp.stateInp = fdm::DataInp::Init;
+
+    for ( int i = 0; i < INIT_STEPS && _dataOut.stateOut != fdm::DataOut::Ready; i++ )
+    {
+        manager.step( TIME_STEP );
+    }
+
+    QVERIFY2( _dataOut.stateOut == fdm::DataOut::Ready, "Failure" );
+
+    _dataInp.stateInp = fdm::DataInp::Work;
+
+    // flying for a while, so all the submodels states are developed
+    for ( int i = 0; i < WARM_STEPS; i++ )
+    {
+        manager.step( TIME_STEP );
+    }
+
+    QVERIFY2( _dataOut.stateOut == fdm::DataOut::Working, "Failure" );
+
+    unsigned int size = manager.getStateSize();
+
+    QVERIFY2( size > 0, "Failure" );
+
+    State state( size );
+    State again( size );
+
+    QVERIFY2( manager.saveState( &state[ 0 ] ) == FDM_SUCCESS, "Failure" );
+
+    std::vector< State > snaps_1;
+    std::vector< State > snaps_2;
+
+    std::vector< fdm::DataOut::Flight > flight_1;
+    std::vector< fdm::DataOut::Flight > flight_2;
+
+    run( &manager, &snaps_1, &flight_1 );
+
+    QVERIFY2( manager.restoreState( &state[ 0 ] ) == FDM_SUCCESS, "Failure" );
+
+    // saving right after restoring has to give the same state
+    QVERIFY2( manager.getStateSize() == size, "Failure" );
+    QVERIFY2( manager.saveState( &again[ 0 ] ) == FDM_SUCCESS, "Failure" );
+    QVERIFY2( memcmp( &state[ 0 ], &again[ 0 ], sizeof(double) * size ) == 0, "Failure" );
+
+    run( &manager, &snaps_2, &flight_2 );
+
+    // the same steps after restoring have to give bit-exact results
+    QVERIFY2( snaps_1.size() == snaps_2.size(), "Failure" );
+
+    for ( unsigned int i = 0; i < snaps_1.size(); i++ )
+    {
+        QVERIFY2( memcmp( &snaps_1[ i ][ 0 ], &snaps_2[ i ][ 0 ], sizeof(double) * size ) == 0, "Failure" );
+    }
+
+    for ( unsigned int i = 0; i < flight_1.size(); i++ )
+    {
+        // doubles are compared bitwise, flags separately (struct padding)
+        QVERIFY2( memcmp( &flight_1[ i ], &flight_2[ i ], offsetof(fdm::DataOut::Flight, onGround) ) == 0, "Failure" );
+        QVERIFY2( flight_1[ i ].onGround == flight_2[ i ].onGround, "Failure" );
+        QVERIFY2( flight_1[ i ].stall    == flight_2[ i ].stall    , "Failure" );
+    }
+
+    _dataInp.stateInp = fdm::DataInp::Stop;
+    manager.step( TIME_STEP );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateTest::initDataInp( fdm::DataInp::AircraftType aircraftType )
+{
+    memset( &_dataInp, 0, sizeof(fdm::DataInp) );
+    memset( &_dataOut, 0, sizeof(fdm::DataOut) );
+
+    _dataInp.aircraftType = aircraftType;
+
+    _dataInp.initial.latitude     = 0.0;
+    _dataInp.initial.longitude    = 0.0;
+    _dataInp.initial.altitude_agl = 300.0;
+    _dataInp.initial.heading      = 0.0;
+    _dataInp.initial.airspeed     = 40.0;
+    _dataInp.initial.engineOn     = true;
+
+    // gusty weather, so turbulence states are also covered
+    _dataInp.environment.temperature_0  = 288.15;
+    _dataInp.environment.pressure_0     = 101325.0;
+    _dataInp.environment.wind_direction = 0.5;
+    _dataInp.environment.wind_speed     = 5.0;
+    _dataInp.environment.turbulence     = fdm::DataInp::Environment::TurbulenceModerate;
+    _dataInp.environment.seed           = 1;
+
+    // sea level ground at the equator and the prime meridian
+    _dataInp.ground.elevation = 0.0;
+    _dataInp.ground.r_x_wgs = 6378137.0;
+    _dataInp.ground.n_x_wgs = 1.0;
+
+    _dataInp.controls.collective = 0.5;
+    _dataInp.controls.lgh = true;
+
+    for ( int i = 0; i < FDM_MAX_ENGINES; i++ )
+    {
+        _dataInp.engine[ i ].throttle  = 0.8;
+        _dataInp.engine[ i ].mixture   = 1.0;
+        _dataInp.engine[ i ].propeller = 1.0;
+        _dataInp.engine[ i ].fuel      = true;
+        _dataInp.engine[ i ].ignition  = true;
+    }
+
+    _dataInp.masses.pilot [ 0 ] = 80.0;
+    _dataInp.masses.tank  [ 0 ] = 100.0;
+    _dataInp.masses.tank  [ 1 ] = 100.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateTest::run( fdm::Manager *manager, std::vector< State > *snaps,
+                     std::vector< fdm::DataOut::Flight > *flight )
+{
+    for ( int i = 0; i < TEST_STEPS; i++ )
+    {
+        // exciting controls, so control systems filters have something to do
+        _dataInp.controls.roll  = 0.2 * sin( 0.05 * i );
+        _dataInp.controls.pitch = 0.1 * sin( 0.03 * i );
+        _dataInp.controls.yaw   = 0.1 * sin( 0.07 * i );
+
+        manager->step( TIME_STEP );
+
+        flight->push_back( _dataOut.flight );
+
+        if ( ( i + 1 ) % SNAP_STEPS == 0 )
+        {
+            State state( manager->getStateSize() );
+            manager->saveState( &state[ 0 ] );
+            snaps->push_back( state );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(StateTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_state.moc"
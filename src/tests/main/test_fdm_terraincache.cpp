@@ -0,0 +1,201 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include <fdm/main/fdm_TerrainCache.h>
+#include <fdm/utils/fdm_WGS84.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define LAT_0 0.9
+#define LON_0 0.3
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Terrain which elevation is linear in latitude and longitude. */
+class PlaneSampler : public fdm::TerrainCache::Sampler
+{
+public:
+
+    static double getElevation( double lat, double lon )
+    {
+        return 100.0 + 2.0e5 * ( lat - LAT_0 ) - 1.0e5 * ( lon - LON_0 );
+    }
+
+    bool sample( double lat, double lon, double *elev, fdm::Vector3 *norm_wgs )
+    {
+        (*elev) = getElevation( lat, lon );
+        (*norm_wgs) = fdm::WGS84( fdm::WGS84::geo2wgs( lat, lon, 0.0 ) ).getNorm_WGS();
+
+        return true;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TerrainCacheTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    TerrainCacheTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getElevation();
+    void tileEdges();
+    void moveTile();
+    void predictTile();
+
+private:
+
+    bool waitReady( fdm::TerrainCache *cache, double lat, double lon,
+                    double vel_n = 0.0 );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TerrainCacheTest::TerrainCacheTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCacheTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCacheTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCacheTest::getElevation()
+{
+    fdm::TerrainCache cache( new PlaneSampler(), 17, 10.0 );
+
+    double elev = 0.0;
+    fdm::Vector3 norm;
+
+    QVERIFY2( !cache.getElevation( LAT_0, LON_0, &elev, &norm ), "Failure" );
+
+    QVERIFY2( waitReady( &cache, LAT_0, LON_0 ), "Failure" );
+
+    // bilinear interpolation is exact for linear terrain
+    for ( int i = -5; i <= 5; i++ )
+    {
+        double lat = LAT_0 + i * 1.0e-6;
+        double lon = LON_0 - i * 1.3e-6;
+
+        QVERIFY2( cache.getElevation( lat, lon, &elev, &norm ), "Failure" );
+        QVERIFY2( fabs( elev - PlaneSampler::getElevation( lat, lon ) ) < 1.0e-6, "Failure" );
+        QVERIFY2( fabs( norm.getLength() - 1.0 ) < 1.0e-9, "Failure" );
+    }
+
+    // outside of the tile (approx. 160 m wide)
+    QVERIFY2( !cache.getElevation( LAT_0 + 1.0e-4, LON_0, &elev, &norm ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCacheTest::tileEdges()
+{
+    fdm::TerrainCache cache( new PlaneSampler(), 17, 10.0 );
+
+    double elev = 0.0;
+    fdm::Vector3 norm;
+
+    QVERIFY2( waitReady( &cache, LAT_0, LON_0 ), "Failure" );
+
+    int inside = 0;
+
+    // sweep across tile edges (tile approx. 1.25e-5 rad half wide)
+    for ( int i = -1500; i <= 1500; i++ )
+    {
+        double lat = LAT_0 + i * 1.0e-8;
+        double lon = LON_0 + i * 2.0e-8;
+
+        if ( cache.getElevation( lat, lon, &elev, &norm ) )
+        {
+            QVERIFY2( fabs( elev - PlaneSampler::getElevation( lat, lon ) ) < 1.0e-6, "Failure" );
+            inside++;
+        }
+    }
+
+    QVERIFY2( inside > 0 && inside < 3001, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCacheTest::moveTile()
+{
+    fdm::TerrainCache cache( new PlaneSampler(), 17, 10.0 );
+
+    double elev = 0.0;
+    fdm::Vector3 norm;
+
+    QVERIFY2( waitReady( &cache, LAT_0, LON_0 ), "Failure" );
+
+    // approx. 640 m north
+    double lat = LAT_0 + 1.0e-4;
+
+    QVERIFY2( waitReady( &cache, lat, LON_0 ), "Failure" );
+    QVERIFY2( cache.getElevation( lat, LON_0, &elev, &norm ), "Failure" );
+    QVERIFY2( fabs( elev - PlaneSampler::getElevation( lat, LON_0 ) ) < 1.0e-6, "Failure" );
+    QVERIFY2( !cache.getElevation( LAT_0, LON_0, &elev, &norm ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TerrainCacheTest::predictTile()
+{
+    // tile approx. 160 m wide, prediction limited to approx. 40 m ahead
+    fdm::TerrainCache cache( new PlaneSampler(), 17, 10.0, 1.0 );
+
+    double elev = 0.0;
+    fdm::Vector3 norm;
+
+    QVERIFY2( waitReady( &cache, LAT_0, LON_0, 100.0 ), "Failure" );
+
+    // tile is centered ahead of ownship
+    QVERIFY2(  cache.getElevation( LAT_0 + 1.7e-5, LON_0, &elev, &norm ), "Failure" );
+    QVERIFY2( !cache.getElevation( LAT_0 - 1.0e-5, LON_0, &elev, &norm ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TerrainCacheTest::waitReady( fdm::TerrainCache *cache, double lat, double lon,
+                                  double vel_n )
+{
+    double elev = 0.0;
+    fdm::Vector3 norm;
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+        cache->update( lat, lon, vel_n );
+
+        if ( cache->getElevation( lat, lon, &elev, &norm ) ) return true;
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(TerrainCacheTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_terraincache.moc"
@@ -44,6 +44,8 @@ mkdir temp_dest_dir
 
 ################################################################################
 
+makeAllTestsInDir bench
+makeAllTestsInDir capi
 makeAllTestsInDir ctrl
 makeAllTestsInDir main
 makeAllTestsInDir models
@@ -42,6 +42,8 @@ private Q_SLOTS:
     void stdConditions();
 
     void modifiedSeaLevelConditions();
+
+    void tableMode();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -215,6 +217,40 @@ void AtmosphereTest::modifiedSeaLevelConditions()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void AtmosphereTest::tableMode()
+{
+    fdm::Atmosphere atmosphere_table;
+
+    atmosphere_table.setTableMode( true );
+
+    for ( int j = 0; j < 3; j++ )
+    {
+        double p_0 = fdm::Atmosphere::_std_sl_p + 1000.0 * ( j - 1 );
+        double t_0 = fdm::Atmosphere::_std_sl_t + 10.0   * ( j - 1 );
+
+        _atmosphere->setPressureSL( p_0 );
+        _atmosphere->setTemperatureSL( t_0 );
+
+        atmosphere_table.setPressureSL( p_0 );
+        atmosphere_table.setTemperatureSL( t_0 );
+
+        for ( double h = -1000.0; h < 84000.0; h += 123.4 )
+        {
+            _atmosphere->update( h );
+            atmosphere_table.update( h );
+
+            QVERIFY2( fabs( atmosphere_table.getTemperature()  - _atmosphere->getTemperature()  ) < 1.0e-9 * _atmosphere->getTemperature()  , "Failure" );
+            QVERIFY2( fabs( atmosphere_table.getPressure()     - _atmosphere->getPressure()     ) < 1.0e-5 * _atmosphere->getPressure()     , "Failure" );
+            QVERIFY2( fabs( atmosphere_table.getDensity()      - _atmosphere->getDensity()      ) < 1.0e-5 * _atmosphere->getDensity()      , "Failure" );
+            QVERIFY2( fabs( atmosphere_table.getSpeedOfSound() - _atmosphere->getSpeedOfSound() ) < 1.0e-5 * _atmosphere->getSpeedOfSound() , "Failure" );
+            QVERIFY2( fabs( atmosphere_table.getDynViscosity() - _atmosphere->getDynViscosity() ) < 1.0e-5 * _atmosphere->getDynViscosity() , "Failure" );
+            QVERIFY2( fabs( atmosphere_table.getKinViscosity() - _atmosphere->getKinViscosity() ) < 1.0e-5 * _atmosphere->getKinViscosity() , "Failure" );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 QTEST_APPLESS_MAIN(AtmosphereTest)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,160 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <iostream>
+
+#include <fdm/models/fdm_MainRotor.h>
+#include <fdm/xml/fdm_XmlDoc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class MainRotorInflowTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    MainRotorInflowTest();
+
+private:
+
+    void step( fdm::MainRotor *rotor, double timeStep, const fdm::Vector3 &vel_bas );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void hover();
+    void forwardFlight();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+MainRotorInflowTest::MainRotorInflowTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorInflowTest::step( fdm::MainRotor *rotor, double timeStep,
+                                const fdm::Vector3 &vel_bas )
+{
+    rotor->update( timeStep, 53.0, 0.0, 0.12, 0.0, 0.0 );
+    rotor->computeForceAndMoment( vel_bas,
+                                  fdm::Vector3(),
+                                  fdm::Vector3(),
+                                  fdm::Vector3(),
+                                  vel_bas,
+                                  fdm::Vector3(),
+                                  fdm::Vector3( 0.0, 0.0, 9.81 ),
+                                  1.225 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorInflowTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorInflowTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorInflowTest::hover()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_mainrotor_inflow.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+
+    fdm::MainRotor rotor;
+    rotor.readData( rootNode );
+
+    QVERIFY( rotor.getDynamicInflow() );
+
+    fdm::Vector3 vel_bas( 0.0, 0.0, 0.0 );
+
+    // inflow states are initialized after momentum theory converged
+    for ( int i = 0; i < 100; i++ )
+    {
+        step( &rotor, 0.01, vel_bas );
+    }
+
+    double lambda_qs = rotor.getLambda0();
+    double thrust_qs = rotor.getThrust();
+
+    QVERIFY( lambda_qs > 0.0 );
+
+    // inflow should stay in equilibrium
+    for ( int i = 0; i < 1000; i++ )
+    {
+        step( &rotor, 0.01, vel_bas );
+    }
+
+    cout << lambda_qs << " " << rotor.getLambda0() << endl;
+    cout << thrust_qs << " " << rotor.getThrust() << endl;
+
+    QVERIFY( fabs( rotor.getLambda0() - lambda_qs ) < 1.0e-4 );
+    QVERIFY( fabs( rotor.getThrust() - thrust_qs ) < 1.0e-2 * thrust_qs );
+    QVERIFY( fabs( rotor.getLambda1c() ) < 1.0e-9 );
+    QVERIFY( fabs( rotor.getLambda1s() ) < 1.0e-9 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorInflowTest::forwardFlight()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_mainrotor_inflow.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+
+    fdm::MainRotor rotor;
+    rotor.readData( rootNode );
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        step( &rotor, 0.01, fdm::Vector3() );
+    }
+
+    double lambda_hover = rotor.getLambda0();
+
+    // inflow lags behind thrust change after sudden airspeed increase
+    fdm::Vector3 vel_bas( 30.0, 0.0, 0.0 );
+
+    step( &rotor, 0.01, vel_bas );
+    QVERIFY( fabs( rotor.getLambda0() - lambda_hover ) < 1.0e-3 );
+
+    for ( int i = 0; i < 2000; i++ )
+    {
+        step( &rotor, 0.01, vel_bas );
+    }
+
+    double lambda_0  = rotor.getLambda0();
+    double lambda_1c = rotor.getLambda1c();
+
+    // steady state (Pitt, Peters)
+    double mu  = 30.0 / ( 53.0 * 5.0 );
+    double chi = rotor.getWakeSkew();
+
+    double lambda_1c_ss = ( 15.0 * M_PI / 32.0 ) * tan( 0.5 * chi ) * lambda_0;
+
+    cout << lambda_hover << " " << lambda_0 << " " << mu << endl;
+    cout << lambda_1c << " " << lambda_1c_ss << endl;
+
+    QVERIFY( lambda_0 < lambda_hover );
+    QVERIFY( lambda_1c > 0.0 );
+    QVERIFY( fabs( lambda_1c - lambda_1c_ss ) < 1.0e-2 * lambda_1c_ss );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(MainRotorInflowTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_mainrotor_inflow.moc"
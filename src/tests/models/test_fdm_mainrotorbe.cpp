@@ -0,0 +1,180 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <iostream>
+
+#include <fdm/models/fdm_MainRotorBE.h>
+#include <fdm/xml/fdm_XmlDoc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class MainRotorBETest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /** Exposes adaptive number of sub-steps. */
+    class Rotor : public fdm::MainRotorBE
+    {
+    public:
+
+        inline void setState( double omega, const fdm::Vector3 &vel_air_ras )
+        {
+            _omega = omega;
+            _vel_air_ras = vel_air_ras;
+        }
+
+        using fdm::MainRotorBE::getAdaptiveSteps;
+    };
+
+    MainRotorBETest();
+
+private:
+
+    void step( Rotor *rotor, double timeStep, double omega,
+               const fdm::Vector3 &vel_bas );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void adaptiveSteps();
+    void adaptiveStepsUpdate();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+MainRotorBETest::MainRotorBETest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorBETest::step( Rotor *rotor, double timeStep, double omega,
+                            const fdm::Vector3 &vel_bas )
+{
+    rotor->update( timeStep,
+                   vel_bas,
+                   fdm::Vector3(),
+                   fdm::Vector3(),
+                   fdm::Vector3(),
+                   fdm::Vector3(),
+                   fdm::Vector3( 0.0, 0.0, 9.81 ),
+                   omega,
+                   0.0,
+                   1.225,
+                   0.1,
+                   0.0,
+                   0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorBETest::initTestCase()
+{
+    fdm::MainRotorBE::setParallelEnabled( false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorBETest::cleanupTestCase()
+{
+    fdm::MainRotorBE::setParallelEnabled( true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorBETest::adaptiveSteps()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_mainrotorbe.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+
+    Rotor rotor;
+    rotor.readData( rootNode );
+
+    const double timeStep = 0.1;
+
+    // blades at rest, steps limited only by maximum adaptive time step
+    rotor.setState( 0.0, fdm::Vector3() );
+    QVERIFY( rotor.getAdaptiveSteps( timeStep )
+             == ceil( timeStep / fdm::MainRotorBE::_adaptiveTimeStepMax ) );
+
+    // hover, azimuth advance limit
+    const double omega = 30.0;
+
+    rotor.setState( omega, fdm::Vector3() );
+    int steps_hover = rotor.getAdaptiveSteps( timeStep );
+    QVERIFY( steps_hover == ceil( timeStep * omega / fdm::MainRotorBE::_azimuthStepMax ) );
+
+    // forward flight at advance ratio 0.4 halves the sub-step
+    rotor.setState( omega, fdm::Vector3( 0.4 * omega * 8.0, 0.0, 0.0 ) );
+    QVERIFY( rotor.getAdaptiveSteps( timeStep ) == 2 * steps_hover );
+
+    // sub-step is never smaller than minimum time step
+    rotor.setState( 1.0e6, fdm::Vector3() );
+    QVERIFY( rotor.getAdaptiveSteps( timeStep )
+             == ceil( timeStep / fdm::MainRotorBE::_timeStepMin ) );
+
+    // at least one step
+    rotor.setState( omega, fdm::Vector3() );
+    QVERIFY( rotor.getAdaptiveSteps( 1.0e-6 ) == 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorBETest::adaptiveStepsUpdate()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_mainrotorbe.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+
+    Rotor rotor;
+    rotor.readData( rootNode );
+
+    const double timeStep = 0.05;
+    const double omega = 30.0;
+
+    const int steps_min = ceil( timeStep * omega / fdm::MainRotorBE::_azimuthStepMax );
+    const int steps_max = ceil( timeStep / fdm::MainRotorBE::_timeStepMin );
+
+    int steps_hover = 0;
+
+    for ( int i = 0; i < 200; i++ )
+    {
+        step( &rotor, timeStep, omega, fdm::Vector3() );
+
+        QVERIFY( rotor.getSteps() >= steps_min );
+        QVERIFY( rotor.getSteps() <= steps_max );
+
+        steps_hover = rotor.getSteps();
+    }
+
+    // settled hover is integrated with steps limited by azimuth advance
+    QVERIFY( steps_hover == steps_min );
+
+    for ( int i = 0; i < 200; i++ )
+    {
+        step( &rotor, timeStep, omega, fdm::Vector3( 50.0, 0.0, 0.0 ) );
+
+        QVERIFY( rotor.getSteps() >= steps_hover );
+        QVERIFY( rotor.getSteps() <= steps_max );
+    }
+
+    QVERIFY( rotor.getSteps() > steps_hover );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(MainRotorBETest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_mainrotorbe.moc"
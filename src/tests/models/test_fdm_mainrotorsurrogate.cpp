@@ -0,0 +1,135 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+
+#include <fdm/models/fdm_MainRotorSurrogate.h>
+#include <fdm/xml/fdm_XmlDoc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class MainRotorSurrogateTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    MainRotorSurrogateTest();
+
+private:
+
+    fdm::MainRotorSurrogate *_rotor;
+
+    double linear( const double args[], unsigned int value );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void gridPoints();
+    void interpolation();
+    void clamping();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+MainRotorSurrogateTest::MainRotorSurrogateTest() :
+    _rotor ( 0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double MainRotorSurrogateTest::linear( const double args[], unsigned int value )
+{
+    // test table values are linear in all the arguments
+    double sum = 0.0;
+
+    for ( unsigned int i = 0; i < fdm::MainRotorSurrogate::_args; i++ )
+    {
+        sum += ( i + 1 ) * args[ i ];
+    }
+
+    return ( value + 1 ) * sum;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogateTest::initTestCase()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_mainrotorsurrogate.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+
+    _rotor = new fdm::MainRotorSurrogate();
+    _rotor->readData( rootNode );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogateTest::cleanupTestCase()
+{
+    if ( _rotor ) delete _rotor;
+    _rotor = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogateTest::gridPoints()
+{
+    double args[] = { 0.4, -0.1, 0.2, 0.1, -0.1 };
+    double vals[ fdm::MainRotorSurrogate::_vals ];
+
+    _rotor->getValues( args, vals );
+
+    for ( unsigned int v = 0; v < fdm::MainRotorSurrogate::_vals; v++ )
+    {
+        QVERIFY( fabs( vals[ v ] - linear( args, v ) ) < 1.0e-9 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogateTest::interpolation()
+{
+    double args[] = { 0.13, 0.02, 0.07, -0.05, 0.09 };
+    double vals[ fdm::MainRotorSurrogate::_vals ];
+
+    _rotor->getValues( args, vals );
+
+    for ( unsigned int v = 0; v < fdm::MainRotorSurrogate::_vals; v++ )
+    {
+        QVERIFY( fabs( vals[ v ] - linear( args, v ) ) < 1.0e-9 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MainRotorSurrogateTest::clamping()
+{
+    double args[] = { 0.6, -0.3, 0.1, 0.2, 0.0 };
+    double vals[ fdm::MainRotorSurrogate::_vals ];
+
+    _rotor->getValues( args, vals );
+
+    // arguments outside the table range are limited to the range
+    double args_lim[] = { 0.4, -0.1, 0.1, 0.1, 0.0 };
+
+    for ( unsigned int v = 0; v < fdm::MainRotorSurrogate::_vals; v++ )
+    {
+        QVERIFY( fabs( vals[ v ] - linear( args_lim, v ) ) < 1.0e-9 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(MainRotorSurrogateTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_mainrotorsurrogate.moc"
@@ -0,0 +1,190 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <iostream>
+
+#include <fdm/models/fdm_MainRotor.h>
+#include <fdm/models/fdm_RotorWake.h>
+#include <fdm/xml/fdm_XmlDoc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class RotorWakeTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    RotorWakeTest();
+
+private:
+
+    void step( fdm::MainRotor *rotor, fdm::RotorWake *wake,
+               const fdm::Vector3 &vel_bas );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void disabled();
+    void hover();
+    void forwardFlight();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+RotorWakeTest::RotorWakeTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWakeTest::step( fdm::MainRotor *rotor, fdm::RotorWake *wake,
+                          const fdm::Vector3 &vel_bas )
+{
+    rotor->update( 0.01, 53.0, 0.0, 0.12, 0.0, 0.0 );
+    rotor->computeForceAndMoment( vel_bas,
+                                  fdm::Vector3(),
+                                  fdm::Vector3(),
+                                  fdm::Vector3(),
+                                  vel_bas,
+                                  fdm::Vector3(),
+                                  fdm::Vector3( 0.0, 0.0, 9.81 ),
+                                  1.225 );
+    wake->update( rotor, vel_bas, fdm::Vector3() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWakeTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWakeTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWakeTest::disabled()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_rotorwake.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+    fdm::XmlNode rotorNode = rootNode.getFirstChildElement( "main_rotor" );
+
+    fdm::MainRotor rotor;
+    rotor.readData( rotorNode );
+
+    // wake model without data is disabled
+    fdm::RotorWake wake;
+
+    step( &rotor, &wake, fdm::Vector3() );
+
+    fdm::Vector3 vel_air_bas( 10.0, 0.0, 1.0 );
+    fdm::Vector3 vel_bas = wake.getVel_air_BAS( vel_air_bas, fdm::Vector3( 0.0, 0.0, 0.0 ) );
+
+    QVERIFY( !wake.isEnabled() );
+    QVERIFY( fdm::Vector3( vel_bas - vel_air_bas ).getLength() < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWakeTest::hover()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_rotorwake.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+    fdm::XmlNode rotorNode = rootNode.getFirstChildElement( "main_rotor" );
+    fdm::XmlNode wakeNode  = rootNode.getFirstChildElement( "rotor_wake" );
+
+    fdm::MainRotor rotor;
+    rotor.readData( rotorNode );
+
+    fdm::RotorWake wake;
+    wake.readData( wakeNode );
+
+    QVERIFY( wake.isEnabled() );
+
+    for ( int i = 0; i < 10; i++ )
+    {
+        step( &rotor, &wake, fdm::Vector3() );
+    }
+
+    double vel_i = rotor.getVel_i();
+
+    cout << vel_i << " " << wake.getWakeSkew() << endl;
+
+    QVERIFY( vel_i > 0.0 );
+
+    // rotor hub "plane"
+    fdm::Vector3 v_0 = wake.getVel_i_BAS( fdm::Vector3( 0.0, 0.0, -1.5 ) );
+    QVERIFY( fabs( v_0.x() ) < 1.0e-9 );
+    QVERIFY( fabs( v_0.z() - vel_i ) < 1.0e-9 );
+
+    // far wake
+    fdm::Vector3 v_f = wake.getVel_i_BAS( fdm::Vector3( 2.0, 0.0, 1000.0 ) );
+    QVERIFY( fabs( v_f.z() - 2.0 * vel_i ) < 1.0e-3 * vel_i );
+
+    // outside the wake
+    fdm::Vector3 v_o = wake.getVel_i_BAS( fdm::Vector3( -6.0, 0.0, 0.0 ) );
+    QVERIFY( v_o.getLength() < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RotorWakeTest::forwardFlight()
+{
+    fdm::XmlDoc doc( "../models/data/test_fdm_rotorwake.xml" );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+    fdm::XmlNode rotorNode = rootNode.getFirstChildElement( "main_rotor" );
+    fdm::XmlNode wakeNode  = rootNode.getFirstChildElement( "rotor_wake" );
+
+    fdm::MainRotor rotor;
+    rotor.readData( rotorNode );
+
+    fdm::RotorWake wake;
+    wake.readData( wakeNode );
+
+    fdm::Vector3 vel_bas( 10.0, 0.0, 0.0 );
+
+    for ( int i = 0; i < 10; i++ )
+    {
+        step( &rotor, &wake, vel_bas );
+    }
+
+    double chi = wake.getWakeSkew();
+
+    cout << wake.getVel_i() << " " << chi << endl;
+
+    QVERIFY( chi > 0.0 );
+
+    // wake is skewed backwards, so point just below the rear of the disc
+    // is inside the wake, while point below the front of the disc is not
+    double dz = 3.0;
+    double dx = -dz * tan( chi );
+
+    fdm::Vector3 r_in_bas  ( dx - 4.0, 0.0, -1.5 + dz );
+    fdm::Vector3 r_out_bas ( 4.0 + 5.0, 0.0, -1.5 + dz );
+
+    QVERIFY( wake.getVel_i_BAS( r_in_bas  ).z() > wake.getVel_i() );
+    QVERIFY( wake.getVel_i_BAS( r_out_bas ).getLength() < 1.0e-12 );
+
+    // component velocity relative to the air includes downwash
+    fdm::Vector3 vel_air_bas = wake.getVel_air_BAS( vel_bas, r_in_bas );
+    QVERIFY( vel_air_bas.z() < 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(RotorWakeTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_rotorwake.moc"
@@ -0,0 +1,136 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <vector>
+
+#include <fdm/models/fdm_Schrenk.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class SchrenkTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    SchrenkTest();
+
+private:
+
+    fdm::Table1 getChord( double cr, double ct, double span );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void meanAerodynamicChord();
+    void liftCoefDistTable();
+    void lazyUpdate();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+SchrenkTest::SchrenkTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Table1 SchrenkTest::getChord( double cr, double ct, double span )
+{
+    std::vector< double > y;
+    std::vector< double > c;
+
+    y.push_back( 0.0 );
+    y.push_back( 0.5 * span );
+
+    c.push_back( cr );
+    c.push_back( ct );
+
+    return fdm::Table1( y, c );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SchrenkTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SchrenkTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SchrenkTest::meanAerodynamicChord()
+{
+    fdm::Schrenk schrenk;
+
+    schrenk.setArea( 15.0 );
+    schrenk.setSpan( 10.0 );
+    schrenk.setChord( getChord( 2.0, 1.0, 10.0 ) );
+
+    QVERIFY( fabs( schrenk.getMeanAerodynamicChord()
+                 - fdm::Schrenk::getMeanAerodynamicChord( 2.0, 1.0 ) ) < 1.0e-9 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SchrenkTest::liftCoefDistTable()
+{
+    fdm::Schrenk schrenk;
+
+    schrenk.setArea( 15.0 );
+    schrenk.setSpan( 10.0 );
+    schrenk.setChord( getChord( 2.0, 1.0, 10.0 ) );
+    schrenk.setStations( 11 );
+
+    const fdm::Table1 &dist = schrenk.getLiftCoefDistTable();
+
+    QVERIFY( dist.getSize() == 11 );
+
+    // table values match analytical distribution at the stations
+    for ( unsigned int i = 0; i < dist.getSize(); i++ )
+    {
+        double y = dist.getIndexValue( i );
+        QVERIFY( fabs( dist.getValueByIndex( i ) - schrenk.getLiftCoefDist( y ) ) < 1.0e-12 );
+    }
+
+    // and are close to it between the stations
+    QVERIFY( fabs( dist.getValue( 1.25 ) - schrenk.getLiftCoefDist( 1.25 ) ) < 1.0e-2 );
+
+    // wing tip
+    QVERIFY( fabs( dist.getValue( 5.0 ) - 0.5 ) < 1.0e-9 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SchrenkTest::lazyUpdate()
+{
+    fdm::Schrenk schrenk;
+
+    schrenk.setArea( 15.0 );
+    schrenk.setSpan( 10.0 );
+    schrenk.setChord( getChord( 2.0, 1.0, 10.0 ) );
+
+    double cl_1 = schrenk.getLiftCoefDist( 2.0 );
+
+    // changing wing parameters invalidates cached values
+    schrenk.setChord( getChord( 1.5, 1.5, 10.0 ) );
+
+    double cl_2 = schrenk.getLiftCoefDist( 2.0 );
+
+    QVERIFY( fabs( cl_1 - cl_2 ) > 1.0e-3 );
+    QVERIFY( fabs( schrenk.getMeanAerodynamicChord() - 1.5 ) < 1.0e-9 );
+    QVERIFY( fabs( schrenk.getLiftCoefDistTable().getValue( 2.0 ) - cl_2 ) < 1.0e-2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(SchrenkTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_schrenk.moc"
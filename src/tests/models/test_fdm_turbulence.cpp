@@ -0,0 +1,168 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+
+#include <fdm/models/fdm_Turbulence.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define ALTITUDE 150.0
+#define DISTANCE 1.0
+#define SAMPLES  200000
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TurbulenceTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    TurbulenceTest() {}
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void none();
+    void reproducibility();
+    void intensity();
+    void continuity();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::none()
+{
+    fdm::Turbulence turb;
+
+    turb.setSeed( 1 );
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        turb.update( DISTANCE, ALTITUDE );
+
+        QVERIFY2( turb.getVel_BAS().getLength() == 0.0, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::reproducibility()
+{
+    fdm::Turbulence t1;
+    fdm::Turbulence t2;
+    fdm::Turbulence t3;
+
+    t1.setSeed( 1234 );
+    t2.setSeed( 1234 );
+    t3.setSeed( 1235 );
+
+    t1.setIntensity( fdm::Turbulence::Moderate );
+    t2.setIntensity( fdm::Turbulence::Moderate );
+    t3.setIntensity( fdm::Turbulence::Moderate );
+
+    bool differs = false;
+
+    for ( int i = 0; i < 20000; i++ )
+    {
+        t1.update( DISTANCE, ALTITUDE );
+        t2.update( DISTANCE, ALTITUDE );
+        t3.update( DISTANCE, ALTITUDE );
+
+        QVERIFY2( t1.getVel_BAS().u() == t2.getVel_BAS().u(), "Failure" );
+        QVERIFY2( t1.getVel_BAS().v() == t2.getVel_BAS().v(), "Failure" );
+        QVERIFY2( t1.getVel_BAS().w() == t2.getVel_BAS().w(), "Failure" );
+
+        if ( t1.getVel_BAS().u() != t3.getVel_BAS().u() ) differs = true;
+    }
+
+    QVERIFY2( differs, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::intensity()
+{
+    fdm::Turbulence turb;
+
+    turb.setSeed( 1 );
+    turb.setIntensity( fdm::Turbulence::Severe );
+
+    double l_uv = 0.0;
+    double l_w  = 0.0;
+    double sigma_uv = 0.0;
+    double sigma_w  = 0.0;
+
+    fdm::Turbulence::getScales( ALTITUDE, fdm::Turbulence::Severe,
+                                &l_uv, &l_w, &sigma_uv, &sigma_w );
+
+    double sum_u2 = 0.0;
+    double sum_v2 = 0.0;
+    double sum_w2 = 0.0;
+
+    // distance as long as a few thousands of scale lengths
+    for ( int i = 0; i < SAMPLES; i++ )
+    {
+        turb.update( 10.0 * DISTANCE, ALTITUDE );
+
+        sum_u2 += turb.getVel_BAS().u() * turb.getVel_BAS().u();
+        sum_v2 += turb.getVel_BAS().v() * turb.getVel_BAS().v();
+        sum_w2 += turb.getVel_BAS().w() * turb.getVel_BAS().w();
+    }
+
+    double s_u = sqrt( sum_u2 / SAMPLES );
+    double s_v = sqrt( sum_v2 / SAMPLES );
+    double s_w = sqrt( sum_w2 / SAMPLES );
+
+    QVERIFY2( fabs( s_u - sigma_uv ) < 0.1 * sigma_uv, "Failure" );
+    QVERIFY2( fabs( s_v - sigma_uv ) < 0.1 * sigma_uv, "Failure" );
+    QVERIFY2( fabs( s_w - sigma_w  ) < 0.1 * sigma_w , "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TurbulenceTest::continuity()
+{
+    fdm::Turbulence turb;
+
+    turb.setSeed( 2 );
+    turb.setIntensity( fdm::Turbulence::Severe );
+
+    turb.update( 0.0, ALTITUDE );
+    double u_prev = turb.getVel_BAS().u();
+
+    // no jumps at blocks boundaries
+    for ( int i = 0; i < SAMPLES; i++ )
+    {
+        turb.update( 0.1 * DISTANCE, ALTITUDE );
+
+        double u = turb.getVel_BAS().u();
+
+        QVERIFY2( fabs( u - u_prev ) < 0.5, "Failure" );
+
+        u_prev = u;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(TurbulenceTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_turbulence.moc"
@@ -0,0 +1,198 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+
+#include <fdm/models/fdm_Wheel.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define MASS 1000.0
+#define GRAV 9.81
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Wheel 1 m below the center of gravity with stiff strut. */
+class StiffWheel : public fdm::Wheel
+{
+public:
+
+    StiffWheel() :
+        fdm::Wheel( false )
+    {
+        _r_a_bas = fdm::Vector3( 0.0, 0.0, 0.0 );
+        _r_u_bas = fdm::Vector3( 0.0, 0.0, 1.0 );
+
+        _k = 1.0e6;
+        _c = 2.0e4;
+
+        _mu_s = 0.7;
+        _mu_k = 0.5;
+        _mu_r = 0.0;
+
+        _v_max = 0.0;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class WheelTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    WheelTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void explicitContact();
+    void implicitStrut();
+    void implicitFriction();
+
+private:
+
+    /**
+     * Simulates mass falling on the wheel (symplectic Euler).
+     * @return [m] center of gravity height above ground, NaN if diverged
+     */
+    double drop( double timeStep, bool implicit, double *h_max );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+WheelTest::WheelTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WheelTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WheelTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WheelTest::explicitContact()
+{
+    StiffWheel wheel_1;
+    StiffWheel wheel_2;
+
+    // zero contact mass is the same as explicit contact
+    wheel_2.setImplicitContact( 0.0, 0.1 );
+
+    fdm::Vector3 vel_bas( 1.0, 0.5, 0.2 );
+    fdm::Vector3 r_c_bas( 0.0, 0.0, 0.99 );
+    fdm::Vector3 n_c_bas( 0.0, 0.0, -1.0 );
+
+    wheel_1.computeForceAndMoment( vel_bas, fdm::Vector3(), r_c_bas, n_c_bas, false, false );
+    wheel_2.computeForceAndMoment( vel_bas, fdm::Vector3(), r_c_bas, n_c_bas, false, false );
+
+    QVERIFY( fdm::Vector3( wheel_1.getFor_BAS() - wheel_2.getFor_BAS() ).getLength() < 1.0e-9 );
+
+    // strut spring and damper
+    QVERIFY( fabs( wheel_1.getFor_BAS().z() + ( 1.0e6 * 0.01 + 2.0e4 * 0.2 ) ) < 1.0e-6 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WheelTest::implicitStrut()
+{
+    const double h_static = 1.0 - MASS * GRAV / 1.0e6;
+
+    double h_max = 0.0;
+
+    // explicit strut is stable at the small step only
+    double h_1 = drop( 0.005, false, &h_max );
+    QVERIFY( fabs( h_1 - h_static ) < 1.0e-3 );
+
+    // semi-implicit strut is stable at 20x larger step
+    double h_2 = drop( 0.1, true, &h_max );
+    QVERIFY( fabs( h_2 - h_static ) < 1.0e-3 );
+    QVERIFY( h_max < 1.1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WheelTest::implicitFriction()
+{
+    const double timeStep = 0.1;
+
+    StiffWheel wheel;
+
+    wheel.setImplicitContact( MASS, timeStep, fdm::Vector3( 0.0, 0.0, GRAV ) );
+
+    fdm::Vector3 r_c_bas( 0.0, 0.0, 1.0 - MASS * GRAV / 1.0e6 );
+    fdm::Vector3 n_c_bas( 0.0, 0.0, -1.0 );
+
+    // sliding sideways at 5 m/s, Coulomb friction without regularization
+    double v = 5.0;
+
+    for ( int i = 0; i < 30; i++ )
+    {
+        wheel.computeForceAndMoment( fdm::Vector3( 0.0, v, 0.0 ), fdm::Vector3(),
+                                     r_c_bas, n_c_bas, false, false );
+
+        double v_prev = v;
+
+        v += timeStep * wheel.getFor_BAS().y() / MASS;
+
+        // never reverses direction (no chatter)
+        QVERIFY( v * v_prev >= -1.0e-12 );
+        QVERIFY( fabs( v ) <= fabs( v_prev ) + 1.0e-12 );
+    }
+
+    QVERIFY( fabs( v ) < 1.0e-3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double WheelTest::drop( double timeStep, bool implicit, double *h_max )
+{
+    StiffWheel wheel;
+
+    wheel.setImplicitContact( implicit ? MASS : 0.0, timeStep, fdm::Vector3( 0.0, 0.0, GRAV ) );
+
+    fdm::Vector3 n_c_bas( 0.0, 0.0, -1.0 );
+
+    double h = 1.05;   // [m] height above ground
+    double w = 1.0;    // [m/s] descent rate
+
+    (*h_max) = 0.0;
+
+    for ( double t = 0.0; t < 5.0; t += timeStep )
+    {
+        double for_z = 0.0;
+
+        if ( h < 1.0 )
+        {
+            wheel.computeForceAndMoment( fdm::Vector3( 0.0, 0.0, w ), fdm::Vector3(),
+                                         fdm::Vector3( 0.0, 0.0, h ), n_c_bas,
+                                         false, false );
+
+            for_z = wheel.getFor_BAS().z();
+        }
+
+        w += timeStep * ( GRAV + for_z / MASS );
+        h -= timeStep * w;
+
+        if ( t > 0.5 && h > (*h_max) ) (*h_max) = h;
+    }
+
+    return h;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(WheelTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_wheel.moc"
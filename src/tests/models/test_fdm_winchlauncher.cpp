@@ -0,0 +1,145 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+
+#include <fdm/models/fdm_WinchLauncher.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define MASS 300.0
+
+#define TIME_STEP 0.05
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** Winch 1000 m ahead along x-axis with stiff cable stretched by 5 m. */
+class StiffWinch : public fdm::WinchLauncher
+{
+public:
+
+    StiffWinch()
+    {
+        _pos_wgs = fdm::Vector3( 1000.0, 0.0, 0.0 );
+
+        _stiffness = 1.0e5;
+
+        _len = 995.0;
+    }
+
+    inline double getStretch( double x ) const { return x - 1000.0 + _len; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+class WinchLauncherTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    WinchLauncherTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void explicitCable();
+    void implicitCable();
+
+private:
+
+    /**
+     * Simulates stretched cable pulling mass (symplectic Euler).
+     * @return [m/s] maximum mass velocity
+     */
+    double pull( bool implicit, double *for_max );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+WinchLauncherTest::WinchLauncherTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WinchLauncherTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WinchLauncherTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double WinchLauncherTest::pull( bool implicit, double *for_max )
+{
+    StiffWinch winch;
+
+    if ( implicit ) winch.setImplicitCable( MASS, TIME_STEP );
+
+    double x = 0.0;
+    double v = 0.0;
+
+    double v_max = 0.0;
+
+    *for_max = 0.0;
+
+    for ( int i = 0; i < 200; i++ )
+    {
+        winch.computeForceAndMoment( fdm::Matrix3x3::identityMatrix(),
+                                     fdm::Vector3( x, 0.0, 0.0 ),
+                                     fdm::Vector3( v, 0.0, 0.0 ) );
+
+        double f = winch.getFor_BAS().x();
+
+        v += TIME_STEP * f / MASS;
+        x += TIME_STEP * v;
+
+        v_max = std::max( v_max, fabs( v ) );
+        *for_max = std::max( *for_max, fabs( f ) );
+    }
+
+    return v_max;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WinchLauncherTest::explicitCable()
+{
+    // cable natural frequency is far above what time step allows
+    double v_lim = sqrt( 2.0 * 1.0e5 * 125.0 / ( 3.0 * MASS ) );
+    double f_0 = 1.0e5 * 25.0;
+
+    double for_max = 0.0;
+    double v_max = pull( false, &for_max );
+
+    QVERIFY( v_max > 1.5 * v_lim || for_max > 1.5 * f_0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WinchLauncherTest::implicitCable()
+{
+    // stored cable energy bounds mass velocity
+    double v_lim = sqrt( 2.0 * 1.0e5 * 125.0 / ( 3.0 * MASS ) );
+    double f_0 = 1.0e5 * 25.0;
+
+    double for_max = 0.0;
+    double v_max = pull( true, &for_max );
+
+    QVERIFY( v_max > 0.1 * v_lim );
+    QVERIFY( v_max <= v_lim );
+    QVERIFY( for_max <= f_0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(WinchLauncherTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_winchlauncher.moc"
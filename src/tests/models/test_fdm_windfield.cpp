@@ -0,0 +1,258 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include <fdm/fdm_Exception.h>
+#include <fdm/models/fdm_WindField.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define FILE_NAME "test_fdm_windfield.bin"
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class WindFieldTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    WindFieldTest() {}
+
+private:
+
+    fdm::WGS84::Geo _origin;
+
+    std::vector< double > _x;
+    std::vector< double > _y;
+    std::vector< double > _z;
+    std::vector< float > _vel;
+
+    static fdm::Vector3 getLinear( double x, double y, double z );
+
+    fdm::Vector3 getPos_WGS( double x, double y, double z ) const;
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getWind();
+    void outside();
+    void bracket();
+    void readFile();
+    void invalidGrid();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Vector3 WindFieldTest::getLinear( double x, double y, double z )
+{
+    return fdm::Vector3( 0.01 * x - 0.02 * y + 0.05 * z,
+                         0.03 * y + 1.0,
+                        -0.04 * z );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Vector3 WindFieldTest::getPos_WGS( double x, double y, double z ) const
+{
+    fdm::WGS84 wgs( _origin );
+    return wgs.getPos_WGS() + wgs.getNED2WGS() * fdm::Vector3( x, y, z );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::initTestCase()
+{
+    _origin.lat = 0.9;
+    _origin.lon = 0.3;
+    _origin.alt = 0.0;
+
+    // non-uniform grid
+    double x[] = { -500.0, -200.0, -50.0, 0.0, 100.0, 400.0 };
+    double y[] = { -300.0, 0.0, 50.0, 300.0 };
+    double z[] = { -200.0, -80.0, -10.0, 0.0 };
+
+    _x.assign( x, x + 6 );
+    _y.assign( y, y + 4 );
+    _z.assign( z, z + 4 );
+
+    for ( unsigned int k = 0; k < _z.size(); k++ )
+    {
+        for ( unsigned int j = 0; j < _y.size(); j++ )
+        {
+            for ( unsigned int i = 0; i < _x.size(); i++ )
+            {
+                fdm::Vector3 v = getLinear( _x[ i ], _y[ j ], _z[ k ] );
+
+                _vel.push_back( v.x() );
+                _vel.push_back( v.y() );
+                _vel.push_back( v.z() );
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::cleanupTestCase()
+{
+    remove( FILE_NAME );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::getWind()
+{
+    fdm::WindField field;
+
+    QVERIFY2( field.getWind_NED( getPos_WGS( 0.0, 0.0, -10.0 ) ).getLength() == 0.0, "Failure" );
+
+    field.setGrid( _origin, _x, _y, _z, _vel );
+
+    double pts[][ 3 ] = {
+        {    0.0,    0.0,  -10.0 },
+        {  -123.0,  77.0,  -55.0 },
+        {   350.0, -290.0, -190.0 },
+        {  -499.0,  299.0,   -1.0 }
+    };
+
+    // trilinear interpolation is exact for linear field
+    for ( int n = 0; n < 4; n++ )
+    {
+        fdm::Vector3 ref = getLinear( pts[ n ][ 0 ], pts[ n ][ 1 ], pts[ n ][ 2 ] );
+        fdm::Vector3 val = field.getWind_NED( getPos_WGS( pts[ n ][ 0 ], pts[ n ][ 1 ], pts[ n ][ 2 ] ) );
+
+        QVERIFY2( fdm::Vector3( val - ref ).getLength() < 1.0e-4, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::outside()
+{
+    fdm::WindField field;
+
+    field.setGrid( _origin, _x, _y, _z, _vel );
+
+    QVERIFY2( field.getWind_NED( getPos_WGS( 501.0,   0.0, -10.0 ) ).getLength() == 0.0, "Failure" );
+    QVERIFY2( field.getWind_NED( getPos_WGS(   0.0, 301.0, -10.0 ) ).getLength() == 0.0, "Failure" );
+    QVERIFY2( field.getWind_NED( getPos_WGS(   0.0,   0.0, -300.0 ) ).getLength() == 0.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::bracket()
+{
+    fdm::WindField field;
+
+    field.setGrid( _origin, _x, _y, _z, _vel );
+
+    fdm::WindField::Bracket bracket;
+
+    // moving point crosses cells in both directions
+    for ( int n = 0; n < 2000; n++ )
+    {
+        double x = 450.0 * sin( 0.01 * n );
+        double y = 250.0 * cos( 0.013 * n );
+        double z = -100.0 + 90.0 * sin( 0.007 * n );
+
+        fdm::Vector3 pos_wgs = getPos_WGS( x, y, z );
+
+        fdm::Vector3 v1 = field.getWind_NED( pos_wgs, &bracket );
+        fdm::Vector3 v2 = field.getWind_NED( pos_wgs );
+
+        QVERIFY2( fdm::Vector3( v1 - v2 ).getLength() < 1.0e-12, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::readFile()
+{
+    std::ofstream ofs( FILE_NAME, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+
+    fdm::UInt32 n[] = { (fdm::UInt32)_x.size(), (fdm::UInt32)_y.size(), (fdm::UInt32)_z.size(), 0 };
+
+    ofs.write( fdm::WindField::_magic, 8 );
+    ofs.write( (const char*)n, sizeof( n ) );
+    ofs.write( (const char*)&_origin.lat, sizeof( double ) );
+    ofs.write( (const char*)&_origin.lon, sizeof( double ) );
+    ofs.write( (const char*)&_origin.alt, sizeof( double ) );
+    ofs.write( (const char*)&_x[ 0 ], _x.size() * sizeof( double ) );
+    ofs.write( (const char*)&_y[ 0 ], _y.size() * sizeof( double ) );
+    ofs.write( (const char*)&_z[ 0 ], _z.size() * sizeof( double ) );
+    ofs.write( (const char*)&_vel[ 0 ], _vel.size() * sizeof( float ) );
+    ofs.close();
+
+    fdm::WindField f1;
+    fdm::WindField f2;
+
+    f1.readFile( FILE_NAME );
+    f2.setGrid( _origin, _x, _y, _z, _vel );
+
+    fdm::Vector3 pos_wgs = getPos_WGS( -123.0, 77.0, -55.0 );
+
+    QVERIFY2( f1.isLoaded(), "Failure" );
+    QVERIFY2( fdm::Vector3( f1.getWind_NED( pos_wgs ) - f2.getWind_NED( pos_wgs ) ).getLength() == 0.0, "Failure" );
+
+    // truncated file
+    ofs.open( FILE_NAME, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+    ofs.write( fdm::WindField::_magic, 8 );
+    ofs.write( (const char*)n, sizeof( n ) );
+    ofs.close();
+
+    bool thrown = false;
+
+    try
+    {
+        f1.readFile( FILE_NAME );
+    }
+    catch ( const fdm::Exception & )
+    {
+        thrown = true;
+    }
+
+    QVERIFY2( thrown, "Failure" );
+    QVERIFY2( !f1.isLoaded(), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WindFieldTest::invalidGrid()
+{
+    fdm::WindField field;
+
+    std::vector< double > x( _x );
+    x[ 2 ] = x[ 1 ];
+
+    bool thrown = false;
+
+    try
+    {
+        field.setGrid( _origin, x, _y, _z, _vel );
+    }
+    catch ( const fdm::Exception & )
+    {
+        thrown = true;
+    }
+
+    QVERIFY2( thrown, "Failure" );
+    QVERIFY2( !field.isLoaded(), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(WindFieldTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_windfield.moc"
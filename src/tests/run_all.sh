@@ -35,6 +35,8 @@ function runAllTestsInDir()
 
 ################################################################################
 
+# runAllTestsInDir bench
+runAllTestsInDir capi
 runAllTestsInDir ctrl
 runAllTestsInDir main
 # runAllTestsInDir models
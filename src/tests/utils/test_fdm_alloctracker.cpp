@@ -0,0 +1,130 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <thread>
+#include <vector>
+
+#include <fdm/utils/fdm_AllocTracker.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+// volatile pointers prevent compiler from eliding allocations
+int *volatile ptr_1 = FDM_NULLPTR;
+int *volatile ptr_2 = FDM_NULLPTR;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class AllocTrackerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    AllocTrackerTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void count();
+    void perThread();
+    void violations();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+AllocTrackerTest::AllocTrackerTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AllocTrackerTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AllocTrackerTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AllocTrackerTest::count()
+{
+    fdm::UInt64 count_0 = fdm::AllocTracker::getCount();
+
+    ptr_1 = new int;
+    ptr_2 = new int [ 16 ];
+
+    QVERIFY2( fdm::AllocTracker::getCount() == count_0 + 2, "Failure" );
+
+    delete ptr_1;
+    delete [] ptr_2;
+
+    // deallocations are not counted
+    QVERIFY2( fdm::AllocTracker::getCount() == count_0 + 2, "Failure" );
+
+    std::vector< double > v;
+    v.reserve( 100 );
+
+    QVERIFY2( fdm::AllocTracker::getCount() == count_0 + 3, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AllocTrackerTest::perThread()
+{
+    fdm::UInt64 count_0 = fdm::AllocTracker::getCount();
+    fdm::UInt64 count_t = 0;
+
+    std::thread thread( [ &count_t ]()
+    {
+        fdm::UInt64 count_0 = fdm::AllocTracker::getCount();
+        for ( int i = 0; i < 10; i++ )
+        {
+            ptr_1 = new int;
+            delete ptr_1;
+        }
+        count_t = fdm::AllocTracker::getCount() - count_0;
+    });
+
+    thread.join();
+
+    QVERIFY2( count_t == 10, "Failure" );
+
+    // thread object itself might allocate, but not the thread allocations
+    QVERIFY2( fdm::AllocTracker::getCount() - count_0 < 10, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AllocTrackerTest::violations()
+{
+    fdm::UInt64 violations_0 = fdm::AllocTracker::getViolations();
+
+    fdm::AllocTracker::setGuarded( true );
+    QVERIFY2( fdm::AllocTracker::isGuarded(), "Failure" );
+
+    ptr_1 = new int;
+
+    fdm::AllocTracker::setGuarded( false );
+    QVERIFY2( !fdm::AllocTracker::isGuarded(), "Failure" );
+
+    ptr_2 = new int;
+
+    delete ptr_1;
+    delete ptr_2;
+
+    QVERIFY2( fdm::AllocTracker::getViolations() == violations_0 + 1, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(AllocTrackerTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_alloctracker.moc"
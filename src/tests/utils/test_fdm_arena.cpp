@@ -0,0 +1,182 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_Arena.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class ArenaTestObject : public fdm::ArenaObject
+{
+public:
+
+    static int _destroyed;
+
+    ArenaTestObject() : value ( 1.0 ) {}
+    virtual ~ArenaTestObject() { _destroyed++; }
+
+    double value;
+};
+
+int ArenaTestObject::_destroyed = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class ArenaTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    ArenaTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void allocate();
+    void clear();
+    void scope();
+    void object();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+ArenaTest::ArenaTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ArenaTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ArenaTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ArenaTest::allocate()
+{
+    fdm::Arena arena( 1024 );
+
+    char *ptr_1 = static_cast< char* >( arena.allocate( 1 ) );
+    char *ptr_2 = static_cast< char* >( arena.allocate( 24 ) );
+    char *ptr_3 = static_cast< char* >( arena.allocate( 8 ) );
+
+    QVERIFY( reinterpret_cast< size_t >( ptr_1 ) % fdm::Arena::_alignment == 0 );
+    QVERIFY( reinterpret_cast< size_t >( ptr_2 ) % fdm::Arena::_alignment == 0 );
+    QVERIFY( reinterpret_cast< size_t >( ptr_3 ) % fdm::Arena::_alignment == 0 );
+
+    // contiguous allocations within a single block
+    QVERIFY( ptr_2 == ptr_1 + 16 );
+    QVERIFY( ptr_3 == ptr_2 + 32 );
+    QVERIFY( arena.getBlocksCount() == 1 );
+    QVERIFY( arena.getAllocatedSize() == 64 );
+
+    // new block when the current one is full
+    arena.allocate( 1000 );
+    QVERIFY( arena.getBlocksCount() == 2 );
+
+    // oversized allocation gets its own block
+    arena.allocate( 4096 );
+    QVERIFY( arena.getBlocksCount() == 3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ArenaTest::clear()
+{
+    fdm::Arena arena( 1024 );
+
+    void *ptr_1 = arena.allocate( 100 );
+
+    arena.allocate( 1000 );
+    arena.allocate( 1000 );
+
+    QVERIFY( arena.getBlocksCount() == 3 );
+
+    arena.clear();
+
+    QVERIFY( arena.getBlocksCount() == 1 );
+    QVERIFY( arena.getAllocatedSize() == 0 );
+
+    // the first block is reused
+    QVERIFY( arena.allocate( 100 ) == ptr_1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ArenaTest::scope()
+{
+    fdm::Arena arena_1;
+    fdm::Arena arena_2;
+
+    QVERIFY( fdm::Arena::getCurrent() == FDM_NULLPTR );
+
+    {
+        fdm::ArenaScope scope_1( &arena_1 );
+        QVERIFY( fdm::Arena::getCurrent() == &arena_1 );
+
+        {
+            fdm::ArenaScope scope_2( &arena_2 );
+            QVERIFY( fdm::Arena::getCurrent() == &arena_2 );
+        }
+
+        QVERIFY( fdm::Arena::getCurrent() == &arena_1 );
+    }
+
+    QVERIFY( fdm::Arena::getCurrent() == FDM_NULLPTR );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ArenaTest::object()
+{
+    fdm::Arena arena;
+
+    ArenaTestObject::_destroyed = 0;
+
+    ArenaTestObject *obj_heap = new ArenaTestObject();
+    ArenaTestObject *obj_arena_1 = FDM_NULLPTR;
+    ArenaTestObject *obj_arena_2 = FDM_NULLPTR;
+
+    {
+        fdm::ArenaScope scope( &arena );
+
+        obj_arena_1 = new ArenaTestObject();
+        obj_arena_2 = new ArenaTestObject();
+    }
+
+    QVERIFY( arena.getAllocatedSize() > 0 );
+
+    char *ptr_1 = reinterpret_cast< char* >( obj_arena_1 );
+    char *ptr_2 = reinterpret_cast< char* >( obj_arena_2 );
+
+    QVERIFY( ptr_2 > ptr_1 && ptr_2 - ptr_1 < 64 );
+
+    QVERIFY( obj_heap->value == 1.0 );
+    QVERIFY( obj_arena_1->value == 1.0 );
+    QVERIFY( obj_arena_2->value == 1.0 );
+
+    // destructors are called regardless of where objects were allocated
+    delete obj_heap;
+    delete obj_arena_1;
+    delete obj_arena_2;
+
+    QVERIFY( ArenaTestObject::_destroyed == 3 );
+
+    arena.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(ArenaTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_arena.moc"
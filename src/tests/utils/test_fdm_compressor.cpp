@@ -0,0 +1,141 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <cstdlib>
+#include <vector>
+
+#include <fdm/utils/fdm_Compressor.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class CompressorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    CompressorTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void empty();
+    void repetitive();
+    void random();
+    void corrupted();
+
+private:
+
+    bool roundTrip( const std::vector< char > &data, std::vector< char > *packed );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+CompressorTest::CompressorTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CompressorTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CompressorTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CompressorTest::empty()
+{
+    std::vector< char > data;
+    std::vector< char > packed;
+
+    QVERIFY2( roundTrip( data, &packed ), "Failure" );
+    QVERIFY2( packed.size() == 1, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CompressorTest::repetitive()
+{
+    std::vector< char > data;
+    std::vector< char > packed;
+
+    for ( int i = 0; i < 100000; i++ )
+    {
+        data.push_back( (char)( i % 7 ) );
+    }
+
+    QVERIFY2( roundTrip( data, &packed ), "Failure" );
+    QVERIFY2( packed.size() < data.size() / 100, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CompressorTest::random()
+{
+    std::vector< char > data;
+    std::vector< char > packed;
+
+    srand( 0 );
+
+    for ( int i = 0; i < 100000; i++ )
+    {
+        // random data with some repetitions
+        data.push_back( (char)( rand() % ( i % 3 == 0 ? 256 : 4 ) ) );
+    }
+
+    QVERIFY2( roundTrip( data, &packed ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void CompressorTest::corrupted()
+{
+    std::vector< char > data( 1000, 'a' );
+    std::vector< char > packed;
+    std::vector< char > output( data.size() );
+
+    fdm::Compressor::compress( data.data(), (unsigned int)data.size(), &packed );
+
+    // truncated
+    QVERIFY2( !fdm::Compressor::decompress( packed.data(), (unsigned int)packed.size() - 1,
+                                            output.data(), (unsigned int)output.size() ), "Failure" );
+
+    // wrong size
+    QVERIFY2( !fdm::Compressor::decompress( packed.data(), (unsigned int)packed.size(),
+                                            output.data(), (unsigned int)output.size() - 1 ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool CompressorTest::roundTrip( const std::vector< char > &data, std::vector< char > *packed )
+{
+    fdm::Compressor::compress( data.data(), (unsigned int)data.size(), packed );
+
+    std::vector< char > output( data.size() + 1 );
+
+    if ( !fdm::Compressor::decompress( packed->data(), (unsigned int)packed->size(),
+                                       output.data(), (unsigned int)data.size() ) )
+    {
+        return false;
+    }
+
+    output.resize( data.size() );
+
+    return output == data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(CompressorTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_compressor.moc"
@@ -0,0 +1,149 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <vector>
+
+#include <fdm/utils/fdm_DataRef.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class DataNodeTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    DataNodeTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void addNode();
+    void dataRef();
+    void freeze();
+    void snapshot();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+DataNodeTest::DataNodeTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNodeTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNodeTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNodeTest::addNode()
+{
+    fdm::DataNode root;
+
+    QVERIFY2( FDM_SUCCESS == root.addNode( "a.b.c", fdm::DataNode::Double ), "Failure" );
+    QVERIFY2( FDM_SUCCESS == root.addNode( "a.b.d", fdm::DataNode::Int    ), "Failure" );
+    QVERIFY2( FDM_FAILURE == root.addNode( "a.b.c", fdm::DataNode::Double ), "Failure" );
+
+    QVERIFY2( root.getCount() == 2, "Failure" );
+    QVERIFY2( root.getNode( "a.b.c" )->getIndex() == 0, "Failure" );
+    QVERIFY2( root.getNode( "a.b.d" )->getIndex() == 1, "Failure" );
+    QVERIFY2( root.getNode( "a.b" )->getIndex() == -1, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNodeTest::dataRef()
+{
+    fdm::DataNode root;
+
+    root.addNode( "x.d", fdm::DataNode::Double );
+    root.addNode( "x.b", fdm::DataNode::Bool   );
+    root.addNode( "x.i", fdm::DataNode::Int    );
+
+    fdm::DataRef d( root.getNode( "x.d" ) );
+    fdm::DataRef b( root.getNode( "x.b" ) );
+    fdm::DataRef i( root.getNode( "x.i" ) );
+    fdm::DataRef n( root.getNode( "x.n" ) );
+
+    // references created before adding nodes remain valid
+    root.addNode( "y.f", fdm::DataNode::Float );
+
+    QVERIFY2( FDM_SUCCESS == d.setDatad( 1.5 ), "Failure" );
+    QVERIFY2( FDM_SUCCESS == b.setDatab( true ), "Failure" );
+    QVERIFY2( FDM_SUCCESS == i.setValue( 7.0 ), "Failure" );
+
+    QVERIFY2( FDM_FAILURE == d.setDatai( 1 ), "Failure" );
+    QVERIFY2( FDM_FAILURE == n.setDatad( 1.0 ), "Failure" );
+
+    QVERIFY2( root.getNode( "x.d" )->getDatad() == 1.5, "Failure" );
+    QVERIFY2( root.getNode( "x.b" )->getDatab(), "Failure" );
+    QVERIFY2( root.getNode( "x.i" )->getDatai() == 7, "Failure" );
+
+    QVERIFY2( d.getDatad() == 1.5, "Failure" );
+    QVERIFY2( b.getValue() == 1.0, "Failure" );
+    QVERIFY2( i.getValue() == 7.0, "Failure" );
+
+    QVERIFY2(  d.isValid(), "Failure" );
+    QVERIFY2( !n.isValid(), "Failure" );
+    QVERIFY2( n.getDatad( 3.0 ) == 3.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNodeTest::freeze()
+{
+    fdm::DataNode root;
+
+    root.addNode( "a", fdm::DataNode::Double );
+    root.freeze();
+
+    QVERIFY2( root.isFrozen(), "Failure" );
+    QVERIFY2( FDM_FAILURE == root.addNode( "b", fdm::DataNode::Double ), "Failure" );
+    QVERIFY2( FDM_SUCCESS == root.getNode( "a" )->setDatad( 2.0 ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DataNodeTest::snapshot()
+{
+    fdm::DataNode root;
+
+    root.addNode( "a", fdm::DataNode::Double );
+    root.addNode( "b", fdm::DataNode::Int    );
+    root.freeze();
+
+    fdm::DataRef a( root.getNode( "a" ) );
+    fdm::DataRef b( root.getNode( "b" ) );
+
+    a.setDatad( 1.0 );
+    b.setDatai( 2 );
+
+    std::vector< char > buffer( root.getSnapshotSize() );
+    root.getSnapshot( buffer.data() );
+
+    a.setDatad( 3.0 );
+    b.setDatai( 4 );
+
+    root.setSnapshot( buffer.data() );
+
+    QVERIFY2( a.getDatad() == 1.0, "Failure" );
+    QVERIFY2( b.getDatai() == 2, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(DataNodeTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_datanode.moc"
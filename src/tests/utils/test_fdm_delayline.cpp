@@ -0,0 +1,102 @@
+#include <cmath>
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_DelayLine.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class DelayLineTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    DelayLineTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void get();
+    void getValue();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+DelayLineTest::DelayLineTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DelayLineTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DelayLineTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DelayLineTest::get()
+{
+    fdm::DelayLine< 4 > delay;
+
+    QVERIFY2( delay.getCount() == 0, "Failure" );
+    QVERIFY2( delay.getValue( 1.0 ) == 0.0, "Failure" );
+
+    // wrapping around several times
+    for ( int i = 0; i < 10; i++ )
+    {
+        delay.push( (double)i );
+
+        QVERIFY2( delay.getCount() == (unsigned int)std::min( i + 1, 4 ), "Failure" );
+        QVERIFY2( delay.get( 0 ) == (double)i, "Failure" );
+    }
+
+    // newest first
+    for ( unsigned int i = 0; i < 4; i++ )
+    {
+        QVERIFY2( delay.get( i ) == 9.0 - i, "Failure" );
+    }
+
+    delay.reset();
+
+    QVERIFY2( delay.getCount() == 0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void DelayLineTest::getValue()
+{
+    fdm::DelayLine< 8 > delay;
+
+    for ( int i = 0; i < 5; i++ )
+    {
+        delay.push( 10.0 * i );
+    }
+
+    // samples: 40 30 20 10 0
+    QVERIFY2( fabs( delay.getValue( 0.0  ) - 40.0 ) < 1.0e-12, "Failure" );
+    QVERIFY2( fabs( delay.getValue( 1.0  ) - 30.0 ) < 1.0e-12, "Failure" );
+    QVERIFY2( fabs( delay.getValue( 1.25 ) - 27.5 ) < 1.0e-12, "Failure" );
+    QVERIFY2( fabs( delay.getValue( 3.5  ) -  5.0 ) < 1.0e-12, "Failure" );
+
+    // clamped to the available history
+    QVERIFY2( fabs( delay.getValue( -1.0 ) - 40.0 ) < 1.0e-12, "Failure" );
+    QVERIFY2( fabs( delay.getValue( 4.0  ) -  0.0 ) < 1.0e-12, "Failure" );
+    QVERIFY2( fabs( delay.getValue( 7.5  ) -  0.0 ) < 1.0e-12, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(DelayLineTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_delayline.moc"
@@ -0,0 +1,123 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <cfenv>
+#include <cfloat>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <xmmintrin.h>
+#   define TEST_MXCSR
+#endif
+
+#include <fdm/utils/fdm_FPEnv.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class FPEnvTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    FPEnvTest();
+
+private:
+
+    volatile double _one;
+    volatile double _three;
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void setDeterministic();
+    void rounding();
+    void denormals();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+FPEnvTest::FPEnvTest() :
+    _one ( 1.0 ),
+    _three ( 3.0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FPEnvTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FPEnvTest::cleanupTestCase()
+{
+    fdm::FPEnv::setDeterministic();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FPEnvTest::setDeterministic()
+{
+    fdm::FPEnv::setDeterministic();
+    QVERIFY2( fdm::FPEnv::isDeterministic(), "Failure" );
+
+    fesetround( FE_UPWARD );
+    QVERIFY2( !fdm::FPEnv::isDeterministic(), "Failure" );
+
+    fdm::FPEnv::setDeterministic();
+    QVERIFY2( fdm::FPEnv::isDeterministic(), "Failure" );
+    QVERIFY2( fegetround() == FE_TONEAREST, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FPEnvTest::rounding()
+{
+    fdm::FPEnv::setDeterministic();
+    double x_ref = _one / _three;
+
+    fesetround( FE_UPWARD );
+    double x_up = _one / _three;
+
+    fdm::FPEnv::setDeterministic();
+    double x_det = _one / _three;
+
+    QVERIFY2( x_up  != x_ref, "Failure" );
+    QVERIFY2( x_det == x_ref, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void FPEnvTest::denormals()
+{
+#   ifdef TEST_MXCSR
+    // flush-to-zero and denormals-are-zero set e.g. by -ffast-math startup code
+    _mm_setcsr( _mm_getcsr() | 0x8040 );
+    QVERIFY2( !fdm::FPEnv::isDeterministic(), "Failure" );
+
+    fdm::FPEnv::setDeterministic();
+    QVERIFY2( fdm::FPEnv::isDeterministic(), "Failure" );
+#   endif
+
+    volatile double min = DBL_MIN;
+    volatile double half = 0.5;
+
+    double denormal = min * half;
+
+    QVERIFY2( denormal > 0.0, "Failure" );
+    QVERIFY2( denormal * _three > 0.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(FPEnvTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_fpenv.moc"
@@ -0,0 +1,149 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <fdm/utils/fdm_Histogram.h>
+#include <fdm/utils/fdm_Random.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define SAMPLES 100000
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class HistogramTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    HistogramTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void empty();
+    void percentiles();
+    void maximum();
+    void reset();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+HistogramTest::HistogramTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HistogramTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HistogramTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HistogramTest::empty()
+{
+    fdm::Histogram hist;
+
+    QVERIFY2( hist.getCount() == 0, "Failure" );
+    QVERIFY2( hist.getPercentile( 50.0 ) == 0.0, "Failure" );
+    QVERIFY2( hist.getMean() == 0.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HistogramTest::percentiles()
+{
+    fdm::Histogram hist( 1.0e-7, 10.0 );
+    fdm::Random random( 1 );
+
+    std::vector< double > values;
+
+    // log-uniform values from 1 us to 100 ms
+    for ( int i = 0; i < SAMPLES; i++ )
+    {
+        double value = 1.0e-6 * pow( 10.0, 5.0 * random.getUniform() );
+
+        hist.add( value );
+        values.push_back( value );
+    }
+
+    std::sort( values.begin(), values.end() );
+
+    const double percents[] = { 1.0, 50.0, 90.0, 99.0, 99.9, 100.0 };
+
+    double results[ 6 ];
+    hist.getPercentiles( percents, results, 6 );
+
+    for ( int i = 0; i < 6; i++ )
+    {
+        unsigned int index = (unsigned int)ceil( 0.01 * percents[ i ] * SAMPLES ) - 1;
+        double ref = values[ index ];
+
+        // bucket relative width and resolution
+        double tol = ref / fdm::Histogram::_sub_count + 1.0e-7;
+
+        QVERIFY2( results[ i ] >= ref, "Failure" );
+        QVERIFY2( results[ i ] - ref <= tol, "Failure" );
+        QVERIFY2( results[ i ] == hist.getPercentile( percents[ i ] ), "Failure" );
+    }
+
+    QVERIFY2( hist.getCount() == SAMPLES, "Failure" );
+    QVERIFY2( hist.getMin() == values.front(), "Failure" );
+    QVERIFY2( hist.getMax() == values.back(), "Failure" );
+    QVERIFY2( hist.getPercentile( 100.0 ) == values.back(), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HistogramTest::maximum()
+{
+    fdm::Histogram hist( 1.0e-3, 1.0 );
+
+    hist.add( 0.5 );
+    hist.add( 25.0 );
+
+    QVERIFY2( hist.getMax() == 25.0, "Failure" );
+    QVERIFY2( hist.getPercentile( 100.0 ) == 25.0, "Failure" );
+    QVERIFY2( fabs( hist.getPercentile( 50.0 ) - 0.5 ) < 0.5 / fdm::Histogram::_sub_count, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void HistogramTest::reset()
+{
+    fdm::Histogram hist;
+
+    hist.add( 0.01 );
+    hist.add( 0.02 );
+
+    hist.reset();
+
+    QVERIFY2( hist.getCount() == 0, "Failure" );
+    QVERIFY2( hist.getMax() == 0.0, "Failure" );
+
+    hist.add( 0.001 );
+
+    QVERIFY2( hist.getCount() == 1, "Failure" );
+    QVERIFY2( fabs( hist.getPercentile( 50.0 ) - 0.001 ) < 0.001 / fdm::Histogram::_sub_count, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(HistogramTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_histogram.moc"
@@ -1,4 +1,6 @@
+#include <cstring>
 #include <iostream>
+#include <type_traits>
 
 #include <QString>
 #include <QtTest>
@@ -25,6 +27,7 @@ private Q_SLOTS:
     void cleanupTestCase();
 
     void constructor();
+    void layout();
 
     void xx();
     void xy();
@@ -255,6 +258,29 @@ void Matrix3x3Test::constructor()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Matrix3x3Test::layout()
+{
+    QVERIFY2( sizeof( fdm::Matrix3x3 ) == 9 * sizeof( double ), "Failure size" );
+    QVERIFY2( std::is_trivially_copyable< fdm::Matrix3x3 >::value, "Failure trivially copyable" );
+
+    const double items[] = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0 };
+
+    fdm::Matrix3x3 src( items );
+    fdm::Matrix3x3 dst[ 2 ];
+
+    memcpy( &dst[ 1 ], &src, sizeof( fdm::Matrix3x3 ) );
+
+    for ( unsigned int i = 0; i < 9; i++ )
+    {
+        QVERIFY2( dst[ 1 ].getItems()[ i ] == items[ i ], "Failure memcpy" );
+    }
+
+    QVERIFY2( reinterpret_cast< const char* >( &dst[ 1 ] )
+            - reinterpret_cast< const char* >( &dst[ 0 ] ) == 9 * sizeof( double ), "Failure array stride" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Matrix3x3Test::xx()
 {
     fdm::Matrix3x3 m0;
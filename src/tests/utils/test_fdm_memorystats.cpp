@@ -0,0 +1,155 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_MemoryStats.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct TestTag
+{
+    static const char* getName() { return "test.allocator"; }
+};
+
+typedef std::vector< double, fdm::MemoryAllocator< double, TestTag > > Vector;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class MemoryStatsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    MemoryStatsTest();
+
+private Q_SLOTS:
+
+    void add();
+    void counters();
+    void budget();
+    void allocator();
+    void dump();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+MemoryStatsTest::MemoryStatsTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStatsTest::add()
+{
+    int id_1 = fdm::MemoryStats::add( "test.add" );
+    int id_2 = fdm::MemoryStats::add( "test.add" );
+
+    QVERIFY( id_1 >= 0 );
+    QVERIFY( id_1 == id_2 );
+
+    // invalid IDs are ignored
+    fdm::MemoryStats::allocate( -1, 100 );
+    fdm::MemoryStats::release( 1000, 100 );
+
+    QVERIFY( fdm::MemoryStats::getBytes( -1 ) == 0 );
+    QVERIFY( !fdm::MemoryStats::isOverBudget( -1 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStatsTest::counters()
+{
+    int id = fdm::MemoryStats::add( "test.counters" );
+
+    fdm::MemoryStats::allocate( id, 1000 );
+    fdm::MemoryStats::allocate( id, 500 );
+    fdm::MemoryStats::release( id, 1200 );
+
+    QVERIFY( fdm::MemoryStats::getBytes( id ) == 300 );
+
+    fdm::MemoryStats::Values values;
+    fdm::MemoryStats::snapshot( &values );
+
+    QVERIFY( values[ id ].bytes == 300 );
+    QVERIFY( values[ id ].peak == 1500 );
+    QVERIFY( values[ id ].budget == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStatsTest::budget()
+{
+    int id = fdm::MemoryStats::add( "test.budget" );
+
+    fdm::MemoryStats::allocate( id, 800 );
+
+    // no budget means unlimited
+    QVERIFY( !fdm::MemoryStats::isOverBudget( id, 1000000 ) );
+
+    fdm::MemoryStats::setBudget( id, 1000 );
+
+    QVERIFY( fdm::MemoryStats::getBudget( id ) == 1000 );
+    QVERIFY( !fdm::MemoryStats::isOverBudget( id ) );
+    QVERIFY( !fdm::MemoryStats::isOverBudget( id, 200 ) );
+    QVERIFY(  fdm::MemoryStats::isOverBudget( id, 201 ) );
+
+    fdm::MemoryStats::allocate( id, 300 );
+
+    QVERIFY( fdm::MemoryStats::isOverBudget( id ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStatsTest::allocator()
+{
+    int id = fdm::MemoryAllocator< double, TestTag >::getId();
+
+    QVERIFY( id == fdm::MemoryStats::add( "test.allocator" ) );
+    QVERIFY( fdm::MemoryStats::getBytes( id ) == 0 );
+
+    {
+        Vector v( 100, 1.0 );
+
+        QVERIFY( fdm::MemoryStats::getBytes( id ) == 100 * sizeof(double) );
+
+        Vector w( v );
+
+        QVERIFY( fdm::MemoryStats::getBytes( id ) == 200 * sizeof(double) );
+
+        v.clear();
+        v.shrink_to_fit();
+
+        QVERIFY( fdm::MemoryStats::getBytes( id ) == 100 * sizeof(double) );
+    }
+
+    QVERIFY( fdm::MemoryStats::getBytes( id ) == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MemoryStatsTest::dump()
+{
+    int id = fdm::MemoryStats::add( "test.dump" );
+
+    fdm::MemoryStats::allocate( id, 4096 );
+
+    std::stringstream ss;
+    fdm::MemoryStats::dump( ss );
+
+    QVERIFY( ss.str().find( "test.dump" ) != std::string::npos );
+    QVERIFY( ss.str().find( "total" ) != std::string::npos );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(MemoryStatsTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_memorystats.moc"
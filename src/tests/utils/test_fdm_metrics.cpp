@@ -0,0 +1,246 @@
+#include <cstring>
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <thread>
+
+#include <fdm/utils/fdm_Metrics.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define THREADS 4
+#define SAMPLES 1000
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class MetricsTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    MetricsTest();
+
+private:
+
+    const fdm::Metrics::Value* getValue( const fdm::Metrics::Values &values,
+                                         const char *name );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void add();
+    void gauge();
+    void counter();
+    void timer();
+    void threads();
+    void dropped();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+MetricsTest::MetricsTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+const fdm::Metrics::Value* MetricsTest::getValue( const fdm::Metrics::Values &values,
+                                                  const char *name )
+{
+    for ( size_t i = 0; i < values.size(); i++ )
+    {
+        if ( 0 == strcmp( values[ i ].name, name ) ) return &values[ i ];
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::initTestCase()
+{
+    fdm::Metrics::setEnabled( true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::cleanupTestCase()
+{
+    fdm::Metrics::setEnabled( false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::add()
+{
+    int id_1 = fdm::Metrics::add( "test.add", fdm::Metrics::Gauge );
+    int id_2 = fdm::Metrics::add( "test.add", fdm::Metrics::Gauge );
+    int id_3 = fdm::Metrics::add( "test.add", fdm::Metrics::Timer );
+
+    QVERIFY( id_1 >= 0 );
+    QVERIFY( id_1 == id_2 );
+    QVERIFY( id_3 == -1 );
+
+    // samples of mismatched type are ignored
+    fdm::Metrics::set( id_1, 1.0 );
+    fdm::Metrics::time( id_1, 1.0 );
+    fdm::Metrics::count( -1 );
+
+    fdm::Metrics::Values values;
+    fdm::Metrics::snapshot( &values );
+
+    const fdm::Metrics::Value *value = getValue( values, "test.add" );
+
+    QVERIFY( value != 0 );
+    QVERIFY( value->type == fdm::Metrics::Gauge );
+    QVERIFY( value->value == 1.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::gauge()
+{
+    int id = fdm::Metrics::add( "test.gauge", fdm::Metrics::Gauge );
+
+    fdm::Metrics::set( id, 1.5 );
+    fdm::Metrics::set( id, 2.5 );
+
+    fdm::Metrics::Values values;
+    fdm::Metrics::snapshot( &values );
+
+    QVERIFY( getValue( values, "test.gauge" )->value == 2.5 );
+
+    // gauge keeps its last value, disabled collection ignores samples
+    fdm::Metrics::setEnabled( false );
+    fdm::Metrics::set( id, 3.5 );
+    fdm::Metrics::setEnabled( true );
+
+    fdm::Metrics::snapshot( &values );
+
+    QVERIFY( getValue( values, "test.gauge" )->value == 2.5 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::counter()
+{
+    int id = fdm::Metrics::add( "test.counter", fdm::Metrics::Counter );
+
+    fdm::Metrics::count( id );
+    fdm::Metrics::count( id, 4 );
+
+    fdm::Metrics::Values values;
+    fdm::Metrics::snapshot( &values );
+
+    QVERIFY( getValue( values, "test.counter" )->value == 5.0 );
+
+    // counters report increments since the previous snapshot
+    fdm::Metrics::count( id, 2 );
+    fdm::Metrics::snapshot( &values );
+
+    QVERIFY( getValue( values, "test.counter" )->value == 2.0 );
+
+    fdm::Metrics::snapshot( &values );
+
+    QVERIFY( getValue( values, "test.counter" )->value == 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::timer()
+{
+    int id = fdm::Metrics::add( "test.timer", fdm::Metrics::Timer );
+
+    for ( int i = 1; i <= SAMPLES; i++ )
+    {
+        fdm::Metrics::time( id, 1.0e-3 * i );
+    }
+
+    fdm::Metrics::Values values;
+    fdm::Metrics::snapshot( &values );
+
+    const fdm::Metrics::Value *value = getValue( values, "test.timer" );
+
+    QVERIFY( value->value == SAMPLES );
+    // relative error of percentiles is bounded by histogram buckets width
+    QVERIFY( fabs( value->p50  / 0.500 - 1.0 ) < 5.0e-2 );
+    QVERIFY( fabs( value->p99  / 0.990 - 1.0 ) < 5.0e-2 );
+    QVERIFY( fabs( value->p999 / 0.999 - 1.0 ) < 5.0e-2 );
+    QVERIFY( fabs( value->max  - 1.000 ) < 1.0e-6 );
+
+    // timers are reset after each snapshot
+    fdm::Metrics::snapshot( &values );
+
+    QVERIFY( getValue( values, "test.timer" )->value == 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::threads()
+{
+    int id = fdm::Metrics::add( "test.threads", fdm::Metrics::Timer );
+
+    std::thread workers[ THREADS ];
+
+    for ( int i = 0; i < THREADS; i++ )
+    {
+        workers[ i ] = std::thread( [ id ]()
+        {
+            for ( int j = 0; j < SAMPLES; j++ )
+            {
+                FDM_METRICS_ZONE( "test.threads.zone" );
+                fdm::Metrics::time( id, 1.0e-3 );
+            }
+        });
+    }
+
+    for ( int i = 0; i < THREADS; i++ )
+    {
+        workers[ i ].join();
+    }
+
+    fdm::Metrics::Values values;
+    fdm::UInt64 dropped = fdm::Metrics::snapshot( &values );
+
+    QVERIFY( dropped == 0 );
+    QVERIFY( getValue( values, "test.threads" )->value == THREADS * SAMPLES );
+    QVERIFY( fabs( getValue( values, "test.threads" )->max - 1.0e-3 ) < 1.0e-6 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MetricsTest::dropped()
+{
+    int id = fdm::Metrics::add( "test.dropped", fdm::Metrics::Timer );
+
+    for ( unsigned int i = 0; i < fdm::Metrics::_buffer_size + 10; i++ )
+    {
+        fdm::Metrics::time( id, 1.0e-3 );
+    }
+
+    fdm::Metrics::Values values;
+
+    QVERIFY( fdm::Metrics::snapshot( &values ) == 10 );
+    QVERIFY( getValue( values, "test.dropped" )->value == fdm::Metrics::_buffer_size );
+
+    // drained buffer accepts samples again
+    fdm::Metrics::time( id, 1.0e-3 );
+
+    QVERIFY( fdm::Metrics::snapshot( &values ) == 0 );
+    QVERIFY( getValue( values, "test.dropped" )->value == 1.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(MetricsTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_metrics.moc"
@@ -0,0 +1,144 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <thread>
+
+#include <fdm/utils/fdm_RingBuffer.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define RECORDS 100000
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class RingBufferTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    RingBufferTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void pushPop();
+    void full();
+    void threads();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+RingBufferTest::RingBufferTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RingBufferTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RingBufferTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RingBufferTest::pushPop()
+{
+    fdm::RingBuffer ring( 3, sizeof( int ) );
+
+    QVERIFY2( ring.front() == FDM_NULLPTR, "Failure" );
+
+    // wrapping around several times
+    for ( int i = 0; i < 20; i++ )
+    {
+        QVERIFY2( ring.push( (const char*)&i ), "Failure" );
+
+        int value = -1;
+        memcpy( &value, ring.front(), sizeof( int ) );
+        QVERIFY2( value == i, "Failure" );
+
+        ring.pop();
+        QVERIFY2( ring.front() == FDM_NULLPTR, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RingBufferTest::full()
+{
+    fdm::RingBuffer ring( 4, sizeof( int ) );
+
+    for ( int j = 0; j < 5; j++ )
+    {
+        for ( int i = 0; i < 4; i++ )
+        {
+            QVERIFY2( ring.push( (const char*)&i ), "Failure" );
+        }
+
+        int i = 4;
+        QVERIFY2( !ring.push( (const char*)&i ), "Failure" );
+
+        for ( int i = 0; i < 4; i++ )
+        {
+            int value = -1;
+            memcpy( &value, ring.front(), sizeof( int ) );
+            QVERIFY2( value == i, "Failure" );
+            ring.pop();
+        }
+
+        QVERIFY2( ring.front() == FDM_NULLPTR, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RingBufferTest::threads()
+{
+    fdm::RingBuffer ring( 64, sizeof( int ) );
+
+    std::thread producer( [ &ring ]
+    {
+        for ( int i = 0; i < RECORDS; i++ )
+        {
+            while ( !ring.push( (const char*)&i ) ) std::this_thread::yield();
+        }
+    });
+
+    bool ordered = true;
+
+    for ( int i = 0; i < RECORDS; i++ )
+    {
+        const char *record = ring.front();
+
+        while ( record == FDM_NULLPTR )
+        {
+            std::this_thread::yield();
+            record = ring.front();
+        }
+
+        int value = -1;
+        memcpy( &value, record, sizeof( int ) );
+        ordered = ordered && value == i;
+
+        ring.pop();
+    }
+
+    producer.join();
+
+    QVERIFY2( ordered, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(RingBufferTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_ringbuffer.moc"
@@ -97,6 +97,7 @@ class RungeKutta4Test : public QObject
 public:
 
     typedef fdm::RungeKutta4< RungeKutta4Test > Integrator;
+    typedef fdm::RungeKutta4< RungeKutta4Test, fdm::Vector< 2 > > IntegratorFixed;
 
     RungeKutta4Test();
 
@@ -104,6 +105,9 @@ public:
     void computeStateDeriv( const fdm::VectorN &state,
                                   fdm::VectorN *deriv );
 
+    void computeStateDerivFixed( const fdm::Vector< 2 > &state,
+                                       fdm::Vector< 2 > *deriv );
+
 private:
 
     double _m;      ///< [kg]       mass
@@ -132,6 +136,8 @@ private Q_SLOTS:
     void test3_1();
     void test3_2();
     void test3_3();
+
+    void testFixedSize();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -152,6 +158,15 @@ void RungeKutta4Test::computeStateDeriv( const fdm::VectorN &state,
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void RungeKutta4Test::computeStateDerivFixed( const fdm::Vector< 2 > &state,
+                                                    fdm::Vector< 2 > *deriv )
+{
+    (*deriv)( 0 ) = state( 1 );
+    (*deriv)( 1 ) = -_k * state( 0 ) - _c * state( 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool RungeKutta4Test::solve( double m,
                              double k,
                              double c,
@@ -469,6 +484,34 @@ void RungeKutta4Test::test3_3()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void RungeKutta4Test::testFixedSize()
+{
+    _m = 1.0;
+    _k = 1.0;
+    _c = 1.0;
+
+    fdm::VectorN s( 2 );
+    fdm::Vector< 2 > s_fixed;
+
+    s( 0 ) = s_fixed( 0 ) = 1.0;
+    s( 1 ) = s_fixed( 1 ) = 1.0;
+
+    Integrator integrator( this, &RungeKutta4Test::computeStateDeriv );
+    IntegratorFixed integrator_fixed( this, &RungeKutta4Test::computeStateDerivFixed );
+
+    for ( double t = 0.0; t <= T_MAX; t += T_STEP )
+    {
+        integrator.integrate( T_STEP, &s );
+        integrator_fixed.integrate( T_STEP, &s_fixed );
+
+        // both variants have to give exactly the same results
+        QVERIFY( s( 0 ) == s_fixed( 0 ) );
+        QVERIFY( s( 1 ) == s_fixed( 1 ) );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 QTEST_APPLESS_MAIN(RungeKutta4Test)
 
 ////////////////////////////////////////////////////////////////////////////////
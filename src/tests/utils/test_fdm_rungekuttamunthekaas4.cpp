@@ -0,0 +1,232 @@
+#include <cmath>
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_RungeKutta4.h>
+#include <fdm/utils/fdm_RungeKuttaMuntheKaas4.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define T_MAX 10.0
+
+// reference solution time step
+#define T_STEP_REF 1.0e-4
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief The RungeKuttaMuntheKaas4Test class, a fdm::RungeKuttaMuntheKaas4
+ * integrator unit test class.
+ *
+ * Torque-free asymmetric rigid body is used as an example. State vector
+ * consists of attitude quaternion and angular velocity:
+ * q_dot = 0.5 * q * omega
+ * I * omega_dot = -omega x ( I * omega )
+ *
+ * Results are compared with classical Runge-Kutta 4th order solution obtained
+ * with much smaller time step.
+ */
+class RungeKuttaMuntheKaas4Test : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    typedef fdm::RungeKutta4< RungeKuttaMuntheKaas4Test, fdm::Vector< 7 > > IntegratorRK4;
+    typedef fdm::RungeKuttaMuntheKaas4< RungeKuttaMuntheKaas4Test, fdm::Vector< 7 > > IntegratorRKMK4;
+
+    RungeKuttaMuntheKaas4Test();
+
+    void computeStateDeriv( const fdm::Vector< 7 > &state,
+                                  fdm::Vector< 7 > *deriv );
+
+private:
+
+    fdm::Vector3 _it;   ///< [kg*m^2] principal moments of inertia
+
+    fdm::Vector< 7 > getInitialState() const;
+
+    template < class INTEGRATOR >
+    fdm::Vector< 7 > solve( double step );
+
+    double getAttitudeError( const fdm::Vector< 7 > &s1,
+                             const fdm::Vector< 7 > &s2 );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void constantRate();
+    void torqueFree();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+RungeKuttaMuntheKaas4Test::RungeKuttaMuntheKaas4Test() :
+    _it ( 1.0, 2.0, 3.0 )
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RungeKuttaMuntheKaas4Test::computeStateDeriv( const fdm::Vector< 7 > &state,
+                                                         fdm::Vector< 7 > *deriv )
+{
+    fdm::Quaternion q( state( 0 ), state( 1 ), state( 2 ), state( 3 ) );
+    fdm::Vector3 omg( state( 4 ), state( 5 ), state( 6 ) );
+
+    fdm::Quaternion q_dot = q.getDerivative( omg );
+
+    fdm::Vector3 h( _it.x() * omg.x(), _it.y() * omg.y(), _it.z() * omg.z() );
+    fdm::Vector3 omg_dot = -( omg % h );
+
+    (*deriv)( 0 ) = q_dot.e0();
+    (*deriv)( 1 ) = q_dot.ex();
+    (*deriv)( 2 ) = q_dot.ey();
+    (*deriv)( 3 ) = q_dot.ez();
+    (*deriv)( 4 ) = omg_dot.x() / _it.x();
+    (*deriv)( 5 ) = omg_dot.y() / _it.y();
+    (*deriv)( 6 ) = omg_dot.z() / _it.z();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Vector< 7 > RungeKuttaMuntheKaas4Test::getInitialState() const
+{
+    fdm::Quaternion q( fdm::Angles( 0.1, 0.2, 0.3 ) );
+
+    fdm::Vector< 7 > state;
+
+    state( 0 ) = q.e0();
+    state( 1 ) = q.ex();
+    state( 2 ) = q.ey();
+    state( 3 ) = q.ez();
+
+    // about 230 deg/s roll rate, close to intermediate axis
+    state( 4 ) = 4.0;
+    state( 5 ) = 0.5;
+    state( 6 ) = 0.2;
+
+    return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template < class INTEGRATOR >
+fdm::Vector< 7 > RungeKuttaMuntheKaas4Test::solve( double step )
+{
+    INTEGRATOR integrator( this, &RungeKuttaMuntheKaas4Test::computeStateDeriv );
+
+    fdm::Vector< 7 > state = getInitialState();
+
+    int steps = (int)floor( T_MAX / step + 0.5 );
+
+    for ( int i = 0; i < steps; i++ )
+    {
+        integrator.integrate( step, &state );
+    }
+
+    return state;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double RungeKuttaMuntheKaas4Test::getAttitudeError( const fdm::Vector< 7 > &s1,
+                                                    const fdm::Vector< 7 > &s2 )
+{
+    fdm::Quaternion q1( s1( 0 ), s1( 1 ), s1( 2 ), s1( 3 ) );
+    fdm::Quaternion q2( s2( 0 ), s2( 1 ), s2( 2 ), s2( 3 ) );
+
+    // rotation angle between attitudes
+    fdm::Quaternion dq = q1.getNormalized().getConjugated() * q2.getNormalized();
+
+    double sin_2 = sqrt( dq.ex()*dq.ex() + dq.ey()*dq.ey() + dq.ez()*dq.ez() );
+
+    return 2.0 * asin( std::min( 1.0, sin_2 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RungeKuttaMuntheKaas4Test::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RungeKuttaMuntheKaas4Test::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RungeKuttaMuntheKaas4Test::constantRate()
+{
+    // spherical body rotates steadily about fixed axis, exact solution is known
+    _it.set( 1.0, 1.0, 1.0 );
+
+    const double step = 0.05;
+
+    fdm::Vector< 7 > s_0 = getInitialState();
+    fdm::Vector< 7 > s_1 = solve< IntegratorRKMK4 >( step );
+    fdm::Vector< 7 > s_2 = solve< IntegratorRK4   >( step );
+
+    fdm::Quaternion q_0( s_0( 0 ), s_0( 1 ), s_0( 2 ), s_0( 3 ) );
+    fdm::Vector3 omg( s_0( 4 ), s_0( 5 ), s_0( 6 ) );
+
+    fdm::Quaternion q_t = q_0 * fdm::Quaternion( omg.getLength() * T_MAX, omg );
+
+    fdm::Vector< 7 > s_t = s_0;
+
+    s_t( 0 ) = q_t.e0();
+    s_t( 1 ) = q_t.ex();
+    s_t( 2 ) = q_t.ey();
+    s_t( 3 ) = q_t.ez();
+
+    fdm::Quaternion q_1( s_1( 0 ), s_1( 1 ), s_1( 2 ), s_1( 3 ) );
+    fdm::Quaternion q_2( s_2( 0 ), s_2( 1 ), s_2( 2 ), s_2( 3 ) );
+
+    // unit norm is kept by construction
+    QVERIFY( fabs( q_1.getLength() - 1.0 ) < 1.0e-12 );
+    QVERIFY( fabs( q_2.getLength() - 1.0 ) > 1.0e-6 );
+
+    QVERIFY( getAttitudeError( s_1, s_t ) < 1.0e-9 );
+    QVERIFY( getAttitudeError( s_1, s_t ) < getAttitudeError( s_2, s_t ) );
+
+    _it.set( 1.0, 2.0, 3.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void RungeKuttaMuntheKaas4Test::torqueFree()
+{
+    fdm::Vector< 7 > s_ref = solve< IntegratorRK4 >( T_STEP_REF );
+
+    double e_1 = getAttitudeError( solve< IntegratorRKMK4 >( 0.02 ), s_ref );
+    double e_2 = getAttitudeError( solve< IntegratorRKMK4 >( 0.01 ), s_ref );
+    double e_rk4 = getAttitudeError( solve< IntegratorRK4 >( 0.02 ), s_ref );
+
+    cout << "RKMK4 error (0.02 s): " << e_1 << endl;
+    cout << "RKMK4 error (0.01 s): " << e_2 << endl;
+    cout << "RK4   error (0.02 s): " << e_rk4 << endl;
+
+    // 4th order convergence, halving time step reduces error about 16 times
+    QVERIFY( e_1 / e_2 > 12.0 );
+    QVERIFY( e_1 / e_2 < 20.0 );
+
+    QVERIFY( e_1 < e_rk4 );
+
+    fdm::Vector< 7 > s_1 = solve< IntegratorRKMK4 >( 0.02 );
+    fdm::Quaternion q_1( s_1( 0 ), s_1( 1 ), s_1( 2 ), s_1( 3 ) );
+
+    QVERIFY( fabs( q_1.getLength() - 1.0 ) < 1.0e-12 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(RungeKuttaMuntheKaas4Test)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_rungekuttamunthekaas4.moc"
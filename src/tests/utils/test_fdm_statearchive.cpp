@@ -0,0 +1,203 @@
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/ctrl/fdm_Lag.h>
+#include <fdm/ctrl/fdm_PID.h>
+
+#include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_Random.h>
+#include <fdm/utils/fdm_StateArchive.h>
+#include <fdm/utils/fdm_Vector3.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class StateArchiveTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /** Test model with all kinds of states. */
+    struct Model
+    {
+        enum State { Off = 0, On = 1, Failed = 2 };
+
+        double d;
+        bool   b;
+        int    i;
+        unsigned int u;
+        fdm::UInt64 l;
+        State  s;
+
+        fdm::Vector3     v;
+        fdm::Matrix3x3   m;
+        fdm::Quaternion  q;
+        std::vector< double > h;
+
+        void archiveState( fdm::StateArchive *archive )
+        {
+            archive->add( &d );
+            archive->add( &b );
+            archive->add( &i );
+            archive->add( &u );
+            archive->add( &l );
+            archive->addEnum( &s );
+            archive->add( &v );
+            archive->add( &m );
+            archive->add( &q );
+            archive->add( &h, 4 );
+        }
+    };
+
+    StateArchiveTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void saveRestore();
+    void restoreStep();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+StateArchiveTest::StateArchiveTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchiveTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchiveTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchiveTest::saveRestore()
+{
+    Model m1;
+
+    m1.d = 1.0 / 3.0;
+    m1.b = true;
+    m1.i = -7;
+    m1.u = 4000000000u;
+    m1.l = 0xfedcba9876543210ULL;
+    m1.s = Model::Failed;
+    m1.v = fdm::Vector3( 1.0, 2.0, 3.0 );
+    m1.m = fdm::Matrix3x3( 1.0, 2.0, 3.0,
+                           4.0, 5.0, 6.0,
+                           7.0, 8.0, 9.0 );
+    m1.q = fdm::Quaternion( fdm::Angles( 0.1, 0.2, 0.3 ) );
+    m1.h.push_back( 0.5 );
+
+    fdm::StateArchive counter;
+    m1.archiveState( &counter );
+
+    QVERIFY2( counter.getSize() == 6 + 3 + 9 + 4 + 4, "Failure" );
+
+    std::vector< double > state( counter.getSize() );
+
+    fdm::StateArchive saver( &state[ 0 ] );
+    m1.archiveState( &saver );
+
+    QVERIFY2( saver.getSize() == counter.getSize(), "Failure" );
+
+    Model m2;
+    const double *data = &state[ 0 ];
+
+    fdm::StateArchive loader( data );
+    m2.archiveState( &loader );
+
+    QVERIFY2( loader.getSize() == counter.getSize(), "Failure" );
+
+    QVERIFY2( m2.d == m1.d, "Failure" );
+    QVERIFY2( m2.b == m1.b, "Failure" );
+    QVERIFY2( m2.i == m1.i, "Failure" );
+    QVERIFY2( m2.u == m1.u, "Failure" );
+    QVERIFY2( m2.l == m1.l, "Failure" );
+    QVERIFY2( m2.s == m1.s, "Failure" );
+    QVERIFY2( m2.v == m1.v, "Failure" );
+    QVERIFY2( m2.m == m1.m, "Failure" );
+    QVERIFY2( m2.q == m1.q, "Failure" );
+
+    // missing values are saved as zeros
+    QVERIFY2( m2.h.size() == 4, "Failure" );
+    QVERIFY2( m2.h[ 0 ] == 0.5, "Failure" );
+    QVERIFY2( m2.h[ 3 ] == 0.0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StateArchiveTest::restoreStep()
+{
+    const double dt = 0.01;
+
+    fdm::Random random( 1234 );
+    fdm::Lag lag( 0.5 );
+    fdm::PID pid( 1.0, 0.5, 0.1 );
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        double u = random.getNormal();
+        lag.update( dt, u );
+        pid.update( dt, u - lag.getValue() );
+    }
+
+    fdm::StateArchive counter;
+    random.archiveState( &counter );
+    lag.archiveState( &counter );
+    pid.archiveState( &counter );
+
+    std::vector< double > state( counter.getSize() );
+
+    fdm::StateArchive saver( &state[ 0 ] );
+    random.archiveState( &saver );
+    lag.archiveState( &saver );
+    pid.archiveState( &saver );
+
+    double out[ 100 ];
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        double u = random.getNormal();
+        lag.update( dt, u );
+        pid.update( dt, u - lag.getValue() );
+        out[ i ] = pid.getValue();
+    }
+
+    const double *data = &state[ 0 ];
+
+    fdm::StateArchive loader( data );
+    random.archiveState( &loader );
+    lag.archiveState( &loader );
+    pid.archiveState( &loader );
+
+    // the same steps after restoring have to give bit-exact results
+    for ( int i = 0; i < 100; i++ )
+    {
+        double u = random.getNormal();
+        lag.update( dt, u );
+        pid.update( dt, u - lag.getValue() );
+
+        double value = pid.getValue();
+
+        QVERIFY2( memcmp( &out[ i ], &value, sizeof(double) ) == 0, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(StateArchiveTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_statearchive.moc"
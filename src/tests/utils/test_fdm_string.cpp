@@ -0,0 +1,163 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <fdm/utils/fdm_String.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class StringTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    StringTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void split();
+    void parseDouble();
+    void parseDoubleExact();
+    void toDouble();
+    void toInt();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+StringTest::StringTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringTest::split()
+{
+    std::string str = "a\tbc\t\t1.5\t";
+
+    std::vector< std::string > s1 = fdm::String::split( str, "\t" );
+
+    fdm::String::Views s2;
+    fdm::String::split( str, '\t', &s2 );
+
+    QVERIFY2( s1.size() == 5 , "Failure s1 size" );
+    QVERIFY2( s2.size() == s1.size(), "Failure s2 size" );
+
+    for ( unsigned int i = 0; i < s1.size(); i++ )
+    {
+        QVERIFY2( s2[ i ].str() == s1[ i ], "Failure token" );
+    }
+
+    fdm::String::split( "", '\t', &s2 );
+
+    QVERIFY2( s2.size() == 1 && s2[ 0 ].empty(), "Failure empty" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringTest::parseDouble()
+{
+    const char *str = " 1.5 -2e3\n.25x";
+    const char *end = str + strlen( str );
+
+    double v1 = 0.0;
+    double v2 = 0.0;
+    double v3 = 0.0;
+
+    const char *p1 = fdm::String::parseDouble( str, end, &v1 );
+    const char *p2 = fdm::String::parseDouble( p1, end, &v2 );
+    const char *p3 = fdm::String::parseDouble( p2, end, &v3 );
+    const char *p4 = fdm::String::parseDouble( p3, end, &v3 );
+
+    QVERIFY2( v1 == 1.5     , "Failure v1" );
+    QVERIFY2( v2 == -2000.0 , "Failure v2" );
+    QVERIFY2( v3 == 0.25    , "Failure v3" );
+
+    QVERIFY2( p1 == str +  4 , "Failure p1" );
+    QVERIFY2( p2 == str +  9 , "Failure p2" );
+    QVERIFY2( p3 == str + 13 , "Failure p3" );
+    QVERIFY2( p4 == 0 , "Failure p4" );
+
+    // end is respected
+    double v4 = 0.0;
+    fdm::String::parseDouble( "12345", "12345" + 3, &v4 );
+
+    QVERIFY2( v4 == 123.0 , "Failure v4" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringTest::parseDoubleExact()
+{
+    // results have to be the same as library ones
+    const char *strs[] =
+    {
+        "0.1", "-0.0", "3.141592653589793", "1.7976931348623157e308",
+        "4.9e-324", "123456789012345678901234", "0.30000000000000004",
+        "1e22", "1e23", "9007199254740993", "nan", "-inf", "0x1p3"
+    };
+
+    for ( unsigned int i = 0; i < sizeof(strs) / sizeof(strs[ 0 ]); i++ )
+    {
+        double v1 = strtod( strs[ i ], 0 );
+        double v2 = 0.0;
+
+        fdm::String::parseDouble( strs[ i ], strs[ i ] + strlen( strs[ i ] ), &v2 );
+
+        QVERIFY2( 0 == memcmp( &v1, &v2, sizeof(double) ), "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringTest::toDouble()
+{
+    std::string str = "1.25\tx";
+
+    fdm::String::Views tokens;
+    fdm::String::split( str, '\t', &tokens );
+
+    double v1 = fdm::String::toDouble( tokens[ 0 ] );
+    double v2 = fdm::String::toDouble( tokens[ 1 ], 7.0 );
+
+    QVERIFY2( v1 == 1.25 , "Failure v1" );
+    QVERIFY2( v2 == 7.0  , "Failure v2" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void StringTest::toInt()
+{
+    int v1 = fdm::String::toInt( fdm::String::View( " -42x", 5 ) );
+    int v2 = fdm::String::toInt( fdm::String::View( "12345", 2 ) );
+    int v3 = fdm::String::toInt( fdm::String::View( "abc", 3 ), 7 );
+
+    QVERIFY2( v1 == -42 , "Failure v1" );
+    QVERIFY2( v2 ==  12 , "Failure v2" );
+    QVERIFY2( v3 ==   7 , "Failure v3" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(StringTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_string.moc"
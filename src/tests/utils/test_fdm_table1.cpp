@@ -1,8 +1,20 @@
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include <QString>
 #include <QtTest>
 
+#include <fdm/utils/fdm_Table1.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+// size of the F-16 aerodynamic tables (angle of attack sweep)
+#define TABLE_SIZE 20
+
+#define LOOKUPS 10000
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace std;
@@ -17,12 +29,31 @@ public:
 
     Table1Test();
 
+private:
+
+    fdm::Table1 _table;
+
+    std::vector< double > _keys;    ///< temporally coherent lookup keys
+
+    double getValueLinearSearch( double key_value ) const;
+
 private Q_SLOTS:
 
     void initTestCase();
     void cleanupTestCase();
 
     void sampleTest();
+
+    void getValueTest();
+    void getValueCursorTest();
+    void smallTableTest();
+    void bakeTest();
+    void shareTest();
+
+    void benchmarkLinearSearch();
+    void benchmarkBinarySearch();
+    void benchmarkCursor();
+    void benchmarkBaked();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -31,7 +62,63 @@ Table1Test::Table1Test() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void Table1Test::initTestCase() {}
+double Table1Test::getValueLinearSearch( double key_value ) const
+{
+    // reference implementation of previous linear search lookup
+    unsigned int size = _table.getSize();
+
+    if ( key_value < _table.getIndexValue( 0 ) )
+        return _table.getFirstValue();
+
+    if ( key_value > _table.getIndexValue( size - 1 ) )
+        return _table.getLastValue();
+
+    unsigned int key_1 = 0;
+    unsigned int key_2 = 0;
+
+    for ( unsigned int i = 1; i < size; i++ )
+    {
+        key_1 = i - 1;
+        key_2 = i;
+
+        if ( key_value >= _table.getIndexValue( key_1 )
+          && key_value <  _table.getIndexValue( key_2 ) )
+        {
+            break;
+        }
+    }
+
+    double k_1 = _table.getIndexValue( key_1 );
+    double k_2 = _table.getIndexValue( key_2 );
+    double v_1 = _table.getValueByIndex( key_1 );
+    double v_2 = _table.getValueByIndex( key_2 );
+
+    return ( key_value - k_1 ) * ( v_2 - v_1 ) / ( k_2 - k_1 ) + v_1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::initTestCase()
+{
+    std::vector< double > key_values;
+    std::vector< double > table_data;
+
+    for ( unsigned int i = 0; i < TABLE_SIZE; i++ )
+    {
+        double x = -10.0 + 5.0 * i;
+
+        key_values.push_back( x );
+        table_data.push_back( sin( 0.1 * x ) + 0.01 * x * x );
+    }
+
+    _table = fdm::Table1( key_values, table_data );
+
+    // slowly varying key, e.g. angle of attack
+    for ( unsigned int i = 0; i < LOOKUPS; i++ )
+    {
+        _keys.push_back( 40.0 + 60.0 * sin( 2.0 * M_PI * i / LOOKUPS ) );
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -46,6 +133,243 @@ void Table1Test::sampleTest()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Table1Test::getValueTest()
+{
+    for ( double x = -20.0; x <= 100.0; x += 0.25 )
+    {
+        QVERIFY( fabs( _table.getValue( x ) - getValueLinearSearch( x ) ) < 1.0e-9 );
+    }
+
+    for ( unsigned int i = 0; i < _table.getSize(); i++ )
+    {
+        double x = _table.getIndexValue( i );
+        QVERIFY( fabs( _table.getValue( x ) - _table.getValueByIndex( i ) ) < 1.0e-9 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::getValueCursorTest()
+{
+    unsigned int cursor = 0;
+
+    for ( unsigned int i = 0; i < _keys.size(); i++ )
+    {
+        double x = _keys[ i ];
+        QVERIFY( fabs( _table.getValue( x, cursor ) - getValueLinearSearch( x ) ) < 1.0e-9 );
+    }
+
+    // random jumps and out of range cursor
+    cursor = 1000;
+
+    for ( double x = 100.0; x >= -20.0; x -= 7.3 )
+    {
+        QVERIFY( fabs( _table.getValue( x, cursor ) - getValueLinearSearch( x ) ) < 1.0e-9 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::smallTableTest()
+{
+    for ( unsigned int size = 1; size <= 10; size++ )
+    {
+        std::vector< double > key_values;
+        std::vector< double > table_data;
+
+        for ( unsigned int i = 0; i < size; i++ )
+        {
+            double x = -5.0 + 2.0 * i + 0.1 * i * i;
+
+            key_values.push_back( x );
+            table_data.push_back( cos( x ) );
+        }
+
+        fdm::Table1 table( key_values, table_data );
+
+        unsigned int cursor = 0;
+
+        for ( double x = -10.0; x <= 30.0; x += 0.05 )
+        {
+            // reference value
+            double v = table_data[ 0 ];
+
+            if ( x >= key_values[ size - 1 ] )
+            {
+                v = table_data[ size - 1 ];
+            }
+            else
+            {
+                for ( unsigned int i = 1; i < size; i++ )
+                {
+                    if ( x >= key_values[ i - 1 ] && x < key_values[ i ] )
+                    {
+                        v = table_data[ i - 1 ] + ( x - key_values[ i - 1 ] )
+                          * ( table_data[ i ] - table_data[ i - 1 ] )
+                          / ( key_values[ i ] - key_values[ i - 1 ] );
+                    }
+                }
+            }
+
+            QVERIFY( fabs( table.getValue( x ) - v ) < 1.0e-9 );
+            QVERIFY( fabs( table.getValue( x, cursor ) - v ) < 1.0e-9 );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::bakeTest()
+{
+    std::vector< double > key_values;
+    std::vector< double > table_data;
+
+    // non-uniform keys
+    key_values.push_back( -10.0 ); table_data.push_back(  1.0 );
+    key_values.push_back(  -5.0 ); table_data.push_back(  0.5 );
+    key_values.push_back(   0.0 ); table_data.push_back(  0.0 );
+    key_values.push_back(   2.5 ); table_data.push_back(  0.3 );
+    key_values.push_back(   5.0 ); table_data.push_back(  0.4 );
+    key_values.push_back(  45.0 ); table_data.push_back( -2.0 );
+
+    fdm::Table1 table( key_values, table_data );
+    fdm::Table1 baked( table );
+
+    QVERIFY( baked.bake( 1.0e-9 ) );
+    QVERIFY( baked.isBaked() );
+
+    fdm::Table1 copy;
+    copy = baked;
+
+    QVERIFY( copy.isBaked() );
+
+    for ( double x = -20.0; x <= 60.0; x += 0.1 )
+    {
+        QVERIFY( fabs( table.getValue( x ) - copy.getValue( x ) ) < 1.0e-9 );
+    }
+
+    // not finite key
+    QVERIFY( std::isnan( copy.getValue( std::numeric_limits< double >::quiet_NaN() ) ) );
+
+    // too small grid
+    QVERIFY( !baked.bake( 1.0e-9, 4 ) );
+    QVERIFY( !baked.isBaked() );
+
+    // modifying baked table
+    QVERIFY( copy.bake( 1.0e-9 ) );
+    copy.multiplyValues( 2.0 );
+    QVERIFY( !copy.isBaked() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::shareTest()
+{
+    std::vector< double > key_values;
+    std::vector< double > table_data;
+
+    key_values.push_back( 0.0 ); table_data.push_back( 1.0 );
+    key_values.push_back( 1.0 ); table_data.push_back( 2.0 );
+    key_values.push_back( 3.0 ); table_data.push_back( 0.0 );
+
+    unsigned int count = fdm::DataPool::getCount();
+
+    fdm::Table1 table_1( key_values, table_data );
+    fdm::Table1 table_2( key_values, table_data );
+
+    table_1.share();
+    table_2.share();
+
+    QVERIFY( fdm::DataPool::getCount() == count + 1 );
+
+    // modifying shared table doesn't affect other tables
+    fdm::Table1 copy( table_1 );
+    copy.multiplyValues( 2.0 );
+
+    QVERIFY( fabs( table_1.getValue( 0.5 ) - 1.5 ) < 1.0e-9 );
+    QVERIFY( fabs( table_2.getValue( 0.5 ) - 1.5 ) < 1.0e-9 );
+    QVERIFY( fabs( copy.getValue( 0.5 ) - 3.0 ) < 1.0e-9 );
+
+    copy.share();
+
+    QVERIFY( fdm::DataPool::getCount() == count + 2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::benchmarkLinearSearch()
+{
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < _keys.size(); i++ )
+        {
+            sum += getValueLinearSearch( _keys[ i ] );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::benchmarkBinarySearch()
+{
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < _keys.size(); i++ )
+        {
+            sum += _table.getValue( _keys[ i ] );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::benchmarkCursor()
+{
+    double sum = 0.0;
+    unsigned int cursor = 0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < _keys.size(); i++ )
+        {
+            sum += _table.getValue( _keys[ i ], cursor );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table1Test::benchmarkBaked()
+{
+    fdm::Table1 table( _table );
+
+    QVERIFY( table.bake( 1.0e-9 ) );
+
+    double sum = 0.0;
+
+    QBENCHMARK
+    {
+        for ( unsigned int i = 0; i < _keys.size(); i++ )
+        {
+            sum += table.getValue( _keys[ i ] );
+        }
+    }
+
+    QVERIFY( sum == sum );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 QTEST_APPLESS_MAIN(Table1Test)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1,8 +1,13 @@
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 #include <QString>
 #include <QtTest>
 
+#include <fdm/utils/fdm_Table2.h>
+
 ////////////////////////////////////////////////////////////////////////////////
 
 using namespace std;
@@ -23,6 +28,10 @@ private Q_SLOTS:
     void cleanupTestCase();
 
     void sampleTest();
+
+    void bakeTest();
+
+    void getValuesTest();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -46,6 +55,123 @@ void Table2Test::sampleTest()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Table2Test::bakeTest()
+{
+    std::vector< double > row_values;
+    std::vector< double > col_values;
+    std::vector< double > table_data;
+
+    // non-uniform keys
+    row_values.push_back( -10.0 );
+    row_values.push_back(   0.0 );
+    row_values.push_back(   5.0 );
+    row_values.push_back(  15.0 );
+    row_values.push_back(  30.0 );
+
+    col_values.push_back( -20.0 );
+    col_values.push_back( -10.0 );
+    col_values.push_back(   0.0 );
+    col_values.push_back(  15.0 );
+
+    for ( unsigned int r = 0; r < row_values.size(); r++ )
+    {
+        for ( unsigned int c = 0; c < col_values.size(); c++ )
+        {
+            table_data.push_back( 0.01 * row_values[ r ] * row_values[ r ]
+                                + sin( 0.1 * col_values[ c ] ) * row_values[ r ] );
+        }
+    }
+
+    fdm::Table2 table( row_values, col_values, table_data );
+    fdm::Table2 baked( table );
+
+    QVERIFY( baked.bake( 1.0e-9 ) );
+    QVERIFY( baked.isBaked() );
+
+    fdm::Table2 copy;
+    copy = baked;
+
+    QVERIFY( copy.isBaked() );
+
+    for ( double r = -20.0; r <= 40.0; r += 0.7 )
+    {
+        for ( double c = -30.0; c <= 30.0; c += 1.3 )
+        {
+            QVERIFY( fabs( table.getValue( r, c ) - copy.getValue( r, c ) ) < 1.0e-9 );
+        }
+    }
+
+    // not finite key
+    QVERIFY( std::isnan( copy.getValue( std::numeric_limits< double >::quiet_NaN(), 0.0 ) ) );
+    QVERIFY( std::isnan( copy.getValue( 0.0, std::numeric_limits< double >::quiet_NaN() ) ) );
+
+    // too small grid
+    QVERIFY( !baked.bake( 1.0e-9, 16 ) );
+    QVERIFY( !baked.isBaked() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2Test::getValuesTest()
+{
+    std::vector< double > row_values;
+    std::vector< double > col_values;
+    std::vector< double > table_data;
+
+    // non-uniform keys
+    row_values.push_back( -10.0 );
+    row_values.push_back(   0.0 );
+    row_values.push_back(   5.0 );
+    row_values.push_back(  15.0 );
+    row_values.push_back(  30.0 );
+
+    col_values.push_back( -20.0 );
+    col_values.push_back( -10.0 );
+    col_values.push_back(   0.0 );
+    col_values.push_back(  15.0 );
+
+    for ( unsigned int r = 0; r < row_values.size(); r++ )
+    {
+        for ( unsigned int c = 0; c < col_values.size(); c++ )
+        {
+            table_data.push_back( 0.01 * row_values[ r ] * row_values[ r ]
+                                + sin( 0.1 * col_values[ c ] ) * row_values[ r ] );
+        }
+    }
+
+    fdm::Table2 table( row_values, col_values, table_data );
+    fdm::Table2 baked( table );
+
+    QVERIFY( baked.bake( 1.0e-9 ) );
+
+    std::vector< double > rows;
+    std::vector< double > cols;
+
+    // includes keys values and out of range values
+    for ( double r = -20.0; r <= 40.0; r += 2.5 )
+    {
+        for ( double c = -30.0; c <= 30.0; c += 2.5 )
+        {
+            rows.push_back( r );
+            cols.push_back( c );
+        }
+    }
+
+    std::vector< double > values( rows.size() );
+    std::vector< double > values_baked( rows.size() );
+
+    table.getValues( rows.size(), &rows[ 0 ], &cols[ 0 ], &values[ 0 ] );
+    baked.getValues( rows.size(), &rows[ 0 ], &cols[ 0 ], &values_baked[ 0 ] );
+
+    for ( unsigned int i = 0; i < rows.size(); i++ )
+    {
+        QVERIFY( fabs( table.getValue( rows[ i ], cols[ i ] ) - values[ i ] ) < 1.0e-12 );
+        QVERIFY( fabs( baked.getValue( rows[ i ], cols[ i ] ) - values_baked[ i ] ) < 1.0e-12 );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 QTEST_APPLESS_MAIN(Table2Test)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,214 @@
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_Table2.h>
+#include <fdm/utils/fdm_Table2Pack.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class Table2PackTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    Table2PackTest();
+
+private:
+
+    fdm::Table2 createTable( const std::vector< double > &row_values,
+                             const std::vector< double > &col_values,
+                             double factor );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getValuesTest();
+
+    void getDerivativesTest();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+Table2PackTest::Table2PackTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::Table2 Table2PackTest::createTable( const std::vector< double > &row_values,
+                                         const std::vector< double > &col_values,
+                                         double factor )
+{
+    std::vector< double > table_data;
+
+    for ( unsigned int r = 0; r < row_values.size(); r++ )
+    {
+        for ( unsigned int c = 0; c < col_values.size(); c++ )
+        {
+            table_data.push_back( factor * 0.01 * row_values[ r ] * row_values[ r ]
+                                + sin( 0.1 * factor * col_values[ c ] ) * row_values[ r ] );
+        }
+    }
+
+    return fdm::Table2( row_values, col_values, table_data );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2PackTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2PackTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2PackTest::getValuesTest()
+{
+    std::vector< double > row_values_1;
+    std::vector< double > col_values_1;
+    std::vector< double > row_values_2;
+    std::vector< double > col_values_2;
+
+    row_values_1.push_back( -10.0 );
+    row_values_1.push_back(   0.0 );
+    row_values_1.push_back(   5.0 );
+    row_values_1.push_back(  15.0 );
+    row_values_1.push_back(  30.0 );
+
+    col_values_1.push_back( -20.0 );
+    col_values_1.push_back( -10.0 );
+    col_values_1.push_back(   0.0 );
+    col_values_1.push_back(  15.0 );
+
+    row_values_2.push_back( -5.0 );
+    row_values_2.push_back(  0.0 );
+    row_values_2.push_back( 20.0 );
+
+    col_values_2.push_back( 0.0 );
+
+    std::vector< fdm::Table2 > tables;
+
+    tables.push_back( createTable( row_values_1, col_values_1, 1.0 ) );
+    tables.push_back( createTable( row_values_2, col_values_2, 2.0 ) );
+    tables.push_back( createTable( row_values_1, col_values_1, 3.0 ) );
+    tables.push_back( createTable( row_values_1, col_values_1, 4.0 ) );
+    tables.push_back( createTable( row_values_2, col_values_2, 5.0 ) );
+
+    fdm::Table2Pack pack;
+
+    for ( unsigned int i = 0; i < tables.size(); i++ )
+    {
+        QVERIFY( pack.add( tables[ i ] ) == i );
+    }
+
+    QVERIFY( pack.getSize() == tables.size() );
+    QVERIFY( pack.getBlocks() == 2 );
+
+    std::vector< double > values( tables.size() );
+
+    for ( double r = -20.0; r <= 40.0; r += 0.7 )
+    {
+        for ( double c = -30.0; c <= 30.0; c += 1.3 )
+        {
+            pack.getValues( r, c, &values[ 0 ] );
+
+            for ( unsigned int i = 0; i < tables.size(); i++ )
+            {
+                QVERIFY( fabs( tables[ i ].getValue( r, c ) - values[ i ] ) < 1.0e-9 );
+            }
+        }
+    }
+
+    // breakpoints
+    for ( unsigned int r = 0; r < row_values_1.size(); r++ )
+    {
+        for ( unsigned int c = 0; c < col_values_1.size(); c++ )
+        {
+            pack.getValues( row_values_1[ r ], col_values_1[ c ], &values[ 0 ] );
+
+            QVERIFY( fabs( tables[ 0 ].getValueByIndex( r, c ) - values[ 0 ] ) < 1.0e-9 );
+            QVERIFY( fabs( tables[ 3 ].getValueByIndex( r, c ) - values[ 3 ] ) < 1.0e-9 );
+        }
+    }
+
+    pack.clear();
+
+    QVERIFY( pack.getSize() == 0 );
+    QVERIFY( pack.getBlocks() == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Table2PackTest::getDerivativesTest()
+{
+    std::vector< double > row_values;
+    std::vector< double > col_values;
+
+    row_values.push_back( -10.0 );
+    row_values.push_back(   0.0 );
+    row_values.push_back(   5.0 );
+    row_values.push_back(  15.0 );
+    row_values.push_back(  30.0 );
+
+    col_values.push_back( -20.0 );
+    col_values.push_back( -10.0 );
+    col_values.push_back(   0.0 );
+    col_values.push_back(  15.0 );
+
+    fdm::Table2 table_1 = createTable( row_values, col_values, 1.0 );
+    fdm::Table2 table_2 = createTable( row_values, col_values, 3.0 );
+
+    fdm::Table2Pack pack;
+
+    pack.add( table_1 );
+    pack.add( table_2 );
+
+    double values     [ 2 ];
+    double row_derivs [ 2 ];
+    double col_derivs [ 2 ];
+
+    const double h = 1.0e-6;
+
+    // inside keys cells
+    for ( double r = -9.55; r < 30.0; r += 0.7 )
+    {
+        for ( double c = -19.65; c < 15.0; c += 1.3 )
+        {
+            pack.getValues( r, c, values, row_derivs, col_derivs );
+
+            QVERIFY( fabs( table_1.getValue( r, c ) - values[ 0 ] ) < 1.0e-9 );
+            QVERIFY( fabs( table_2.getValue( r, c ) - values[ 1 ] ) < 1.0e-9 );
+
+            double dr = ( table_1.getValue( r + h, c ) - table_1.getValue( r - h, c ) ) / ( 2.0 * h );
+            double dc = ( table_2.getValue( r, c + h ) - table_2.getValue( r, c - h ) ) / ( 2.0 * h );
+
+            QVERIFY( fabs( dr - row_derivs[ 0 ] ) < 1.0e-6 );
+            QVERIFY( fabs( dc - col_derivs[ 1 ] ) < 1.0e-6 );
+        }
+    }
+
+    // outside table range
+    pack.getValues( 40.0, -30.0, values, row_derivs, col_derivs );
+
+    QVERIFY( fabs( table_1.getValue( 40.0, -30.0 ) - values[ 0 ] ) < 1.0e-9 );
+    QVERIFY( row_derivs[ 0 ] == 0.0 );
+    QVERIFY( col_derivs[ 0 ] == 0.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(Table2PackTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_table2pack.moc"
@@ -0,0 +1,261 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <algorithm>
+#include <thread>
+
+#include <fdm/utils/fdm_ThreadPlacement.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class ThreadPlacementTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    ThreadPlacementTest();
+
+private:
+
+    fdm::ThreadPlacement::Topology _topology;
+
+    fdm::ThreadPlacement::Config getConfig( int sim, int render, int sfx, int workers );
+
+    static bool contains( const fdm::ThreadPlacement::CPUs &cpus, int cpu );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void avoidSiblings();
+    void useSiblings();
+    void numaNode();
+    void isolateRender();
+    void exhausted();
+    void notPinned();
+    void apply();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+ThreadPlacementTest::ThreadPlacementTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+fdm::ThreadPlacement::Config ThreadPlacementTest::getConfig( int sim, int render, int sfx, int workers )
+{
+    fdm::ThreadPlacement::Config config;
+
+    config.cores[ fdm::ThreadPlacement::Simulation ] = sim;
+    config.cores[ fdm::ThreadPlacement::Render     ] = render;
+    config.cores[ fdm::ThreadPlacement::Sound      ] = sfx;
+    config.cores[ fdm::ThreadPlacement::Workers    ] = workers;
+
+    config.node = -1;
+    config.avoidSiblings = true;
+    config.isolateRender = true;
+
+    return config;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool ThreadPlacementTest::contains( const fdm::ThreadPlacement::CPUs &cpus, int cpu )
+{
+    return std::find( cpus.begin(), cpus.end(), cpu ) != cpus.end();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::initTestCase()
+{
+    // 2 sockets, 4 cores per socket, 2 hyperthreads per core, node per socket
+    // CPUs 0-7 are first threads of cores, 8-15 are their siblings
+    for ( int i = 0; i < 16; i++ )
+    {
+        fdm::ThreadPlacement::CPU cpu;
+
+        cpu.id      = i;
+        cpu.package = ( i % 8 ) / 4;
+        cpu.core    = i % 4;
+        cpu.node    = cpu.package;
+
+        _topology.push_back( cpu );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::cleanupTestCase()
+{
+    fdm::ThreadPlacement::reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::avoidSiblings()
+{
+    fdm::ThreadPlacement::configure( getConfig( 1, 1, 0, 0 ), _topology );
+
+    fdm::ThreadPlacement::CPUs sim = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation );
+    fdm::ThreadPlacement::CPUs ren = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Render );
+    fdm::ThreadPlacement::CPUs sfx = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Sound );
+    fdm::ThreadPlacement::CPUs wrk = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Workers );
+
+    QVERIFY( sim.size() == 1 && sim[ 0 ] == 0 );
+    QVERIFY( ren.size() == 1 && ren[ 0 ] == 1 );
+
+    // dedicated cores and their siblings are not shared
+    QVERIFY( sfx.size() == 12 );
+    QVERIFY( !contains( sfx, 0 ) && !contains( sfx, 8 ) );
+    QVERIFY( !contains( sfx, 1 ) && !contains( sfx, 9 ) );
+    QVERIFY( sfx == wrk );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::useSiblings()
+{
+    fdm::ThreadPlacement::Config config = getConfig( 1, 1, 0, 2 );
+    config.avoidSiblings = false;
+
+    fdm::ThreadPlacement::configure( config, _topology );
+
+    fdm::ThreadPlacement::CPUs sim = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation );
+    fdm::ThreadPlacement::CPUs ren = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Render );
+    fdm::ThreadPlacement::CPUs sfx = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Sound );
+    fdm::ThreadPlacement::CPUs wrk = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Workers );
+
+    // physical cores are used before siblings
+    QVERIFY( sim.size() == 1 && sim[ 0 ] == 0 );
+    QVERIFY( ren.size() == 1 && ren[ 0 ] == 1 );
+    QVERIFY( wrk.size() == 2 && wrk[ 0 ] == 2 && wrk[ 1 ] == 3 );
+
+    QVERIFY( sfx.size() == 12 );
+    QVERIFY( contains( sfx, 8 ) );
+    QVERIFY( !contains( sfx, 0 ) && !contains( sfx, 2 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::numaNode()
+{
+    fdm::ThreadPlacement::Config config = getConfig( 1, 1, 0, 0 );
+    config.node = 1;
+
+    fdm::ThreadPlacement::configure( config, _topology );
+
+    fdm::ThreadPlacement::CPUs sim = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation );
+    fdm::ThreadPlacement::CPUs ren = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Render );
+    fdm::ThreadPlacement::CPUs sfx = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Sound );
+
+    QVERIFY( sim.size() == 1 && sim[ 0 ] == 4 );
+    QVERIFY( ren.size() == 1 && ren[ 0 ] == 5 );
+
+    QVERIFY( sfx.size() == 4 );
+    QVERIFY( contains( sfx, 6 ) && contains( sfx, 7 ) );
+    QVERIFY( contains( sfx, 14 ) && contains( sfx, 15 ) );
+
+    // node without CPUs falls back to all nodes
+    config.node = 5;
+
+    fdm::ThreadPlacement::configure( config, _topology );
+
+    sim = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation );
+
+    QVERIFY( sim.size() == 1 && sim[ 0 ] == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::isolateRender()
+{
+    fdm::ThreadPlacement::Config config = getConfig( 1, 1, 0, 0 );
+    config.isolateRender = false;
+
+    fdm::ThreadPlacement::configure( config, _topology );
+
+    fdm::ThreadPlacement::CPUs sfx = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Sound );
+
+    QVERIFY( sfx.size() == 14 );
+    QVERIFY( contains( sfx, 1 ) && contains( sfx, 9 ) );
+    QVERIFY( !contains( sfx, 0 ) && !contains( sfx, 8 ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::exhausted()
+{
+    fdm::ThreadPlacement::Topology topology( _topology.begin(), _topology.begin() + 2 );
+
+    fdm::ThreadPlacement::configure( getConfig( 1, 1, 0, 0 ), topology );
+
+    fdm::ThreadPlacement::CPUs sim = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation );
+    fdm::ThreadPlacement::CPUs ren = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Render );
+    fdm::ThreadPlacement::CPUs sfx = fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Sound );
+
+    QVERIFY( sim.size() == 1 && sim[ 0 ] == 0 );
+
+    // render has no dedicated core left, it shares everything but simulation core
+    QVERIFY( ren.size() == 1 && ren[ 0 ] == 1 );
+    QVERIFY( sfx.size() == 1 && sfx[ 0 ] == 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::notPinned()
+{
+    fdm::ThreadPlacement::configure( getConfig( 1, -1, -1, -1 ), _topology );
+
+    QVERIFY( fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation ).size() == 1 );
+    QVERIFY( fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Render  ).empty() );
+    QVERIFY( fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Sound   ).empty() );
+    QVERIFY( fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Workers ).empty() );
+
+    fdm::ThreadPlacement::reset();
+
+    QVERIFY( fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation ).empty() );
+    QVERIFY( fdm::ThreadPlacement::apply( fdm::ThreadPlacement::Simulation ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPlacementTest::apply()
+{
+    fdm::ThreadPlacement::Topology topology = fdm::ThreadPlacement::getTopology();
+
+    QVERIFY( topology.size() > 0 );
+
+    fdm::ThreadPlacement::configure( getConfig( 1, 0, 0, 0 ) );
+
+    QVERIFY( fdm::ThreadPlacement::getCPUs( fdm::ThreadPlacement::Simulation ).size() == 1 );
+
+    bool result = false;
+
+    std::thread thread( [ &result ]()
+    {
+        result = fdm::ThreadPlacement::apply( fdm::ThreadPlacement::Simulation );
+    } );
+
+    thread.join();
+
+    QVERIFY( result );
+
+    fdm::ThreadPlacement::reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(ThreadPlacementTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_threadplacement.moc"
@@ -0,0 +1,218 @@
+#include <QString>
+#include <QtTest>
+
+#include <cmath>
+#include <cstdlib>
+
+#include <fdm/utils/fdm_TriangleBVH.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRIANGLES 2000
+#define SEGMENTS  2000
+
+////////////////////////////////////////////////////////////////////////////////
+
+class TriangleBVHTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    TriangleBVHTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void empty();
+    void degenerate();
+    void bruteForce();
+
+private:
+
+    std::vector< fdm::Vector3 > _vertices;
+    std::vector< fdm::UInt32 >  _indices;
+
+    static double random( double min, double max );
+
+    bool getIntersection( const fdm::Vector3 &b, const fdm::Vector3 &e, double *u );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TriangleBVHTest::TriangleBVHTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVHTest::initTestCase()
+{
+    srand( 0 );
+
+    for ( int i = 0; i < TRIANGLES; i++ )
+    {
+        fdm::Vector3 c( random( -100.0, 100.0 ),
+                        random( -100.0, 100.0 ),
+                        random(  -25.0,  25.0 ) );
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            _indices.push_back( (fdm::UInt32)_vertices.size() );
+            _vertices.push_back( c + fdm::Vector3( random( -5.0, 5.0 ),
+                                                   random( -5.0, 5.0 ),
+                                                   random( -5.0, 5.0 ) ) );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVHTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVHTest::empty()
+{
+    fdm::TriangleBVH bvh;
+
+    double u = 0.0;
+    fdm::Vector3 n;
+
+    QVERIFY2( bvh.isEmpty(), "Failure" );
+    QVERIFY2( !bvh.getIntersection( fdm::Vector3( 0.0, 0.0, -1.0 ),
+                                    fdm::Vector3( 0.0, 0.0,  1.0 ), &u, &n ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVHTest::degenerate()
+{
+    std::vector< fdm::Vector3 > vertices;
+    std::vector< fdm::UInt32 > indices;
+
+    vertices.push_back( fdm::Vector3( -10.0, -10.0, 0.0 ) );
+    vertices.push_back( fdm::Vector3(  10.0, -10.0, 0.0 ) );
+    vertices.push_back( fdm::Vector3(   0.0,  10.0, 0.0 ) );
+    vertices.push_back( fdm::Vector3(  20.0,  20.0, 0.0 ) );
+
+    // valid triangle
+    indices.push_back( 0 );
+    indices.push_back( 1 );
+    indices.push_back( 2 );
+
+    // collinear
+    indices.push_back( 0 );
+    indices.push_back( 1 );
+    indices.push_back( 1 );
+
+    fdm::TriangleBVH bvh;
+    bvh.build( vertices, indices );
+
+    QVERIFY2( bvh.getTrianglesCount() == 1, "Failure" );
+
+    double u = 0.0;
+    fdm::Vector3 n;
+
+    QVERIFY2( bvh.getIntersection( fdm::Vector3( 0.0, 0.0, -10.0 ),
+                                   fdm::Vector3( 0.0, 0.0,  10.0 ), &u, &n ), "Failure" );
+    QCOMPARE( u, 0.5 );
+    QVERIFY2( fabs( fabs( n.z() ) - 1.0 ) < 1.0e-9, "Failure" );
+
+    QVERIFY2( !bvh.getIntersection( fdm::Vector3( 20.0, 20.0, -10.0 ),
+                                    fdm::Vector3( 20.0, 20.0,  10.0 ), &u, &n ), "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TriangleBVHTest::bruteForce()
+{
+    fdm::TriangleBVH bvh;
+    bvh.build( _vertices, _indices );
+
+    QVERIFY2( bvh.getTrianglesCount() == TRIANGLES, "Failure" );
+
+    int hits = 0;
+
+    for ( int i = 0; i < SEGMENTS; i++ )
+    {
+        fdm::Vector3 b( random( -150.0, 150.0 ), random( -150.0, 150.0 ), random( -50.0, 50.0 ) );
+        fdm::Vector3 e( random( -150.0, 150.0 ), random( -150.0, 150.0 ), random( -50.0, 50.0 ) );
+
+        double u_bvh = 0.0;
+        double u_ref = 0.0;
+        fdm::Vector3 n;
+
+        bool hit_bvh = bvh.getIntersection( b, e, &u_bvh, &n );
+        bool hit_ref = getIntersection( b, e, &u_ref );
+
+        QVERIFY2( hit_bvh == hit_ref, "Failure" );
+
+        if ( hit_ref )
+        {
+            QVERIFY2( fabs( u_bvh - u_ref ) < 1.0e-5, "Failure" );
+            hits++;
+        }
+    }
+
+    QVERIFY2( hits > 0, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+double TriangleBVHTest::random( double min, double max )
+{
+    return min + ( max - min ) * ( (double)rand() / (double)RAND_MAX );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool TriangleBVHTest::getIntersection( const fdm::Vector3 &b, const fdm::Vector3 &e, double *u )
+{
+    bool result = false;
+
+    (*u) = 1.0;
+
+    fdm::Vector3 d = e - b;
+
+    for ( unsigned int i = 0; i < _indices.size(); i += 3 )
+    {
+        const fdm::Vector3 &v0 = _vertices[ _indices[ i     ] ];
+        const fdm::Vector3 &v1 = _vertices[ _indices[ i + 1 ] ];
+        const fdm::Vector3 &v2 = _vertices[ _indices[ i + 2 ] ];
+
+        fdm::Vector3 e1 = v1 - v0;
+        fdm::Vector3 e2 = v2 - v0;
+        fdm::Vector3 p = d % e2;
+
+        double det = e1 * p;
+
+        if ( fabs( det ) < 1.0e-15 ) continue;
+
+        fdm::Vector3 s = b - v0;
+        double uu = ( s * p ) / det;
+        if ( uu < 0.0 || uu > 1.0 ) continue;
+
+        fdm::Vector3 q = s % e1;
+        double vv = ( d * q ) / det;
+        if ( vv < 0.0 || uu + vv > 1.0 ) continue;
+
+        double t = ( e2 * q ) / det;
+
+        if ( t >= 0.0 && t <= (*u) )
+        {
+            (*u) = t;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(TriangleBVHTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_trianglebvh.moc"
@@ -1,4 +1,6 @@
+#include <cstring>
 #include <iostream>
+#include <type_traits>
 
 #include <QString>
 #include <QtTest>
@@ -26,6 +28,7 @@ private Q_SLOTS:
     void cleanupTestCase();
 
     void constructor();
+    void layout();
     void getLength2();
     void getLengthXY();
     void getLengthXZ();
@@ -114,6 +117,29 @@ void Vector3Test::constructor()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Vector3Test::layout()
+{
+    QVERIFY2( sizeof( fdm::Vector3 ) == 3 * sizeof( double ), "Failure size" );
+    QVERIFY2( std::is_trivially_copyable< fdm::Vector3 >::value, "Failure trivially copyable" );
+
+    const double items[] = { 1.0, 2.0, 3.0 };
+
+    fdm::Vector3 src( items );
+    fdm::Vector3 dst[ 2 ];
+
+    memcpy( &dst[ 1 ], &src, sizeof( fdm::Vector3 ) );
+
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        QVERIFY2( dst[ 1 ].getItems()[ i ] == items[ i ], "Failure memcpy" );
+    }
+
+    QVERIFY2( reinterpret_cast< const char* >( &dst[ 1 ] )
+            - reinterpret_cast< const char* >( &dst[ 0 ] ) == 3 * sizeof( double ), "Failure array stride" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Vector3Test::getLength2()
 {
     fdm::Vector3 v1( 1.0, 2.0, 3.0 );
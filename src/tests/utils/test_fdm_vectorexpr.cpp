@@ -0,0 +1,200 @@
+#include <iostream>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_Matrix3x3.h>
+#include <fdm/utils/fdm_Matrix6x6.h>
+#include <fdm/utils/fdm_Vector3.h>
+#include <fdm/utils/fdm_Vector6.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class VectorExprTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    VectorExprTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void compound();
+    void aliasing();
+    void matrixVectorProduct();
+    void crossProduct();
+    void dotProduct();
+    void conversion();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+VectorExprTest::VectorExprTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::compound()
+{
+    fdm::Vector3 b( 1.0, 2.0, 3.0 );
+    fdm::Vector3 e( 5.0, 4.0, 9.0 );
+
+    double u = 0.25;
+
+    // b + u * ( e - b ) = ( 2.0, 2.5, 4.5 )
+    fdm::Vector3 v = b + u * ( e - b );
+
+    QVERIFY2( fabs( v.x() - 2.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() - 2.5 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() - 4.5 ) < 1.0e-9, "Failure z" );
+
+    // -( b - e ) / 2.0 + b * 2.0 = ( 4.0, 5.0, 9.0 )
+    v = -( b - e ) / 2.0 + b * 2.0;
+
+    QVERIFY2( fabs( v.x() - 4.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() - 5.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() - 9.0 ) < 1.0e-9, "Failure z" );
+
+    v += e - b;
+
+    QVERIFY2( fabs( v.x() - 8.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() - 7.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() - 15.0 ) < 1.0e-9, "Failure z" );
+
+    v -= 2.0 * e;
+
+    QVERIFY2( fabs( v.x() + 2.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() + 1.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() + 3.0 ) < 1.0e-9, "Failure z" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::aliasing()
+{
+    fdm::Vector3 v( 1.0, 2.0, 3.0 );
+    fdm::Vector3 w( 1.0, 1.0, 1.0 );
+
+    v = w - v;
+
+    QVERIFY2( fabs( v.x() - 0.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() + 1.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() + 2.0 ) < 1.0e-9, "Failure z" );
+
+    fdm::Matrix3x3 m( 0.0, 1.0, 0.0,
+                      0.0, 0.0, 1.0,
+                      1.0, 0.0, 0.0 );
+
+    v.set( 1.0, 2.0, 3.0 );
+    v = m * v;
+
+    QVERIFY2( fabs( v.x() - 2.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() - 3.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() - 1.0 ) < 1.0e-9, "Failure z" );
+
+    v += m * v;
+
+    QVERIFY2( fabs( v.x() - 5.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() - 4.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() - 3.0 ) < 1.0e-9, "Failure z" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::matrixVectorProduct()
+{
+    fdm::Matrix3x3 m( 1.0, 2.0, 3.0,
+                      4.0, 5.0, 6.0,
+                      7.0, 8.0, 9.0 );
+
+    fdm::Vector3 a( 1.0, 0.0, 0.0 );
+    fdm::Vector3 b( 0.0, 1.0, 1.0 );
+
+    fdm::Vector3 v = m * ( a + b );
+
+    QVERIFY2( fabs( v.x() -  6.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() - 15.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() - 24.0 ) < 1.0e-9, "Failure z" );
+
+    fdm::Matrix6x6 m6;
+    fdm::Vector6 v6;
+
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        m6( i, i ) = i + 1.0;
+        v6( i ) = 1.0;
+    }
+
+    fdm::Vector6 r6 = m6 * v6 - v6;
+
+    for ( unsigned int i = 0; i < 6; i++ )
+    {
+        QVERIFY2( fabs( r6( i ) - i ) < 1.0e-9, "Failure" );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::crossProduct()
+{
+    fdm::Vector3 a( 1.0, 0.0, 0.0 );
+    fdm::Vector3 b( 0.0, 1.0, 0.0 );
+
+    fdm::Vector3 v = ( a + b ) % ( 2.0 * b );
+
+    QVERIFY2( fabs( v.x() - 0.0 ) < 1.0e-9, "Failure x" );
+    QVERIFY2( fabs( v.y() - 0.0 ) < 1.0e-9, "Failure y" );
+    QVERIFY2( fabs( v.z() - 2.0 ) < 1.0e-9, "Failure z" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::dotProduct()
+{
+    fdm::Vector3 a( 1.0, 2.0, 3.0 );
+    fdm::Vector3 b( 4.0, 5.0, 6.0 );
+
+    // ( 5, 7, 9 ) * ( 3, 3, 3 ) = 63
+    double s = ( a + b ) * ( b - a );
+
+    QVERIFY2( fabs( s - 63.0 ) < 1.0e-9, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void VectorExprTest::conversion()
+{
+    fdm::Vector3 a( 1.0, 2.0, 3.0 );
+    fdm::Vector3 b( 4.0, 5.0, 6.0 );
+
+    QVERIFY2( fabs( fdm::Vector3( a - b ).getLength2() - 27.0 ) < 1.0e-9, "Failure" );
+
+    fdm::Vector< 3 > v = a + b;
+
+    QVERIFY2( fabs( v( 0 ) - 5.0 ) < 1.0e-9, "Failure" );
+    QVERIFY2( fabs( v( 1 ) - 7.0 ) < 1.0e-9, "Failure" );
+    QVERIFY2( fabs( v( 2 ) - 9.0 ) < 1.0e-9, "Failure" );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(VectorExprTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_vectorexpr.moc"
@@ -397,14 +397,63 @@ void WGS84Test::getWGS2NED()
 
 void WGS84Test::setPos_Geo()
 {
-    // TODO
+    fdm::WGS84::Geo geo;
+
+    geo.lat = M_PI_4;
+    geo.lon = M_PI_4;
+    geo.alt = 0.0;
+
+    fdm::WGS84 wgs( geo );
+
+    // the same latitude and longitude (cached trigonometric functions)
+    geo.alt = 1000.0;
+    wgs.setPos_Geo( geo );
+
+    fdm::Vector3 pos_wgs = fdm::WGS84::geo2wgs( geo );
+
+    QVERIFY2( fabs( wgs.getPos_WGS().x() - pos_wgs.x() ) < 1.0e-6, "Failure x" );
+    QVERIFY2( fabs( wgs.getPos_WGS().y() - pos_wgs.y() ) < 1.0e-6, "Failure y" );
+    QVERIFY2( fabs( wgs.getPos_WGS().z() - pos_wgs.z() ) < 1.0e-6, "Failure z" );
+
+    // different latitude and longitude
+    geo.lat = -M_PI / 6.0;
+    geo.lon =  M_PI / 3.0;
+    wgs.setPos_Geo( geo );
+
+    pos_wgs = fdm::WGS84::geo2wgs( geo );
+
+    QVERIFY2( fabs( wgs.getPos_WGS().x() - pos_wgs.x() ) < 1.0e-6, "Failure x" );
+    QVERIFY2( fabs( wgs.getPos_WGS().y() - pos_wgs.y() ) < 1.0e-6, "Failure y" );
+    QVERIFY2( fabs( wgs.getPos_WGS().z() - pos_wgs.z() ) < 1.0e-6, "Failure z" );
+
+    QVERIFY2( fabs( wgs.getNorm_WGS().x() - cos( geo.lat ) * cos( geo.lon ) ) < 1.0e-9, "Failure norm x" );
+    QVERIFY2( fabs( wgs.getNorm_WGS().y() - cos( geo.lat ) * sin( geo.lon ) ) < 1.0e-9, "Failure norm y" );
+    QVERIFY2( fabs( wgs.getNorm_WGS().z() - sin( geo.lat )                  ) < 1.0e-9, "Failure norm z" );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void WGS84Test::setPos_WGS()
 {
-    // TODO
+    fdm::WGS84 wgs;
+
+    for ( int i = -80; i <= 80; i += 20 )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            fdm::WGS84::Geo geo;
+
+            geo.lat = M_PI * i / 180.0;
+            geo.lon = 0.3 * i / 180.0;
+            geo.alt = j * 5000.0;
+
+            wgs.setPos_WGS( fdm::WGS84::geo2wgs( geo ) );
+
+            QVERIFY2( fabs( wgs.getPos_Geo().lat - geo.lat ) < 1.0e-9, "Failure lat" );
+            QVERIFY2( fabs( wgs.getPos_Geo().lon - geo.lon ) < 1.0e-9, "Failure lon" );
+            QVERIFY2( fabs( wgs.getPos_Geo().alt - geo.alt ) < 1.0e-4, "Failure alt" );
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,183 @@
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/utils/fdm_WorkerPool.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+class WorkerPoolTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    WorkerPoolTest();
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void run();
+    void runRepeated();
+    void exception();
+    void shared();
+    void tryRunBusy();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+WorkerPoolTest::WorkerPoolTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPoolTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPoolTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPoolTest::run()
+{
+    for ( unsigned int threads = 1; threads <= 4; threads++ )
+    {
+        fdm::WorkerPool pool( threads );
+
+        QVERIFY( pool.getThreads() == threads );
+
+        std::vector< int > calls( 100, 0 );
+
+        pool.run( calls.size(), [ &calls ]( unsigned int index ) { calls[ index ]++; } );
+
+        for ( unsigned int i = 0; i < calls.size(); i++ )
+        {
+            QVERIFY( calls[ i ] == 1 );
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPoolTest::runRepeated()
+{
+    fdm::WorkerPool pool( 3 );
+
+    std::vector< double > values( 5, 0.0 );
+
+    for ( unsigned int i = 0; i < 10000; i++ )
+    {
+        pool.run( values.size(), [ &values ]( unsigned int index ) { values[ index ] += index; } );
+    }
+
+    for ( unsigned int i = 0; i < values.size(); i++ )
+    {
+        QVERIFY( values[ i ] == 10000.0 * i );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPoolTest::exception()
+{
+    fdm::WorkerPool pool( 2 );
+
+    bool thrown = false;
+
+    try
+    {
+        pool.run( 10, []( unsigned int index )
+        {
+            if ( index == 7 ) throw std::runtime_error( "Test." );
+        } );
+    }
+    catch ( const std::runtime_error & )
+    {
+        thrown = true;
+    }
+
+    QVERIFY( thrown );
+
+    // pool is still usable
+    int count = 0;
+    pool.run( 1, [ &count ]( unsigned int ) { count++; } );
+
+    QVERIFY( count == 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPoolTest::shared()
+{
+    std::shared_ptr< fdm::WorkerPool > pool_1 = fdm::WorkerPool::getShared( 2 );
+    std::shared_ptr< fdm::WorkerPool > pool_2 = fdm::WorkerPool::getShared( 2 );
+
+    QVERIFY( pool_1 == pool_2 );
+    QVERIFY( pool_1->getThreads() == 2 );
+
+    // smaller pool is shared
+    std::shared_ptr< fdm::WorkerPool > pool_3 = fdm::WorkerPool::getShared( 1 );
+
+    QVERIFY( pool_3 == pool_1 );
+
+    // bigger pool replaces shared one
+    std::shared_ptr< fdm::WorkerPool > pool_4 = fdm::WorkerPool::getShared( 3 );
+
+    QVERIFY( pool_4 != pool_1 );
+    QVERIFY( pool_4->getThreads() == 3 );
+    QVERIFY( fdm::WorkerPool::getShared( 2 ) == pool_4 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void WorkerPoolTest::tryRunBusy()
+{
+    fdm::WorkerPool pool( 2 );
+
+    std::atomic< bool > started( false );
+    std::atomic< bool > release( false );
+
+    // first run holds the pool
+    std::thread thread( [ & ]()
+    {
+        pool.run( 2, [ & ]( unsigned int index )
+        {
+            if ( index == 0 )
+            {
+                started = true;
+                while ( !release ) std::this_thread::yield();
+            }
+        } );
+    } );
+
+    while ( !started ) std::this_thread::yield();
+
+    int count = 0;
+
+    QVERIFY( !pool.tryRun( 4, [ &count ]( unsigned int ) { count++; } ) );
+    QVERIFY( count == 0 );
+
+    release = true;
+    thread.join();
+
+    QVERIFY( pool.tryRun( 4, [ &count ]( unsigned int ) { count++; } ) );
+    QVERIFY( count == 4 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(WorkerPoolTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_workerpool.moc"
@@ -0,0 +1,279 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <QString>
+#include <QtTest>
+
+#include <fdm/xml/fdm_XmlDoc.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define XML_FILE    "test_fdm_xmldoc.xml"
+#define CACHE_FILE  "test_fdm_xmldoc.xml.cache"
+
+////////////////////////////////////////////////////////////////////////////////
+
+class XmlDocTest : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    XmlDocTest();
+
+private:
+
+    static std::string readFile( const char *fileName );
+    static void writeFile( const char *fileName, const std::string &data );
+
+    static std::string getXml( double value );
+
+    static bool isEqual( const fdm::XmlNode &node_1, const fdm::XmlNode &node_2 );
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void cleanup();
+
+    void attributes();
+    void cacheRoundTrip();
+    void cacheStaleHash();
+    void cacheCorrupted();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+XmlDocTest::XmlDocTest() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string XmlDocTest::readFile( const char *fileName )
+{
+    std::ifstream ifs( fileName, std::ios_base::in | std::ios_base::binary );
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::writeFile( const char *fileName, const std::string &data )
+{
+    std::ofstream ofs( fileName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+    ofs << data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::string XmlDocTest::getXml( double value )
+{
+    std::stringstream ss;
+
+    ss << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    ss << "<root version=\"1\">\n";
+    ss << "  <!-- comment -->\n";
+    ss << "  <value unit=\"m\" factor=\"2.0\"> " << value << " </value>\n";
+    ss << "  <empty name=\"\"/>\n";
+    ss << "  <table>\n";
+    ss << "    0.0 1.0\n";
+    ss << "    1.0 2.0\n";
+    ss << "  </table>\n";
+    ss << "  <group>\n";
+    ss << "    <item id=\"a\"/>\n";
+    ss << "    <item id=\"b\">text</item>\n";
+    ss << "  </group>\n";
+    ss << "</root>\n";
+
+    return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool XmlDocTest::isEqual( const fdm::XmlNode &node_1, const fdm::XmlNode &node_2 )
+{
+    if ( node_1.isValid() != node_2.isValid() ) return false;
+    if ( !node_1.isValid() ) return true;
+
+    if ( node_1.getName()       != node_2.getName()       ) return false;
+    if ( node_1.getLine()       != node_2.getLine()       ) return false;
+    if ( node_1.isElement()     != node_2.isElement()     ) return false;
+    if ( node_1.isText()        != node_2.isText()        ) return false;
+    if ( node_1.isComment()     != node_2.isComment()     ) return false;
+    if ( node_1.getAttributes() != node_2.getAttributes() ) return false;
+
+    if ( node_1.isText() && node_1.getText() != node_2.getText() ) return false;
+
+    return isEqual( node_1.getFirstChild(), node_2.getFirstChild() )
+        && isEqual( node_1.getNextSibling(), node_2.getNextSibling() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::initTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::cleanupTestCase() {}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::cleanup()
+{
+    fdm::XmlDoc::setCacheEnabled( false );
+
+    remove( XML_FILE );
+    remove( CACHE_FILE );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::attributes()
+{
+    writeFile( XML_FILE, getXml( 1.0 ) );
+
+    fdm::XmlDoc doc( XML_FILE );
+    QVERIFY( doc.isOpen() );
+
+    fdm::XmlNode rootNode = doc.getRootNode();
+
+    fdm::XmlNode nodeValue = rootNode.getFirstChildElement( "value" );
+    QVERIFY( nodeValue.getAttributes().size() == 2 );
+    QVERIFY( nodeValue.getAttribute( "unit" ) == "m" );
+
+    // attributes with empty value are not listed, but are still present
+    fdm::XmlNode nodeEmpty = rootNode.getFirstChildElement( "empty" );
+    QVERIFY( nodeEmpty.getAttributes().empty() );
+    QVERIFY( nodeEmpty.hasAttribute( "name" ) );
+    QVERIFY( nodeEmpty.getAttribute( "name" ).empty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::cacheRoundTrip()
+{
+    writeFile( XML_FILE, getXml( 1.0 ) );
+
+    fdm::XmlDoc parsed( XML_FILE );
+    QVERIFY( parsed.isOpen() );
+
+    fdm::XmlDoc::setCacheEnabled( true );
+
+    // cache file is written when document is parsed
+    fdm::XmlDoc written( XML_FILE );
+    QVERIFY( written.isOpen() );
+
+    std::string cache = readFile( CACHE_FILE );
+    QVERIFY( cache.size() > 0 );
+
+    // and read afterwards
+    fdm::XmlDoc cached( XML_FILE );
+    QVERIFY( cached.isOpen() );
+
+    QVERIFY( readFile( CACHE_FILE ) == cache );
+
+    QVERIFY( isEqual( parsed.getRootNode(), written.getRootNode() ) );
+    QVERIFY( isEqual( parsed.getRootNode(), cached.getRootNode() ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::cacheStaleHash()
+{
+    fdm::XmlDoc::setCacheEnabled( true );
+
+    writeFile( XML_FILE, getXml( 1.0 ) );
+
+    fdm::XmlDoc doc_1( XML_FILE );
+    QVERIFY( doc_1.isOpen() );
+
+    std::string cache_1 = readFile( CACHE_FILE );
+
+    // modified XML file, cache of the previous content is ignored
+    writeFile( XML_FILE, getXml( 2.0 ) );
+
+    fdm::XmlDoc doc_2( XML_FILE );
+    QVERIFY( doc_2.isOpen() );
+
+    fdm::XmlNode nodeValue = doc_2.getRootNode().getFirstChildElement( "value" );
+    QVERIFY( nodeValue.getFirstChild().getText() == " 2 " );
+
+    // and rewritten
+    std::string cache_2 = readFile( CACHE_FILE );
+    QVERIFY( cache_2.size() > 0 );
+    QVERIFY( cache_2 != cache_1 );
+
+    fdm::XmlDoc::setCacheEnabled( false );
+
+    fdm::XmlDoc parsed( XML_FILE );
+    QVERIFY( isEqual( parsed.getRootNode(), doc_2.getRootNode() ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void XmlDocTest::cacheCorrupted()
+{
+    writeFile( XML_FILE, getXml( 1.0 ) );
+
+    fdm::XmlDoc parsed( XML_FILE );
+    QVERIFY( parsed.isOpen() );
+
+    fdm::XmlDoc::setCacheEnabled( true );
+
+    fdm::XmlDoc written( XML_FILE );
+    QVERIFY( written.isOpen() );
+
+    std::string cache = readFile( CACHE_FILE );
+    QVERIFY( cache.size() > 0 );
+
+    // truncated cache file
+    writeFile( CACHE_FILE, cache.substr( 0, cache.size() / 2 ) );
+
+    fdm::XmlDoc truncated( XML_FILE );
+    QVERIFY( truncated.isOpen() );
+    QVERIFY( isEqual( parsed.getRootNode(), truncated.getRootNode() ) );
+    QVERIFY( readFile( CACHE_FILE ) == cache );
+
+    // root node first child link pointing at the root node itself, offset
+    // after magic number, hash, nodes count, node type and line number
+    std::string corrupted = cache;
+    corrupted.replace( 28, 4, std::string( 4, '\0' ) );
+    writeFile( CACHE_FILE, corrupted );
+
+    fdm::XmlDoc damaged( XML_FILE );
+    QVERIFY( damaged.isOpen() );
+    QVERIFY( isEqual( parsed.getRootNode(), damaged.getRootNode() ) );
+    QVERIFY( readFile( CACHE_FILE ) == cache );
+
+    // trailing data
+    writeFile( CACHE_FILE, cache + "garbage" );
+
+    fdm::XmlDoc trailing( XML_FILE );
+    QVERIFY( trailing.isOpen() );
+    QVERIFY( isEqual( parsed.getRootNode(), trailing.getRootNode() ) );
+    QVERIFY( readFile( CACHE_FILE ) == cache );
+
+    // not a cache file at all
+    writeFile( CACHE_FILE, "garbage" );
+
+    fdm::XmlDoc garbage( XML_FILE );
+    QVERIFY( garbage.isOpen() );
+    QVERIFY( isEqual( parsed.getRootNode(), garbage.getRootNode() ) );
+    QVERIFY( readFile( CACHE_FILE ) == cache );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+QTEST_APPLESS_MAIN(XmlDocTest)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_fdm_xmldoc.moc"